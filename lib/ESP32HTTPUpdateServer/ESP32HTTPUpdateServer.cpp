@@ -6,7 +6,6 @@
 //#include <flash_hal.h>
 #include <FS.h>
 #include <Update.h>
-#include "StreamString.h"
 
 #include <ESP32HTTPUpdateServer.h>
   
@@ -20,7 +19,7 @@
      <body>
      <form method='POST' action='' enctype='multipart/form-data'>
          Firmware:<br>
-         <input type='file' accept='.bin' name='firmware'>
+         <input type='file' accept='.bin,.bin.gz' name='firmware'>
          <input type='submit' value='Update Firmware'>
      </form>
      </body>
@@ -55,7 +54,7 @@ void ESP32HTTPUpdateServer::setup(WebServer *server, const String& path, const S
     _server->on(path.c_str(), HTTP_POST, [&](){
       if(!_authenticated)
         return _server->requestAuthentication();
-      if (Update.hasError()) {
+      if (_updater.hasError()) {
         _server->send(200, F("text/html"), String(F("Update error: ")) + _updaterError);
       } else {
         _server->client().setNoDelay(true);
@@ -93,24 +92,23 @@ void ESP32HTTPUpdateServer::setup(WebServer *server, const String& path, const S
           }*/
         } else {
           uint32_t maxSketchSpace = (ESP.getFreeSketchSpace() - 0x1000) & 0xFFFFF000;
-          if (!Update.begin(maxSketchSpace, U_FLASH)){//start with max available size
-            _setUpdaterError();
-          }
+          // A .bin.gz image is decompressed while writing.
+          _updater.begin(maxSketchSpace);//start with max available size
         }
       } else if(_authenticated && upload.status == UPLOAD_FILE_WRITE && !_updaterError.length()){
         if (_serial_output) Serial.printf(".");
-        if(Update.write(upload.buf, upload.currentSize) != upload.currentSize){
+        if(_updater.write(upload.buf, upload.currentSize) != upload.currentSize){
           _setUpdaterError();
         }
       } else if(_authenticated && upload.status == UPLOAD_FILE_END && !_updaterError.length()){
-        if(Update.end(true)){ //true to set the size to the current progress
-          if (_serial_output) Serial.printf("Update Success: %u\nRebooting...\n", upload.totalSize);
+        if(_updater.end(true)){ //true to set the size to the current progress
+          if (_serial_output) Serial.printf("Update Success: %u (%u written)\nRebooting...\n", upload.totalSize, _updater.written());
         } else {
           _setUpdaterError();
         }
         if (_serial_output) Serial.setDebugOutput(false);
       } else if(_authenticated && upload.status == UPLOAD_FILE_ABORTED){
-        Update.end();
+        _updater.abort();
         if (_serial_output) Serial.println("Update was aborted");
       }
       delay(0);
@@ -119,10 +117,8 @@ void ESP32HTTPUpdateServer::setup(WebServer *server, const String& path, const S
 
 void ESP32HTTPUpdateServer::_setUpdaterError()
 {
-  if (_serial_output) Update.printError(Serial);
-  StreamString str;
-  Update.printError(str);
-  _updaterError = str.c_str();
+  _updaterError = _updater.errorString();
+  if (_serial_output) Serial.println(_updaterError);
 }
     
 
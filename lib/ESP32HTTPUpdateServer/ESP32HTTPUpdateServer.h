@@ -5,6 +5,8 @@
 
 #include <Arduino.h>
 
+#include "ESP32UpdateInflate.h"
+
 class ESP32HTTPUpdateServer
 {
   public:
@@ -43,6 +45,7 @@ class ESP32HTTPUpdateServer
     String _password;
     bool _authenticated;
     String _updaterError;
+    ESP32UpdateInflate _updater;
 
 };
 
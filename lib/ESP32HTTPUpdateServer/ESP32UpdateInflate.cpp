@@ -0,0 +1,307 @@
+#include <ESP32UpdateInflate.h>
+
+#include <Update.h>
+#include <esp_rom_crc.h>
+#include <rom/miniz.h>
+
+#define GZIP_FLAG_HCRC     0x02
+#define GZIP_FLAG_EXTRA    0x04
+#define GZIP_FLAG_NAME     0x08
+#define GZIP_FLAG_COMMENT  0x10
+
+ESP32UpdateInflate::~ESP32UpdateInflate()
+{
+  _free();
+}
+
+void ESP32UpdateInflate::begin(size_t size, int ledPin, uint8_t ledOn)
+{
+  _free();
+  _state      = State::Start;
+  _size       = size;
+  _ledPin     = ledPin;
+  _ledOn      = ledOn;
+  _compressed = false;
+  _headerPos  = 0;
+  _extraLen   = 0;
+  _crc        = 0;
+  _written    = 0;
+  _error.clear();
+}
+
+size_t ESP32UpdateInflate::write(const uint8_t *data, size_t len)
+{
+  const size_t total = len;
+
+  if (hasError() || len == 0) {
+    return 0;
+  }
+
+  if (_state == State::Start) {
+    // gzip magic bytes: 0x1F 0x8B
+    if (!_startUpdate(data[0] == 0x1F)) {
+      return 0;
+    }
+  }
+
+  if (_state == State::Raw) {
+    const size_t res = Update.write(const_cast<uint8_t *>(data), len);
+    _written += res;
+    return res;
+  }
+
+  _keepTail(data, len);
+
+  while (len > 0 && !hasError()) {
+    if (_state == State::Deflate) {
+      if (!_inflate(data, len)) {
+        return 0;
+      }
+    } else if (_state == State::Done) {
+      // The gzip trailer is checked at the end, as the decompressor may already have read part of it.
+      len = 0;
+    } else if (!_parseHeader(data, len)) {
+      return 0;
+    }
+  }
+  return hasError() ? 0 : total;
+}
+
+bool ESP32UpdateInflate::end(bool evenIfRemaining)
+{
+  if (_state == State::Idle || _state == State::Start) {
+    _free();
+    _state = State::Idle;
+    return Update.end(evenIfRemaining);
+  }
+
+  if (_compressed && !hasError()) {
+    if (_state != State::Done) {
+      _setError(F("Compressed image incomplete"));
+    } else {
+      // gzip trailer: CRC32 and size of the decompressed data
+      const uint32_t crc  = _tail[0] | (_tail[1] << 8) | (_tail[2] << 16) | ((uint32_t)_tail[3] << 24);
+      const uint32_t size = _tail[4] | (_tail[5] << 8) | (_tail[6] << 16) | ((uint32_t)_tail[7] << 24);
+
+      if (crc != _crc || size != (uint32_t)_written) {
+        _setError(F("Decompressed image CRC32 or size mismatch"));
+      }
+    }
+  }
+  _free();
+
+  if (hasError()) {
+    Update.abort();
+    _state = State::Idle;
+    return false;
+  }
+  _state = State::Idle;
+
+  // The decompressed size was not known at the start.
+  return Update.end(_compressed ? true : evenIfRemaining);
+}
+
+void ESP32UpdateInflate::abort()
+{
+  _free();
+
+  if (_state != State::Idle && _state != State::Start) {
+    Update.abort();
+  }
+  _state = State::Idle;
+}
+
+bool ESP32UpdateInflate::hasError() const
+{
+  return _error.length() > 0 || Update.hasError();
+}
+
+String ESP32UpdateInflate::errorString() const
+{
+  if (_error.length() > 0) {
+    return _error;
+  }
+  return String(Update.errorString());
+}
+
+bool ESP32UpdateInflate::_startUpdate(bool compressed)
+{
+  _compressed = compressed;
+
+  if (compressed) {
+    _decomp = malloc(sizeof(tinfl_decompressor));
+    _dict   = static_cast<uint8_t *>(malloc(TINFL_LZ_DICT_SIZE));
+
+    if (_decomp == nullptr || _dict == nullptr) {
+      return _setError(F("Not enough memory to decompress image"));
+    }
+    tinfl_init(static_cast<tinfl_decompressor *>(_decomp));
+    _dictOfs = 0;
+    _state   = State::Header;
+  } else {
+    _state = State::Raw;
+  }
+
+  if (!Update.begin(compressed ? UPDATE_SIZE_UNKNOWN : _size, U_FLASH, _ledPin, _ledOn)) {
+    _state = State::Idle;
+    return false;
+  }
+  return true;
+}
+
+bool ESP32UpdateInflate::_parseHeader(const uint8_t *&data, size_t& len)
+{
+  const uint8_t flags = _header[3];
+
+  switch (_state) {
+    case State::Header:
+      _header[_headerPos++] = *data++;
+      --len;
+
+      if (_headerPos == 10) {
+        // 0x08: deflate compression method
+        if (_header[0] != 0x1F || _header[1] != 0x8B || _header[2] != 0x08) {
+          return _setError(F("Not a valid gzip image"));
+        }
+        _headerPos = 0;
+        _state     = State::ExtraLen;
+      }
+      return true;
+
+    case State::ExtraLen:
+
+      if (!(flags & GZIP_FLAG_EXTRA)) {
+        _state = State::Name;
+        return true;
+      }
+      _extraLen |= (*data++) << (8 * _headerPos);
+      --len;
+
+      if (++_headerPos == 2) {
+        _state = State::Extra;
+      }
+      return true;
+
+    case State::Extra:
+
+      while (_extraLen > 0 && len > 0) {
+        ++data;
+        --len;
+        --_extraLen;
+      }
+
+      if (_extraLen == 0) {
+        _state = State::Name;
+      }
+      return true;
+
+    case State::Name:
+    case State::Comment:
+    {
+      const uint8_t flag = (_state == State::Name) ? GZIP_FLAG_NAME : GZIP_FLAG_COMMENT;
+      bool done          = !(flags & flag);
+
+      // Zero terminated string
+      while (!done && len > 0) {
+        done = (*data++ == 0);
+        --len;
+      }
+
+      if (done) {
+        _headerPos = 0;
+        _state     = (_state == State::Name) ? State::Comment : State::HeaderCRC;
+      }
+      return true;
+    }
+
+    case State::HeaderCRC:
+
+      if (!(flags & GZIP_FLAG_HCRC) || _headerPos == 2) {
+        _headerPos = 0;
+        _state     = State::Deflate;
+        return true;
+      }
+      ++data;
+      --len;
+      ++_headerPos;
+      return true;
+
+    default:
+      break;
+  }
+  return _setError(F("Invalid state"));
+}
+
+bool ESP32UpdateInflate::_inflate(const uint8_t *&data, size_t& len)
+{
+  tinfl_decompressor *decomp = static_cast<tinfl_decompressor *>(_decomp);
+  tinfl_status status;
+
+  do {
+    size_t in_bytes  = len;
+    size_t out_bytes = TINFL_LZ_DICT_SIZE - _dictOfs;
+
+    status = tinfl_decompress(decomp, data, &in_bytes, _dict, _dict + _dictOfs, &out_bytes, TINFL_FLAG_HAS_MORE_INPUT);
+    data += in_bytes;
+    len  -= in_bytes;
+
+    if (out_bytes > 0) {
+      if (!_writeOut(_dict + _dictOfs, out_bytes)) {
+        return false;
+      }
+      _dictOfs = (_dictOfs + out_bytes) & (TINFL_LZ_DICT_SIZE - 1);
+    }
+
+    if (status < TINFL_STATUS_DONE) {
+      return _setError(F("Decompression of image failed"));
+    }
+
+    if (status == TINFL_STATUS_DONE) {
+      _state = State::Done;
+      return true;
+    }
+  } while (status == TINFL_STATUS_HAS_MORE_OUTPUT || len > 0);
+
+  return true;
+}
+
+void ESP32UpdateInflate::_keepTail(const uint8_t *data, size_t len)
+{
+  if (len >= sizeof(_tail)) {
+    memcpy(_tail, data + len - sizeof(_tail), sizeof(_tail));
+  } else {
+    memmove(_tail, _tail + len, sizeof(_tail) - len);
+    memcpy(_tail + sizeof(_tail) - len, data, len);
+  }
+}
+
+bool ESP32UpdateInflate::_writeOut(const uint8_t *data, size_t len)
+{
+  if (Update.write(const_cast<uint8_t *>(data), len) != len) {
+    return false;
+  }
+  _crc      = esp_rom_crc32_le(_crc, data, len);
+  _written += len;
+  return true;
+}
+
+bool ESP32UpdateInflate::_setError(const __FlashStringHelper *error)
+{
+  if (_error.length() == 0) {
+    _error = error;
+  }
+  return false;
+}
+
+void ESP32UpdateInflate::_free()
+{
+  if (_decomp != nullptr) {
+    free(_decomp);
+    _decomp = nullptr;
+  }
+
+  if (_dict != nullptr) {
+    free(_dict);
+    _dict = nullptr;
+  }
+}
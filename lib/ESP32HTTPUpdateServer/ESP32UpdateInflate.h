@@ -0,0 +1,81 @@
+#pragma once
+
+#ifndef __ESP32_UPDATE_INFLATE_H
+#define __ESP32_UPDATE_INFLATE_H
+
+#include <Arduino.h>
+
+// Writes a firmware image via Update.
+// A gzip compressed image (.bin.gz) is decompressed on the fly, using a 32k window buffer.
+// The decompressed image is verified against the CRC32 and size in the gzip trailer,
+// the Update class verifies the image itself (checksum and SHA256 digest) when it ends.
+class ESP32UpdateInflate
+{
+  public:
+    ~ESP32UpdateInflate();
+
+    // Update.begin() is called on the first write, as only then it is known whether the image is compressed.
+    // size: Size of the (uncompressed) image, or UPDATE_SIZE_UNKNOWN
+    void begin(size_t size, int ledPin = -1, uint8_t ledOn = LOW);
+
+    // Return the nr of bytes processed, which is less than len on error.
+    size_t write(const uint8_t *data, size_t len);
+
+    bool end(bool evenIfRemaining = false);
+
+    void abort();
+
+    bool hasError() const;
+
+    String errorString() const;
+
+    bool isCompressed() const { return _compressed; }
+
+    // Nr of bytes written to flash
+    size_t written() const { return _written; }
+
+  private:
+    enum class State : uint8_t {
+      Idle,
+      Start,      // Waiting for the first bytes
+      Raw,        // Not compressed
+      Header,     // Fixed gzip header
+      ExtraLen,
+      Extra,
+      Name,
+      Comment,
+      HeaderCRC,
+      Deflate,
+      Done
+    };
+
+    bool _startUpdate(bool compressed);
+    bool _parseHeader(const uint8_t *&data, size_t& len);
+    bool _inflate(const uint8_t *&data, size_t& len);
+    bool _writeOut(const uint8_t *data, size_t len);
+    void _keepTail(const uint8_t *data, size_t len);
+    bool _setError(const __FlashStringHelper *error);
+    void _free();
+
+    State    _state      = State::Idle;
+    size_t   _size       = 0;
+    int      _ledPin     = -1;
+    uint8_t  _ledOn      = LOW;
+    bool     _compressed = false;
+
+    uint8_t  _header[10] = {0};
+    uint16_t _headerPos  = 0;
+    uint16_t _extraLen   = 0;
+    uint8_t  _tail[8]    = {0}; // Last bytes received, the gzip trailer at the end
+
+    void    *_decomp     = nullptr; // tinfl_decompressor
+    uint8_t *_dict       = nullptr; // Window buffer
+    size_t   _dictOfs    = 0;
+
+    uint32_t _crc        = 0;
+    size_t   _written    = 0;
+
+    String   _error;
+};
+
+#endif
@@ -182,6 +182,14 @@ int ESPeasySerial::read(void)
   return _serialPort->read();
 }
 
+size_t ESPeasySerial::read(uint8_t *buffer, size_t size)
+{
+  if (!isValid() || !buffer) {
+    return 0;
+  }
+  return _serialPort->read(buffer, size);
+}
+
 int ESPeasySerial::available(void)
 {
   if (!isValid()) {
@@ -269,6 +277,13 @@ bool ESPeasySerial::setRS485Mode(int8_t rtsPin, bool enableCollisionDetection) {
   return false;
 }
 
+bool ESPeasySerial::setOnReceiveCallback(ESPEasySerial_onReceive_cb callback, void *arg, uint8_t rxTimeout_symbols) {
+  if (_serialPort != nullptr) {
+    return _serialPort->setOnReceiveCallback(callback, arg, rxTimeout_symbols);
+  }
+  return false;
+}
+
 bool ESPeasySerial::isValid() const {
   // FIXME TD-er: Must call isValid() on the individual _serialPort types
   return _serialPort != nullptr;
@@ -89,6 +89,10 @@ public:
   int    peek(void);
   size_t write(uint8_t val) override;
   int    read(void) override;
+
+  // Bulk read, use size <= available() to avoid waiting for more data
+  size_t read(uint8_t *buffer,
+              size_t   size);
   int    available(void) override;
   int    availableForWrite(void);
   void   flush(void) override;
@@ -168,6 +172,14 @@ public:
   // @retval True when supported and successful.
   bool setRS485Mode(int8_t rtsPin, bool enableCollisionDetection = false);
 
+  // Set callback for received data, nullptr to remove.
+  // Only supported on ESP32 hardware serial ports, the callback is then called from the UART event task.
+  // @param rxTimeout_symbols  Only call when the line was idle for this nr of symbols (end of frame), 0 = on every received chunk
+  // @retval True when supported and successful, otherwise available() must be polled.
+  bool setOnReceiveCallback(ESPEasySerial_onReceive_cb callback,
+                            void                      *arg,
+                            uint8_t                    rxTimeout_symbols = 0);
+
 private:
 
   bool isValid() const;
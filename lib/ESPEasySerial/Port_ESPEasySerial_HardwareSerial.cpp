@@ -286,4 +286,31 @@ bool Port_ESPEasySerial_HardwareSerial_t::setRS485Mode(int8_t rtsPin, bool enabl
   }
   #endif  
   return false;
-}
\ No newline at end of file
+}
+
+#ifdef ESP32
+bool Port_ESPEasySerial_HardwareSerial_t::setOnReceiveCallback(ESPEasySerial_onReceive_cb callback,
+                                                               void                      *arg,
+                                                               uint8_t                    rxTimeout_symbols)
+{
+  if (_serial == nullptr) {
+    return false;
+  }
+
+  if (callback == nullptr) {
+    _serial->onReceive(NULL);
+    return true;
+  }
+
+  if ((rxTimeout_symbols > 0) && !_serial->setRxTimeout(rxTimeout_symbols)) {
+    return false;
+  }
+
+  // N.B. HardwareSerial::end() also removes the callback, so must be set after begin()
+  _serial->onReceive([callback, arg]() {
+    callback(arg);
+  }, rxTimeout_symbols > 0);
+  return true;
+}
+
+#endif // ifdef ESP32
\ No newline at end of file
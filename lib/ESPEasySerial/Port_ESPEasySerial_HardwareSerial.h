@@ -52,6 +52,14 @@ public:
   // @retval True when supported and successful.
   bool setRS485Mode(int8_t rtsPin, bool enableCollisionDetection = false);
 
+#ifdef ESP32
+
+  // Uses the UART driver event task, callback is called from that task.
+  bool setOnReceiveCallback(ESPEasySerial_onReceive_cb callback,
+                            void                      *arg,
+                            uint8_t                    rxTimeout_symbols) override;
+#endif // ifdef ESP32
+
 private:
 
   HardwareSerial *_serial = nullptr;
@@ -9,6 +9,14 @@ int Port_ESPEasySerial_base::getBaudRate() const
   return _config.baud;
 }
 
+bool Port_ESPEasySerial_base::setOnReceiveCallback(ESPEasySerial_onReceive_cb callback,
+                                                   void                      *arg,
+                                                   uint8_t                    rxTimeout_symbols)
+{
+  // Not supported, must poll available()
+  return false;
+}
+
 String Port_ESPEasySerial_base::getPortDescription() const
 {
   String res;
@@ -8,6 +8,10 @@
 
 #include <Stream.h>
 
+// Called when data has been received.
+// N.B. may be called from another task (e.g. the ESP32 UART event task), so only set some flag.
+typedef void (*ESPEasySerial_onReceive_cb)(void *arg);
+
 class Port_ESPEasySerial_base {
 public:
 
@@ -78,6 +82,13 @@ public:
   virtual size_t setTxBufferSize(size_t new_size) = 0;
   virtual bool   setRS485Mode(int8_t rtsPin, bool enableCollisionDetection) = 0;
 
+  // Set callback for received data, nullptr to remove.
+  // @param rxTimeout_symbols  Only call when the line was idle for this nr of symbols (end of frame), 0 = on every received chunk
+  // @retval True when supported by this port type.
+  virtual bool   setOnReceiveCallback(ESPEasySerial_onReceive_cb callback,
+                                      void                      *arg,
+                                      uint8_t                    rxTimeout_symbols);
+
 
 
   const ESPEasySerialConfig& getSerialConfig() const {
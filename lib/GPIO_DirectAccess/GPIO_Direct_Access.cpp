@@ -2,6 +2,11 @@
 
 #include <Arduino.h>
 
+#if defined(ARDUINO_ARCH_ESP32)
+  # include <soc/gpio_reg.h>
+  # include <soc/soc_caps.h>
+#endif // if defined(ARDUINO_ARCH_ESP32)
+
 #if defined(ARDUINO_ARCH_ESP8266)
   # ifndef CORE_POST_3_0_0
     #  define IRAM_ATTR ICACHE_RAM_ATTR
@@ -119,4 +124,49 @@ void  IRAM_ATTR DIRECT_PINMODE_INPUT_ISR(IO_REG_TYPE pin)
   DIRECT_MODE_INPUT(reg, PIN_TO_BITMASK(pin));
 }
 
+void DIRECT_portWrite(uint64_t setMask, uint64_t clearMask)
+{
+  # ifdef ARDUINO_ARCH_ESP8266
+
+  // ESP8266 GPIO 16 doesn't have direct access
+  if ((setMask | clearMask) & (1ull << 16)) {
+    digitalWrite(16, (setMask & (1ull << 16)) ? HIGH : LOW);
+  }
+
+  if (setMask & 0xFFFF) { GPOS = static_cast<uint32_t>(setMask & 0xFFFF); }
+
+  if (clearMask & 0xFFFF) { GPOC = static_cast<uint32_t>(clearMask & 0xFFFF); }
+  # endif // ifdef ARDUINO_ARCH_ESP8266
+  # ifdef ARDUINO_ARCH_ESP32
+
+  if (static_cast<uint32_t>(setMask)) { REG_WRITE(GPIO_OUT_W1TS_REG, static_cast<uint32_t>(setMask)); }
+
+  if (static_cast<uint32_t>(clearMask)) { REG_WRITE(GPIO_OUT_W1TC_REG, static_cast<uint32_t>(clearMask)); }
+  #  if SOC_GPIO_PIN_COUNT > 32
+
+  if (setMask >> 32) { REG_WRITE(GPIO_OUT1_W1TS_REG, static_cast<uint32_t>(setMask >> 32)); }
+
+  if (clearMask >> 32) { REG_WRITE(GPIO_OUT1_W1TC_REG, static_cast<uint32_t>(clearMask >> 32)); }
+  #  endif // if SOC_GPIO_PIN_COUNT > 32
+  # endif  // ifdef ARDUINO_ARCH_ESP32
+}
+
+uint64_t DIRECT_portRead()
+{
+  # ifdef ARDUINO_ARCH_ESP8266
+  uint64_t res = GPI & 0xFFFF;
+
+  // ESP8266 GPIO 16 doesn't have direct access
+  if (digitalRead(16)) { res |= (1ull << 16); }
+  return res;
+  # endif // ifdef ARDUINO_ARCH_ESP8266
+  # ifdef ARDUINO_ARCH_ESP32
+  uint64_t res = REG_READ(GPIO_IN_REG);
+  #  if SOC_GPIO_PIN_COUNT > 32
+  res |= static_cast<uint64_t>(REG_READ(GPIO_IN1_REG)) << 32;
+  #  endif // if SOC_GPIO_PIN_COUNT > 32
+  return res;
+  # endif // ifdef ARDUINO_ARCH_ESP32
+}
+
 #endif // if defined(ARDUINO_ARCH_ESP8266) || defined(ARDUINO_ARCH_ESP32)
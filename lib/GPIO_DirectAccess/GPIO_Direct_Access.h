@@ -129,6 +129,13 @@ void DIRECT_pinWrite_ISR(IO_REG_TYPE pin, bool pinstate);
 void DIRECT_PINMODE_OUTPUT_ISR(IO_REG_TYPE pin);
 void DIRECT_PINMODE_INPUT_ISR(IO_REG_TYPE pin);
 
+// Set and clear multiple pins at once, bit N of the masks is GPIO N.
+// GPIO 0 ... 15 are written in a single register write, GPIO 16 is written separately.
+void DIRECT_portWrite(uint64_t setMask, uint64_t clearMask);
+
+// Read all pins at once, bit N is the state of GPIO N.
+uint64_t DIRECT_portRead();
+
 #elif defined(ARDUINO_ARCH_ESP32)
 
 #include <esp32-hal-gpio.h>
@@ -249,6 +256,13 @@ void DIRECT_pinWrite_ISR(IO_REG_TYPE pin, bool pinstate) IRAM_ATTR;
 void DIRECT_PINMODE_OUTPUT_ISR(IO_REG_TYPE pin) IRAM_ATTR;
 void DIRECT_PINMODE_INPUT_ISR(IO_REG_TYPE pin) IRAM_ATTR;
 
+// Set and clear multiple pins at once, bit N of the masks is GPIO N.
+// Uses a single W1TS and W1TC register write per bank of 32 pins.
+void DIRECT_portWrite(uint64_t setMask, uint64_t clearMask);
+
+// Read all pins at once, bit N is the state of GPIO N.
+uint64_t DIRECT_portRead();
+
 /*
 // https://github.com/PaulStoffregen/OneWire/pull/47
 // https://github.com/stickbreaker/OneWire/commit/6eb7fc1c11a15b6ac8c60e5671cf36eb6829f82c
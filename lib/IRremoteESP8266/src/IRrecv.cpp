@@ -398,8 +398,11 @@ void IRrecv::disableIRIn(void) {
   os_timer_disarm(&timer);
 #endif  // ESP8266
 #if defined(ESP32)
-  timerAlarmDisable(timer);
-  timerEnd(timer);
+  if (timer != NULL) {  // Not started when the capture is done externally.
+    timerAlarmDisable(timer);
+    timerEnd(timer);
+    timer = NULL;
+  }
 #endif  // ESP32
   detachInterrupt(params.recvpin);
 #endif  // UNIT_TEST
@@ -414,10 +417,40 @@ void IRrecv::resume(void) {
   params.rawlen = 0;
   params.overflow = false;
 #if defined(ESP32)
-  timerAlarmDisable(timer);
+  if (timer != NULL) timerAlarmDisable(timer);
 #endif  // ESP32
 }
 
+#if defined(ESP32)
+/// Add a mark or space duration captured outside of the GPIO interrupt.
+/// The first call after resume() starts a new message.
+/// @param[in] usec The duration of the mark or space in micro-seconds.
+/// @return false when the capture buffer is full, or a message is waiting
+///   to be decoded.
+bool IRrecv::addCapturedDuration(const uint32_t usec) {
+  if (params.rcvstate == kStopState) return false;
+  if (params.rcvstate == kIdleState) {
+    params.rcvstate = kMarkState;
+    params.rawbuf[0] = 1;  // Gap before the message, not measured.
+    params.rawlen = 1;
+  }
+  params.rawbuf[params.rawlen++] = std::min(usec / kRawTick,
+                                            (uint32_t)UINT16_MAX);
+  if (params.rawlen >= params.bufsize) {
+    // Keep room for the terminating entry written by decode().
+    params.overflow = true;
+    params.rcvstate = kStopState;
+  }
+  return true;
+}
+
+/// Mark the message fed via addCapturedDuration() as complete,
+/// so it can be decoded.
+void IRrecv::markCaptureComplete(void) {
+  if (params.rawlen) params.rcvstate = kStopState;
+}
+#endif  // ESP32
+
 /// Make a copy of the interrupt state & buffer data.
 /// Needed because irparams is marked as volatile, thus memcpy() isn't allowed.
 /// Only call this when you know the interrupt handlers won't modify anything.
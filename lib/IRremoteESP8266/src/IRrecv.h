@@ -139,6 +139,12 @@ class IRrecv {
   void disableIRIn(void);
   void resume(void);
   uint16_t getBufSize(void);
+#if defined(ESP32)
+  // Feed durations captured by other hardware (e.g. the RMT peripheral)
+  // instead of using the GPIO interrupt. Don't call enableIRIn() then.
+  bool addCapturedDuration(const uint32_t usec);
+  void markCaptureComplete(void);
+#endif  // ESP32
 #if DECODE_HASH
   void setUnknownThreshold(const uint16_t length);
 #endif
@@ -41,6 +41,25 @@ IRsend::IRsend(uint16_t IRsendPin, bool inverted, bool use_modulation)
     _dutycycle = kDutyMax;
 }
 
+#if defined(ESP32)
+IRsendHardwareOutput *IRsend::_hardwareOutput = NULL;
+
+/// Set (or clear with NULL) the hardware output used by all IRsend instances
+/// for the pins it handles.
+/// @param[in] output Pointer to the hardware output, must outlive its use.
+void IRsend::setHardwareOutput(IRsendHardwareOutput *output) {
+  _hardwareOutput = output;
+}
+
+/// The hardware output to use for this instance, if any.
+/// @return NULL when the pin should be bit-banged.
+IRsendHardwareOutput *IRsend::hardwareOutput() const {
+  if (_hardwareOutput != NULL && _hardwareOutput->handlesPin(IRpin))
+    return _hardwareOutput;
+  return NULL;
+}
+#endif  // ESP32
+
 /// Enable the pin for output.
 void IRsend::begin() {
 #ifndef UNIT_TEST
@@ -106,6 +125,10 @@ void IRsend::enableIROut(uint32_t freq, uint8_t duty) {
   onTimePeriod = (period * _dutycycle) / kDutyMax;
   // Nr. of uSeconds the LED will be off per pulse.
   offTimePeriod = period - onTimePeriod;
+#if defined(ESP32)
+  IRsendHardwareOutput *output = hardwareOutput();
+  if (output != NULL) output->setCarrier(IRpin, freq, _dutycycle);
+#endif  // ESP32
 }
 
 #if ALLOW_DELAY_CALLS
@@ -155,6 +178,13 @@ void IRsend::_delayMicroseconds(uint32_t usec) {
 /// Ref:
 ///   https://www.analysir.com/blog/2017/01/29/updated-esp8266-nodemcu-backdoor-upwm-hack-for-ir-signals/
 uint16_t IRsend::mark(uint16_t usec) {
+#if defined(ESP32)
+  IRsendHardwareOutput *output = hardwareOutput();
+  if (output != NULL) {
+    output->mark(IRpin, usec);
+    return 1;
+  }
+#endif  // ESP32
   // Handle the simple case of no required frequency modulation.
   if (!modulation || _dutycycle >= 100) {
     ledOn();
@@ -192,6 +222,13 @@ uint16_t IRsend::mark(uint16_t usec) {
 /// A space is no output, so the PWM output is disabled.
 /// @param[in] time Time in microseconds (us).
 void IRsend::space(uint32_t time) {
+#if defined(ESP32)
+  IRsendHardwareOutput *output = hardwareOutput();
+  if (output != NULL) {
+    output->space(IRpin, time);
+    return;
+  }
+#endif  // ESP32
   ledOff();
   if (time == 0) return;
   _delayMicroseconds(time);
@@ -205,6 +205,25 @@ enum lg_ac_remote_model_t {
 
 // Classes
 
+#if defined(ESP32)
+/// Interface for hardware generated IR output (e.g. the ESP32 RMT peripheral).
+/// When set via IRsend::setHardwareOutput(), all IRsend instances sending on
+/// a GPIO pin it handles, hand their marks and spaces to it instead of
+/// bit-banging the pin. The output is responsible for the carrier and for
+/// (eventually) transmitting the marks and spaces.
+class IRsendHardwareOutput {
+ public:
+  virtual ~IRsendHardwareOutput() {}
+  virtual bool handlesPin(const uint16_t pin) const = 0;
+  /// @param[in] freq Carrier frequency in Hz.
+  /// @param[in] duty Duty cycle in percent, 100 = no modulation.
+  virtual void setCarrier(const uint16_t pin, const uint32_t freq,
+                          const uint8_t duty) = 0;
+  virtual void mark(const uint16_t pin, const uint32_t usec) = 0;
+  virtual void space(const uint16_t pin, const uint32_t usec) = 0;
+};
+#endif  // ESP32
+
 /// Class for sending all basic IR protocols.
 /// @note Originally from https://github.com/shirriff/Arduino-IRremote/
 ///  Updated by markszabo (https://github.com/crankyoldgit/IRremoteESP8266) for
@@ -220,6 +239,9 @@ class IRsend {
   VIRTUAL void space(uint32_t usec);
   int8_t calibrate(uint16_t hz = 38000U);
   void sendRaw(const uint16_t buf[], const uint16_t len, const uint16_t hz);
+#if defined(ESP32)
+  static void setHardwareOutput(IRsendHardwareOutput *output);
+#endif  // ESP32
   void sendData(uint16_t onemark, uint32_t onespace, uint16_t zeromark,
                 uint32_t zerospace, uint64_t data, uint16_t nbits,
                 bool MSBfirst = true);
@@ -864,6 +886,10 @@ class IRsend {
   uint8_t _dutycycle;
   bool modulation;
   uint32_t calcUSecPeriod(uint32_t hz, bool use_offset = true);
+#if defined(ESP32)
+  static IRsendHardwareOutput *_hardwareOutput;
+  IRsendHardwareOutput *hardwareOutput() const;
+#endif  // ESP32
 #if SEND_SONY
   void _sendSony(const uint64_t data, const uint16_t nbits,
                  const uint16_t repeat, const uint16_t freq);
@@ -314,6 +314,16 @@ bool IthoCC1101::checkForNewPacket() {
   return false;
 }
 
+bool IthoCC1101::receivePacket(CC1101Packet *packet) {
+  // receiveData() already flushes the fifo and switches back to RX state
+  return receiveData(packet, 63) != 0;
+}
+
+bool IthoCC1101::parsePacket(const CC1101Packet *packet) {
+  inMessage = *packet;
+  return parseMessageCommand();
+}
+
 bool IthoCC1101::parseMessageCommand() {
   // TODO nl0pvm: make this orcon proof?
   #if defined(CRC_FILTER)
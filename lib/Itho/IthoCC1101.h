@@ -105,6 +105,11 @@ public:
 
   // receive
   bool       checkForNewPacket(); // check RX fifo for new data
+
+  // Same as checkForNewPacket(), split in 2 steps so the RX fifo can be emptied as soon as possible
+  // and the packet decoded later.
+  bool receivePacket(CC1101Packet *packet);      // copy RX fifo into packet and restart RX, no decoding
+  bool parsePacket(const CC1101Packet *packet);  // decode a packet from receivePacket(), result via getLastCommand()/getLastIDstr()
   // IthoPacket getLastPacket() const {
   //   return inIthoPacket;
   // }                               // retrieve last received/parsed packet from remote
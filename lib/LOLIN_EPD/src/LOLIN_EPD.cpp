@@ -140,6 +140,40 @@ void LOLIN_EPD::fillbuffer(const unsigned char *black_image, const unsigned char
   // No action here
 }
 
+bool LOLIN_EPD::partialDisplay() {
+  return false; // Not supported
+}
+
+bool LOLIN_EPD::isBusy() {
+  return (busy >= 0) && (digitalRead(busy) != 0);
+}
+
+void LOLIN_EPD::setAsyncRefresh(bool async) {
+  asyncRefresh = async;
+}
+
+uint32_t LOLIN_EPD::bufferChecksum() const {
+  uint32_t hash = 2166136261u; // FNV-1a
+
+  for (int i = 0; i < bw_bufsize; i++) {
+    hash = (hash ^ bw_buf[i]) * 16777619u;
+  }
+  if (red_buf) {
+    for (int i = 0; i < red_bufsize; i++) {
+      hash = (hash ^ red_buf[i]) * 16777619u;
+    }
+  }
+  return hash;
+}
+
+bool LOLIN_EPD::deferBusy() {
+  if (asyncRefresh && (busy >= 0)) {
+    refreshPending = true;
+    return true;
+  }
+  return false;
+}
+
 /**************************************************************************/
 /*!
     @brief send an EPD command with no data
@@ -150,6 +184,16 @@ void LOLIN_EPD::fillbuffer(const unsigned char *black_image, const unsigned char
 /**************************************************************************/
 void LOLIN_EPD::sendCmd(uint8_t c)
 {
+  if (refreshPending)
+  {
+    // Previous refresh must be finished before the display accepts new commands
+    while (isBusy())
+    {
+      delay(1);
+    }
+    refreshPending = false;
+  }
+
   // SPI
   csHigh();
   dcLow();
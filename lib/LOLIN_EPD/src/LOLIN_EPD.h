@@ -73,6 +73,19 @@ public:
 
 	virtual void fillbuffer(const unsigned char *black_image, const unsigned char *red_image);
 
+	// Refresh using the partial update waveform, returns false if not supported by the display
+	virtual bool partialDisplay();
+
+	// Busy pin is active, the display is still refreshing
+	virtual bool isBusy();
+
+	// Return from display() once the refresh is started, the next command waits for the busy pin.
+	// Only used when a busy pin is configured.
+	void setAsyncRefresh(bool async);
+
+	// Checksum of the display buffer(s), to detect changes since the previous refresh
+	uint32_t bufferChecksum() const;
+
 protected:
   int8_t sid, ///< sid pin
       sclk,   ///< serial clock pin
@@ -90,6 +103,12 @@ protected:
   uint8_t *bw_buf  = nullptr;  ///< the pointer to the black and white buffer if using on-chip ram
   uint8_t *red_buf = nullptr; ///< the pointer to the red buffer if using on-chip ram
 
+  bool asyncRefresh   = false; ///< don't wait for the refresh to finish
+  bool refreshPending = false; ///< a refresh was started and not waited for yet
+
+  // Returns true if the wait for the refresh is deferred to the next command
+  bool deferBusy();
+
   void sendCmd(uint8_t c);
   void sendData(uint8_t data);
   uint8_t fastSPIwrite(uint8_t c);
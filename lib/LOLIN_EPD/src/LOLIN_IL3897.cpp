@@ -288,6 +288,11 @@ void LOLIN_IL3897::begin(bool reset)
 
 void LOLIN_IL3897::display()
 {
+    if (partialMode)
+    {
+        partialMode = false;
+        begin(false); // Restore the full update LUT
+    }
 
     sendCmd(0x24); //write RAM for black(0)/white (1)
 
@@ -303,7 +308,8 @@ void LOLIN_IL3897::update()
     sendCmd(0x22);
     sendData(0xC7);
     sendCmd(0x20);
-    readBusy();
+    if (!deferBusy())
+        readBusy();
 }
 
 /**************************************************************************/
@@ -400,6 +406,7 @@ void LOLIN_IL3897::readBusy()
         {
             if (digitalRead(busy) == 0)
                 break;
+            delay(0);
         }
     }
     else
@@ -418,6 +425,7 @@ void LOLIN_IL3897::selectLUT(uint8_t *wave_data)
 
 void LOLIN_IL3897::deepSleep()
 {
+    partialMode = false;
     sendCmd(0x10); //enter deep sleep
     sendData(0x01);
     delay(100);
@@ -474,7 +482,29 @@ void LOLIN_IL3897::partUpdate()
     sendCmd(0x22);
     sendData(0x0C);
     sendCmd(0x20);
-    readBusy();
+    if (!deferBusy())
+        readBusy();
+}
+
+bool LOLIN_IL3897::partialDisplay()
+{
+    if (!partialMode)
+    {
+        // Full refresh of the current buffer as base image, then load the partial update LUT
+        partInit();
+        partialMode = true;
+        return true;
+    }
+
+    sendCmd(0x24); //write RAM for black(0)/white (1)
+
+    for (uint16_t i = 0; i < bw_bufsize; i++)
+    {
+        sendData(bw_buf[i]);
+    }
+
+    partUpdate();
+    return true;
 }
 
 void LOLIN_IL3897::partDisplay(int16_t x_start, int16_t y_start, const unsigned char *datas, int16_t PART_COLUMN, int16_t PART_LINE)
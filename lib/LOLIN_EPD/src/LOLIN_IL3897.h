@@ -40,7 +40,10 @@ class LOLIN_IL3897 : public LOLIN_EPD {
 	void partDisplay(int16_t x_start, int16_t y_start, const unsigned char *datas, int16_t PART_COLUMN, int16_t PART_LINE);
 	void partUpdate();
 
+	bool partialDisplay();
+
 protected:
+	bool partialMode = false; // Partial update LUT is loaded
 	void readBusy();
 	void selectLUT(uint8_t * wave_data);
 	int _height_8bit;// height 8-bit alignment
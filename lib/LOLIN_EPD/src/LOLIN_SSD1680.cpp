@@ -140,7 +140,8 @@ void LOLIN_SSD1680::update()
     sendCmd(0x22); //Display Update Control
     sendData(0xF7);
     sendCmd(0x20); //Activate Display Update Sequence
-    readBusy();
+    if (!deferBusy())
+        readBusy();
 }
 
 /**************************************************************************/
@@ -240,6 +241,7 @@ void LOLIN_SSD1680::readBusy()
         {
             if (digitalRead(busy) == 0)
                 break;
+            delay(0);
         }
     }
     else
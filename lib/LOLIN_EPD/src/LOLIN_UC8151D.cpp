@@ -111,7 +111,8 @@ void LOLIN_UC8151D::update()
 {
     sendCmd(0x12);
     delay(100);
-    readBusy();
+    if (!deferBusy())
+        readBusy();
 }
 
 /**************************************************************************/
@@ -210,6 +211,7 @@ void LOLIN_UC8151D::readBusy()
         {
             if (digitalRead(busy) == 0)
                 break;
+            delay(0);
         }
     }
     else
@@ -227,7 +227,9 @@ void Waveshare_2in7::display() {
 void Waveshare_2in7::update() {
   sendCmd(WS2IN7_DISPLAY_REFRESH);
   delay(200);
-  readBusy();
+  if (!deferBusy()) {
+    readBusy();
+  }
 }
 
 /**************************************************************************/
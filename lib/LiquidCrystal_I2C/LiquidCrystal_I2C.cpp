@@ -12,6 +12,21 @@ inline size_t LiquidCrystal_I2C::write(uint8_t value) {
 	return 1;
 }
 
+size_t LiquidCrystal_I2C::write(const uint8_t *buffer, size_t size) {
+	size_t remaining = size;
+	while (remaining > 0) {
+		const size_t count = (remaining > LCD_I2C_BATCH_CHARS) ? LCD_I2C_BATCH_CHARS : remaining;
+		Wire.beginTransmission(_Addr);
+		for (size_t i = 0; i < count; ++i) {
+			queueByte(*buffer++, Rs);
+		}
+		Wire.endTransmission();
+		delayMicroseconds(50);	// last character needs > 37us to settle
+		remaining -= count;
+	}
+	return size;
+}
+
 #else
 #include "WProgram.h"
 
@@ -251,12 +266,23 @@ inline void LiquidCrystal_I2C::command(uint8_t value) {
 
 /************ low level data pushing commands **********/
 
-// write either command or data
+// write either command or data, both nibbles in a single I2C transmission
 void LiquidCrystal_I2C::send(uint8_t value, uint8_t mode) {
-	uint8_t highnib=value&0xf0;
-	uint8_t lownib=(value<<4)&0xf0;
-       write4bits((highnib)|mode);
-	write4bits((lownib)|mode);
+	Wire.beginTransmission(_Addr);
+	queueByte(value, mode);
+	Wire.endTransmission();
+	delayMicroseconds(50);		// commands need > 37us to settle
+}
+
+// Add both nibbles, each with an enable pulse, to the current I2C transmission.
+// The PCF8574 updates its outputs per received byte, so the enable pulse lasts one byte time (> 450ns).
+void LiquidCrystal_I2C::queueByte(uint8_t value, uint8_t mode) {
+	const uint8_t nibbles[2] = { (uint8_t)((value & 0xf0) | mode), (uint8_t)(((value << 4) & 0xf0) | mode) };
+	for (uint8_t i = 0; i < 2; ++i) {
+		printIIC((int)(nibbles[i]) | _backlightval);
+		printIIC((int)(nibbles[i] | En) | _backlightval);	// En high
+		printIIC((int)(nibbles[i] & ~En) | _backlightval);	// En low
+	}
 }
 
 void LiquidCrystal_I2C::write4bits(uint8_t value) {
@@ -52,6 +52,12 @@
 #define Rw B00000010  // Read/Write bit
 #define Rs B00000001  // Register select bit
 
+// Max. nr of characters sent in a single I2C transmission, 6 expander bytes per character.
+// Must fit in the Wire buffer and keep > 37 usec between characters, true up to 400 kHz.
+#ifndef LCD_I2C_BATCH_CHARS
+#define LCD_I2C_BATCH_CHARS 16
+#endif
+
 class LiquidCrystal_I2C : public Print {
 public:
   LiquidCrystal_I2C(uint8_t lcd_Addr,uint8_t lcd_cols,uint8_t lcd_rows);
@@ -83,6 +89,9 @@ public:
   void setCursor(uint8_t, uint8_t); 
 #if defined(ARDUINO) && ARDUINO >= 100
   virtual size_t write(uint8_t);
+  // Send multiple characters, batched in as few I2C transmissions as possible
+  virtual size_t write(const uint8_t *buffer, size_t size);
+  using Print::write;
 #else
   virtual void write(uint8_t);
 #endif
@@ -115,6 +124,7 @@ private:
   void init_priv();
   void send(uint8_t, uint8_t);
   void write4bits(uint8_t);
+  void queueByte(uint8_t, uint8_t);
   void expanderWrite(uint8_t);
   void pulseEnable(uint8_t);
   uint8_t _Addr;
@@ -255,6 +255,8 @@ void MD_MAX72XX::flushBufferAll()
 // efficient to send a data byte all devices at the same time, substantially cutting
 // the number of communication messages required.
 {
+  bool bTransaction = false; // one SPI transaction for all rows, only CS is toggled per row
+
   for (uint8_t i=0; i<ROW_SIZE; i++)  // all data rows
   {
     bool bChange = false; // set to true if we detected a change
@@ -272,9 +274,24 @@ void MD_MAX72XX::flushBufferAll()
       }
     }
 
-  if (bChange) spiSend();
+  if (bChange)
+  {
+#ifdef ARDUINO
+    if (_hardwareSPI && !bTransaction)
+    {
+      _spiRef.beginTransaction(SPISettings(8000000, MSBFIRST, SPI_MODE0));
+      bTransaction = true;
+    }
+#endif
+    spiSend(bTransaction);
+  }
   }
 
+#ifdef ARDUINO
+  if (bTransaction)
+    _spiRef.endTransaction();
+#endif
+
   // mark everything as cleared
   for (uint8_t dev = FIRST_BUFFER; dev <= LAST_BUFFER; dev++)
     _matrix[dev].changed = ALL_CLEAR;
@@ -313,19 +330,25 @@ inline void MD_MAX72XX::spiClearBuffer(void)
   memset(_spiData, OP_NOOP, SPI_DATA_SIZE);
 }
 
-void MD_MAX72XX::spiSend(void)
+void MD_MAX72XX::spiSend(bool inTransaction)
+// inTransaction is set when the caller already started the SPI transaction
 {
 #ifdef ARDUINO
   // initialize the SPI transaction
-  if (_hardwareSPI)
+  if (_hardwareSPI && !inTransaction)
     _spiRef.beginTransaction(SPISettings(8000000, MSBFIRST, SPI_MODE0));
   digitalWrite(_csPin, LOW);
 
   // shift out the data
   if (_hardwareSPI)
   {
+#if defined(ESP8266) || defined(ESP32)
+    // block write, no per-byte transfer overhead
+    _spiRef.writeBytes(_spiData, SPI_DATA_SIZE);
+#else
     for (uint16_t i = 0; i < SPI_DATA_SIZE; i++)
       _spiRef.transfer(_spiData[i]);
+#endif
   }
   else  // not hardware SPI - bit bash it out
   {
@@ -335,7 +358,7 @@ void MD_MAX72XX::spiSend(void)
 
   // end the SPI transaction
   digitalWrite(_csPin, HIGH);
-  if (_hardwareSPI)
+  if (_hardwareSPI && !inTransaction)
     _spiRef.endTransaction();
 #else
   _cs = 0;
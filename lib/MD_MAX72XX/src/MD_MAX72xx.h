@@ -1055,7 +1055,7 @@ private:
 #endif
 
   // Private functions
-  void spiSend(void);         // do the actual physical communications task
+  void spiSend(bool inTransaction = false); // do the actual physical communications task
   inline void spiClearBuffer(void);  // clear the SPI send buffer
   void controlHardware(uint8_t dev, controlRequest_t mode, int value);  // set hardware control commands
   void controlLibrary(controlRequest_t mode, int value);  // set internal control commands
@@ -42,6 +42,18 @@ ShiftRegister74HC595_NonTemplate::ShiftRegister74HC595_NonTemplate(const uint8_t
   // updateRegisters(); // reset shift register
 }
 
+// Constructor using the hardware SPI peripheral, SPI must already be initialized
+ShiftRegister74HC595_NonTemplate::ShiftRegister74HC595_NonTemplate(const uint8_t  size,
+                                                                   SPIClass     & spi,
+                                                                   const uint8_t  latchPin,
+                                                                   const uint32_t spiFrequency) :
+  _size(size), _clockPin(0), _serialDataPin(0), _latchPin(latchPin), _spi(&spi), _spiFrequency(spiFrequency) {
+  pinMode(_latchPin, OUTPUT);
+  digitalWrite(_latchPin, LOW);
+
+  _digitalValues.resize(_size, 0);
+}
+
 // Set a new size for the mnumber of shift registers
 void ShiftRegister74HC595_NonTemplate::setSize(const uint8_t size) {
   _size = size;
@@ -79,8 +91,20 @@ void ShiftRegister74HC595_NonTemplate::set(const uint8_t pin, const uint16_t val
 // Updates the shift register pins to the stored output values.
 // This is the function that actually writes data into the shift registers of the 74HC595.
 void ShiftRegister74HC595_NonTemplate::updateRegisters() {
-  for (int i = _size - 1; i >= 0; i--) {
-    shiftOut(_serialDataPin, _clockPin, MSBFIRST, _digitalValues[i]);
+  if (nullptr != _spi) {
+    // Send the whole chain in a single burst
+    _spiBuffer.resize(_size);
+
+    for (int i = 0; i < _size; i++) {
+      _spiBuffer[i] = _digitalValues[_size - 1 - i];
+    }
+    _spi->beginTransaction(SPISettings(_spiFrequency, MSBFIRST, SPI_MODE0));
+    _spi->writeBytes(&_spiBuffer[0], _size);
+    _spi->endTransaction();
+  } else {
+    for (int i = _size - 1; i >= 0; i--) {
+      shiftOut(_serialDataPin, _clockPin, MSBFIRST, _digitalValues[i]);
+    }
   }
 
   digitalWrite(_latchPin, HIGH);
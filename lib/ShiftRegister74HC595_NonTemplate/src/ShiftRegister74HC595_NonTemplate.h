@@ -8,6 +8,7 @@
 #pragma once
 
 #include <Arduino.h>
+#include <SPI.h>
 #include <vector>
 
 class ShiftRegister74HC595_NonTemplate {
@@ -18,6 +19,12 @@ public:
                                    const uint8_t clockPin,
                                    const uint8_t latchPin);
 
+  // Use the hardware SPI peripheral, MOSI -> DS, SCK -> SH_CP
+  ShiftRegister74HC595_NonTemplate(const uint8_t  size,
+                                   SPIClass     & spi,
+                                   const uint8_t  latchPin,
+                                   const uint32_t spiFrequency = 4000000);
+
   void           setSize(const uint8_t size);
   void           setAll(const uint8_t *digitalValues,
                         bool           update = true);
@@ -42,5 +49,9 @@ private:
   uint8_t _serialDataPin;
   uint8_t _latchPin;
 
+  SPIClass *_spi          = nullptr;
+  uint32_t  _spiFrequency = 0;
+
   std::vector<uint8_t>_digitalValues;
+  std::vector<uint8_t>_spiBuffer; // Values in transfer order, last chip first
 };
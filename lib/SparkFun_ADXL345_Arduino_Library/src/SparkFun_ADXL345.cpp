@@ -740,6 +740,40 @@ byte ADXL345::get_bw_code() {
   return bw_code;
 }
 
+/****************************** FIFO ********************************/
+/*                   ~ SET MODE, GET ENTRIES, READ                  */
+void ADXL345::setFIFOMode(byte fifoMode, byte samples) {
+  writeTo(ADXL345_FIFO_CTL, (fifoMode & B11000000) | (samples & B00011111));
+}
+
+byte ADXL345::getFIFOEntries() {
+  byte _b;
+
+  readFrom(ADXL345_FIFO_STATUS, 1, &_b);
+  return _b & B00111111;
+}
+
+byte ADXL345::readFIFO(int16_t *xyz, byte maxEntries) {
+  byte entries = getFIFOEntries();
+
+  if (entries > maxEntries) {
+    entries = maxEntries;
+  }
+
+  for (byte i = 0; i < entries; ++i) {
+    if (!I2C) {
+      delayMicroseconds(5); // Minimal time between reads of the FIFO via SPI
+    }
+
+    // Each read of the 6 data registers pops one entry from the FIFO
+    readFrom(ADXL345_DATAX0, ADXL345_TO_READ, _buff);
+    *xyz++ = (int16_t)((((int)_buff[1]) << 8) | _buff[0]);
+    *xyz++ = (int16_t)((((int)_buff[3]) << 8) | _buff[2]);
+    *xyz++ = (int16_t)((((int)_buff[5]) << 8) | _buff[4]);
+  }
+  return entries;
+}
+
 /************************* TRIGGER CHECK  ***************************/
 /*                                                                  */
 
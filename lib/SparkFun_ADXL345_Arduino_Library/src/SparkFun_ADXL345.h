@@ -54,6 +54,13 @@
 # define ADXL345_FIFO_CTL                0x38         // FIFO Control
 # define ADXL345_FIFO_STATUS             0x39         // FIFO Status
 
+/************************** FIFO MODES *****************************/
+# define ADXL345_FIFO_MODE_BYPASS        0x00         // FIFO not used
+# define ADXL345_FIFO_MODE_FIFO          0x40         // Collect up to 32 samples, then stop
+# define ADXL345_FIFO_MODE_STREAM        0x80         // Keep the last 32 samples
+# define ADXL345_FIFO_MODE_TRIGGER       0xC0         // Keep samples around a trigger event
+# define ADXL345_FIFO_SIZE               32
+
 # define ADXL345_BW_1600                 0xF          // 1111		IDD = 40uA
 # define ADXL345_BW_800                  0xE          // 1110		IDD = 90uA
 # define ADXL345_BW_400                  0xD          // 1101		IDD = 140uA
@@ -203,6 +210,15 @@ public:
   void   set_bw(byte bw_code);
   byte   get_bw_code();
 
+  // FIFO, samples: number of entries that trigger the watermark interrupt (1..31)
+  void   setFIFOMode(byte fifoMode,
+                     byte samples);
+  byte   getFIFOEntries();
+
+  // Read up to maxEntries samples (X, Y, Z) from the FIFO, returns the number of samples read
+  byte   readFIFO(int16_t *xyz,
+                  byte     maxEntries);
+
   bool   triggered(byte interrupts,
                    int  mask);
 
@@ -52,6 +52,11 @@
 #endif
 #define DISPLAY_BUFFER_SIZE ((DISPLAY_WIDTH) * (DISPLAY_HEIGHT) / 8)
 
+// Nr of display data bytes per I2C transmission, plus the control byte it must fit in the Wire buffer
+#ifndef OLEDDISPLAY_I2C_CHUNK_SIZE
+  #define OLEDDISPLAY_I2C_CHUNK_SIZE 64
+#endif
+
 // Header Values
 #define JUMPTABLE_BYTES 4
 
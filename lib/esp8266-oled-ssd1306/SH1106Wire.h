@@ -102,7 +102,7 @@ class SH1106Wire : public OLEDDisplay {
             }
             Wire.write(buffer[x + y * DISPLAY_WIDTH]);
             k++;
-            if (k == 16)  {
+            if (k == OLEDDISPLAY_I2C_CHUNK_SIZE)  {
               Wire.endTransmission();
               k = 0;
             }
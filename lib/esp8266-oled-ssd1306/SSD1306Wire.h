@@ -98,7 +98,7 @@ class SSD1306Wire : public OLEDDisplay {
             }
             Wire.write(buffer[x + y * this->width()]);
             k++;
-            if (k == 16)  {
+            if (k == OLEDDISPLAY_I2C_CHUNK_SIZE)  {
               Wire.endTransmission();
               k = 0;
             }
@@ -8,6 +8,17 @@ function decodeUplink(input) {
   if (input.bytes.length === 0) {
     // Do nothing
   } else {
+    if (input.fPort === 2) {
+      // Combined messages, each: 1 byte length + packed data as sent on port 1
+      data.messages = [];
+      var pos = 0;
+      while (pos < input.bytes.length) {
+        var len = input.bytes[pos];
+        var message = decodeUplink({ bytes: input.bytes.slice(pos + 1, pos + 1 + len), fPort: 1 });
+        data.messages.push(message.data);
+        pos += 1 + len;
+      }
+    }
     if (input.fPort === 1) {
       switch (input.bytes[0]) {
         case 26:
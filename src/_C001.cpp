@@ -22,6 +22,7 @@ bool CPlugin_001(CPlugin::Function function, struct EventStruct *event, String&
     {
       ProtocolStruct& proto = getProtocolStruct(event->idx); //      = CPLUGIN_ID_001;
       proto.usesMQTT     = false;
+      proto.usesHTTP     = true;
       proto.usesAccount  = true;
       proto.usesPassword = true;
       proto.usesExtCreds = true;
@@ -19,6 +19,7 @@ bool CPlugin_004(CPlugin::Function function, struct EventStruct *event, String&
     {
       ProtocolStruct& proto = getProtocolStruct(event->idx); //      = CPLUGIN_ID_004;
       proto.usesMQTT     = false;
+      proto.usesHTTP     = true;
       proto.usesAccount  = true;
       proto.usesPassword = true;
       proto.defaultPort  = 80;
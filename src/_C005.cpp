@@ -4,6 +4,8 @@
 # include "src/Commands/InternalCommands.h"
 # include "src/Globals/EventQueue.h"
 # include "src/Helpers/PeriodicalActions.h"
+# include "src/Helpers/_CPlugin_CBOR_helper.h"
+# include "src/Helpers/CRC_functions.h"
 # include "src/Helpers/StringParser.h"
 # include "_Plugin_Helper.h"
 
@@ -17,8 +19,23 @@
 
 String CPlugin_005_pubname;
 bool   CPlugin_005_mqtt_retainFlag = false;
+bool   CPlugin_005_aggregateValues = false;
+
+# if FEATURE_MQTT_CBOR_PAYLOAD
+bool     CPlugin_005_sendBinary = false;
+uint32_t CPlugin_005_schemaCRC[TASKS_MAX]{}; // CRC of the last published schema per task
+# endif // if FEATURE_MQTT_CBOR_PAYLOAD
 
 bool C005_parse_command(struct EventStruct *event);
+void C005_remove_valname(String& topic);
+bool C005_publish_aggregated(struct EventStruct *event,
+                             String           && topic,
+                             bool                mqtt_retainFlag);
+# if FEATURE_MQTT_CBOR_PAYLOAD
+bool C005_publish_binary(struct EventStruct *event,
+                         const String      & pubname,
+                         bool                mqtt_retainFlag);
+# endif // if FEATURE_MQTT_CBOR_PAYLOAD
 
 bool CPlugin_005(CPlugin::Function function, struct EventStruct *event, String& string)
 {
@@ -48,6 +65,22 @@ bool CPlugin_005(CPlugin::Function function, struct EventStruct *event, String&
     case CPlugin::Function::CPLUGIN_INIT:
     {
       success = init_mqtt_delay_queue(event->ControllerIndex, CPlugin_005_pubname, CPlugin_005_mqtt_retainFlag);
+
+      if (success) {
+        MakeControllerSettings(ControllerSettings); //-V522
+
+        if (AllocatedControllerSettings()) {
+          LoadControllerSettings(event->ControllerIndex, *ControllerSettings);
+          CPlugin_005_aggregateValues = ControllerSettings->mqtt_aggregateValues();
+          # if FEATURE_MQTT_CBOR_PAYLOAD
+          CPlugin_005_sendBinary = ControllerSettings->sendBinary();
+
+          for (taskIndex_t x = 0; x < TASKS_MAX; ++x) {
+            CPlugin_005_schemaCRC[x] = 0;
+          }
+          # endif // if FEATURE_MQTT_CBOR_PAYLOAD
+        }
+      }
       break;
     }
 
@@ -57,6 +90,23 @@ bool CPlugin_005(CPlugin::Function function, struct EventStruct *event, String&
       break;
     }
 
+    case CPlugin::Function::CPLUGIN_WEBFORM_LOAD:
+    {
+      // Place in scope to delete ControllerSettings as soon as it is no longer needed
+      MakeControllerSettings(ControllerSettings); //-V522
+
+      if (AllocatedControllerSettings()) {
+        LoadControllerSettings(event->ControllerIndex, *ControllerSettings);
+        addControllerParameterForm(*ControllerSettings, event->ControllerIndex, ControllerSettingsStruct::CONTROLLER_MQTT_AGGREGATE_VALUES);
+        addFormNote(F("Publish all values of a task as one JSON message. Topic is Controller Publish without %valname%"));
+        # if FEATURE_MQTT_CBOR_PAYLOAD
+        addControllerParameterForm(*ControllerSettings, event->ControllerIndex, ControllerSettingsStruct::CONTROLLER_SEND_BINARY);
+        addFormNote(F("Publish values as CBOR. A JSON description of the values is published to Controller Publish without %valname%, followed by /$schema"));
+        # endif // if FEATURE_MQTT_CBOR_PAYLOAD
+      }
+      break;
+    }
+
     case CPlugin::Function::CPLUGIN_PROTOCOL_TEMPLATE:
     {
       event->String1 = F("%sysname%/#");
@@ -86,6 +136,19 @@ bool CPlugin_005(CPlugin::Function function, struct EventStruct *event, String&
 
       parseControllerVariables(pubname, event, false);
 
+      # if FEATURE_MQTT_CBOR_PAYLOAD
+
+      if (CPlugin_005_sendBinary && (event->sensorType != Sensor_VType::SENSOR_TYPE_STRING)) {
+        success = C005_publish_binary(event, pubname, mqtt_retainFlag);
+        break;
+      }
+      # endif // if FEATURE_MQTT_CBOR_PAYLOAD
+
+      if (CPlugin_005_aggregateValues && (event->sensorType != Sensor_VType::SENSOR_TYPE_STRING)) {
+        success = C005_publish_aggregated(event, std::move(pubname), mqtt_retainFlag);
+        break;
+      }
+
       uint8_t valueCount = getValueCountForTask(event->TaskIndex);
 
       for (uint8_t x = 0; x < valueCount; x++)
@@ -140,6 +203,104 @@ bool CPlugin_005(CPlugin::Function function, struct EventStruct *event, String&
   return success;
 }
 
+// Remove %valname% from the topic, e.g. "%sysname%/%tskname%/%valname%" becomes "%sysname%/%tskname%"
+void C005_remove_valname(String& topic) {
+  topic.replace(F("%valname%"), EMPTY_STRING);
+  topic.replace(F("//"), F("/"));
+
+  if (topic.endsWith(F("/"))) {
+    topic.remove(topic.length() - 1);
+  }
+}
+
+// Publish all task values as a single JSON object, like {"Temperature":21.50,"Humidity":45.2}
+// The topic is the publish template with %valname% removed, e.g. "%sysname%/%tskname%"
+bool C005_publish_aggregated(struct EventStruct *event, String&& topic, bool mqtt_retainFlag) {
+  C005_remove_valname(topic);
+
+  const uint8_t valueCount = getValueCountForTask(event->TaskIndex);
+  String payload;
+
+  payload.reserve(16 * valueCount + 2);
+  payload += '{';
+
+  for (uint8_t x = 0; x < valueCount; x++)
+  {
+    const String valueName = getTaskValueName(event->TaskIndex, x);
+
+    // Skip values with empty labels, same as when publishing separate values
+    if (valueName.isEmpty()) {
+      continue;
+    }
+
+    if (payload.length() > 1) {
+      payload += ',';
+    }
+    payload += to_json_object_value(valueName, formatUserVarNoCheck(event, x));
+  }
+  payload += '}';
+
+  if (payload.length() <= 2) {
+    return false;
+  }
+# ifndef BUILD_NO_DEBUG
+
+  if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+    addLogMove(LOG_LEVEL_DEBUG, strformat(F("MQTT : %s %s"), topic.c_str(), payload.c_str()));
+  }
+# endif // ifndef BUILD_NO_DEBUG
+
+  return MQTTpublish(event->ControllerIndex, event->TaskIndex, std::move(topic), std::move(payload), mqtt_retainFlag);
+}
+
+# if FEATURE_MQTT_CBOR_PAYLOAD
+
+// Publish the task values encoded as CBOR, either per value or as a map when aggregating values.
+// The schema describing the values is published (retained) whenever it changes.
+bool C005_publish_binary(struct EventStruct *event, const String& pubname, bool mqtt_retainFlag) {
+  String baseTopic = pubname;
+
+  C005_remove_valname(baseTopic);
+
+  if (validTaskIndex(event->TaskIndex)) {
+    String schema      = CBOR_getTaskSchema(event);
+    const uint32_t crc = calc_CRC32(reinterpret_cast<const uint8_t *>(schema.c_str()), schema.length());
+
+    if (crc != CPlugin_005_schemaCRC[event->TaskIndex]) {
+      String schemaTopic = baseTopic;
+      schemaTopic += F("/$schema");
+
+      if (MQTTpublish(event->ControllerIndex, event->TaskIndex, std::move(schemaTopic), std::move(schema), true)) {
+        CPlugin_005_schemaCRC[event->TaskIndex] = crc;
+      }
+    }
+  }
+
+  if (CPlugin_005_aggregateValues) {
+    return MQTTpublish(event->ControllerIndex, event->TaskIndex, std::move(baseTopic), CBOR_encodeTaskValues(event), mqtt_retainFlag);
+  }
+
+  bool success             = false;
+  const uint8_t valueCount = getValueCountForTask(event->TaskIndex);
+
+  for (uint8_t x = 0; x < valueCount; x++)
+  {
+    // Skip values with empty labels, same as when publishing as text
+    if (getTaskValueName(event->TaskIndex, x).isEmpty()) {
+      continue;
+    }
+    String tmppubname = pubname;
+    parseSingleControllerVariable(tmppubname, event, x, false);
+
+    if (MQTTpublish(event->ControllerIndex, event->TaskIndex, std::move(tmppubname), CBOR_encodeTaskValue(event, x), mqtt_retainFlag)) {
+      success = true;
+    }
+  }
+  return success;
+}
+
+# endif // if FEATURE_MQTT_CBOR_PAYLOAD
+
 bool C005_parse_command(struct EventStruct *event) {
   // FIXME TD-er: Command is not parsed for template arguments.
 
@@ -22,6 +22,7 @@ bool CPlugin_007(CPlugin::Function function, struct EventStruct *event, String&
     {
       ProtocolStruct& proto = getProtocolStruct(event->idx); //      = CPLUGIN_ID_007;
       proto.usesMQTT     = false;
+      proto.usesHTTP     = true;
       proto.usesAccount  = false;
       proto.usesPassword = true;
       proto.defaultPort  = 80;
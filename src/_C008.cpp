@@ -20,6 +20,7 @@ bool CPlugin_008(CPlugin::Function function, struct EventStruct *event, String&
     {
       ProtocolStruct& proto = getProtocolStruct(event->idx); //      = CPLUGIN_ID_008;
       proto.usesMQTT     = false;
+      proto.usesHTTP     = true;
       proto.usesTemplate = true;
       proto.usesAccount  = true;
       proto.usesPassword = true;
@@ -80,35 +81,31 @@ bool CPlugin_008(CPlugin::Function function, struct EventStruct *event, String&
       
       uint8_t valueCount = getValueCountForTask(event->TaskIndex);
       std::unique_ptr<C008_queue_element> element(new C008_queue_element(event, valueCount));
-      success = C008_DelayHandler->addToQueue(std::move(element));
 
-      if (success) {
-        // Element was added.
-        // Now we try to append to the existing element
-        // and thus preventing the need to create a long string only to copy it to a queue element.
-        C008_queue_element& element = static_cast<C008_queue_element&>(*(C008_DelayHandler->sendQueue.back()));
-
-        // Collect the values at the same run, to make sure all are from the same sample
-        //LoadTaskSettings(event->TaskIndex); // FIXME TD-er: This can probably be removed
-        parseControllerVariables(pubname, event, true);
-
-        for (uint8_t x = 0; x < valueCount; x++)
-        {
-          bool   isvalid;
-          const String formattedValue = formatUserVar(event, x, isvalid);
-
-          if (isvalid) {
-            element.txt[x]  = '/';
-            element.txt[x] += pubname;
-            parseSingleControllerVariable(element.txt[x], event, x, true);
-            element.txt[x].replace(F("%value%"), formattedValue);
+      // Collect the values at the same run, to make sure all are from the same sample
+      //LoadTaskSettings(event->TaskIndex); // FIXME TD-er: This can probably be removed
+      parseControllerVariables(pubname, event, true);
+
+      // Fill the element before adding it to the queue.
+      // The queue may be processed from another task, so the element may no longer be accessed once queued.
+      for (uint8_t x = 0; x < valueCount; x++)
+      {
+        bool   isvalid;
+        const String formattedValue = formatUserVar(event, x, isvalid);
+
+        if (isvalid) {
+          element->txt[x]  = '/';
+          element->txt[x] += pubname;
+          parseSingleControllerVariable(element->txt[x], event, x, true);
+          element->txt[x].replace(F("%value%"), formattedValue);
 # ifndef BUILD_NO_DEBUG
-            if (loglevelActiveFor(LOG_LEVEL_DEBUG_MORE))
-              addLog(LOG_LEVEL_DEBUG_MORE, element.txt[x]);
+          if (loglevelActiveFor(LOG_LEVEL_DEBUG_MORE))
+            addLog(LOG_LEVEL_DEBUG_MORE, element->txt[x]);
 # endif // ifndef BUILD_NO_DEBUG
-          }
         }
       }
+      success = C008_DelayHandler->addToQueue(std::move(element));
+
       Scheduler.scheduleNextDelayQueue(SchedulerIntervalTimer_e::TIMER_C008_DELAY_QUEUE, C008_DelayHandler->getNextScheduleTime());
       break;
     }
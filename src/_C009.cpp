@@ -46,6 +46,7 @@ bool CPlugin_009(CPlugin::Function function, struct EventStruct *event, String&
     {
       ProtocolStruct& proto = getProtocolStruct(event->idx); //      = CPLUGIN_ID_009;
       proto.usesMQTT     = false;
+      proto.usesHTTP     = true;
       proto.usesTemplate = false;
       proto.usesAccount  = true;
       proto.usesPassword = true;
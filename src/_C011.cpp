@@ -51,6 +51,7 @@ bool CPlugin_011(CPlugin::Function function, struct EventStruct *event, String&
     {
       ProtocolStruct& proto = getProtocolStruct(event->idx); //      = CPLUGIN_ID_011;
       proto.usesMQTT     = false;
+      proto.usesHTTP     = true;
       proto.usesAccount  = true;
       proto.usesPassword = true;
       proto.usesExtCreds = true;
@@ -261,39 +262,34 @@ boolean Create_schedule_HTTP_C011(struct EventStruct *event)
   }
   //LoadTaskSettings(event->TaskIndex); // FIXME TD-er: This can probably be removed
 
-  // Add a new element to the queue with the minimal payload
+  // Fill the element before adding it to the queue.
+  // The queue may be processed from another task, so the element may no longer be accessed once queued.
   std::unique_ptr<C011_queue_element> element(new C011_queue_element(event));
-  bool success = C011_DelayHandler->addToQueue(std::move(element));
 
-  if (success) {
-    // Element was added.
-    // Now we try to append to the existing element
-    // and thus preventing the need to create a long string only to copy it to a queue element.
-    C011_queue_element& element = static_cast<C011_queue_element&>(*(C011_DelayHandler->sendQueue.back()));
+  if (!load_C011_ConfigStruct(event->ControllerIndex, element->HttpMethod, element->uri, element->header, element->postStr))
+  {
+    if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+      String log = F("C011   : ");
+      log += element->HttpMethod;
+      log += element->uri;
+      log += element->header;
+      log += element->postStr;
+      addLogMove(LOG_LEVEL_ERROR, log);
+    }
+    return false;
+  }
 
+  ReplaceTokenByValue(element->uri,    event, false);
+  ReplaceTokenByValue(element->header, event, false);
 
-    if (!load_C011_ConfigStruct(event->ControllerIndex, element.HttpMethod, element.uri, element.header, element.postStr))
-    {
-      if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
-        String log = F("C011   : ");
-        log += element.HttpMethod;
-        log += element.uri;
-        log += element.header;
-        log += element.postStr;
-        addLogMove(LOG_LEVEL_ERROR, log);
-      }
-      C011_DelayHandler->sendQueue.pop_back();
-      return false;
-    }
+  if (element->postStr.length() > 0)
+  {
+    ReplaceTokenByValue(element->postStr, event, C011_sendBinary);
+  }
 
-    ReplaceTokenByValue(element.uri,    event, false);
-    ReplaceTokenByValue(element.header, event, false);
+  const bool success = C011_DelayHandler->addToQueue(std::move(element));
 
-    if (element.postStr.length() > 0)
-    {
-      ReplaceTokenByValue(element.postStr, event, C011_sendBinary);
-    }
-  } else {
+  if (!success) {
     addLog(LOG_LEVEL_ERROR, F("C011  : Could not add to delay handler"));
   }
 
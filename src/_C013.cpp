@@ -12,6 +12,16 @@
 # include "src/Helpers/Misc.h"
 # include "src/Helpers/Network.h"
 
+# if FEATURE_C013_COMPACT_DATA
+#  include "src/Globals/Cache.h"
+#  include "src/Globals/Device.h"
+#  include "src/Helpers/ESPEasy_time_calc.h"
+#  include "src/Helpers/Numerical.h"
+
+#  include <map>
+#  include <vector>
+# endif // if FEATURE_C013_COMPACT_DATA
+
 // #######################################################################################################
 // ########################### Controller Plugin 013: ESPEasy P2P network ################################
 // #######################################################################################################
@@ -22,6 +32,50 @@
 
 WiFiUDP C013_portUDP;
 
+# if FEATURE_C013_COMPACT_DATA
+
+// Send all values of a task after this many compact updates of the task.
+// This also recovers values lost in the last packet, which cannot be detected by a sequence gap.
+#  define C013_FULL_UPDATE_INTERVAL        20
+
+// Min. time in msec between refresh requests to the same unit.
+#  define C013_REFRESH_INTERVAL_MISSED     1000
+
+// A unit sending the old sensor data format is asked less frequently, as it may not support the compact format.
+#  define C013_REFRESH_INTERVAL_OLD_FORMAT 300000
+
+// Values last sent of a task, to leave out the values that did not change.
+struct C013_TaskSentState {
+  TaskValues_Data_t values{};
+  uint8_t           nrCompactUpdates = 0;
+  bool              valid            = false;
+};
+
+struct C013_PeerState {
+  unsigned long lastRefreshRequest   = 0;
+  uint16_t      sentSequence         = 0;
+  uint16_t      receivedSequence     = 0;
+  bool          hasReceivedSequence  = false;
+
+  // The unit sent a refresh request, so it can receive the compact format.
+  bool          compactCapable       = false;
+  bool          needsFullUpdate      = false;
+};
+
+bool C013_compactData = false;
+
+// Tasks to send on the next CPLUGIN_TEN_PER_SECOND call, so multiple tasks can be combined in a single packet.
+std::vector<taskIndex_t> C013_pendingTasks;
+std::vector<C013_TaskSentState> C013_taskSentState;
+std::map<uint8_t, C013_PeerState> C013_peers;
+
+void C013_SendPendingTasks();
+void C013_ReceiveMultiData(struct EventStruct *event);
+void C013_SendRefreshRequest(uint8_t         unit,
+                             C013_PeerState& peer,
+                             unsigned long   minInterval);
+# endif // if FEATURE_C013_COMPACT_DATA
+
 // Forward declarations
 void C013_SendUDPTaskInfo(uint8_t destUnit,
                           uint8_t sourceTaskIndex,
@@ -33,6 +87,8 @@ void C013_sendUDP(uint8_t        unit,
                   const uint8_t *data,
                   uint8_t        size);
 void C013_Receive(struct EventStruct *event);
+bool C013_ApplySensorData(const C013_SensorDataStruct& dataReply,
+                          uint8_t                      slotMask);
 
 
 bool CPlugin_013(CPlugin::Function function, struct EventStruct *event, String& string)
@@ -61,6 +117,47 @@ bool CPlugin_013(CPlugin::Function function, struct EventStruct *event, String&
       break;
     }
 
+# if FEATURE_C013_COMPACT_DATA
+    case CPlugin::Function::CPLUGIN_INIT:
+    {
+      MakeControllerSettings(ControllerSettings); //-V522
+
+      if (AllocatedControllerSettings()) {
+        LoadControllerSettings(event->ControllerIndex, *ControllerSettings);
+        C013_compactData = ControllerSettings->p2p_compactData();
+      }
+      success = true;
+      break;
+    }
+
+    case CPlugin::Function::CPLUGIN_EXIT:
+    {
+      C013_compactData = false;
+      C013_pendingTasks.clear();
+      C013_taskSentState.clear();
+      C013_peers.clear();
+      break;
+    }
+
+    case CPlugin::Function::CPLUGIN_WEBFORM_LOAD:
+    {
+      MakeControllerSettings(ControllerSettings); //-V522
+
+      if (AllocatedControllerSettings()) {
+        LoadControllerSettings(event->ControllerIndex, *ControllerSettings);
+        addControllerParameterForm(*ControllerSettings, event->ControllerIndex, ControllerSettingsStruct::CONTROLLER_P2P_COMPACT_DATA);
+        addFormNote(F("Combine tasks in a single packet and leave out unchanged values. Only sent to nodes with this option enabled"));
+      }
+      break;
+    }
+
+    case CPlugin::Function::CPLUGIN_TEN_PER_SECOND:
+    {
+      C013_SendPendingTasks();
+      break;
+    }
+# endif // if FEATURE_C013_COMPACT_DATA
+
     case CPlugin::Function::CPLUGIN_TASK_CHANGE_NOTIFICATION:
     {
       C013_SendUDPTaskInfo(0, event->TaskIndex, event->TaskIndex);
@@ -69,6 +166,23 @@ bool CPlugin_013(CPlugin::Function function, struct EventStruct *event, String&
 
     case CPlugin::Function::CPLUGIN_PROTOCOL_SEND:
     {
+# if FEATURE_C013_COMPACT_DATA
+
+      if (C013_compactData) {
+        // Sent on the next CPLUGIN_TEN_PER_SECOND call
+        bool found = false;
+
+        for (auto it = C013_pendingTasks.begin(); !found && it != C013_pendingTasks.end(); ++it) {
+          found = *it == event->TaskIndex;
+        }
+
+        if (!found) {
+          C013_pendingTasks.push_back(event->TaskIndex);
+        }
+        success = true;
+        break;
+      }
+# endif // if FEATURE_C013_COMPACT_DATA
       C013_SendUDPTaskData(event, 0, event->TaskIndex);
       success = true;
       break;
@@ -174,6 +288,10 @@ void C013_SendUDPTaskData(struct EventStruct *event, uint8_t destUnit, uint8_t d
   {
     dataReply.destUnit = destUnit;
     C013_sendUDP(destUnit, reinterpret_cast<const uint8_t *>(&dataReply), sizeof(C013_SensorDataStruct));
+  } else if (P2P_sendToGroup()) {
+    // Single packet to the multicast group, receiving nodes only check the source unit.
+    dataReply.destUnit = 0;
+    C013_sendUDP(255, reinterpret_cast<const uint8_t *>(&dataReply), sizeof(C013_SensorDataStruct));
   } else {
     for (auto it = Nodes.begin(); it != Nodes.end(); ++it) {
       if (it->first != Settings.Unit) {
@@ -185,7 +303,7 @@ void C013_SendUDPTaskData(struct EventStruct *event, uint8_t destUnit, uint8_t d
 }
 
 /*********************************************************************************************\
-   Send UDP message (unit 255=broadcast)
+   Send UDP message (unit 255=broadcast or multicast group)
 \*********************************************************************************************/
 void C013_sendUDP(uint8_t unit, const uint8_t *data, uint8_t size)
 {
@@ -301,51 +419,386 @@ void C013_Receive(struct EventStruct *event) {
       // FIXME TD-er: We should check for sensorType and pluginID on both sides.
       // For example sending different sensor type data from one dummy to another is probably not going to work well
       if (dataReply.isValid()) {
-        // only if this task has a remote feed, update values
-        const uint8_t remoteFeed = Settings.TaskDeviceDataFeed[dataReply.destTaskIndex];
+        constexpr uint8_t allSlots = (1 << VARS_PER_TASK) - 1;
 
-        if ((remoteFeed != 0) && (remoteFeed == dataReply.sourceUnit))
-        {
-          if (!dataReply.matchesPluginID(Settings.getPluginID_for_task(dataReply.destTaskIndex))) {
-            // Mismatch in plugin ID from sending node
-            if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
-              String log = concat(F("P2P data : PluginID mismatch for task "), dataReply.destTaskIndex + 1);
-              log += concat(F(" from unit "), dataReply.sourceUnit);
-              log += concat(F(" remote: "), dataReply.deviceNumber.value);
-              log += concat(F(" local: "), Settings.getPluginID_for_task(dataReply.destTaskIndex).value);
-              addLogMove(LOG_LEVEL_ERROR, log);
-            }
-          } else {
-            struct EventStruct TempEvent(dataReply.destTaskIndex);
-            TempEvent.Source = EventValueSource::Enum::VALUE_SOURCE_UDP;
-
-            const Sensor_VType sensorType = TempEvent.getSensorType();
-
-            if (dataReply.matchesSensorType(sensorType)) {
-              TaskValues_Data_t *taskValues = UserVar.getTaskValues_Data(dataReply.destTaskIndex);
-
-              if (taskValues != nullptr) {
-                for (taskVarIndex_t x = 0; x < VARS_PER_TASK; ++x)
-                {
-                  taskValues->copyValue(dataReply.values, x, sensorType);
-                }
-              }
-
-              SensorSendTask(&TempEvent);
-            } else {
-              // Mismatch in sensor types
-              if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
-                String log = concat(F("P2P data : SensorType mismatch for task "), dataReply.destTaskIndex + 1);
-                log += concat(F(" from unit "), dataReply.sourceUnit);
-                addLogMove(LOG_LEVEL_ERROR, log);
-              }
-            }
+        if (C013_ApplySensorData(dataReply, allSlots)) {
+# if FEATURE_C013_COMPACT_DATA
+
+          if (C013_compactData) {
+            // Ask the unit to send the compact format, which is ignored by units not supporting it.
+            C013_SendRefreshRequest(dataReply.sourceUnit, C013_peers[dataReply.sourceUnit], C013_REFRESH_INTERVAL_OLD_FORMAT);
           }
+# endif // if FEATURE_C013_COMPACT_DATA
         }
       }
       break;
     }
+
+# if FEATURE_C013_COMPACT_DATA
+    case C013_SENSOR_DATA_MULTI_ID: // sensor data of multiple tasks
+    {
+      C013_ReceiveMultiData(event);
+      break;
+    }
+
+    case C013_REFRESH_REQUEST_ID:
+    {
+      struct C013_RefreshRequestStruct request;
+
+      if (static_cast<size_t>(event->Par2) < sizeof(C013_RefreshRequestStruct)) { break; }
+      memcpy(reinterpret_cast<uint8_t *>(&request), event->Data, sizeof(C013_RefreshRequestStruct));
+
+      if (request.isValid() && C013_compactData) {
+        C013_PeerState& peer = C013_peers[request.sourceUnit];
+        peer.compactCapable  = true;
+        peer.needsFullUpdate = true;
+      }
+      break;
+    }
+# endif // if FEATURE_C013_COMPACT_DATA
+  }
+}
+
+// Apply the received values of the slots set in slotMask.
+// Return true when the destination task uses the data of the sending unit.
+bool C013_ApplySensorData(const C013_SensorDataStruct& dataReply, uint8_t slotMask)
+{
+  // only if this task has a remote feed, update values
+  const uint8_t remoteFeed = Settings.TaskDeviceDataFeed[dataReply.destTaskIndex];
+
+  if ((remoteFeed == 0) || (remoteFeed != dataReply.sourceUnit)) {
+    return false;
+  }
+
+  if (!dataReply.matchesPluginID(Settings.getPluginID_for_task(dataReply.destTaskIndex))) {
+    // Mismatch in plugin ID from sending node
+    if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+      String log = concat(F("P2P data : PluginID mismatch for task "), dataReply.destTaskIndex + 1);
+      log += concat(F(" from unit "), dataReply.sourceUnit);
+      log += concat(F(" remote: "), dataReply.deviceNumber.value);
+      log += concat(F(" local: "), Settings.getPluginID_for_task(dataReply.destTaskIndex).value);
+      addLogMove(LOG_LEVEL_ERROR, log);
+    }
+    return true;
+  }
+  struct EventStruct TempEvent(dataReply.destTaskIndex);
+  TempEvent.Source = EventValueSource::Enum::VALUE_SOURCE_UDP;
+
+  const Sensor_VType sensorType = TempEvent.getSensorType();
+
+  if (dataReply.matchesSensorType(sensorType)) {
+    TaskValues_Data_t *taskValues = UserVar.getTaskValues_Data(dataReply.destTaskIndex);
+
+    if ((taskValues != nullptr) && (sensorType != Sensor_VType::SENSOR_TYPE_STRING)) {
+      // Copy per 4 byte slot, 64 bit values are sent in 2 slots.
+      for (taskVarIndex_t x = 0; x < VARS_PER_TASK; ++x)
+      {
+        if (bitRead(slotMask, x)) {
+          taskValues->uint32s[x] = dataReply.values.uint32s[x];
+        }
+      }
+    }
+
+    SensorSendTask(&TempEvent);
+  } else {
+    // Mismatch in sensor types
+    if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+      String log = concat(F("P2P data : SensorType mismatch for task "), dataReply.destTaskIndex + 1);
+      log += concat(F(" from unit "), dataReply.sourceUnit);
+      addLogMove(LOG_LEVEL_ERROR, log);
+    }
   }
+  return true;
 }
 
+# if FEATURE_C013_COMPACT_DATA
+
+// ********************************************************************************
+// Compact sensor data of multiple tasks
+// ********************************************************************************
+
+// Check whether a float value changed at the number of decimals set for the task value.
+bool C013_FloatValueChanged(taskIndex_t taskIndex, taskVarIndex_t varNr, float newValue, float oldValue)
+{
+  if (!isValidFloat(newValue) || !isValidFloat(oldValue)) {
+    return true;
+  }
+  const deviceIndex_t DeviceIndex = getDeviceIndex_from_TaskIndex(taskIndex);
+
+  if (!validDeviceIndex(DeviceIndex) || !Device[DeviceIndex].configurableDecimals()) {
+    return true;
+  }
+  float factor = 1.0f;
+
+  for (uint8_t i = Cache.getTaskDeviceValueDecimals(taskIndex, varNr); i > 0; --i) {
+    factor *= 10.0f;
+  }
+
+  return roundf(newValue * factor) != roundf(oldValue * factor);
+}
+
+// Return the value slots which changed since last sent.
+// Return C013_SensorDataMultiEntry::FULL_UPDATE with all slots set when a full update is needed.
+uint8_t C013_GetChangedSlots(taskIndex_t              taskIndex,
+                             Sensor_VType             sensorType,
+                             const TaskValues_Data_t& values,
+                             const C013_TaskSentState& sentState)
+{
+  if (sensorType == Sensor_VType::SENSOR_TYPE_STRING) {
+    // Not sent, the task event is still sent.
+    return 0;
+  }
+
+  if (!sentState.valid || (sentState.nrCompactUpdates >= C013_FULL_UPDATE_INTERVAL)) {
+    return C013_SensorDataMultiEntry::FULL_UPDATE | C013_SensorDataMultiEntry::SLOT_MASK;
+  }
+  uint8_t slotMask = 0;
+
+  for (taskVarIndex_t x = 0; x < VARS_PER_TASK; ++x) {
+    if (values.uint32s[x] != sentState.values.uint32s[x]) {
+      // Leave out float values which are the same when rounded to the number of decimals of the task value.
+      // The last sent value is kept, so slow changes are still sent once they add up.
+      if (!isFloatOutputDataType(sensorType) ||
+          C013_FloatValueChanged(taskIndex, x, values.floats[x], sentState.values.floats[x])) {
+        bitSet(slotMask, x);
+      }
+    }
+  }
+
+  if (!is32bitOutputDataType(sensorType)) {
+    // Always send both slots of a 64 bit value
+    for (taskVarIndex_t x = 0; x < VARS_PER_TASK; x += 2) {
+      if ((slotMask >> x) & 0x3) {
+        slotMask |= (0x3 << x);
+      }
+    }
+  }
+  return slotMask;
+}
+
+void C013_SendMultiData(uint8_t                      unit,
+                        C013_PeerState             & peer,
+                        const std::vector<uint8_t> & slotMasks)
+{
+  std::vector<uint8_t> packet;
+  struct C013_SensorDataMultiHeader header;
+
+  header.sourceUnit = Settings.Unit;
+  header.destUnit   = unit;
+
+  packet.reserve(UDP_PACKETSIZE_MAX);
+  packet.resize(sizeof(C013_SensorDataMultiHeader));
+
+  for (size_t i = 0; i <= C013_pendingTasks.size(); ++i) {
+    struct C013_SensorDataMultiEntry entry;
+    const TaskValues_Data_t *taskValues = nullptr;
+
+    if (i < C013_pendingTasks.size()) {
+      entry.sourceTaskIndex = C013_pendingTasks[i];
+      entry.destTaskIndex   = entry.sourceTaskIndex;
+      entry.deviceNumber    = Settings.getPluginID_for_task(entry.sourceTaskIndex);
+      entry.changedMask     = slotMasks[i];
+
+      struct EventStruct TempEvent(entry.sourceTaskIndex);
+      entry.sensorType = TempEvent.getSensorType();
+      taskValues       = UserVar.getTaskValues_Data(entry.sourceTaskIndex);
+
+      if (peer.needsFullUpdate && (entry.sensorType != Sensor_VType::SENSOR_TYPE_STRING)) {
+        entry.changedMask = C013_SensorDataMultiEntry::FULL_UPDATE | C013_SensorDataMultiEntry::SLOT_MASK;
+      }
+    }
+    const size_t entrySize = sizeof(C013_SensorDataMultiEntry) + 4 * entry.nrValueSlots();
+    const bool   lastEntry = i == C013_pendingTasks.size();
+
+    if ((header.nrEntries != 0) &&
+        (lastEntry || (header.nrEntries == 255) || ((packet.size() + entrySize) >= UDP_PACKETSIZE_MAX))) {
+      header.sequence = ++peer.sentSequence;
+      memcpy(&packet[0], &header, sizeof(C013_SensorDataMultiHeader));
+      C013_sendUDP(unit, &packet[0], packet.size());
+
+      header.nrEntries = 0;
+      packet.resize(sizeof(C013_SensorDataMultiHeader));
+    }
+
+    if (!lastEntry) {
+      const uint8_t *entryData = reinterpret_cast<const uint8_t *>(&entry);
+      packet.insert(packet.end(), entryData, entryData + sizeof(C013_SensorDataMultiEntry));
+
+      for (taskVarIndex_t x = 0; x < VARS_PER_TASK; ++x) {
+        if (bitRead(entry.changedMask, x)) {
+          const uint8_t *valueData = (taskValues != nullptr) ? &(taskValues->binary[x * 4]) : nullptr;
+
+          for (uint8_t b = 0; b < 4; ++b) {
+            packet.push_back(valueData != nullptr ? valueData[b] : 0);
+          }
+        }
+      }
+      ++header.nrEntries;
+    }
+  }
+  peer.needsFullUpdate = false;
+}
+
+void C013_SendPendingTasks()
+{
+  if (C013_pendingTasks.empty()) {
+    return;
+  }
+
+  if (!NetworkConnected(10)) {
+    C013_pendingTasks.clear();
+    return;
+  }
+
+  if (C013_taskSentState.size() != TASKS_MAX) {
+    C013_taskSentState.resize(TASKS_MAX);
+  }
+
+  // Changed value slots per pending task
+  std::vector<uint8_t> slotMasks;
+
+  slotMasks.reserve(C013_pendingTasks.size());
+
+  for (auto it = C013_pendingTasks.begin(); it != C013_pendingTasks.end(); ++it) {
+    const TaskValues_Data_t *taskValues = UserVar.getTaskValues_Data(*it);
+    uint8_t slotMask                    = 0;
+
+    if (taskValues != nullptr) {
+      struct EventStruct TempEvent(*it);
+      slotMask = C013_GetChangedSlots(*it, TempEvent.getSensorType(), *taskValues, C013_taskSentState[*it]);
+    }
+    slotMasks.push_back(slotMask);
+  }
+
+  for (auto it = Nodes.begin(); it != Nodes.end(); ++it) {
+    if (it->first == Settings.Unit) {
+      continue;
+    }
+    auto peer_it = C013_peers.find(it->first);
+
+    if ((peer_it != C013_peers.end()) && peer_it->second.compactCapable) {
+      C013_SendMultiData(it->first, peer_it->second, slotMasks);
+    } else {
+      for (auto task_it = C013_pendingTasks.begin(); task_it != C013_pendingTasks.end(); ++task_it) {
+        struct EventStruct TempEvent(*task_it);
+        C013_SendUDPTaskData(&TempEvent, it->first, *task_it);
+      }
+    }
+  }
+
+  // Keep the values as they were sent
+  for (size_t i = 0; i < C013_pendingTasks.size(); ++i) {
+    const TaskValues_Data_t *taskValues = UserVar.getTaskValues_Data(C013_pendingTasks[i]);
+    C013_TaskSentState& sentState       = C013_taskSentState[C013_pendingTasks[i]];
+
+    if (taskValues != nullptr) {
+      for (taskVarIndex_t x = 0; x < VARS_PER_TASK; ++x) {
+        if (bitRead(slotMasks[i], x)) {
+          sentState.values.uint32s[x] = taskValues->uint32s[x];
+        }
+      }
+
+      if (slotMasks[i] & C013_SensorDataMultiEntry::FULL_UPDATE) {
+        sentState.nrCompactUpdates = 0;
+        sentState.valid            = true;
+      } else if (sentState.nrCompactUpdates < 255) {
+        ++sentState.nrCompactUpdates;
+      }
+    }
+  }
+  C013_pendingTasks.clear();
+}
+
+void C013_ReceiveMultiData(struct EventStruct *event)
+{
+  const size_t packetSize = event->Par2;
+  struct C013_SensorDataMultiHeader header;
+
+  if (packetSize < sizeof(C013_SensorDataMultiHeader)) { return; }
+  memcpy(reinterpret_cast<uint8_t *>(&header), event->Data, sizeof(C013_SensorDataMultiHeader));
+
+  if (!header.isValid()) { return; }
+
+  size_t pos        = sizeof(C013_SensorDataMultiHeader);
+  bool   allFull    = true;
+  bool   isComplete = true;
+  bool   usesData   = false;
+
+  for (uint8_t i = 0; i < header.nrEntries; ++i) {
+    struct C013_SensorDataMultiEntry entry;
+
+    if ((pos + sizeof(C013_SensorDataMultiEntry)) > packetSize) {
+      isComplete = false;
+      break;
+    }
+    memcpy(reinterpret_cast<uint8_t *>(&entry), &(event->Data[pos]), sizeof(C013_SensorDataMultiEntry));
+    pos += sizeof(C013_SensorDataMultiEntry);
+
+    if ((pos + 4 * entry.nrValueSlots()) > packetSize) {
+      isComplete = false;
+      break;
+    }
+    struct C013_SensorDataStruct dataReply;
+
+    dataReply.sourceUnit      = header.sourceUnit;
+    dataReply.destUnit        = header.destUnit;
+    dataReply.sourceTaskIndex = entry.sourceTaskIndex;
+    dataReply.destTaskIndex   = entry.destTaskIndex;
+    dataReply.deviceNumber    = entry.deviceNumber;
+    dataReply.sensorType      = entry.sensorType;
+
+    for (taskVarIndex_t x = 0; x < VARS_PER_TASK; ++x) {
+      if (bitRead(entry.changedMask, x)) {
+        memcpy(&(dataReply.values.binary[x * 4]), &(event->Data[pos]), 4);
+        pos += 4;
+      }
+    }
+
+    if (!(entry.changedMask & C013_SensorDataMultiEntry::FULL_UPDATE)) {
+      allFull = false;
+    }
+
+    if (entry.isValid() &&
+        C013_ApplySensorData(dataReply, entry.changedMask & C013_SensorDataMultiEntry::SLOT_MASK)) {
+      usesData = true;
+    }
+  }
+
+  C013_PeerState& peer = C013_peers[header.sourceUnit];
+  bool missedData      = !isComplete;
+
+  if (peer.hasReceivedSequence) {
+    missedData |= header.sequence != static_cast<uint16_t>(peer.receivedSequence + 1);
+  } else {
+    // Values of a unit sending only changed values are unknown until a full update.
+    missedData |= !allFull;
+  }
+  peer.receivedSequence    = header.sequence;
+  peer.hasReceivedSequence = true;
+
+  if (missedData && usesData) {
+    C013_SendRefreshRequest(header.sourceUnit, peer, C013_REFRESH_INTERVAL_MISSED);
+  }
+}
+
+void C013_SendRefreshRequest(uint8_t unit, C013_PeerState& peer, unsigned long minInterval)
+{
+  if ((peer.lastRefreshRequest != 0) && (timePassedSince(peer.lastRefreshRequest) < static_cast<long>(minInterval))) {
+    return;
+  }
+  peer.lastRefreshRequest = millis();
+
+  if (peer.lastRefreshRequest == 0) {
+    peer.lastRefreshRequest = 1;
+  }
+
+  struct C013_RefreshRequestStruct request;
+
+  request.sourceUnit = Settings.Unit;
+  request.destUnit   = unit;
+  C013_sendUDP(unit, reinterpret_cast<const uint8_t *>(&request), sizeof(C013_RefreshRequestStruct));
+}
+
+# endif // if FEATURE_C013_COMPACT_DATA
+
 #endif // ifdef USES_C013
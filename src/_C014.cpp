@@ -7,14 +7,19 @@
 # include "src/Globals/MQTT.h"
 # include "src/Globals/Plugins.h"
 # include "src/Globals/Statistics.h"
+# include "src/Helpers/CRC_functions.h"
 # include "src/Helpers/PeriodicalActions.h"
 # include "_Plugin_Helper.h"
 
+# include <list>
+
 // #######################################################################################################
 // ################################# Controller Plugin 0014: Homie 3/4 ###################################
 // #######################################################################################################
 
 /** Changelog:
+ * 2026-10-15 Generate the autodiscover data lazily and publish it a few messages per CPLUGIN_TEN_PER_SECOND call,
+ *            skip republishing an unchanged tree after a reconnect.
  * 2023-03-15 tonhuisman: Replace use of deprecated DummyValueSet with TaskValueSet
  * 2023-03 Changelog started
  */
@@ -48,6 +53,10 @@
 # define CPLUGIN_014_GPIO_VALUE      "gpio"    // name for gpio value i.e. "gpio1"
 # define CPLUGIN_014_CMD_VALUE_NAME  "Command" // human readabele name for command value
 
+# define CPLUGIN_014_DISCOVERY_PER_CALL  4          // Max. autodiscover messages queued per CPLUGIN_TEN_PER_SECOND call
+# define CPLUGIN_014_HASH_PER_CALL       16         // Max. autodiscover messages hashed per call, when checking for changes
+# define CPLUGIN_014_HASH_MARKER         0xC014DA5C
+
 uint8_t msgCounter = 0;                        // counter for send Messages (currently for information / log only!
 
 String CPlugin_014_pubname;
@@ -170,6 +179,492 @@ void CPLUGIN_014_addToList(String& valuesList, const String& node)
   valuesList += node;
 }
 
+/*********************************************************************************************\
+* Autodiscover data
+* The Homie device tree takes a few messages per task value and per GPIO, most of them retained.
+* Instead of queueing them all at once after connecting, the messages are generated per GPIO or
+* task value and queued a few at a time, as long as the MQTT queue has room.
+* The hash of the last fully published tree (and controller settings) is kept, so after a reconnect
+* the tree is first generated without publishing, and only published again when it has changed.
+\*********************************************************************************************/
+struct C014_discoveryHash_t {
+  uint32_t marker;
+  uint32_t hash;
+};
+
+# ifdef ESP32
+RTC_NOINIT_ATTR C014_discoveryHash_t C014_discoveryHash;
+# else // ifdef ESP32
+
+// ESP8266 RTC user memory is already fully in use, so only kept while running.
+static C014_discoveryHash_t C014_discoveryHash;
+# endif // ifdef ESP32
+
+bool C014_discoveryHashValid()
+{
+  return C014_discoveryHash.marker == CPLUGIN_014_HASH_MARKER;
+}
+
+enum class C014_discovery_e : uint8_t {
+  Idle,
+  Header,
+  Gpio,
+  Task,
+  Nodes,
+  Done
+};
+
+struct C014_discovery_t {
+  // @param publishTree  False to only compute the hash of the tree
+  void start(controllerIndex_t controller_idx,
+             bool              publishTree);
+
+  void stop();
+
+  bool active() const {
+    return stage != C014_discovery_e::Idle;
+  }
+
+  // Handle the next few messages, call repeatedly until no longer active()
+  void process();
+
+  controllerIndex_t controllerIndex = INVALID_CONTROLLER_INDEX;
+
+private:
+
+  // Generate the messages for the next GPIO or task value.
+  // @retval False when the whole tree has been generated
+  bool generate();
+
+  void generateHeader();
+  void generateGpio();
+  void generateTaskValue();
+  void finish();
+
+  void addDevice(const __FlashStringHelper *topic,
+                 const String             & payload);
+  void addNode(const String& node,
+               const String& value,
+               const String& topic,
+               const String& payload);
+
+  std::list<std::pair<String, String> > pending; // topic, payload
+  String           pubname;                     // Scheme to form device messages
+  String           nodename;                    // Scheme to form node messages
+  String           nodesList;                   // build comma separated List for nodes
+  String           valuesList;                  // build comma separated List for values
+  uint32_t         hash         = 0;
+  int              errorCounter = 0;
+  int              msgCount     = 0;
+  int              deviceCount  = 0;
+  int              nodeCount    = 0;
+  int              gpio         = 0;
+  taskIndex_t      taskIndex    = 0;
+  uint8_t          varNr        = 0;
+  C014_discovery_e stage        = C014_discovery_e::Idle;
+  bool             publish      = false;
+};
+
+C014_discovery_t C014_discovery;
+
+void C014_discovery_t::start(controllerIndex_t controller_idx, bool publishTree)
+{
+  stop();
+  controllerIndex = controller_idx;
+  publish         = publishTree;
+  pubname         = CPLUGIN_014_BASE_TOPIC;
+  pubname.replace(F("%sysname%"), Settings.getName());
+  nodename = CPLUGIN_014_BASE_VALUE;
+  nodename.replace(F("%sysname%"), Settings.getName());
+  deviceCount = 1; // minimum the SYSTEM device exists
+  nodeCount   = 1; // minimum the cmd node exists
+  stage       = C014_discovery_e::Header;
+
+  // Include the controller settings in the hash, so the tree is published again when e.g. another broker is used.
+  MakeControllerSettings(ControllerSettings); //-V522
+
+  if (AllocatedControllerSettings()) {
+    LoadControllerSettings(controller_idx, *ControllerSettings);
+    hash = calc_CRC32(reinterpret_cast<const uint8_t *>(ControllerSettings.get()), sizeof(ControllerSettingsStruct));
+  }
+}
+
+void C014_discovery_t::stop()
+{
+  pending.clear();
+  nodesList    = String();
+  valuesList   = String();
+  hash         = 0;
+  errorCounter = 0;
+  msgCount     = 0;
+  gpio         = 0;
+  taskIndex    = 0;
+  varNr        = 0;
+  stage        = C014_discovery_e::Idle;
+}
+
+void C014_discovery_t::process()
+{
+  int budget = publish ? CPLUGIN_014_DISCOVERY_PER_CALL : CPLUGIN_014_HASH_PER_CALL;
+
+  while (budget > 0) {
+    if (pending.empty() && !generate()) {
+      finish();
+      return;
+    }
+
+    if (publish && MQTT_queueFull(controllerIndex)) {
+      // Continue on the next call
+      return;
+    }
+    String& topic   = pending.front().first;
+    String& payload = pending.front().second;
+
+    const uint32_t crc = calc_CRC32(reinterpret_cast<const uint8_t *>(topic.c_str()), topic.length()) ^
+                         calc_CRC32(reinterpret_cast<const uint8_t *>(payload.c_str()), payload.length());
+    hash = ((hash << 1) | (hash >> 31)) ^ crc;
+
+    if (publish) {
+      # ifndef BUILD_NO_DEBUG
+      String log;
+
+      if (loglevelActiveFor(LOG_LEVEL_DEBUG_MORE)) {
+        log = strformat(F("C014 : T:%s P: %s"), topic.c_str(), payload.c_str());
+      }
+      # endif // ifndef BUILD_NO_DEBUG
+
+      if (MQTTpublish(controllerIndex, INVALID_TASK_INDEX, std::move(topic), std::move(payload), true)) {
+        ++msgCount;
+        # ifndef BUILD_NO_DEBUG
+        addLogMove(LOG_LEVEL_DEBUG_MORE, log);
+        # endif // ifndef BUILD_NO_DEBUG
+      } else {
+        ++errorCounter;
+        addLog(LOG_LEVEL_ERROR, F("C014 : Autodiscover message ERROR!"));
+      }
+    }
+    pending.pop_front();
+    --budget;
+  }
+}
+
+bool C014_discovery_t::generate()
+{
+  while (pending.empty()) {
+    switch (stage) {
+      case C014_discovery_e::Header:
+        generateHeader();
+        stage = C014_discovery_e::Gpio;
+        break;
+      case C014_discovery_e::Gpio:
+        generateGpio();
+        break;
+      case C014_discovery_e::Task:
+        generateTaskValue();
+        break;
+      case C014_discovery_e::Nodes:
+
+        // and finally ...
+        // $nodes	Device → Controller	Nodes the device exposes, with format id separated by a , if there are multiple nodes. To
+        // make a node an array, append [] to the ID.	Yes	Yes
+        addDevice(F("$nodes"), nodesList);
+        stage = C014_discovery_e::Done;
+        break;
+      case C014_discovery_e::Idle:
+      case C014_discovery_e::Done:
+        return false;
+    }
+  }
+  return true;
+}
+
+void C014_discovery_t::generateHeader()
+{
+  // init: this is the state the device is in when it is connected to the MQTT broker, but has not yet sent all Homie messages and is
+  // not yet ready to operate. This is the first message that must that must be sent.
+  addDevice(F("$state"), F("init"));
+
+  // $homie	Device → Controller	Version of the Homie convention the device conforms to	Yes	Yes
+  addDevice(F("$homie"), F(CPLUGIN_014_HOMIE_VERSION));
+
+  // $name	Device → Controller	Friendly name of the device	Yes	Yes
+  addDevice(F("$name"),  Settings.getName());
+
+  // $localip	Device → Controller	IP of the device on the local network	Yes	Yes
+# ifdef CPLUGIN_014_V3
+  addDevice(F("$localip"), formatIP(NetworkLocalIP()));
+
+  // $mac	Device → Controller	Mac address of the device network interface. The format MUST be of the type A1:B2:C3:D4:E5:F6	Yes	Yes
+  addDevice(F("$mac"),     NetworkMacAddress());
+
+  // $implementation	Device → Controller	An identifier for the Homie implementation (example esp8266)	Yes	Yes
+    #  if defined(ESP8266)
+  addDevice(F("$implementation"), F("ESP8266"));
+    #  endif // if defined(ESP8266)
+    #  if defined(ESP32)
+  addDevice(F("$implementation"), F("ESP32"));
+    #  endif // if defined(ESP32)
+
+  // $fw/version	Device → Controller	Version of the firmware running on the device	Yes	Yes
+  addDevice(F("$fw/version"), toString(Settings.Build, 0));
+
+#  if FEATURE_ESPEASY_P2P
+
+  // $fw/name	Device → Controller	Name of the firmware running on the device. Allowed characters are the same as the device ID	Yes	Yes
+  addDevice(F("$fw/name"), getNodeTypeDisplayString(NODE_TYPE_ID));
+#  endif // if FEATURE_ESPEASY_P2P
+
+  // $stats/interval	Device → Controller	Interval in seconds at which the device refreshes its $stats/+: See next section for
+  // details about statistical attributes	Yes	Yes
+  addDevice(F("$stats/interval"), F(CPLUGIN_014_INTERVAL));
+# endif // ifdef CPLUGIN_014_V3
+
+  // always send the SYSTEM device with the cmd node
+  CPLUGIN_014_addToList(nodesList,  F(CPLUGIN_014_SYSTEM_DEVICE));
+  CPLUGIN_014_addToList(valuesList, F(CPLUGIN_014_CMD_VALUE));
+
+  // $name	Device → Controller	Friendly name of the Node	Yes	Yes
+  addNode(F(CPLUGIN_014_SYSTEM_DEVICE), F("$name"),                EMPTY_STRING, F(CPLUGIN_014_SYSTEM_DEVICE));
+
+  // $name	Device → Controller	Friendly name of the property.	Any String	Yes	No ("")
+  addNode(F(CPLUGIN_014_SYSTEM_DEVICE), F(CPLUGIN_014_CMD_VALUE), F("/$name"),     F(CPLUGIN_014_CMD_VALUE_NAME));
+
+  // $datatype	The data type. See Payloads.	Enum: [integer, float, boolean, string, enum, color]
+  addNode(F(CPLUGIN_014_SYSTEM_DEVICE), F(CPLUGIN_014_CMD_VALUE), F("/$datatype"), F("string"));
+
+  // $settable	Device → Controller	Specifies whether the property is settable (true) or readonly (false)	true or false	Yes	No
+  // (false)
+  addNode(F(CPLUGIN_014_SYSTEM_DEVICE), F(CPLUGIN_014_CMD_VALUE), F("/$settable"), F("true"));
+}
+
+void C014_discovery_t::generateGpio()
+{
+  // FIRST Standard GPIO tasks
+  while (gpio <= MAX_GPIO) {
+    const PinBootState state = Settings.getPinBootState(gpio);
+    String valueName         = F(CPLUGIN_014_GPIO_VALUE);
+    valueName += gpio;
+    ++gpio;
+
+    if (state != PinBootState::Default_state) // anything but default
+    {
+      nodeCount++;
+      CPLUGIN_014_addToList(valuesList, valueName);
+
+      // $name	Device → Controller	Friendly name of the property.	Any String	Yes	No ("")
+      addNode(F(CPLUGIN_014_SYSTEM_DEVICE), valueName, F("/$name"),     valueName);
+
+      // $datatype	The data type. See Payloads.	Enum: [integer, float, boolean,string, enum, color]
+      addNode(F(CPLUGIN_014_SYSTEM_DEVICE), valueName, F("/$datatype"), F("boolean"));
+
+      if (state != PinBootState::Input) // defined as output
+      {
+        // $settable	Device → Controller	Specifies whether the property is settable (true) or readonly (false)	true or
+        // false	Yes	No (false)
+        addNode(F(CPLUGIN_014_SYSTEM_DEVICE), valueName, F("/$settable"), F("true"));
+      }
+      return;
+    }
+  }
+
+  // $properties	Device → Controller	Properties the node exposes, with format id separated by a , if there are multiple nodes.	Yes	Yes
+  addNode(F(CPLUGIN_014_SYSTEM_DEVICE), F("$properties"), EMPTY_STRING, valuesList);
+  valuesList = String();
+  deviceCount++;
+  stage = C014_discovery_e::Task;
+}
+
+void C014_discovery_t::generateTaskValue()
+{
+  // SECOND Plugins
+  if (taskIndex >= TASKS_MAX) {
+    stage = C014_discovery_e::Nodes;
+    return;
+  }
+  const pluginID_t    pluginID    = Settings.getPluginID_for_task(taskIndex);
+  const deviceIndex_t DeviceIndex = getDeviceIndex_from_TaskIndex(taskIndex);
+
+  if (!validPluginID_fullcheck(pluginID) || !validDeviceIndex(DeviceIndex) || !Settings.TaskDeviceEnabled[taskIndex]) {
+    # ifndef BUILD_NO_DEBUG
+
+    if (validPluginID_fullcheck(pluginID) && loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+      addLogMove(LOG_LEVEL_DEBUG, strformat(F("C014 : Device Disabled: %s not propagated!"),
+                                            getPluginNameFromDeviceIndex(DeviceIndex).c_str()));
+    }
+    # endif // ifndef BUILD_NO_DEBUG
+    ++taskIndex;
+    varNr = 0;
+    return;
+  }
+
+  // Only loads from file when switching to another task.
+  LoadTaskSettings(taskIndex);
+  const String  deviceName = getTaskDeviceName(taskIndex);
+  const uint8_t valueCount = getValueCountForTask(taskIndex);
+
+  if (varNr < valueCount) {
+    const String valueName = ExtraTaskSettings.TaskDeviceValueNames[varNr];
+
+    if (!valueName.isEmpty()) { // do not send if Value Name is empty!
+      if (!Device[DeviceIndex].SendDataOption) // check if device is not sending data = assume that it can receive.
+      {
+        constexpr pluginID_t HOMIE_RECEIVER_PLUGIN_ID(86);
+
+        if (pluginID == HOMIE_RECEIVER_PLUGIN_ID)
+        {
+          CPLUGIN_014_addToList(valuesList, valueName);
+
+          // $settable	Device → Controller	Specifies whether the property is settable (true) or readonly (false)	true
+          // or false	Yes	No (false)
+          addNode(deviceName, valueName, F("/$settable"), F("true"));
+
+          // $name	Device → Controller	Friendly name of the property.	Any String	Yes	No ("")
+          addNode(deviceName, valueName, F("/$name"),     concat(F("Homie Receiver: "), valueName));
+
+          // $datatype	The data type. See Payloads.	Enum: [integer, float, boolean,string, enum, color]
+          String dataType;
+          String unitName;
+
+          switch (Settings.TaskDevicePluginConfig[taskIndex][varNr]) {
+            case 0: dataType = F("integer");
+
+              if ((ExtraTaskSettings.TaskDevicePluginConfig[varNr] != 0) ||
+                  (ExtraTaskSettings.TaskDevicePluginConfig[varNr + 5] != 0)) {
+                unitName  = ExtraTaskSettings.TaskDevicePluginConfig[varNr];
+                unitName += ':';
+                unitName += ExtraTaskSettings.TaskDevicePluginConfig[varNr + valueCount];
+              }
+              break;
+            case 1: dataType = F("float");
+
+              if ((ExtraTaskSettings.TaskDevicePluginConfig[varNr] != 0) ||
+                  (ExtraTaskSettings.TaskDevicePluginConfig[varNr + 5] != 0)) {
+                unitName  = ExtraTaskSettings.TaskDevicePluginConfig[varNr];
+                unitName += ':';
+                unitName += ExtraTaskSettings.TaskDevicePluginConfig[varNr + valueCount];
+              }
+              break;
+            case 2: dataType = F("boolean"); break;
+            case 3: dataType = F("string"); break;
+            case 4: dataType = F("enum");
+              unitName       = ExtraTaskSettings.TaskDeviceFormula[varNr];
+              break;
+            case 5: dataType = F("color");
+              unitName       = F("rgb");
+              break;
+            case 6: dataType = F("color");
+              unitName       = F("hsv");
+              break;
+          }
+          addNode(deviceName, valueName, F("/$datatype"), dataType);
+
+          if (!unitName.isEmpty()) {
+            addNode(deviceName, valueName, F("/$format"), unitName);
+          }
+          nodeCount++;
+        }
+      } else {
+        // ignore cutom values for now! Assume all Values are standard float.
+        CPLUGIN_014_addToList(valuesList, valueName);
+
+        // $name	Device → Controller	Friendly name of the property.	Any String	Yes	No ("")
+        addNode(deviceName, valueName, F("/$name"),     valueName);
+
+        // $datatype	The data type. See Payloads.	Enum: [integer, float, boolean,string, enum, color]
+        addNode(deviceName, valueName, F("/$datatype"), F("float"));
+
+        constexpr pluginID_t DUMMY_PLUGIN_ID(33);
+
+        if (pluginID == DUMMY_PLUGIN_ID) { // Dummy Device can send AND receive Data
+          addNode(deviceName, valueName, F("/$settable"), F("true"));
+        }
+        nodeCount++;
+      }
+    }
+    ++varNr;
+    return;
+  }
+
+  if (!valuesList.isEmpty())
+  {
+    // only add device to list if it has nodes!
+    // $name	Device → Controller	Friendly name of the Node	Yes	Yes
+    addNode(deviceName, F("$name"),       EMPTY_STRING, deviceName);
+
+    // $type	Device → Controller	Type of the node	Yes	Yes
+    addNode(deviceName, F("$type"),       EMPTY_STRING, getPluginNameFromDeviceIndex(DeviceIndex));
+
+    // add device to device list
+    CPLUGIN_014_addToList(nodesList, deviceName);
+    deviceCount++;
+
+    // $properties	Device → Controller	Properties the node exposes, with format id separated by a , if there are multiple
+    // nodes.	Yes	Yes
+    addNode(deviceName, F("$properties"), EMPTY_STRING, valuesList);
+    valuesList = String();
+  }
+  ++taskIndex;
+  varNr = 0;
+}
+
+void C014_discovery_t::finish()
+{
+  const bool unchanged = !publish && C014_discoveryHashValid() && (C014_discoveryHash.hash == hash);
+
+  if (!publish && !unchanged) {
+    // Tree has changed since it was last published.
+    start(controllerIndex, true);
+    return;
+  }
+
+  if (publish && (errorCounter == 0)) {
+    C014_discoveryHash.hash   = hash;
+    C014_discoveryHash.marker = CPLUGIN_014_HASH_MARKER;
+  }
+
+  int stateErrors = errorCounter;
+
+  if (errorCounter > 0)
+  {
+    // alert: this is the state the device is when connected to the MQTT broker, but something wrong is happening. E.g. a sensor is not
+    // providing data and needs human intervention. You have to send this message when something is wrong.
+    CPlugin_014_sendMQTTdevice(pubname, INVALID_TASK_INDEX, F("$state"), F("alert"), stateErrors);
+  } else {
+    // ready: this is the state the device is in when it is connected to the MQTT broker, has sent all Homie messages and is ready to
+    // operate. You have to send this message after all other announcements message have been sent.
+    CPlugin_014_sendMQTTdevice(pubname, INVALID_TASK_INDEX, F("$state"), F("ready"), stateErrors);
+  }
+
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    if (unchanged) {
+      addLogMove(LOG_LEVEL_INFO, strformat(F("C014 : autodiscover information of %d Devices and %d Nodes unchanged, not sent again"),
+                                           deviceCount, nodeCount));
+    } else {
+      addLogMove(LOG_LEVEL_INFO, strformat(F("C014 : autodiscover information of %d Devices and %d Nodes sent with %d errors! (%d messages)"),
+                                           deviceCount, nodeCount, errorCounter, msgCount));
+    }
+  }
+  stop();
+}
+
+void C014_discovery_t::addDevice(const __FlashStringHelper *topic, const String& payload)
+{
+  String tmppubname(pubname);
+
+  tmppubname.replace(F("#"), topic);
+  pending.emplace_back(std::move(tmppubname), payload);
+}
+
+void C014_discovery_t::addNode(const String& node, const String& value, const String& topic, const String& payload)
+{
+  String tmppubname(nodename);
+
+  tmppubname.replace(F("%device%"),    node);
+  tmppubname.replace(F("%node%"),      value);
+  tmppubname.replace(F("/%property%"), topic); // leading forward slash required to send "homie/device/value" topics
+  pending.emplace_back(std::move(tmppubname), payload);
+}
+
 bool CPlugin_014(CPlugin::Function function, struct EventStruct *event, String& string)
 {
   bool   success      = false;
@@ -201,18 +696,21 @@ bool CPlugin_014(CPlugin::Function function, struct EventStruct *event, String&
     case CPlugin::Function::CPLUGIN_INIT:
     {
       success = init_mqtt_delay_queue(event->ControllerIndex, CPlugin_014_pubname, CPlugin_014_mqtt_retainFlag);
+      C014_discovery.stop();
       break;
     }
 
     case CPlugin::Function::CPLUGIN_EXIT:
     {
+      C014_discovery.stop();
       exit_mqtt_delay_queue();
       break;
     }
 
     case CPlugin::Function::CPLUGIN_INTERVAL:
     {
-      if (MQTTclient.connected())
+      // $state is sent when sending the autodiscover data has finished.
+      if (MQTTclient.connected() && !C014_discovery.active())
       {
         errorCounter = 0;
 
@@ -266,400 +764,33 @@ bool CPlugin_014(CPlugin::Function function, struct EventStruct *event, String&
     {
       statusLED(true);
 
-      // send autodiscover header
-      pubname = CPLUGIN_014_BASE_TOPIC;           // Scheme to form device messages
-      pubname.replace(F("%sysname%"), Settings.getName());
-      int deviceCount = 1;                        // minimum the SYSTEM device exists
-      int nodeCount   = 1;                        // minimum the cmd node exists
-      errorCounter = 0;
-
       if (lastBootCause != BOOT_CAUSE_DEEP_SLEEP) // skip sending autodiscover data when returning from deep sleep
       {
-        String nodename = CPLUGIN_014_BASE_VALUE; // Scheme to form node messages
-        nodename.replace(F("%sysname%"), Settings.getName());
-        String nodesList;                         // build comma separated List for nodes
-        String valuesList;                        // build comma separated List for values
-        String deviceName;                        // current Device Name nr:name
-        String valueName;                         // current Value Name
-        String unitName;                          // estaimate Units
-
-        // init: this is the state the device is in when it is connected to the MQTT broker, but has not yet sent all Homie messages and is
-        // not yet ready to operate. This is the first message that must that must be sent.
-        CPlugin_014_sendMQTTdevice(pubname, event->TaskIndex, F("$state"), F("init"),                    errorCounter);
-
-        // $homie	Device → Controller	Version of the Homie convention the device conforms to	Yes	Yes
-        CPlugin_014_sendMQTTdevice(pubname, event->TaskIndex, F("$homie"), F(CPLUGIN_014_HOMIE_VERSION), errorCounter);
-
-        // $name	Device → Controller	Friendly name of the device	Yes	Yes
-        CPlugin_014_sendMQTTdevice(pubname, event->TaskIndex, F("$name"),  Settings.getName(),       errorCounter);
-
-        // $localip	Device → Controller	IP of the device on the local network	Yes	Yes
-# ifdef CPLUGIN_014_V3
-        CPlugin_014_sendMQTTdevice(pubname, event->TaskIndex, F("$localip"), formatIP(NetworkLocalIP()), errorCounter);
-
-        // $mac	Device → Controller	Mac address of the device network interface. The format MUST be of the type A1:B2:C3:D4:E5:F6	Yes	Yes
-        CPlugin_014_sendMQTTdevice(pubname, event->TaskIndex, F("$mac"),     NetworkMacAddress(),        errorCounter);
-
-        // $implementation	Device → Controller	An identifier for the Homie implementation (example esp8266)	Yes	Yes
-          #  if defined(ESP8266)
-        CPlugin_014_sendMQTTdevice(pubname, event->TaskIndex, F("$implementation"), F("ESP8266"), errorCounter);
-          #  endif // if defined(ESP8266)
-          #  if defined(ESP32)
-        CPlugin_014_sendMQTTdevice(pubname, event->TaskIndex, F("$implementation"), F("ESP32"),   errorCounter);
-          #  endif // if defined(ESP32)
-
-        // $fw/version	Device → Controller	Version of the firmware running on the device	Yes	Yes
-        CPlugin_014_sendMQTTdevice(pubname, event->TaskIndex, F("$fw/version"), toString(Settings.Build, 0),
-                                   errorCounter);
-
-#if FEATURE_ESPEASY_P2P
-        // $fw/name	Device → Controller	Name of the firmware running on the device. Allowed characters are the same as the device ID	Yes	Yes
-        CPlugin_014_sendMQTTdevice(pubname, event->TaskIndex, F("$fw/name"), getNodeTypeDisplayString(NODE_TYPE_ID),
-                                   errorCounter);
-#endif
-
-        // $stats/interval	Device → Controller	Interval in seconds at which the device refreshes its $stats/+: See next section for
-        // details about statistical attributes	Yes	Yes
-        CPlugin_014_sendMQTTdevice(pubname, event->TaskIndex, F("$stats/interval"), F(CPLUGIN_014_INTERVAL),
-                                   errorCounter);
-# endif // ifdef CPLUGIN_014_V3
-
-        // always send the SYSTEM device with the cmd node
-        CPLUGIN_014_addToList(nodesList,  F(CPLUGIN_014_SYSTEM_DEVICE));
-        CPLUGIN_014_addToList(valuesList, F(CPLUGIN_014_CMD_VALUE));
-
-        // $name	Device → Controller	Friendly name of the Node	Yes	Yes
-        CPlugin_014_sendMQTTnode(nodename,
-                                 F(CPLUGIN_014_SYSTEM_DEVICE),
-                                 F("$name"),
-                                 F(""),
-                                 F(CPLUGIN_014_SYSTEM_DEVICE),
-                                 errorCounter);
-
-        // $name	Device → Controller	Friendly name of the property.	Any String	Yes	No ("")
-        CPlugin_014_sendMQTTnode(nodename,
-                                 F(CPLUGIN_014_SYSTEM_DEVICE),
-                                 F(CPLUGIN_014_CMD_VALUE),
-                                 F("/$name"),
-                                 F(CPLUGIN_014_CMD_VALUE_NAME),
-                                 errorCounter);
-
-        // $datatype	The data type. See Payloads.	Enum: [integer, float, boolean, string, enum, color]
-        CPlugin_014_sendMQTTnode(nodename,
-                                 F(CPLUGIN_014_SYSTEM_DEVICE),
-                                 F(CPLUGIN_014_CMD_VALUE),
-                                 F("/$datatype"),
-                                 F("string"),
-                                 errorCounter);
-
-        // $settable	Device → Controller	Specifies whether the property is settable (true) or readonly (false)	true or false	Yes	No
-        // (false)
-        CPlugin_014_sendMQTTnode(nodename,
-                                 F(CPLUGIN_014_SYSTEM_DEVICE),
-                                 F(CPLUGIN_014_CMD_VALUE),
-                                 F("/$settable"),
-                                 F("true"),
-                                 errorCounter);
-
-        // enum all devices
-
-        // FIRST Standard GPIO tasks
-        int gpio = 0;
-
-        while (gpio <= MAX_GPIO) {
-          if (Settings.getPinBootState(gpio) != PinBootState::Default_state) // anything but default
-          {
-            nodeCount++;
-            valueName  = F(CPLUGIN_014_GPIO_VALUE);
-            valueName += toString(gpio, 0);
-            CPLUGIN_014_addToList(valuesList, valueName);
+        // Autodiscover data is sent from CPLUGIN_TEN_PER_SECOND.
+        // When the tree was published before, first check whether it changed.
+        C014_discovery.start(event->ControllerIndex, !C014_discoveryHashValid());
+        success = true;
+        break;
+      }
 
-            // $name	Device → Controller	Friendly name of the property.	Any String	Yes	No ("")
-            CPlugin_014_sendMQTTnode(nodename, F(CPLUGIN_014_SYSTEM_DEVICE), valueName, F("/$name"),     valueName, errorCounter);
+      pubname = CPLUGIN_014_BASE_TOPIC; // Scheme to form device messages
+      pubname.replace(F("%sysname%"), Settings.getName());
 
-            // $datatype	The data type. See Payloads.	Enum: [integer, float, boolean,string, enum, color]
-            CPlugin_014_sendMQTTnode(nodename, F(CPLUGIN_014_SYSTEM_DEVICE), valueName, F("/$datatype"), F("boolean"),         errorCounter);
+      // ready: this is the state the device is in when it is connected to the MQTT broker, has sent all Homie messages and is ready to
+      // operate. You have to send this message after all other announcements message have been sent.
+      success = CPlugin_014_sendMQTTdevice(pubname, event->TaskIndex, F("$state"), F("ready"), errorCounter);
+      break;
+    }
 
-            if (Settings.getPinBootState(gpio) != PinBootState::Input) // defined as output
-            {
-              // $settable	Device → Controller	Specifies whether the property is settable (true) or readonly (false)	true or
-              // false	Yes	No (false)
-              CPlugin_014_sendMQTTnode(nodename, F(CPLUGIN_014_SYSTEM_DEVICE), valueName, F("/$settable"), F("true"), errorCounter);
-            }
-          }
-          ++gpio;
+    case CPlugin::Function::CPLUGIN_TEN_PER_SECOND:
+    {
+      if (C014_discovery.active() && (event->ControllerIndex == C014_discovery.controllerIndex)) {
+        if (MQTTclient.connected()) {
+          C014_discovery.process();
+        } else {
+          C014_discovery.stop();
         }
-
-        // $properties	Device → Controller	Properties the node exposes, with format id separated by a , if there are multiple nodes.	Yes	Yes
-        CPlugin_014_sendMQTTnode(nodename, F(CPLUGIN_014_SYSTEM_DEVICE), F("$properties"), F(""), valuesList, errorCounter);
-        valuesList = F("");
-        deviceCount++;
-
-        // SECOND Plugins
-        for (taskIndex_t x = 0; x < TASKS_MAX; x++)
-        {
-          const pluginID_t pluginID = Settings.getPluginID_for_task(x);
-          if (validPluginID_fullcheck(pluginID))
-          {
-            LoadTaskSettings(x);
-            deviceIndex_t DeviceIndex = getDeviceIndex_from_TaskIndex(x);
-
-            deviceName = getTaskDeviceName(x);
-
-            if (validDeviceIndex(DeviceIndex) && Settings.TaskDeviceEnabled[x]) // Device is enabled so send information
-            {                                                                   // device enabled
-              valuesList = F("");
-
-              const uint8_t valueCount = getValueCountForTask(x);
-
-              if (!Device[DeviceIndex].SendDataOption) // check if device is not sending data = assume that it can receive.
-              {
-                constexpr pluginID_t HOMIE_RECEIVER_PLUGIN_ID(86);
-                if (pluginID == HOMIE_RECEIVER_PLUGIN_ID)
-                {
-                  for (uint8_t varNr = 0; varNr < valueCount; varNr++) {
-                    if (validPluginID_fullcheck(Settings.getPluginID_for_task(x))) {
-                      if (ExtraTaskSettings.TaskDeviceValueNames[varNr][0] != 0) { // do not send if Value Name is empty!
-                        CPLUGIN_014_addToList(valuesList, ExtraTaskSettings.TaskDeviceValueNames[varNr]);
-
-                        // $settable	Device → Controller	Specifies whether the property is settable (true) or readonly (false)	true
-                        // or false	Yes	No (false)
-                        CPlugin_014_sendMQTTnode(nodename,
-                                                 deviceName,
-                                                 ExtraTaskSettings.TaskDeviceValueNames[varNr],
-                                                 F("/$settable"),
-                                                 F("true"),
-                                                 errorCounter);
-
-                        // $name	Device → Controller	Friendly name of the property.	Any String	Yes	No ("")
-                        valueName  = F("Homie Receiver: ");
-                        valueName += ExtraTaskSettings.TaskDeviceValueNames[varNr];
-                        CPlugin_014_sendMQTTnode(nodename,
-                                                 deviceName,
-                                                 ExtraTaskSettings.TaskDeviceValueNames[varNr],
-                                                 F("/$name"),
-                                                 valueName,
-                                                 errorCounter);
-
-                        // $datatype	The data type. See Payloads.	Enum: [integer, float, boolean,string, enum, color]
-                        unitName = F("");
-
-                        switch (Settings.TaskDevicePluginConfig[x][varNr]) {
-                          case 0: valueName = F("integer");
-
-                            if ((ExtraTaskSettings.TaskDevicePluginConfig[varNr] != 0) ||
-                                (ExtraTaskSettings.TaskDevicePluginConfig[varNr + 5] != 0)) {
-                              unitName  = ExtraTaskSettings.TaskDevicePluginConfig[varNr];
-                              unitName += ':';
-                              unitName += ExtraTaskSettings.TaskDevicePluginConfig[varNr + valueCount];
-                            }
-                            break;
-                          case 1: valueName = F("float");
-
-                            if ((ExtraTaskSettings.TaskDevicePluginConfig[varNr] != 0) ||
-                                (ExtraTaskSettings.TaskDevicePluginConfig[varNr + 5] != 0)) {
-                              unitName  = ExtraTaskSettings.TaskDevicePluginConfig[varNr];
-                              unitName += ':';
-                              unitName += ExtraTaskSettings.TaskDevicePluginConfig[varNr + valueCount];
-                            }
-                            break;
-                          case 2: valueName = F("boolean"); break;
-                          case 3: valueName = F("string"); break;
-                          case 4: valueName = F("enum");
-                            unitName        = ExtraTaskSettings.TaskDeviceFormula[varNr];
-                            break;
-                          case 5: valueName = F("color");
-                            unitName        = F("rgb");
-                            break;
-                          case 6: valueName = F("color");
-                            unitName        = F("hsv");
-                            break;
-                        }
-                        CPlugin_014_sendMQTTnode(nodename,
-                                                 deviceName,
-                                                 ExtraTaskSettings.TaskDeviceValueNames[varNr],
-                                                 F("/$datatype"),
-                                                 valueName,
-                                                 errorCounter);
-
-                        if (!unitName.isEmpty()) { 
-                          CPlugin_014_sendMQTTnode(nodename,
-                                                   deviceName,
-                                                   ExtraTaskSettings.TaskDeviceValueNames[varNr],
-                                                   F("/$format"),
-                                                   unitName,
-                                                   errorCounter); }
-                        nodeCount++;
-                      }
-                    }
-                  }
-                }
-              } else {
-                // ignore cutom values for now! Assume all Values are standard float.
-                // String customValuesStr;
-                // customValues = PluginCall(PLUGIN_WEBFORM_SHOW_VALUES, &TempEvent, customValuesStr);
-                uint8_t customValues = false;
-
-                if (!customValues)
-                { // standard Values
-                  for (uint8_t varNr = 0; varNr < valueCount; varNr++)
-                  {
-                    const pluginID_t pluginID = Settings.getPluginID_for_task(x);
-                    if (validPluginID_fullcheck(pluginID))
-                    {
-                      if (ExtraTaskSettings.TaskDeviceValueNames[varNr][0] != 0) // do not send if Value Name is empty!
-                      {
-                        CPLUGIN_014_addToList(valuesList, ExtraTaskSettings.TaskDeviceValueNames[varNr]);
-
-                        // $name	Device → Controller	Friendly name of the property.	Any String	Yes	No ("")
-                        CPlugin_014_sendMQTTnode(nodename,
-                                                 deviceName,
-                                                 ExtraTaskSettings.TaskDeviceValueNames[varNr],
-                                                 F("/$name"),
-                                                 ExtraTaskSettings.TaskDeviceValueNames[varNr],
-                                                 errorCounter);
-
-                        // $datatype	The data type. See Payloads.	Enum: [integer, float, boolean,string, enum, color]
-                        CPlugin_014_sendMQTTnode(nodename,
-                                                 deviceName,
-                                                 ExtraTaskSettings.TaskDeviceValueNames[varNr],
-                                                 F("/$datatype"),
-                                                 F("float"),
-                                                 errorCounter);
-
-                        constexpr pluginID_t DUMMY_PLUGIN_ID(33);
-                        if (pluginID == DUMMY_PLUGIN_ID) { // Dummy Device can send AND receive Data
-                          CPlugin_014_sendMQTTnode(nodename,
-                                                   deviceName,
-                                                   ExtraTaskSettings.TaskDeviceValueNames[varNr],
-                                                   F("/$settable"),
-                                                   F("true"),
-                                                   errorCounter);
-                        }
-
-                        nodeCount++;
-
-                        /*                          // because values in ESPEasy are unitless lets assueme some units by the value name
-                           (still case sensitive)
-                                                  if (strstr(ExtraTaskSettings.TaskDeviceValueNames[varNr], "temp") != nullptr )
-                                                  {
-                                                    unitName = F("°C");
-                                                  } else if (strstr(ExtraTaskSettings.TaskDeviceValueNames[varNr], "humi") != nullptr )
-                                                  {
-                                                    unitName = F("%");
-                                                  } else if (strstr(ExtraTaskSettings.TaskDeviceValueNames[varNr], "press") != nullptr )
-                                                  {
-                                                    unitName = F("Pa");
-                                                  } // ToDo: .... and more
-
-                                                  if (unitName != F(""))  // found a unit match
-                                                  {
-                                                    // $unit	Device → Controller	A string containing the unit of this property. You
-                                                       are not limited to the recommended values, although they are the only well known ones
-                                                       that will have to be recognized by any Homie consumer.	Recommended: Yes	No
-                                                       ("")
-                                                    CPlugin_014_sendMQTTnode(nodename, deviceName,
-                                                       ExtraTaskSettings.TaskDeviceValueNames[varNr], F("/$unit"), unitName,
-                                                       errorCounter);
-                                                  }
-                                                  unitName = F("");
-                         */
-                      }
-                    }
-                  }      // end loop throug values
-                } else { // Device has custom Values
-                  #ifndef BUILD_NO_DEBUG
-                  if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-                    String log = F("C014 : Device has custom values: ");
-                    log += getPluginNameFromDeviceIndex(getDeviceIndex_from_TaskIndex(x));
-                    log += F(" not implemented!");
-                    addLogMove(LOG_LEVEL_DEBUG, log);
-                  }
-                  #endif
-                }
-              }
-
-              if (!valuesList.isEmpty())
-              {
-                // only add device to list if it has nodes!
-                // $name	Device → Controller	Friendly name of the Node	Yes	Yes
-                CPlugin_014_sendMQTTnode(nodename,
-                                         deviceName,
-                                         F("$name"),
-                                         F(""),
-                                         getTaskDeviceName(x),
-                                         errorCounter);
-
-                // $type	Device → Controller	Type of the node	Yes	Yes
-                CPlugin_014_sendMQTTnode(nodename,
-                                         deviceName,
-                                         F("$type"),
-                                         F(""),
-                                         getPluginNameFromDeviceIndex(DeviceIndex),
-                                         errorCounter);
-
-                // add device to device list
-                CPLUGIN_014_addToList(nodesList, deviceName);
-                deviceCount++;
-
-                // $properties	Device → Controller	Properties the node exposes, with format id separated by a , if there are multiple
-                // nodes.	Yes	Yes
-                CPlugin_014_sendMQTTnode(nodename, 
-                                         deviceName, 
-                                         F("$properties"), 
-                                         F(""), 
-                                         valuesList, 
-                                         errorCounter);
-                valuesList = F("");
-              }
-            } else { // device not enabeled
-              #ifndef BUILD_NO_DEBUG
-              if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-                String log = F("C014 : Device Disabled: ");
-                log += getPluginNameFromDeviceIndex(getDeviceIndex_from_TaskIndex(x));
-                log += F(" not propagated!");
-                addLogMove(LOG_LEVEL_DEBUG, log);
-              }
-              #endif
-            }
-          } // device configured
-        }   // loop through devices
-
-        // and finally ...
-        // $nodes	Device → Controller	Nodes the device exposes, with format id separated by a , if there are multiple nodes. To
-        // make a node an array, append [] to the ID.	Yes	Yes
-        CPlugin_014_sendMQTTdevice(pubname, event->TaskIndex, F("$nodes"), nodesList, errorCounter);
-      }
-
-      if (errorCounter > 0)
-      {
-        // alert: this is the state the device is when connected to the MQTT broker, but something wrong is happening. E.g. a sensor is not
-        // providing data and needs human intervention. You have to send this message when something is wrong.
-        CPlugin_014_sendMQTTdevice(pubname, event->TaskIndex, F("$state"), F("alert"), errorCounter);
-        success = false;
-      } else {
-        // ready: this is the state the device is in when it is connected to the MQTT broker, has sent all Homie messages and is ready to
-        // operate. You have to send this message after all other announcements message have been sent.
-        CPlugin_014_sendMQTTdevice(pubname, event->TaskIndex, F("$state"), F("ready"), errorCounter);
-        success = true;
-      }
-
-      if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-        String log = F("C014 : autodiscover information of ");
-        log += deviceCount;
-        log += F(" Devices and ");
-        log += nodeCount;
-        log += F(" Nodes sent with ");
-
-        if (errorCounter > 0) { log += errorCounter; }
-        else { log += F("no"); }
-        log         += F(" errors! (");
-        log         += msgCounter;
-        log         += F(" messages)");
-        addLogMove(LOG_LEVEL_INFO, log);
       }
-      msgCounter   = 0;
-      errorCounter = 0;
       break;
     }
 
@@ -185,57 +185,51 @@ bool CPlugin_015(CPlugin::Function function, struct EventStruct *event, String&
       uint8_t valueCount = getValueCountForTask(event->TaskIndex);
 
       std::unique_ptr<C015_queue_element> element(new C015_queue_element(event, valueCount));
-      success = C015_DelayHandler->addToQueue(std::move(element));
-
-      if (success) {
-        // Element was added.
-        // Now we try to append to the existing element
-        // and thus preventing the need to create a long string only to copy it to a queue element.
-        C015_queue_element& element = static_cast<C015_queue_element&>(*(C015_DelayHandler->sendQueue.back()));
 
-        for (uint8_t x = 0; x < valueCount; x++)
-        {
-          bool   isvalid;
-          String formattedValue = formatUserVar(event, x, isvalid);
+      // Fill the element before adding it to the queue, so its size is known when queued.
+      for (uint8_t x = 0; x < valueCount; x++)
+      {
+        bool   isvalid;
+        String formattedValue = formatUserVar(event, x, isvalid);
 
-          if (!isvalid) {
-            // send empty string to Blynk in case of error
-            formattedValue = String();
-          }
+        if (!isvalid) {
+          // send empty string to Blynk in case of error
+          formattedValue = String();
+        }
 
-          const String valueName = getTaskValueName(event->TaskIndex, x);
-          String valueFullName   = getTaskDeviceName(event->TaskIndex);
-          valueFullName += F(".");
-          valueFullName += valueName;
-          String vPinNumberStr = valueName.substring(1, 4);
-          int    vPinNumber    = vPinNumberStr.toInt();
+        const String valueName = getTaskValueName(event->TaskIndex, x);
+        String valueFullName   = getTaskDeviceName(event->TaskIndex);
+        valueFullName += F(".");
+        valueFullName += valueName;
+        String vPinNumberStr = valueName.substring(1, 4);
+        int    vPinNumber    = vPinNumberStr.toInt();
 
-          if ((vPinNumber < 0) || (vPinNumber > 255)) {
-            vPinNumber = -1;
-          }
-          if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-            String log           = F(C015_LOG_PREFIX);
-            log += Blynk.connected() ? F("(online): ") : F("(offline): ");
-
-            if ((vPinNumber > 0) && (vPinNumber < 256)) {
-              log += F("send ");
-              log += valueFullName;
-              log += F(" = ");
-              log += formattedValue;
-              log += F(" to blynk pin v");
-              log += vPinNumber;
-            } else {
-              log += F("error got vPin number for ");
-              log += valueFullName;
-              log += F(", got not valid value: ");
-              log += vPinNumberStr;
-            }
-            addLogMove(LOG_LEVEL_INFO, log);
+        if ((vPinNumber < 0) || (vPinNumber > 255)) {
+          vPinNumber = -1;
+        }
+        if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+          String log           = F(C015_LOG_PREFIX);
+          log += Blynk.connected() ? F("(online): ") : F("(offline): ");
+
+          if ((vPinNumber > 0) && (vPinNumber < 256)) {
+            log += F("send ");
+            log += valueFullName;
+            log += F(" = ");
+            log += formattedValue;
+            log += F(" to blynk pin v");
+            log += vPinNumber;
+          } else {
+            log += F("error got vPin number for ");
+            log += valueFullName;
+            log += F(", got not valid value: ");
+            log += vPinNumberStr;
           }
-          element.vPin[x] = vPinNumber;
-          element.txt[x]  = formattedValue;
+          addLogMove(LOG_LEVEL_INFO, log);
         }
+        element->vPin[x] = vPinNumber;
+        element->txt[x]  = formattedValue;
       }
+      success = C015_DelayHandler->addToQueue(std::move(element));
       Scheduler.scheduleNextDelayQueue(SchedulerIntervalTimer_e::TIMER_C015_DELAY_QUEUE, C015_DelayHandler->getNextScheduleTime());
       break;
     }
@@ -36,6 +36,9 @@
 // #include <ArduinoJson.h>
 
 bool C016_allowLocalSystemTime = false;
+# if FEATURE_RTC_CACHE_COMPRESSION
+bool C016_compressSamples = false;
+# endif // if FEATURE_RTC_CACHE_COMPRESSION
 
 bool CPlugin_016(CPlugin::Function function, struct EventStruct *event, String& string)
 {
@@ -79,10 +82,16 @@ bool CPlugin_016(CPlugin::Function function, struct EventStruct *event, String&
         if (AllocatedControllerSettings()) {
           LoadControllerSettings(event->ControllerIndex, *ControllerSettings);
           C016_allowLocalSystemTime = ControllerSettings->useLocalSystemTime();
+          # if FEATURE_RTC_CACHE_COMPRESSION
+          C016_compressSamples = ControllerSettings->cache_compressSamples();
+          # endif // if FEATURE_RTC_CACHE_COMPRESSION
         }
       }
       success = init_c016_delay_queue(event->ControllerIndex);
       ControllerCache.init();
+      # if FEATURE_RTC_CACHE_COMPRESSION
+      ControllerCache.setCompression(C016_compressSamples);
+      # endif // if FEATURE_RTC_CACHE_COMPRESSION
       break;
     }
 
@@ -94,6 +103,14 @@ bool CPlugin_016(CPlugin::Function function, struct EventStruct *event, String&
 
     case CPlugin::Function::CPLUGIN_WEBFORM_LOAD:
     {
+      # if FEATURE_RTC_CACHE_COMPRESSION
+      MakeControllerSettings(ControllerSettings); // -V522
+
+      if (AllocatedControllerSettings()) {
+        LoadControllerSettings(event->ControllerIndex, *ControllerSettings);
+        addControllerParameterForm(*ControllerSettings, event->ControllerIndex, ControllerSettingsStruct::CONTROLLER_CACHE_COMPRESS);
+      }
+      # endif // if FEATURE_RTC_CACHE_COMPRESSION
       break;
     }
 
@@ -38,6 +38,7 @@ C018_data_struct *C018_data = nullptr;
 
 // Forward declarations
 bool   C018_init(struct EventStruct *event);
+bool   C018_merge_queue_element(const C018_queue_element& element);
 String c018_add_joinChanged_script_element_line(const String& id,
                                                 bool          forOTAA);
 
@@ -205,7 +206,11 @@ bool CPlugin_018(CPlugin::Function function, struct EventStruct *event, String&
 
       if (C018_data != nullptr) {
         std::unique_ptr<C018_queue_element> element(new C018_queue_element(event, C018_data->getSampleSetCount(event->TaskIndex)));
-        success = C018_DelayHandler->addToQueue(std::move(element));
+        success = C018_merge_queue_element(*element);
+
+        if (!success) {
+          success = C018_DelayHandler->addToQueue(std::move(element));
+        }
         Scheduler.scheduleNextDelayQueue(SchedulerIntervalTimer_e::TIMER_C018_DELAY_QUEUE,
                                          C018_DelayHandler->getNextScheduleTime());
 
@@ -344,6 +349,7 @@ bool C018_init(struct EventStruct *event) {
   if (!C018_data->setAdaptiveDataRate(customConfig->adr != 0)) {
     return false;
   }
+  C018_data->setCombineUplinks(customConfig->combineUplinks != 0);
 
   if (!C018_data->setTTNstack(static_cast<RN2xx3_datatypes::TTN_stack_version>(customConfig->stackVersion))) {
     return false;
@@ -383,18 +389,40 @@ bool C018_init(struct EventStruct *event) {
 bool do_process_c018_delay_queue(int controller_number, const Queue_element_base& element_base, ControllerSettingsStruct& ControllerSettings) {
   const C018_queue_element& element = static_cast<const C018_queue_element&>(element_base);
 // *INDENT-ON*
-uint8_t pl           = (element.packed.length() / 2);
+uint8_t pl           = element.getPayloadSize();
 float   airtime_ms   = C018_data->getLoRaAirTime(pl);
 bool    mustSetDelay = false;
 bool    success      = false;
 
+if (airtime_ms > 0.0f) {
+  const unsigned long wait = C018_data->getAirtimeWait(airtime_ms);
+
+  if (wait > 0) {
+    // Waiting for the duty cycle budget is not a failed attempt.
+    C018_DelayHandler->setAdditionalDelay(wait);
+    C018_DelayHandler->attempt = 0;
+
+    if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+      String log = F("LoRaWAN : Duty cycle budget used, delay for ");
+      log += wait;
+      log += F(" ms");
+      addLogMove(LOG_LEVEL_INFO, log);
+    }
+    return false;
+  }
+}
+
 if (!C018_data->command_finished()) {
   mustSetDelay = true;
 } else {
-  success = C018_data->txHexBytes(element.packed, ControllerSettings.Port);
+  // Combined messages are sent on the next port, so they can be told apart by the decoder.
+  const uint8_t port = (element.nrCombined > 1) ? ControllerSettings.Port + 1 : ControllerSettings.Port;
+
+  success = C018_data->txHexBytes(element.packed, port);
 
   if (success) {
     if (airtime_ms > 0.0f) {
+      C018_data->useAirtime(airtime_ms);
       ADD_TIMER_STAT(C018_AIR_TIME, static_cast<unsigned long>(airtime_ms * 1000));
 
       if (loglevelActiveFor(LOG_LEVEL_INFO)) {
@@ -444,6 +472,45 @@ if (mustSetDelay) {
 return success;
 }
 
+// Try to merge a new element into the elements already queued.
+// When the duty cycle budget is used, an older sample of the same task is replaced by the new one.
+// Else, when enabled, the new element is appended to the last queued element if the combined payload fits.
+// @retval true when merged, so the element must not be queued.
+bool C018_merge_queue_element(const C018_queue_element& element) {
+  if ((C018_DelayHandler == nullptr) || (C018_data == nullptr)) {
+    return false;
+  }
+  Queue_element_ring& queue = C018_DelayHandler->sendQueue;
+
+  const float airtime_ms = C018_data->getLoRaAirTime(element.getPayloadSize());
+
+  if ((airtime_ms > 0.0f) && (C018_data->getAirtimeWait(airtime_ms) > 0)) {
+    for (size_t nr = 0; nr < queue.size(); ++nr) {
+      if (static_cast<C018_queue_element *>(queue.at(nr))->replaceStale(element)) {
+        addLog(LOG_LEVEL_INFO, F("C018 : Duty cycle budget used, replaced queued sample"));
+        return true;
+      }
+    }
+  }
+
+  if (C018_data->combineUplinks() && !queue.empty()) {
+    // Queue is only processed from the main loop, so no element is being sent right now.
+    C018_queue_element *last = static_cast<C018_queue_element *>(queue.back());
+
+    if (last->combine(element, C018_data->getMaxPayload())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+float C018_getRemainingAirtime() {
+  if ((C018_data == nullptr) || !C018_data->isInitialized()) {
+    return -1.0f;
+  }
+  return C018_data->getRemainingAirtime();
+}
+
 String c018_add_joinChanged_script_element_line(const String& id, bool forOTAA) {
   String result = F("document.getElementById('tr_");
 
@@ -7,6 +7,8 @@
 // #######################################################################################################
 
 /** Changelog:
+ * 2026-10-15 Queue notifications and deliver them with a non-blocking SMTP state machine, stepped 10x per second.
+ *            Failed deliveries are retried with increasing delay, identical alerts within a time window are sent as a single email.
  * 2022-12-29 tonhuisman: Add Date: field to email header to reduce spam score, see https://github.com/letscontrolit/ESPEasy/issues/3865
  * 2022-12-29 tonhuisman: Start changelog
 */
@@ -15,34 +17,99 @@
 # define NPLUGIN_ID_001         1
 # define NPLUGIN_NAME_001       "Email (SMTP)"
 
-# define NPLUGIN_001_TIMEOUT 5000
+# define NPLUGIN_001_TIMEOUT            5000  // Max. time to wait for a reply of the mail server
+
+# ifndef NPLUGIN_001_QUEUE_MAX
+#  ifdef ESP8266
+#   define NPLUGIN_001_QUEUE_MAX        4
+#  else // ifdef ESP8266
+#   define NPLUGIN_001_QUEUE_MAX        8
+#  endif // ifdef ESP8266
+# endif // ifndef NPLUGIN_001_QUEUE_MAX
+# define NPLUGIN_001_MAX_ATTEMPTS       3
+# define NPLUGIN_001_RETRY_DELAY        10000 // Doubled after each failed attempt
+# define NPLUGIN_001_COALESCE_WINDOW    60000 // Identical alerts within this window are sent as a single email
+# define NPLUGIN_001_MAX_LINE_LENGTH    512
 
 # include "src/DataStructs/ESPEasy_EventStruct.h"
 # include "src/DataStructs/NotificationSettingsStruct.h"
+# include "src/ESPEasyCore/ESPEasyNetwork.h"
 # include "src/ESPEasyCore/ESPEasy_Log.h"
-# include "src/ESPEasyCore/ESPEasy_backgroundtasks.h"
 # include "src/Globals/NPlugins.h"
 # include "src/Globals/Settings.h"
+# include "src/Helpers/CRC_functions.h"
 # include "src/Helpers/ESPEasy_Storage.h"
 # include "src/Helpers/ESPEasy_time_calc.h"
 # include "src/Helpers/Networking.h"
+# include "src/Helpers/StringConverter.h"
 # include "src/Helpers/StringGenerator_System.h"
 # include "src/Helpers/StringParser.h"
-# include "src/Helpers/_CPlugin_Helper.h" // safeReadStringUntil
 # include "src/Helpers/_NPlugin_init.h"
 
 # include <base64.h>
+# include <list>
+# include <memory>
+
+// Email waiting for delivery
+struct NPlugin_001_mail {
+  String          subject;
+  String          body;
+  uint32_t        hash        = 0; // CRC32 of subject and body, to detect repeated alerts
+  unsigned long   queued      = 0; // Time the (first) alert was queued
+  unsigned long   notBefore   = 0; // Earliest time for the next delivery attempt
+  uint16_t        repeatCount = 0; // Nr. of identical alerts coalesced into this email
+  notifierIndex_t notificationIndex = INVALID_NOTIFIER_INDEX;
+  uint8_t         attempts    = 0;
+};
+
+// Recently delivered email, to coalesce repeated alerts
+struct NPlugin_001_sent {
+  uint32_t        hash = 0;
+  unsigned long   sent = 0;
+  notifierIndex_t notificationIndex = INVALID_NOTIFIER_INDEX;
+};
+
+enum class NPlugin_001_state : uint8_t {
+  Greeting,
+  Ehlo,
+  AuthLogin,
+  AuthUser,
+  AuthPass,
+  MailFrom,
+  RcptTo,
+  Data,
+  Message
+};
+
+// SMTP session for the email at the front of the queue
+struct NPlugin_001_session {
+  WiFiClient                          client;
+  NotificationSettingsStruct_ptr_type settings;
+  String                              line;    // Reply line received so far
+  String                              mailheader;
+  unsigned long                       timeout   = 0;
+  uint16_t                            expected  = 0; // Expected SMTP reply code
+  uint8_t                             rcptIndex = 0;
+  NPlugin_001_state                   state     = NPlugin_001_state::Greeting;
+};
+
+static std::list<NPlugin_001_mail>          NPlugin_001_queue;
+static std::list<NPlugin_001_sent>          NPlugin_001_history;
+static std::unique_ptr<NPlugin_001_session> NPlugin_001_active;
 
 // Forward declaration
-bool NPlugin_001_send(const NotificationSettingsStruct& notificationsettings,
-                      const String                    & aSub,
-                      String                          & aMesg);
-bool NPlugin_001_Auth(WiFiClient  & client,
-                      const String& user,
-                      const String& pass);
-bool NPlugin_001_MTA(WiFiClient  & client,
-                     const String& aStr,
-                     uint16_t aWaitForPattern);
+bool NPlugin_001_enqueue(notifierIndex_t notificationIndex,
+                         String        && subject,
+                         String        && body);
+void NPlugin_001_process();
+bool NPlugin_001_start(NPlugin_001_mail& mail);
+bool NPlugin_001_step(NPlugin_001_mail& mail);
+bool NPlugin_001_handleReply(NPlugin_001_mail& mail,
+                             uint16_t          code);
+void NPlugin_001_sendCmd(const String    & aStr,
+                         uint16_t          aWaitForPattern,
+                         NPlugin_001_state nextState);
+void NPlugin_001_finish(bool success);
 bool getNextMailAddress(const String& data,
                         String      & address,
                         int           index);
@@ -99,10 +166,17 @@ bool NPlugin_001(NPlugin::Function function, struct EventStruct *event, String&
       else {
         body = NotificationSettings.Body;
       }
+
+      // Parse now, so the email shows the values at the moment of the alert
       subject = parseTemplate(subject);
       body    = parseTemplate(body);
-      NPlugin_001_send(NotificationSettings, subject, body);
-      success = true;
+      success = NPlugin_001_enqueue(event->NotificationIndex, std::move(subject), std::move(body));
+      break;
+    }
+
+    case NPlugin::Function::NPLUGIN_TEN_PER_SECOND:
+    {
+      NPlugin_001_process();
       break;
     }
 
@@ -112,13 +186,104 @@ bool NPlugin_001(NPlugin::Function function, struct EventStruct *event, String&
   return success;
 }
 
-bool NPlugin_001_send(const NotificationSettingsStruct& notificationsettings, const String& aSub, String& aMesg)
+bool NPlugin_001_enqueue(notifierIndex_t notificationIndex, String&& subject, String&& body)
+{
+  uint32_t hash = calc_CRC32(reinterpret_cast<const uint8_t *>(subject.c_str()), subject.length());
+
+  hash ^= calc_CRC32(reinterpret_cast<const uint8_t *>(body.c_str()), body.length());
+
+  // An identical alert still waiting in the queue only increments its repeat count.
+  // Skip the email currently being delivered, as its message may already have been sent.
+  auto it = NPlugin_001_queue.begin();
+
+  if (NPlugin_001_active && (it != NPlugin_001_queue.end())) {
+    ++it;
+  }
+
+  for (; it != NPlugin_001_queue.end(); ++it) {
+    if ((it->notificationIndex == notificationIndex) && (it->hash == hash) &&
+        (timePassedSince(it->queued) < NPLUGIN_001_COALESCE_WINDOW)) {
+      ++(it->repeatCount);
+      addLog(LOG_LEVEL_INFO, F("EMAIL: Repeated alert, added to queued email"));
+      return true;
+    }
+  }
+
+  if (NPlugin_001_queue.size() >= NPLUGIN_001_QUEUE_MAX) {
+    addLog(LOG_LEVEL_ERROR, F("EMAIL: Queue full, notification dropped"));
+    return false;
+  }
+
+  NPlugin_001_mail mail;
+
+  mail.subject           = std::move(subject);
+  mail.body              = std::move(body);
+  mail.hash              = hash;
+  mail.queued            = millis();
+  mail.notBefore         = mail.queued;
+  mail.notificationIndex = notificationIndex;
+
+  // When the same alert was sent recently, hold it until the window has passed
+  // so any further repeats are collected in this email.
+  for (auto sent = NPlugin_001_history.begin(); sent != NPlugin_001_history.end();) {
+    if (timePassedSince(sent->sent) >= NPLUGIN_001_COALESCE_WINDOW) {
+      sent = NPlugin_001_history.erase(sent);
+    } else {
+      if ((sent->notificationIndex == notificationIndex) && (sent->hash == hash)) {
+        mail.notBefore = sent->sent + NPLUGIN_001_COALESCE_WINDOW;
+      }
+      ++sent;
+    }
+  }
+
+  NPlugin_001_queue.push_back(std::move(mail));
+  return true;
+}
+
+void NPlugin_001_process()
+{
+  if (NPlugin_001_queue.empty()) {
+    return;
+  }
+  NPlugin_001_mail& mail = NPlugin_001_queue.front();
+
+  if (!NPlugin_001_active) {
+    if (!timeOutReached(mail.notBefore) || !NetworkConnected()) {
+      return;
+    }
+
+    if (!NPlugin_001_start(mail)) {
+      NPlugin_001_finish(false);
+    }
+    return;
+  }
+
+  if (!NPlugin_001_step(mail)) {
+    NPlugin_001_finish(false);
+  }
+}
+
+bool NPlugin_001_start(NPlugin_001_mail& mail)
 {
-  //  String& aDomain , String aTo, String aFrom, String aSub, String aMesg, String aHost, int aPort)
-  bool myStatus = false;
+  NPlugin_001_active.reset(new (std::nothrow) NPlugin_001_session());
+
+  if (!NPlugin_001_active) {
+    return false;
+  }
+  NPlugin_001_session& session = *NPlugin_001_active;
+
+  session.settings.reset(new (std::nothrow) NotificationSettingsStruct());
+
+  if (!session.settings) {
+    return false;
+  }
+  NotificationSettingsStruct& notificationsettings = *session.settings;
+
+  LoadNotificationSettings(mail.notificationIndex, (uint8_t *)&notificationsettings, sizeof(NotificationSettingsStruct));
+  notificationsettings.validate();
 
   // Use WiFiClient class to create TCP connections
-  WiFiClient client;
+  WiFiClient& client = session.client;
 
 # ifdef MUSTFIX_CLIENT_TIMEOUT_IN_SECONDS
 
@@ -138,164 +303,259 @@ bool NPlugin_001_send(const NotificationSettingsStruct& notificationsettings, co
   }
 #endif
 
+  // Only the connect itself is blocking, limited by the (short) client timeout.
   if (!connectClient(client, aHost.c_str(), notificationsettings.Port, CONTROLLER_CLIENTTIMEOUT_DFLT)) {
     if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
       addLog(LOG_LEVEL_ERROR, String(F("EMAIL: Error connecting to ")) + aHost + notificationsettings.Port);
     }
-    myStatus = false;
-  } else {
-    String mailheader = F(
-      "From: $nodename <$emailfrom>\r\n"
-      "To: $ato\r\n"
-      "Subject: $subject\r\n"
-      "Reply-To: $nodename <$emailfrom>\r\n"
-      "Date: $date\r\n"
-      "MIME-VERSION: 1.0\r\n"
-      "Content-type: text/html; charset=UTF-8\r\n"
-      "X-Mailer: EspEasy v$espeasyversion\r\n\r\n"
-      );
-
-    String email_address = notificationsettings.Sender;
-    int    pos_less      = email_address.indexOf('<');
-
-    if (pos_less == -1) {
-      // No email address markup
-      mailheader.replace(F("$nodename"),  Settings.getHostname());
-      mailheader.replace(F("$emailfrom"), notificationsettings.Sender);
-    } else {
-      String senderName = email_address.substring(0, pos_less);
-      removeChar(senderName, '"'); // Remove quotes
-      String address = email_address.substring(pos_less + 1);
-      removeChar(address, '<');
-      removeChar(address, '>');
-      address.trim();
-      senderName.trim();
-      mailheader.replace(F("$nodename"),  senderName);
-      mailheader.replace(F("$emailfrom"), address);
-    }
+    return false;
+  }
 
-    mailheader.replace(F("$nodename"),       Settings.getHostname());
-    mailheader.replace(F("$emailfrom"),      notificationsettings.Sender);
-    mailheader.replace(F("$ato"),            notificationsettings.Receiver);
-    mailheader.replace(F("$subject"),        aSub);
-    String dateFmtHdr = F("%sysweekday_s%, %sysday_0% %sysmonth_s% %sysyear% %systime% %systzoffset%");
-    String date       = parseTemplate(dateFmtHdr);
-    mailheader.replace(F("$date"),           date);
-    mailheader.replace(F("$espeasyversion"), getSystemBuildString());
-    aMesg.replace(F("\r"), F("<br/>")); // re-write line breaks for Content-type: text/html
+  String& mailheader = session.mailheader;
+
+  mailheader = F(
+    "From: $nodename <$emailfrom>\r\n"
+    "To: $ato\r\n"
+    "Subject: $subject\r\n"
+    "Reply-To: $nodename <$emailfrom>\r\n"
+    "Date: $date\r\n"
+    "MIME-VERSION: 1.0\r\n"
+    "Content-type: text/html; charset=UTF-8\r\n"
+    "X-Mailer: EspEasy v$espeasyversion\r\n\r\n"
+    );
+
+  String email_address = notificationsettings.Sender;
+  int    pos_less      = email_address.indexOf('<');
+
+  if (pos_less == -1) {
+    // No email address markup
+    mailheader.replace(F("$nodename"),  Settings.getHostname());
+    mailheader.replace(F("$emailfrom"), notificationsettings.Sender);
+  } else {
+    String senderName = email_address.substring(0, pos_less);
+    removeChar(senderName, '"'); // Remove quotes
+    String address = email_address.substring(pos_less + 1);
+    removeChar(address, '<');
+    removeChar(address, '>');
+    address.trim();
+    senderName.trim();
+    mailheader.replace(F("$nodename"),  senderName);
+    mailheader.replace(F("$emailfrom"), address);
+  }
 
-    // Wait for Client to Start Sending
-    // The MTA Exchange
-    while (true) {
-      if (!NPlugin_001_MTA(client, EMPTY_STRING, 220)) { break; }
+  mailheader.replace(F("$nodename"),       Settings.getHostname());
+  mailheader.replace(F("$emailfrom"),      notificationsettings.Sender);
+  mailheader.replace(F("$ato"),            notificationsettings.Receiver);
+  mailheader.replace(F("$subject"),        mail.subject);
+  String dateFmtHdr = F("%sysweekday_s%, %sysday_0% %sysmonth_s% %sysyear% %systime% %systzoffset%");
+  String date       = parseTemplate(dateFmtHdr);
+  mailheader.replace(F("$date"),           date);
+  mailheader.replace(F("$espeasyversion"), getSystemBuildString());
+
+  // Wait for the server greeting
+  NPlugin_001_sendCmd(EMPTY_STRING, 220, NPlugin_001_state::Greeting);
+  return true;
+}
 
-      if (!NPlugin_001_MTA(client, concat(F("EHLO "), String(notificationsettings.Domain)), 250)) { break; }
+// Process the server replies received so far, never waits for more data.
+// @retval False on error or timeout.
+bool NPlugin_001_step(NPlugin_001_mail& mail)
+{
+  NPlugin_001_session& session = *NPlugin_001_active;
+  WiFiClient& client           = session.client;
 
-      if (!NPlugin_001_Auth(client, notificationsettings.User, notificationsettings.Pass)) { break; }
+  while (client.available() > 0) {
+    const int c = client.read();
 
-      if (!NPlugin_001_MTA(client, concat(F("MAIL FROM:<"), String(notificationsettings.Sender) + '>') , 250)) { break; }
+    if (c < 0) {
+      break;
+    }
 
-      bool   nextAddressAvailable = true;
-      int    i                    = 0;
-      String emailTo;
-      const String receiver(notificationsettings.Receiver);
-      if (!getNextMailAddress(receiver, emailTo, i)) {
-        addLog(LOG_LEVEL_ERROR, F("Email: No recipient given"));
-        break;
+    if (c != '\n') {
+      if ((c != '\r') && (session.line.length() < NPLUGIN_001_MAX_LINE_LENGTH)) {
+        session.line += static_cast<char>(c);
       }
+      continue;
+    }
 
-      while (nextAddressAvailable) {
-        if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-          addLogMove(LOG_LEVEL_INFO, concat(F("Email: To "), emailTo));
-        }
+# ifndef BUILD_NO_DEBUG
 
-        if (!NPlugin_001_MTA(client, concat(F("RCPT TO:<"), emailTo + '>'), 250)) { break; }
-        ++i;
-        nextAddressAvailable = getNextMailAddress(receiver, emailTo, i);
-      }
+    if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+      addLog(LOG_LEVEL_DEBUG, session.line);
+    }
+# endif // ifndef BUILD_NO_DEBUG
 
-      if (!NPlugin_001_MTA(client, F("DATA"), 354)) { break; }
+    // Multi-line replies use "250-" for all but the last line, which uses "250 "
+    const bool lastLine = (session.line.length() >= 3) &&
+                          ((session.line.length() == 3) || (session.line[3] == ' '));
+    const uint16_t code = lastLine ? session.line.substring(0, 3).toInt() : 0;
+    session.line.clear();
 
-      if (!NPlugin_001_MTA(client, mailheader + aMesg + F("\r\n.\r\n"), 250)) { break; }
+    if (lastLine) {
+      if (!NPlugin_001_handleReply(mail, code)) {
+        return false;
+      }
 
-      myStatus = true;
-      break;
+      if (!NPlugin_001_active) {
+        // Delivery completed
+        return true;
+      }
     }
+  }
 
-    client.flush();
-    client.stop();
+  if (timeOutReached(session.timeout)) {
+    addLog(LOG_LEVEL_ERROR, strformat(F("EMAIL: Timeout waiting for %u reply"), session.expected));
+    return false;
+  }
 
-    if (myStatus == true) {
-      addLog(LOG_LEVEL_INFO, F("EMAIL: Connection Closed Successfully"));
-    } else {
-      if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
-        addLogMove(LOG_LEVEL_ERROR, concat(F("EMAIL: Connection Closed With Error. Used header: "),  mailheader));
-      }
-    }
+  if (!client.connected() && (client.available() == 0)) {
+    addLog(LOG_LEVEL_ERROR, F("EMAIL: Connection closed by server"));
+    return false;
   }
-  return myStatus;
+  return true;
 }
 
-bool NPlugin_001_Auth(WiFiClient& client, const String& user, const String& pass)
+bool NPlugin_001_handleReply(NPlugin_001_mail& mail, uint16_t code)
 {
-  if (user.isEmpty() || pass.isEmpty()) {
-    // No user/password given.
-    return true;
+  NPlugin_001_session& session = *NPlugin_001_active;
+
+  if (code != session.expected) {
+    if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+      addLogMove(LOG_LEVEL_ERROR, strformat(F("EMAIL: Unexpected reply %u, expected %u"), code, session.expected));
+    }
+    return false;
   }
+
+  const NotificationSettingsStruct& notificationsettings = *session.settings;
+  const String receiver(notificationsettings.Receiver);
+  String emailTo;
   base64 encoder;
-  return NPlugin_001_MTA(client, F("AUTH LOGIN"), 334) &&
-         NPlugin_001_MTA(client, encoder.encode(user), 334) &&
-         NPlugin_001_MTA(client, encoder.encode(pass), 235);
+
+  switch (session.state) {
+    case NPlugin_001_state::Greeting:
+      NPlugin_001_sendCmd(concat(F("EHLO "), String(notificationsettings.Domain)), 250, NPlugin_001_state::Ehlo);
+      break;
+    case NPlugin_001_state::Ehlo:
+
+      if ((notificationsettings.User[0] != '\0') && (notificationsettings.Pass[0] != '\0')) {
+        NPlugin_001_sendCmd(F("AUTH LOGIN"), 334, NPlugin_001_state::AuthLogin);
+        break;
+      }
+
+      // No user/password given.
+      NPlugin_001_sendCmd(concat(F("MAIL FROM:<"), String(notificationsettings.Sender) + '>'), 250, NPlugin_001_state::MailFrom);
+      break;
+    case NPlugin_001_state::AuthLogin:
+      NPlugin_001_sendCmd(encoder.encode(String(notificationsettings.User)), 334, NPlugin_001_state::AuthUser);
+      break;
+    case NPlugin_001_state::AuthUser:
+      NPlugin_001_sendCmd(encoder.encode(String(notificationsettings.Pass)), 235, NPlugin_001_state::AuthPass);
+      break;
+    case NPlugin_001_state::AuthPass:
+      NPlugin_001_sendCmd(concat(F("MAIL FROM:<"), String(notificationsettings.Sender) + '>'), 250, NPlugin_001_state::MailFrom);
+      break;
+    case NPlugin_001_state::MailFrom:
+    case NPlugin_001_state::RcptTo:
+
+      if (session.state == NPlugin_001_state::RcptTo) {
+        ++session.rcptIndex;
+      }
+
+      if (getNextMailAddress(receiver, emailTo, session.rcptIndex)) {
+        if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+          addLogMove(LOG_LEVEL_INFO, concat(F("Email: To "), emailTo));
+        }
+        NPlugin_001_sendCmd(concat(F("RCPT TO:<"), emailTo + '>'), 250, NPlugin_001_state::RcptTo);
+      } else if (session.rcptIndex == 0) {
+        addLog(LOG_LEVEL_ERROR, F("Email: No recipient given"));
+        return false;
+      } else {
+        NPlugin_001_sendCmd(F("DATA"), 354, NPlugin_001_state::Data);
+      }
+      break;
+    case NPlugin_001_state::Data:
+    {
+      String message(mail.body);
+      message.replace(F("\r"), F("<br/>")); // re-write line breaks for Content-type: text/html
+
+      if (mail.repeatCount > 0) {
+        message += strformat(F("<br/>(Alert repeated %u times)"), mail.repeatCount);
+      }
+      NPlugin_001_sendCmd(session.mailheader + message + F("\r\n.\r\n"), 250, NPlugin_001_state::Message);
+      break;
+    }
+    case NPlugin_001_state::Message:
+      session.client.println(F("QUIT"));
+      NPlugin_001_finish(true);
+      break;
+  }
+  return true;
 }
 
-bool NPlugin_001_MTA(WiFiClient& client, const String& aStr, uint16_t aWaitForPattern)
+void NPlugin_001_sendCmd(const String& aStr, uint16_t aWaitForPattern, NPlugin_001_state nextState)
 {
+  NPlugin_001_session& session = *NPlugin_001_active;
+
 #ifndef BUILD_NO_DEBUG
   if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
     addLog(LOG_LEVEL_DEBUG, aStr);
   }
 #endif
 
-  if (aStr.length()) { client.println(aStr); }
-
-  // Wait For Response
-  unsigned long timer = millis() + NPLUGIN_001_TIMEOUT;
-
-  backgroundtasks();
+  if (aStr.length()) { session.client.println(aStr); }
+  session.expected = aWaitForPattern;
+  session.state    = nextState;
+  session.timeout  = millis() + NPLUGIN_001_TIMEOUT;
+}
 
-  const String aWaitForPattern_str = String(aWaitForPattern) + ' ';
+// Close the session and remove the email from the queue, or schedule a retry.
+void NPlugin_001_finish(bool success)
+{
+  if (NPlugin_001_active) {
+    NPlugin_001_active->client.flush();
+    NPlugin_001_active->client.stop();
 
-  while (true) {
-    if (timeOutReached(timer)) {
-      if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
-        String log = F("NPlugin_001_MTA: timeout. ");
-        log += aStr;
-        addLogMove(LOG_LEVEL_ERROR, log);
-      }
-      return false;
+    if (!success && loglevelActiveFor(LOG_LEVEL_ERROR)) {
+      addLog(LOG_LEVEL_ERROR, concat(F("EMAIL: Connection Closed With Error. Used header: "), NPlugin_001_active->mailheader));
     }
+    NPlugin_001_active.reset();
+  }
 
-    delay(0);
-
-    // String line = client.readStringUntil('\n');
-    String line;
-    safeReadStringUntil(client, line, '\n');
+  if (NPlugin_001_queue.empty()) {
+    return;
+  }
+  NPlugin_001_mail& mail = NPlugin_001_queue.front();
 
-    const bool patternFound = line.indexOf(aWaitForPattern_str) >= 0;
+  if (success) {
+    addLog(LOG_LEVEL_INFO, F("EMAIL: Connection Closed Successfully"));
 
-# ifndef BUILD_NO_DEBUG
+    NPlugin_001_sent sent;
+    sent.hash              = mail.hash;
+    sent.sent              = millis();
+    sent.notificationIndex = mail.notificationIndex;
 
-    if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-      addLogMove(LOG_LEVEL_DEBUG, line);
+    if (NPlugin_001_history.size() >= NPLUGIN_001_QUEUE_MAX) {
+      NPlugin_001_history.pop_front();
     }
-# endif // ifndef BUILD_NO_DEBUG
+    NPlugin_001_history.push_back(sent);
+    NPlugin_001_queue.pop_front();
+    return;
+  }
 
-    if (patternFound) {
-      return true;
-    }
+  ++mail.attempts;
+
+  if (mail.attempts >= NPLUGIN_001_MAX_ATTEMPTS) {
+    addLog(LOG_LEVEL_ERROR, strformat(F("EMAIL: Delivery failed after %u attempts, email dropped"), mail.attempts));
+    NPlugin_001_queue.pop_front();
+    return;
   }
+  const unsigned long retryDelay = static_cast<unsigned long>(NPLUGIN_001_RETRY_DELAY) << (mail.attempts - 1);
 
-  return false;
+  mail.notBefore = millis() + retryDelay;
+
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    addLogMove(LOG_LEVEL_INFO, strformat(F("EMAIL: Retry in %u sec."), static_cast<unsigned int>(retryDelay / 1000)));
+  }
 }
 
 bool getNextMailAddress(const String& data, String& address, int index)
@@ -8,6 +8,7 @@
 # include "src/Helpers/_Plugin_Helper_webform.h"
 # include "src/Helpers/PortStatus.h"
 # include "src/Helpers/Scheduler.h"
+# include "src/PluginStructs/P001_data_struct.h"
 
 // #######################################################################################################
 // #################################### Plugin 001: Input Switch #########################################
@@ -19,7 +20,7 @@
    0: button type (switch or dimmer)
    1: dim value
    2: button option (normal, push high, push low)
-   3: send boot state (true,false)
+   3: bit 0: send boot state (true,false), bit 1: interrupt mode (true,false)
    4: use doubleclick (0,1,2,3)
    5: use longpress (0,1,2,3)
    6: LP fired (true,false)
@@ -52,6 +53,8 @@
 
 
 # define P001_BOOTSTATE     PCONFIG(3)
+# define P001_BOOTSTATE_BIT 0
+# define P001_INTERRUPT_BIT 1
 # define P001_DEBOUNCE      PCONFIG_FLOAT(0)
 # define P001_DOUBLECLICK   PCONFIG(4)
 # define P001_DC_MAX_INT    PCONFIG_FLOAT(1)
@@ -70,6 +73,16 @@ uint8_t P001_getSwitchType(struct EventStruct *event) {
   return PLUGIN_001_TYPE_SWITCH;
 }
 
+// Long press is enabled for the current state and has not fired yet
+bool P001_longPressPending(struct EventStruct *event, int8_t state) {
+  if (PCONFIG(6) != 0) {
+    return false;
+  }
+  const int16_t longPress = P001_LONGPRESS;
+
+  return (longPress == 3) || ((longPress == 1) && (state == 0)) || ((longPress == 2) && (state == 1));
+}
+
 boolean Plugin_001(uint8_t function, struct EventStruct *event, String& string)
 {
   boolean success = false;
@@ -95,6 +108,11 @@ boolean Plugin_001(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].TimerOptional      = true;
       Device[deviceCount].GlobalSyncOption   = true;
+      Device[deviceCount].PluginCallSubscriptions =
+                                                    # if FEATURE_SWITCH_INTERRUPT
+                                                    PLUGIN_CALL_SUBSCRIBE(FIFTY_PER_SECOND) |
+                                                    # endif // if FEATURE_SWITCH_INTERRUPT
+                                                    PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND);
       break;
     }
 
@@ -152,7 +170,7 @@ boolean Plugin_001(uint8_t function, struct EventStruct *event, String& string)
       }
 
       SwitchWebformLoad(
-        P001_BOOTSTATE,
+        bitRead(P001_BOOTSTATE, P001_BOOTSTATE_BIT),
         P001_DEBOUNCE,
         P001_DOUBLECLICK,
         P001_DC_MAX_INT,
@@ -160,6 +178,11 @@ boolean Plugin_001(uint8_t function, struct EventStruct *event, String& string)
         P001_LP_MIN_INT,
         P001_SAFE_BTN);
 
+      # if FEATURE_SWITCH_INTERRUPT
+      addFormCheckBox(F("Interrupt mode"), F("sw_int"), bitRead(P001_BOOTSTATE, P001_INTERRUPT_BIT));
+      addFormNote(F("Handle input changes from a GPIO interrupt instead of reading the input 10x per second"));
+      # endif // if FEATURE_SWITCH_INTERRUPT
+
       success = true;
       break;
     }
@@ -186,6 +209,10 @@ boolean Plugin_001(uint8_t function, struct EventStruct *event, String& string)
         P001_LP_MIN_INT,
         P001_SAFE_BTN);
 
+      # if FEATURE_SWITCH_INTERRUPT
+      bitWrite(P001_BOOTSTATE, P001_INTERRUPT_BIT, isFormItemChecked(F("sw_int")));
+      # endif // if FEATURE_SWITCH_INTERRUPT
+
       success = true;
       break;
     }
@@ -218,7 +245,7 @@ boolean Plugin_001(uint8_t function, struct EventStruct *event, String& string)
 
         // if boot state must be send, inverse default state
         // this is done to force the trigger in PLUGIN_TEN_PER_SECOND
-        if (P001_BOOTSTATE)
+        if (bitRead(P001_BOOTSTATE, P001_BOOTSTATE_BIT))
         {
           newStatus.state  = !newStatus.state;
           newStatus.output = !newStatus.output;
@@ -256,6 +283,20 @@ boolean Plugin_001(uint8_t function, struct EventStruct *event, String& string)
         if (P001_LP_MIN_INT < SWITCH_LONGPRESS_MIN_INTERVAL) {
           P001_LP_MIN_INT = SWITCH_LONGPRESS_MIN_INTERVAL;
         }
+
+        # if FEATURE_SWITCH_INTERRUPT
+
+        if (bitRead(P001_BOOTSTATE, P001_INTERRUPT_BIT)) {
+          initPluginTaskData(event->TaskIndex,
+                             new (std::nothrow) P001_data_struct(CONFIG_PIN1, newStatus.mode, lround(P001_DEBOUNCE)));
+          P001_data_struct *P001_data =
+            static_cast<P001_data_struct *>(getPluginTaskData(event->TaskIndex));
+
+          if (nullptr != P001_data) {
+            P001_data->init();
+          }
+        }
+        # endif // if FEATURE_SWITCH_INTERRUPT
         success = true;
       }
       break;
@@ -285,7 +326,7 @@ boolean Plugin_001(uint8_t function, struct EventStruct *event, String& string)
           case PLUGIN_UNCONDITIONAL_POLL:
             {
               // port monitoring, generates an event by rule command 'monitor,gpio,port#'
-              for (std::map<uint32_t,portStatusStruct>::iterator it=globalMapPortStatus.begin(); it!=globalMapPortStatus.end(); ++it) {
+              for (auto it=globalMapPortStatus.begin(); it!=globalMapPortStatus.end(); ++it) {
                 if ((it->second.monitor || it->second.command || it->second.init) && getPluginFromKey(it->first)==PLUGIN_ID_001) {
                   const uint16_t port = getPortFromKey(it->first);
                   uint8_t state = Plugin_001_read_switch_state(port, it->second.mode);
@@ -334,6 +375,9 @@ boolean Plugin_001(uint8_t function, struct EventStruct *event, String& string)
           break;
         }
      */
+    # if FEATURE_SWITCH_INTERRUPT
+    case PLUGIN_FIFTY_PER_SECOND:
+    # endif // if FEATURE_SWITCH_INTERRUPT
     case PLUGIN_TEN_PER_SECOND:
     {
       /**************************************************************************\
@@ -360,12 +404,42 @@ boolean Plugin_001(uint8_t function, struct EventStruct *event, String& string)
 
       if (validGpio(CONFIG_PIN1))
       {
+        # if FEATURE_SWITCH_INTERRUPT
+        P001_data_struct *P001_data =
+          static_cast<P001_data_struct *>(getPluginTaskData(event->TaskIndex));
+
+        // Polled tasks are handled 10x per second, tasks in interrupt mode 50x per second.
+        if ((nullptr != P001_data) != (function == PLUGIN_FIFTY_PER_SECOND)) {
+          success = true;
+          break;
+        }
+
+        if ((nullptr != P001_data) &&
+            !P001_data->update() &&
+            (PCONFIG_LONG(3) == 0) &&
+            !P001_longPressPending(event, P001_data->getState())) {
+          // No input change, no long press or safe button check pending
+          success = true;
+          break;
+        }
+        # endif // if FEATURE_SWITCH_INTERRUPT
+
         const uint32_t key = createKey(PLUGIN_GPIO, CONFIG_PIN1);
 
         // WARNING operator [],creates an entry in map if key doesn't exist:
         portStatusStruct currentStatus = globalMapPortStatus[key];
 
-        const int8_t state = GPIO_Read_Switch_State(CONFIG_PIN1, currentStatus.mode);
+        # if FEATURE_SWITCH_INTERRUPT
+
+        // In interrupt mode the debounced state and the time of the last edge are used
+        const int8_t state = (nullptr != P001_data)
+          ? P001_data->getState()
+          : GPIO_Read_Switch_State(CONFIG_PIN1, currentStatus.mode);
+        const unsigned long changeTime = (nullptr != P001_data) ? P001_data->getEdgeTime() : millis();
+        # else // if FEATURE_SWITCH_INTERRUPT
+        const int8_t state             = GPIO_Read_Switch_State(CONFIG_PIN1, currentStatus.mode);
+        const unsigned long changeTime = millis();
+        # endif // if FEATURE_SWITCH_INTERRUPT
 
         //        if (currentStatus.mode != PIN_MODE_OUTPUT )
         //        {
@@ -386,12 +460,20 @@ boolean Plugin_001(uint8_t function, struct EventStruct *event, String& string)
           PCONFIG_LONG(3) = 0;
 
           // reset timer for long press
-          PCONFIG_LONG(2) = millis();
+          PCONFIG_LONG(2) = changeTime;
           PCONFIG(6)      = 0;
 
           const unsigned long debounceTime = timePassedSince(PCONFIG_LONG(0));
+          bool debounced                   = debounceTime >= (unsigned long)lround(P001_DEBOUNCE);
+          # if FEATURE_SWITCH_INTERRUPT
 
-          if (debounceTime >= (unsigned long)lround(P001_DEBOUNCE)) // de-bounce check
+          if (nullptr != P001_data) {
+            // Already debounced when handling the interrupt
+            debounced = true;
+          }
+          # endif // if FEATURE_SWITCH_INTERRUPT
+
+          if (debounced) // de-bounce check
           {
             const unsigned long deltaDC = timePassedSince(PCONFIG_LONG(1));
 
@@ -400,7 +482,7 @@ boolean Plugin_001(uint8_t function, struct EventStruct *event, String& string)
             {
               // reset timer for doubleclick
               PCONFIG(7) = 0;
-              PCONFIG_LONG(1) = millis();
+              PCONFIG_LONG(1) = changeTime;
             }
 
             // just to simplify the reading of the code
@@ -494,15 +576,9 @@ boolean Plugin_001(uint8_t function, struct EventStruct *event, String& string)
           savePortStatus(key, currentStatus);
         }
 
-        // just to simplify the reading of the code
-    # define LP P001_LONGPRESS
-    # define FIRED PCONFIG(6)
-
         // CASE 3: status unchanged. Checking longpress:
         // Check if LP is enabled and if LP has not fired yet
-        else if (!FIRED && ((LP == 3) || ((LP == 1) && (state == 0)) || ((LP == 2) && (state == 1)))) {
-    # undef LP
-    # undef FIRED
+        else if (P001_longPressPending(event, state)) {
 
           /**************************************************************************\
              20181009 - @giig1967g: new longpress logic is:
@@ -36,6 +36,7 @@ boolean Plugin_002(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].PluginStats        = true;
       Device[deviceCount].TaskLogsOwnPeaks   = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND);
       break;
     }
 
@@ -102,6 +103,9 @@ boolean Plugin_002(uint8_t function, struct EventStruct *event, String& string)
       if (nullptr != P002_data) {
         success = true;
         P002_data->init(event);
+        # if FEATURE_ADC_DMA
+        P002_data->startDMA(event);
+        # endif // if FEATURE_ADC_DMA
       }
       break;
     }
@@ -171,10 +175,26 @@ boolean Plugin_002(uint8_t function, struct EventStruct *event, String& string)
 
         if (success) {
           P002_data->init(event);
+          # if FEATURE_ADC_DMA
+          P002_data->startDMA(event);
+          # endif // if FEATURE_ADC_DMA
         }
       }
       break;
     }
+
+    # if FEATURE_ADC_DMA
+    case PLUGIN_GET_CONFIG_VALUE:
+    {
+      P002_data_struct *P002_data =
+        static_cast<P002_data_struct *>(getPluginTaskData(event->TaskIndex));
+
+      if (P002_data != nullptr) {
+        success = P002_data->plugin_get_config_value(event, string);
+      }
+      break;
+    }
+    # endif // if FEATURE_ADC_DMA
   }
   return success;
 }
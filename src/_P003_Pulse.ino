@@ -44,6 +44,8 @@
 # define P003_IDX_DEBOUNCETIME   0
 # define P003_IDX_COUNTERTYPE    1
 # define P003_IDX_MODETYPE       2
+# define P003_IDX_USE_PCNT       3
+# define P003_IDX_PERIOD_STATS   4
 
 // values for WEBFORM Counter Types
 # define P003_NR_COUNTERTYPES               4
@@ -75,6 +77,11 @@ boolean Plugin_003(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].PluginStats        = true;
       Device[deviceCount].TaskLogsOwnPeaks   = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(FIFTY_PER_SECOND) |
+                                                    # if FEATURE_PULSE_PERIOD_STATS
+                                                    PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND) |
+                                                    # endif // if FEATURE_PULSE_PERIOD_STATS
+                                                    PLUGIN_CALL_SUBSCRIBE(WRITE);
       break;
     }
 
@@ -117,6 +124,16 @@ boolean Plugin_003(uint8_t function, struct EventStruct *event, String& string)
         F("raisetype"), 
         static_cast<Internal_GPIO_pulseHelper::GPIOtriggerMode>(PCONFIG(P003_IDX_MODETYPE)));
 
+      # if FEATURE_PULSE_PCNT
+      addFormCheckBox(F("Use Hardware Counter (PCNT)"), F("pcnt"), PCONFIG(P003_IDX_USE_PCNT) == 1);
+      addFormNote(F("Only for Edge Mode Types. Debounce Time is replaced by a glitch filter of max. 12.8 usec."));
+      # endif // if FEATURE_PULSE_PCNT
+
+      # if FEATURE_PULSE_PERIOD_STATS
+      addFormCheckBox(F("Period Statistics"), F("periodstats"), PCONFIG(P003_IDX_PERIOD_STATS) == 1);
+      addFormNote(F("Only for Edge Mode Types without PCNT. Use [<taskname>#PeriodMean], #PeriodMin, #PeriodMax, #PeriodJitter (msec)."));
+      # endif // if FEATURE_PULSE_PERIOD_STATS
+
       success = true;
       break;
     }
@@ -126,6 +143,12 @@ boolean Plugin_003(uint8_t function, struct EventStruct *event, String& string)
       PCONFIG(P003_IDX_DEBOUNCETIME) = getFormItemInt(F("debounce"));
       PCONFIG(P003_IDX_COUNTERTYPE)  = getFormItemInt(F("countertype"));
       PCONFIG(P003_IDX_MODETYPE)     = getFormItemInt(F("raisetype"));
+      # if FEATURE_PULSE_PCNT
+      PCONFIG(P003_IDX_USE_PCNT) = isFormItemChecked(F("pcnt")) ? 1 : 0;
+      # endif // if FEATURE_PULSE_PCNT
+      # if FEATURE_PULSE_PERIOD_STATS
+      PCONFIG(P003_IDX_PERIOD_STATS) = isFormItemChecked(F("periodstats")) ? 1 : 0;
+      # endif // if FEATURE_PULSE_PERIOD_STATS
       success                        = true;
       break;
     }
@@ -138,6 +161,12 @@ boolean Plugin_003(uint8_t function, struct EventStruct *event, String& string)
       config.taskIndex        = event->TaskIndex;
       config.interruptPinMode = static_cast<Internal_GPIO_pulseHelper::GPIOtriggerMode>(PCONFIG(P003_IDX_MODETYPE));
       config.pullupPinMode    = Settings.TaskDevicePin1PullUp[event->TaskIndex] ? INPUT_PULLUP : INPUT;
+      # if FEATURE_PULSE_PCNT
+      config.usePCNT = PCONFIG(P003_IDX_USE_PCNT) == 1;
+      # endif // if FEATURE_PULSE_PCNT
+      # if FEATURE_PULSE_PERIOD_STATS
+      config.usePeriodStats = PCONFIG(P003_IDX_PERIOD_STATS) == 1;
+      # endif // if FEATURE_PULSE_PERIOD_STATS
 
       // FIXME TD-er: Must set the state using globalMapPortStatus
 
@@ -204,6 +233,9 @@ boolean Plugin_003(uint8_t function, struct EventStruct *event, String& string)
         float pulseTime_msec;
         P003_data->pulseHelper.getPulseCounters(pulseCounter, pulseCounterTotal, pulseTime_msec);
         P003_data->pulseHelper.resetPulseCounter();
+        # if FEATURE_PULSE_PERIOD_STATS
+        P003_data->pulseHelper.getPeriodStats(P003_data->periodStats);
+        # endif // if FEATURE_PULSE_PERIOD_STATS
 
 
         // store the current counter values into UserVar (RTC-memory)
@@ -330,6 +362,43 @@ boolean Plugin_003(uint8_t function, struct EventStruct *event, String& string)
       break;
     }
 
+    # if FEATURE_PULSE_PERIOD_STATS
+    case PLUGIN_GET_CONFIG_VALUE:
+    {
+      P003_data_struct *P003_data =
+        static_cast<P003_data_struct *>(getPluginTaskData(event->TaskIndex));
+
+      if (nullptr != P003_data) {
+        const String command = parseString(string, 1);
+        success = true;
+
+        if (equals(command, F("periodmean"))) {
+          string = toString(P003_data->periodStats.mean_msec(), 3);
+        } else if (equals(command, F("periodmin"))) {
+          string = toString(P003_data->periodStats.min_msec(), 3);
+        } else if (equals(command, F("periodmax"))) {
+          string = toString(P003_data->periodStats.max_msec(), 3);
+        } else if (equals(command, F("periodjitter"))) {
+          string = toString(P003_data->periodStats.jitter_msec(), 3);
+        } else {
+          success = false;
+        }
+      }
+      break;
+    }
+
+    case PLUGIN_TEN_PER_SECOND:
+    {
+      P003_data_struct *P003_data =
+        static_cast<P003_data_struct *>(getPluginTaskData(event->TaskIndex));
+
+      if (nullptr != P003_data) {
+        P003_data->pulseHelper.processEdgeTimestamps();
+      }
+      break;
+    }
+    # endif // if FEATURE_PULSE_PERIOD_STATS
+
     case PLUGIN_FIFTY_PER_SECOND:
     {
       P003_data_struct *P003_data =
@@ -8,6 +8,7 @@
 // Maxim Integrated (ex Dallas) DS18B20 datasheet : https://datasheets.maximintegrated.com/en/ds/DS18B20.pdf
 
 /** Changelog:
+ * 2026-10-15 Add 1-Wire Driver selection, RMT driver for ESP32 (single GPIO pin only)
  * 2023-04-18 tonhuisman: Add warning on statistics section for Parasite Powered sensors, as these are unsupported.
  * 2023-04-17 tonhuisman: Use actual sensor resolution, even when using multiple sensors with different resolutions
  * 2023-04-16 tonhuisman: Rename from DS18b20 to 1-Wire Temperature, as it supports several 1-Wire temperature sensors
@@ -38,6 +39,7 @@
 // Used to easily replace a sensor, without configuring.
 // Can only be used for a single instance of this plugin and a single sensor.
 # define P004_SCAN_ON_INIT       PCONFIG(3)
+# define P004_DALLAS_DRIVER      PCONFIG(4)
 
 
 boolean Plugin_004(uint8_t function, struct EventStruct *event, String& string)
@@ -61,6 +63,7 @@ boolean Plugin_004(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].OutputDataType     = Output_Data_type_t::Simple;
       Device[deviceCount].PluginStats        = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE_NONE;
       break;
     }
 
@@ -122,6 +125,9 @@ boolean Plugin_004(uint8_t function, struct EventStruct *event, String& string)
         addFormCheckBox(F("Auto Select Sensor"), F("autoselect"), P004_SCAN_ON_INIT, valueCount > 1);
         addFormNote(F("Auto Select can only be used for 1 Dallas sensor per GPIO pin."));
         Dallas_addr_selector_webform_load(event->TaskIndex, Plugin_004_DallasPin_RX, Plugin_004_DallasPin_TX, valueCount);
+        # if FEATURE_DALLAS_RMT
+        Dallas_driver_webform_load(P004_DALLAS_DRIVER);
+        # endif // if FEATURE_DALLAS_RMT
 
         {
           // Device Resolution select
@@ -196,6 +202,9 @@ boolean Plugin_004(uint8_t function, struct EventStruct *event, String& string)
       }
       P004_SCAN_ON_INIT       = isFormItemChecked(F("autoselect"));
       P004_ERROR_STATE_OUTPUT = getFormItemInt(F("err"));
+      # if FEATURE_DALLAS_RMT
+      P004_DALLAS_DRIVER = Dallas_driver_webform_save();
+      # endif // if FEATURE_DALLAS_RMT
       success                 = true;
       break;
     }
@@ -248,6 +257,9 @@ boolean Plugin_004(uint8_t function, struct EventStruct *event, String& string)
       if (Plugin_004_DallasPin_TX == -1) {
         Plugin_004_DallasPin_TX = Plugin_004_DallasPin_RX;
       }
+      # if FEATURE_DALLAS_RMT
+      Dallas_setDriver(Plugin_004_DallasPin_RX, Plugin_004_DallasPin_TX, static_cast<Dallas_driver_e>(P004_DALLAS_DRIVER));
+      # endif // if FEATURE_DALLAS_RMT
 
       initPluginTaskData(event->TaskIndex, new (std::nothrow) P004_data_struct(
                            event->TaskIndex,
@@ -35,6 +35,7 @@ boolean Plugin_005(uint8_t function, struct EventStruct *event, String& string)
         Device[deviceCount].TimerOption = true;
         Device[deviceCount].GlobalSyncOption = true;
         Device[deviceCount].PluginStats = true;
+        Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE_NONE;
         break;
       }
 
@@ -98,7 +99,24 @@ boolean Plugin_005(uint8_t function, struct EventStruct *event, String& string)
           static_cast<P005_data_struct *>(getPluginTaskData(event->TaskIndex));
 
         if (nullptr != P005_data) {
-          success = P005_data->readDHT(event);
+          const uint32_t startSignal_ms = P005_data->getStartSignalDuration_ms();
+
+          if (startSignal_ms == 0) {
+            success = P005_data->readDHT(event);
+          } else {
+            // Do not block during the long start signal of DHT11/DHT12
+            switch (P005_data->readPhase.getPhase(event->TaskIndex)) {
+              case PluginReadPhase_e::Start:
+                P005_data->sendStartSignal();
+                P005_data->readPhase.conversionStarted(event->TaskIndex, startSignal_ms);
+                break;
+              case PluginReadPhase_e::Wait:
+                break;
+              case PluginReadPhase_e::Collect:
+                success = P005_data->readResponse(event);
+                break;
+            }
+          }
         }
         break;
       }
@@ -35,6 +35,7 @@ boolean Plugin_006(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].PluginStats        = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE_NONE;
       break;
     }
 
@@ -98,25 +99,50 @@ boolean Plugin_006(uint8_t function, struct EventStruct *event, String& string)
       if (nullptr != P006_data) {
         if (P006_data->begin())
         {
-          UserVar[event->BaseVarIndex] = P006_data->readTemperature();
-          int   elev     = PCONFIG(1);
-          float pressure = static_cast<float>(P006_data->readPressure()) / 100.0f;
-
-          if (elev != 0)
-          {
-            pressure = pressureElevation(pressure, elev);
-          }
-          UserVar[event->BaseVarIndex + 1] = pressure;
-
-          if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-            String log = F("BMP  : Temperature: ");
-            log += formatUserVarNoCheck(event->TaskIndex, 0);
-            addLogMove(LOG_LEVEL_INFO, log);
-            log  = F("BMP  : Barometric Pressure: ");
-            log += formatUserVarNoCheck(event->TaskIndex, 1);
-            addLogMove(LOG_LEVEL_INFO, log);
+          switch (P006_data->readPhase.getPhase(event->TaskIndex)) {
+            case PluginReadPhase_e::Start:
+              P006_data->rawTemperatureValid = false;
+              P006_data->startTemperatureConversion();
+              P006_data->readPhase.conversionStarted(event->TaskIndex, P006_TEMPERATURE_CONVERSION_TIME);
+              break;
+            case PluginReadPhase_e::Wait:
+              break;
+            case PluginReadPhase_e::Collect:
+
+              if (!P006_data->rawTemperatureValid) {
+                P006_data->rawTemperature      = P006_data->readRawTemperature();
+                P006_data->rawTemperatureValid = true;
+                P006_data->startPressureConversion();
+                P006_data->readPhase.conversionStarted(event->TaskIndex, P006_PRESSURE_CONVERSION_TIME);
+                break;
+              }
+              {
+                const int32_t UT = P006_data->rawTemperature;
+                const int32_t UP = P006_data->readRawPressure();
+                P006_data->rawTemperatureValid = false;
+
+                UserVar[event->BaseVarIndex] = P006_data->computeTemperature(UT);
+                int   elev     = PCONFIG(1);
+                float pressure = static_cast<float>(P006_data->computePressure(UT, UP)) / 100.0f;
+
+                if (elev != 0)
+                {
+                  pressure = pressureElevation(pressure, elev);
+                }
+                UserVar[event->BaseVarIndex + 1] = pressure;
+
+                if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+                  String log = F("BMP  : Temperature: ");
+                  log += formatUserVarNoCheck(event->TaskIndex, 0);
+                  addLogMove(LOG_LEVEL_INFO, log);
+                  log  = F("BMP  : Barometric Pressure: ");
+                  log += formatUserVarNoCheck(event->TaskIndex, 1);
+                  addLogMove(LOG_LEVEL_INFO, log);
+                }
+                success = true;
+              }
+              break;
           }
-          success = true;
         }
       }
       break;
@@ -47,6 +47,7 @@ boolean Plugin_007(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].OutputDataType     = Output_Data_type_t::Simple;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(WRITE);
       break;
     }
 
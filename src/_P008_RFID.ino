@@ -58,6 +58,8 @@ boolean Plugin_008(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].SendDataOption     = true;
       Device[deviceCount].TimerOption        = false;
       Device[deviceCount].GlobalSyncOption   = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(ONCE_A_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(FIFTY_PER_SECOND);
       break;
     }
 
@@ -109,6 +111,16 @@ boolean Plugin_008(uint8_t function, struct EventStruct *event, String& string)
       break;
     }
 
+    case PLUGIN_FIFTY_PER_SECOND:
+    {
+      P008_data_struct *P008_data = static_cast<P008_data_struct *>(getPluginTaskData(event->TaskIndex));
+
+      if (nullptr != P008_data) {
+        success = P008_data->plugin_fifty_per_second(event);
+      }
+      break;
+    }
+
     case PLUGIN_ONCE_A_SECOND:
     {
       P008_data_struct *P008_data = static_cast<P008_data_struct *>(getPluginTaskData(event->TaskIndex));
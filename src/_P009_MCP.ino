@@ -72,6 +72,8 @@ boolean Plugin_009(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].TimerOptional      = true;
       Device[deviceCount].GlobalSyncOption   = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(WRITE);
       break;
     }
 
@@ -133,6 +135,8 @@ boolean Plugin_009(uint8_t function, struct EventStruct *event, String& string)
       if (it != globalMapPortStatus.end()) {
         it->second.previousTask = event->TaskIndex;
       }
+      addFormPinSelect(PinSelectPurpose::Generic_input, formatGpioName_input_optional(F("INT")), F("taskdevicepin1"), CONFIG_PIN1);
+      addFormNote(F("GPIO connected to INTA or INTB, to only read the MCP23017 after a change of its inputs."));
 
       SwitchWebformLoad(
         P009_BOOTSTATE,
@@ -182,6 +186,11 @@ boolean Plugin_009(uint8_t function, struct EventStruct *event, String& string)
         // Read current status or create empty if it does not exist
         newStatus = globalMapPortStatus[key];
 
+        {
+          const uint8_t unit = (CONFIG_PORT - 1) / 16;
+          GPIO_Expander_INT_attach(PLUGIN_MCP, 0x20 + unit, CONFIG_PORT - (unit * 16), CONFIG_PIN1);
+        }
+
         // read and store current state to prevent switching at boot time
         // "state" could be -1, 0 or 1
         newStatus.state = GPIO_MCP_Read(CONFIG_PORT);
@@ -246,7 +255,9 @@ boolean Plugin_009(uint8_t function, struct EventStruct *event, String& string)
       const uint8_t unit    = (CONFIG_PORT - 1) / 16;
       const uint8_t address = 0x20 + unit;
 
-      if (!I2C_deviceCheck(address, event->TaskIndex, 10, PLUGIN_I2C_GET_ADDRESS)) { // Generate stats
+      // No need to check the device while its INT pin signals no change.
+      if (!GPIO_Expander_INT_idle(PLUGIN_MCP, address) &&
+          !I2C_deviceCheck(address, event->TaskIndex, 10, PLUGIN_I2C_GET_ADDRESS)) { // Generate stats
         break; // Will return the default false for success
       }
       # endif // if FEATURE_I2C_DEVICE_CHECK
@@ -483,6 +494,7 @@ boolean Plugin_009(uint8_t function, struct EventStruct *event, String& string)
     case PLUGIN_EXIT:
     {
       removeTaskFromPort(createKey(PLUGIN_MCP, CONFIG_PORT));
+      GPIO_Expander_INT_detach(PLUGIN_MCP, 0x20 + ((CONFIG_PORT - 1) / 16));
       break;
     }
 
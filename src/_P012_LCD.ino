@@ -10,6 +10,8 @@
 // #######################################################################################################
 
 /** Changelog:
+ * 2026-10-15 tonhuisman: Keep a copy of the displayed characters, only send changed characters
+ *                        Send each character in a single I2C transmission, and consecutive characters batched
  * 2023-03-07 tonhuisman: Parse text to display without trimming off leading and trailing spaces
  * 2023-03: First changelog added, older changes not logged
  */
@@ -54,6 +56,9 @@ boolean Plugin_012(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].ValueCount         = 0;
       Device[deviceCount].SendDataOption     = false;
       Device[deviceCount].TimerOption        = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(ONCE_A_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(WRITE);
       break;
     }
 
@@ -251,7 +256,7 @@ boolean Plugin_012(uint8_t function, struct EventStruct *event, String& string)
             P012_data->lcd.backlight();
           }
           else if (arg1.equalsIgnoreCase(F("Clear"))) {
-            P012_data->lcd.clear();
+            P012_data->clearDisplay();
           }
         }
         else if (cmd.equalsIgnoreCase(F("LCD")))
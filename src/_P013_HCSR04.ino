@@ -58,6 +58,7 @@ boolean                    Plugin_013(uint8_t function, struct EventStruct *even
       Device[deviceCount].TimerOptional    = true;
       Device[deviceCount].GlobalSyncOption = true;
       Device[deviceCount].PluginStats      = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND);
 
       break;
     }
@@ -59,6 +59,7 @@ boolean Plugin_014(uint8_t function, struct EventStruct *event, String& string)
       // Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].PluginStats    = true;
       Device[deviceCount].OutputDataType = Output_Data_type_t::All;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE_NONE;
       break;
     }
 
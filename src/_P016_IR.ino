@@ -23,6 +23,8 @@
 // IRSENDAC,'{"protocol":"COOLIX","power":"on","mode":"dry","fanspeed":"auto","temp":22,"swingv":"max","swingh":"off"}'
 
 /** Changelog:
+ * 2026-10-15 tonhuisman: ESP32: Capture IR messages with the RMT peripheral instead of a GPIO interrupt per edge (FEATURE_IR_RMT),
+ *                        falls back to the interrupt when the RMT channel can't be installed.
  * 2022-08-08 tonhuisman: Optionally (compile-time) disable command handling by setting #define P016_FEATURE_COMMAND_HDNLING 0
  *                        Make reserved buffer size for receiver configurable 100..1024 uint16_t = 200-2048 bytes
  *                        Change UI to show buffer size in bytes instead of 'units' to avoid confusion.
@@ -36,6 +38,7 @@
 
 # include <vector>
 # include "src/PluginStructs/P016_data_struct.h"
+# include "src/Helpers/IR_RMT.h"
 
 # include "src/ESPEasyCore/Serial.h"
 
@@ -195,6 +198,8 @@ boolean Plugin_016(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].SendDataOption     = true;
       Device[deviceCount].TimerOption        = false;
       Device[deviceCount].TimerOptional      = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(ONCE_A_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND);
       break;
     }
 
@@ -251,7 +256,13 @@ boolean Plugin_016(uint8_t function, struct EventStruct *event, String& string)
 
         if (nullptr != irReceiver) {
           irReceiver->setUnknownThreshold(kMinUnknownSize); // Ignore messages with less than minimum on or off pulses.
-          irReceiver->enableIRIn();                         // Start the receiver
+          # if FEATURE_IR_RMT
+
+          if (!IR_RMT_rx_begin(irPin, P016_TIMEOUT))
+          # endif // if FEATURE_IR_RMT
+          {
+            irReceiver->enableIRIn(); // Start the receiver
+          }
           # ifdef PLUGIN_016_DEBUG
           addLog(LOG_LEVEL_INFO, F("P016_PLUGIN_INIT IR receiver initialized"));
           # endif // PLUGIN_016_DEBUG
@@ -283,6 +294,9 @@ boolean Plugin_016(uint8_t function, struct EventStruct *event, String& string)
 
       if (nullptr != irReceiver)
       {
+        # if FEATURE_IR_RMT
+        IR_RMT_rx_end();
+        # endif // if FEATURE_IR_RMT
         irReceiver->disableIRIn(); // Stop the receiver
         delete irReceiver;
         irReceiver = nullptr;
@@ -598,6 +612,10 @@ boolean Plugin_016(uint8_t function, struct EventStruct *event, String& string)
     {
       decode_results results;
 
+      # if FEATURE_IR_RMT
+      IR_RMT_rx_read(irReceiver);
+      # endif // if FEATURE_IR_RMT
+
       if (irReceiver->decode(&results))
       {
         yield(); // Feed the WDT after a time expensive decoding procedure
@@ -1043,6 +1061,13 @@ void enableIR_RX(boolean enable)
 #ifdef PLUGIN_016
 
   if (irReceiver == 0) { return; }
+  # if FEATURE_IR_RMT
+
+  if (IR_RMT_rx_active()) {
+    IR_RMT_rx_enable(enable);
+    return;
+  }
+  # endif // if FEATURE_IR_RMT
 
   if (enable) {
     irReceiver->enableIRIn();  // Start the receiver
@@ -35,6 +35,7 @@ boolean Plugin_018(uint8_t function, struct EventStruct *event, String& string)
         Device[deviceCount].TimerOption = true;
         Device[deviceCount].GlobalSyncOption = true;
         Device[deviceCount].PluginStats = true;
+        Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE_NONE;
         break;
       }
 
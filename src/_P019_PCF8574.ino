@@ -69,6 +69,8 @@ boolean Plugin_019(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].TimerOptional      = true;
       Device[deviceCount].GlobalSyncOption   = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(WRITE);
       break;
     }
 
@@ -136,6 +138,9 @@ boolean Plugin_019(uint8_t function, struct EventStruct *event, String& string)
       if (it != globalMapPortStatus.end()) {
         it->second.previousTask = event->TaskIndex;
       }
+      addFormPinSelect(PinSelectPurpose::Generic_input, formatGpioName_input_optional(F("INT")), F("taskdevicepin1"), CONFIG_PIN1);
+      addFormNote(F("GPIO connected to the INT output, to only read the PCF8574 after a change of its inputs."));
+
       SwitchWebformLoad(
         P019_BOOTSTATE,
         P019_DEBOUNCE,
@@ -184,6 +189,8 @@ boolean Plugin_019(uint8_t function, struct EventStruct *event, String& string)
         // Read current status or create empty if it does not exist
         newStatus = globalMapPortStatus[key];
 
+        GPIO_Expander_INT_attach(PLUGIN_PCF, P019_getAddress(CONFIG_PORT), CONFIG_PORT, CONFIG_PIN1);
+
         // read and store current state to prevent switching at boot time
         // "state" could be -1, 0 or 1
         newStatus.state  = Plugin_019_Read(CONFIG_PORT);
@@ -239,7 +246,7 @@ boolean Plugin_019(uint8_t function, struct EventStruct *event, String& string)
           case PLUGIN_UNCONDITIONAL_POLL:
             {
               // port monitoring, generates an event by rule command 'monitor,pcf,port#'
-              for (std::map<uint32_t,portStatusStruct>::iterator it=globalMapPortStatus.begin(); it!=globalMapPortStatus.end(); ++it) {
+              for (auto it=globalMapPortStatus.begin(); it!=globalMapPortStatus.end(); ++it) {
                 if (getPluginFromKey(it->first)==PLUGIN_ID_019 && (it->second.monitor || it->second.command || it->second.init)) {
                   const uint16_t port = getPortFromKey(it->first);
                   int8_t state = Plugin_019_Read(port);
@@ -301,12 +308,11 @@ boolean Plugin_019(uint8_t function, struct EventStruct *event, String& string)
     {
       # if FEATURE_I2C_DEVICE_CHECK
 
-      const uint8_t unit = (CONFIG_PORT - 1) / 8;
-      uint8_t address    = 0x20 + unit;
-
-      if (unit > 7) { address += 0x10; }
+      const uint8_t address = P019_getAddress(CONFIG_PORT);
 
-      if (!I2C_deviceCheck(address, event->TaskIndex, 10, PLUGIN_I2C_GET_ADDRESS)) {
+      // No need to check the device while its INT pin signals no change.
+      if (!GPIO_Expander_INT_idle(PLUGIN_PCF, address) &&
+          !I2C_deviceCheck(address, event->TaskIndex, 10, PLUGIN_I2C_GET_ADDRESS)) {
         break; // Will return the default false for success
       }
       # endif // if FEATURE_I2C_DEVICE_CHECK
@@ -551,6 +557,7 @@ boolean Plugin_019(uint8_t function, struct EventStruct *event, String& string)
     case PLUGIN_EXIT:
     {
       removeTaskFromPort(createKey(PLUGIN_PCF, CONFIG_PORT));
+      GPIO_Expander_INT_detach(PLUGIN_PCF, P019_getAddress(CONFIG_PORT));
       break;
     }
 
@@ -634,6 +641,15 @@ boolean Plugin_019(uint8_t function, struct EventStruct *event, String& string)
 // ********************************************************************************
 // PCF8574 read
 // ********************************************************************************
+uint8_t P019_getAddress(int port)
+{
+  const uint8_t unit = (port - 1) / 8;
+  uint8_t address    = 0x20 + unit;
+
+  if (unit > 7) { address += 0x10; }
+  return address;
+}
+
 // @giig1967g-20181023: changed to int8_t
 int8_t Plugin_019_Read(uint8_t Par1)
 {
@@ -645,9 +661,8 @@ int8_t Plugin_019_Read(uint8_t Par1)
   if (unit > 7) { address += 0x10; }
 
   // get the current pin status
-  bool is_ok = false;
-  const uint8_t rawState = I2C_read8(address, &is_ok);
-  if (is_ok)
+  uint8_t rawState = 0;
+  if (GPIO_PCF_ReadAllPins(address, &rawState))
   {
     state = ((rawState & _BV(port - 1)) >> (port - 1));
   }
@@ -656,9 +671,8 @@ int8_t Plugin_019_Read(uint8_t Par1)
 
 uint8_t Plugin_019_ReadAllPins(uint8_t address)
 {
-  bool is_ok = false;
-  const uint8_t rawState = I2C_read8(address, &is_ok);
-  return is_ok ? rawState : 0u;
+  uint8_t rawState = 0;
+  return GPIO_PCF_ReadAllPins(address, &rawState) ? rawState : 0u;
 }
 
 // ********************************************************************************
@@ -701,7 +715,7 @@ boolean Plugin_019_Write(uint8_t Par1, uint8_t Par2)
     portmask &= ~(1 << (port - 1));
   }
 
-  I2C_write8(address, portmask);
+  GPIO_PCF_WriteAllPins(address, portmask);
 
   return true;
 }
@@ -7,6 +7,8 @@
 
 /************
  * Changelog:
+ * 2026-10-15 tonhuisman: Add Transparent bridge mode, moving data in bulk between serial and client, with statistics on the Devices page
+ *                        Add option to disable the Nagle algorithm for the client connection
  * 2022-05-28 tonhuisman: Add option to generate events for all lines of a multi-line message
  * 2022-05-26 tonhuisman: Add option to allow processing without webclient connected.
  * No older changelog available.
@@ -39,8 +41,12 @@
 # define P020_FLAGS                     PCONFIG_LONG(0)
 # define P020_FLAG_IGNORE_CLIENT        0
 # define P020_FLAG_MULTI_LINE           1
+# define P020_FLAG_BRIDGE_MODE          2
+# define P020_FLAG_NO_DELAY             3
 # define P020_IGNORE_CLIENT_CONNECTED   bitRead(P020_FLAGS, P020_FLAG_IGNORE_CLIENT)
 # define P020_HANDLE_MULTI_LINE         bitRead(P020_FLAGS, P020_FLAG_MULTI_LINE)
+# define P020_BRIDGE_MODE               bitRead(P020_FLAGS, P020_FLAG_BRIDGE_MODE)
+# define P020_NO_DELAY                  bitRead(P020_FLAGS, P020_FLAG_NO_DELAY)
 
 
 # define P020_QUERY_VALUE        0 // Temp placement holder until we know what selectors are needed.
@@ -72,6 +78,10 @@ boolean Plugin_020(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].SendDataOption     = true;
       Device[deviceCount].TimerOption        = false;
       Device[deviceCount].GlobalSyncOption   = false;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(ONCE_A_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(FIFTY_PER_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(WRITE) |
+                                                    PLUGIN_CALL_SUBSCRIBE(SERIAL_IN);
       break;
     }
     case PLUGIN_GET_DEVICENAME:
@@ -105,6 +115,20 @@ boolean Plugin_020(uint8_t function, struct EventStruct *event, String& string)
       break;
     }
 
+    case PLUGIN_WEBFORM_SHOW_VALUES:
+    {
+      P020_Task *task = static_cast<P020_Task *>(getPluginTaskData(event->TaskIndex));
+
+      if ((nullptr != task) && task->bridgeMode) {
+        uint8_t varNr = VARS_PER_TASK;
+        pluginWebformShowValue(event->TaskIndex, varNr++, F("Serial in"),      String(task->serialBytesIn));
+        pluginWebformShowValue(event->TaskIndex, varNr++, F("Client in"),      String(task->clientBytesIn));
+        pluginWebformShowValue(event->TaskIndex, varNr++, F("RX buffer full"), String(task->serialRxFull));
+        pluginWebformShowValue(event->TaskIndex, varNr++, F("Client dropped"), String(task->clientDropped), true);
+      }
+      break;
+    }
+
     case PLUGIN_WEBFORM_SHOW_GPIO_DESCR:
     {
       string  = F("RST: ");
@@ -140,6 +164,12 @@ boolean Plugin_020(uint8_t function, struct EventStruct *event, String& string)
       addFormNote(F("Standard RX buffer 256B; higher values could be unstable; energy meters could require 1024B"));
       # endif // ifndef LIMIT_BUILD_SIZE
 
+      addFormCheckBox(F("Transparent bridge mode"), F("p020_bridge"), P020_BRIDGE_MODE);
+      # ifndef LIMIT_BUILD_SIZE
+      addFormNote(F("Pass data as-is in both directions, no event processing. RX buffer size is used for the serial port."));
+      # endif // ifndef LIMIT_BUILD_SIZE
+      addFormCheckBox(F("Disable Nagle (TCP no delay)"), F("p020_nodelay"), P020_NO_DELAY);
+
       success = true;
       break;
     }
@@ -156,6 +186,8 @@ boolean Plugin_020(uint8_t function, struct EventStruct *event, String& string)
 
       bitWrite(P020_FLAGS, P020_FLAG_IGNORE_CLIENT, isFormItemChecked(F("p020_ignoreclient")));
       bitWrite(P020_FLAGS, P020_FLAG_MULTI_LINE,    isFormItemChecked(F("p020_multiline")));
+      bitWrite(P020_FLAGS, P020_FLAG_BRIDGE_MODE,   isFormItemChecked(F("p020_bridge")));
+      bitWrite(P020_FLAGS, P020_FLAG_NO_DELAY,      isFormItemChecked(F("p020_nodelay")));
 
       success = true;
       break;
@@ -183,6 +215,8 @@ boolean Plugin_020(uint8_t function, struct EventStruct *event, String& string)
         break;
       }
       task->handleMultiLine = P020_HANDLE_MULTI_LINE;
+      task->noDelay         = P020_NO_DELAY;
+      task->initBridge(P020_BRIDGE_MODE);
 
       // int rxPin =-1;
       // int txPin =-1;
@@ -221,7 +255,8 @@ boolean Plugin_020(uint8_t function, struct EventStruct *event, String& string)
       // serial0 on esp32 is Ser2net: port=2 rxPin=3 txPin=1; serial1 on esp32 is Ser2net: port=4 rxPin=13 txPin=15; Serial2 on esp32 is
       // Ser2net: port=4 rxPin=16 txPin=17
       uint8_t serialconfig = serialHelper_convertOldSerialConfig(P020_SERIAL_CONFIG);
-      task->serialBegin(port, rxPin, txPin, P020_GET_BAUDRATE, serialconfig);
+      task->serialBegin(port, rxPin, txPin, P020_GET_BAUDRATE, serialconfig,
+                        task->bridgeMode ? P020_RX_BUFFER : SOC_UART_FIFO_LEN);
       task->startServer(P020_GET_SERVER_PORT);
 
       if (!task->isInit()) {
@@ -286,7 +321,9 @@ boolean Plugin_020(uint8_t function, struct EventStruct *event, String& string)
 
       bool hasClient = task->hasClientConnected();
 
-      if (P020_IGNORE_CLIENT_CONNECTED || hasClient) {
+      if (task->bridgeMode) {
+        task->handleBridge();
+      } else if (P020_IGNORE_CLIENT_CONNECTED || hasClient) {
         if (hasClient) {
           task->handleClientIn(event);
         }
@@ -304,7 +341,10 @@ boolean Plugin_020(uint8_t function, struct EventStruct *event, String& string)
         break;
       }
 
-      if (P020_IGNORE_CLIENT_CONNECTED || task->hasClientConnected()) {
+      if (task->bridgeMode) {
+        task->hasClientConnected();
+        task->handleBridge();
+      } else if (P020_IGNORE_CLIENT_CONNECTED || task->hasClientConnected()) {
         task->handleSerialIn(event);
       } else {
         task->discardSerialIn();
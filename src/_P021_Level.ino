@@ -51,6 +51,8 @@ boolean Plugin_021(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].ValueCount         = 1;
       Device[deviceCount].SendDataOption     = true;
       Device[deviceCount].TimerOption        = false;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(ONCE_A_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND);
       break;
     }
 
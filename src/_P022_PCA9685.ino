@@ -65,6 +65,7 @@ boolean Plugin_022(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].Custom             = true;
       Device[deviceCount].TimerOption        = false;
       Device[deviceCount].ExitTaskBeforeSave = false;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(WRITE);
       break;
     }
 
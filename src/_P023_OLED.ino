@@ -7,6 +7,8 @@
 // #######################################################################################################
 
 /** Changelog:
+ * 2026-10-15 tonhuisman: Keep a copy of the displayed characters, only send changed characters
+ *                        Send display data and cursor positioning in multi-byte I2C transmissions
  * 2023-03-18 tonhuisman: Show current on-display content on Devices page (75% size, omits trailing empty lines)
  *                        Manually set content via command: oled,x,y,<content> is included in the Devices page content
  *                        Make Interval optional
@@ -49,6 +51,9 @@ boolean Plugin_023(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].SendDataOption     = false;
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].TimerOptional      = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(ONCE_A_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(WRITE);
       break;
     }
 
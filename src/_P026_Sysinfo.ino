@@ -11,6 +11,10 @@
 # include "src/Globals/ESPEasyWiFiEvent.h"
 # include "src/Helpers/Memory.h"
 
+# ifdef USES_C018
+#  include "src/Controller_struct/C018_data_struct.h"
+# endif // ifdef USES_C018
+
 # include "ESPEasy-Globals.h"
 
 # define PLUGIN_026
@@ -22,7 +26,7 @@
 # define P026_SENSOR_TYPE_INDEX  (P026_QUERY1_CONFIG_POS + VARS_PER_TASK)
 # define P026_NR_OUTPUT_VALUES   getValueCountFromSensorType(static_cast<Sensor_VType>(PCONFIG(P026_SENSOR_TYPE_INDEX)))
 
-# define P026_NR_OUTPUT_OPTIONS  14
+# define P026_NR_OUTPUT_OPTIONS  15
 
 const __FlashStringHelper* Plugin_026_valuename(uint8_t value_nr, bool displayString) {
   const __FlashStringHelper* strings[] {
@@ -39,7 +43,8 @@ const __FlashStringHelper* Plugin_026_valuename(uint8_t value_nr, bool displaySt
     F("Free Stack")   , F("freestack"),
     F("None")         , F(""),
     F("WiFi TX pwr")  , F("txpwr"),
-    F("Free 2nd Heap"), F("free2ndheap")
+    F("Free 2nd Heap"), F("free2ndheap"),
+    F("LoRa air time"), F("airtime")
   };
   const size_t index = (2* value_nr) + (displayString ? 0 : 1);
   constexpr size_t nrStrings = NR_ELEMENTS(strings);
@@ -65,6 +70,7 @@ boolean Plugin_026(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].FormulaOption  = true;
       Device[deviceCount].OutputDataType = Output_Data_type_t::Simple;
       Device[deviceCount].PluginStats    = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE_NONE;
       break;
     }
 
@@ -252,6 +258,14 @@ float P026_get_value(uint8_t type)
       res = FreeMem2ndHeap();
       # endif // ifdef USE_SECOND_HEAP
       break;
+    case 14:
+      // Remaining LoRaWAN duty cycle air time in msec
+      # ifdef USES_C018
+      res = C018_getRemainingAirtime();
+      # else // ifdef USES_C018
+      res = -1.0f;
+      # endif // ifdef USES_C018
+      break;
   }
   return res;
 }
@@ -35,6 +35,7 @@ boolean Plugin_032(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].PluginStats        = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE_NONE;
       break;
     }
 
@@ -105,30 +106,47 @@ boolean Plugin_032(uint8_t function, struct EventStruct *event, String& string)
         static_cast<P032_data_struct *>(getPluginTaskData(event->TaskIndex));
 
       if (nullptr != P032_data) {
-        if (P032_data->begin()) {
-          P032_data->read_prom();
-          P032_data->readout();
-
-          UserVar[event->BaseVarIndex] = P032_data->ms5611_temperature / 100;
-
-          const int elev = PCONFIG(1);
-
-          if (elev != 0)
+        switch (P032_data->readPhase.getPhase(event->TaskIndex)) {
+          case PluginReadPhase_e::Start:
+            P032_data->readout_reset();
+
+            if (P032_data->begin()) {
+              P032_data->readPhase.conversionStarted(event->TaskIndex, P032_data->readout_step());
+            }
+            break;
+          case PluginReadPhase_e::Wait:
+            break;
+          case PluginReadPhase_e::Collect:
           {
-            UserVar[event->BaseVarIndex + 1] = pressureElevation(P032_data->ms5611_pressure, elev);
-          } else {
-            UserVar[event->BaseVarIndex + 1] = P032_data->ms5611_pressure;
-          }
-
-          if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-            String log = F("MS5611  : Temperature: ");
-            log += formatUserVarNoCheck(event->TaskIndex, 0);
-            addLogMove(LOG_LEVEL_INFO, log);
-            log  = F("MS5611  : Barometric Pressure: ");
-            log += formatUserVarNoCheck(event->TaskIndex, 1);
-            addLogMove(LOG_LEVEL_INFO, log);
+            const uint32_t waitTime = P032_data->readout_step();
+
+            if (waitTime != 0) {
+              P032_data->readPhase.conversionStarted(event->TaskIndex, waitTime);
+              break;
+            }
+
+            UserVar[event->BaseVarIndex] = P032_data->ms5611_temperature / 100;
+
+            const int elev = PCONFIG(1);
+
+            if (elev != 0)
+            {
+              UserVar[event->BaseVarIndex + 1] = pressureElevation(P032_data->ms5611_pressure, elev);
+            } else {
+              UserVar[event->BaseVarIndex + 1] = P032_data->ms5611_pressure;
+            }
+
+            if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+              String log = F("MS5611  : Temperature: ");
+              log += formatUserVarNoCheck(event->TaskIndex, 0);
+              addLogMove(LOG_LEVEL_INFO, log);
+              log  = F("MS5611  : Barometric Pressure: ");
+              log += formatUserVarNoCheck(event->TaskIndex, 1);
+              addLogMove(LOG_LEVEL_INFO, log);
+            }
+            success = true;
+            break;
           }
-          success = true;
         }
       }
       break;
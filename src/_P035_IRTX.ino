@@ -6,6 +6,7 @@
 // #######################################################################################################
 //
 // Changelog:
+// 2026-10-15, tonhuisman:  ESP32: Transmit via the RMT peripheral, which generates the carrier in hardware (FEATURE_IR_RMT)
 // 2023-07-25, tonhuisman:  Code optimization and deduplication, remove some commented code
 // 2023-07-22, tonhuisman:  Minor code improvements, show IRSENDAC command only in config page if included in build
 // 2023-07-21, tonhuisman:  Add 'Inverted output' option, as supported by the IRsend class.
@@ -62,6 +63,7 @@ boolean Plugin_035(uint8_t function, struct EventStruct *event, String& string)
       Device[++deviceCount].Number       = PLUGIN_ID_035;
       Device[deviceCount].Type           = DEVICE_TYPE_SINGLE;
       Device[deviceCount].SendDataOption = false;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(WRITE);
       break;
     }
 
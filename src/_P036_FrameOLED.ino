@@ -14,6 +14,8 @@
 // Added to the main repository with some optimizations and some limitations.
 // As long as the device is not enabled, no RAM is wasted.
 //
+// @tonhuisman: 2026-10-15
+// CHG: Pre-render the outgoing and incoming page once when page scrolling starts, each scroll step only copies display memory
 // @tonhuisman: 2023-09-16
 // CHG: Some improvements and optimizations, improved struct alignment to reduce bin size, uncrustify sources
 // @uwekaditz: 2023-08-10
@@ -259,6 +261,10 @@ boolean Plugin_036(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].SendDataOption     = false;
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].TimerOptional      = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(ONCE_A_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(FIFTY_PER_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(WRITE);
       break;
     }
 
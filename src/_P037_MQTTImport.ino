@@ -121,6 +121,7 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].ValueCount         = VARS_PER_TASK;
       Device[deviceCount].SendDataOption     = false;
       Device[deviceCount].TimerOption        = false;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE_NONE;
       break;
     }
 
@@ -363,8 +364,9 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
 
       for (uint8_t x = 0; x < VARS_PER_TASK; x++)
       {
-        if (P037_data->mqttTopics[x].length() == 0) {
-          continue; // skip blank subscriptions
+        if ((P037_data->mqttTopics[x].length() == 0) ||
+            ((event->Par1 != 0) && !bitRead(event->Par1, x))) {
+          continue; // skip blank subscriptions and those not matched by the topic trie
         }
 
         // Now check if the incoming topic matches one of our subscriptions
@@ -444,8 +446,8 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
         // json filter check
         if (checkJson && P037_data->hasFilters()) { // See if we pass the filters for all json attributes
           do {
-            key     = P037_data->iter->key().c_str();
-            Payload = P037_data->iter->value().as<String>();
+            key     = P037_data->jsonKey();
+            Payload = P037_data->jsonValue();
             #    if P037_MAPPING_SUPPORT
 
             if (P037_APPLY_MAPPINGS) {
@@ -453,8 +455,8 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
             }
             #    endif // if P037_MAPPING_SUPPORT
             processData = P037_data->checkFilters(key, Payload, x + 1); // Will return true unless key matches *and* Payload doesn't
-            ++P037_data->iter;
-          } while (processData && P037_data->iter != P037_data->doc.end());
+            P037_data->nextJsonAttribute();
+          } while (processData && !P037_data->jsonAtEnd());
         }
         #   endif // P037_FILTER_PER_TOPIC
         #  endif  // if P037_JSON_SUPPORT
@@ -478,8 +480,9 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
       // Get the Topic and see if it matches any of the subscriptions
       for (uint8_t x = 0; x < VARS_PER_TASK && processData; x++)
       {
-        if (P037_data->mqttTopics[x].length() == 0) {
-          continue; // skip blank subscriptions
+        if ((P037_data->mqttTopics[x].length() == 0) ||
+            ((event->Par1 != 0) && !bitRead(event->Par1, x))) {
+          continue; // skip blank subscriptions and those not matched by the topic trie
         }
 
         // Now check if the incoming topic matches one of our subscriptions
@@ -494,11 +497,11 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
           bool passFilter = true;
 
           if (checkJson && P037_data->hasFilters()) { // See if we pass the filters for all json attributes
-            P037_data->iter = P037_data->doc.begin();
+            P037_data->firstJsonAttribute();
 
             do {
-              key     = P037_data->iter->key().c_str();
-              Payload = P037_data->iter->value().as<String>();
+              key     = P037_data->jsonKey();
+              Payload = P037_data->jsonValue();
               #   if P037_MAPPING_SUPPORT
 
               if (P037_APPLY_MAPPINGS) {
@@ -507,9 +510,9 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
               #   endif // if P037_MAPPING_SUPPORT
               passFilter = P037_data->checkFilters(key, Payload, x + 1); // Will return true unless key matches *and* Payload doesn't
 
-              ++P037_data->iter;
-            } while (passFilter && P037_data->iter != P037_data->doc.end());
-            P037_data->iter = P037_data->doc.begin();
+              P037_data->nextJsonAttribute();
+            } while (passFilter && !P037_data->jsonAtEnd());
+            P037_data->firstJsonAttribute();
           }
 
           if (passFilter) // Watch it!
@@ -519,21 +522,14 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
             do {
               # if P037_JSON_SUPPORT
 
-              if (checkJson && (P037_data->iter != P037_data->doc.end())) {
+              if (checkJson && !P037_data->jsonAtEnd()) {
                 String jsonIndex     = parseString(P037_data->jsonAttributes[x], 2, ';');
                 String jsonAttribute = parseStringKeepCase(P037_data->jsonAttributes[x], 1, ';');
                 jsonAttribute.trim();
 
                 if (!jsonAttribute.isEmpty()) {
-                  key = jsonAttribute;
-
-                  if (key.indexOf('.') > -1) {
-                    String part1 = parseStringKeepCase(key, 1, '.');
-                    String part2 = parseStringKeepCase(key, 2, '.');
-                    Payload = P037_data->doc[part1][part2].as<String>();
-                  } else {
-                    Payload = P037_data->doc[key].as<String>();
-                  }
+                  key             = jsonAttribute;
+                  Payload         = P037_data->jsonAttributeValue(x); // Already extracted while parsing the message
                   unparsedPayload = Payload;
                   int8_t jIndex = jsonIndex.toInt();
 
@@ -559,8 +555,8 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
                   #  endif // if !defined(P037_LIMIT_BUILD_SIZE) || defined(P037_OVERRIDE)
                   continueProcessing = false; // no need to loop over all attributes, the configured one is found
                 } else {
-                  key             = P037_data->iter->key().c_str();
-                  Payload         = P037_data->iter->value().as<String>();
+                  key             = P037_data->jsonKey();
+                  Payload         = P037_data->jsonValue();
                   unparsedPayload = Payload;
                 }
                 #  ifdef PLUGIN_037_DEBUG
@@ -578,7 +574,7 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
                   addLogMove(LOG_LEVEL_INFO, log);
                 }
                 #  endif // ifdef PLUGIN_037_DEBUG
-                ++P037_data->iter;
+                P037_data->nextJsonAttribute();
               }
               #  if P037_MAPPING_SUPPORT
 
@@ -692,7 +688,7 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
                 }
                 # if P037_JSON_SUPPORT
 
-                if (checkJson && (P037_data->iter == P037_data->doc.end())) {
+                if (checkJson && P037_data->jsonAtEnd()) {
                   continueProcessing = false;
                 }
                 # endif // if P037_JSON_SUPPORT
@@ -719,6 +715,8 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
 
 bool MQTT_unsubscribe_037(struct EventStruct *event)
 {
+  P037_MQTTImport_topics.removeTask(event->TaskIndex);
+
   P037_data_struct *P037_data = static_cast<P037_data_struct *>(getPluginTaskData(event->TaskIndex));
 
   if (nullptr == P037_data) {
@@ -795,6 +793,8 @@ bool MQTTSubscribe_037(struct EventStruct *event)
   // FIXME TD-er: Should not be needed to load, as it is loaded when constructing it.
   P037_data->loadSettings();
 
+  P037_MQTTImport_topics.removeTask(event->TaskIndex);
+
   // Now loop over all import variables and subscribe to those that are not blank
   for (uint8_t x = 0; x < VARS_PER_TASK; x++) {
     String subscribeTo = P037_data->getFullMQTTTopic(x);
@@ -803,6 +803,8 @@ bool MQTTSubscribe_037(struct EventStruct *event)
       parseSystemVariables(subscribeTo, false);
 
       if (MQTTclient.subscribe(subscribeTo.c_str())) {
+        P037_MQTTImport_topics.add(subscribeTo, event->TaskIndex, x);
+
         if (loglevelActiveFor(LOG_LEVEL_INFO)) {
           String log = F("IMPT : [");
           log += getTaskDeviceName(event->TaskIndex);
@@ -56,6 +56,7 @@ boolean Plugin_038(uint8_t function, struct EventStruct *event, String& string)
       Device[++deviceCount].Number    = PLUGIN_ID_038;
       Device[deviceCount].Type        = DEVICE_TYPE_SINGLE;
       Device[deviceCount].TimerOption = false;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(WRITE);
       break;
     }
 
@@ -214,6 +214,9 @@
 // total number of registers in MAX 31865
 # define MAX31865_NO_REG                 8u
 
+// number of consecutive registers read in one SPI transfer after a conversion: RTD_MSB ... FAULT
+# define MAX31865_RESULT_REG_CNT         (MAX31865_FAULT - MAX31865_RTD_MSB + 1u)
+
 // bit masks to identify failures for MAX 31865
 # define MAX31865_FAULT_HIGHTHRESH   0x80u
 # define MAX31865_FAULT_LOWTHRESH    0x40u
@@ -269,6 +272,7 @@ boolean Plugin_039(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].PluginStats        = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE_NONE;
       break;
     }
 
@@ -370,18 +374,8 @@ boolean Plugin_039(uint8_t function, struct EventStruct *event, String& string)
         // ensure MODE3 access to SPI device
         SPI.setDataMode(SPI_MODE3);
 
-        // write intially 0x00 to CONFIG register
-        write8BitRegister(CS_pin_no, (MAX31865_WRITE_ADDR_BASE + MAX31865_CONFIG), 0x00u);
-
-        // activate 50Hz filter, clear all faults, no auto conversion, no conversion started
-        change8BitRegister(CS_pin_no,
-                           MAX31865_RD_ADDRESS(MAX31865_CONFIG),
-                           MAX31865_WR_ADDRESS(MAX31865_CONFIG),
-                           MAX31865_SET_50HZ,
-                           static_cast<bool>(P039_RTD_FILT_TYPE));
-
-        // configure 2/4-wire sensor connection as default
-        MAX31865_setConType(CS_pin_no, P039_CONFIG_4);
+        // set 50Hz filter and 2/3/4-wire sensor connection, no auto conversion, no conversion started
+        write8BitRegister(CS_pin_no, MAX31865_WR_ADDRESS(MAX31865_CONFIG), MAX31865_getConfig(event));
 
         // set HighFault Threshold
         transfer_n_ByteSPI(CS_pin_no, 3, &initSendBufferHFTH[0]);
@@ -389,15 +383,10 @@ boolean Plugin_039(uint8_t function, struct EventStruct *event, String& string)
         // set LowFault Threshold
         transfer_n_ByteSPI(CS_pin_no, 3, &initSendBufferLFTH[0]);
 
-        // clear all faults
-        MAX31865_clearFaults(CS_pin_no);
-
-        // activate BIAS short before read, to reduce power consumption
-        change8BitRegister(CS_pin_no,
-                           (MAX31865_READ_ADDR_BASE + MAX31865_CONFIG),
-                           (MAX31865_WRITE_ADDR_BASE + MAX31865_CONFIG),
-                           MAX31865_SET_VBIAS_ON,
-                           P039_SET);
+        // clear all faults and activate BIAS short before read, to reduce power consumption
+        write8BitRegister(CS_pin_no,
+                          (MAX31865_WRITE_ADDR_BASE + MAX31865_CONFIG),
+                          MAX31865_getConfig(event) | MAX31865_CLEAR_FAULTS | MAX31865_SET_VBIAS_ON);
 
         if (nullptr != P039_data) {
           // save current timer for next calculation
@@ -707,12 +696,10 @@ boolean Plugin_039(uint8_t function, struct EventStruct *event, String& string)
                 }
                 # endif // ifndef BUILD_NO_DEBUG
 
-                // activate one shot conversion
-                change8BitRegister(CS_pin_no,
-                                   (MAX31865_READ_ADDR_BASE + MAX31865_CONFIG),
-                                   (MAX31865_WRITE_ADDR_BASE + MAX31865_CONFIG),
-                                   MAX31865_SET_ONE_SHOT,
-                                   P039_SET);
+                // activate one shot conversion, config register content is known, no need to read it first
+                write8BitRegister(CS_pin_no,
+                                  (MAX31865_WRITE_ADDR_BASE + MAX31865_CONFIG),
+                                  MAX31865_getConfig(event) | MAX31865_SET_VBIAS_ON | MAX31865_SET_ONE_SHOT);
 
                 // set next state in sequence -> READ STATE
                 // start time to follow up on conversion and read the conversion result
@@ -763,18 +750,20 @@ boolean Plugin_039(uint8_t function, struct EventStruct *event, String& string)
                 }
                 # endif // ifndef BUILD_NO_DEBUG
 
-                // read conversion result
-                P039_data->conversionResult = read16BitRegister(CS_pin_no, (MAX31865_READ_ADDR_BASE + MAX31865_RTD_MSB));
+                {
+                  // read conversion result and fault register in a single transfer,
+                  // the address auto-increments from RTD_MSB up to FAULT
+                  uint8_t l_messageBuffer[MAX31865_RESULT_REG_CNT + 1] = { (MAX31865_READ_ADDR_BASE + MAX31865_RTD_MSB) };
 
-                // deactivate BIAS short after read, to reduce power consumption
-                change8BitRegister(CS_pin_no,
-                                   (MAX31865_READ_ADDR_BASE + MAX31865_CONFIG),
-                                   (MAX31865_WRITE_ADDR_BASE + MAX31865_CONFIG),
-                                   MAX31865_SET_VBIAS_ON,
-                                   P039_RESET);
+                  transfer_n_ByteSPI(CS_pin_no, sizeof(l_messageBuffer), l_messageBuffer);
+                  P039_data->conversionResult = ((l_messageBuffer[1] << 8) | l_messageBuffer[2]);
+                  P039_data->deviceFaults     = l_messageBuffer[MAX31865_RESULT_REG_CNT];
+                }
 
-                // read fault register to get a full picture
-                P039_data->deviceFaults = read8BitRegister(CS_pin_no, (MAX31865_READ_ADDR_BASE + MAX31865_FAULT));
+                // deactivate BIAS short after read, to reduce power consumption
+                write8BitRegister(CS_pin_no,
+                                  (MAX31865_WRITE_ADDR_BASE + MAX31865_CONFIG),
+                                  MAX31865_getConfig(event));
 
                 // mark conversion as ready
                 P039_data->convReady = true;
@@ -804,15 +793,10 @@ boolean Plugin_039(uint8_t function, struct EventStruct *event, String& string)
               case MAX31865_INIT_STATE:
               default:
               {
-                // clear all faults
-                MAX31865_clearFaults(CS_pin_no);
-
-                // activate BIAS short before read, to reduce power consumption
-                change8BitRegister(CS_pin_no,
-                                   (MAX31865_READ_ADDR_BASE + MAX31865_CONFIG),
-                                   (MAX31865_WRITE_ADDR_BASE + MAX31865_CONFIG),
-                                   MAX31865_SET_VBIAS_ON,
-                                   P039_SET);
+                // clear all faults and activate BIAS short before read, to reduce power consumption
+                write8BitRegister(CS_pin_no,
+                                  (MAX31865_WRITE_ADDR_BASE + MAX31865_CONFIG),
+                                  MAX31865_getConfig(event) | MAX31865_CLEAR_FAULTS | MAX31865_SET_VBIAS_ON);
 
 
                 # ifndef BUILD_NO_DEBUG
@@ -1313,26 +1297,11 @@ float readMax31865(struct EventStruct *event)
   # endif // ifndef BUILD_NO_DEBUG
 
   // Prepare and start next conversion, before handling faults and rawValue
-  // clear all faults
-  MAX31865_clearFaults(CS_pin_no);
-
-  // set frequency filter
-  change8BitRegister(CS_pin_no,
-                     (MAX31865_READ_ADDR_BASE + MAX31865_CONFIG),
-                     (MAX31865_WRITE_ADDR_BASE + MAX31865_CONFIG),
-                     MAX31865_SET_50HZ,
-                     static_cast<bool>(P039_RTD_FILT_TYPE));
-
-
-  // configure read access with configuration from web interface
-  MAX31865_setConType(CS_pin_no, P039_CONFIG_4);
-
-  // activate BIAS short before read, to reduce power consumption
-  change8BitRegister(CS_pin_no,
-                     (MAX31865_READ_ADDR_BASE + MAX31865_CONFIG),
-                     (MAX31865_WRITE_ADDR_BASE + MAX31865_CONFIG),
-                     MAX31865_SET_VBIAS_ON,
-                     P039_SET);
+  // clear all faults, set frequency filter and connection type from web interface
+  // and activate BIAS short before read, to reduce power consumption; all in a single register write
+  write8BitRegister(CS_pin_no,
+                    (MAX31865_WRITE_ADDR_BASE + MAX31865_CONFIG),
+                    MAX31865_getConfig(event) | MAX31865_CLEAR_FAULTS | MAX31865_SET_VBIAS_ON);
 
   // start time to follow up on BIAS activation before starting the conversion
   // and start conversion sequence via TIMER API
@@ -1459,46 +1428,30 @@ float readMax31865(struct EventStruct *event)
   }
 }
 
-void MAX31865_clearFaults(int8_t l_CS_pin_no)
-{
-  uint8_t l_reg = 0u;
-
-  // read in config register
-  l_reg = read8BitRegister(l_CS_pin_no, (MAX31865_READ_ADDR_BASE + MAX31865_CONFIG));
-
+/**************************************************************************/
 
-  // clear all faults ( write "0" to D2, D3, D5; write "1" to D2)
-  l_reg &= ~(MAX31865_SET_ONE_SHOT | MAX31865_FAULT_CTRL_MASK);
-  l_reg |= MAX31865_CLEAR_FAULTS;
+/*!
+    @brief Compute the MAX31865 CONFIG register content from the task settings,
+    so it can be written directly instead of a read-modify-write per flag
+    @param event the task event, for the filter and connection type settings
 
-  // write configuration
-  write8BitRegister(l_CS_pin_no, (MAX31865_WRITE_ADDR_BASE + MAX31865_CONFIG), l_reg);
-}
+    @returns CONFIG register with 50Hz filter and 3-wire flags, BIAS off, no conversion started
+ */
 
-void MAX31865_setConType(int8_t l_CS_pin_no, uint8_t l_conType)
+/**************************************************************************/
+uint8_t MAX31865_getConfig(struct EventStruct *event)
 {
-  bool l_set_reset = false;
+  uint8_t l_reg = 0u;
 
-  // configure if 3 WIRE bit will be set/reset
-  switch (l_conType)
-  {
-    case 0:
-      l_set_reset = P039_RESET;
-      break;
-    case 1:
-      l_set_reset = P039_SET;
-      break;
-    default:
-      l_set_reset = P039_RESET;
-      break;
+  if (static_cast<bool>(P039_RTD_FILT_TYPE)) {
+    l_reg |= MAX31865_SET_50HZ;
   }
 
-  // change to configuration register
-  change8BitRegister(l_CS_pin_no,
-                     (MAX31865_READ_ADDR_BASE + MAX31865_CONFIG),
-                     (MAX31865_WRITE_ADDR_BASE + MAX31865_CONFIG),
-                     MAX31865_SET_3WIRE,
-                     l_set_reset);
+  // 1 = 3-wire, all other values are 2/4-wire
+  if (P039_CONFIG_4 == 1) {
+    l_reg |= MAX31865_SET_3WIRE;
+  }
+  return l_reg;
 }
 
 /**************************************************************************/
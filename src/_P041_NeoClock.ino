@@ -36,6 +36,9 @@ boolean Plugin_041(uint8_t function, struct EventStruct *event, String& string)
         Device[deviceCount].FormulaOption = false;
         Device[deviceCount].ValueCount = 0;
         Device[deviceCount].SendDataOption = false;
+        Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(ONCE_A_SECOND) |
+                                                      PLUGIN_CALL_SUBSCRIBE(WRITE) |
+                                                      PLUGIN_CALL_SUBSCRIBE(CLOCK_IN);
         break;
       }
 
@@ -37,6 +37,7 @@ boolean Plugin_043(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].ValueCount         = 2;
       Device[deviceCount].SendDataOption     = true;
       Device[deviceCount].OutputDataType     = Output_Data_type_t::Simple;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(CLOCK_IN);
       break;
     }
 
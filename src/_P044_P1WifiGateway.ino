@@ -10,6 +10,12 @@
 //    See also http://domoticx.com/p1-poort-slimme-meter-hardware/
 //#######################################################################################################
 
+/** Changelog:
+ * 2026-10-15 tonhuisman: Send the telegram to the client per line while receiving, CRC is calculated per character,
+ *                        the complete telegram is no longer stored.
+ *                        Optionally parse up to 4 OBIS codes into task values.
+ */
+
 
 #include "src/Helpers/_Plugin_Helper_serial.h"
 #include "src/PluginStructs/P044_data_struct.h"
@@ -29,6 +35,7 @@
 #define P044_RX_WAIT              PCONFIG(0)
 #define P044_SERIAL_CONFIG        PCONFIG(1)
 #define P044_RESET_TARGET_PIN     CONFIG_PIN1
+#define P044_NR_VALUES            PCONFIG(2)
  
 
 
@@ -45,6 +52,10 @@ boolean Plugin_044(uint8_t function, struct EventStruct *event, String& string)
         Device[deviceCount].Type = DEVICE_TYPE_SINGLE;
         Device[deviceCount].Custom = true;
         Device[deviceCount].TimerOption = false;
+        Device[deviceCount].SendDataOption = true;
+        Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(ONCE_A_SECOND) |
+                                                      PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND) |
+                                                      PLUGIN_CALL_SUBSCRIBE(SERIAL_IN);
         break;
       }
 
@@ -54,6 +65,36 @@ boolean Plugin_044(uint8_t function, struct EventStruct *event, String& string)
         break;
       }
 
+    case PLUGIN_GET_DEVICEVALUENAMES:
+      {
+        for (uint8_t i = 0; i < P044_NR_OBIS_VALUES; ++i) {
+          safe_strncpy(ExtraTaskSettings.TaskDeviceValueNames[i], concat(F("Value"), i + 1),
+                       sizeof(ExtraTaskSettings.TaskDeviceValueNames[i]));
+        }
+        break;
+      }
+
+    case PLUGIN_GET_DEVICEVALUECOUNT:
+      {
+        event->Par1 = P044_NR_VALUES;
+        success     = true;
+        break;
+      }
+
+    case PLUGIN_GET_DEVICEVTYPE:
+      {
+        const Sensor_VType vtypes[] = {
+          Sensor_VType::SENSOR_TYPE_NONE,
+          Sensor_VType::SENSOR_TYPE_SINGLE,
+          Sensor_VType::SENSOR_TYPE_DUAL,
+          Sensor_VType::SENSOR_TYPE_TRIPLE,
+          Sensor_VType::SENSOR_TYPE_QUAD
+        };
+        event->sensorType = vtypes[P044_NR_VALUES <= P044_NR_OBIS_VALUES ? P044_NR_VALUES : 0];
+        success           = true;
+        break;
+      }
+
     case PLUGIN_WEBFORM_LOAD:
       {
       	addFormNumericBox(F("TCP Port"), F("p044_port"), P044_GET_WIFI_SERVER_PORT, 0);
@@ -67,6 +108,17 @@ boolean Plugin_044(uint8_t function, struct EventStruct *event, String& string)
 
       	addFormNumericBox(F("RX Receive Timeout (mSec)"), F("p044_rxwait"), P044_RX_WAIT, 0);
 
+        {
+          addFormSubHeader(F("Task values"));
+          String obisCodes[P044_NR_OBIS_VALUES];
+          LoadCustomTaskSettings(event->TaskIndex, obisCodes, P044_NR_OBIS_VALUES, P044_OBIS_CODE_LENGTH);
+
+          for (uint8_t i = 0; i < P044_NR_OBIS_VALUES; ++i) {
+            addFormTextBox(concat(F("OBIS code value "), i + 1), getPluginCustomArgName(i), obisCodes[i], P044_OBIS_CODE_LENGTH - 1);
+          }
+          addFormNote(F("E.g. 1-0:1.8.1 for energy delivered (tariff 1). Empty code ends the list of values."));
+        }
+
         success = true;
         break;
       }
@@ -78,6 +130,25 @@ boolean Plugin_044(uint8_t function, struct EventStruct *event, String& string)
         P044_RX_WAIT = getFormItemInt(F("p044_rxwait"));
         P044_SERIAL_CONFIG = serialHelper_serialconfig_webformSave();
 
+        {
+          String obisCodes[P044_NR_OBIS_VALUES];
+          P044_NR_VALUES = 0;
+
+          for (uint8_t i = 0; i < P044_NR_OBIS_VALUES; ++i) {
+            obisCodes[i] = webArg(getPluginCustomArgName(i));
+            obisCodes[i].trim();
+
+            if ((P044_NR_VALUES == i) && !obisCodes[i].isEmpty()) {
+              ++P044_NR_VALUES;
+            }
+          }
+          const String error = SaveCustomTaskSettings(event->TaskIndex, obisCodes, P044_NR_OBIS_VALUES, P044_OBIS_CODE_LENGTH);
+
+          if (!error.isEmpty()) {
+            addHtmlError(error);
+          }
+        }
+
         success = true;
         break;
       }
@@ -112,6 +183,7 @@ boolean Plugin_044(uint8_t function, struct EventStruct *event, String& string)
         uint8_t serialconfig = serialHelper_convertOldSerialConfig(P044_SERIAL_CONFIG);
         task->serialBegin(ESPEasySerialPort::not_set,  rxPin, txPin, P044_GET_BAUDRATE, serialconfig);
         task->startServer(P044_GET_WIFI_SERVER_PORT);
+        task->loadObisCodes(event->TaskIndex);
 
         if (!task->isInit()) {
           clearPluginTaskData(event->TaskIndex);
@@ -187,7 +259,8 @@ boolean Plugin_044(uint8_t function, struct EventStruct *event, String& string)
         if (nullptr == task) {
           break;
         }
-        if (task->hasClientConnected()) {
+        // Also process without a client when values are parsed from the telegram
+        if (task->hasClientConnected() || (task->nrObisValues > 0)) {
           task->handleSerialIn(event);
         } else {
           task->discardSerialIn();
@@ -55,6 +55,12 @@
 //              Settings.TaskDevicePluginConfig[x][7]     - Last known status of switch
 //              Settings.TaskDevicePluginConfigLong[x][0] - Minimal detection threshold counter
 //              Settings.TaskDevicePluginConfigLong[x][1] - Detection threshold window counter
+//              Settings.TaskDevicePluginConfigLong[x][2] - Detection on any axis (inverted)
+//              Settings.TaskDevicePluginConfigLong[x][3] - FIFO sample rate in Hz, 0 = FIFO not used
+
+// Changelog:
+// 2026-10-15 Add FIFO mode, collecting accelerometer samples at up to 500 Hz, read in bursts 10x per second.
+//            Add Vibration RMS and Vibration peak functions.
 
 
 // FIXME TD-er: Reverted to old version before adding Plugin_task_data array
@@ -88,6 +94,8 @@ boolean Plugin_045(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption    = true;
       Device[deviceCount].FormulaOption  = false;
       Device[deviceCount].PluginStats    = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(ONCE_A_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND);
       break;
     }
 
@@ -130,7 +138,7 @@ boolean Plugin_045(uint8_t function, struct EventStruct *event, String& string)
     {
       uint8_t choice = PCONFIG(1);
       {
-        const __FlashStringHelper *options[10] = {
+        const __FlashStringHelper *options[P045_NR_FUNCTIONS] = {
           F("Movement detection"),
           F("Range acceleration X"),
           F("Range acceleration Y"),
@@ -140,9 +148,19 @@ boolean Plugin_045(uint8_t function, struct EventStruct *event, String& string)
           F("Acceleration Z"),
           F("G-force X"),
           F("G-force Y"),
-          F("G-force Z")
+          F("G-force Z"),
+          F("Vibration RMS"),
+          F("Vibration peak")
         };
-        addFormSelector(F("Function"), F("pfunction"), 10, options, nullptr, choice);
+        addFormSelector(F("Function"), F("pfunction"), P045_NR_FUNCTIONS, options, nullptr, choice);
+      }
+
+      {
+        const __FlashStringHelper *options[] = { F("Off"), F("100"), F("200"), F("500") };
+        const int optionValues[]             = { 0, 100, 200, 500 };
+        addFormSelector(F("FIFO sample rate"), F("pfifo"), 4, options, optionValues, P045_FIFO_RATE);
+        addUnit(F("Hz"));
+        addFormNote(F("With FIFO, all accelerometer samples are collected by the sensor and read in bursts, for ranges and vibration values."));
       }
 
       if (choice == 0) {
@@ -177,6 +195,7 @@ boolean Plugin_045(uint8_t function, struct EventStruct *event, String& string)
       PCONFIG(5)      = getFormItemInt(F("pthld_counter"));
       PCONFIG(6)      = getFormItemInt(F("pthld_window"));
       PCONFIG_LONG(2) = isFormItemChecked(F("pmultiaxes")) ? 0 : 1; // Inverted setting, default is backward compatible, 3 axis
+      P045_FIFO_RATE  = getFormItemInt(F("pfifo"));
 
       if (PCONFIG(6) < PCONFIG(5)) {
         PCONFIG(6) = PCONFIG(5);
@@ -200,7 +219,7 @@ boolean Plugin_045(uint8_t function, struct EventStruct *event, String& string)
         static_cast<P045_data_struct *>(getPluginTaskData(event->TaskIndex));
 
       if (nullptr != P045_data) {
-        P045_data->init();
+        P045_data->init(P045_FIFO_RATE);
         success = true;
       }
 
@@ -224,11 +243,24 @@ boolean Plugin_045(uint8_t function, struct EventStruct *event, String& string)
       break;
     }
 
+    case PLUGIN_TEN_PER_SECOND:
+    {
+      if (P045_FIFO_RATE > 0) {
+        P045_data_struct *P045_data =
+          static_cast<P045_data_struct *>(getPluginTaskData(event->TaskIndex));
+
+        if (nullptr != P045_data) {
+          P045_data->readFIFO();
+          success = true;
+        }
+      }
+      break;
+    }
+
     case PLUGIN_READ:
     {
-      // Use const pointer here, as we don't want to change data, only read it
-      const P045_data_struct *P045_data =
-        static_cast<const P045_data_struct *>(getPluginTaskData(event->TaskIndex));
+      P045_data_struct *P045_data =
+        static_cast<P045_data_struct *>(getPluginTaskData(event->TaskIndex));
 
       if (nullptr != P045_data) {
         int _P045_Function = PCONFIG(1);
@@ -292,6 +324,18 @@ boolean Plugin_045(uint8_t function, struct EventStruct *event, String& string)
             break;
           }
 
+          // Vibration values cover all samples since the previous read
+          case P045_FUNCTION_VIBRATION_RMS:
+          case P045_FUNCTION_VIBRATION_PEAK:
+          {
+            float rms, peak;
+            P045_data->getVibration(rms, peak);
+            P045_data->clearVibration();
+            UserVar[event->BaseVarIndex] = (_P045_Function == P045_FUNCTION_VIBRATION_RMS) ? rms : peak;
+            success                      = true;
+            break;
+          }
+
           // All other functions are reading values. So extract xyz value and wanted type from function number:
           default:                                            // [1-3]: range-values, [4-6]: a-values, [7-9]: g-values
           {
@@ -48,6 +48,7 @@ boolean Plugin_052(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].OutputDataType     = Output_Data_type_t::Simple;
       Device[deviceCount].ExitTaskBeforeSave = false;
       Device[deviceCount].PluginStats        = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(WRITE);
       break;
     }
 
@@ -10,6 +10,9 @@
 // The PMSx003 are particle sensors. Particles are measured by blowing air through the enclosure and,
 // together with a laser, count the amount of particles. These sensors have an integrated microcontroller
 // that counts particles and transmits measurement data over the serial connection.
+//
+// Changelog:
+// 2026-10-15 tonhuisman: On ESP32 hardware serial, read a packet when woken by the UART driver receive timeout (end of packet).
 
 # include "src/PluginStructs/P053_data_struct.h"
 
@@ -54,6 +57,8 @@ boolean Plugin_053(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].GlobalSyncOption = true;
       Device[deviceCount].PluginStats      = true;
       success                              = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(WRITE);
       break;
     }
 
@@ -338,6 +343,9 @@ boolean Plugin_053(uint8_t function, struct EventStruct *event, String& string)
     // The update rate from the module is 200ms .. multiple seconds. Practise
     // shows that we need to read the buffer many times per seconds to stay in
     // sync.
+    # if FEATURE_SERIAL_RX_EVENT
+    case PLUGIN_TASKTIMER_IN: // Woken when a packet was received, see serialHelper_enableRxEvent()
+    # endif // if FEATURE_SERIAL_RX_EVENT
     case PLUGIN_TEN_PER_SECOND:
     {
       P053_data_struct *P053_data =
@@ -88,6 +88,8 @@ boolean Plugin_054(uint8_t function, struct EventStruct *event, String& string)
         Device[deviceCount].TimerOption = false;
         Device[deviceCount].TimerOptional = false;
         Device[deviceCount].GlobalSyncOption = true;
+        Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND) |
+                                                      PLUGIN_CALL_SUBSCRIBE(WRITE);
         break;
       }
 
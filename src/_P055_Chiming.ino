@@ -98,6 +98,10 @@ boolean Plugin_055(uint8_t function, struct EventStruct *event, String& string)
         Device[deviceCount].TimerOption = false;
         Device[deviceCount].TimerOptional = false;
         Device[deviceCount].GlobalSyncOption = true;
+        Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND) |
+                                                      PLUGIN_CALL_SUBSCRIBE(FIFTY_PER_SECOND) |
+                                                      PLUGIN_CALL_SUBSCRIBE(WRITE) |
+                                                      PLUGIN_CALL_SUBSCRIBE(CLOCK_IN);
         break;
       }
 
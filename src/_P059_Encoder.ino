@@ -14,7 +14,11 @@
 // Optional use 3rd GPIO for encoders I signal to reset counter to 0 at first trigger.
 // If counter runs in wrong direction, change A and B GPIOs in settings page
 
-// Note: Up to 4 encoders can be used simultaneously
+// Note: Up to 4 encoders can be used simultaneously, more on ESP32 when using PCNT
+
+/** Changelog:
+ * 2026-10-15 Optional quadrature decoding with the PCNT peripheral (ESP32), the counter is read 10x per second.
+ */
 
 
 # define PLUGIN_059
@@ -22,9 +26,7 @@
 # define PLUGIN_NAME_059       "Switch Input - Rotary Encoder"
 # define PLUGIN_VALUENAME1_059 "Counter"
 
-# include <QEIx4.h>
-
-std::map<unsigned int, std::shared_ptr<QEIx4> > P_059_sensordefs;
+# include "src/PluginStructs/P059_data_struct.h"
 
 boolean Plugin_059(uint8_t function, struct EventStruct *event, String& string)
 {
@@ -46,6 +48,8 @@ boolean Plugin_059(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].TimerOptional      = true;
       Device[deviceCount].GlobalSyncOption   = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(WRITE);
       break;
     }
 
@@ -72,19 +76,24 @@ boolean Plugin_059(uint8_t function, struct EventStruct *event, String& string)
     case PLUGIN_WEBFORM_LOAD:
     {
       // default values
-      if ((PCONFIG_LONG(0) == 0) && (PCONFIG_LONG(1) == 0)) {
-        PCONFIG_LONG(1) = 100;
+      if ((P059_LIMIT_MIN == 0) && (P059_LIMIT_MAX == 0)) {
+        P059_LIMIT_MAX = 100;
       }
 
       {
         const __FlashStringHelper *options[3] = { F("1"), F("2"), F("4") };
         int optionValues[3]                   = { 1, 2, 4 };
-        addFormSelector(F("Mode"), F("mode"), 3, options, optionValues, PCONFIG(0));
+        addFormSelector(F("Mode"), F("mode"), 3, options, optionValues, P059_MODE);
         addUnit(F("pulses per cycle"));
       }
 
-      addFormNumericBox(F("Limit min."), F("limitmin"), PCONFIG_LONG(0));
-      addFormNumericBox(F("Limit max."), F("limitmax"), PCONFIG_LONG(1));
+      addFormNumericBox(F("Limit min."), F("limitmin"), P059_LIMIT_MIN);
+      addFormNumericBox(F("Limit max."), F("limitmax"), P059_LIMIT_MAX);
+
+      # if FEATURE_ENCODER_PCNT
+      addFormCheckBox(F("Use Hardware Counter (PCNT)"), F("pcnt"), P059_USE_PCNT == 1);
+      addFormNote(F("Decodes A/B without interrupts. The Index pin is only checked when the counter is read."));
+      # endif // if FEATURE_ENCODER_PCNT
 
       success = true;
       break;
@@ -92,10 +101,14 @@ boolean Plugin_059(uint8_t function, struct EventStruct *event, String& string)
 
     case PLUGIN_WEBFORM_SAVE:
     {
-      PCONFIG(0) = getFormItemInt(F("mode"));
+      P059_MODE = getFormItemInt(F("mode"));
 
-      PCONFIG_LONG(0) = getFormItemInt(F("limitmin"));
-      PCONFIG_LONG(1) = getFormItemInt(F("limitmax"));
+      P059_LIMIT_MIN = getFormItemInt(F("limitmin"));
+      P059_LIMIT_MAX = getFormItemInt(F("limitmax"));
+
+      # if FEATURE_ENCODER_PCNT
+      P059_USE_PCNT = isFormItemChecked(F("pcnt")) ? 1 : 0;
+      # endif // if FEATURE_ENCODER_PCNT
 
       success = true;
       break;
@@ -105,17 +118,18 @@ boolean Plugin_059(uint8_t function, struct EventStruct *event, String& string)
     {
       portStatusStruct newStatus;
 
-      // create sensor instance and add to std::map
-      P_059_sensordefs.erase(event->TaskIndex);
-      P_059_sensordefs[event->TaskIndex] = std::shared_ptr<QEIx4>(new QEIx4);
+      initPluginTaskData(event->TaskIndex, new (std::nothrow) P059_data_struct());
+      P059_data_struct *P059_data = static_cast<P059_data_struct *>(getPluginTaskData(event->TaskIndex));
 
-      P_059_sensordefs[event->TaskIndex]->begin(CONFIG_PIN1, CONFIG_PIN2, CONFIG_PIN3, PCONFIG(0));
-      P_059_sensordefs[event->TaskIndex]->setLimit(PCONFIG_LONG(0), PCONFIG_LONG(1));
-      P_059_sensordefs[event->TaskIndex]->setIndexTrigger(true);
+      if ((nullptr == P059_data) ||
+          !P059_data->begin(CONFIG_PIN1, CONFIG_PIN2, CONFIG_PIN3, P059_MODE, P059_LIMIT_MIN, P059_LIMIT_MAX, P059_USE_PCNT == 1)) {
+        clearPluginTaskData(event->TaskIndex);
+        break;
+      }
 
       ExtraTaskSettings.TaskDeviceValueDecimals[event->BaseVarIndex] = 0;
 
-      String log = F("QEI  : GPIO: ");
+      String log = P059_data->usesPCNT() ? F("QEI  : PCNT GPIO: ") : F("QEI  : GPIO: ");
 
       for (uint8_t i = 0; i < 3; i++)
       {
@@ -146,25 +160,26 @@ boolean Plugin_059(uint8_t function, struct EventStruct *event, String& string)
       break;
     }
 
-    case PLUGIN_EXIT:
-    {
-      P_059_sensordefs.erase(event->TaskIndex);
-      break;
-    }
-
     case PLUGIN_TEN_PER_SECOND:
     {
-      if (P_059_sensordefs.count(event->TaskIndex) != 0)
+      P059_data_struct *P059_data = static_cast<P059_data_struct *>(getPluginTaskData(event->TaskIndex));
+
+      if (nullptr != P059_data)
       {
-        if (P_059_sensordefs[event->TaskIndex]->hasChanged())
+        // With PCNT, all steps since the previous call are reported as a single change
+        if (P059_data->hasChanged())
         {
-          long c = P_059_sensordefs[event->TaskIndex]->read();
+          const long c     = P059_data->read();
+          const long delta = c - static_cast<long>(UserVar[event->BaseVarIndex]);
           UserVar[event->BaseVarIndex] = c;
           event->sensorType            = Sensor_VType::SENSOR_TYPE_SWITCH;
 
           if (loglevelActiveFor(LOG_LEVEL_INFO)) {
             String log = F("QEI  : ");
             log += c;
+            log += F(" (");
+            log += delta;
+            log += ')';
             addLogMove(LOG_LEVEL_INFO, log);
           }
 
@@ -177,9 +192,11 @@ boolean Plugin_059(uint8_t function, struct EventStruct *event, String& string)
 
     case PLUGIN_READ:
     {
-      if (P_059_sensordefs.count(event->TaskIndex) != 0)
+      P059_data_struct *P059_data = static_cast<P059_data_struct *>(getPluginTaskData(event->TaskIndex));
+
+      if (nullptr != P059_data)
       {
-        UserVar[event->BaseVarIndex] = P_059_sensordefs[event->TaskIndex]->read();
+        UserVar[event->BaseVarIndex] = P059_data->read();
       }
       success = true;
       break;
@@ -187,7 +204,9 @@ boolean Plugin_059(uint8_t function, struct EventStruct *event, String& string)
 
     case PLUGIN_WRITE:
     {
-      if (P_059_sensordefs.count(event->TaskIndex) != 0)
+      P059_data_struct *P059_data = static_cast<P059_data_struct *>(getPluginTaskData(event->TaskIndex));
+
+      if (nullptr != P059_data)
       {
         String command = parseString(string, 1);
 
@@ -200,7 +219,7 @@ boolean Plugin_059(uint8_t function, struct EventStruct *event, String& string)
               log += string;
               addLogMove(LOG_LEVEL_INFO, log);
             }
-            P_059_sensordefs[event->TaskIndex]->write(event->Par1);
+            P059_data->write(event->Par1);
             Scheduler.schedule_task_device_timer(event->TaskIndex, millis());
           }
           success = true; // Command is handled.
@@ -17,6 +17,7 @@
 
 // Note: The chip has a wide view-of-angle. If housing is in this angle the chip blocks!
 
+// 2026-10-15: Optional INT pin, to only read gesture data after the sensor signals a gesture, instead of polling 10x per second
 // 2022-08-12 tonhuisman: Remove [DEVELOPMENT] tag
 // 2022-08-05 tonhuisman: Remove [TESTING] tag, Improvement: INIT, 10/sec and READ events now return false if errors occur during processing
 // 2022-06-17 tonhuisman: Remove I2C address selector, as there is nothing to choose...
@@ -53,6 +54,7 @@
 # define P064_PGAIN                PCONFIG(5)
 # define P064_AGAIN                PCONFIG(6)
 # define P064_LDRIVE               PCONFIG(7)
+# define P064_INT_PIN              CONFIG_PIN1
 
 # define P064_IS_GPL_SENSOR        (P064_MODE == PLUGIN_MODE_GPL_064)
 # define P064_IS_RGB_SENSOR        (P064_MODE == PLUGIN_MODE_RGB_064)
@@ -82,6 +84,7 @@ boolean Plugin_064(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOptional      = true;
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].PluginStats        = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND);
       break;
     }
 
@@ -200,6 +203,11 @@ boolean Plugin_064(uint8_t function, struct EventStruct *event, String& string)
             addFormSelector(F("Gesture LED Boost"), F("lboost"), 4, optionsLedBoost, optionsLedBoostValues, P064_LED_BOOST);
           }
 
+          # if FEATURE_PLUGIN_DATA_READY_PIN
+          addFormPinSelect(PinSelectPurpose::Generic_input, formatGpioName_input_optional(F("INT")), F("taskdevicepin1"), P064_INT_PIN);
+          addFormNote(F("When connected, gesture data is only read after the sensor signals a gesture."));
+          # endif // if FEATURE_PLUGIN_DATA_READY_PIN
+
           addFormSubHeader(F("Proximity & Ambient Light Sensor parameters"));
 
           addFormSelector(F("Proximity Gain"), F("pgain"), 4, optionsGain, optionsGainValues, P064_PGAIN);
@@ -269,7 +277,10 @@ boolean Plugin_064(uint8_t function, struct EventStruct *event, String& string)
               success = false;
             }
 
-            if (!P064_data->sensor.enableGestureSensor(false, P064_LED_BOOST)) {
+            // INT is active low, asserted until the gesture data is read
+            const bool useInt = dataReadyPin_enable(event->TaskIndex, P064_INT_PIN, FALLING);
+
+            if (!P064_data->sensor.enableGestureSensor(useInt, P064_LED_BOOST)) {
               log    += F("Error during gesture sensor init!");
               success = false;
             }
@@ -284,11 +295,31 @@ boolean Plugin_064(uint8_t function, struct EventStruct *event, String& string)
       break;
     }
 
+    case PLUGIN_EXIT:
+    {
+      dataReadyPin_disable(event->TaskIndex);
+      break;
+    }
+
     case PLUGIN_TEN_PER_SECOND:
+    case PLUGIN_TASKTIMER_IN:
     {
       P064_data_struct *P064_data = static_cast<P064_data_struct *>(getPluginTaskData(event->TaskIndex));
 
-      if ((nullptr == P064_data) || (P064_MODE != PLUGIN_MODE_GPL_064) || !P064_data->sensor.isGestureAvailable()) {
+      if ((nullptr == P064_data) || (P064_MODE != PLUGIN_MODE_GPL_064)) {
+        break;
+      }
+
+      if (PLUGIN_TASKTIMER_IN == function) {
+        if ((event->Par1 != DATA_READY_PIN_TASKTIMER_PAR1) || !dataReadyPin_triggered(event->TaskIndex)) {
+          break;
+        }
+      } else if (dataReadyPin_enabled(event->TaskIndex) && (digitalRead(P064_INT_PIN) == HIGH)) {
+        // No gesture pending, only poll when INT is still asserted, e.g. after reading was aborted halfway a gesture
+        break;
+      }
+
+      if (!P064_data->sensor.isGestureAvailable()) {
         break;
       }
 
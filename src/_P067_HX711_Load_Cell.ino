@@ -17,6 +17,7 @@
 // Datasheet: https://cdn.sparkfun.com/datasheets/Sensors/ForceFlex/hx711_english.pdf
 
 /** Changelog:
+ * 2026-10-15 Add optional data-ready interrupt, reading each conversion immediately into a ring buffer, and median filter
  * 2023-02-23 tonhuisman: Ignore first PLUGIN_READ after startup, as no samples have been read yet so no measurement data is available
  * 2023-01-01 tonhuisman: Minor string reductions
  * 2022-12-30 tonhuisman: Fix no longer generating events, use DIRECT_pinRead() and DIRECT_pinWrite() to ensure proper working on ESP32,
@@ -55,6 +56,8 @@ boolean Plugin_067(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOptional      = false;
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].PluginStats        = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(FIFTY_PER_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(WRITE);
       break;
     }
 
@@ -82,6 +85,11 @@ boolean Plugin_067(uint8_t function, struct EventStruct *event, String& string)
     {
       float valFloat;
 
+      addFormCheckBox(F("Read on data-ready interrupt"), F("intr"), P067_GET_USE_INTERRUPT);
+      addFormNote(F("Read each conversion as soon as DT goes low, allows the full 80 samples/sec of the HX711."));
+      addFormCheckBox(F("Median filter"), F("median"), P067_GET_MEDIAN_FILTER);
+      addFormNote(F("Use the median of the last 5 samples per channel, to suppress spikes."));
+
       // A ------------
       addFormSubHeader(F("Measurement Channel A"));
 
@@ -159,6 +167,9 @@ boolean Plugin_067(uint8_t function, struct EventStruct *event, String& string)
       P067_SET_CHANNEL_A_CALIB(isFormItemChecked(F("calChA")));
       P067_SET_CHANNEL_B_CALIB(isFormItemChecked(F("calChB")));
 
+      P067_SET_USE_INTERRUPT(isFormItemChecked(F("intr")));
+      P067_SET_MEDIAN_FILTER(isFormItemChecked(F("median")));
+
       if (isFormItemChecked(F("tareChA"))) {
         valFloat = -UserVar[event->BaseVarIndex + 2];
       } else {
@@ -13,6 +13,9 @@
 //
 
 /** Changelog:
+ * 2026-10-15 tonhuisman: Only send command lines that changed since the last interval, collect them in a single serial write.
+ *                        Cache is cleared on a touch event, display reset or a Nextion command from PLUGIN_WRITE.
+ *                        Read incoming data with a framed reader into a fixed buffer, no more delay() while receiving.
  * 2022-09-27 tonhuisman: Use Changelog formatted updates
  *                        Extend nr. of lines available for text/commands to 20, minor code improvements
  * Updated: Oct-03-2018, ThomasB.
@@ -62,6 +65,9 @@ boolean Plugin_075(uint8_t function, struct EventStruct *event, String& string)
 
       // FIXME TD-er: Not sure if access to any existing task data is needed when saving
       Device[deviceCount].ExitTaskBeforeSave = false;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(ONCE_A_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(WRITE);
 
       break;
     }
@@ -205,6 +211,10 @@ boolean Plugin_075(uint8_t function, struct EventStruct *event, String& string)
         String newString;
         String UcTmpString;
 
+        if (P075_data->txPin < 0) {
+          addLog(LOG_LEVEL_INFO, F("NEXTION075 : Missing TxD Pin Number, aborted sendCommand"));
+        }
+
         // Get optional LINE command statements. Special RSSIBAR bargraph keyword is supported.
         for (uint8_t x = 0; x < P75_Nlines; x++) {
           if (P075_data->displayLines[x].length()) {
@@ -260,16 +270,19 @@ boolean Plugin_075(uint8_t function, struct EventStruct *event, String& string)
               newString = parseTemplate(tmpString);
             }
 
-            P075_sendCommand(event->TaskIndex, newString.c_str());
-            # ifdef P075_DEBUG_LOG
-            String log;
-            log.reserve(P75_Nchars + 50); // Prevent re-allocation
-            log += concat(F("NEXTION075 : Cmd Statement Line-"), x + 1);
-            log += concat(F(" Sent: "), newString);
-            addLogMove(LOG_LEVEL_INFO, log);
-            # endif // ifdef P075_DEBUG_LOG
+            // Only send when changed since the last interval
+            if (P075_data->queueCommand(newString, x, true)) {
+              # ifdef P075_DEBUG_LOG
+              String log;
+              log.reserve(P75_Nchars + 50); // Prevent re-allocation
+              log += concat(F("NEXTION075 : Cmd Statement Line-"), x + 1);
+              log += concat(F(" Sent: "), newString);
+              addLogMove(LOG_LEVEL_INFO, log);
+              # endif // ifdef P075_DEBUG_LOG
+            }
           }
         }
+        P075_data->flushCommands();
 
         // At Interval timer, send idx & value data only if user enabled "values" interval mode.
         if (P075_IncludeValues) {
@@ -303,7 +316,7 @@ boolean Plugin_075(uint8_t function, struct EventStruct *event, String& string)
       if (command.equalsIgnoreCase(getTaskDeviceName(event->TaskIndex))) {
         success = true; // Set true only if plugin found a command to execute.
         const String nextionArguments = parseStringToEndKeepCase(string, 2);
-        P075_sendCommand(event->TaskIndex, nextionArguments.c_str());
+        P075_sendCommand(event->TaskIndex, nextionArguments);
         {
           String log;
           log.reserve(24 + nextionArguments.length()); // Prevent re-allocation
@@ -355,14 +368,7 @@ boolean Plugin_075(uint8_t function, struct EventStruct *event, String& string)
         break; // P075_data->easySerial missing, exit.
       }
       {
-        uint16_t i;
-        uint8_t  c;
-        String   Vidx;
-        String   Nvalue;
-        String   Svalue;
-        String   Nswitch;
-        char     __buffer[RXBUFFSZ + 1];                         // Staging buffer.
-        uint8_t  charCount = P075_data->easySerial->available(); // Prime the Soft Serial engine.
+        const int charCount = P075_data->easySerial->available();
 
         if (charCount >= RXBUFFWARN) {
           String log;
@@ -371,135 +377,102 @@ boolean Plugin_075(uint8_t function, struct EventStruct *event, String& string)
           log += F(" bytes");
           addLogMove(LOG_LEVEL_INFO, log);
         }
-        uint32_t baudrate_delay_unit = P075_data->baudrate / 9600;
 
-        if (baudrate_delay_unit == 0) {
-          baudrate_delay_unit = 1;
-        }
+        // Incomplete frames are kept in the data struct and completed on a next call.
+        while (P075_data->readFrame()) {
+          const uint8_t *frame  = P075_data->rxBuffer;
+          const uint8_t  length = P075_data->rxLength;
 
-        while (charCount) { // This is the serial engine. It processes the serial Rx stream.
-          c = P075_data->easySerial->read();
+          if ((frame[0] == P075_TOUCH_EVENT) && (length == 4)) {
+            UserVar[event->BaseVarIndex]     = (frame[1] * 256) + frame[2] + TOUCH_BASE;
+            UserVar[event->BaseVarIndex + 1] = frame[3];
+            sendData(event);
 
-          if (c == 0x65) {
-            if (charCount < 6) { delay((5 / (baudrate_delay_unit)) + 1); // Let's wait for a few more chars to arrive.
-            }
-            charCount = P075_data->easySerial->available();
+            // A touch event can change the page, so all lines have to be sent again
+            P075_data->invalidateSentCache();
 
-            if (charCount >= 6) {
-              __buffer[0] = c; // Store in staging buffer.
+            # ifdef P075_DEBUG_LOG
+            String log;
+            log.reserve(70); // Prevent re-allocation
+            log += F("NEXTION075 : code: ");
+            log += frame[1];
+            log += ',';
+            log += frame[2];
+            log += ',';
+            log += frame[3];
+            addLogMove(LOG_LEVEL_INFO, log);
+            # endif // ifdef P075_DEBUG_LOG
+          }
+          else if ((frame[0] == P075_READY) || (frame[0] == P075_PAGE_ID) ||
+                   ((frame[0] == P075_STARTUP) && (length == 3))) {
+            // Display was reset or reports a page (change), all lines have to be sent again
+            P075_data->invalidateSentCache();
+          }
+          else if (frame[0] == P075_PIPE_CMD) {
+            String Vidx;
+            String Nvalue;
+            String Svalue;
+            const String tmpString(reinterpret_cast<const char *>(frame));
 
-              for (i = 1; i < 7; i++) {
-                __buffer[i] = P075_data->easySerial->read();
-              }
+            # ifdef P075_DEBUG_LOG
+            String log;
+            log.reserve(50); // Prevent re-allocation
+            log += concat(F("NEXTION075 : Code = "), tmpString);
+            addLogMove(LOG_LEVEL_INFO, log);
+            # endif // ifdef P075_DEBUG_LOG
 
-              __buffer[i] = 0x00;
-              
-              // FIXME TD-er: (PVS Studio) A part of conditional expression is always false: (0xFF == __buffer[4]). The value range of char type: [-128, 127].
-              if ((0xFF == __buffer[4]) && (0xFF == __buffer[5]) && (0xFF == __buffer[6])) {
-                UserVar[event->BaseVarIndex]     = (__buffer[1] * 256) + __buffer[2] + TOUCH_BASE;
-                UserVar[event->BaseVarIndex + 1] = __buffer[3];
-                sendData(event);
+            int argIndex = tmpString.indexOf(F(",i"));
+            int argEnd   = tmpString.indexOf(',', argIndex + 1);
 
-                # ifdef P075_DEBUG_LOG
-                String log;
-                log.reserve(70); // Prevent re-allocation
-                log += F("NEXTION075 : code: ");
-                log += __buffer[1];
-                log += ',';
-                log += __buffer[2];
-                log += ',';
-                log += __buffer[3];
-                addLogMove(LOG_LEVEL_INFO, log);
-                # endif // ifdef P075_DEBUG_LOG
-              }
-            }
-          }
-          else {
-            if (c == '|') {
-              __buffer[0] = c;                                             // Store in staging buffer.
+            if (argIndex) { Vidx = tmpString.substring(argIndex + 2, argEnd); }
 
-              if (charCount < 8) { delay((9 / (baudrate_delay_unit)) + 1); // Let's wait for more chars to arrive.
-              }
-              else { delay((3 / (baudrate_delay_unit)) + 1);               // Short wait for tardy chars.
-              }
-              charCount = P075_data->easySerial->available();
+            boolean GotPipeCmd = false;
 
-              i = 1;
+            switch (frame[1]) {
+              case 'u':
+                GotPipeCmd = true;
+                argIndex   = argEnd;
+                argEnd     = tmpString.indexOf(',', argIndex + 1);
 
-              while (P075_data->easySerial->available() > 0 && i < RXBUFFSZ) { // Copy global serial buffer to local buffer.
-                __buffer[i] = P075_data->easySerial->read();
+                if (argIndex) { Nvalue = tmpString.substring(argIndex + 2, argEnd); }
+                argIndex = argEnd;
 
-                if ((__buffer[i] == 0x0a) || (__buffer[i] == 0x0d)) { break; }
-                i++;
-              }
+                if (argIndex) { Svalue = tmpString.substring(argIndex + 2); }
+                break;
+              case 's':
+                GotPipeCmd = true;
+                argIndex   = argEnd;
 
-              __buffer[i] = 0x00;
+                if (argIndex) { Nvalue = tmpString.substring(argIndex + 2); }
 
-              String tmpString = __buffer;
+                if (equals(Nvalue, F("On"))) { Svalue = '1'; }
+
+                if (equals(Nvalue, F("Off"))) { Svalue = '0'; }
+                break;
+            }
+
+            if (GotPipeCmd) {
+              UserVar[event->BaseVarIndex]     = 0.0f;
+              UserVar[event->BaseVarIndex + 1] = 0.0f;
+              validFloatFromString(Vidx,   UserVar[event->BaseVarIndex]);
+              validFloatFromString(Svalue, UserVar[event->BaseVarIndex + 1]);
+              sendData(event);
 
               # ifdef P075_DEBUG_LOG
               String log;
-              log.reserve(50); // Prevent re-allocation
-              log += concat(F("NEXTION075 : Code = "), tmpString);
+              log.reserve(80); // Prevent re-allocation
+              log += F("NEXTION075 : Pipe Command Sent: ");
+              log += tmpString;
+              log += formatUserVarNoCheck(event->TaskIndex, 0);
               addLogMove(LOG_LEVEL_INFO, log);
               # endif // ifdef P075_DEBUG_LOG
-
-              int argIndex = tmpString.indexOf(F(",i"));
-              int argEnd   = tmpString.indexOf(',', argIndex + 1);
-
-              if (argIndex) { Vidx = tmpString.substring(argIndex + 2, argEnd); }
-
-              boolean GotPipeCmd = false;
-
-              switch (__buffer[1]) {
-                case 'u':
-                  GotPipeCmd = true;
-                  argIndex   = argEnd;
-                  argEnd     = tmpString.indexOf(',', argIndex + 1);
-
-                  if (argIndex) { Nvalue = tmpString.substring(argIndex + 2, argEnd); }
-                  argIndex = argEnd;
-                  argEnd   = tmpString.indexOf(0x0a);
-
-                  if (argIndex) { Svalue = tmpString.substring(argIndex + 2, argEnd); }
-                  break;
-                case 's':
-                  GotPipeCmd = true;
-                  argIndex   = argEnd;
-                  argEnd     = tmpString.indexOf(0x0a);
-
-                  if (argIndex) { Nvalue = tmpString.substring(argIndex + 2, argEnd); }
-
-                  if (equals(Nvalue, F("On"))) { Svalue = '1'; }
-
-                  if (equals(Nvalue, F("Off"))) { Svalue = '0'; }
-                  break;
-              }
-
-              if (GotPipeCmd) {
-                UserVar[event->BaseVarIndex]     = 0.0f;
-                UserVar[event->BaseVarIndex + 1] = 0.0f;
-                validFloatFromString(Vidx,   UserVar[event->BaseVarIndex]);
-                validFloatFromString(Svalue, UserVar[event->BaseVarIndex + 1]);
-                sendData(event);
-
-                # ifdef P075_DEBUG_LOG
-                String log;
-                log.reserve(80); // Prevent re-allocation
-                log += F("NEXTION075 : Pipe Command Sent: ");
-                log += __buffer;
-                log += formatUserVarNoCheck(event->TaskIndex, 0);
-                addLogMove(LOG_LEVEL_INFO, log);
-                # endif // ifdef P075_DEBUG_LOG
-              }
-              else {
-                # ifdef P075_DEBUG_LOG
-                addLog(LOG_LEVEL_INFO, F("NEXTION075 : Unknown Pipe Command, skipped"));
-                # endif // ifdef P075_DEBUG_LOG
-              }
+            }
+            else {
+              # ifdef P075_DEBUG_LOG
+              addLog(LOG_LEVEL_INFO, F("NEXTION075 : Unknown Pipe Command, skipped"));
+              # endif // ifdef P075_DEBUG_LOG
             }
           }
-          charCount = P075_data->easySerial->available();
         }
       }
 
@@ -510,7 +483,7 @@ boolean Plugin_075(uint8_t function, struct EventStruct *event, String& string)
   return success;
 }
 
-void P075_sendCommand(taskIndex_t taskIndex, const char *cmd)
+void P075_sendCommand(taskIndex_t taskIndex, const String& cmd)
 {
   P075_data_struct *P075_data = static_cast<P075_data_struct *>(getPluginTaskData(taskIndex));
 
@@ -522,10 +495,11 @@ void P075_sendCommand(taskIndex_t taskIndex, const char *cmd)
   else
   {
     if (P075_data->easySerial != nullptr) {
-      P075_data->easySerial->print(cmd);
-      P075_data->easySerial->write(0xff);
-      P075_data->easySerial->write(0xff);
-      P075_data->easySerial->write(0xff);
+      P075_data->queueCommand(cmd);
+      P075_data->flushCommands();
+
+      // The command may have changed components that are also set from the command lines
+      P075_data->invalidateSentCache();
     }
     else {
       addLog(LOG_LEVEL_INFO, F("NEXTION075 : P075_data->easySerial error, aborted sendCommand"));
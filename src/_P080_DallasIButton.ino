@@ -14,6 +14,8 @@
 # define PLUGIN_NAME_080       "Input - iButton"
 # define PLUGIN_VALUENAME1_080 "iButton"
 
+# define P080_DALLAS_DRIVER    PCONFIG(0)
+
 
 int8_t Plugin_080_DallasPin;
 
@@ -36,6 +38,7 @@ boolean Plugin_080(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].SendDataOption     = true;
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].GlobalSyncOption   = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND);
       break;
     }
 
@@ -66,6 +69,9 @@ boolean Plugin_080(uint8_t function, struct EventStruct *event, String& string)
 
       if (validGpio(Plugin_080_DallasPin)) {
         Dallas_addr_selector_webform_load(event->TaskIndex, Plugin_080_DallasPin, Plugin_080_DallasPin);
+        # if FEATURE_DALLAS_RMT
+        Dallas_driver_webform_load(P080_DALLAS_DRIVER);
+        # endif // if FEATURE_DALLAS_RMT
       }
       success = true;
       break;
@@ -75,6 +81,9 @@ boolean Plugin_080(uint8_t function, struct EventStruct *event, String& string)
     {
       // save the address for selected device and store into extra tasksettings
       Dallas_addr_selector_webform_save(event->TaskIndex, CONFIG_PIN1, CONFIG_PIN1);
+      # if FEATURE_DALLAS_RMT
+      P080_DALLAS_DRIVER = Dallas_driver_webform_save();
+      # endif // if FEATURE_DALLAS_RMT
       success = true;
       break;
     }
@@ -97,6 +106,9 @@ boolean Plugin_080(uint8_t function, struct EventStruct *event, String& string)
         // Explicitly set the pinMode using the "slow" pinMode function
         // This way we know for sure the state of any pull-up or -down resistor is known.
         pinMode(Plugin_080_DallasPin, INPUT);
+        # if FEATURE_DALLAS_RMT
+        Dallas_setDriver(Plugin_080_DallasPin, Plugin_080_DallasPin, static_cast<Dallas_driver_e>(P080_DALLAS_DRIVER));
+        # endif // if FEATURE_DALLAS_RMT
 
         Dallas_plugin_get_addr(addr, event->TaskIndex);
         Dallas_startConversion(addr, Plugin_080_DallasPin, Plugin_080_DallasPin);
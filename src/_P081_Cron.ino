@@ -12,7 +12,6 @@
 # include "src/PluginStructs/P081_data_struct.h"
 
 # define PLUGIN_081
-# define PLUGIN_ID_081      81                        // plugin id
 # define PLUGIN_NAME_081   "Generic - CRON" // "Plugin Name" is what will be displayed in the selection list
 # define PLUGIN_VALUENAME1_081 "LastExecution"
 # define PLUGIN_VALUENAME2_081 "NextExecution"
@@ -43,6 +42,7 @@ boolean Plugin_081(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOptional    = false;
       Device[deviceCount].GlobalSyncOption = true;
       Device[deviceCount].DecimalsOnly     = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(TIME_CHANGE);
       break;
     }
 
@@ -125,6 +125,9 @@ boolean Plugin_081(uint8_t function, struct EventStruct *event, String& string)
 
       if (P081_data->isInitialized()) {
         P081_check_or_init(event);
+
+        // (Re)schedule the plugin timer, as this task may now be the first to execute.
+        P081_processCronTasks(true);
         success = true;
       } else {
         clearPluginTaskData(event->TaskIndex);
@@ -141,45 +144,20 @@ boolean Plugin_081(uint8_t function, struct EventStruct *event, String& string)
     }
 
     case PLUGIN_TIME_CHANGE:
-    case PLUGIN_ONCE_A_SECOND:
     {
-      // code to be executed once a second. Tasks which do not require fast response can be added here
-      if (node_time.systemTimePresent()) {
-        P081_check_or_init(event);
-        time_t next_exec_time = P081_getCronExecTime(event->TaskIndex, NEXTEXECUTION);
-
-        if (next_exec_time != CRON_INVALID_INSTANT) {
-          const time_t current_time = P081_getCurrentTime();
-          const bool   cron_elapsed = (next_exec_time <= current_time);
-
-          if (cron_elapsed) {
-            # ifndef BUILD_NO_DEBUG
-            addLog(LOG_LEVEL_DEBUG, F("Cron Elapsed"));
-            # endif // ifndef BUILD_NO_DEBUG
-
-            time_t last_exec_time = next_exec_time;
-            next_exec_time = P081_computeNextCronTime(event->TaskIndex, current_time);
-            P081_setCronExecTimes(event, last_exec_time, next_exec_time);
-
-            # ifndef BUILD_NO_DEBUG
-            addLog(LOG_LEVEL_DEBUG, String(F("Next execution:")) + formatDateTimeString(*gmtime(&next_exec_time)));
-            # endif // ifndef BUILD_NO_DEBUG
-
-            if (function != PLUGIN_TIME_CHANGE) {
-              if (Settings.UseRules) {
-                eventQueue.addMove(concat(F("Cron#"), getTaskDeviceName(event->TaskIndex)));
-              }
-              success = true;
-            }
-          }
-        } else {
-          addLog(LOG_LEVEL_ERROR, F("CRON: INVALID INSTANT"));
-        }
-      } else {
-        addLog(LOG_LEVEL_ERROR, F("CRON: Time not synced"));
+      // Schedules which elapsed because of the time change are skipped, without sending an event.
+      // All cron tasks are handled at once, so only needed for the first cron task.
+      if (event->TaskIndex == P081_firstCronTask()) {
+        P081_processCronTasks(false);
       }
+      break;
+    }
 
-
+    case PLUGIN_DEVICETIMER_IN:
+    {
+      // Single timer for all cron tasks, set at the first next execution time.
+      P081_processCronTasks(true);
+      success = true;
       break;
     }
   } // switch
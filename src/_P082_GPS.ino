@@ -10,6 +10,9 @@
 // Based on the library TinyGPS++
 // http://arduiniana.org/libraries/tinygpsplus/
 //
+// Changelog:
+// 2026-10-15 tonhuisman: Only parse the NMEA sentences needed for the configured values, no String allocations per sentence.
+//                        PPS pulse timestamped in usec, system time set as GPS PPS time source when PPS is used.
 //
 
 # include <ESPeasySerial.h>
@@ -60,7 +63,8 @@
 # define P082_QUERY4_DFLT         P082_query::P082_QUERY_SPD
 
 // Must use volatile declared variable (which will end up in iRAM)
-volatile unsigned long P082_pps_time = 0;
+// micros() at the last PPS pulse, 32 bit so it can be read atomically
+volatile uint32_t P082_pps_time_usec = 0;
 void    Plugin_082_interrupt() IRAM_ATTR;
 
 boolean Plugin_082(uint8_t function, struct EventStruct *event, String& string) {
@@ -81,6 +85,8 @@ boolean Plugin_082(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].PluginStats        = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(FIFTY_PER_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(WRITE);
       break;
     }
 
@@ -351,6 +357,7 @@ boolean Plugin_082(uint8_t function, struct EventStruct *event, String& string)
 
       if (P082_data->init(port, serial_rx, serial_tx)) {
         success = true;
+        P082_data->setParseSatelliteStats(P082_satelliteStatsNeeded(event));
         serialHelper_log_GpioDescription(port, serial_rx, serial_tx);
 
         if (validGpio(pps_pin)) {
@@ -392,7 +399,8 @@ boolean Plugin_082(uint8_t function, struct EventStruct *event, String& string)
         P082_setSystemTime(event);
 # ifdef P082_SEND_GPS_TO_LOG
 
-        if (P082_data->_lastSentence.substring(0, 10).indexOf(F("TXT")) != -1) {
+        // Sentence starts with "$" + talker ID, e.g. "$GPTXT"
+        if (strncmp_P(&P082_data->_lastSentence[3], PSTR("TXT"), 3) == 0) {
           addLog(LOG_LEVEL_INFO, P082_data->_lastSentence);
         } else {
           #  ifndef BUILD_NO_DEBUG
@@ -728,6 +736,11 @@ void P082_html_show_stats(struct EventStruct *event) {
       break;
   }
 
+  if (!P082_data->parseSatelliteStats()) {
+    addRowLabel(F("Satellite stats"));
+    addHtml(F("Not parsed, not used in any value"));
+  }
+
   addRowLabel(F("Satellites tracked"));
   addHtmlInt(P082_data->gps->satellitesStats.nrSatsTracked());
 
@@ -749,12 +762,12 @@ void P082_html_show_stats(struct EventStruct *event) {
 
   addRowLabel(F("UTC Time"));
   struct tm dateTime;
-  uint32_t  age;
+  uint32_t  age_usec;
   bool updated;
   bool pps_sync;
 
-  if (P082_data->getDateTime(dateTime, age, updated, pps_sync)) {
-    dateTime = node_time.addSeconds(dateTime, (age / 1000), false);
+  if (P082_data->getDateTime(dateTime, age_usec, updated, pps_sync)) {
+    dateTime = node_time.addSeconds(dateTime, (age_usec / 1000000), false);
     addHtml(formatDateTimeString(dateTime));
   } else {
     addHtml('-');
@@ -771,16 +784,14 @@ void P082_html_show_stats(struct EventStruct *event) {
   }
 
   addRowLabel(F("Checksum (pass/fail/invalid)"));
-  {
-    String chksumStats;
-
-    chksumStats  = P082_data->gps->passedChecksum();
-    chksumStats += '/';
-    chksumStats += P082_data->gps->failedChecksum();
-    chksumStats += '/';
-    chksumStats += P082_data->gps->invalidData();
-    addHtml(chksumStats);
-  }
+  addHtmlInt(P082_data->gps->passedChecksum());
+  addHtml('/');
+  addHtmlInt(P082_data->gps->failedChecksum());
+  addHtml('/');
+  addHtmlInt(P082_data->gps->invalidData());
+
+  addRowLabel(F("Sentences skipped"));
+  addHtmlInt(P082_data->_sentencesSkipped);
 }
 
 void P082_setSystemTime(struct EventStruct *event) {
@@ -791,7 +802,8 @@ void P082_setSystemTime(struct EventStruct *event) {
     return;
   }
 
-  if ((timeSource_t::GPS_time_source == node_time.timeSource) &&
+  if (((timeSource_t::GPS_time_source == node_time.timeSource) ||
+       (timeSource_t::GPS_PPS_time_source == node_time.timeSource)) &&
       (P082_data->_last_setSystemTime != 0) &&
       (timePassedSince(P082_data->_last_setSystemTime) < EXT_TIME_SOURCE_MIN_UPDATE_INTERVAL_MSEC))
   {
@@ -800,27 +812,41 @@ void P082_setSystemTime(struct EventStruct *event) {
   }
 
   struct tm dateTime;
-  uint32_t  age;
+  uint32_t  age_usec;
   bool updated;
   bool pps_sync;
 
-  P082_data->_pps_time = P082_pps_time; // Must copy the interrupt gathered time first.
+  P082_data->_pps_time_usec = P082_pps_time_usec; // Must copy the interrupt gathered time first.
 
-  if (P082_data->getDateTime(dateTime, age, updated, pps_sync)) {
+  if (P082_data->getDateTime(dateTime, age_usec, updated, pps_sync)) {
     if (updated) {
-      // Use floating point precision to use the time since last update from GPS
-      // and the given offset in centisecond.
-      ESPEASY_RULES_FLOAT_TYPE time = makeTime(dateTime);
-      time += (static_cast<ESPEASY_RULES_FLOAT_TYPE>(age) / static_cast<ESPEASY_RULES_FLOAT_TYPE>(1000));
-      node_time.setExternalTimeSource(time, timeSource_t::GPS_time_source);
+      // Use double precision to use the time since last update from GPS,
+      // either since the PPS pulse or the given offset in centisecond.
+      double time = makeTime(dateTime);
+      time += (static_cast<double>(age_usec) / 1000000.0);
+      node_time.setExternalTimeSource(time, pps_sync ? timeSource_t::GPS_PPS_time_source : timeSource_t::GPS_time_source);
       P082_data->_last_setSystemTime = millis();
     }
   }
-  P082_pps_time = 0;
+  P082_pps_time_usec = 0;
+}
+
+bool P082_satelliteStatsNeeded(struct EventStruct *event) {
+  for (uint8_t i = 0; i < P082_NR_OUTPUT_VALUES; ++i) {
+    switch (static_cast<P082_query>(PCONFIG(i + P082_QUERY1_CONFIG_POS))) {
+      case P082_query::P082_QUERY_SATVIS:
+      case P082_query::P082_QUERY_SATUSE:
+      case P082_query::P082_QUERY_DB_MAX:
+        return true;
+      default:
+        break;
+    }
+  }
+  return false;
 }
 
 void Plugin_082_interrupt() {
-  P082_pps_time = millis();
+  P082_pps_time_usec = micros();
 }
 
 #endif // USES_P082
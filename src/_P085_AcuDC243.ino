@@ -16,6 +16,13 @@
     Use 1kOhm in serie on datapins!
  */
 
+/** Changelog:
+ * 2026-10-15 tonhuisman: Read the selected values using a Modbus register map, merging the registers into block reads.
+ *                        Reading is non-blocking from PLUGIN_FIFTY_PER_SECOND, values are sent when all blocks are read.
+ *                        Share the serial port with other Modbus tasks on the same RS485 bus, reads are queued per bus.
+ *                        Show statistics and reply time of this slave.
+ */
+
 # define PLUGIN_085
 # define PLUGIN_ID_085 85
 # define PLUGIN_NAME_085 "Energy - AccuEnergy AcuDC24x"
@@ -41,6 +48,8 @@ boolean Plugin_085(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].ExitTaskBeforeSave = false;
       Device[deviceCount].PluginStats        = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(WRITE) |
+                                                    PLUGIN_CALL_SUBSCRIBE(FIFTY_PER_SECOND);
       break;
     }
 
@@ -127,36 +136,50 @@ boolean Plugin_085(uint8_t function, struct EventStruct *event, String& string)
         static_cast<P085_data_struct *>(getPluginTaskData(event->TaskIndex));
 
       if ((nullptr != P085_data) && P085_data->isInitialized()) {
-        addFormNote(P085_data->modbus.detected_device_description);
-        addRowLabel(F("Checksum (pass/fail/nodata)"));
-        uint32_t reads_pass, reads_crc_failed, reads_nodata;
-        P085_data->modbus.getStatistics(reads_pass, reads_crc_failed, reads_nodata);
-        String chksumStats;
-        chksumStats  = reads_pass;
-        chksumStats += '/';
-        chksumStats += reads_crc_failed;
-        chksumStats += '/';
-        chksumStats += reads_nodata;
-        addHtml(chksumStats);
+        addFormNote(P085_data->detected_device_description);
+        ModbusRTU_slaveStats stats;
+
+        if (P085_data->bus->modbus.getStatistics(P085_data->modbusAddress, stats)) {
+          addRowLabel(F("Checksum (pass/fail/nodata)"));
+          String chksumStats;
+          chksumStats  = stats.pass;
+          chksumStats += '/';
+          chksumStats += stats.fail;
+          chksumStats += '/';
+          chksumStats += stats.nodata;
+          addHtml(chksumStats);
+          addRowLabel(F("Reply time (last/max)"));
+          String latency;
+          latency  = stats.lastLatency;
+          latency += '/';
+          latency += stats.maxLatency;
+          addHtml(latency);
+          addUnit(F("ms"));
+        }
+
+        if (P085_data->bus->refCount > 1) {
+          addRowLabel(F("Tasks sharing the bus"));
+          addHtmlInt(P085_data->bus->refCount);
+        }
 
         addFormSubHeader(F("Calibration"));
 
         // Calibration data is stored in the AcuDC module, not in the settings of ESPeasy.
         {
           uint8_t errorcode = 0;
-          int     value     = P085_data->modbus.readHoldingRegister(0x107, errorcode);
+          int     value     = P085_data->modbus().readHoldingRegister(0x107, errorcode);
 
           if (errorcode == 0) {
             addFormNumericBox(F("Full Range Voltage Value"), F("fr_volt"), value, 5, 9999);
             addUnit('V');
           }
-          value = P085_data->modbus.readHoldingRegister(0x104, errorcode);
+          value = P085_data->modbus().readHoldingRegister(0x104, errorcode);
 
           if (errorcode == 0) {
             addFormNumericBox(F("Full Range Current Value"), F("fr_curr"), value, 20, 50000);
             addUnit('A');
           }
-          value = P085_data->modbus.readHoldingRegister(0x105, errorcode);
+          value = P085_data->modbus().readHoldingRegister(0x105, errorcode);
 
           if (errorcode == 0) {
             addFormNumericBox(F("Full Range Shunt Value"), F("fr_shunt"), value, 50, 100);
@@ -165,18 +188,18 @@ boolean Plugin_085(uint8_t function, struct EventStruct *event, String& string)
 
           addFormSubHeader(F("Logging"));
 
-          value = P085_data->modbus.readHoldingRegister(0x500, errorcode);
+          value = P085_data->modbus().readHoldingRegister(0x500, errorcode);
 
           if (errorcode == 0) {
             addFormCheckBox(F("Enable data logging"), F("en_log"), value);
           }
-          value = P085_data->modbus.readHoldingRegister(0x501, errorcode);
+          value = P085_data->modbus().readHoldingRegister(0x501, errorcode);
 
           if (errorcode == 0) {
             addRowLabel(F("Mode of data logging"));
             addHtmlInt(value);
           }
-          value = P085_data->modbus.readHoldingRegister(0x502, errorcode);
+          value = P085_data->modbus().readHoldingRegister(0x502, errorcode);
 
           if (errorcode == 0) {
             addFormNumericBox(F("Log Interval"), F("log_int"), value, 1, 1440);
@@ -185,12 +208,23 @@ boolean Plugin_085(uint8_t function, struct EventStruct *event, String& string)
         }
 
         addFormSubHeader(F("Logged Values"));
-        p085_showValueLoadPage(P085_QUERY_Wh_imp, event);
-        p085_showValueLoadPage(P085_QUERY_Wh_exp, event);
-        p085_showValueLoadPage(P085_QUERY_Wh_tot, event);
-        p085_showValueLoadPage(P085_QUERY_Wh_net, event);
-        p085_showValueLoadPage(P085_QUERY_h_tot,  event);
-        p085_showValueLoadPage(P085_QUERY_h_load, event);
+        {
+          const uint8_t queries[] = {
+            P085_QUERY_Wh_imp, P085_QUERY_Wh_exp, P085_QUERY_Wh_tot, P085_QUERY_Wh_net, P085_QUERY_h_tot, P085_QUERY_h_load };
+          constexpr uint8_t nrQueries = NR_ELEMENTS(queries);
+          ModbusRTU_RegisterMap registerMap;
+          registerMap.setSlaveAddress(P085_data->modbusAddress);
+
+          for (uint8_t i = 0; i < nrQueries; ++i) {
+            p085_addQueryRegisters(registerMap, queries[i]);
+          }
+          registerMap.build();
+          registerMap.readAll(P085_data->modbus());
+
+          for (uint8_t i = 0; i < nrQueries; ++i) {
+            p085_showValueLoadPage(queries[i], registerMap);
+          }
+        }
 
         // Checkbox is always presented unchecked.
         // Must check and save to clear the stored accumulated values in the sensor.
@@ -219,33 +253,33 @@ boolean Plugin_085(uint8_t function, struct EventStruct *event, String& string)
 
       if ((nullptr != P085_data) && P085_data->isInitialized()) {
         uint16_t log_enabled = isFormItemChecked(F("en_log")) ? 1 : 0;
-        P085_data->modbus.writeMultipleRegisters(0x500, log_enabled);
+        P085_data->modbus().writeMultipleRegisters(0x500, log_enabled);
         delay(1);
 
         uint16_t log_int = getFormItemInt(F("log_int"));
-        P085_data->modbus.writeMultipleRegisters(0x502, log_int);
+        P085_data->modbus().writeMultipleRegisters(0x502, log_int);
         delay(1);
 
         uint16_t current = getFormItemInt(F("fr_curr"));
-        P085_data->modbus.writeMultipleRegisters(0x104, current);
+        P085_data->modbus().writeMultipleRegisters(0x104, current);
         delay(1);
 
         uint16_t shunt = getFormItemInt(F("fr_shunt"));
-        P085_data->modbus.writeMultipleRegisters(0x105, shunt);
+        P085_data->modbus().writeMultipleRegisters(0x105, shunt);
         delay(1);
 
         uint16_t voltage = getFormItemInt(F("fr_volt"));
-        P085_data->modbus.writeMultipleRegisters(0x107, voltage);
+        P085_data->modbus().writeMultipleRegisters(0x107, voltage);
 
         if (isFormItemChecked(F("clear_log")))
         {
           // Clear all logged values in the meter.
-          P085_data->modbus.writeMultipleRegisters(0x122, 0x0A); // Clear Energy
-          P085_data->modbus.writeMultipleRegisters(0x123, 0x0A); // Clear Meter Running Hour
-          P085_data->modbus.writeMultipleRegisters(0x124, 0x0A); // Clear Meter Load Hour
-          P085_data->modbus.writeMultipleRegisters(0x127, 0x0A); // Clear Ah
-          P085_data->modbus.writeMultipleRegisters(0x128, 0x0A); // Clear Min/Max value
-          P085_data->modbus.writeMultipleRegisters(0x129, 0x0A); // Clear Data Logging
+          P085_data->modbus().writeMultipleRegisters(0x122, 0x0A); // Clear Energy
+          P085_data->modbus().writeMultipleRegisters(0x123, 0x0A); // Clear Meter Running Hour
+          P085_data->modbus().writeMultipleRegisters(0x124, 0x0A); // Clear Meter Load Hour
+          P085_data->modbus().writeMultipleRegisters(0x127, 0x0A); // Clear Ah
+          P085_data->modbus().writeMultipleRegisters(0x128, 0x0A); // Clear Min/Max value
+          P085_data->modbus().writeMultipleRegisters(0x129, 0x0A); // Clear Data Logging
         }
       }
 
@@ -270,6 +304,7 @@ boolean Plugin_085(uint8_t function, struct EventStruct *event, String& string)
                           p085_storageValueToBaudrate(P085_BAUDRATE),
                           P085_DEV_ID)) {
         serialHelper_log_GpioDescription(port, serial_rx, serial_tx);
+        P085_data->initRegisterMap(event);
         success = true;
       } else {
         clearPluginTaskData(event->TaskIndex);
@@ -287,13 +322,28 @@ boolean Plugin_085(uint8_t function, struct EventStruct *event, String& string)
         static_cast<P085_data_struct *>(getPluginTaskData(event->TaskIndex));
 
       if ((nullptr != P085_data) && P085_data->isInitialized()) {
+        // Registers are read via the bus queue in PLUGIN_FIFTY_PER_SECOND, values are sent when all are read.
+        P085_data->bus->enqueue(&P085_data->registerMap);
+      }
+      break;
+    }
+
+    case PLUGIN_FIFTY_PER_SECOND: {
+      P085_data_struct *P085_data =
+        static_cast<P085_data_struct *>(getPluginTaskData(event->TaskIndex));
+
+      if ((nullptr != P085_data) && P085_data->isInitialized()) {
+        // Handles the queued reads of all tasks on the same bus
+        P085_data->bus->loop();
+      }
+
+      if ((nullptr != P085_data) && P085_data->registerMap.fetchCompleted()) {
         for (int i = 0; i < P085_NR_OUTPUT_VALUES; ++i) {
-          UserVar[event->BaseVarIndex + i] = p085_readValue(PCONFIG(i + P085_QUERY1_CONFIG_POS), event);
-          delay(1);
+          UserVar[event->BaseVarIndex + i] = p085_decodeValue(PCONFIG(i + P085_QUERY1_CONFIG_POS), P085_data->registerMap);
         }
-
-        success = true;
+        sendData(event);
       }
+      success = true;
       break;
     }
 # if FEATURE_PACKED_RAW_DATA
@@ -50,6 +50,7 @@ boolean Plugin_086(uint8_t function, struct EventStruct *event, String& string)
         Device[deviceCount].TimerOption = false;
         Device[deviceCount].GlobalSyncOption = false;
         Device[deviceCount].Custom = true;
+        Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(WRITE);
         break;
       }
 
@@ -11,6 +11,9 @@
 
 /**
  * Changelog:
+ * 2026-10-15 tonhuisman: On ESP32 hardware serial, only read the port when woken by the UART driver receive event.
+ * 2026-10-15 tonhuisman: Receive into a fixed buffer and apply regex and capture filters in loop(), using settings cached at init.
+ *                        Rejected sentences are no longer copied into a String, nor do they schedule a PLUGIN_READ.
  * 2023-03-25 tonhuisman: Change serialproxy_writemix to handle 0x00 also, by implementing parseHexTextData()
  * 2023-03-22 tonhuisman: Add command serialproxy_writemix to handle mixed hex characters and text to send
  *                        using parseHexTextString()
@@ -81,6 +84,8 @@ boolean Plugin_087(uint8_t function, struct EventStruct *event, String& string)
 
       // FIXME TD-er: Not sure if access to any existing task data is needed when saving
       Device[deviceCount].ExitTaskBeforeSave = false;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(FIFTY_PER_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(WRITE);
       break;
     }
 
@@ -195,6 +200,7 @@ boolean Plugin_087(uint8_t function, struct EventStruct *event, String& string)
       if (P087_data->init(port, serial_rx, serial_tx, P087_BAUDRATE, static_cast<uint8_t>(P087_SERIAL_CONFIG))) {
         LoadCustomTaskSettings(event->TaskIndex, P087_data->_lines, P87_Nlines, 0);
         P087_data->post_init();
+        P087_data->enableRxEvent(event->TaskIndex);
         success = true;
         serialHelper_log_GpioDescription(port, serial_rx, serial_tx);
       } else {
@@ -203,6 +209,9 @@ boolean Plugin_087(uint8_t function, struct EventStruct *event, String& string)
       break;
     }
 
+    # if FEATURE_SERIAL_RX_EVENT
+    case PLUGIN_TASKTIMER_IN: // Woken when data was received, see serialHelper_enableRxEvent()
+    # endif // if FEATURE_SERIAL_RX_EVENT
     case PLUGIN_FIFTY_PER_SECOND: {
       if (Settings.TaskDeviceEnabled[event->TaskIndex]) {
         P087_data_struct *P087_data =
@@ -222,17 +231,13 @@ boolean Plugin_087(uint8_t function, struct EventStruct *event, String& string)
       P087_data_struct *P087_data =
         static_cast<P087_data_struct *>(getPluginTaskData(event->TaskIndex));
 
+      // Sentence already passed the filters in loop()
       if ((nullptr != P087_data) && P087_data->getSentence(event->String2)) {
-        if (Plugin_087_match_all(event->TaskIndex, event->String2)) {
-          //          sendData(event);
 # ifndef BUILD_NO_DEBUG
-          addLog(LOG_LEVEL_DEBUG, event->String2);
+        addLog(LOG_LEVEL_DEBUG, event->String2);
 # endif // ifndef BUILD_NO_DEBUG
-          success = true;
-        }
+        success = true;
       }
-
-      if ((nullptr != P087_data)) {}
       break;
     }
 
@@ -263,30 +268,6 @@ boolean Plugin_087(uint8_t function, struct EventStruct *event, String& string)
   return success;
 }
 
-bool Plugin_087_match_all(taskIndex_t taskIndex, String& received)
-{
-  P087_data_struct *P087_data =
-    static_cast<P087_data_struct *>(getPluginTaskData(taskIndex));
-
-  if ((nullptr == P087_data)) {
-    return false;
-  }
-
-
-  if (P087_data->disableFilterWindowActive()) {
-    addLog(LOG_LEVEL_INFO, F("Serial Proxy: Disable Filter Window active"));
-    return true;
-  }
-
-  bool res = P087_data->matchRegexp(received);
-
-  if (P087_data->invertMatch()) {
-    addLog(LOG_LEVEL_INFO, F("Serial Proxy: invert filter"));
-    return !res;
-  }
-  return res;
-}
-
 String Plugin_087_valuename(uint8_t value_nr, bool displayString) {
   switch (value_nr) {
     case P087_QUERY_VALUE: return displayString ? F("Value")          : F("v");
@@ -401,6 +382,8 @@ void P087_html_show_stats(struct EventStruct *event) {
     chksumStats += '/';
     chksumStats += error;
     addHtml(chksumStats);
+    addRowLabel(F("Sentences rejected by filter"));
+    addHtmlInt(P087_data->getSentencesRejected());
     addRowLabel(F("Length Last Sentence"));
     addHtmlInt(length_last);
   }
@@ -44,9 +44,15 @@
  *
  */
 
+/*
+ * Changelog:
+ * 2026-10-15 tonhuisman: ESP32: Transmit via the RMT peripheral, which generates the carrier in hardware (FEATURE_IR_RMT)
+ */
+
 #include <HeatpumpIRFactory.h>
 
 #include "ESPEasy-Globals.h"
+#include "src/Helpers/IR_RMT.h"
 
 IRSenderIRremoteESP8266 *Plugin_088_irSender = nullptr;
 int panasonicCKPTimer = 0;
@@ -72,6 +78,9 @@ boolean Plugin_088(uint8_t function, struct EventStruct *event, String& string)
         Device[deviceCount].TimerOptional = false;
         Device[deviceCount].GlobalSyncOption = false;
         Device[deviceCount].DecimalsOnly = false;
+        Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(ONCE_A_SECOND) |
+                                                      PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND) |
+                                                      PLUGIN_CALL_SUBSCRIBE(WRITE);
 
         break;
       }
@@ -125,6 +134,9 @@ boolean Plugin_088(uint8_t function, struct EventStruct *event, String& string)
             delete Plugin_088_irSender;
           }
           Plugin_088_irSender = new (std::nothrow) IRSenderIRremoteESP8266(irPin);
+#if FEATURE_IR_RMT
+          IR_RMT_tx_begin(irPin, false);
+#endif // if FEATURE_IR_RMT
         }
         if (Plugin_088_irSender != nullptr && irPin == -1)
         {
@@ -173,6 +185,9 @@ boolean Plugin_088(uint8_t function, struct EventStruct *event, String& string)
           if (heatpumpIR != nullptr) {
             enableIR_RX(false);
             heatpumpIR->send(*Plugin_088_irSender, powerMode, operatingMode, fanSpeed, temperature, vDir, hDir);
+#if FEATURE_IR_RMT
+            IR_RMT_tx_flush();
+#endif // if FEATURE_IR_RMT
             enableIR_RX(true);
 
             delete heatpumpIR;
@@ -216,6 +231,9 @@ boolean Plugin_088(uint8_t function, struct EventStruct *event, String& string)
           delete Plugin_088_irSender;
           Plugin_088_irSender = nullptr;
         }
+#if FEATURE_IR_RMT
+        IR_RMT_tx_end(CONFIG_PIN1);
+#endif // if FEATURE_IR_RMT
 
     	  break;
     	}
@@ -231,6 +249,9 @@ boolean Plugin_088(uint8_t function, struct EventStruct *event, String& string)
             if (panasonicHeatpumpIR != nullptr) {
               enableIR_RX(false);
               panasonicHeatpumpIR->sendPanasonicCKPCancelTimer(*Plugin_088_irSender);
+#if FEATURE_IR_RMT
+              IR_RMT_tx_flush();
+#endif // if FEATURE_IR_RMT
               enableIR_RX(true);
 
               delete panasonicHeatpumpIR;
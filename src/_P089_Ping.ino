@@ -19,6 +19,9 @@
    Maintainer: Denys Fedoryshchenko, denys AT nuclearcat.com
  */
 /** Changelog:
+ * 2026-10-15 Add Host list mode: ping up to 16 hosts at once via the shared ICMP socket, without waiting for the replies.
+ *            Values: nr. of hosts not responding, nr. of hosts responding and the average round trip time.
+ *            Optional event per host with round trip time and loss percentage.
  * 2023-03-19 tonhuisman: Show hostname in GPIO column of Devices page
  * 2023-03-14 tonhuisman: Change command handling to not require the taskname as the second argument if no 3rd argument is given.
  *                        Set decimals to 0 whan adding the task.
@@ -29,6 +32,8 @@
 # define PLUGIN_089
 # define PLUGIN_NAME_089           "Communication - Ping"
 # define PLUGIN_VALUENAME1_089     "Fails"
+# define PLUGIN_VALUENAME2_089     "Up"
+# define PLUGIN_VALUENAME3_089     "AvgRTT"
 
 
 boolean Plugin_089(uint8_t function, struct EventStruct *event, String& string)
@@ -50,6 +55,8 @@ boolean Plugin_089(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].FormulaOption      = false;
       Device[deviceCount].SendDataOption     = true;
       Device[deviceCount].TimerOption        = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(WRITE);
       break;
     }
 
@@ -62,17 +69,49 @@ boolean Plugin_089(uint8_t function, struct EventStruct *event, String& string)
     case PLUGIN_GET_DEVICEVALUENAMES:
     {
       strcpy_P(ExtraTaskSettings.TaskDeviceValueNames[0], PSTR(PLUGIN_VALUENAME1_089));
+      strcpy_P(ExtraTaskSettings.TaskDeviceValueNames[1], PSTR(PLUGIN_VALUENAME2_089));
+      strcpy_P(ExtraTaskSettings.TaskDeviceValueNames[2], PSTR(PLUGIN_VALUENAME3_089));
+      break;
+    }
+
+    case PLUGIN_GET_DEVICEVALUECOUNT:
+    {
+      event->Par1 = P089_MODE == P089_MODE_MULTI ? 3 : 1;
+      success     = true;
+      break;
+    }
+
+    case PLUGIN_GET_DEVICEVTYPE:
+    {
+      event->sensorType = P089_MODE == P089_MODE_MULTI ? Sensor_VType::SENSOR_TYPE_TRIPLE : Sensor_VType::SENSOR_TYPE_SINGLE;
+      event->idx        = 0;
+      success           = true;
       break;
     }
 
     case PLUGIN_SET_DEFAULTS:
     {
       ExtraTaskSettings.TaskDeviceValueDecimals[0] = 0; // Count doesn't include decimals
+      ExtraTaskSettings.TaskDeviceValueDecimals[1] = 0;
+      ExtraTaskSettings.TaskDeviceValueDecimals[2] = 0;
+      P089_TIMEOUT                                 = P089_DEFAULT_TIMEOUT;
       break;
     }
 
     case PLUGIN_WEBFORM_SHOW_GPIO_DESCR:
     {
+      if (P089_MODE == P089_MODE_MULTI) {
+        String strings[P089_MAX_HOSTS];
+        LoadCustomTaskSettings(event->TaskIndex, strings, P089_MAX_HOSTS, P089_HOST_SIZE, P089_HOSTS_OFFSET);
+        int nrHosts = 0;
+
+        for (uint8_t i = 0; i < P089_MAX_HOSTS; ++i) {
+          if (!strings[i].isEmpty()) { ++nrHosts; }
+        }
+        string  = concat(nrHosts, F(" hosts"));
+        success = true;
+        break;
+      }
       char hostname[PLUGIN_089_HOSTNAME_SIZE]{};
       LoadCustomTaskSettings(event->TaskIndex, (uint8_t *)&hostname, PLUGIN_089_HOSTNAME_SIZE);
       string  = hostname;
@@ -82,22 +121,64 @@ boolean Plugin_089(uint8_t function, struct EventStruct *event, String& string)
 
     case PLUGIN_WEBFORM_LOAD:
     {
-      char hostname[PLUGIN_089_HOSTNAME_SIZE]{};
-      LoadCustomTaskSettings(event->TaskIndex, (uint8_t *)&hostname, PLUGIN_089_HOSTNAME_SIZE);
-      addFormTextBox(F("Hostname"), F("host"), hostname, PLUGIN_089_HOSTNAME_SIZE - 2);
+      {
+        const __FlashStringHelper *options[] = {
+          F("Single host"),
+          F("Host list"),
+        };
+        const int optionValues[] = { P089_MODE_SINGLE, P089_MODE_MULTI };
+        addFormSelector(F("Mode"), F("pmode"), 2, options, optionValues, P089_MODE, true);
+      }
+
+      if (P089_MODE == P089_MODE_MULTI) {
+        String strings[P089_MAX_HOSTS];
+        LoadCustomTaskSettings(event->TaskIndex, strings, P089_MAX_HOSTS, P089_HOST_SIZE, P089_HOSTS_OFFSET);
+
+        for (uint8_t varNr = 0; varNr < P089_MAX_HOSTS; ++varNr) {
+          addFormTextBox(concat(F("Host "), varNr + 1), getPluginCustomArgName(varNr), strings[varNr], P089_HOST_SIZE - 1);
+        }
+        addFormNumericBox(F("Reply timeout"), F("ptimeout"), P089_TIMEOUT, 100, 5000);
+        addUnit(F("msec"));
+        addFormCheckBox(F("Event per host"), F("pevents"), P089_SEND_EVENTS);
+        addFormNote(F("Event: &lt;taskname&gt;#Host&lt;n&gt;=&lt;round trip time msec, -1 = no reply&gt;,&lt;loss %&gt;"));
+      } else {
+        char hostname[PLUGIN_089_HOSTNAME_SIZE]{};
+        LoadCustomTaskSettings(event->TaskIndex, (uint8_t *)&hostname, PLUGIN_089_HOSTNAME_SIZE);
+        addFormTextBox(F("Hostname"), F("host"), hostname, PLUGIN_089_HOSTNAME_SIZE - 2);
+      }
       success = true;
       break;
     }
 
     case PLUGIN_WEBFORM_SAVE:
     {
-      char hostname[PLUGIN_089_HOSTNAME_SIZE]{};
+      // Only save the fields shown, the mode may just have been changed.
+      if (P089_MODE == P089_MODE_MULTI) {
+        String strings[P089_MAX_HOSTS];
+        String error;
+
+        for (uint8_t varNr = 0; varNr < P089_MAX_HOSTS; ++varNr) {
+          strings[varNr] = webArg(getPluginCustomArgName(varNr));
+          strings[varNr].trim();
+        }
+        error = SaveCustomTaskSettings(event->TaskIndex, strings, P089_MAX_HOSTS, P089_HOST_SIZE, P089_HOSTS_OFFSET);
+
+        if (!error.isEmpty()) {
+          addHtmlError(error);
+        }
+        P089_TIMEOUT     = getFormItemInt(F("ptimeout"));
+        P089_SEND_EVENTS = isFormItemChecked(F("pevents"));
+      } else {
+        char hostname[PLUGIN_089_HOSTNAME_SIZE]{};
+
+        strncpy(hostname, webArg(F("host")).c_str(), sizeof(hostname) - 1);
+        SaveCustomTaskSettings(event->TaskIndex, (uint8_t *)&hostname, PLUGIN_089_HOSTNAME_SIZE);
+      }
+      P089_MODE = getFormItemInt(F("pmode"));
 
       // Reset "Fails" if settings updated
       UserVar[event->BaseVarIndex] = 0;
-      strncpy(hostname, webArg(F("host")).c_str(), sizeof(hostname));
-      SaveCustomTaskSettings(event->TaskIndex, (uint8_t *)&hostname, PLUGIN_089_HOSTNAME_SIZE);
-      success = true;
+      success                      = true;
       break;
     }
 
@@ -118,6 +199,12 @@ boolean Plugin_089(uint8_t function, struct EventStruct *event, String& string)
         break;
       }
 
+      if (P089_MODE == P089_MODE_MULTI) {
+        // Values are set and sent when all replies are received, or the timeout has passed.
+        P089_taskdata->send_pings(event);
+        break;
+      }
+
       if (P089_taskdata->send_ping(event)) {
         UserVar[event->BaseVarIndex]++;
       }
@@ -126,6 +213,21 @@ boolean Plugin_089(uint8_t function, struct EventStruct *event, String& string)
       break;
     }
 
+    case PLUGIN_TEN_PER_SECOND:
+    {
+      if (P089_MODE == P089_MODE_MULTI) {
+        P089_data_struct *P089_taskdata =
+          static_cast<P089_data_struct *>(getPluginTaskData(event->TaskIndex));
+
+        if ((nullptr != P089_taskdata) && P089_taskdata->roundCompleted(event)) {
+          P089_taskdata->finishRound(event);
+          sendData(event);
+        }
+        success = true;
+      }
+      break;
+    }
+
     case PLUGIN_WRITE:
     {
       String command = parseString(string, 1);
@@ -99,6 +99,7 @@ boolean Plugin_091(uint8_t function, struct EventStruct *event, String& string)
         Device[deviceCount].TimerOption = true;
         Device[deviceCount].TimerOptional = true;
         Device[deviceCount].GlobalSyncOption = true;
+        Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(WRITE) | PLUGIN_CALL_SUBSCRIBE(SERIAL_IN);
         break;
       }
     case PLUGIN_GET_DEVICENAME:
@@ -22,6 +22,11 @@
    For following devices just a pull up resistor is needed if the device is used stand alone:
          UVR1611, UVR61-3 and ESR21
 
+    @tonhuisman 2026-10-15 CHG: ISR only stores the edge timings in a small ring buffer, edges are decoded incrementally
+                           in PLUGIN_FIFTY_PER_SECOND, instead of processing a 1402 byte pulse buffer at once.
+                           StartReceiving no longer waits (up to 100 msec) for the first pulse.
+                           ESP32-S3/ESP32-C3: Capture the edges with the RMT peripheral.
+
     @tonhuisman 2022-09-24 Optimizations, suppress some logging for stressed builds
 
     @uwekaditz 2022-09-04 CHG: #ifdef INPUT_PULLDOWN and all its dependencies removed 
@@ -103,6 +108,8 @@ boolean Plugin_092(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].DecimalsOnly       = true;
       Device[deviceCount].PluginStats        = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(ONCE_A_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(FIFTY_PER_SECOND);
       break;
     }
 
@@ -310,8 +317,8 @@ boolean Plugin_092(uint8_t function, struct EventStruct *event, String& string)
 
         if (P092_data->DLbus_Data->IsISRset) {
           // interrupt was already attached to P092_DLB_Pin
-          P092_data->DLbus_Data->IsISRset = false; // to ensure that a new interrupt is attached in P092_data->init()
-          detachInterrupt(digitalPinToInterrupt(P092_data->DLbus_Data->ISR_DLB_Pin));
+          // IsISRset is reset to ensure that a new interrupt is attached in P092_data->init()
+          P092_data->DLbus_Data->detachDLBusInterrupt();
           # ifndef LIMIT_BUILD_SIZE
           addLog(LOG_LEVEL_INFO, F("P092_save: detachInterrupt"));
           # endif // ifndef LIMIT_BUILD_SIZE
@@ -475,9 +482,9 @@ boolean Plugin_092(uint8_t function, struct EventStruct *event, String& string)
 
       P092_data->Plugin_092_SetIndices(PCONFIG(0));
 
-      if (P092_data->DLbus_Data->ISR_AllBitsReceived) {
-        P092_data->DLbus_Data->ISR_AllBitsReceived = false;
-        success                                    = P092_data->DLbus_Data->CheckTimings();
+      if (P092_data->DLbus_Data->FrameComplete) {
+        P092_data->DLbus_Data->FrameComplete = false;
+        success                              = P092_data->DLbus_Data->FrameTimingOK;
 
         if (success) {
           success = P092_data->DLbus_Data->Processing();
@@ -510,6 +517,16 @@ boolean Plugin_092(uint8_t function, struct EventStruct *event, String& string)
       break;
     }
 
+    case PLUGIN_FIFTY_PER_SECOND:
+    {
+      // Decode the received edges in small steps, the frame is processed in PLUGIN_ONCE_A_SECOND
+      if (P092_init && (nullptr != P092_data) && (nullptr != P092_data->DLbus_Data)) {
+        P092_data->DLbus_Data->ProcessEdges();
+      }
+      success = true;
+      break;
+    }
+
     case PLUGIN_READ:
     {
 # ifndef P092_LIMIT_BUILD_SIZE
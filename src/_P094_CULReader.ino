@@ -8,6 +8,12 @@
 // Interact with Brick4U CUL receiver
 // Allows to control the mode of the CUL receiver
 //
+// Changelog:
+// 2026-10-15 tonhuisman: On ESP32 hardware serial, only read the port when woken by the UART driver receive event.
+// 2026-10-15 tonhuisman: Filters are converted once at init and matched on the received frame before creating a String.
+//                        Add hit counter per filter set, counters for rejected frames, and a window for dropping
+//                        repeated telegrams. Fix: Filter 7 was never checked. Per frame filter logging moved to DEBUG.
+//
 
 
 #include "src/Helpers/ESPEasy_Storage.h"
@@ -75,6 +81,8 @@ boolean Plugin_094(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].DuplicateDetection = true;
       // FIXME TD-er: Not sure if access to any existing task data is needed when saving
       Device[deviceCount].ExitTaskBeforeSave = false;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(FIFTY_PER_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(WRITE);
       break;
     }
 
@@ -195,6 +203,7 @@ boolean Plugin_094(uint8_t function, struct EventStruct *event, String& string)
       if (P094_data->init(port, serial_rx, serial_tx, P094_BAUDRATE)) {
         LoadCustomTaskSettings(event->TaskIndex, P094_data->_lines, P94_Nlines, 0);
         P094_data->post_init();
+        P094_data->enableRxEvent(event->TaskIndex);
         success = true;
 
         serialHelper_log_GpioDescription(port, serial_rx, serial_tx);
@@ -204,6 +213,9 @@ boolean Plugin_094(uint8_t function, struct EventStruct *event, String& string)
       break;
     }
 
+    #if FEATURE_SERIAL_RX_EVENT
+    case PLUGIN_TASKTIMER_IN: // Woken when data was received, see serialHelper_enableRxEvent()
+    #endif // if FEATURE_SERIAL_RX_EVENT
     case PLUGIN_FIFTY_PER_SECOND: {
       if (Settings.TaskDeviceEnabled[event->TaskIndex]) {
         P094_data_struct *P094_data =
@@ -215,30 +227,29 @@ boolean Plugin_094(uint8_t function, struct EventStruct *event, String& string)
                     // background tasks.
           P094_data->getSentence(event->String2, P094_APPEND_RECEIVE_SYSTIME);
 
+          // Frames are already checked against the filters by loop()
           if (event->String2.length() > 0) {
-            if (Plugin_094_match_all(event->TaskIndex, event->String2)) {
-              if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-                String log;
-                if (log.reserve(128)) {
-                  log = F("CUL Reader: Sending: ");
-                  const size_t messageLength = event->String2.length();
-                  if (messageLength < 100) {
-                    log += event->String2;
-                  } else {
-                    // Split string so we get start and end
-                    log += event->String2.substring(0, 40);
-                    log += F("...");
-                    log += event->String2.substring(messageLength - 40);
-                  }
-                  addLogMove(LOG_LEVEL_INFO, log);
+            if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+              String log;
+              if (log.reserve(128)) {
+                log = F("CUL Reader: Sending: ");
+                const size_t messageLength = event->String2.length();
+                if (messageLength < 100) {
+                  log += event->String2;
+                } else {
+                  // Split string so we get start and end
+                  log += event->String2.substring(0, 40);
+                  log += F("...");
+                  log += event->String2.substring(messageLength - 40);
                 }
+                addLogMove(LOG_LEVEL_INFO, log);
               }
-              // Filter length options:
-              // - 22 char, for hash-value then we filter the exact meter including serial and meter type, (that will also prevent very quit sending meters, which normaly is a fault)
-              // - 38 char, The exact message, because we have 2 uint8_t from the value payload
-              //sendData_checkDuplicates(event, event->String2.substring(0, 22));
-              sendData(event);
             }
+            // Filter length options:
+            // - 22 char, for hash-value then we filter the exact meter including serial and meter type, (that will also prevent very quit sending meters, which normaly is a fault)
+            // - 38 char, The exact message, because we have 2 uint8_t from the value payload
+            //sendData_checkDuplicates(event, event->String2.substring(0, 22));
+            sendData(event);
           }
         }
         success = true;
@@ -298,30 +309,6 @@ boolean Plugin_094(uint8_t function, struct EventStruct *event, String& string)
   return success;
 }
 
-bool Plugin_094_match_all(taskIndex_t taskIndex, const String& received)
-{
-  P094_data_struct *P094_data =
-    static_cast<P094_data_struct *>(getPluginTaskData(taskIndex));
-
-  if ((nullptr == P094_data)) {
-    return false;
-  }
-
-
-  if (P094_data->disableFilterWindowActive()) {
-    addLog(LOG_LEVEL_INFO, F("CUL Reader: Disable Filter Window active"));
-    return true;
-  }
-
-  bool res = P094_data->parsePacket(received);
-
-  if (P094_data->invertMatch()) {
-    addLog(LOG_LEVEL_INFO, F("CUL Reader: invert filter"));
-    return !res;
-  }
-  return res;
-}
-
 String Plugin_094_valuename(uint8_t value_nr, bool displayString) {
   switch (value_nr) {
     case P094_QUERY_VALUE: return displayString ? F("Value")          : F("v");
@@ -342,6 +329,14 @@ void P094_html_show_matchForms(struct EventStruct *event) {
     addUnit(F("msec"));
     addFormNote(F("0 = Do not turn off filter after sending to the connected device."));
 
+    addFormNumericBox(F("Drop repeated telegrams within"),
+                      getPluginCustomArgName(P094_DEDUP_WINDOW_POS),
+                      P094_data->getDedupWindowTime(),
+                      0,
+                      600000);
+    addUnit(F("msec"));
+    addFormNote(F("0 = Send all telegrams. Telegrams are compared without the RSSI."));
+
     {
       const __FlashStringHelper * options[P094_Match_Type_NR_ELEMENTS];
       int    optionValues[P094_Match_Type_NR_ELEMENTS];
@@ -460,6 +455,24 @@ void P094_html_show_stats(struct EventStruct *event) {
     addRowLabel(F("Length Last Sentence"));
     addHtmlInt(length_last);
   }
+
+  {
+    constexpr uint8_t nrFilterSets = P094_NR_FILTERS / P094_AND_FILTER_BLOCK;
+    uint32_t rejected, duplicates;
+    uint32_t setHits[nrFilterSets] = { 0 };
+    P094_data->getFilterStats(rejected, duplicates, setHits, nrFilterSets);
+    addRowLabel(F("Sentences (rejected/repeated)"));
+    addHtmlInt(rejected);
+    addHtml('/');
+    addHtmlInt(duplicates);
+
+    for (uint8_t i = 0; i < nrFilterSets; ++i) {
+      if (setHits[i] > 0) {
+        addRowLabel(concat(F("Filter "), static_cast<int>(i + 1)));
+        addHtmlInt(setHits[i]);
+      }
+    }
+  }
 }
 
 #endif // USES_P094
\ No newline at end of file
@@ -15,6 +15,7 @@
 
 /**
  * Changelog:
+ * 2026-10-15 tonhuisman: Enable the AdafruitGFX_helper draw cache, unchanged text is no longer sent to the display again
  * 2022-10-24 tonhuisman: Add Invert display option in settings to accomodate displays that swap foreground and background colors
  *                        (f.e. M5Stack Core2 using ILI9342C), or just to invert the colors at user choice.
  * 2022-07-20 tonhuisman: Made support for ILI9486/ILI9488 optional and excluded by default as these are not available as
@@ -154,6 +155,10 @@ boolean Plugin_095(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].TimerOptional      = true;
       success                                = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(ONCE_A_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(FIFTY_PER_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(WRITE);
       break;
     }
 
@@ -71,6 +71,7 @@
  |-----|-----|-----|
  | clear | clear,<color> | Clear display |
  | deepsleep | deepsleep | Make screen go to sleep |
+ | fullrefresh | fullrefresh | Next update uses a full refresh instead of a partial update |
  | inv | inv,<value> | Invert the dispaly (value:0 normal display, 1 inverted display) |
  | rot | rot,<value> | Rotate display (value from 0 to 3 inclusive) |
 
@@ -193,6 +194,7 @@ boolean Plugin_096(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].SendDataOption = false;
 
       success = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(WRITE);
       break;
     }
 
@@ -395,6 +397,9 @@ boolean Plugin_096(uint8_t function, struct EventStruct *event, String& string)
 
       AdaGFXFormTextBackgroundFill(F("_backfill"), bitRead(P096_CONFIG_FLAGS, P096_CONFIG_FLAG_BACK_FILL) == 0);      // Inverse
 
+      addFormNumericBox(F("Partial updates before full refresh"), F("_partial"), P096_CONFIG_FLAG_GET_PARTIAL, 0, 15);
+      addFormNote(F("0 = Always full refresh. Partial updates are supported by the IL3897 display."));
+
       addFormSubHeader(F("Content"));
 
       if (P096_CONFIG_COLORS == 0) { // For migrating from older release task settings
@@ -453,6 +458,7 @@ boolean Plugin_096(uint8_t function, struct EventStruct *event, String& string)
       set4BitToUL(lSettings, P096_CONFIG_FLAG_MODE,        getFormItemInt(F("_mode")));           // Bit 16..19 Text print mode
       set4BitToUL(lSettings, P096_CONFIG_FLAG_COLORDEPTH,  getFormItemInt(F("_colorDepth")));     // Bit 20..23 Color depth
       set4BitToUL(lSettings, P096_CONFIG_FLAG_DISPLAYTYPE, getFormItemInt(F("_type")));           // Bit 24..27 Hardwaretype
+      set4BitToUL(lSettings, P096_CONFIG_FLAG_PARTIAL,     getFormItemInt(F("_partial")));        // Bit 28..31 Partial updates
 
       P096_CONFIG_FLAGS = lSettings;
 
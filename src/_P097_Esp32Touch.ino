@@ -40,12 +40,25 @@
 # define P097_SEND_RELEASE_EVENT  PCONFIG(1)
 # define P097_SEND_DURATION_EVENT PCONFIG(2)
 # define P097_TOUCH_THRESHOLD     PCONFIG(3)
+# define P097_AUTO_BASELINE       PCONFIG(4)
 
 // Share this bitmap among all instances of this plugin
 DRAM_ATTR uint32_t p097_pinTouched     = 0;
 DRAM_ATTR uint32_t p097_pinTouchedPrev = 0;
 DRAM_ATTR uint32_t p097_timestamp[LAST_TOUCH_INPUT_INDEX]  = { 0 };
 
+# ifdef ESP32_CLASSIC
+
+// Untouched reading per touch pad, tracked from the task readings when 'Automatic Baseline' is enabled.
+// Only on ESP32 classic, on ESP32-S2/S3 the touch peripheral keeps a benchmark value itself
+// and the interrupt threshold is already relative to it.
+uint16_t p097_baseline[LAST_TOUCH_INPUT_INDEX]       = { 0 };
+uint16_t p097_activeThreshold[LAST_TOUCH_INPUT_INDEX] = { 0 };
+
+// Weight of a new reading in the baseline, 1/n
+#  define P097_BASELINE_FILTER    8
+# endif // ifdef ESP32_CLASSIC
+
 boolean Plugin_097(uint8_t function, struct EventStruct *event, String& string)
 {
   boolean success = false;
@@ -67,6 +80,7 @@ boolean Plugin_097(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = false;
       Device[deviceCount].TimerOptional      = true;
       Device[deviceCount].GlobalSyncOption   = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND);
       break;
     }
 
@@ -101,6 +115,10 @@ boolean Plugin_097(uint8_t function, struct EventStruct *event, String& string)
       addFormCheckBox(F("Send Release Event"),  F("sendrelease"),  P097_SEND_RELEASE_EVENT);
       addFormCheckBox(F("Send Duration Event"), F("sendduration"), P097_SEND_DURATION_EVENT);
       addFormNumericBox(F("Touch Threshold"), F("threshold"), P097_TOUCH_THRESHOLD, 0, P097_MAX_ADC_VALUE);
+      # ifdef ESP32_CLASSIC
+      addFormCheckBox(F("Automatic Baseline"), F("autobaseline"), P097_AUTO_BASELINE);
+      addFormNote(F("Threshold is the drop below the untouched value, which is tracked at the task interval"));
+      # endif // ifdef ESP32_CLASSIC
 
       // Show current value
       addRowLabel(F("Current Pressure"));
@@ -116,6 +134,9 @@ boolean Plugin_097(uint8_t function, struct EventStruct *event, String& string)
       P097_SEND_RELEASE_EVENT  = isFormItemChecked(F("sendrelease"));
       P097_SEND_DURATION_EVENT = isFormItemChecked(F("sendduration"));
       P097_TOUCH_THRESHOLD     = getFormItemInt(F("threshold"));
+      # ifdef ESP32_CLASSIC
+      P097_AUTO_BASELINE = isFormItemChecked(F("autobaseline"));
+      # endif // ifdef ESP32_CLASSIC
 
       success = true;
       break;
@@ -123,7 +144,19 @@ boolean Plugin_097(uint8_t function, struct EventStruct *event, String& string)
 
     case PLUGIN_INIT:
     {
-      P097_setEventParams(CONFIG_PIN1, P097_TOUCH_THRESHOLD);
+      # ifdef ESP32_CLASSIC
+      int adc, ch, t;
+
+      if (P097_AUTO_BASELINE && getADC_gpio_info(CONFIG_PIN1, adc, ch, t)) {
+        // Assume the pad is not touched at init
+        p097_baseline[t]        = touchRead(CONFIG_PIN1);
+        p097_activeThreshold[t] = P097_getBaselineThreshold(p097_baseline[t], P097_TOUCH_THRESHOLD);
+        P097_setEventParams(CONFIG_PIN1, p097_activeThreshold[t]);
+      } else
+      # endif // ifdef ESP32_CLASSIC
+      {
+        P097_setEventParams(CONFIG_PIN1, P097_TOUCH_THRESHOLD);
+      }
       success = true;
       break;
     }
@@ -144,8 +177,8 @@ boolean Plugin_097(uint8_t function, struct EventStruct *event, String& string)
 
           if (touched != touched_prev) {
             // state changed
-            UserVar[event->BaseVarIndex] = touchRead(CONFIG_PIN1);
-
+            // No touchRead() here, it takes a few msec per call.
+            // The value is updated via the scheduled PLUGIN_READ.
             if (touched) {
               if (P097_SEND_TOUCH_EVENT) {
                 // schedule a read to update output values and send to controllers
@@ -178,6 +211,22 @@ boolean Plugin_097(uint8_t function, struct EventStruct *event, String& string)
       int raw_value = touchRead(CONFIG_PIN1);
       UserVar[event->BaseVarIndex] = raw_value;
 
+      # ifdef ESP32_CLASSIC
+      int adc, ch, t;
+
+      if (P097_AUTO_BASELINE && getADC_gpio_info(CONFIG_PIN1, adc, ch, t) && !bitRead(p097_pinTouchedPrev, t)) {
+        // Follow slow changes of the untouched value, e.g. due to temperature or humidity
+        p097_baseline[t] = ((P097_BASELINE_FILTER - 1) * p097_baseline[t] + raw_value) / P097_BASELINE_FILTER;
+
+        const uint16_t threshold = P097_getBaselineThreshold(p097_baseline[t], P097_TOUCH_THRESHOLD);
+
+        if (threshold != p097_activeThreshold[t]) {
+          p097_activeThreshold[t] = threshold;
+          P097_setEventParams(CONFIG_PIN1, threshold);
+        }
+      }
+      # endif // ifdef ESP32_CLASSIC
+
       if (loglevelActiveFor(LOG_LEVEL_INFO)) {
         String log = F("Touch : ");
         log += formatGpioName_ADC(CONFIG_PIN1);
@@ -192,6 +241,18 @@ boolean Plugin_097(uint8_t function, struct EventStruct *event, String& string)
   return success;
 }
 
+# ifdef ESP32_CLASSIC
+
+// Touched pads read lower, so the interrupt threshold is below the baseline.
+uint16_t P097_getBaselineThreshold(uint16_t baseline, int16_t delta) {
+  if (static_cast<int>(baseline) > delta) {
+    return baseline - delta;
+  }
+  return 0;
+}
+
+# endif // ifdef ESP32_CLASSIC
+
 /**********************************************************************************
 * Touch pin callback functions
 **********************************************************************************/
@@ -6,6 +6,7 @@
 
 /**
  * Changelog:
+ * 2026-10-15: Add optional TS IRQ pin (PENIRQ), so the touchscreen is only read via SPI after it was touched
  * 2020-11-01 tonhuisman: Solved previous strange rotation settings to be compatible with TFT ILI9341
  * 2020-11-01 tonhuisman: Add option to flip rotation by 180 deg, and command touch,flip,<0|1>
  * 2020-11-01 tonhuisman: Add option for the debounce timeout for On/Off buttons
@@ -50,6 +51,7 @@
 
 #define P099_CONFIG_STATE       PCONFIG(0)
 #define P099_CONFIG_CS_PIN      PIN(0)
+#define P099_CONFIG_IRQ_PIN     PIN(1)
 #define P099_CONFIG_TRESHOLD    PCONFIG(1)
 #define P099_CONFIG_ROTATION    PCONFIG(2)
 #define P099_CONFIG_X_RES       PCONFIG(3)
@@ -90,7 +92,7 @@ boolean Plugin_099(uint8_t function, struct EventStruct *event, String& string)
     case PLUGIN_DEVICE_ADD:
     {
       Device[++deviceCount].Number           = PLUGIN_ID_099;
-      Device[deviceCount].Type               = DEVICE_TYPE_SPI;
+      Device[deviceCount].Type               = DEVICE_TYPE_SPI2;
       Device[deviceCount].VType              = Sensor_VType::SENSOR_TYPE_TRIPLE;
       Device[deviceCount].Ports              = 0;
       Device[deviceCount].PullUpOption       = false;
@@ -100,6 +102,8 @@ boolean Plugin_099(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].SendDataOption     = false;
       Device[deviceCount].TimerOption        = false;
       success                                = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(WRITE);
       break;
     }
 
@@ -122,6 +126,7 @@ boolean Plugin_099(uint8_t function, struct EventStruct *event, String& string)
     case PLUGIN_GET_DEVICEGPIONAMES:
     {
       event->String1 = formatGpioName_output(F("TS CS"));
+      event->String2 = formatGpioName_input_optional(F("TS IRQ"));
       break;
     }
 
@@ -401,6 +406,7 @@ boolean Plugin_099(uint8_t function, struct EventStruct *event, String& string)
 
       success = (nullptr != P099_data) && P099_data->init(event->TaskIndex,
                                                           P099_CONFIG_CS_PIN,
+                                                          P099_CONFIG_IRQ_PIN,
                                                           P099_CONFIG_ROTATION,
                                                           bitRead(P099_CONFIG_FLAGS, P099_FLAGS_ROTATION_FLIPPED),
                                                           P099_CONFIG_TRESHOLD,
@@ -14,6 +14,8 @@
 # define PLUGIN_NAME_100       "Pulse Counter - DS2423"
 # define PLUGIN_VALUENAME1_100 "CountDelta"
 
+# define P100_DALLAS_DRIVER    PCONFIG(1)
+
 boolean Plugin_100(uint8_t function, struct EventStruct *event, String& string)
 {
   boolean success = false;
@@ -33,6 +35,7 @@ boolean Plugin_100(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].SendDataOption     = true;
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].GlobalSyncOption   = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE_NONE;
       break;
     }
 
@@ -69,6 +72,9 @@ boolean Plugin_100(uint8_t function, struct EventStruct *event, String& string)
         int    resultsOptionValues[2] = { 0, 1 };
         addFormSelector(F("Counter"), F("counter"), 2, resultsOptions, resultsOptionValues, PCONFIG(0));
         addFormNote(F("Counter value is incremental"));
+        # if FEATURE_DALLAS_RMT
+        Dallas_driver_webform_load(P100_DALLAS_DRIVER);
+        # endif // if FEATURE_DALLAS_RMT
       }
       success = true;
       break;
@@ -81,6 +87,9 @@ boolean Plugin_100(uint8_t function, struct EventStruct *event, String& string)
 
       // 1-wire device address
       Dallas_addr_selector_webform_save(event->TaskIndex, CONFIG_PIN1, CONFIG_PIN1);
+      # if FEATURE_DALLAS_RMT
+      P100_DALLAS_DRIVER = Dallas_driver_webform_save();
+      # endif // if FEATURE_DALLAS_RMT
 
       success = true;
       break;
@@ -105,6 +114,9 @@ boolean Plugin_100(uint8_t function, struct EventStruct *event, String& string)
         // Explicitly set the pinMode using the "slow" pinMode function
         // This way we know for sure the state of any pull-up or -down resistor is known.
         pinMode(CONFIG_PIN1, INPUT);
+        # if FEATURE_DALLAS_RMT
+        Dallas_setDriver(CONFIG_PIN1, CONFIG_PIN1, static_cast<Dallas_driver_e>(P100_DALLAS_DRIVER));
+        # endif // if FEATURE_DALLAS_RMT
       }
 
       success = true;
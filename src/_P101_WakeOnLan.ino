@@ -123,6 +123,7 @@ boolean Plugin_101(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].FormulaOption      = false;
       Device[deviceCount].SendDataOption     = false;
       Device[deviceCount].TimerOption        = false;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(WRITE);
       break;
     }
 
@@ -73,6 +73,9 @@
 //                                the coordinate set.
 //
 // History:
+// 2026-10-15 tonhuisman: Run the animations from PLUGIN_FIFTY_PER_SECOND, so effect speeds below 100 msec are no longer slowed down.
+//                        All zones are still composed in the display buffer before the changed rows are sent out, now in a single
+//                        SPI transaction.
 // 2023-08-13 tonhuisman: Add Dot subcommand for pixel-drawing in a zone. Can be applied on any type of zone (so can be overwritten by the
 //                        original content when that's updated...)
 //                        Set default Hardware type to FC16, as that's the most used for modules found on Aliexpress
@@ -142,6 +145,9 @@ boolean Plugin_104(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOptional      = false;
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].ExitTaskBeforeSave = false;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(ONCE_A_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(FIFTY_PER_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(WRITE);
       break;
     }
 
@@ -307,10 +313,11 @@ boolean Plugin_104(uint8_t function, struct EventStruct *event, String& string)
       break;
     }
 
-    case PLUGIN_TEN_PER_SECOND: {
+    case PLUGIN_FIFTY_PER_SECOND: {
       P104_data_struct *P104_data = static_cast<P104_data_struct *>(getPluginTaskData(event->TaskIndex));
 
       if ((nullptr != P104_data) && (nullptr != P104_data->P)) {
+        // Zones only advance when their own speed interval has passed, all zones are flushed to the display at once
         P104_data->P->displayAnimate(); // Keep the animations moving
         success = true;
       }
@@ -56,6 +56,7 @@ boolean Plugin_106(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].PluginStats        = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE_NONE;
       break;
     }
 
@@ -137,33 +138,52 @@ boolean Plugin_106(uint8_t function, struct EventStruct *event, String& string)
 
       if (nullptr != P106_data)
       {
-        P106_data->begin(P106_I2C_ADDRESS);
-
-        if (!P106_data->initialized) {
-          break;
-        }
-
-        if (!P106_data->bme.performReading()) {
-          P106_data->initialized = false;
-          addLog(LOG_LEVEL_ERROR, F("BME68x : Failed to perform reading!"));
-          break;
-        }
-
-        UserVar[event->BaseVarIndex + 0] = P106_data->bme.temperature;
-        UserVar[event->BaseVarIndex + 1] = P106_data->bme.humidity;
-        UserVar[event->BaseVarIndex + 3] = P106_GET_OPT_GAS_OHM ? P106_data->bme.gas_resistance : P106_data->bme.gas_resistance / 1000.0f;
-
-        const int elev = P106_ALTITUDE;
-
-        if (elev != 0)
-        {
-          UserVar[event->BaseVarIndex + 2] = pressureElevation(P106_data->bme.pressure / 100.0f, elev);
-        } else {
-          UserVar[event->BaseVarIndex + 2] = P106_data->bme.pressure / 100.0f;
+        switch (P106_data->readPhase.getPhase(event->TaskIndex)) {
+          case PluginReadPhase_e::Start:
+          {
+            P106_data->begin(P106_I2C_ADDRESS);
+
+            if (!P106_data->initialized) {
+              break;
+            }
+
+            if (P106_data->bme.beginReading() == 0) {
+              P106_data->initialized = false;
+              addLog(LOG_LEVEL_ERROR, F("BME68x : Failed to start reading!"));
+              break;
+            }
+            const int remaining = P106_data->bme.remainingReadingMillis();
+            P106_data->readPhase.conversionStarted(event->TaskIndex, remaining > 0 ? remaining : 0);
+            break;
+          }
+          case PluginReadPhase_e::Wait:
+            break;
+          case PluginReadPhase_e::Collect:
+          {
+            // Conversion is ready, so endReading() does not block
+            if (!P106_data->bme.endReading()) {
+              P106_data->initialized = false;
+              addLog(LOG_LEVEL_ERROR, F("BME68x : Failed to perform reading!"));
+              break;
+            }
+
+            UserVar[event->BaseVarIndex + 0] = P106_data->bme.temperature;
+            UserVar[event->BaseVarIndex + 1] = P106_data->bme.humidity;
+            UserVar[event->BaseVarIndex + 3] = P106_GET_OPT_GAS_OHM ? P106_data->bme.gas_resistance : P106_data->bme.gas_resistance / 1000.0f;
+
+            const int elev = P106_ALTITUDE;
+
+            if (elev != 0)
+            {
+              UserVar[event->BaseVarIndex + 2] = pressureElevation(P106_data->bme.pressure / 100.0f, elev);
+            } else {
+              UserVar[event->BaseVarIndex + 2] = P106_data->bme.pressure / 100.0f;
+            }
+            success = true;
+            break;
+          }
         }
       }
-
-      success = true;
       break;
     }
   }
@@ -16,6 +16,13 @@
 //  Written by José Araújo (josemariaaraujo@gmail.com),
 //      with most code copied from plugin 085: _P085_AcuDC243.ino
 
+/** Changelog:
+ * 2026-10-15 tonhuisman: Read the selected values using a Modbus register map, merging the registers into block reads.
+ *                        Reading is non-blocking from PLUGIN_FIFTY_PER_SECOND, values are sent when all blocks are read.
+ *                        Share the serial port with other Modbus tasks on the same RS485 bus, reads are queued per bus.
+ *                        Show statistics and reply time of this slave.
+ */
+
 
 /*
    DF - Below doesn't look right; needs a RS485 to TTL(3.3v) level converter (see https://github.com/reaper7/SDM_Energy_Meter)
@@ -50,6 +57,8 @@ boolean Plugin_108(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].PluginStats        = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(WRITE) |
+                                                    PLUGIN_CALL_SUBSCRIBE(FIFTY_PER_SECOND);
       break;
     }
 
@@ -135,28 +144,52 @@ boolean Plugin_108(uint8_t function, struct EventStruct *event, String& string)
         static_cast<P108_data_struct *>(getPluginTaskData(event->TaskIndex));
 
       if ((nullptr != P108_data) && P108_data->isInitialized()) {
-        addFormNote(P108_data->modbus.detected_device_description);
-        addRowLabel(F("Checksum (pass/fail/nodata)"));
-        uint32_t reads_pass, reads_crc_failed, reads_nodata;
-        P108_data->modbus.getStatistics(reads_pass, reads_crc_failed, reads_nodata);
-        String chksumStats;
-        chksumStats  = reads_pass;
-        chksumStats += '/';
-        chksumStats += reads_crc_failed;
-        chksumStats += '/';
-        chksumStats += reads_nodata;
-        addHtml(chksumStats);
+        addFormNote(P108_data->detected_device_description);
+        ModbusRTU_slaveStats stats;
+
+        if (P108_data->bus->modbus.getStatistics(P108_data->modbusAddress, stats)) {
+          addRowLabel(F("Checksum (pass/fail/nodata)"));
+          String chksumStats;
+          chksumStats  = stats.pass;
+          chksumStats += '/';
+          chksumStats += stats.fail;
+          chksumStats += '/';
+          chksumStats += stats.nodata;
+          addHtml(chksumStats);
+          addRowLabel(F("Reply time (last/max)"));
+          String latency;
+          latency  = stats.lastLatency;
+          latency += '/';
+          latency += stats.maxLatency;
+          addHtml(latency);
+          addUnit(F("ms"));
+        }
+
+        if (P108_data->bus->refCount > 1) {
+          addRowLabel(F("Tasks sharing the bus"));
+          addHtmlInt(P108_data->bus->refCount);
+        }
 
         addFormSubHeader(F("Logged Values"));
-        p108_showValueLoadPage(P108_QUERY_Wh_imp, event);
-        p108_showValueLoadPage(P108_QUERY_Wh_exp, event);
-        p108_showValueLoadPage(P108_QUERY_Wh_tot, event);
-        p108_showValueLoadPage(P108_QUERY_V,      event);
-        p108_showValueLoadPage(P108_QUERY_A,      event);
-        p108_showValueLoadPage(P108_QUERY_W,      event);
-        p108_showValueLoadPage(P108_QUERY_VA,     event);
-        p108_showValueLoadPage(P108_QUERY_PF,     event);
-        p108_showValueLoadPage(P108_QUERY_F,      event);
+        {
+          const uint8_t queries[] = {
+            P108_QUERY_Wh_imp, P108_QUERY_Wh_exp, P108_QUERY_Wh_tot,
+            P108_QUERY_V,      P108_QUERY_A,      P108_QUERY_W,
+            P108_QUERY_VA,     P108_QUERY_PF,     P108_QUERY_F };
+          constexpr uint8_t nrQueries = NR_ELEMENTS(queries);
+          ModbusRTU_RegisterMap registerMap;
+          registerMap.setSlaveAddress(P108_data->modbusAddress);
+
+          for (uint8_t i = 0; i < nrQueries; ++i) {
+            p108_addQueryRegisters(registerMap, queries[i]);
+          }
+          registerMap.build(); // All in a single block read
+          registerMap.readAll(P108_data->modbus());
+
+          for (uint8_t i = 0; i < nrQueries; ++i) {
+            p108_showValueLoadPage(queries[i], registerMap);
+          }
+        }
 
         // Can't clear totals, maybe because of modbus library can't write DWORD?
         // Disabled for now
@@ -195,12 +228,12 @@ boolean Plugin_108(uint8_t function, struct EventStruct *event, String& string)
          if (isFormItemChecked(F("p108_clear_log")))
          {
           // Clear all logged values in the meter.
-          P108_data->modbus.writeMultipleRegisters(0x0, 0x00); // Clear Total Energy
-          P108_data->modbus.writeMultipleRegisters(0x1, 0x00); // Clear Total Energy
-          P108_data->modbus.writeMultipleRegisters(0x8, 0x00); // Clear Import Energy
-          P108_data->modbus.writeMultipleRegisters(0x9, 0x00); // Clear Import Energy
-          P108_data->modbus.writeMultipleRegisters(0xA, 0x00); // Clear Export Energy
-          P108_data->modbus.writeMultipleRegisters(0xB, 0x00); // Clear Export Energy
+          P108_data->modbus().writeMultipleRegisters(0x0, 0x00); // Clear Total Energy
+          P108_data->modbus().writeMultipleRegisters(0x1, 0x00); // Clear Total Energy
+          P108_data->modbus().writeMultipleRegisters(0x8, 0x00); // Clear Import Energy
+          P108_data->modbus().writeMultipleRegisters(0x9, 0x00); // Clear Import Energy
+          P108_data->modbus().writeMultipleRegisters(0xA, 0x00); // Clear Export Energy
+          P108_data->modbus().writeMultipleRegisters(0xB, 0x00); // Clear Export Energy
          }
          }*/
 
@@ -225,6 +258,7 @@ boolean Plugin_108(uint8_t function, struct EventStruct *event, String& string)
                           p108_storageValueToBaudrate(P108_BAUDRATE),
                           P108_DEV_ID)) {
         serialHelper_log_GpioDescription(port, serial_rx, serial_tx);
+        P108_data->initRegisterMap(event);
         success = true;
       } else {
         clearPluginTaskData(event->TaskIndex);
@@ -242,13 +276,28 @@ boolean Plugin_108(uint8_t function, struct EventStruct *event, String& string)
         static_cast<P108_data_struct *>(getPluginTaskData(event->TaskIndex));
 
       if ((nullptr != P108_data) && P108_data->isInitialized()) {
+        // Registers are read via the bus queue in PLUGIN_FIFTY_PER_SECOND, values are sent when all are read.
+        P108_data->bus->enqueue(&P108_data->registerMap);
+      }
+      break;
+    }
+
+    case PLUGIN_FIFTY_PER_SECOND: {
+      P108_data_struct *P108_data =
+        static_cast<P108_data_struct *>(getPluginTaskData(event->TaskIndex));
+
+      if ((nullptr != P108_data) && P108_data->isInitialized()) {
+        // Handles the queued reads of all tasks on the same bus
+        P108_data->bus->loop();
+      }
+
+      if ((nullptr != P108_data) && P108_data->registerMap.fetchCompleted()) {
         for (int i = 0; i < P108_NR_OUTPUT_VALUES; ++i) {
-          UserVar[event->BaseVarIndex + i] = p108_readValue(PCONFIG(i + P108_QUERY1_CONFIG_POS), event);
-          delay(1);
+          UserVar[event->BaseVarIndex + i] = p108_decodeValue(PCONFIG(i + P108_QUERY1_CONFIG_POS), P108_data->registerMap);
         }
-
-        success = true;
+        sendData(event);
       }
+      success = true;
       break;
     }
 
@@ -6,6 +6,7 @@
 // #######################################################################################################
 
 // Changelog:
+// 2026-10-15, Add optional IRQ pin: the card is only read when it answers the REQA, plus a slow heartbeat poll
 // 2022-06-24, tonhuisman: Move plugin_ten_per_second handler to pluginstruct so it can properly handle the reset procedure
 // 2022-06-23, tonhuisman: Reformat source (uncrustify), optimize somewhat for size
 //                         Replace delay() call in reset by handling via plugin_fifty_per_second
@@ -35,7 +36,7 @@ boolean Plugin_111(uint8_t function, struct EventStruct *event, String& string)
     case PLUGIN_DEVICE_ADD:
     {
       Device[++deviceCount].Number           = PLUGIN_ID_111;
-      Device[deviceCount].Type               = DEVICE_TYPE_SPI2;
+      Device[deviceCount].Type               = DEVICE_TYPE_SPI3;
       Device[deviceCount].VType              = Sensor_VType::SENSOR_TYPE_ULONG;
       Device[deviceCount].Ports              = 0;
       Device[deviceCount].PullUpOption       = false;
@@ -44,6 +45,8 @@ boolean Plugin_111(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].SendDataOption     = true;
       Device[deviceCount].TimerOption        = false;
       Device[deviceCount].GlobalSyncOption   = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(FIFTY_PER_SECOND);
       break;
     }
 
@@ -63,6 +66,7 @@ boolean Plugin_111(uint8_t function, struct EventStruct *event, String& string)
     {
       event->String1 = formatGpioName_output(F("CS PIN"));            // P111_CS_PIN
       event->String2 = formatGpioName_output_optional(F("RST PIN ")); // P111_RST_PIN
+      event->String3 = formatGpioName_input_optional(F("IRQ PIN "));  // P111_IRQ_PIN
       break;
     }
 
@@ -123,7 +127,7 @@ boolean Plugin_111(uint8_t function, struct EventStruct *event, String& string)
 
     case PLUGIN_INIT:
     {
-      initPluginTaskData(event->TaskIndex, new (std::nothrow) P111_data_struct(P111_CS_PIN, P111_RST_PIN));
+      initPluginTaskData(event->TaskIndex, new (std::nothrow) P111_data_struct(P111_CS_PIN, P111_RST_PIN, P111_IRQ_PIN));
       P111_data_struct *P111_data = static_cast<P111_data_struct *>(getPluginTaskData(event->TaskIndex));
 
       if (nullptr != P111_data) {
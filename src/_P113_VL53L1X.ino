@@ -6,6 +6,7 @@
 // #######################################################################################################
 
 /** Changelog:
+ * 2026-10-15, Optional INT pin (GPIO1 of the sensor), to only read the sensor when a measurement is ready
  * 2023-08-11, tonhuisman: Fix issue not surfacing before, that the library right-shifts the I2C address when that is set...
  *                         Also use new/delete on sensor object (code improvement)
  *                         Limit the selection list of I2C addresses to 1 item, as changing the I2C address of the sensor does not work as
@@ -45,6 +46,7 @@ boolean Plugin_113(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].PluginStats        = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(FIFTY_PER_SECOND);
       break;
     }
 
@@ -114,6 +116,11 @@ boolean Plugin_113(uint8_t function, struct EventStruct *event, String& string)
       addUnit(F("0-100mm"));
       addFormNote(F("Minimal change in Distance to trigger an event."));
 
+      # if FEATURE_PLUGIN_DATA_READY_PIN
+      addFormPinSelect(PinSelectPurpose::Generic_input, formatGpioName_input_optional(F("INT (GPIO1)")), F("taskdevicepin1"), P113_INT_PIN);
+      addFormNote(F("When connected, the sensor is only read when a measurement is ready, instead of polling it 50x per second."));
+      # endif // if FEATURE_PLUGIN_DATA_READY_PIN
+
       success = true;
       break;
     }
@@ -136,11 +143,16 @@ boolean Plugin_113(uint8_t function, struct EventStruct *event, String& string)
       P113_data_struct *P113_data = static_cast<P113_data_struct *>(getPluginTaskData(event->TaskIndex));
 
       success = (nullptr != P113_data) && P113_data->begin(); // Start the sensor
+
+      if (success) {
+        P113_data->enableDataReadyPin(event->TaskIndex, P113_INT_PIN);
+      }
       break;
     }
 
     case PLUGIN_EXIT:
     {
+      dataReadyPin_disable(event->TaskIndex);
       success = true;
       break;
     }
@@ -168,7 +180,7 @@ boolean Plugin_113(uint8_t function, struct EventStruct *event, String& string)
       P113_data_struct *P113_data = static_cast<P113_data_struct *>(getPluginTaskData(event->TaskIndex));
 
       if (nullptr != P113_data) {
-        if (P113_data->startRead()) {
+        if (P113_data->startRead() && !dataReadyPin_enabled(event->TaskIndex)) {
           if (P113_data->readAvailable() && (Settings.TaskDeviceTimer[event->TaskIndex] == 0)) { // Trigger as soon as there's a valid
                                                                                                  // measurement and the time-out is set to 0
             Scheduler.schedule_task_device_timer(event->TaskIndex, millis() + 10);
@@ -177,6 +189,19 @@ boolean Plugin_113(uint8_t function, struct EventStruct *event, String& string)
       }
       break;
     }
+
+    case PLUGIN_TASKTIMER_IN:
+    {
+      if ((event->Par1 == DATA_READY_PIN_TASKTIMER_PAR1) && dataReadyPin_triggered(event->TaskIndex)) {
+        P113_data_struct *P113_data = static_cast<P113_data_struct *>(getPluginTaskData(event->TaskIndex));
+
+        if ((nullptr != P113_data) && P113_data->readAvailable() && (Settings.TaskDeviceTimer[event->TaskIndex] == 0)) {
+          Scheduler.schedule_task_device_timer(event->TaskIndex, millis() + 10);
+        }
+        success = true;
+      }
+      break;
+    }
   }
   return success;
 }
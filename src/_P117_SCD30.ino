@@ -11,6 +11,7 @@
 
 // Changelog:
 //
+// 2026-10-15: Optional RDY pin, to read the sensor as soon as a new measurement is available
 // 2022-02-26 tonhuisman: Implement commands for get/set measurement interval, and a setting too. Bugfix.
 // 2022-02-26 tonhuisman: Implement commands for auto/manual CO2 calibration, and setting for auto calibration
 // 2021-11-20 tonhuisman: Implement multi-instance support (using PluginStruct)
@@ -56,6 +57,7 @@ boolean Plugin_117(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].PluginStats        = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(WRITE);
       break;
     }
 
@@ -117,6 +119,11 @@ boolean Plugin_117(uint8_t function, struct EventStruct *event, String& string)
       addUnit(F("2..1800 sec."));
 
       addFormCheckBox(F("Automatic Self Calibration"), F("abc"), P117_AUTO_CALIBRATION == 1);
+
+      # if FEATURE_PLUGIN_DATA_READY_PIN
+      addFormPinSelect(PinSelectPurpose::Generic_input, formatGpioName_input_optional(F("RDY")), F("taskdevicepin1"), P117_RDY_PIN);
+      addFormNote(F("When connected, values are read and sent as soon as a new measurement is available."));
+      # endif // if FEATURE_PLUGIN_DATA_READY_PIN
       success = true;
       break;
     }
@@ -153,6 +160,25 @@ boolean Plugin_117(uint8_t function, struct EventStruct *event, String& string)
 
       success = (nullptr != P117_data);
 
+      if (success) {
+        // RDY is active high and stays high until the measurement is read
+        dataReadyPin_enable(event->TaskIndex, P117_RDY_PIN, RISING);
+      }
+
+      break;
+    }
+    case PLUGIN_EXIT:
+    {
+      dataReadyPin_disable(event->TaskIndex);
+      break;
+    }
+    case PLUGIN_TASKTIMER_IN:
+    {
+      if ((event->Par1 == DATA_READY_PIN_TASKTIMER_PAR1) && dataReadyPin_triggered(event->TaskIndex)) {
+        // New measurement available, the task interval only acts as a fallback
+        Scheduler.schedule_task_device_timer(event->TaskIndex, millis());
+        success = true;
+      }
       break;
     }
     case PLUGIN_READ:
@@ -181,6 +207,12 @@ boolean Plugin_117(uint8_t function, struct EventStruct *event, String& string)
           }
           break;
         case ERROR_SCD30_NO_DATA:
+
+          if (dataReadyPin_enabled(event->TaskIndex)) {
+            // Values were already sent when the measurement became available
+            return success;
+          }
+          break;
         case ERROR_SCD30_CRC_ERROR:
         case ERROR_SCD30_CO2_ZERO:
           break;
@@ -11,6 +11,7 @@
  */
 
 /** Changelog:
+ * 2026-10-15 Add FIFO mode, reading all samples in bursts, and Vibration RMS/peak output values
  * 2023-01-09, tonhuisman: Fixed a bug that the Inactivity threshold wasn't saved, and thus not applied
  * 2021-12-10, tonhuisman: Split functional parts into P120_data_struc to re-use for P125 ADXL345 SPI plugin
  * 2021-11-22, tonhuisman: Move from DEVELOPMENT to TESTING
@@ -51,6 +52,9 @@ boolean Plugin_120(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOptional  = true;
       Device[deviceCount].PluginStats    = true;
       Device[deviceCount].OutputDataType = Output_Data_type_t::Simple;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(ONCE_A_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(FIFTY_PER_SECOND);
 
       break;
     }
@@ -180,8 +184,11 @@ boolean Plugin_120(uint8_t function, struct EventStruct *event, String& string)
     {
       P120_data_struct *P120_data = static_cast<P120_data_struct *>(getPluginTaskData(event->TaskIndex));
 
-      if (nullptr != P120_data) {
-        success = P120_data->initialized();
+      if ((nullptr != P120_data) && P120_data->initialized()) {
+        // Include the samples since the last update, the vibration values cover the whole Interval
+        P120_data->read_data(event);
+        P120_data->clear_vibration_stats();
+        success = true;
       }
 
       break;
@@ -212,8 +219,12 @@ boolean Plugin_120(uint8_t function, struct EventStruct *event, String& string)
     case PLUGIN_TEN_PER_SECOND:
     case PLUGIN_FIFTY_PER_SECOND:
     {
-      if (((function == PLUGIN_TEN_PER_SECOND) && (P120_FREQUENCY == P120_FREQUENCY_10)) ||
-          ((function == PLUGIN_FIFTY_PER_SECOND) && (P120_FREQUENCY == P120_FREQUENCY_50))) {
+      // In FIFO mode the sensor decides when to read, based on the nr. of samples collected
+      const bool fifoMode = bitRead(P120_CONFIG_FLAGS1, P120_FLAGS1_FIFO_MODE);
+
+      if ((fifoMode && (function == PLUGIN_FIFTY_PER_SECOND)) ||
+          (!fifoMode && (function == PLUGIN_TEN_PER_SECOND) && (P120_FREQUENCY == P120_FREQUENCY_10)) ||
+          (!fifoMode && (function == PLUGIN_FIFTY_PER_SECOND) && (P120_FREQUENCY == P120_FREQUENCY_50))) {
         P120_data_struct *P120_data = static_cast<P120_data_struct *>(getPluginTaskData(event->TaskIndex));
 
         if (nullptr != P120_data) {
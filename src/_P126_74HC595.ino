@@ -7,6 +7,7 @@
 // #######################################################################################################
 
 /** Changelog:
+ * 2026-10-15 Option to use hardware SPI (MOSI -> DS, SCK -> SH_CP) to send the whole chain in a single transfer.
  * 2022-02-27 tonhuisman: Rename plugin title to Output - Shift registers (74HC595)
  * 2022-02-25 tonhuisman: Again rename commands, now using separate prefix shiftout and the rest of the previous command as subcommand.
  * 2022-02-24 tonhuisman: Further update changing 74hc commands to 74hc595.
@@ -101,6 +102,7 @@ boolean Plugin_126(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].SendDataOption = true;
       Device[deviceCount].TimerOption    = true;
       Device[deviceCount].TimerOptional  = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(WRITE);
 
       break;
     }
@@ -172,6 +174,9 @@ boolean Plugin_126(uint8_t function, struct EventStruct *event, String& string)
 
       addFormCheckBox(F("Restore Values on warm boot"), F("valrestore"), P126_CONFIG_FLAGS_GET_VALUES_RESTORE);
 
+      addFormCheckBox(F("Use hardware SPI"), F("hwspi"), P126_CONFIG_FLAGS_GET_USE_HW_SPI == 1, !Settings.isSPI_valid());
+      addFormNote(F("Connect MOSI to DS and CLK to SH_CP, Data and Clock pin are then not used. SPI must be enabled on the Hardware page."));
+
       success = true;
       break;
     }
@@ -201,6 +206,8 @@ boolean Plugin_126(uint8_t function, struct EventStruct *event, String& string)
       # endif // ifdef P126_SHOW_VALUES
 
       if (!isFormItemChecked(F("valrestore"))) { bitSet(lSettings, P126_FLAGS_VALUES_RESTORE); } // Inverted setting!
+
+      if (isFormItemChecked(F("hwspi"))) { bitSet(lSettings, P126_FLAGS_USE_HW_SPI); }
       set4BitToUL(lSettings, P126_FLAGS_OUTPUT_SELECTION, getFormItemInt(F("output")));
 
       P126_CONFIG_FLAGS = lSettings;
@@ -224,7 +231,9 @@ boolean Plugin_126(uint8_t function, struct EventStruct *event, String& string)
       initPluginTaskData(event->TaskIndex, new (std::nothrow) P126_data_struct(P126_CONFIG_DATA_PIN,
                                                                                P126_CONFIG_CLOCK_PIN,
                                                                                P126_CONFIG_LATCH_PIN,
-                                                                               P126_CONFIG_CHIP_COUNT));
+                                                                               P126_CONFIG_CHIP_COUNT,
+                                                                               P126_CONFIG_FLAGS_GET_USE_HW_SPI &&
+                                                                               Settings.isSPI_valid()));
       P126_data_struct *P126_data = static_cast<P126_data_struct *>(getPluginTaskData(event->TaskIndex));
 
       if ((nullptr != P126_data) && P126_data->isInitialized()) {
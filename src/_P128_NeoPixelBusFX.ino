@@ -7,6 +7,9 @@
 // #######################################################################################################
 
 // Changelog:
+// 2026-10-15, tonhuisman Effects use 8 bit integer math instead of float per pixel, Fire flicker only processes the configured pixels,
+//                        frames are skipped when a frame takes longer than 20 msec.
+//                        Add compile-time option P128_USES_DMA to use the I2S DMA method on ESP8266 (GPIO3)
 // 2023-08-09, tonhuisman Update NeoPixelBus library to latest (2.7.6).
 //                        Keep reverted code for ESP8266 AND ESP32, so using deprecated NeoPixelBrightnessBus class,
 //                        with deprecation message disabled (unfortunately we'll have to keep dat updated manually)
@@ -166,6 +169,8 @@ boolean Plugin_128(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOptional      = true;
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].DecimalsOnly       = false;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(FIFTY_PER_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(WRITE);
       break;
     }
 
@@ -199,7 +204,11 @@ boolean Plugin_128(uint8_t function, struct EventStruct *event, String& string)
 
       addRowLabel(formatGpioName_output(F("Stripe data")));
       # ifdef ESP8266
+      #  ifdef P128_USES_DMA
+      addHtml(F("<span style=\"color:red\">Please connect stripe to GPIO3 (RX)!</span>"));
+      #  else // ifdef P128_USES_DMA
       addHtml(F("<span style=\"color:red\">Please connect stripe to GPIO2!</span>"));
+      #  endif // ifdef P128_USES_DMA
       # endif // ifdef ESP8266
       # ifdef ESP32
       addPinSelect(PinSelectPurpose::Generic_output, F("taskdevicepin1"), PIN(0));
@@ -7,6 +7,8 @@
 // #######################################################################################################
 
 /** Changelog:
+ * 2026-10-15 Option to use hardware SPI (MISO <- Q7, SCK -> CP) to read the whole chain in a single transfer.
+ *            Only check for events when any input changed.
  * 2023-01-04 tonhuisman: Use DIRECT_pin GPIO functions for faster GPIO handling (mostly on ESP32), string optimization
  * 2022-08-05 tonhuisman: Fix issue with reading 8th bit of each byte (found during HW testing)
  *                        Reduce number of Values to match the selected number of chips/4. Small UI improvements.
@@ -87,6 +89,9 @@ boolean Plugin_129(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].SendDataOption = true; // No use in sending the Values to a controller
       Device[deviceCount].TimerOption    = true; // Used to update the Devices page
       Device[deviceCount].TimerOptional  = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(FIFTY_PER_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(WRITE);
 
       break;
     }
@@ -153,7 +158,7 @@ boolean Plugin_129(uint8_t function, struct EventStruct *event, String& string)
                        F("load_pin"),
                        P129_CONFIG_LOAD_PIN);
       # ifndef LIMIT_BUILD_SIZE
-      addFormNote(F("GPIO pins for Data, Clock and Load <B>must</B> be configured to correctly initialize the plugin."));
+      addFormNote(F("GPIO pins for Data, Clock (unless using hardware SPI) and Load <B>must</B> be configured to correctly initialize the plugin."));
       # endif // ifndef LIMIT_BUILD_SIZE
 
       addFormSubHeader(F("Device configuration"));
@@ -200,6 +205,11 @@ boolean Plugin_129(uint8_t function, struct EventStruct *event, String& string)
 
       addFormCheckBox(F("Separate events per pin"), F("separate_events"), P129_CONFIG_FLAGS_GET_SEPARATE_EVENTS == 1);
 
+      addFormCheckBox(F("Use hardware SPI"), F("hwspi"), P129_CONFIG_FLAGS_GET_USE_HW_SPI == 1, !Settings.isSPI_valid());
+      # ifndef LIMIT_BUILD_SIZE
+      addFormNote(F("Connect MISO to Q7 and CLK to CP, Data and Clock pin are then not used. SPI must be enabled on the Hardware page."));
+      # endif // ifndef LIMIT_BUILD_SIZE
+
       addFormSubHeader(F("Event configuration"));
 
       {
@@ -279,6 +289,8 @@ boolean Plugin_129(uint8_t function, struct EventStruct *event, String& string)
       # endif // ifdef P129_SHOW_VALUES
 
       if (getFormItemInt(F("frequency"))) { bitSet(lSettings, P129_FLAGS_READ_FREQUENCY); }
+
+      if (isFormItemChecked(F("hwspi"))) { bitSet(lSettings, P129_FLAGS_USE_HW_SPI); }
       set4BitToUL(lSettings, P129_FLAGS_OUTPUT_SELECTION, getFormItemInt(F("outputsel")));
 
       P129_CONFIG_FLAGS = lSettings & 0xFFFF;
@@ -321,7 +333,9 @@ boolean Plugin_129(uint8_t function, struct EventStruct *event, String& string)
                                                                                P129_CONFIG_CLOCK_PIN,
                                                                                P129_CONFIG_ENABLE_PIN,
                                                                                P129_CONFIG_LOAD_PIN,
-                                                                               P129_CONFIG_CHIP_COUNT));
+                                                                               P129_CONFIG_CHIP_COUNT,
+                                                                               P129_CONFIG_FLAGS_GET_USE_HW_SPI &&
+                                                                               Settings.isSPI_valid()));
       P129_data_struct *P129_data = static_cast<P129_data_struct *>(getPluginTaskData(event->TaskIndex));
 
       if ((nullptr != P129_data) && P129_data->isInitialized()) {
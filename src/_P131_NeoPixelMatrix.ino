@@ -7,6 +7,8 @@
 // #######################################################################################################
 
 /** Changelog:
+ * 2026-10-15 tonhuisman: Compose each frame in the matrix buffer and show() it at most once per 20 msec, from PLUGIN_FIFTY_PER_SECOND,
+ *                        instead of after each command or scrolled line. Lines that scroll at the same time are drawn once.
  * 2023-02-27 tonhuisman: Implement support for getting config values, see AdafruitGFX_Helper.h changelog for details
  * 2022-07-30 tonhuisman: Add commands to set scroll-options (settext, setscroll, setstep, setspeed, setempty, setright)
  *                        Fix issue that on startup the display wasn't cleared (unit reset should turn off the display)
@@ -51,6 +53,9 @@ boolean Plugin_131(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].SendDataOption     = false;
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].TimerOptional      = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(FIFTY_PER_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(WRITE);
 
       break;
     }
@@ -434,6 +439,17 @@ boolean Plugin_131(uint8_t function, struct EventStruct *event, String& string)
       break;
     }
 
+    case PLUGIN_FIFTY_PER_SECOND:
+    {
+      P131_data_struct *P131_data = static_cast<P131_data_struct *>(getPluginTaskData(event->TaskIndex));
+
+      if (nullptr != P131_data) {
+        success = P131_data->plugin_fifty_per_second(event); // 50 per second operation, show the frame if it was changed
+      }
+
+      break;
+    }
+
     # if ADAGFX_ENABLE_GET_CONFIG_VALUE
     case PLUGIN_GET_CONFIG_VALUE:
     {
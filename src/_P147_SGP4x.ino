@@ -6,6 +6,8 @@
 // #######################################################################################################
 
 /** Changelog:
+ * 2026-10-15 Sample on a strict 1 sec. interval timer instead of PLUGIN_ONCE_A_SECOND, as expected by the gas index algorithm
+ *            Optionally keep the VOC algorithm state in RTC memory, to skip the learning period after a reboot
  * 2023-05-07 tonhuisman: Make Temperature and Humidity compensation selection independent, so if either setting is configured
  *                        it will still be applied, with the other value using the default. Minor UI improvement.
  * 2023-05-02 tonhuisman: Fix Low-power measurement, introducing a new State for reading the second measurement only
@@ -62,6 +64,7 @@ boolean Plugin_147(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].PluginStats        = true;
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(WRITE);
 
       break;
     }
@@ -153,6 +156,9 @@ boolean Plugin_147(uint8_t function, struct EventStruct *event, String& string)
 
       # if P147_FEATURE_GASINDEXALGORITHM
       addFormCheckBox(F("Show raw data only"), F("raw"), P147_GET_RAW_DATA_ONLY);
+
+      addFormCheckBox(F("Keep VOC algorithm state"), F("keep"), P147_GET_KEEP_VOC_STATE);
+      addFormNote(F("Resume the VOC index after a reboot without learning period. Only after 3 hours of operation, not after power loss."));
       # endif // if P147_FEATURE_GASINDEXALGORITHM
 
       success = true;
@@ -167,6 +173,7 @@ boolean Plugin_147(uint8_t function, struct EventStruct *event, String& string)
       P147_SET_USE_COMPENSATION(getFormItemInt(F("comp")));
       # if P147_FEATURE_GASINDEXALGORITHM
       P147_SET_RAW_DATA_ONLY(isFormItemChecked(F("raw")));
+      P147_SET_KEEP_VOC_STATE(isFormItemChecked(F("keep")));
       # endif // if P147_FEATURE_GASINDEXALGORITHM
 
       if (P147_GET_USE_COMPENSATION) {
@@ -205,17 +212,6 @@ boolean Plugin_147(uint8_t function, struct EventStruct *event, String& string)
       break;
     }
 
-    case PLUGIN_ONCE_A_SECOND:
-    {
-      P147_data_struct *P147_data = static_cast<P147_data_struct *>(getPluginTaskData(event->TaskIndex));
-
-      if (nullptr != P147_data) {
-        success = P147_data->plugin_once_a_second(event);
-      }
-
-      break;
-    }
-
     case PLUGIN_READ:
     {
       P147_data_struct *P147_data = static_cast<P147_data_struct *>(getPluginTaskData(event->TaskIndex));
@@ -36,6 +36,13 @@ void clearPluginTaskData(taskIndex_t taskIndex) {
       delete Plugin_task_data[taskIndex];
       Plugin_task_data[taskIndex] = nullptr;
     }
+    #if FEATURE_PLUGIN_TASKDATA_ARENA
+
+    if (!Settings.TaskDeviceEnabled[taskIndex]) {
+      // No re-init expected, so release the memory kept for this task
+      freePluginTaskDataArena(taskIndex);
+    }
+    #endif // if FEATURE_PLUGIN_TASKDATA_ARENA
   }
 }
 
@@ -43,7 +43,9 @@
 #include "src/Helpers/StringGenerator_Plugin.h"
 #include "src/Helpers/StringParser.h"
 #include "src/Helpers/_Plugin_SensorTypeHelper.h"
+#include "src/Helpers/_Plugin_Helper_data_ready.h"
 #include "src/Helpers/_Plugin_Helper_serial.h"
+#include "src/Helpers/_Plugin_Helper_two_phase_read.h"
 
 #if FEATURE_PLUGIN_STATS
 #include "src/PluginStructs/_StatsOnly_data_struct.h"
@@ -114,6 +114,12 @@ boolean Plugin_xxx(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = false;                            // Allow to set the "Interval" timer for the plugin.
       Device[deviceCount].TimerOptional      = false;                            // When taskdevice timer is not set and not optional, use default "Interval" delay (Settings.Delay)
       Device[deviceCount].DecimalsOnly       = true;                             // Allow to set the number of decimals (otherwise treated a 0 decimals)
+      // Broadcast plugin calls handled by this plugin, other broadcast calls are not made to its tasks.
+      // Must list each of PLUGIN_ONCE_A_SECOND, PLUGIN_TEN_PER_SECOND, PLUGIN_FIFTY_PER_SECOND, PLUGIN_WRITE,
+      // PLUGIN_SERIAL_IN, PLUGIN_UDP_IN, PLUGIN_CLOCK_IN and PLUGIN_TIME_CHANGE handled in the switch below.
+      Device[deviceCount].PluginCallSubscriptions = PLUGIN_CALL_SUBSCRIBE(ONCE_A_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(TEN_PER_SECOND) |
+                                                    PLUGIN_CALL_SUBSCRIBE(WRITE);
       break;
     }
 
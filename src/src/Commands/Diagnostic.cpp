@@ -18,11 +18,13 @@
 #include "../Globals/Settings.h"
 #include "../Globals/Statistics.h"
 
+#include "../Helpers/Benchmark.h"
 #include "../Helpers/Convert.h"
 #include "../Helpers/ESPEasy_Storage.h"
 #include "../Helpers/ESPEasy_time_calc.h"
 #include "../Helpers/Misc.h"
 #include "../Helpers/_Plugin_init.h"
+#include "../Helpers/Numerical.h"
 #include "../Helpers/PortStatus.h"
 #include "../Helpers/StringConverter.h"
 #include "../Helpers/StringParser.h"
@@ -136,6 +138,40 @@ const __FlashStringHelper * Command_Background(struct EventStruct *event, const
   serialPrintln(F("end"));
   return return_see_serial(event);
 }
+
+#if FEATURE_BENCHMARK
+String Command_Benchmark(struct EventStruct *event, const char *Line)
+{
+  // Benchmark,<suite>[,<iterations>][,<I2C address>]
+  // Benchmark,events[,<passes>][,<event file>]
+  const String suite = parseString(Line, 2);
+  int iterations     = parseCommandArgumentInt(Line, 2);
+
+  if (iterations < 0) { iterations = 0; }
+
+  int i2cAddress = -1;
+  String eventFile;
+  const String i2cAddressStr = parseString(Line, 4);
+
+  if (equals(suite, F("events"))) {
+    eventFile = parseStringKeepCase(Line, 4);
+  } else if (!i2cAddressStr.isEmpty()) {
+    int address{};
+
+    if (!validIntFromString(i2cAddressStr, address) || (address < 0) || (address > 0x7F)) {
+      return return_result(event, concat(F("Invalid I2C address: "), i2cAddressStr));
+    }
+    i2cAddress = address;
+  }
+
+  String result;
+
+  if (!Benchmark_run(suite, iterations, i2cAddress, eventFile, result)) {
+    return return_result(event, concat(F("Unknown suite, use: "), Benchmark_getSuites()));
+  }
+  return return_result(event, result);
+}
+#endif // if FEATURE_BENCHMARK
 #endif // BUILD_NO_DIAGNOSTIC_COMMANDS
 
 const __FlashStringHelper * Command_Debug(struct EventStruct *event, const char *Line)
@@ -172,7 +208,7 @@ const __FlashStringHelper * Command_JSONPortStatus(struct EventStruct *event, co
   return return_command_success_flashstr();
 }
 
-void createLogPortStatus(std::map<uint32_t, portStatusStruct>::iterator it)
+void createLogPortStatus(MapPortStatus::iterator it)
 {  
   if (loglevelActiveFor(LOG_LEVEL_INFO)) {
     String log;
@@ -198,7 +234,7 @@ void createLogPortStatus(std::map<uint32_t, portStatusStruct>::iterator it)
   }
 }
 
-void debugPortStatus(std::map<uint32_t, portStatusStruct>::iterator it)
+void debugPortStatus(MapPortStatus::iterator it)
 {
   createLogPortStatus(it);
 }
@@ -210,7 +246,7 @@ const __FlashStringHelper * Command_logPortStatus(struct EventStruct *event, con
     addLogMove(LOG_LEVEL_INFO, concat(F("PortStatus structure: Called from=Rules Count="), static_cast<int>(globalMapPortStatus.size())));
   }
 
-  for (std::map<uint32_t, portStatusStruct>::iterator it = globalMapPortStatus.begin(); it != globalMapPortStatus.end(); ++it) {
+  for (auto it = globalMapPortStatus.begin(); it != globalMapPortStatus.end(); ++it) {
     debugPortStatus(it);
   }
 
@@ -17,13 +17,16 @@ const __FlashStringHelper * Command_SerialFloat(struct EventStruct *event, const
 const __FlashStringHelper * Command_MemInfo(struct EventStruct *event, const char* Line);
 const __FlashStringHelper * Command_MemInfo_detail(struct EventStruct *event, const char* Line);
 const __FlashStringHelper * Command_Background(struct EventStruct *event, const char* Line);
+#if FEATURE_BENCHMARK
+String Command_Benchmark(struct EventStruct *event, const char* Line);
+#endif
 #endif
 const __FlashStringHelper * Command_Debug(struct EventStruct *event, const char* Line);
 const __FlashStringHelper * Command_logentry(struct EventStruct *event, const char* Line);
 #ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
 const __FlashStringHelper * Command_JSONPortStatus(struct EventStruct *event, const char* Line);
-//void createLogPortStatus(std::map< uint32_t, portStatusStruct >::iterator it);
-//void debugPortStatus(std::map< uint32_t, portStatusStruct >::iterator it);
+//void createLogPortStatus(MapPortStatus::iterator it);
+//void debugPortStatus(MapPortStatus::iterator it);
 const __FlashStringHelper * Command_logPortStatus(struct EventStruct *event, const char* Line);
 #endif
 
@@ -18,6 +18,8 @@
 #include "../Helpers/PortStatus.h"
 #include "../Helpers/Numerical.h"
 
+#include <GPIO_Direct_Access.h>
+
 #if FEATURE_GPIO_USE_ESP8266_WAVEFORM
 # include <core_esp8266_waveform.h>
 #endif 
@@ -39,6 +41,7 @@ bool mcpgpio_range_pattern_helper(struct EventStruct *event, const char* Line, b
 #ifdef USES_P019
 bool pcfgpio_range_pattern_helper(struct EventStruct *event, const char* Line, bool isWritePattern);
 #endif
+bool gpio_range_pattern_helper(struct EventStruct *event, const char* Line, bool isWritePattern);
 bool gpio_mode_range_helper(uint8_t pin, uint8_t pinMode, struct EventStruct *event, const char* Line);
 #ifdef USES_P019
 uint8_t getPcfAddress(uint8_t pin);
@@ -355,6 +358,55 @@ const __FlashStringHelper * Command_GPIO_PWM(struct EventStruct *event, const ch
   return return_command_failed_flashstr();
 }
 
+const __FlashStringHelper * Command_GPIO_PWM_Group(struct EventStruct *event, const char *Line)
+{
+  // pwmgroup,<fade duration>,<GPIO>,<duty>[,<GPIO>,<duty>,...]
+  // All pins are started at the same time.
+  int      gpios[GPIO_PWM_GROUP_MAX];
+  uint32_t dutyCycles[GPIO_PWM_GROUP_MAX];
+  uint8_t  nrPins = 0;
+  int      fadeDuration_ms = 0;
+
+  if (!validIntFromString(parseString(Line, 2), fadeDuration_ms) || (fadeDuration_ms < 0)) {
+    return return_command_failed_flashstr();
+  }
+
+  for (uint8_t arg = 3; ; arg += 2) {
+    const String gpio_str = parseString(Line, arg);
+
+    if (gpio_str.isEmpty()) {
+      break;
+    }
+    int gpio = -1;
+    int duty = -1;
+
+    if ((nrPins >= GPIO_PWM_GROUP_MAX) ||
+        !validIntFromString(gpio_str, gpio) ||
+        !validIntFromString(parseString(Line, arg + 1), duty) ||
+        (duty < 0) || (duty > 1023)) {
+      return return_command_failed_flashstr();
+    }
+    gpios[nrPins]      = gpio;
+    dutyCycles[nrPins] = duty;
+    ++nrPins;
+  }
+
+  if (!set_Gpio_PWM_group(gpios, dutyCycles, nrPins, fadeDuration_ms)) {
+    logErrorGpioOutOfRange(F("GPIO"), nrPins > 0 ? gpios[0] : -1, Line);
+    return return_command_failed_flashstr();
+  }
+
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    String log = strformat(F("PWM  : group of %d GPIO"), nrPins);
+
+    if (fadeDuration_ms != 0) {
+      log += strformat(F(" Fade: %d ms"), fadeDuration_ms);
+    }
+    addLogMove(LOG_LEVEL_INFO, log);
+  }
+  return return_command_success_flashstr();
+}
+
 const __FlashStringHelper * Command_GPIO_Tone(struct EventStruct *event, const char *Line)
 {
   // play a tone on pin par1, with frequency par2 and duration in msec par3.
@@ -863,6 +915,127 @@ const __FlashStringHelper * Command_GPIO_PcfGPIORange(struct EventStruct *event,
 }
 #endif
 
+/******************************************************************************
+** Internal GPIO version of mcpgpioRange / mcpgpioPattern
+** Par1=starting pin
+** Par2=ending pin (must be higher of starting pin; and maximum 32 pin per command)
+** Par3=gpioRange: write value 0 or 1 for all the pins in the range
+**      gpioPattern: write pattern, bit 0 is the starting pin
+** Par4=mask (optional): if present is used as a mask (1=update, 0=do not update).
+**
+** Pins in the range which cannot be used as output are skipped.
+** All pins are written at once, using a single register write.
+**
+**  examples:
+**  gpioRange,12,15,1: set GPIO 12 to 15 to 1
+**  gpioPattern,12,15,5: set GPIO 12 and 14 to 1, GPIO 13 and 15 to 0
+**  gpioPattern,12,15,5,3: set GPIO 12 to 1 and GPIO 13 to 0
+******************************************************************************/
+const __FlashStringHelper * Command_GPIO_GPIORange(struct EventStruct *event, const char *Line)
+{
+  return return_command_boolean_result_flashstr(gpio_range_pattern_helper(event, Line, false));
+}
+
+const __FlashStringHelper * Command_GPIO_GPIOPattern(struct EventStruct *event, const char *Line)
+{
+  return return_command_boolean_result_flashstr(gpio_range_pattern_helper(event, Line, true));
+}
+
+bool gpio_range_pattern_helper(struct EventStruct *event, const char *Line, bool isWritePattern)
+{
+  const __FlashStringHelper *logPrefix = isWritePattern ? F("GPIOPattern") : F("GPIORange");
+  const int firstPin                   = event->Par1;
+  const int lastPin                    = event->Par2;
+
+  if ((lastPin < firstPin) ||
+      !checkValidPortRange(PLUGIN_GPIO, firstPin) ||
+      !checkValidPortRange(PLUGIN_GPIO, lastPin) ||
+      ((lastPin - firstPin + 1) > 32)) {
+    if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+      addLog(LOG_LEVEL_ERROR, concat(logPrefix, F(": pin numbers out of range.")));
+    }
+    return false;
+  }
+  const uint8_t  numBits = lastPin - firstPin + 1;
+  const uint32_t allBits = (numBits == 32) ? 0xFFFFFFFF : ((1u << numBits) - 1);
+  uint32_t mask          = allBits;
+  uint32_t write         = 0;
+
+  if (!parseString(Line, 5).isEmpty()) {
+    mask &= static_cast<uint32_t>(event->Par4);
+  }
+
+  if (isWritePattern) {
+    write = static_cast<uint32_t>(event->Par3) & allBits;
+  } else if (event->Par3 == 1) {
+    write = allBits;
+  } else if (event->Par3 != 0) {
+    if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+      addLog(LOG_LEVEL_ERROR, concat(logPrefix, F(": write value must be 0 or 1.")));
+    }
+    return false;
+  }
+
+  uint64_t setMask   = 0;
+  uint64_t clearMask = 0;
+
+  for (uint8_t i = 0; i < numBits; ++i) {
+    if (!(mask & (1u << i))) { continue; }
+    const int pin = firstPin + i;
+    int  pinnr    = -1;
+    bool input    = false;
+    bool output   = false;
+    bool warning  = false;
+
+    if (!checkValidPortRange(PLUGIN_GPIO, pin) ||
+        !getGpioInfo(pin, pinnr, input, output, warning) ||
+        !output) {
+      mask &= ~(1u << i);
+      continue;
+    }
+    const bool state = write & (1u << i);
+    Scheduler.clearGPIOTimer(PLUGIN_GPIO, pin);
+
+    auto it = globalMapPortStatus.find(createKey(PLUGIN_GPIO, pin));
+
+    if ((it == globalMapPortStatus.end()) || (it->second.mode != PIN_MODE_OUTPUT)) {
+      // Pin not yet used as output, this also stops a running PWM on this pin.
+      pinMode(pin, OUTPUT);
+      digitalWrite(pin, state);
+    }
+
+    if (state) {
+      setMask |= (1ull << pin);
+    } else {
+      clearMask |= (1ull << pin);
+    }
+  }
+
+  if (mask == 0) {
+    logErrorGpioNotOutput(logPrefix, firstPin);
+    return false;
+  }
+
+  DIRECT_portWrite(setMask, clearMask);
+
+  // Update the port status only after all pins have been written
+  for (uint8_t i = 0; i < numBits; ++i) {
+    if (mask & (1u << i)) {
+      createAndSetPortStatus_Mode_State(createKey(PLUGIN_GPIO, firstPin + i), PIN_MODE_OUTPUT, (write >> i) & 1);
+    }
+  }
+
+  const uint32_t key      = createKey(PLUGIN_GPIO, firstPin);
+  const uint32_t readBack = static_cast<uint32_t>(DIRECT_portRead() >> firstPin) & allBits;
+  const String   log      = concat(
+    logPrefix,
+    strformat(F(": GPIO %d-%d set to 0x%X mask: 0x%X read: 0x%X"), firstPin, lastPin, write & mask, mask, readBack));
+
+  addLog(LOG_LEVEL_INFO, log);
+  SendStatusOnlyIfNeeded(event, SEARCH_PIN_STATE, key, log, 0);
+  return true;
+}
+
 #ifdef USES_P009
 // FIXME TD-er: Function is nearly identical to pcfgpio_range_pattern_helper
 bool mcpgpio_range_pattern_helper(struct EventStruct *event, const char *Line, bool isWritePattern)
@@ -12,6 +12,7 @@ void createAndSetPortStatus_Mode_State(uint32_t key, uint8_t newMode, int8_t new
 const __FlashStringHelper * Command_GPIO(struct EventStruct *event, const char* Line);
 const __FlashStringHelper * Command_GPIO_Toggle(struct EventStruct *event, const char* Line);
 const __FlashStringHelper * Command_GPIO_PWM(struct EventStruct *event, const char* Line);
+const __FlashStringHelper * Command_GPIO_PWM_Group(struct EventStruct *event, const char* Line);
 const __FlashStringHelper * Command_GPIO_Tone(struct EventStruct *event, const char* Line);
 const __FlashStringHelper * Command_GPIO_RTTTL(struct EventStruct *event, const char* Line);
 const __FlashStringHelper * Command_GPIO_Pulse(struct EventStruct *event, const char* Line);
@@ -21,6 +22,9 @@ const __FlashStringHelper * Command_GPIO_Monitor(struct EventStruct *event, cons
 const __FlashStringHelper * Command_GPIO_UnMonitor(struct EventStruct *event, const char* Line);
 const __FlashStringHelper * Command_GPIO_Status(struct EventStruct *event, const char* Line);
 
+const __FlashStringHelper * Command_GPIO_GPIORange(struct EventStruct *event, const char* Line);
+const __FlashStringHelper * Command_GPIO_GPIOPattern(struct EventStruct *event, const char* Line);
+
 #ifdef USES_P009
 const __FlashStringHelper * Command_GPIO_McpGPIORange(struct EventStruct *event, const char* Line);
 const __FlashStringHelper * Command_GPIO_McpGPIOPattern(struct EventStruct *event, const char* Line);
@@ -4,6 +4,7 @@
 
 #include "../../_Plugin_Helper.h"
 #include "../Globals/Settings.h"
+#include "../Helpers/StringProvider.h"
 
 #if FEATURE_BLYNK
 # include "../Commands/Blynk.h"
@@ -39,6 +40,7 @@
 #include "../Commands/wd.h"
 #include "../Commands/WiFi.h"
 
+#include "../DataStructs/CommandArguments.h"
 #include "../DataStructs/TimingStats.h"
 
 #include "../ESPEasyCore/ESPEasy_Log.h"
@@ -128,415 +130,342 @@ bool checkSourceFlags(EventValueSource::Enum source, EventValueSourceGroup::Enum
   return false;
 }
 
-command_case_data::command_case_data(const char *cmd, struct EventStruct *event, const char *line) :
+command_case_data::command_case_data(const char *cmd, struct EventStruct *event, const String& line) :
   cmd(cmd), event(event), line(line)
-{
-  cmd_lc = cmd;
-  cmd_lc.toLowerCase();
-}
+{}
 
 
-// Wrapper to reduce generated code by macro
-bool do_command_case_all(command_case_data         & data,
-                         const __FlashStringHelper * cmd_test,
-                         command_function_fs         pFunc,
-                         int                         nrArguments)
+// Call a command function with either signature via a single handler type.
+template<typename T, T pFunc>
+struct command_adapter {
+  static void call(command_case_data& data) {
+    // FIXME TD-er: Must change command function signature to use const String&
+    data.status = pFunc(data.event, data.line.c_str());
+  }
+};
+
+typedef void (*command_handler)(command_case_data& data);
+
+struct command_table_entry {
+  command_handler             handler;
+  char                        name[26]; // Lower case
+  int8_t                      nrArguments;
+  EventValueSourceGroup::Enum group;
+};
+
+// EventValueSourceGroup::Enum::ALL
+#define COMMAND_CASE_A(S, C, NARGS) \
+  { &command_adapter<decltype(&C), &C>::call, S, NARGS, EventValueSourceGroup::Enum::ALL },
+
+// EventValueSourceGroup::Enum::RESTRICTED
+#define COMMAND_CASE_R(S, C, NARGS) \
+  { &command_adapter<decltype(&C), &C>::call, S, NARGS, EventValueSourceGroup::Enum::RESTRICTED },
+
+// All internal commands, looked up using a binary search.
+// N.B. Must be kept sorted on the command name.
+// FIXME TD-er: must determine nr arguments where NARGS is set to -1
+static const command_table_entry internal_commands[] PROGMEM = {
+  COMMAND_CASE_A(            "accessinfo", Command_AccessInfo_Ls,               0) // Network Command
+  COMMAND_CASE_A(            "asyncevent", Command_Rules_Async_Events,         -1) // Rule.h
+#ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
+  COMMAND_CASE_R(            "background", Command_Background,                  1) // Diagnostic.h
+#if FEATURE_BENCHMARK
+  COMMAND_CASE_A(             "benchmark", Command_Benchmark,                  -1) // Diagnostic.h
+#endif // if FEATURE_BENCHMARK
+#endif // ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
+#ifdef USES_C012
+  COMMAND_CASE_A(              "blynkget", Command_Blynk_Get,                  -1)
+#endif // ifdef USES_C012
+#ifdef USES_C015
+  COMMAND_CASE_R(              "blynkset", Command_Blynk_Set,                  -1)
+#endif // ifdef USES_C015
+  COMMAND_CASE_A(                 "build", Command_Settings_Build,              1) // Settings.h
+  COMMAND_CASE_R(      "clearaccessblock", Command_AccessInfo_Clear,            0) // Network Command
+  COMMAND_CASE_R(         "clearpassword", Command_Settings_Password_Clear,     1) // Settings.h
+  COMMAND_CASE_R(           "clearrtcram", Command_RTC_Clear,                   0) // RTC.h
+#ifdef ESP8266
+  COMMAND_CASE_R(          "clearsdkwifi", Command_System_Erase_SDK_WiFiconfig, 0) // System.h
+  COMMAND_CASE_R(        "clearwifirfcal", Command_System_Erase_RFcal,          0) // System.h
+#endif // ifdef ESP8266
+  COMMAND_CASE_R(                "config", Command_Task_RemoteConfig,          -1) // Tasks.h
+  COMMAND_CASE_R(     "controllerdisable", Command_Controller_Disable,          1) // Controller.h
+  COMMAND_CASE_R(      "controllerenable", Command_Controller_Enable,           1) // Controller.h
+  COMMAND_CASE_R(              "datetime", Command_DateTime,                    2) // Time.h
+  COMMAND_CASE_R(                 "debug", Command_Debug,                       1) // Diagnostic.h
+  COMMAND_CASE_A(                   "dec", Command_Rules_Dec,                  -1) // Rules.h
+  COMMAND_CASE_R(             "deepsleep", Command_System_deepSleep,            1) // System.h
+#if FEATURE_DEEP_SLEEP_BATCH
+  COMMAND_CASE_R(         "deepsleepsend", Command_System_deepSleepSend,        0) // System.h
+#endif // if FEATURE_DEEP_SLEEP_BATCH
+  COMMAND_CASE_R(                 "delay", Command_Delay,                       1) // Timers.h
+#if FEATURE_PLUGIN_PRIORITY
+  COMMAND_CASE_R(   "disableprioritytask", Command_PriorityTask_Disable,        1) // Tasks.h
+#endif // if FEATURE_PLUGIN_PRIORITY
+  COMMAND_CASE_R(                   "dns", Command_DNS,                         1) // Network Command
+  COMMAND_CASE_R(                   "dst", Command_DST,                         1) // Time.h
+  COMMAND_CASE_R(          "erasesdkwifi", Command_WiFi_Erase,                  0) // WiFi.h
+#if FEATURE_ETHERNET
+  COMMAND_CASE_R(          "ethclockmode", Command_ETH_Clock_Mode,              1) // Network Command
+  COMMAND_CASE_A(         "ethdisconnect", Command_ETH_Disconnect,              0) // Network Command
+  COMMAND_CASE_R(                "ethdns", Command_ETH_DNS,                     1) // Network Command
+  COMMAND_CASE_R(            "ethgateway", Command_ETH_Gateway,                 1) // Network Command
+  COMMAND_CASE_R(                 "ethip", Command_ETH_IP,                      1) // Network Command
+  COMMAND_CASE_R(             "ethphyadr", Command_ETH_Phy_Addr,                1) // Network Command
+  COMMAND_CASE_R(            "ethphytype", Command_ETH_Phy_Type,                1) // Network Command
+  COMMAND_CASE_R(             "ethpinmdc", Command_ETH_Pin_mdc,                 1) // Network Command
+  COMMAND_CASE_R(            "ethpinmdio", Command_ETH_Pin_mdio,                1) // Network Command
+  COMMAND_CASE_R(           "ethpinpower", Command_ETH_Pin_power,               1) // Network Command
+  COMMAND_CASE_R(             "ethsubnet", Command_ETH_Subnet,                  1) // Network Command
+  COMMAND_CASE_R(           "ethwifimode", Command_ETH_Wifi_Mode,               1) // Network Command
+#endif // if FEATURE_ETHERNET
+  COMMAND_CASE_A(                 "event", Command_Rules_Events,               -1) // Rule.h
+  COMMAND_CASE_A(          "executerules", Command_Rules_Execute,              -1) // Rule.h
+  COMMAND_CASE_R(               "gateway", Command_Gateway,                     1) // Network Command
+  COMMAND_CASE_A(                  "gpio", Command_GPIO,                        2) // Gpio.h
+  COMMAND_CASE_A(           "gpiopattern", Command_GPIO_GPIOPattern,           -1) // Gpio.h
+  COMMAND_CASE_A(             "gpiorange", Command_GPIO_GPIORange,             -1) // Gpio.h
+  COMMAND_CASE_A(            "gpiotoggle", Command_GPIO_Toggle,                 1) // Gpio.h
+  COMMAND_CASE_R(            "hiddenssid", Command_Wifi_HiddenSSID,             1) // wifi.h
+  COMMAND_CASE_R(            "i2cscanner", Command_i2c_Scanner,                -1) // i2c.h
+  COMMAND_CASE_A(                   "inc", Command_Rules_Inc,                  -1) // Rules.h
+  COMMAND_CASE_R(                    "ip", Command_IP,                          1) // Network Command
+#ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
+  COMMAND_CASE_A(        "jsonportstatus", Command_JSONPortStatus,             -1) // Diagnostic.h
+#endif // ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
+  COMMAND_CASE_A(                   "let", Command_Rules_Let,                   2) // Rules.h
+  COMMAND_CASE_A(                  "load", Command_Settings_Load,               0) // Settings.h
+  COMMAND_CASE_A(              "logentry", Command_logentry,                   -1) // Diagnostic.h
+#ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
+  COMMAND_CASE_A(         "logportstatus", Command_logPortStatus,               0) // Diagnostic.h
+#endif // ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
+  COMMAND_CASE_A(             "longpulse", Command_GPIO_LongPulse,              5) // GPIO.h
+  COMMAND_CASE_A(          "longpulse_ms", Command_GPIO_LongPulse_Ms,           5) // GPIO.h
+  COMMAND_CASE_A(          "looptimerset", Command_Loop_Timer_Set,              3) // Timers.h
+  COMMAND_CASE_A(       "looptimerset_ms", Command_Loop_Timer_Set_ms,           3) // Timers.h
+#ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
+  COMMAND_CASE_A(                "lowmem", Command_Lowmem,                      0) // Diagnostic.h
+  COMMAND_CASE_A(                "malloc", Command_Malloc,                      1) // Diagnostic.h
+#endif // ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
+#ifdef USES_P009
+  COMMAND_CASE_A(               "mcpgpio", Command_GPIO,                        2) // Gpio.h
+  COMMAND_CASE_A(        "mcpgpiopattern", Command_GPIO_McpGPIOPattern,        -1) // Gpio.h
+  COMMAND_CASE_A(          "mcpgpiorange", Command_GPIO_McpGPIORange,          -1) // Gpio.h
+  COMMAND_CASE_A(         "mcpgpiotoggle", Command_GPIO_Toggle,                 1) // Gpio.h
+  COMMAND_CASE_A(          "mcplongpulse", Command_GPIO_LongPulse,              3) // GPIO.h
+  COMMAND_CASE_A(       "mcplongpulse_ms", Command_GPIO_LongPulse_Ms,           3) // GPIO.h
+  COMMAND_CASE_A(               "mcpmode", Command_GPIO_Mode,                   2) // Gpio.h
+  COMMAND_CASE_A(          "mcpmoderange", Command_GPIO_ModeRange,              3) // Gpio.h
+  COMMAND_CASE_A(              "mcppulse", Command_GPIO_Pulse,                  3) // GPIO.h
+#endif // ifdef USES_P009
+#ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
+  COMMAND_CASE_A(               "meminfo", Command_MemInfo,                     0) // Diagnostic.h
+  COMMAND_CASE_A(         "meminfodetail", Command_MemInfo_detail,              0) // Diagnostic.h
+#endif // ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
+  COMMAND_CASE_A(               "monitor", Command_GPIO_Monitor,                2) // GPIO.h
+  COMMAND_CASE_A(          "monitorrange", Command_GPIO_MonitorRange,           3) // GPIO.h
+  COMMAND_CASE_R(                  "name", Command_Settings_Name,               1) // Settings.h
+  COMMAND_CASE_R(               "nosleep", Command_System_NoSleep,              1) // System.h
+#if FEATURE_NOTIFIER
+  COMMAND_CASE_R(                "notify", Command_Notifications_Notify,        2) // Notifications.h
+#endif // if FEATURE_NOTIFIER
+  COMMAND_CASE_R(               "ntphost", Command_NTPHost,                     1) // Time.h
+  COMMAND_CASE_R(              "password", Command_Settings_Password,           1) // Settings.h
+#ifdef USES_P019
+  COMMAND_CASE_A(               "pcfgpio", Command_GPIO,                        2) // Gpio.h
+  COMMAND_CASE_A(        "pcfgpiopattern", Command_GPIO_PcfGPIOPattern,        -1) // Gpio.h
+  COMMAND_CASE_A(          "pcfgpiorange", Command_GPIO_PcfGPIORange,          -1) // Gpio.h
+  COMMAND_CASE_A(         "pcfgpiotoggle", Command_GPIO_Toggle,                 1) // Gpio.h
+  COMMAND_CASE_A(          "pcflongpulse", Command_GPIO_LongPulse,              3) // GPIO.h
+  COMMAND_CASE_A(       "pcflongpulse_ms", Command_GPIO_LongPulse_Ms,           3) // GPIO.h
+  COMMAND_CASE_A(               "pcfmode", Command_GPIO_Mode,                   2) // Gpio.h
+  COMMAND_CASE_A(          "pcfmoderange", Command_GPIO_ModeRange,              3) // Gpio.h
+  COMMAND_CASE_A(              "pcfpulse", Command_GPIO_Pulse,                  3) // GPIO.h
+#endif // ifdef USES_P019
+#if FEATURE_POST_TO_HTTP
+  COMMAND_CASE_A(            "posttohttp", Command_HTTP_PostToHTTP,            -1) // HTTP.h
+#endif // if FEATURE_POST_TO_HTTP
+#if FEATURE_CUSTOM_PROVISIONING
+  COMMAND_CASE_A(          "provisionall", Command_Provisioning_All,            0) // Provisioning.h
+  COMMAND_CASE_A(       "provisionconfig", Command_Provisioning_Config,         0) // Provisioning.h
+  COMMAND_CASE_A(     "provisionfirmware", Command_Provisioning_Firmware,       1) // Provisioning.h
+# if FEATURE_NOTIFIER
+  COMMAND_CASE_A( "provisionnotification", Command_Provisioning_Notification,   0) // Provisioning.h
+# endif // if FEATURE_NOTIFIER
+  COMMAND_CASE_A(    "provisionprovision", Command_Provisioning_Provision,      0) // Provisioning.h
+  COMMAND_CASE_A(        "provisionrules", Command_Provisioning_Rules,          1) // Provisioning.h
+  COMMAND_CASE_A(     "provisionsecurity", Command_Provisioning_Security,       0) // Provisioning.h
+#endif // if FEATURE_CUSTOM_PROVISIONING
+#if FEATURE_MQTT
+  COMMAND_CASE_A(               "publish", Command_MQTT_Publish,               -1) // MQTT.h
+  COMMAND_CASE_R(           "publishfile", Command_MQTT_PublishFile,            2) // MQTT.h
+#endif // if FEATURE_MQTT
+  COMMAND_CASE_A(                 "pulse", Command_GPIO_Pulse,                  3) // GPIO.h
+#if FEATURE_PUT_TO_HTTP
+  COMMAND_CASE_A(             "puttohttp", Command_HTTP_PutToHTTP,             -1) // HTTP.h
+#endif // if FEATURE_PUT_TO_HTTP
+  COMMAND_CASE_A(                   "pwm", Command_GPIO_PWM,                    4) // GPIO.h
+  COMMAND_CASE_A(              "pwmgroup", Command_GPIO_PWM_Group,             -1) // GPIO.h
+  COMMAND_CASE_A(                "reboot", Command_System_Reboot,               0) // System.h
+  COMMAND_CASE_R(                 "reset", Command_Settings_Reset,              0) // Settings.h
+  COMMAND_CASE_A("resetflashwritecounter", Command_RTC_resetFlashWriteCounter,  0) // RTC.h
+  COMMAND_CASE_A(               "restart", Command_System_Reboot,               0) // System.h
+  COMMAND_CASE_A(                 "rtttl", Command_GPIO_RTTTL,                 -1) // GPIO.h
+  COMMAND_CASE_A(                 "rules", Command_Rules_UseRules,              1) // Rule.h
+  COMMAND_CASE_R(                  "save", Command_Settings_Save,               0) // Settings.h
+  COMMAND_CASE_A(       "scheduletaskrun", Command_ScheduleTask_Run,            2) // Tasks.h
+#if FEATURE_SD
+  COMMAND_CASE_R(                "sdcard", Command_SD_LS,                       0) // SDCARDS.h
+  COMMAND_CASE_R(              "sdremove", Command_SD_Remove,                   1) // SDCARDS.h
+#endif // if FEATURE_SD
+#if FEATURE_ESPEASY_P2P
+
+  // FIXME TD-er: These send commands, can we determine the nr of arguments?
+  COMMAND_CASE_A(                "sendto", Command_UPD_SendTo,                  2) // UDP.h
+#endif // if FEATURE_ESPEASY_P2P
+#if FEATURE_SEND_TO_HTTP
+  COMMAND_CASE_A(            "sendtohttp", Command_HTTP_SendToHTTP,             3) // HTTP.h
+#endif // if FEATURE_SEND_TO_HTTP
+  COMMAND_CASE_A(             "sendtoudp", Command_UDP_SendToUPD,               3) // UDP.h
+#ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
+  COMMAND_CASE_R(           "serialfloat", Command_SerialFloat,                 0) // Diagnostic.h
+#endif // ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
+  COMMAND_CASE_A(                 "servo", Command_Servo,                       3) // Servo.h
+  COMMAND_CASE_R(              "settings", Command_Settings_Print,              0) // Settings.h
+  COMMAND_CASE_A(                "status", Command_GPIO_Status,                 2) // GPIO.h
+  COMMAND_CASE_R(                "subnet", Command_Subnet,                      1) // Network Command
+#if FEATURE_MQTT
+  COMMAND_CASE_A(             "subscribe", Command_MQTT_Subscribe,              1) // MQTT.h
+#endif // if FEATURE_MQTT
+#ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
+  COMMAND_CASE_A(               "sysload", Command_SysLoad,                     0) // Diagnostic.h
+#endif // ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
+  COMMAND_CASE_R(             "taskclear", Command_Task_Clear,                  1) // Tasks.h
+  COMMAND_CASE_R(          "taskclearall", Command_Task_ClearAll,               0) // Tasks.h
+  COMMAND_CASE_R(           "taskdisable", Command_Task_Disable,                1) // Tasks.h
+  COMMAND_CASE_R(            "taskenable", Command_Task_Enable,                 1) // Tasks.h
+  COMMAND_CASE_A(               "taskrun", Command_Task_Run,                    1) // Tasks.h
+  COMMAND_CASE_A(             "taskrunat", Command_Task_Run,                    2) // Tasks.h
+  COMMAND_CASE_A(          "taskvalueset", Command_Task_ValueSet,               3) // Tasks.h
+  COMMAND_CASE_A(    "taskvaluesetandrun", Command_Task_ValueSetAndRun,         3) // Tasks.h
+  COMMAND_CASE_A(       "taskvaluetoggle", Command_Task_ValueToggle,            2) // Tasks.h
+  COMMAND_CASE_A(            "timerpause", Command_Timer_Pause,                 1) // Timers.h
+  COMMAND_CASE_A(           "timerresume", Command_Timer_Resume,                1) // Timers.h
+  COMMAND_CASE_A(                "timers", Command_Timer_List,                  0) // Timers.h
+  COMMAND_CASE_A(              "timerset", Command_Timer_Set,                   2) // Timers.h
+  COMMAND_CASE_A(           "timerset_ms", Command_Timer_Set_ms,                2) // Timers.h
+  COMMAND_CASE_R(              "timezone", Command_TimeZone,                    1) // Time.h
+  COMMAND_CASE_A(                  "tone", Command_GPIO_Tone,                   3) // GPIO.h
+  COMMAND_CASE_R(               "udpport", Command_UDP_Port,                    1) // UDP.h
+#if FEATURE_ESPEASY_P2P
+  COMMAND_CASE_R(               "udptest", Command_UDP_Test,                    2) // UDP.h
+#endif // if FEATURE_ESPEASY_P2P
+  COMMAND_CASE_R(                  "unit", Command_Settings_Unit,               1) // Settings.h
+  COMMAND_CASE_A(             "unmonitor", Command_GPIO_UnMonitor,              2) // GPIO.h
+  COMMAND_CASE_A(        "unmonitorrange", Command_GPIO_UnMonitorRange,         3) // GPIO.h
+  COMMAND_CASE_R(                "usentp", Command_useNTP,                      1) // Time.h
+#ifndef LIMIT_BUILD_SIZE
+  COMMAND_CASE_R(              "wdconfig", Command_WD_Config,                   3) // WD.h
+  COMMAND_CASE_R(                "wdread", Command_WD_Read,                     2) // WD.h
+#endif // ifndef LIMIT_BUILD_SIZE
+  COMMAND_CASE_R(           "wifiallowap", Command_Wifi_AllowAP,                0) // WiFi.h
+  COMMAND_CASE_R(            "wifiapmode", Command_Wifi_APMode,                 0) // WiFi.h
+  COMMAND_CASE_A(           "wificonnect", Command_Wifi_Connect,                0) // WiFi.h
+  COMMAND_CASE_A(        "wifidisconnect", Command_Wifi_Disconnect,             0) // WiFi.h
+  COMMAND_CASE_R(               "wifikey", Command_Wifi_Key,                    1) // WiFi.h
+  COMMAND_CASE_R(              "wifikey2", Command_Wifi_Key2,                   1) // WiFi.h
+  COMMAND_CASE_R(              "wifimode", Command_Wifi_Mode,                   1) // WiFi.h
+  COMMAND_CASE_R(              "wifiscan", Command_Wifi_Scan,                   0) // WiFi.h
+  COMMAND_CASE_R(              "wifissid", Command_Wifi_SSID,                   1) // WiFi.h
+  COMMAND_CASE_R(             "wifissid2", Command_Wifi_SSID2,                  1) // WiFi.h
+  COMMAND_CASE_R(           "wifistamode", Command_Wifi_STAMode,                0) // WiFi.h
+};
+
+#undef COMMAND_CASE_R
+#undef COMMAND_CASE_A
+
+constexpr size_t nr_internal_commands = sizeof(internal_commands) / sizeof(internal_commands[0]);
+
+static const command_table_entry* findInternalCommand(const char *cmd)
 {
-  return do_command_case(data, cmd_test, pFunc, nrArguments, EventValueSourceGroup::Enum::ALL);
-}
+  #ifndef BUILD_NO_DEBUG
+  static bool checked = false;
 
+  if (!checked) {
+    checked = true;
 
-bool do_command_case_all(command_case_data         & data,
-                         const __FlashStringHelper * cmd_test,
-                         command_function            pFunc,
-                         int                         nrArguments)
-{
-  return do_command_case(data, cmd_test, pFunc, nrArguments, EventValueSourceGroup::Enum::ALL);
-}
+    for (size_t i = 1; i < nr_internal_commands; ++i) {
+      char previous[sizeof(internal_commands[0].name)];
+      memcpy_P(previous, internal_commands[i - 1].name, sizeof(previous));
 
-// Wrapper to reduce generated code by macro
-bool do_command_case_all_restricted(command_case_data         & data,
-                                    const __FlashStringHelper * cmd_test,
-                                    command_function_fs         pFunc,
-                                    int                         nrArguments)
-{
-  return do_command_case(data, cmd_test, pFunc, nrArguments, EventValueSourceGroup::Enum::RESTRICTED);
-}
+      if (strcmp_P(previous, internal_commands[i].name) >= 0) {
+        addLog(LOG_LEVEL_ERROR, concat(F("Internal commands not sorted at: "), FPSTR(internal_commands[i].name)));
+      }
+    }
+  }
+  #endif // ifndef BUILD_NO_DEBUG
 
+  // Case insensitive compare, so no lower case copy of the command is needed.
+  int first = 0;
+  int last  = nr_internal_commands - 1;
 
-bool do_command_case_all_restricted(command_case_data         & data,
-                                    const __FlashStringHelper * cmd_test,
-                                    command_function            pFunc,
-                                    int                         nrArguments)
-{
-  return do_command_case(data, cmd_test, pFunc, nrArguments, EventValueSourceGroup::Enum::RESTRICTED);
-}
+  while (first <= last) {
+    const int mid = (first + last) / 2;
+    const int res = strcasecmp_P(cmd, internal_commands[mid].name);
+
+    if (res == 0) {
+      return &internal_commands[mid];
+    }
 
+    if (res < 0) {
+      last = mid - 1;
+    } else {
+      first = mid + 1;
+    }
+  }
+  return nullptr;
+}
 
-bool do_command_case_check(command_case_data         & data,
-                           const __FlashStringHelper * cmd_test,
-                           int                         nrArguments,
-                           EventValueSourceGroup::Enum group)
+bool executeInternalCommand(command_case_data & data)
 {
-  // The data struct is re-used on each attempt to process an internal command.
-  // Re-initialize the only two members that may have been altered by a previous call.
-  data.retval = false;
-  data.status = String();
-  if (!data.cmd_lc.equals(cmd_test)) {
+  const command_table_entry *entry = findInternalCommand(data.cmd);
+
+  if (entry == nullptr) {
     return false;
   }
+  data.retval = false;
+  data.status = String();
+
+  const EventValueSourceGroup::Enum group = static_cast<EventValueSourceGroup::Enum>(pgm_read_byte(&entry->group));
+
   if (!checkSourceFlags(data.event->Source, group)) {
     data.status = return_incorrect_source();
     return false;
-  } 
+  }
+
   // FIXME TD-er: Do not check nr arguments from MQTT source.
   // See https://github.com/letscontrolit/ESPEasy/issues/3344
   // C005 does recreate command partly from topic and published message
   // e.g. ESP_Easy/Bathroom_pir_env/GPIO/14 with data 0 or 1
   // This only allows for 2 parameters, but some commands need more arguments (default to "0")
   const bool mustCheckNrArguments = data.event->Source != EventValueSource::Enum::VALUE_SOURCE_MQTT;
-  if (mustCheckNrArguments) {
-    if (!checkNrArguments(data.cmd, data.line, nrArguments)) {
-      data.status = return_incorrect_nr_arguments();
-      //data.retval = false;
-      return true; // Command is handled
-    }
-  }
-  data.retval = true; // Mark the command should be executed.
-  return true; // Command is handled
-}
-
-bool do_command_case(command_case_data         & data,
-                     const __FlashStringHelper * cmd_test,
-                     command_function_fs         pFunc,
-                     int                         nrArguments,
-                     EventValueSourceGroup::Enum group)
-{
-  if (do_command_case_check(data, cmd_test, nrArguments, group)) {
-    // It has been handled, check if we need to execute it.
-    // FIXME TD-er: Must change command function signature to use const String&
-    START_TIMER;
-    data.status = pFunc(data.event, data.line.c_str());
-    STOP_TIMER(COMMAND_EXEC_INTERNAL);
-    return true;
-  }
-  return false;
-}
-
 
-bool do_command_case(command_case_data         & data,
-                     const __FlashStringHelper * cmd_test,
-                     command_function            pFunc,
-                     int                         nrArguments,
-                     EventValueSourceGroup::Enum group)
-{
-  if (do_command_case_check(data, cmd_test, nrArguments, group)) {
-    // It has been handled, check if we need to execute it.
-    // FIXME TD-er: Must change command function signature to use const String&
-    START_TIMER;
-    data.status = pFunc(data.event, data.line.c_str());
-    STOP_TIMER(COMMAND_EXEC_INTERNAL);
-    return true;
-  }
-  return false;
-}
-
-bool executeInternalCommand(command_case_data & data)
-{
-  const size_t cmd_lc_length = data.cmd_lc.length();
-  if (cmd_lc_length < 2) return false; // No commands less than 2 characters
-  // Simple macro to match command to function call.
-
-  // EventValueSourceGroup::Enum::ALL
-  #define COMMAND_CASE_A(S, C, NARGS) \
-  if (do_command_case_all(data, F(S), &C, NARGS)) { return data.retval; }
+  // FIXME TD-er: Should we execute command when number of arguments is wrong?
+  data.retval = !mustCheckNrArguments ||
+                checkNrArguments(data.cmd, data.line, static_cast<int8_t>(pgm_read_byte(&entry->nrArguments)));
 
-  // EventValueSourceGroup::Enum::RESTRICTED
-  #define COMMAND_CASE_R(S, C, NARGS) \
-  if (do_command_case_all_restricted(data, F(S), &C, NARGS)) { return data.retval; }
+  const command_handler handler = reinterpret_cast<command_handler>(pgm_read_ptr(&entry->handler));
 
-  // FIXME TD-er: Should we execute command when number of arguments is wrong?
+  START_TIMER;
+  handler(data);
+  STOP_TIMER(COMMAND_EXEC_INTERNAL);
+  #if FEATURE_LABEL_VALUE_CACHE
 
-  // FIXME TD-er: must determine nr arguments where NARGS is set to -1
-  switch (data.cmd_lc[0]) {
-    case 'a': {
-      COMMAND_CASE_A("accessinfo", Command_AccessInfo_Ls,       0); // Network Command
-      COMMAND_CASE_A("asyncevent", Command_Rules_Async_Events, -1); // Rule.h
-      break;
-    }
-    case 'b': {
-    #ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
-      COMMAND_CASE_R("background", Command_Background, 1); // Diagnostic.h
-    #endif // ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
-    #ifdef USES_C012
-      COMMAND_CASE_A("blynkget", Command_Blynk_Get, -1);
-    #endif // ifdef USES_C012
-    #ifdef USES_C015
-      COMMAND_CASE_R("blynkset", Command_Blynk_Set, -1);
-    #endif // ifdef USES_C015
-      COMMAND_CASE_A("build", Command_Settings_Build, 1);      // Settings.h
-      break;
-    }
-    case 'c': {
-      COMMAND_CASE_R( "clearaccessblock", Command_AccessInfo_Clear,   0); // Network Command
-      COMMAND_CASE_R(    "clearpassword", Command_Settings_Password_Clear,     1); // Settings.h
-      COMMAND_CASE_R(      "clearrtcram", Command_RTC_Clear,          0); // RTC.h
-      #ifdef ESP8266
-      COMMAND_CASE_R(     "clearsdkwifi", Command_System_Erase_SDK_WiFiconfig,  0); // System.h
-      COMMAND_CASE_R(   "clearwifirfcal", Command_System_Erase_RFcal,  0); // System.h
-      #endif
-      COMMAND_CASE_R(           "config", Command_Task_RemoteConfig, -1); // Tasks.h
-      COMMAND_CASE_R("controllerdisable", Command_Controller_Disable, 1); // Controller.h
-      COMMAND_CASE_R( "controllerenable", Command_Controller_Enable,  1); // Controller.h
-
-      break;
-    }
-    case 'd': {
-      COMMAND_CASE_R(           "datetime", Command_DateTime,             2); // Time.h
-      COMMAND_CASE_R(              "debug", Command_Debug,                1); // Diagnostic.h
-      COMMAND_CASE_A(                "dec", Command_Rules_Dec,           -1); // Rules.h
-      COMMAND_CASE_R(          "deepsleep", Command_System_deepSleep,     1); // System.h
-      COMMAND_CASE_R(              "delay", Command_Delay,                1); // Timers.h
-    #if FEATURE_PLUGIN_PRIORITY
-      COMMAND_CASE_R("disableprioritytask", Command_PriorityTask_Disable, 1); // Tasks.h
-    #endif // if FEATURE_PLUGIN_PRIORITY
-      COMMAND_CASE_R(                "dns", Command_DNS,                  1); // Network Command
-      COMMAND_CASE_R(                "dst", Command_DST,                  1); // Time.h
-      break;
-    }
-    case 'e': {
-    #if FEATURE_ETHERNET
-      COMMAND_CASE_R(   "ethphyadr", Command_ETH_Phy_Addr,   1); // Network Command
-      COMMAND_CASE_R(   "ethpinmdc", Command_ETH_Pin_mdc,    1); // Network Command
-      COMMAND_CASE_R(  "ethpinmdio", Command_ETH_Pin_mdio,   1); // Network Command
-      COMMAND_CASE_R( "ethpinpower", Command_ETH_Pin_power,  1); // Network Command
-      COMMAND_CASE_R(  "ethphytype", Command_ETH_Phy_Type,   1); // Network Command
-      COMMAND_CASE_R("ethclockmode", Command_ETH_Clock_Mode, 1); // Network Command
-      COMMAND_CASE_R(       "ethip", Command_ETH_IP,         1); // Network Command
-      COMMAND_CASE_R(  "ethgateway", Command_ETH_Gateway,    1); // Network Command
-      COMMAND_CASE_R(   "ethsubnet", Command_ETH_Subnet,     1); // Network Command  
-      COMMAND_CASE_R(      "ethdns", Command_ETH_DNS,        1); // Network Command
-      COMMAND_CASE_A("ethdisconnect", Command_ETH_Disconnect, 0); // Network Command
-      COMMAND_CASE_R( "ethwifimode", Command_ETH_Wifi_Mode,  1); // Network Command
-    #endif // FEATURE_ETHERNET
-      COMMAND_CASE_R("erasesdkwifi", Command_WiFi_Erase,     0); // WiFi.h
-      COMMAND_CASE_A(       "event", Command_Rules_Events,  -1); // Rule.h
-      COMMAND_CASE_A("executerules", Command_Rules_Execute, -1); // Rule.h
-      break;
-    }
-    case 'g': {
-      COMMAND_CASE_R(   "gateway", Command_Gateway,     1); // Network Command
-      COMMAND_CASE_A(      "gpio", Command_GPIO,        2); // Gpio.h
-      COMMAND_CASE_A("gpiotoggle", Command_GPIO_Toggle, 1); // Gpio.h
-      break;
-    }
-    case 'h': {
-      COMMAND_CASE_R("hiddenssid", Command_Wifi_HiddenSSID, 1); // wifi.h
-      break;
-    }
-    case 'i': {
-      COMMAND_CASE_R("i2cscanner", Command_i2c_Scanner, -1); // i2c.h
-      COMMAND_CASE_A(       "inc", Command_Rules_Inc,   -1); // Rules.h
-      COMMAND_CASE_R(        "ip", Command_IP,           1); // Network Command
-      break;
-    }
-    case 'j': {
-      #ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
-      COMMAND_CASE_A("jsonportstatus", Command_JSONPortStatus, -1); // Diagnostic.h
-      #endif // ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
-      break;
-    }
-    case 'l': {
-      COMMAND_CASE_A(            "let", Command_Rules_Let,         2); // Rules.h
-      COMMAND_CASE_A(           "load", Command_Settings_Load,     0); // Settings.h
-      COMMAND_CASE_A(       "logentry", Command_logentry,         -1); // Diagnostic.h
-      COMMAND_CASE_A(   "looptimerset", Command_Loop_Timer_Set,    3); // Timers.h
-      COMMAND_CASE_A("looptimerset_ms", Command_Loop_Timer_Set_ms, 3); // Timers.h
-      COMMAND_CASE_A(      "longpulse", Command_GPIO_LongPulse,    5);    // GPIO.h
-      COMMAND_CASE_A(   "longpulse_ms", Command_GPIO_LongPulse_Ms, 5);    // GPIO.h
-    #ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
-      COMMAND_CASE_A(  "logportstatus", Command_logPortStatus,     0); // Diagnostic.h
-      COMMAND_CASE_A(         "lowmem", Command_Lowmem,            0); // Diagnostic.h
-    #endif // ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
-      break;
-    }
-    case 'm': {
-#ifdef USES_P009
-      if (cmd_lc_length > 3 && data.cmd_lc[3] == 'g') {
-        COMMAND_CASE_A(        "mcpgpio", Command_GPIO,              2); // Gpio.h
-        COMMAND_CASE_A(   "mcpgpiorange", Command_GPIO_McpGPIORange, -1); // Gpio.h
-        COMMAND_CASE_A( "mcpgpiopattern", Command_GPIO_McpGPIOPattern, -1); // Gpio.h
-        COMMAND_CASE_A(  "mcpgpiotoggle", Command_GPIO_Toggle,       1); // Gpio.h
-      } else if (data.cmd_lc[1] == 'c') {
-        COMMAND_CASE_A(   "mcplongpulse", Command_GPIO_LongPulse,    3); // GPIO.h
-        COMMAND_CASE_A("mcplongpulse_ms", Command_GPIO_LongPulse_Ms, 3); // GPIO.h
-        COMMAND_CASE_A(        "mcpmode", Command_GPIO_Mode,         2); // Gpio.h   
-        COMMAND_CASE_A(   "mcpmoderange", Command_GPIO_ModeRange,    3); // Gpio.h   
-        COMMAND_CASE_A(       "mcppulse", Command_GPIO_Pulse,        3); // GPIO.h
-      }
-#endif
-      COMMAND_CASE_A(          "monitor", Command_GPIO_Monitor,      2); // GPIO.h
-      COMMAND_CASE_A(     "monitorrange", Command_GPIO_MonitorRange, 3); // GPIO.h   
-    #ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
-      COMMAND_CASE_A(          "malloc", Command_Malloc,         1);        // Diagnostic.h
-      COMMAND_CASE_A(         "meminfo", Command_MemInfo,        0);        // Diagnostic.h
-      COMMAND_CASE_A(   "meminfodetail", Command_MemInfo_detail, 0);        // Diagnostic.h
-    #endif // ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
-
-      break;
-    }
-    case 'n': {
-      COMMAND_CASE_R(   "name", Command_Settings_Name,        1); // Settings.h
-      COMMAND_CASE_R("nosleep", Command_System_NoSleep,       1); // System.h
-#if FEATURE_NOTIFIER
-      COMMAND_CASE_R( "notify", Command_Notifications_Notify, 2); // Notifications.h
-#endif
-      COMMAND_CASE_R("ntphost", Command_NTPHost,              1); // Time.h
-      break;
-    }
-    case 'p': {
-#ifdef USES_P019
-      if (cmd_lc_length > 3 && data.cmd_lc[3] == 'g') {
-        COMMAND_CASE_A(        "pcfgpio", Command_GPIO,                 2); // Gpio.h
-        COMMAND_CASE_A(   "pcfgpiorange", Command_GPIO_PcfGPIORange,   -1); // Gpio.h
-        COMMAND_CASE_A( "pcfgpiopattern", Command_GPIO_PcfGPIOPattern, -1); // Gpio.h
-        COMMAND_CASE_A(  "pcfgpiotoggle", Command_GPIO_Toggle,          1); // Gpio.h
-      } else if (data.cmd_lc[1] == 'c') {
-        COMMAND_CASE_A(   "pcflongpulse", Command_GPIO_LongPulse,       3); // GPIO.h
-        COMMAND_CASE_A("pcflongpulse_ms", Command_GPIO_LongPulse_Ms,    3); // GPIO.h
-        COMMAND_CASE_A(        "pcfmode", Command_GPIO_Mode,            2); // Gpio.h   
-        COMMAND_CASE_A(   "pcfmoderange", Command_GPIO_ModeRange,       3); // Gpio.h   ************
-        COMMAND_CASE_A(       "pcfpulse", Command_GPIO_Pulse,           3); // GPIO.h
-      }
-#endif
-      COMMAND_CASE_R(  "password", Command_Settings_Password, 1); // Settings.h
-      #if FEATURE_POST_TO_HTTP
-      COMMAND_CASE_A("posttohttp", Command_HTTP_PostToHTTP,  -1); // HTTP.h
-      #endif // if FEATURE_POST_TO_HTTP
-#if FEATURE_CUSTOM_PROVISIONING
-      COMMAND_CASE_A(       "provisionconfig", Command_Provisioning_Config,       0); // Provisioning.h
-      COMMAND_CASE_A(     "provisionsecurity", Command_Provisioning_Security,     0); // Provisioning.h
-      #if FEATURE_NOTIFIER
-      COMMAND_CASE_A( "provisionnotification", Command_Provisioning_Notification, 0); // Provisioning.h
-      #endif
-      COMMAND_CASE_A(    "provisionprovision", Command_Provisioning_Provision,    0); // Provisioning.h
-      COMMAND_CASE_A(        "provisionrules", Command_Provisioning_Rules,        1); // Provisioning.h
-      COMMAND_CASE_A(     "provisionfirmware", Command_Provisioning_Firmware,     1); // Provisioning.h
-#endif
-      COMMAND_CASE_A(   "pulse", Command_GPIO_Pulse,        3); // GPIO.h
-#if FEATURE_MQTT
-      COMMAND_CASE_A( "publish", Command_MQTT_Publish,     -1); // MQTT.h
-#endif // if FEATURE_MQTT
-      #if FEATURE_PUT_TO_HTTP
-      COMMAND_CASE_A("puttohttp", Command_HTTP_PutToHTTP,  -1); // HTTP.h
-      #endif // if FEATURE_PUT_TO_HTTP
-      COMMAND_CASE_A(     "pwm", Command_GPIO_PWM,          4); // GPIO.h
-      break;
-    }
-    case 'r': {
-      COMMAND_CASE_A(                "reboot", Command_System_Reboot,              0); // System.h
-      COMMAND_CASE_R(                 "reset", Command_Settings_Reset,             0); // Settings.h
-      COMMAND_CASE_A("resetflashwritecounter", Command_RTC_resetFlashWriteCounter, 0); // RTC.h
-      COMMAND_CASE_A(               "restart", Command_System_Reboot,              0); // System.h
-      COMMAND_CASE_A(                 "rtttl", Command_GPIO_RTTTL,                -1); // GPIO.h
-      COMMAND_CASE_A(                 "rules", Command_Rules_UseRules,             1); // Rule.h
-      break;
-    }
-    case 's': {
-      COMMAND_CASE_R(           "save", Command_Settings_Save, 0); // Settings.h
-      COMMAND_CASE_A("scheduletaskrun", Command_ScheduleTask_Run, 2); // Tasks.h
-
-    #if FEATURE_SD
-      COMMAND_CASE_R(  "sdcard", Command_SD_LS,         0); // SDCARDS.h
-      COMMAND_CASE_R("sdremove", Command_SD_Remove,     1); // SDCARDS.h
-    #endif // if FEATURE_SD
-
-      if (data.cmd_lc[1] == 'e') {
-      #if FEATURE_ESPEASY_P2P
-        COMMAND_CASE_A(    "sendto", Command_UPD_SendTo,      2); // UDP.h    // FIXME TD-er: These send commands, can we determine the nr
-                                                                  // of
-                                                                  // arguments?
-      #endif
-        #if FEATURE_SEND_TO_HTTP
-        COMMAND_CASE_A("sendtohttp", Command_HTTP_SendToHTTP, 3); // HTTP.h
-        #endif // FEATURE_SEND_TO_HTTP
-        COMMAND_CASE_A( "sendtoudp", Command_UDP_SendToUPD,   3); // UDP.h
-    #ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
-        COMMAND_CASE_R("serialfloat", Command_SerialFloat,    0); // Diagnostic.h
-    #endif // ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
-        COMMAND_CASE_R(   "settings", Command_Settings_Print, 0); // Settings.h
-        COMMAND_CASE_A(      "servo", Command_Servo,          3); // Servo.h
-      }
-      COMMAND_CASE_A("status", Command_GPIO_Status,          2); // GPIO.h
-      COMMAND_CASE_R("subnet", Command_Subnet, 1);                // Network Command
-    #if FEATURE_MQTT
-      COMMAND_CASE_A("subscribe", Command_MQTT_Subscribe, 1);     // MQTT.h
-    #endif // if FEATURE_MQTT
-    #ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
-      COMMAND_CASE_A(  "sysload", Command_SysLoad,        0);     // Diagnostic.h
-    #endif // ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
-      break;
-    }
-    case 't': {
-      if (data.cmd_lc[1] == 'a') {
-        COMMAND_CASE_R(   "taskclear", Command_Task_Clear,    1);             // Tasks.h
-        COMMAND_CASE_R("taskclearall", Command_Task_ClearAll, 0);             // Tasks.h
-        COMMAND_CASE_R( "taskdisable", Command_Task_Disable,  1);             // Tasks.h
-        COMMAND_CASE_R(  "taskenable", Command_Task_Enable,   1);             // Tasks.h
-        COMMAND_CASE_A(           "taskrun", Command_Task_Run,            1); // Tasks.h
-        COMMAND_CASE_A(         "taskrunat", Command_Task_Run,            2); // Tasks.h
-        COMMAND_CASE_A(      "taskvalueset", Command_Task_ValueSet,       3); // Tasks.h
-        COMMAND_CASE_A(   "taskvaluetoggle", Command_Task_ValueToggle,    2); // Tasks.h
-        COMMAND_CASE_A("taskvaluesetandrun", Command_Task_ValueSetAndRun, 3); // Tasks.h
-      } else if (data.cmd_lc[1] == 'i') {
-        COMMAND_CASE_A( "timerpause", Command_Timer_Pause,  1);               // Timers.h
-        COMMAND_CASE_A("timerresume", Command_Timer_Resume, 1);               // Timers.h
-        COMMAND_CASE_A(   "timerset", Command_Timer_Set,    2);               // Timers.h
-        COMMAND_CASE_A("timerset_ms", Command_Timer_Set_ms, 2); // Timers.h
-        COMMAND_CASE_R("timezone", Command_TimeZone, 1);                      // Time.h
-      }
-      COMMAND_CASE_A(      "tone", Command_GPIO_Tone, 3); // GPIO.h
-      break;
-    }
-    case 'u': {
-      COMMAND_CASE_R("udpport", Command_UDP_Port,      1);    // UDP.h
-    #if FEATURE_ESPEASY_P2P
-      COMMAND_CASE_R("udptest", Command_UDP_Test,      2);    // UDP.h
-    #endif
-      COMMAND_CASE_R(   "unit", Command_Settings_Unit, 1);    // Settings.h
-      COMMAND_CASE_A("unmonitor", Command_GPIO_UnMonitor, 2); // GPIO.h
-      COMMAND_CASE_A("unmonitorrange", Command_GPIO_UnMonitorRange, 3); // GPIO.h
-      COMMAND_CASE_R("usentp", Command_useNTP, 1);            // Time.h
-      break;
-    }
-    case 'w': {
-      #ifndef LIMIT_BUILD_SIZE
-      COMMAND_CASE_R("wdconfig", Command_WD_Config, 3);               // WD.h
-      COMMAND_CASE_R(  "wdread", Command_WD_Read,   2);               // WD.h
-      #endif
-
-      if (data.cmd_lc[1] == 'i') {
-        COMMAND_CASE_R(   "wifiallowap", Command_Wifi_AllowAP,    0); // WiFi.h
-        COMMAND_CASE_R(    "wifiapmode", Command_Wifi_APMode,     0); // WiFi.h
-        COMMAND_CASE_A(   "wificonnect", Command_Wifi_Connect,    0); // WiFi.h
-        COMMAND_CASE_A("wifidisconnect", Command_Wifi_Disconnect, 0); // WiFi.h
-        COMMAND_CASE_R(       "wifikey", Command_Wifi_Key,        1); // WiFi.h
-        COMMAND_CASE_R(      "wifikey2", Command_Wifi_Key2,       1); // WiFi.h
-        COMMAND_CASE_R(      "wifimode", Command_Wifi_Mode,       1); // WiFi.h
-        COMMAND_CASE_R(      "wifiscan", Command_Wifi_Scan,       0); // WiFi.h
-        COMMAND_CASE_R(      "wifissid", Command_Wifi_SSID,       1); // WiFi.h
-        COMMAND_CASE_R(     "wifissid2", Command_Wifi_SSID2,      1); // WiFi.h
-        COMMAND_CASE_R(   "wifistamode", Command_Wifi_STAMode,    0); // WiFi.h
-      }
-      break;
-    }
-    default:
-      break;
+  if (group == EventValueSourceGroup::Enum::RESTRICTED) {
+    // Restricted commands may change settings without saving them (e.g. Name, Unit, WiFiSSID)
+    clearLabelValueCache(LabelVolatility::Settings);
   }
-
-  #undef COMMAND_CASE_R
-  #undef COMMAND_CASE_A
-  return false;
+  #endif // if FEATURE_LABEL_VALUE_CACHE
+  return data.retval;
 }
 
 // Execute command which may be plugin or internal commands
@@ -618,6 +547,10 @@ bool ExecuteCommand(taskIndex_t            taskIndex,
   String action(Line);
   action = parseTemplate(action); // parseTemplate before executing the command
 
+  // Tokenize the command line once, used by all argument parsing on this line,
+  // as long as the line is not copied.
+  const CommandArguments arguments(action);
+
   // Split the arguments into Par1...5 of the event.
   // Do not split it in executeInternalCommand, since that one will be called from the scheduler with pre-set events.
   // FIXME TD-er: Why call this for all commands? The CalculateParam function is quite heavy.
@@ -646,7 +579,7 @@ bool ExecuteCommand(taskIndex_t            taskIndex,
 
 
   if (tryInternal) {
-    command_case_data data(cmd.c_str(), &TempEvent, action.c_str());
+    command_case_data data(cmd.c_str(), &TempEvent, action);
     bool   handled = executeInternalCommand(data);
 
     if (data.status.length() > 0) {
@@ -16,25 +16,21 @@ bool checkNrArguments(const char *cmd, const String& Line, int nrArguments);
 typedef String (*command_function)(struct EventStruct *, const char *);
 typedef const __FlashStringHelper * (*command_function_fs)(struct EventStruct *, const char *);
 // Simple struct to be used in handling commands.
-// By packing all into a struct, the macro calling do_command_case generates a lot less code
+// By packing all into a struct, the command handlers in the command table generate a lot less code
 // resulting in a smaller binary.
 struct command_case_data {
 
-    command_case_data(const char *cmd, struct EventStruct *event, const char *line);
+    command_case_data(const char *cmd, struct EventStruct *event, const String& line);
 
 
-    String cmd_lc;
     const char  *cmd;
     struct EventStruct *event;
-    const String line;
+    const String& line;
     String status;
     bool retval = false;
 
 };
 
-bool do_command_case(command_case_data& data, const __FlashStringHelper * cmd_test, command_function_fs pFunc, int nrArguments, EventValueSourceGroup::Enum group);
-bool do_command_case(command_case_data& data, const __FlashStringHelper * cmd_test, command_function pFunc, int nrArguments, EventValueSourceGroup::Enum group);
-
 
 /*********************************************************************************************\
 * Registers command
@@ -72,6 +72,41 @@ const __FlashStringHelper * Command_MQTT_Publish(struct EventStruct *event, cons
   return return_command_failed_flashstr();
 }
 
+const __FlashStringHelper * Command_MQTT_PublishFile(struct EventStruct *event, const char *Line)
+{
+  controllerIndex_t enabledMqttController = firstEnabledMQTT_ControllerIndex();
+
+  if (!validControllerIndex(enabledMqttController)) {
+    return F("No MQTT controller enabled");
+  }
+
+  // Command structure:  PublishFile,<topic>,<filename>
+  String topic          = parseStringKeepCase(Line, 2);
+  const String fileName = parseStringKeepCase(Line, 3);
+
+  if (topic.isEmpty() || fileName.isEmpty()) {
+    return return_command_failed_flashstr();
+  }
+
+  if (!fileExists(fileName)) {
+    return F("File does not exist");
+  }
+  bool mqtt_retainFlag;
+  {
+    // Place the ControllerSettings in a scope to free the memory as soon as we got all relevant information.
+    MakeControllerSettings(ControllerSettings); //-V522
+    if (!AllocatedControllerSettings()) {
+      addLog(LOG_LEVEL_ERROR, F("MQTT : Cannot publish, out of RAM"));
+      return F("MQTT : Cannot publish, out of RAM");
+    }
+
+    LoadControllerSettings(enabledMqttController, *ControllerSettings);
+    mqtt_retainFlag = ControllerSettings->mqtt_retainFlag();
+  }
+  return return_command_boolean_result_flashstr(
+    MQTTpublishFile(enabledMqttController, INVALID_TASK_INDEX, std::move(topic), fileName, mqtt_retainFlag));
+}
+
 
 boolean MQTTsubscribe(controllerIndex_t controller_idx, const char* topic, boolean retained)
 {
@@ -8,6 +8,9 @@
 const __FlashStringHelper * Command_MQTT_Publish(struct EventStruct *event,
                             const char         *Line);
 
+const __FlashStringHelper * Command_MQTT_PublishFile(struct EventStruct *event,
+                                                    const char         *Line);
+
 const __FlashStringHelper * Command_MQTT_Subscribe(struct EventStruct *event,
                               const char* Line);
 
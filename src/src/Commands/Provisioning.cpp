@@ -7,6 +7,7 @@
 # include "../DataStructs/ESPEasy_EventStruct.h"
 # include "../Helpers/ESPEasy_Storage.h"
 # include "../Helpers/Networking.h"
+# include "../Helpers/ProvisioningJob.h"
 # include "../Helpers/StringConverter.h"
 
 String Command_Provisioning_Config(struct EventStruct *event, const char *Line)
@@ -50,5 +51,15 @@ String Command_Provisioning_Firmware(struct EventStruct *event, const char *Line
   return error;
 }
 
+String Command_Provisioning_All(struct EventStruct *event, const char *Line)
+{
+  const String error = ProvisioningJob_start();
+
+  if (error.isEmpty()) {
+    return return_command_success();
+  }
+  return error;
+}
+
 
 #endif // if FEATURE_CUSTOM_PROVISIONING
@@ -23,6 +23,9 @@ String Command_Provisioning_Rules(struct EventStruct *event,
 String Command_Provisioning_Firmware(struct EventStruct *event,
                                      const char         *Line);
 
+String Command_Provisioning_All(struct EventStruct *event,
+                                const char         *Line);
+
 #endif // if FEATURE_CUSTOM_PROVISIONING
 
 #endif // ifndef COMMANDS_PROVISIONING_H
@@ -19,6 +19,7 @@
 #include "../Helpers/Misc.h"
 #include "../Helpers/StringConverter.h"
 #include "../Helpers/StringGenerator_System.h"
+#include "../Helpers/SystemVariables.h"
 
 
 String Command_Settings_Build(struct EventStruct *event, const char* Line)
@@ -35,6 +36,7 @@ String Command_Settings_Unit(struct EventStruct *event, const char* Line)
 {
 	if (HasArgv(Line, 2)) {
 	  Settings.Unit = event->Par1;
+	  SystemVariables::clearCachedValues();
 	  update_mDNS();
 	} else {
       return return_result(event, concat(F("Unit:"), static_cast<int>(Settings.Unit)));
@@ -44,6 +46,7 @@ String Command_Settings_Unit(struct EventStruct *event, const char* Line)
 
 String Command_Settings_Name(struct EventStruct *event, const char* Line)
 {
+	SystemVariables::clearCachedValues();
 	return Command_GetORSetString(event, F("Name:"),
 							Line,
 							Settings.Name,
@@ -28,6 +28,17 @@ const __FlashStringHelper * Command_System_deepSleep(struct EventStruct *event,
 	return return_command_success_flashstr();
 }
 
+#if FEATURE_DEEP_SLEEP_BATCH
+const __FlashStringHelper * Command_System_deepSleepSend(struct EventStruct *event, const char* Line)
+{
+	if (!deepSleepBatchEnabled()) {
+		return return_command_failed_flashstr();
+	}
+	deepSleepBatch_requestSend();
+	return return_command_success_flashstr();
+}
+#endif // if FEATURE_DEEP_SLEEP_BATCH
+
 const __FlashStringHelper * Command_System_Reboot(struct EventStruct *event, const char* Line)
 {
 	pinMode(0, INPUT);
@@ -5,6 +5,10 @@
 
 const __FlashStringHelper * Command_System_NoSleep(struct EventStruct *event, const char* Line);
 const __FlashStringHelper * Command_System_deepSleep(struct EventStruct *event, const char* Line);
+#if FEATURE_DEEP_SLEEP_BATCH
+// Send the samples collected in deep sleep batch mode in this (or the next) wake cycle
+const __FlashStringHelper * Command_System_deepSleepSend(struct EventStruct *event, const char* Line);
+#endif // if FEATURE_DEEP_SLEEP_BATCH
 const __FlashStringHelper * Command_System_Reboot(struct EventStruct *event, const char* Line);
 
 #ifdef ESP8266
@@ -4,6 +4,7 @@
 
 
 #include "../../ESPEasy_common.h"
+#include "../../ESPEasy-Globals.h"
 
 
 #include "../Commands/Common.h"
@@ -100,6 +101,43 @@ const __FlashStringHelper * Command_Timer_Resume(struct EventStruct *event, cons
   return return_command_failed_flashstr();
 }
 
+String Command_Timer_List(struct EventStruct *event, const char *Line)
+{
+  // Reply all active rules timers as JSON:
+  // [{"timer":1,"remaining":1234,"interval":5000,"loop":1,"paused":0},...]
+  String reply;
+  const unsigned int timerIndexMax = Scheduler.getRulesTimerIndexMax();
+
+  reply += '[';
+
+  for (unsigned int timerIndex = 1; timerIndex <= timerIndexMax; ++timerIndex) {
+    unsigned long msecRemaining = 0;
+    unsigned long interval      = 0;
+    int  loopCount              = 0;
+    bool paused                 = false;
+
+    if (Scheduler.getRulesTimerState(timerIndex, msecRemaining, interval, loopCount, paused)) {
+      if (reply.length() > 1) {
+        reply += ',';
+      }
+      reply += F("{\"timer\":");
+      reply += timerIndex;
+      reply += F(",\"remaining\":");
+      reply += msecRemaining;
+      reply += F(",\"interval\":");
+      reply += interval;
+      reply += F(",\"loop\":");
+      reply += loopCount;
+      reply += F(",\"paused\":");
+      reply += paused ? 1 : 0;
+      reply += '}';
+    }
+  }
+  reply += ']';
+  printToWebJSON = true;
+  return return_result(event, reply);
+}
+
 const __FlashStringHelper * Command_Delay(struct EventStruct *event, const char *Line)
 {
   delayBackground(event->Par1);
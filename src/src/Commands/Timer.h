@@ -9,6 +9,7 @@ const __FlashStringHelper * Command_Loop_Timer_Set (struct EventStruct *event, c
 const __FlashStringHelper * Command_Loop_Timer_Set_ms (struct EventStruct *event, const char* Line);
 const __FlashStringHelper * Command_Timer_Pause (struct EventStruct *event, const char* Line);
 const __FlashStringHelper * Command_Timer_Resume (struct EventStruct *event, const char* Line);
+String Command_Timer_List (struct EventStruct *event, const char* Line);
 const __FlashStringHelper * Command_Delay (struct EventStruct *event, const char* Line);
 
 #endif // COMMAND_TIMER_H
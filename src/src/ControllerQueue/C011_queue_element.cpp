@@ -38,4 +38,15 @@ bool C011_queue_element::isDuplicate(const Queue_element_base& other) const {
          oth.postStr.equals(postStr);
 }
 
+uint32_t C011_queue_element::getContentHash() const {
+  uint32_t hash = hashAdd(hashBase(), static_cast<uint32_t>(_taskIndex));
+
+  hash = hashAdd(hash, static_cast<uint32_t>(sensorType));
+  hash = hashAdd(hash, static_cast<uint32_t>(idx));
+  hash = hashAdd(hash, uri);
+  hash = hashAdd(hash, HttpMethod);
+  hash = hashAdd(hash, header);
+  return hashAdd(hash, postStr);
+}
+
 #endif // ifdef USES_C011
@@ -10,6 +10,9 @@ C015_queue_element::C015_queue_element(C015_queue_element&& other)
   , valueCount(other.valueCount)
 {
   _timestamp      = other._timestamp;
+#if FEATURE_SAMPLE_LATENCY
+  _readTime_usec  = other._readTime_usec;
+#endif // if FEATURE_SAMPLE_LATENCY
   _controller_idx = other._controller_idx;
   _taskIndex      = other._taskIndex;
   # ifdef USE_SECOND_HEAP
@@ -33,6 +36,9 @@ C015_queue_element::C015_queue_element(const struct EventStruct *event, uint8_t
 C015_queue_element& C015_queue_element::operator=(C015_queue_element&& other) {
   idx             = other.idx;
   _timestamp      = other._timestamp;
+#if FEATURE_SAMPLE_LATENCY
+  _readTime_usec  = other._readTime_usec;
+#endif // if FEATURE_SAMPLE_LATENCY
   _taskIndex      = other._taskIndex;
   _controller_idx = other._controller_idx;
   valuesSent      = other.valuesSent;
@@ -81,4 +87,17 @@ bool C015_queue_element::isDuplicate(const Queue_element_base& other) const {
   return true;
 }
 
+uint32_t C015_queue_element::getContentHash() const {
+  uint32_t hash = hashAdd(hashBase(), static_cast<uint32_t>(_taskIndex));
+
+  hash = hashAdd(hash, static_cast<uint32_t>(valueCount));
+  hash = hashAdd(hash, static_cast<uint32_t>(idx));
+
+  for (uint8_t i = 0; i < VARS_PER_TASK; ++i) {
+    hash = hashAdd(hash, txt[i]);
+    hash = hashAdd(hash, static_cast<uint32_t>(vPin[i]));
+  }
+  return hash;
+}
+
 #endif // ifdef USES_C015
@@ -21,6 +21,9 @@ C016_queue_element::C016_queue_element(C016_queue_element&& other)
   , valueCount(other.valueCount)
 {
   _timestamp      = other._timestamp;
+#if FEATURE_SAMPLE_LATENCY
+  _readTime_usec  = other._readTime_usec;
+#endif // if FEATURE_SAMPLE_LATENCY
   _controller_idx = other._controller_idx;
   _taskIndex      = other._taskIndex;
   values          = other.values;
@@ -45,6 +48,9 @@ C016_queue_element::C016_queue_element(const struct EventStruct *event, uint8_t
 
 C016_queue_element& C016_queue_element::operator=(C016_queue_element&& other) {
   _timestamp      = other._timestamp;
+#if FEATURE_SAMPLE_LATENCY
+  _readTime_usec  = other._readTime_usec;
+#endif // if FEATURE_SAMPLE_LATENCY
   _taskIndex      = other._taskIndex;
   _controller_idx = other._controller_idx;
   sensorType      = other.sensorType;
@@ -83,6 +89,14 @@ bool C016_queue_element::isDuplicate(const Queue_element_base& other) const {
   return true;
 }
 
+uint32_t C016_queue_element::getContentHash() const {
+  uint32_t hash = hashAdd(hashBase(), static_cast<uint32_t>(_taskIndex));
+
+  // Float values are compared with some tolerance, so these cannot be part of the hash.
+  hash = hashAdd(hash, static_cast<uint32_t>(sensorType));
+  return hashAdd(hash, static_cast<uint32_t>(valueCount));
+}
+
 C016_binary_element C016_queue_element::getBinary() const {
   C016_binary_element element;
 
@@ -53,6 +53,8 @@ public:
 
   bool                      isDuplicate(const Queue_element_base& other) const;
 
+  uint32_t                  getContentHash() const;
+
   const UnitMessageCount_t* getUnitMessageCount() const {
     return nullptr;
   }
@@ -43,4 +43,42 @@ bool C018_queue_element::isDuplicate(const Queue_element_base& other) const {
   return true;
 }
 
+bool C018_queue_element::combine(const C018_queue_element& other, uint8_t maxPayload) {
+  # if FEATURE_PACKED_RAW_DATA
+
+  if ((other._controller_idx != _controller_idx) || (other.nrCombined != 1) || (nrCombined == 255)) {
+    return false;
+  }
+  const size_t combinedSize = getPayloadSize() + (nrCombined == 1 ? 1 : 0) + 1 + other.getPayloadSize();
+
+  if (combinedSize > maxPayload) {
+    return false;
+  }
+
+  if (nrCombined == 1) {
+    packed = LoRa_addInt(getPayloadSize(), PackedData_uint8) + packed;
+  }
+  packed += LoRa_addInt(other.getPayloadSize(), PackedData_uint8);
+  packed += other.packed;
+  ++nrCombined;
+  return true;
+  # else // if FEATURE_PACKED_RAW_DATA
+  return false;
+  # endif // if FEATURE_PACKED_RAW_DATA
+}
+
+bool C018_queue_element::replaceStale(const C018_queue_element& newer) {
+  if ((newer._controller_idx != _controller_idx) ||
+      (newer._taskIndex != _taskIndex) ||
+      (nrCombined != 1) || (newer.nrCombined != 1)) {
+    return false;
+  }
+  packed = newer.packed;
+  return true;
+}
+
+uint32_t C018_queue_element::getContentHash() const {
+  return hashAdd(hashAdd(hashBase(), static_cast<uint32_t>(_taskIndex)), packed);
+}
+
 #endif // ifdef USES_C018
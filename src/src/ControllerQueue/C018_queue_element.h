@@ -38,6 +38,8 @@ public:
 
   bool                      isDuplicate(const Queue_element_base& other) const;
 
+  uint32_t                  getContentHash() const;
+
   const UnitMessageCount_t* getUnitMessageCount() const {
     return nullptr;
   }
@@ -46,7 +48,23 @@ public:
     return nullptr;
   }
 
-  String packed;
+  // Payload size in bytes
+  uint8_t getPayloadSize() const {
+    return packed.length() / 2;
+  }
+
+  // Append the payload of another (single) element, to send both in a single uplink.
+  // A combined payload is a sequence of: 1 byte length + packed data of a single element.
+  // @retval false when the combined payload would exceed maxPayload bytes.
+  bool combine(const C018_queue_element& other,
+               uint8_t                   maxPayload);
+
+  // Replace the payload with the newer sample of the same task.
+  // @retval false when this element is not a single sample of the same task.
+  bool replaceStale(const C018_queue_element& newer);
+
+  String  packed;
+  uint8_t nrCombined = 1;
 };
 
 #endif // USES_C018
@@ -0,0 +1,85 @@
+#include "../ControllerQueue/ControllerBackoff.h"
+
+#if FEATURE_CONTROLLER_BACKOFF
+
+# include "../Helpers/ESPEasy_time_calc.h"
+# include "../Helpers/Hardware.h"
+
+const __FlashStringHelper* toString(ControllerCircuitState_e state) {
+  switch (state) {
+    case ControllerCircuitState_e::Closed:   return F("Closed");
+    case ControllerCircuitState_e::Open:     return F("Open");
+    case ControllerCircuitState_e::HalfOpen: return F("Half-open");
+  }
+  return F("");
+}
+
+void ControllerBackoff::markFailed(unsigned long minDelay) {
+  if (_failures < 0xFFFF) {
+    ++_failures;
+  }
+
+  if ((_state == ControllerCircuitState_e::HalfOpen) ||
+      ((_state == ControllerCircuitState_e::Closed) && (_failures >= CONTROLLER_BACKOFF_OPEN_THRESHOLD))) {
+    if (_state == ControllerCircuitState_e::HalfOpen) {
+      // Probe failed, stay away longer
+      _openTime *= 2;
+
+      if (_openTime > CONTROLLER_BACKOFF_MAX_OPEN_TIME) {
+        _openTime = CONTROLLER_BACKOFF_MAX_OPEN_TIME;
+      }
+    }
+    _state = ControllerCircuitState_e::Open;
+    ++_openCount;
+
+    // Still some jitter, to spread the probes of all nodes.
+    _nextAttempt = millis() + HwRandom(_openTime / 2, _openTime + 1);
+    return;
+  }
+
+  // Exponential backoff, capped to CONTROLLER_BACKOFF_MAX_DELAY
+  unsigned long maxDelay = minDelay;
+
+  for (uint16_t i = 1; i < _failures && maxDelay < CONTROLLER_BACKOFF_MAX_DELAY; ++i) {
+    maxDelay *= 2;
+  }
+
+  if (maxDelay > CONTROLLER_BACKOFF_MAX_DELAY) {
+    maxDelay = CONTROLLER_BACKOFF_MAX_DELAY;
+  }
+
+  // Full jitter, but never retry faster than the min. send interval.
+  unsigned long delay = HwRandom(maxDelay + 1);
+
+  if (delay < minDelay) {
+    delay = minDelay;
+  }
+  _nextAttempt = millis() + delay;
+}
+
+void ControllerBackoff::markSuccess() {
+  _failures    = 0;
+  _nextAttempt = 0;
+  _openTime    = CONTROLLER_BACKOFF_OPEN_TIME;
+  _state       = ControllerCircuitState_e::Closed;
+}
+
+bool ControllerBackoff::mayAttempt() {
+  if ((_nextAttempt != 0) && (timePassedSince(_nextAttempt) < 0)) {
+    return false;
+  }
+
+  if (_state == ControllerCircuitState_e::Open) {
+    _state = ControllerCircuitState_e::HalfOpen;
+  }
+  return true;
+}
+
+unsigned long ControllerBackoff::getNextAttemptTime() const {
+  if ((_nextAttempt == 0) || (timePassedSince(_nextAttempt) >= 0)) {
+    return 0;
+  }
+  return _nextAttempt;
+}
+
+#endif // if FEATURE_CONTROLLER_BACKOFF
@@ -0,0 +1,92 @@
+#ifndef CONTROLLERQUEUE_CONTROLLERBACKOFF_H
+#define CONTROLLERQUEUE_CONTROLLERBACKOFF_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_CONTROLLER_BACKOFF
+
+# include "../DataTypes/ControllerIndex.h"
+
+// Max. delay in msec between retries while the circuit is still closed
+# ifndef CONTROLLER_BACKOFF_MAX_DELAY
+#  define CONTROLLER_BACKOFF_MAX_DELAY      60000
+# endif // ifndef CONTROLLER_BACKOFF_MAX_DELAY
+
+// Nr of consecutive failures to open the circuit
+# ifndef CONTROLLER_BACKOFF_OPEN_THRESHOLD
+#  define CONTROLLER_BACKOFF_OPEN_THRESHOLD 5
+# endif // ifndef CONTROLLER_BACKOFF_OPEN_THRESHOLD
+
+// Time in msec the circuit stays open the first time.
+// Doubled each time the probe in half-open state fails, up to CONTROLLER_BACKOFF_MAX_OPEN_TIME
+# ifndef CONTROLLER_BACKOFF_OPEN_TIME
+#  define CONTROLLER_BACKOFF_OPEN_TIME      30000
+# endif // ifndef CONTROLLER_BACKOFF_OPEN_TIME
+
+# ifndef CONTROLLER_BACKOFF_MAX_OPEN_TIME
+#  define CONTROLLER_BACKOFF_MAX_OPEN_TIME  300000
+# endif // ifndef CONTROLLER_BACKOFF_MAX_OPEN_TIME
+
+enum class ControllerCircuitState_e : uint8_t {
+  Closed   = 0, // Sending normally, failed attempts are retried with exponential backoff
+  Open     = 1, // Too many failures, no attempts until the open time has passed
+  HalfOpen = 2  // A single probe is allowed, which either closes or opens the circuit again
+};
+
+const __FlashStringHelper* toString(ControllerCircuitState_e state);
+
+
+/*********************************************************************************************\
+* ControllerBackoff
+* Retry pacing of a controller queue.
+* Each failed attempt doubles the max. delay until the next attempt, starting from the
+* min. send interval. The actual delay is a random value up to this max. ("full jitter"),
+* so nodes which lost their connection to the same server at the same time do not retry in lockstep.
+* After CONTROLLER_BACKOFF_OPEN_THRESHOLD consecutive failures the circuit is opened and
+* no attempts are made at all until the open time has passed.
+\*********************************************************************************************/
+class ControllerBackoff {
+public:
+
+  // Register a failed attempt and compute the time of the next attempt.
+  void                     markFailed(unsigned long minDelay);
+
+  // Register a successful attempt, which closes the circuit.
+  void                     markSuccess();
+
+  // Return true when an attempt may be made now.
+  // An open circuit is switched to half-open once the open time has passed.
+  bool                     mayAttempt();
+
+  // Time of the next allowed attempt, or 0 when not delayed.
+  unsigned long            getNextAttemptTime() const;
+
+  ControllerCircuitState_e getState() const {
+    return _state;
+  }
+
+  uint16_t getConsecutiveFailures() const {
+    return _failures;
+  }
+
+  // Nr of times the circuit was opened since boot
+  uint32_t getOpenCount() const {
+    return _openCount;
+  }
+
+  // Controller of the last attempt, as a queue may be shared by controllers using the same protocol.
+  controllerIndex_t controller_idx = INVALID_CONTROLLER_INDEX;
+
+private:
+
+  unsigned long _nextAttempt = 0;
+  unsigned long _openTime    = CONTROLLER_BACKOFF_OPEN_TIME;
+  uint32_t      _openCount   = 0;
+  uint16_t      _failures    = 0;
+
+  ControllerCircuitState_e _state = ControllerCircuitState_e::Closed;
+};
+
+#endif // if FEATURE_CONTROLLER_BACKOFF
+
+#endif // ifndef CONTROLLERQUEUE_CONTROLLERBACKOFF_H
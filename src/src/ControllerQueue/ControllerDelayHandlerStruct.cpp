@@ -1,5 +1,15 @@
 #include "../ControllerQueue/ControllerDelayHandlerStruct.h"
 
+#include "../ControllerQueue/SampleLatency.h"
+#include "../Helpers/HeapTracker.h"
+
+#if FEATURE_CONTROLLER_QUEUE_TASK
+# include "../Helpers/ControllerQueueTask.h"
+
+ESPEasy_Mutex controllerDelayHandler_processingMutex;
+#endif // if FEATURE_CONTROLLER_QUEUE_TASK
+
+ControllerDelayHandlerStruct *ControllerDelayHandlerStruct::_firstInstance = nullptr;
 
 ControllerDelayHandlerStruct::ControllerDelayHandlerStruct() :
   lastSend(0),
@@ -8,10 +18,29 @@ ControllerDelayHandlerStruct::ControllerDelayHandlerStruct() :
   max_queue_depth(CONTROLLER_DELAY_QUEUE_DEPTH_DFLT),
   attempt(0),
   max_retries(CONTROLLER_DELAY_QUEUE_RETRY_DFLT),
+  max_burst(CONTROLLER_DELAY_QUEUE_BURST_DFLT),
   delete_oldest(false),
   must_check_reply(false),
   deduplicate(false),
-  useLocalSystemTime(false) {}
+  useLocalSystemTime(false),
+  _nextInstance(_firstInstance)
+{
+  _firstInstance = this;
+  sendQueue.setCapacity(max_queue_depth);
+}
+
+ControllerDelayHandlerStruct::~ControllerDelayHandlerStruct()
+{
+  ControllerDelayHandlerStruct **instance = &_firstInstance;
+
+  while (*instance != nullptr) {
+    if (*instance == this) {
+      *instance = _nextInstance;
+      return;
+    }
+    instance = &((*instance)->_nextInstance);
+  }
+}
 
 bool ControllerDelayHandlerStruct::cacheControllerSettings(controllerIndex_t ControllerIndex)
 {
@@ -22,13 +51,23 @@ bool ControllerDelayHandlerStruct::cacheControllerSettings(controllerIndex_t Con
   }
   LoadControllerSettings(ControllerIndex, *ControllerSettings);
   cacheControllerSettings(*ControllerSettings);
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+  setSpillController(ControllerIndex, *ControllerSettings);
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
   return true;
 }
 
 void ControllerDelayHandlerStruct::cacheControllerSettings(const ControllerSettingsStruct& settings) {
+  lock();
+  cacheControllerSettings_nolock(settings);
+  unlock();
+}
+
+void ControllerDelayHandlerStruct::cacheControllerSettings_nolock(const ControllerSettingsStruct& settings) {
   minTimeBetweenMessages = settings.MinimalTimeBetweenMessages;
   max_queue_depth        = settings.MaxQueueDepth;
   max_retries            = settings.MaxRetry;
+  max_burst              = settings.MaxBurst;
   delete_oldest          = settings.DeleteOldest;
   must_check_reply       = settings.MustCheckReply;
   deduplicate            = settings.deduplicate();
@@ -47,14 +86,73 @@ void ControllerDelayHandlerStruct::cacheControllerSettings(const ControllerSetti
   // Set some sound limits when not configured
   if (max_queue_depth == 0) { max_queue_depth = CONTROLLER_DELAY_QUEUE_DEPTH_DFLT; }
 
+  // Only reallocates the slots when the queue depth was changed.
+  sendQueue.setCapacity(max_queue_depth);
+  sendQueue.setHashing(deduplicate);
+
   if (max_retries == 0) { max_retries = CONTROLLER_DELAY_QUEUE_RETRY_DFLT; }
 
+  if (max_burst == 0) { max_burst = CONTROLLER_DELAY_QUEUE_BURST_DFLT; }
+
   if (minTimeBetweenMessages == 0) { minTimeBetweenMessages = CONTROLLER_DELAY_QUEUE_DELAY_DFLT; }
 
   // No less than 10 msec between messages.
   if (minTimeBetweenMessages < 10) { minTimeBetweenMessages = 10; }
+
+#if FEATURE_CONTROLLER_QUEUE_TASK
+
+  if (controllerQueueTask_active()) {
+    if (!_settings) {
+      _settings.reset(new (std::nothrow) ControllerSettingsStruct());
+    }
+
+    if (_settings) {
+      *_settings = settings;
+    }
+  }
+#endif // if FEATURE_CONTROLLER_QUEUE_TASK
 }
 
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+void ControllerDelayHandlerStruct::setSpillController(controllerIndex_t ControllerIndex, const ControllerSettingsStruct& settings)
+{
+  lock();
+  _spill.setController(ControllerIndex, settings.queueSpill());
+  unlock();
+}
+
+bool ControllerDelayHandlerStruct::processSpill()
+{
+  lock();
+
+  if (!_spill.enabled()) {
+    unlock();
+    return false;
+  }
+  _spill.loop();
+
+  size_t queueSize = sendQueue.size();
+# if FEATURE_CONTROLLER_QUEUE_TASK
+
+  if (_inFlight) { ++queueSize; }
+# endif // if FEATURE_CONTROLLER_QUEUE_TASK
+
+  if (_spill.empty() || (queueSize >= max_queue_depth) || queueFull_nolock(_spill.getControllerIndex())) {
+    unlock();
+    return false;
+  }
+  std::vector<std::unique_ptr<Queue_element_base> > elements;
+
+  _spill.take_front(max_queue_depth - queueSize, elements);
+
+  for (auto it = elements.begin(); it != elements.end(); ++it) {
+    sendQueue.push_back(std::move(*it));
+  }
+  unlock();
+  return !elements.empty();
+}
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
 bool ControllerDelayHandlerStruct::readyToProcess(const Queue_element_base& element) const {
   const protocolIndex_t protocolIndex = getProtocolIndex_from_ControllerIndex(element._controller_idx);
 
@@ -63,13 +161,32 @@ bool ControllerDelayHandlerStruct::readyToProcess(const Queue_element_base& elem
   }
 
   if (getProtocolStruct(protocolIndex).needsNetwork) {
+#if FEATURE_CONTROLLER_QUEUE_TASK
+
+    if (controllerQueueTask_isWorker()) {
+      return controllerQueueTask_networkConnected();
+    }
+#endif // if FEATURE_CONTROLLER_QUEUE_TASK
     return NetworkConnected(10);
   }
   return true;
 }
 
 bool ControllerDelayHandlerStruct::queueFull(controllerIndex_t controller_idx) const {
-  if (sendQueue.size() >= max_queue_depth) { return true; }
+  lock();
+  const bool res = queueFull_nolock(controller_idx);
+  unlock();
+  return res;
+}
+
+bool ControllerDelayHandlerStruct::queueFull_nolock(controllerIndex_t controller_idx) const {
+  size_t queueSize = sendQueue.size();
+#if FEATURE_CONTROLLER_QUEUE_TASK
+
+  if (_inFlight) { ++queueSize; }
+#endif // if FEATURE_CONTROLLER_QUEUE_TASK
+
+  if (queueSize >= max_queue_depth) { return true; }
 
   // Number of elements is not exceeding the limit, check memory
   int freeHeap = FreeMem();
@@ -97,7 +214,7 @@ bool ControllerDelayHandlerStruct::queueFull(controllerIndex_t controller_idx) c
     String log = F("Controller-");
     log += controller_idx + 1;
     log += F(" : Memory used: ");
-    log += getQueueMemorySize();
+    log += getQueueMemorySize_nolock();
     log += F(" bytes ");
     log += sendQueue.size();
     log += F(" items ");
@@ -123,15 +240,22 @@ bool ControllerDelayHandlerStruct::isDuplicate(const Queue_element_base& element
 
   // the setting 'deduplicate' does look at the content of the message and only compares it to messages in the queue.
   if (deduplicate && !sendQueue.empty()) {
-    // Use reverse iterator here, as it is more likely a duplicate is added shortly after another.
-    auto it = sendQueue.rbegin(); // Same as back()
+    // Only compare the content of elements with the same content hash.
+    const uint32_t hash = element.getContentHash();
+
+    if (!sendQueue.mayContainHash(hash)) {
+      return false;
+    }
+
+    // Iterate from the newest element, as it is more likely a duplicate is added shortly after another.
+    for (size_t nr = sendQueue.size(); nr > 0; --nr) {
+      const Queue_element_base *queued = sendQueue.at(nr - 1);
 
-    for (; it != sendQueue.rend(); ++it) {
-      if (element.isDuplicate(*(it->get()))) {
+      if ((sendQueue.getHash(nr - 1) == hash) && element.isDuplicate(*queued)) {
 #ifndef BUILD_NO_DEBUG
 
         if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-          const cpluginID_t cpluginID = getCPluginID_from_ControllerIndex(it->get()->_controller_idx);
+          const cpluginID_t cpluginID = getCPluginID_from_ControllerIndex(queued->_controller_idx);
           String log                  = get_formatted_Controller_number(cpluginID);
           log += F(" : Remove duplicate");
           addLogMove(LOG_LEVEL_DEBUG, log);
@@ -150,24 +274,38 @@ bool ControllerDelayHandlerStruct::addToQueue(std::unique_ptr<Queue_element_base
   if (!element) { 
     return false;
   }
+  lock();
   if (isDuplicate(*element)) {
+    unlock();
     return true;
   }
 
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+  // Once elements are spilled, new elements must also be spilled to keep the order.
+  if (_spill.enabled() &&
+      (!_spill.empty() || queueFull_nolock(element->_controller_idx)) &&
+      _spill.add(*element)) {
+    unlock();
+    return true;
+  }
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
   if (delete_oldest) {
     // Force add to the queue.
     // If max buffer is reached, the oldest in the queue (first to be served) will be removed.
-    while (queueFull(element->_controller_idx)) {
+    while (queueFull_nolock(element->_controller_idx) && !sendQueue.empty()) {
       sendQueue.pop_front();
       attempt = 0;
     }
   }
 
-  if (!queueFull(element->_controller_idx)) {
-    sendQueue.push_back(std::move(element));
+  if (!queueFull_nolock(element->_controller_idx) && sendQueue.push_back(std::move(element))) {
+    unlock();
 
     return true;
   }
+  unlock();
 #ifndef BUILD_NO_DEBUG
 
   if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
@@ -183,6 +321,13 @@ bool ControllerDelayHandlerStruct::addToQueue(std::unique_ptr<Queue_element_base
 // Get the next element.
 // Remove front element when max_retries is reached.
 Queue_element_base * ControllerDelayHandlerStruct::getNext() {
+  lock();
+  Queue_element_base *res = getNext_nolock();
+  unlock();
+  return res;
+}
+
+Queue_element_base * ControllerDelayHandlerStruct::getNext_nolock() {
   if (sendQueue.empty()) { return nullptr; }
 
   if (attempt > max_retries) {
@@ -194,7 +339,7 @@ Queue_element_base * ControllerDelayHandlerStruct::getNext() {
     bool done = false;
 
     while (!done && !sendQueue.empty()) {
-      if ((sendQueue.front().get() != nullptr) && (timePassedSince(sendQueue.front()->_timestamp) < static_cast<long>(expire_timeout))) {
+      if (timePassedSince(sendQueue.front()->_timestamp) < static_cast<long>(expire_timeout)) {
         done = true;
       } else {
         sendQueue.pop_front();
@@ -203,29 +348,62 @@ Queue_element_base * ControllerDelayHandlerStruct::getNext() {
     }
   }
 
-  if (sendQueue.empty()) { return nullptr; }
-  return sendQueue.front().get();
+  return sendQueue.front();
 }
 
 // Mark as processed and return time to schedule for next process.
 // Return 0 when nothing to process.
 // @param remove_from_queue indicates whether the elements should be removed from the queue.
 unsigned long ControllerDelayHandlerStruct::markProcessed(bool remove_from_queue) {
+  lock();
+  const unsigned long res = markProcessed_nolock(remove_from_queue);
+  unlock();
+  return res;
+}
+
+unsigned long ControllerDelayHandlerStruct::markProcessed_nolock(bool remove_from_queue) {
   if (sendQueue.empty()) { return 0; }
+#if FEATURE_CONTROLLER_BACKOFF
+  _backoff.controller_idx = sendQueue.front()->_controller_idx;
+#endif // if FEATURE_CONTROLLER_BACKOFF
 
   if (remove_from_queue) {
+    HEAP_TRACK_SCOPE(ControllerQueue);
+#if FEATURE_SAMPLE_LATENCY
+    SampleLatency_delivered(*sendQueue.front());
+#endif // if FEATURE_SAMPLE_LATENCY
     sendQueue.pop_front();
-    attempt  = 0;
-    lastSend = millis();
+    attempt = 0;
+    markSent_nolock();
+#if FEATURE_CONTROLLER_BACKOFF
+    _backoff.markSuccess();
+#endif // if FEATURE_CONTROLLER_BACKOFF
   } else {
     ++attempt;
+#if FEATURE_CONTROLLER_BACKOFF
+    _backoff.markFailed(minTimeBetweenMessages);
+#endif // if FEATURE_CONTROLLER_BACKOFF
   }
-  return getNextScheduleTime();
+  return getNextScheduleTime_nolock();
 }
 
 unsigned long ControllerDelayHandlerStruct::getNextScheduleTime() const {
+  lock();
+  const unsigned long res = getNextScheduleTime_nolock();
+  unlock();
+  return res;
+}
+
+unsigned long ControllerDelayHandlerStruct::getNextScheduleTime_nolock() const {
   if (sendQueue.empty()) { return 0; }
-  unsigned long nextTime = lastSend + minTimeBetweenMessages;
+  unsigned long nextTime = lastSend + minTimeBetweenMessages - getBurstSpan();
+#if FEATURE_CONTROLLER_BACKOFF
+  const unsigned long nextAttempt = _backoff.getNextAttemptTime();
+
+  if ((nextAttempt != 0) && (timeDiff(nextTime, nextAttempt) > 0)) {
+    nextTime = nextAttempt;
+  }
+#endif // if FEATURE_CONTROLLER_BACKOFF
 
   if (timePassedSince(nextTime) > 0) {
     nextTime = millis();
@@ -236,46 +414,295 @@ unsigned long ControllerDelayHandlerStruct::getNextScheduleTime() const {
   return nextTime;
 }
 
+#if FEATURE_CONTROLLER_BACKOFF
+bool ControllerDelayHandlerStruct::mayAttempt() {
+  lock();
+  const bool res = _backoff.mayAttempt();
+  unlock();
+  return res;
+}
+
+bool ControllerDelayHandlerStruct::getBackoffState(controllerIndex_t controller_idx, ControllerBackoff& backoff) {
+  for (const ControllerDelayHandlerStruct *instance = _firstInstance; instance != nullptr; instance = instance->_nextInstance) {
+    instance->lock();
+    const bool found = instance->_backoff.controller_idx == controller_idx;
+
+    if (found) {
+      backoff = instance->_backoff;
+    }
+    instance->unlock();
+
+    if (found) {
+      return true;
+    }
+  }
+  return false;
+}
+#endif // if FEATURE_CONTROLLER_BACKOFF
+
 // Set the "lastSend" to "now" + some additional delay.
 // This will cause the next schedule time to be delayed to
 // msecFromNow + minTimeBetweenMessages
 void ControllerDelayHandlerStruct::setAdditionalDelay(unsigned long msecFromNow) {
-  lastSend = millis() + msecFromNow;
+  lock();
+  lastSend = millis() + msecFromNow + getBurstSpan();
+  unlock();
+}
+
+bool ControllerDelayHandlerStruct::mayProcessNext(unsigned long processStart) const {
+  if (timePassedSince(processStart) >= CONTROLLER_DELAY_QUEUE_PROCESS_BUDGET) {
+    return false;
+  }
+  const unsigned long nextTime = getNextScheduleTime();
+
+  return nextTime != 0 && timePassedSince(nextTime) >= 0;
+}
+
+void ControllerDelayHandlerStruct::markSent_nolock() {
+  // Each sent message moves "lastSend" by minTimeBetweenMessages.
+  // When idle, the bucket is full and "lastSend" starts again from now.
+  // This allows up to max_burst messages before being limited to the configured interval again.
+  const unsigned long nextTime = lastSend + minTimeBetweenMessages;
+
+  if (timePassedSince(nextTime) > 0) {
+    lastSend = millis();
+  } else {
+    lastSend = nextTime;
+  }
+}
+
+unsigned long ControllerDelayHandlerStruct::getBurstSpan() const {
+  if (max_burst <= 1) { return 0; }
+  return static_cast<unsigned long>(max_burst - 1) * minTimeBetweenMessages;
 }
 
 size_t ControllerDelayHandlerStruct::getQueueMemorySize() const {
-  size_t totalSize = 0;
+  lock();
+  const size_t res = getQueueMemorySize_nolock();
+  unlock();
+  return res;
+}
 
-  for (auto it = sendQueue.begin(); it != sendQueue.end(); ++it) {
-    if (it->get() != nullptr) {
-      totalSize += it->get()->getSize();
-    }
+size_t ControllerDelayHandlerStruct::getQueueMemorySize_nolock() const {
+  size_t totalSize = sendQueue.getMemorySize();
+#if FEATURE_CONTROLLER_QUEUE_TASK
+
+  if (_inFlight) {
+    totalSize += _inFlight->getSize();
   }
+#endif // if FEATURE_CONTROLLER_QUEUE_TASK
   return totalSize;
 }
 
+size_t ControllerDelayHandlerStruct::getQueueDepth(controllerIndex_t controller_idx) {
+  size_t depth = 0;
+
+  for (const ControllerDelayHandlerStruct *instance = _firstInstance; instance != nullptr; instance = instance->_nextInstance) {
+    instance->lock();
+
+    for (size_t nr = 0; nr < instance->sendQueue.size(); ++nr) {
+      if (instance->sendQueue.at(nr)->_controller_idx == controller_idx) {
+        ++depth;
+      }
+    }
+#if FEATURE_CONTROLLER_QUEUE_TASK
+
+    if (instance->_inFlight && (instance->_inFlight->_controller_idx == controller_idx)) {
+      ++depth;
+    }
+#endif // if FEATURE_CONTROLLER_QUEUE_TASK
+    instance->unlock();
+  }
+  return depth;
+}
+
 void ControllerDelayHandlerStruct::process(
   int                                controller_number,
   do_process_function                func,
   TimingStatsElements                timerstats_id,
   SchedulerIntervalTimer_e timerID) 
 {
+#if FEATURE_CONTROLLER_QUEUE_TASK
+
+  if (controllerQueueTask_isWorker()) {
+    // Rescheduling is done by the controller queue task itself.
+    process_in_worker(controller_number, func);
+    return;
+  }
+#endif // if FEATURE_CONTROLLER_QUEUE_TASK
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+  processSpill();
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
   Queue_element_base *element(static_cast<Queue_element_base *>(getNext()));
 
   if (element == nullptr) { return; }
+#if FEATURE_CONTROLLER_ASYNC_CONNECT
+  bool connectPending = false;
+#endif // if FEATURE_CONTROLLER_ASYNC_CONNECT
+
+  bool mayProcess = readyToProcess(*element);
+#if FEATURE_CONTROLLER_BACKOFF
 
-  if (readyToProcess(*element)) {
+  // Not checked when not ready, so a half-open circuit is only probed when the network is up.
+  mayProcess = mayProcess && mayAttempt();
+#endif // if FEATURE_CONTROLLER_BACKOFF
+
+  if (mayProcess) {
     MakeControllerSettings(ControllerSettings);
 
     if (AllocatedControllerSettings()) {
       LoadControllerSettings(element->_controller_idx, *ControllerSettings);
       cacheControllerSettings(*ControllerSettings);
-      START_TIMER;
-      markProcessed(func(controller_number, *element, *ControllerSettings));
-      #if FEATURE_TIMING_STATS
-      STOP_TIMER_VAR(timerstats_id);
-      #endif
+
+      // Keep sending while tokens are left for a burst and there is time left in this loop.
+      // Only for elements of the same controller, as the loaded settings are used.
+      const controllerIndex_t controller_idx = element->_controller_idx;
+      const unsigned long     processStart   = millis();
+      bool processed                         = true;
+#if FEATURE_CONTROLLER_ASYNC_CONNECT
+      const bool usesHTTP = getProtocolStruct(getProtocolIndex_from_ControllerIndex(controller_idx)).usesHTTP;
+#endif // if FEATURE_CONTROLLER_ASYNC_CONNECT
+
+      while (processed && (element != nullptr)) {
+#if FEATURE_CONTROLLER_ASYNC_CONNECT
+
+        if (usesHTTP) {
+          // Connect without blocking, the element is sent once connected.
+          const AsyncConnectResult connectResult = http_connect_async(controller_number, controller_idx, *ControllerSettings);
+
+          if (connectResult == AsyncConnectResult::Pending) {
+            connectPending = true;
+            break;
+          }
+
+          if (connectResult == AsyncConnectResult::Failed) {
+            markProcessed(false);
+            break;
+          }
+        }
+#endif // if FEATURE_CONTROLLER_ASYNC_CONNECT
+        START_TIMER;
+        processed = func(controller_number, *element, *ControllerSettings);
+        markProcessed(processed);
+        #if FEATURE_TIMING_STATS
+        STOP_TIMER_VAR(timerstats_id);
+        #endif
+
+        element = nullptr;
+
+        if (processed && mayProcessNext(processStart)) {
+          element = getNext();
+
+          if ((element != nullptr) &&
+              ((element->_controller_idx != controller_idx) || !readyToProcess(*element))) {
+            element = nullptr;
+          }
+        }
+      }
     }
   }
+#if FEATURE_CONTROLLER_ASYNC_CONNECT
+
+  if (connectPending) {
+    Scheduler.scheduleNextDelayQueue(timerID, millis() + HTTP_ASYNC_CONNECT_POLL_INTERVAL);
+    return;
+  }
+#endif // if FEATURE_CONTROLLER_ASYNC_CONNECT
   Scheduler.scheduleNextDelayQueue(timerID, getNextScheduleTime());
 }
+
+#if FEATURE_CONTROLLER_QUEUE_TASK
+void ControllerDelayHandlerStruct::process_in_worker(
+  int                 controller_number,
+  do_process_function func)
+{
+  lock();
+
+  if ((getNext_nolock() == nullptr) || !_settings) {
+    unlock();
+    return;
+  }
+  _inFlight = sendQueue.take_front();
+  unlock();
+
+  bool sent       = false;
+  bool processed  = false;
+  bool mayProcess = readyToProcess(*_inFlight);
+# if FEATURE_CONTROLLER_BACKOFF
+  mayProcess = mayProcess && mayAttempt();
+# endif // if FEATURE_CONTROLLER_BACKOFF
+
+  if (mayProcess) {
+    MakeControllerSettings(ControllerSettings);
+
+    if (AllocatedControllerSettings()) {
+      lock();
+      *ControllerSettings = *_settings;
+      unlock();
+      processed = func(controller_number, *_inFlight, *ControllerSettings);
+      sent      = true;
+    }
+  }
+
+  lock();
+# if FEATURE_CONTROLLER_BACKOFF
+
+  if (sent) {
+    _backoff.controller_idx = _inFlight->_controller_idx;
+  }
+# endif // if FEATURE_CONTROLLER_BACKOFF
+
+  if (processed) {
+# if FEATURE_SAMPLE_LATENCY
+    SampleLatency_delivered(*_inFlight);
+# endif // if FEATURE_SAMPLE_LATENCY
+    attempt = 0;
+    markSent_nolock();
+# if FEATURE_CONTROLLER_BACKOFF
+    _backoff.markSuccess();
+# endif // if FEATURE_CONTROLLER_BACKOFF
+  } else {
+    // Put it back as front element, to try again later.
+    if (sent) {
+      ++attempt;
+# if FEATURE_CONTROLLER_BACKOFF
+      _backoff.markFailed(minTimeBetweenMessages);
+# endif // if FEATURE_CONTROLLER_BACKOFF
+    }
+    if (!sendQueue.push_front(std::move(_inFlight))) {
+      // Queue was made smaller while sending
+      attempt = 0;
+    }
+  }
+  _inFlight.reset();
+  unlock();
+}
+#endif // if FEATURE_CONTROLLER_QUEUE_TASK
+
+void ControllerDelayHandlerStruct::lock() const
+{
+#if FEATURE_CONTROLLER_QUEUE_TASK
+  _mutex.lock();
+#endif // if FEATURE_CONTROLLER_QUEUE_TASK
+}
+
+void ControllerDelayHandlerStruct::unlock() const
+{
+#if FEATURE_CONTROLLER_QUEUE_TASK
+  _mutex.unlock();
+#endif // if FEATURE_CONTROLLER_QUEUE_TASK
+}
+
+void ControllerDelayHandlerStruct::lockProcessing()
+{
+#if FEATURE_CONTROLLER_QUEUE_TASK
+  controllerDelayHandler_processingMutex.lock();
+#endif // if FEATURE_CONTROLLER_QUEUE_TASK
+}
+
+void ControllerDelayHandlerStruct::unlockProcessing()
+{
+#if FEATURE_CONTROLLER_QUEUE_TASK
+  controllerDelayHandler_processingMutex.unlock();
+#endif // if FEATURE_CONTROLLER_QUEUE_TASK
+}
@@ -3,7 +3,10 @@
 
 #include "../../ESPEasy_common.h"
 
+#include "../ControllerQueue/ControllerBackoff.h"
 #include "../ControllerQueue/Queue_element_base.h"
+#include "../ControllerQueue/Queue_element_ring.h"
+#include "../ControllerQueue/Queue_element_spill.h"
 
 #include "../DataStructs/ControllerSettingsStruct.h"
 #include "../DataStructs/TimingStats.h"
@@ -14,13 +17,13 @@
 #include "../Helpers/_CPlugin_Helper.h"
 #include "../Helpers/ESPEasy_Storage.h"
 #include "../Helpers/ESPEasy_time_calc.h"
+#include "../Helpers/ESPEasyMutex.h"
 #include "../Helpers/Memory.h"
 #include "../Helpers/Networking.h"
 #include "../Helpers/Scheduler.h"
 #include "../Helpers/StringConverter.h"
 
 
-#include <list>
 #include <memory> // For std::shared_ptr
 #include <new>    // std::nothrow
 
@@ -37,10 +40,29 @@ typedef bool (*do_process_function)(int,
 \*********************************************************************************************/
 struct ControllerDelayHandlerStruct {
   ControllerDelayHandlerStruct();
+  ~ControllerDelayHandlerStruct();
+
+  ControllerDelayHandlerStruct(const ControllerDelayHandlerStruct&) = delete;
+  ControllerDelayHandlerStruct& operator=(const ControllerDelayHandlerStruct&) = delete;
 
   bool cacheControllerSettings(controllerIndex_t ControllerIndex);
   void cacheControllerSettings(const ControllerSettingsStruct& settings);
 
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+  // Set the controller to use the spill file of, when enabled in its settings.
+  void setSpillController(controllerIndex_t               ControllerIndex,
+                          const ControllerSettingsStruct& settings);
+
+  // Move spilled elements back to the queue when there is room.
+  // Return true when elements were moved.
+  // Must be called from the main loop, as it accesses the file system.
+  bool processSpill();
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
+  // Only reads the protocol table and the network state.
+  // In the controller queue task the network state last published by the main loop is used,
+  // as checking the network may reset WiFi.
   bool readyToProcess(const Queue_element_base& element) const;
 
   bool queueFull(controllerIndex_t controller_idx) const;
@@ -49,11 +71,14 @@ struct ControllerDelayHandlerStruct {
   bool isDuplicate(const Queue_element_base& element) const;
 
   // Try to add to the queue, if permitted by "delete_oldest"
+  // When the queue is full, the element is spilled to a file if enabled.
   // Return true when item was added, or skipped as it was considered a duplicate
   bool addToQueue(std::unique_ptr<Queue_element_base>element);
 
   // Get the next element.
   // Remove front element when max_retries is reached.
+  // The returned element is only valid until the queue is changed by the same task,
+  // which is fine as a queue is either processed by the main loop or by the controller queue task.
   Queue_element_base* getNext();
 
   // Mark as processed and return time to schedule for next process.
@@ -63,31 +88,125 @@ struct ControllerDelayHandlerStruct {
 
   unsigned long getNextScheduleTime() const;
 
+#if FEATURE_CONTROLLER_BACKOFF
+
+  // Return false while failed attempts are backed off, or the circuit is open.
+  // Must only be called right before an actual attempt, as it allows the probe of a half-open circuit.
+  bool mayAttempt();
+
+  // Copy of the backoff state of the queue last used by the given controller.
+  // Return false when no queue was used by this controller.
+  static bool getBackoffState(controllerIndex_t  controller_idx,
+                              ControllerBackoff& backoff);
+#endif // if FEATURE_CONTROLLER_BACKOFF
+
+  // Return true when the next element may be sent right away and
+  // the time spent since processStart is still within CONTROLLER_DELAY_QUEUE_PROCESS_BUDGET.
+  bool   mayProcessNext(unsigned long processStart) const;
+
   // Set the "lastSend" to "now" + some additional delay.
   // This will cause the next schedule time to be delayed to
   // msecFromNow + minTimeBetweenMessages
+  // Any allowed burst is cleared.
   void   setAdditionalDelay(unsigned long msecFromNow);
 
   size_t getQueueMemorySize() const;
 
+  // Number of queued elements for the given controller, summed over all existing queues.
+  static size_t getQueueDepth(controllerIndex_t controller_idx);
+
   void   process(
     int                                controller_number,
     do_process_function                func,
     TimingStatsElements                timerstats_id,
     SchedulerIntervalTimer_e timerID);
 
-  std::list<std::unique_ptr<Queue_element_base> >sendQueue;
+  // Block the controller queue task from processing any queue.
+  // Must be held while creating or deleting a delay handler.
+  static void lockProcessing();
+  static void unlockProcessing();
+
+  Queue_element_ring                             sendQueue;
   mutable UnitLastMessageCount_map               unitLastMessageCount;
+
+  // Token bucket, kept as the time the last message would have been sent when sending at the max. rate.
+  // A message may be sent at lastSend + minTimeBetweenMessages - (max_burst - 1) * minTimeBetweenMessages
   unsigned long                                  lastSend               = 0;
   unsigned int                                   minTimeBetweenMessages = CONTROLLER_DELAY_QUEUE_DELAY_DFLT;
   unsigned long                                  expire_timeout         = 0;
   uint8_t                                        max_queue_depth        = CONTROLLER_DELAY_QUEUE_DEPTH_DFLT;
   uint8_t                                        attempt                = 0;
   uint8_t                                        max_retries            = CONTROLLER_DELAY_QUEUE_RETRY_DFLT;
+  uint8_t                                        max_burst              = CONTROLLER_DELAY_QUEUE_BURST_DFLT;
   bool                                           delete_oldest          = false;
   bool                                           must_check_reply       = false;
   bool                                           deduplicate            = false;
   bool                                           useLocalSystemTime     = false;
+
+private:
+
+  // Ownership of the fields when FEATURE_CONTROLLER_QUEUE_TASK is enabled:
+  // - Guarded by _mutex: sendQueue, unitLastMessageCount, the cached settings, lastSend, attempt,
+  //   _inFlight, _settings and _backoff.
+  //   Both the main loop and the controller queue task access these.
+  // - Main loop only: _spill.
+  // - Sample latency stats are guarded by their own mutex, see SampleLatency.cpp.
+  // The *_nolock functions must be called while holding _mutex.
+
+  Queue_element_base* getNext_nolock();
+
+  unsigned long markProcessed_nolock(bool remove_from_queue);
+
+  bool          queueFull_nolock(controllerIndex_t controller_idx) const;
+
+  unsigned long getNextScheduleTime_nolock() const;
+
+  // Take a token from the bucket
+  void          markSent_nolock();
+
+  // Time span covered by the tokens which can be saved for a burst
+  unsigned long getBurstSpan() const;
+
+  size_t        getQueueMemorySize_nolock() const;
+
+  void          cacheControllerSettings_nolock(const ControllerSettingsStruct& settings);
+
+  void          lock() const;
+  void          unlock() const;
+
+#if FEATURE_CONTROLLER_QUEUE_TASK
+
+  // Process the front element from the controller queue task.
+  // The element is taken from the queue while sending, so the main loop can keep adding to the queue.
+  void          process_in_worker(int                 controller_number,
+                                  do_process_function func);
+
+  // Guards the queue, settings and token bucket, as the queue may be processed in the controller queue task.
+  mutable ESPEasy_Mutex                     _mutex;
+
+  // Element being sent by the controller queue task
+  std::unique_ptr<Queue_element_base>       _inFlight;
+
+  // Copy of the controller settings, as the controller queue task cannot load them.
+  std::unique_ptr<ControllerSettingsStruct> _settings;
+#endif // if FEATURE_CONTROLLER_QUEUE_TASK
+
+#if FEATURE_CONTROLLER_BACKOFF
+
+  // Pacing of retries after failed attempts
+  ControllerBackoff _backoff;
+#endif // if FEATURE_CONTROLLER_BACKOFF
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+  // Elements which did not fit in the queue.
+  // Only accessed from the main loop.
+  ControllerQueueSpill _spill;
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
+  // All existing instances are kept in a linked list, to collect queue statistics.
+  static ControllerDelayHandlerStruct *_firstInstance;
+  ControllerDelayHandlerStruct        *_nextInstance = nullptr;
 };
 
 
@@ -3,6 +3,7 @@
 #include "../DataStructs/ControllerSettingsStruct.h"
 #include "../DataStructs/TimingStats.h"
 #include "../Globals/ESPEasy_Scheduler.h"
+#include "../Helpers/Memory.h"
 #include "../Helpers/PeriodicalActions.h"
 
 #if FEATURE_MQTT
@@ -17,9 +18,7 @@ bool init_mqtt_delay_queue(controllerIndex_t ControllerIndex, String& pubname, b
   LoadControllerSettings(ControllerIndex, *ControllerSettings);
 
   if (MQTTDelayHandler == nullptr) {
-    # ifdef USE_SECOND_HEAP
-    HeapSelectIram ephemeral;
-    # endif // ifdef USE_SECOND_HEAP
+    MemoryPolicyScope memoryPolicy(MemoryBufferClass_e::ControllerQueue);
 
     MQTTDelayHandler = new (std::nothrow) ControllerDelayHandlerStruct;
   }
@@ -28,6 +27,9 @@ bool init_mqtt_delay_queue(controllerIndex_t ControllerIndex, String& pubname, b
     return false;
   }
   MQTTDelayHandler->cacheControllerSettings(*ControllerSettings);
+  # if FEATURE_CONTROLLER_QUEUE_SPILL
+  MQTTDelayHandler->setSpillController(ControllerIndex, *ControllerSettings);
+  # endif // if FEATURE_CONTROLLER_QUEUE_SPILL
   pubname    = ControllerSettings->Publish;
   retainFlag = ControllerSettings->mqtt_retainFlag();
   Scheduler.setIntervalTimerOverride(SchedulerIntervalTimer_e::TIMER_MQTT, 10); // Make sure the MQTT is being processed as soon
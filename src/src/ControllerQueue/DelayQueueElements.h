@@ -67,15 +67,19 @@
   }                                                                                                                  \
   bool init_c##NNN####M##_delay_queue(controllerIndex_t ControllerIndex) {                                           \
     if (C##NNN####M##_DelayHandler == nullptr) {                                                                     \
+      ControllerDelayHandlerStruct::lockProcessing();                                                                \
       C##NNN####M##_DelayHandler = new (std::nothrow) (ControllerDelayHandlerStruct);                                \
+      ControllerDelayHandlerStruct::unlockProcessing();                                                              \
     }                                                                                                                \
     if (C##NNN####M##_DelayHandler == nullptr) { return false; }                                                     \
     return C##NNN####M##_DelayHandler->cacheControllerSettings(ControllerIndex);                                 \
   }                                                                                                                  \
   void exit_c##NNN####M##_delay_queue() {                                                                            \
     if (C##NNN####M##_DelayHandler != nullptr) {                                                                     \
+      ControllerDelayHandlerStruct::lockProcessing();                                                                \
       delete C##NNN####M##_DelayHandler;                                                                             \
       C##NNN####M##_DelayHandler = nullptr;                                                                          \
+      ControllerDelayHandlerStruct::unlockProcessing();                                                              \
     }                                                                                                                \
   }                                                                                                                  \
 
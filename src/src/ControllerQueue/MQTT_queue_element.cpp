@@ -2,6 +2,10 @@
 
 #if FEATURE_MQTT
 
+# if FEATURE_CONTROLLER_QUEUE_SPILL
+#  include "../ControllerQueue/Queue_element_spill.h"
+# endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
 MQTT_queue_element::MQTT_queue_element(int ctrl_idx,
                                        taskIndex_t TaskIndex,
                                        const String& topic, const String& payload,
@@ -58,7 +62,14 @@ MQTT_queue_element::MQTT_queue_element(int         ctrl_idx,
 }
 
 size_t MQTT_queue_element::getSize() const {
-  return sizeof(*this) + _topic.length() + _payload.length();
+  return sizeof(*this) + _topic.length() + getPayload().length() + _payloadFile.length();
+}
+
+const String& MQTT_queue_element::getPayload() const {
+  if (_sharedPayload) {
+    return *_sharedPayload;
+  }
+  return _payload;
 }
 
 bool MQTT_queue_element::isDuplicate(const Queue_element_base& other) const {
@@ -72,12 +83,22 @@ bool MQTT_queue_element::isDuplicate(const Queue_element_base& other) const {
   if ((oth._controller_idx != _controller_idx) ||
       (oth._retained != _retained) ||
       (oth._topic != _topic) ||
-      (oth._payload != _payload)) {
+      (oth._payloadFile != _payloadFile) ||
+      (oth.getPayload() != getPayload())) {
     return false;
   }
   return true;
 }
 
+uint32_t MQTT_queue_element::getContentHash() const {
+  // Same as isDuplicate(), the task index is not included.
+  uint32_t hash = hashAdd(hashBase(), _retained ? 1u : 0u);
+
+  hash = hashAdd(hash, _topic);
+  hash = hashAdd(hash, _payloadFile);
+  return hashAdd(hash, getPayload());
+}
+
 void MQTT_queue_element::removeEmptyTopics() {
   // some parts of the topic may have been replaced by empty strings,
   // or "/status" may have been appended to a topic ending with a "/"
@@ -87,4 +108,35 @@ void MQTT_queue_element::removeEmptyTopics() {
   }
 }
 
+# if FEATURE_CONTROLLER_QUEUE_SPILL
+bool MQTT_queue_element::serialize(Queue_element_spill_writer& writer) const {
+  serializeBase(writer, static_cast<uint8_t>(Queue_element_type_e::MQTT));
+
+  // Bit 0: retained, bit 1: the payload is a file name
+  writer.writeUInt8((_retained ? 1 : 0) | (hasPayloadFile() ? 2 : 0));
+  writer.writeString(_topic);
+  writer.writeString(hasPayloadFile() ? _payloadFile : getPayload());
+  return true;
+}
+
+bool MQTT_queue_element::deserialize(Queue_element_spill_reader& reader) {
+  uint8_t flags = 0;
+
+  if (!deserializeBase(reader) ||
+      !reader.readUInt8(flags) ||
+      !reader.readString(_topic) ||
+      !reader.readString(_payload)) {
+    return false;
+  }
+  _retained = (flags & 1) != 0;
+  _sharedPayload.reset();
+
+  if (flags & 2) {
+    _payloadFile = std::move(_payload);
+    _payload     = String();
+  }
+  return true;
+}
+# endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
 #endif // if FEATURE_MQTT
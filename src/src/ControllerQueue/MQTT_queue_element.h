@@ -9,6 +9,8 @@
 # include "../DataStructs/UnitMessageCount.h"
 # include "../Globals/CPlugins.h"
 
+# include <memory>
+
 /*********************************************************************************************\
 * MQTT_queue_element for all MQTT base controllers
 \*********************************************************************************************/
@@ -43,6 +45,14 @@ public:
 
   bool                      isDuplicate(const Queue_element_base& other) const;
 
+  uint32_t                  getContentHash() const;
+
+# if FEATURE_CONTROLLER_QUEUE_SPILL
+  bool                      serialize(Queue_element_spill_writer& writer) const;
+
+  bool                      deserialize(Queue_element_spill_reader& reader);
+# endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
   const UnitMessageCount_t* getUnitMessageCount() const {
     return &UnitMessageCount;
   }
@@ -53,8 +63,22 @@ public:
 
   void removeEmptyTopics();
 
+  // The payload to publish, either the own copy or the shared one.
+  const String& getPayload() const;
+
+  // Publish the payload from a file instead of from memory.
+  bool hasPayloadFile() const {
+    return !_payloadFile.isEmpty();
+  }
+
   String _topic{};
   String _payload{};
+
+  // Payload shared with other queue elements or the caller, to avoid a copy per queued message.
+  std::shared_ptr<const String> _sharedPayload;
+
+  // File name of the payload, streamed from the file system while publishing.
+  String _payloadFile{};
   UnitMessageCount_t UnitMessageCount{};
   bool _retained = false; 
 };
@@ -1,5 +1,12 @@
 #include "../ControllerQueue/Queue_element_base.h"
 
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+# include "../ControllerQueue/Queue_element_spill.h"
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+#if FEATURE_SAMPLE_LATENCY
+# include "../ControllerQueue/SampleLatency.h"
+#endif // if FEATURE_SAMPLE_LATENCY
+
 Queue_element_base::Queue_element_base() :
   _controller_idx(INVALID_CONTROLLER_INDEX),
   _taskIndex(INVALID_TASK_INDEX),
@@ -7,6 +14,59 @@ Queue_element_base::Queue_element_base() :
   _processByController(false)
 {
   _timestamp = millis();
+#if FEATURE_SAMPLE_LATENCY
+  _readTime_usec = SampleReadTimeScope::getReadTime();
+#endif // if FEATURE_SAMPLE_LATENCY
 }
 
 Queue_element_base::~Queue_element_base() {}
+
+uint32_t Queue_element_base::hashBase() const {
+  return hashAdd(2166136261u, static_cast<uint32_t>(_controller_idx));
+}
+
+uint32_t Queue_element_base::hashAdd(uint32_t hash, const String& str) {
+  const size_t length = str.length();
+
+  for (size_t i = 0; i < length; ++i) {
+    hash ^= static_cast<uint8_t>(str[i]);
+    hash *= 16777619u;
+  }
+
+  // Also add the length, so moving characters between strings gives another hash
+  return hashAdd(hash, static_cast<uint32_t>(length));
+}
+
+uint32_t Queue_element_base::hashAdd(uint32_t hash, uint32_t value) {
+  for (uint8_t i = 0; i < sizeof(uint32_t); ++i) {
+    hash  ^= value & 0xFF;
+    hash  *= 16777619u;
+    value >>= 8;
+  }
+  return hash;
+}
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+void Queue_element_base::serializeBase(Queue_element_spill_writer& writer, uint8_t elementType) const {
+  writer.writeUInt8(elementType);
+  writer.writeUInt8(_controller_idx);
+  writer.writeUInt8(_taskIndex);
+  writer.writeUInt8((_call_PLUGIN_PROCESS_CONTROLLER_DATA ? 1 : 0) | (_processByController ? 2 : 0));
+}
+
+bool Queue_element_base::deserializeBase(Queue_element_spill_reader& reader) {
+  uint8_t flags = 0;
+
+  if (!reader.readUInt8(_controller_idx) ||
+      !reader.readUInt8(_taskIndex) ||
+      !reader.readUInt8(flags)) {
+    return false;
+  }
+  _call_PLUGIN_PROCESS_CONTROLLER_DATA = (flags & 1) != 0;
+  _processByController                 = (flags & 2) != 0;
+
+  // The time the element was spilled is not kept, so it does not expire right away when read back.
+  _timestamp = millis();
+  return true;
+}
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
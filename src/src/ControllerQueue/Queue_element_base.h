@@ -7,6 +7,11 @@
 #include "../DataStructs/UnitMessageCount.h"
 #include "../Globals/CPlugins.h"
 
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+class Queue_element_spill_reader;
+class Queue_element_spill_writer;
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
 /*********************************************************************************************\
 * Base class for all controller queue elements
 \*********************************************************************************************/
@@ -20,10 +25,33 @@ public:
 
   virtual bool                      isDuplicate(const Queue_element_base& other) const = 0;
 
+  // Hash of the content compared in isDuplicate().
+  // Elements considered a duplicate must have the same hash.
+  virtual uint32_t                  getContentHash() const = 0;
+
   virtual const UnitMessageCount_t* getUnitMessageCount() const = 0;
   virtual UnitMessageCount_t      * getUnitMessageCount()       = 0;
 
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+  // Store the element in a record of the controller queue spill file.
+  // Return false when this element type cannot be stored.
+  virtual bool serialize(Queue_element_spill_writer& writer) const {
+    return false;
+  }
+
+  // Read the element from a spill file record, after the element type was read.
+  virtual bool deserialize(Queue_element_spill_reader& reader) {
+    return false;
+  }
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
   unsigned long _timestamp;
+#if FEATURE_SAMPLE_LATENCY
+
+  // getMicros64() when the sample was read, to compute the latency when delivered.
+  uint64_t _readTime_usec;
+#endif // if FEATURE_SAMPLE_LATENCY
   controllerIndex_t _controller_idx;
   taskIndex_t _taskIndex;
 
@@ -34,6 +62,26 @@ public:
   // Some formatting of values can be done when actually sending it.
   // This may require less RAM than keeping formatted strings in memory
   bool _processByController;
+
+protected:
+
+  // FNV-1a hash of the controller index, to start computing getContentHash()
+  uint32_t        hashBase() const;
+
+  static uint32_t hashAdd(uint32_t      hash,
+                          const String& str);
+
+  static uint32_t hashAdd(uint32_t hash,
+                          uint32_t value);
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+  // Write the element type and the members of this base class
+  void serializeBase(Queue_element_spill_writer& writer,
+                     uint8_t                     elementType) const;
+
+  bool deserializeBase(Queue_element_spill_reader& reader);
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
 };
 
 #endif // ifndef CONTROLLERQUEUE_QUEUE_ELEMENT_BASE_H
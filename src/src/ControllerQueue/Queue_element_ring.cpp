@@ -0,0 +1,141 @@
+#include "../ControllerQueue/Queue_element_ring.h"
+
+void Queue_element_ring::setCapacity(size_t capacity)
+{
+  if (capacity == _slots.size()) {
+    return;
+  }
+
+  while (_count > capacity) {
+    pop_front();
+  }
+
+  std::vector<Slot> slots;
+
+  slots.resize(capacity);
+
+  for (size_t i = 0; i < _count; ++i) {
+    Slot& slot = _slots[slotIndex(i)];
+    slots[i].element = std::move(slot.element);
+    slots[i].size    = slot.size;
+    slots[i].hash    = slot.hash;
+  }
+  _slots.swap(slots);
+  _head = 0;
+}
+
+Queue_element_base * Queue_element_ring::at(size_t nr) const
+{
+  if (nr >= _count) {
+    return nullptr;
+  }
+  return _slots[slotIndex(nr)].element.get();
+}
+
+bool Queue_element_ring::push_back(std::unique_ptr<Queue_element_base>&& element)
+{
+  if (!element || full()) {
+    return false;
+  }
+  store(slotIndex(_count), std::move(element));
+  ++_count;
+  return true;
+}
+
+bool Queue_element_ring::push_front(std::unique_ptr<Queue_element_base>&& element)
+{
+  if (!element || full()) {
+    return false;
+  }
+  _head = (_head + _slots.size() - 1) % _slots.size();
+  store(_head, std::move(element));
+  ++_count;
+  return true;
+}
+
+std::unique_ptr<Queue_element_base>Queue_element_ring::take_front()
+{
+  if (_count == 0) {
+    return nullptr;
+  }
+  Slot& slot = _slots[_head];
+
+  std::unique_ptr<Queue_element_base> res = std::move(slot.element);
+
+  remove(slot);
+  _head = slotIndex(1);
+  --_count;
+
+  if (_count == 0) {
+    _head = 0;
+  }
+  return res;
+}
+
+void Queue_element_ring::pop_front()
+{
+  take_front();
+}
+
+void Queue_element_ring::clear()
+{
+  while (_count > 0) {
+    pop_front();
+  }
+}
+
+void Queue_element_ring::setHashing(bool enabled)
+{
+  if (enabled == _hashing) {
+    return;
+  }
+  _hashing = enabled;
+
+  for (size_t i = 0; i < QUEUE_ELEMENT_RING_HASH_BUCKETS; ++i) {
+    _hashCount[i] = 0;
+  }
+
+  for (size_t i = 0; i < _count; ++i) {
+    Slot& slot = _slots[slotIndex(i)];
+    slot.hash = 0;
+
+    if (_hashing) {
+      slot.hash = slot.element->getContentHash();
+      ++_hashCount[slot.hash % QUEUE_ELEMENT_RING_HASH_BUCKETS];
+    }
+  }
+}
+
+uint32_t Queue_element_ring::getHash(size_t nr) const
+{
+  if (nr >= _count) {
+    return 0;
+  }
+  return _slots[slotIndex(nr)].hash;
+}
+
+void Queue_element_ring::store(size_t index, std::unique_ptr<Queue_element_base>element)
+{
+  Slot& slot = _slots[index];
+
+  slot.size    = element->getSize();
+  slot.hash    = 0;
+  _memorySize += slot.size;
+
+  if (_hashing) {
+    slot.hash = element->getContentHash();
+    ++_hashCount[slot.hash % QUEUE_ELEMENT_RING_HASH_BUCKETS];
+  }
+  slot.element = std::move(element);
+}
+
+void Queue_element_ring::remove(Slot& slot)
+{
+  _memorySize -= slot.size;
+
+  if (_hashing) {
+    --_hashCount[slot.hash % QUEUE_ELEMENT_RING_HASH_BUCKETS];
+  }
+  slot.size = 0;
+  slot.hash = 0;
+}
@@ -0,0 +1,116 @@
+#ifndef CONTROLLERQUEUE_QUEUE_ELEMENT_RING_H
+#define CONTROLLERQUEUE_QUEUE_ELEMENT_RING_H
+
+
+#include "../../ESPEasy_common.h"
+
+#include "../ControllerQueue/Queue_element_base.h"
+
+#include <memory>
+#include <vector>
+
+// Number of buckets to count element hashes, used for a quick duplicate check
+#define QUEUE_ELEMENT_RING_HASH_BUCKETS  32
+
+/*********************************************************************************************\
+* Fixed capacity ring buffer of controller queue elements.
+* The slots are allocated when the capacity is set, so adding and removing elements
+* does not allocate list nodes.
+* The memory used by the elements is accounted for when adding and removing them.
+* Optionally the content hash of the elements is kept, to quickly find duplicates.
+\*********************************************************************************************/
+class Queue_element_ring {
+public:
+
+  Queue_element_ring() = default;
+
+  // Set the number of slots.
+  // When shrinking, the oldest elements which no longer fit are removed.
+  void                setCapacity(size_t capacity);
+
+  size_t              capacity() const {
+    return _slots.size();
+  }
+
+  size_t size() const {
+    return _count;
+  }
+
+  bool empty() const {
+    return _count == 0;
+  }
+
+  bool full() const {
+    return _count >= _slots.size();
+  }
+
+  // Return element nr, counting from the oldest element.
+  // Return nullptr when not present.
+  Queue_element_base* at(size_t nr) const;
+
+  Queue_element_base* front() const {
+    return at(0);
+  }
+
+  Queue_element_base* back() const {
+    return _count == 0 ? nullptr : at(_count - 1);
+  }
+
+  // Return false when there is no free slot, the element is then not moved.
+  bool                push_back(std::unique_ptr<Queue_element_base>&& element);
+
+  // Put an element back as oldest element.
+  // Return false when there is no free slot, the element is then not moved.
+  bool                push_front(std::unique_ptr<Queue_element_base>&& element);
+
+  // Remove the oldest element from the ring and return it.
+  std::unique_ptr<Queue_element_base>take_front();
+
+  void                pop_front();
+
+  void                clear();
+
+  // Sum of getSize() of all elements, as computed when the elements were added.
+  size_t              getMemorySize() const {
+    return _memorySize;
+  }
+
+  // Keep the content hash of all elements.
+  // Hashes of already queued elements are computed when enabled.
+  void                setHashing(bool enabled);
+
+  // Return false when no element with this content hash is present.
+  // Only valid when hashing is enabled.
+  bool                mayContainHash(uint32_t hash) const {
+    return _hashCount[hash % QUEUE_ELEMENT_RING_HASH_BUCKETS] != 0;
+  }
+
+  // Return the content hash of element nr, counting from the oldest element.
+  uint32_t            getHash(size_t nr) const;
+
+private:
+
+  struct Slot {
+    std::unique_ptr<Queue_element_base>element;
+    size_t                             size = 0;
+    uint32_t                           hash = 0;
+  };
+
+  size_t slotIndex(size_t nr) const {
+    return (_head + nr) % _slots.size();
+  }
+
+  void store(size_t                             index,
+             std::unique_ptr<Queue_element_base>element);
+
+  void remove(Slot& slot);
+
+  std::vector<Slot> _slots;
+  uint16_t          _hashCount[QUEUE_ELEMENT_RING_HASH_BUCKETS]{};
+  size_t            _head       = 0; // Slot index of the oldest element
+  size_t            _count      = 0;
+  size_t            _memorySize = 0;
+  bool              _hashing    = false;
+};
+
+#endif // ifndef CONTROLLERQUEUE_QUEUE_ELEMENT_RING_H
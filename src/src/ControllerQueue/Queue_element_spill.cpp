@@ -0,0 +1,370 @@
+#include "../ControllerQueue/Queue_element_spill.h"
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+# include "../ControllerQueue/SimpleQueueElement_formatted_Strings.h"
+# include "../ControllerQueue/SimpleQueueElement_string_only.h"
+# include "../ESPEasyCore/ESPEasy_Log.h"
+# include "../Helpers/ESPEasy_Storage.h"
+# include "../Helpers/ESPEasy_time_calc.h"
+# include "../Helpers/StringConverter.h"
+
+# if FEATURE_MQTT
+#  include "../ControllerQueue/MQTT_queue_element.h"
+# endif // if FEATURE_MQTT
+
+// Size of the length field of a record
+# define CONTROLLER_QUEUE_SPILL_RECORD_HEADER  2
+
+
+void Queue_element_spill_writer::writeUInt8(uint8_t value) {
+  _data.push_back(value);
+}
+
+void Queue_element_spill_writer::writeUInt16(uint16_t value) {
+  _data.push_back(value & 0xFF);
+  _data.push_back(value >> 8);
+}
+
+void Queue_element_spill_writer::writeInt32(int32_t value) {
+  const uint32_t uvalue = static_cast<uint32_t>(value);
+
+  writeUInt16(uvalue & 0xFFFF);
+  writeUInt16(uvalue >> 16);
+}
+
+void Queue_element_spill_writer::writeString(const String& str) {
+  const size_t length = str.length() > 0xFFFF ? 0xFFFF : str.length();
+
+  writeUInt16(length);
+
+  for (size_t i = 0; i < length; ++i) {
+    _data.push_back(static_cast<uint8_t>(str[i]));
+  }
+}
+
+bool Queue_element_spill_reader::readUInt8(uint8_t& value) {
+  if (_pos >= _end) {
+    return false;
+  }
+  value = *_pos;
+  ++_pos;
+  return true;
+}
+
+bool Queue_element_spill_reader::readUInt16(uint16_t& value) {
+  uint8_t low  = 0;
+  uint8_t high = 0;
+
+  if (!readUInt8(low) || !readUInt8(high)) {
+    return false;
+  }
+  value = (static_cast<uint16_t>(high) << 8) | low;
+  return true;
+}
+
+bool Queue_element_spill_reader::readInt32(int32_t& value) {
+  uint16_t low  = 0;
+  uint16_t high = 0;
+
+  if (!readUInt16(low) || !readUInt16(high)) {
+    return false;
+  }
+  value = static_cast<int32_t>((static_cast<uint32_t>(high) << 16) | low);
+  return true;
+}
+
+bool Queue_element_spill_reader::readString(String& str) {
+  uint16_t length = 0;
+
+  if (!readUInt16(length) || (static_cast<size_t>(_end - _pos) < length)) {
+    return false;
+  }
+  str.clear();
+
+  if (!str.reserve(length)) {
+    return false;
+  }
+
+  for (uint16_t i = 0; i < length; ++i) {
+    str += static_cast<char>(_pos[i]);
+  }
+  _pos += length;
+  return true;
+}
+
+std::unique_ptr<Queue_element_base>deserializeQueueElement(const uint8_t *data, size_t size) {
+  Queue_element_spill_reader reader(data, size);
+  uint8_t elementType = 0;
+
+  if (!reader.readUInt8(elementType)) {
+    return nullptr;
+  }
+  std::unique_ptr<Queue_element_base> element;
+
+  switch (static_cast<Queue_element_type_e>(elementType)) {
+    case Queue_element_type_e::string_only:
+      element.reset(new (std::nothrow) simple_queue_element_string_only());
+      break;
+    case Queue_element_type_e::formatted_Strings:
+      element.reset(new (std::nothrow) SimpleQueueElement_formatted_Strings());
+      break;
+    case Queue_element_type_e::MQTT:
+# if FEATURE_MQTT
+      element.reset(new (std::nothrow) MQTT_queue_element());
+# endif // if FEATURE_MQTT
+      break;
+  }
+
+  if (element && !element->deserialize(reader)) {
+    element.reset();
+  }
+  return element;
+}
+
+
+ControllerQueueSpill::~ControllerQueueSpill() {
+  // Keep the collected elements, to be sent when the controller is started again.
+  flush();
+}
+
+void ControllerQueueSpill::setController(controllerIndex_t controller_idx, bool enabled) {
+  if ((controller_idx == _controller_idx) && (enabled == _enabled)) {
+    return;
+  }
+
+  if (_enabled) {
+    flush();
+  }
+  _writeBuffer.clear();
+  _controller_idx = controller_idx;
+  _enabled        = enabled && validControllerIndex(controller_idx);
+  _fileSize       = 0;
+  _readPos        = 0;
+  _count          = 0;
+  _fileCount      = 0;
+  _sealed         = false;
+
+  if (!validControllerIndex(controller_idx)) {
+    return;
+  }
+  const String fname = getFilename();
+
+  if (!fileExists(fname)) {
+    return;
+  }
+
+  if (!_enabled) {
+    tryDeleteFile(fname);
+    return;
+  }
+  fs::File file = tryOpenFile(fname, "r");
+
+  if (file) {
+    _fileSize = scanFile(file);
+    _sealed   = _fileSize != file.size();
+    file.close();
+  }
+
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    addLogMove(LOG_LEVEL_INFO, strformat(
+                 F("Controller-%d : %d queued messages in %s"),
+                 controller_idx + 1,
+                 static_cast<int>(_count),
+                 fname.c_str()));
+  }
+}
+
+bool ControllerQueueSpill::add(const Queue_element_base& element) {
+  if (!_enabled || (element._controller_idx != _controller_idx)) {
+    return false;
+  }
+  const size_t oldSize = _writeBuffer.size();
+
+  // Reserve room for the length of the record
+  _writeBuffer.resize(oldSize + CONTROLLER_QUEUE_SPILL_RECORD_HEADER);
+  Queue_element_spill_writer writer(_writeBuffer);
+  const bool serialized   = element.serialize(writer);
+  const size_t recordSize = _writeBuffer.size() - oldSize - CONTROLLER_QUEUE_SPILL_RECORD_HEADER;
+
+  if (!serialized || (recordSize > 0xFFFF)) {
+    _writeBuffer.resize(oldSize);
+    return false;
+  }
+
+  if (((_fileSize + _writeBuffer.size()) > CONTROLLER_QUEUE_SPILL_MAX_SIZE) ||
+      (_writeBuffer.size() > CONTROLLER_QUEUE_SPILL_MAX_BUFFER)) {
+    // Spill file is full, the caller must deal with the element.
+    _writeBuffer.resize(oldSize);
+    return false;
+  }
+  _writeBuffer[oldSize]     = recordSize & 0xFF;
+  _writeBuffer[oldSize + 1] = recordSize >> 8;
+
+  if (oldSize == 0) {
+    _bufferedSince = millis();
+  }
+  ++_count;
+
+  if (_writeBuffer.size() >= CONTROLLER_QUEUE_SPILL_FLUSH_SIZE) {
+    flush();
+  }
+  return true;
+}
+
+void ControllerQueueSpill::take_front(size_t maxCount, std::vector<std::unique_ptr<Queue_element_base> >& elements) {
+  if (!_enabled) {
+    return;
+  }
+  fs::File file;
+
+  while ((elements.size() < maxCount) && (_count > 0)) {
+    std::unique_ptr<Queue_element_base> element;
+
+    if (_readPos < _fileSize) {
+      if (!file) {
+        file = tryOpenFile(getFilename(), "r");
+
+        if (!file || !file.seek(_readPos)) {
+          // File is lost, continue with the elements in RAM.
+          dropFile(file);
+          continue;
+        }
+      }
+      uint8_t header[CONTROLLER_QUEUE_SPILL_RECORD_HEADER] = {};
+
+      if (file.read(header, CONTROLLER_QUEUE_SPILL_RECORD_HEADER) != CONTROLLER_QUEUE_SPILL_RECORD_HEADER) {
+        dropFile(file);
+        continue;
+      }
+      const size_t recordSize = (static_cast<size_t>(header[1]) << 8) | header[0];
+      std::vector<uint8_t> record(recordSize);
+
+      if (file.read(record.data(), recordSize) == recordSize) {
+        element = deserializeQueueElement(record.data(), recordSize);
+      }
+      _readPos += CONTROLLER_QUEUE_SPILL_RECORD_HEADER + recordSize;
+      --_fileCount;
+      --_count;
+
+      if (_readPos >= _fileSize) {
+        dropFile(file);
+      }
+    } else if (!take_front_from_buffer(element)) {
+      _count = 0;
+    }
+
+    if (element) {
+      elements.push_back(std::move(element));
+    }
+  }
+}
+
+void ControllerQueueSpill::dropFile(fs::File& file) {
+  if (file) {
+    file.close();
+  }
+  tryDeleteFile(getFilename());
+  _count    -= _fileCount;
+  _fileCount = 0;
+  _fileSize  = 0;
+  _readPos   = 0;
+  _sealed    = false;
+}
+
+bool ControllerQueueSpill::take_front_from_buffer(std::unique_ptr<Queue_element_base>& element) {
+  if (_writeBuffer.size() < CONTROLLER_QUEUE_SPILL_RECORD_HEADER) {
+    _writeBuffer.clear();
+    return false;
+  }
+  const size_t recordSize = (static_cast<size_t>(_writeBuffer[1]) << 8) | _writeBuffer[0];
+  const size_t totalSize  = CONTROLLER_QUEUE_SPILL_RECORD_HEADER + recordSize;
+
+  if (_writeBuffer.size() < totalSize) {
+    _writeBuffer.clear();
+    return false;
+  }
+  element = deserializeQueueElement(_writeBuffer.data() + CONTROLLER_QUEUE_SPILL_RECORD_HEADER, recordSize);
+  _writeBuffer.erase(_writeBuffer.begin(), _writeBuffer.begin() + totalSize);
+  --_count;
+  return true;
+}
+
+void ControllerQueueSpill::loop() {
+  if (_enabled && !_writeBuffer.empty() &&
+      (timePassedSince(_bufferedSince) >= CONTROLLER_QUEUE_SPILL_FLUSH_INTERVAL)) {
+    if (!flush()) {
+      // Try again later
+      _bufferedSince = millis();
+    }
+  }
+}
+
+bool ControllerQueueSpill::flush() {
+  if (!_enabled || _writeBuffer.empty()) {
+    return true;
+  }
+
+  if (_sealed ||
+      (SpiffsFreeSpace() < (_writeBuffer.size() + CONTROLLER_QUEUE_SPILL_MIN_FREE_SPACE))) {
+    return false;
+  }
+  fs::File file = tryOpenFile(getFilename(), "a");
+
+  if (!file) {
+    return false;
+  }
+  const size_t written = file.write(_writeBuffer.data(), _writeBuffer.size());
+
+  file.close();
+
+  if (written != _writeBuffer.size()) {
+    // An incomplete record may have been written
+    _sealed = true;
+    addLog(LOG_LEVEL_ERROR, concat(F("Controller queue : Could not write "), getFilename()));
+    return false;
+  }
+  _fileSize += written;
+  _fileCount = _count;
+  _writeBuffer.clear();
+  return true;
+}
+
+String ControllerQueueSpill::getFilename() const {
+  String fname;
+
+  fname.reserve(16);
+  # ifdef ESP32
+  fname = '/';
+  # endif // ifdef ESP32
+  fname += F("ctrlq_");
+  fname += String(_controller_idx + 1);
+  fname += F(".bin");
+  return fname;
+}
+
+size_t ControllerQueueSpill::scanFile(fs::File& file) {
+  const size_t fileSize = file.size();
+  size_t pos            = 0;
+
+  while ((pos + CONTROLLER_QUEUE_SPILL_RECORD_HEADER) <= fileSize) {
+    uint8_t header[CONTROLLER_QUEUE_SPILL_RECORD_HEADER] = {};
+
+    if (!file.seek(pos) ||
+        (file.read(header, CONTROLLER_QUEUE_SPILL_RECORD_HEADER) != CONTROLLER_QUEUE_SPILL_RECORD_HEADER)) {
+      break;
+    }
+    const size_t recordEnd = pos + CONTROLLER_QUEUE_SPILL_RECORD_HEADER +
+                             ((static_cast<size_t>(header[1]) << 8) | header[0]);
+
+    if (recordEnd > fileSize) {
+      break;
+    }
+    pos = recordEnd;
+    ++_fileCount;
+    ++_count;
+  }
+  return pos;
+}
+
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
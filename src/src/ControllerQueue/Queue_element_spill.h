@@ -0,0 +1,163 @@
+#ifndef CONTROLLERQUEUE_QUEUE_ELEMENT_SPILL_H
+#define CONTROLLERQUEUE_QUEUE_ELEMENT_SPILL_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+# include "../ControllerQueue/Queue_element_base.h"
+# include "../Helpers/FS_Helper.h"
+
+# include <memory>
+# include <vector>
+
+// Max. size of the spill file of a single controller
+# ifndef CONTROLLER_QUEUE_SPILL_MAX_SIZE
+#  define CONTROLLER_QUEUE_SPILL_MAX_SIZE        65536
+# endif // ifndef CONTROLLER_QUEUE_SPILL_MAX_SIZE
+
+// Spilled elements are collected in RAM and appended to the file in batches of this size
+# define CONTROLLER_QUEUE_SPILL_FLUSH_SIZE       1024
+
+// Max. time in msec to keep spilled elements in RAM before appending them to the file
+# define CONTROLLER_QUEUE_SPILL_FLUSH_INTERVAL   10000
+
+// Max. size of the spilled elements kept in RAM when they cannot be written to the file
+# define CONTROLLER_QUEUE_SPILL_MAX_BUFFER       4096
+
+// Min. free space to leave on the file system
+# define CONTROLLER_QUEUE_SPILL_MIN_FREE_SPACE   16384
+
+// Stored in the spill file, so do not change the values.
+enum class Queue_element_type_e : uint8_t {
+  string_only       = 1,
+  formatted_Strings = 2,
+  MQTT              = 3
+};
+
+
+/*********************************************************************************************\
+* Serialize queue elements to a byte buffer, to be stored in a spill file.
+\*********************************************************************************************/
+class Queue_element_spill_writer {
+public:
+
+  explicit Queue_element_spill_writer(std::vector<uint8_t>& data) : _data(data) {}
+
+  void writeUInt8(uint8_t value);
+  void writeUInt16(uint16_t value);
+  void writeInt32(int32_t value);
+
+  // Strings are truncated to 65535 bytes
+  void writeString(const String& str);
+
+private:
+
+  std::vector<uint8_t>& _data;
+};
+
+class Queue_element_spill_reader {
+public:
+
+  Queue_element_spill_reader(const uint8_t *data, size_t size) : _pos(data), _end(data + size) {}
+
+  // All read functions return false when reading past the end of the data.
+  bool readUInt8(uint8_t& value);
+  bool readUInt16(uint16_t& value);
+  bool readInt32(int32_t& value);
+  bool readString(String& str);
+
+private:
+
+  const uint8_t *_pos;
+  const uint8_t *_end;
+};
+
+// Create a queue element from a serialized record.
+// Return nullptr when the record is not valid.
+std::unique_ptr<Queue_element_base>deserializeQueueElement(const uint8_t *data,
+                                                           size_t         size);
+
+
+/*********************************************************************************************\
+* ControllerQueueSpill
+* Overflow tier of a controller queue, stored in a file per controller.
+* Elements which do not fit in the queue are appended to the file, and taken from the front
+* once the queue has room again. Thus the order of the elements is kept.
+* The file is only appended to, in batches, to limit flash wear.
+* When the file is fully read, it is deleted.
+*
+* File format: a sequence of records, each a 2 byte length followed by the serialized element.
+\*********************************************************************************************/
+class ControllerQueueSpill {
+public:
+
+  ControllerQueueSpill() = default;
+
+  ~ControllerQueueSpill();
+
+  // Set the controller of the queue.
+  // An existing spill file of this controller is used when enabled, or deleted when disabled.
+  void   setController(controllerIndex_t controller_idx,
+                       bool              enabled);
+
+  bool   enabled() const {
+    return _enabled;
+  }
+
+  controllerIndex_t getControllerIndex() const {
+    return _controller_idx;
+  }
+
+  // Nr of spilled elements
+  size_t size() const {
+    return _count;
+  }
+
+  bool empty() const {
+    return _count == 0;
+  }
+
+  // Return false when the element could not be spilled,
+  // e.g. when the element type cannot be stored, or the spill file is full.
+  bool add(const Queue_element_base& element);
+
+  // Take at most maxCount of the oldest spilled elements.
+  void take_front(size_t                                           maxCount,
+                  std::vector<std::unique_ptr<Queue_element_base> >& elements);
+
+  // Append the collected elements to the file when enough are collected, or kept for too long.
+  void loop();
+
+  // Append the collected elements to the file.
+  bool flush();
+
+private:
+
+  String getFilename() const;
+
+  // Count the complete records in the spill file.
+  // Return the size of the file up to the end of the last complete record.
+  size_t scanFile(fs::File& file);
+
+  bool   take_front_from_buffer(std::unique_ptr<Queue_element_base>& element);
+
+  // Delete the spill file and forget the elements which were not yet read from it.
+  void   dropFile(fs::File& file);
+
+  std::vector<uint8_t> _writeBuffer;
+  size_t               _fileSize = 0; // Size of the complete records in the file
+  size_t               _readPos  = 0;
+  size_t               _count    = 0; // Elements in the file and in RAM
+  size_t               _fileCount = 0; // Elements not yet read from the file
+  unsigned long        _bufferedSince = 0;
+  controllerIndex_t    _controller_idx = INVALID_CONTROLLER_INDEX;
+  bool                 _enabled = false;
+
+  // The file ends with an incomplete record, so nothing may be appended until it is fully read.
+  bool _sealed = false;
+};
+
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
+#endif // ifndef CONTROLLERQUEUE_QUEUE_ELEMENT_SPILL_H
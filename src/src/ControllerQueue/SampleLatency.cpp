@@ -0,0 +1,157 @@
+#include "../ControllerQueue/SampleLatency.h"
+
+#if FEATURE_SAMPLE_LATENCY
+
+# include "../ControllerQueue/Queue_element_base.h"
+# include "../Globals/Plugins.h"
+# include "../Helpers/ESPEasy_time_calc.h"
+
+# if FEATURE_CONTROLLER_QUEUE_TASK
+#  include "../Helpers/ESPEasyMutex.h"
+# endif // if FEATURE_CONTROLLER_QUEUE_TASK
+
+// Elements may be delivered from the controller queue task, so use fixed arrays
+// which never have to be reallocated.
+// The stats are written from either the main loop or the controller queue task and read from the main loop.
+// Guarded by sampleLatency_mutex, getters return a copy taken while holding the lock.
+static SampleLatencyStats sampleLatency_controllers[CONTROLLER_MAX];
+static SampleLatencyStats sampleLatency_tasks[TASKS_MAX];
+
+# if FEATURE_CONTROLLER_QUEUE_TASK
+static ESPEasy_Mutex sampleLatency_mutex;
+# endif // if FEATURE_CONTROLLER_QUEUE_TASK
+
+static void sampleLatency_lock()
+{
+# if FEATURE_CONTROLLER_QUEUE_TASK
+  sampleLatency_mutex.lock();
+# endif // if FEATURE_CONTROLLER_QUEUE_TASK
+}
+
+static void sampleLatency_unlock()
+{
+# if FEATURE_CONTROLLER_QUEUE_TASK
+  sampleLatency_mutex.unlock();
+# endif // if FEATURE_CONTROLLER_QUEUE_TASK
+}
+
+// Read time of the sample being sent by sendData(), 0 when not sending.
+static uint64_t sampleReadTime_usec = 0;
+
+void SampleLatencyStats::add(uint32_t latency_usec)
+{
+  if ((count == 0) || (latency_usec < min_usec)) {
+    min_usec = latency_usec;
+  }
+
+  if (latency_usec > max_usec) {
+    max_usec = latency_usec;
+  }
+  sum_usec += latency_usec;
+  ++count;
+
+  uint8_t bucket = 0;
+
+  while ((bucket < (SAMPLE_LATENCY_NR_BUCKETS - 1)) && (latency_usec > getBucketUpperBound(bucket))) {
+    ++bucket;
+  }
+
+  if (buckets[bucket] < 0xFFFF) {
+    ++buckets[bucket];
+  }
+}
+
+uint32_t SampleLatencyStats::getAverage() const
+{
+  if (count == 0) { return 0; }
+  return sum_usec / count;
+}
+
+uint32_t SampleLatencyStats::getP99() const
+{
+  uint32_t total = 0;
+
+  for (uint8_t i = 0; i < SAMPLE_LATENCY_NR_BUCKETS; ++i) {
+    total += buckets[i];
+  }
+
+  // Smallest bucket for which at most 1% of the samples is larger
+  const uint32_t threshold = total - (total / 100);
+  uint32_t cumulative      = 0;
+
+  for (uint8_t i = 0; i < (SAMPLE_LATENCY_NR_BUCKETS - 1); ++i) {
+    cumulative += buckets[i];
+
+    if (cumulative >= threshold) {
+      const uint32_t upperBound = getBucketUpperBound(i);
+      return (upperBound < max_usec) ? upperBound : max_usec;
+    }
+  }
+  return max_usec;
+}
+
+uint32_t SampleLatencyStats::getBucketUpperBound(uint8_t bucket)
+{
+  return 1000ul << bucket;
+}
+
+SampleReadTimeScope::SampleReadTimeScope(uint64_t readTime_usec)
+  : _prevReadTime(sampleReadTime_usec)
+{
+  sampleReadTime_usec = (readTime_usec != 0) ? readTime_usec : getMicros64();
+}
+
+SampleReadTimeScope::~SampleReadTimeScope()
+{
+  sampleReadTime_usec = _prevReadTime;
+}
+
+uint64_t SampleReadTimeScope::getReadTime()
+{
+  return (sampleReadTime_usec != 0) ? sampleReadTime_usec : getMicros64();
+}
+
+void SampleLatency_delivered(const Queue_element_base& element)
+{
+  const int64_t latency = usecPassedSince(element._readTime_usec);
+
+  if (latency < 0) { return; }
+  const uint32_t latency_usec = (latency < 0xFFFFFFFF) ? latency : 0xFFFFFFFF;
+
+  sampleLatency_lock();
+
+  if (validControllerIndex(element._controller_idx)) {
+    sampleLatency_controllers[element._controller_idx].add(latency_usec);
+  }
+
+  if (validTaskIndex(element._taskIndex)) {
+    sampleLatency_tasks[element._taskIndex].add(latency_usec);
+  }
+  sampleLatency_unlock();
+}
+
+SampleLatencyStats SampleLatency_getController(controllerIndex_t controllerIndex)
+{
+  SampleLatencyStats res;
+
+  if (validControllerIndex(controllerIndex)) {
+    sampleLatency_lock();
+    res = sampleLatency_controllers[controllerIndex];
+    sampleLatency_unlock();
+  }
+  return res;
+}
+
+SampleLatencyStats SampleLatency_getTask(taskIndex_t taskIndex)
+{
+  SampleLatencyStats res;
+
+  if (validTaskIndex(taskIndex)) {
+    sampleLatency_lock();
+    res = sampleLatency_tasks[taskIndex];
+    sampleLatency_unlock();
+  }
+  return res;
+}
+
+#endif // if FEATURE_SAMPLE_LATENCY
@@ -0,0 +1,75 @@
+#ifndef CONTROLLERQUEUE_SAMPLELATENCY_H
+#define CONTROLLERQUEUE_SAMPLELATENCY_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_SAMPLE_LATENCY
+
+# include "../DataTypes/ControllerIndex.h"
+# include "../DataTypes/TaskIndex.h"
+
+class Queue_element_base;
+
+// Bucket N counts latencies up to (1 msec << N), the last bucket counts all larger latencies.
+# define SAMPLE_LATENCY_NR_BUCKETS  17
+
+/*********************************************************************************************\
+* SampleLatencyStats
+* Time from reading a sample (PLUGIN_READ) until it was delivered by the controller.
+\*********************************************************************************************/
+struct SampleLatencyStats {
+  void     add(uint32_t latency_usec);
+
+  bool     isEmpty() const {
+    return count == 0;
+  }
+
+  uint32_t getAverage() const;
+
+  // Upper bound of the bucket holding the 99th percentile, limited to the max. latency.
+  uint32_t getP99() const;
+
+  static uint32_t getBucketUpperBound(uint8_t bucket);
+
+  uint64_t sum_usec{};
+  uint32_t count{};
+  uint32_t min_usec{};
+  uint32_t max_usec{};
+  uint16_t buckets[SAMPLE_LATENCY_NR_BUCKETS]{}; // Saturates at 0xFFFF
+};
+
+/*********************************************************************************************\
+* SampleReadTimeScope
+* Keep the read time of the sample being sent by sendData(),
+* so queue elements created for it get the read time of the sample instead of the time they were created.
+\*********************************************************************************************/
+class SampleReadTimeScope {
+public:
+
+  // A read time of 0 means the time the scope was created.
+  explicit SampleReadTimeScope(uint64_t readTime_usec);
+  ~SampleReadTimeScope();
+
+  SampleReadTimeScope(const SampleReadTimeScope&)            = delete;
+  SampleReadTimeScope& operator=(const SampleReadTimeScope&) = delete;
+
+  // Read time of the sample being sent, or the current time when not sending a sample.
+  static uint64_t getReadTime();
+
+private:
+
+  uint64_t _prevReadTime;
+};
+
+// Record the latency of a queue element, which was just delivered by the controller.
+// May be called from the controller queue task.
+void               SampleLatency_delivered(const Queue_element_base& element);
+
+// Return a copy, as the stats may be updated by the controller queue task while being used.
+SampleLatencyStats SampleLatency_getController(controllerIndex_t controllerIndex);
+
+SampleLatencyStats SampleLatency_getTask(taskIndex_t taskIndex);
+
+#endif // if FEATURE_SAMPLE_LATENCY
+
+#endif // ifndef CONTROLLERQUEUE_SAMPLELATENCY_H
@@ -1,5 +1,9 @@
 #include "../ControllerQueue/SimpleQueueElement_formatted_Strings.h"
 
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+# include "../ControllerQueue/Queue_element_spill.h"
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
 #include "../DataStructs/ESPEasy_EventStruct.h"
 #include "../Helpers/StringConverter.h"
 
@@ -39,6 +43,9 @@ SimpleQueueElement_formatted_Strings::SimpleQueueElement_formatted_Strings(Simpl
   valuesSent(rval.valuesSent), valueCount(rval.valueCount)
 {
   _timestamp      = rval._timestamp;
+#if FEATURE_SAMPLE_LATENCY
+  _readTime_usec  = rval._readTime_usec;
+#endif // if FEATURE_SAMPLE_LATENCY
   _controller_idx = rval._controller_idx;
   _taskIndex      = rval._taskIndex;
   #ifdef USE_SECOND_HEAP
@@ -53,6 +60,9 @@ SimpleQueueElement_formatted_Strings::SimpleQueueElement_formatted_Strings(Simpl
 SimpleQueueElement_formatted_Strings& SimpleQueueElement_formatted_Strings::operator=(SimpleQueueElement_formatted_Strings&& rval) {
   idx             = rval.idx;
   _timestamp      = rval._timestamp;
+#if FEATURE_SAMPLE_LATENCY
+  _readTime_usec  = rval._readTime_usec;
+#endif // if FEATURE_SAMPLE_LATENCY
   _taskIndex      = rval._taskIndex;
   _controller_idx = rval._controller_idx;
   sensorType      = rval.sensorType;
@@ -107,3 +117,53 @@ bool SimpleQueueElement_formatted_Strings::isDuplicate(const Queue_element_base&
   }
   return true;
 }
+
+uint32_t SimpleQueueElement_formatted_Strings::getContentHash() const {
+  uint32_t hash = hashAdd(hashBase(), static_cast<uint32_t>(_taskIndex));
+
+  hash = hashAdd(hash, static_cast<uint32_t>(sensorType));
+  hash = hashAdd(hash, static_cast<uint32_t>(valueCount));
+  hash = hashAdd(hash, static_cast<uint32_t>(idx));
+
+  for (uint8_t i = 0; i < VARS_PER_TASK; ++i) {
+    hash = hashAdd(hash, txt[i]);
+  }
+  return hash;
+}
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+bool SimpleQueueElement_formatted_Strings::serialize(Queue_element_spill_writer& writer) const {
+  serializeBase(writer, static_cast<uint8_t>(Queue_element_type_e::formatted_Strings));
+  writer.writeInt32(idx);
+  writer.writeUInt8(static_cast<uint8_t>(sensorType));
+  writer.writeUInt8(valuesSent);
+  writer.writeUInt8(valueCount);
+
+  for (uint8_t i = 0; i < VARS_PER_TASK; ++i) {
+    writer.writeString(txt[i]);
+  }
+  return true;
+}
+
+bool SimpleQueueElement_formatted_Strings::deserialize(Queue_element_spill_reader& reader) {
+  int32_t value_idx        = 0;
+  uint8_t value_sensorType = 0;
+
+  if (!deserializeBase(reader) ||
+      !reader.readInt32(value_idx) ||
+      !reader.readUInt8(value_sensorType) ||
+      !reader.readUInt8(valuesSent) ||
+      !reader.readUInt8(valueCount)) {
+    return false;
+  }
+  idx        = value_idx;
+  sensorType = static_cast<Sensor_VType>(value_sensorType);
+
+  for (uint8_t i = 0; i < VARS_PER_TASK; ++i) {
+    if (!reader.readString(txt[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
@@ -1,5 +1,9 @@
 #include "../ControllerQueue/SimpleQueueElement_string_only.h"
 
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+# include "../ControllerQueue/Queue_element_spill.h"
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
 
 simple_queue_element_string_only::simple_queue_element_string_only(int ctrl_idx, taskIndex_t TaskIndex,  String&& req)
 {
@@ -33,3 +37,19 @@ bool simple_queue_element_string_only::isDuplicate(const Queue_element_base& oth
   }
   return true;
 }
+
+uint32_t simple_queue_element_string_only::getContentHash() const {
+  return hashAdd(hashAdd(hashBase(), static_cast<uint32_t>(_taskIndex)), txt);
+}
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+bool simple_queue_element_string_only::serialize(Queue_element_spill_writer& writer) const {
+  serializeBase(writer, static_cast<uint8_t>(Queue_element_type_e::string_only));
+  writer.writeString(txt);
+  return true;
+}
+
+bool simple_queue_element_string_only::deserialize(Queue_element_spill_reader& reader) {
+  return deserializeBase(reader) && reader.readString(txt);
+}
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
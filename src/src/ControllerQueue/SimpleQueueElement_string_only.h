@@ -31,6 +31,14 @@ public:
 
   bool                      isDuplicate(const Queue_element_base& other) const;
 
+  uint32_t                  getContentHash() const;
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+  bool                      serialize(Queue_element_spill_writer& writer) const;
+
+  bool                      deserialize(Queue_element_spill_reader& reader);
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
   const UnitMessageCount_t* getUnitMessageCount() const {
     return nullptr;
   }
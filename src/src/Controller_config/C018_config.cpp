@@ -52,6 +52,7 @@ void C018_ConfigStruct::reset() {
   rx2_freq      = 0;
   stackVersion  = RN2xx3_datatypes::TTN_stack_version::TTN_v3;
   joinmethod    = C018_USE_OTAA;
+  combineUplinks = 0;
 }
 
 void C018_ConfigStruct::webform_load(C018_data_struct *C018_data) {
@@ -109,6 +110,8 @@ void C018_ConfigStruct::webform_load(C018_data_struct *C018_data) {
 
   addFormNumericBox(F("Spread Factor"), F("sf"), sf, 7, 12);
   addFormCheckBox(F("Adaptive Data Rate (ADR)"), F("adr"), adr);
+  addFormCheckBox(F("Combine Messages"), F("combine"), combineUplinks);
+  addFormNote(F("Combine queued messages in a single uplink, sent on Port + 1"));
 
 
   addTableSeparator(F("Serial Port Configuration"), 2, 3);
@@ -162,6 +165,20 @@ void C018_ConfigStruct::webform_load(C018_data_struct *C018_data) {
     addRowLabel(F("Data Rate"));
     addHtml(C018_data->getDataRate());
 
+    addRowLabel(F("Max. Payload"));
+    addHtmlInt(C018_data->getMaxPayload());
+    addUnit(F("byte"));
+
+    {
+      const float airtime = C018_data->getRemainingAirtime();
+
+      if (airtime >= 0.0f) {
+        addRowLabel(F("Air Time Budget"));
+        addHtmlFloat(airtime / 1000.0f, 1);
+        addUnit(F("sec"));
+      }
+    }
+
     {
       RN2xx3_status status = C018_data->getStatus();
 
@@ -198,6 +215,7 @@ void C018_ConfigStruct::webform_save() {
   joinmethod    = getFormItemInt(F("joinmethod"), joinmethod);
   stackVersion  = getFormItemInt(F("ttnstack"), stackVersion);
   adr           = isFormItemChecked(F("adr"));
+  combineUplinks = isFormItemChecked(F("combine"));
   serialHelper_webformSave(serialPort, rxpin, txpin);
 }
 
@@ -47,6 +47,7 @@ struct C018_ConfigStruct
   uint8_t       stackVersion                                    = RN2xx3_datatypes::TTN_stack_version::TTN_v2;
   uint8_t       adr                                             = 0;
   uint32_t      rx2_freq                                        = 0;
+  uint8_t       combineUplinks                                  = 0;
 };
 
 
@@ -128,6 +128,10 @@ bool C018_data_struct::setFrequencyPlan(RN2xx3_datatypes::Freq_plan plan, uint32
   if (!isInitialized()) { return false; }
   bool res = myLora->setFrequencyPlan(plan, rx2_freq);
 
+  _freqPlan          = plan;
+  _airtimeBudget     = getAirtimeCapacity();
+  _airtimeBudgetTime = millis();
+
   C018_logError(F("setFrequencyPlan()"));
   return res;
 }
@@ -136,6 +140,8 @@ bool C018_data_struct::setSF(uint8_t sf) {
   if (!isInitialized()) { return false; }
   bool res = myLora->setSF(sf);
 
+  _sf = sf;
+
   C018_logError(F("setSF()"));
   return res;
 }
@@ -144,6 +150,8 @@ bool C018_data_struct::setAdaptiveDataRate(bool enabled) {
   if (!isInitialized()) { return false; }
   bool res = myLora->setAdaptiveDataRate(enabled);
 
+  _adr = enabled;
+
   C018_logError(F("setAdaptiveDataRate()"));
   return res;
 }
@@ -285,6 +293,82 @@ float C018_data_struct::getLoRaAirTime(uint8_t pl) const {
   return -1.0;
 }
 
+uint8_t C018_data_struct::getMaxPayload() const {
+  // LoRaWAN Regional Parameters, max. application payload size per data rate
+  const uint8_t sf = _adr ? 12 : _sf;
+
+  if (_freqPlan == RN2xx3_datatypes::Freq_plan::TTN_US) {
+    switch (sf) {
+      case 7:  return 242;
+      case 8:  return 125;
+      case 9:  return 53;
+      default: return 11;
+    }
+  }
+
+  if (sf <= 8) { return 222; }
+
+  if (sf == 9) { return 115; }
+  return 51;
+}
+
+float C018_data_struct::getAirtimeCapacity() const {
+  uint8_t subBands = 1;
+
+  switch (_freqPlan) {
+    case RN2xx3_datatypes::Freq_plan::TTN_EU:
+      // 867.1 - 867.9 MHz and 868.1 - 868.5 MHz
+      subBands = 2;
+      break;
+    case RN2xx3_datatypes::Freq_plan::TTN_US:
+      // No duty cycle limit, only a max. dwell time
+      return 0.0f;
+    default:
+      break;
+  }
+  return static_cast<float>(subBands) * (C018_DUTY_CYCLE_WINDOW / 100) * C018_DUTY_CYCLE_PCT;
+}
+
+void C018_data_struct::updateAirtimeBudget() {
+  const float capacity = getAirtimeCapacity();
+
+  _airtimeBudget    += (timePassedSince(_airtimeBudgetTime) * capacity) / C018_DUTY_CYCLE_WINDOW;
+  _airtimeBudgetTime = millis();
+
+  if (_airtimeBudget > capacity) {
+    _airtimeBudget = capacity;
+  }
+}
+
+float C018_data_struct::getRemainingAirtime() {
+  if (getAirtimeCapacity() <= 0.0f) {
+    return -1.0f;
+  }
+  updateAirtimeBudget();
+  return _airtimeBudget;
+}
+
+unsigned long C018_data_struct::getAirtimeWait(float airtime_ms) {
+  const float capacity = getAirtimeCapacity();
+
+  if (capacity <= 0.0f) {
+    return 0;
+  }
+  updateAirtimeBudget();
+
+  if (_airtimeBudget >= airtime_ms) {
+    return 0;
+  }
+  return static_cast<unsigned long>(((airtime_ms - _airtimeBudget) * C018_DUTY_CYCLE_WINDOW) / capacity) + 1;
+}
+
+void C018_data_struct::useAirtime(float airtime_ms) {
+  if (getAirtimeCapacity() > 0.0f) {
+    updateAirtimeBudget();
+    _airtimeBudget -= airtime_ms;
+  }
+}
+
 void C018_data_struct::async_loop() {
   if (isInitialized()) {
     rn2xx3_handler::RN_state state = myLora->async_loop();
@@ -7,6 +7,10 @@
 
 # include <rn2xx3.h>
 
+// Duty cycle limit per sub-band (EU868: 1%), applied over this time window in msec
+# define C018_DUTY_CYCLE_PCT     1
+# define C018_DUTY_CYCLE_WINDOW  3600000
+
 
 struct C018_data_struct {
 private:
@@ -103,10 +107,36 @@ public:
 
   float   getLoRaAirTime(uint8_t pl) const;
 
-  void    async_loop();
+  // Max. application payload size in bytes for the configured spreading factor.
+  // With ADR the lowest data rate is assumed, as the network may lower it at any time.
+  uint8_t getMaxPayload() const;
+
+  // Air time left of the duty cycle budget in msec, or -1 when the frequency plan has no duty cycle limit.
+  // The module picks the channel, so the budget is the sum of all sub-bands used by the frequency plan.
+  float         getRemainingAirtime();
+
+  // Time in msec until the budget allows sending a message with this air time, 0 = send now.
+  unsigned long getAirtimeWait(float airtime_ms);
+
+  void          useAirtime(float airtime_ms);
+
+  void          setCombineUplinks(bool combine) {
+    _combineUplinks = combine;
+  }
+
+  bool          combineUplinks() const {
+    return _combineUplinks;
+  }
+
+  void          async_loop();
 
 private:
 
+  // Duty cycle budget when full, in msec air time
+  float getAirtimeCapacity() const;
+
+  void  updateAirtimeBudget();
+
   void triggerAutobaud();
 
   ESPeasySerial *C018_easySerial = nullptr;
@@ -119,8 +149,19 @@ private:
   taskIndex_t    sampleSetInitiator = INVALID_TASK_INDEX;
   int8_t         _resetPin          = -1;
   bool           autobaud_success   = false;
+
+  RN2xx3_datatypes::Freq_plan _freqPlan = RN2xx3_datatypes::Freq_plan::TTN_EU;
+  uint8_t                     _sf       = 7;
+  bool                        _adr      = false;
+  bool                        _combineUplinks = false;
+
+  float         _airtimeBudget     = 0.0f; // msec
+  unsigned long _airtimeBudgetTime = 0;
 };
 
+// Remaining duty cycle air time in msec of the active C018 controller, -1 when not limited or not active.
+float C018_getRemainingAirtime();
+
 #endif // ifdef USES_C018
 
 #endif // ifndef CONTROLLER_STRUCT_C018_DATA_STRUCT_H
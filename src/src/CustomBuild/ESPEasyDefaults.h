@@ -234,6 +234,9 @@
 #ifndef DEFAULT_I2C_CLOCK_SPEED_SLOW
 #define DEFAULT_I2C_CLOCK_SPEED_SLOW      100000            // Use 100 kHz for old/slow I2C chips
 #endif
+#ifndef DEFAULT_I2C2_CLOCK_SPEED
+#define DEFAULT_I2C2_CLOCK_SPEED          100000            // 2nd I2C bus (ESP32), typically used for slow devices
+#endif
 #ifndef FEATURE_I2C_DEVICE_SCAN
 #define FEATURE_I2C_DEVICE_SCAN           1                 // Show device name in I2C scan
 #endif
@@ -296,6 +299,9 @@
 #ifndef DEFAULT_RULES_OLDENGINE
 #define DEFAULT_RULES_OLDENGINE                true
 #endif
+#ifndef DEFAULT_RULES_EVENT_BUDGET
+#define DEFAULT_RULES_EVENT_BUDGET             5000    // Max. time in usec spent on processing queued events per loop
+#endif
 
 #ifndef DEFAULT_MQTT_RETAIN
 #define DEFAULT_MQTT_RETAIN                     false   // (true|false) Retain MQTT messages?
@@ -153,6 +153,16 @@
 #ifndef UDP_PACKETSIZE_MAX
   #define UDP_PACKETSIZE_MAX               256 // Currently only needed for C013_Receive
 #endif
+#ifndef UDP_RECEIVE_POOL_SIZE
+  #ifdef ESP8266
+    #define UDP_RECEIVE_POOL_SIZE            4 // Max. nr of UDP packets read per checkUDP() call
+  #else
+    #define UDP_RECEIVE_POOL_SIZE            8
+  #endif
+#endif
+#ifndef UDP_RECEIVE_TIME_BUDGET
+  #define UDP_RECEIVE_TIME_BUDGET           10 // msec, stop reading UDP packets in checkUDP() after this time
+#endif
 #ifndef TIMER_GRATUITOUS_ARP_MAX
   #define TIMER_GRATUITOUS_ARP_MAX           5000
 #endif
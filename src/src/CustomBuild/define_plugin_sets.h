@@ -2629,6 +2629,24 @@ To create/register a plugin, you have to :
   #define FEATURE_TIMING_STATS  0
 #endif
 
+// Rules profiling is shown along with the timing stats
+#ifndef FEATURE_RULES_PROFILING
+  #define FEATURE_RULES_PROFILING  FEATURE_TIMING_STATS
+#endif
+#if FEATURE_RULES_PROFILING && !FEATURE_TIMING_STATS
+  #undef FEATURE_RULES_PROFILING
+  #define FEATURE_RULES_PROFILING  0
+#endif
+
+// Plugin call stack/duration stats are shown along with the timing stats
+#ifndef FEATURE_PLUGIN_CALL_STATS
+  #define FEATURE_PLUGIN_CALL_STATS  FEATURE_TIMING_STATS
+#endif
+#if FEATURE_PLUGIN_CALL_STATS && !FEATURE_TIMING_STATS
+  #undef FEATURE_PLUGIN_CALL_STATS
+  #define FEATURE_PLUGIN_CALL_STATS  0
+#endif
+
 
 #ifdef BUILD_NO_DEBUG
   #ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
@@ -2909,6 +2927,19 @@ To create/register a plugin, you have to :
 #define FEATURE_PLUGIN_STATS                  0
 #endif
 
+// Downsampled 1-minute and 15-minute history per task value, uses ~2.5k RAM per task value with stats enabled
+#ifndef FEATURE_PLUGIN_STATS_HISTORY
+  #if FEATURE_PLUGIN_STATS && defined(ESP32) && !defined(LIMIT_BUILD_SIZE)
+    #define FEATURE_PLUGIN_STATS_HISTORY      1
+  #else
+    #define FEATURE_PLUGIN_STATS_HISTORY      0
+  #endif
+#endif
+#if FEATURE_PLUGIN_STATS_HISTORY && !FEATURE_PLUGIN_STATS
+  #undef FEATURE_PLUGIN_STATS_HISTORY
+  #define FEATURE_PLUGIN_STATS_HISTORY        0
+#endif
+
 #ifndef FEATURE_REPORTING                     
 #define FEATURE_REPORTING                     0
 #endif
@@ -3141,6 +3172,356 @@ To create/register a plugin, you have to :
   #endif
 #endif
 
+#ifndef FEATURE_RULES_COMPILED
+  #ifdef LIMIT_BUILD_SIZE
+    #define FEATURE_RULES_COMPILED 0
+  #else
+    #define FEATURE_RULES_COMPILED 1
+  #endif
+#endif
+
+#ifndef FEATURE_TEMPLATE_CACHE
+  #ifdef LIMIT_BUILD_SIZE
+    #define FEATURE_TEMPLATE_CACHE 0
+  #else
+    #define FEATURE_TEMPLATE_CACHE 1
+  #endif
+#endif
+
+// Page templates split once in literal text and {{var}} segments
+#ifndef FEATURE_WEB_TEMPLATE_CACHE
+  #ifdef LIMIT_BUILD_SIZE
+    #define FEATURE_WEB_TEMPLATE_CACHE 0
+  #else
+    #define FEATURE_WEB_TEMPLATE_CACHE 1
+  #endif
+#endif
+
+#ifndef FEATURE_JSON_DELTA
+  #ifdef LIMIT_BUILD_SIZE
+    #define FEATURE_JSON_DELTA 0
+  #else
+    #define FEATURE_JSON_DELTA 1
+  #endif
+#endif
+
+// Lock free consistent copy of task values, for readers outside the main loop
+#ifndef FEATURE_TASKVALUE_SNAPSHOT
+  #ifdef ESP32
+    #define FEATURE_TASKVALUE_SNAPSHOT 1
+  #else
+    #define FEATURE_TASKVALUE_SNAPSHOT 0
+  #endif
+#endif
+
+// Per task I2C clock speed, optionally auto-tuned at task init
+#ifndef FEATURE_I2C_CLOCK_PROFILE
+  #if FEATURE_I2C_GET_ADDRESS && FEATURE_I2C_DEVICE_CHECK && !defined(LIMIT_BUILD_SIZE)
+    #define FEATURE_I2C_CLOCK_PROFILE 1
+  #else
+    #define FEATURE_I2C_CLOCK_PROFILE 0
+  #endif
+#endif
+
+// Queued non-blocking I2C transactions on the 2nd I2C controller of the ESP32
+#ifndef FEATURE_I2C_ASYNC
+  #if defined(ESP32) && !defined(ESP32C3) && !defined(LIMIT_BUILD_SIZE)
+    #define FEATURE_I2C_ASYNC 1
+  #else
+    #define FEATURE_I2C_ASYNC 0
+  #endif
+#endif
+
+// 1-Wire driver using the RMT peripheral of the ESP32, for Dallas plugins
+#ifndef FEATURE_DALLAS_RMT
+  #if defined(ESP32) && !defined(LIMIT_BUILD_SIZE) && (defined(USES_P004) || defined(USES_P080) || defined(USES_P100))
+    #define FEATURE_DALLAS_RMT 1
+  #else
+    #define FEATURE_DALLAS_RMT 0
+  #endif
+#endif
+
+// IR receive and transmit with the RMT peripheral of the ESP32
+// ESP32-C3 and ESP32-S2 have no RMT channels left next to Dallas 1-Wire and NeoPixelBus
+#ifndef FEATURE_IR_RMT
+  #if (defined(ESP32_CLASSIC) || defined(ESP32S3)) && (defined(USES_P016) || defined(USES_P035) || defined(USES_P088))
+    #define FEATURE_IR_RMT 1
+  #else
+    #define FEATURE_IR_RMT 0
+  #endif
+#endif
+
+// Pulse counting with the PCNT peripheral of the ESP32 (ESP32-C3 has no PCNT)
+#ifndef FEATURE_PULSE_PCNT
+  #if defined(ESP32) && !defined(ESP32C3) && !defined(LIMIT_BUILD_SIZE) && defined(USES_P003)
+    #define FEATURE_PULSE_PCNT 1
+  #else
+    #define FEATURE_PULSE_PCNT 0
+  #endif
+#endif
+
+// Quadrature decoding of the rotary encoder with the PCNT peripheral of the ESP32
+#ifndef FEATURE_ENCODER_PCNT
+  #if defined(ESP32) && !defined(ESP32C3) && defined(USES_P059)
+    #define FEATURE_ENCODER_PCNT 1
+  #else
+    #define FEATURE_ENCODER_PCNT 0
+  #endif
+#endif
+
+// Wake sensor plugins via the data-ready (DRDY/RDY/INT) output of the sensor instead of only polling
+#ifndef FEATURE_PLUGIN_DATA_READY_PIN
+  #ifdef LIMIT_BUILD_SIZE
+    #define FEATURE_PLUGIN_DATA_READY_PIN 0
+  #else
+    #define FEATURE_PLUGIN_DATA_READY_PIN 1
+  #endif
+#endif
+
+// Wake serial plugins from the ESP32 UART driver event task instead of only polling
+#ifndef FEATURE_SERIAL_RX_EVENT
+  #if defined(ESP32) && defined(PLUGIN_USES_SERIAL)
+    #define FEATURE_SERIAL_RX_EVENT 1
+  #else
+    #define FEATURE_SERIAL_RX_EVENT 0
+  #endif
+#endif
+
+// Period statistics (mean/min/max/jitter) of the edges counted by the pulse counter
+#ifndef FEATURE_PULSE_PERIOD_STATS
+  #if !defined(LIMIT_BUILD_SIZE) && defined(USES_P003)
+    #define FEATURE_PULSE_PERIOD_STATS 1
+  #else
+    #define FEATURE_PULSE_PERIOD_STATS 0
+  #endif
+#endif
+
+// P002: continuous ADC sampling using DMA (ESP32)
+#ifndef FEATURE_ADC_DMA
+  #if defined(ESP32) && !defined(LIMIT_BUILD_SIZE) && defined(USES_P002)
+    #define FEATURE_ADC_DMA 1
+  #else
+    #define FEATURE_ADC_DMA 0
+  #endif
+#endif
+
+// P001: handle switch input changes from a GPIO interrupt instead of polling
+#ifndef FEATURE_SWITCH_INTERRUPT
+  #if !defined(LIMIT_BUILD_SIZE) && defined(USES_P001)
+    #define FEATURE_SWITCH_INTERRUPT 1
+  #else
+    #define FEATURE_SWITCH_INTERRUPT 0
+  #endif
+#endif
+
+// Per task and controller: only send task values when changed more than a deadband
+#ifndef FEATURE_SEND_ON_CHANGE
+  #ifdef LIMIT_BUILD_SIZE
+    #define FEATURE_SEND_ON_CHANGE 0
+  #else
+    #define FEATURE_SEND_ON_CHANGE 1
+  #endif
+#endif
+
+// Read tasks with the same aligned read group back to back in a single scheduler slot
+#ifndef FEATURE_ALIGNED_READ_GROUP
+  #ifdef LIMIT_BUILD_SIZE
+    #define FEATURE_ALIGNED_READ_GROUP 0
+  #else
+    #define FEATURE_ALIGNED_READ_GROUP 1
+  #endif
+#endif
+
+// Keep the memory of PluginTaskData per task, so a task re-init does not fragment the heap
+#ifndef FEATURE_PLUGIN_TASKDATA_ARENA
+  #ifdef ESP8266
+    #define FEATURE_PLUGIN_TASKDATA_ARENA 1
+  #else
+    #define FEATURE_PLUGIN_TASKDATA_ARENA 0
+  #endif
+#endif
+
+#ifndef FEATURE_WEB_EVENT_STREAM
+  #ifdef LIMIT_BUILD_SIZE
+    #define FEATURE_WEB_EVENT_STREAM 0
+  #else
+    #define FEATURE_WEB_EVENT_STREAM 1
+  #endif
+#endif
+
+#ifndef FEATURE_TIMING_STATS_HISTOGRAM
+  #if defined(LIMIT_BUILD_SIZE) || defined(ESP8266_1M)
+    #define FEATURE_TIMING_STATS_HISTOGRAM 0
+  #else
+    #define FEATURE_TIMING_STATS_HISTOGRAM 1
+  #endif
+#endif
+
+#ifndef FEATURE_CONTROLLER_QUEUE_TASK
+  #if defined(ESP32) && !defined(LIMIT_BUILD_SIZE)
+    #define FEATURE_CONTROLLER_QUEUE_TASK 1
+  #else
+    #define FEATURE_CONTROLLER_QUEUE_TASK 0
+  #endif
+#endif
+
+#ifndef FEATURE_HTTP_KEEP_ALIVE
+  #if FEATURE_HTTP_CLIENT && !defined(LIMIT_BUILD_SIZE)
+    #define FEATURE_HTTP_KEEP_ALIVE 1
+  #else
+    #define FEATURE_HTTP_KEEP_ALIVE 0
+  #endif
+#endif
+
+#ifndef FEATURE_MQTT_CBOR_PAYLOAD
+  #if FEATURE_MQTT && !defined(LIMIT_BUILD_SIZE)
+    #define FEATURE_MQTT_CBOR_PAYLOAD 1
+  #else
+    #define FEATURE_MQTT_CBOR_PAYLOAD 0
+  #endif
+#endif
+
+#ifndef FEATURE_CONTROLLER_QUEUE_SPILL
+  #if defined(ESP32) && !defined(LIMIT_BUILD_SIZE)
+    #define FEATURE_CONTROLLER_QUEUE_SPILL 1
+  #else
+    #define FEATURE_CONTROLLER_QUEUE_SPILL 0
+  #endif
+#endif
+
+#ifndef FEATURE_MQTT_TLS
+  #if defined(ESP32) && FEATURE_MQTT && !defined(LIMIT_BUILD_SIZE)
+    #define FEATURE_MQTT_TLS 1
+  #else
+    #define FEATURE_MQTT_TLS 0
+  #endif
+#endif
+
+#ifndef FEATURE_DNS_CACHE
+  #ifdef LIMIT_BUILD_SIZE
+    #define FEATURE_DNS_CACHE 0
+  #else
+    #define FEATURE_DNS_CACHE 1
+  #endif
+#endif
+
+#ifndef FEATURE_C013_COMPACT_DATA
+  #ifdef LIMIT_BUILD_SIZE
+    #define FEATURE_C013_COMPACT_DATA 0
+  #else
+    #define FEATURE_C013_COMPACT_DATA 1
+  #endif
+#endif
+
+#ifndef FEATURE_CONTROLLER_ASYNC_CONNECT
+  #if defined(ESP32) && FEATURE_HTTP_KEEP_ALIVE
+    #define FEATURE_CONTROLLER_ASYNC_CONNECT 1
+  #else
+    #define FEATURE_CONTROLLER_ASYNC_CONNECT 0
+  #endif
+#endif
+
+#ifndef FEATURE_CONTROLLER_BACKOFF
+  #ifdef LIMIT_BUILD_SIZE
+    #define FEATURE_CONTROLLER_BACKOFF 0
+  #else
+    #define FEATURE_CONTROLLER_BACKOFF 1
+  #endif
+#endif
+
+#ifndef FEATURE_RTC_CACHE_COMPRESSION
+  #if FEATURE_RTC_CACHE_STORAGE && defined(USES_C016) && !defined(LIMIT_BUILD_SIZE)
+    #define FEATURE_RTC_CACHE_COMPRESSION 1
+  #else
+    #define FEATURE_RTC_CACHE_COMPRESSION 0
+  #endif
+#endif
+
+#ifndef FEATURE_RTC_CACHE_INDEX
+  #if FEATURE_RTC_CACHE_STORAGE && defined(USES_C016) && !defined(LIMIT_BUILD_SIZE)
+    #define FEATURE_RTC_CACHE_INDEX 1
+  #else
+    #define FEATURE_RTC_CACHE_INDEX 0
+  #endif
+#endif
+
+#ifndef FEATURE_SETTINGS_WRITEBACK
+  #ifdef BUILD_MINIMAL_OTA
+    #define FEATURE_SETTINGS_WRITEBACK 0
+  #else
+    #define FEATURE_SETTINGS_WRITEBACK 1
+  #endif
+#endif
+
+#ifndef FEATURE_SETTINGS_PSRAM_MIRROR
+  #if defined(ESP32) && !defined(LIMIT_BUILD_SIZE)
+    #define FEATURE_SETTINGS_PSRAM_MIRROR 1
+  #else
+    #define FEATURE_SETTINGS_PSRAM_MIRROR 0
+  #endif
+#endif
+
+#ifndef FEATURE_EXTRA_TASK_SETTINGS_LRU
+  #if defined(ESP32) && !defined(LIMIT_BUILD_SIZE)
+    #define FEATURE_EXTRA_TASK_SETTINGS_LRU 1
+  #else
+    #define FEATURE_EXTRA_TASK_SETTINGS_LRU 0
+  #endif
+#endif
+
+#ifndef FEATURE_SD_LOG_BUFFER
+  #if FEATURE_SD && !defined(LIMIT_BUILD_SIZE)
+    #define FEATURE_SD_LOG_BUFFER 1
+  #else
+    #define FEATURE_SD_LOG_BUFFER 0
+  #endif
+#endif
+
+#ifndef FEATURE_LOG_DEFERRED_FORMAT
+  #if defined(LIMIT_BUILD_SIZE) || defined(BUILD_MINIMAL_OTA)
+    #define FEATURE_LOG_DEFERRED_FORMAT 0
+  #else
+    #define FEATURE_LOG_DEFERRED_FORMAT 1
+  #endif
+#endif
+
+#ifndef FEATURE_SYSLOG_BUFFER
+  #if defined(LIMIT_BUILD_SIZE) || defined(BUILD_MINIMAL_OTA)
+    #define FEATURE_SYSLOG_BUFFER 0
+  #else
+    #define FEATURE_SYSLOG_BUFFER 1
+  #endif
+#endif
+
+#ifndef FEATURE_HEAP_TRACKER
+  #if defined(LIMIT_BUILD_SIZE) || defined(BUILD_MINIMAL_OTA)
+    #define FEATURE_HEAP_TRACKER 0
+  #else
+    #define FEATURE_HEAP_TRACKER 1
+  #endif
+#endif
+
+// Event tracer is downloaded from the timing stats pages
+#ifndef FEATURE_EVENT_TRACER
+  #if defined(ESP32) && !defined(LIMIT_BUILD_SIZE)
+    #define FEATURE_EVENT_TRACER  FEATURE_TIMING_STATS
+  #else
+    #define FEATURE_EVENT_TRACER  0
+  #endif
+#endif
+#if FEATURE_EVENT_TRACER && !FEATURE_TIMING_STATS
+  #undef FEATURE_EVENT_TRACER
+  #define FEATURE_EVENT_TRACER  0
+#endif
+
+#ifndef FEATURE_RULES_CALCULATE_CACHE
+  #ifdef LIMIT_BUILD_SIZE
+    #define FEATURE_RULES_CALCULATE_CACHE 0
+  #else
+    #define FEATURE_RULES_CALCULATE_CACHE 1
+  #endif
+#endif
+
 #ifndef FEATURE_CHART_STORAGE_LAYOUT
   #ifdef ESP32
     #define FEATURE_CHART_SETTINGS_FILE_LAYOUT 1
@@ -3154,6 +3535,72 @@ To create/register a plugin, you have to :
   #endif
 #endif
 
+// Deep sleep batch mode collects samples in the C016 cache while WiFi is off
+#ifndef FEATURE_DEEP_SLEEP_BATCH
+  #ifdef USES_C016
+    #define FEATURE_DEEP_SLEEP_BATCH 1
+  #else
+    #define FEATURE_DEEP_SLEEP_BATCH 0
+  #endif
+#endif
+#if FEATURE_DEEP_SLEEP_BATCH && !defined(USES_C016)
+  #undef FEATURE_DEEP_SLEEP_BATCH
+  #define FEATURE_DEEP_SLEEP_BATCH 0
+#endif
+
+// Boot timeline of the setup phases and task/controller init, shown on the sysinfo page
+#ifndef FEATURE_BOOT_PROFILER
+  #ifdef LIMIT_BUILD_SIZE
+    #define FEATURE_BOOT_PROFILER 0
+  #else
+    #define FEATURE_BOOT_PROFILER 1
+  #endif
+#endif
+
+// Time from reading a sample until delivered by the controller, per controller and per task
+#ifndef FEATURE_SAMPLE_LATENCY
+  #ifdef LIMIT_BUILD_SIZE
+    #define FEATURE_SAMPLE_LATENCY 0
+  #else
+    #define FEATURE_SAMPLE_LATENCY 1
+  #endif
+#endif
+
+// Keep what ran during loops taking longer than SLOW_LOOP_THRESHOLD_USEC, shown on the sysinfo page
+#ifndef FEATURE_SLOW_LOOP_DETECTOR
+  #ifdef LIMIT_BUILD_SIZE
+    #define FEATURE_SLOW_LOOP_DETECTOR 0
+  #else
+    #define FEATURE_SLOW_LOOP_DETECTOR 1
+  #endif
+#endif
+
+#ifndef FEATURE_BENCHMARK
+  #if defined(LIMIT_BUILD_SIZE) || defined(BUILD_NO_DIAGNOSTIC_COMMANDS)
+    #define FEATURE_BENCHMARK 0
+  #else
+    #define FEATURE_BENCHMARK 1
+  #endif
+#endif
+
+// ETag for pages which only change when settings are saved, the responses are kept in PSRAM when present
+#ifndef FEATURE_WEB_RESPONSE_CACHE
+  #ifdef LIMIT_BUILD_SIZE
+    #define FEATURE_WEB_RESPONSE_CACHE 0
+  #else
+    #define FEATURE_WEB_RESPONSE_CACHE 1
+  #endif
+#endif
+
+// Rendered values of system info labels which only change on boot, settings or network events
+#ifndef FEATURE_LABEL_VALUE_CACHE
+  #ifdef LIMIT_BUILD_SIZE
+    #define FEATURE_LABEL_VALUE_CACHE 0
+  #else
+    #define FEATURE_LABEL_VALUE_CACHE 1
+  #endif
+#endif
+
     
 
 
@@ -41,4 +41,41 @@ bool C013_SensorDataStruct::matchesSensorType(Sensor_VType sensor_type) const
   return sensorType == sensor_type;
 }
 
+# if FEATURE_C013_COMPACT_DATA
+
+static_assert(sizeof(C013_SensorDataMultiHeader) == 8, "C013_SensorDataMultiHeader is sent to other nodes, do not change its size");
+static_assert(sizeof(C013_SensorDataMultiEntry) == 5, "C013_SensorDataMultiEntry is sent to other nodes, do not change its size");
+
+bool C013_SensorDataMultiHeader::isValid() const
+{
+  return (header == 255) &&
+         (ID == C013_SENSOR_DATA_MULTI_ID) &&
+         (version == C013_SENSOR_DATA_MULTI_VERSION);
+}
+
+bool C013_SensorDataMultiEntry::isValid() const
+{
+  return validTaskIndex(sourceTaskIndex) &&
+         validTaskIndex(destTaskIndex);
+}
+
+uint8_t C013_SensorDataMultiEntry::nrValueSlots() const
+{
+  uint8_t res = 0;
+
+  for (uint8_t i = 0; i < VARS_PER_TASK; ++i) {
+    if (bitRead(changedMask, i)) { ++res; }
+  }
+  return res;
+}
+
+bool C013_RefreshRequestStruct::isValid() const
+{
+  return (header == 255) &&
+         (ID == C013_REFRESH_REQUEST_ID) &&
+         (version == C013_SENSOR_DATA_MULTI_VERSION);
+}
+
+# endif // if FEATURE_C013_COMPACT_DATA
+
 #endif // ifdef USES_C013
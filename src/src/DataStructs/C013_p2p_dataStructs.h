@@ -53,6 +53,71 @@ struct C013_SensorDataStruct
   TaskValues_Data_t values{};
 };
 
+# if FEATURE_C013_COMPACT_DATA
+
+// Marker 255,6 is reserved for "Data Format Version 1", see the C013 documentation.
+#  define C013_SENSOR_DATA_MULTI_ID     7
+#  define C013_REFRESH_REQUEST_ID       8
+#  define C013_SENSOR_DATA_MULTI_VERSION 1
+
+// Sensor data of multiple tasks in a single packet.
+// The header is followed by nrEntries of C013_SensorDataMultiEntry,
+// each followed by 4 bytes for every value slot set in its changedMask.
+struct C013_SensorDataMultiHeader
+{
+  C013_SensorDataMultiHeader() = default;
+
+  bool isValid() const;
+
+  uint8_t  header     = 255;
+  uint8_t  ID         = C013_SENSOR_DATA_MULTI_ID;
+  uint8_t  version    = C013_SENSOR_DATA_MULTI_VERSION;
+  uint8_t  sourceUnit = 0;
+  uint8_t  destUnit   = 0;
+  uint8_t  nrEntries  = 0;
+  uint16_t sequence   = 0; // Incremented per packet sent to a unit
+};
+
+struct C013_SensorDataMultiEntry
+{
+  // All value slots are included, so the receiver can apply them regardless of the values it already has.
+  static constexpr uint8_t FULL_UPDATE = 0x80;
+
+  // Bit 0 ... 3: the 4 byte value slot of TaskValues_Data_t following this entry.
+  // 64 bit values use 2 slots.
+  static constexpr uint8_t SLOT_MASK = 0x0F;
+
+  C013_SensorDataMultiEntry() = default;
+
+  bool    isValid() const;
+
+  uint8_t nrValueSlots() const;
+
+  taskIndex_t  sourceTaskIndex = INVALID_TASK_INDEX;
+  taskIndex_t  destTaskIndex   = INVALID_TASK_INDEX;
+  pluginID_t   deviceNumber    = INVALID_PLUGIN_ID;
+  Sensor_VType sensorType      = Sensor_VType::SENSOR_TYPE_NONE;
+  uint8_t      changedMask     = 0;
+};
+
+// Sent to a unit to request it to send compact sensor data,
+// starting with a full update of all values.
+// Sent on the first data received from a unit, or when a packet from the unit was missed.
+struct C013_RefreshRequestStruct
+{
+  C013_RefreshRequestStruct() = default;
+
+  bool isValid() const;
+
+  uint8_t header     = 255;
+  uint8_t ID         = C013_REFRESH_REQUEST_ID;
+  uint8_t version    = C013_SENSOR_DATA_MULTI_VERSION;
+  uint8_t sourceUnit = 0;
+  uint8_t destUnit   = 0;
+};
+
+# endif // if FEATURE_C013_COMPACT_DATA
+
 #endif // ifdef USES_C013
 
 #endif // DATASTRUCTS_C013_P2P_DATASTRUCTS_H
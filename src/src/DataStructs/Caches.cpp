@@ -2,16 +2,22 @@
 
 #include "../Globals/Device.h"
 #include "../Globals/ExtraTaskSettings.h"
+#include "../Globals/RulesCalculate.h"
 #include "../Globals/Settings.h"
 #include "../Globals/WiFi_AP_Candidates.h"
 
 #include "../Helpers/ESPEasy_Storage.h"
+#include "../Helpers/StringProvider.h"
+
+#include "../WebServer/Metrics.h"
 
 
 #ifdef PLUGIN_USES_SERIAL
 #include <ESPeasySerial.h>
 #endif
 
+#include <algorithm>
+
 void Caches::clearAllCaches()
 {
   clearAllButTaskCaches();
@@ -20,15 +26,57 @@ void Caches::clearAllCaches()
 
 void Caches::clearAllButTaskCaches() {
   clearFileCaches();
+  clearNonFileCaches();
+}
+
+void Caches::clearAllButTaskCaches(const String& changedFile) {
+  invalidateFileCache(patch_fname(changedFile));
+
+  // A changed rules file is parsed again in the background, the other rules files are kept in the cache.
+  clearNonFileCaches(!rulesHelper.invalidateRulesFile(changedFile));
+}
+
+void Caches::clearNonFileCaches(bool clearRulesCache) {
   WiFi_AP_Candidates.clearCache();
-  rulesHelper.closeAllFiles();
+
+  if (clearRulesCache) {
+    rulesHelper.closeAllFiles();
+    #if FEATURE_RULES_CALCULATE_CACHE
+
+    // Free the programs of expressions which may no longer be used by the rules
+    RulesCalculate.clearCache();
+    #endif // if FEATURE_RULES_CALCULATE_CACHE
+  }
+  #if FEATURE_TEMPLATE_CACHE
+  templateCache.clear();
+  #endif // if FEATURE_TEMPLATE_CACHE
+  #if FEATURE_WEB_RESPONSE_CACHE
+  webResponseCache.clear();
+  #endif // if FEATURE_WEB_RESPONSE_CACHE
+  #if FEATURE_WEB_TEMPLATE_CACHE
+
+  // Built-in templates depend on settings, like the CSS mode
+  webTemplateCache.clear();
+  #endif // if FEATURE_WEB_TEMPLATE_CACHE
+  #if FEATURE_LABEL_VALUE_CACHE
+  clearLabelValueCache(LabelVolatility::Settings);
+  #endif // if FEATURE_LABEL_VALUE_CACHE
 }
 
 void Caches::clearAllTaskCaches() {
   taskIndexName.clear();
   taskIndexValueName.clear();
   extraTaskSettings_cache.clear();
+  taskNamePool.clear();
+  #if FEATURE_EXTRA_TASK_SETTINGS_LRU
+  extraTaskSettings_LRU.clear();
+  #endif // if FEATURE_EXTRA_TASK_SETTINGS_LRU
+  enabledTasksValid = false;
   updateActiveTaskUseSerial0();
+  pluginCallSubscribersValid = false;
+  #ifdef WEBSERVER_METRICS
+  metrics_markDevicesDirty();
+  #endif // ifdef WEBSERVER_METRICS
 }
 
 void Caches::clearTaskCache(taskIndex_t TaskIndex) {
@@ -37,9 +85,18 @@ void Caches::clearTaskCache(taskIndex_t TaskIndex) {
   auto it = extraTaskSettings_cache.find(TaskIndex);
 
   if (it != extraTaskSettings_cache.end()) {
+    releaseTaskNames(it->second);
     extraTaskSettings_cache.erase(it);
   }
+  #if FEATURE_EXTRA_TASK_SETTINGS_LRU
+  extraTaskSettings_LRU.clear(TaskIndex);
+  #endif // if FEATURE_EXTRA_TASK_SETTINGS_LRU
+  enabledTasksValid = false;
   updateActiveTaskUseSerial0();
+  pluginCallSubscribersValid = false;
+  #ifdef WEBSERVER_METRICS
+  metrics_markDevicesDirty();
+  #endif // ifdef WEBSERVER_METRICS
 }
 
 void Caches::clearFileCaches()
@@ -48,6 +105,152 @@ void Caches::clearFileCaches()
   fileCacheClearMoment = 0;
 }
 
+void Caches::invalidateFileCache(const String& patched_fname)
+{
+  auto it = fileExistsMap.find(patched_fname);
+
+  if (it != fileExistsMap.end()) {
+    fileExistsMap.erase(it);
+  }
+
+  // Static web files are served with the moment of the last file cache clear
+  // as ETag and URL prefix, so browsers will fetch them again.
+  // Settings and cache files are not served as static file.
+  if (!patched_fname.endsWith(F(".dat"))
+      #if FEATURE_RTC_CACHE_STORAGE
+      && !isCacheFile(patched_fname)
+      #endif // if FEATURE_RTC_CACHE_STORAGE
+      ) {
+    fileCacheClearMoment = 0;
+    #if FEATURE_WEB_TEMPLATE_CACHE
+    webTemplateCache.invalidate(patched_fname);
+    #endif // if FEATURE_WEB_TEMPLATE_CACHE
+    #if FEATURE_WEB_RESPONSE_CACHE
+
+    // Pages may include this file, e.g. a custom CSS
+    webResponseCache.clear();
+    #endif // if FEATURE_WEB_RESPONSE_CACHE
+  }
+}
+
+const std::vector<taskIndex_t>* Caches::getPluginCallSubscribers(uint8_t function)
+{
+  PluginCallSubscription_e subscription;
+
+  if (!getPluginCallSubscription(function, subscription)) {
+    return nullptr;
+  }
+
+  if (!pluginCallSubscribersValid) {
+    updatePluginCallSubscribers();
+
+    if (!pluginCallSubscribersValid) {
+      return nullptr;
+    }
+  }
+  return &pluginCallSubscribers[static_cast<uint8_t>(subscription)];
+}
+
+void Caches::updatePluginCallSubscribers()
+{
+  for (size_t i = 0; i < NR_ELEMENTS(pluginCallSubscribers); ++i) {
+    pluginCallSubscribers[i].clear();
+  }
+
+  // Plugins are not yet known, so do not filter
+  if (getDeviceCount() <= 0) {
+    return;
+  }
+
+  for (taskIndex_t task = 0; task < TASKS_MAX; ++task) {
+    const deviceIndex_t DeviceIndex = getDeviceIndex_from_TaskIndex(task);
+
+    if (validDeviceIndex(DeviceIndex)) {
+      const uint8_t subscriptions = Device[DeviceIndex].PluginCallSubscriptions;
+
+      for (size_t i = 0; i < NR_ELEMENTS(pluginCallSubscribers); ++i) {
+        if (subscriptions & (1 << i)) {
+          pluginCallSubscribers[i].push_back(task);
+        }
+      }
+    }
+  }
+  pluginCallSubscribersValid = true;
+}
+
+const std::vector<taskIndex_t>& Caches::getEnabledTasks(EnabledTaskGroup_e group)
+{
+  if (!enabledTasksValid) {
+    updateEnabledTasks();
+  }
+  return enabledTasks[static_cast<uint8_t>(group)];
+}
+
+TaskIndexRange Caches::getEnabledTasks(pluginID_t pluginID)
+{
+  if (!enabledTasksValid) {
+    updateEnabledTasks();
+  }
+  TaskIndexRange res;
+
+  if (enabledTasksByPlugin.empty()) {
+    return res;
+  }
+  const taskIndex_t *first = &enabledTasksByPlugin[0];
+  const taskIndex_t *last  = first + enabledTasksByPlugin.size();
+
+  res._begin = std::lower_bound(first, last, pluginID, [](taskIndex_t task, pluginID_t id) {
+    return Settings.getPluginID_for_task(task).value < id.value;
+  });
+  res._end = std::upper_bound(res._begin, last, pluginID, [](pluginID_t id, taskIndex_t task) {
+    return id.value < Settings.getPluginID_for_task(task).value;
+  });
+  return res;
+}
+
+void Caches::updateEnabledTasks()
+{
+  for (size_t i = 0; i < NR_ELEMENTS(enabledTasks); ++i) {
+    enabledTasks[i].clear();
+  }
+  enabledTasksByPlugin.clear();
+
+  // Plugins are not yet known, so keep the lists empty and retry on the next call.
+  if (getDeviceCount() <= 0) {
+    return;
+  }
+
+  for (taskIndex_t task = 0; task < TASKS_MAX; ++task) {
+    const deviceIndex_t DeviceIndex = getDeviceIndex_from_TaskIndex(task);
+
+    if (Settings.TaskDeviceEnabled[task] && validDeviceIndex(DeviceIndex)) {
+      const DeviceStruct& device = Device[DeviceIndex];
+
+      enabledTasks[static_cast<uint8_t>(EnabledTaskGroup_e::All)].push_back(task);
+
+      if (device.Type == DEVICE_TYPE_I2C) {
+        enabledTasks[static_cast<uint8_t>(EnabledTaskGroup_e::I2C)].push_back(task);
+      }
+
+      if ((device.Type == DEVICE_TYPE_SERIAL) ||
+          (device.Type == DEVICE_TYPE_SERIAL_PLUS1)) {
+        enabledTasks[static_cast<uint8_t>(EnabledTaskGroup_e::Serial)].push_back(task);
+      }
+
+      if (device.PluginStats) {
+        enabledTasks[static_cast<uint8_t>(EnabledTaskGroup_e::PluginStats)].push_back(task);
+      }
+    }
+  }
+  enabledTasksByPlugin = enabledTasks[static_cast<uint8_t>(EnabledTaskGroup_e::All)];
+
+  // Stable sort to keep the tasks of the same plugin in order of task index
+  std::stable_sort(enabledTasksByPlugin.begin(), enabledTasksByPlugin.end(), [](taskIndex_t a, taskIndex_t b) {
+    return Settings.getPluginID_for_task(a).value < Settings.getPluginID_for_task(b).value;
+  });
+  enabledTasksValid = true;
+}
+
 bool Caches::matchChecksumExtraTaskSettings(taskIndex_t TaskIndex, const ChecksumType& checksum) const
 {
   if (validTaskIndex(TaskIndex)) {
@@ -68,34 +271,27 @@ void Caches::updateActiveTaskUseSerial0() {
 
   // Check to see if a task is enabled and using the pins we also use for receiving commands.
   // We're now receiving only from Serial0, so check if an enabled task is also using it.
-  for (taskIndex_t task = 0; task < TASKS_MAX; ++task)
+  for (const taskIndex_t task : getEnabledTasks(EnabledTaskGroup_e::Serial))
   {
-    const deviceIndex_t DeviceIndex = getDeviceIndex_from_TaskIndex(task);
+    const ESPEasySerialPort port = ESPeasySerialType::getSerialType(
+              static_cast<ESPEasySerialPort>(Settings.TaskDevicePort[task]),
+              Settings.TaskDevicePin1[task],
+              Settings.TaskDevicePin2[task]);
 
-    if (Settings.TaskDeviceEnabled[task] && validDeviceIndex(DeviceIndex)) {
-      if ((Device[DeviceIndex].Type == DEVICE_TYPE_SERIAL) ||
-          (Device[DeviceIndex].Type == DEVICE_TYPE_SERIAL_PLUS1)) {
-        const ESPEasySerialPort port = ESPeasySerialType::getSerialType(
-                  static_cast<ESPEasySerialPort>(Settings.TaskDevicePort[task]),
-                  Settings.TaskDevicePin1[task],
-                  Settings.TaskDevicePin2[task]);
-
-        // FIXME TD-er: Must not check for conflict with serial0, but for conflict with ESPEasy_Console.
-        #ifdef ESP32
-        if (port == ESPEasySerialPort::serial0) 
-        {
-          activeTaskUseSerial0 = true;
-        }
-        #endif
-        #ifdef ESP8266
-        if (port == ESPEasySerialPort::serial0_swap ||
-            port == ESPEasySerialPort::serial0) 
-        {
-          activeTaskUseSerial0 = true;
-        }
-        #endif
-      }
+    // FIXME TD-er: Must not check for conflict with serial0, but for conflict with ESPEasy_Console.
+    #ifdef ESP32
+    if (port == ESPEasySerialPort::serial0) 
+    {
+      activeTaskUseSerial0 = true;
+    }
+    #endif
+    #ifdef ESP8266
+    if (port == ESPEasySerialPort::serial0_swap ||
+        port == ESPEasySerialPort::serial0) 
+    {
+      activeTaskUseSerial0 = true;
     }
+    #endif
   }
 #endif
 }
@@ -118,12 +314,66 @@ String Caches::getTaskDeviceName(taskIndex_t TaskIndex)
     auto it = getExtraTaskSettings(TaskIndex);
 
     if (it != extraTaskSettings_cache.end()) {
-      return it->second.TaskDeviceName;
+      return taskNamePool.get(it->second.TaskDeviceName);
     }
   }
   return EMPTY_STRING;
 }
 
+bool Caches::matchTaskDeviceName(taskIndex_t TaskIndex, const String& name, uint32_t nameHash)
+{
+  if (validTaskIndex(TaskIndex)) {
+    auto it = getExtraTaskSettings(TaskIndex);
+
+    if (it != extraTaskSettings_cache.end()) {
+      return taskNamePool.equalsIgnoreCase(it->second.TaskDeviceName, name, nameHash);
+    }
+  }
+  return false;
+}
+
+bool Caches::matchTaskDeviceValueName(taskIndex_t TaskIndex, uint8_t rel_index, const String& name, uint32_t nameHash)
+{
+  if (validTaskIndex(TaskIndex) && (rel_index < VARS_PER_TASK)) {
+  #ifdef ESP8266
+
+    // Value names are not cached on ESP8266, so the hash alone cannot rule out a collision.
+    return name.equalsIgnoreCase(getTaskDeviceValueName(TaskIndex, rel_index));
+  #endif // ifdef ESP8266
+  #ifdef ESP32
+
+    auto it = getExtraTaskSettings(TaskIndex);
+
+    if (it != extraTaskSettings_cache.end()) {
+      return taskNamePool.equalsIgnoreCase(it->second.TaskDeviceValueNames[rel_index], name, nameHash);
+    }
+    #endif // ifdef ESP32
+  }
+  return false;
+}
+
+uint32_t Caches::taskNameHash(const String& name)
+{
+  return StringPool::hash(name);
+}
+
+uint32_t Caches::taskValueNameHash(const String& valueName, taskIndex_t TaskIndex)
+{
+  return taskValueNameHash(StringPool::hash(valueName), TaskIndex);
+}
+
+uint32_t Caches::taskValueNameHash(uint32_t valueNameHash, taskIndex_t TaskIndex)
+{
+  // The '#' cannot exist in a value name, use it as separator.
+  uint32_t hash = valueNameHash;
+
+  hash ^= '#';
+  hash *= 16777619u;
+  hash ^= TaskIndex;
+  hash *= 16777619u;
+  return hash;
+}
+
 String Caches::getTaskDeviceValueName(taskIndex_t TaskIndex, uint8_t rel_index)
 {
   if (validTaskIndex(TaskIndex) && (rel_index < VARS_PER_TASK)) {
@@ -139,7 +389,7 @@ String Caches::getTaskDeviceValueName(taskIndex_t TaskIndex, uint8_t rel_index)
     auto it = getExtraTaskSettings(TaskIndex);
 
     if (it != extraTaskSettings_cache.end()) {
-      return it->second.TaskDeviceValueNames[rel_index];
+      return taskNamePool.get(it->second.TaskDeviceValueNames[rel_index]);
     }
     #endif // ifdef ESP32
   }
@@ -170,6 +420,21 @@ String Caches::getTaskDeviceFormula(taskIndex_t TaskIndex, uint8_t rel_index)
   return EMPTY_STRING;
 }
 
+#if FEATURE_RULES_CALCULATE_CACHE
+const RulesCalculate_program_t * Caches::getTaskDeviceFormulaProgram(taskIndex_t TaskIndex, uint8_t rel_index)
+{
+  if ((rel_index < VARS_PER_TASK) && validTaskIndex(TaskIndex)) {
+    auto it = getExtraTaskSettings(TaskIndex);
+
+    if ((it != extraTaskSettings_cache.end()) && !it->second.formulaProgram[rel_index].isEmpty()) {
+      return &(it->second.formulaProgram[rel_index]);
+    }
+  }
+  return nullptr;
+}
+
+#endif // if FEATURE_RULES_CALCULATE_CACHE
+
 long Caches::getTaskDevicePluginConfigLong(taskIndex_t TaskIndex, uint8_t rel_index)
 {
   if (validTaskIndex(TaskIndex) && (rel_index < PLUGIN_EXTRACONFIGVAR_MAX)) {
@@ -259,11 +524,16 @@ void Caches::updateExtraTaskSettingsCache()
       tmp.defaultTaskDeviceValueName = it->second.defaultTaskDeviceValueName;
 
       // Now clear it so we can create a fresh copy.
+      releaseTaskNames(it->second);
       extraTaskSettings_cache.erase(it);
       clearTaskIndexFromMaps(TaskIndex);
+
+      if (taskNamePool.needsCompaction()) {
+        compactTaskNamePool();
+      }
     }
 
-    tmp.TaskDeviceName = ExtraTaskSettings.TaskDeviceName;
+    tmp.TaskDeviceName = taskNamePool.add(ExtraTaskSettings.TaskDeviceName);
 
     #if FEATURE_PLUGIN_STATS
     tmp.enabledPluginStats = 0;
@@ -271,11 +541,14 @@ void Caches::updateExtraTaskSettingsCache()
 
     for (size_t i = 0; i < VARS_PER_TASK; ++i) {
         #ifdef ESP32
-      tmp.TaskDeviceValueNames[i] = ExtraTaskSettings.TaskDeviceValueNames[i];
+      tmp.TaskDeviceValueNames[i] = taskNamePool.add(ExtraTaskSettings.TaskDeviceValueNames[i]);
         #endif // ifdef ESP32
 
       if (ExtraTaskSettings.TaskDeviceFormula[i][0] != 0) {
         tmp.hasFormula = true;
+        #if FEATURE_RULES_CALCULATE_CACHE
+        CompileTaskFormula(ExtraTaskSettings.TaskDeviceFormula[i], tmp.formulaProgram[i]);
+        #endif // if FEATURE_RULES_CALCULATE_CACHE
       }
       tmp.decimals[i] = ExtraTaskSettings.TaskDeviceValueDecimals[i];
       #if FEATURE_PLUGIN_STATS
@@ -303,7 +576,7 @@ void Caches::updateExtraTaskSettingsCache()
     }
     #endif // ifdef ESP32
 
-    extraTaskSettings_cache[TaskIndex] = tmp;
+    extraTaskSettings_cache[TaskIndex] = std::move(tmp);
   }
 }
 
@@ -327,6 +600,30 @@ void Caches::updateExtraTaskSettingsCache_afterLoad_Save()
   }
 }
 
+#if FEATURE_EXTRA_TASK_SETTINGS_LRU
+bool Caches::loadExtraTaskSettingsFromLRU(taskIndex_t TaskIndex)
+{
+  // Only valid as long as the checksum of the last loaded/saved settings is still known.
+  // An empty checksum never matches, but is still counted as a miss.
+  auto it = extraTaskSettings_cache.find(TaskIndex);
+
+  return extraTaskSettings_LRU.get(
+    TaskIndex,
+    (it == extraTaskSettings_cache.end()) ? ChecksumType() : it->second.md5checksum,
+    ExtraTaskSettings);
+}
+
+void Caches::storeExtraTaskSettingsInLRU()
+{
+  auto it = extraTaskSettings_cache.find(ExtraTaskSettings.TaskIndex);
+
+  if (it != extraTaskSettings_cache.end()) {
+    extraTaskSettings_LRU.set(ExtraTaskSettings, it->second.md5checksum);
+  }
+}
+
+#endif // if FEATURE_EXTRA_TASK_SETTINGS_LRU
+
 ExtraTaskSettingsMap::const_iterator Caches::getExtraTaskSettings(taskIndex_t TaskIndex)
 {
   if (validTaskIndex(TaskIndex)) {
@@ -356,11 +653,10 @@ void Caches::clearTaskIndexFromMaps(taskIndex_t TaskIndex)
     }
   }
   {
-    const String searchstr = String('#') + TaskIndex;
-    auto it                = taskIndexValueName.begin();
+    auto it = taskIndexValueName.begin();
 
     for (; it != taskIndexValueName.end();) {
-      if (it->first.endsWith(searchstr)) {
+      if (it->second.taskIndex == TaskIndex) {
         it = taskIndexValueName.erase(it);
       } else {
         ++it;
@@ -369,6 +665,33 @@ void Caches::clearTaskIndexFromMaps(taskIndex_t TaskIndex)
   }
 }
 
+void Caches::releaseTaskNames(const ExtraTaskSettings_cache_t& cache)
+{
+  taskNamePool.release(cache.TaskDeviceName);
+  #ifdef ESP32
+
+  for (size_t i = 0; i < VARS_PER_TASK; ++i) {
+    taskNamePool.release(cache.TaskDeviceValueNames[i]);
+  }
+  #endif // ifdef ESP32
+}
+
+void Caches::compactTaskNamePool()
+{
+  StringPool compacted;
+
+  for (auto it = extraTaskSettings_cache.begin(); it != extraTaskSettings_cache.end(); ++it) {
+    it->second.TaskDeviceName = compacted.add(taskNamePool, it->second.TaskDeviceName);
+    #ifdef ESP32
+
+    for (size_t i = 0; i < VARS_PER_TASK; ++i) {
+      it->second.TaskDeviceValueNames[i] = compacted.add(taskNamePool, it->second.TaskDeviceValueNames[i]);
+    }
+    #endif // ifdef ESP32
+  }
+  taskNamePool = std::move(compacted);
+}
+
   #ifdef ESP32
 bool Caches::getControllerSettings(controllerIndex_t index,  ControllerSettingsStruct& ControllerSettings) const
 {
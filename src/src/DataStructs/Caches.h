@@ -5,15 +5,23 @@
 #include "../../ESPEasy_common.h"
 #include "../CustomBuild/ESPEasyLimits.h"
 #include "../DataStructs/ChecksumType.h"
+#include "../DataStructs/CompiledTemplate.h"
+#include "../DataStructs/DeviceStruct.h"
+#include "../DataStructs/ExtraTaskSettings_LRU.h"
+#include "../DataStructs/StringPool.h"
+#include "../DataStructs/WebPageTemplateCache.h"
+#include "../DataStructs/WebResponseCache.h"
 #ifdef ESP32
 # include "../DataStructs/ControllerSettingsStruct.h"
 # include "../DataTypes/ControllerIndex.h"
 #endif // ifdef ESP32
 #include "../Globals/Plugins.h"
 
+#include "../Helpers/Rules_calculate.h"
 #include "../Helpers/RulesHelper.h"
 
 #include <map>
+#include <vector>
 
 // Key is combination of array index + some offset reflecting the used array
 // Store those sparingly used TaskDevicePluginConfigLong and TaskDevicePluginConfig
@@ -36,20 +44,36 @@ struct ExtraTaskSettings_cache_t {
   uint16_t TaskDevicePluginConfigLong_index_used = 0;
   uint16_t TaskDevicePluginConfig_index_used     = 0;
 
-  String TaskDeviceValueNames[VARS_PER_TASK];
+  StringPool_handle_t TaskDeviceValueNames[VARS_PER_TASK];
   #endif // ifdef ESP32
-  String       TaskDeviceName;
-  ChecksumType md5checksum;
+
+  // Names are stored in Caches::taskNamePool
+  StringPool_handle_t TaskDeviceName;
+  ChecksumType        md5checksum;
   uint8_t      decimals[VARS_PER_TASK] = { 0 };
   uint8_t      defaultTaskDeviceValueName{};
   #if FEATURE_PLUGIN_STATS
   uint8_t enabledPluginStats = 0;
   #endif // if FEATURE_PLUGIN_STATS
+  #if FEATURE_RULES_CALCULATE_CACHE
+
+  // Formula compiled when loading/saving the task settings.
+  // Empty when there is no formula, or it could not be compiled.
+  RulesCalculate_program_t formulaProgram[VARS_PER_TASK];
+  #endif // if FEATURE_RULES_CALCULATE_CACHE
   bool hasFormula = false;
 };
 
-typedef std::map<String, taskIndex_t>                    TaskIndexNameMap;
-typedef std::map<String, uint8_t>                        TaskIndexValueNameMap;
+// Task value index of a value name, for a specific task.
+struct TaskIndexValueName_t {
+  taskIndex_t taskIndex = INVALID_TASK_INDEX;
+  uint8_t     valueNr   = VARS_PER_TASK;
+};
+
+// Key is the case insensitive hash of the (value) name.
+// See Caches::taskNameHash() and Caches::taskValueNameHash()
+typedef std::map<uint32_t, taskIndex_t>                  TaskIndexNameMap;
+typedef std::map<uint32_t, TaskIndexValueName_t>         TaskIndexValueNameMap;
 typedef std::map<String, uint8_t>                        FilePresenceMap;
 typedef std::map<taskIndex_t, ExtraTaskSettings_cache_t> ExtraTaskSettingsMap;
 
@@ -57,25 +81,107 @@ typedef std::map<taskIndex_t, ExtraTaskSettings_cache_t> ExtraTaskSettingsMap;
 typedef std::map<controllerIndex_t, ControllerSettingsStruct> ControllerSettingsMap;
 #endif // ifdef ESP32
 
+// Groups of enabled tasks, see Caches::getEnabledTasks()
+enum class EnabledTaskGroup_e : uint8_t {
+  All,         // All enabled tasks with a plugin included in the build
+  I2C,         // DEVICE_TYPE_I2C
+  Serial,      // DEVICE_TYPE_SERIAL and DEVICE_TYPE_SERIAL_PLUS1
+  PluginStats, // Plugin supports PluginStats
+
+  NR_ELEMENTS // Keep as last
+};
+
+// Range of task indices, to be used in a range based for loop.
+struct TaskIndexRange {
+  const taskIndex_t* begin() const {
+    return _begin;
+  }
+
+  const taskIndex_t* end() const {
+    return _end;
+  }
+
+  bool empty() const {
+    return _begin == _end;
+  }
+
+  const taskIndex_t *_begin = nullptr;
+  const taskIndex_t *_end   = nullptr;
+};
+
 struct Caches {
   void    clearAllCaches();
   void    clearAllButTaskCaches();
 
+  // Same as clearAllButTaskCaches(), but only the cached file presence
+  // of the given file is cleared.
+  void    clearAllButTaskCaches(const String& changedFile);
+
   void    clearAllTaskCaches();
   void    clearTaskCache(taskIndex_t TaskIndex);
 
   void    clearFileCaches();
 
+  // Forget the cached presence of a single file, after it has been created, changed or removed.
+  // @param patched_fname  File name as returned by patch_fname()
+  void    invalidateFileCache(const String& patched_fname);
+
   bool    matchChecksumExtraTaskSettings(taskIndex_t         TaskIndex,
                                          const ChecksumType& checksum) const;
 
   void    updateActiveTaskUseSerial0();
 
+  // Tasks to call for a broadcast plugin call, in order of task index.
+  // Only tasks with a plugin subscribed to the function, see DeviceStruct::PluginCallSubscriptions
+  // @retval nullptr when all tasks must be called.
+  // N.B. The vector may be updated by a nested plugin call, so iterate by index.
+  const std::vector<taskIndex_t>* getPluginCallSubscribers(uint8_t function);
+
+  // Enabled tasks of the group, in order of task index.
+  // Use this instead of iterating over all TASKS_MAX tasks and checking whether each task is enabled.
+  // The lists are rebuilt on the first call after a task is saved, enabled or disabled.
+  // N.B. Lists may be rebuilt by a nested call, so do not keep a reference or range while calling plugins.
+  const std::vector<taskIndex_t>& getEnabledTasks(EnabledTaskGroup_e group = EnabledTaskGroup_e::All);
+
+  // Enabled tasks running the plugin, in order of task index.
+  TaskIndexRange                  getEnabledTasks(pluginID_t pluginID);
+
+  // To be called when Settings.TaskDeviceEnabled[] or the plugin of a task is changed.
+  void                            invalidateEnabledTasks() {
+    enabledTasksValid = false;
+  }
+
   uint8_t getTaskDeviceValueDecimals(taskIndex_t TaskIndex,
                                      uint8_t     rel_index);
 
   String  getTaskDeviceName(taskIndex_t TaskIndex);
 
+  // Case insensitive compare of the task name, without making a copy of the name.
+  // @param nameHash  As returned by taskNameHash(name)
+  bool    matchTaskDeviceName(taskIndex_t   TaskIndex,
+                              const String& name,
+                              uint32_t      nameHash);
+
+  // Case insensitive compare of the task value name, without making a copy of the name.
+  // On ESP8266 the value names are not cached, so this will always return true.
+  // @param nameHash  As returned by taskNameHash(name)
+  bool    matchTaskDeviceValueName(taskIndex_t   TaskIndex,
+                                   uint8_t       rel_index,
+                                   const String& name,
+                                   uint32_t      nameHash);
+
+  // Case insensitive FNV-1a hash of a task name, used as key in taskIndexName
+  static uint32_t taskNameHash(const String& name);
+
+  // Case insensitive FNV-1a hash of a value name combined with the task index,
+  // used as key in taskIndexValueName
+  static uint32_t taskValueNameHash(const String& valueName,
+                                    taskIndex_t   TaskIndex);
+
+  // Same, using the hash of the value name as returned by taskNameHash()
+  static uint32_t taskValueNameHash(uint32_t    valueNameHash,
+                                    taskIndex_t TaskIndex);
+
   String  getTaskDeviceValueName(taskIndex_t TaskIndex,
                                  uint8_t     rel_index);
 
@@ -86,6 +192,14 @@ struct Caches {
   String  getTaskDeviceFormula(taskIndex_t TaskIndex,
                                uint8_t     rel_index);
 
+  #if FEATURE_RULES_CALCULATE_CACHE
+
+  // Return the compiled formula, or nullptr when not available.
+  // Pointer is only valid until the task settings cache is updated.
+  const RulesCalculate_program_t* getTaskDeviceFormulaProgram(taskIndex_t TaskIndex,
+                                                              uint8_t     rel_index);
+  #endif // if FEATURE_RULES_CALCULATE_CACHE
+
   long    getTaskDevicePluginConfigLong(taskIndex_t TaskIndex,
                                         uint8_t     rel_index);
 
@@ -106,6 +220,17 @@ struct Caches {
   // since only those functions know the checksum of what has been stored.
   void updateExtraTaskSettingsCache_afterLoad_Save();
 
+  #if FEATURE_EXTRA_TASK_SETTINGS_LRU
+
+  // Restore ExtraTaskSettings from the LRU cache of full task settings.
+  // Only to be called from LoadTaskSettings()
+  bool loadExtraTaskSettingsFromLRU(taskIndex_t TaskIndex);
+
+  // Keep a copy of the just loaded ExtraTaskSettings.
+  // Only to be called from LoadTaskSettings() after updateExtraTaskSettingsCache_afterLoad_Save()
+  void storeExtraTaskSettingsInLRU();
+  #endif // if FEATURE_EXTRA_TASK_SETTINGS_LRU
+
   #ifdef ESP32
   bool getControllerSettings(controllerIndex_t         index,
                              ControllerSettingsStruct& ControllerSettings) const;
@@ -122,23 +247,61 @@ private:
 
   void                                 clearTaskIndexFromMaps(taskIndex_t TaskIndex);
 
+  // Release the names of the cached task settings from taskNamePool
+  void                                 releaseTaskNames(const ExtraTaskSettings_cache_t& cache);
+
+  // Copy the names still in use to a new pool, to free released names
+  void                                 compactTaskNamePool();
+
+  // Clear all caches which do not depend on a specific task or file.
+  // The rules cache may be kept when only a single rules file has changed.
+  void                                 clearNonFileCaches(bool clearRulesCache = true);
+
+  void                                 updatePluginCallSubscribers();
+
+  void                                 updateEnabledTasks();
+
 public:
 
   TaskIndexNameMap      taskIndexName;
   TaskIndexValueNameMap taskIndexValueName;
   FilePresenceMap       fileExistsMap;
   RulesHelperClass      rulesHelper;
+  #if FEATURE_TEMPLATE_CACHE
+  CompiledTemplateCache templateCache;
+  #endif // if FEATURE_TEMPLATE_CACHE
+  #if FEATURE_EXTRA_TASK_SETTINGS_LRU
+  ExtraTaskSettings_LRU extraTaskSettings_LRU;
+  #endif // if FEATURE_EXTRA_TASK_SETTINGS_LRU
+  #if FEATURE_WEB_RESPONSE_CACHE
+  WebResponseCache      webResponseCache;
+  #endif // if FEATURE_WEB_RESPONSE_CACHE
+  #if FEATURE_WEB_TEMPLATE_CACHE
+  WebPageTemplateCache  webTemplateCache;
+  #endif // if FEATURE_WEB_TEMPLATE_CACHE
 
 private:
 
   ExtraTaskSettingsMap extraTaskSettings_cache;
 
+  // Task names and task value names of extraTaskSettings_cache
+  StringPool taskNamePool;
+
   #ifdef ESP32
 
   // Only cache Controller Settings on ESP32 due to memory restrictions on ESP8266
   ControllerSettingsMap controllerSetings_cache;
   #endif // ifdef ESP32
 
+  std::vector<taskIndex_t> pluginCallSubscribers[static_cast<uint8_t>(PluginCallSubscription_e::NR_ELEMENTS)];
+  bool                     pluginCallSubscribersValid = false;
+
+  std::vector<taskIndex_t> enabledTasks[static_cast<uint8_t>(EnabledTaskGroup_e::NR_ELEMENTS)];
+
+  // Enabled tasks sorted by plugin ID, then task index
+  std::vector<taskIndex_t> enabledTasksByPlugin;
+  bool                     enabledTasksValid = false;
+
 public:
 
   ChecksumType controllerSettings_checksums[CONTROLLER_MAX] = {};
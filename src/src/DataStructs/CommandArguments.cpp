@@ -0,0 +1,46 @@
+#include "../DataStructs/CommandArguments.h"
+
+#include "../Helpers/StringConverter.h"
+
+const CommandArguments *CommandArguments::_active = nullptr;
+
+CommandArguments::CommandArguments(const String& line) : _line(line)
+{
+  bool complete = false;
+
+  _count = GetArgvPositions(_line.c_str(), _begin, _end, COMMAND_ARGUMENTS_MAX, complete);
+
+  if (complete) {
+    _registered = true;
+    _previous   = _active;
+    _active     = this;
+  }
+}
+
+CommandArguments::~CommandArguments()
+{
+  if (_registered && (_active == this)) {
+    _active = _previous;
+  }
+}
+
+bool CommandArguments::getBeginEnd(unsigned int argc, int& pos_begin, int& pos_end) const
+{
+  if ((argc == 0) || (argc > _count)) {
+    pos_begin = -1;
+    pos_end   = -1;
+    return false;
+  }
+  pos_begin = _begin[argc - 1];
+  pos_end   = _end[argc - 1];
+  return true;
+}
+
+const CommandArguments * CommandArguments::find(const char *string, char separator)
+{
+  // Only the buffer of the line itself, as the positions are only valid for that content.
+  if ((_active != nullptr) && (separator == ',') && (string == _active->_line.c_str())) {
+    return _active;
+  }
+  return nullptr;
+}
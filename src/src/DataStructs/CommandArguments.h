@@ -0,0 +1,59 @@
+#ifndef DATASTRUCTS_COMMANDARGUMENTS_H
+#define DATASTRUCTS_COMMANDARGUMENTS_H
+
+#include "../../ESPEasy_common.h"
+
+#ifndef COMMAND_ARGUMENTS_MAX
+# define COMMAND_ARGUMENTS_MAX  16 // Max. nr of arguments (including the command) kept per command line
+#endif // ifndef COMMAND_ARGUMENTS_MAX
+
+/*********************************************************************************************\
+* CommandArguments
+* Begin and end positions of all arguments of a command line, tokenized once.
+* While an instance exists, GetArgvBeginEnd() and the parseString() functions called on this very
+* same line buffer use these positions instead of scanning the line again for each argument.
+* Instances may be nested (e.g. commands executed from a command), the most recent one is used.
+\*********************************************************************************************/
+class CommandArguments {
+public:
+
+  explicit CommandArguments(const String& line);
+
+  ~CommandArguments();
+
+  CommandArguments(const CommandArguments& other)            = delete;
+  CommandArguments& operator=(const CommandArguments& other) = delete;
+
+  // Same as GetArgvBeginEnd(): argc = 1 => command
+  bool getBeginEnd(unsigned int argc,
+                   int        & pos_begin,
+                   int        & pos_end) const;
+
+  // Nr of arguments, including the command
+  uint8_t count() const {
+    return _count;
+  }
+
+  const String& line() const {
+    return _line;
+  }
+
+  // Return the active instance for this line buffer, or nullptr when the line must be scanned.
+  static const CommandArguments* find(const char *string,
+                                      char        separator);
+
+private:
+
+  const String& _line;
+  int16_t       _begin[COMMAND_ARGUMENTS_MAX] = { 0 }; // -1 for an empty argument
+  int16_t       _end[COMMAND_ARGUMENTS_MAX]   = { 0 };
+  uint8_t       _count                        = 0;
+
+  // Only registered when all arguments fit
+  bool                    _registered = false;
+  const CommandArguments *_previous   = nullptr;
+
+  static const CommandArguments *_active;
+};
+
+#endif // ifndef DATASTRUCTS_COMMANDARGUMENTS_H
@@ -0,0 +1,323 @@
+#include "../DataStructs/CompiledTemplate.h"
+
+#if FEATURE_TEMPLATE_CACHE
+
+# include "../../_Plugin_Helper.h"
+
+# include "../DataStructs/TimingStats.h"
+# include "../Globals/ExtraTaskSettings.h"
+# include "../Globals/Plugins_other.h"
+# include "../Globals/RuntimeData.h"
+# include "../Helpers/ESPEasy_Storage.h"
+# include "../Helpers/Misc.h"
+# include "../Helpers/StringConverter.h"
+# include "../Helpers/StringParser.h"
+# include "../Helpers/SystemVariables.h"
+
+# include <algorithm>
+
+namespace {
+// Parse a decimal number without leading zeroes, the way %vN% and %valN% are matched.
+bool getDecimalIndex(const String& str, size_t start, uint32_t& index)
+{
+  if ((start >= str.length()) ||
+      ((str[start] == '0') && ((start + 1) < str.length()))) {
+    return false;
+  }
+  index = 0;
+
+  for (size_t i = start; i < str.length(); ++i) {
+    if (!isDigit(str[i])) { return false; }
+    const uint32_t digit = str[i] - '0';
+
+    if (index > ((UINT32_MAX - digit) / 10)) { return false; }
+    index = (index * 10) + digit;
+  }
+  return true;
+}
+
+void appendValue(String& s, const String& value, bool useURLencode)
+{
+  if (useURLencode) {
+    s += URLEncode(value);
+  } else {
+    s += value;
+  }
+}
+
+// Values containing these characters would have been parsed again by parseTemplate()
+bool isSafeValue(const String& s, size_t start)
+{
+  for (size_t i = start; i < s.length(); ++i) {
+    if ((s[i] == '%') || (s[i] == '[') || (s[i] == '{')) {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+bool CompiledTemplate::compile(const String& tmpString)
+{
+  _template = tmpString;
+  _segments.clear();
+  _compiled = false;
+
+  // Special characters and string commands are not supported.
+  if ((tmpString.indexOf('{') != -1) ||
+      ((tmpString.indexOf('&') != -1) && (tmpString.indexOf(';') != -1))) {
+    return false;
+  }
+
+  int startpos     = 0;
+  int lastStartpos = 0;
+  int endpos       = 0;
+  String deviceName, valueName, format;
+
+  while (findNextDevValNameInString(tmpString, startpos, endpos, deviceName, valueName, format)) {
+    if (!addText(tmpString.substring(lastStartpos, startpos))) {
+      return false;
+    }
+
+    if ((deviceName.indexOf('%') != -1) ||
+        (valueName.indexOf('%') != -1) ||
+        (format.indexOf('%') != -1)) {
+      // Would be changed by parseSystemVariables() before the marker is parsed.
+      return false;
+    }
+    CompiledTemplate_segment segment;
+    segment.type      = CompiledTemplate_segment_e::TaskValueMarker;
+    segment.text      = std::move(deviceName);
+    segment.valueName = std::move(valueName);
+    segment.format    = std::move(format);
+    _segments.emplace_back(std::move(segment));
+
+    lastStartpos = endpos + 1;
+    startpos     = endpos + 1;
+  }
+
+  if (!addText(tmpString.substring(lastStartpos))) {
+    return false;
+  }
+  _compiled = true;
+  return true;
+}
+
+bool CompiledTemplate::addText(const String& text)
+{
+  if (text.indexOf('[') != -1) {
+    // May become a marker when a variable is replaced
+    return false;
+  }
+  int literalStart = 0;
+  int pos          = text.indexOf('%');
+
+  while (pos != -1) {
+    const int end = text.indexOf('%', pos + 1);
+
+    if (end == -1) {
+      return false;
+    }
+    CompiledTemplate_segment segment;
+
+    if (!getVariableSegment(text.substring(pos + 1, end), segment)) {
+      // Unknown variables or conversions like %c_...% are left to parseTemplate()
+      return false;
+    }
+    addLiteral(text.substring(literalStart, pos));
+
+    if (segment.type == CompiledTemplate_segment_e::Literal) {
+      addLiteral(segment.text);
+    } else {
+      _segments.emplace_back(std::move(segment));
+    }
+    literalStart = end + 1;
+    pos          = text.indexOf('%', literalStart);
+  }
+  addLiteral(text.substring(literalStart));
+  return true;
+}
+
+void CompiledTemplate::addLiteral(const String& text)
+{
+  if (text.isEmpty()) { return; }
+
+  if (!_segments.empty() && (_segments.back().type == CompiledTemplate_segment_e::Literal)) {
+    _segments.back().text += text;
+    return;
+  }
+  CompiledTemplate_segment segment;
+  segment.text = text;
+  _segments.emplace_back(std::move(segment));
+}
+
+bool CompiledTemplate::getVariableSegment(const String& name, CompiledTemplate_segment& segment)
+{
+  // Same order as parseTemplate() and parseEventVariables() replace them.
+  const SystemVariables::Enum enumval = SystemVariables::findEnum(name.c_str(), name.length());
+
+  if (enumval != SystemVariables::Enum::UNKNOWN) {
+    segment.type  = CompiledTemplate_segment_e::SystemVariable;
+    segment.index = enumval;
+    return true;
+  }
+
+  if (name.startsWith(F("v")) && getDecimalIndex(name, 1, segment.index)) {
+    segment.type = CompiledTemplate_segment_e::CustomVariable;
+    return true;
+  }
+
+  if (equals(name, F("id"))) {
+    segment.type = CompiledTemplate_segment_e::EventId;
+    return true;
+  }
+
+  if (equals(name, F("tskname"))) {
+    segment.type = CompiledTemplate_segment_e::EventTaskName;
+    return true;
+  }
+
+  if (equals(name, F("valname"))) {
+    // Replaced per value by parseSingleControllerVariable()
+    segment.type = CompiledTemplate_segment_e::Literal;
+    segment.text = F("%valname%");
+    return true;
+  }
+
+  if (name.startsWith(F("val")) && getDecimalIndex(name, 3, segment.index) && (segment.index > 0)) {
+    segment.type = CompiledTemplate_segment_e::EventValue;
+    --segment.index;
+    return true;
+  }
+
+  if (name.startsWith(F("vname")) && getDecimalIndex(name, 5, segment.index) &&
+      (segment.index > 0) && (segment.index <= 4)) {
+    segment.type = CompiledTemplate_segment_e::EventValueName;
+    --segment.index;
+    return true;
+  }
+  return false;
+}
+
+bool CompiledTemplate::expand(String& result, struct EventStruct *event, bool useURLencode) const
+{
+  if (!_compiled || (event == nullptr)) { return false; }
+  START_TIMER;
+
+  // Keep current loaded taskSettings to restore at the end.
+  const taskIndex_t currentTaskIndex = ExtraTaskSettings.TaskIndex;
+  String newString;
+  bool   res = true;
+
+  newString.reserve(_template.length() + 16);
+
+  for (auto it = _segments.begin(); res && it != _segments.end(); ++it) {
+    const size_t valueStart = newString.length();
+
+    switch (it->type) {
+      case CompiledTemplate_segment_e::Literal:
+        newString += it->text;
+        continue;
+      case CompiledTemplate_segment_e::SystemVariable:
+        appendValue(
+          newString,
+          SystemVariables::getCachedSystemVariable(static_cast<SystemVariables::Enum>(it->index)),
+          useURLencode);
+        break;
+      case CompiledTemplate_segment_e::CustomVariable:
+      {
+        const bool trimTrailingZeros = true;
+        # if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+        appendValue(newString, doubleToString(getCustomFloatVar(it->index), 6, trimTrailingZeros), useURLencode);
+        # else // if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+        appendValue(newString, floatToString(getCustomFloatVar(it->index), 6, trimTrailingZeros), useURLencode);
+        # endif // if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+        break;
+      }
+      case CompiledTemplate_segment_e::TaskValueMarker:
+      {
+        String format = it->format;
+        parseTemplate_replaceMarker(newString, 0, it->text, it->valueName, format, _template);
+
+        // This may have taken some time, so call delay()
+        delay(0);
+        break;
+      }
+      case CompiledTemplate_segment_e::EventId:
+        appendValue(newString, String(event->idx), useURLencode);
+        break;
+      case CompiledTemplate_segment_e::EventValue:
+      {
+        const uint8_t valueCount = validTaskIndex(event->TaskIndex)
+          ? ((event->getSensorType() == Sensor_VType::SENSOR_TYPE_ULONG) ? 1 : getValueCountForTask(event->TaskIndex))
+          : 0;
+
+        if (it->index < valueCount) {
+          appendValue(newString, formatUserVarNoCheck(event, it->index), useURLencode);
+        } else {
+          // Not replaced by parseEventVariables()
+          newString += F("%val");
+          newString += it->index + 1;
+          newString += '%';
+          continue;
+        }
+        break;
+      }
+      case CompiledTemplate_segment_e::EventTaskName:
+        appendValue(newString, getTaskDeviceName(event->TaskIndex), useURLencode);
+        break;
+      case CompiledTemplate_segment_e::EventValueName:
+        appendValue(newString, getTaskValueName(event->TaskIndex, it->index), useURLencode);
+        break;
+    }
+    res = isSafeValue(newString, valueStart);
+  }
+
+  // Restore previous loaded taskSettings
+  if (validTaskIndex(currentTaskIndex))
+  {
+    LoadTaskSettings(currentTaskIndex);
+  }
+
+  if (res) {
+    result = std::move(newString);
+    STOP_TIMER(PARSE_TEMPLATE_CACHED);
+  }
+  return res;
+}
+
+bool CompiledTemplateCache::parseControllerVariables(String& s, struct EventStruct *event, bool useURLencode)
+{
+  if (parseTemplate_CallBack_ptr != nullptr) {
+    // Callback may change anything in the template
+    return false;
+  }
+  auto it = _cache.begin();
+
+  for (; it != _cache.end(); ++it) {
+    if (it->_template.equals(s)) {
+      break;
+    }
+  }
+
+  if (it == _cache.end()) {
+    if (_cache.size() >= TEMPLATE_CACHE_SIZE) {
+      _cache.pop_back();
+    }
+
+    // Also keep templates which cannot be compiled, to not try again.
+    CompiledTemplate compiled;
+    compiled.compile(s);
+    _cache.emplace(_cache.begin(), std::move(compiled));
+  } else if (it != _cache.begin()) {
+    std::rotate(_cache.begin(), it, it + 1);
+  }
+  return _cache.front().expand(s, event, useURLencode);
+}
+
+void CompiledTemplateCache::clear()
+{
+  _cache.clear();
+}
+
+#endif // if FEATURE_TEMPLATE_CACHE
@@ -0,0 +1,91 @@
+#ifndef DATASTRUCTS_COMPILEDTEMPLATE_H
+#define DATASTRUCTS_COMPILEDTEMPLATE_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_TEMPLATE_CACHE
+
+# include <vector>
+
+# ifndef TEMPLATE_CACHE_SIZE
+#  ifdef ESP8266
+#   define TEMPLATE_CACHE_SIZE 4
+#  else // ifdef ESP8266
+#   define TEMPLATE_CACHE_SIZE 16
+#  endif // ifdef ESP8266
+# endif // ifndef TEMPLATE_CACHE_SIZE
+
+struct EventStruct;
+
+enum class CompiledTemplate_segment_e : uint8_t {
+  Literal,
+  SystemVariable,  // %sysname%
+  CustomVariable,  // %vN%
+  TaskValueMarker, // [task#value] or [task#value#format]
+  EventId,         // %id%
+  EventValue,      // %valN%
+  EventTaskName,   // %tskname%
+  EventValueName   // %vnameN%
+};
+
+struct CompiledTemplate_segment {
+  CompiledTemplate_segment_e type = CompiledTemplate_segment_e::Literal;
+
+  // SystemVariables::Enum, custom variable nr. or task value index
+  uint32_t index = 0;
+
+  // Literal text, or the device name of a task value marker
+  String text;
+  String valueName;
+  String format;
+};
+
+// Template split into segments, so it can be expanded in a single pass.
+// Only templates which give the same result as parseTemplate() followed by
+// parseEventVariables() can be compiled.
+struct CompiledTemplate {
+  // Return false when the template must be handled by parseTemplate().
+  bool compile(const String& tmpString);
+
+  // Return false when parseTemplate() must be used, for example when a
+  // replaced value contains characters which parseTemplate() would parse again.
+  bool expand(String            & result,
+              struct EventStruct *event,
+              bool                useURLencode) const;
+
+  String _template;
+
+private:
+
+  bool addText(const String& text);
+
+  void addLiteral(const String& text);
+
+  static bool getVariableSegment(const String            & name,
+                                 CompiledTemplate_segment& segment);
+
+  std::vector<CompiledTemplate_segment> _segments;
+  bool                                  _compiled = false;
+};
+
+// LRU cache of compiled controller templates, like MQTT topics and HTTP bodies.
+class CompiledTemplateCache {
+public:
+
+  // Same as parseControllerVariables(), using a compiled version of the template.
+  // Return false when the template could not be expanded and is left unchanged.
+  bool parseControllerVariables(String            & s,
+                                struct EventStruct *event,
+                                bool                useURLencode);
+
+  void clear();
+
+private:
+
+  // Most recently used first
+  std::vector<CompiledTemplate> _cache;
+};
+
+#endif // if FEATURE_TEMPLATE_CACHE
+
+#endif // DATASTRUCTS_COMPILEDTEMPLATE_H
@@ -30,6 +30,7 @@ void ControllerSettingsStruct::reset() {
   MinimalTimeBetweenMessages = CONTROLLER_DELAY_QUEUE_DELAY_DFLT;
   MaxQueueDepth              = CONTROLLER_DELAY_QUEUE_DEPTH_DFLT;
   MaxRetry                   = CONTROLLER_DELAY_QUEUE_RETRY_DFLT;
+  MaxBurst                   = CONTROLLER_DELAY_QUEUE_BURST_DFLT;
   DeleteOldest               = DEFAULT_CONTROLLER_DELETE_OLDEST;
   ClientTimeout              = CONTROLLER_CLIENTTIMEOUT_DFLT;
   MustCheckReply             = DEFAULT_CONTROLLER_MUST_CHECK_REPLY ;
@@ -61,6 +62,10 @@ void ControllerSettingsStruct::validate() {
 
   if (MaxRetry == 0) { MaxRetry = CONTROLLER_DELAY_QUEUE_RETRY_DFLT; }
 
+  if (MaxBurst > CONTROLLER_DELAY_QUEUE_BURST_MAX) { MaxBurst = CONTROLLER_DELAY_QUEUE_BURST_MAX; }
+
+  if (MaxBurst == 0) { MaxBurst = CONTROLLER_DELAY_QUEUE_BURST_DFLT; }
+
   if ((ClientTimeout < 10) || (ClientTimeout > CONTROLLER_CLIENTTIMEOUT_MAX)) {
     ClientTimeout = CONTROLLER_CLIENTTIMEOUT_DFLT;
   }
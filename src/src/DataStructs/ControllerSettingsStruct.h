@@ -41,6 +41,20 @@
 # define CONTROLLER_DELAY_QUEUE_RETRY_DFLT  10
 #endif // ifndef CONTROLLER_DELAY_QUEUE_RETRY_DFLT
 
+// Number of messages which may be sent in a burst, when the queue was not processed for a while.
+// The average rate is still limited by the minimum delay between messages.
+#ifndef CONTROLLER_DELAY_QUEUE_BURST_MAX
+# define CONTROLLER_DELAY_QUEUE_BURST_MAX   50
+#endif // ifndef CONTROLLER_DELAY_QUEUE_BURST_MAX
+#ifndef CONTROLLER_DELAY_QUEUE_BURST_DFLT
+# define CONTROLLER_DELAY_QUEUE_BURST_DFLT  1
+#endif // ifndef CONTROLLER_DELAY_QUEUE_BURST_DFLT
+
+// Max. time in msec spent sending queued messages in a burst, before returning to the main loop.
+#ifndef CONTROLLER_DELAY_QUEUE_PROCESS_BUDGET
+# define CONTROLLER_DELAY_QUEUE_PROCESS_BUDGET  20
+#endif // ifndef CONTROLLER_DELAY_QUEUE_PROCESS_BUDGET
+
 // Timeout of the client in msec.
 #ifndef CONTROLLER_CLIENTTIMEOUT_MAX
 # define CONTROLLER_CLIENTTIMEOUT_MAX     4000 // Not sure if this may trigger SW watchdog.
@@ -69,6 +83,7 @@ struct ControllerSettingsStruct
     CONTROLLER_MIN_SEND_INTERVAL,
     CONTROLLER_MAX_QUEUE_DEPTH,
     CONTROLLER_MAX_RETRIES,
+    CONTROLLER_MAX_BURST,
     CONTROLLER_FULL_QUEUE_ACTION,
     CONTROLLER_ALLOW_EXPIRE,
     CONTROLLER_DEDUPLICATE,
@@ -88,6 +103,12 @@ struct ControllerSettingsStruct
     CONTROLLER_TIMEOUT,
     CONTROLLER_SAMPLE_SET_INITIATOR,
     CONTROLLER_SEND_BINARY,
+    CONTROLLER_MQTT_AGGREGATE_VALUES,
+    CONTROLLER_HTTP_KEEP_ALIVE,
+    CONTROLLER_QUEUE_SPILL,
+    CONTROLLER_P2P_COMPACT_DATA,
+    CONTROLLER_MQTT_TLS,
+    CONTROLLER_CACHE_COMPRESS,
 
     // Keep this as last, is used to loop over all parameters
     CONTROLLER_ENABLED
@@ -155,6 +176,30 @@ struct ControllerSettingsStruct
   bool         useLocalSystemTime() const { return VariousBits1.useLocalSystemTime; }
   void         useLocalSystemTime(bool value) { VariousBits1.useLocalSystemTime = value; }
 
+  // Publish all values of a task as a single JSON message
+  bool         mqtt_aggregateValues() const { return VariousBits1.mqtt_aggregateValues; }
+  void         mqtt_aggregateValues(bool value) { VariousBits1.mqtt_aggregateValues = value; }
+
+  // Keep the HTTP connection open to send the next message
+  bool         http_keepAlive() const { return VariousBits1.http_keepAlive; }
+  void         http_keepAlive(bool value) { VariousBits1.http_keepAlive = value; }
+
+  // Store messages in a file when the queue is full
+  bool         queueSpill() const { return VariousBits1.queueSpill; }
+  void         queueSpill(bool value) { VariousBits1.queueSpill = value; }
+
+  // Send ESPEasy p2p sensor data of multiple tasks per packet, leaving out unchanged values
+  bool         p2p_compactData() const { return VariousBits1.p2p_compactData; }
+  void         p2p_compactData(bool value) { VariousBits1.p2p_compactData = value; }
+
+  // Connect to the MQTT broker using TLS
+  bool         mqtt_useTLS() const { return VariousBits1.mqtt_useTLS; }
+  void         mqtt_useTLS(bool value) { VariousBits1.mqtt_useTLS = value; }
+
+  // Store cache controller samples in compressed blocks
+  bool         cache_compressSamples() const { return VariousBits1.cache_compressSamples; }
+  void         cache_compressSamples(bool value) { VariousBits1.cache_compressSamples = value; }
+
   bool         UseDNS;
   uint8_t      IP[4];
   unsigned int Port;
@@ -186,12 +231,12 @@ struct ControllerSettingsStruct
       uint32_t allowExpire                      : 1; // Bit 09
       uint32_t deduplicate                      : 1; // Bit 10
       uint32_t useLocalSystemTime               : 1; // Bit 11
-      uint32_t unused_12                        : 1; // Bit 12
-      uint32_t unused_13                        : 1; // Bit 13
-      uint32_t unused_14                        : 1; // Bit 14
-      uint32_t unused_15                        : 1; // Bit 15
-      uint32_t unused_16                        : 1; // Bit 16
-      uint32_t unused_17                        : 1; // Bit 17
+      uint32_t mqtt_aggregateValues             : 1; // Bit 12
+      uint32_t http_keepAlive                   : 1; // Bit 13
+      uint32_t queueSpill                       : 1; // Bit 14
+      uint32_t p2p_compactData                  : 1; // Bit 15
+      uint32_t mqtt_useTLS                      : 1; // Bit 16
+      uint32_t cache_compressSamples            : 1; // Bit 17
       uint32_t unused_18                        : 1; // Bit 18
       uint32_t unused_19                        : 1; // Bit 19
       uint32_t unused_20                        : 1; // Bit 20
@@ -210,6 +255,7 @@ struct ControllerSettingsStruct
     uint32_t VariousFlags;                           // Various flags
   };
   char ClientID[65];                                 // Used to define the Client ID used by the controller
+  uint8_t MaxBurst;                                  // Max. number of messages to send at once, 0 or 1 means no burst.
 
 private:
 
@@ -0,0 +1,82 @@
+#include "../DataStructs/CustomVarStore.h"
+
+
+ESPEASY_RULES_FLOAT_TYPE CustomVarStore::get(uint32_t index) const
+{
+  if (index < CUSTOM_VARS_DENSE_SIZE) {
+    if (index < _dense.size()) {
+      return _dense[index];
+    }
+    return 0.0;
+  }
+  auto it = _sparse.find(index);
+
+  if (it != _sparse.end()) {
+    return it->second;
+  }
+  return 0.0;
+}
+
+void CustomVarStore::set(uint32_t index, const ESPEASY_RULES_FLOAT_TYPE& value)
+{
+  if (index < CUSTOM_VARS_DENSE_SIZE) {
+    if (index >= _dense.size()) {
+      size_t newSize = ((index / CUSTOM_VARS_DENSE_BLOCK) + 1) * CUSTOM_VARS_DENSE_BLOCK;
+
+      if (newSize > CUSTOM_VARS_DENSE_SIZE) {
+        newSize = CUSTOM_VARS_DENSE_SIZE;
+      }
+      _dense.resize(newSize, 0.0);
+    }
+    _dense[index] = value;
+    _denseIsSet[index / 32] |= (1u << (index % 32));
+    return;
+  }
+  _sparse[index] = value;
+}
+
+bool CustomVarStore::isSet(uint32_t index) const
+{
+  if (index < CUSTOM_VARS_DENSE_SIZE) {
+    return (_denseIsSet[index / 32] & (1u << (index % 32))) != 0;
+  }
+  return _sparse.find(index) != _sparse.end();
+}
+
+bool CustomVarStore::getFirst(uint32_t& index, ESPEASY_RULES_FLOAT_TYPE& value) const
+{
+  return getFrom(0, index, value);
+}
+
+bool CustomVarStore::getNext(uint32_t& index, ESPEASY_RULES_FLOAT_TYPE& value) const
+{
+  if (index == UINT32_MAX) { return false; }
+  return getFrom(index + 1, index, value);
+}
+
+void CustomVarStore::clear()
+{
+  _dense.clear();
+  _sparse.clear();
+
+  for (size_t i = 0; i < NR_ELEMENTS(_denseIsSet); ++i) {
+    _denseIsSet[i] = 0;
+  }
+}
+
+bool CustomVarStore::getFrom(uint32_t index, uint32_t& foundIndex, ESPEASY_RULES_FLOAT_TYPE& value) const
+{
+  for (; index < _dense.size(); ++index) {
+    if (isSet(index)) {
+      foundIndex = index;
+      value      = _dense[index];
+      return true;
+    }
+  }
+  auto it = _sparse.lower_bound(index);
+
+  if (it == _sparse.end()) { return false; }
+  foundIndex = it->first;
+  value      = it->second;
+  return true;
+}
@@ -0,0 +1,58 @@
+#ifndef DATASTRUCTS_CUSTOMVARSTORE_H
+#define DATASTRUCTS_CUSTOMVARSTORE_H
+
+#include "../../ESPEasy_common.h"
+
+#include <map>
+#include <vector>
+
+// Custom variables with an index below this value are stored in a vector,
+// addressed by their index. Others are kept in a map.
+#ifndef CUSTOM_VARS_DENSE_SIZE
+# ifdef ESP8266
+#  define CUSTOM_VARS_DENSE_SIZE   64
+# else // ifdef ESP8266
+#  define CUSTOM_VARS_DENSE_SIZE   256
+# endif // ifdef ESP8266
+#endif // ifndef CUSTOM_VARS_DENSE_SIZE
+
+// Number of elements the dense part grows at once, to limit reallocations.
+#define CUSTOM_VARS_DENSE_BLOCK    16
+
+
+struct CustomVarStore {
+  CustomVarStore() = default;
+
+  // Return 0 when not set.
+  ESPEASY_RULES_FLOAT_TYPE get(uint32_t index) const;
+
+  void                     set(uint32_t                        index,
+                               const ESPEASY_RULES_FLOAT_TYPE& value);
+
+  bool                     isSet(uint32_t index) const;
+
+  // Get the variable with the lowest index.
+  bool                     getFirst(uint32_t                & index,
+                                    ESPEASY_RULES_FLOAT_TYPE& value) const;
+
+  // Get the first set variable with an index larger than given index.
+  bool                     getNext(uint32_t                & index,
+                                   ESPEASY_RULES_FLOAT_TYPE& value) const;
+
+  void                     clear();
+
+private:
+
+  bool getFrom(uint32_t                 index,
+               uint32_t                & foundIndex,
+               ESPEASY_RULES_FLOAT_TYPE& value) const;
+
+  std::vector<ESPEASY_RULES_FLOAT_TYPE>        _dense;
+  std::map<uint32_t, ESPEASY_RULES_FLOAT_TYPE> _sparse;
+
+  // Bit set for each variable in _dense which has been set.
+  uint32_t _denseIsSet[(CUSTOM_VARS_DENSE_SIZE + 31) / 32]{};
+};
+
+
+#endif // DATASTRUCTS_CUSTOMVARSTORE_H
@@ -0,0 +1,169 @@
+#include "../DataStructs/DNS_Cache.h"
+
+#if FEATURE_DNS_CACHE
+
+# include "../Helpers/ESPEasy_time_calc.h"
+# include "../Helpers/Networking.h"
+
+bool DNS_Cache::resolve(const char *hostname, IPAddress& ip, uint32_t timeout_ms)
+{
+  if ((hostname == nullptr) || (hostname[0] == '\0')) {
+    return false;
+  }
+
+  if (ip.fromString(hostname)) {
+    // Not a host name
+    return true;
+  }
+  const String host(hostname);
+
+  {
+    _mutex.lock();
+    const int index = find(host);
+
+    if ((index >= 0) && isFresh(_entries[index])) {
+      ip                       = _entries[index].ip;
+      _entries[index].lastUsed = millis();
+      ++_hits;
+      _mutex.unlock();
+      return true;
+    }
+    ++_misses;
+    _mutex.unlock();
+  }
+
+  if (lookup(host, ip, timeout_ms)) {
+    return true;
+  }
+
+  // Fall back to the last known address
+  bool res = false;
+
+  _mutex.lock();
+  const int index = find(host);
+
+  if ((index >= 0) && (_entries[index].resolvedMoment != 0)) {
+    ip                       = _entries[index].ip;
+    _entries[index].lastUsed = millis();
+    ++_fallbacks;
+    res = true;
+  }
+  _mutex.unlock();
+  return res;
+}
+
+void DNS_Cache::loop()
+{
+  String host;
+
+  _mutex.lock();
+
+  for (auto it = _entries.begin(); host.isEmpty() && it != _entries.end(); ++it) {
+    // Only refresh entries used within the last TTL period
+    if ((it->resolvedMoment != 0) &&
+        (timePassedSince(it->lastUsed) < DNS_CACHE_TTL) &&
+        (timePassedSince(it->resolvedMoment) > (DNS_CACHE_TTL - DNS_CACHE_REFRESH_MARGIN)) &&
+        ((it->failedMoment == 0) || (timePassedSince(it->failedMoment) > DNS_CACHE_RETRY_INTERVAL))) {
+      host = it->hostname;
+    }
+  }
+  _mutex.unlock();
+
+  if (!host.isEmpty()) {
+    IPAddress ip;
+    lookup(host, ip, 1000);
+  }
+}
+
+void DNS_Cache::clear()
+{
+  _mutex.lock();
+  _entries.clear();
+  _mutex.unlock();
+}
+
+uint32_t DNS_Cache::getAverageLookupTime() const
+{
+  if (_nrLookups == 0) {
+    return 0;
+  }
+  return _totalLookupTime / _nrLookups;
+}
+
+bool DNS_Cache::isFresh(const Entry& entry)
+{
+  if ((entry.failedMoment != 0) && (timePassedSince(entry.failedMoment) < DNS_CACHE_RETRY_INTERVAL)) {
+    // Resolving failed recently, do not try again yet.
+    return entry.resolvedMoment != 0;
+  }
+  return (entry.resolvedMoment != 0) && (timePassedSince(entry.resolvedMoment) < DNS_CACHE_TTL);
+}
+
+bool DNS_Cache::lookup(const String& hostname, IPAddress& ip, uint32_t timeout_ms)
+{
+  const unsigned long start = millis();
+  const bool resolved       = resolveHostByName_noCache(hostname.c_str(), ip, timeout_ms);
+  const uint32_t duration   = timePassedSince(start);
+
+  _mutex.lock();
+  ++_nrLookups;
+  _totalLookupTime += duration;
+
+  if (duration > _maxLookupTime) {
+    _maxLookupTime = duration;
+  }
+
+  int index = find(hostname);
+
+  if (index < 0) {
+    if (!resolved) {
+      // Nothing to fall back to later
+      _mutex.unlock();
+      return false;
+    }
+
+    if (_entries.size() >= DNS_CACHE_MAX_ENTRIES) {
+      // Replace the least recently used entry
+      index = 0;
+
+      for (size_t i = 1; i < _entries.size(); ++i) {
+        if (timePassedSince(_entries[i].lastUsed) > timePassedSince(_entries[index].lastUsed)) {
+          index = i;
+        }
+      }
+      _entries[index] = Entry();
+    } else {
+      _entries.emplace_back();
+      index = _entries.size() - 1;
+    }
+    _entries[index].hostname = hostname;
+    _entries[index].lastUsed = millis();
+  }
+  Entry& entry = _entries[index];
+
+  if (resolved) {
+    entry.ip             = ip;
+    entry.resolvedMoment = millis();
+    entry.failedMoment   = 0;
+  } else {
+    entry.failedMoment = millis();
+
+    if (entry.failedMoment == 0) {
+      entry.failedMoment = 1;
+    }
+  }
+  _mutex.unlock();
+  return resolved;
+}
+
+int DNS_Cache::find(const String& hostname) const
+{
+  for (size_t i = 0; i < _entries.size(); ++i) {
+    if (_entries[i].hostname.equalsIgnoreCase(hostname)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+#endif // if FEATURE_DNS_CACHE
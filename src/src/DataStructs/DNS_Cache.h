@@ -0,0 +1,102 @@
+#ifndef DATASTRUCTS_DNS_CACHE_H
+#define DATASTRUCTS_DNS_CACHE_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_DNS_CACHE
+
+# include "../Helpers/ESPEasyMutex.h"
+
+# include <IPAddress.h>
+# include <vector>
+
+// Max. nr of host names kept in the cache
+# ifndef DNS_CACHE_MAX_ENTRIES
+#  define DNS_CACHE_MAX_ENTRIES      8
+# endif // ifndef DNS_CACHE_MAX_ENTRIES
+
+// Time in msec a resolved address is used without resolving it again.
+// The Arduino API does not provide the TTL of the DNS record, so a fixed TTL is used.
+# ifndef DNS_CACHE_TTL
+#  define DNS_CACHE_TTL              300000
+# endif // ifndef DNS_CACHE_TTL
+
+// Entries used recently are resolved again in the background this long before they expire.
+# define DNS_CACHE_REFRESH_MARGIN    30000
+
+// Time in msec to use the last known address after resolving failed, before trying again.
+# define DNS_CACHE_RETRY_INTERVAL    10000
+
+/*********************************************************************************************\
+* DNS_Cache
+* Cache of resolved host names, shared by all users of resolveHostByName().
+* When resolving a host name fails, the last known address is used.
+\*********************************************************************************************/
+class DNS_Cache {
+public:
+
+  // Return true when the host name is resolved, or a last known address is available.
+  bool     resolve(const char *hostname,
+                   IPAddress & ip,
+                   uint32_t    timeout_ms);
+
+  // Resolve a single recently used host name which is about to expire.
+  void     loop();
+
+  void     clear();
+
+  uint32_t getHits() const {
+    return _hits;
+  }
+
+  uint32_t getMisses() const {
+    return _misses;
+  }
+
+  // Nr of times the last known address was used as resolving failed
+  uint32_t getFallbacks() const {
+    return _fallbacks;
+  }
+
+  // Lookup time in msec of the actual DNS lookups
+  uint32_t getAverageLookupTime() const;
+
+  uint32_t getMaxLookupTime() const {
+    return _maxLookupTime;
+  }
+
+private:
+
+  struct Entry {
+    String        hostname;
+    IPAddress     ip;
+    unsigned long resolvedMoment = 0;
+    unsigned long lastUsed       = 0;
+    unsigned long failedMoment   = 0;
+  };
+
+  // Return true when the address of the entry can be used without resolving it again.
+  static bool isFresh(const Entry& entry);
+
+  // Perform the actual lookup and update the cache.
+  bool        lookup(const String& hostname,
+                     IPAddress   & ip,
+                     uint32_t      timeout_ms);
+
+  // Return the index of the entry, or -1 when not present.
+  int         find(const String& hostname) const;
+
+  std::vector<Entry> _entries;
+  mutable ESPEasy_Mutex _mutex;
+
+  uint32_t _hits            = 0;
+  uint32_t _misses          = 0;
+  uint32_t _fallbacks       = 0;
+  uint32_t _nrLookups       = 0;
+  uint64_t _totalLookupTime = 0;
+  uint32_t _maxLookupTime   = 0;
+};
+
+#endif // if FEATURE_DNS_CACHE
+
+#endif // ifndef DATASTRUCTS_DNS_CACHE_H
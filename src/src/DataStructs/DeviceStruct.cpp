@@ -1,10 +1,12 @@
 #include "../DataStructs/DeviceStruct.h"
 
+#include "../DataTypes/ESPEasy_plugin_functions.h"
 
 
 DeviceStruct::DeviceStruct() :
   Number(0), Type(0), VType(Sensor_VType::SENSOR_TYPE_NONE), Ports(0), ValueCount(0),
   OutputDataType(Output_Data_type_t::Default),
+  PluginCallSubscriptions(PLUGIN_CALL_SUBSCRIBE_ALL),
   PullUpOption(false), InverseLogicOption(false), FormulaOption(false),
   Custom(false), SendDataOption(false), GlobalSyncOption(false),
   TimerOption(false), TimerOptional(false), DecimalsOnly(false),
@@ -67,3 +69,25 @@ bool DeviceStruct::isCustom() const {
          (Type == DEVICE_TYPE_CUSTOM3);
 }
 
+bool DeviceStruct::subscribesTo(uint8_t function) const {
+  PluginCallSubscription_e subscription;
+
+  if (!getPluginCallSubscription(function, subscription)) {
+    return true;
+  }
+  return (PluginCallSubscriptions & (1 << static_cast<uint8_t>(subscription))) != 0;
+}
+
+bool getPluginCallSubscription(uint8_t function, PluginCallSubscription_e& subscription) {
+  switch (function) {
+    case PLUGIN_ONCE_A_SECOND:    subscription = PluginCallSubscription_e::ONCE_A_SECOND;    return true;
+    case PLUGIN_TEN_PER_SECOND:   subscription = PluginCallSubscription_e::TEN_PER_SECOND;   return true;
+    case PLUGIN_FIFTY_PER_SECOND: subscription = PluginCallSubscription_e::FIFTY_PER_SECOND; return true;
+    case PLUGIN_WRITE:            subscription = PluginCallSubscription_e::WRITE;            return true;
+    case PLUGIN_SERIAL_IN:        subscription = PluginCallSubscription_e::SERIAL_IN;        return true;
+    case PLUGIN_UDP_IN:           subscription = PluginCallSubscription_e::UDP_IN;           return true;
+    case PLUGIN_CLOCK_IN:         subscription = PluginCallSubscription_e::CLOCK_IN;         return true;
+    case PLUGIN_TIME_CHANGE:      subscription = PluginCallSubscription_e::TIME_CHANGE;      return true;
+  }
+  return false;
+}
@@ -36,6 +36,32 @@
 
 #define I2C_FLAGS_SLOW_SPEED                0 // Force slow speed when this flag is set
 #define I2C_FLAGS_MUX_MULTICHANNEL          1 // Allow multiple multiplexer channels when set
+#define I2C_FLAGS_CLOCK_PROFILE             2 // Bit 2 ... 4: I2C clock profile, see I2C_ClockProfile.h
+
+// Broadcast plugin calls, which are made to all tasks.
+// Each is a bit in DeviceStruct::PluginCallSubscriptions.
+// Tasks are only called for these functions when their plugin has the bit set.
+enum class PluginCallSubscription_e : uint8_t {
+  ONCE_A_SECOND,
+  TEN_PER_SECOND,
+  FIFTY_PER_SECOND,
+  WRITE,
+  SERIAL_IN,
+  UDP_IN,
+  CLOCK_IN,
+  TIME_CHANGE,
+
+  NR_ELEMENTS // Keep as last
+};
+
+#define PLUGIN_CALL_SUBSCRIBE(S)    (1 << static_cast<uint8_t>(PluginCallSubscription_e::S))
+#define PLUGIN_CALL_SUBSCRIBE_NONE  0
+#define PLUGIN_CALL_SUBSCRIBE_ALL   0xFF
+
+// Get the subscription for a plugin function.
+// @retval false when the function is not a broadcast plugin call
+bool getPluginCallSubscription(uint8_t                   function,
+                               PluginCallSubscription_e& subscription);
 
 
 
@@ -62,6 +88,10 @@ struct __attribute__((__packed__)) DeviceStruct
 
   bool isCustom() const;
 
+  // Whether the plugin handles a broadcast plugin call.
+  // Always true for other functions.
+  bool subscribesTo(uint8_t function) const;
+
   pluginID_t getPluginID() const
   {
     return pluginID_t::toPluginID(Number);
@@ -74,6 +104,7 @@ struct __attribute__((__packed__)) DeviceStruct
   uint8_t            Ports;          // Port to use when device has multiple I/O pins  (N.B. not used much)
   uint8_t            ValueCount;     // The number of output values of a plugin. The value should match the number of keys PLUGIN_VALUENAME1_xxx
   Output_Data_type_t OutputDataType; // Subset of selectable output data types (Default = no selection)
+  uint8_t            PluginCallSubscriptions; // Bitmask of broadcast plugin calls handled by the plugin, see PLUGIN_CALL_SUBSCRIBE() (Default = all)
                                      
   bool PullUpOption       : 1;       // Allow to set internal pull-up resistors.
   bool InverseLogicOption : 1;       // Allow to invert the boolean state (e.g. a switch)
@@ -29,6 +29,12 @@ struct ControllerCache_struct {
 
   bool   isInitialized() const;
 
+#if FEATURE_RTC_CACHE_COMPRESSION
+
+  // Store new samples in compressed blocks
+  void   setCompression(bool compress);
+#endif // if FEATURE_RTC_CACHE_COMPRESSION
+
   // Clear all caches
   void   clearCache();
 
@@ -40,6 +46,9 @@ struct ControllerCache_struct {
 
   void   closeOpenFiles();
 
+  // Delete old cache files and run FS garbage collection while the scheduler is idle.
+  bool   backgroundMaintenance();
+
   void   resetpeek();
 
   bool   peekDataAvailable() const;
@@ -54,6 +63,24 @@ struct ControllerCache_struct {
   bool   peek(uint8_t     *data,
               unsigned int size) const;
 
+#if FEATURE_RTC_CACHE_INDEX
+
+  // Set the peek position to the first sample with a timestamp at or after unixTime.
+  // Uses the index files to skip the older samples.
+  // Return false when there is no such sample.
+  bool   seekToTime(uint32_t unixTime);
+
+  // Range of file positions holding the samples between startTime and endTime.
+  // Intended for bulk export. See RTC_cache_handler_struct for details.
+  // With endTime 0, endFileNr and endPos are set to -1 (no end).
+  bool   getIndexedRange(uint32_t startTime,
+                         uint32_t endTime,
+                         int    & startFileNr,
+                         int    & startPos,
+                         int    & endFileNr,
+                         int    & endPos);
+#endif // if FEATURE_RTC_CACHE_INDEX
+
   String getNextCacheFileName(int& fileNr, bool& islast);
 
 private:
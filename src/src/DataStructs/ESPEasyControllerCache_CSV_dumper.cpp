@@ -132,7 +132,7 @@ bool ESPEasyControllerCache_CSV_dumper::createCSVLine()
 
   // Fetch samples from Cache Controller bin files.
   if (_element_processed) {
-    if (!C016_getTaskSample(_element)) {
+    if (!getTaskSample()) {
       return !_outputLine.line.isEmpty();
     }
     _outputLine.markEnd();
@@ -204,7 +204,7 @@ bool ESPEasyControllerCache_CSV_dumper::createCSVLine()
       ++csv_values_left;
     }
     _outputLine.markEnd();
-    _element_processed = !C016_getTaskSample(_element);
+    _element_processed = !getTaskSample();
   }
 
   if (csv_values_left > 0) {
@@ -219,6 +219,43 @@ void ESPEasyControllerCache_CSV_dumper::setPeekFilePos(int peekFileNr, int peekR
   _element_processed = true;
 }
 
+# if FEATURE_RTC_CACHE_INDEX
+void ESPEasyControllerCache_CSV_dumper::setTimeRange(uint32_t startTime, uint32_t endTime)
+{
+  _endTime           = endTime;
+  _endOfData         = false;
+  _element_processed = true;
+
+  if (startTime != 0) {
+    _endOfData = !ControllerCache.seekToTime(startTime);
+  }
+}
+
+# endif // if FEATURE_RTC_CACHE_INDEX
+
+bool ESPEasyControllerCache_CSV_dumper::getTaskSample()
+{
+# if FEATURE_RTC_CACHE_INDEX
+
+  if (_endOfData) {
+    return false;
+  }
+
+  if (!C016_getTaskSample(_element)) {
+    return false;
+  }
+
+  if ((_endTime != 0) && (static_cast<uint32_t>(_element.unixTime) > _endTime)) {
+    // Samples are stored in chronological order, so no need to read further.
+    _endOfData = true;
+    return false;
+  }
+  return true;
+# else // if FEATURE_RTC_CACHE_INDEX
+  return C016_getTaskSample(_element);
+# endif // if FEATURE_RTC_CACHE_INDEX
+}
+
 void ESPEasyControllerCache_CSV_dumper::flushValuesLeft(uint32_t csv_values_left)
 {
   if (_joinTimestamp) {
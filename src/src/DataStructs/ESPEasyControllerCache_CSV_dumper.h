@@ -51,6 +51,14 @@ struct ESPEasyControllerCache_CSV_dumper {
   void setPeekFilePos(int peekFileNr,
                       int peekReadPos);
 
+# if FEATURE_RTC_CACHE_INDEX
+
+  // Only dump samples within the given time range (unix time, inclusive).
+  // A time of 0 means no limit.
+  void setTimeRange(uint32_t startTime,
+                    uint32_t endTime);
+# endif // if FEATURE_RTC_CACHE_INDEX
+
 private:
 
   uint32_t writeToTarget(const String& str,
@@ -61,6 +69,9 @@ private:
 
   void     flushValuesLeft(uint32_t csv_values_left);
 
+  // Fetch the next sample within the set time range.
+  bool     getTaskSample();
+
   String  _csv_values[VARS_PER_TASK * TASKS_MAX];
   uint8_t _nrDecimals[VARS_PER_TASK * TASKS_MAX] = { 0 };
   bool    _includeTask[TASKS_MAX]                = { 0 };
@@ -77,6 +88,11 @@ private:
   int _backup_peekFileNr  = 0;
   int _backup_peekFilePos = 0;
 
+# if FEATURE_RTC_CACHE_INDEX
+  uint32_t _endTime   = 0;
+  bool     _endOfData = false;
+# endif // if FEATURE_RTC_CACHE_INDEX
+
   Target _target = Target::CSV_file;
 };
 #endif // if FEATURE_RTC_CACHE_STORAGE
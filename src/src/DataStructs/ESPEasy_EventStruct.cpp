@@ -10,6 +10,8 @@
 
 #include "../../_Plugin_Helper.h"
 
+#include <utility>
+
 EventStruct::EventStruct(taskIndex_t taskIndex) :
   TaskIndex(taskIndex), BaseVarIndex(taskIndex * VARS_PER_TASK)
 {
@@ -28,6 +30,38 @@ void EventStruct::deep_copy(const struct EventStruct *other) {
   }
 }
 
+void EventStruct::copy_except_strings(const struct EventStruct& other) {
+  // N.B. Keep in sync with the members of EventStruct
+  timestamp       = other.timestamp;
+#if FEATURE_SAMPLE_LATENCY
+  readTime_usec   = other.readTime_usec;
+#endif // if FEATURE_SAMPLE_LATENCY
+  Data            = other.Data;
+  idx             = other.idx;
+  Par1            = other.Par1;
+  Par2            = other.Par2;
+  Par3            = other.Par3;
+  Par4            = other.Par4;
+  Par5            = other.Par5;
+  Source          = other.Source;
+  TaskIndex       = other.TaskIndex;
+  ControllerIndex = other.ControllerIndex;
+#if FEATURE_NOTIFIER
+  NotificationIndex = other.NotificationIndex;
+#endif
+  BaseVarIndex    = other.BaseVarIndex;
+  sensorType      = other.sensorType;
+  OriginTaskIndex = other.OriginTaskIndex;
+}
+
+void EventStruct::swap_strings(struct EventStruct& other) {
+  std::swap(String1, other.String1);
+  std::swap(String2, other.String2);
+  std::swap(String3, other.String3);
+  std::swap(String4, other.String4);
+  std::swap(String5, other.String5);
+}
+
 void EventStruct::setTaskIndex(taskIndex_t taskIndex) {
   TaskIndex = taskIndex;
 
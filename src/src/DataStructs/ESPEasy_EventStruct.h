@@ -34,6 +34,12 @@ public:
   // Copy constructor and assignment operator should not be used.
   void deep_copy(const struct EventStruct& other);
   void deep_copy(const struct EventStruct* other);
+
+  // Copy all members, except the strings.
+  void copy_except_strings(const struct EventStruct& other);
+
+  // Exchange the strings with those of the other event, without copying them.
+  void swap_strings(struct EventStruct& other);
   //  explicit EventStruct(const struct EventStruct& event);
   //  EventStruct& operator=(const struct EventStruct& other);
 
@@ -51,6 +57,9 @@ public:
   String        String4;
   String        String5;
   unsigned long timestamp = 0u;
+#if FEATURE_SAMPLE_LATENCY
+  uint64_t      readTime_usec = 0u; // getMicros64() when PLUGIN_READ was called, 0 = not read by SensorSendTask
+#endif // if FEATURE_SAMPLE_LATENCY
   uint8_t      *Data = nullptr;
   int           idx  = 0;
   int           Par1 = 0;
@@ -1,6 +1,7 @@
 #include "../DataStructs/ESPEasy_packed_raw_data.h"
 
-#if FEATURE_PACKED_RAW_DATA
+// The data types are also used to describe the CBOR payload of MQTT controllers
+#if FEATURE_PACKED_RAW_DATA || FEATURE_MQTT_CBOR_PAYLOAD
 
 uint8_t getPackedDataTypeSize(PackedData_enum dtype, float& factor, float& offset) {
   offset = 0;
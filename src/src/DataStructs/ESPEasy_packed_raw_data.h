@@ -3,7 +3,8 @@
 
 #include "../../ESPEasy_common.h"
 
-#if FEATURE_PACKED_RAW_DATA
+// The data types are also used to describe the CBOR payload of MQTT controllers
+#if FEATURE_PACKED_RAW_DATA || FEATURE_MQTT_CBOR_PAYLOAD
 
 // Data types used in packed encoder.
 // p_uint16_1e2 means it is a 16 bit unsigned int, but multiplied by 100 first.
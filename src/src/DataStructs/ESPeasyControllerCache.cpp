@@ -44,6 +44,14 @@ bool ControllerCache_struct::isInitialized() const {
   return _RTC_cache_handler != nullptr;
 }
 
+#if FEATURE_RTC_CACHE_COMPRESSION
+void ControllerCache_struct::setCompression(bool compress) {
+  if (_RTC_cache_handler != nullptr) {
+    _RTC_cache_handler->setCompression(compress);
+  }
+}
+#endif // if FEATURE_RTC_CACHE_COMPRESSION
+
 // Clear all caches
 void ControllerCache_struct::clearCache() {}
 
@@ -60,6 +68,13 @@ void ControllerCache_struct::closeOpenFiles() {
   }
 }
 
+bool ControllerCache_struct::backgroundMaintenance() {
+  if (_RTC_cache_handler != nullptr) {
+    return _RTC_cache_handler->backgroundMaintenance();
+  }
+  return false;
+}
+
 bool ControllerCache_struct::deleteAllCacheBlocks() {
   if (_RTC_cache_handler != nullptr) {
     return _RTC_cache_handler->deleteAllCacheBlocks();
@@ -115,6 +130,37 @@ bool ControllerCache_struct::peek(uint8_t *data, unsigned int size) const {
   return _RTC_cache_handler->peek(data, size);
 }
 
+#if FEATURE_RTC_CACHE_INDEX
+bool ControllerCache_struct::seekToTime(uint32_t unixTime) {
+  if (_RTC_cache_handler == nullptr) {
+    return false;
+  }
+  return _RTC_cache_handler->seekToTime(unixTime);
+}
+
+bool ControllerCache_struct::getIndexedRange(uint32_t startTime,
+                                             uint32_t endTime,
+                                             int    & startFileNr,
+                                             int    & startPos,
+                                             int    & endFileNr,
+                                             int    & endPos) {
+  if (_RTC_cache_handler == nullptr) {
+    return false;
+  }
+  _RTC_cache_handler->getIndexedStartPos(startTime, startFileNr, startPos);
+
+  if (endTime == 0) {
+    // No end time, read all
+    endFileNr = -1;
+    endPos    = -1;
+  } else {
+    _RTC_cache_handler->getIndexedEndPos(endTime, endFileNr, endPos);
+  }
+  return true;
+}
+
+#endif // if FEATURE_RTC_CACHE_INDEX
+
 String ControllerCache_struct::getNextCacheFileName(int& fileNr, bool& islast) {
   if (_RTC_cache_handler == nullptr) {
     fileNr = -1;
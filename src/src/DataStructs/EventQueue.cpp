@@ -2,56 +2,36 @@
 
 #include "../../ESPEasy_common.h"
 
+#include "../Globals/Cache.h"
 #include "../Globals/Settings.h"
+#include "../Helpers/ControllerQueueTask.h"
+#include "../Helpers/HeapTracker.h"
 #include "../Helpers/Misc.h"
 
 
 void EventQueueStruct::add(const String& event, bool deduplicate)
 {
-  #ifdef USE_SECOND_HEAP
-  HeapSelectIram ephemeral;
-  #endif // ifdef USE_SECOND_HEAP
-
-  if (!deduplicate || !isDuplicate(event)) {
-    _eventQueue.push_back(event);
-  }
+  add(event.c_str(), event.length(), deduplicate);
 }
 
 void EventQueueStruct::add(const __FlashStringHelper *event, bool deduplicate)
 {
-  #ifdef USE_SECOND_HEAP
-  HeapSelectIram ephemeral;
-  #endif // ifdef USE_SECOND_HEAP
+  // Need to copy it from flash first
+  const String str(event);
 
-  // Wrap in String() constructor to make sure it is using the 2nd heap allocator if present.
-  if (!deduplicate || !isDuplicate(event)) {
-    _eventQueue.push_back(String(event));
-  }
+  add(str.c_str(), str.length(), deduplicate);
 }
 
 void EventQueueStruct::addMove(String&& event, bool deduplicate)
 {
-  if (!event.length()) { return; }
-  #ifdef USE_SECOND_HEAP
-  HeapSelectIram ephemeral;
-
-  if (!mmu_is_iram(&(event[0]))) {
-    // Wrap in String constructor to make sure it is stored in the 2nd heap.
-    if (!deduplicate || !isDuplicate(event)) {
-      _eventQueue.push_back(String(event));
-    }
-    return;
-  }
-  #endif // ifdef USE_SECOND_HEAP
-
-  if (!deduplicate || !isDuplicate(event)) {
-    _eventQueue.emplace_back(std::move(event));
-  }
+  // Event will be copied into the arena, so no need to keep the String.
+  add(event.c_str(), event.length(), deduplicate);
+  event = String();
 }
 
 void EventQueueStruct::add(taskIndex_t TaskIndex, const String& varName, const String& eventValue)
 {
-  if (Settings.UseRules) {
+  if (Settings.UseRules && taskEventMayMatch(TaskIndex)) {
     String eventCommand = getTaskDeviceName(TaskIndex);
     eventCommand.reserve(eventCommand.length() + 2 + varName.length() + eventValue.length());
     eventCommand += '#';
@@ -67,54 +47,313 @@ void EventQueueStruct::add(taskIndex_t TaskIndex, const String& varName, const S
 
 void EventQueueStruct::add(taskIndex_t TaskIndex, const String& varName, int eventValue)
 {
-  if (Settings.UseRules) {
+  if (Settings.UseRules && taskEventMayMatch(TaskIndex)) {
     add(TaskIndex, varName, String(eventValue));
   }
 }
 
 void EventQueueStruct::add(taskIndex_t TaskIndex, const __FlashStringHelper *varName, const String& eventValue)
 {
-  if (Settings.UseRules) {
+  if (Settings.UseRules && taskEventMayMatch(TaskIndex)) {
     add(TaskIndex, String(varName), eventValue);
   }
 }
 
 void EventQueueStruct::add(taskIndex_t TaskIndex, const __FlashStringHelper *varName, int eventValue)
 {
-  if (Settings.UseRules) {
+  if (Settings.UseRules && taskEventMayMatch(TaskIndex)) {
     add(TaskIndex, String(varName), String(eventValue));
   }
 }
 
+bool EventQueueStruct::taskEventMayMatch(taskIndex_t TaskIndex)
+{
+  if (Cache.rulesHelper.taskEventMayMatch(getTaskDeviceName(TaskIndex))) {
+    return true;
+  }
+  ++_filteredCount;
+  return false;
+}
+
 bool EventQueueStruct::getNext(String& event)
 {
-  if (_eventQueue.empty()) {
+  if (isEmpty()) {
     return false;
   }
-  #ifdef USE_SECOND_HEAP
   {
-    // Fetch the event and make sure it is allocated on the DRAM heap, not the 2nd heap
+    #ifdef USE_SECOND_HEAP
+
+    // Make sure the event is allocated on the DRAM heap, not the 2nd heap
     // Otherwise checks like strnlen_P may crash on it.
     HeapSelectDram ephemeral;
-    event = std::move(String(_eventQueue.front()));
+    #endif // ifdef USE_SECOND_HEAP
+
+    // Head record is never a removed one.
+    const EventRecord& record = _records[_head];
+    event = String();
+
+    if (event.reserve(record.length)) {
+      const char *data = &_arena[record.offset];
+
+      for (uint16_t i = 0; i < record.length; ++i) {
+        event += data[i];
+      }
+    }
   }
-  #else // ifdef USE_SECOND_HEAP
-  event = std::move(_eventQueue.front());
-  #endif // ifdef USE_SECOND_HEAP
-  _eventQueue.pop_front();
+  removeFront();
   return true;
 }
 
 void EventQueueStruct::clear()
 {
-  _eventQueue.clear();
+  _head         = 0;
+  _count        = 0;
+  _removedCount = 0;
+
+  for (size_t i = 0; i < EVENT_QUEUE_HASH_BUCKETS; ++i) {
+    _hashCount[i] = 0;
+  }
 }
 
 bool EventQueueStruct::isEmpty() const
 {
-  return _eventQueue.empty();
+  return size() == 0;
+}
+
+bool EventQueueStruct::allocate()
+{
+  if (_arena.empty()) {
+    HEAP_TRACK_SCOPE(EventQueue);
+
+    // Allocated only once, to prevent heap fragmentation.
+    #ifdef USE_SECOND_HEAP
+    HeapSelectIram ephemeral;
+    #endif // ifdef USE_SECOND_HEAP
+
+    _arena.resize(EVENT_QUEUE_ARENA_SIZE);
+    _records.resize(EVENT_QUEUE_MAX_EVENTS);
+  }
+  return _arena.size() == EVENT_QUEUE_ARENA_SIZE &&
+         _records.size() == EVENT_QUEUE_MAX_EVENTS;
+}
+
+void EventQueueStruct::add(const char *event, size_t length, bool deduplicate)
+{
+  if (length == 0) { return; }
+
+  #if FEATURE_CONTROLLER_QUEUE_TASK
+
+  if (controllerQueueTask_isWorker()) {
+    // The queue is only accessed from the main loop.
+    controllerQueueTask_deferEvent(event, length, deduplicate);
+    return;
+  }
+  #endif // if FEATURE_CONTROLLER_QUEUE_TASK
+
+  if (!allocate()) { return; }
+
+  if (!Cache.rulesHelper.eventMayMatch(event, length)) {
+    ++_filteredCount;
+    return;
+  }
+
+  const uint32_t eventHash = hash(event, length);
+
+  if (deduplicate && isDuplicate(event, length, eventHash)) {
+    return;
+  }
+
+  uint16_t offset = 0;
+
+  if (!getFreeOffset(length, offset)) {
+    // Queue is full
+    const EventQueueOverflowPolicy_e policy = Settings.EventQueueOverflowPolicy();
+
+    if ((length > EVENT_QUEUE_ARENA_SIZE) ||
+        (policy == EventQueueOverflowPolicy_e::DropNewest)) {
+      ++_droppedCount;
+      return;
+    }
+
+    if ((policy == EventQueueOverflowPolicy_e::CoalesceEventName) &&
+        coalesce(event, length, eventHash)) {
+      return;
+    }
+
+    // Remove the oldest events until the new event fits
+    while (!getFreeOffset(length, offset)) {
+      if (_count == 0) {
+        ++_droppedCount;
+        return;
+      }
+      removeFront();
+      ++_droppedCount;
+    }
+  }
+
+  memcpy(&_arena[offset], event, length);
+
+  EventRecord& record = _records[recordIndex(_count)];
+  record.hash    = eventHash;
+  record.offset  = offset;
+  record.length  = length;
+  record.removed = false;
+  ++_count;
+  ++_hashCount[eventHash % EVENT_QUEUE_HASH_BUCKETS];
+
+  if (size() > _maxDepth) {
+    _maxDepth = size();
+  }
+}
+
+bool EventQueueStruct::getFreeOffset(size_t length, uint16_t& offset) const
+{
+  if ((length > EVENT_QUEUE_ARENA_SIZE) || (_count >= EVENT_QUEUE_MAX_EVENTS)) {
+    return false;
+  }
+
+  if (_count == 0) {
+    offset = 0;
+    return true;
+  }
+
+  // Events are stored in the order of the records.
+  // Data is present from the start of the oldest event, up to the end of the newest event.
+  const size_t start  = _records[_head].offset;
+  const EventRecord& newest = _records[recordIndex(_count - 1)];
+  const size_t end    = newest.offset + newest.length;
+
+  if (newest.offset >= start) {
+    // Not wrapped, free space at the end and before the oldest event.
+    if ((EVENT_QUEUE_ARENA_SIZE - end) >= length) {
+      offset = end;
+      return true;
+    }
+
+    if (start >= length) {
+      offset = 0;
+      return true;
+    }
+    return false;
+  }
+
+  // Wrapped, the only free space is between newest and oldest event.
+  if ((start - end) >= length) {
+    offset = end;
+    return true;
+  }
+  return false;
+}
+
+bool EventQueueStruct::coalesce(const char *event, size_t length, uint32_t eventHash)
+{
+  const size_t name_length = nameLength(event, length);
+
+  // Look for the most recent pending event with the same name
+  for (size_t nr = _count; nr > 0; --nr) {
+    const size_t index  = recordIndex(nr - 1);
+    EventRecord& record = _records[index];
+
+    if (!record.removed) {
+      const char *data = &_arena[record.offset];
+
+      if ((nameLength(data, record.length) == name_length) &&
+          (memcmp(data, event, name_length) == 0)) {
+        ++_coalescedCount;
+
+        if (length <= record.length) {
+          // Replace the pending event with the new one.
+          memcpy(&_arena[record.offset], event, length);
+          --_hashCount[record.hash % EVENT_QUEUE_HASH_BUCKETS];
+          ++_hashCount[eventHash % EVENT_QUEUE_HASH_BUCKETS];
+          record.hash   = eventHash;
+          record.length = length;
+          return true;
+        }
+
+        // Does not fit, so remove the pending one and add the new event at the end.
+        markRemoved(index);
+        return false;
+      }
+    }
+  }
+  return false;
+}
+
+void EventQueueStruct::removeFront()
+{
+  if (_count == 0) { return; }
+
+  do {
+    const EventRecord& record = _records[_head];
+
+    if (record.removed) {
+      --_removedCount;
+    } else {
+      --_hashCount[record.hash % EVENT_QUEUE_HASH_BUCKETS];
+    }
+    _head = recordIndex(1);
+    --_count;
+
+    // Skip any removed records, so the head record is always a valid one.
+  } while (_count > 0 && _records[_head].removed);
+
+  if (_count == 0) {
+    _head = 0;
+  }
+}
+
+void EventQueueStruct::markRemoved(size_t index)
+{
+  EventRecord& record = _records[index];
+
+  if (record.removed) { return; }
+
+  if (index == _head) {
+    removeFront();
+    return;
+  }
+  record.removed = true;
+  ++_removedCount;
+  --_hashCount[record.hash % EVENT_QUEUE_HASH_BUCKETS];
+}
+
+uint32_t EventQueueStruct::hash(const char *event, size_t length)
+{
+  // FNV-1a hash
+  uint32_t res = 2166136261u;
+
+  for (size_t i = 0; i < length; ++i) {
+    res ^= static_cast<uint8_t>(event[i]);
+    res *= 16777619u;
+  }
+  return res;
+}
+
+size_t EventQueueStruct::nameLength(const char *event, size_t length)
+{
+  const char *pos = static_cast<const char *>(memchr(event, '=', length));
+
+  if (pos == nullptr) { return length; }
+  return pos - event;
 }
 
-bool EventQueueStruct::isDuplicate(const String& event) {
-  return std::find(_eventQueue.begin(), _eventQueue.end(), event) != _eventQueue.end();
+bool EventQueueStruct::isDuplicate(const char *event, size_t length, uint32_t eventHash) const
+{
+  if (_hashCount[eventHash % EVENT_QUEUE_HASH_BUCKETS] == 0) {
+    // Quick check, no event present with a hash in the same bucket
+    return false;
+  }
+
+  for (size_t nr = 0; nr < _count; ++nr) {
+    const EventRecord& record = _records[recordIndex(nr)];
+
+    if (!record.removed &&
+        (record.hash == eventHash) &&
+        (record.length == length) &&
+        (memcmp(&_arena[record.offset], event, length) == 0)) {
+      return true;
+    }
+  }
+  return false;
 }
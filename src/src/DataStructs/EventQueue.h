@@ -2,12 +2,35 @@
 #define DATASTRUCTS_EVENTQUEUE_H
 
 
-#include <list>
+#include <vector>
 
 
+#include "../DataTypes/EventQueueOverflowPolicy.h"
 #include "../Globals/Plugins.h"
 
 
+// Events are stored in a fixed size byte arena, used as ring buffer.
+// This avoids heap fragmentation during bursts of events.
+#ifndef EVENT_QUEUE_ARENA_SIZE
+# ifdef ESP8266
+#  define EVENT_QUEUE_ARENA_SIZE   3072
+# else // ifdef ESP8266
+#  define EVENT_QUEUE_ARENA_SIZE   16384
+# endif // ifdef ESP8266
+#endif // ifndef EVENT_QUEUE_ARENA_SIZE
+
+#ifndef EVENT_QUEUE_MAX_EVENTS
+# ifdef ESP8266
+#  define EVENT_QUEUE_MAX_EVENTS   64
+# else // ifdef ESP8266
+#  define EVENT_QUEUE_MAX_EVENTS   256
+# endif // ifdef ESP8266
+#endif // ifndef EVENT_QUEUE_MAX_EVENTS
+
+// Number of buckets to count event hashes, used for quick duplicate check
+#define EVENT_QUEUE_HASH_BUCKETS   64
+
+
 struct EventQueueStruct {
   EventQueueStruct() = default;
 
@@ -32,15 +55,88 @@ struct EventQueueStruct {
 
   bool        isEmpty() const;
 
-  std::size_t size() {
-    return _eventQueue.size();
+  std::size_t size() const {
+    return _count - _removedCount;
+  }
+
+  // Number of events dropped due to a full queue
+  uint32_t getDroppedCount() const {
+    return _droppedCount;
+  }
+
+  // Number of events replaced by a newer event with the same name
+  uint32_t getCoalescedCount() const {
+    return _coalescedCount;
+  }
+
+  // Number of events not queued as no rule can match them
+  uint32_t getFilteredCount() const {
+    return _filteredCount;
+  }
+
+  // Return false when no event of the task can match any rule.
+  // Events of this task will then not be added to the queue.
+  bool     taskEventMayMatch(taskIndex_t TaskIndex);
+
+  // Max. number of events present in the queue
+  uint16_t getMaxDepth() const {
+    return _maxDepth;
   }
 
 private:
 
-  bool isDuplicate(const String& event);
+  struct EventRecord {
+    uint32_t hash    = 0;
+    uint16_t offset  = 0; // Offset in the arena
+    uint16_t length  = 0;
+    bool     removed = false;
+  };
+
+  bool         allocate();
+
+  void         add(const char *event,
+                   size_t      length,
+                   bool        deduplicate);
+
+  // Try to find a free contiguous block in the arena for an event of given length.
+  bool         getFreeOffset(size_t    length,
+                             uint16_t& offset) const;
+
+  // Replace a pending event with the same name by the new event.
+  // Return true when the new event was stored in place of the pending one.
+  bool         coalesce(const char *event,
+                        size_t      length,
+                        uint32_t    eventHash);
+
+  void         removeFront();
+
+  void         markRemoved(size_t index);
+
+  size_t       recordIndex(size_t nr) const {
+    return (_head + nr) % EVENT_QUEUE_MAX_EVENTS;
+  }
+
+  static uint32_t hash(const char *event,
+                       size_t      length);
+
+  static size_t   nameLength(const char *event,
+                             size_t      length);
+
+  bool            isDuplicate(const char *event,
+                              size_t      length,
+                              uint32_t    hash) const;
+
+  std::vector<char>        _arena;
+  std::vector<EventRecord> _records;
 
-  std::list<String>_eventQueue;
+  uint16_t _hashCount[EVENT_QUEUE_HASH_BUCKETS]{};
+  uint16_t _head         = 0; // Index of the oldest record
+  uint16_t _count        = 0; // Number of records, including removed ones
+  uint16_t _removedCount = 0;
+  uint16_t _maxDepth     = 0;
+  uint32_t _droppedCount   = 0;
+  uint32_t _coalescedCount = 0;
+  uint32_t _filteredCount  = 0;
 };
 
 
@@ -0,0 +1,98 @@
+#include "../DataStructs/ExtraTaskSettings_LRU.h"
+
+#if FEATURE_EXTRA_TASK_SETTINGS_LRU
+
+# include "../DataStructs/ExtraTaskSettingsStruct.h"
+# include "../Helpers/ESPEasy_time_calc.h"
+# include "../Helpers/Memory.h"
+
+ExtraTaskSettings_LRU::~ExtraTaskSettings_LRU() {
+  clear();
+}
+
+bool ExtraTaskSettings_LRU::get(taskIndex_t              taskIndex,
+                                const ChecksumType     & checksum,
+                                ExtraTaskSettingsStruct& settings) {
+  const int index = find(taskIndex);
+
+  if ((index < 0) || !(_entries[index].checksum == checksum)) {
+    ++_misses;
+    return false;
+  }
+  memcpy(reinterpret_cast<uint8_t *>(&settings), _entries[index].data, sizeof(ExtraTaskSettingsStruct));
+  _entries[index].lastUsed = millis();
+  ++_hits;
+  return true;
+}
+
+void ExtraTaskSettings_LRU::set(const ExtraTaskSettingsStruct& settings,
+                                const ChecksumType           & checksum) {
+  if (!validTaskIndex(settings.TaskIndex)) {
+    return;
+  }
+  int index = find(settings.TaskIndex);
+
+  if (index < 0) {
+    if (_entries.size() < EXTRA_TASK_SETTINGS_LRU_SIZE) {
+      void *ptr = special_calloc(1, sizeof(ExtraTaskSettingsStruct));
+
+      if (ptr == nullptr) {
+        return;
+      }
+      Entry entry;
+      entry.data = static_cast<ExtraTaskSettingsStruct *>(ptr);
+      _entries.push_back(entry);
+      index = _entries.size() - 1;
+    } else {
+      // Replace a cleared entry, or else the least recently used entry
+      index = 0;
+
+      for (size_t i = 0; i < _entries.size(); ++i) {
+        if (!validTaskIndex(_entries[i].taskIndex)) {
+          index = i;
+          break;
+        }
+
+        if (timeDiff(_entries[i].lastUsed, _entries[index].lastUsed) > 0) {
+          index = i;
+        }
+      }
+    }
+  }
+  Entry& entry = _entries[index];
+
+  memcpy(entry.data, reinterpret_cast<const uint8_t *>(&settings), sizeof(ExtraTaskSettingsStruct));
+  entry.checksum  = checksum;
+  entry.taskIndex = settings.TaskIndex;
+  entry.lastUsed  = millis();
+}
+
+void ExtraTaskSettings_LRU::clear(taskIndex_t taskIndex) {
+  const int index = find(taskIndex);
+
+  if (index >= 0) {
+    // Keep the allocated memory, it will be used for the next task.
+    _entries[index].taskIndex = INVALID_TASK_INDEX;
+    _entries[index].checksum  = ChecksumType();
+  }
+}
+
+void ExtraTaskSettings_LRU::clear() {
+  for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+    free(it->data);
+  }
+  _entries.clear();
+}
+
+int ExtraTaskSettings_LRU::find(taskIndex_t taskIndex) const {
+  if (validTaskIndex(taskIndex)) {
+    for (size_t i = 0; i < _entries.size(); ++i) {
+      if (_entries[i].taskIndex == taskIndex) {
+        return i;
+      }
+    }
+  }
+  return -1;
+}
+
+#endif // if FEATURE_EXTRA_TASK_SETTINGS_LRU
@@ -0,0 +1,74 @@
+#ifndef DATASTRUCTS_EXTRATASKSETTINGS_LRU_H
+#define DATASTRUCTS_EXTRATASKSETTINGS_LRU_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_EXTRA_TASK_SETTINGS_LRU
+
+# include "../DataStructs/ChecksumType.h"
+# include "../DataTypes/TaskIndex.h"
+
+# include <vector>
+
+// Max. nr of full ExtraTaskSettings kept in memory (~470 bytes each)
+# ifndef EXTRA_TASK_SETTINGS_LRU_SIZE
+#  define EXTRA_TASK_SETTINGS_LRU_SIZE  8
+# endif // ifndef EXTRA_TASK_SETTINGS_LRU_SIZE
+
+struct ExtraTaskSettingsStruct;
+
+/*********************************************************************************************\
+* ExtraTaskSettings_LRU
+* Copies of the most recently loaded ExtraTaskSettings, so LoadTaskSettings() does not need
+* to read from the file system when switching between tasks.
+* Each copy is stored along with the checksum of the loaded settings, so a copy is only used
+* when it still matches the checksum kept in the task settings cache.
+* Copies are allocated in PSRAM when present.
+\*********************************************************************************************/
+class ExtraTaskSettings_LRU {
+public:
+
+  ~ExtraTaskSettings_LRU();
+
+  // Copy the cached settings of the task into settings.
+  // Return false when not present or the checksum does not match.
+  bool     get(taskIndex_t              taskIndex,
+               const ChecksumType     & checksum,
+               ExtraTaskSettingsStruct& settings);
+
+  // Store a copy of the settings, replacing the least recently used entry when full.
+  void     set(const ExtraTaskSettingsStruct& settings,
+               const ChecksumType           & checksum);
+
+  void     clear(taskIndex_t taskIndex);
+
+  void     clear();
+
+  uint32_t getHits() const {
+    return _hits;
+  }
+
+  uint32_t getMisses() const {
+    return _misses;
+  }
+
+private:
+
+  struct Entry {
+    ExtraTaskSettingsStruct *data      = nullptr;
+    ChecksumType             checksum;
+    unsigned long            lastUsed  = 0;
+    taskIndex_t              taskIndex = INVALID_TASK_INDEX;
+  };
+
+  // Return the index of the entry, or -1 when not present.
+  int find(taskIndex_t taskIndex) const;
+
+  std::vector<Entry> _entries;
+  uint32_t           _hits   = 0;
+  uint32_t           _misses = 0;
+};
+
+#endif // if FEATURE_EXTRA_TASK_SETTINGS_LRU
+
+#endif // ifndef DATASTRUCTS_EXTRATASKSETTINGS_LRU_H
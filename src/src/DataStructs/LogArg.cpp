@@ -0,0 +1,172 @@
+#include "../DataStructs/LogArg.h"
+
+#include "../Helpers/StringConverter_Numerical.h"
+
+// Max. length of a conversion specification, e.g. "%-08.3f"
+#define LOG_ARG_MAX_SPEC_LENGTH  12
+
+static bool isConversionChar(char c) {
+  return strchr("diuxXcsfFeEgGp", c) != nullptr;
+}
+
+static bool isLengthModifier(char c) {
+  return strchr("hlLqjzt", c) != nullptr;
+}
+
+// Pad the value to the width set in the specification
+static void appendPadded(String& output, const String& value, const char *spec) {
+  bool leftAlign = false;
+  bool zeroPad   = false;
+  size_t  width  = 0;
+  const char *c  = spec + 1;
+
+  for (; *c == '-' || *c == '0' || *c == '+' || *c == ' ' || *c == '#'; ++c) {
+    if (*c == '-') { leftAlign = true; }
+
+    if (*c == '0') { zeroPad = true; }
+  }
+
+  for (; isdigit(*c); ++c) {
+    width = width * 10 + (*c - '0');
+  }
+
+  if (leftAlign) {
+    output += value;
+  }
+
+  for (size_t i = value.length(); i < width; ++i) {
+    output += (zeroPad && !leftAlign) ? '0' : ' ';
+  }
+
+  if (!leftAlign) {
+    output += value;
+  }
+}
+
+static int getPrecision(const char *spec, int defaultPrecision) {
+  const char *dot = strchr(spec, '.');
+
+  if (dot == nullptr) {
+    return defaultPrecision;
+  }
+  return atoi(dot + 1);
+}
+
+void LogArg_t::format(String& output, const char *spec) const {
+  const size_t specLength = strlen(spec);
+  const char   conversion = spec[specLength - 1];
+
+  if (!isConversionChar(conversion)) {
+    // Incomplete specification at the end of the format
+    return;
+  }
+
+  switch (type) {
+    case Type::Text:
+    case Type::FlashText:
+    {
+      String str;
+
+      if (str.reserve(length)) {
+        for (size_t i = 0; i < length; ++i) {
+          str += static_cast<char>(type == Type::Text ? text[i] : pgm_read_byte(text + i));
+        }
+      }
+      appendPadded(output, str, spec);
+      return;
+    }
+    case Type::Float:
+
+      if (strchr("diuxXc", conversion) == nullptr) {
+        appendPadded(output, toString(value_f, getPrecision(spec, 6)), spec);
+        return;
+      }
+      break;
+    case Type::Int64:
+      appendPadded(output, ll2String(value_ll, (conversion == 'x' || conversion == 'X') ? 16 : 10), spec);
+      return;
+    case Type::UInt64:
+      appendPadded(output, ull2String(value_ull, (conversion == 'x' || conversion == 'X') ? 16 : 10), spec);
+      return;
+    case Type::Int32:
+    case Type::UInt32:
+      break;
+  }
+
+  if (strchr("fFeEgG", conversion) != nullptr) {
+    const float f = (type == Type::Int32) ? static_cast<float>(value_i) : static_cast<float>(value_u);
+    appendPadded(output, toString(f, getPrecision(spec, 6)), spec);
+    return;
+  }
+
+  if ((conversion == 's') || (conversion == 'p')) {
+    appendPadded(output, (type == Type::Int32) ? String(value_i) : String(value_u), spec);
+    return;
+  }
+
+  // Integer conversions, the single argument is formatted by the C library.
+  char buffer[24] = {};
+  int  value      = value_i;
+
+  if (type == Type::Float) {
+    value = static_cast<int>(value_f);
+  }
+  snprintf(buffer, sizeof(buffer), spec, value);
+  output += buffer;
+}
+
+String LogArg_format(const __FlashStringHelper *format, const LogArg_t *args, size_t nrArgs) {
+  String output;
+  const char *fmt = reinterpret_cast<const char *>(format);
+  const size_t formatLength = strlen_P(fmt);
+
+  if (!output.reserve(formatLength + 16 * nrArgs)) {
+    return output;
+  }
+  size_t argIndex = 0;
+
+  for (size_t i = 0; i < formatLength; ++i) {
+    const char c = pgm_read_byte(fmt + i);
+
+    if (c != '%') {
+      output += c;
+      continue;
+    }
+
+    if ((i + 1) < formatLength && (pgm_read_byte(fmt + i + 1) == '%')) {
+      output += '%';
+      ++i;
+      continue;
+    }
+
+    // Collect the conversion specification
+    char   spec[LOG_ARG_MAX_SPEC_LENGTH + 1] = {};
+    size_t specLength                       = 0;
+
+    spec[specLength++] = '%';
+
+    for (++i; i < formatLength; ++i) {
+      const char s = pgm_read_byte(fmt + i);
+
+      if (isLengthModifier(s)) {
+        // Argument types are known, length modifiers are not needed.
+        continue;
+      }
+
+      if (specLength < LOG_ARG_MAX_SPEC_LENGTH) {
+        spec[specLength++] = s;
+      }
+
+      if (isConversionChar(s)) {
+        break;
+      }
+    }
+    spec[specLength] = 0;
+
+    if (argIndex < nrArgs) {
+      args[argIndex].format(output, spec);
+    }
+    ++argIndex;
+  }
+  return output;
+}
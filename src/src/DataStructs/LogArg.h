@@ -0,0 +1,89 @@
+#ifndef DATASTRUCTS_LOGARG_H
+#define DATASTRUCTS_LOGARG_H
+
+#include <Arduino.h>
+
+/*********************************************************************************************\
+* LogArg_t
+* Typed argument of a log line added via addLogFmt().
+* Text arguments only refer to the original string, so a LogArg_t may not outlive the call.
+\*********************************************************************************************/
+struct LogArg_t {
+  enum class Type : uint8_t {
+    Int32,
+    UInt32,
+    Int64,
+    UInt64,
+    Float,
+    Text, // Text in RAM
+    FlashText
+  };
+
+  LogArg_t(int value) : type(Type::Int32) {
+    value_i = value;
+  }
+
+  LogArg_t(long value) : type(Type::Int32) {
+    value_i = value;
+  }
+
+  LogArg_t(unsigned int value) : type(Type::UInt32) {
+    value_u = value;
+  }
+
+  LogArg_t(unsigned long value) : type(Type::UInt32) {
+    value_u = value;
+  }
+
+  LogArg_t(long long value) : type(Type::Int64) {
+    value_ll = value;
+  }
+
+  LogArg_t(unsigned long long value) : type(Type::UInt64) {
+    value_ull = value;
+  }
+
+  LogArg_t(float value) : type(Type::Float) {
+    value_f = value;
+  }
+
+  LogArg_t(double value) : type(Type::Float) {
+    value_f = value;
+  }
+
+  LogArg_t(const char *str) : type(Type::Text), text(str) {
+    length = str == nullptr ? 0 : strlen(str);
+  }
+
+  LogArg_t(const char *str, size_t len) : type(Type::Text), text(str), length(len) {}
+
+  LogArg_t(const String& str) : type(Type::Text), text(str.c_str()), length(str.length()) {}
+
+  LogArg_t(const __FlashStringHelper *str) : type(Type::FlashText), text(reinterpret_cast<const char *>(str)) {
+    length = str == nullptr ? 0 : strlen_P(text);
+  }
+
+  // Append the formatted value to the output
+  // @param spec  Conversion specification, e.g. "%04d", without length modifiers
+  void format(String    & output,
+              const char *spec) const;
+
+  Type type;
+  union {
+    int32_t  value_i;
+    uint32_t value_u;
+    int64_t  value_ll;
+    uint64_t value_ull;
+    float    value_f;
+  };
+  const char *text   = nullptr;
+  size_t      length = 0;
+};
+
+// Format the log line, using printf-like conversion specifications (%d, %u, %x, %s, %f, ...)
+// Each specification uses the next argument, formatted according to its type.
+String LogArg_format(const __FlashStringHelper *format,
+                     const LogArg_t            *args,
+                     size_t                     nrArgs);
+
+#endif // ifndef DATASTRUCTS_LOGARG_H
@@ -1,44 +1,211 @@
 #include "../DataStructs/LogStruct.h"
 
 #include "../Helpers/ESPEasy_time_calc.h"
+#include "../Helpers/Memory.h"
 #include "../Helpers/StringConverter.h"
 
-void LogStruct::add_end() {
-  if (isFull()) {
-    read_idx = nextIndex(read_idx);
+static_assert(LOG_STRUCT_BUFFER_SIZE <= 0xFFFF, "LOG_STRUCT_BUFFER_SIZE must fit in uint16_t");
+static_assert(LOG_STRUCT_BUFFER_SIZE >= (LOG_STRUCT_RECORD_HEADER_SIZE + LOG_STRUCT_MESSAGE_SIZE), "LOG_STRUCT_BUFFER_SIZE too small");
+
+// Set in the log level of a record holding format and arguments
+#define LOG_STRUCT_DEFERRED_FLAG  0x80
+
+void LogStruct::add(const uint8_t loglevel, const String& line) {
+  addRecord(loglevel, reinterpret_cast<const uint8_t *>(line.c_str()), line.length());
+}
+
+void LogStruct::add(const uint8_t loglevel, String&& line) {
+  addRecord(loglevel, reinterpret_cast<const uint8_t *>(line.c_str()), line.length());
+}
+
+#if FEATURE_LOG_DEFERRED_FORMAT
+void LogStruct::addDeferred(const uint8_t loglevel, const __FlashStringHelper *format, const LogArg_t *args, size_t nrArgs) {
+  uint8_t data[LOG_STRUCT_MESSAGE_SIZE - 1];
+  size_t  pos = 0;
+
+  if (nrArgs > LOG_STRUCT_MAX_ARGS) {
+    nrArgs = LOG_STRUCT_MAX_ARGS;
   }
-  write_idx = nextIndex(write_idx);
-  is_full   = (write_idx == read_idx);
+  memcpy(data, &format, sizeof(format));
+  pos          += sizeof(format);
+  data[pos++]   = nrArgs;
+
+  for (size_t i = 0; i < nrArgs; ++i) {
+    const LogArg_t& arg = args[i];
+
+    // Room for the largest non text argument
+    if ((pos + 9) > sizeof(data)) {
+      break;
+    }
+    data[pos++] = static_cast<uint8_t>(arg.type);
+
+    switch (arg.type) {
+      case LogArg_t::Type::Int64:
+      case LogArg_t::Type::UInt64:
+        memcpy(data + pos, &arg.value_ull, 8);
+        pos += 8;
+        break;
+      case LogArg_t::Type::Text:
+      case LogArg_t::Type::FlashText:
+      {
+        // Stored as text in RAM
+        data[pos - 1] = static_cast<uint8_t>(LogArg_t::Type::Text);
+        size_t length = arg.length;
+
+        if (length > (sizeof(data) - pos - 1)) {
+          length = sizeof(data) - pos - 1;
+        }
+        data[pos++] = length;
+
+        if (arg.type == LogArg_t::Type::Text) {
+          memcpy(data + pos, arg.text, length);
+        } else {
+          memcpy_P(data + pos, arg.text, length);
+        }
+        pos += length;
+        break;
+      }
+      default:
+        memcpy(data + pos, &arg.value_u, 4);
+        pos += 4;
+        break;
+    }
+  }
+  addRecord(loglevel | LOG_STRUCT_DEFERRED_FLAG, data, pos);
 }
 
-void LogStruct::add(const uint8_t loglevel, const String& line) {
-  if (Message[write_idx].add(loglevel, line)) {
-    add_end();
+String LogStruct::formatDeferred(const uint8_t *data, size_t length) {
+  const __FlashStringHelper *format = nullptr;
+
+  if (length < (sizeof(format) + 1)) {
+    return EMPTY_STRING;
   }
+  memcpy(&format, data, sizeof(format));
+  size_t pos          = sizeof(format);
+  const size_t nrArgs = data[pos++];
+
+  // LogArg_t has no default constructor
+  LogArg_t args[LOG_STRUCT_MAX_ARGS] = {
+    0, 0, 0, 0, 0, 0, 0, 0
+  };
+  size_t i = 0;
+
+  for (; i < nrArgs && i < LOG_STRUCT_MAX_ARGS && pos < length; ++i) {
+    const LogArg_t::Type type = static_cast<LogArg_t::Type>(data[pos++]);
+    args[i].type = type;
+
+    if (type == LogArg_t::Type::Text) {
+      if (pos >= length) {
+        break;
+      }
+      args[i].length = data[pos++];
+      args[i].text   = reinterpret_cast<const char *>(data + pos);
+      pos           += args[i].length;
+    } else if ((type == LogArg_t::Type::Int64) || (type == LogArg_t::Type::UInt64)) {
+      memcpy(&args[i].value_ull, data + pos, 8);
+      pos += 8;
+    } else {
+      memcpy(&args[i].value_u, data + pos, 4);
+      pos += 4;
+    }
+
+    if (pos > length) {
+      // Corrupt record
+      break;
+    }
+  }
+  return LogArg_format(format, args, i);
 }
 
-void LogStruct::add(const uint8_t loglevel, String&& line) {
-  if (Message[write_idx].add(loglevel, std::move(line))) {
-    add_end();
+#endif // if FEATURE_LOG_DEFERRED_FORMAT
+
+void LogStruct::addRecord(const uint8_t loglevel, const uint8_t *data, size_t length) {
+  if (length == 0) {
+    return;
   }
+
+  if (_buffer == nullptr) {
+    _buffer = static_cast<uint8_t *>(buffer_calloc(MemoryBufferClass_e::LogBuffer, 1, LOG_STRUCT_BUFFER_SIZE));
+
+    if (_buffer == nullptr) {
+      return;
+    }
+  }
+
+  if (length > LOG_STRUCT_MESSAGE_SIZE - 1) {
+    length = LOG_STRUCT_MESSAGE_SIZE - 1;
+  }
+  const size_t recordSize = LOG_STRUCT_RECORD_HEADER_SIZE + length;
+
+  while ((LOG_STRUCT_BUFFER_SIZE - _used) < recordSize) {
+    clearOldest();
+  }
+  const uint16_t messageLength = length;
+  const uint32_t timestamp     = millis();
+
+  write(reinterpret_cast<const uint8_t *>(&messageLength), sizeof(messageLength));
+  write(reinterpret_cast<const uint8_t *>(&timestamp),     sizeof(timestamp));
+  write(&loglevel,                                         1);
+  write(data,                                              length);
+  ++_nrLines;
 }
 
-bool LogStruct::getNext(bool& logLinesAvailable, unsigned long& timestamp, String& message, uint8_t& loglevel) {
+int LogStruct::getLine(uint32_t& seq, unsigned long& timestamp, char *message, uint8_t& loglevel) {
   lastReadTimeStamp = millis();
-  logLinesAvailable = false;
 
   if (isEmpty()) {
-    return false;
+    return -1;
   }
-  timestamp = Message[read_idx]._timestamp;
-  message   = std::move(Message[read_idx]._message);
-  loglevel  = Message[read_idx]._loglevel;
-  clearOldest();
 
-  if (!isEmpty()) {
-    logLinesAvailable = true;
+  if (static_cast<int32_t>(seq - _oldestSeq) < 0) {
+    // Line has already been removed, continue with the oldest line
+    seq = _oldestSeq;
+  } else if ((seq - _oldestSeq) >= _nrLines) {
+    if (seq == getNextSeq()) {
+      // No new lines
+      return -1;
+    }
+
+    // Sequence number not issued (yet), e.g. a client still using the cursor from before a reboot
+    seq = _oldestSeq;
+  }
+  const uint16_t pos   = getPos(seq);
+  uint16_t length      = getLength(pos);
+  uint32_t timestamp32 = 0;
+
+  read(pos + 2, reinterpret_cast<uint8_t *>(&timestamp32), 4);
+  read(pos + 6, &loglevel,                                 1);
+  timestamp = timestamp32;
+
+  _cursorSeq = seq + 1;
+  _cursorPos = (pos + LOG_STRUCT_RECORD_HEADER_SIZE + length) % LOG_STRUCT_BUFFER_SIZE;
+
+  if (length > (LOG_STRUCT_MESSAGE_SIZE - 1)) {
+    length = LOG_STRUCT_MESSAGE_SIZE - 1;
   }
-  return true;
+
+  #if FEATURE_LOG_DEFERRED_FORMAT
+
+  if (loglevel & LOG_STRUCT_DEFERRED_FLAG) {
+    uint8_t data[LOG_STRUCT_MESSAGE_SIZE];
+
+    read(pos + LOG_STRUCT_RECORD_HEADER_SIZE, data, length);
+    loglevel &= ~LOG_STRUCT_DEFERRED_FLAG;
+    const String formatted = formatDeferred(data, length);
+
+    length = formatted.length();
+
+    if (length > (LOG_STRUCT_MESSAGE_SIZE - 1)) {
+      length = LOG_STRUCT_MESSAGE_SIZE - 1;
+    }
+    memcpy(message, formatted.c_str(), length);
+  } else
+  #endif // if FEATURE_LOG_DEFERRED_FORMAT
+  {
+    read(pos + LOG_STRUCT_RECORD_HEADER_SIZE, reinterpret_cast<uint8_t *>(message), length);
+  }
+  message[length] = '\0';
+  return length;
 }
 
 
@@ -48,14 +215,11 @@ bool LogStruct::logActiveRead() {
 }
 
 void LogStruct::clearExpiredEntries() {
-  unsigned int maxLoops = LOG_STRUCT_MESSAGE_LINES;
-
-  while (maxLoops > 0) {
-    --maxLoops;
+  while (!isEmpty()) {
+    uint32_t timestamp = 0;
+    read(_readPos + 2, reinterpret_cast<uint8_t *>(&timestamp), 4);
 
-    if (isEmpty() || // Nothing left
-        !Message[read_idx].isExpired())
-    {
+    if (timePassedSince(timestamp) < LOG_BUFFER_EXPIRE) {
       return;
     }
     clearOldest();
@@ -64,8 +228,51 @@ void LogStruct::clearExpiredEntries() {
 
 void LogStruct::clearOldest() {
   if (!isEmpty()) {
-    is_full = false;
-    Message[read_idx].clear();
-    read_idx = nextIndex(read_idx);
+    const uint16_t recordSize = LOG_STRUCT_RECORD_HEADER_SIZE + getLength(_readPos);
+
+    _readPos = (_readPos + recordSize) % LOG_STRUCT_BUFFER_SIZE;
+    _used   -= recordSize;
+    ++_oldestSeq;
+    --_nrLines;
+  }
+}
+
+void LogStruct::write(const uint8_t *data, size_t size) {
+  size_t writePos = (_readPos + _used) % LOG_STRUCT_BUFFER_SIZE;
+
+  for (size_t i = 0; i < size; ++i) {
+    _buffer[writePos] = data[i];
+    writePos          = (writePos + 1) % LOG_STRUCT_BUFFER_SIZE;
+  }
+  _used += size;
+}
+
+void LogStruct::read(uint16_t pos, uint8_t *data, size_t size) const {
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = _buffer[(pos + i) % LOG_STRUCT_BUFFER_SIZE];
+  }
+}
+
+uint16_t LogStruct::getLength(uint16_t pos) const {
+  uint16_t length = 0;
+
+  read(pos, reinterpret_cast<uint8_t *>(&length), sizeof(length));
+  return length;
+}
+
+uint16_t LogStruct::getPos(uint32_t seq) {
+  uint32_t curSeq = _oldestSeq;
+  uint16_t pos    = _readPos;
+
+  if (((_cursorSeq - _oldestSeq) < _nrLines) && (static_cast<int32_t>(seq - _cursorSeq) >= 0)) {
+    // Continue from the last line read, instead of walking from the oldest line
+    curSeq = _cursorSeq;
+    pos    = _cursorPos;
+  }
+
+  while (curSeq != seq) {
+    pos = (pos + LOG_STRUCT_RECORD_HEADER_SIZE + getLength(pos)) % LOG_STRUCT_BUFFER_SIZE;
+    ++curSeq;
   }
+  return pos;
 }
@@ -4,29 +4,51 @@
 
 #include "../../ESPEasy_common.h"
 
-#include "../DataStructs/LogEntry.h"
+#include "../DataStructs/LogArg.h"
 
 /*********************************************************************************************\
  * LogStruct
+ * Buffer of log lines for the web log.
+ * All lines are stored as records in a single ring buffer of LOG_STRUCT_BUFFER_SIZE bytes,
+ * so adding log lines does not allocate memory and the nr of lines adapts to their length.
+ * The buffer itself is allocated on the first line added, thus only when the web log is used.
+ * Record: message length (2 bytes), timestamp (4 bytes), log level (1 byte), message
+ * With FEATURE_LOG_DEFERRED_FORMAT, a record may also hold the format and arguments of
+ * addLogFmt(), which are only formatted when the line is read.
+ * Every line gets a sequence number. Reading does not remove lines, so each reader
+ * (web log client, event stream) keeps its own cursor and gets exactly the new lines.
+ * Lines are only removed when they expire, or to make room for new lines.
 \*********************************************************************************************/
-#ifdef ESP32
-  #define LOG_STRUCT_MESSAGE_LINES 60
-#else
-  #ifdef USE_SECOND_HEAP
-    #define LOG_STRUCT_MESSAGE_LINES 60
+#ifndef LOG_STRUCT_BUFFER_SIZE
+  #ifdef ESP32
+    #define LOG_STRUCT_BUFFER_SIZE 16384
   #else
-    #if defined(PLUGIN_BUILD_COLLECTION) || defined(PLUGIN_BUILD_DEV)
-      #define LOG_STRUCT_MESSAGE_LINES 10
+    #ifdef USE_SECOND_HEAP
+      #define LOG_STRUCT_BUFFER_SIZE 6144
     #else
-      #define LOG_STRUCT_MESSAGE_LINES 15
+      #if defined(PLUGIN_BUILD_COLLECTION) || defined(PLUGIN_BUILD_DEV)
+        #define LOG_STRUCT_BUFFER_SIZE 1536
+      #else
+        #define LOG_STRUCT_BUFFER_SIZE 2048
+      #endif
     #endif
   #endif
 #endif
 
+// Max. length of a stored log line, including terminating zero
+#define LOG_STRUCT_MESSAGE_SIZE 128
+
+#define LOG_STRUCT_RECORD_HEADER_SIZE 7
+
+// Max. nr of arguments stored in a deferred record
+#define LOG_STRUCT_MAX_ARGS 8
+
 #ifdef ESP32
   #define LOG_BUFFER_ACTIVE_READ_TIMEOUT 30000
+  #define LOG_BUFFER_EXPIRE              30000  // Time after which a buffered log item is considered expired.
 #else
   #define LOG_BUFFER_ACTIVE_READ_TIMEOUT 5000
+  #define LOG_BUFFER_EXPIRE              5000   // Time after which a buffered log item is considered expired.
 #endif
 
 
@@ -35,41 +57,68 @@ struct LogStruct {
     void add(const uint8_t loglevel, const String& line);
     void add(const uint8_t loglevel, String&& line);
 
-    // Read the next item and append it to the given string.
-    // Returns whether new lines are available.
-//    bool get(String& output, const String& lineEnd);
+    #if FEATURE_LOG_DEFERRED_FORMAT
+    // Store the format and arguments, to be formatted when read.
+    // Text arguments are copied, as long as they fit in LOG_STRUCT_MESSAGE_SIZE.
+    void addDeferred(const uint8_t loglevel, const __FlashStringHelper *format, const LogArg_t *args, size_t nrArgs);
+    #endif // if FEATURE_LOG_DEFERRED_FORMAT
+
+    // Read the line with sequence number seq, without removing it.
+    // When that line is no longer present, the oldest line is read and seq is updated.
+    // message must be able to hold LOG_STRUCT_MESSAGE_SIZE chars, it is zero terminated.
+    // Returns the message length, or -1 when no line with seq or newer is present.
+    int getLine(uint32_t& seq, unsigned long& timestamp, char *message, uint8_t& loglevel);
+
+    // Sequence number of the oldest line present
+    uint32_t getOldestSeq() const {
+      return _oldestSeq;
+    }
 
-    // Returns whether a line was retrieved.
-    bool getNext(bool& logLinesAvailable, unsigned long& timestamp, String& message, uint8_t& loglevel);
+    // Sequence number the next added line will get
+    uint32_t getNextSeq() const {
+      return _oldestSeq + _nrLines;
+    }
 
     bool isEmpty() const {
-      return !is_full && (write_idx == read_idx);
+      return _used == 0;
     }
 
-    bool isFull() const { return is_full; }
-
     bool logActiveRead();
 
   private:
 
-    void add_end();
+    void addRecord(const uint8_t loglevel, const uint8_t *data, size_t length);
+
+    #if FEATURE_LOG_DEFERRED_FORMAT
+    static String formatDeferred(const uint8_t *data, size_t length);
+    #endif // if FEATURE_LOG_DEFERRED_FORMAT
 
     void clearExpiredEntries();
 
     void clearOldest();
 
-    static int nextIndex(int idx) {
-//      return ((++idx) == LOG_STRUCT_MESSAGE_LINES) ? 0 : idx;
-      return (idx + 1) % LOG_STRUCT_MESSAGE_LINES;
-    }
+    void write(const uint8_t *data, size_t size);
+
+    void read(uint16_t pos, uint8_t *data, size_t size) const;
+
+    // Length of the message of the record at pos
+    uint16_t getLength(uint16_t pos) const;
+
+    // Position of the record with sequence number seq, which must be present
+    uint16_t getPos(uint32_t seq);
 
-    LogEntry_t Message[LOG_STRUCT_MESSAGE_LINES];
-    int write_idx = 0;
-    int read_idx = 0;
+    uint8_t *_buffer = nullptr;
     unsigned long lastReadTimeStamp = 0;
-    bool is_full = false;
+    uint32_t _oldestSeq = 0;
+    uint16_t _nrLines = 0;
+    uint16_t _readPos = 0;
+    uint16_t _used = 0;
+
+    // Position of the record following the last line read, as readers move forward line by line.
+    uint32_t _cursorSeq = 0;
+    uint16_t _cursorPos = 0;
 };
 
 
 
-#endif // DATASTRUCTS_LOGSTRUCT_H
\ No newline at end of file
+#endif // DATASTRUCTS_LOGSTRUCT_H
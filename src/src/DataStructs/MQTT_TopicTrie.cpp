@@ -0,0 +1,167 @@
+#include "../DataStructs/MQTT_TopicTrie.h"
+
+#if FEATURE_MQTT
+
+# include "../Globals/Plugins.h"
+
+// Skip white space and '/' at the start and end of the topic
+static void MQTT_TopicTrie_trim(const char *& start, const char *& end)
+{
+  while (start < end && (isspace(*start) || *start == '/')) { ++start; }
+
+  while (end > start && (isspace(*(end - 1)) || *(end - 1) == '/')) { --end; }
+}
+
+void MQTT_TopicTrie::add(const String& subscription, taskIndex_t taskIndex, uint8_t valueIndex)
+{
+  if (subscription.isEmpty() || !validTaskIndex(taskIndex) || (valueIndex >= 8)) {
+    return;
+  }
+  Subscription sub;
+
+  sub.topic      = subscription;
+  sub.taskIndex  = taskIndex;
+  sub.valueIndex = valueIndex;
+  _subscriptions.push_back(std::move(sub));
+  _dirty = true;
+}
+
+void MQTT_TopicTrie::removeTask(taskIndex_t taskIndex)
+{
+  for (auto it = _subscriptions.begin(); it != _subscriptions.end();) {
+    if (it->taskIndex == taskIndex) {
+      it     = _subscriptions.erase(it);
+      _dirty = true;
+    } else {
+      ++it;
+    }
+  }
+}
+
+void MQTT_TopicTrie::clear()
+{
+  _subscriptions.clear();
+  _nextSubscription.clear();
+  _nodes.clear();
+  _dirty = true;
+}
+
+bool MQTT_TopicTrie::match(const char *topic, uint8_t valueMasks[TASKS_MAX])
+{
+  if ((topic == nullptr) || _subscriptions.empty()) {
+    return false;
+  }
+
+  if (_dirty) {
+    rebuild();
+  }
+  const char *start = topic;
+  const char *end   = topic + strlen(topic);
+
+  MQTT_TopicTrie_trim(start, end);
+
+  bool matched = false;
+
+  matchLevel(0, start < end ? start : nullptr, end, valueMasks, matched);
+  return matched;
+}
+
+void MQTT_TopicTrie::rebuild()
+{
+  _nodes.clear();
+  _nodes.emplace_back(); // Root
+  _nextSubscription.assign(_subscriptions.size(), 0);
+
+  for (size_t i = 0; i < _subscriptions.size(); ++i) {
+    const char *pos = _subscriptions[i].topic.c_str();
+    const char *end = pos + _subscriptions[i].topic.length();
+    MQTT_TopicTrie_trim(pos, end);
+
+    uint16_t nodeIndex = 0;
+
+    while (pos < end) {
+      const char *slash    = static_cast<const char *>(memchr(pos, '/', end - pos));
+      const char *levelEnd = (slash == nullptr) ? end : slash;
+      nodeIndex = getChild(nodeIndex, pos, levelEnd - pos, true);
+      pos       = (slash == nullptr) ? end : slash + 1;
+    }
+
+    // Prepend to the list of subscriptions ending at this node
+    _nextSubscription[i]                = _nodes[nodeIndex].firstSubscription;
+    _nodes[nodeIndex].firstSubscription = i + 1;
+  }
+  _dirty = false;
+}
+
+uint16_t MQTT_TopicTrie::getChild(uint16_t nodeIndex, const char *level, size_t length, bool create)
+{
+  uint16_t child = _nodes[nodeIndex].firstChild;
+
+  while (child != 0) {
+    const String& childLevel = _nodes[child].level;
+
+    if ((childLevel.length() == length) && (strncmp(childLevel.c_str(), level, length) == 0)) {
+      return child;
+    }
+    child = _nodes[child].nextSibling;
+  }
+
+  if (!create) {
+    return 0;
+  }
+  Node node;
+
+  node.level.reserve(length);
+
+  for (size_t i = 0; i < length; ++i) {
+    node.level += level[i];
+  }
+  node.nextSibling = _nodes[nodeIndex].firstChild;
+
+  // Do not keep a reference to _nodes[nodeIndex] while adding, as the vector may reallocate.
+  _nodes.push_back(std::move(node));
+  const uint16_t newIndex = _nodes.size() - 1;
+  _nodes[nodeIndex].firstChild = newIndex;
+  return newIndex;
+}
+
+void MQTT_TopicTrie::matchLevel(uint16_t    nodeIndex,
+                                const char *pos,
+                                const char *end,
+                                uint8_t     valueMasks[],
+                                bool      & matched) const
+{
+  if (pos == nullptr) {
+    setMatched(nodeIndex, valueMasks, matched);
+  }
+
+  const char *slash    = (pos == nullptr) ? nullptr : static_cast<const char *>(memchr(pos, '/', end - pos));
+  const char *levelEnd = (slash == nullptr) ? end : slash;
+  const size_t length  = (pos == nullptr) ? 0 : levelEnd - pos;
+  const char  *next    = (slash == nullptr) ? nullptr : slash + 1;
+
+  for (uint16_t child = _nodes[nodeIndex].firstChild; child != 0; child = _nodes[child].nextSibling) {
+    const String& level = _nodes[child].level;
+
+    if (equals(level, '#')) {
+      // Matches this and all following levels, including none at all.
+      setMatched(child, valueMasks, matched);
+    } else if (pos != nullptr) {
+      if (equals(level, '+') ||
+          ((level.length() == length) && (strncmp(level.c_str(), pos, length) == 0))) {
+        matchLevel(child, next, end, valueMasks, matched);
+      }
+    }
+  }
+}
+
+void MQTT_TopicTrie::setMatched(uint16_t nodeIndex, uint8_t valueMasks[], bool& matched) const
+{
+  for (uint16_t sub = _nodes[nodeIndex].firstSubscription; sub != 0; sub = _nextSubscription[sub - 1]) {
+    const Subscription& subscription = _subscriptions[sub - 1];
+    valueMasks[subscription.taskIndex] |= (1 << subscription.valueIndex);
+    matched = true;
+  }
+}
+
+#endif // if FEATURE_MQTT
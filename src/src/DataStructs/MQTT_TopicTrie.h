@@ -0,0 +1,87 @@
+#ifndef DATASTRUCTS_MQTT_TOPICTRIE_H
+#define DATASTRUCTS_MQTT_TOPICTRIE_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_MQTT
+
+# include "../CustomBuild/ESPEasyLimits.h"
+# include "../DataTypes/TaskIndex.h"
+
+# include <vector>
+
+/*********************************************************************************************\
+* MQTT_TopicTrie
+* Subscription topics of all tasks, stored per topic level in a tree.
+* A received topic is matched against all subscriptions in a single walk,
+* supporting the '+' (single level) and '#' (multi level) wildcards.
+* Leading and trailing '/' are ignored, like MQTTCheckSubscription_037() does.
+\*********************************************************************************************/
+class MQTT_TopicTrie {
+public:
+
+  void add(const String& subscription,
+           taskIndex_t   taskIndex,
+           uint8_t       valueIndex);
+
+  void removeTask(taskIndex_t taskIndex);
+
+  void clear();
+
+  bool empty() const {
+    return _subscriptions.empty();
+  }
+
+  // Set the bit of the task value index in valueMasks[taskIndex] for all subscriptions matching the topic.
+  // valueMasks must be cleared by the caller.
+  // @retval true when at least one subscription matches
+  bool match(const char *topic,
+             uint8_t     valueMasks[TASKS_MAX]);
+
+private:
+
+  struct Subscription {
+    String      topic;
+    taskIndex_t taskIndex;
+    uint8_t     valueIndex;
+  };
+
+  // Tree stored as first-child, next-sibling to keep the nodes small.
+  struct Node {
+    String   level;
+    uint16_t firstChild  = 0; // 0 = none, as the root can never be a child
+    uint16_t nextSibling = 0;
+
+    // Index in _subscriptions + 1 of the first subscription ending at this node, 0 = none
+    uint16_t firstSubscription = 0;
+  };
+
+  void rebuild();
+
+  uint16_t getChild(uint16_t    nodeIndex,
+                    const char *level,
+                    size_t      length,
+                    bool        create);
+
+  // pos points to the start of the current level, nullptr when all levels have been matched.
+  void     matchLevel(uint16_t    nodeIndex,
+                      const char *pos,
+                      const char *end,
+                      uint8_t     valueMasks[],
+                      bool      & matched) const;
+
+  void     setMatched(uint16_t nodeIndex,
+                      uint8_t  valueMasks[],
+                      bool   & matched) const;
+
+  std::vector<Subscription> _subscriptions;
+
+  // Index in _subscriptions + 1 of the next subscription ending at the same node
+  std::vector<uint16_t> _nextSubscription;
+  std::vector<Node>     _nodes;
+  bool                  _dirty = true;
+};
+
+#endif // if FEATURE_MQTT
+
+#endif // ifndef DATASTRUCTS_MQTT_TOPICTRIE_H
@@ -0,0 +1,260 @@
+#include "../DataStructs/NTP_query.h"
+
+#include "../ESPEasyCore/ESPEasy_Log.h"
+#include "../Globals/Settings.h"
+#include "../Helpers/ESPEasy_time_calc.h"
+#include "../Helpers/Hardware.h"
+#include "../Helpers/Networking.h"
+#include "../Helpers/StringConverter.h"
+
+#define NTP_PACKET_SIZE   48 // NTP time is in the first 48 bytes of message
+#define NTP_PORT          123
+
+// Convert the 64 bit NTP timestamp at the given offset to Unix time
+static double NTP_timestamp_to_unixTime(const uint8_t *packet, uint8_t offset)
+{
+  uint32_t secsSince1900;
+
+  secsSince1900  = (uint32_t)packet[offset] << 24;
+  secsSince1900 |= (uint32_t)packet[offset + 1] << 16;
+  secsSince1900 |= (uint32_t)packet[offset + 2] << 8;
+  secsSince1900 |= (uint32_t)packet[offset + 3];
+
+  if (secsSince1900 == 0) {
+    return 0.0;
+  }
+
+  uint32_t frac;
+
+  frac  = (uint32_t)packet[offset + 4] << 24;
+  frac |= (uint32_t)packet[offset + 5] << 16;
+  frac |= (uint32_t)packet[offset + 6] << 8;
+  frac |= (uint32_t)packet[offset + 7];
+
+  return static_cast<double>(secsSince1900 - 2208988800UL) +
+         (static_cast<double>(frac) / 4294967295.0);
+}
+
+uint8_t NTP_query_struct::start()
+{
+  stop();
+
+  String hosts[NTP_QUERY_MAX_SERVERS];
+  uint8_t nrHosts = 0;
+
+  if (Settings.NTPHost[0] != 0) {
+    hosts[nrHosts++] = Settings.NTPHost;
+  }
+
+  // Have to do a lookup each time, since the NTP pool always returns another IP
+  const uint8_t firstPool = HwRandom(0, 3);
+
+  for (uint8_t i = 0; nrHosts < NTP_QUERY_MAX_SERVERS && i < 4; ++i) {
+    hosts[nrHosts]  = String((firstPool + i) % 4);
+    hosts[nrHosts] += F(".pool.ntp.org");
+    ++nrHosts;
+  }
+
+  if (!beginWiFiUDP_randomPort(_udp)) {
+    return 0;
+  }
+
+  while (_udp.parsePacket() > 0) { // discard any previously received packets
+  }
+
+  uint8_t packetBuffer[NTP_PACKET_SIZE];
+
+  _start_usec = getMicros64();
+
+  for (uint8_t i = 0; i < nrHosts; ++i) {
+    server_t& server = _servers[_nrServers];
+
+    if (!resolveHostByName(hosts[i].c_str(), server.ip) || (server.ip == IPAddress())) {
+      addLog(LOG_LEVEL_INFO, concat(F("NTP  : Cannot resolve "), hosts[i]));
+      continue;
+    }
+
+    // Skip duplicate IP addresses, e.g. configured host also in the pool
+    bool duplicate = false;
+
+    for (uint8_t j = 0; j < _nrServers && !duplicate; ++j) {
+      duplicate = _servers[j].ip == server.ip;
+    }
+
+    if (duplicate) { continue; }
+
+    memset(packetBuffer, 0, NTP_PACKET_SIZE);
+    packetBuffer[0]  = 0b11100011; // LI, Version, Mode
+    packetBuffer[1]  = 0;          // Stratum, or type of clock
+    packetBuffer[2]  = 6;          // Polling Interval
+    packetBuffer[3]  = 0xEC;       // Peer Clock Precision
+    packetBuffer[12] = 49;
+    packetBuffer[13] = 0x4E;
+    packetBuffer[14] = 49;
+    packetBuffer[15] = 52;
+
+    // Random transmit timestamp, returned as origin timestamp to match the reply with this request.
+    server.nonce     = HwRandom(1, 0x7FFFFFFF);
+    packetBuffer[44] = (server.nonce >> 24) & 0xFF;
+    packetBuffer[45] = (server.nonce >> 16) & 0xFF;
+    packetBuffer[46] = (server.nonce >> 8) & 0xFF;
+    packetBuffer[47] = server.nonce & 0xFF;
+
+    FeedSW_watchdog();
+
+    if (_udp.beginPacket(server.ip, NTP_PORT) == 0) {
+      continue;
+    }
+    _udp.write(packetBuffer, NTP_PACKET_SIZE);
+    server.sent_usec = getMicros64();
+    server.replied   = false;
+
+    if (_udp.endPacket() == 0) {
+      continue;
+    }
+#ifndef BUILD_NO_DEBUG
+
+    if (loglevelActiveFor(LOG_LEVEL_DEBUG_MORE)) {
+      addLogMove(LOG_LEVEL_DEBUG_MORE, strformat(
+                   F("NTP  : NTP host %s (%s) queried"),
+                   hosts[i].c_str(),
+                   formatIP(server.ip).c_str()));
+    }
+#endif // ifndef BUILD_NO_DEBUG
+    ++_nrServers;
+  }
+
+  if (_nrServers == 0) {
+    stop();
+    return 0;
+  }
+  _active = true;
+  return _nrServers;
+}
+
+void NTP_query_struct::loop()
+{
+  if (!_active) { return; }
+
+  uint8_t packetBuffer[NTP_PACKET_SIZE];
+
+  while (_udp.parsePacket() > 0) {
+    const uint64_t received_usec = getMicros64();
+
+    if ((_udp.remotePort() != NTP_PORT) ||
+        (_udp.read(packetBuffer, NTP_PACKET_SIZE) < NTP_PACKET_SIZE)) {
+      continue;
+    }
+
+    const IPAddress remoteIP = _udp.remoteIP();
+
+    for (uint8_t i = 0; i < _nrServers; ++i) {
+      if (!_servers[i].replied && (_servers[i].ip == remoteIP)) {
+        parseReply(_servers[i], packetBuffer, received_usec);
+        break;
+      }
+    }
+  }
+}
+
+void NTP_query_struct::parseReply(server_t& server, const uint8_t *packet, uint64_t received_usec)
+{
+  // Origin timestamp must be the transmit timestamp of our request.
+  const uint32_t origin =
+    ((uint32_t)packet[28] << 24) |
+    ((uint32_t)packet[29] << 16) |
+    ((uint32_t)packet[30] << 8) |
+    (uint32_t)packet[31];
+
+  if (origin != server.nonce) {
+    return;
+  }
+  server.replied = true;
+
+  if (((packet[0] & 0b11000000) == 0b11000000) || (packet[1] == 0)) {
+    // Leap-Indicator: unknown (clock unsynchronized) or Kiss-o'-Death packet
+    // See: https://github.com/letscontrolit/ESPEasy/issues/2886#issuecomment-586656384
+    if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+      addLogMove(LOG_LEVEL_ERROR, concat(F("NTP  : NTP host ("), formatIP(server.ip)) + F(") unsynchronized"));
+    }
+    return;
+  }
+
+  // For more detailed info on improving accuracy, see:
+  // https://github.com/lettier/ntpclient/issues/4#issuecomment-360703503
+  const double receiveTime  = NTP_timestamp_to_unixTime(packet, 32);
+  const double transmitTime = NTP_timestamp_to_unixTime(packet, 40);
+
+  if ((receiveTime == 0.0) || (transmitTime == 0.0)) {
+    // No time stamp received
+    return;
+  }
+
+  // Round trip minus the time the server took to reply.
+  const int64_t roundTrip_usec = received_usec - server.sent_usec;
+  int64_t delay_usec           = roundTrip_usec - static_cast<int64_t>((transmitTime - receiveTime) * 1000000.0);
+
+  if (delay_usec < 0) {
+    delay_usec = 0;
+  }
+
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    addLogMove(LOG_LEVEL_INFO, strformat(
+                 F("NTP  : NTP host (%s) replied: delay %d usec"),
+                 formatIP(server.ip).c_str(),
+                 static_cast<int>(delay_usec)));
+  }
+
+  if (!_best_set || (static_cast<uint32_t>(delay_usec) < _best_delay_usec)) {
+    // Compensate for the delay by adding half the network delay
+    _best_unixTime_d    = transmitTime + (static_cast<double>(delay_usec) / 2000000.0);
+    _best_received_usec = received_usec;
+    _best_delay_usec    = static_cast<uint32_t>(delay_usec);
+    _best_server        = server.ip;
+    _best_set           = true;
+  }
+}
+
+void NTP_query_struct::stop()
+{
+  _udp.stop();
+  _active             = false;
+  _nrServers          = 0;
+  _best_set           = false;
+  _best_unixTime_d    = 0.0;
+  _best_received_usec = 0;
+  _best_delay_usec    = 0;
+}
+
+bool NTP_query_struct::done() const
+{
+  if (!_active) { return true; }
+
+  if (usecPassedSince(_start_usec) > (NTP_QUERY_TIMEOUT_MSEC * 1000ll)) {
+    return true;
+  }
+
+  for (uint8_t i = 0; i < _nrServers; ++i) {
+    if (!_servers[i].replied) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool NTP_query_struct::getUnixTime(double& unixTime_d, uint32_t& delay_usec, IPAddress& server) const
+{
+  if (!_best_set) {
+    return false;
+  }
+  unixTime_d  = _best_unixTime_d;
+  unixTime_d += static_cast<double>(usecPassedSince(_best_received_usec)) / 1000000.0;
+  delay_usec  = _best_delay_usec;
+  server      = _best_server;
+  return true;
+}
+
+int64_t NTP_query_struct::duration_usec() const
+{
+  return usecPassedSince(_start_usec);
+}
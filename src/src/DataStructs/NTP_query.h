@@ -0,0 +1,79 @@
+#ifndef DATASTRUCT_NTP_QUERY_H
+#define DATASTRUCT_NTP_QUERY_H
+
+#include "../../ESPEasy_common.h"
+
+#include <IPAddress.h>
+#include <WiFiUdp.h>
+
+// Max. nr of NTP servers queried at once.
+// The configured NTP host (if any) and the remaining ones from the NTP pool.
+#ifndef NTP_QUERY_MAX_SERVERS
+# define NTP_QUERY_MAX_SERVERS      4
+#endif // ifndef NTP_QUERY_MAX_SERVERS
+
+// Time to wait for the replies after sending the requests.
+#ifndef NTP_QUERY_TIMEOUT_MSEC
+# define NTP_QUERY_TIMEOUT_MSEC     1000
+#endif // ifndef NTP_QUERY_TIMEOUT_MSEC
+
+/*********************************************************************************************\
+* Non blocking SNTP query to several servers at once.
+* All requests are sent from a single UDP socket, replies are collected on each call to loop().
+* The reply with the lowest round trip delay is kept, its time is compensated for
+* half the network delay (round trip minus the processing time of the server).
+\*********************************************************************************************/
+struct NTP_query_struct {
+  // Resolve the servers and send a request to each of them.
+  // @retval Nr of requests sent.
+  uint8_t start();
+
+  // Read all replies received so far.
+  void    loop();
+
+  void    stop();
+
+  bool    active() const {
+    return _active;
+  }
+
+  // All servers replied or the timeout has been reached.
+  bool    done() const;
+
+  // Time of the best reply, including the time passed since it was received.
+  // @param delay_usec  Network delay of the best reply.
+  bool    getUnixTime(double  & unixTime_d,
+                      uint32_t& delay_usec,
+                      IPAddress& server) const;
+
+  // Time since start() in usec.
+  int64_t duration_usec() const;
+
+private:
+
+  struct server_t {
+    IPAddress ip;
+    uint64_t  sent_usec = 0;
+    uint32_t  nonce     = 0; // Our transmit timestamp, echoed by the server as origin timestamp
+    bool      replied   = false;
+  };
+
+  void parseReply(server_t     & server,
+                  const uint8_t *packet,
+                  uint64_t       received_usec);
+
+  WiFiUDP  _udp;
+  server_t _servers[NTP_QUERY_MAX_SERVERS];
+  uint64_t _start_usec = 0;
+  uint8_t  _nrServers  = 0;
+  bool     _active     = false;
+
+  // Best reply so far
+  double    _best_unixTime_d    = 0.0; // At the moment of receiving the reply
+  uint64_t  _best_received_usec = 0;
+  uint32_t  _best_delay_usec    = 0;
+  IPAddress _best_server;
+  bool      _best_set           = false;
+};
+
+#endif // ifndef DATASTRUCT_NTP_QUERY_H
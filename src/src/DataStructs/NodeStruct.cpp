@@ -9,8 +9,6 @@
 #include "../Helpers/ESPEasy_time_calc.h"
 
 
-#define NODE_STRUCT_AGE_TIMEOUT 300000  // 5 minutes
-
 NodeStruct::NodeStruct() : ESPEasyNowPeer(0), useAP_ESPEasyNow(0), scaled_rssi(0)
 {}
 
@@ -8,8 +8,9 @@
 #include "../DataStructs/MAC_address.h"
 
 #include <IPAddress.h>
-#include <map>
+#include <vector>
 
+#define NODE_STRUCT_AGE_TIMEOUT 300000  // 5 minutes
 
 /*********************************************************************************************\
 * NodeStruct
@@ -101,6 +102,8 @@ struct __attribute__((__packed__)) NodeStruct
   uint32_t unix_time_sec = 0;
   uint32_t unix_time_frac = 0;
 };
-typedef std::map<uint8_t, NodeStruct> NodesMap;
+
+// Nodes sorted by unit nr, see NodesHandler
+typedef std::vector<NodeStruct> NodesList;
 #endif
 #endif // DATASTRUCTS_NODESTRUCT_H
\ No newline at end of file
@@ -29,8 +29,13 @@
 #include "../Helpers/Misc.h"
 #include "../Helpers/PeriodicalActions.h"
 
+#include <algorithm>
+
 #define ESPEASY_NOW_ALLOWED_AGE_NO_TRACEROUTE  35000
 
+// Max. time to keep the cached preferred node, to pick up changes not tracked here (e.g. settings)
+#define NODES_PREFERRED_NODE_CACHE_TIMEOUT     10000
+
 bool NodesHandler::addNode(const NodeStruct& node)
 {
   int8_t rssi = 0;
@@ -43,15 +48,15 @@ bool NodesHandler::addNode(const NodeStruct& node)
   // Erase any existing node with matching MAC address
   for (auto it = _nodes.begin(); it != _nodes.end(); )
   {
-    const MAC_address sta = it->second.sta_mac;
-    const MAC_address ap  = it->second.ap_mac;
+    const MAC_address sta = it->sta_mac;
+    const MAC_address ap  = it->ap_mac;
     if ((!sta.all_zero() && node.match(sta)) || (!ap.all_zero() && node.match(ap))) {
-      rssi = it->second.getRSSI();
+      rssi = it->getRSSI();
       if (!sta.all_zero())
         match_sta = sta;
       if (!ap.all_zero())
         match_ap = ap;
-      ESPEasy_NOW_MAC = it->second.ESPEasy_Now_MAC();
+      ESPEasy_NOW_MAC = it->ESPEasy_Now_MAC();
 
       isNewNode = false;
       {
@@ -65,21 +70,23 @@ bool NodesHandler::addNode(const NodeStruct& node)
   }
   {
     _nodes_mutex.lock();
-    _nodes[node.unit] = node;
+    NodeStruct& stored = getOrAddNode(node.unit);
+    stored = node;
     _ntp_candidate.set(node);
-    _nodes[node.unit].lastUpdated = millis();
+    stored.lastUpdated = millis();
     if (node.getRSSI() >= 0 && rssi < 0) {
-      _nodes[node.unit].setRSSI(rssi);
+      stored.setRSSI(rssi);
     }
     const MAC_address node_ap(node.ap_mac);
     if (node_ap.all_zero()) {
-      _nodes[node.unit].setAP_MAC(node_ap);
+      stored.setAP_MAC(node_ap);
     }
     if (node.ESPEasy_Now_MAC().all_zero()) {
-      _nodes[node.unit].setESPEasyNow_mac(ESPEasy_NOW_MAC);
+      stored.setESPEasyNow_mac(ESPEasy_NOW_MAC);
     }
     _nodes_mutex.unlock();
   }
+  invalidatePreferredNode();
 
   // Check whether the current time source is considered "worse" than received from p2p node.
   if (!node_time.systemTimePresent() || 
@@ -105,6 +112,7 @@ bool NodesHandler::addNode(const NodeStruct& node, const ESPEasy_now_traceroute_
     _nodeStats[node.unit].setDiscoveryRoute(node.unit, traceRoute);
     _nodeStats_mutex.unlock();
   }
+  invalidatePreferredNode();
 
   ESPEasy_now_peermanager.addPeer(node.ESPEasy_Now_MAC(), node.channel);  
 
@@ -129,7 +137,7 @@ bool NodesHandler::addNode(const NodeStruct& node, const ESPEasy_now_traceroute_
 
 bool NodesHandler::hasNode(uint8_t unit_nr) const
 {
-  return _nodes.find(unit_nr) != _nodes.end();
+  return find(unit_nr) != _nodes.end();
 }
 
 bool NodesHandler::hasNode(const uint8_t *mac) const
@@ -139,22 +147,22 @@ bool NodesHandler::hasNode(const uint8_t *mac) const
 
 NodeStruct * NodesHandler::getNode(uint8_t unit_nr)
 {
-  auto it = _nodes.find(unit_nr);
+  auto it = lowerBound(unit_nr);
 
-  if (it == _nodes.end()) {
+  if ((it == _nodes.end()) || (it->unit != unit_nr)) {
     return nullptr;
   }
-  return &(it->second);
+  return &(*it);
 }
 
 const NodeStruct * NodesHandler::getNode(uint8_t unit_nr) const
 {
-  auto it = _nodes.find(unit_nr);
+  auto it = find(unit_nr);
 
   if (it == _nodes.end()) {
     return nullptr;
   }
-  return &(it->second);
+  return &(*it);
 }
 
 NodeStruct * NodesHandler::getNodeByMac(const MAC_address& mac)
@@ -166,12 +174,8 @@ NodeStruct * NodesHandler::getNodeByMac(const MAC_address& mac)
 
   for (auto it = _nodes.begin(); it != _nodes.end(); ++it)
   {
-    if (mac == it->second.sta_mac) {
-      return &(it->second);
-    }
-
-    if (mac == it->second.ap_mac) {
-      return &(it->second);
+    if ((mac == it->sta_mac) || (mac == it->ap_mac)) {
+      return &(*it);
     }
   }
   return nullptr;
@@ -193,14 +197,14 @@ const NodeStruct * NodesHandler::getNodeByMac(const MAC_address& mac, bool& matc
 
   for (auto it = _nodes.begin(); it != _nodes.end(); ++it)
   {
-    if (mac == it->second.sta_mac) {
+    if (mac == it->sta_mac) {
       match_STA = true;
-      return &(it->second);
+      return &(*it);
     }
 
-    if (mac == it->second.ap_mac) {
+    if (mac == it->ap_mac) {
       match_STA = false;
-      return &(it->second);
+      return &(*it);
     }
   }
   return nullptr;
@@ -224,6 +228,28 @@ const NodeStruct* NodesHandler::getPreferredNode_notMatching(uint8_t unit_nr) co
 }
 
 const NodeStruct * NodesHandler::getPreferredNode_notMatching(const MAC_address& not_matching) const {
+  if (!_preferredNode.valid ||
+      (_preferredNode.not_matching != not_matching) ||
+      timeOutReached(_preferredNode.validUntil)) {
+    unsigned long validFor = NODES_PREFERRED_NODE_CACHE_TIMEOUT;
+    const NodeStruct *res  = computePreferredNode_notMatching(not_matching, validFor);
+
+    _preferredNode.not_matching = not_matching;
+    _preferredNode.validUntil   = millis() + validFor;
+    _preferredNode.hasNode      = res != nullptr;
+    _preferredNode.unit         = res != nullptr ? res->unit : 0;
+    _preferredNode.valid        = true;
+    return res;
+  }
+
+  if (!_preferredNode.hasNode) {
+    return nullptr;
+  }
+  return getNode(_preferredNode.unit);
+}
+
+const NodeStruct * NodesHandler::computePreferredNode_notMatching(const MAC_address& not_matching,
+                                                                  unsigned long    & validFor) const {
   MAC_address this_mac;
 
   WiFi.macAddress(this_mac.mac);
@@ -234,7 +260,19 @@ const NodeStruct * NodesHandler::getPreferredNode_notMatching(const MAC_address&
 
   for (auto it = _nodes.begin(); it != _nodes.end(); ++it)
   {
-    if ((&(it->second) != reject) && (&(it->second) != thisNode)) {
+    if ((&(*it) != reject) && (&(*it) != thisNode)) {
+      // The score depends on the age of the nodes, so the result is only valid
+      // until the age of a candidate passes one of the thresholds used.
+      const unsigned long age = it->getAge();
+      if ((age <= NODE_STRUCT_AGE_TIMEOUT) && ((NODE_STRUCT_AGE_TIMEOUT - age) < validFor)) {
+        validFor = NODE_STRUCT_AGE_TIMEOUT - age + 1;
+      }
+      #ifdef USES_ESPEASY_NOW
+      if ((age < ESPEASY_NOW_ALLOWED_AGE_NO_TRACEROUTE) && ((ESPEASY_NOW_ALLOWED_AGE_NO_TRACEROUTE - age) < validFor)) {
+        validFor = ESPEASY_NOW_ALLOWED_AGE_NO_TRACEROUTE - age;
+      }
+      #endif
+
       bool mustSet = false;
       if (res == nullptr) {
         mustSet = true;
@@ -243,13 +281,13 @@ const NodeStruct * NodesHandler::getPreferredNode_notMatching(const MAC_address&
 
         uint8_t distance_new, distance_res = 255;
 
-        const int successRate_new = getRouteSuccessRate(it->second.unit, distance_new);
+        const int successRate_new = getRouteSuccessRate(it->unit, distance_new);
         const int successRate_res = getRouteSuccessRate(res->unit, distance_res);
 
         if (successRate_new == 0 || successRate_res == 0) {
           // One of the nodes does not (yet) have a route.
           if (successRate_new == 0 && successRate_res == 0) {
-            distance_new = it->second.distance;
+            distance_new = it->distance;
             distance_res = res->distance;
           } else if (successRate_res == 0) {
             // The new one has a route, so must set the new one.
@@ -265,25 +303,25 @@ const NodeStruct * NodesHandler::getPreferredNode_notMatching(const MAC_address&
             mustSet = true;
           }
         } else if (distance_new < distance_res) {
-          if (it->second.getAge() < ESPEASY_NOW_ALLOWED_AGE_NO_TRACEROUTE) {
+          if (age < ESPEASY_NOW_ALLOWED_AGE_NO_TRACEROUTE) {
             // Only allow this new one if it was seen recently 
             // as it does not (yet) have a traceroute.
             mustSet = true;
           }
         }
         #else
-        if (it->second < *res) {
+        if (*it < *res) {
             mustSet = true;
         }
         #endif
       }
       if (mustSet) {
         #ifdef USES_ESPEASY_NOW
-        if (it->second.ESPEasyNowPeer && it->second.distance < 255) {
-          res = &(it->second);
+        if (it->ESPEasyNowPeer && it->distance < 255) {
+          res = &(*it);
         }
         #else
-        res = &(it->second);
+        res = &(*it);
         #endif
       }
     }
@@ -336,6 +374,7 @@ void NodesHandler::setTraceRoute(const MAC_address& mac, const ESPEasy_now_trace
     if (trace_it != _nodeStats.end()) {
       _lastTimeValidDistance = millis();
       trace_it->second.addRoute(node->unit, traceRoute);
+      invalidatePreferredNode();
     }
   }
 }
@@ -492,17 +531,48 @@ uint8_t NodesHandler::getDistance() const {
 }
 
 
-NodesMap::const_iterator NodesHandler::begin() const {
+NodesList::const_iterator NodesHandler::begin() const {
   return _nodes.begin();
 }
 
-NodesMap::const_iterator NodesHandler::end() const {
+NodesList::const_iterator NodesHandler::end() const {
+  return _nodes.end();
+}
+
+NodesList::const_iterator NodesHandler::find(uint8_t unit_nr) const
+{
+  auto it = lowerBound(unit_nr);
+
+  if ((it != _nodes.end()) && (it->unit == unit_nr)) {
+    return it;
+  }
   return _nodes.end();
 }
 
-NodesMap::const_iterator NodesHandler::find(uint8_t unit_nr) const
+NodesList::iterator NodesHandler::lowerBound(uint8_t unit_nr)
 {
-  return _nodes.find(unit_nr);
+  return std::lower_bound(
+    _nodes.begin(), _nodes.end(), unit_nr,
+    [](const NodeStruct& node, uint8_t unit) { return node.unit < unit; });
+}
+
+NodesList::const_iterator NodesHandler::lowerBound(uint8_t unit_nr) const
+{
+  return std::lower_bound(
+    _nodes.begin(), _nodes.end(), unit_nr,
+    [](const NodeStruct& node, uint8_t unit) { return node.unit < unit; });
+}
+
+NodeStruct& NodesHandler::getOrAddNode(uint8_t unit_nr)
+{
+  auto it = lowerBound(unit_nr);
+
+  if ((it == _nodes.end()) || (it->unit != unit_nr)) {
+    NodeStruct node;
+    node.unit = unit_nr;
+    it        = _nodes.insert(it, node);
+  }
+  return *it;
 }
 
 bool NodesHandler::refreshNodeList(unsigned long max_age_allowed, unsigned long& max_age)
@@ -511,11 +581,11 @@ bool NodesHandler::refreshNodeList(unsigned long max_age_allowed, unsigned long&
   bool nodeRemoved = false;
 
   for (auto it = _nodes.begin(); it != _nodes.end();) {
-    unsigned long age = it->second.getAge();
+    unsigned long age = it->getAge();
     if (age > max_age_allowed) {
       bool mustErase = true;
       #ifdef USES_ESPEASY_NOW
-      auto route_it = _nodeStats.find(it->second.unit);
+      auto route_it = _nodeStats.find(it->unit);
       if (route_it != _nodeStats.end()) {
         if (route_it->second.getAge() > max_age_allowed) {
           _nodeStats_mutex.lock();
@@ -542,6 +612,7 @@ bool NodesHandler::refreshNodeList(unsigned long max_age_allowed, unsigned long&
       }
     }
   }
+  invalidatePreferredNode();
   return nodeRemoved;
 }
 
@@ -609,6 +680,7 @@ void NodesHandler::setRSSI(NodeStruct * node, int rssi)
 {
   if (node != nullptr) {
     node->setRSSI(rssi);
+    invalidatePreferredNode();
   }
 }
 
@@ -624,6 +696,7 @@ void NodesHandler::updateSuccessRate(uint8_t unit, bool success)
   auto it = _nodeStats.find(unit);
   if (it != _nodeStats.end()) {
     it->second.updateSuccessRate(unit, success);
+    invalidatePreferredNode();
   }
 }
 
@@ -45,9 +45,11 @@ public:
   const NodeStruct       * getNodeByMac(const MAC_address& mac,
                                         bool             & match_STA) const;
 
-  NodesMap::const_iterator begin() const;
-  NodesMap::const_iterator end() const;
-  NodesMap::const_iterator find(uint8_t unit_nr) const;
+  // Iterate over the nodes, in order of unit nr.
+  // N.B. Adding a node may invalidate iterators and pointers to nodes.
+  NodesList::const_iterator begin() const;
+  NodesList::const_iterator end() const;
+  NodesList::const_iterator find(uint8_t unit_nr) const;
 
   // Remove nodes in list older than max_age_allowed (msec)
   // Returns oldest age, max_age (msec) not removed from the list.
@@ -56,6 +58,8 @@ public:
                        unsigned long& max_age);
 
 
+  // The preferred node is cached until one of its score inputs changes
+  // or the age of one of the nodes passes a threshold used in the score.
   const NodeStruct                   * getPreferredNode() const;
   const NodeStruct                   * getPreferredNode_notMatching(uint8_t unit_nr) const;
   const NodeStruct                   * getPreferredNode_notMatching(const MAC_address& not_matching) const;
@@ -125,13 +129,38 @@ private:
   void setRSSI(NodeStruct *node,
                int         rssi);
 
+  // First node with unit nr >= unit_nr
+  NodesList::iterator       lowerBound(uint8_t unit_nr);
+  NodesList::const_iterator lowerBound(uint8_t unit_nr) const;
+
+  // Return the node with this unit nr, add it when not present.
+  NodeStruct& getOrAddNode(uint8_t unit_nr);
+
+  const NodeStruct* computePreferredNode_notMatching(const MAC_address& not_matching,
+                                                     unsigned long    & validFor) const;
+
+  void invalidatePreferredNode() {
+    _preferredNode.valid = false;
+  }
+
   unsigned long _lastTimeValidDistance = 0;
 
   uint8_t _distance = 255; // Cached value
 
-  NodesMap _nodes;
+  NodesList _nodes;
   ESPEasy_Mutex _nodes_mutex;
 
+  // Cached result of getPreferredNode_notMatching()
+  struct PreferredNode_cache_t {
+    MAC_address   not_matching;
+    unsigned long validUntil = 0;
+    uint8_t       unit       = 0;
+    bool          hasNode    = false; // false when no preferred node was found
+    bool          valid      = false;
+  };
+
+  mutable PreferredNode_cache_t _preferredNode;
+
   NTP_candidate_struct _ntp_candidate;
   
 
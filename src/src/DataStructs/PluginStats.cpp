@@ -3,7 +3,10 @@
 #if FEATURE_PLUGIN_STATS
 # include "../../_Plugin_Helper.h"
 
+# include "../Globals/ESPEasy_time.h"
+
 # include "../Helpers/ESPEasy_math.h"
+# include "../Helpers/Memory.h"
 
 # include "../WebServer/Chart_JS.h"
 
@@ -15,11 +18,122 @@ PluginStats::PluginStats(uint8_t nrDecimals, float errorValue) :
   _errorValueIsNaN = isnan(_errorValue);
   _minValue        = std::numeric_limits<float>::max();
   _maxValue        = std::numeric_limits<float>::lowest();
+  _sampleMin       = std::numeric_limits<float>::max();
+  _sampleMax       = std::numeric_limits<float>::lowest();
+  # if FEATURE_PLUGIN_STATS_HISTORY
+  void *history = buffer_malloc(MemoryBufferClass_e::PluginStats, sizeof(PluginStatsHistory));
+
+  if (history != nullptr) {
+    _history = new (history) PluginStatsHistory();
+  }
+  # endif // if FEATURE_PLUGIN_STATS_HISTORY
+}
+
+PluginStats::~PluginStats()
+{
+  # if FEATURE_PLUGIN_STATS_HISTORY
+  if (_history != nullptr) {
+    _history->~PluginStatsHistory();
+    buffer_free(MemoryBufferClass_e::PluginStats, _history, sizeof(PluginStatsHistory));
+    _history = nullptr;
+  }
+  # endif // if FEATURE_PLUGIN_STATS_HISTORY
 }
 
 bool PluginStats::push(float value)
 {
-  return _samples.push(value);
+  if (_samples.isFull()) {
+    // Oldest sample will be overwritten
+    removeFromAccumulators(_samples.first());
+  }
+  const bool res = _samples.push(value);
+
+  addToAccumulators(value);
+  # if FEATURE_PLUGIN_STATS_HISTORY
+
+  if ((_history != nullptr) && usableValue(value)) {
+    _history->push(value);
+  }
+  # endif // if FEATURE_PLUGIN_STATS_HISTORY
+
+  if (++_nrPushesSinceResync >= PLUGIN_STATS_NR_ELEMENTS) {
+    resyncAccumulators();
+  }
+  return res;
+}
+
+void PluginStats::clearSamples()
+{
+  _samples.clear();
+  resyncAccumulators();
+  # if FEATURE_PLUGIN_STATS_HISTORY
+
+  if (_history != nullptr) {
+    _history->clear();
+  }
+  # endif // if FEATURE_PLUGIN_STATS_HISTORY
+}
+
+void PluginStats::addToAccumulators(float value)
+{
+  if (!usableValue(value)) { return; }
+  _sampleSum   += value;
+  _sampleSumSq += static_cast<double>(value) * value;
+  ++_nrUsableSamples;
+
+  if (_sampleExtremesValid) {
+    if (value < _sampleMin) { _sampleMin = value; }
+
+    if (value > _sampleMax) { _sampleMax = value; }
+  }
+}
+
+void PluginStats::removeFromAccumulators(float value)
+{
+  if (!usableValue(value)) { return; }
+  _sampleSum   -= value;
+  _sampleSumSq -= static_cast<double>(value) * value;
+
+  if (_nrUsableSamples > 0) {
+    --_nrUsableSamples;
+  }
+
+  if ((value <= _sampleMin) || (value >= _sampleMax)) {
+    _sampleExtremesValid = false;
+  }
+}
+
+void PluginStats::resyncAccumulators()
+{
+  _sampleSum           = 0.0;
+  _sampleSumSq         = 0.0;
+  _nrUsableSamples     = 0;
+  _nrPushesSinceResync = 0;
+  _sampleMin           = std::numeric_limits<float>::max();
+  _sampleMax           = std::numeric_limits<float>::lowest();
+  _sampleExtremesValid = true;
+
+  for (PluginStatsBuffer_t::index_t i = 0; i < _samples.size(); ++i) {
+    addToAccumulators(_samples[i]);
+  }
+}
+
+void PluginStats::updateSampleExtremes() const
+{
+  if (_sampleExtremesValid) { return; }
+  _sampleMin = std::numeric_limits<float>::max();
+  _sampleMax = std::numeric_limits<float>::lowest();
+
+  for (PluginStatsBuffer_t::index_t i = 0; i < _samples.size(); ++i) {
+    const float sample(_samples[i]);
+
+    if (usableValue(sample)) {
+      if (sample < _sampleMin) { _sampleMin = sample; }
+
+      if (sample > _sampleMax) { _sampleMax = sample; }
+    }
+  }
+  _sampleExtremesValid = true;
 }
 
 void PluginStats::trackPeak(float value)
@@ -38,6 +152,11 @@ void PluginStats::resetPeaks()
 float PluginStats::getSampleAvg(PluginStatsBuffer_t::index_t lastNrSamples) const
 {
   if (_samples.size() == 0) { return _errorValue; }
+
+  if (lastNrSamples >= _samples.size()) {
+    if (_nrUsableSamples == 0) { return _errorValue; }
+    return static_cast<float>(_sampleSum / _nrUsableSamples);
+  }
   float sum = 0.0f;
 
   PluginStatsBuffer_t::index_t i = 0;
@@ -62,6 +181,16 @@ float PluginStats::getSampleAvg(PluginStatsBuffer_t::index_t lastNrSamples) cons
 
 float PluginStats::getSampleStdDev(PluginStatsBuffer_t::index_t lastNrSamples) const
 {
+  if (lastNrSamples >= _samples.size()) {
+    if (_nrUsableSamples < 2) { return 0.0f; }
+
+    // Population variance: E[x^2] - E[x]^2
+    const double average = _sampleSum / _nrUsableSamples;
+    const double var     = _sampleSumSq / _nrUsableSamples - average * average;
+
+    if (var <= 0.0) { return 0.0f; }
+    return static_cast<float>(sqrt(var));
+  }
   float variance      = 0.0f;
   const float average = getSampleAvg(lastNrSamples);
 
@@ -94,6 +223,13 @@ float PluginStats::getSampleExtreme(PluginStatsBuffer_t::index_t lastNrSamples,
 {
   if (_samples.size() == 0) { return _errorValue; }
 
+  if (lastNrSamples >= _samples.size()) {
+    updateSampleExtremes();
+
+    if (_sampleMin > _sampleMax) { return _errorValue; }
+    return getMax ? _sampleMax : _sampleMin;
+  }
+
   PluginStatsBuffer_t::index_t i = 0;
 
   if (lastNrSamples < _samples.size()) {
@@ -345,25 +481,78 @@ void PluginStats::webformLoad_show_val(
 }
 
 # if FEATURE_CHART_JS
-void PluginStats::plot_ChartJS_dataset() const
+String PluginStats::get_ChartJS_binary_dataset_header(bool history, float& scale) const
 {
-  add_ChartJS_dataset_header(getLabel(), _ChartJS_dataset_config.color);
+  float    minValue = std::numeric_limits<float>::max();
+  float    maxValue = std::numeric_limits<float>::lowest();
+  uint16_t count    = 0;
 
-  PluginStatsBuffer_t::index_t i = 0;
+  #  if FEATURE_PLUGIN_STATS_HISTORY
 
-  for (; i < _samples.size(); ++i) {
-    if (i != 0) {
-      addHtml(',');
+  if (history) {
+    if (_history != nullptr) {
+      PluginStatsBucket_t bucket;
+
+      for (; _history->getBucket(PluginStatsHistoryTier_e::QuarterHour, count, bucket); ++count) {
+        if (bucket.avg < minValue) { minValue = bucket.avg; }
+
+        if (bucket.avg > maxValue) { maxValue = bucket.avg; }
+      }
     }
+  } else
+  #  endif // if FEATURE_PLUGIN_STATS_HISTORY
+  {
+    // Error values are sent too, so include them in the range
+    for (; count < _samples.size(); ++count) {
+      const float sample(_samples[count]);
 
-    if (!isnan(_samples[i])) {
-      addHtmlFloat(_samples[i], _nrDecimals);
+      if (!isnan(sample)) {
+        if (sample < minValue) { minValue = sample; }
+
+        if (sample > maxValue) { maxValue = sample; }
+      }
     }
-    else {
-      addHtml(F("null"));
+  }
+  scale = get_ChartJS_binary_scale(minValue, maxValue, _nrDecimals);
+
+  String res;
+
+  res  = F("{\"name\":");
+  res += to_json_value(getLabel(), true);
+  res += F(",\"color\":\"");
+  res += _ChartJS_dataset_config.color;
+  res += F("\",\"hidden\":");
+  res += boolToString(_ChartJS_dataset_config.hidden);
+  res += F(",\"count\":");
+  res += count;
+  res += F(",\"scale\":");
+  res += static_cast<uint32_t>(scale);
+  res += '}';
+  return res;
+}
+
+void PluginStats::send_ChartJS_binary_values(bool history, float scale) const
+{
+  ChartJS_binary_array values(scale);
+
+  #  if FEATURE_PLUGIN_STATS_HISTORY
+
+  if (history) {
+    if (_history != nullptr) {
+      PluginStatsBucket_t bucket;
+
+      for (uint16_t i = 0; _history->getBucket(PluginStatsHistoryTier_e::QuarterHour, i, bucket); ++i) {
+        values.add(bucket.avg);
+      }
+    }
+  } else
+  #  endif // if FEATURE_PLUGIN_STATS_HISTORY
+  {
+    for (PluginStatsBuffer_t::index_t i = 0; i < _samples.size(); ++i) {
+      values.add(_samples[i]);
     }
   }
-  add_ChartJS_dataset_footer(_ChartJS_dataset_config.hidden);
+  values.flush();
 }
 
 # endif // if FEATURE_CHART_JS
@@ -528,32 +717,94 @@ bool PluginStats_array::webformLoad_show_stats(struct EventStruct *event) const
 }
 
 # if FEATURE_CHART_JS
-void PluginStats_array::plot_ChartJS() const
+void PluginStats_array::plot_ChartJS(taskIndex_t taskIndex) const
+{
+  if (nrSamplesPresent() == 0) { return; }
+
+  add_ChartJS_binary_chart(F("line"), F("TaskStatsChart"), F(""), 500, 500,
+                           strformat(F("/pluginstats_bin?tasknr=%u"), static_cast<unsigned int>(taskIndex + 1)));
+}
+
+#  if FEATURE_PLUGIN_STATS_HISTORY
+static const PluginStatsHistory* getFirstHistory(PluginStats * const plugin_stats[])
 {
-  const size_t nrSamples = nrSamplesPresent();
+  for (size_t i = 0; i < VARS_PER_TASK; ++i) {
+    if ((plugin_stats[i] != nullptr) && (plugin_stats[i]->getHistory() != nullptr)) {
+      return plugin_stats[i]->getHistory();
+    }
+  }
+  return nullptr;
+}
 
-  if (nrSamples == 0) { return; }
+void PluginStats_array::plot_ChartJS_history(taskIndex_t taskIndex) const
+{
+  const PluginStatsHistory *history = getFirstHistory(_plugin_stats);
+
+  if ((history == nullptr) || (history->getNrBuckets(PluginStatsHistoryTier_e::QuarterHour) == 0)) { return; }
+
+  add_ChartJS_binary_chart(F("line"), F("TaskStatsHistoryChart"), F("Average per 15 minutes"), 500, 500,
+                           strformat(F("/pluginstats_bin?tasknr=%u&history=1"), static_cast<unsigned int>(taskIndex + 1)));
+}
+
+#  endif // if FEATURE_PLUGIN_STATS_HISTORY
 
-  // Chart Header
-  add_ChartJS_chart_header(F("line"), F("TaskStatsChart"), F(""), 500, 500);
+void PluginStats_array::send_ChartJS_binary(bool history) const
+{
+  #  if FEATURE_PLUGIN_STATS_HISTORY
+  const PluginStatsHistory *labelHistory = history ? getFirstHistory(_plugin_stats) : nullptr;
+  #  else // if FEATURE_PLUGIN_STATS_HISTORY
+  history = false;
+  #  endif // if FEATURE_PLUGIN_STATS_HISTORY
 
-  // Add labels
-  for (size_t i = 0; i < nrSamples; ++i) {
-    if (i != 0) {
-      addHtml(',');
+  uint16_t count = nrSamplesPresent();
+
+  #  if FEATURE_PLUGIN_STATS_HISTORY
+
+  if (history) {
+    count = (labelHistory == nullptr) ? 0 : labelHistory->getNrBuckets(PluginStatsHistoryTier_e::QuarterHour);
+  }
+  #  endif // if FEATURE_PLUGIN_STATS_HISTORY
+
+  // Labels of the history: Hours ago, or bucket index when the system time was not set
+  const uint32_t now = node_time.systemTimePresent() ? node_time.getUnixTime() : 0;
+
+  String header = strformat(
+    F("{\"count\":%u,\"now\":%u,\"labels\":%d,\"datasets\":["),
+    static_cast<unsigned int>(count),
+    static_cast<unsigned int>(now),
+    history ? 1 : 0);
+  float scales[VARS_PER_TASK] = {};
+  bool  first                 = true;
+
+  for (size_t i = 0; i < VARS_PER_TASK; ++i) {
+    if (_plugin_stats[i] != nullptr) {
+      if (!first) { header += ','; }
+      first   = false;
+      header += _plugin_stats[i]->get_ChartJS_binary_dataset_header(history, scales[i]);
     }
-    addHtmlInt(i);
   }
-  addHtml(F("],datasets: ["));
+  header += ']';
+  header += '}';
+  add_ChartJS_binary_header(header);
+
+  #  if FEATURE_PLUGIN_STATS_HISTORY
 
+  if (history && (labelHistory != nullptr)) {
+    ChartJS_binary_array labels;
+    PluginStatsBucket_t  bucket;
+
+    for (uint16_t i = 0; i < count && labelHistory->getBucket(PluginStatsHistoryTier_e::QuarterHour, i, bucket); ++i) {
+      labels.addTimestamp(bucket.timestamp);
+    }
+    labels.flush();
+  }
+  #  endif // if FEATURE_PLUGIN_STATS_HISTORY
 
-  // Data sets
   for (size_t i = 0; i < VARS_PER_TASK; ++i) {
     if (_plugin_stats[i] != nullptr) {
-      _plugin_stats[i]->plot_ChartJS_dataset();
+      _plugin_stats[i]->send_ChartJS_binary_values(history, scales[i]);
     }
   }
-  add_ChartJS_chart_footer();
 }
 
 # endif // if FEATURE_CHART_JS
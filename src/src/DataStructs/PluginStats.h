@@ -6,6 +6,7 @@
 #if FEATURE_PLUGIN_STATS
 
 # include "../DataStructs/ChartJS_dataset_config.h"
+# include "../DataStructs/PluginStatsHistory.h"
 #include "../DataTypes/TaskIndex.h"
 
 
@@ -29,6 +30,11 @@ public:
   PluginStats(uint8_t nrDecimals,
               float   errorValue);
 
+  ~PluginStats();
+
+  PluginStats(const PluginStats&)            = delete;
+  PluginStats& operator=(const PluginStats&) = delete;
+
 
   // Add a sample to the _sample buffer
   // This does not also track peaks as the peaks could be raw sensor data and the samples processed data.
@@ -56,14 +62,16 @@ public:
   // Set the peaks to unset values
   void resetPeaks();
 
-  void clearSamples() {
-    _samples.clear();
-  }
+  void clearSamples();
 
   size_t getNrSamples() const {
     return _samples.size();
   }
 
+  uint8_t getNrDecimals() const {
+    return _nrDecimals;
+  }
+
   // Compute average over all stored values
   float getSampleAvg() const {
     return getSampleAvg(_samples.size());
@@ -88,6 +96,15 @@ public:
   
   float operator[](PluginStatsBuffer_t::index_t index) const;
 
+# if FEATURE_PLUGIN_STATS_HISTORY
+
+  // Downsampled history, nullptr when it could not be allocated
+  const PluginStatsHistory* getHistory() const {
+    return _history;
+  }
+
+# endif // if FEATURE_PLUGIN_STATS_HISTORY
+
 private:
   static bool matchedCommand(const String& command, const __FlashStringHelper *cmd_match, int& nrSamples);
 
@@ -128,7 +145,15 @@ public:
   }
 
 # if FEATURE_CHART_JS
-  void plot_ChartJS_dataset() const;
+
+  // JSON object describing this dataset in the binary chart data, see add_ChartJS_binary_header()
+  // @param history  Use the 15-minute history instead of the samples
+  // @param scale    Set to the scale for send_ChartJS_binary_values()
+  String get_ChartJS_binary_dataset_header(bool   history,
+                                           float& scale) const;
+
+  void   send_ChartJS_binary_values(bool  history,
+                                    float scale) const;
 # endif // if FEATURE_CHART_JS
 
 # if FEATURE_CHART_JS
@@ -150,10 +175,37 @@ private:
 
   bool usableValue(float value) const;
 
+  // Running accumulators over all samples in _samples, updated in push()
+  // so queries over the full buffer do not need to iterate the buffer.
+  void addToAccumulators(float value);
+  void removeFromAccumulators(float value);
+
+  // Recompute the accumulators from _samples.
+  // Called once per PLUGIN_STATS_NR_ELEMENTS pushes to prevent rounding errors to accumulate.
+  void resyncAccumulators();
+
+  // Min/max over all samples are only recomputed when needed
+  // after the current min or max was removed from the buffer.
+  void updateSampleExtremes() const;
+
   float _minValue;
   float _maxValue;
 
   PluginStatsBuffer_t _samples;
+
+  double _sampleSum   = 0.0;
+  double _sampleSumSq = 0.0;
+  PluginStatsBuffer_t::index_t _nrUsableSamples = 0;
+  PluginStatsBuffer_t::index_t _nrPushesSinceResync = 0;
+
+  mutable float _sampleMin;
+  mutable float _sampleMax;
+  mutable bool  _sampleExtremesValid = true;
+
+# if FEATURE_PLUGIN_STATS_HISTORY
+  PluginStatsHistory *_history = nullptr;
+# endif // if FEATURE_PLUGIN_STATS_HISTORY
+
   float _errorValue;
   bool _errorValueIsNaN;
 
@@ -186,7 +238,17 @@ public:
   bool    webformLoad_show_stats(struct EventStruct *event) const;
 
 # if FEATURE_CHART_JS
-  void    plot_ChartJS() const;
+
+  // Charts are fetched as binary data from /pluginstats_bin
+  void    plot_ChartJS(taskIndex_t taskIndex) const;
+#  if FEATURE_PLUGIN_STATS_HISTORY
+
+  // Plot the average per 15-minute bucket
+  void    plot_ChartJS_history(taskIndex_t taskIndex) const;
+#  endif // if FEATURE_PLUGIN_STATS_HISTORY
+
+  // Send the samples or the 15-minute history as binary chart data
+  void    send_ChartJS_binary(bool history) const;
 # endif // if FEATURE_CHART_JS
 
 
@@ -0,0 +1,116 @@
+#include "../DataStructs/PluginStatsHistory.h"
+
+#if FEATURE_PLUGIN_STATS_HISTORY
+
+# include "../Globals/ESPEasy_time.h"
+# include "../Helpers/ESPEasy_time_calc.h"
+
+void PluginStatsHistory::Accumulator::add(float value, float minValue, float maxValue, uint32_t nrSamples)
+{
+  if (isEmpty()) {
+    min         = minValue;
+    max         = maxValue;
+    startMillis = millis();
+    timestamp   = node_time.systemTimePresent() ? node_time.getUnixTime() : 0;
+  } else {
+    if (minValue < min) { min = minValue; }
+
+    if (maxValue > max) { max = maxValue; }
+  }
+  sum   += static_cast<double>(value) * nrSamples;
+  count += nrSamples;
+}
+
+PluginStatsBucket_t PluginStatsHistory::Accumulator::get() const
+{
+  PluginStatsBucket_t bucket{};
+
+  if (!isEmpty()) {
+    bucket.timestamp = timestamp;
+    bucket.min       = min;
+    bucket.avg       = static_cast<float>(sum / count);
+    bucket.max       = max;
+  }
+  return bucket;
+}
+
+void PluginStatsHistory::push(float value)
+{
+  if (!_minute.isEmpty() &&
+      (timePassedSince(_minute.startMillis) >= static_cast<long>(getIntervalSec(PluginStatsHistoryTier_e::Minute) * 1000))) {
+    closeMinuteBucket();
+  }
+  _minute.add(value, value, value, 1);
+}
+
+void PluginStatsHistory::clear()
+{
+  _minuteBuckets.clear();
+  _quarterBuckets.clear();
+  _minute  = Accumulator();
+  _quarter = Accumulator();
+}
+
+uint16_t PluginStatsHistory::getNrBuckets(PluginStatsHistoryTier_e tier) const
+{
+  switch (tier) {
+    case PluginStatsHistoryTier_e::Minute:      return _minuteBuckets.size();
+    case PluginStatsHistoryTier_e::QuarterHour: return _quarterBuckets.size();
+    case PluginStatsHistoryTier_e::NR_ELEMENTS: break;
+  }
+  return 0;
+}
+
+bool PluginStatsHistory::getBucket(PluginStatsHistoryTier_e tier, uint16_t index, PluginStatsBucket_t& bucket) const
+{
+  if (index >= getNrBuckets(tier)) {
+    return false;
+  }
+
+  if (tier == PluginStatsHistoryTier_e::Minute) {
+    bucket = _minuteBuckets[index];
+  } else {
+    bucket = _quarterBuckets[index];
+  }
+  return true;
+}
+
+uint32_t PluginStatsHistory::getIntervalSec(PluginStatsHistoryTier_e tier)
+{
+  switch (tier) {
+    case PluginStatsHistoryTier_e::Minute:      return 60;
+    case PluginStatsHistoryTier_e::QuarterHour: return 15 * 60;
+    case PluginStatsHistoryTier_e::NR_ELEMENTS: break;
+  }
+  return 0;
+}
+
+void PluginStatsHistory::closeMinuteBucket()
+{
+  const PluginStatsBucket_t bucket = _minute.get();
+
+  _minuteBuckets.push(bucket);
+
+  if (!_quarter.isEmpty() &&
+      (timePassedSince(_quarter.startMillis) >= static_cast<long>(getIntervalSec(PluginStatsHistoryTier_e::QuarterHour) * 1000))) {
+    closeQuarterBucket();
+  }
+
+  // Keep the weight of the number of samples, so the 15-minute average is the average of all samples.
+  _quarter.add(bucket.avg, bucket.min, bucket.max, _minute.count);
+
+  if (_quarter.count == _minute.count) {
+    // First minute of this quarter, start at its first sample
+    _quarter.startMillis = _minute.startMillis;
+    _quarter.timestamp   = _minute.timestamp;
+  }
+  _minute = Accumulator();
+}
+
+void PluginStatsHistory::closeQuarterBucket()
+{
+  _quarterBuckets.push(_quarter.get());
+  _quarter = Accumulator();
+}
+
+#endif // if FEATURE_PLUGIN_STATS_HISTORY
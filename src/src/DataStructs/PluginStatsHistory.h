@@ -0,0 +1,94 @@
+#ifndef DATASTRUCTS_PLUGINSTATSHISTORY_H
+#define DATASTRUCTS_PLUGINSTATSHISTORY_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_PLUGIN_STATS_HISTORY
+
+# include <CircularBuffer.h>
+
+// Nr of 1-minute buckets, default 1 hour
+# ifndef PLUGIN_STATS_HISTORY_MINUTE_BUCKETS
+#  define PLUGIN_STATS_HISTORY_MINUTE_BUCKETS   60
+# endif // ifndef PLUGIN_STATS_HISTORY_MINUTE_BUCKETS
+
+// Nr of 15-minute buckets, default 24 hours
+# ifndef PLUGIN_STATS_HISTORY_QUARTER_BUCKETS
+#  define PLUGIN_STATS_HISTORY_QUARTER_BUCKETS  96
+# endif // ifndef PLUGIN_STATS_HISTORY_QUARTER_BUCKETS
+
+enum class PluginStatsHistoryTier_e : uint8_t {
+  Minute,
+  QuarterHour,
+
+  NR_ELEMENTS // Keep as last
+};
+
+// N.B. Must remain an aggregate without default member initializers, as CircularBuffer initializes with {0}
+struct PluginStatsBucket_t {
+  uint32_t timestamp; // Unix time of the first sample, 0 when system time was not set
+  float    min;
+  float    avg;
+  float    max;
+};
+
+/*********************************************************************************************\
+* PluginStatsHistory
+* Downsampled history of a task value.
+* Samples are collected in 1-minute buckets, which are combined into 15-minute buckets.
+* Per bucket only min/avg/max are kept.
+* Buckets are only closed when a new sample arrives, so periods without samples are skipped.
+\*********************************************************************************************/
+class PluginStatsHistory {
+public:
+
+  // Add a usable sample, error values should be filtered by the caller.
+  void     push(float value);
+
+  void     clear();
+
+  uint16_t getNrBuckets(PluginStatsHistoryTier_e tier) const;
+
+  // Get bucket by index, 0 is the oldest bucket.
+  bool     getBucket(PluginStatsHistoryTier_e tier,
+                     uint16_t                 index,
+                     PluginStatsBucket_t    & bucket) const;
+
+  static uint32_t getIntervalSec(PluginStatsHistoryTier_e tier);
+
+private:
+
+  struct Accumulator {
+    bool isEmpty() const {
+      return count == 0;
+    }
+
+    void                add(float    value,
+                            float    minValue,
+                            float    maxValue,
+                            uint32_t nrSamples);
+
+    PluginStatsBucket_t get() const;
+
+    double   sum{};
+    float    min{};
+    float    max{};
+    uint32_t count{};
+    uint32_t startMillis{};
+    uint32_t timestamp{};
+  };
+
+  void closeMinuteBucket();
+
+  void closeQuarterBucket();
+
+  CircularBuffer<PluginStatsBucket_t, PLUGIN_STATS_HISTORY_MINUTE_BUCKETS> _minuteBuckets;
+  CircularBuffer<PluginStatsBucket_t, PLUGIN_STATS_HISTORY_QUARTER_BUCKETS> _quarterBuckets;
+
+  Accumulator _minute;
+  Accumulator _quarter;
+};
+
+#endif // if FEATURE_PLUGIN_STATS_HISTORY
+
+#endif // ifndef DATASTRUCTS_PLUGINSTATSHISTORY_H
@@ -37,3 +37,120 @@ void PluginTaskData_base::clearPluginStats(taskVarIndex_t taskVarIndex)
 }
 
 #endif // if FEATURE_PLUGIN_STATS
+
+#if FEATURE_PLUGIN_TASKDATA_ARENA
+
+struct PluginTaskDataArena_t {
+  void  *ptr;
+  size_t size;
+  bool   inUse;
+};
+
+static PluginTaskDataArena_t PluginTaskData_arena[TASKS_MAX] = {};
+
+// Task being initialized, INVALID_TASK_INDEX when not in a PluginTaskDataArenaScope
+static taskIndex_t PluginTaskData_arena_taskIndex = INVALID_TASK_INDEX;
+
+static void* PluginTaskData_arena_alloc(size_t size)
+{
+  if (!validTaskIndex(PluginTaskData_arena_taskIndex)) {
+    return nullptr;
+  }
+  PluginTaskDataArena_t& arena = PluginTaskData_arena[PluginTaskData_arena_taskIndex];
+
+  if (arena.inUse) {
+    // Old object not yet deleted, or a second object allocated during init
+    return nullptr;
+  }
+
+  if ((arena.ptr != nullptr) && (arena.size < size)) {
+    // Other plugin set to this task, needing a larger block
+    free(arena.ptr);
+    arena.ptr  = nullptr;
+    arena.size = 0;
+  }
+
+  if (arena.ptr == nullptr) {
+    arena.ptr = malloc(size);
+
+    if (arena.ptr == nullptr) {
+      return nullptr;
+    }
+    arena.size = size;
+  }
+  arena.inUse = true;
+  return arena.ptr;
+}
+
+static bool PluginTaskData_arena_release(void *ptr)
+{
+  if (ptr == nullptr) {
+    return false;
+  }
+
+  for (taskIndex_t i = 0; i < TASKS_MAX; ++i) {
+    if (PluginTaskData_arena[i].ptr == ptr) {
+      PluginTaskData_arena[i].inUse = false;
+      return true;
+    }
+  }
+  return false;
+}
+
+void * PluginTaskData_base::operator new(size_t size)
+{
+  void *ptr = PluginTaskData_arena_alloc(size);
+
+  if (ptr == nullptr) {
+    ptr = ::operator new(size);
+  }
+  return ptr;
+}
+
+void * PluginTaskData_base::operator new(size_t size, const std::nothrow_t&) noexcept
+{
+  void *ptr = PluginTaskData_arena_alloc(size);
+
+  if (ptr == nullptr) {
+    ptr = ::operator new(size, std::nothrow);
+  }
+  return ptr;
+}
+
+void PluginTaskData_base::operator delete(void *ptr) noexcept
+{
+  if (!PluginTaskData_arena_release(ptr)) {
+    ::operator delete(ptr);
+  }
+}
+
+void PluginTaskData_base::operator delete(void *ptr, const std::nothrow_t&) noexcept
+{
+  PluginTaskData_base::operator delete(ptr);
+}
+
+PluginTaskDataArenaScope::PluginTaskDataArenaScope(taskIndex_t taskIndex)
+  : _previous(PluginTaskData_arena_taskIndex)
+{
+  PluginTaskData_arena_taskIndex = taskIndex;
+}
+
+PluginTaskDataArenaScope::~PluginTaskDataArenaScope()
+{
+  PluginTaskData_arena_taskIndex = _previous;
+}
+
+void freePluginTaskDataArena(taskIndex_t taskIndex)
+{
+  if (validTaskIndex(taskIndex)) {
+    PluginTaskDataArena_t& arena = PluginTaskData_arena[taskIndex];
+
+    if (!arena.inUse && (arena.ptr != nullptr)) {
+      free(arena.ptr);
+      arena.ptr  = nullptr;
+      arena.size = 0;
+    }
+  }
+}
+
+#endif // if FEATURE_PLUGIN_TASKDATA_ARENA
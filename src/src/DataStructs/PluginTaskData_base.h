@@ -9,6 +9,8 @@
 #include "../DataTypes/PluginID.h"
 #include "../DataTypes/TaskIndex.h"
 
+#include <new> // for std::nothrow
+
 // ==============================================
 // Data used by instances of plugins.
 // =============================================
@@ -31,6 +33,15 @@ struct PluginTaskData_base {
 #endif // if FEATURE_PLUGIN_STATS
   }
 
+#if FEATURE_PLUGIN_TASKDATA_ARENA
+
+  // Allocate in the arena of the task being initialized, see PluginTaskDataArenaScope
+  static void* operator new(size_t size);
+  static void* operator new(size_t size, const std::nothrow_t&) noexcept;
+  static void  operator delete(void *ptr) noexcept;
+  static void  operator delete(void *ptr, const std::nothrow_t&) noexcept;
+#endif // if FEATURE_PLUGIN_TASKDATA_ARENA
+
   bool baseClassOnly() const {
     return _baseClassOnly;
   }
@@ -118,13 +129,29 @@ struct PluginTaskData_base {
   }
 
 # if FEATURE_CHART_JS
-  void plot_ChartJS() const
+  void plot_ChartJS(taskIndex_t taskIndex) const
   {
     if (_plugin_stats_array != nullptr) {
-      _plugin_stats_array->plot_ChartJS();
+      _plugin_stats_array->plot_ChartJS(taskIndex);
     }
   }
 
+#  if FEATURE_PLUGIN_STATS_HISTORY
+  void plot_ChartJS_history(taskIndex_t taskIndex) const
+  {
+    if (_plugin_stats_array != nullptr) {
+      _plugin_stats_array->plot_ChartJS_history(taskIndex);
+    }
+  }
+
+#  endif // if FEATURE_PLUGIN_STATS_HISTORY
+
+  void send_ChartJS_binary(bool history) const
+  {
+    if (_plugin_stats_array != nullptr) {
+      _plugin_stats_array->send_ChartJS_binary(history);
+    }
+  }
 # endif // if FEATURE_CHART_JS
 #endif  // if FEATURE_PLUGIN_STATS
 
@@ -162,4 +189,25 @@ protected:
   bool _baseClassOnly = false;
 };
 
+#if FEATURE_PLUGIN_TASKDATA_ARENA
+
+// While in scope, PluginTaskData_base objects are allocated in a memory block kept per task.
+// The block is kept when the object is deleted, so a re-init of the task reuses the same memory.
+// Its size is set by the first allocation, which is sizeof() the plugin data struct.
+class PluginTaskDataArenaScope {
+public:
+
+  explicit PluginTaskDataArenaScope(taskIndex_t taskIndex);
+  ~PluginTaskDataArenaScope();
+
+private:
+
+  taskIndex_t _previous;
+};
+
+// Release the memory block of a task, when not in use
+void freePluginTaskDataArena(taskIndex_t taskIndex);
+
+#endif // if FEATURE_PLUGIN_TASKDATA_ARENA
+
 #endif // ifndef DATASTRUCTS_PLUGINTASKDATA_BASE_H
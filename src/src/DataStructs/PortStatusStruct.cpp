@@ -20,3 +20,138 @@ int16_t portStatusStruct::getValue() const
     return dutyCycle;
   return state;
 }
+
+
+MapPortStatus::iterator::iterator(MapPortStatus        *portStatus,
+                                  uint16_t              gpio,
+                                  OverflowMap::iterator it)
+  : _portStatus(portStatus), _gpio(gpio), _it(it) {}
+
+MapPortStatus::value_type& MapPortStatus::iterator::operator*() const
+{
+  if (_gpio < _portStatus->_gpio.size()) {
+    return _portStatus->_gpio[_gpio];
+  }
+  return *_it;
+}
+
+MapPortStatus::value_type * MapPortStatus::iterator::operator->() const
+{
+  return &(operator*());
+}
+
+MapPortStatus::iterator& MapPortStatus::iterator::operator++()
+{
+  if (_gpio < _portStatus->_gpio.size()) {
+    _gpio = _portStatus->nextUsedGPIO(_gpio + 1);
+  } else {
+    ++_it;
+  }
+  return *this;
+}
+
+bool MapPortStatus::iterator::operator==(const iterator& other) const
+{
+  return _gpio == other._gpio && _it == other._it;
+}
+
+MapPortStatus::iterator MapPortStatus::begin()
+{
+  return iterator(this, nextUsedGPIO(0), _overflow.begin());
+}
+
+MapPortStatus::iterator MapPortStatus::end()
+{
+  return iterator(this, _gpio.size(), _overflow.end());
+}
+
+MapPortStatus::iterator MapPortStatus::find(uint32_t key)
+{
+  const int index = gpioIndex(key);
+
+  if (index < 0) {
+    return iterator(this, _gpio.size(), _overflow.find(key));
+  }
+
+  if (gpioUsed(index)) {
+    return iterator(this, index, _overflow.begin());
+  }
+  return end();
+}
+
+portStatusStruct& MapPortStatus::operator[](uint32_t key)
+{
+  const int index = gpioIndex(key);
+
+  if (index < 0) {
+    return _overflow[key];
+  }
+
+  if (_gpio.empty()) {
+    _gpio.reserve(MAX_GPIO + 1);
+
+    for (uint32_t i = 0; i <= MAX_GPIO; ++i) {
+      _gpio.emplace_back(key - index + i, portStatusStruct());
+    }
+  }
+  bitSet(_gpioUsed[index / 32], index % 32);
+  return _gpio[index].second;
+}
+
+size_t MapPortStatus::erase(uint32_t key)
+{
+  const int index = gpioIndex(key);
+
+  if (index < 0) {
+    return _overflow.erase(key);
+  }
+
+  if (!gpioUsed(index)) {
+    return 0;
+  }
+  bitClear(_gpioUsed[index / 32], index % 32);
+  _gpio[index].second = portStatusStruct();
+  return 1;
+}
+
+size_t MapPortStatus::size() const
+{
+  size_t res = _overflow.size();
+
+  for (size_t i = 0; i < _gpio.size(); ++i) {
+    if (gpioUsed(i)) { ++res; }
+  }
+  return res;
+}
+
+bool MapPortStatus::empty() const
+{
+  for (size_t i = 0; i < (sizeof(_gpioUsed) / sizeof(_gpioUsed[0])); ++i) {
+    if (_gpioUsed[i] != 0) { return false; }
+  }
+  return _overflow.empty();
+}
+
+int MapPortStatus::gpioIndex(uint32_t key)
+{
+  // See createKey()
+  const uint16_t port = key & 0xFFFF;
+
+  if (((key >> 16) != PLUGIN_GPIO_INT) || (port > MAX_GPIO)) {
+    return -1;
+  }
+  return port;
+}
+
+bool MapPortStatus::gpioUsed(uint16_t index) const
+{
+  return index < _gpio.size() && bitRead(_gpioUsed[index / 32], index % 32);
+}
+
+uint16_t MapPortStatus::nextUsedGPIO(uint16_t index) const
+{
+  while (index < _gpio.size() && !gpioUsed(index)) {
+    ++index;
+  }
+  return index;
+}
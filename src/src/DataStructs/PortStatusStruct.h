@@ -3,8 +3,10 @@
 
 #include "../../ESPEasy_common.h"
 
+#include "../CustomBuild/ESPEasyLimits.h"
 #include "../Globals/Plugins.h"
 #include <map>
+#include <vector>
 
 struct portStatusStruct {
   portStatusStruct();
@@ -33,7 +35,73 @@ struct portStatusStruct {
   deviceIndex_t x; // used to synchronize the Plugin_prt vector index (x) with the PLUGIN_ID
 };
 
-typedef std::map<uint32_t, portStatusStruct> MapPortStatus;
+/*********************************************************************************************\
+* MapPortStatus
+* Status of all ports in use, with the same interface as the std::map it used to be.
+* Ports of the internal GPIO plugin are kept in a flat array indexed by pin nr.
+* All other ports (e.g. of MCP/PCF/PCA extenders) are kept in an overflow map.
+* Iteration is in order of key, like the std::map.
+* References to a port status remain valid until the port is erased.
+\*********************************************************************************************/
+class MapPortStatus {
+public:
+
+  typedef std::map<uint32_t, portStatusStruct> OverflowMap;
+  typedef OverflowMap::value_type              value_type;
+
+  class iterator {
+public:
+
+    value_type& operator*() const;
+    value_type* operator->() const;
+
+    iterator  & operator++();
+
+    bool        operator==(const iterator& other) const;
+    bool        operator!=(const iterator& other) const {
+      return !(*this == other);
+    }
+
+private:
+
+    friend class MapPortStatus;
+
+    iterator(MapPortStatus        *portStatus,
+             uint16_t              gpio,
+             OverflowMap::iterator it);
+
+    MapPortStatus        *_portStatus;
+    uint16_t              _gpio; // Index in _gpio, _gpio.size() when iterating the overflow map
+    OverflowMap::iterator _it;
+  };
+
+  iterator          begin();
+  iterator          end();
+  iterator          find(uint32_t key);
+
+  // Return the port status, add a default one when not present.
+  portStatusStruct& operator[](uint32_t key);
+
+  size_t            erase(uint32_t key);
+
+  size_t            size() const;
+
+  bool              empty() const;
+
+private:
+
+  // Return the index in _gpio or -1 when the key is not of an internal GPIO pin.
+  static int        gpioIndex(uint32_t key);
+
+  bool              gpioUsed(uint16_t index) const;
+
+  uint16_t          nextUsedGPIO(uint16_t index) const;
+
+  // Allocated on the first use of an internal GPIO pin.
+  std::vector<value_type> _gpio;
+  uint32_t                _gpioUsed[(MAX_GPIO + 32) / 32] = { 0 };
+  OverflowMap             _overflow;
+};
 
 // giig1967g: TODO: remove std::map []operator and use at(), insert(), find()
 // https://devblogs.microsoft.com/oldnewthing/20190227-00/?p=101072
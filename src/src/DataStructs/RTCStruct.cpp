@@ -12,9 +12,9 @@
     flashCounter = 0;
     bootCounter = 0;
     lastMixedSchedulerId = 0;
-    unused1 = 0;
-    unused2 = 0;
+    lastWiFiLeaseChecksum = 0;
     lastSysTime = 0;
+    lastPluginCall = RTC_PluginCall_t();
   }
 
   void RTCStruct::clearLastWiFi() {
@@ -23,6 +23,7 @@
     }
     lastWiFiChannel = 0;
     lastWiFiSettingsIndex = 0;
+    lastWiFiLeasePrefix = 0;
   }
 
   bool RTCStruct::lastWiFi_set() const {
@@ -7,6 +7,12 @@
 #define RTC_BASE_STRUCT   64
 #define RTC_BASE_USERVAR  74
 #define RTC_BASE_CACHE   124
+#define RTC_BASE_WIFI_LEASE 188 // ESP8266: RTC_BASE_CACHE + 4 + (RTC_CACHE_DATA_SIZE / 4)
+
+// RTCStruct::deepSleepState
+#define RTC_DEEPSLEEP_STATE_SLEEPING     0x01 // Set when entering deep sleep
+#define RTC_DEEPSLEEP_STATE_CYCLES_MASK  0x7E // Deep sleep batch mode: Nr. of wake cycles since the samples were sent
+#define RTC_DEEPSLEEP_STATE_SEND_NEXT    0x80 // Deep sleep batch mode: Send the samples in the next wake cycle
 
 #ifdef ESP8266
 # define RTC_CACHE_DATA_SIZE 240 // 10 elements, limited by RTC memory
@@ -33,6 +39,34 @@
 # endif // ifdef USE_LITTLEFS
 #endif  // ifdef ESP32
 
+/*********************************************************************************************\
+* RTC_PluginCall_t
+* Last and deepest (stack wise) plugin call, kept in RTC to see what ran before a crash.
+\*********************************************************************************************/
+struct RTC_PluginCall_t
+{
+  uint8_t  taskIndex         = 0xFF; // Task of the last plugin call, 0xFF when not set
+  uint8_t  function          = 0;
+  uint8_t  active            = 0;    // Set while the plugin call is in progress
+  uint8_t  lowStackTaskIndex = 0xFF; // Task of the plugin call with the lowest free stack
+  uint8_t  lowStackFunction  = 0;
+  uint8_t  unused            = 0;    // Force alignment to 4 bytes
+  uint16_t lowStack          = 0xFFFF;
+};
+
+/*********************************************************************************************\
+* RTC_WiFiLease_t
+* IP config of the last DHCP lease, to connect without waiting for DHCP after a reboot.
+* Subnet prefix length and checksum are kept in RTCStruct, as this fills the last 4 RTC blocks.
+\*********************************************************************************************/
+struct RTC_WiFiLease_t
+{
+  uint32_t ip      = 0;
+  uint32_t gateway = 0;
+  uint32_t dns     = 0;
+  uint32_t expiry  = 0; // Unix time after which the lease should no longer be used
+};
+
 /*********************************************************************************************\
 * RTCStruct
 \*********************************************************************************************/
@@ -65,9 +99,10 @@ struct RTCStruct
   unsigned long bootCounter           = 0;
   unsigned long lastMixedSchedulerId  = 0;
   uint8_t       lastBSSID[6]          = { 0 };
-  uint8_t       unused1               = 0; // Force alignment to 4 bytes
-  uint8_t       unused2               = 0;
+  uint8_t       lastWiFiLeasePrefix   = 0; // Subnet prefix length of RTC_WiFiLease_t, 0 = not set
+  uint8_t       lastWiFiLeaseChecksum = 0; // CRC8 of RTC_WiFiLease_t
   unsigned long lastSysTime           = 0;
+  RTC_PluginCall_t lastPluginCall;
 };
 
 
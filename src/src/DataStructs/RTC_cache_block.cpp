@@ -0,0 +1,269 @@
+#include "../DataStructs/RTC_cache_block.h"
+
+#if FEATURE_RTC_CACHE_COMPRESSION
+
+# include "../Helpers/CRC_functions.h"
+
+static_assert(sizeof(RTC_cache_block_header) == RTC_CACHE_BLOCK_HEADER_SIZE, "RTC_cache_block_header size changed");
+static_assert(VARS_PER_TASK == 4, "Value codes of RTC_cache_block_codec assume 4 task values");
+
+# define RTC_CACHE_BLOCK_META_FLAG  0x80
+
+bool RTC_cache_block_isBlock(const uint8_t *data, size_t size) {
+  if (size < RTC_CACHE_BLOCK_HEADER_SIZE) {
+    return false;
+  }
+  uint32_t magic = 0;
+
+  memcpy(&magic, data, sizeof(magic));
+  return magic == RTC_CACHE_BLOCK_MAGIC;
+}
+
+void RTC_cache_block_codec::reset() {
+  if (_tasks.size() != TASKS_MAX) {
+    _tasks.resize(TASKS_MAX);
+  }
+
+  for (auto it = _tasks.begin(); it != _tasks.end(); ++it) {
+    *it = TaskState();
+  }
+  _prevTime = 0;
+}
+
+size_t RTC_cache_block_codec::encode(const C016_binary_element& element, uint8_t *out) {
+  if (!validTaskIndex(element.TaskIndex) || (_tasks.size() != TASKS_MAX) || (element.valueCount > VARS_PER_TASK)) {
+    return 0;
+  }
+  TaskState& state = _tasks[element.TaskIndex];
+  size_t     pos   = 0;
+
+  // Zigzag encoded time difference as varint
+  const int32_t diff = static_cast<int32_t>(element.unixTime - _prevTime);
+  uint32_t zigzag    = (static_cast<uint32_t>(diff) << 1) ^ static_cast<uint32_t>(diff >> 31);
+
+  while (zigzag >= 0x80) {
+    out[pos++] = (zigzag & 0x7F) | 0x80;
+    zigzag   >>= 7;
+  }
+  out[pos++] = zigzag;
+
+  const bool meta = !state.seen ||
+                    (state.pluginID != element.pluginID) ||
+                    (state.sensorType != element.sensorType) ||
+                    (state.valueCount != element.valueCount);
+
+  out[pos++] = element.TaskIndex | (meta ? RTC_CACHE_BLOCK_META_FLAG : 0);
+
+  if (meta) {
+    out[pos++] = element.pluginID.value;
+    out[pos++] = static_cast<uint8_t>(element.sensorType);
+    out[pos++] = element.valueCount;
+  }
+
+  // Reserve room for the value codes
+  const size_t codePos = pos;
+  uint16_t     codes   = 0;
+
+  pos += 2;
+
+  for (uint8_t i = 0; i < VARS_PER_TASK; ++i) {
+    uint32_t xorValue = element.values.uint32s[i] ^ state.values.uint32s[i];
+
+    if (xorValue == 0) {
+      continue;
+    }
+    uint8_t trailing = 0;
+
+    while ((xorValue & 0xFF) == 0) {
+      xorValue >>= 8;
+      ++trailing;
+    }
+    uint8_t nrBytes = 1;
+
+    while ((nrBytes + trailing) < 4 && (xorValue >> (8 * nrBytes)) != 0) {
+      ++nrBytes;
+    }
+
+    for (uint8_t b = 0; b < nrBytes; ++b) {
+      out[pos++] = (xorValue >> (8 * b)) & 0xFF;
+    }
+    const uint8_t code = (nrBytes == 4) ? 1 : ((nrBytes << 2) | trailing);
+    codes |= static_cast<uint16_t>(code) << (4 * i);
+  }
+  out[codePos]     = codes & 0xFF;
+  out[codePos + 1] = codes >> 8;
+
+  state.values     = element.values;
+  state.pluginID   = element.pluginID;
+  state.sensorType = element.sensorType;
+  state.valueCount = element.valueCount;
+  state.seen       = true;
+  _prevTime        = element.unixTime;
+  return pos;
+}
+
+size_t RTC_cache_block_codec::decode(const uint8_t *data, size_t size, C016_binary_element& element) {
+  if (_tasks.size() != TASKS_MAX) {
+    return 0;
+  }
+  size_t   pos    = 0;
+  uint32_t zigzag = 0;
+
+  for (uint8_t shift = 0;; shift += 7) {
+    if ((pos >= size) || (shift > 28)) {
+      return 0;
+    }
+    const uint8_t b = data[pos++];
+    zigzag |= static_cast<uint32_t>(b & 0x7F) << shift;
+
+    if ((b & 0x80) == 0) {
+      break;
+    }
+  }
+  const int32_t diff = static_cast<int32_t>((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+
+  if (pos >= size) {
+    return 0;
+  }
+  const uint8_t     taskByte  = data[pos++];
+  const taskIndex_t taskIndex = taskByte & ~RTC_CACHE_BLOCK_META_FLAG;
+
+  if (!validTaskIndex(taskIndex)) {
+    return 0;
+  }
+  TaskState& state = _tasks[taskIndex];
+
+  if (taskByte & RTC_CACHE_BLOCK_META_FLAG) {
+    if ((pos + 3) > size) {
+      return 0;
+    }
+    state.pluginID   = pluginID_t::toPluginID(data[pos]);
+    state.sensorType = static_cast<Sensor_VType>(data[pos + 1]);
+    state.valueCount = data[pos + 2];
+    state.seen       = true;
+    pos             += 3;
+  } else if (!state.seen) {
+    return 0;
+  }
+
+  if ((pos + 2) > size) {
+    return 0;
+  }
+  const uint16_t codes = data[pos] | (static_cast<uint16_t>(data[pos + 1]) << 8);
+
+  pos += 2;
+
+  for (uint8_t i = 0; i < VARS_PER_TASK; ++i) {
+    const uint8_t code = (codes >> (4 * i)) & 0x0F;
+    uint8_t nrBytes    = code >> 2;
+    uint8_t trailing   = code & 0x03;
+
+    if (nrBytes == 0) {
+      if (trailing == 0) {
+        continue;
+      }
+
+      if (trailing != 1) {
+        return 0;
+      }
+      nrBytes  = 4;
+      trailing = 0;
+    }
+
+    if ((pos + nrBytes) > size) {
+      return 0;
+    }
+    uint32_t xorValue = 0;
+
+    for (uint8_t b = 0; b < nrBytes; ++b) {
+      xorValue |= static_cast<uint32_t>(data[pos++]) << (8 * b);
+    }
+    state.values.uint32s[i] ^= xorValue << (8 * trailing);
+  }
+
+  _prevTime += diff;
+
+  element.values     = state.values;
+  element.unixTime   = _prevTime;
+  element.TaskIndex  = taskIndex;
+  element.pluginID   = state.pluginID;
+  element.sensorType = state.sensorType;
+  element.valueCount = state.valueCount;
+  return pos;
+}
+
+bool RTC_cache_block_reader::load(fs::File& file) {
+  clear();
+  _blockStart = file.position();
+
+  if ((file.read(reinterpret_cast<uint8_t *>(&_header), sizeof(_header)) != sizeof(_header)) ||
+      (_header.magic != RTC_CACHE_BLOCK_MAGIC) ||
+      (_header.blockSize < RTC_CACHE_BLOCK_HEADER_SIZE) ||
+      ((_blockStart + _header.blockSize) > file.size())) {
+    _header = RTC_cache_block_header();
+    return false;
+  }
+  _data.resize(_header.blockSize - RTC_CACHE_BLOCK_HEADER_SIZE);
+
+  if ((file.read(_data.data(), _data.size()) != _data.size()) ||
+      (calc_CRC32(_data.data(), _data.size()) != _header.checksum)) {
+    clear();
+    return false;
+  }
+  _codec.reset();
+  return true;
+}
+
+void RTC_cache_block_reader::clear() {
+  _data.clear();
+  _header      = RTC_cache_block_header();
+  _readPos     = 0;
+  _sampleIndex = 0;
+}
+
+bool RTC_cache_block_reader::next(C016_binary_element& element) {
+  if (!active()) {
+    return false;
+  }
+  const size_t bytesRead = _codec.decode(_data.data() + _readPos, _data.size() - _readPos, element);
+
+  if (bytesRead == 0) {
+    // Corrupt data, skip the rest of the block.
+    _sampleIndex = _header.nrSamples;
+    return false;
+  }
+  _readPos += bytesRead;
+  ++_sampleIndex;
+  return true;
+}
+
+bool RTC_cache_block_reader::seek(size_t filePos) {
+  if (_data.empty() || (filePos < _blockStart) || (filePos >= getBlockEnd())) {
+    return false;
+  }
+  size_t skip = filePos - _blockStart;
+
+  if (skip < _sampleIndex) {
+    // Start decoding from the beginning of the block
+    _codec.reset();
+    _readPos     = 0;
+    _sampleIndex = 0;
+  } else {
+    skip -= _sampleIndex;
+  }
+  C016_binary_element element;
+
+  while (skip > 0 && next(element)) {
+    --skip;
+  }
+  return true;
+}
+
+size_t RTC_cache_block_reader::getPosition() const {
+  if (!active()) {
+    return getBlockEnd();
+  }
+  return _blockStart + _sampleIndex;
+}
+
+#endif // if FEATURE_RTC_CACHE_COMPRESSION
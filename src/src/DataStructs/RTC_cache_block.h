@@ -0,0 +1,127 @@
+#ifndef DATASTRUCTS_RTC_CACHE_BLOCK_H
+#define DATASTRUCTS_RTC_CACHE_BLOCK_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_RTC_CACHE_COMPRESSION
+
+# include "../ControllerQueue/C016_queue_element.h"
+
+# include <FS.h>
+# include <vector>
+
+// First 4 bytes of a compressed block.
+// As float this is a signalling NaN, which is never stored as first task value of a raw sample.
+// So raw samples and compressed blocks can be mixed in a cache file.
+# define RTC_CACHE_BLOCK_MAGIC        0x7F805A43
+
+# define RTC_CACHE_BLOCK_HEADER_SIZE  12
+
+// Max. size of a single encoded sample
+# define RTC_CACHE_BLOCK_MAX_SAMPLE_SIZE (5 + 1 + 3 + 2 + sizeof(TaskValues_Data_t))
+
+// Do NOT change order of members, it is stored.
+struct RTC_cache_block_header {
+  uint32_t magic     = RTC_CACHE_BLOCK_MAGIC;
+  uint16_t blockSize = 0; // Including this header
+  uint16_t nrSamples = 0;
+  uint32_t checksum  = 0; // CRC32 of the encoded samples
+};
+
+// Return true when the data starts with a block header.
+bool RTC_cache_block_isBlock(const uint8_t *data,
+                             size_t         size);
+
+
+/*********************************************************************************************\
+* RTC_cache_block_codec
+* Compressed format of C016_binary_element samples, stored in blocks.
+* Each sample is encoded relative to the previous samples in the same block:
+* - Timestamp: difference with the previous sample as zigzag varint (first sample: unix time)
+* - Task index, bit 7 set when the meta data follows
+* - Meta data: plugin ID, sensor type and value count.
+*   Only present for the first sample of a task in the block, or when changed.
+* - Per task value, a nibble describing the XOR with the previous value of the same task (2 bytes for 4 values)
+*   bits 0-1: Nr of trailing zero bytes of the XOR, not stored
+*   bits 2-3: Nr of stored bytes. With 0 trailing zero bytes: unchanged value, with 1: all 4 bytes stored
+* - Stored bytes of the XOR per task value
+\*********************************************************************************************/
+class RTC_cache_block_codec {
+public:
+
+  // Start of a new block
+  void   reset();
+
+  // Return nr of bytes written to out, 0 when the element cannot be encoded.
+  // @param out Must be at least RTC_CACHE_BLOCK_MAX_SAMPLE_SIZE bytes
+  size_t encode(const C016_binary_element& element,
+                uint8_t                   *out);
+
+  // Return nr of bytes read from data, 0 when no valid sample could be decoded.
+  size_t decode(const uint8_t       *data,
+                size_t               size,
+                C016_binary_element& element);
+
+private:
+
+  struct TaskState {
+    TaskValues_Data_t values{};
+    pluginID_t        pluginID{ INVALID_PLUGIN_ID };
+    Sensor_VType      sensorType{ Sensor_VType::SENSOR_TYPE_NONE };
+    uint8_t           valueCount{};
+    bool              seen{};
+  };
+
+  std::vector<TaskState> _tasks;
+  unsigned long          _prevTime = 0;
+};
+
+
+/*********************************************************************************************\
+* RTC_cache_block_reader
+* Decode the samples of a block read from a cache file.
+* To allow storing the read position, the file position of the n-th sample in a block
+* is represented as block start + n, which is always before the next block.
+\*********************************************************************************************/
+class RTC_cache_block_reader {
+public:
+
+  // Read the block starting at the current position of the file.
+  // On success the file position is at the end of the block.
+  bool   load(fs::File& file);
+
+  void   clear();
+
+  bool   active() const {
+    return !_data.empty() && (_sampleIndex < _header.nrSamples);
+  }
+
+  bool   next(C016_binary_element& element);
+
+  // Continue from the sample at the given position, must be within this block.
+  bool   seek(size_t filePos);
+
+  // File position of the next sample to read
+  size_t getPosition() const;
+
+  size_t getBlockStart() const {
+    return _blockStart;
+  }
+
+  size_t getBlockEnd() const {
+    return _blockStart + _header.blockSize;
+  }
+
+private:
+
+  std::vector<uint8_t>   _data;
+  RTC_cache_block_header _header;
+  RTC_cache_block_codec  _codec;
+  size_t                 _blockStart  = 0;
+  size_t                 _readPos     = 0;
+  uint16_t               _sampleIndex = 0;
+};
+
+#endif // if FEATURE_RTC_CACHE_COMPRESSION
+
+#endif // ifndef DATASTRUCTS_RTC_CACHE_BLOCK_H
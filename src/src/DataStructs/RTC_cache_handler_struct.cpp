@@ -6,11 +6,16 @@
 #include "../DataStructs/RTCStruct.h"
 #include "../Helpers/CRC_functions.h"
 #include "../Helpers/ESPEasy_Storage.h"
+#include "../Helpers/ESPEasy_time_calc.h"
 #include "../Helpers/StringConverter.h"
 
 #include "../ESPEasyCore/ESPEasy_backgroundtasks.h"
 #include "../ESPEasyCore/ESPEasy_Log.h"
 
+#if FEATURE_RTC_CACHE_INDEX
+# include "../ControllerQueue/C016_queue_element.h"
+#endif // if FEATURE_RTC_CACHE_INDEX
+
 #ifdef ESP8266
 # include <user_interface.h>
 #endif // ifdef ESP8266
@@ -46,6 +51,9 @@ bool RTC_cache_handler_struct::init() {
     rtc_debug_log(F("Read from RTC cache"), RTC_cache.writePos);
       #endif // ifdef RTC_STRUCT_DEBUG
   }
+#if FEATURE_RTC_CACHE_COMPRESSION
+  restoreEncoder();
+#endif // if FEATURE_RTC_CACHE_COMPRESSION
   updateRTC_filenameCounters();
   return success;
 }
@@ -63,9 +71,16 @@ void RTC_cache_handler_struct::resetpeek() {
   }
   _peekfilenr  = 0;
   _peekreadpos = 0;
+#if FEATURE_RTC_CACHE_COMPRESSION
+  _peekBlock.clear();
+#endif // if FEATURE_RTC_CACHE_COMPRESSION
 }
 
 bool RTC_cache_handler_struct::peekDataAvailable() const {
+#if FEATURE_RTC_CACHE_COMPRESSION
+
+  if (_peekBlock.active()) { return true; }
+#endif // if FEATURE_RTC_CACHE_COMPRESSION
   if (fp) {
     if ((_peekreadpos + 1) < fp.size()) { return true; }
   }
@@ -86,6 +101,12 @@ int RTC_cache_handler_struct::getPeekFilePos(int& peekFileNr) {
   peekFileNr = _peekfilenr;
   if (fp) {
     _peekreadpos = fp.position();
+#if FEATURE_RTC_CACHE_COMPRESSION
+
+    if (_peekBlock.active()) {
+      _peekreadpos = _peekBlock.getPosition();
+    }
+#endif // if FEATURE_RTC_CACHE_COMPRESSION
   }
   return _peekreadpos;
 }
@@ -99,6 +120,16 @@ int RTC_cache_handler_struct::getPeekFileSize(int peekFileNr) const {
 
 void RTC_cache_handler_struct::setPeekFilePos(int newPeekFileNr, int newPeekReadPos) {
   validateFilePos(newPeekFileNr, newPeekReadPos);
+#if FEATURE_RTC_CACHE_COMPRESSION
+
+  // Position within the current block, no need to read the file again.
+  if (fp && (static_cast<int>(_peekfilenr) == newPeekFileNr) && (newPeekReadPos >= 0) &&
+      _peekBlock.seek(newPeekReadPos)) {
+    _peekreadpos = _peekBlock.getPosition();
+    return;
+  }
+  _peekBlock.clear();
+#endif // if FEATURE_RTC_CACHE_COMPRESSION
 
   if (fp) {
     if (newPeekReadPos < static_cast<int>(fp.position())) {
@@ -139,9 +170,16 @@ void RTC_cache_handler_struct::setPeekFilePos(int newPeekFileNr, int newPeekRead
         return;
       }
 
+#if FEATURE_RTC_CACHE_COMPRESSION
+
+      // The position may be within a compressed block, or not at the start of a raw sample.
+      seekPeekSample(newPeekReadPos);
+#else // if FEATURE_RTC_CACHE_COMPRESSION
+
       if (fp.seek(newPeekReadPos)) {
         _peekreadpos = newPeekReadPos;
       }
+#endif // if FEATURE_RTC_CACHE_COMPRESSION
     } else {
       _peekreadpos = 0;
     }
@@ -168,9 +206,13 @@ bool RTC_cache_handler_struct::peek(uint8_t *data, unsigned int size) {
 
   if (!fp) { return false; }
 
-  const size_t bytesRead = fp.read(data, size);
+#if FEATURE_RTC_CACHE_COMPRESSION
+  const bool success = peekSample(data, size);
+#else // if FEATURE_RTC_CACHE_COMPRESSION
+  const bool success = fp.read(data, size) == size;
 
   _peekreadpos = fp.position();
+#endif // if FEATURE_RTC_CACHE_COMPRESSION
 
   if (_peekreadpos >= fp.size()) {
     if (_peekfilenr < RTC_cache.writeFileNr) {
@@ -180,7 +222,7 @@ bool RTC_cache_handler_struct::peek(uint8_t *data, unsigned int size) {
     }
   }
 
-  return bytesRead == size;
+  return success;
 }
 
 // Write a single sample set to the buffer
@@ -189,6 +231,23 @@ bool RTC_cache_handler_struct::write(const uint8_t *data, unsigned int size) {
   rtc_debug_log(F("write RTC cache data"), size);
     #endif // ifdef RTC_STRUCT_DEBUG
 
+#if FEATURE_RTC_CACHE_COMPRESSION
+
+  if (_compress && (size == sizeof(C016_binary_element))) {
+    C016_binary_element element;
+
+    memcpy(&element, data, size);
+    return writeCompressed(element);
+  }
+
+  if (isBlockInRTC()) {
+    // Block stored while compression was enabled, raw samples cannot be appended to it.
+    if (!flush()) {
+      return false;
+    }
+  }
+#endif // if FEATURE_RTC_CACHE_COMPRESSION
+
   if (getFreeSpace() < size) {
     if (!flush()) {
       return false;
@@ -200,7 +259,10 @@ bool RTC_cache_handler_struct::write(const uint8_t *data, unsigned int size) {
     RTC_cache_data[RTC_cache.writePos] = data[i];
     ++RTC_cache.writePos;
   }
+  return saveRTCcache_lastWritten(size);
+}
 
+bool RTC_cache_handler_struct::saveRTCcache_lastWritten(unsigned int size) {
   // Now store the updated part of the buffer to the RTC memory.
   // Pad some extra bytes around it to allow sample sizes not multiple of 4 bytes.
   int startOffset = RTC_cache.writePos - size;
@@ -239,6 +301,17 @@ bool RTC_cache_handler_struct::flush() {
       if (fp) {
         fp.close();
       }
+#if FEATURE_RTC_CACHE_COMPRESSION
+
+      if (isBlockInRTC()) {
+        finalizeBlockInRTC();
+      }
+#endif // if FEATURE_RTC_CACHE_COMPRESSION
+#if FEATURE_RTC_CACHE_INDEX
+      const uint32_t filePos = fw.size();
+      uint32_t firstTime     = 0;
+      const bool hasTime     = getFirstSampleTimeInRTC(firstTime);
+#endif // if FEATURE_RTC_CACHE_INDEX
 
       int bytesWritten = fw.write(&RTC_cache_data[0], RTC_cache.writePos);
 
@@ -264,15 +337,27 @@ bool RTC_cache_handler_struct::flush() {
           #endif // ifdef RTC_STRUCT_DEBUG
         fw.close();
 
-        if (!GarbageCollection()) {
-          // Garbage collection was not able to remove anything
+        if (_gcStepsLeft != 0) {
+          // Background maintenance did not manage to free enough space since the last failed write.
+          // Remove the oldest file on the next attempt.
           writeError = true;
         }
+        _gcStepsLeft = CACHE_MAINTENANCE_GC_STEPS;
         return false;
       }
+#if FEATURE_RTC_CACHE_INDEX
+
+      if (hasTime) {
+        addIndexEntry(filePos, firstTime);
+      }
+#endif // if FEATURE_RTC_CACHE_INDEX
       initRTCcache_data();
       clearRTCcacheData();
       saveRTCcache();
+#if FEATURE_RTC_CACHE_COMPRESSION
+      _encoder.reset();
+      _encodedSamples = 0;
+#endif // if FEATURE_RTC_CACHE_COMPRESSION
       return true;
     }
   }
@@ -355,6 +440,9 @@ bool RTC_cache_handler_struct::deleteAllCacheBlocks()
       for (int fileNr = RTC_cache.readFileNr; count < 25 && fileNr < RTC_cache.writeFileNr; ++fileNr)
       {
         String fname = createCacheFilename(fileNr);
+#if FEATURE_RTC_CACHE_INDEX
+        tryDeleteFile(createCacheIndexFilename(fileNr));
+#endif // if FEATURE_RTC_CACHE_INDEX
 
         if (tryDeleteFile(fname)) {
           ++count;
@@ -397,6 +485,9 @@ bool RTC_cache_handler_struct::deleteCacheBlock(int fileNr)
       if (fp) {
         fp.close();
       }
+#if FEATURE_RTC_CACHE_INDEX
+      tryDeleteFile(createCacheIndexFilename(RTC_cache.readFileNr));
+#endif // if FEATURE_RTC_CACHE_INDEX
 
       if (tryDeleteFile(fname)) {
         fileDeleted = true;
@@ -571,7 +662,7 @@ bool RTC_cache_handler_struct::prepareFileForWrite() {
 
     if (fw && (fw.size() >= CACHE_FILE_MAX_SIZE)) {
       fw.close();
-      GarbageCollection();
+      _gcStepsLeft = CACHE_MAINTENANCE_GC_STEPS;
     }
 
     if (!fw) {
@@ -579,8 +670,8 @@ bool RTC_cache_handler_struct::prepareFileForWrite() {
       initRTCcache_data();
 
       if (updateRTC_filenameCounters()) {
-        if (writeError || (SpiffsFreeSpace() < ((2 * CACHE_FILE_MAX_SIZE) + SpiffsBlocksize()))) {
-          // Not enough room for another file, remove the oldest one.
+        if (writeError || (SpiffsFreeSpace() < getRequiredFreeSpace(false))) {
+          // Not enough room for another file and the background maintenance did not keep up, remove the oldest one.
           deleteOldestCacheBlock();
         }
       }
@@ -616,6 +707,39 @@ bool RTC_cache_handler_struct::prepareFileForWrite() {
   return false;
 }
 
+size_t RTC_cache_handler_struct::getRequiredFreeSpace(bool keepSpare) const {
+  return (keepSpare ? (2 * CACHE_FILE_MAX_SIZE) : CACHE_FILE_MAX_SIZE) + SpiffsBlocksize();
+}
+
+bool RTC_cache_handler_struct::backgroundMaintenance() {
+  if (timePassedSince(_lastMaintenance) < CACHE_MAINTENANCE_INTERVAL) {
+    return false;
+  }
+  _lastMaintenance = millis();
+
+  if (_gcStepsLeft != 0) {
+    // A single garbage collection call erases at most one FS block.
+    // Continue in the next call, until there is nothing left to collect.
+    --_gcStepsLeft;
+
+    if (!GarbageCollection()) {
+      _gcStepsLeft = 0;
+    }
+    return true;
+  }
+
+  if ((RTC_cache.readFileNr < RTC_cache.writeFileNr) &&
+      (SpiffsFreeSpace() < getRequiredFreeSpace(true))) {
+    // Keep room for the current and the next cache file,
+    // so flush() does not need to delete a file when it has to start a new one.
+    if (deleteOldestCacheBlock()) {
+      _gcStepsLeft = CACHE_MAINTENANCE_GC_STEPS;
+      return true;
+    }
+  }
+  return false;
+}
+
 void RTC_cache_handler_struct::validateFilePos(int& fileNr, int& readPos) {
   {
     // Check to see if we try to set it to a no longer existing file
@@ -631,6 +755,368 @@ void RTC_cache_handler_struct::validateFilePos(int& fileNr, int& readPos) {
   }
 }
 
+#if FEATURE_RTC_CACHE_COMPRESSION
+bool RTC_cache_handler_struct::writeCompressed(const C016_binary_element& element) {
+  if ((RTC_cache.writePos != 0) && !isBlockInRTC()) {
+    // Raw samples, stored by a build without compression.
+    if (!flush()) {
+      return false;
+    }
+  }
+
+  if (RTC_cache.writePos == 0) {
+    startBlockInRTC();
+  }
+  uint8_t encoded[RTC_CACHE_BLOCK_MAX_SAMPLE_SIZE];
+  size_t  size = _encoder.encode(element, encoded);
+
+  if ((size != 0) && (getFreeSpace() < size)) {
+    if (!flush()) {
+      // Encoder state was already updated for a sample which is not stored.
+      restoreEncoder();
+      return false;
+    }
+    startBlockInRTC();
+    size = _encoder.encode(element, encoded);
+  }
+
+  if (size == 0) {
+    if (_encodedSamples == 0) {
+      // Do not keep an empty block
+      RTC_cache.writePos = 0;
+    }
+    return false;
+  }
+
+  for (size_t i = 0; i < size; ++i) {
+    RTC_cache_data[RTC_cache.writePos] = encoded[i];
+    ++RTC_cache.writePos;
+  }
+  ++_encodedSamples;
+  return saveRTCcache_lastWritten(size);
+}
+
+bool RTC_cache_handler_struct::isBlockInRTC() const {
+  return RTC_cache_block_isBlock(&RTC_cache_data[0], RTC_cache.writePos);
+}
+
+void RTC_cache_handler_struct::startBlockInRTC() {
+  const RTC_cache_block_header header;
+
+  initRTCcache_data();
+  memcpy(&RTC_cache_data[0], &header, sizeof(header));
+  RTC_cache.writePos = RTC_CACHE_BLOCK_HEADER_SIZE;
+  _encoder.reset();
+  _encodedSamples = 0;
+  saveRTCcache(0, RTC_CACHE_BLOCK_HEADER_SIZE);
+}
+
+void RTC_cache_handler_struct::finalizeBlockInRTC() {
+  RTC_cache_block_header header;
+
+  header.blockSize = RTC_cache.writePos;
+  header.nrSamples = _encodedSamples;
+  header.checksum  = calc_CRC32(&RTC_cache_data[RTC_CACHE_BLOCK_HEADER_SIZE], RTC_cache.writePos - RTC_CACHE_BLOCK_HEADER_SIZE);
+  memcpy(&RTC_cache_data[0], &header, sizeof(header));
+}
+
+void RTC_cache_handler_struct::restoreEncoder() {
+  _encoder.reset();
+  _encodedSamples = 0;
+
+  if (!isBlockInRTC()) {
+    return;
+  }
+  size_t pos = RTC_CACHE_BLOCK_HEADER_SIZE;
+  C016_binary_element element;
+
+  while (pos < RTC_cache.writePos) {
+    const size_t bytesRead = _encoder.decode(&RTC_cache_data[pos], RTC_cache.writePos - pos, element);
+
+    if (bytesRead == 0) {
+      // Drop whatever cannot be decoded
+      RTC_cache.writePos = pos;
+      saveRTCcache();
+      return;
+    }
+    pos += bytesRead;
+    ++_encodedSamples;
+  }
+}
+
+bool RTC_cache_handler_struct::peekSample(uint8_t *data, unsigned int size) {
+  while (true) {
+    if (_peekBlock.active()) {
+      C016_binary_element element;
+      const bool success = (size == sizeof(C016_binary_element)) && _peekBlock.next(element);
+
+      if (success) {
+        memcpy(data, &element, size);
+      }
+      _peekreadpos = _peekBlock.getPosition();
+      return success;
+    }
+    const size_t recordStart = fp.position();
+    RTC_cache_block_header header;
+    const size_t bytesRead = fp.read(reinterpret_cast<uint8_t *>(&header), sizeof(header));
+
+    if (!RTC_cache_block_isBlock(reinterpret_cast<const uint8_t *>(&header), bytesRead)) {
+      // Raw sample
+      fp.seek(recordStart);
+      const bool success = fp.read(data, size) == size;
+      _peekreadpos = fp.position();
+      return success;
+    }
+    fp.seek(recordStart);
+
+    if (!_peekBlock.load(fp)) {
+      // Skip the corrupt block. When its size cannot be trusted, skip the rest of the file.
+      if ((header.blockSize < RTC_CACHE_BLOCK_HEADER_SIZE) || !fp.seek(recordStart + header.blockSize)) {
+        fp.seek(0, fs::SeekEnd);
+      }
+      _peekreadpos = fp.position();
+      return false;
+    }
+
+    // An empty block is skipped
+  }
+}
+
+void RTC_cache_handler_struct::seekPeekSample(int peekReadPos) {
+  const size_t fileSize = fp.size();
+  size_t recordStart    = 0;
+
+  while (recordStart < fileSize) {
+    RTC_cache_block_header header;
+
+    if (!fp.seek(recordStart)) {
+      break;
+    }
+    const size_t bytesRead = fp.read(reinterpret_cast<uint8_t *>(&header), sizeof(header));
+    const bool   isBlock   = RTC_cache_block_isBlock(reinterpret_cast<const uint8_t *>(&header), bytesRead);
+    size_t recordEnd       = recordStart + sizeof(C016_binary_element);
+
+    if (isBlock) {
+      recordEnd = (header.blockSize < RTC_CACHE_BLOCK_HEADER_SIZE) ? fileSize : recordStart + header.blockSize;
+    }
+
+    if (static_cast<size_t>(peekReadPos) < recordEnd) {
+      fp.seek(recordStart);
+
+      if (isBlock && _peekBlock.load(fp)) {
+        _peekBlock.seek(peekReadPos);
+        _peekreadpos = _peekBlock.getPosition();
+        return;
+      }
+
+      if (isBlock) {
+        // Corrupt block, continue at the next
+        fp.seek(recordEnd);
+        recordStart = recordEnd;
+      }
+      _peekreadpos = recordStart;
+      return;
+    }
+    recordStart = recordEnd;
+  }
+  fp.seek(0, fs::SeekEnd);
+  _peekreadpos = fp.position();
+}
+
+#endif // if FEATURE_RTC_CACHE_COMPRESSION
+
+#if FEATURE_RTC_CACHE_INDEX
+bool RTC_cache_handler_struct::seekToTime(uint32_t unixTime) {
+  int fileNr  = 0;
+  int filePos = 0;
+
+  getIndexedStartPos(unixTime, fileNr, filePos);
+  setPeekFilePos(fileNr, filePos);
+
+  // Read from the indexed position up to the requested time.
+  int peekFileNr = 0;
+  int peekPos    = getPeekFilePos(peekFileNr);
+  C016_binary_element element;
+
+  while (peek(reinterpret_cast<uint8_t *>(&element), sizeof(element))) {
+    if (element.unixTime >= unixTime) {
+      setPeekFilePos(peekFileNr, peekPos);
+      return true;
+    }
+    peekPos = getPeekFilePos(peekFileNr);
+  }
+  return false;
+}
+
+void RTC_cache_handler_struct::getIndexedStartPos(uint32_t unixTime, int& fileNr, int& filePos) {
+  fileNr  = getFileNrForTime(unixTime);
+  filePos = getIndexedFilePos(fileNr, unixTime);
+}
+
+void RTC_cache_handler_struct::getIndexedEndPos(uint32_t unixTime, int& fileNr, int& filePos) {
+  fileNr  = getFileNrForTime(unixTime);
+  filePos = getIndexedFilePos(fileNr, unixTime, true);
+}
+
+int RTC_cache_handler_struct::getFileNrForTime(uint32_t unixTime) {
+  updateRTC_filenameCounters();
+
+  for (int nr = RTC_cache.writeFileNr; nr > RTC_cache.readFileNr; --nr) {
+    uint32_t firstTime = 0;
+
+    if (getFirstTimeOfFile(nr, firstTime) && (firstTime <= unixTime)) {
+      return nr;
+    }
+  }
+  return RTC_cache.readFileNr;
+}
+
+bool RTC_cache_handler_struct::getFirstSampleTimeInRTC(uint32_t& unixTime) {
+  C016_binary_element element;
+
+# if FEATURE_RTC_CACHE_COMPRESSION
+
+  if (isBlockInRTC()) {
+    RTC_cache_block_codec codec;
+
+    codec.reset();
+
+    if (codec.decode(&RTC_cache_data[RTC_CACHE_BLOCK_HEADER_SIZE], RTC_cache.writePos - RTC_CACHE_BLOCK_HEADER_SIZE, element) == 0) {
+      return false;
+    }
+    unixTime = element.unixTime;
+    return true;
+  }
+# endif // if FEATURE_RTC_CACHE_COMPRESSION
+
+  if (RTC_cache.writePos < sizeof(C016_binary_element)) {
+    return false;
+  }
+  memcpy(&element, &RTC_cache_data[0], sizeof(C016_binary_element));
+  unixTime = element.unixTime;
+  return true;
+}
+
+void RTC_cache_handler_struct::addIndexEntry(uint32_t filePos, uint32_t unixTime) {
+  const String fname = createCacheIndexFilename(RTC_cache.writeFileNr);
+
+  if (filePos == 0) {
+    // New cache file, any existing index is no longer valid.
+    tryDeleteFile(fname);
+    _hasIndexedEntry = false;
+    _indexFileNr     = RTC_cache.writeFileNr;
+  }
+
+  if (_indexFileNr != RTC_cache.writeFileNr) {
+    // Last entry not known, e.g. after a reboot
+    _hasIndexedEntry = false;
+    _indexFileNr     = RTC_cache.writeFileNr;
+    fs::File f = tryOpenFile(fname, "r");
+
+    if (f) {
+      const size_t fileSize = f.size();
+      RTC_cache_index_entry entry;
+
+      if ((fileSize % sizeof(entry)) != 0) {
+        // Incomplete entry, start a new index
+        f.close();
+        tryDeleteFile(fname);
+      } else if ((fileSize != 0) &&
+                 f.seek(fileSize - sizeof(entry)) &&
+                 (f.read(reinterpret_cast<uint8_t *>(&entry), sizeof(entry)) == sizeof(entry))) {
+        _lastIndexedPos  = entry.filePos;
+        _hasIndexedEntry = true;
+      }
+    }
+  }
+
+  if (_hasIndexedEntry && (filePos < (_lastIndexedPos + CACHE_INDEX_INTERVAL))) {
+    return;
+  }
+  fs::File f = tryOpenFile(fname, "a");
+
+  if (f) {
+    RTC_cache_index_entry entry;
+    entry.unixTime = unixTime;
+    entry.filePos  = filePos;
+
+    if (f.write(reinterpret_cast<const uint8_t *>(&entry), sizeof(entry)) == sizeof(entry)) {
+      _lastIndexedPos  = filePos;
+      _hasIndexedEntry = true;
+    }
+  }
+}
+
+bool RTC_cache_handler_struct::getFirstTimeOfFile(int fileNr, uint32_t& unixTime) {
+  {
+    fs::File f = tryOpenFile(createCacheIndexFilename(fileNr), "r");
+    RTC_cache_index_entry entry;
+
+    if (f && (f.read(reinterpret_cast<uint8_t *>(&entry), sizeof(entry)) == sizeof(entry)) && (entry.filePos == 0)) {
+      unixTime = entry.unixTime;
+      return true;
+    }
+  }
+
+  // No index, read the first sample of the file.
+  fs::File f = tryOpenFile(createCacheFilename(fileNr), "r");
+
+  if (!f) {
+    return false;
+  }
+  C016_binary_element element;
+# if FEATURE_RTC_CACHE_COMPRESSION
+  RTC_cache_block_header header;
+
+  if ((f.read(reinterpret_cast<uint8_t *>(&header), sizeof(header)) == sizeof(header)) &&
+      RTC_cache_block_isBlock(reinterpret_cast<const uint8_t *>(&header), sizeof(header))) {
+    RTC_cache_block_reader reader;
+
+    f.seek(0);
+
+    if (!reader.load(f) || !reader.next(element)) {
+      return false;
+    }
+    unixTime = element.unixTime;
+    return true;
+  }
+  f.seek(0);
+# endif // if FEATURE_RTC_CACHE_COMPRESSION
+
+  if (f.read(reinterpret_cast<uint8_t *>(&element), sizeof(element)) != sizeof(element)) {
+    return false;
+  }
+  unixTime = element.unixTime;
+  return true;
+}
+
+int RTC_cache_handler_struct::getIndexedFilePos(int fileNr, uint32_t unixTime, bool after) {
+  int filePos = after ? -1 : 0;
+  fs::File f  = tryOpenFile(createCacheIndexFilename(fileNr), "r");
+
+  if (!f) {
+    return filePos;
+  }
+  RTC_cache_index_entry entry;
+
+  while (f.read(reinterpret_cast<uint8_t *>(&entry), sizeof(entry)) == sizeof(entry)) {
+    if (after) {
+      if (entry.unixTime > unixTime) {
+        return entry.filePos;
+      }
+    } else {
+      if (entry.unixTime >= unixTime) {
+        // Samples with the same timestamp may be in the previous part
+        break;
+      }
+      filePos = entry.filePos;
+    }
+  }
+  return filePos;
+}
+
+#endif // if FEATURE_RTC_CACHE_INDEX
+
 #ifdef RTC_STRUCT_DEBUG
 void RTC_cache_handler_struct::rtc_debug_log(const String& description, size_t nrBytes) {
   if (loglevelActiveFor(LOG_LEVEL_INFO)) {
@@ -8,6 +8,7 @@
 #if FEATURE_RTC_CACHE_STORAGE
 
 #include "../DataStructs/RTCCacheStruct.h"
+#include "../DataStructs/RTC_cache_block.h"
 
 #include <FS.h>
 #include <vector>
@@ -29,6 +30,31 @@
 
 // #define RTC_STRUCT_DEBUG
 
+// Min. interval between two background maintenance steps on the cache files.
+#ifndef CACHE_MAINTENANCE_INTERVAL
+# define CACHE_MAINTENANCE_INTERVAL 1000
+#endif // ifndef CACHE_MAINTENANCE_INTERVAL
+
+// Max. nr of FS garbage collection steps after a cache file was closed or deleted.
+#ifndef CACHE_MAINTENANCE_GC_STEPS
+# define CACHE_MAINTENANCE_GC_STEPS 4
+#endif // ifndef CACHE_MAINTENANCE_GC_STEPS
+
+#if FEATURE_RTC_CACHE_INDEX
+
+// Min. nr of bytes in a cache file between two entries in its index file.
+# ifndef CACHE_INDEX_INTERVAL
+#  define CACHE_INDEX_INTERVAL 2048
+# endif // ifndef CACHE_INDEX_INTERVAL
+
+// Entry in the index file (cache_N.idx) of a cache file.
+// Do NOT change order of members, it is stored.
+struct RTC_cache_index_entry {
+  uint32_t unixTime = 0; // Timestamp of the first sample at filePos
+  uint32_t filePos  = 0; // Start of a raw sample or compressed block
+};
+#endif // if FEATURE_RTC_CACHE_INDEX
+
 /********************************************************************************************\
    RTC located cache
  \*********************************************************************************************/
@@ -53,10 +79,37 @@ struct RTC_cache_handler_struct
   bool         peek(uint8_t     *data,
                     unsigned int size);
 
+#if FEATURE_RTC_CACHE_INDEX
+
+  // Set the peek position to the first sample with a timestamp at or after unixTime.
+  // Uses the index files to skip most of the samples.
+  // Return false when there is no such sample.
+  bool seekToTime(uint32_t unixTime);
+
+  // Position from where to read samples starting at unixTime.
+  // All samples before this position are older than unixTime.
+  void getIndexedStartPos(uint32_t unixTime,
+                          int    & fileNr,
+                          int    & filePos);
+
+  // Position up to where to read samples till unixTime.
+  // All samples after this position are newer than unixTime.
+  // filePos is -1 when the samples up to the end of the file must be read.
+  void getIndexedEndPos(uint32_t unixTime,
+                        int    & fileNr,
+                        int    & filePos);
+#endif // if FEATURE_RTC_CACHE_INDEX
+
   // Write a single sample set to the buffer
   bool write(const uint8_t *data,
              unsigned int   size);
 
+#if FEATURE_RTC_CACHE_COMPRESSION
+
+  // Store new samples in compressed blocks. Off by default, as not all readers can decode these.
+  void setCompression(bool compress) { _compress = compress; }
+#endif // if FEATURE_RTC_CACHE_COMPRESSION
+
   // Mark all content as being processed and empty buffer.
   bool flush();
 
@@ -75,6 +128,11 @@ struct RTC_cache_handler_struct
   // When trying to access cache files, like deleting them, these files must be closed first.
   void   closeOpenFiles();
 
+  // Make room for the next cache file(s) while the scheduler is idle, so flush() does not have to.
+  // Performs at most a single file delete or FS garbage collection per call.
+  // Return true when some work was done.
+  bool   backgroundMaintenance();
+
 private:
 
   bool     loadMetaData();
@@ -86,6 +144,9 @@ private:
   bool     saveRTCcache(unsigned int startOffset,
                         size_t       nrBytes);
 
+  // Store the last written part of the buffer to the RTC memory.
+  bool     saveRTCcache_lastWritten(unsigned int size);
+
   uint32_t getDataChecksum();
 
   void     initRTCcache_data();
@@ -99,6 +160,57 @@ private:
 
   bool     prepareFileForWrite();
 
+  // Free space needed on the FS to start a new cache file.
+  // With keepSpare set, also keep room for the file after that, which is what the background maintenance aims for.
+  size_t   getRequiredFreeSpace(bool keepSpare) const;
+
+#if FEATURE_RTC_CACHE_COMPRESSION
+
+  // Encode the sample into the block in the RTC buffer
+  bool     writeCompressed(const C016_binary_element& element);
+
+  // Return true when the RTC buffer contains a block being filled.
+  bool     isBlockInRTC() const;
+
+  void     startBlockInRTC();
+
+  // Set size, nr of samples and checksum of the block in the RTC buffer, before writing it to a file.
+  void     finalizeBlockInRTC();
+
+  // Decode the block in the RTC buffer to continue encoding after a reboot or failed flush.
+  void     restoreEncoder();
+
+  // Read the next sample, either a raw sample or from a block.
+  bool     peekSample(uint8_t     *data,
+                      unsigned int size);
+
+  // Set the peek position to the raw sample or compressed sample at or before peekReadPos.
+  void     seekPeekSample(int peekReadPos);
+#endif // if FEATURE_RTC_CACHE_COMPRESSION
+
+#if FEATURE_RTC_CACHE_INDEX
+
+  // Timestamp of the first sample in the RTC buffer
+  bool     getFirstSampleTimeInRTC(uint32_t& unixTime);
+
+  // Add an entry to the index of the write file when the last entry is at least CACHE_INDEX_INTERVAL bytes before filePos.
+  void     addIndexEntry(uint32_t filePos,
+                         uint32_t unixTime);
+
+  // Timestamp of the first sample in the cache file
+  bool     getFirstTimeOfFile(int       fileNr,
+                              uint32_t& unixTime);
+
+  // Newest cache file with its first sample at or before unixTime, or the oldest file.
+  int      getFileNrForTime(uint32_t unixTime);
+
+  // Position of the last indexed sample before unixTime, or 0 when not indexed.
+  // With after set: position of the first indexed sample after unixTime, or -1 when not indexed.
+  int      getIndexedFilePos(int      fileNr,
+                             uint32_t unixTime,
+                             bool     after = false);
+#endif // if FEATURE_RTC_CACHE_INDEX
+
 #ifdef RTC_STRUCT_DEBUG
   void     rtc_debug_log(const String& description,
                          size_t        nrBytes);
@@ -113,9 +225,24 @@ private:
   fs::File fp;  // File handler Peek
   size_t   _peekfilenr  = 0;
   size_t   _peekreadpos = 0;
+#if FEATURE_RTC_CACHE_COMPRESSION
+  RTC_cache_block_codec  _encoder;
+  RTC_cache_block_reader _peekBlock;
+  uint16_t               _encodedSamples = 0;
+  bool                   _compress       = false;
+#endif // if FEATURE_RTC_CACHE_COMPRESSION
+
+#if FEATURE_RTC_CACHE_INDEX
+  uint32_t _lastIndexedPos  = 0;
+  uint16_t _indexFileNr     = 0; // File nr of which the last index entry is known
+  bool     _hasIndexedEntry = false;
+#endif // if FEATURE_RTC_CACHE_INDEX
+
+  uint32_t _lastMaintenance = 0;
 
   uint8_t storageLocation = CACHE_STORAGE_SPIFFS;
   bool    writeError      = false;
+  uint8_t _gcStepsLeft    = 0; // FS garbage collection left to the background maintenance
 };
 
 #endif
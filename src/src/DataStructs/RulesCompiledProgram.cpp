@@ -0,0 +1,364 @@
+#include "../DataStructs/RulesCompiledProgram.h"
+
+#if FEATURE_RULES_COMPILED
+
+# include "../DataStructs/TimingStats.h"
+# include "../ESPEasyCore/ESPEasy_Log.h"
+# include "../Globals/Cache.h"
+# include "../Helpers/CRC_functions.h"
+# include "../Helpers/ESPEasy_Storage.h"
+# include "../Helpers/RulesMatcher.h"
+# include "../Helpers/StringConverter.h"
+
+# ifndef RULES_COMPILED_IN_MEMORY
+
+// Sidecar file layout:
+// Header: uint32_t version, uint32_t CRC32 of the ops part
+// Per op: uint8_t opcode, uint32_t jump, uint16_t text length, text (not 0-terminated)
+#  define RULES_COMPILED_FILE_VERSION      0x01435245 // "ERC" + version 1
+#  define RULES_COMPILED_FILE_HEADER_SIZE  8
+#  define RULES_COMPILED_OP_HEADER_SIZE    7
+# endif // ifndef RULES_COMPILED_IN_MEMORY
+
+RulesCompiledProgram::~RulesCompiledProgram()
+{
+  clear();
+}
+
+void RulesCompiledProgram::clear()
+{
+# ifdef RULES_COMPILED_IN_MEMORY
+  _programs.clear();
+# else // ifdef RULES_COMPILED_IN_MEMORY
+
+  if (_file) {
+    _file.close();
+  }
+  _openFilename.clear();
+# endif // ifdef RULES_COMPILED_IN_MEMORY
+}
+
+void RulesCompiledProgram::closeBlock(RulesCompiled_ops  & ops,
+                                      std::vector<size_t>& branchStack,
+                                      size_t               onIndex,
+                                      size_t               endPos)
+{
+  // Any unterminated if/elseif/else will continue at the end of the block
+  for (auto it = branchStack.begin(); it != branchStack.end(); ++it) {
+    ops[*it].jump = endPos;
+  }
+  branchStack.clear();
+
+  if (onIndex < ops.size()) {
+    ops[onIndex].jump = endPos;
+  }
+}
+
+bool RulesCompiledProgram::compile(const String             & filename,
+                                   const std::vector<String>& lines,
+                                   RulesEventCache          & eventCache)
+{
+  START_TIMER
+  RulesCompiled_ops   ops;
+  std::vector<size_t> branchStack;
+
+  struct event_pending {
+    event_pending(size_t index, String&& event, String&& action)
+      : _index(index), _event(std::move(event)), _action(std::move(action)) {}
+
+    size_t _index;
+    String _event;
+    String _action;
+  };
+  std::vector<event_pending> events;
+
+  const size_t noIndex = static_cast<size_t>(-1);
+  size_t onIndex = noIndex;
+  bool   inBlock = false;
+
+  for (auto line = lines.begin(); line != lines.end(); ++line) {
+    if (line->isEmpty()) { continue; }
+
+    String lcLine = *line;
+    lcLine.toLowerCase();
+
+    const size_t index = ops.size();
+    RulesCompiled_op op;
+
+    if (lcLine.startsWith(F("on "))) {
+      // A new "on" also ends a block which lacks an "endon"
+      closeBlock(ops, branchStack, onIndex, index);
+      onIndex = noIndex;
+      inBlock = false;
+
+      String event, action;
+
+      if (!getEventFromRulesLine(*line, event, action)) {
+        continue;
+      }
+      if (action.isEmpty()) {
+        op.opcode = RulesCompiled_opcode::On;
+        onIndex   = index;
+        inBlock   = true;
+      } else {
+        op.opcode = RulesCompiled_opcode::OnOneLiner;
+        op.text   = action;
+      }
+      events.emplace_back(index, std::move(event), std::move(action));
+    } else if (!inBlock) {
+      // Lines outside an "on ... do" block are never executed
+      continue;
+    } else if (equals(lcLine, F("endon"))) {
+      op.opcode = RulesCompiled_opcode::EndOn;
+      closeBlock(ops, branchStack, onIndex, index);
+      onIndex = noIndex;
+      inBlock = false;
+    } else if (lcLine.startsWith(F("elseif "))) {
+      if (branchStack.empty()) {
+        addLog(LOG_LEVEL_ERROR, concat(F("Rules : 'elseif' without 'if' in: "), filename));
+        continue;
+      }
+      op.opcode = RulesCompiled_opcode::ElseIf;
+      op.text   = line->substring(7);
+      op.text.trim();
+      ops[branchStack.back()].jump = index;
+      branchStack.back()           = index;
+    } else if (lcLine.startsWith(F("if "))) {
+      op.opcode = RulesCompiled_opcode::If;
+      op.text   = line->substring(3);
+      op.text.trim();
+      branchStack.push_back(index);
+    } else if (equals(lcLine, F("else"))) {
+      if (branchStack.empty()) {
+        addLog(LOG_LEVEL_ERROR, concat(F("Rules : 'else' without 'if' in: "), filename));
+        continue;
+      }
+      op.opcode                    = RulesCompiled_opcode::Else;
+      ops[branchStack.back()].jump = index;
+      branchStack.back()           = index;
+    } else if (equals(lcLine, F("endif"))) {
+      if (branchStack.empty()) {
+        addLog(LOG_LEVEL_ERROR, concat(F("Rules : 'endif' without 'if' in: "), filename));
+        continue;
+      }
+      op.opcode                    = RulesCompiled_opcode::EndIf;
+      ops[branchStack.back()].jump = index;
+      branchStack.pop_back();
+    } else {
+      op.opcode = RulesCompiled_opcode::Command;
+
+      if (line->startsWith(F("%event"))) {
+        op.text = F("restrict,");
+
+        if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+          addLog(LOG_LEVEL_ERROR, concat(F("Rules : Prefix command with 'restrict': "), *line));
+        }
+      }
+      op.text += *line;
+    }
+    ops.emplace_back(std::move(op));
+  }
+  closeBlock(ops, branchStack, onIndex, ops.size());
+
+  # ifndef BUILD_NO_DEBUG
+
+  if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+    String log = F("Rules : Compiled ");
+    log += lines.size();
+    log += F(" lines into ");
+    log += ops.size();
+    log += F(" ops for ");
+    log += filename;
+    addLogMove(LOG_LEVEL_DEBUG, log);
+  }
+  # endif // ifndef BUILD_NO_DEBUG
+
+  bool res = true;
+# ifdef RULES_COMPILED_IN_MEMORY
+
+  for (auto it = events.begin(); it != events.end(); ++it) {
+    eventCache.addEvent(filename, it->_index, std::move(it->_event), std::move(it->_action));
+  }
+  _programs[filename] = std::move(ops);
+# else // ifdef RULES_COMPILED_IN_MEMORY
+  std::vector<uint32_t> offsets;
+  res = writeSidecar(filename, ops, offsets);
+
+  if (res) {
+    for (auto it = events.begin(); it != events.end(); ++it) {
+      eventCache.addEvent(filename, offsets[it->_index], std::move(it->_event), std::move(it->_action));
+    }
+  }
+# endif // ifdef RULES_COMPILED_IN_MEMORY
+  STOP_TIMER(RULES_COMPILE);
+  return res;
+}
+
+bool RulesCompiledProgram::readOp(const String    & filename,
+                                  size_t          & pos,
+                                  RulesCompiled_op& op)
+{
+# ifdef RULES_COMPILED_IN_MEMORY
+  auto it = _programs.find(filename);
+
+  if ((it == _programs.end()) || (pos >= it->second.size())) {
+    return false;
+  }
+  op = it->second[pos];
+  ++pos;
+  return true;
+# else // ifdef RULES_COMPILED_IN_MEMORY
+
+  if (!_file || !_openFilename.equals(filename)) {
+    if (_file) {
+      _file.close();
+    }
+    _file = tryOpenFile(getSidecarFileName(filename), F("r"));
+
+    if (!_file) {
+      _openFilename.clear();
+      return false;
+    }
+    _openFilename = filename;
+  }
+
+  if ((pos < RULES_COMPILED_FILE_HEADER_SIZE) ||
+      ((pos + RULES_COMPILED_OP_HEADER_SIZE) > _file.size())) {
+    return false;
+  }
+
+  if (_file.position() != pos) {
+    _file.seek(pos);
+  }
+  uint8_t header[RULES_COMPILED_OP_HEADER_SIZE]{};
+
+  if (_file.read(header, RULES_COMPILED_OP_HEADER_SIZE) != RULES_COMPILED_OP_HEADER_SIZE) {
+    return false;
+  }
+  op.opcode = static_cast<RulesCompiled_opcode>(header[0]);
+  memcpy(&op.jump, &header[1], sizeof(uint32_t));
+  uint16_t length = 0;
+  memcpy(&length, &header[5], sizeof(uint16_t));
+
+  op.text.clear();
+
+  if (length > 0) {
+    std::vector<uint8_t> buf;
+    buf.resize(length);
+
+    if (_file.read(&buf[0], length) != length) {
+      return false;
+    }
+
+    if (op.text.reserve(length)) {
+      for (uint16_t i = 0; i < length; ++i) {
+        op.text += static_cast<char>(buf[i]);
+      }
+    }
+  }
+  pos = _file.position();
+  return true;
+# endif // ifdef RULES_COMPILED_IN_MEMORY
+}
+
+# ifndef RULES_COMPILED_IN_MEMORY
+String RulesCompiledProgram::getSidecarFileName(const String& filename)
+{
+  String res = filename;
+
+  res.replace(F(".txt"), F(".rbc"));
+  return res;
+}
+
+void RulesCompiledProgram::deleteSidecar(const String& filename)
+{
+  if (_file && _openFilename.equals(filename)) {
+    _file.close();
+    _openFilename.clear();
+  }
+  const String sidecar = patch_fname(getSidecarFileName(filename));
+
+  if (fileExists(sidecar)) {
+    // Not using tryDeleteFile(), as that clears the rules cache which may be calling this.
+    ESPEASY_FS.remove(sidecar);
+    Cache.invalidateFileCache(sidecar);
+  }
+}
+
+bool RulesCompiledProgram::writeSidecar(const String           & filename,
+                                        const RulesCompiled_ops& ops,
+                                        std::vector<uint32_t>  & offsets)
+{
+  if (_file) {
+    _file.close();
+  }
+  _openFilename.clear();
+
+  // First compute the file offsets of all ops, so the jumps can be translated.
+  offsets.resize(ops.size() + 1);
+  offsets[0] = RULES_COMPILED_FILE_HEADER_SIZE;
+
+  for (size_t i = 0; i < ops.size(); ++i) {
+    offsets[i + 1] = offsets[i] + RULES_COMPILED_OP_HEADER_SIZE + ops[i].text.length();
+  }
+
+  std::vector<uint8_t> buf;
+  buf.reserve(offsets[ops.size()]);
+  buf.resize(RULES_COMPILED_FILE_HEADER_SIZE);
+
+  for (auto it = ops.begin(); it != ops.end(); ++it) {
+    const uint32_t jump   = it->jump <= ops.size() ? offsets[it->jump] : offsets[ops.size()];
+    const uint16_t length = it->text.length();
+    buf.push_back(static_cast<uint8_t>(it->opcode));
+
+    for (size_t i = 0; i < sizeof(uint32_t); ++i) {
+      buf.push_back((jump >> (8 * i)) & 0xFF);
+    }
+
+    for (size_t i = 0; i < sizeof(uint16_t); ++i) {
+      buf.push_back((length >> (8 * i)) & 0xFF);
+    }
+
+    for (uint16_t i = 0; i < length; ++i) {
+      buf.push_back(static_cast<uint8_t>(it->text[i]));
+    }
+  }
+  const uint32_t version = RULES_COMPILED_FILE_VERSION;
+  const uint32_t crc     = calc_CRC32(&buf[RULES_COMPILED_FILE_HEADER_SIZE], buf.size() - RULES_COMPILED_FILE_HEADER_SIZE);
+  memcpy(&buf[0], &version, sizeof(uint32_t));
+  memcpy(&buf[4], &crc,     sizeof(uint32_t));
+
+  const String sidecar = getSidecarFileName(filename);
+
+  {
+    // Only write when changed, to limit flash wear as this is also done at boot.
+    fs::File f = tryOpenFile(sidecar, F("r"));
+
+    if (f) {
+      uint8_t header[RULES_COMPILED_FILE_HEADER_SIZE]{};
+      const bool unchanged =
+        (f.size() == buf.size()) &&
+        (f.read(header, RULES_COMPILED_FILE_HEADER_SIZE) == RULES_COMPILED_FILE_HEADER_SIZE) &&
+        (memcmp(header, &buf[0], RULES_COMPILED_FILE_HEADER_SIZE) == 0);
+      f.close();
+
+      if (unchanged) {
+        return true;
+      }
+    }
+  }
+
+  fs::File f = tryOpenFile(sidecar, F("w"));
+
+  if (!f) {
+    addLog(LOG_LEVEL_ERROR, concat(F("Rules : Could not write compiled rules "), sidecar));
+    return false;
+  }
+  const bool res = f.write(&buf[0], buf.size()) == buf.size();
+  f.close();
+  return res;
+}
+
+# endif // ifndef RULES_COMPILED_IN_MEMORY
+
+#endif // if FEATURE_RULES_COMPILED
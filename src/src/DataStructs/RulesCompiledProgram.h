@@ -0,0 +1,100 @@
+#ifndef DATASTRUCTS_RULESCOMPILEDPROGRAM_H
+#define DATASTRUCTS_RULESCOMPILEDPROGRAM_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_RULES_COMPILED
+
+# include "../DataStructs/RulesEventCache.h"
+
+# include <FS.h>
+# include <map>
+# include <vector>
+
+// Compiled rules are kept in RAM on ESP32.
+// On ESP8266 they are stored in a sidecar file next to the rules file
+// to keep RAM usage low.
+# ifdef ESP32
+#  define RULES_COMPILED_IN_MEMORY
+# endif // ifdef ESP32
+
+
+enum class RulesCompiled_opcode : uint8_t {
+  Invalid = 0,
+  On,         // "on <event> do"        jump: position of the end of the block
+  OnOneLiner, // "on <event> do <cmd>"  text: command
+  EndOn,      // "endon"
+  If,         // "if <cond>"            text: condition, jump: next elseif/else/endif
+  ElseIf,     // "elseif <cond>"        text: condition, jump: next elseif/else/endif
+  Else,       // "else"                 jump: matching endif
+  EndIf,      // "endif"
+  Command     // Any other line         text: command
+};
+
+struct RulesCompiled_op {
+  RulesCompiled_opcode opcode = RulesCompiled_opcode::Invalid;
+
+  // Position of the next op to continue with, when a condition is not met.
+  // The meaning of a position depends on the storage used:
+  // index in the vector when kept in memory, offset in the sidecar file otherwise.
+  uint32_t jump = 0;
+  String   text;
+};
+
+typedef std::vector<RulesCompiled_op> RulesCompiled_ops;
+
+// Parse the rules text once into a compact form, with jump positions for
+// the if/elseif/else/endif structure, so the rules engine does not need to
+// re-detect keywords and skip lines while processing an event.
+class RulesCompiledProgram {
+public:
+
+  RulesCompiledProgram() = default;
+
+  ~RulesCompiledProgram();
+
+  void clear();
+
+  // Compile the lines of a rules file.
+  // Lines must already be trimmed and stripped of comments.
+  // Every "on ... do" found will be added to the event cache,
+  // with the position of its compiled op.
+  bool compile(const String             & filename,
+               const std::vector<String>& lines,
+               RulesEventCache          & eventCache);
+
+  // Read the op at pos and set pos to the position of the next op.
+  // Return false when there is no op at pos.
+  bool readOp(const String    & filename,
+              size_t          & pos,
+              RulesCompiled_op& op);
+
+# ifndef RULES_COMPILED_IN_MEMORY
+  static String getSidecarFileName(const String& filename);
+
+  // Remove the sidecar file of a rules file, when present.
+  void          deleteSidecar(const String& filename);
+# endif // ifndef RULES_COMPILED_IN_MEMORY
+
+private:
+
+  static void closeBlock(RulesCompiled_ops   & ops,
+                         std::vector<size_t> & branchStack,
+                         size_t                onIndex,
+                         size_t                endPos);
+
+# ifdef RULES_COMPILED_IN_MEMORY
+  std::map<String, RulesCompiled_ops>_programs;
+# else // ifdef RULES_COMPILED_IN_MEMORY
+  bool writeSidecar(const String           & filename,
+                    const RulesCompiled_ops& ops,
+                    std::vector<uint32_t>  & offsets);
+
+  fs::File _file;
+  String   _openFilename;
+# endif // ifdef RULES_COMPILED_IN_MEMORY
+};
+
+#endif // if FEATURE_RULES_COMPILED
+
+#endif // ifndef DATASTRUCTS_RULESCOMPILEDPROGRAM_H
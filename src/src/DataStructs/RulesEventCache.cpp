@@ -3,74 +3,350 @@
 #include "../DataStructs/TimingStats.h"
 #include "../Helpers/RulesMatcher.h"
 
+#include <iterator>
+
+
+#if FEATURE_RULES_PROFILING
+void RulesEventCache_profile::clear()
+{
+  *this = RulesEventCache_profile();
+}
+
+void RulesEventCache_profile::add(uint32_t duration_usec, uint32_t nrCommands, int32_t heapDelta)
+{
+  _totalDuration_usec += duration_usec;
+
+  if (duration_usec > _maxDuration_usec) {
+    _maxDuration_usec = duration_usec;
+  }
+  _nrCommands     += nrCommands;
+  _heapDeltaTotal += heapDelta;
+
+  if (heapDelta < _heapDeltaMin) {
+    _heapDeltaMin = heapDelta;
+  }
+}
+
+void RulesEventCache::addProfile(size_t index, uint32_t duration_usec, uint32_t nrCommands, int32_t heapDelta)
+{
+  if (index < _eventCache.size()) {
+    RulesEventCache_element& element = _eventCache[index];
+    ++element._nrTimesMatched;
+    element._profile.add(duration_usec, nrCommands, heapDelta);
+  }
+}
+
+void RulesEventCache::clearProfiles()
+{
+  for (auto it = _eventCache.begin(); it != _eventCache.end(); ++it) {
+    it->_nrTimesMatched = 0;
+    it->_profile.clear();
+  }
+}
+
+#endif // if FEATURE_RULES_PROFILING
 
 void RulesEventCache::clear()
 {
   _eventCache.clear();
-  _initialized = false;
+  _eventIndex.clear();
+  _genericRules.clear();
+  _wildcardPrefixes.clear();
+  _filterMatchAll = true;
+  _initialized    = false;
 }
 
 void RulesEventCache::initialize()
 {
+  buildIndex();
   _initialized = true;
 }
 
 bool RulesEventCache::addLine(const String& line, const String& filename, size_t pos)
+{
+  return parseLine(line, filename, pos, _eventCache);
+}
+
+bool RulesEventCache::parseLine(const String& line, const String& filename, size_t pos, RulesEventCache_vector& events)
 {
   String event, action;
 
   if (getEventFromRulesLine(line, event, action)) {
-    _eventCache.emplace_back(filename, pos, std::move(event), std::move(action));
+    events.emplace_back(filename, pos, std::move(event), std::move(action));
     return true;
   }
   return false;
 }
 
-RulesEventCache_vector::const_iterator RulesEventCache::findMatchingRule(const String& event, bool optimize)
+void RulesEventCache::replaceFileEvents(const String& filename, RulesEventCache_vector&& events)
+{
+  // Events must be kept in the order of the rules files.
+  // Rules file names only differ in the set number, so comparing the names gives the file order.
+  RulesEventCache_vector newCache;
+
+  newCache.reserve(_eventCache.size() + events.size());
+  bool added = false;
+
+  for (auto it = _eventCache.begin(); it != _eventCache.end(); ++it) {
+    if (it->_filename.equals(filename)) {
+      continue;
+    }
+
+    if (!added && (it->_filename.compareTo(filename) > 0)) {
+      std::move(events.begin(), events.end(), std::back_inserter(newCache));
+      added = true;
+    }
+    newCache.emplace_back(std::move(*it));
+  }
+
+  if (!added) {
+    std::move(events.begin(), events.end(), std::back_inserter(newCache));
+  }
+  _eventCache.swap(newCache);
+  initialize();
+}
+
+void RulesEventCache::addEvent(const String& filename, size_t pos, String&& event, String&& action)
+{
+  _eventCache.emplace_back(filename, pos, std::move(event), std::move(action));
+}
+
+bool RulesEventCache::getIndexKey(const String& str, bool isRule, uint32_t& key)
+{
+  if (isRule) {
+    const char *c = str.c_str();
+
+    while (*c == ' ') { ++c; }
+
+    if ((*c == '!') ||
+        (str.indexOf('*') != -1) ||
+        (str.indexOf('[') != -1) ||
+        (str.indexOf('%') != -1) ||
+        (str.indexOf('{') != -1)) {
+      // Rule may match events with other names, or will only be known after parsing.
+      return false;
+    }
+  }
+  return getEventNameKey(str.c_str(), str.length(), key);
+}
+
+bool RulesEventCache::getEventNameKey(const char *c, size_t length, uint32_t& key)
+{
+  const char *end = c + length;
+
+  while (c < end && *c == ' ') { ++c; }
+
+  // FNV-1a hash
+  uint32_t hash          = 2166136261u;
+  uint32_t hash_nonSpace = hash;
+  bool     hasChars      = false;
+
+  for (; c < end && *c != '\0'; ++c) {
+    if ((*c == '#') || (*c == '=') || (*c == '<') || (*c == '>') ||
+        ((*c == '!') && ((c + 1) < end) && (*(c + 1) == '='))) {
+      break;
+    }
+    hash ^= static_cast<uint8_t>(tolower(*c));
+    hash *= 16777619u;
+
+    if (*c != ' ') {
+      // Ignore trailing spaces
+      hash_nonSpace = hash;
+      hasChars      = true;
+    }
+  }
+
+  if (!hasChars) { return false; }
+  key = hash_nonSpace;
+  return true;
+}
+
+void RulesEventCache::buildIndex()
+{
+  _eventIndex.clear();
+  _genericRules.clear();
+  _wildcardPrefixes.clear();
+  _filterMatchAll = false;
+
+  for (size_t i = 0; i < RULES_EVENT_FILTER_BITS / 32; ++i) {
+    _filterBits[i] = 0;
+  }
+
+  for (size_t i = 0; i < _eventCache.size(); ++i) {
+    uint32_t key = 0;
+
+    if (getIndexKey(_eventCache[i]._event, true, key)) {
+      _eventIndex[key].push_back(i);
+      setFilterBits(key);
+    } else {
+      _genericRules.push_back(i);
+      addToFilter(_eventCache[i]);
+    }
+  }
+}
+
+void RulesEventCache::addToFilter(const RulesEventCache_element& element)
 {
-  RulesEventCache_vector::iterator it   = _eventCache.begin();
-//  RulesEventCache_vector::iterator prev = _eventCache.end();
+  String rule = element._event;
 
-  // FIXME TD-er: Disable optimize as it has some side effects.
+  rule.trim();
+
+  const int asterisk_pos = rule.indexOf('*');
+
+  if ((asterisk_pos == -1) ||
+      rule.startsWith(F("!")) ||
+      (rule.indexOf('[') != -1) ||
+      (rule.indexOf('%') != -1) ||
+      (rule.indexOf('{') != -1)) {
+    // Rule can only be checked by parsing it.
+    _filterMatchAll = true;
+    return;
+  }
+
+  // Clock events are matched on the part before the '=', so only use the event name.
+  int prefix_length = asterisk_pos;
+  const int equal_pos = rule.indexOf('=');
+
+  if ((equal_pos != -1) && (equal_pos < prefix_length)) {
+    prefix_length = equal_pos;
+  }
+
+  if (prefix_length == 0) {
+    _filterMatchAll = true;
+    return;
+  }
+  String prefix = rule.substring(0, prefix_length);
+
+  prefix.toLowerCase();
+  _wildcardPrefixes.emplace_back(std::move(prefix));
+}
+
+void RulesEventCache::setFilterBits(uint32_t key)
+{
+  const uint32_t bit1 = key % RULES_EVENT_FILTER_BITS;
+  const uint32_t bit2 = (key >> 16) % RULES_EVENT_FILTER_BITS;
+
+  _filterBits[bit1 / 32] |= (1u << (bit1 % 32));
+  _filterBits[bit2 / 32] |= (1u << (bit2 % 32));
+}
+
+bool RulesEventCache::getFilterBits(uint32_t key) const
+{
+  const uint32_t bit1 = key % RULES_EVENT_FILTER_BITS;
+  const uint32_t bit2 = (key >> 16) % RULES_EVENT_FILTER_BITS;
+
+  return (_filterBits[bit1 / 32] & (1u << (bit1 % 32))) &&
+         (_filterBits[bit2 / 32] & (1u << (bit2 % 32)));
+}
+
+bool RulesEventCache::mayMatch(const char *event, size_t length) const
+{
+  if (!_initialized || _filterMatchAll) { return true; }
+
+  uint32_t key = 0;
+
+  if (!getEventNameKey(event, length, key)) {
+    // All rules will be checked for this event
+    return true;
+  }
+
+  if (getFilterBits(key) && (_eventIndex.find(key) != _eventIndex.end())) {
+    return true;
+  }
+
+  while (length > 0 && *event == ' ') {
+    ++event;
+    --length;
+  }
+
+  for (auto it = _wildcardPrefixes.begin(); it != _wildcardPrefixes.end(); ++it) {
+    if ((length >= it->length()) &&
+        (strncasecmp(event, it->c_str(), it->length()) == 0)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool RulesEventCache::mayMatchTask(const String& taskName) const
+{
+  if (!_initialized || _filterMatchAll) { return true; }
+
+  uint32_t key = 0;
+
+  if (!getEventNameKey(taskName.c_str(), taskName.length(), key)) {
+    return true;
+  }
+
+  if (getFilterBits(key) && (_eventIndex.find(key) != _eventIndex.end())) {
+    return true;
+  }
+
+  for (auto it = _wildcardPrefixes.begin(); it != _wildcardPrefixes.end(); ++it) {
+    if (it->length() <= taskName.length()) {
+      // Prefix like "task*" or "taskname*"
+      if (strncasecmp(taskName.c_str(), it->c_str(), it->length()) == 0) {
+        return true;
+      }
+    } else if ((strncasecmp(taskName.c_str(), it->c_str(), taskName.length()) == 0) &&
+               ((*it)[taskName.length()] == '#')) {
+      // Prefix like "taskname#val*"
+      return true;
+    }
+  }
+  return false;
+}
+
+RulesEventCache_vector::const_iterator RulesEventCache::findMatchingRule(const String& event, bool optimize)
+{
+  // N.B. The order in which the rules are checked must be kept the same as in the rules files.
   // For example, matching a specific event first and then a more generic one is perfectly normal to do.
-  // But this optimization will then put the generic one in front as it will be matched more often.
+  // Reordering based on how often a rule matches will then put the generic one in front.
   // Thus it will never match the more specific one anymore.
+  // The 'optimize' flag is therefore ignored.
+  (void)optimize;
+  uint32_t key = 0;
+
+  if (!getIndexKey(event, false, key)) {
+    // Can't use the index, check all
+    for (auto it = _eventCache.begin(); it != _eventCache.end(); ++it) {
+      START_TIMER
+      const bool match = ruleMatch(event, it->_event);
+      STOP_TIMER(RULES_MATCH);
+
+      if (match) {
+        return it;
+      }
+    }
+    return _eventCache.end();
+  }
+
+  static const RulesEventCache_indices noIndices;
+  auto indexIt = _eventIndex.find(key);
+  const RulesEventCache_indices& indices = (indexIt == _eventIndex.end()) ? noIndices : indexIt->second;
 
+  // Merge both lists of candidates, to check them in file order.
+  auto it_index   = indices.begin();
+  auto it_generic = _genericRules.begin();
 
-  for (; it != _eventCache.end(); ++it)
-  {
+  while (it_index != indices.end() || it_generic != _genericRules.end()) {
+    size_t pos = 0;
+
+    if ((it_generic == _genericRules.end()) ||
+        ((it_index != indices.end()) && (*it_index < *it_generic))) {
+      pos = *it_index;
+      ++it_index;
+    } else {
+      pos = *it_generic;
+      ++it_generic;
+    }
     START_TIMER
-    const bool match = ruleMatch(event, it->_event);
+    const bool match = ruleMatch(event, _eventCache[pos]._event);
     STOP_TIMER(RULES_MATCH);
 
     if (match) {
-      /*
-      if (optimize) {
-        it->_nrTimesMatched++;
-
-        if (prev != _eventCache.end()) {
-          // Check to see if we need to place this one more to the front of the vector
-          // to speed up parsing.
-          if (prev->_nrTimesMatched < it->_nrTimesMatched) {
-            std::swap(*prev, *it);
-            return prev;
-          }
-        }
-      }
-      */
-      return it;
-    }
-/*
-    if (optimize) {
-      if (prev == _eventCache.end()) {
-        prev = it;
-      }
-      else if (prev->_nrTimesMatched > it->_nrTimesMatched) {
-        // Found one that's having a lower match rate
-        prev = it;
-      }
+      return _eventCache.begin() + pos;
     }
-    */
   }
-  return it;
+  return _eventCache.end();
 }
@@ -3,8 +3,36 @@
 
 #include "../../ESPEasy_common.h"
 
+#include <map>
 #include <vector>
 
+// Number of bits used for the quick (Bloom-style) check of event names
+#ifndef RULES_EVENT_FILTER_BITS
+# ifdef ESP8266
+#  define RULES_EVENT_FILTER_BITS  128
+# else // ifdef ESP8266
+#  define RULES_EVENT_FILTER_BITS  512
+# endif // ifdef ESP8266
+#endif // ifndef RULES_EVENT_FILTER_BITS
+
+#if FEATURE_RULES_PROFILING
+
+// Execution statistics of a single "on ... do" block
+struct RulesEventCache_profile {
+  void     clear();
+
+  void     add(uint32_t duration_usec,
+               uint32_t nrCommands,
+               int32_t  heapDelta);
+
+  uint64_t _totalDuration_usec = 0;
+  uint32_t _maxDuration_usec   = 0;
+  uint32_t _nrCommands         = 0;
+  int32_t  _heapDeltaTotal     = 0; // Sum of the change in free heap
+  int32_t  _heapDeltaMin       = 0; // Largest decrease of free heap
+};
+#endif // if FEATURE_RULES_PROFILING
+
 struct RulesEventCache_element {
   RulesEventCache_element(const String& filename, size_t pos, const String& event, const String& action)
     : _filename(filename), _posInFile(pos), _event(event), _action(action)
@@ -16,6 +44,9 @@ struct RulesEventCache_element {
   String _event;
   String _action;
   size_t _nrTimesMatched = 0;
+#if FEATURE_RULES_PROFILING
+  RulesEventCache_profile _profile;
+#endif // if FEATURE_RULES_PROFILING
 };
 
 typedef std::vector<RulesEventCache_element> RulesEventCache_vector;
@@ -37,15 +68,91 @@ public:
                const String& filename,
                size_t        pos);
 
+  // Parse a rules line and append the event to the given vector, without changing the cache.
+  static bool parseLine(const String          & line,
+                        const String          & filename,
+                        size_t                  pos,
+                        RulesEventCache_vector& events);
+
+  // Replace all events of a single rules file by the given events and rebuild the index.
+  // Events of the other files are kept, including their statistics.
+  void replaceFileEvents(const String          & filename,
+                         RulesEventCache_vector&& events);
+
+  // Add an already parsed event.
+  // pos is interpreted by the owner of the cache (e.g. position in the compiled rules)
+  void addEvent(const String& filename,
+                size_t        pos,
+                String     && event,
+                String     && action);
+
   RulesEventCache_vector::const_iterator findMatchingRule(const String& event, bool optimize);
 
+  // Return false when no rule can match the event.
+  // Event does not need to be 0-terminated.
+  bool mayMatch(const char *event,
+                size_t      length) const;
+
+  // Return false when no rule can match any event of a task with given name.
+  bool mayMatchTask(const String& taskName) const;
+
+  RulesEventCache_vector::const_iterator begin() const {
+    return _eventCache.begin();
+  }
+
   RulesEventCache_vector::const_iterator end() const {
     return _eventCache.end();
   }
 
+#if FEATURE_RULES_PROFILING
+
+  // Add execution stats for the rules block at given position in the cache.
+  void addProfile(size_t   index,
+                  uint32_t duration_usec,
+                  uint32_t nrCommands,
+                  int32_t  heapDelta);
+
+  void clearProfiles();
+#endif // if FEATURE_RULES_PROFILING
+
 private:
 
+  // Compute a hash of the lowercase event name up to the first '#', '=' or compare operator.
+  // For rules: return false when the key cannot be determined upfront (wildcards, templates, literal '!' events)
+  static bool getIndexKey(const String& str,
+                          bool          isRule,
+                          uint32_t    & key);
+
+  static bool getEventNameKey(const char *str,
+                              size_t      length,
+                              uint32_t  & key);
+
+  void buildIndex();
+
+  void addToFilter(const RulesEventCache_element& element);
+
+  void setFilterBits(uint32_t key);
+
+  bool getFilterBits(uint32_t key) const;
+
   RulesEventCache_vector _eventCache;
+
+  // Index on the event name, holding the positions in _eventCache in file order.
+  typedef std::vector<size_t> RulesEventCache_indices;
+  std::map<uint32_t, RulesEventCache_indices> _eventIndex;
+
+  // Positions of rules which have to be checked for any event
+  RulesEventCache_indices _genericRules;
+
+  // Filter to quickly tell that an event cannot match any rule.
+  uint32_t _filterBits[RULES_EVENT_FILTER_BITS / 32]{};
+
+  // Lower case part before the '*' of wildcard rules
+  std::vector<String> _wildcardPrefixes;
+
+  // Set when some rule cannot be captured by the filter
+  bool _filterMatchAll = true;
+
   bool _initialized = false;
 };
 
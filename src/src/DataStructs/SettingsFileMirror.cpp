@@ -0,0 +1,93 @@
+#include "../DataStructs/SettingsFileMirror.h"
+
+#if FEATURE_SETTINGS_PSRAM_MIRROR
+
+# include "../Helpers/Hardware.h"
+# include "../Helpers/Memory.h"
+
+SettingsFileMirror_struct::~SettingsFileMirror_struct() {
+  invalidateAll();
+}
+
+bool SettingsFileMirror_struct::canMirror(size_t fileSize) const {
+  return (fileSize > 0) && (fileSize <= SETTINGS_MIRROR_MAX_FILE_SIZE) && UsePSRAM();
+}
+
+bool SettingsFileMirror_struct::load(const String& fname, fs::File& f) {
+  invalidate(fname);
+  const size_t fileSize = f.size();
+
+  if (!canMirror(fileSize)) {
+    return false;
+  }
+
+  uint8_t *data = static_cast<uint8_t *>(buffer_malloc(MemoryBufferClass_e::FileCache, fileSize));
+
+  if (data == nullptr) {
+    return false;
+  }
+
+  if (!f.seek(0, fs::SeekSet) || (f.read(data, fileSize) != fileSize)) {
+    buffer_free(MemoryBufferClass_e::FileCache, data, fileSize);
+    return false;
+  }
+  MirroredFile file;
+
+  file.fname = fname;
+  file.data  = data;
+  file.size  = fileSize;
+  _files.push_back(std::move(file));
+  return true;
+}
+
+bool SettingsFileMirror_struct::read(const String& fname, uint32_t offset, uint8_t *memAddress, size_t size) const {
+  for (auto it = _files.begin(); it != _files.end(); ++it) {
+    if (it->fname.equals(fname)) {
+      size_t available = 0;
+
+      if (offset < it->size) {
+        available = it->size - offset;
+
+        if (available > size) {
+          available = size;
+        }
+        memcpy(memAddress, it->data + offset, available);
+      }
+
+      if (available < size) {
+        memset(memAddress + available, 0, size - available);
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+void SettingsFileMirror_struct::invalidate(const String& fname) {
+  for (auto it = _files.begin(); it != _files.end();) {
+    if (it->fname.equals(fname)) {
+      buffer_free(MemoryBufferClass_e::FileCache, it->data, it->size);
+      it = _files.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void SettingsFileMirror_struct::invalidateAll() {
+  for (auto it = _files.begin(); it != _files.end(); ++it) {
+    buffer_free(MemoryBufferClass_e::FileCache, it->data, it->size);
+  }
+  _files.clear();
+}
+
+size_t SettingsFileMirror_struct::getMirroredSize() const {
+  size_t res = 0;
+
+  for (auto it = _files.begin(); it != _files.end(); ++it) {
+    res += it->size;
+  }
+  return res;
+}
+
+#endif // if FEATURE_SETTINGS_PSRAM_MIRROR
@@ -0,0 +1,66 @@
+#ifndef DATASTRUCTS_SETTINGSFILEMIRROR_H
+#define DATASTRUCTS_SETTINGSFILEMIRROR_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_SETTINGS_PSRAM_MIRROR
+
+# include <FS.h>
+# include <vector>
+
+// Max. size of a single file kept in PSRAM
+# ifndef SETTINGS_MIRROR_MAX_FILE_SIZE
+#  define SETTINGS_MIRROR_MAX_FILE_SIZE  (256 * 1024)
+# endif // ifndef SETTINGS_MIRROR_MAX_FILE_SIZE
+
+
+/*********************************************************************************************\
+* SettingsFileMirror_struct
+* Copy of complete settings files in PSRAM, to load settings without accessing the file system.
+* Opening a file on a large LittleFS partition is slow, which adds up when a page loads all task settings.
+* A mirrored file is invalidated as soon as the file is opened for writing, deleted or renamed.
+\*********************************************************************************************/
+class SettingsFileMirror_struct {
+public:
+
+  ~SettingsFileMirror_struct();
+
+  // Return true when the file can be mirrored.
+  bool canMirror(size_t fileSize) const;
+
+  // Read the whole file into PSRAM.
+  // Return false when the file could not be mirrored.
+  bool load(const String& fname,
+            fs::File    & f);
+
+  // Copy from the mirrored file, like LoadFromFile: Data beyond the end of the file is set to 0.
+  // Return false when the file is not mirrored.
+  bool read(const String& fname,
+            uint32_t      offset,
+            uint8_t      *memAddress,
+            size_t        size) const;
+
+  void invalidate(const String& fname);
+
+  void invalidateAll();
+
+  bool isEmpty() const {
+    return _files.empty();
+  }
+
+  size_t getMirroredSize() const;
+
+private:
+
+  struct MirroredFile {
+    String   fname;
+    uint8_t *data = nullptr;
+    size_t   size = 0;
+  };
+
+  std::vector<MirroredFile> _files;
+};
+
+#endif // if FEATURE_SETTINGS_PSRAM_MIRROR
+
+#endif // ifndef DATASTRUCTS_SETTINGSFILEMIRROR_H
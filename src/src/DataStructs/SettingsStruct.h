@@ -7,7 +7,9 @@
 #include "../CustomBuild/ESPEasyLimits.h"
 #include "../DataStructs/ChecksumType.h"
 #include "../DataStructs/DeviceStruct.h"
+#include "../DataTypes/ControllerIndex.h"
 #include "../DataTypes/EthernetParameters.h"
+#include "../DataTypes/EventQueueOverflowPolicy.h"
 #include "../DataTypes/NetworkMedium.h"
 #include "../DataTypes/NPluginID.h"
 #include "../DataTypes/PluginID.h"
@@ -183,6 +185,39 @@ class SettingsStruct_tmpl
   void DisableRulesCodeCompletion(bool value);
   #endif // if FEATURE_RULES_EASY_COLOR_CODE
 
+  #if FEATURE_RULES_COMPILED
+  // Execute rules from a pre-parsed form instead of parsing the text on each event.
+  bool EnableRulesCompiled() const;
+  void EnableRulesCompiled(bool value);
+  #endif // if FEATURE_RULES_COMPILED
+
+  // What to do with new events when the event queue is full.
+  EventQueueOverflowPolicy_e EventQueueOverflowPolicy() const;
+  void EventQueueOverflowPolicy(EventQueueOverflowPolicy_e value);
+
+  // Max. time in usec to spend on processing queued rules events per loop.
+  uint16_t getRulesEventBudget() const;
+
+  // Do not queue events which cannot match any cached rule.
+  bool EnableRulesEventFilter() const;
+  void EnableRulesEventFilter(bool value);
+
+  #if FEATURE_CONTROLLER_QUEUE_TASK
+  // Process the controller delay queues of HTTP based controllers in a separate task.
+  bool EnableControllerQueueTask() const;
+  void EnableControllerQueueTask(bool value);
+  #endif // if FEATURE_CONTROLLER_QUEUE_TASK
+
+  #if FEATURE_SYSLOG_BUFFER
+  // Send multiple newline separated syslog lines per UDP datagram.
+  bool SyslogBatchLines() const;
+  void SyslogBatchLines(bool value);
+  #endif // if FEATURE_SYSLOG_BUFFER
+
+  // Start web server, mDNS, SSDP, notifications and rules processing after the first task has sent its values.
+  bool FastFirstSample() const;
+  void FastFirstSample(bool value);
+
 
   // Flag indicating whether all task values should be sent in a single event or one event per task value (default behavior)
   bool CombineTaskValues_SingleEvent(taskIndex_t taskIndex) const;
@@ -211,9 +246,33 @@ class SettingsStruct_tmpl
   void    setCssMode(uint8_t value) { VariousBits_1.CssMode = value; }
   #endif // FEATURE_AUTO_DARK_MODE
 
+  // Only send task values to the controller when changed more than the deadband,
+  // or when the max. silence interval has passed.
+  bool     SendOnChange(taskIndex_t taskIndex, controllerIndex_t controllerIndex) const;
+  void     SendOnChange(taskIndex_t taskIndex, controllerIndex_t controllerIndex, bool value);
+
+  // Deadband in steps of the last decimal, e.g. 5 with 2 decimals = 0.05
+  // 0 = send on any change
+  uint8_t  SendOnChangeDeadband(taskIndex_t taskIndex) const;
+  void     SendOnChangeDeadband(taskIndex_t taskIndex, uint8_t value);
+
+  // Max. time in seconds without sending, 0 = no max.
+  uint16_t SendOnChangeMaxSilence(taskIndex_t taskIndex) const;
+  void     SendOnChangeMaxSilence(taskIndex_t taskIndex, uint16_t value);
+
   bool isTaskEnableReadonly(taskIndex_t taskIndex) const;
   void setTaskEnableReadonly(taskIndex_t taskIndex, bool value);
 
+  // Aligned read group, stored in bit 4 ... 7 of VariousTaskBits
+  // 0 = no group, tasks with the same group and interval are read in a single scheduler slot
+  uint8_t getTaskReadGroup(taskIndex_t taskIndex) const;
+  void    setTaskReadGroup(taskIndex_t taskIndex, uint8_t value);
+
+  // I2C clock profile, stored in bit 2 ... 4 of I2C_Flags
+  // 0 = Default, use normal or slow clock speed
+  uint8_t getI2CClockProfile(taskIndex_t taskIndex) const;
+  void    setI2CClockProfile(taskIndex_t taskIndex, uint8_t value);
+
   #if FEATURE_PLUGIN_PRIORITY
   bool isPowerManagerTask(taskIndex_t taskIndex) const;
   void setPowerManagerTask(taskIndex_t taskIndex, bool value);
@@ -285,6 +344,9 @@ public:
   // Return true if I2C settings are correct
   bool isI2CEnabled() const;
 
+  // Return true if the 2nd I2C bus is configured
+  bool isI2C2Enabled() const;
+
   // Return true when pin is one of the fixed Ethernet pins and Ethernet is enabled
   bool isEthernetPin(int8_t pin) const;
 
@@ -346,7 +408,11 @@ public:
   uint8_t       Notification[NOTIFICATION_MAX] = {0}; //notifications, point to a NPLUGIN id
   // FIXME TD-er: Must change to pluginID_t, but then also another check must be added since changing the pluginID_t will also render settings incompatible
   uint8_t       TaskDeviceNumber[N_TASKS] = {0}; // The "plugin number" set at as task (e.g. 4 for P004_dallas)
-  unsigned int  OLD_TaskDeviceID[N_TASKS] = {0};  //UNUSED: this can be reused
+  // Was OLD_TaskDeviceID, cleared in BuildFixes()
+  // Bit 0 ... 3  : Send on change per controller
+  // Bit 8 ... 15 : Deadband, in steps of the last decimal of the task value
+  // Bit 16 ... 31: Max. silence interval in seconds, 0 = no max.
+  unsigned int  TaskSendOnChange[N_TASKS] = {0};
   union {
     struct {
       int8_t        TaskDevicePin1[N_TASKS];
@@ -473,6 +539,12 @@ public:
   int8_t        console_serial_rxpin = DEFAULT_CONSOLE_PORT_RXPIN;
   int8_t        console_serial_txpin = DEFAULT_CONSOLE_PORT_TXPIN;
   uint8_t       console_serial0_fallback = DEFAULT_CONSOLE_SER0_FALLBACK;
+  uint16_t      RulesEventBudget_usec = 0; // 0 = DEFAULT_RULES_EVENT_BUDGET
+  uint32_t      I2C2_clockSpeed = DEFAULT_I2C2_CLOCK_SPEED; // 2nd I2C bus, only used for async I2C transactions on ESP32
+  int8_t        Pin_i2c2_sda = -1;
+  int8_t        Pin_i2c2_scl = -1;
+  uint8_t       P2P_MulticastGroup[4] = {0}; // 0.0.0.0 = use broadcast for the ESPEasy p2p network
+  uint8_t       deepSleep_batchCycles = 0; // Deep sleep batch mode: connect every N-th wake cycle, 0 = every wake cycle
   
   // Try to extend settings to make the checksum 4-uint8_t aligned.
 };
@@ -0,0 +1,129 @@
+#include "../DataStructs/SettingsWriteBack.h"
+
+#if FEATURE_SETTINGS_WRITEBACK
+
+# include "../Helpers/ESPEasy_time_calc.h"
+
+bool SettingsWriteBack_struct::fits(size_t size) const {
+  return (_bufferedSize + size) <= SETTINGS_WRITEBACK_MAX_SIZE;
+}
+
+void SettingsWriteBack_struct::add(const String & fname,
+                                   uint32_t       offset,
+                                   const uint8_t *data,
+                                   size_t         size)
+{
+  if (size == 0) {
+    return;
+  }
+  uint32_t start = offset;
+  uint32_t end   = offset + size;
+
+  // Skip to the ranges of this file
+  auto first = _ranges.begin();
+
+  while (first != _ranges.end() && (first->fname != fname)) {
+    ++first;
+  }
+
+  // Skip the ranges of this file before the new data
+  while (first != _ranges.end() && (first->fname == fname) && (first->end() < start)) {
+    ++first;
+  }
+  auto last = first;
+
+  while (last != _ranges.end() && (last->fname == fname) && (last->offset <= end)) {
+    if (last->offset < start) { start = last->offset; }
+
+    if (last->end() > end) { end = last->end(); }
+    ++last;
+  }
+
+  SettingsWriteBack_range range;
+
+  range.fname  = fname;
+  range.offset = start;
+  range.data.resize(end - start, 0);
+
+  // First copy the existing ranges, then the new data on top.
+  for (auto it = first; it != last; ++it) {
+    memcpy(&range.data[it->offset - start], it->data.data(), it->data.size());
+    _bufferedSize -= it->data.size();
+  }
+
+  if (data != nullptr) {
+    memcpy(&range.data[offset - start], data, size);
+  } else {
+    memset(&range.data[offset - start], 0, size);
+  }
+  _bufferedSize += range.data.size();
+
+  // Replace the merged ranges, this keeps the ranges of the same file together, sorted by offset.
+  auto pos = _ranges.erase(first, last);
+
+  _ranges.insert(pos, std::move(range));
+
+  if (_firstChange == 0) {
+    _firstChange = millis();
+  }
+  _lastChange = millis();
+}
+
+void SettingsWriteBack_struct::overlay(const String& fname,
+                                       uint32_t      offset,
+                                       uint8_t      *memAddress,
+                                       size_t        size) const
+{
+  const uint32_t end = offset + size;
+
+  for (auto it = _ranges.begin(); it != _ranges.end(); ++it) {
+    if ((it->fname == fname) && (it->offset < end) && (it->end() > offset)) {
+      const uint32_t from = (it->offset > offset) ? it->offset : offset;
+      const uint32_t to   = (it->end() < end) ? it->end() : end;
+      memcpy(memAddress + (from - offset), &it->data[from - it->offset], to - from);
+    }
+  }
+}
+
+bool SettingsWriteBack_struct::isDirty(const String& fname) const {
+  for (auto it = _ranges.begin(); it != _ranges.end(); ++it) {
+    if (it->fname == fname) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void SettingsWriteBack_struct::discard(const String& fname) {
+  auto it = _ranges.begin();
+
+  while (it != _ranges.end()) {
+    if (it->fname == fname) {
+      _bufferedSize -= it->data.size();
+      it             = _ranges.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  if (_ranges.empty()) {
+    clear();
+  }
+}
+
+void SettingsWriteBack_struct::clear() {
+  _ranges.clear();
+  _bufferedSize = 0;
+  _firstChange  = 0;
+  _lastChange   = 0;
+}
+
+bool SettingsWriteBack_struct::commitDue() const {
+  if (!isDirty()) {
+    return false;
+  }
+  return timePassedSince(_lastChange) >= SETTINGS_WRITEBACK_TIMEOUT ||
+         timePassedSince(_firstChange) >= SETTINGS_WRITEBACK_MAX_AGE;
+}
+
+#endif // if FEATURE_SETTINGS_WRITEBACK
@@ -0,0 +1,102 @@
+#ifndef DATASTRUCTS_SETTINGSWRITEBACK_H
+#define DATASTRUCTS_SETTINGSWRITEBACK_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_SETTINGS_WRITEBACK
+
+# include <vector>
+
+// Max. nr of bytes kept in RAM before the buffered writes are committed
+# ifndef SETTINGS_WRITEBACK_MAX_SIZE
+#  ifdef ESP8266
+#   define SETTINGS_WRITEBACK_MAX_SIZE  4096
+#  else // ifdef ESP8266
+#   define SETTINGS_WRITEBACK_MAX_SIZE  16384
+#  endif // ifdef ESP8266
+# endif // ifndef SETTINGS_WRITEBACK_MAX_SIZE
+
+// Time in msec without new writes before the buffered writes are committed
+# ifndef SETTINGS_WRITEBACK_TIMEOUT
+#  define SETTINGS_WRITEBACK_TIMEOUT    500
+# endif // ifndef SETTINGS_WRITEBACK_TIMEOUT
+
+// Max. time in msec data may be kept in RAM, even when writes keep coming in.
+# ifndef SETTINGS_WRITEBACK_MAX_AGE
+#  define SETTINGS_WRITEBACK_MAX_AGE    3000
+# endif // ifndef SETTINGS_WRITEBACK_MAX_AGE
+
+// Flash erase size, used to estimate the nr of erase cycles of a commit
+# ifndef SETTINGS_WRITEBACK_SECTOR_SIZE
+#  define SETTINGS_WRITEBACK_SECTOR_SIZE  4096
+# endif // ifndef SETTINGS_WRITEBACK_SECTOR_SIZE
+
+struct SettingsWriteBack_range {
+  uint32_t end() const {
+    return offset + data.size();
+  }
+
+  String               fname;
+  uint32_t             offset = 0;
+  std::vector<uint8_t> data;
+};
+
+
+/*********************************************************************************************\
+* SettingsWriteBack_struct
+* Dirty ranges of the settings files, kept in RAM until committed.
+* Overlapping and adjacent ranges of the same file are merged.
+* Ranges are kept sorted per file and offset, so a commit can write each file in a single sequential pass.
+\*********************************************************************************************/
+class SettingsWriteBack_struct {
+public:
+
+  // Return true when the data can be added without exceeding SETTINGS_WRITEBACK_MAX_SIZE
+  bool fits(size_t size) const;
+
+  // Add data to be written to the file.
+  // @param data  When nullptr, the range is cleared (set to 0)
+  void add(const String & fname,
+           uint32_t       offset,
+           const uint8_t *data,
+           size_t         size);
+
+  // Copy the buffered data within the given range of the file into memAddress.
+  void overlay(const String& fname,
+               uint32_t      offset,
+               uint8_t      *memAddress,
+               size_t        size) const;
+
+  bool isDirty() const {
+    return !_ranges.empty();
+  }
+
+  bool isDirty(const String& fname) const;
+
+  // Forget buffered data of a file, e.g. when it is deleted or truncated.
+  void discard(const String& fname);
+
+  void clear();
+
+  // Return true when the buffered data should be committed, based on time.
+  bool commitDue() const;
+
+  const std::vector<SettingsWriteBack_range>& getRanges() const {
+    return _ranges;
+  }
+
+  size_t getBufferedSize() const {
+    return _bufferedSize;
+  }
+
+private:
+
+  std::vector<SettingsWriteBack_range> _ranges;
+  size_t                               _bufferedSize = 0;
+  unsigned long                        _firstChange  = 0;
+  unsigned long                        _lastChange   = 0;
+};
+
+#endif // if FEATURE_SETTINGS_WRITEBACK
+
+#endif // ifndef DATASTRUCTS_SETTINGSWRITEBACK_H
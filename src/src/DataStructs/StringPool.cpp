@@ -0,0 +1,110 @@
+#include "../DataStructs/StringPool.h"
+
+uint32_t StringPool::hash(const String& str, uint32_t hash)
+{
+  return StringPool::hash(str.c_str(), str.length(), hash);
+}
+
+uint32_t StringPool::hash(const char *str, size_t length, uint32_t hash)
+{
+  for (size_t i = 0; i < length; ++i) {
+    hash ^= static_cast<uint8_t>(tolower(str[i]));
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+StringPool_handle_t StringPool::add(const char *str)
+{
+  return add(str, (str == nullptr) ? 0 : strlen(str));
+}
+
+StringPool_handle_t StringPool::add(const char *str, size_t length)
+{
+  StringPool_handle_t handle;
+
+  if ((str == nullptr) || (length == 0)) {
+    handle.hash = hash(str, 0);
+    return handle;
+  }
+
+  if (length > 255) {
+    length = 255;
+  }
+  handle.hash   = hash(str, length);
+  handle.length = length;
+
+  // Look for an identical string
+  size_t pos = 0;
+
+  while (pos < _data.size()) {
+    const size_t curLength = strlen(&_data[pos]);
+
+    if ((curLength == length) && (memcmp(&_data[pos], str, length) == 0)) {
+      handle.offset = pos;
+      return handle;
+    }
+    pos += curLength + 1;
+  }
+
+  if ((_data.size() + length + 1) > 0xFFFF) {
+    // Offset does not fit
+    handle.length = 0;
+    return handle;
+  }
+  handle.offset = _data.size();
+  _data.insert(_data.end(), str, str + length);
+  _data.push_back('\0');
+  return handle;
+}
+
+StringPool_handle_t StringPool::add(const StringPool& source, const StringPool_handle_t& handle)
+{
+  if (handle.length == 0) {
+    return handle;
+  }
+  return add(source.c_str(handle), handle.length);
+}
+
+void StringPool::release(const StringPool_handle_t& handle)
+{
+  if (handle.length != 0) {
+    _released += handle.length + 1;
+  }
+}
+
+String StringPool::get(const StringPool_handle_t& handle) const
+{
+  if (handle.length == 0) {
+    return EMPTY_STRING;
+  }
+  return String(c_str(handle));
+}
+
+const char * StringPool::c_str(const StringPool_handle_t& handle) const
+{
+  if ((handle.length == 0) || (handle.offset >= _data.size())) {
+    return "";
+  }
+  return &_data[handle.offset];
+}
+
+bool StringPool::equalsIgnoreCase(const StringPool_handle_t& handle, const String& str, uint32_t strHash) const
+{
+  if ((handle.hash != strHash) || (handle.length != str.length())) {
+    return false;
+  }
+  return strncasecmp(c_str(handle), str.c_str(), handle.length) == 0;
+}
+
+bool StringPool::needsCompaction() const
+{
+  return (_released >= STRING_POOL_COMPACT_THRESHOLD) && ((2 * _released) > _data.size());
+}
+
+void StringPool::clear()
+{
+  _data.clear();
+  _data.shrink_to_fit();
+  _released = 0;
+}
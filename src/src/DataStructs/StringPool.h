@@ -0,0 +1,81 @@
+#ifndef DATASTRUCTS_STRINGPOOL_H
+#define DATASTRUCTS_STRINGPOOL_H
+
+#include "../../ESPEasy_common.h"
+
+#include <vector>
+
+// Minimum nr of unused bytes before the pool is worth compacting.
+#ifndef STRING_POOL_COMPACT_THRESHOLD
+# define STRING_POOL_COMPACT_THRESHOLD  256
+#endif // ifndef STRING_POOL_COMPACT_THRESHOLD
+
+// Reference to a string in a StringPool.
+struct StringPool_handle_t {
+  uint32_t hash   = 0; // Case insensitive FNV-1a hash, see StringPool::hash()
+  uint16_t offset = 0;
+  uint8_t  length = 0;
+};
+
+/*********************************************************************************************\
+* StringPool
+* Append-only storage of short strings, like task names and task value names.
+* All strings are kept zero terminated in a single buffer, instead of a heap allocation per String.
+* Identical strings are stored only once.
+* Released strings remain in the buffer, until the owner compacts the pool by copying
+* all strings still in use to a new pool.
+\*********************************************************************************************/
+class StringPool {
+public:
+
+  // Case insensitive FNV-1a hash, so no lower case copy is needed.
+  static uint32_t     hash(const String& str,
+                           uint32_t      hash = 2166136261u);
+
+  static uint32_t     hash(const char *str,
+                           size_t      length,
+                           uint32_t    hash = 2166136261u);
+
+  // Add a string, or return the handle of an identical string already present.
+  // Strings are truncated to 255 chars.
+  StringPool_handle_t add(const char *str);
+
+  StringPool_handle_t add(const char *str,
+                          size_t      length);
+
+  // Add a string from another pool, used to compact a pool.
+  StringPool_handle_t add(const StringPool         & source,
+                          const StringPool_handle_t& handle);
+
+  // Mark the string as no longer used by the caller.
+  void                release(const StringPool_handle_t& handle);
+
+  String              get(const StringPool_handle_t& handle) const;
+
+  const char*         c_str(const StringPool_handle_t& handle) const;
+
+  // Case insensitive compare, using the hash to skip most non matching strings.
+  // @param strHash  Hash of str, as returned by hash()
+  bool                equalsIgnoreCase(const StringPool_handle_t& handle,
+                                       const String             & str,
+                                       uint32_t                   strHash) const;
+
+  // Whether enough strings are released to make compacting worthwhile
+  bool                needsCompaction() const;
+
+  size_t              size() const {
+    return _data.size();
+  }
+
+  void                clear();
+
+private:
+
+  std::vector<char> _data;
+
+  // Estimate of the nr of bytes no longer in use.
+  // Identical strings are shared, so this may be larger than the actual nr.
+  size_t _released = 0;
+};
+
+#endif // ifndef DATASTRUCTS_STRINGPOOL_H
@@ -4,12 +4,24 @@
 
 # include "../DataTypes/ESPEasy_plugin_functions.h"
 # include "../Globals/CPlugins.h"
+# include "../Helpers/ControllerQueueTask.h"
 # include "../Helpers/_CPlugin_Helper.h"
 # include "../Helpers/StringConverter.h"
 
+# if FEATURE_TIMING_STATS_HISTOGRAM
+static const uint32_t timingStatsBucketUpperBounds[TIMING_STATS_HISTOGRAM_BUCKETS - 1] = {
+  10,     20,     50,
+  100,    200,    500,
+  1000,   2000,   5000,
+  10000,  20000,  50000,
+  100000, 200000, 500000
+};
+# endif // if FEATURE_TIMING_STATS_HISTOGRAM
+
 std::map<int, TimingStats> pluginStats;
 std::map<int, TimingStats> controllerStats;
 std::map<TimingStatsElements, TimingStats> miscStats;
+std::map<uint32_t, SchedulerLatenessStats> schedulerLatenessStats;
 unsigned long timingstats_last_reset(0);
 
 
@@ -22,6 +34,17 @@ void TimingStats::add(int64_t time) {
   if (time > static_cast<int64_t>(_maxVal)) { _maxVal = time; }
 
   if (time < static_cast<int64_t>(_minVal)) { _minVal = time; }
+
+# if FEATURE_TIMING_STATS_HISTOGRAM
+  uint8_t bucket = 0;
+
+  // Most values are small, so a linear search from the start is fastest.
+  while ((bucket < (TIMING_STATS_HISTOGRAM_BUCKETS - 1)) &&
+         (time > static_cast<int64_t>(timingStatsBucketUpperBounds[bucket]))) {
+    ++bucket;
+  }
+  ++_buckets[bucket];
+# endif // if FEATURE_TIMING_STATS_HISTOGRAM
 }
 
 void TimingStats::reset() {
@@ -29,6 +52,12 @@ void TimingStats::reset() {
   _count     = 0;
   _maxVal    = 0;
   _minVal    = 4294967295;
+# if FEATURE_TIMING_STATS_HISTOGRAM
+
+  for (uint8_t i = 0; i < TIMING_STATS_HISTOGRAM_BUCKETS; ++i) {
+    _buckets[i] = 0;
+  }
+# endif // if FEATURE_TIMING_STATS_HISTOGRAM
 }
 
 bool TimingStats::isEmpty() const {
@@ -58,6 +87,54 @@ bool TimingStats::thresholdExceeded(const uint64_t& threshold) const {
   return _maxVal > threshold;
 }
 
+# if FEATURE_TIMING_STATS_HISTOGRAM
+uint32_t TimingStats::getBucketCount(uint8_t bucket) const {
+  if (bucket >= TIMING_STATS_HISTOGRAM_BUCKETS) { return 0; }
+  return _buckets[bucket];
+}
+
+uint32_t TimingStats::getBucketUpperBound(uint8_t bucket) {
+  if (bucket >= (TIMING_STATS_HISTOGRAM_BUCKETS - 1)) { return 0; }
+  return timingStatsBucketUpperBounds[bucket];
+}
+
+float TimingStats::getPercentile(uint8_t percentile) const {
+  if (_count == 0) { return 0.0f; }
+
+  if (percentile > 100) { percentile = 100; }
+
+  // Rank of the requested value, 1 ... _count
+  uint32_t rank = (static_cast<uint64_t>(_count) * percentile + 99) / 100;
+
+  if (rank == 0) { rank = 1; }
+
+  uint32_t cumulative = 0;
+
+  for (uint8_t bucket = 0; bucket < TIMING_STATS_HISTOGRAM_BUCKETS; ++bucket) {
+    const uint32_t bucketCount = _buckets[bucket];
+
+    if ((cumulative + bucketCount) >= rank) {
+      // Value range of this bucket, limited by the actual min and max values.
+      float lower = (bucket == 0) ? 0.0f : static_cast<float>(timingStatsBucketUpperBounds[bucket - 1]);
+      float upper = (bucket == (TIMING_STATS_HISTOGRAM_BUCKETS - 1))
+                    ? static_cast<float>(_maxVal)
+                    : static_cast<float>(timingStatsBucketUpperBounds[bucket]);
+
+      if (lower < static_cast<float>(_minVal)) { lower = static_cast<float>(_minVal); }
+
+      if (upper > static_cast<float>(_maxVal)) { upper = static_cast<float>(_maxVal); }
+
+      if (upper < lower) { upper = lower; }
+
+      return lower + (upper - lower) * static_cast<float>(rank - cumulative) / static_cast<float>(bucketCount);
+    }
+    cumulative += bucketCount;
+  }
+  return static_cast<float>(_maxVal);
+}
+
+# endif // if FEATURE_TIMING_STATS_HISTOGRAM
+
 /********************************************************************************************\
    Functions used for displaying timing stats
  \*********************************************************************************************/
@@ -219,6 +296,8 @@ const __FlashStringHelper* getMiscStatsName_F(TimingStatsElements stat) {
     case TimingStatsElements::SEND_DATA_STATS:            return F("sendData()");
     case TimingStatsElements::COMPUTE_FORMULA_STATS:      return F("Compute formula");
     case TimingStatsElements::COMPUTE_STATS:              return F("Compute()");
+    case TimingStatsElements::COMPUTE_CACHE_HIT:          return F("Compute() (cached)");
+    case TimingStatsElements::COMPUTE_CACHE_MISS:         return F("Compute() (not cached)");
     case TimingStatsElements::PLUGIN_CALL_DEVICETIMER_IN: return F("PLUGIN_DEVICETIMER_IN");
     case TimingStatsElements::SET_NEW_TIMER:              return F("setNewTimerAt()");
     case TimingStatsElements::MQTT_DELAY_QUEUE:           return F("Delay queue MQTT");
@@ -230,6 +309,9 @@ const __FlashStringHelper* getMiscStatsName_F(TimingStatsElements stat) {
     case TimingStatsElements::WIFI_ISCONNECTED_STATS:     return F("WiFi.isConnected()");
     case TimingStatsElements::WIFI_NOTCONNECTED_STATS:    return F("WiFi.isConnected() (fail)");
     case TimingStatsElements::LOAD_TASK_SETTINGS:         return F("LoadTaskSettings()");
+    #if FEATURE_EXTRA_TASK_SETTINGS_LRU
+    case TimingStatsElements::LOAD_TASK_SETTINGS_C:       return F("LoadTaskSettings() (cached)");
+    #endif
     case TimingStatsElements::SAVE_TASK_SETTINGS:         return F("SaveTaskSettings()");
     case TimingStatsElements::LOAD_CONTROLLER_SETTINGS:   return F("LoadControllerSettings()");
     #ifdef ESP32
@@ -241,9 +323,13 @@ const __FlashStringHelper* getMiscStatsName_F(TimingStatsElements stat) {
     case TimingStatsElements::FS_GC_FAIL:                 return F("ESPEASY_FS GC fail");
     case TimingStatsElements::RULES_PROCESSING:           return F("rulesProcessing()");
     case TimingStatsElements::RULES_PARSE_LINE:           return F("parseCompleteNonCommentLine()");
+    case TimingStatsElements::RULES_COMPILE:              return F("compileRules()");
+    case TimingStatsElements::RULES_EVENT_QUEUE_PASS:     return F("processEventQueue()");
+    case TimingStatsElements::RULES_EVENT_QUEUE_DEPTH:    return F("Rules event queue depth (not usec)");
     case TimingStatsElements::RULES_PROCESS_MATCHED:      return F("processMatchedRule()");
     case TimingStatsElements::RULES_MATCH:                return F("rulesMatch()");
     case TimingStatsElements::GRAT_ARP_STATS:             return F("sendGratuitousARP()");
+    case TimingStatsElements::CHECK_UDP:                  return F("checkUDP()");
     case TimingStatsElements::SAVE_TO_RTC:                return F("saveToRTC()");
     case TimingStatsElements::BACKGROUND_TASKS:           return F("backgroundtasks()");
     case TimingStatsElements::PROCESS_SYSTEM_EVENT_QUEUE: return F("process_system_event_queue()");
@@ -253,6 +339,7 @@ const __FlashStringHelper* getMiscStatsName_F(TimingStatsElements stat) {
     case TimingStatsElements::HANDLE_SCHEDULER_IDLE:      return F("handle_schedule() idle");
     case TimingStatsElements::HANDLE_SCHEDULER_TASK:      return F("handle_schedule() task");
     case TimingStatsElements::PARSE_TEMPLATE_PADDED:      return F("parseTemplate_padded()");
+    case TimingStatsElements::PARSE_TEMPLATE_CACHED:      return F("parseTemplate (compiled)");
     case TimingStatsElements::PARSE_SYSVAR:               return F("parseSystemVariables()");
     case TimingStatsElements::PARSE_SYSVAR_NOCHANGE:      return F("parseSystemVariables() No change");
     case TimingStatsElements::HANDLE_SERVING_WEBPAGE:     return F("handle webpage");
@@ -309,24 +396,44 @@ String getMiscStatsName(TimingStatsElements stat) {
   return getMiscStatsName_F(static_cast<TimingStatsElements>(stat));
 }
 
+// The stats are only collected from the main loop, as they are not thread safe.
+inline bool timingStatsMayCollect()
+{
+  # if FEATURE_CONTROLLER_QUEUE_TASK
+  return !controllerQueueTask_isWorker();
+  # else // if FEATURE_CONTROLLER_QUEUE_TASK
+  return true;
+  # endif // if FEATURE_CONTROLLER_QUEUE_TASK
+}
+
 void stopTimerTask(deviceIndex_t T, int F, uint64_t statisticsTimerStart)
 {
-  if (mustLogFunction(F)) { pluginStats[static_cast<int>(T.value) * 256 + (F)].add(usecPassedSince(statisticsTimerStart)); }
+  if (mustLogFunction(F) && timingStatsMayCollect()) { pluginStats[static_cast<int>(T.value) * 256 + (F)].add(usecPassedSince(statisticsTimerStart)); }
 }
 
 void stopTimerController(protocolIndex_t T, CPlugin::Function F, uint64_t statisticsTimerStart)
 {
-  if (mustLogCFunction(F)) { controllerStats[static_cast<int>(T) * 256 + static_cast<int>(F)].add(usecPassedSince(statisticsTimerStart)); }
+  if (mustLogCFunction(F) && timingStatsMayCollect()) { controllerStats[static_cast<int>(T) * 256 + static_cast<int>(F)].add(usecPassedSince(statisticsTimerStart)); }
 }
 
 void stopTimer(TimingStatsElements L, uint64_t statisticsTimerStart)
 {
-  if (Settings.EnableTimingStats()) { miscStats[L].add(usecPassedSince(statisticsTimerStart)); }
+  if (Settings.EnableTimingStats() && timingStatsMayCollect()) { miscStats[L].add(usecPassedSince(statisticsTimerStart)); }
 }
 
 void addMiscTimerStat(TimingStatsElements L, int64_t T)
 {
-  if (Settings.EnableTimingStats()) { miscStats[L].add(T); }
+  if (Settings.EnableTimingStats() && timingStatsMayCollect()) { miscStats[L].add(T); }
+}
+
+void addSchedulerLateness(uint32_t key, int64_t lateness_usec)
+{
+  if (Settings.EnableTimingStats() && timingStatsMayCollect()) { schedulerLatenessStats[key].lateness.add(lateness_usec); }
+}
+
+void addSchedulerResync(uint32_t key)
+{
+  if (Settings.EnableTimingStats() && timingStatsMayCollect()) { ++schedulerLatenessStats[key].resyncCount; }
 }
 
 #endif // if FEATURE_TIMING_STATS
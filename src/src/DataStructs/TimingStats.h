@@ -64,9 +64,12 @@ enum class TimingStatsElements {
   SEND_DATA_STATS,
   COMPUTE_FORMULA_STATS,
   COMPUTE_STATS,
+  COMPUTE_CACHE_HIT,
+  COMPUTE_CACHE_MISS,
   PARSE_SYSVAR,
   PARSE_SYSVAR_NOCHANGE,
   PARSE_TEMPLATE_PADDED,
+  PARSE_TEMPLATE_CACHED,
   IS_NUMERICAL,
   GET_TASKVALUE_AS_STRING,
   FORMAT_USER_VAR,
@@ -75,6 +78,9 @@ enum class TimingStatsElements {
   RULES_PROCESSING,
   RULES_PROCESS_MATCHED,
   RULES_PARSE_LINE,
+  RULES_COMPILE,
+  RULES_EVENT_QUEUE_PASS,
+  RULES_EVENT_QUEUE_DEPTH,
   COMMAND_EXEC_INTERNAL,
   CONSOLE_LOOP,
   CONSOLE_WRITE_SERIAL,
@@ -82,6 +88,9 @@ enum class TimingStatsElements {
   // Related to file access
   LOADFILE_STATS,
   LOAD_TASK_SETTINGS,
+  #if FEATURE_EXTRA_TASK_SETTINGS_LRU
+  LOAD_TASK_SETTINGS_C,
+  #endif
   LOAD_CUSTOM_TASK_STATS,
   LOAD_CONTROLLER_SETTINGS,
   #ifdef ESP32
@@ -111,6 +120,7 @@ enum class TimingStatsElements {
   TRY_CONNECT_HOST_UDP,
   HOST_BY_NAME_STATS,
   GRAT_ARP_STATS,
+  CHECK_UDP,
   WIFI_ISCONNECTED_STATS,
   WIFI_NOTCONNECTED_STATS,
   CONNECT_CLIENT_STATS,
@@ -128,6 +138,13 @@ enum class TimingStatsElements {
 
 #if FEATURE_TIMING_STATS
 
+# if FEATURE_TIMING_STATS_HISTOGRAM
+
+// Log-scale histogram buckets with upper bounds in 1-2-5 steps from 10 usec ... 500 msec
+// and a last bucket for all larger values.
+#  define TIMING_STATS_HISTOGRAM_BUCKETS  16
+# endif // if FEATURE_TIMING_STATS_HISTOGRAM
+
 class TimingStats {
 public:
 
@@ -141,12 +158,30 @@ public:
                      uint64_t& maxVal) const;
   bool     thresholdExceeded(const uint64_t& threshold) const;
 
+  // Sum of all added values
+  float    getSum() const { return _timeTotal; }
+
+# if FEATURE_TIMING_STATS_HISTOGRAM
+
+  // Number of added values in the given bucket (not cumulative)
+  uint32_t getBucketCount(uint8_t bucket) const;
+
+  // Upper bound (inclusive) of the bucket, 0 for the last bucket which is unbounded.
+  static uint32_t getBucketUpperBound(uint8_t bucket);
+
+  // Estimate of the given percentile (0 ... 100), interpolated within the bucket.
+  float    getPercentile(uint8_t percentile) const;
+# endif // if FEATURE_TIMING_STATS_HISTOGRAM
+
 private:
 
   float _timeTotal;
   uint32_t _count;
   uint64_t _maxVal;
   uint64_t _minVal;
+# if FEATURE_TIMING_STATS_HISTOGRAM
+  uint32_t _buckets[TIMING_STATS_HISTOGRAM_BUCKETS]{};
+# endif // if FEATURE_TIMING_STATS_HISTOGRAM
 };
 
 
@@ -167,9 +202,23 @@ void                       stopTimer(TimingStatsElements L,
 void                       addMiscTimerStat(TimingStatsElements L,
                                             int64_t             T);
 
+// Lateness of scheduled timers (actual - scheduled run time) in usec.
+// Collected per timer type, per task for task device timers and per interval timer.
+struct SchedulerLatenessStats {
+  TimingStats lateness;
+
+  // Number of times an interval was restarted as more than 1 full interval was missed.
+  uint32_t    resyncCount = 0;
+};
+
+void addSchedulerLateness(uint32_t key,
+                          int64_t  lateness_usec);
+void addSchedulerResync(uint32_t key);
+
 extern std::map<int, TimingStats> pluginStats;
 extern std::map<int, TimingStats> controllerStats;
 extern std::map<TimingStatsElements, TimingStats> miscStats;
+extern std::map<uint32_t, SchedulerLatenessStats> schedulerLatenessStats;
 extern unsigned long timingstats_last_reset;
 
 # define START_TIMER const uint64_t statisticsTimerStart(getMicros64());
@@ -183,6 +232,9 @@ extern unsigned long timingstats_last_reset;
 // Add a timer statistic value in usec.
 # define ADD_TIMER_STAT(L, T) addMiscTimerStat(TimingStatsElements::L, T);
 
+# define ADD_SCHEDULER_LATENESS(K, T) addSchedulerLateness(K, T);
+# define ADD_SCHEDULER_RESYNC(K) addSchedulerResync(K);
+
 #else // if FEATURE_TIMING_STATS
 
 # define START_TIMER ;
@@ -190,6 +242,8 @@ extern unsigned long timingstats_last_reset;
 # define STOP_TIMER_CONTROLLER(T, F) ;
 # define STOP_TIMER(L) ;
 # define ADD_TIMER_STAT(L, T) ;
+# define ADD_SCHEDULER_LATENESS(K, T) ;
+# define ADD_SCHEDULER_RESYNC(K) ;
 
 
 // FIXME TD-er: This class is used as a parameter in functions defined in .ino files.
@@ -1,13 +1,18 @@
 #include "../DataStructs/UserVarStruct.h"
 
 #include "../ESPEasyCore/ESPEasy_Log.h"
+#include "../Globals/Cache.h"
 #include "../Globals/Plugins.h"
 #include "../Helpers/_Plugin_SensorTypeHelper.h"
 #include "../Helpers/CRC_functions.h"
+#include "../Helpers/ESPEasy_time_calc.h"
 
 UserVarStruct::UserVarStruct()
 {
   _data.resize(TASKS_MAX);
+#if FEATURE_TASKVALUE_SNAPSHOT
+  _snapshots.resize(TASKS_MAX);
+#endif // if FEATURE_TASKVALUE_SNAPSHOT
 }
 
 void UserVarStruct::clear()
@@ -241,3 +246,162 @@ uint32_t UserVarStruct::compute_CRC32() const
 
   return calc_CRC32(buffer, size);
 }
+
+#if FEATURE_JSON_DELTA
+void UserVarStruct::enableChangeTracking()
+{
+  if (changeTrackingEnabled()) { return; }
+
+  // All values are considered changed since sequence 0
+  _lastChangeSequence = 1;
+  _previousData       = _data;
+  _changeSequences.resize(_data.size() * VARS_PER_TASK, _lastChangeSequence);
+}
+
+void UserVarStruct::markUpdated(taskIndex_t taskIndex, Sensor_VType sensorType)
+{
+  if (!changeTrackingEnabled() || (taskIndex >= _data.size())) {
+    return;
+  }
+  const uint8_t *current  = _data[taskIndex].binary;
+  uint8_t       *previous = _previousData[taskIndex].binary;
+
+  // 64 bit values take 2 floats
+  const size_t valueSize = is32bitOutputDataType(sensorType) ? sizeof(float) : 2 * sizeof(float);
+
+  // String values are not stored in UserVar, so always consider those changed.
+  const bool alwaysChanged = sensorType == Sensor_VType::SENSOR_TYPE_STRING;
+  bool newSequence         = false;
+
+  for (uint8_t varNr = 0; ((varNr + 1) * valueSize) <= sizeof(TaskValues_Data_t::binary); ++varNr) {
+    const size_t offset = varNr * valueSize;
+
+    if (alwaysChanged || (memcmp(&current[offset], &previous[offset], valueSize) != 0)) {
+      if (!newSequence) {
+        ++_lastChangeSequence;
+        newSequence = true;
+      }
+      _changeSequences[taskIndex * VARS_PER_TASK + varNr] = _lastChangeSequence;
+    }
+  }
+  memcpy(previous, current, sizeof(TaskValues_Data_t::binary));
+}
+
+uint32_t UserVarStruct::getChangeSequence(taskIndex_t taskIndex, uint8_t varNr) const
+{
+  const size_t index = taskIndex * VARS_PER_TASK + varNr;
+
+  if ((varNr < VARS_PER_TASK) && (index < _changeSequences.size())) {
+    return _changeSequences[index];
+  }
+  return 0;
+}
+
+#endif // if FEATURE_JSON_DELTA
+
+#if FEATURE_SEND_ON_CHANGE
+bool UserVarStruct::mustSendToController(
+  taskIndex_t       taskIndex,
+  controllerIndex_t controllerIndex,
+  Sensor_VType      sensorType,
+  uint8_t           valueCount,
+  uint8_t           deadbandSteps,
+  uint32_t          maxSilence_ms)
+{
+  if ((taskIndex >= _data.size()) || (controllerIndex >= CONTROLLER_MAX)) {
+    return true;
+  }
+  const uint16_t key = taskIndex * CONTROLLER_MAX + controllerIndex;
+  auto it            = _lastSent.find(key);
+
+  bool mustSend = (it == _lastSent.end()) ||
+
+                  // String values are not stored in UserVar, so always consider those changed.
+                  (sensorType == Sensor_VType::SENSOR_TYPE_STRING) ||
+                  ((maxSilence_ms != 0) && (timePassedSince(it->second.timestamp) >= static_cast<long>(maxSilence_ms)));
+
+  for (uint8_t varNr = 0; !mustSend && varNr < valueCount && varNr < VARS_PER_TASK; ++varNr) {
+    const ESPEASY_RULES_FLOAT_TYPE current  = _data[taskIndex].getAsDouble(varNr, sensorType);
+    const ESPEASY_RULES_FLOAT_TYPE lastSent = it->second.values.getAsDouble(varNr, sensorType);
+
+    if (deadbandSteps == 0) {
+      mustSend = current != lastSent;
+    } else {
+      ESPEASY_RULES_FLOAT_TYPE deadband = deadbandSteps;
+
+      for (uint8_t i = 0; i < Cache.getTaskDeviceValueDecimals(taskIndex, varNr); ++i) {
+        deadband /= 10;
+      }
+
+      mustSend = (current - lastSent >= deadband) || (lastSent - current >= deadband);
+    }
+  }
+
+  if (mustSend) {
+    LastSent_t& lastSent = _lastSent[key];
+    lastSent.values    = _data[taskIndex];
+    lastSent.timestamp = millis();
+  }
+  return mustSend;
+}
+
+void UserVarStruct::clearLastSent(taskIndex_t taskIndex)
+{
+  for (controllerIndex_t controllerIndex = 0; controllerIndex < CONTROLLER_MAX; ++controllerIndex) {
+    _lastSent.erase(taskIndex * CONTROLLER_MAX + controllerIndex);
+  }
+}
+
+#endif // if FEATURE_SEND_ON_CHANGE
+
+#if FEATURE_TASKVALUE_SNAPSHOT
+void UserVarStruct::publishSnapshot(taskIndex_t taskIndex, Sensor_VType sensorType)
+{
+  if (taskIndex >= _snapshots.size()) {
+    return;
+  }
+  Snapshot_t& snapshot = _snapshots[taskIndex];
+
+  const uint32_t sequence = __atomic_load_n(&snapshot.sequence, __ATOMIC_RELAXED);
+
+  // Odd sequence marks a write in progress
+  __atomic_store_n(&snapshot.sequence, sequence + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+
+  snapshot.values     = _data[taskIndex];
+  snapshot.sensorType = sensorType;
+
+  __atomic_store_n(&snapshot.sequence, sequence + 2, __ATOMIC_RELEASE);
+}
+
+bool UserVarStruct::getSnapshot(taskIndex_t taskIndex, TaskValues_Data_t& values, Sensor_VType& sensorType) const
+{
+  if (taskIndex >= _snapshots.size()) {
+    return false;
+  }
+  const Snapshot_t& snapshot = _snapshots[taskIndex];
+
+  // Writer only copies a few bytes, so a retry is rarely needed.
+  constexpr uint8_t maxAttempts = 8;
+
+  for (uint8_t attempt = 0; attempt < maxAttempts; ++attempt) {
+    const uint32_t before = __atomic_load_n(&snapshot.sequence, __ATOMIC_ACQUIRE);
+
+    if (before == 0) {
+      return false;
+    }
+
+    if ((before & 1) == 0) {
+      values     = snapshot.values;
+      sensorType = snapshot.sensorType;
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+      if (__atomic_load_n(&snapshot.sequence, __ATOMIC_RELAXED) == before) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+#endif // if FEATURE_TASKVALUE_SNAPSHOT
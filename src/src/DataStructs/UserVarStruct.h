@@ -5,9 +5,11 @@
 
 #include "../DataStructs/DeviceStruct.h"
 
+#include "../DataTypes/ControllerIndex.h"
 #include "../DataTypes/TaskIndex.h"
 #include "../DataTypes/TaskValues_Data.h"
 
+#include <map>
 #include <vector>
 
 struct UserVarStruct {
@@ -101,9 +103,94 @@ struct UserVarStruct {
 
   uint32_t                 compute_CRC32() const;
 
+#if FEATURE_JSON_DELTA
+
+  // Keep track of changed task values, using a change sequence number per task value.
+  // Allows clients to only fetch the values changed since their previous request.
+  // Memory is only allocated when change tracking is enabled.
+  void     enableChangeTracking();
+
+  bool     changeTrackingEnabled() const {
+    return !_changeSequences.empty();
+  }
+
+  // Compare the task values with those of the previous call
+  // and update the change sequence number of the changed values.
+  void     markUpdated(taskIndex_t  taskIndex,
+                       Sensor_VType sensorType);
+
+  uint32_t getChangeSequence(taskIndex_t taskIndex,
+                             uint8_t     varNr) const;
+
+  uint32_t getLastChangeSequence() const {
+    return _lastChangeSequence;
+  }
+#endif // if FEATURE_JSON_DELTA
+
+#if FEATURE_SEND_ON_CHANGE
+
+  // Check whether the task values must be sent to the controller.
+  // This is when one of the values differs at least the deadband from the last sent value,
+  // or maxSilence_ms has passed since the last send (0 = no max.)
+  // When true, the current values are kept as the last sent values.
+  bool mustSendToController(taskIndex_t       taskIndex,
+                            controllerIndex_t controllerIndex,
+                            Sensor_VType      sensorType,
+                            uint8_t           valueCount,
+                            uint8_t           deadbandSteps,
+                            uint32_t          maxSilence_ms);
+
+  // Forget the last sent values, so the next values will be sent.
+  void clearLastSent(taskIndex_t taskIndex);
+#endif // if FEATURE_SEND_ON_CHANGE
+
+#if FEATURE_TASKVALUE_SNAPSHOT
+
+  // Publish the current task values as snapshot.
+  // Seqlock: only to be called from a single writer, the main loop.
+  void publishSnapshot(taskIndex_t  taskIndex,
+                       Sensor_VType sensorType);
+
+  // Get a consistent copy of the last published task values, without locking.
+  // Safe to call from another core or FreeRTOS task.
+  // Returns false when nothing was published yet, or no consistent copy could be made.
+  bool getSnapshot(taskIndex_t        taskIndex,
+                   TaskValues_Data_t& values,
+                   Sensor_VType     & sensorType) const;
+#endif // if FEATURE_TASKVALUE_SNAPSHOT
+
 private:
 
   std::vector<TaskValues_Data_t>_data;
+
+#if FEATURE_TASKVALUE_SNAPSHOT
+  struct Snapshot_t {
+    TaskValues_Data_t values;
+    Sensor_VType      sensorType = Sensor_VType::SENSOR_TYPE_NONE;
+
+    // Odd while being written, 0 when never published
+    uint32_t sequence = 0;
+  };
+
+  std::vector<Snapshot_t>_snapshots;
+#endif // if FEATURE_TASKVALUE_SNAPSHOT
+
+#if FEATURE_JSON_DELTA
+  std::vector<TaskValues_Data_t>_previousData;
+  std::vector<uint32_t>         _changeSequences;
+  uint32_t                      _lastChangeSequence = 0;
+#endif // if FEATURE_JSON_DELTA
+
+#if FEATURE_SEND_ON_CHANGE
+  struct LastSent_t {
+    TaskValues_Data_t values;
+    uint32_t          timestamp = 0;
+  };
+
+  // Key: taskIndex * CONTROLLER_MAX + controllerIndex
+  // Only present for tasks which have send on change enabled.
+  std::map<uint16_t, LastSent_t>_lastSent;
+#endif // if FEATURE_SEND_ON_CHANGE
 };
 
 #endif // ifndef DATASTRUCTS_USERVARSTRUCT_H
@@ -0,0 +1,42 @@
+#include "../DataStructs/WebPageTemplateCache.h"
+
+#if FEATURE_WEB_TEMPLATE_CACHE
+
+# include "../Helpers/StringConverter.h"
+
+const WebPageTemplate_segments * WebPageTemplateCache::get(const String& tmplName, bool tail) const
+{
+  for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+    if (it->name.equals(tmplName)) {
+      return tail ? &(it->tail) : &(it->head);
+    }
+  }
+  return nullptr;
+}
+
+void WebPageTemplateCache::add(const String& tmplName, WebPageTemplate_segments&& head, WebPageTemplate_segments&& tail)
+{
+  Entry entry;
+
+  entry.name = tmplName;
+  entry.head = std::move(head);
+  entry.tail = std::move(tail);
+  _entries.push_back(std::move(entry));
+}
+
+void WebPageTemplateCache::clear()
+{
+  _entries.clear();
+}
+
+void WebPageTemplateCache::invalidate(const String& patched_fname)
+{
+  // Template files are named like "TmplStd.htm", with a leading '/' on ESP32
+  const int pos = patched_fname.indexOf(F("Tmpl"));
+
+  if (((pos == 0) || ((pos == 1) && (patched_fname[0] == '/'))) && patched_fname.endsWith(F(".htm"))) {
+    clear();
+  }
+}
+
+#endif // if FEATURE_WEB_TEMPLATE_CACHE
@@ -0,0 +1,67 @@
+#ifndef DATASTRUCTS_WEBPAGETEMPLATECACHE_H
+#define DATASTRUCTS_WEBPAGETEMPLATECACHE_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_WEB_TEMPLATE_CACHE
+
+# include <vector>
+
+// Template files larger than this are parsed on every page load, as the literal text is kept in RAM.
+# ifndef WEB_TEMPLATE_CACHE_MAX_FILE_SIZE
+#  ifdef ESP8266
+#   define WEB_TEMPLATE_CACHE_MAX_FILE_SIZE  4096
+#  else // ifdef ESP8266
+#   define WEB_TEMPLATE_CACHE_MAX_FILE_SIZE  16384
+#  endif // ifdef ESP8266
+# endif // ifndef WEB_TEMPLATE_CACHE_MAX_FILE_SIZE
+
+struct WebPageTemplate_segment {
+  // Literal text in PROGMEM, from the built-in templates
+  PGM_P    flashText   = nullptr;
+  uint16_t flashLength = 0;
+
+  // Literal text in RAM (from a template file), or the lower case variable name
+  String text;
+  bool   isVar = false;
+};
+
+typedef std::vector<WebPageTemplate_segment> WebPageTemplate_segments;
+
+/*********************************************************************************************\
+* WebPageTemplateCache
+* Page templates (e.g. TmplStd), split once in literal text and {{var}} segments.
+* Head (before {{content}}) and tail (after {{content}}) are kept separately.
+* Built-in templates refer to their text in PROGMEM, so only the segment list takes RAM.
+\*********************************************************************************************/
+class WebPageTemplateCache {
+public:
+
+  // Return nullptr when the template has not been cached yet.
+  const WebPageTemplate_segments* get(const String& tmplName,
+                                      bool          tail) const;
+
+  void                            add(const String             & tmplName,
+                                      WebPageTemplate_segments&& head,
+                                      WebPageTemplate_segments&& tail);
+
+  void                            clear();
+
+  // Clear the cache when the changed file is a page template file.
+  // @param patched_fname  File name as returned by patch_fname()
+  void                            invalidate(const String& patched_fname);
+
+private:
+
+  struct Entry {
+    String                   name;
+    WebPageTemplate_segments head;
+    WebPageTemplate_segments tail;
+  };
+
+  std::vector<Entry> _entries;
+};
+
+#endif // if FEATURE_WEB_TEMPLATE_CACHE
+
+#endif // ifndef DATASTRUCTS_WEBPAGETEMPLATECACHE_H
@@ -0,0 +1,197 @@
+#include "../DataStructs/WebResponseCache.h"
+
+#if FEATURE_WEB_RESPONSE_CACHE
+
+# include "../ESPEasyCore/ESPEasy_Log.h"
+# include "../Globals/Services.h"
+# include "../Helpers/Hardware.h"
+# include "../Helpers/StringConverter.h"
+# include "../WebServer/LoadFromFS.h"
+# include "../WebServer/common.h"
+
+WebResponseCache::~WebResponseCache() {
+  discardCapture();
+  clear();
+}
+
+bool WebResponseCache::serve(const __FlashStringHelper *content_type, const __FlashStringHelper *origin) {
+  discardCapture();
+
+  if (web_server.method() != HTTP_GET) {
+    // Forms posted to the page may change settings.
+    return false;
+  }
+  const String etag = getETag();
+
+  if (reply_304_not_modified_ETag(etag)) {
+    sendHeader(F("ETag"), etag);
+
+    if (origin != nullptr) {
+      sendHeader(F("Access-Control-Allow-Origin"), origin);
+    }
+    web_server.send(304, String(content_type), EMPTY_STRING);
+    return true;
+  }
+
+  const String key = getKey();
+
+  for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+    if (it->key.equals(key)) {
+      if (it != _entries.begin()) {
+        // Move to the front
+        CachedResponse tmp = std::move(*it);
+        _entries.erase(it);
+        _entries.insert(_entries.begin(), std::move(tmp));
+      }
+      const CachedResponse& response = _entries.front();
+      sendHeader(F("Cache-Control"), F("no-cache"));
+      sendHeader(F("ETag"),          etag);
+
+      if (origin != nullptr) {
+        sendHeader(F("Access-Control-Allow-Origin"), origin);
+      }
+      web_server.setContentLength(response.size);
+      web_server.send(200, String(content_type), EMPTY_STRING);
+      web_server.sendContent(reinterpret_cast<const char *>(response.data), response.size);
+      return true;
+    }
+  }
+
+  // Send the ETag with the page about to be rendered.
+  sendHeader(F("ETag"), etag);
+
+  # ifdef ESP32
+
+  if (UsePSRAM()) {
+    // Only use PSRAM, the internal heap is too precious for this.
+    _captureAllocated = 4096;
+    _captureData      = static_cast<uint8_t *>(heap_caps_malloc(_captureAllocated, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+
+    if (_captureData == nullptr) {
+      _captureAllocated = 0;
+    } else {
+      _captureKey  = key;
+      _captureSize = 0;
+    }
+  }
+  # endif // ifdef ESP32
+  return false;
+}
+
+void WebResponseCache::capture(const char *data, size_t length) {
+  if (!capturing() || (length == 0)) { return; }
+
+  const size_t newSize = _captureSize + length;
+
+  if (newSize > WEB_RESPONSE_CACHE_MAX_SIZE) {
+    discardCapture();
+    return;
+  }
+
+  # ifdef ESP32
+
+  if (newSize > _captureAllocated) {
+    size_t newAllocated = _captureAllocated * 2;
+
+    while (newAllocated < newSize) {
+      newAllocated *= 2;
+    }
+
+    if (newAllocated > WEB_RESPONSE_CACHE_MAX_SIZE) {
+      newAllocated = WEB_RESPONSE_CACHE_MAX_SIZE;
+    }
+    uint8_t *tmp = static_cast<uint8_t *>(heap_caps_realloc(_captureData, newAllocated, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+
+    if (tmp == nullptr) {
+      discardCapture();
+      return;
+    }
+    _captureData      = tmp;
+    _captureAllocated = newAllocated;
+  }
+  # endif // ifdef ESP32
+  memcpy_P(_captureData + _captureSize, data, length);
+  _captureSize = newSize;
+}
+
+void WebResponseCache::captureDone(bool complete) {
+  if (!capturing()) { return; }
+
+  if (!complete || (_captureSize == 0)) {
+    discardCapture();
+    return;
+  }
+
+  CachedResponse response;
+
+  response.key      = std::move(_captureKey);
+  response.data     = _captureData;
+  response.size     = _captureSize;
+  _captureData      = nullptr;
+  _captureKey       = String();
+  _captureSize      = 0;
+  _captureAllocated = 0;
+
+  _entries.insert(_entries.begin(), std::move(response));
+
+  while (_entries.size() > WEB_RESPONSE_CACHE_ENTRIES) {
+    free(_entries.back().data);
+    _entries.pop_back();
+  }
+}
+
+void WebResponseCache::clear() {
+  for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+    free(it->data);
+  }
+  _entries.clear();
+
+  // A page being rendered right now may already contain the old settings.
+  discardCapture();
+
+  if (_generation != 0) {
+    ++_generation;
+  }
+}
+
+size_t WebResponseCache::getCachedSize() const {
+  size_t res = 0;
+
+  for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+    res += it->size;
+  }
+  return res;
+}
+
+String WebResponseCache::getKey() const {
+  String key = web_server.uri();
+
+  for (int i = 0; i < web_server.args(); ++i) {
+    key += i == 0 ? '?' : '&';
+    key += web_server.argName(i);
+    key += '=';
+    key += web_server.arg(i);
+  }
+  return key;
+}
+
+String WebResponseCache::getETag() {
+  if (_generation == 0) {
+    _generation = HwRandom();
+
+    if (_generation == 0) { _generation = 1; }
+  }
+  return wrap_String(concat(F("w"), formatToHex_no_prefix(_generation, 8)), '"');
+}
+
+void WebResponseCache::discardCapture() {
+  if (_captureData != nullptr) {
+    free(_captureData);
+    _captureData = nullptr;
+  }
+  _captureKey       = String();
+  _captureSize      = 0;
+  _captureAllocated = 0;
+}
+
+#endif // if FEATURE_WEB_RESPONSE_CACHE
@@ -0,0 +1,83 @@
+#ifndef DATASTRUCTS_WEBRESPONSECACHE_H
+#define DATASTRUCTS_WEBRESPONSECACHE_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_WEB_RESPONSE_CACHE
+
+# include <vector>
+
+// Max. nr of responses kept in PSRAM
+# ifndef WEB_RESPONSE_CACHE_ENTRIES
+#  define WEB_RESPONSE_CACHE_ENTRIES   8
+# endif // ifndef WEB_RESPONSE_CACHE_ENTRIES
+
+// Max. size of a single response kept in PSRAM
+# ifndef WEB_RESPONSE_CACHE_MAX_SIZE
+#  define WEB_RESPONSE_CACHE_MAX_SIZE  (64 * 1024)
+# endif // ifndef WEB_RESPONSE_CACHE_MAX_SIZE
+
+
+/*********************************************************************************************\
+* WebResponseCache
+* Responses of pages which only change when settings are saved, keyed by URL + arguments.
+* All responses share a single ETag, which changes when any settings file is written.
+* So a browser sending the same ETag in If-None-Match gets a 304 Not Modified,
+* on nodes with PSRAM the stored response is sent without rendering the page again.
+\*********************************************************************************************/
+class WebResponseCache {
+public:
+
+  ~WebResponseCache();
+
+  // Call from a page handler before rendering the page.
+  // Return true when the request has been answered, either with a 304 or the stored response.
+  // Otherwise the ETag header is set and the page streamed via TXBuffer will be stored.
+  bool serve(const __FlashStringHelper *content_type,
+             const __FlashStringHelper *origin = nullptr);
+
+  bool capturing() const {
+    return _captureData != nullptr;
+  }
+
+  // Data sent by TXBuffer while capturing, may be in PROGMEM.
+  void capture(const char *data,
+               size_t      length);
+
+  // TXBuffer finished the page, store it when the page was sent completely.
+  void captureDone(bool complete);
+
+  // Settings changed, all stored responses and the current ETag are no longer valid.
+  void clear();
+
+  size_t getCachedSize() const;
+
+private:
+
+  String getKey() const;
+
+  String getETag();
+
+  void   discardCapture();
+
+  struct CachedResponse {
+    String   key;
+    uint8_t *data = nullptr;
+    size_t   size = 0;
+  };
+
+  // Most recently used first
+  std::vector<CachedResponse> _entries;
+
+  String   _captureKey;
+  uint8_t *_captureData      = nullptr;
+  size_t   _captureSize      = 0;
+  size_t   _captureAllocated = 0;
+
+  // Part of the ETag, random start value so an ETag from before a reboot is not valid anymore.
+  uint32_t _generation = 0;
+};
+
+#endif // if FEATURE_WEB_RESPONSE_CACHE
+
+#endif // ifndef DATASTRUCTS_WEBRESPONSECACHE_H
@@ -6,21 +6,45 @@
 #include "../ESPEasyCore/ESPEasyNetwork.h"
 
 // FIXME TD-er: Should keep a pointer to the webserver as a member, not use the global defined one.
+#include "../Globals/Cache.h"
 #include "../Globals/Services.h"
 
 #include "../Helpers/ESPEasy_time_calc.h"
+#include "../Helpers/EventTracer.h"
+#include "../Helpers/SlowLoopDetector.h"
 #include "../Helpers/Convert.h"
 #include "../Helpers/StringConverter.h"
+#include "../Helpers/StringConverter_Numerical.h"
 
 #include "../../ESPEasy_common.h"
 
 #ifdef ESP8266
-#define CHUNKED_BUFFER_SIZE         512
+#include <lwip/opt.h>
+
+// Fill a single TCP segment per chunk.
+// Keep some room for the chunk header ("5a4\r\n") and the trailing "\r\n".
+# if defined(TCP_MSS) && (TCP_MSS > 512)
+#  define CHUNKED_BUFFER_SIZE       (TCP_MSS - 9)
+# else
+#  define CHUNKED_BUFFER_SIZE       512
+# endif
 #else 
 #define CHUNKED_BUFFER_SIZE         4096
 #endif
 
-Web_StreamingBuffer::Web_StreamingBuffer(void) : lowMemorySkip(false),
+#if defined(ESP8266) && defined(ARDUINO_ESP8266_RELEASE_2_3_0)
+// Flash strings cannot be sent directly, as we need to do chunked transfer encoding ourselves.
+#else
+#define WEB_STREAMING_SEND_FLASH_DIRECT  1
+#endif
+
+// Max. time in msec a single write to the client may block the main loop.
+// When the client did not accept any data within this time, the rest of the page is skipped.
+#ifndef WEB_STREAMING_CLIENT_TIMEOUT
+# define WEB_STREAMING_CLIENT_TIMEOUT   1000
+#endif
+
+Web_StreamingBuffer::Web_StreamingBuffer(void) : lowMemorySkip(false), streamAborted(false), discardOutput(false), streamStart(0),
   initialRam(0), beforeTXRam(0), duringTXRam(0), finalRam(0), maxCoreUsage(0),
   maxServerUsage(0), sentBytes(0), flashStringCalls(0), flashStringData(0)
 {
@@ -36,20 +60,54 @@ Web_StreamingBuffer& Web_StreamingBuffer::operator+=(char a)                   {
   return *this;
 }
 
+Web_StreamingBuffer& Web_StreamingBuffer::operator+=(int a) {
+  return operator+=(static_cast<int64_t>(a));
+}
+
+Web_StreamingBuffer& Web_StreamingBuffer::operator+=(unsigned int a) {
+  return operator+=(static_cast<uint64_t>(a));
+}
+
 Web_StreamingBuffer& Web_StreamingBuffer::operator+=(uint64_t a) {
-  return addString(ull2String(a));
+  // Write the digits backwards, max. 20 digits for uint64_t
+  char str[21];
+  size_t pos = sizeof(str);
+
+  do {
+    str[--pos] = '0' + (a % 10);
+    a         /= 10;
+  } while (a > 0);
+  return addChars(&str[pos], sizeof(str) - pos);
 }
 
 Web_StreamingBuffer& Web_StreamingBuffer::operator+=(int64_t a) {
-  return addString(ll2String(a));
+  if (a < 0) {
+    operator+=('-');
+
+    // Cast before negating, to also handle the lowest value
+    return operator+=(static_cast<uint64_t>(0) - static_cast<uint64_t>(a));
+  }
+  return operator+=(static_cast<uint64_t>(a));
 }
 
 Web_StreamingBuffer& Web_StreamingBuffer::operator+=(const float& a)           {
+  char str[FORMAT_FIXED_DECIMALS_BUFFER_SIZE];
+  const size_t length = formatFixedDecimals(str, sizeof(str), a, 2);
+
+  if (length != 0) {
+    return addChars(str, length);
+  }
   return addString(toString(a, 2));
 }
 
 #if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
 Web_StreamingBuffer& Web_StreamingBuffer::operator+=(const double& a)          {
+  char str[FORMAT_FIXED_DECIMALS_BUFFER_SIZE];
+  const size_t length = formatFixedDecimals(str, sizeof(str), a, 2);
+
+  if (length != 0) {
+    return addChars(str, length);
+  }
   return addString(doubleToString(a));
 }
 #endif
@@ -95,7 +153,24 @@ Web_StreamingBuffer& Web_StreamingBuffer::addFlashString(PGM_P str, int length)
 
   ++flashStringCalls;
 
-  if (lowMemorySkip) { return *this; }
+  if (skipOutput()) { return *this; }
+
+  #ifdef WEB_STREAMING_SEND_FLASH_DIRECT
+  {
+    // Only check for \0 when no length was given (e.g. binary data)
+    const size_t str_length = (length < 0) ? strlen_P(str) : length;
+
+    if (str_length >= CHUNKED_BUFFER_SIZE) {
+      // Large flash strings, like CSS and JavaScript, do not need to be copied into the buffer.
+      // Send what is already buffered and then stream straight from flash.
+      flush();
+      sendContentBlocking_P(str, str_length);
+      flashStringData += str_length;
+      return *this;
+    }
+    length = str_length;
+  }
+  #endif // ifdef WEB_STREAMING_SEND_FLASH_DIRECT
 
   checkFull();
 
@@ -112,7 +187,7 @@ Web_StreamingBuffer& Web_StreamingBuffer::addFlashString(PGM_P str, int length)
       }
       const char c = (char)pgm_read_byte(pos);
       if (c == '\0' && length < 0) {
-        // Only check for \0 when length was given (e.g. binary data)
+        // Only check for \0 when no length was given (e.g. binary data)
         return *this;
       }
       this->buf += c;
@@ -126,22 +201,30 @@ Web_StreamingBuffer& Web_StreamingBuffer::addFlashString(PGM_P str, int length)
 }
 
 Web_StreamingBuffer& Web_StreamingBuffer::addString(const String& a) {
-  if (lowMemorySkip) { return *this; }
+  if (skipOutput()) { return *this; }
   const unsigned int length = a.length();
   if (length == 0) { return *this; }
 
   checkFull();
-  int flush_step = CHUNKED_BUFFER_SIZE - this->buf.length();
-
-  if (flush_step < 1) { flush_step = 0; }
 
-  if (length < static_cast<unsigned int>(flush_step)) {
-    // Just use the faster String operator to copy flash strings.
+  if (length < (CHUNKED_BUFFER_SIZE - this->buf.length())) {
+    // Just use the faster String operator to copy when it fits.
     this->buf += a;
     return *this;
   }
+  return addChars(a.c_str(), length);
+}
+
+Web_StreamingBuffer& Web_StreamingBuffer::addChars(const char *a, size_t length) {
+  if (skipOutput()) { return *this; }
+  if (length == 0) { return *this; }
+
+  checkFull();
+  int flush_step = CHUNKED_BUFFER_SIZE - this->buf.length();
 
-  unsigned int pos = 0;
+  if (flush_step < 1) { flush_step = 0; }
+
+  size_t pos = 0;
   while (pos < length) {
     if (flush_step == 0) {
       flush();
@@ -157,7 +240,7 @@ Web_StreamingBuffer& Web_StreamingBuffer::addString(const String& a) {
 }
 
 void Web_StreamingBuffer::flush() {
-  if (lowMemorySkip) {
+  if (skipOutput()) {
     this->buf.clear();
   } else {
     if (this->buf.length() > 0) {
@@ -166,8 +249,53 @@ void Web_StreamingBuffer::flush() {
   }
 }
 
+void Web_StreamingBuffer::sendBinary(const uint8_t *data, size_t length) {
+  // Keep the order of the data
+  flush();
+
+  if (skipOutput() || (length == 0)) { return; }
+
+  if (discardOutput) {
+    sentBytes += length;
+    return;
+  }
+
+  delay(0); // Try to prevent WDT reboots
+  #if FEATURE_WEB_RESPONSE_CACHE
+  Cache.webResponseCache.capture(reinterpret_cast<const char *>(data), length);
+  #endif // if FEATURE_WEB_RESPONSE_CACHE
+  const uint32_t writeStart = millis();
+
+  web_server.sendContent(reinterpret_cast<const char *>(data), length);
+  const long writeDuration = timePassedSince(writeStart);
+
+  trackCoreMem();
+
+  sentBytes += length;
+  checkClient(writeDuration);
+  delay(0);
+}
+
+bool Web_StreamingBuffer::skipOutput() const {
+  return lowMemorySkip || streamAborted;
+}
+
+void Web_StreamingBuffer::checkClient(long writeDuration) {
+  if (streamAborted) { return; }
+
+  // Stop rendering when nobody is listening, or when the last write hit the client timeout,
+  // meaning the client did not read anything for that long.
+  // Every following write would otherwise block until the client timeout.
+  // A slow client which keeps reading may take as long as it needs.
+  if (!web_server.client().connected() ||
+      (writeDuration >= WEB_STREAMING_CLIENT_TIMEOUT)) {
+    streamAborted = true;
+    buf.clear();
+  }
+}
+
 void Web_StreamingBuffer::checkFull() {
-  if (lowMemorySkip) { this->buf.clear(); }
+  if (skipOutput()) { this->buf.clear(); }
 
   if (this->buf.length() >= CHUNKED_BUFFER_SIZE) {
     trackTotalMem();
@@ -192,6 +320,16 @@ void Web_StreamingBuffer::startJsonStream() {
   startStream(true, F("application/json"), F("*"));
 }
 
+void Web_StreamingBuffer::startDiscardStream() {
+  lowMemorySkip = false;
+  streamAborted = false;
+  discardOutput = true;
+  sentBytes     = 0;
+  streamStart   = millis();
+  buf.clear();
+  buf.reserve(CHUNKED_BUFFER_SIZE);
+}
+
 void Web_StreamingBuffer::startStream(bool allowOriginAll, 
                                       const __FlashStringHelper * content_type, 
                                       const __FlashStringHelper * origin,
@@ -200,12 +338,23 @@ void Web_StreamingBuffer::startStream(bool allowOriginAll,
   HeapSelectDram ephemeral;
   #endif
 
+  #if FEATURE_EVENT_TRACER
+  EventTracer_add(EventTraceType_e::WebRequest, httpCode, true);
+  #endif // if FEATURE_EVENT_TRACER
+
   maxCoreUsage = maxServerUsage = 0;
   initialRam   = ESP.getFreeHeap();
   beforeTXRam  = initialRam;
   sentBytes    = 0;
+  streamStart  = millis();
+  discardOutput = false;
   buf.clear();
   buf.reserve(CHUNKED_BUFFER_SIZE);
+
+  #ifdef ESP8266
+  // The ESP32 WiFiClient timeout does not apply to writes.
+  web_server.client().setTimeout(WEB_STREAMING_CLIENT_TIMEOUT);
+  #endif // ifdef ESP8266
   
   if (beforeTXRam < 3000) {
     lowMemorySkip = true;
@@ -248,7 +397,22 @@ void Web_StreamingBuffer::endStream() {
   HeapSelectDram ephemeral;
   #endif
 
-  if (!lowMemorySkip) {
+  #if FEATURE_WEB_RESPONSE_CACHE
+  const bool complete = !streamAborted && !lowMemorySkip;
+  #endif // if FEATURE_WEB_RESPONSE_CACHE
+
+  if (streamAborted) {
+    buf.clear();
+    web_server.client().stop();
+
+    if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+      addLogMove(LOG_LEVEL_ERROR, strformat(
+                   F("Webpage aborted: client lost or not reading after %u bytes, %d msec"),
+                   sentBytes,
+                   static_cast<int>(timePassedSince(streamStart))));
+    }
+    streamAborted = false;
+  } else if (!lowMemorySkip) {
     if (buf.length() > 0) { sendContentBlocking(buf); }
     buf.clear();
     sendContentBlocking(buf);
@@ -274,6 +438,15 @@ void Web_StreamingBuffer::endStream() {
       addLog(LOG_LEVEL_ERROR, concat("Webpage skipped: low memory: ", finalRam));
     lowMemorySkip = false;
   }
+  #if FEATURE_WEB_RESPONSE_CACHE
+  Cache.webResponseCache.captureDone(complete);
+  #endif // if FEATURE_WEB_RESPONSE_CACHE
+  #if FEATURE_EVENT_TRACER
+  EventTracer_add(EventTraceType_e::WebRequest, 0, false);
+  #endif // if FEATURE_EVENT_TRACER
+  #if FEATURE_SLOW_LOOP_DETECTOR
+  SlowLoop_webRequest(web_server.uri());
+  #endif // if FEATURE_SLOW_LOOP_DETECTOR
 }
 
 
@@ -287,6 +460,12 @@ void Web_StreamingBuffer::sendContentBlocking(String& data) {
   delay(0); // Try to prevent WDT reboots
 
   const uint32_t length   = data.length();
+
+  if (discardOutput) {
+    sentBytes += length;
+    data.clear();
+    return;
+  }
 #ifndef BUILD_NO_DEBUG
   if (loglevelActiveFor(LOG_LEVEL_DEBUG_DEV)) {
     String log;
@@ -306,19 +485,29 @@ void Web_StreamingBuffer::sendContentBlocking(String& data) {
     beforeTXRam = freeBeforeSend;
   }
   duringTXRam = freeBeforeSend;
+
+  #if FEATURE_WEB_RESPONSE_CACHE
+  Cache.webResponseCache.capture(data.c_str(), length);
+  #endif // if FEATURE_WEB_RESPONSE_CACHE
   
 #if defined(ESP8266) && defined(ARDUINO_ESP8266_RELEASE_2_3_0)
   String size = formatToHex(length) + "\r\n";
 
   // do chunked transfer encoding ourselves (WebServer doesn't support it)
+  const uint32_t writeStart = millis();
+
   web_server.sendContent(size);
 
   if (length > 0) { web_server.sendContent(data); }
   web_server.sendContent("\r\n");
+  const long writeDuration = timePassedSince(writeStart);
 #else // ESP8266 2.4.0rc2 and higher and the ESP32 webserver supports chunked http transfer
   unsigned int timeout = 100;
 
+  const uint32_t writeStart = millis();
+
   web_server.sendContent(data);
+  const long writeDuration = timePassedSince(writeStart);
 
   if (data.length() > CHUNKED_BUFFER_SIZE) {
     data = String(); // Clear also allocated memory
@@ -342,6 +531,45 @@ void Web_StreamingBuffer::sendContentBlocking(String& data) {
 #endif // if defined(ESP8266) && defined(ARDUINO_ESP8266_RELEASE_2_3_0)
 
   sentBytes += length;
+  checkClient(writeDuration);
+  delay(0);
+}
+
+void Web_StreamingBuffer::sendContentBlocking_P(PGM_P data, size_t length) {
+  #ifdef USE_SECOND_HEAP
+  HeapSelectDram ephemeral;
+  #endif
+
+  delay(0); // Try to prevent WDT reboots
+
+  if (discardOutput) {
+    sentBytes += length;
+    return;
+  }
+
+  const uint32_t freeBeforeSend = ESP.getFreeHeap();
+
+  if (beforeTXRam > freeBeforeSend) {
+    beforeTXRam = freeBeforeSend;
+  }
+  duringTXRam = freeBeforeSend;
+
+  #if FEATURE_WEB_RESPONSE_CACHE
+  Cache.webResponseCache.capture(data, length);
+  #endif // if FEATURE_WEB_RESPONSE_CACHE
+
+  const uint32_t writeStart = millis();
+
+  #ifdef WEB_STREAMING_SEND_FLASH_DIRECT
+  // The webserver sends the chunk header and then writes the data straight from flash.
+  web_server.sendContent_P(data, length);
+  #endif // ifdef WEB_STREAMING_SEND_FLASH_DIRECT
+  const long writeDuration = timePassedSince(writeStart);
+
+  trackCoreMem();
+
+  sentBytes += length;
+  checkClient(writeDuration);
   delay(0);
 }
 
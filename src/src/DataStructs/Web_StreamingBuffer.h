@@ -15,6 +15,13 @@ private:
 
   bool lowMemorySkip;
 
+  // Client disconnected or stopped reading, skip the rest of the page.
+  bool streamAborted;
+
+  // Output is formatted and buffered as usual, but not sent.
+  bool discardOutput;
+  uint32_t streamStart;
+
 public:
 
   uint32_t initialRam;
@@ -37,6 +44,9 @@ public:
 
   Web_StreamingBuffer& operator+=(char a);
 
+  // Numerical values are formatted in place, without a temporary String
+  Web_StreamingBuffer& operator+=(int a);
+  Web_StreamingBuffer& operator+=(unsigned int a);
   Web_StreamingBuffer& operator+=(uint64_t a);
   Web_StreamingBuffer& operator+=(int64_t a);
 
@@ -54,11 +64,17 @@ template <typename T>
   Web_StreamingBuffer& operator+=(PGM_P str);
   Web_StreamingBuffer& operator+=(const __FlashStringHelper* str);
 
+  // Large flash strings are sent directly from flash to the client.
   Web_StreamingBuffer& addFlashString(PGM_P str, int length = -1);
+
+  // Send binary data from RAM as a chunk, without copying it into the buffer.
+  void sendBinary(const uint8_t *data, size_t length);
   
 private:
   Web_StreamingBuffer& addString(const String& a);
 
+  Web_StreamingBuffer& addChars(const char *str, size_t length);
+
 public:
   void flush();
 
@@ -72,6 +88,10 @@ public:
 
   void startJsonStream();
 
+  // Start a stream which is not sent to a client, to measure the cost of rendering.
+  // sentBytes is the nr of bytes which would have been sent.
+  void startDiscardStream();
+
 private:
 
   void startStream(bool allowOriginAll, 
@@ -81,6 +101,12 @@ private:
 
   void trackTotalMem();
 
+  bool skipOutput() const;
+
+  // Abort the page when the client is gone or did not read anything during the last write.
+  // @param writeDuration  Time in msec the last write to the client took.
+  void checkClient(long writeDuration);
+
 public:
 
   void trackCoreMem();
@@ -90,6 +116,8 @@ public:
 private: 
 
   void sendContentBlocking(String& data);
+  void sendContentBlocking_P(PGM_P  data,
+                             size_t length);
   void sendHeaderBlocking(bool          allowOriginAll,
                           const String& content_type,
                           const String& origin,
@@ -115,6 +115,7 @@ struct WiFiEventData_t {
   LongTermTimer           timerAPoff;   // Timer to check whether the AP mode should be disabled (0 = disabled)
   LongTermTimer           timerAPstart; // Timer to start AP mode, started when no valid network is detected.
   bool                    intent_to_reboot = false;
+  bool                    scanRequested    = false; // Scan to be started from the loop, see WifiScan_request()
   MAC_address             lastMacConnectedAPmode;
   MAC_address             lastMacDisconnectedAPmode;
 
@@ -136,6 +137,7 @@ struct WiFiEventData_t {
   bool processedScanDone         = true;
   bool wifiConnectAttemptNeeded  = true;
   bool wifiConnectInProgress     = false;
+  bool usingCachedLease          = false; // Connected using the DHCP lease stored in RTC
   bool warnedNoValidWiFiSettings = false;
 
   bool performedClearWiFiCredentials = false;
@@ -369,7 +369,126 @@ void SettingsStruct_tmpl<N_TASKS>::DisableRulesCodeCompletion(bool value) {
 }
 #endif // if FEATURE_RULES_EASY_COLOR_CODE
 
+#if FEATURE_RULES_COMPILED
+template<unsigned int N_TASKS>
+bool SettingsStruct_tmpl<N_TASKS>::EnableRulesCompiled() const { 
+  return bitRead(VariousBits2, 3);
+}
+
+template<unsigned int N_TASKS>
+void SettingsStruct_tmpl<N_TASKS>::EnableRulesCompiled(bool value) { 
+  bitWrite(VariousBits2, 3, value);
+}
+#endif // if FEATURE_RULES_COMPILED
+
+template<unsigned int N_TASKS>
+EventQueueOverflowPolicy_e SettingsStruct_tmpl<N_TASKS>::EventQueueOverflowPolicy() const {
+  return static_cast<EventQueueOverflowPolicy_e>(get2BitFromUL(VariousBits2, 4)); // Also occupies bit 5!
+}
+
+template<unsigned int N_TASKS>
+void SettingsStruct_tmpl<N_TASKS>::EventQueueOverflowPolicy(EventQueueOverflowPolicy_e value) {
+  set2BitToUL(VariousBits2, 4, static_cast<uint8_t>(value)); // Also occupies bit 5!
+}
+
+template<unsigned int N_TASKS>
+bool SettingsStruct_tmpl<N_TASKS>::EnableRulesEventFilter() const { // Inverted
+  return !bitRead(VariousBits2, 6);
+}
+
+template<unsigned int N_TASKS>
+void SettingsStruct_tmpl<N_TASKS>::EnableRulesEventFilter(bool value) { // Inverted
+  bitWrite(VariousBits2, 6, !value);
+}
+
+#if FEATURE_CONTROLLER_QUEUE_TASK
+template<unsigned int N_TASKS>
+bool SettingsStruct_tmpl<N_TASKS>::EnableControllerQueueTask() const { 
+  return bitRead(VariousBits2, 7);
+}
+
+template<unsigned int N_TASKS>
+void SettingsStruct_tmpl<N_TASKS>::EnableControllerQueueTask(bool value) { 
+  bitWrite(VariousBits2, 7, value);
+}
+#endif // if FEATURE_CONTROLLER_QUEUE_TASK
+
+#if FEATURE_SYSLOG_BUFFER
+template<unsigned int N_TASKS>
+bool SettingsStruct_tmpl<N_TASKS>::SyslogBatchLines() const {
+  return bitRead(VariousBits2, 8);
+}
+
+template<unsigned int N_TASKS>
+void SettingsStruct_tmpl<N_TASKS>::SyslogBatchLines(bool value) {
+  bitWrite(VariousBits2, 8, value);
+}
+#endif // if FEATURE_SYSLOG_BUFFER
+
+template<unsigned int N_TASKS>
+bool SettingsStruct_tmpl<N_TASKS>::FastFirstSample() const {
+  return bitRead(VariousBits2, 9);
+}
+
+template<unsigned int N_TASKS>
+void SettingsStruct_tmpl<N_TASKS>::FastFirstSample(bool value) {
+  bitWrite(VariousBits2, 9, value);
+}
+
+template<unsigned int N_TASKS>
+uint16_t SettingsStruct_tmpl<N_TASKS>::getRulesEventBudget() const {
+  if (RulesEventBudget_usec == 0) {
+    return DEFAULT_RULES_EVENT_BUDGET;
+  }
+  return RulesEventBudget_usec;
+}
+
+
+
+template<unsigned int N_TASKS>
+bool SettingsStruct_tmpl<N_TASKS>::SendOnChange(taskIndex_t taskIndex, controllerIndex_t controllerIndex) const {
+  if (validTaskIndex(taskIndex) && validControllerIndex(controllerIndex)) {
+    return bitRead(TaskSendOnChange[taskIndex], controllerIndex);
+  }
+  return false;
+}
 
+template<unsigned int N_TASKS>
+void SettingsStruct_tmpl<N_TASKS>::SendOnChange(taskIndex_t taskIndex, controllerIndex_t controllerIndex, bool value) {
+  if (validTaskIndex(taskIndex) && validControllerIndex(controllerIndex)) {
+    bitWrite(TaskSendOnChange[taskIndex], controllerIndex, value);
+  }
+}
+
+template<unsigned int N_TASKS>
+uint8_t SettingsStruct_tmpl<N_TASKS>::SendOnChangeDeadband(taskIndex_t taskIndex) const {
+  if (validTaskIndex(taskIndex)) {
+    return (TaskSendOnChange[taskIndex] >> 8) & 0xFF;
+  }
+  return 0;
+}
+
+template<unsigned int N_TASKS>
+void SettingsStruct_tmpl<N_TASKS>::SendOnChangeDeadband(taskIndex_t taskIndex, uint8_t value) {
+  if (validTaskIndex(taskIndex)) {
+    TaskSendOnChange[taskIndex] = (TaskSendOnChange[taskIndex] & ~(0xFFu << 8)) | (static_cast<uint32_t>(value) << 8);
+  }
+}
+
+template<unsigned int N_TASKS>
+uint16_t SettingsStruct_tmpl<N_TASKS>::SendOnChangeMaxSilence(taskIndex_t taskIndex) const {
+  if (validTaskIndex(taskIndex)) {
+    return (TaskSendOnChange[taskIndex] >> 16) & 0xFFFF;
+  }
+  return 0;
+}
+
+template<unsigned int N_TASKS>
+void SettingsStruct_tmpl<N_TASKS>::SendOnChangeMaxSilence(taskIndex_t taskIndex, uint16_t value) {
+  if (validTaskIndex(taskIndex)) {
+    TaskSendOnChange[taskIndex] = (TaskSendOnChange[taskIndex] & 0xFFFFu) | (static_cast<uint32_t>(value) << 16);
+  }
+}
 
 template<unsigned int N_TASKS>
 bool SettingsStruct_tmpl<N_TASKS>::isTaskEnableReadonly(taskIndex_t taskIndex) const {
@@ -386,6 +505,37 @@ void SettingsStruct_tmpl<N_TASKS>::setTaskEnableReadonly(taskIndex_t taskIndex,
   }
 }
 
+template<unsigned int N_TASKS>
+uint8_t SettingsStruct_tmpl<N_TASKS>::getTaskReadGroup(taskIndex_t taskIndex) const {
+  if (validTaskIndex(taskIndex)) {
+    return (VariousTaskBits[taskIndex] >> 4) & 0x0F;
+  }
+  return 0;
+}
+
+template<unsigned int N_TASKS>
+void SettingsStruct_tmpl<N_TASKS>::setTaskReadGroup(taskIndex_t taskIndex, uint8_t value) {
+  if (validTaskIndex(taskIndex)) {
+    VariousTaskBits[taskIndex] = (VariousTaskBits[taskIndex] & 0x0F) | ((value & 0x0F) << 4);
+  }
+}
+
+template<unsigned int N_TASKS>
+uint8_t SettingsStruct_tmpl<N_TASKS>::getI2CClockProfile(taskIndex_t taskIndex) const {
+  if (validTaskIndex(taskIndex)) {
+    return (I2C_Flags[taskIndex] >> I2C_FLAGS_CLOCK_PROFILE) & 0x07;
+  }
+  return 0;
+}
+
+template<unsigned int N_TASKS>
+void SettingsStruct_tmpl<N_TASKS>::setI2CClockProfile(taskIndex_t taskIndex, uint8_t value) {
+  if (validTaskIndex(taskIndex)) {
+    I2C_Flags[taskIndex] = (I2C_Flags[taskIndex] & ~(0x07 << I2C_FLAGS_CLOCK_PROFILE)) |
+                           ((value & 0x07) << I2C_FLAGS_CLOCK_PROFILE);
+  }
+}
+
 #if FEATURE_PLUGIN_PRIORITY
 template<unsigned int N_TASKS>
 bool SettingsStruct_tmpl<N_TASKS>::isPowerManagerTask(taskIndex_t taskIndex) const {
@@ -612,6 +762,12 @@ void SettingsStruct_tmpl<N_TASKS>::clearMisc() {
   console_serial_rxpin             = DEFAULT_CONSOLE_PORT_RXPIN;
   console_serial_txpin             = DEFAULT_CONSOLE_PORT_TXPIN;
   console_serial0_fallback         = DEFAULT_CONSOLE_SER0_FALLBACK;
+  RulesEventBudget_usec            = 0;
+  I2C2_clockSpeed                  = DEFAULT_I2C2_CLOCK_SPEED;
+  Pin_i2c2_sda                     = -1;
+  Pin_i2c2_scl                     = -1;
+  ZERO_FILL(P2P_MulticastGroup);
+  deepSleep_batchCycles            = 0;
 
 
   OldRulesEngine(DEFAULT_RULES_OLDENGINE);
@@ -641,7 +797,7 @@ void SettingsStruct_tmpl<N_TASKS>::clearTask(taskIndex_t task) {
     TaskDeviceSendData[i][task] = false;
   }
   TaskDeviceNumber[task]     = 0u; //.setInvalid();
-  OLD_TaskDeviceID[task]     = 0u; // UNUSED: this can be removed
+  TaskSendOnChange[task]     = 0u;
   TaskDevicePin1[task]       = -1;
   TaskDevicePin2[task]       = -1;
   TaskDevicePin3[task]       = -1;
@@ -897,7 +1053,8 @@ bool SettingsStruct_tmpl<N_TASKS>::isSPI_valid() const {
 template<unsigned int N_TASKS>
 bool SettingsStruct_tmpl<N_TASKS>::isI2C_pin(int8_t pin) const {
   if (pin < 0) { return false; }
-  return Pin_i2c_sda == pin || Pin_i2c_scl == pin;
+  return Pin_i2c_sda == pin || Pin_i2c_scl == pin ||
+         Pin_i2c2_sda == pin || Pin_i2c2_scl == pin;
 }
 
 template<unsigned int N_TASKS>
@@ -908,6 +1065,13 @@ bool SettingsStruct_tmpl<N_TASKS>::isI2CEnabled() const {
          (I2C_clockSpeed_Slow > 0);
 }
 
+template<unsigned int N_TASKS>
+bool SettingsStruct_tmpl<N_TASKS>::isI2C2Enabled() const {
+  return (Pin_i2c2_sda != -1) &&
+         (Pin_i2c2_scl != -1) &&
+         (I2C2_clockSpeed > 0);
+}
+
 template<unsigned int N_TASKS>
 bool SettingsStruct_tmpl<N_TASKS>::isEthernetPin(int8_t pin) const {
   #if FEATURE_ETHERNET
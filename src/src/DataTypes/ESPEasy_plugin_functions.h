@@ -121,7 +121,8 @@ public:
     NPLUGIN_WEBFORM_SAVE,
     NPLUGIN_WEBFORM_LOAD,
     NPLUGIN_WRITE,
-    NPLUGIN_NOTIFY
+    NPLUGIN_NOTIFY,
+    NPLUGIN_TEN_PER_SECOND
   };
 };
 
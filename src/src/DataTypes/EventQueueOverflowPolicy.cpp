@@ -0,0 +1,12 @@
+#include "../DataTypes/EventQueueOverflowPolicy.h"
+
+const __FlashStringHelper * toString(EventQueueOverflowPolicy_e policy) {
+  switch (policy) {
+    case EventQueueOverflowPolicy_e::DropOldest:        return F("Drop oldest");
+    case EventQueueOverflowPolicy_e::DropNewest:        return F("Drop newest");
+    case EventQueueOverflowPolicy_e::CoalesceEventName: return F("Coalesce same event name");
+
+      // Do not use default: as this allows the compiler to detect any missing cases.
+  }
+  return F("Unknown");
+}
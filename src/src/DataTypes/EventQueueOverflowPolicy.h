@@ -0,0 +1,19 @@
+#ifndef DATATYPES_EVENTQUEUEOVERFLOWPOLICY_H
+#define DATATYPES_EVENTQUEUEOVERFLOWPOLICY_H
+
+#include "../../ESPEasy_common.h"
+
+// What to do with a new event when the event queue is full.
+// Is stored in settings, so don't change order
+enum class EventQueueOverflowPolicy_e : uint8_t {
+  DropOldest        = 0, // Remove the oldest events until the new event fits
+  DropNewest        = 1, // Do not add the new event
+  CoalesceEventName = 2  // Remove an older event with the same name, e.g. "Dummy#Value"
+
+  // Stored in 2 bits, so max. 4 options
+};
+
+const __FlashStringHelper * toString(EventQueueOverflowPolicy_e policy);
+
+
+#endif // DATATYPES_EVENTQUEUEOVERFLOWPOLICY_H
@@ -6,6 +6,7 @@
 #include "../../_Plugin_Helper.h"
 
 #include "../ControllerQueue/MQTT_queue_element.h"
+#include "../ControllerQueue/SampleLatency.h"
 
 #include "../DataStructs/ControllerSettingsStruct.h"
 #include "../DataStructs/ESPEasy_EventStruct.h"
@@ -14,6 +15,7 @@
 #include "../DataTypes/SPI_options.h"
 
 #include "../ESPEasyCore/ESPEasyRules.h"
+#include "../ESPEasyCore/ESPEasy_setup.h"
 #include "../ESPEasyCore/Serial.h"
 
 #include "../Globals/CPlugins.h"
@@ -25,10 +27,16 @@
 #include "../Globals/RulesCalculate.h"
 
 #include "../Helpers/_CPlugin_Helper.h"
+#include "../Helpers/ESPEasy_Storage.h"
+#include "../Helpers/ESPEasy_time_calc.h"
+#include "../Helpers/FormattedTaskValues.h"
+#include "../Helpers/HeapTracker.h"
 #include "../Helpers/Misc.h"
 #include "../Helpers/Network.h"
 #include "../Helpers/PeriodicalActions.h"
 #include "../Helpers/PortStatus.h"
+#include "../WebServer/EventStream.h"
+#include "../WebServer/Metrics.h"
 
 
 constexpr pluginID_t PLUGIN_ID_MQTT_IMPORT(37);
@@ -44,6 +52,28 @@ void sendData(struct EventStruct *event)
   #endif // ifndef BUILD_NO_RAM_TRACKER
 //  LoadTaskSettings(event->TaskIndex);
 
+  // Format the task values only once for rules, web event stream, value logger and all controllers
+  FormattedTaskValuesScope formattedTaskValues(event);
+
+  #if FEATURE_SAMPLE_LATENCY
+
+  // Queue elements created by the controllers get the read time of the sample
+  SampleReadTimeScope sampleReadTime(event->readTime_usec);
+  #endif // if FEATURE_SAMPLE_LATENCY
+
+  #if FEATURE_JSON_DELTA
+  UserVar.markUpdated(event->TaskIndex, event->getSensorType());
+  #endif // if FEATURE_JSON_DELTA
+  #if FEATURE_TASKVALUE_SNAPSHOT
+  UserVar.publishSnapshot(event->TaskIndex, event->getSensorType());
+  #endif // if FEATURE_TASKVALUE_SNAPSHOT
+  #if FEATURE_WEB_EVENT_STREAM
+  eventStream_sendTaskValues(event);
+  #endif // if FEATURE_WEB_EVENT_STREAM
+  #ifdef WEBSERVER_METRICS
+  metrics_markDevicesDirty();
+  #endif // ifdef WEBSERVER_METRICS
+
   if (Settings.UseRules) {
     createRuleEvents(event);
   }
@@ -65,17 +95,29 @@ void sendData(struct EventStruct *event)
     {
       protocolIndex_t ProtocolIndex = getProtocolIndex_from_ControllerIndex(event->ControllerIndex);
 
+      #if FEATURE_SEND_ON_CHANGE
+
+      // Check before allocating a queue element
+      if (Settings.SendOnChange(event->TaskIndex, x) &&
+          !UserVar.mustSendToController(
+            event->TaskIndex,
+            x,
+            event->getSensorType(),
+            getValueCountForTask(event->TaskIndex),
+            Settings.SendOnChangeDeadband(event->TaskIndex),
+            Settings.SendOnChangeMaxSilence(event->TaskIndex) * 1000ul)) {
+        continue;
+      }
+      #endif // if FEATURE_SEND_ON_CHANGE
+
       if (validUserVar(event)) {
+        HEAP_TRACK_SCOPE(ControllerQueue);
         String dummy;
         CPluginCall(ProtocolIndex, CPlugin::Function::CPLUGIN_PROTOCOL_SEND, event, dummy);
       }
 #ifndef BUILD_NO_DEBUG
       else {
-        if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-          String log = F("Invalid value detected for controller ");
-          log += getCPluginNameFromProtocolIndex(ProtocolIndex);
-          addLogMove(LOG_LEVEL_DEBUG, log);
-        }
+        addLogFmt(LOG_LEVEL_DEBUG, F("Invalid value detected for controller %s"), getCPluginNameFromProtocolIndex(ProtocolIndex));
       }
 #endif // ifndef BUILD_NO_DEBUG
     }
@@ -133,20 +175,27 @@ void incoming_mqtt_callback(char *c_topic, uint8_t *b_payload, unsigned int leng
     CPlugin::Function::CPLUGIN_PROTOCOL_RECV,
     c_topic, b_payload, length);
 
+#ifdef USES_P037
   deviceIndex_t DeviceIndex = getDeviceIndex(PLUGIN_ID_MQTT_IMPORT); // Check if P037_MQTTimport is present in the build
 
-  if (validDeviceIndex(DeviceIndex)) {
-    //  Here we loop over all tasks and call each 037 plugin with function PLUGIN_MQTT_IMPORT
-    for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; taskIndex++)
-    {
-      if (Settings.TaskDeviceEnabled[taskIndex] && (Settings.getPluginID_for_task(taskIndex) == PLUGIN_ID_MQTT_IMPORT))
+  if (validDeviceIndex(DeviceIndex) && !P037_MQTTImport_topics.empty()) {
+    // Match the topic once against the subscriptions of all MQTT import tasks,
+    // only the tasks subscribed to this topic get a copy of the message.
+    uint8_t valueMasks[TASKS_MAX] = { 0 };
+
+    if (P037_MQTTImport_topics.match(c_topic, valueMasks)) {
+      for (const taskIndex_t taskIndex : Cache.getEnabledTasks(PLUGIN_ID_MQTT_IMPORT))
       {
-        Scheduler.schedule_mqtt_plugin_import_event_timer(
-          DeviceIndex, taskIndex, PLUGIN_MQTT_IMPORT,
-          c_topic, b_payload, length);
+        if (valueMasks[taskIndex] != 0)
+        {
+          Scheduler.schedule_mqtt_plugin_import_event_timer(
+            DeviceIndex, taskIndex, valueMasks[taskIndex], PLUGIN_MQTT_IMPORT,
+            c_topic, b_payload, length);
+        }
       }
     }
   }
+#endif // ifdef USES_P037
 }
 
 /*********************************************************************************************\
@@ -161,6 +210,48 @@ void MQTTDisconnect()
   updateMQTTclient_connected();
 }
 
+#if FEATURE_MQTT_TLS
+bool MQTTclient_keepConnectionOnReconnect()
+{
+  return MQTTclient_usesTLS &&
+         MQTTclient.connected() &&
+         (NetworkLocalIP() == MQTTclient_tls_localIP);
+}
+
+// Set the CA certificate to check the broker certificate, or accept any certificate when not present.
+void MQTT_setTLS_rootCA()
+{
+  const String fname = F("mqtt_ca.pem");
+
+  if (fileExists(fname)) {
+    if (mqtt_tls_rootCA.isEmpty()) {
+      fs::File f = tryOpenFile(fname, "r");
+
+      if (f) {
+        mqtt_tls_rootCA = f.readString();
+        f.close();
+      }
+    }
+  } else {
+    mqtt_tls_rootCA.clear();
+  }
+
+  if (mqtt_tls_rootCA.isEmpty()) {
+    addLog(LOG_LEVEL_ERROR, F("MQTT : TLS without certificate check, no mqtt_ca.pem"));
+    mqtt_tls.setInsecure();
+  } else {
+    mqtt_tls.setCACert(mqtt_tls_rootCA.c_str());
+  }
+}
+
+#else // if FEATURE_MQTT_TLS
+bool MQTTclient_keepConnectionOnReconnect()
+{
+  return false;
+}
+
+#endif // if FEATURE_MQTT_TLS
+
 /*********************************************************************************************\
 * Connect to MQTT message broker
 \*********************************************************************************************/
@@ -193,6 +284,17 @@ bool MQTTConnect(controllerIndex_t controller_idx)
   //  mqtt = WiFiClient(); // workaround see: https://github.com/esp8266/Arduino/issues/4497#issuecomment-373023864
   delay(0);
 
+  #if FEATURE_MQTT_TLS
+  MQTTclient_usesTLS = ControllerSettings->mqtt_useTLS();
+  WiFiClient& client = MQTTclient_usesTLS ? mqtt_tls : mqtt;
+
+  if (MQTTclient_usesTLS) {
+    MQTT_setTLS_rootCA();
+  }
+  #else
+  WiFiClient& client = mqtt;
+  #endif // if FEATURE_MQTT_TLS
+
   // Ignoring the ACK from the server is probably set for a reason.
   // For example because the server does not give an acknowledgement.
   // This way, we always need the set amount of timeout to handle the request.
@@ -203,14 +305,14 @@ bool MQTTConnect(controllerIndex_t controller_idx)
 
   #ifdef MUSTFIX_CLIENT_TIMEOUT_IN_SECONDS
   // See: https://github.com/espressif/arduino-esp32/pull/6676
-  mqtt.setTimeout((timeout + 500) / 1000); // in seconds!!!!
-  Client *pClient = &mqtt;
+  client.setTimeout((timeout + 500) / 1000); // in seconds!!!!
+  Client *pClient = &client;
   pClient->setTimeout(timeout);
   #else
-  mqtt.setTimeout(timeout); // in msec as it should be!  
+  client.setTimeout(timeout); // in msec as it should be!  
   #endif
   
-  MQTTclient.setClient(mqtt);
+  MQTTclient.setClient(client);
 
   if (ControllerSettings->UseDNS) {
     MQTTclient.setServer(ControllerSettings->getHost().c_str(), ControllerSettings->Port);
@@ -266,6 +368,10 @@ bool MQTTConnect(controllerIndex_t controller_idx)
 
     return false;
   }
+  #if FEATURE_MQTT_TLS
+  MQTTclient_tls_localIP = NetworkLocalIP();
+  #endif // if FEATURE_MQTT_TLS
+
   if (loglevelActiveFor(LOG_LEVEL_INFO)) {
     String log;
     log += F("MQTT : Connected to broker with client ID: ");
@@ -555,6 +661,46 @@ bool MQTTpublish(controllerIndex_t controller_idx, taskIndex_t taskIndex,  Strin
   return success;
 }
 
+bool MQTTpublish(controllerIndex_t controller_idx, taskIndex_t taskIndex,  String&& topic, const std::shared_ptr<const String>& payload, bool retained) {
+  if ((MQTTDelayHandler == nullptr) || !payload) {
+    return false;
+  }
+
+  if (MQTT_queueFull(controller_idx)) {
+    return false;
+  }
+  std::unique_ptr<MQTT_queue_element> element(new (std::nothrow) MQTT_queue_element(controller_idx, taskIndex, std::move(topic), String(), retained, false));
+
+  if (!element) {
+    return false;
+  }
+  element->_sharedPayload = payload;
+  const bool success = MQTTDelayHandler->addToQueue(std::move(element));
+
+  scheduleNextMQTTdelayQueue();
+  return success;
+}
+
+bool MQTTpublishFile(controllerIndex_t controller_idx, taskIndex_t taskIndex,  String&& topic, const String& fileName, bool retained) {
+  if ((MQTTDelayHandler == nullptr) || !fileExists(fileName)) {
+    return false;
+  }
+
+  if (MQTT_queueFull(controller_idx)) {
+    return false;
+  }
+  std::unique_ptr<MQTT_queue_element> element(new (std::nothrow) MQTT_queue_element(controller_idx, taskIndex, std::move(topic), String(), retained, false));
+
+  if (!element) {
+    return false;
+  }
+  element->_payloadFile = fileName;
+  const bool success = MQTTDelayHandler->addToQueue(std::move(element));
+
+  scheduleNextMQTTdelayQueue();
+  return success;
+}
+
 /*********************************************************************************************\
 * Send status info back to channel where request came from
 \*********************************************************************************************/
@@ -607,6 +753,42 @@ void MQTTStatus(struct EventStruct *event, const String& status)
 /*********************************************************************************************\
 * send specific sensor task data, effectively calling PluginCall(PLUGIN_READ...)
 \*********************************************************************************************/
+#if FEATURE_RULES_CALCULATE_CACHE
+bool getFormulaTaskValue(struct EventStruct *event, uint8_t varNr, ESPEASY_RULES_FLOAT_TYPE& value)
+{
+  const Sensor_VType sensorType = event->getSensorType();
+
+  value = UserVar.getAsDouble(event->TaskIndex, varNr, sensorType);
+
+  if (isIntegerOutputDataType(sensorType)) {
+    return true;
+  }
+
+  if (!isfinite(value)) {
+    return false;
+  }
+
+  uint8_t nrDecimals = 0;
+  const deviceIndex_t DeviceIndex = getDeviceIndex_from_TaskIndex(event->TaskIndex);
+
+  if (validDeviceIndex(DeviceIndex) && Device[DeviceIndex].configurableDecimals()) {
+    nrDecimals = Cache.getTaskDeviceValueDecimals(event->TaskIndex, varNr);
+  }
+  ESPEASY_RULES_FLOAT_TYPE factor = 1;
+
+  for (uint8_t i = 0; i < nrDecimals; ++i) {
+    factor *= 10;
+  }
+  #if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+  value = round(value * factor) / factor;
+  #else
+  value = roundf(value * factor) / factor;
+  #endif
+  return true;
+}
+
+#endif // if FEATURE_RULES_CALCULATE_CACHE
+
 void SensorSendTask(struct EventStruct *event, unsigned long timestampUnixTime)
 {
   SensorSendTask(event, timestampUnixTime, millis());
@@ -638,9 +820,25 @@ void SensorSendTask(struct EventStruct *event, unsigned long timestampUnixTime,
     // Store the previous value, in case %pvalue% is used in the formula
     String preValue[VARS_PER_TASK];
     const bool processFormula = Device[DeviceIndex].FormulaOption && Cache.hasFormula(event->TaskIndex);
+    #if FEATURE_RULES_CALCULATE_CACHE
+    ESPEASY_RULES_FLOAT_TYPE preValueCompiled[VARS_PER_TASK]{};
+    const bool useCompiledFormula = TempEvent.sensorType != Sensor_VType::SENSOR_TYPE_STRING;
+    #endif // if FEATURE_RULES_CALCULATE_CACHE
     if (processFormula) {
       for (uint8_t varNr = 0; varNr < valueCount; varNr++)
       {
+        #if FEATURE_RULES_CALCULATE_CACHE
+        if (useCompiledFormula) {
+          const RulesCalculate_program_t *program = Cache.getTaskDeviceFormulaProgram(event->TaskIndex, varNr);
+
+          if (program != nullptr) {
+            if (program->usesVariable(TASK_FORMULA_VAR_PVALUE)) {
+              getFormulaTaskValue(&TempEvent, varNr, preValueCompiled[varNr]);
+            }
+            continue;
+          }
+        }
+        #endif // if FEATURE_RULES_CALCULATE_CACHE
         const String formula = Cache.getTaskDeviceFormula(event->TaskIndex, varNr);
         if (!formula.isEmpty())
         {
@@ -653,6 +851,9 @@ void SensorSendTask(struct EventStruct *event, unsigned long timestampUnixTime,
 
     {
       String dummy;
+      #if FEATURE_SAMPLE_LATENCY
+      TempEvent.readTime_usec = getMicros64();
+      #endif // if FEATURE_SAMPLE_LATENCY
       success = PluginCall(PLUGIN_READ, &TempEvent, dummy);
     }
 
@@ -661,6 +862,24 @@ void SensorSendTask(struct EventStruct *event, unsigned long timestampUnixTime,
       if (processFormula) {
         for (uint8_t varNr = 0; varNr < valueCount; varNr++)
         {
+          #if FEATURE_RULES_CALCULATE_CACHE
+          if (useCompiledFormula) {
+            const RulesCalculate_program_t *program = Cache.getTaskDeviceFormulaProgram(event->TaskIndex, varNr);
+
+            if (program != nullptr) {
+              START_TIMER;
+              ESPEASY_RULES_FLOAT_TYPE value{};
+              ESPEASY_RULES_FLOAT_TYPE result{};
+
+              if (getFormulaTaskValue(&TempEvent, varNr, value) &&
+                  !isError(CalculateTaskFormula(*program, value, preValueCompiled[varNr], result))) {
+                UserVar.set(event->TaskIndex, varNr, result, TempEvent.sensorType);
+              }
+              STOP_TIMER(COMPUTE_FORMULA_STATS);
+              continue;
+            }
+          }
+          #endif // if FEATURE_RULES_CALCULATE_CACHE
           String formula = Cache.getTaskDeviceFormula(event->TaskIndex, varNr);
           if (!formula.isEmpty())
           {
@@ -681,6 +900,7 @@ void SensorSendTask(struct EventStruct *event, unsigned long timestampUnixTime,
         }
       }
       sendData(&TempEvent);
+      ESPEasy_setup_firstSampleSent();
     }
   }
 }
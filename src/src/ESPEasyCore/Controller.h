@@ -6,6 +6,8 @@
 #include "../DataTypes/EventValueSource.h"
 #include "../Globals/CPlugins.h"
 
+#include <memory>
+
 // ********************************************************************************
 // Interface for Sending to Controllers
 // ********************************************************************************
@@ -31,6 +33,10 @@ void MQTTDisconnect();
 \*********************************************************************************************/
 bool MQTTConnect(controllerIndex_t controller_idx);
 
+// Return true when the current MQTT connection can be kept after the network was reconnected.
+// Only a TLS connection is kept, to save the TLS handshake, when the local IP address did not change.
+bool MQTTclient_keepConnectionOnReconnect();
+
 String getMQTTclientID(const ControllerSettingsStruct& ControllerSettings);
 
 /*********************************************************************************************\
@@ -67,6 +73,14 @@ bool MQTTpublish(controllerIndex_t controller_idx, taskIndex_t taskIndex,  const
 // Publish using the move operator for topic and message
 bool MQTTpublish(controllerIndex_t controller_idx, taskIndex_t taskIndex,  String&& topic, String&& payload, bool retained, bool callbackTask = false);
 
+// Publish a payload which is shared, not copied, e.g. to publish the same large message to several topics or controllers.
+bool MQTTpublish(controllerIndex_t controller_idx, taskIndex_t taskIndex,  String&& topic, const std::shared_ptr<const String>& payload, bool retained);
+
+// Publish the content of a file, read in small chunks while sending.
+// The payload size is not limited by the free heap or MQTT_MAX_PACKET_SIZE.
+// The file must remain present until it is published.
+bool MQTTpublishFile(controllerIndex_t controller_idx, taskIndex_t taskIndex,  String&& topic, const String& fileName, bool retained);
+
 
 /*********************************************************************************************\
 * Send status info back to channel where request came from
@@ -75,6 +89,15 @@ void MQTTStatus(struct EventStruct *event, const String& status);
 #endif //if FEATURE_MQTT
 
 
+#if FEATURE_RULES_CALCULATE_CACHE
+
+// Get the task value to use in a compiled formula.
+// Rounded to the number of decimals, just like the formatted value used in a formula which is not compiled.
+bool getFormulaTaskValue(struct EventStruct      *event,
+                         uint8_t                  varNr,
+                         ESPEASY_RULES_FLOAT_TYPE& value);
+#endif // if FEATURE_RULES_CALCULATE_CACHE
+
 /*********************************************************************************************\
  * send specific sensor task data, effectively calling PluginCall(PLUGIN_READ...)
 \*********************************************************************************************/
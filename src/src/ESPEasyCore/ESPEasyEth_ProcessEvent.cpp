@@ -4,6 +4,7 @@
 
 # include "../../ESPEasy-Globals.h"
 
+# include "../ESPEasyCore/Controller.h"
 # include "../ESPEasyCore/ESPEasyEth.h"
 # include "../ESPEasyCore/ESPEasyNetwork.h"
 # include "../ESPEasyCore/ESPEasyWifi.h" // LogConnectionStatus
@@ -21,6 +22,7 @@
 # include "../Helpers/Networking.h"
 # include "../Helpers/PeriodicalActions.h"
 # include "../Helpers/StringConverter.h"
+# include "../Helpers/StringProvider.h"
 
 # include <ETH.h>
 
@@ -116,6 +118,9 @@ void processEthernetConnected() {
   addLog(LOG_LEVEL_INFO, F("processEthernetConnected()"));
   EthEventData.setEthConnected();
   EthEventData.processedConnect = true;
+  # if FEATURE_LABEL_VALUE_CACHE
+  clearLabelValueCache(LabelVolatility::Network);
+  # endif // if FEATURE_LABEL_VALUE_CACHE
 
   if (Settings.UseRules)
   {
@@ -130,6 +135,9 @@ void processEthernetDisconnected() {
   if (EthEventData.processedDisconnect) { return; }
   EthEventData.setEthDisconnected();
   EthEventData.processedDisconnect     = true;
+  # if FEATURE_LABEL_VALUE_CACHE
+  clearLabelValueCache(LabelVolatility::Network);
+  # endif // if FEATURE_LABEL_VALUE_CACHE
   EthEventData.ethConnectAttemptNeeded = true;
 
   if (Settings.UseRules)
@@ -223,7 +231,8 @@ void processEthernetGotIP() {
   }
 # if FEATURE_MQTT
   mqtt_reconnect_count        = 0;
-  MQTTclient_should_reconnect = true;
+  // Keep a TLS connection which survived the network interruption, to save a new handshake.
+  MQTTclient_should_reconnect = !MQTTclient_keepConnectionOnReconnect();
   timermqtt_interval          = 100;
   Scheduler.setIntervalTimer(SchedulerIntervalTimer_e::TIMER_MQTT);
   scheduleNextMQTTdelayQueue();
@@ -239,6 +248,9 @@ void processEthernetGotIP() {
 
   EthEventData.processedGotIP = true;
   EthEventData.setEthGotIP();
+  # if FEATURE_LABEL_VALUE_CACHE
+  clearLabelValueCache(LabelVolatility::Network);
+  # endif // if FEATURE_LABEL_VALUE_CACHE
   CheckRunningServices();
 }
 
@@ -10,6 +10,10 @@
 #include "../Helpers/Hardware.h"
 #include "../Helpers/PortStatus.h"
 
+#if defined(USES_P009) || defined(USES_P019)
+#include <list>
+#endif
+
 
 
 //********************************************************************************
@@ -100,7 +104,14 @@ int8_t GPIO_MCP_Read(int Par1)
     port = port % 8;
 
     uint8_t retValue;
-    if (GPIO_MCP_ReadRegister(address,IOBankValueReg,&retValue)) {
+    uint16_t allPins = 0;
+    bool success = false;
+    if (GPIO_Expander_INT_read(PLUGIN_MCP, address, allPins, success)) {
+      retValue = (IOBankValueReg == MCP23017_GPIOA) ? (allPins & 0xFF) : (allPins >> 8);
+    } else {
+      success = GPIO_MCP_ReadRegister(address,IOBankValueReg,&retValue);
+    }
+    if (success) {
       retValue = (retValue & (1 << port)) >> port;
       pinState = (retValue==0)?0:1;
 
@@ -141,6 +152,7 @@ bool GPIO_MCP_ReadRegister(uint8_t mcpAddr, uint8_t regAddr, uint8_t *retValue)
 void GPIO_MCP_WriteRegister(uint8_t mcpAddr, uint8_t regAddr, uint8_t regValue) {
   // Write the register
   I2C_write8_reg(mcpAddr, regAddr, regValue);
+  GPIO_Expander_INT_invalidate(PLUGIN_MCP, mcpAddr);
 }
 
 
@@ -296,9 +308,8 @@ int8_t GPIO_PCF_Read(int Par1)
     if (unit > 7) address += 0x10;
 
     // get the current pin status
-    bool is_ok = false;
-    const uint8_t value = I2C_read8(address, &is_ok);
-    if (is_ok) 
+    uint8_t value = 0;
+    if (GPIO_PCF_ReadAllPins(address, &value))
     {
       state = ((value & _BV(port)) >> (port));
     }
@@ -309,6 +320,14 @@ int8_t GPIO_PCF_Read(int Par1)
 bool GPIO_PCF_ReadAllPins(uint8_t address, uint8_t *retValue)
 {
   bool success = false;
+  uint16_t allPins = 0;
+
+  if (GPIO_Expander_INT_read(PLUGIN_PCF, address, allPins, success)) {
+    if (success) {
+      *retValue = allPins & 0xFF;
+    }
+    return success;
+  }
 
   const uint8_t value = I2C_read8(address, &success);
   if (success) {
@@ -324,6 +343,7 @@ bool GPIO_PCF_ReadAllPins(uint8_t address, uint8_t *retValue)
 void GPIO_PCF_WriteAllPins(uint8_t address, uint8_t value)
 {
   I2C_write8(address, value);
+  GPIO_Expander_INT_invalidate(PLUGIN_PCF, address);
 }
 
 bool GPIO_PCF_Write(int Par1, uint8_t Par2)
@@ -399,6 +419,173 @@ bool setPCFInputMode(uint8_t pin)
 }
 #endif
 
+#if defined(USES_P009) || defined(USES_P019)
+//********************************************************************************
+// I/O expander INT pin
+//********************************************************************************
+// The INT line may be shared by several chips (e.g. open drain output of the PCF8574)
+struct GPIO_Expander_INT_pin_t {
+  int8_t            pin      = -1;
+  uint8_t           refCount = 0;
+  volatile uint32_t edgeCount = 0;
+};
+
+struct GPIO_Expander_INT_chip_t {
+  GPIO_Expander_INT_pin_t *intPin           = nullptr;
+  uint32_t                 handledEdgeCount = 0;
+  uint16_t                 value            = 0;
+  uint8_t                  pluginID         = 0;
+  uint8_t                  address          = 0;
+  uint8_t                  refCount         = 0;
+  bool                     valid            = false;
+};
+
+// Use std::list as the ISR keeps a pointer to the pin
+static std::list<GPIO_Expander_INT_pin_t>  GPIO_Expander_INT_pins;
+static std::list<GPIO_Expander_INT_chip_t> GPIO_Expander_INT_chips;
+
+static void IRAM_ATTR GPIO_Expander_INT_ISR(void *arg)
+{
+  ++(static_cast<GPIO_Expander_INT_pin_t *>(arg)->edgeCount);
+}
+
+static GPIO_Expander_INT_chip_t* GPIO_Expander_INT_find(pluginID_t pluginID, uint8_t address)
+{
+  for (auto it = GPIO_Expander_INT_chips.begin(); it != GPIO_Expander_INT_chips.end(); ++it) {
+    if ((it->pluginID == pluginID.value) && (it->address == address)) {
+      return &(*it);
+    }
+  }
+  return nullptr;
+}
+
+// Active low INT output is asserted or an edge occurred since the last read
+static bool GPIO_Expander_INT_pending(const GPIO_Expander_INT_chip_t& chip)
+{
+  return !chip.valid ||
+         (chip.handledEdgeCount != chip.intPin->edgeCount) ||
+         (digitalRead(chip.intPin->pin) == LOW);
+}
+
+bool GPIO_Expander_INT_attach(pluginID_t pluginID, uint8_t address, uint8_t port, int8_t intPin)
+{
+  if ((intPin < 0) || (digitalPinToInterrupt(intPin) == NOT_AN_INTERRUPT)) {
+    return false;
+  }
+  GPIO_Expander_INT_chip_t *chip = GPIO_Expander_INT_find(pluginID, address);
+
+  if (chip == nullptr) {
+    GPIO_Expander_INT_pin_t *pin = nullptr;
+
+    for (auto it = GPIO_Expander_INT_pins.begin(); pin == nullptr && it != GPIO_Expander_INT_pins.end(); ++it) {
+      if (it->pin == intPin) {
+        pin = &(*it);
+      }
+    }
+
+    if (pin == nullptr) {
+      GPIO_Expander_INT_pins.emplace_back();
+      pin      = &GPIO_Expander_INT_pins.back();
+      pin->pin = intPin;
+      pinMode(intPin, INPUT_PULLUP);
+      attachInterruptArg(digitalPinToInterrupt(intPin), GPIO_Expander_INT_ISR, pin, FALLING);
+    }
+    ++(pin->refCount);
+
+    GPIO_Expander_INT_chips.emplace_back();
+    chip           = &GPIO_Expander_INT_chips.back();
+    chip->intPin   = pin;
+    chip->pluginID = pluginID.value;
+    chip->address  = address;
+  }
+  ++(chip->refCount);
+
+#ifdef USES_P009
+  if ((pluginID == PLUGIN_MCP) && (port > 0) && (port <= 16)) {
+    // Mirror INTA and INTB, so a single INT pin covers all 16 pins.
+    uint8_t value = 0;
+    if (GPIO_MCP_ReadRegister(address, MCP23017_IOCON, &value)) {
+      GPIO_MCP_WriteRegister(address, MCP23017_IOCON, value | MCP23017_IOCON_MIRROR);
+    }
+
+    // Enable interrupt-on-change, compared against the previous value
+    const uint8_t GPINTENReg = (port <= 8) ? MCP23017_GPINTENA : MCP23017_GPINTENB;
+    if (GPIO_MCP_ReadRegister(address, GPINTENReg, &value)) {
+      GPIO_MCP_WriteRegister(address, GPINTENReg, value | (1 << ((port - 1) % 8)));
+    }
+  }
+#endif
+  chip->valid = false;
+  return true;
+}
+
+void GPIO_Expander_INT_detach(pluginID_t pluginID, uint8_t address)
+{
+  for (auto it = GPIO_Expander_INT_chips.begin(); it != GPIO_Expander_INT_chips.end(); ++it) {
+    if ((it->pluginID == pluginID.value) && (it->address == address)) {
+      if (--(it->refCount) == 0) {
+        GPIO_Expander_INT_pin_t *pin = it->intPin;
+        GPIO_Expander_INT_chips.erase(it);
+
+        if (--(pin->refCount) == 0) {
+          detachInterrupt(digitalPinToInterrupt(pin->pin));
+
+          for (auto pin_it = GPIO_Expander_INT_pins.begin(); pin_it != GPIO_Expander_INT_pins.end(); ++pin_it) {
+            if (&(*pin_it) == pin) {
+              GPIO_Expander_INT_pins.erase(pin_it);
+              break;
+            }
+          }
+        }
+      }
+      return;
+    }
+  }
+}
+
+bool GPIO_Expander_INT_read(pluginID_t pluginID, uint8_t address, uint16_t& value, bool& success)
+{
+  GPIO_Expander_INT_chip_t *chip = GPIO_Expander_INT_find(pluginID, address);
+
+  if (chip == nullptr) {
+    return false;
+  }
+
+  if (GPIO_Expander_INT_pending(*chip)) {
+    // Store the edge count before reading, so a change during the read is not missed.
+    chip->handledEdgeCount = chip->intPin->edgeCount;
+    bool is_ok = false;
+
+    if (pluginID == PLUGIN_MCP) {
+      // GPIOA and GPIOB in a single transaction, which also clears the interrupt
+      chip->value = I2C_read16_LE_reg(address, MCP23017_GPIOA, &is_ok);
+    } else {
+      chip->value = I2C_read8(address, &is_ok);
+    }
+    chip->valid = is_ok;
+  }
+  value   = chip->value;
+  success = chip->valid;
+  return true;
+}
+
+bool GPIO_Expander_INT_idle(pluginID_t pluginID, uint8_t address)
+{
+  const GPIO_Expander_INT_chip_t *chip = GPIO_Expander_INT_find(pluginID, address);
+
+  return chip != nullptr && !GPIO_Expander_INT_pending(*chip);
+}
+
+void GPIO_Expander_INT_invalidate(pluginID_t pluginID, uint8_t address)
+{
+  GPIO_Expander_INT_chip_t *chip = GPIO_Expander_INT_find(pluginID, address);
+
+  if (chip != nullptr) {
+    chip->valid = false;
+  }
+}
+#endif
+
 
 //*********************************************************
 // GPIO_Monitor10xSec:
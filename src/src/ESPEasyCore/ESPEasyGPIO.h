@@ -14,6 +14,11 @@
 #define MCP23017_GPPUB  0x0D   //!< Pullup resistor register B
 #define MCP23017_GPIOB  0x13   //!< General purpose I/O port register B
 
+#define MCP23017_GPINTENA 0x04 //!< Interrupt-on-change enable register A
+#define MCP23017_GPINTENB 0x05 //!< Interrupt-on-change enable register B
+#define MCP23017_IOCON    0x0A //!< Configuration register
+#define MCP23017_IOCON_MIRROR 0x40 //!< INTA and INTB are internally connected
+
 //********************************************************************************
 // Internal GPIO write
 //********************************************************************************
@@ -59,6 +64,28 @@ bool GPIO_PCF_Write(int Par1, uint8_t Par2);
 void GPIO_PCF_WriteAllPins(uint8_t Par1, uint8_t Par2);
 #endif
 
+#if defined(USES_P009) || defined(USES_P019)
+//********************************************************************************
+// I/O expander INT pin
+// The INT output of a MCP23017 or PCF8574 signals a change on any of its input pins.
+// With an INT pin attached, the pins of the chip are only read via I2C after an interrupt,
+// using a single read of all pins, shared by all tasks and monitors using that chip.
+//********************************************************************************
+// port: 1-based port nr on the chip, only used for the MCP23017 to enable interrupt-on-change.
+bool GPIO_Expander_INT_attach(pluginID_t pluginID, uint8_t address, uint8_t port, int8_t intPin);
+void GPIO_Expander_INT_detach(pluginID_t pluginID, uint8_t address);
+
+// Return true when the chip has an INT pin attached, value is then set to the state of all pins.
+// Only reads the chip when an interrupt occurred since the last read.
+bool GPIO_Expander_INT_read(pluginID_t pluginID, uint8_t address, uint16_t& value, bool& success);
+
+// Return true when the chip has an INT pin attached and no change is pending.
+bool GPIO_Expander_INT_idle(pluginID_t pluginID, uint8_t address);
+
+// Force a read on next access, e.g. after writing to the chip.
+void GPIO_Expander_INT_invalidate(pluginID_t pluginID, uint8_t address);
+#endif
+
 //*********************************************************
 // GPIO_Monitor10xSec:
 // What it does:
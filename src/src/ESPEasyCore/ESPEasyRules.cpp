@@ -6,6 +6,7 @@
 #include "../DataStructs/TimingStats.h"
 #include "../DataTypes/EventValueSource.h"
 #include "../ESPEasyCore/ESPEasy_backgroundtasks.h"
+#include "../ESPEasyCore/ESPEasy_setup.h"
 #include "../ESPEasyCore/Serial.h"
 #include "../Globals/Cache.h"
 #include "../Globals/Device.h"
@@ -13,14 +14,20 @@
 #include "../Globals/Plugins.h"
 #include "../Globals/Plugins_other.h"
 #include "../Globals/RulesCalculate.h"
+#include "../Globals/ESPEasy_Scheduler.h"
 #include "../Globals/Settings.h"
+#include "../Globals/Statistics.h"
 #include "../Helpers/ESPEasy_Storage.h"
+#include "../Helpers/EventTracer.h"
+#include "../Helpers/HeapTracker.h"
 #include "../Helpers/ESPEasy_time_calc.h"
 #include "../Helpers/FS_Helper.h"
+#include "../Helpers/Memory.h"
 #include "../Helpers/Misc.h"
 #include "../Helpers/Numerical.h"
 #include "../Helpers/RulesHelper.h"
 #include "../Helpers/RulesMatcher.h"
+#include "../Helpers/SlowLoopDetector.h"
 #include "../Helpers/StringConverter.h"
 #include "../Helpers/StringParser.h"
 
@@ -61,6 +68,13 @@ String FileNameToEvent(const String& fileName) {
 
 void checkRuleSets() {
   Cache.rulesHelper.closeAllFiles();
+#if FEATURE_RULES_COMPILED
+
+  if (!Settings.EnableRulesCompiled()) {
+    // Remove what is left from when compiled rules were enabled
+    Cache.rulesHelper.deleteCompiledRules();
+  }
+#endif // if FEATURE_RULES_COMPILED
 }
 
 /********************************************************************************************\
@@ -69,6 +83,7 @@ void checkRuleSets() {
 bool processNextEvent() {
   if (Settings.UseRules)
   {
+    HEAP_TRACK_SCOPE(Rules);
     String nextEvent;
 
     if (eventQueue.getNext(nextEvent)) {
@@ -82,6 +97,66 @@ bool processNextEvent() {
   return false;
 }
 
+/********************************************************************************************\
+   Process queued events within the time budget of the current loop
+ \*********************************************************************************************/
+void processEventQueue() {
+  // Time already spent on processing events during this loop
+  static unsigned long lastLoopCounter = 0;
+  static uint64_t usedBudget_usec      = 0;
+
+  if (lastLoopCounter != loopCounter_full) {
+    lastLoopCounter = loopCounter_full;
+    usedBudget_usec = 0;
+  }
+
+  if (ESPEasy_setup_deferredPending()) {
+    // Keep the events until System#Boot has been processed.
+    return;
+  }
+
+  if (eventQueue.isEmpty()) {
+    // Make sure the queue will be cleared, when rules are disabled.
+    processNextEvent();
+    return;
+  }
+  START_TIMER
+  ADD_TIMER_STAT(RULES_EVENT_QUEUE_DEPTH, eventQueue.size());
+
+  const uint64_t budget_usec = Settings.getRulesEventBudget();
+  const uint64_t start       = getMicros64();
+  bool first                 = true;
+
+  // Always process at least one event per loop, to guarantee progress.
+  while ((first || (usedBudget_usec + usecPassedSince(start)) < budget_usec) &&
+         processNextEvent()) {
+    first = false;
+
+    if (Scheduler.hasScheduledTimerDue()) {
+      // Give scheduled jobs a chance to run, continue with the events later.
+      break;
+    }
+  }
+  usedBudget_usec += usecPassedSince(start);
+  STOP_TIMER(RULES_EVENT_QUEUE_PASS);
+}
+
+/********************************************************************************************\
+   Yield at block boundaries when processing an event takes longer than the event budget
+ \*********************************************************************************************/
+static uint64_t rulesProcessingStart = 0;
+
+#if FEATURE_RULES_PROFILING
+static uint32_t rulesCommandsExecuted = 0;
+#endif // if FEATURE_RULES_PROFILING
+
+void rulesProcessingYield() {
+  if ((rulesProcessingStart != 0) &&
+      (usecPassedSince(rulesProcessingStart) > static_cast<int64_t>(Settings.getRulesEventBudget()))) {
+    backgroundtasks();
+  }
+}
+
 /********************************************************************************************\
    Rules processing
  \*********************************************************************************************/
@@ -90,6 +165,7 @@ void rulesProcessing(const String& event) {
     return;
   }
   START_TIMER
+  EVENT_TRACE_SCOPE(Rules, 0);
   #ifndef BUILD_NO_RAM_TRACKER
   checkRAM(F("rulesProcessing"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
@@ -97,21 +173,45 @@ void rulesProcessing(const String& event) {
   const unsigned long timer = millis();
 #endif // ifndef BUILD_NO_DEBUG
 
-  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-    String log = F("EVENT: ");
-    log += event;
-    addLogMove(LOG_LEVEL_INFO, log);
+  // Only keep track of the start of the outer event, not nested ones.
+  const bool outerEvent = rulesProcessingStart == 0;
+
+  if (outerEvent) {
+    rulesProcessingStart = getMicros64();
   }
 
+  addLogFmt(LOG_LEVEL_INFO, F("EVENT: %s"), event);
+
   if (Settings.OldRulesEngine()) {
     bool eventHandled = false;
 
     if (Settings.EnableRulesCaching()) {
       String filename;
-      size_t pos = 0;
-      if (Cache.rulesHelper.findMatchingRule(event, filename, pos)) {
-        const bool startOnMatched = true; // We already matched the event
-        eventHandled = rulesProcessingFile(filename, event, pos, startOnMatched);
+      size_t pos        = 0;
+      size_t cacheIndex = 0;
+      if (Cache.rulesHelper.findMatchingRule(event, filename, pos, cacheIndex)) {
+#if FEATURE_RULES_PROFILING
+        // N.B. Includes the commands and time spent in nested events
+        const uint64_t profileStart      = getMicros64();
+        const uint32_t profileNrCommands = rulesCommandsExecuted;
+        const int32_t  profileFreeMem    = FreeMem();
+#endif // if FEATURE_RULES_PROFILING
+#if FEATURE_RULES_COMPILED
+        if (Settings.EnableRulesCompiled()) {
+          eventHandled = rulesProcessingCompiled(filename, event, pos);
+        } else
+#endif // if FEATURE_RULES_COMPILED
+        {
+          const bool startOnMatched = true; // We already matched the event
+          eventHandled = rulesProcessingFile(filename, event, pos, startOnMatched);
+        }
+#if FEATURE_RULES_PROFILING
+        Cache.rulesHelper.addProfile(
+          cacheIndex,
+          usecPassedSince(profileStart),
+          rulesCommandsExecuted - profileNrCommands,
+          static_cast<int32_t>(FreeMem()) - profileFreeMem);
+#endif // if FEATURE_RULES_PROFILING
       }
     } else {
       for (uint8_t x = 0; x < RULESETS_MAX && !eventHandled; x++) {
@@ -128,9 +228,7 @@ void rulesProcessing(const String& event) {
     }
 # ifndef BUILD_NO_DEBUG
     else {
-      addLog(LOG_LEVEL_DEBUG, String(F("EVENT: ")) + event +
-             F(" is ingnored. File ") + fileName +
-             F(" not found."));
+      addLogFmt(LOG_LEVEL_DEBUG, F("EVENT: %s is ingnored. File %s not found."), event, fileName);
     }
 # endif    // ifndef BUILD_NO_DEBUG
     #endif // WEBSERVER_NEW_RULES
@@ -138,15 +236,15 @@ void rulesProcessing(const String& event) {
 
 #ifndef BUILD_NO_DEBUG
 
-  if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-    String log = F("EVENT: ");
-    log += event;
-    log += F(" Processing time:");
-    log += timePassedSince(timer);
-    log += F(" milliSeconds");
-    addLogMove(LOG_LEVEL_DEBUG, log);
-  }
+  addLogFmt(LOG_LEVEL_DEBUG, F("EVENT: %s Processing time:%d milliSeconds"), event, timePassedSince(timer));
 #endif // ifndef BUILD_NO_DEBUG
+
+  if (outerEvent) {
+    #if FEATURE_SLOW_LOOP_DETECTOR
+    SlowLoop_rulesEvent(event, usecPassedSince(rulesProcessingStart));
+    #endif // if FEATURE_SLOW_LOOP_DETECTOR
+    rulesProcessingStart = 0;
+  }
   STOP_TIMER(RULES_PROCESSING);
   backgroundtasks();
 }
@@ -204,6 +302,7 @@ bool rulesProcessingFile(const String& fileName,
     {
       START_TIMER
       const bool matched_before_parse = match;
+      const uint8_t ifBlock_before_parse = ifBlock;
       bool isOneLiner = false;
       parseCompleteNonCommentLine(line, event, action, match, codeBlock,
                                   isCommand, isOneLiner, condition, ifBranche, ifBlock,
@@ -214,6 +313,9 @@ bool rulesProcessingFile(const String& fileName,
         // So we're done processing
         eventHandled = true;
         backgroundtasks();
+      } else if (match && (ifBlock < ifBlock_before_parse)) {
+        // Crossed an "endif" in a long block
+        rulesProcessingYield();
       }
       STOP_TIMER(RULES_PARSE_LINE);
     }
@@ -242,6 +344,143 @@ bool rulesProcessingFile(const String& fileName,
   return eventHandled; // && nestingLevel == 0;
 }
 
+#if FEATURE_RULES_COMPILED
+
+/********************************************************************************************\
+   Evaluate a condition of a compiled if/elseif
+ \*********************************************************************************************/
+bool compiledConditionMatch(const String& condition, const String& event)
+{
+  String check = condition;
+
+  substitute_eventvalue(check, event);
+  check = parseTemplate(check);
+  check.toLowerCase();
+  check.trim();
+  #ifndef BUILD_NO_DEBUG
+  const String orig_check = check;
+  #endif // ifndef BUILD_NO_DEBUG
+  const bool res = conditionMatchExtended(check);
+  #ifndef BUILD_NO_DEBUG
+
+  if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+    String log = F("Rules : [if ");
+    log += orig_check;
+    log += F("]=");
+    log += boolToString(res);
+    addLogMove(LOG_LEVEL_DEBUG, log);
+  }
+  #endif // ifndef BUILD_NO_DEBUG
+  return res;
+}
+
+/********************************************************************************************\
+   Rules processing using the compiled rules
+   pos is the position of the compiled "on ... do" matching the event.
+ \*********************************************************************************************/
+bool rulesProcessingCompiled(const String& fileName,
+                             const String& event,
+                             size_t        pos) {
+  if (!Settings.UseRules) {
+    return false;
+  }
+  static uint8_t nestingLevel = 0;
+
+  nestingLevel++;
+
+  if (nestingLevel > RULES_MAX_NESTING_LEVEL) {
+    addLog(LOG_LEVEL_ERROR, F("EVENT: Error: Nesting level exceeded!"));
+    nestingLevel--;
+    return false;
+  }
+
+  RulesCompiled_op op;
+  bool eventHandled = false;
+
+  if (Cache.rulesHelper.readCompiledOp(fileName, pos, op)) {
+    if (op.opcode == RulesCompiled_opcode::OnOneLiner) {
+      eventHandled = true;
+      START_TIMER
+      String action = op.text;
+      substitute_eventvalue(action, event);
+      action = parseTemplate(action);
+      executeRulesAction(action);
+      STOP_TIMER(RULES_PROCESS_MATCHED);
+    } else if (op.opcode == RulesCompiled_opcode::On) {
+      eventHandled = true;
+      bool done = false;
+
+      while (!done && Cache.rulesHelper.readCompiledOp(fileName, pos, op)) {
+        switch (op.opcode) {
+          case RulesCompiled_opcode::If:
+          {
+            // Find the first branch with a matching condition
+            bool condition = compiledConditionMatch(op.text, event);
+
+            while (!condition && !done) {
+              pos = op.jump;
+
+              if (!Cache.rulesHelper.readCompiledOp(fileName, pos, op)) {
+                done = true;
+              } else if (op.opcode == RulesCompiled_opcode::ElseIf) {
+                condition = compiledConditionMatch(op.text, event);
+              } else if ((op.opcode == RulesCompiled_opcode::Else) ||
+                         (op.opcode == RulesCompiled_opcode::EndIf)) {
+                condition = true;
+              } else {
+                // End of the block, missing "endif"
+                done = true;
+              }
+            }
+            break;
+          }
+          case RulesCompiled_opcode::ElseIf:
+          case RulesCompiled_opcode::Else:
+          {
+            // Reached the end of the executed branch, skip to the "endif"
+            while (!done && (op.opcode != RulesCompiled_opcode::EndIf)) {
+              pos = op.jump;
+
+              if (!Cache.rulesHelper.readCompiledOp(fileName, pos, op) ||
+                  ((op.opcode != RulesCompiled_opcode::ElseIf) &&
+                   (op.opcode != RulesCompiled_opcode::Else) &&
+                   (op.opcode != RulesCompiled_opcode::EndIf))) {
+                done = true;
+              }
+            }
+            break;
+          }
+          case RulesCompiled_opcode::EndIf:
+            rulesProcessingYield();
+            break;
+          case RulesCompiled_opcode::Command:
+          {
+            START_TIMER
+            String action = op.text;
+            substitute_eventvalue(action, event);
+            action = parseTemplate(action);
+            executeRulesAction(action);
+            STOP_TIMER(RULES_PROCESS_MATCHED);
+            break;
+          }
+          case RulesCompiled_opcode::On:
+          case RulesCompiled_opcode::OnOneLiner:
+          case RulesCompiled_opcode::EndOn:
+          case RulesCompiled_opcode::Invalid:
+            done = true;
+            break;
+        }
+      }
+    }
+  }
+
+  nestingLevel--;
+  backgroundtasks();
+  return eventHandled;
+}
+
+#endif // if FEATURE_RULES_COMPILED
+
 
 /********************************************************************************************\
    Parse string commands
@@ -977,22 +1216,25 @@ void processMatchedRule(String& action, const String& event,
   // the condition matches the if or else block.
   if (isCommand) {
     substitute_eventvalue(action, event);
+    executeRulesAction(action);
+  }
+}
 
-    const bool executeRestricted = equals(parseString(action, 1), F("restrict"));
+void executeRulesAction(String& action) {
+#if FEATURE_RULES_PROFILING
+  ++rulesCommandsExecuted;
+#endif // if FEATURE_RULES_PROFILING
 
-    if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-      String actionlog = executeRestricted ? F("ACT  : (restricted) ") : F("ACT  : ");
-      actionlog += action;
-      addLogMove(LOG_LEVEL_INFO, actionlog);
-    }
+  const bool executeRestricted = equals(parseString(action, 1), F("restrict"));
 
-    if (executeRestricted) {
-      ExecuteCommand_all(EventValueSource::Enum::VALUE_SOURCE_RULES_RESTRICTED, parseStringToEndKeepCase(action, 2).c_str());
-    } else {
-      ExecuteCommand_all(EventValueSource::Enum::VALUE_SOURCE_RULES, action.c_str());
-    }
-    delay(0);
+  addLogFmt(LOG_LEVEL_INFO, executeRestricted ? F("ACT  : (restricted) %s") : F("ACT  : %s"), action);
+
+  if (executeRestricted) {
+    ExecuteCommand_all(EventValueSource::Enum::VALUE_SOURCE_RULES_RESTRICTED, parseStringToEndKeepCase(action, 2).c_str());
+  } else {
+    ExecuteCommand_all(EventValueSource::Enum::VALUE_SOURCE_RULES, action.c_str());
   }
+  delay(0);
 }
 
 /********************************************************************************************\
@@ -1301,6 +1543,9 @@ void createRuleEvents(struct EventStruct *event) {
 
   if (!validDeviceIndex(DeviceIndex)) { return; }
 
+  // Do not format any value when no rule can handle events of this task.
+  if (!eventQueue.taskEventMayMatch(event->TaskIndex)) { return; }
+
   #ifdef USE_SECOND_HEAP
 //  HeapSelectIram ephemeral;  
 // TD-er: Disabled for now, suspect for causing crashes
@@ -21,6 +21,18 @@ void   checkRuleSets();
  \*********************************************************************************************/
 bool   processNextEvent();
 
+/********************************************************************************************\
+   Process queued events, as long as the rules event budget of this loop allows.
+   At least one event is processed per loop.
+ \*********************************************************************************************/
+void   processEventQueue();
+
+/********************************************************************************************\
+   Run background tasks when the current event has exceeded the rules event budget.
+   Called at block boundaries of rules.
+ \*********************************************************************************************/
+void   rulesProcessingYield();
+
 
 /********************************************************************************************\
    Rules processing
@@ -36,6 +48,21 @@ bool rulesProcessingFile(const String& fileName,
                          size_t pos = 0,
                          bool   startOnMatched = false);
 
+#if FEATURE_RULES_COMPILED
+
+/********************************************************************************************\
+   Rules processing using the compiled rules
+   pos is the position of the compiled "on ... do" matching the event.
+   Return true when event was handled.
+ \*********************************************************************************************/
+bool rulesProcessingCompiled(const String& fileName,
+                             const String& event,
+                             size_t        pos);
+
+bool compiledConditionMatch(const String& condition,
+                            const String& event);
+#endif // if FEATURE_RULES_COMPILED
+
 
 
 /********************************************************************************************\
@@ -90,6 +117,10 @@ void processMatchedRule(String& action,
                         uint8_t  & ifBlock,
                         uint8_t  & fakeIfBlock);
 
+// Execute a command from the rules, handling the "restrict" prefix.
+// %eventvalue% must already be substituted.
+void executeRulesAction(String& action);
+
 
 /********************************************************************************************\
    Check expression
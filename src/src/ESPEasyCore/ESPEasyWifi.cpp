@@ -7,7 +7,9 @@
 #include "../ESPEasyCore/ESPEasyWifi_ProcessEvent.h"
 #include "../ESPEasyCore/ESPEasy_Log.h"
 #include "../ESPEasyCore/Serial.h"
+#include "../CustomBuild/CompiletimeDefines.h"
 #include "../Globals/ESPEasyWiFiEvent.h"
+#include "../Globals/ESPEasy_time.h"
 #include "../Globals/EventQueue.h"
 #include "../Globals/NetworkState.h"
 #include "../Globals/Nodes.h"
@@ -16,6 +18,8 @@
 #include "../Globals/Services.h"
 #include "../Globals/Settings.h"
 #include "../Globals/WiFi_AP_Candidates.h"
+#include "../Helpers/DeepSleep.h"
+#include "../Helpers/ESPEasyRTC.h"
 #include "../Helpers/ESPEasy_time_calc.h"
 #include "../Helpers/Hardware.h"
 #include "../Helpers/Hardware_defines.h"
@@ -25,6 +29,9 @@
 #include "../Helpers/StringGenerator_WiFi.h"
 #include "../Helpers/StringProvider.h"
 
+#include <lwip/netif.h>
+#include <lwip/dhcp.h>
+
 #ifdef ESP32
 #include <WiFiGeneric.h>
 #include <esp_wifi.h> // Needed to call ESP-IDF functions like esp_wifi_....
@@ -211,6 +218,13 @@ bool ESPEasyWiFi_t::connectSTA() {
    - connection successful
    - Connection stable (connected for > 5 minutes)
 
+   Quick reconnect also uses the last DHCP lease (IP/gateway/subnet/DNS) stored in RTC as static IP config when all apply:
+   - Quick reconnect to the AP stored in RTC applies
+   - No static IP or fixed IP octet configured
+   - The lease has not expired
+   A failed attempt clears the RTC WiFi data, so the next attempt will scan and use DHCP.
+   As a static IP config does not renew the lease, the node will reconnect using DHCP when the lease has expired.
+
  */
 
 
@@ -407,6 +421,13 @@ void AttemptWiFiConnect() {
     return;
   }
 
+  #if FEATURE_DEEP_SLEEP_BATCH
+  if (deepSleepBatch_sampleOnly()) {
+    // WiFi stays off while only collecting samples
+    return;
+  }
+  #endif // if FEATURE_DEEP_SLEEP_BATCH
+
   if (WiFiEventData.wifiConnectInProgress) {
     return;
   }
@@ -1060,6 +1081,26 @@ void WifiScan(bool async, uint8_t channel) {
 
 }
 
+bool WifiScan_request()
+{
+  if (!WifiScan_inProgress()) {
+    const bool resultsExpired =
+      !WiFiEventData.lastScanMoment.isSet() ||
+      (WiFiEventData.lastScanMoment.millisPassedSince() > WIFI_SCAN_RESULTS_MAX_AGE) ||
+      (WiFi_AP_Candidates.scanComplete() <= 0);
+
+    if (resultsExpired) {
+      WiFiEventData.scanRequested = true;
+    }
+  }
+  return WifiScan_inProgress();
+}
+
+bool WifiScan_inProgress()
+{
+  return WiFiEventData.scanRequested || !WiFiEventData.processedScanDone;
+}
+
 // ********************************************************************************
 // Scan all Wifi Access Points
 // ********************************************************************************
@@ -1438,10 +1479,175 @@ void setConnectionSpeed() {
   #endif // ifdef ESP32
 }
 
+// ********************************************************************************
+// Last DHCP lease stored in RTC
+// ********************************************************************************
+static RTC_WiFiLease_t wifiLease;
+static uint8_t         wifiLeasePrefix   = 0;
+static uint32_t        wifiLeaseDuration = 0; // in seconds, lease not yet stored as its expiry time is not yet known
+static uint32_t        wifiLeaseStart    = 0;
+
+bool WiFiUseCachedLease() {
+  return Settings.UseLastWiFiFromRTC() &&
+         !WiFiUseStaticIP() &&
+         ((Settings.IP_Octet == 0) || (Settings.IP_Octet == 255));
+}
+
+static bool wifiLeaseTimeValid(uint32_t unixTime) {
+  return unixTime > get_build_unixtime();
+}
+
+static uint32_t getDHCPleaseTime(const IPAddress& ip) {
+  #if LWIP_DHCP
+
+  for (struct netif *nif = netif_list; nif != nullptr; nif = nif->next) {
+    if (ip4_addr_get_u32(netif_ip4_addr(nif)) == static_cast<uint32_t>(ip)) {
+      const struct dhcp *dhcp = netif_dhcp_data(nif);
+
+      if (dhcp != nullptr) {
+        return dhcp->offered_t0_lease;
+      }
+    }
+  }
+  #endif // if LWIP_DHCP
+  return 0;
+}
+
+static uint8_t getSubnetPrefixLength(const IPAddress& subnet) {
+  uint8_t prefix = 0;
+
+  for (uint8_t i = 0; i < 4; ++i) {
+    for (uint8_t mask = subnet[i]; mask & 0x80; mask <<= 1) {
+      ++prefix;
+    }
+  }
+  return prefix;
+}
+
+static IPAddress getSubnetMask(uint8_t prefix) {
+  const uint32_t mask = (prefix == 0) ? 0 : (0xFFFFFFFFul << (32 - prefix));
+
+  return IPAddress(mask >> 24, (mask >> 16) & 0xFF, (mask >> 8) & 0xFF, mask & 0xFF);
+}
+
+// Convert the lease duration into its expiry time, which needs the system time.
+static bool setWiFiLeaseExpiry() {
+  if (wifiLeaseDuration == 0) { return false; }
+  const uint32_t now = node_time.getUnixTime();
+
+  if (!wifiLeaseTimeValid(now)) { return false; }
+  const uint32_t elapsed = timePassedSince(wifiLeaseStart) / 1000;
+  const uint32_t duration = wifiLeaseDuration;
+
+  wifiLeaseDuration = 0;
+
+  if (elapsed >= duration) { return false; }
+  wifiLease.expiry = now + duration - elapsed;
+  return true;
+}
+
+static void setupCachedLeaseIPconfig() {
+  const bool wasUsingCachedLease = WiFiEventData.usingCachedLease;
+
+  WiFiEventData.usingCachedLease = false;
+
+  if (WiFiUseCachedLease() && RTC.lastWiFi_set()) {
+    const WiFi_AP_Candidate candidate = WiFi_AP_Candidates.getCurrent();
+    const uint32_t now = node_time.getUnixTime();
+
+    if ((candidate.index == RTC.lastWiFiSettingsIndex) &&
+        candidate.bssid_match(RTC.lastBSSID) &&
+        readWiFiLeaseFromRTC(wifiLease, wifiLeasePrefix) &&
+        (wifiLease.expiry != 0) &&
+        (!wifiLeaseTimeValid(now) || (now < wifiLease.expiry)))
+    {
+      const IPAddress ip(wifiLease.ip);
+      const IPAddress gw(wifiLease.gateway);
+      const IPAddress subnet(getSubnetMask(wifiLeasePrefix));
+      const IPAddress dns(wifiLease.dns);
+
+      WiFiEventData.dns0_cache       = dns;
+      WiFiEventData.usingCachedLease = true;
+      wifiLeaseDuration              = 0;
+
+      WiFi.config(ip, gw, subnet, dns);
+
+      if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+        String log = concat(F("IP   : Cached lease: "), formatIP(ip));
+        log += concat(F(" GW: "), formatIP(gw));
+        log += concat(F(" SN: "), formatIP(subnet));
+        log += concat(F(" DNS: "), formatIP(dns));
+        addLogMove(LOG_LEVEL_INFO, log);
+      }
+      return;
+    }
+  }
+  #ifdef ESP8266
+
+  if (wasUsingCachedLease) {
+    // ESP32 already enables DHCP again in prepareWiFi()
+    const IPAddress none;
+    WiFi.config(none, none, none);
+  }
+  #endif // ifdef ESP8266
+}
+
+void WiFi_storeDHCPlease() {
+  if (!WiFiUseCachedLease()) { return; }
+
+  if (!WiFiEventData.usingCachedLease) {
+    const IPAddress ip = WiFi.localIP();
+    uint32_t duration  = getDHCPleaseTime(ip) / 2; // Renewal time (T1)
+
+    if (duration == 0) {
+      duration = WIFI_CACHED_LEASE_DEFAULT_DURATION;
+    }
+
+    wifiLease.ip      = static_cast<uint32_t>(ip);
+    wifiLease.gateway = static_cast<uint32_t>(WiFi.gatewayIP());
+    wifiLease.dns     = static_cast<uint32_t>(WiFiEventData.dns0_cache);
+    wifiLease.expiry  = 0;
+    wifiLeasePrefix   = getSubnetPrefixLength(WiFi.subnetMask());
+    wifiLeaseDuration = (duration > WIFI_CACHED_LEASE_MAX_DURATION) ? WIFI_CACHED_LEASE_MAX_DURATION : duration;
+    wifiLeaseStart    = millis();
+
+    if (!setWiFiLeaseExpiry()) {
+      // Will be stored by WiFi_checkCachedLease() once the system time is known.
+      return;
+    }
+  }
+
+  // Also store the lease when connected using the cached lease, as the RTC WiFi data was cleared when starting the connect attempt.
+  saveWiFiLeaseToRTC(wifiLease, wifiLeasePrefix);
+}
+
+void WiFi_checkCachedLease() {
+  if (!WiFiEventData.WiFiServicesInitialized()) { return; }
+
+  if (setWiFiLeaseExpiry()) {
+    saveWiFiLeaseToRTC(wifiLease, wifiLeasePrefix);
+    return;
+  }
+
+  if (!WiFiEventData.usingCachedLease) { return; }
+  const uint32_t now = node_time.getUnixTime();
+
+  if (!wifiLeaseTimeValid(now) || (now < wifiLease.expiry)) { return; }
+
+  addLog(LOG_LEVEL_INFO, F("IP   : Cached lease expired, reconnect using DHCP"));
+  RTC.lastWiFiLeasePrefix = 0;
+  saveToRTC();
+  WifiDisconnect();
+}
+
 void setupStaticIPconfig() {
   setUseStaticIP(WiFiUseStaticIP());
 
-  if (!WiFiUseStaticIP()) { return; }
+  if (!WiFiUseStaticIP()) {
+    setupCachedLeaseIPconfig();
+    return;
+  }
+  WiFiEventData.usingCachedLease = false;
   const IPAddress ip     (Settings.IP);
   const IPAddress gw     (Settings.Gateway);
   const IPAddress subnet (Settings.Subnet);
@@ -21,6 +21,9 @@
 #define WIFI_ALLOW_AP_AFTERBOOT_PERIOD     5      // in minutes
 #define WIFI_SCAN_INTERVAL_AP_USED         125000 // in milliSeconds
 #define WIFI_SCAN_INTERVAL_MINIMAL          60000 // in milliSeconds
+#define WIFI_SCAN_RESULTS_MAX_AGE           60000 // in milliSeconds, age of scan results before WifiScan_request() starts a new scan
+#define WIFI_CACHED_LEASE_DEFAULT_DURATION   3600 // in seconds, used when the DHCP lease time is unknown
+#define WIFI_CACHED_LEASE_MAX_DURATION      86400 // in seconds
 
 
 #ifdef ESPEASY_WIFI_CLEANUP_WORK_IN_PROGRESS
@@ -123,6 +126,11 @@ WiFiConnectionProtocol getConnectionProtocol();
 void WifiDisconnect();
 bool WiFiScanAllowed();
 void WifiScan(bool async, uint8_t channel = 0);
+
+// Request a scan to be started from the loop, when the last scan results are too old.
+// Return true when a scan is pending or running.
+bool WifiScan_request();
+bool WifiScan_inProgress();
 void WiFiScan_log_to_serial();
 void setSTA(bool enable);
 void setAP(bool enable);
@@ -134,6 +142,12 @@ bool WiFiUseStaticIP();
 bool wifiAPmodeActivelyUsed();
 void setConnectionSpeed();
 void setupStaticIPconfig();
+
+// Last DHCP lease kept in RTC, to reconnect to the AP stored in RTC without waiting for DHCP.
+bool WiFiUseCachedLease();
+void WiFi_storeDHCPlease();
+// Store the lease expiry once the time is known and reconnect using DHCP when the cached lease has expired.
+void WiFi_checkCachedLease();
 String formatScanResult(int i, const String& separator);
 String formatScanResult(int i, const String& separator, int32_t& rssi);
 
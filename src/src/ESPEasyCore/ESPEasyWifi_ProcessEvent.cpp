@@ -2,6 +2,7 @@
 
 #include "../../ESPEasy-Globals.h"
 
+#include "../ESPEasyCore/Controller.h"
 #if FEATURE_ETHERNET
 #include "../ESPEasyCore/ESPEasyEth_ProcessEvent.h"
 #endif
@@ -197,6 +198,12 @@ void handle_unprocessedNetworkEvents()
       }
     }
   }
+
+  if (WiFiEventData.scanRequested && !WiFiEventData.unprocessedWifiEvents()) {
+    // Scan requested via WifiScan_request(), results will be processed in processScanDone()
+    WiFiEventData.scanRequested = false;
+    WifiScan(true);
+  }
 #if FEATURE_ETHERNET
   check_Eth_DNS_valid();
 #endif // if FEATURE_ETHERNET
@@ -212,6 +219,9 @@ void handle_unprocessedNetworkEvents()
 // ********************************************************************************
 void processDisconnect() {
   if (WiFiEventData.processedDisconnect) { return; }
+  #if FEATURE_LABEL_VALUE_CACHE
+  clearLabelValueCache(LabelVolatility::Network);
+  #endif // if FEATURE_LABEL_VALUE_CACHE
 
   if (loglevelActiveFor(LOG_LEVEL_INFO)) {
     String log = F("WIFI : Disconnected! Reason: '");
@@ -290,6 +300,9 @@ void processConnect() {
     return;
   }
   WiFiEventData.processedConnect = true;
+  #if FEATURE_LABEL_VALUE_CACHE
+  clearLabelValueCache(LabelVolatility::Network);
+  #endif // if FEATURE_LABEL_VALUE_CACHE
   if (WiFi.status() == WL_DISCONNECTED) {
     // Apparently not really connected
     return;
@@ -357,7 +370,7 @@ void processConnect() {
     }
   } 
 
-  if (useStaticIP()) {
+  if (useStaticIP() || WiFiEventData.usingCachedLease) {
     WiFiEventData.markGotIP(); // in static IP config the got IP event is never fired.
   }
   saveToRTC();
@@ -372,6 +385,9 @@ void processGotIP() {
   if (checkAndResetWiFi()) {
     return;
   }
+  #if FEATURE_LABEL_VALUE_CACHE
+  clearLabelValueCache(LabelVolatility::Network);
+  #endif // if FEATURE_LABEL_VALUE_CACHE
 
   IPAddress ip = NetworkLocalIP();
 
@@ -408,6 +424,10 @@ void processGotIP() {
     addLogMove(LOG_LEVEL_INFO, log);
   }
 
+  if (!useStaticIP()) {
+    WiFi_storeDHCPlease();
+  }
+
   // Might not work in core 2.5.0
   // See https://github.com/esp8266/Arduino/issues/5839
   if ((Settings.IP_Octet != 0) && (Settings.IP_Octet != 255))
@@ -422,7 +442,8 @@ void processGotIP() {
 
 #if FEATURE_MQTT
   mqtt_reconnect_count        = 0;
-  MQTTclient_should_reconnect = true;
+  // Keep a TLS connection which survived the network interruption, to save a new handshake.
+  MQTTclient_should_reconnect = !MQTTclient_keepConnectionOnReconnect();
   timermqtt_interval          = 100;
   Scheduler.setIntervalTimer(SchedulerIntervalTimer_e::TIMER_MQTT);
   scheduleNextMQTTdelayQueue();
@@ -456,6 +477,9 @@ void processGotIP() {
 void processDisconnectAPmode() {
   if (WiFiEventData.processedDisconnectAPmode) { return; }
   WiFiEventData.processedDisconnectAPmode = true;
+  #if FEATURE_LABEL_VALUE_CACHE
+  clearLabelValueCache(LabelVolatility::Network);
+  #endif // if FEATURE_LABEL_VALUE_CACHE
 
 #ifndef BUILD_NO_DEBUG
   if (loglevelActiveFor(LOG_LEVEL_INFO)) {
@@ -473,6 +497,9 @@ void processDisconnectAPmode() {
 void processConnectAPmode() {
   if (WiFiEventData.processedConnectAPmode) { return; }
   WiFiEventData.processedConnectAPmode = true;
+  #if FEATURE_LABEL_VALUE_CACHE
+  clearLabelValueCache(LabelVolatility::Network);
+  #endif // if FEATURE_LABEL_VALUE_CACHE
   // Extend timer to switch off AP.
   WiFiEventData.timerAPoff.setMillisFromNow(WIFI_AP_OFF_TIMER_DURATION);
 #ifndef BUILD_NO_DEBUG
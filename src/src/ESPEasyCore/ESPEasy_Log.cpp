@@ -7,6 +7,8 @@
 #include "../Globals/ESPEasyWiFiEvent.h"
 #include "../Globals/Logging.h"
 #include "../Globals/Settings.h"
+#include "../Helpers/ControllerQueueTask.h"
+#include "../Helpers/HeapTracker.h"
 #include "../Helpers/Networking.h"
 
 #include <FS.h>
@@ -14,6 +16,7 @@
 #if FEATURE_SD
 #include <SD.h>
 #include "../Helpers/ESPEasy_Storage.h"
+#include "../Helpers/SD_LogBuffer.h"
 #endif
 
 /********************************************************************************************\
@@ -277,6 +280,9 @@ void addToSDLog(uint8_t logLevel, const String& string)
 {
 #if FEATURE_SD
   if (loglevelActiveFor(LOG_TO_SDCARD, logLevel)) {
+    #if FEATURE_SD_LOG_BUFFER
+    SD_LogBuffer_add(string);
+    #else
     String   logName = patch_fname(F("log.txt"));
     fs::File logFile = SD.open(logName, "a+");
     if (logFile) {
@@ -287,6 +293,7 @@ void addToSDLog(uint8_t logLevel, const String& string)
       logFile.println();
     }
     logFile.close();
+    #endif // if FEATURE_SD_LOG_BUFFER
   }
 #endif
 }
@@ -294,6 +301,13 @@ void addToSDLog(uint8_t logLevel, const String& string)
 
 void addLog(uint8_t logLevel, const String& string)
 {
+  HEAP_TRACK_SCOPE(Log);
+#if FEATURE_CONTROLLER_QUEUE_TASK
+  if (controllerQueueTask_isWorker()) {
+    controllerQueueTask_deferLog(logLevel, String(string));
+    return;
+  }
+#endif
   addToSerialLog(logLevel, string);
   addToSysLog(logLevel, string);
   addToSDLog(logLevel, string);
@@ -304,6 +318,14 @@ void addLog(uint8_t logLevel, const String& string)
 
 void addToLogMove(uint8_t logLevel, String&& string)
 {
+  HEAP_TRACK_SCOPE(Log);
+#if FEATURE_CONTROLLER_QUEUE_TASK
+  if (controllerQueueTask_isWorker()) {
+    // Logging is not thread safe, so let the main loop handle it.
+    controllerQueueTask_deferLog(logLevel, std::move(string));
+    return;
+  }
+#endif
   addToSerialLog(logLevel, string);
   addToSysLog(logLevel, string);
   addToSDLog(logLevel, string);
@@ -315,3 +337,25 @@ void addToLogMove(uint8_t logLevel, String&& string)
   // Make sure the string may no longer keep up memory
   string = String();
 }
+
+void addLogFmt_args(uint8_t logLevel, const __FlashStringHelper *format, const LogArg_t *args, size_t nrArgs)
+{
+#if FEATURE_LOG_DEFERRED_FORMAT
+  // Other log destinations need the text right away.
+  const bool formatNow =
+  #if FEATURE_CONTROLLER_QUEUE_TASK
+    controllerQueueTask_isWorker() ||
+  #endif
+    loglevelActiveFor(LOG_TO_SERIAL, logLevel) ||
+    loglevelActiveFor(LOG_TO_SYSLOG, logLevel) ||
+    loglevelActiveFor(LOG_TO_SDCARD, logLevel);
+
+  if (!formatNow) {
+    if (loglevelActiveFor(LOG_TO_WEBLOG, logLevel)) {
+      Logging.addDeferred(logLevel, format, args, nrArgs);
+    }
+    return;
+  }
+#endif // if FEATURE_LOG_DEFERRED_FORMAT
+  addToLogMove(logLevel, LogArg_format(format, args, nrArgs));
+}
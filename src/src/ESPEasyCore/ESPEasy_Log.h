@@ -4,6 +4,8 @@
 
 #include "../../ESPEasy_common.h"
 
+#include "../DataStructs/LogArg.h"
+
 #define LOG_LEVEL_NONE                      0
 #define LOG_LEVEL_ERROR                     1
 #define LOG_LEVEL_INFO                      2
@@ -56,5 +58,23 @@ void addLog(uint8_t logLevel, String&& string);
 void addLog(uint8_t logLevel, const String& string);
 void addToLogMove(uint8_t logLevel, String&& string);
 
+// Log a format string with typed arguments, see LogArg_format() for the supported conversions.
+// When the line is only sent to the web log, it is stored in binary form and
+// only formatted when the web log is read (FEATURE_LOG_DEFERRED_FORMAT).
+// Use instead of building a log String, e.g.:
+//   addLogFmt(LOG_LEVEL_INFO, F("EVENT: %s"), event);
+void addLogFmt_args(uint8_t                    logLevel,
+                    const __FlashStringHelper *format,
+                    const LogArg_t            *args,
+                    size_t                     nrArgs);
+
+template<typename ... Args>
+void addLogFmt(uint8_t logLevel, const __FlashStringHelper *format, const Args&... args) {
+  if (loglevelActiveFor(logLevel)) {
+    const LogArg_t logArgs[] = { LogArg_t(args)... };
+    addLogFmt_args(logLevel, format, logArgs, sizeof...(Args));
+  }
+}
+
 
 #endif 
\ No newline at end of file
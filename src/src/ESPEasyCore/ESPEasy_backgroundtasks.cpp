@@ -6,12 +6,17 @@
 #include "../DataStructs/TimingStats.h"
 #include "../ESPEasyCore/ESPEasyNetwork.h"
 #include "../ESPEasyCore/Serial.h"
+#include "../Globals/ESPEasy_time.h"
 #include "../Globals/NetworkState.h"
 #include "../Globals/Services.h"
 #include "../Globals/Settings.h"
 #include "../Helpers/ESPEasy_time_calc.h"
+#include "../Helpers/HeapTracker.h"
 #include "../Helpers/Network.h"
 #include "../Helpers/Networking.h"
+#ifdef USE_RTOS_MULTITASKING
+# include "../Helpers/RTOS_Multitasking.h"
+#endif // ifdef USE_RTOS_MULTITASKING
 
 
 #if FEATURE_ARDUINO_OTA
@@ -72,10 +77,18 @@ void backgroundtasks()
 
   process_serialWriteBuffer();
 
-  if (!UseRTOSMultitasking) {
-    serial();
+  serial();
 
+  #ifdef USE_RTOS_MULTITASKING
+
+  if (UseRTOSMultitasking) {
+    // Safe point for the server task to handle the web server and p2p UDP port.
+    RTOS_mainLoop_yield();
+  } else
+  #endif // ifdef USE_RTOS_MULTITASKING
+  {
     if (webserverRunning) {
+      HEAP_TRACK_SCOPE(WebServer);
       web_server.handleClient();
     }
     #if FEATURE_ESPEASY_P2P
@@ -83,6 +96,8 @@ void backgroundtasks()
     #endif
   }
 
+  node_time.ntpQuery_loop();
+
   #if FEATURE_DNS_SERVER
 
   // process DNS, only used if the ESP has no valid WiFi config
@@ -20,18 +20,32 @@
 #include "../Helpers/Misc.h"
 #include "../Helpers/Networking.h"
 #include "../Helpers/PeriodicalActions.h"
+#include "../Helpers/SlowLoopDetector.h"
 #include "../Helpers/StringConverter.h"
+#include "../Helpers/SystemVariables.h"
+#include "../Helpers/_Plugin_Helper_data_ready.h"
+#include "../Helpers/_Plugin_Helper_serial.h"
 
 void updateLoopStats() {
   ++loopCounter;
   ++loopCounter_full;
 
+  // Values like %sysname% may have changed since the last loop.
+  SystemVariables::clearCachedValues();
+
   if (lastLoopStart == 0) {
     lastLoopStart = getMicros64();
+    #if FEATURE_SLOW_LOOP_DETECTOR
+    SlowLoop_loopDone(0);
+    #endif // if FEATURE_SLOW_LOOP_DETECTOR
     return;
   }
   const int64_t usecSince = usecPassedSince(lastLoopStart);
 
+  #if FEATURE_SLOW_LOOP_DETECTOR
+  SlowLoop_loopDone(usecSince);
+  #endif // if FEATURE_SLOW_LOOP_DETECTOR
+
   #if FEATURE_TIMING_STATS
   ADD_TIMER_STAT(LOOP_STATS, usecSince);
   #endif // if FEATURE_TIMING_STATS
@@ -153,12 +167,17 @@ void ESPEasy_loop()
   // normal mode, run each task when its time
   else
   {
-    if (!UseRTOSMultitasking) {
-      // On ESP32 the schedule is executed on the 2nd core.
-      Scheduler.handle_schedule();
-    }
+    Scheduler.handle_schedule();
   }
 
+  #if FEATURE_SERIAL_RX_EVENT
+  serialHelper_processRxEvents();
+  #endif // if FEATURE_SERIAL_RX_EVENT
+
+  #if FEATURE_PLUGIN_DATA_READY_PIN
+  dataReadyPin_processEvents();
+  #endif // if FEATURE_PLUGIN_DATA_READY_PIN
+
   backgroundtasks();
 
   if (readyForSleep()) {
@@ -5,6 +5,7 @@
 #include "../../ESPEasy-Globals.h"
 #include "../../_Plugin_Helper.h"
 #include "../CustomBuild/CompiletimeDefines.h"
+#include "../DataStructs/TimingStats.h"
 #include "../ESPEasyCore/ESPEasyGPIO.h"
 #include "../ESPEasyCore/ESPEasyNetwork.h"
 #include "../ESPEasyCore/ESPEasyRules.h"
@@ -22,21 +23,25 @@
 #include "../Helpers/_CPlugin_init.h"
 #include "../Helpers/_NPlugin_init.h"
 #include "../Helpers/_Plugin_init.h"
+#include "../Helpers/BootProfiler.h"
+#include "../Helpers/ControllerQueueTask.h"
 #include "../Helpers/DeepSleep.h"
 #include "../Helpers/ESPEasyRTC.h"
 #include "../Helpers/ESPEasy_FactoryDefault.h"
 #include "../Helpers/ESPEasy_Storage.h"
 #include "../Helpers/ESPEasy_checks.h"
+#include "../Helpers/EventTracer.h"
 #include "../Helpers/Hardware.h"
+#include "../Helpers/HeapTracker.h"
 #include "../Helpers/Memory.h"
 #include "../Helpers/Misc.h"
+#include "../Helpers/PluginCallStats.h"
 #include "../Helpers/StringGenerator_System.h"
 #include "../WebServer/ESPEasy_WebServer.h"
 
 
 #ifdef USE_RTOS_MULTITASKING
-# include "../Helpers/Networking.h"
-# include "../Helpers/PeriodicalActions.h"
+# include "../Helpers/RTOS_Multitasking.h"
 #endif // ifdef USE_RTOS_MULTITASKING
 
 #if FEATURE_ARDUINO_OTA
@@ -48,61 +53,115 @@
 #include <soc/gpio_reg.h>
 #include <soc/efuse_reg.h>
 
-#include <esp_pm.h>
-
-#if CONFIG_IDF_TARGET_ESP32
-# include "hal/efuse_ll.h"
-# include "hal/efuse_hal.h"
 #endif
 
-#endif
 
+/*********************************************************************************************\
+* ISR call back function for handling the watchdog.
+\*********************************************************************************************/
+void sw_watchdog_callback(void *arg)
+{
+  yield(); // feed the WD
+  ++sw_watchdog_callback_count;
+}
+
+/*********************************************************************************************\
+* Subsystems started after the first sample when "Fast First Sample" is enabled
+\*********************************************************************************************/
+static bool          setup_deferredPending = false;
+static bool          setup_firstSampleSent = false;
+static unsigned long setup_doneMoment      = 0;
 
-#ifdef USE_RTOS_MULTITASKING
-void RTOS_TaskServers(void *parameter)
+static void processWakeEvents()
 {
-  while (true) {
-    delay(100);
-    web_server.handleClient();
-    #if FEATURE_ESPEASY_P2P
-    checkUDP();
-    #endif
+  if (Settings.UseRules && isDeepSleepEnabled())
+  {
+    String event = F("System#NoSleep=");
+    event += Settings.deepSleep_wakeTime;
+    rulesProcessing(event); // TD-er: Process events in the setup() now.
+  }
+
+  if (Settings.UseRules)
+  {
+    String event = F("System#Wake");
+    rulesProcessing(event); // TD-er: Process events in the setup() now.
   }
+  #ifdef ESP32
+  if (Settings.UseRules)
+  {
+    const uint32_t gpio_strap =   GPIO_REG_READ(GPIO_STRAP_REG);
+//    BOOT_MODE_GET();
+
+    // Event values: 
+    // ESP32   :  GPIO-5, GPIO-15, GPIO-4, GPIO-2, GPIO-0, GPIO-12
+    // ESP32-C3:  bit 0: GPIO2, bit 2: GPIO8, bit 3: GPIO9
+    // ESP32-S2: Unclear what bits represent which strapping state.
+    // ESP32-S3: bit5 ~ bit2 correspond to strapping pins GPIO3, GPIO45, GPIO0, and GPIO46 respectively.
+    String event = F("System#BootMode=");
+    event += bitRead(gpio_strap, 0); 
+    event += ',';
+    event += bitRead(gpio_strap, 1); 
+    event += ',';
+    event += bitRead(gpio_strap, 2); 
+    event += ',';
+    event += bitRead(gpio_strap, 3); 
+    event += ',';
+    event += bitRead(gpio_strap, 4); 
+    event += ',';
+    event += bitRead(gpio_strap, 5); 
+    rulesProcessing(event);
+  }
+  #endif
 }
 
-void RTOS_TaskSerial(void *parameter)
+static void processBootEvent()
 {
-  while (true) {
-    delay(100);
-    serial();
+  if (Settings.UseRules)
+  {
+    String event = F("System#Boot");
+    rulesProcessing(event); // TD-er: Process events in the setup() now.
+    #ifndef BUILD_NO_RAM_TRACKER
+    logMemUsageAfter(F("rulesProcessing(System#Boot)"));
+    #endif
   }
 }
 
-void RTOS_Task10ps(void *parameter)
+bool ESPEasy_setup_deferredPending()
 {
-  while (true) {
-    delay(100);
-    run10TimesPerSecond();
-  }
+  return setup_deferredPending;
 }
 
-void RTOS_HandleSchedule(void *parameter)
+void ESPEasy_setup_firstSampleSent()
 {
-  while (true) {
-    Scheduler.handle_schedule();
-  }
+  if (setup_firstSampleSent) { return; }
+  setup_firstSampleSent = true;
+  #if FEATURE_BOOT_PROFILER
+  BootProfiler_firstSample();
+  #endif // if FEATURE_BOOT_PROFILER
 }
 
-#endif // ifdef USE_RTOS_MULTITASKING
+void ESPEasy_setup_deferred_loop()
+{
+  if (!setup_deferredPending) { return; }
 
+  if (!setup_firstSampleSent &&
+      (timePassedSince(setup_doneMoment) < ESPEASY_SETUP_DEFERRED_TIMEOUT)) {
+    return;
+  }
+  setup_deferredPending = false;
+  addLog(LOG_LEVEL_INFO, F("INIT : Start deferred subsystems"));
+  #if FEATURE_BOOT_PROFILER
+  BootProfiler_phaseStart();
+  #endif // if FEATURE_BOOT_PROFILER
 
-/*********************************************************************************************\
-* ISR call back function for handling the watchdog.
-\*********************************************************************************************/
-void sw_watchdog_callback(void *arg)
-{
-  yield(); // feed the WD
-  ++sw_watchdog_callback_count;
+  #if FEATURE_NOTIFIER
+  NPluginInit();
+  #endif // if FEATURE_NOTIFIER
+  processWakeEvents();
+  setWebserverRunning(true);
+  processBootEvent();
+  writeDefaultCSS();
+  BOOT_PHASE_DONE(DeferredInit)
 }
 
 /*********************************************************************************************\
@@ -119,6 +178,15 @@ void ESPEasy_setup()
 #ifdef USE_SECOND_HEAP
   HeapSelectDram ephemeral;
 #endif
+#if FEATURE_BOOT_PROFILER
+  BootProfiler_begin();
+#endif // if FEATURE_BOOT_PROFILER
+#if FEATURE_HEAP_TRACKER
+  HeapTracker_init();
+#endif // if FEATURE_HEAP_TRACKER
+#if FEATURE_EVENT_TRACER
+  EventTracer_init();
+#endif // if FEATURE_EVENT_TRACER
 #ifdef ESP32
 #ifdef DISABLE_ESP32_BROWNOUT
   DisableBrownout();      // Workaround possible weak LDO resulting in brownout detection during Wifi connection
@@ -174,6 +242,7 @@ void ESPEasy_setup()
   initAnalogWrite();
 
   resetPluginTaskData();
+  BOOT_PHASE_DONE(EarlyInit)
 
   #ifndef BUILD_NO_RAM_TRACKER
   checkRAM(F("setup"));
@@ -183,6 +252,7 @@ void ESPEasy_setup()
   // serialPrint("\n\n\nBOOOTTT\n\n\n");
 
   initLog();
+  BOOT_PHASE_DONE(Log)
   #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("initLog()"));
   #endif
@@ -245,6 +315,16 @@ void ESPEasy_setup()
       log += F(" Last systime: ");
       log += RTC.lastSysTime;
       #endif // ifndef BUILD_NO_DEBUG
+      #if FEATURE_PLUGIN_CALL_STATS
+      PluginCallStats_loadFromRTC();
+
+      if (PluginCallStats_getBeforeReboot().active) {
+        log += F(" Active plugin call: Task ");
+        log += PluginCallStats_getBeforeReboot().taskIndex + 1;
+        log += ' ';
+        log += getPluginFunctionName(PluginCallStats_getBeforeReboot().function);
+      }
+      #endif // if FEATURE_PLUGIN_CALL_STATS
     }
 
     // cold boot (RTC memory empty)
@@ -262,16 +342,19 @@ void ESPEasy_setup()
     log += F(" - Restart Reason: ");
     log += getResetReasonString();
 
-    RTC.deepSleepState = 0;
+    // Keep the deep sleep batch mode state
+    RTC.deepSleepState &= ~RTC_DEEPSLEEP_STATE_SLEEPING;
     saveToRTC();
 
     addLogMove(LOG_LEVEL_INFO, log);
   }
+  BOOT_PHASE_DONE(RTC)
   #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("RTC init"));
   #endif
 
   fileSystemCheck();
+  BOOT_PHASE_DONE(FileSystem)
   #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("fileSystemCheck()"));
   #endif
@@ -279,67 +362,25 @@ void ESPEasy_setup()
   //  progMemMD5check();
   LoadSettings();
   ESPEasy_Console.reInit();
+  BOOT_PHASE_DONE(LoadSettings)
 
   #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("LoadSettings()"));
   #endif
 
-#ifdef ESP32
-  if (Settings.EcoPowerMode()) {
-    // Configure dynamic frequency scaling:
-    // maximum and minimum frequencies are set in sdkconfig,
-    // automatic light sleep is enabled if tickless idle support is enabled.
-#if CONFIG_IDF_TARGET_ESP32
-    esp_pm_config_esp32_t pm_config = {
-            .max_freq_mhz = static_cast<int>(efuse_hal_get_rated_freq_mhz()),
-#elif CONFIG_IDF_TARGET_ESP32S2
-    esp_pm_config_esp32s2_t pm_config = {
-            .max_freq_mhz = 240,
-#elif CONFIG_IDF_TARGET_ESP32C3
-    esp_pm_config_esp32c3_t pm_config = {
-            .max_freq_mhz = 160,
-#elif CONFIG_IDF_TARGET_ESP32S3
-    esp_pm_config_esp32s3_t pm_config = {
-            .max_freq_mhz = 240,
-#elif CONFIG_IDF_TARGET_ESP32C2
-    esp_pm_config_esp32c2_t pm_config = {
-            .max_freq_mhz = 120,
-#endif
-            .min_freq_mhz = 80,
-#if CONFIG_FREERTOS_USE_TICKLESS_IDLE
-            .light_sleep_enable = true
-#endif
-    };
-    esp_pm_configure(&pm_config);
-#if CONFIG_IDF_TARGET_ESP32
-  } else {
-    // Set the max/min frequency based on what's being reported by the efuses.
-    // Only ESP32 seems to have this function.
-    esp_pm_config_esp32_t pm_config = {
-            .max_freq_mhz = static_cast<int>(efuse_hal_get_rated_freq_mhz()),
-            .min_freq_mhz = static_cast<int>(efuse_hal_get_rated_freq_mhz()),
-#if CONFIG_FREERTOS_USE_TICKLESS_IDLE
-            .light_sleep_enable = false
-#endif
-    };
-    esp_pm_configure(&pm_config);
-#endif
-  }
-#endif
-
+  // CPU frequency and power management are configured in afterloadSettings()
 
   #ifndef BUILD_NO_RAM_TRACKER
   checkRAM(F("hardwareInit"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
   hardwareInit();
+  BOOT_PHASE_DONE(HardwareInit)
   #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("hardwareInit()"));
   #endif
 
   node_time.restoreFromRTC();
 
-  Settings.UseRTOSMultitasking = false; // For now, disable it, we experience heap corruption.
-
   if ((RTC.bootFailedCount > 10) && (RTC.bootCounter > 10)) {
     uint8_t toDisable = RTC.bootFailedCount - 10;
     toDisable = disablePlugin(toDisable);
@@ -387,6 +428,15 @@ void ESPEasy_setup()
   bool initWiFi = active_network_medium == NetworkMedium_t::WIFI;
   // FIXME TD-er: Must add another check for 'delayed start WiFi' for poorly designed ESP8266 nodes.
 
+  #if FEATURE_DEEP_SLEEP_BATCH
+  deepSleepBatch_initCycle();
+
+  if (deepSleepBatch_sampleOnly()) {
+    // Only collecting samples in this wake cycle, keep WiFi off.
+    initWiFi = false;
+  }
+  #endif // if FEATURE_DEEP_SLEEP_BATCH
+
 
   if (initWiFi) {
     WiFi_AP_Candidates.clearCache();
@@ -416,6 +466,7 @@ void ESPEasy_setup()
     }
 //    setWifiMode(WIFI_OFF);
   }
+  BOOT_PHASE_DONE(WiFiScan)
   #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("WifiScan()"));
   #endif
@@ -423,6 +474,7 @@ void ESPEasy_setup()
 
   //  setWifiMode(WIFI_STA);
   checkRuleSets();
+  BOOT_PHASE_DONE(RuleSets)
   #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("checkRuleSets()"));
   #endif
@@ -443,6 +495,7 @@ void ESPEasy_setup()
   }
 
   initSerial();
+  BOOT_PHASE_DONE(Serial)
   #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("initSerial()"));
   #endif
@@ -461,20 +514,33 @@ void ESPEasy_setup()
 
   timermqtt_interval      = 250; // Interval for checking MQTT
   timerAwakeFromDeepSleep = millis();
+  #if FEATURE_CONTROLLER_QUEUE_TASK
+  // Must be started before the controllers are initialized, so the delay handlers keep a copy of their settings.
+  controllerQueueTask_start();
+  #endif // if FEATURE_CONTROLLER_QUEUE_TASK
   CPluginInit();
+  BOOT_PHASE_DONE(Controllers)
   #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("CPluginInit()"));
   #endif
+
+  // Postpone the subsystems not needed to take and send the first sample.
+  setup_deferredPending = Settings.FastFirstSample();
+
   #if FEATURE_NOTIFIER
-  NPluginInit();
-  #ifndef BUILD_NO_RAM_TRACKER
-  logMemUsageAfter(F("NPluginInit()"));
-  #endif
+  if (!setup_deferredPending) {
+    NPluginInit();
+    BOOT_PHASE_DONE(Notifications)
+    #ifndef BUILD_NO_RAM_TRACKER
+    logMemUsageAfter(F("NPluginInit()"));
+    #endif
+  }
   #endif // if FEATURE_NOTIFIER
 
   PluginInit();
 
   initSerial(); // Plugins may have altered serial, so re-init serial
+  BOOT_PHASE_DONE(Plugins)
   
   #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("PluginInit()"));
@@ -502,44 +568,10 @@ void ESPEasy_setup()
   logMemUsageAfter(F("clearAllCaches()"));
   #endif
 
-  if (Settings.UseRules && isDeepSleepEnabled())
-  {
-    String event = F("System#NoSleep=");
-    event += Settings.deepSleep_wakeTime;
-    rulesProcessing(event); // TD-er: Process events in the setup() now.
-  }
-
-  if (Settings.UseRules)
-  {
-    String event = F("System#Wake");
-    rulesProcessing(event); // TD-er: Process events in the setup() now.
-  }
-  #ifdef ESP32
-  if (Settings.UseRules)
-  {
-    const uint32_t gpio_strap =   GPIO_REG_READ(GPIO_STRAP_REG);
-//    BOOT_MODE_GET();
-
-    // Event values: 
-    // ESP32   :  GPIO-5, GPIO-15, GPIO-4, GPIO-2, GPIO-0, GPIO-12
-    // ESP32-C3:  bit 0: GPIO2, bit 2: GPIO8, bit 3: GPIO9
-    // ESP32-S2: Unclear what bits represent which strapping state.
-    // ESP32-S3: bit5 ~ bit2 correspond to strapping pins GPIO3, GPIO45, GPIO0, and GPIO46 respectively.
-    String event = F("System#BootMode=");
-    event += bitRead(gpio_strap, 0); 
-    event += ',';
-    event += bitRead(gpio_strap, 1); 
-    event += ',';
-    event += bitRead(gpio_strap, 2); 
-    event += ',';
-    event += bitRead(gpio_strap, 3); 
-    event += ',';
-    event += bitRead(gpio_strap, 4); 
-    event += ',';
-    event += bitRead(gpio_strap, 5); 
-    rulesProcessing(event);
+  if (!setup_deferredPending) {
+    processWakeEvents();
+    BOOT_PHASE_DONE(WakeEvents)
   }
-  #endif
 
   #if FEATURE_ETHERNET
   if (Settings.ETH_Pin_power != -1) {
@@ -548,15 +580,24 @@ void ESPEasy_setup()
 
   #endif
 
-  NetworkConnectRelaxed();
+  #if FEATURE_DEEP_SLEEP_BATCH
+  if (!deepSleepBatch_sampleOnly())
+  #endif // if FEATURE_DEEP_SLEEP_BATCH
+  {
+    NetworkConnectRelaxed();
+  }
+  BOOT_PHASE_DONE(NetworkConnect)
   #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("NetworkConnectRelaxed()"));
   #endif
 
-  setWebserverRunning(true);
-  #ifndef BUILD_NO_RAM_TRACKER
-  logMemUsageAfter(F("setWebserverRunning()"));
-  #endif
+  if (!setup_deferredPending) {
+    setWebserverRunning(true);
+    BOOT_PHASE_DONE(WebServer)
+    #ifndef BUILD_NO_RAM_TRACKER
+    logMemUsageAfter(F("setWebserverRunning()"));
+    #endif
+  }
 
 
   #if FEATURE_REPORTING
@@ -565,6 +606,7 @@ void ESPEasy_setup()
 
   #if FEATURE_ARDUINO_OTA
   ArduinoOTAInit();
+  BOOT_PHASE_DONE(ArduinoOTA)
   #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("ArduinoOTAInit()"));
   #endif
@@ -577,40 +619,25 @@ void ESPEasy_setup()
     #endif
   }
 
-  if (Settings.UseRules)
-  {
-    String event = F("System#Boot");
-    rulesProcessing(event); // TD-er: Process events in the setup() now.
+  if (!setup_deferredPending) {
+    processBootEvent();
+    BOOT_PHASE_DONE(BootEvent)
+
+    writeDefaultCSS();
+    BOOT_PHASE_DONE(WriteCSS)
     #ifndef BUILD_NO_RAM_TRACKER
-    logMemUsageAfter(F("rulesProcessing(System#Boot)"));
+    logMemUsageAfter(F("writeDefaultCSS()"));
     #endif
   }
 
-  writeDefaultCSS();
-  #ifndef BUILD_NO_RAM_TRACKER
-  logMemUsageAfter(F("writeDefaultCSS()"));
-  #endif
-
 
   UseRTOSMultitasking = Settings.UseRTOSMultitasking;
   #ifdef USE_RTOS_MULTITASKING
 
-  if (UseRTOSMultitasking) {
-    if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-      addLog(LOG_LEVEL_INFO, F("RTOS : Launching tasks"));
-    }
-    xTaskCreatePinnedToCore(RTOS_TaskServers, "RTOS_TaskServers", 16384, nullptr, 1, nullptr, 1);
-    xTaskCreatePinnedToCore(RTOS_TaskSerial,  "RTOS_TaskSerial",  8192,  nullptr, 1, nullptr, 1);
-    xTaskCreatePinnedToCore(RTOS_Task10ps,    "RTOS_Task10ps",    8192,  nullptr, 1, nullptr, 1);
-    xTaskCreatePinnedToCore(
-      RTOS_HandleSchedule,   /* Function to implement the task */
-      "RTOS_HandleSchedule", /* Name of the task */
-      16384,                 /* Stack size in words */
-      nullptr,                  /* Task input parameter */
-      1,                     /* Priority of the task */
-      nullptr,                  /* Task handle. */
-      1);                    /* Core where the task should run */
-  }
+  // Web server and p2p UDP port in a separate task, the scheduler keeps running in the main loop.
+  RTOS_serverTask_start();
+  #else // ifdef USE_RTOS_MULTITASKING
+  UseRTOSMultitasking = false;
   #endif // ifdef USE_RTOS_MULTITASKING
 
   // Start the interval timers at N msec from now.
@@ -625,5 +652,10 @@ void ESPEasy_setup()
   #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("Scheduler.setIntervalTimerOverride"));
   #endif
+  BOOT_PHASE_DONE(Scheduler)
 
+  setup_doneMoment = millis();
+  #if FEATURE_BOOT_PROFILER
+  BootProfiler_end();
+  #endif // if FEATURE_BOOT_PROFILER
 }
@@ -8,4 +8,18 @@
 \*********************************************************************************************/
 void ESPEasy_setup();
 
+// Max. time in msec after setup to wait for the first sample before starting the deferred subsystems.
+#ifndef ESPEASY_SETUP_DEFERRED_TIMEOUT
+# define ESPEASY_SETUP_DEFERRED_TIMEOUT  10000
+#endif // ifndef ESPEASY_SETUP_DEFERRED_TIMEOUT
+
+// Web server, notifications and boot rules events are not yet started, see Settings.FastFirstSample()
+bool ESPEasy_setup_deferredPending();
+
+// A task has read and sent its values.
+void ESPEasy_setup_firstSampleSent();
+
+// Start the deferred subsystems after the first sample, or on timeout.
+void ESPEasy_setup_deferred_loop();
+
 #endif
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include "../ESPEasyCore/ESPEasy_Log.h"
 #include "../Globals/Settings.h"
 #include "../Helpers/_CPlugin_init.h"
+#include "../Helpers/BootProfiler.h"
 
 
 /********************************************************************************************\
@@ -65,12 +66,23 @@ bool CPluginCall(CPlugin::Function Function, struct EventStruct *event, String&
           if (Function == CPlugin::Function::CPLUGIN_WRITE) {
             command = str;
           }
+          #if FEATURE_BOOT_PROFILER
+          const uint64_t callStart_usec = getMicros64();
+          #endif // if FEATURE_BOOT_PROFILER
 
-          if (CPluginCall(
-                getProtocolIndex_from_ControllerIndex(x),
-                Function,
-                event,
-                command)) {
+          const bool handled = CPluginCall(
+            getProtocolIndex_from_ControllerIndex(x),
+            Function,
+            event,
+            command);
+
+          #if FEATURE_BOOT_PROFILER
+          if (Function == CPlugin::Function::CPLUGIN_INIT) {
+            BootProfiler_controllerInit(x, usecPassedSince(callStart_usec));
+          }
+          #endif // if FEATURE_BOOT_PROFILER
+
+          if (handled) {
             if (Function == CPlugin::Function::CPLUGIN_WRITE) {
               // Need to stop when write call was handled
               return true;
@@ -12,6 +12,11 @@ void clearAllButTaskCaches()
   Cache.clearAllButTaskCaches();
 }
 
+void clearAllButTaskCaches(const String& changedFile)
+{
+  Cache.clearAllButTaskCaches(changedFile);
+}
+
 void clearTaskCache(taskIndex_t TaskIndex)
 {
   Cache.clearTaskCache(TaskIndex);
@@ -7,6 +7,8 @@ void clearAllCaches();
 
 void clearAllButTaskCaches();
 
+void clearAllButTaskCaches(const String& changedFile);
+
 void clearTaskCache(taskIndex_t TaskIndex);
 
 void clearFileCaches();
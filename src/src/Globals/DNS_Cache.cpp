@@ -0,0 +1,7 @@
+#include "../Globals/DNS_Cache.h"
+
+#if FEATURE_DNS_CACHE
+
+DNS_Cache DNScache;
+
+#endif // if FEATURE_DNS_CACHE
@@ -0,0 +1,14 @@
+#ifndef GLOBALS_DNS_CACHE_H
+#define GLOBALS_DNS_CACHE_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_DNS_CACHE
+
+# include "../DataStructs/DNS_Cache.h"
+
+extern DNS_Cache DNScache;
+
+#endif // if FEATURE_DNS_CACHE
+
+#endif // ifndef GLOBALS_DNS_CACHE_H
@@ -13,10 +13,19 @@ bool MQTTclient_must_send_LWT_connected = false;
 bool MQTTclient_connected               = false;
 int  mqtt_reconnect_count               = 0;
 LongTermTimer MQTTclient_next_connect_attempt;
+
+# if FEATURE_MQTT_TLS
+WiFiClientSecure mqtt_tls;
+String    mqtt_tls_rootCA;
+bool      MQTTclient_usesTLS = false;
+IPAddress MQTTclient_tls_localIP;
+# endif // if FEATURE_MQTT_TLS
 #endif // if FEATURE_MQTT
 
 #ifdef USES_P037
 
 // mqtt import status
 bool P037_MQTTImport_connected = false;
+
+MQTT_TopicTrie P037_MQTTImport_topics;
 #endif // ifdef USES_P037
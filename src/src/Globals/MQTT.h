@@ -19,12 +19,29 @@ extern bool MQTTclient_must_send_LWT_connected;
 extern bool MQTTclient_connected;
 extern int  mqtt_reconnect_count;
 extern LongTermTimer MQTTclient_next_connect_attempt;
+
+# if FEATURE_MQTT_TLS
+#  include <WiFiClientSecure.h>
+
+extern WiFiClientSecure mqtt_tls;
+
+// The CA certificate must remain allocated, as the client only keeps a pointer to it.
+extern String    mqtt_tls_rootCA;
+extern bool      MQTTclient_usesTLS;
+
+// Local IP address at the moment the TLS connection was made
+extern IPAddress MQTTclient_tls_localIP;
+# endif // if FEATURE_MQTT_TLS
 #endif // if FEATURE_MQTT
 
 #ifdef USES_P037
+# include "../DataStructs/MQTT_TopicTrie.h"
 
 // mqtt import status
 extern bool P037_MQTTImport_connected;
+
+// Topics subscribed by all MQTT import tasks, to only forward a received message to the tasks subscribed to it.
+extern MQTT_TopicTrie P037_MQTTImport_topics;
 #endif // ifdef USES_P037
 
 
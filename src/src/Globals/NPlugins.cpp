@@ -36,6 +36,7 @@ bool NPluginCall(NPlugin::Function Function, struct EventStruct *event)
   {
     // Unconditional calls to all plugins
     case NPlugin::Function::NPLUGIN_PROTOCOL_ADD:
+    case NPlugin::Function::NPLUGIN_TEN_PER_SECOND:
 
       for (x = 0; x < NPLUGIN_MAX; x++) {
         if (validNPluginID(NPlugin_id[x])) {
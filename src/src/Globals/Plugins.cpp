@@ -23,12 +23,16 @@
 
 #if FEATURE_DEFINE_SERIAL_CONSOLE_PORT
 #include "../Helpers/_Plugin_Helper_serial.h"
+#include "../Helpers/BootProfiler.h"
 #endif
 
 #include "../Helpers/ESPEasyRTC.h"
 #include "../Helpers/ESPEasy_Storage.h"
+#include "../Helpers/HeapTracker.h"
 #include "../Helpers/Hardware.h"
+#include "../Helpers/I2C_ClockProfile.h"
 #include "../Helpers/Misc.h"
+#include "../Helpers/PluginCallStats.h"
 #include "../Helpers/_Plugin_init.h"
 #include "../Helpers/PortStatus.h"
 #include "../Helpers/StringConverter.h"
@@ -183,32 +187,32 @@ bool prepare_I2C_by_taskIndex(taskIndex_t taskIndex, deviceIndex_t DeviceIndex)
     return false; // Bus state is not OK, so do not consider task runnable
   }
   #if FEATURE_I2CMULTIPLEXER
-  I2CMultiplexerSelectByTaskIndex(taskIndex);
+  // The multiplexer keeps the channel of the previous task selected.
+  // Nothing is written to the multiplexer when the selection does not change.
+  if (I2CMultiplexerPortSelectedForTask(taskIndex)) {
+    I2CMultiplexerSelectByTaskIndex(taskIndex);
+  } else {
+    // Task is not behind the multiplexer, deselect the channel of a previous task
+    I2CMultiplexerOff();
+  }
   // Output is selected after this write, so now we must make sure the
   // frequency is set before anything else is sent.
   #endif // if FEATURE_I2CMULTIPLEXER
 
+  // The clock speed is always set for the task, so it does not need to be reset afterwards.
+  // I2CBegin() does nothing when the clock speed is not changed.
+  #if FEATURE_I2C_CLOCK_PROFILE
+  I2CSelectTaskClockSpeed(taskIndex);
+  #else // if FEATURE_I2C_CLOCK_PROFILE
   if (bitRead(Settings.I2C_Flags[taskIndex], I2C_FLAGS_SLOW_SPEED)) {
     I2CSelectLowClockSpeed(); // Set to slow
+  } else {
+    I2CSelectHighClockSpeed();
   }
+  #endif // if FEATURE_I2C_CLOCK_PROFILE
   return true;
 }
 
-
-void post_I2C_by_taskIndex(taskIndex_t taskIndex, deviceIndex_t DeviceIndex) {
-  if (!validTaskIndex(taskIndex) || !validDeviceIndex(DeviceIndex)) {
-    return;
-  }
-  if (Device[DeviceIndex].Type != DEVICE_TYPE_I2C) {
-    return;
-  }
-  #if FEATURE_I2CMULTIPLEXER
-  I2CMultiplexerOff();
-  #endif // if FEATURE_I2CMULTIPLEXER
-
-  I2CSelectHighClockSpeed();  // Reset
-}
-
 // Add an event to the event queue.
 // event value 1 = taskIndex (first task = 1)
 // event value 2 = return value of the plugin function
@@ -276,6 +280,7 @@ bool PluginCallForTask(taskIndex_t taskIndex, uint8_t Function, EventStruct *Tem
   #ifdef USE_SECOND_HEAP
   HeapSelectDram ephemeral;
   #endif
+  HEAP_TRACK_SCOPE(Plugins);
 
   bool retval = false;
   const bool considerTaskEnabled = Settings.TaskDeviceEnabled[taskIndex];
@@ -323,6 +328,9 @@ bool PluginCallForTask(taskIndex_t taskIndex, uint8_t Function, EventStruct *Tem
         if ((Function == PLUGIN_INIT) && (Device[DeviceIndex].Type == DEVICE_TYPE_I2C) && !Device[DeviceIndex].I2CNoDeviceCheck) {
           const uint8_t i2cAddr = getTaskI2CAddress(taskIndex);
           if (i2cAddr > 0) {
+            #if FEATURE_I2C_CLOCK_PROFILE
+            I2C_autoTuneTaskClockSpeed(taskIndex, i2cAddr);
+            #endif // if FEATURE_I2C_CLOCK_PROFILE
             START_TIMER;
             i2cStatusOk = I2C_deviceCheck(i2cAddr);
             STOP_TIMER_TASK(DeviceIndex, PLUGIN_I2C_GET_ADDRESS);
@@ -352,11 +360,22 @@ bool PluginCallForTask(taskIndex_t taskIndex, uint8_t Function, EventStruct *Tem
             Scheduler.schedule_task_device_timer_at_init(TempEvent->TaskIndex);
           }
 
-          START_TIMER;
-          retval = (PluginCall(DeviceIndex, Function, TempEvent, command));
-          STOP_TIMER_TASK(DeviceIndex, Function);
+          #if FEATURE_BOOT_PROFILER
+          const uint64_t callStart_usec = getMicros64();
+          #endif // if FEATURE_BOOT_PROFILER
+          {
+            #if FEATURE_PLUGIN_CALL_STATS
+            PluginCallStatsScope pluginCallStats(taskIndex, Function);
+            #endif // if FEATURE_PLUGIN_CALL_STATS
+            START_TIMER;
+            retval = (PluginCall(DeviceIndex, Function, TempEvent, command));
+            STOP_TIMER_TASK(DeviceIndex, Function);
+          }
 
           if (Function == PLUGIN_INIT) {
+            #if FEATURE_BOOT_PROFILER
+            BootProfiler_taskInit(taskIndex, usecPassedSince(callStart_usec));
+            #endif // if FEATURE_BOOT_PROFILER
             #if FEATURE_PLUGIN_STATS
             if (Device[DeviceIndex].PluginStats) {
               PluginTaskData_base *taskData = getPluginTaskData(taskIndex);
@@ -376,7 +395,6 @@ bool PluginCallForTask(taskIndex_t taskIndex, uint8_t Function, EventStruct *Tem
         }
         #endif // if FEATURE_I2C_DEVICE_CHECK
 
-        post_I2C_by_taskIndex(taskIndex, DeviceIndex);
         delay(0); // SMY: call delay(0) unconditionally
       } else {
         #if FEATURE_PLUGIN_STATS
@@ -398,6 +416,70 @@ bool PluginCallForTask(taskIndex_t taskIndex, uint8_t Function, EventStruct *Tem
   return retval;
 }
 
+/*********************************************************************************************\
+* Iterate over the tasks to call for a broadcast plugin call.
+* Tasks with a plugin not handling the function are skipped, see DeviceStruct::PluginCallSubscriptions
+\*********************************************************************************************/
+struct PluginCallTaskIterator {
+  // Only when called for all tasks, tasks not handling the function are skipped.
+  PluginCallTaskIterator(uint8_t     Function,
+                         taskIndex_t firstTask = 0,
+                         taskIndex_t lastTask  = TASKS_MAX)
+    : _subscribers(nullptr), _pos(firstTask), _end(lastTask)
+  {
+    if ((firstTask == 0) && (lastTask == TASKS_MAX)) {
+      _subscribers = Cache.getPluginCallSubscribers(Function);
+    }
+  }
+
+  bool next(taskIndex_t& taskIndex) {
+    if (_subscribers == nullptr) {
+      if (_pos >= _end) { return false; }
+      taskIndex = _pos++;
+      return true;
+    }
+
+    // Check size on every call, as a nested plugin call may update the subscribers
+    if (_pos >= _subscribers->size()) { return false; }
+    taskIndex = (*_subscribers)[_pos++];
+    return true;
+  }
+
+private:
+
+  const std::vector<taskIndex_t> *_subscribers;
+  size_t                          _pos;
+  size_t                          _end;
+};
+
+/*********************************************************************************************\
+* Temporary event for a broadcast plugin call.
+* Instead of a deep copy of the caller's event, its strings are lent to the temporary event
+* and handed back when done. Only the per task members are set for each task.
+* N.B. Changes made by a plugin to the strings are thus seen by the caller.
+\*********************************************************************************************/
+struct PluginCallBroadcastEvent {
+  PluginCallBroadcastEvent(EventStruct& tempEvent, EventStruct *event)
+    : _tempEvent(tempEvent), _event(event == &tempEvent ? nullptr : event)
+  {
+    if (_event != nullptr) {
+      _tempEvent.copy_except_strings(*_event);
+      _tempEvent.swap_strings(*_event);
+    }
+  }
+
+  ~PluginCallBroadcastEvent() {
+    if (_event != nullptr) {
+      _tempEvent.swap_strings(*_event);
+    }
+  }
+
+private:
+
+  EventStruct& _tempEvent;
+  EventStruct *_event;
+};
+
 /*********************************************************************************************\
 * Function call to all or specific plugins
 \*********************************************************************************************/
@@ -407,14 +489,12 @@ bool PluginCall(uint8_t Function, struct EventStruct *event, String& str)
   HeapSelectDram ephemeral;
   #endif
 
+  // Only used for broadcast calls, calls to a specific task use the caller's event.
   struct EventStruct TempEvent;
 
   if (event == nullptr) {
     event = &TempEvent;
   }
-  else {
-    TempEvent.deep_copy(*event);
-  }
 
   #ifndef BUILD_NO_RAM_TRACKER
   checkRAM(F("PluginCall"), Function);
@@ -441,6 +521,8 @@ bool PluginCall(uint8_t Function, struct EventStruct *event, String& str)
     */
 
     case PLUGIN_MONITOR:
+    {
+      PluginCallBroadcastEvent broadcastEvent(TempEvent, event);
 
       for (auto it = globalMapPortStatus.begin(); it != globalMapPortStatus.end(); ++it) {
         // only call monitor function if there the need to
@@ -459,12 +541,14 @@ bool PluginCall(uint8_t Function, struct EventStruct *event, String& str)
         }
       }
       return true;
+    }
 
 
     // Call to all plugins. Return at first match
     case PLUGIN_WRITE:
 //    case PLUGIN_REQUEST: @giig1967g: replaced by new function getGPIOPluginValues()
     {
+      PluginCallBroadcastEvent broadcastEvent(TempEvent, event);
       taskIndex_t firstTask = 0;
       taskIndex_t lastTask = TASKS_MAX;
       String command = String(str);                           // Local copy to avoid warning in ExecuteCommand
@@ -518,7 +602,11 @@ bool PluginCall(uint8_t Function, struct EventStruct *event, String& str)
   // info += lastTask;
   // addLog(LOG_LEVEL_INFO, info);
 
-      for (taskIndex_t task = firstTask; task < lastTask; task++)
+      // A specific task is always called, as the generic plugin task data commands must still be tried.
+      PluginCallTaskIterator tasks(Function, firstTask, lastTask);
+      taskIndex_t task;
+
+      while (tasks.next(task))
       {
         bool retval = PluginCallForTask(task, Function, &TempEvent, command);
 
@@ -528,7 +616,7 @@ bool PluginCall(uint8_t Function, struct EventStruct *event, String& str)
             // Don't try to match them on the first task that may have such data.
             PluginTaskData_base *taskData = getPluginTaskDataBaseClassOnly(task);
             if (nullptr != taskData) {
-              if (taskData->plugin_write_base(event, command)) {
+              if (taskData->plugin_write_base(&TempEvent, command)) {
                 retval = true;
               }
             }
@@ -563,7 +651,11 @@ bool PluginCall(uint8_t Function, struct EventStruct *event, String& str)
     case PLUGIN_SERIAL_IN:
     case PLUGIN_UDP_IN:
     {
-      for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; taskIndex++)
+      PluginCallBroadcastEvent broadcastEvent(TempEvent, event);
+      PluginCallTaskIterator tasks(Function);
+      taskIndex_t taskIndex;
+
+      while (tasks.next(taskIndex))
       {
         if (PluginCallForTask(taskIndex, Function, &TempEvent, str)) {
           #ifndef BUILD_NO_RAM_TRACKER
@@ -583,12 +675,16 @@ bool PluginCall(uint8_t Function, struct EventStruct *event, String& str)
     case PLUGIN_CLOCK_IN:
     case PLUGIN_TIME_CHANGE:
     {
+      PluginCallBroadcastEvent broadcastEvent(TempEvent, event);
+
       if (Function == PLUGIN_INIT_ALL) {
         Function = PLUGIN_INIT;
       }
       bool result = true;
+      PluginCallTaskIterator tasks(Function);
+      taskIndex_t taskIndex;
 
-      for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; taskIndex++)
+      while (tasks.next(taskIndex))
       {
         #ifndef BUILD_NO_DEBUG
         const int freemem_begin = ESP.getFreeHeap();
@@ -604,6 +700,7 @@ bool PluginCall(uint8_t Function, struct EventStruct *event, String& str)
             //Settings.TaskDeviceEnabled[taskIndex].setRetryInit(); 
             //Scheduler.setPluginTaskTimer(10000, taskIndex, PLUGIN_INIT);
             Settings.TaskDeviceEnabled[taskIndex] = false;
+            Cache.invalidateEnabledTasks();
             result = false;
           }
           #ifndef BUILD_NO_DEBUG
@@ -641,6 +738,8 @@ bool PluginCall(uint8_t Function, struct EventStruct *event, String& str)
     #if FEATURE_PLUGIN_PRIORITY
     case PLUGIN_PRIORITY_INIT_ALL:
     {
+      PluginCallBroadcastEvent broadcastEvent(TempEvent, event);
+
       if (Function == PLUGIN_PRIORITY_INIT_ALL) {
         addLogMove(LOG_LEVEL_INFO, F("INIT : Check for Priority tasks"));
         PluginInit(true); // Priority only, load plugins but don't initialize them yet
@@ -725,10 +824,21 @@ bool PluginCall(uint8_t Function, struct EventStruct *event, String& str)
               && (Device[DeviceIndex].Type == DEVICE_TYPE_I2C) && !Device[DeviceIndex].I2CNoDeviceCheck) {
             const uint8_t i2cAddr = getTaskI2CAddress(event->TaskIndex);
             if (i2cAddr > 0) {
+              #if FEATURE_I2C_CLOCK_PROFILE
+              if (Function == PLUGIN_INIT) {
+                I2C_autoTuneTaskClockSpeed(event->TaskIndex, i2cAddr);
+              }
+              #endif // if FEATURE_I2C_CLOCK_PROFILE
               START_TIMER;
               // Disable task when device is unreachable for 10 PLUGIN_READs or 1 PLUGIN_INIT
               i2cStatusOk = I2C_deviceCheck(i2cAddr, event->TaskIndex, Function == PLUGIN_INIT ? 1 : 10);
               STOP_TIMER_TASK(DeviceIndex, PLUGIN_I2C_GET_ADDRESS);
+              #if FEATURE_I2C_CLOCK_PROFILE
+              if (!i2cStatusOk && (Function == PLUGIN_READ)) {
+                // Try again at the next read with a lower clock speed
+                I2C_taskClockSpeedBackoff(event->TaskIndex);
+              }
+              #endif // if FEATURE_I2C_CLOCK_PROFILE
             }
           }
         }
@@ -786,7 +896,7 @@ bool PluginCall(uint8_t Function, struct EventStruct *event, String& str)
                 taskData->pushPluginStatsValues(event, !Device[DeviceIndex].TaskLogsOwnPeaks);
               }
               #endif // if FEATURE_PLUGIN_STATS
-              saveUserVarToRTC();
+              saveUserVarToRTC(event->TaskIndex);
             }
           }
           if (Function == PLUGIN_INIT) {
@@ -794,6 +904,7 @@ bool PluginCall(uint8_t Function, struct EventStruct *event, String& str)
               // Disable temporarily as PLUGIN_INIT failed
               // FIXME TD-er: Should reschedule call to PLUGIN_INIT????
               Settings.TaskDeviceEnabled[event->TaskIndex] = false;
+              Cache.invalidateEnabledTasks();
             } else {
               #if FEATURE_PLUGIN_STATS
               if (Device[DeviceIndex].PluginStats) {
@@ -809,12 +920,15 @@ bool PluginCall(uint8_t Function, struct EventStruct *event, String& str)
               }
               #endif // if FEATURE_PLUGIN_STATS
               // Schedule the plugin to be read.
-              Scheduler.schedule_task_device_timer_at_init(TempEvent.TaskIndex);
+              Scheduler.schedule_task_device_timer_at_init(event->TaskIndex);
               queueTaskEvent(F("TaskInit"), event->TaskIndex, retval);
             }
           }
           if (Function == PLUGIN_EXIT) {
             clearPluginTaskData(event->TaskIndex);
+            #if FEATURE_I2C_CLOCK_PROFILE
+            I2C_clearTaskClockProfile(event->TaskIndex);
+            #endif // if FEATURE_I2C_CLOCK_PROFILE
 //            initSerial();
             queueTaskEvent(F("TaskExit"), event->TaskIndex, retval);
             updateActiveTaskUseSerial0();
@@ -823,7 +937,6 @@ bool PluginCall(uint8_t Function, struct EventStruct *event, String& str)
         #if FEATURE_I2C_DEVICE_CHECK
         }
         #endif // if FEATURE_I2C_DEVICE_CHECK
-        post_I2C_by_taskIndex(event->TaskIndex, DeviceIndex);
         delay(0); // SMY: call delay(0) unconditionally
 
         return retval;
@@ -895,7 +1008,7 @@ bool PluginCall(uint8_t Function, struct EventStruct *event, String& str)
           Cache.updateExtraTaskSettingsCache();
         }
         if (Function == PLUGIN_SET_DEFAULTS) {
-          saveUserVarToRTC();
+          saveUserVarToRTC(event->TaskIndex);
         }
         if (Function == PLUGIN_GET_CONFIG_VALUE && !retval) {
           // Try to match a statistical property of a task value.
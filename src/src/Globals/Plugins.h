@@ -26,7 +26,7 @@
    
 
    We have the following one-to-one relations:
-   - Plugin_id_to_DeviceIndex  - Map from Plugin ID to Device Index.
+   - Plugin_id_to_DeviceIndex  - Map from Plugin ID to Device Index. (generated, see tools/pio/generate-plugin-tables.py)
    - DeviceIndex_to_Plugin_id  - Vector from DeviceIndex to Plugin ID.
    - Plugin_ptr                - Array of function pointers to call plugins.
    - Device                    - Vector of DeviceStruct containing plugin specific information.
@@ -95,7 +95,6 @@ String        getPluginNameFromPluginID(pluginID_t pluginID);
 // Prepare I2C bus for next call to task
 // Return false if task is I2C, but I2C bus is not ready
 bool prepare_I2C_by_taskIndex(taskIndex_t taskIndex, deviceIndex_t DeviceIndex);
-void post_I2C_by_taskIndex(taskIndex_t taskIndex, deviceIndex_t DeviceIndex);
 
 void loadDefaultTaskValueNames_ifEmpty(taskIndex_t TaskIndex);
 
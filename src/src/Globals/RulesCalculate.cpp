@@ -43,9 +43,15 @@ CalculateReturnCode Calculate(const String& input,
                               ESPEASY_RULES_FLOAT_TYPE      & result)
 {
   START_TIMER;
+#if FEATURE_RULES_CALCULATE_CACHE
+  CalculateReturnCode returnCode = RulesCalculate.doCalculateCached(
+    RulesCalculate_t::preProces(input).c_str(),
+    &result);
+#else // if FEATURE_RULES_CALCULATE_CACHE
   CalculateReturnCode returnCode = RulesCalculate.doCalculate(
     RulesCalculate_t::preProces(input).c_str(),
     &result);
+#endif // if FEATURE_RULES_CALCULATE_CACHE
 
   if (isError(returnCode)) {
     if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
@@ -92,3 +98,34 @@ CalculateReturnCode Calculate(const String& input,
   return returnCode;
 }
 
+#if FEATURE_RULES_CALCULATE_CACHE
+bool CompileTaskFormula(const String            & formula,
+                        RulesCalculate_program_t& program)
+{
+  program.clear();
+
+  String expression(formula);
+
+  expression.replace(F("%pvalue%"), String(static_cast<char>(RULES_CALCULATE_VARIABLE_MARKER + TASK_FORMULA_VAR_PVALUE)));
+  expression.replace(F("%value%"),  String(static_cast<char>(RULES_CALCULATE_VARIABLE_MARKER + TASK_FORMULA_VAR_VALUE)));
+
+  // Anything else which needs parseTemplate() cannot be compiled.
+  if ((expression.indexOf('%') != -1) ||
+      (expression.indexOf('[') != -1) ||
+      (expression.indexOf('{') != -1)) {
+    return false;
+  }
+  return RulesCalculate.compile(RulesCalculate_t::preProces(expression), program);
+}
+
+CalculateReturnCode CalculateTaskFormula(const RulesCalculate_program_t& program,
+                                         ESPEASY_RULES_FLOAT_TYPE        value,
+                                         ESPEASY_RULES_FLOAT_TYPE        pvalue,
+                                         ESPEASY_RULES_FLOAT_TYPE      & result)
+{
+  const ESPEASY_RULES_FLOAT_TYPE vars[] = { value, pvalue };
+
+  return RulesCalculate.execute(program, vars, NR_ELEMENTS(vars), &result);
+}
+
+#endif // if FEATURE_RULES_CALCULATE_CACHE
@@ -22,6 +22,24 @@ int                 CalculateParam(const String& TmpStr);
 CalculateReturnCode Calculate(const String& input,
                               ESPEASY_RULES_FLOAT_TYPE      & result);
 
+#if FEATURE_RULES_CALCULATE_CACHE
+
+// Variable indices used in compiled task value formulas
+# define TASK_FORMULA_VAR_VALUE   0
+# define TASK_FORMULA_VAR_PVALUE  1
+
+// Compile a task value formula, with %value% and %pvalue% as variables.
+// Return false when the formula cannot be compiled, for example when
+// it refers to other task values or system variables.
+bool                CompileTaskFormula(const String            & formula,
+                                       RulesCalculate_program_t& program);
+
+CalculateReturnCode CalculateTaskFormula(const RulesCalculate_program_t& program,
+                                         ESPEASY_RULES_FLOAT_TYPE        value,
+                                         ESPEASY_RULES_FLOAT_TYPE        pvalue,
+                                         ESPEASY_RULES_FLOAT_TYPE      & result);
+#endif // if FEATURE_RULES_CALCULATE_CACHE
+
 
 
 #endif
\ No newline at end of file
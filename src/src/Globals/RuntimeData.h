@@ -5,10 +5,9 @@
 
 #include "../CustomBuild/ESPEasyLimits.h"
 
+#include "../DataStructs/CustomVarStore.h"
 #include "../DataStructs/UserVarStruct.h"
 
-#include <map>
-
 /*********************************************************************************************\
 * Custom Variables for usage in rules and http.
 * This is volatile data, meaning it is lost after a reboot.
@@ -17,11 +16,12 @@
 * let,1,10
 * if %v1%=10 do ...
 \*********************************************************************************************/
-extern std::map<uint32_t, ESPEASY_RULES_FLOAT_TYPE> customFloatVar;
+extern CustomVarStore customFloatVar;
 
 ESPEASY_RULES_FLOAT_TYPE getCustomFloatVar(uint32_t index);
 void setCustomFloatVar(uint32_t index, const ESPEASY_RULES_FLOAT_TYPE& value);
 
+bool getFirstCustomFloatVar(uint32_t& index, ESPEASY_RULES_FLOAT_TYPE& value);
 bool getNextCustomFloatVar(uint32_t& index, ESPEASY_RULES_FLOAT_TYPE& value);
 
 
@@ -0,0 +1,261 @@
+#include "../Helpers/ADC_DMA.h"
+
+#if FEATURE_ADC_DMA
+
+# include "../ESPEasyCore/ESPEasy_Log.h"
+# include "../Helpers/Hardware.h"
+# include "../Helpers/StringConverter.h"
+
+# include <vector>
+
+# if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
+#  define ADC_DMA_RESULT_BYTES     2
+#  define ADC_DMA_CONV_LIMIT_EN    1 // Must be set on ESP32
+#  define ADC_DMA_OUTPUT_FORMAT    ADC_DIGI_OUTPUT_FORMAT_TYPE1
+# else // if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
+#  define ADC_DMA_RESULT_BYTES     4
+#  define ADC_DMA_CONV_LIMIT_EN    0
+#  define ADC_DMA_OUTPUT_FORMAT    ADC_DIGI_OUTPUT_FORMAT_TYPE2
+# endif // if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
+
+// Nr of bytes per DMA conversion frame
+# define ADC_DMA_FRAME_SIZE        256
+
+// Buffer size in msec of samples, must be larger than the interval of ADC_DMA_process() calls
+# define ADC_DMA_BUFFER_MSEC       200
+
+
+struct ADC_DMA_channel_t {
+  taskIndex_t     taskIndex;
+  uint8_t         channel;
+  adc_atten_t     attenuation;
+  uint32_t        sampleRate;
+  ADC_DMA_stats_t stats;
+};
+
+static std::vector<ADC_DMA_channel_t> ADC_DMA_channels;
+static uint32_t ADC_DMA_sampleRate = 0;
+
+
+void ADC_DMA_stats_t::add(uint16_t value)
+{
+  if ((count == 0) || (value < min)) { min = value; }
+
+  if ((count == 0) || (value > max)) { max = value; }
+  ++count;
+  sum    += value;
+  sumSqr += static_cast<uint32_t>(value) * value;
+}
+
+float ADC_DMA_stats_t::getMean() const
+{
+  if (count == 0) { return 0.0f; }
+  return static_cast<float>(sum) / count;
+}
+
+float ADC_DMA_stats_t::getRMS_AC() const
+{
+  if (count == 0) { return 0.0f; }
+  const double mean     = static_cast<double>(sum) / count;
+  const double variance = static_cast<double>(sumSqr) / count - mean * mean;
+
+  return variance > 0.0 ? sqrt(variance) : 0.0f;
+}
+
+uint16_t ADC_DMA_stats_t::getPeakToPeak() const
+{
+  return max - min;
+}
+
+static void ADC_DMA_stop()
+{
+  if (ADC_DMA_sampleRate != 0) {
+    adc_digi_stop();
+    adc_digi_deinitialize();
+    ADC_DMA_sampleRate = 0;
+  }
+}
+
+// (Re)start the stream with all registered channels
+static bool ADC_DMA_start()
+{
+  ADC_DMA_stop();
+
+  if (ADC_DMA_channels.empty()) {
+    return true;
+  }
+
+  adc_digi_pattern_config_t pattern[SOC_ADC_PATT_LEN_MAX]{};
+  uint32_t adc1_chan_mask = 0;
+  uint32_t sampleRate     = SOC_ADC_SAMPLE_FREQ_THRES_LOW;
+  uint32_t pattern_num    = 0;
+
+  for (auto it = ADC_DMA_channels.begin(); it != ADC_DMA_channels.end(); ++it) {
+    if (it->sampleRate > sampleRate) {
+      sampleRate = it->sampleRate;
+    }
+
+    // Multiple tasks may use the same channel, then the attenuation of the first is used.
+    if (((adc1_chan_mask & (1 << it->channel)) == 0) && (pattern_num < SOC_ADC_PATT_LEN_MAX)) {
+      adc1_chan_mask              |= (1 << it->channel);
+      pattern[pattern_num].atten     = it->attenuation;
+      pattern[pattern_num].channel   = it->channel;
+      pattern[pattern_num].unit      = 0; // ADC1
+      pattern[pattern_num].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+      ++pattern_num;
+    }
+  }
+
+  if (sampleRate > ADC_DMA_MAX_SAMPLE_RATE) {
+    sampleRate = ADC_DMA_MAX_SAMPLE_RATE;
+  }
+
+  if (sampleRate > SOC_ADC_SAMPLE_FREQ_THRES_HIGH) {
+    sampleRate = SOC_ADC_SAMPLE_FREQ_THRES_HIGH;
+  }
+
+  // Buffer for ADC_DMA_BUFFER_MSEC of samples, rounded up to whole frames
+  uint32_t bufferSize = (sampleRate * ADC_DMA_RESULT_BYTES * ADC_DMA_BUFFER_MSEC) / 1000;
+
+  bufferSize = ((bufferSize / ADC_DMA_FRAME_SIZE) + 1) * ADC_DMA_FRAME_SIZE;
+
+  adc_digi_init_config_t init_config{};
+
+  init_config.max_store_buf_size = bufferSize;
+  init_config.conv_num_each_intr = ADC_DMA_FRAME_SIZE;
+  init_config.adc1_chan_mask     = adc1_chan_mask;
+  init_config.adc2_chan_mask     = 0;
+
+  adc_digi_configuration_t digi_config{};
+
+  digi_config.conv_limit_en  = ADC_DMA_CONV_LIMIT_EN;
+  digi_config.conv_limit_num = 250;
+  digi_config.pattern_num    = pattern_num;
+  digi_config.adc_pattern    = pattern;
+  digi_config.sample_freq_hz = sampleRate;
+  digi_config.conv_mode      = ADC_CONV_SINGLE_UNIT_1;
+  digi_config.format         = ADC_DMA_OUTPUT_FORMAT;
+
+  if (adc_digi_initialize(&init_config) != ESP_OK) {
+    addLog(LOG_LEVEL_ERROR, F("ADC  : Could not initialize DMA mode"));
+    return false;
+  }
+
+  if ((adc_digi_controller_configure(&digi_config) != ESP_OK) ||
+      (adc_digi_start() != ESP_OK)) {
+    adc_digi_deinitialize();
+    addLog(LOG_LEVEL_ERROR, F("ADC  : Could not start DMA mode"));
+    return false;
+  }
+  ADC_DMA_sampleRate = sampleRate;
+
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    addLogMove(LOG_LEVEL_INFO, strformat(
+                 F("ADC  : DMA mode started, %u channels at %u Hz"),
+                 static_cast<unsigned int>(pattern_num),
+                 static_cast<unsigned int>(sampleRate)));
+  }
+  return true;
+}
+
+bool ADC_DMA_addChannel(taskIndex_t taskIndex,
+                        int         gpio_pin,
+                        adc_atten_t attenuation,
+                        uint32_t    sampleRate_Hz)
+{
+  int adc, ch, t;
+
+  if (!validTaskIndex(taskIndex) ||
+      !getADC_gpio_info(gpio_pin, adc, ch, t) ||
+      (adc != 1)) {
+    return false;
+  }
+
+  for (auto it = ADC_DMA_channels.begin(); it != ADC_DMA_channels.end(); ++it) {
+    if (it->taskIndex == taskIndex) {
+      ADC_DMA_channels.erase(it);
+      break;
+    }
+  }
+  ADC_DMA_channel_t channel;
+
+  channel.taskIndex   = taskIndex;
+  channel.channel     = ch;
+  channel.attenuation = attenuation;
+  channel.sampleRate  = sampleRate_Hz;
+  ADC_DMA_channels.push_back(channel);
+
+  return ADC_DMA_start();
+}
+
+void ADC_DMA_removeChannel(taskIndex_t taskIndex)
+{
+  for (auto it = ADC_DMA_channels.begin(); it != ADC_DMA_channels.end(); ++it) {
+    if (it->taskIndex == taskIndex) {
+      ADC_DMA_channels.erase(it);
+      ADC_DMA_start();
+      return;
+    }
+  }
+}
+
+void ADC_DMA_process()
+{
+  if (ADC_DMA_sampleRate == 0) {
+    return;
+  }
+  uint8_t  buffer[ADC_DMA_FRAME_SIZE];
+  uint32_t nrBytes = 0;
+  esp_err_t res;
+
+  // ESP_ERR_INVALID_STATE: Data is returned, but samples were lost as the buffer was full.
+  while (((res = adc_digi_read_bytes(buffer, sizeof(buffer), &nrBytes, 0)) == ESP_OK) ||
+         (res == ESP_ERR_INVALID_STATE)) {
+    if (nrBytes == 0) {
+      return;
+    }
+
+    for (uint32_t i = 0; i + ADC_DMA_RESULT_BYTES <= nrBytes; i += ADC_DMA_RESULT_BYTES) {
+      const adc_digi_output_data_t *sample = reinterpret_cast<const adc_digi_output_data_t *>(&buffer[i]);
+      # if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
+      const uint8_t  channel = sample->type1.channel;
+      const uint16_t value   = sample->type1.data;
+      # else // if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
+
+      if (sample->type2.unit != 0) { continue; }
+      const uint8_t  channel = sample->type2.channel;
+      const uint16_t value   = sample->type2.data;
+      # endif // if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
+
+      for (auto it = ADC_DMA_channels.begin(); it != ADC_DMA_channels.end(); ++it) {
+        if (it->channel == channel) {
+          it->stats.add(value);
+        }
+      }
+    }
+  }
+}
+
+bool ADC_DMA_getStats(taskIndex_t      taskIndex,
+                      ADC_DMA_stats_t& stats,
+                      bool             reset)
+{
+  for (auto it = ADC_DMA_channels.begin(); it != ADC_DMA_channels.end(); ++it) {
+    if (it->taskIndex == taskIndex) {
+      stats = it->stats;
+
+      if (reset) {
+        it->stats = ADC_DMA_stats_t();
+      }
+      return stats.count != 0;
+    }
+  }
+  return false;
+}
+
+uint32_t ADC_DMA_getSampleRate()
+{
+  return ADC_DMA_sampleRate;
+}
+
+#endif // if FEATURE_ADC_DMA
@@ -0,0 +1,66 @@
+#ifndef HELPERS_ADC_DMA_H
+#define HELPERS_ADC_DMA_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_ADC_DMA
+
+# include "../DataTypes/TaskIndex.h"
+
+# include <driver/adc.h>
+
+/*********************************************************************************************\
+*  Continuous ADC sampling using the DMA mode of the ESP32 ADC.
+*  All registered channels share a single DMA stream on ADC1.
+*  The sample rate is shared among the channels, so each channel is sampled at
+*  (sample rate / nr of channels).
+*
+*  While the stream is running, ADC1 cannot be read using analogRead().
+\*********************************************************************************************/
+
+// Max. sample rate of the stream, limited by the memory needed to buffer 200 msec of samples.
+# ifndef ADC_DMA_MAX_SAMPLE_RATE
+#  define ADC_DMA_MAX_SAMPLE_RATE  80000
+# endif // ifndef ADC_DMA_MAX_SAMPLE_RATE
+
+struct ADC_DMA_stats_t {
+  void     add(uint16_t value);
+
+  float    getMean() const;
+
+  // Standard deviation, which is the RMS of the AC component
+  float    getRMS_AC() const;
+
+  uint16_t getPeakToPeak() const;
+
+  uint32_t count  = 0;
+  uint64_t sum    = 0;
+  uint64_t sumSqr = 0;
+  uint16_t min    = 0;
+  uint16_t max    = 0;
+};
+
+// Register the GPIO pin for the task, replacing any existing channel for the task.
+// Only ADC1 pins can be used.
+// @param sampleRate_Hz   Requested sample rate, the highest requested rate of all channels is used.
+bool     ADC_DMA_addChannel(taskIndex_t taskIndex,
+                            int         gpio_pin,
+                            adc_atten_t attenuation,
+                            uint32_t    sampleRate_Hz);
+
+void     ADC_DMA_removeChannel(taskIndex_t taskIndex);
+
+// Read all available samples from the DMA buffer and add them to the stats of the channels.
+void     ADC_DMA_process();
+
+// Get the stats of the task collected since the last reset.
+bool     ADC_DMA_getStats(taskIndex_t      taskIndex,
+                          ADC_DMA_stats_t& stats,
+                          bool             reset);
+
+// Actual sample rate of the stream, 0 when not running
+uint32_t ADC_DMA_getSampleRate();
+
+#endif // if FEATURE_ADC_DMA
+
+#endif // ifndef HELPERS_ADC_DMA_H
@@ -4,6 +4,11 @@
 #ifdef PLUGIN_USES_ADAFRUITGFX
 
 # include "../Helpers/StringConverter.h"
+# include "../Helpers/CRC_functions.h"
+
+# if ADAGFX_ENABLE_LINE_BUFFER
+#  include <esp_heap_caps.h>
+# endif // if ADAGFX_ENABLE_LINE_BUFFER
 # include "../WebServer/Markup_Forms.h"
 
 # if ADAGFX_FONTS_INCLUDED
@@ -1108,15 +1113,15 @@ bool AdafruitGFX_helper::processCommand(const String& string) {
     if (_window == 0)
     # endif // if ADAGFX_ENABLE_FRAMED_WINDOW
     {
-      _display->fillScreen(argCount == 0 ? _bgcolor : AdaGFXparseColor(sParams[0], _colorDepth));
+      fillScreen(argCount == 0 ? _bgcolor : AdaGFXparseColor(sParams[0], _colorDepth));
     }
     # if ADAGFX_ENABLE_FRAMED_WINDOW
     else {
       // logWindows(F("clear ")); // Use for debugging only
       uint16_t _w = 0, _h = 0;
       getWindowLimits(_w, _h);
-      _display->fillRect(_xo, _yo, _w, _h,
-                         argCount == 0 ? _bgcolor : AdaGFXparseColor(sParams[0], _colorDepth));
+      fillRect(_xo, _yo, _w, _h,
+               argCount == 0 ? _bgcolor : AdaGFXparseColor(sParams[0], _colorDepth));
     }
     # endif // if ADAGFX_ENABLE_FRAMED_WINDOW
   }
@@ -1195,55 +1200,55 @@ bool AdafruitGFX_helper::processCommand(const String& string) {
     const adagfx_fonts_e font = static_cast<adagfx_fonts_e>(font_i);
 
     if (adagfx_fonts_e::sevenseg24 == font) {
-      _display->setFont(&Seven_Segment24pt7b);
+      setFont(&Seven_Segment24pt7b);
       calculateTextMetrics(21, 42, 35, true);
     } else if (adagfx_fonts_e::sevenseg18 == font) {
-      _display->setFont(&Seven_Segment18pt7b);
+      setFont(&Seven_Segment18pt7b);
       calculateTextMetrics(16, 33, 26, true);
     } else if (adagfx_fonts_e::freesans == font) {
-      _display->setFont(&FreeSans9pt7b);
+      setFont(&FreeSans9pt7b);
       calculateTextMetrics(10, 16, 12);
 
       // Extra 8pt fonts:
     #  ifdef ADAGFX_FONTS_EXTRA_8PT_INCLUDED
     #   ifdef ADAGFX_FONTS_EXTRA_8PT_ANGELINA
     } else if (adagfx_fonts_e::angelina8prop == font) { // Proportional font!
-      _display->setFont(&angelina8pt7b);
+      setFont(&angelina8pt7b);
       calculateTextMetrics(6, 16, 12, true);
     #   endif // ifdef ADAGFX_FONTS_EXTRA_8PT_ANGELINA
     #   ifdef ADAGFX_FONTS_EXTRA_8PT_NOVAMONO
     } else if (adagfx_fonts_e::novamono8pt == font) {
-      _display->setFont(&NovaMono8pt7b);
+      setFont(&NovaMono8pt7b);
       calculateTextMetrics(9, 16, 12);
     #   endif // ifdef ADAGFX_FONTS_EXTRA_8PT_NOVAMONO
     #   ifdef ADAGFX_FONTS_EXTRA_8PT_UNISPACE
     } else if (adagfx_fonts_e::unispace8pt == font) {
-      _display->setFont(&unispace8pt7b);
+      setFont(&unispace8pt7b);
       calculateTextMetrics(13, 24, 20);
     #   endif // ifdef ADAGFX_FONTS_EXTRA_8PT_UNISPACE
     #   ifdef ADAGFX_FONTS_EXTRA_8PT_UNISPACEITALIC
     } else if (adagfx_fonts_e::unispaceitalic8pt == font) {
-      _display->setFont(&unispace_italic8pt7b);
+      setFont(&unispace_italic8pt7b);
       calculateTextMetrics(13, 24, 20);
     #   endif // ifdef ADAGFX_FONTS_EXTRA_8PT_UNISPACEITALIC
     #   ifdef ADAGFX_FONTS_EXTRA_8PT_WHITERABBiT
     } else if (adagfx_fonts_e::whiterabbit8pt == font) {
-      _display->setFont(&whitrabt8pt7b);
+      setFont(&whitrabt8pt7b);
       calculateTextMetrics(10, 16, 12);
     #   endif // ifdef ADAGFX_FONTS_EXTRA_8PT_WHITERABBiT
     #   ifdef ADAGFX_FONTS_EXTRA_8PT_ROBOTO
     } else if (adagfx_fonts_e::roboto8pt == font) { // Proportional font!
-      _display->setFont(&Roboto_Regular8pt7b);
+      setFont(&Roboto_Regular8pt7b);
       calculateTextMetrics(10, 16, 12, true);
     #   endif // ifdef ADAGFX_FONTS_EXTRA_8PT_ROBOTO
     #   ifdef ADAGFX_FONTS_EXTRA_8PT_ROBOTOCONDENSED
     } else if (adagfx_fonts_e::robotocond8pt == font) { // Proportional font!
-      _display->setFont(&RobotoCondensed_Regular8pt7b);
+      setFont(&RobotoCondensed_Regular8pt7b);
       calculateTextMetrics(9, 16, 12, true);
     #   endif // ifdef ADAGFX_FONTS_EXTRA_8PT_ROBOTOCONDENSED
     #   ifdef ADAGFX_FONTS_EXTRA_8PT_ROBOTOMONO
     } else if (adagfx_fonts_e::robotomono8pt == font) {
-      _display->setFont(&RobotoMono_Regular8pt7b);
+      setFont(&RobotoMono_Regular8pt7b);
       calculateTextMetrics(10, 16, 12);
     #   endif // ifdef ADAGFX_FONTS_EXTRA_8PT_ROBOTOMONO
     #  endif  // ifdef ADAGFX_FONTS_EXTRA_8PT_INCLUDED
@@ -1251,93 +1256,93 @@ bool AdafruitGFX_helper::processCommand(const String& string) {
     #  ifdef ADAGFX_FONTS_EXTRA_12PT_INCLUDED
     #   ifdef ADAGFX_FONTS_EXTRA_12PT_ANGELINA
     } else if (adagfx_fonts_e::angelina12prop == font) { // Proportional font!
-      _display->setFont(&angelina12pt7b);
+      setFont(&angelina12pt7b);
       calculateTextMetrics(8, 22, 18, true);
     #   endif // ifdef ADAGFX_FONTS_EXTRA_12PT_ANGELINA
     #   ifdef ADAGFX_FONTS_EXTRA_12PT_NOVAMONO
     } else if (adagfx_fonts_e::novamono12pt == font) {
-      _display->setFont(&NovaMono12pt7b);
+      setFont(&NovaMono12pt7b);
       calculateTextMetrics(13, 26, 22);
     #   endif // ifdef ADAGFX_FONTS_EXTRA_12PT_NOVAMONO
     #   ifdef ADAGFX_FONTS_EXTRA_12PT_REPETITIONSCROLLiNG
     } else if (adagfx_fonts_e::repetitionscrolling12pt == font) {
-      _display->setFont(&RepetitionScrolling12pt7b);
+      setFont(&RepetitionScrolling12pt7b);
       calculateTextMetrics(13, 22, 18);
     #   endif // ifdef ADAGFX_FONTS_EXTRA_12PT_REPETITIONSCROLLiNG
     #   ifdef ADAGFX_FONTS_EXTRA_12PT_UNISPACE
     } else if (adagfx_fonts_e::unispace12pt == font) {
-      _display->setFont(&unispace12pt7b);
+      setFont(&unispace12pt7b);
       calculateTextMetrics(18, 30, 26);
     #   endif // ifdef ADAGFX_FONTS_EXTRA_12PT_UNISPACE
     #   ifdef ADAGFX_FONTS_EXTRA_12PT_UNISPACEITALIC
     } else if (adagfx_fonts_e::unispaceitalic12pt == font) {
-      _display->setFont(&unispace_italic12pt7b);
+      setFont(&unispace_italic12pt7b);
       calculateTextMetrics(18, 30, 26);
     #   endif // ifdef ADAGFX_FONTS_EXTRA_12PT_UNISPACEITALIC
     #   ifdef ADAGFX_FONTS_EXTRA_12PT_WHITERABBiT
     } else if (adagfx_fonts_e::whiterabbit12pt == font) {
-      _display->setFont(&whitrabt12pt7b);
+      setFont(&whitrabt12pt7b);
       calculateTextMetrics(13, 20, 16);
     #   endif // ifdef ADAGFX_FONTS_EXTRA_12PT_WHITERABBiT
     #   ifdef ADAGFX_FONTS_EXTRA_12PT_ROBOTO
     } else if (adagfx_fonts_e::roboto12pt == font) { // Proportional font!
-      _display->setFont(&Roboto_Regular12pt7b);
+      setFont(&Roboto_Regular12pt7b);
       calculateTextMetrics(13, 20, 16, true);
     #   endif // ifdef ADAGFX_FONTS_EXTRA_12PT_ROBOTO
     #   ifdef ADAGFX_FONTS_EXTRA_12PT_ROBOTOCONDENSED
     } else if (adagfx_fonts_e::robotocond12pt == font) { // Proportional font!
-      _display->setFont(&RobotoCondensed_Regular12pt7b);
+      setFont(&RobotoCondensed_Regular12pt7b);
       calculateTextMetrics(13, 20, 16, true);
     #   endif // ifdef ADAGFX_FONTS_EXTRA_12PT_ROBOTOCONDENSED
     #   ifdef ADAGFX_FONTS_EXTRA_12PT_ROBOTOMONO
     } else if (adagfx_fonts_e::robotomono12pt == font) {
-      _display->setFont(&RobotoMono_Regular12pt7b);
+      setFont(&RobotoMono_Regular12pt7b);
       calculateTextMetrics(13, 20, 16);
     #   endif // ifdef ADAGFX_FONTS_EXTRA_12PT_ROBOTOMONO
     #  endif  // ifdef ADAGFX_FONTS_EXTRA_12PT_INCLUDED
     #  ifdef ADAGFX_FONTS_EXTRA_16PT_INCLUDED
     #   ifdef ADAGFX_FONTS_EXTRA_16PT_AMERIKASANS
     } else if (adagfx_fonts_e::amerikasans16pt == font) { // Proportional font!
-      _display->setFont(&AmerikaSans16pt7b);
+      setFont(&AmerikaSans16pt7b);
       calculateTextMetrics(17, 30, 26, true);
     #   endif // ifdef ADAGFX_FONTS_EXTRA_16PT_AMERIKASANS
     #   ifdef ADAGFX_FONTS_EXTRA_16PT_WHITERABBiT
     } else if (adagfx_fonts_e::whiterabbit16pt == font) {
-      _display->setFont(&whitrabt16pt7b);
+      setFont(&whitrabt16pt7b);
       calculateTextMetrics(18, 26, 22);
     #   endif // ifdef ADAGFX_FONTS_EXTRA_16PT_WHITERABBiT
     #   ifdef ADAGFX_FONTS_EXTRA_16PT_ROBOTO
     } else if (adagfx_fonts_e::roboto16pt == font) { // Proportional font!
-      _display->setFont(&Roboto_Regular16pt7b);
+      setFont(&Roboto_Regular16pt7b);
       calculateTextMetrics(18, 27, 23, true);
     #   endif // ifdef ADAGFX_FONTS_EXTRA_16PT_ROBOTO
     #   ifdef ADAGFX_FONTS_EXTRA_16PT_ROBOTOCONDENSED
     } else if (adagfx_fonts_e::robotocond16pt == font) { // Proportional font!
-      _display->setFont(&RobotoCondensed_Regular16pt7b);
+      setFont(&RobotoCondensed_Regular16pt7b);
       calculateTextMetrics(18, 27, 23, true);
     #   endif // ifdef ADAGFX_FONTS_EXTRA_16PT_ROBOTOCONDENSED
     #   ifdef ADAGFX_FONTS_EXTRA_16PT_ROBOTOMONO
     } else if (adagfx_fonts_e::robotomono16pt == font) {
-      _display->setFont(&RobotoMono_Regular16pt7b);
+      setFont(&RobotoMono_Regular16pt7b);
       calculateTextMetrics(18, 27, 23);
     #   endif // ifdef ADAGFX_FONTS_EXTRA_16PT_ROBOTOMONO
     #  endif  // ifdef ADAGFX_FONTS_EXTRA_16PT_INCLUDED
     #  ifdef ADAGFX_FONTS_EXTRA_18PT_INCLUDED
     #   ifdef ADAGFX_FONTS_EXTRA_18PT_WHITERABBiT
     } else if (adagfx_fonts_e::whiterabbit18pt == font) {
-      _display->setFont(&whitrabt18pt7b);
+      setFont(&whitrabt18pt7b);
       calculateTextMetrics(21, 30, 26);
       #   endif // ifdef ADAGFX_FONTS_EXTRA_18PT_WHITERABBiT
     #  endif    // ifdef ADAGFX_FONTS_EXTRA_18PT_WHITERABBiT
     #  ifdef ADAGFX_FONTS_EXTRA_20PT_INCLUDED
     #   ifdef ADAGFX_FONTS_EXTRA_20PT_WHITERABBiT
     } else if (adagfx_fonts_e::whiterabbit20pt == font) {
-      _display->setFont(&whitrabt20pt7b);
+      setFont(&whitrabt20pt7b);
       calculateTextMetrics(24, 32, 28);
     #   endif // ifdef ADAGFX_FONTS_EXTRA_20PT_WHITERABBiT
     #  endif  // ifdef ADAGFX_FONTS_EXTRA_20PT_INCLUDED
     } else if (adagfx_fonts_e::default_font == font) { // font,default is always available!
-      _display->setFont();
+      setFont();
       calculateTextMetrics(6, 9);
     } else {
       success = false;
@@ -1910,6 +1915,32 @@ bool AdafruitGFX_helper::processCommand(const String& string) {
     success = false;
   }
 
+  # if ADAGFX_ENABLE_DRAW_CACHE
+
+  if (success) {
+    switch (subcmd) {
+      case adagfx_commands_e::txp: // No drawing
+      case adagfx_commands_e::txc:
+      case adagfx_commands_e::txs:
+      case adagfx_commands_e::rot: // setRotation() resets the cache
+      case adagfx_commands_e::win:
+      case adagfx_commands_e::defwin:
+      case adagfx_commands_e::delwin:
+      case adagfx_commands_e::txl: // Text is drawn and tracked by printText()
+      case adagfx_commands_e::txtfull:
+      case adagfx_commands_e::asciitable:
+        break;
+      case adagfx_commands_e::tpm: // Changes how the same text is drawn
+      case adagfx_commands_e::font:
+        _textCache.clear();
+        break;
+      default:                     // Anything else drawn, assume the entire window has changed
+        invalidateWindow();
+        break;
+    }
+  }
+  # endif // if ADAGFX_ENABLE_DRAW_CACHE
+
   return success;
 }
 
@@ -2133,7 +2164,13 @@ void AdafruitGFX_helper::printText(const char     *string,
   # endif // if ADAGFX_ENABLE_FRAMED_WINDOW
 
   _display->setTextSize(textSize);
-  _display->getTextBounds(String('A'), 0, 0, &xText, &yText, &wChar1, &hChar1); // Calculate ~1 char height
+
+  if (_charBoundsSize != textSize) { // Only changes with font or size
+    _display->getTextBounds(String('A'), 0, 0, &xText, &yText, &_charWidth, &_charHeight); // Calculate ~1 char height
+    _charBoundsSize = textSize;
+  }
+  wChar1 = _charWidth;
+  hChar1 = _charHeight;
 
   if (_columnRowMode) {
     _x = X * (_fontwidth * textSize);                                           // We need this multiple times
@@ -2148,6 +2185,27 @@ void AdafruitGFX_helper::printText(const char     *string,
   _display->setCursor(_x, _y);
   _display->setTextColor(color, bkcolor);
 
+  # if ADAGFX_ENABLE_DRAW_CACHE
+  const uint32_t textCRC   = _drawCache ? calc_CRC32(reinterpret_cast<const uint8_t *>(string), strlen(string)) : 0u;
+  const uint16_t textBkcol = bkcolor;
+  const int16_t  textX     = _x; // _y can be adjusted below
+  const int16_t  textY     = _y;
+
+  if (_drawCache) {
+    for (auto it = _textCache.begin(); it != _textCache.end(); ++it) {
+      if ((it->x == textX) && (it->y == textY)) {
+        if ((it->textCRC == textCRC) && (it->textSize == textSize) && (it->color == color) &&
+            (it->bkcolor == bkcolor) && (it->maxWidth == maxWidth)) {
+          _display->setCursor(it->cursorX, it->cursorY); // Already on display, only move the cursor
+          return;
+        }
+        break;
+      }
+    }
+  }
+  tDirtyRect area;
+  # endif // if ADAGFX_ENABLE_DRAW_CACHE
+
   if (_textPrintMode != AdaGFXTextPrintMode::ContinueToNextLine) {
     # if ADAGFX_ENABLE_FRAMED_WINDOW
 
@@ -2223,12 +2281,265 @@ void AdafruitGFX_helper::printText(const char     *string,
     } else {
       _display->fillRect(_x + oTop, yText, _w, hText + oBottom - oTop, bkcolor); // Clear text area
     }
+    # if ADAGFX_ENABLE_DRAW_CACHE
+    area.x = _x + oTop;
+    area.y = yText;
+    area.w = (_textPrintMode == AdaGFXTextPrintMode::ClearThenTruncate) ? res_x - (_x - xOffset) : _w;
+    area.h = hText + oBottom - oTop;
+    # endif // if ADAGFX_ENABLE_DRAW_CACHE
 
     delay(0);
   }
 
   _display->setCursor(_x + oLeft, _y); // add left offset to center, _y may be updated
-  _display->print(newString);
+  # if ADAGFX_ENABLE_GLYPH_CACHE
+
+  if (nullptr != _font) {
+    printString(newString, textSize, color);
+  } else
+  # endif // if ADAGFX_ENABLE_GLYPH_CACHE
+  {
+    _display->print(newString);
+  }
+
+  # if ADAGFX_ENABLE_DRAW_CACHE
+  tDirtyRect textArea;
+  textArea.x = xText + oLeft;
+  textArea.y = yText + oBottom; // Moved down when back-filling
+  textArea.w = wText;
+  textArea.h = hText;
+  area.add(textArea);
+  invalidateArea(area);         // Also drops the previous text at this position
+
+  if (_drawCache) {
+    tTextCacheEntry entry;
+    entry.area     = area;
+    entry.textCRC  = textCRC;
+    entry.x        = textX;
+    entry.y        = textY;
+    entry.cursorX  = _display->getCursorX();
+    entry.cursorY  = _display->getCursorY();
+    entry.color    = color;
+    entry.bkcolor  = textBkcol;
+    entry.maxWidth = maxWidth;
+    entry.textSize = textSize;
+
+    if (_textCache.size() < ADAGFX_DRAW_CACHE_SIZE) {
+      _textCache.push_back(entry);
+    } else {
+      _textCache[_textCacheNext] = entry; // Replace the oldest
+      _textCacheNext             = (_textCacheNext + 1) % ADAGFX_DRAW_CACHE_SIZE;
+    }
+  }
+  # endif // if ADAGFX_ENABLE_DRAW_CACHE
+}
+
+/****************************************************************************
+ * setFont: Set the font on the display, and forget data cached for the previous font
+ ***************************************************************************/
+void AdafruitGFX_helper::setFont(const GFXfont *font) {
+  _display->setFont(font);
+  _charBoundsSize = 0;
+  # if ADAGFX_ENABLE_GLYPH_CACHE
+  _font = font;
+  _glyphCache.clear();
+  _glyphCacheNext = 0;
+  # endif // if ADAGFX_ENABLE_GLYPH_CACHE
+}
+
+# if ADAGFX_ENABLE_GLYPH_CACHE
+
+/****************************************************************************
+ * printString: Print text in a custom font at the cursor, like Adafruit_GFX::print()
+ * Digits and numeric symbols are drawn from the glyph cache as horizontal lines,
+ * instead of decoding the glyph bitmap and drawing every pixel separately
+ ***************************************************************************/
+void AdafruitGFX_helper::printString(const String  & text,
+                                     const uint8_t & textSize,
+                                     const uint16_t& color) {
+  const uint8_t  first    = pgm_read_byte(&_font->first);
+  const uint8_t  last     = pgm_read_byte(&_font->last);
+  const int16_t  yAdvance = static_cast<int16_t>(textSize) * pgm_read_byte(&_font->yAdvance);
+  const bool     wrap     = _textPrintMode == AdaGFXTextPrintMode::ContinueToNextLine;
+  const int16_t  width    = _display->width();
+  int16_t        cx       = _display->getCursorX();
+  int16_t        cy       = _display->getCursorY();
+
+  for (size_t i = 0; i < text.length(); ++i) {
+    const uint8_t c = text[i];
+
+    if (c == '\n') {
+      cx  = 0;
+      cy += yAdvance;
+      continue;
+    }
+
+    if ((c == '\r') || (c < first) || (c > last)) { continue; }
+
+    const GFXglyph *glyph = _font->glyph + (c - first);
+    const uint8_t   w     = pgm_read_byte(&glyph->width);
+    const uint8_t   h     = pgm_read_byte(&glyph->height);
+
+    if ((w > 0) && (h > 0)) {
+      const int8_t xo = pgm_read_byte(&glyph->xOffset);
+
+      if (wrap && ((cx + textSize * (xo + w)) > width)) {
+        cx  = 0;
+        cy += yAdvance;
+      }
+      const tGlyphCacheEntry *entry = nullptr;
+
+      if (isDigit(c) || (strchr_P(PSTR(".,:-+%/"), c) != nullptr)) {
+        entry = getGlyph(c);
+      }
+
+      if (nullptr != entry) {
+        _display->startWrite();
+
+        for (auto it = entry->spans.begin(); it != entry->spans.end(); ++it) {
+          if (textSize == 1) {
+            _display->writeFastHLine(cx + entry->xOffset + it->x, cy + entry->yOffset + it->y, it->len, color);
+          } else {
+            _display->writeFillRect(cx + (entry->xOffset + it->x) * textSize,
+                                    cy + (entry->yOffset + it->y) * textSize,
+                                    it->len * textSize,
+                                    textSize,
+                                    color);
+          }
+        }
+        _display->endWrite();
+      } else {
+        _display->drawChar(cx, cy, c, color, color, textSize);
+      }
+    }
+    cx += pgm_read_byte(&glyph->xAdvance) * static_cast<int16_t>(textSize);
+  }
+  _display->setCursor(cx, cy);
+}
+
+/****************************************************************************
+ * getGlyph: Get a glyph of the current font from the cache, decode it if not cached yet
+ ***************************************************************************/
+const tGlyphCacheEntry * AdafruitGFX_helper::getGlyph(const uint8_t& c) {
+  for (auto it = _glyphCache.begin(); it != _glyphCache.end(); ++it) {
+    if (it->c == c) {
+      return &(*it);
+    }
+  }
+
+  const GFXglyph *glyph  = _font->glyph + (c - pgm_read_byte(&_font->first));
+  const uint8_t  *bitmap = _font->bitmap;
+  uint16_t bo            = pgm_read_word(&glyph->bitmapOffset);
+  const uint8_t w        = pgm_read_byte(&glyph->width);
+  const uint8_t h        = pgm_read_byte(&glyph->height);
+  uint8_t bits           = 0;
+  uint8_t bit            = 0;
+  tGlyphCacheEntry entry;
+
+  entry.c       = c;
+  entry.xOffset = pgm_read_byte(&glyph->xOffset);
+  entry.yOffset = pgm_read_byte(&glyph->yOffset);
+
+  for (uint8_t yy = 0; yy < h; ++yy) { // Bitmap rows are not padded to a byte boundary
+    tGlyphSpan span;
+    bool inSpan = false;
+    span.y = yy;
+
+    for (uint8_t xx = 0; xx < w; ++xx) {
+      if (!(bit++ & 7)) {
+        bits = pgm_read_byte(&bitmap[bo++]);
+      }
+
+      if (bits & 0x80) {
+        if (!inSpan) {
+          span.x = xx;
+          inSpan = true;
+        }
+      } else if (inSpan) {
+        span.len = xx - span.x;
+        entry.spans.push_back(span);
+        inSpan = false;
+      }
+      bits <<= 1;
+    }
+
+    if (inSpan) {
+      span.len = w - span.x;
+      entry.spans.push_back(span);
+    }
+  }
+
+  if (_glyphCache.size() < ADAGFX_GLYPH_CACHE_SIZE) {
+    _glyphCache.push_back(std::move(entry));
+    return &_glyphCache.back();
+  }
+  const uint8_t idx = _glyphCacheNext;
+
+  _glyphCache[idx] = std::move(entry); // Replace the oldest
+  _glyphCacheNext  = (_glyphCacheNext + 1) % ADAGFX_GLYPH_CACHE_SIZE;
+  return &_glyphCache[idx];
+}
+
+# endif // if ADAGFX_ENABLE_GLYPH_CACHE
+
+/****************************************************************************
+ * fillRect: Fill an area, on ESP32 TFT displays in strips of lines from the line buffer
+ * Transfers a line buffer at once instead of small chunks, and ends the SPI transaction
+ * after each strip so other tasks and SPI devices don't have to wait for the entire area
+ ***************************************************************************/
+void AdafruitGFX_helper::fillRect(int16_t  x,
+                                  int16_t  y,
+                                  int16_t  w,
+                                  int16_t  h,
+                                  uint16_t color) {
+  # if ADAGFX_ENABLE_LINE_BUFFER
+
+  if ((nullptr != _tft) && (nullptr == _lineBuffer)) {
+    _lineBuffer = static_cast<uint16_t *>(buffer_malloc(MemoryBufferClass_e::DisplayBuffer,
+                                                        ADAGFX_LINE_BUFFER_PIXELS * sizeof(uint16_t)));
+  }
+
+  if ((nullptr != _tft) && (nullptr != _lineBuffer)) {
+    if (x < 0) { w += x; x = 0; } // Clip to display
+
+    if (y < 0) { h += y; y = 0; }
+
+    if ((x + w) > _tft->width()) { w = _tft->width() - x; }
+
+    if ((y + h) > _tft->height()) { h = _tft->height() - y; }
+
+    if ((w <= 0) || (h <= 0)) { return; }
+
+    const int16_t  lines  = max(1, ADAGFX_LINE_BUFFER_PIXELS / w);
+    const uint32_t pixels = min(static_cast<uint32_t>(w) * lines, static_cast<uint32_t>(ADAGFX_LINE_BUFFER_PIXELS));
+
+    for (uint32_t i = 0; i < pixels; ++i) {
+      _lineBuffer[i] = color;
+    }
+
+    for (int16_t row = 0; row < h; row += lines) {
+      const int16_t strip     = min(lines, static_cast<int16_t>(h - row));
+      uint32_t      remaining = static_cast<uint32_t>(w) * strip;
+
+      _tft->startWrite();
+      _tft->setAddrWindow(x, y + row, w, strip);
+
+      while (remaining > 0) {
+        const uint32_t count = min(remaining, pixels);
+        _tft->writePixels(_lineBuffer, count, true); // Endian swap is done while sending, buffer is unchanged
+        remaining -= count;
+      }
+      _tft->endWrite();
+      delay(0);
+    }
+    return;
+  }
+  # endif // if ADAGFX_ENABLE_LINE_BUFFER
+  _display->fillRect(x, y, w, h, color);
+}
+
+void AdafruitGFX_helper::fillScreen(uint16_t color) {
+  fillRect(0, 0, _display->width(), _display->height(), color);
 }
 
 /****************************************************************************
@@ -2244,6 +2555,158 @@ uint16_t AdafruitGFX_helper::getTextSize(const String& text,
   return w;
 }
 
+# if ADAGFX_ENABLE_DRAW_CACHE
+
+/****************************************************************************
+ * tDirtyRect: merge an area into the bounding box, and check for overlap
+ ***************************************************************************/
+void tDirtyRect::add(const tDirtyRect& area) {
+  if (area.isEmpty()) { return; }
+
+  if (isEmpty()) {
+    *this = area;
+    return;
+  }
+  const int32_t x2 = max(static_cast<int32_t>(x) + w, static_cast<int32_t>(area.x) + area.w);
+  const int32_t y2 = max(static_cast<int32_t>(y) + h, static_cast<int32_t>(area.y) + area.h);
+
+  x = min(x, area.x);
+  y = min(y, area.y);
+  w = x2 - x;
+  h = y2 - y;
+}
+
+bool tDirtyRect::overlaps(const tDirtyRect& area) const {
+  return !isEmpty() && !area.isEmpty() &&
+         (x < static_cast<int32_t>(area.x) + area.w) && (area.x < static_cast<int32_t>(x) + w) &&
+         (y < static_cast<int32_t>(area.y) + area.h) && (area.y < static_cast<int32_t>(y) + h);
+}
+
+/****************************************************************************
+ * setDrawCache: Enable/disable skipping printText() calls that don't change the display
+ * Only to be enabled if the plugin calls invalidateDrawCache() after drawing directly on the display
+ ***************************************************************************/
+void AdafruitGFX_helper::setDrawCache(bool state) {
+  _drawCache = state;
+  _textCache.clear();
+  _textCacheNext = 0;
+}
+
+/****************************************************************************
+ * invalidateDrawCache: Forget all cached text, and mark the entire display as changed
+ ***************************************************************************/
+void AdafruitGFX_helper::invalidateDrawCache() {
+  tDirtyRect area;
+
+  area.w = _res_x;
+  area.h = _res_y;
+  _textCache.clear();
+  _textCacheNext = 0;
+  markDirty(area);
+}
+
+/****************************************************************************
+ * invalidateArea: Drop cached text that overlaps the area, and mark the area as changed
+ ***************************************************************************/
+void AdafruitGFX_helper::invalidateArea(const tDirtyRect& area) {
+  if (area.isEmpty()) { return; }
+
+  for (auto it = _textCache.begin(); it != _textCache.end();) {
+    if (it->area.overlaps(area)) {
+      it = _textCache.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  if (_textCacheNext >= _textCache.size()) {
+    _textCacheNext = 0;
+  }
+  markDirty(area);
+}
+
+/****************************************************************************
+ * invalidateWindow: Invalidate the current window, or the entire display
+ ***************************************************************************/
+void AdafruitGFX_helper::invalidateWindow() {
+  tDirtyRect area;
+  uint16_t   xOffset = 0;
+  uint16_t   yOffset = 0;
+
+  area.w = _res_x;
+  area.h = _res_y;
+  #  if ADAGFX_ENABLE_FRAMED_WINDOW
+  getWindowOffsets(xOffset, yOffset);
+  getWindowLimits(area.w, area.h);
+  #  endif // if ADAGFX_ENABLE_FRAMED_WINDOW
+  area.x = xOffset;
+  area.y = yOffset;
+  invalidateArea(area);
+}
+
+/****************************************************************************
+ * markDirty: Add the area to the changed area of the display and of the windows it overlaps
+ ***************************************************************************/
+void AdafruitGFX_helper::markDirty(const tDirtyRect& area) {
+  _dirty.add(area);
+  #  if ADAGFX_ENABLE_FRAMED_WINDOW
+
+  for (auto it = _windows.begin(); it != _windows.end(); ++it) {
+    tDirtyRect win;
+    win.x = it->top_left.x;
+    win.y = it->top_left.y;
+    win.w = it->width_height.x;
+    win.h = it->width_height.y;
+
+    if (win.overlaps(area)) { // Only the part within the window
+      const int32_t x2 = min(static_cast<int32_t>(win.x) + win.w, static_cast<int32_t>(area.x) + area.w);
+      const int32_t y2 = min(static_cast<int32_t>(win.y) + win.h, static_cast<int32_t>(area.y) + area.h);
+      win.x = max(win.x, area.x);
+      win.y = max(win.y, area.y);
+      win.w = x2 - win.x;
+      win.h = y2 - win.y;
+      it->dirty.add(win);
+    }
+  }
+  #  endif // if ADAGFX_ENABLE_FRAMED_WINDOW
+}
+
+/****************************************************************************
+ * getDirtyRect: Get the changed area of the display (windowId -1) or of a window, false if nothing changed
+ ***************************************************************************/
+bool AdafruitGFX_helper::getDirtyRect(tDirtyRect  & rect,
+                                      const int16_t windowId) {
+  rect = _dirty;
+  #  if ADAGFX_ENABLE_FRAMED_WINDOW
+
+  if (windowId >= 0) {
+    const int16_t idx = getWindowIndex(windowId);
+
+    if (idx < 0) {
+      rect.clear();
+    } else {
+      rect = _windows[idx].dirty;
+    }
+  }
+  #  endif // if ADAGFX_ENABLE_FRAMED_WINDOW
+  return !rect.isEmpty();
+}
+
+/****************************************************************************
+ * clearDirty: Reset the changed areas, after the display has been updated
+ ***************************************************************************/
+void AdafruitGFX_helper::clearDirty() {
+  _dirty.clear();
+  #  if ADAGFX_ENABLE_FRAMED_WINDOW
+
+  for (auto it = _windows.begin(); it != _windows.end(); ++it) {
+    it->dirty.clear();
+  }
+  #  endif // if ADAGFX_ENABLE_FRAMED_WINDOW
+}
+
+# endif // if ADAGFX_ENABLE_DRAW_CACHE
+
 /****************************************************************************
  * color565: convert r, g, b colors to rgb565 (by bit-shifting)
  ***************************************************************************/
@@ -2842,6 +3305,10 @@ void AdafruitGFX_helper::setRotation(uint8_t m) {
   // logWindows(F("rot ")); // For debugging only
   # endif // if ADAGFX_ENABLE_FRAMED_WINDOW
   calculateTextMetrics(_fontwidth, _fontheight, _heightOffset, _isProportional);
+  # if ADAGFX_ENABLE_DRAW_CACHE
+  clearDirty();          // Tracked areas are in the previous orientation
+  invalidateDrawCache();
+  # endif // if ADAGFX_ENABLE_DRAW_CACHE
 }
 
 # if ADAGFX_ENABLE_BMP_DISPLAY
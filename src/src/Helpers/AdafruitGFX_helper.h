@@ -12,6 +12,9 @@
  ***************************************************************************/
 /************
  * Changelog:
+ * 2026-10-15 tonhuisman: Add glyph span cache for digits and numeric symbols of custom fonts, cache single character text bounds
+ * 2026-10-15 tonhuisman: Add line-strip buffered fillRect/fillScreen for TFT displays on ESP32, yielding between strips
+ * 2026-10-15 tonhuisman: Add optional draw cache to skip redrawing unchanged text, and track the changed (dirty) display area
  * 2023-02-26 tonhuisman: Use GetCommandCode() / PROGMEM for parsing of commands and colors to reduce .bin size.
  * 2022-10-05 tonhuisman: No longer trim off spaces from arguments to commands
  * 2022-09-23 tonhuisman: Allow backlight percentage from 0% instead of from 1% to be able to completely turn it off
@@ -41,6 +44,7 @@
 
 # include "../Helpers/Numerical.h"
 # include "../Helpers/ESPEasy_Storage.h"
+# include "../Helpers/Memory.h"
 # include "../ESPEasyCore/ESPEasy_Log.h"
 
 
@@ -88,6 +92,24 @@
 # ifndef ADAGFX_ENABLE_GET_CONFIG_VALUE
 #  define ADAGFX_ENABLE_GET_CONFIG_VALUE  1 // Enable getting values features
 # endif // ifndef ADAGFX_ENABLE_GET_CONFIG_VALUE
+# ifndef ADAGFX_ENABLE_DRAW_CACHE
+#  define ADAGFX_ENABLE_DRAW_CACHE    1     // Enable skipping unchanged text redraws and dirty area tracking
+# endif // ifndef ADAGFX_ENABLE_DRAW_CACHE
+# ifndef ADAGFX_DRAW_CACHE_SIZE
+#  define ADAGFX_DRAW_CACHE_SIZE      16    // Max. nr of text positions remembered by the draw cache
+# endif // ifndef ADAGFX_DRAW_CACHE_SIZE
+# ifndef ADAGFX_ENABLE_GLYPH_CACHE
+#  define ADAGFX_ENABLE_GLYPH_CACHE   1     // Draw digits and numeric symbols of custom fonts from decoded pixel spans
+# endif // ifndef ADAGFX_ENABLE_GLYPH_CACHE
+# ifndef ADAGFX_GLYPH_CACHE_SIZE
+#  define ADAGFX_GLYPH_CACHE_SIZE     16    // Max. nr of glyphs in the glyph cache
+# endif // ifndef ADAGFX_GLYPH_CACHE_SIZE
+# if !defined(ADAGFX_ENABLE_LINE_BUFFER) && defined(ESP32)
+#  define ADAGFX_ENABLE_LINE_BUFFER   1     // Fill areas on TFT displays in line strips from a buffer
+# endif // if !defined(ADAGFX_ENABLE_LINE_BUFFER) && defined(ESP32)
+# ifndef ADAGFX_LINE_BUFFER_PIXELS
+#  define ADAGFX_LINE_BUFFER_PIXELS   320   // Size of the line buffer, 1 line of a 320 pixel wide display
+# endif // ifndef ADAGFX_LINE_BUFFER_PIXELS
 
 // # define ADAGFX_FONTS_EXTRA_8PT_INCLUDED  // 8 extra 8pt fonts, should probably only be enabled in a private custom build, adds ~15.4 kB
 // # define ADAGFX_FONTS_EXTRA_12PT_INCLUDED // 9 extra 12pt fonts, should probably only be enabled in a private custom build, adds ~28 kB
@@ -145,6 +167,12 @@
 #  ifdef ADAGFX_SUPPORT_8and16COLOR
 #   undef ADAGFX_SUPPORT_8and16COLOR
 #  endif // ifdef ADAGFX_SUPPORT_8and16COLOR
+#  ifdef ADAGFX_ENABLE_DRAW_CACHE
+#   undef ADAGFX_ENABLE_DRAW_CACHE
+#  endif // ifdef ADAGFX_ENABLE_DRAW_CACHE
+#  ifdef ADAGFX_ENABLE_GLYPH_CACHE
+#   undef ADAGFX_ENABLE_GLYPH_CACHE
+#  endif // ifdef ADAGFX_ENABLE_GLYPH_CACHE
 // #  ifdef ADAGFX_ENABLE_BMP_DISPLAY
 // #   undef ADAGFX_ENABLE_BMP_DISPLAY
 // #  endif // ifdef ADAGFX_ENABLE_BMP_DISPLAY
@@ -311,6 +339,60 @@ const __FlashStringHelper* toString(const Button_layout_e layout);
 
 # endif // if ADAGFX_ENABLE_BUTTON_DRAW
 
+# if ADAGFX_ENABLE_DRAW_CACHE
+
+// Rectangle in display coordinates, merging areas results in the bounding box of both
+struct tDirtyRect {
+  bool isEmpty() const {
+    return (0 == w) || (0 == h);
+  }
+
+  void clear() {
+    x = 0; y = 0; w = 0; h = 0;
+  }
+
+  void add(const tDirtyRect& area);
+  bool overlaps(const tDirtyRect& area) const;
+
+  int16_t  x = 0;
+  int16_t  y = 0;
+  uint16_t w = 0;
+  uint16_t h = 0;
+};
+
+// Text last printed at a position, with the attributes used
+struct tTextCacheEntry {
+  tDirtyRect area;         // Pixels covered by the print
+  uint32_t   textCRC  = 0;
+  int16_t    x        = 0; // Print position, display coordinates
+  int16_t    y        = 0;
+  int16_t    cursorX  = 0; // Cursor position after printing
+  int16_t    cursorY  = 0;
+  uint16_t   color    = 0;
+  uint16_t   bkcolor  = 0;
+  uint16_t   maxWidth = 0;
+  uint8_t    textSize = 0;
+};
+# endif // if ADAGFX_ENABLE_DRAW_CACHE
+
+# if ADAGFX_ENABLE_GLYPH_CACHE
+
+// Horizontal run of set pixels in a glyph bitmap
+struct tGlyphSpan {
+  uint8_t x   = 0;
+  uint8_t y   = 0;
+  uint8_t len = 0;
+};
+
+// Glyph of the current font, decoded into spans
+struct tGlyphCacheEntry {
+  std::vector<tGlyphSpan>spans;
+  int8_t  xOffset = 0;
+  int8_t  yOffset = 0;
+  uint8_t c       = 0;
+};
+# endif // if ADAGFX_ENABLE_GLYPH_CACHE
+
 # if ADAGFX_ENABLE_FRAMED_WINDOW
 
 struct tWindowPoint {
@@ -324,6 +406,9 @@ struct tWindowObject {
   tWindowPoint org_width_height;
   uint8_t      id       = 0u;
   int8_t       rotation = 0;
+  #  if ADAGFX_ENABLE_DRAW_CACHE
+  tDirtyRect dirty; // Changed area within this window
+  #  endif // if ADAGFX_ENABLE_DRAW_CACHE
 };
 # endif // if ADAGFX_ENABLE_FRAMED_WINDOW
 
@@ -409,7 +494,11 @@ public:
                      const bool                 useValidation = true,
                      const bool                 textBackFill  = false);
   # endif // if ADAGFX_ENABLE_BMP_DISPLAY
-  virtual ~AdafruitGFX_helper() {}
+  virtual ~AdafruitGFX_helper() {
+    # if ADAGFX_ENABLE_LINE_BUFFER
+    buffer_free(MemoryBufferClass_e::DisplayBuffer, _lineBuffer, ADAGFX_LINE_BUFFER_PIXELS * sizeof(uint16_t));
+    # endif // if ADAGFX_ENABLE_LINE_BUFFER
+  }
 
   String getFeatures();
 
@@ -499,6 +588,25 @@ public:
   void invertDisplay(bool i);
   void initialize();
 
+  void fillRect(int16_t  x,          // Same as the display object fillRect(), but uses the line buffer when available
+                int16_t  y,
+                int16_t  w,
+                int16_t  h,
+                uint16_t color);
+  void fillScreen(uint16_t color);
+
+  # if ADAGFX_ENABLE_DRAW_CACHE
+  void setDrawCache(bool state);  // Skip printText() calls that would draw the same text again, default off
+  void invalidateDrawCache();     // Use after drawing directly on the display object, forgets cached text and marks all dirty
+  bool isDirty() const {
+    return !_dirty.isEmpty();
+  }
+
+  bool getDirtyRect(tDirtyRect  & rect,              // Area changed since the last clearDirty(), of the display or a window
+                    const int16_t windowId = -1);
+  void clearDirty();
+  # endif // if ADAGFX_ENABLE_DRAW_CACHE
+
 private:
 
   # if ADAGFX_ARGUMENT_VALIDATION
@@ -561,6 +669,31 @@ private:
   uint8_t _window      = 0; // current window
   uint8_t _windowIndex = 0; // current window Index
   # endif // if ADAGFX_ENABLE_FRAMED_WINDOW
+  void setFont(const GFXfont *font = nullptr); // Set font on the display, and reset cached font data
+  uint8_t  _charBoundsSize = 0;                // Text size of the cached single character bounds, 0 = not cached
+  uint16_t _charWidth      = 0;
+  uint16_t _charHeight     = 0;
+  # if ADAGFX_ENABLE_GLYPH_CACHE
+  void                    printString(const String & text, // Print using the glyph cache, custom fonts only
+                                      const uint8_t& textSize,
+                                      const uint16_t& color);
+  const tGlyphCacheEntry* getGlyph(const uint8_t & c);
+  const GFXfont *_font = nullptr;
+  std::vector<tGlyphCacheEntry>_glyphCache;
+  uint8_t _glyphCacheNext = 0;
+  # endif // if ADAGFX_ENABLE_GLYPH_CACHE
+  # if ADAGFX_ENABLE_LINE_BUFFER
+  uint16_t *_lineBuffer = nullptr;
+  # endif // if ADAGFX_ENABLE_LINE_BUFFER
+  # if ADAGFX_ENABLE_DRAW_CACHE
+  void markDirty(const tDirtyRect& area);
+  void invalidateArea(const tDirtyRect& area); // Drop cached text overlapping area, mark it dirty
+  void invalidateWindow();                     // Current window, or entire display
+  std::vector<tTextCacheEntry>_textCache;
+  tDirtyRect _dirty;
+  uint8_t _textCacheNext = 0;
+  bool _drawCache        = false;
+  # endif // if ADAGFX_ENABLE_DRAW_CACHE
 };
 #endif // ifdef PLUGIN_USES_ADAFRUITGFX
 
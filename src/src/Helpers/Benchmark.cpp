@@ -0,0 +1,545 @@
+#include "../Helpers/Benchmark.h"
+
+#if FEATURE_BENCHMARK
+
+# include "../DataStructs/Web_StreamingBuffer.h"
+# include "../ESPEasyCore/ESPEasyRules.h"
+# include "../Globals/Cache.h"
+# include "../Globals/RulesCalculate.h"
+# include "../Globals/Settings.h"
+# include "../Helpers/ESPEasy_Storage.h"
+# include "../Helpers/ESPEasy_time_calc.h"
+# include "../Helpers/Hardware.h"
+# include "../Helpers/I2C_access.h"
+# include "../Helpers/Memory.h"
+# include "../Helpers/RulesMatcher.h"
+# include "../Helpers/StringConverter.h"
+# include "../Helpers/StringParser.h"
+# include "../Helpers/StringProvider.h"
+
+# include "../../_Plugin_Helper.h"
+
+// Nr of iterations timed in one go, background tasks are run in between and are not included in the timing.
+# define BENCHMARK_BATCH_SIZE         16
+
+// Each file system iteration writes to flash, which is limited by the flash guard
+# define BENCHMARK_FS_MAX_ITERATIONS  10
+# define BENCHMARK_FS_DATA_SIZE       4096
+# define BENCHMARK_FS_FILENAME        "/bench.tmp"
+
+template<typename Step>
+static uint64_t Benchmark_measure(uint32_t iterations, Step step)
+{
+  uint64_t duration_usec = 0;
+
+  for (uint32_t i = 0; i < iterations;) {
+    const uint32_t batchEnd = (iterations - i > BENCHMARK_BATCH_SIZE) ? i + BENCHMARK_BATCH_SIZE : iterations;
+    const uint64_t start    = getMicros64();
+
+    for (; i < batchEnd; ++i) {
+      step(i);
+    }
+    duration_usec += usecPassedSince(start);
+    delay(0);
+  }
+  return duration_usec;
+}
+
+static void Benchmark_addResult(String       & result,
+                                const String & name,
+                                uint32_t       iterations,
+                                uint64_t       duration_usec,
+                                const String & extra = EMPTY_STRING)
+{
+  if (!result.isEmpty()) {
+    result += ',';
+  }
+  result += '{';
+  result += to_json_object_value(F("name"), name, true);
+  result += ',';
+  result += to_json_object_value(F("iterations"), String(iterations));
+  result += ',';
+  result += to_json_object_value(F("total_usec"), ull2String(duration_usec));
+  result += ',';
+  result += to_json_object_value(F("avg_usec"), toString(iterations == 0 ? 0.0f : static_cast<float>(duration_usec) / iterations, 2));
+  result += ',';
+  result += to_json_object_value(F("per_sec"), toString(duration_usec == 0 ? 0.0f : (iterations * 1000000.0f) / duration_usec, 1));
+
+  if (!extra.isEmpty()) {
+    result += ',';
+    result += extra;
+  }
+  result += '}';
+}
+
+static String Benchmark_bytesPerSec(uint64_t bytes, uint64_t duration_usec)
+{
+  return to_json_object_value(F("bytes_per_sec"),
+                              toString(duration_usec == 0 ? 0.0f : (bytes * 1000000.0f) / duration_usec, 0));
+}
+
+/*********************************************************************************************\
+* Suites
+\*********************************************************************************************/
+static void Benchmark_rules(uint32_t iterations, String& result)
+{
+  // Synthetic rule set, matched against events which do and do not match.
+  const __FlashStringHelper *rules[] = {
+    F("System#Boot"),
+    F("Clock#Time=All,12:00"),
+    F("Switch#State=1"),
+    F("Sensor#Temperature>20"),
+    F("Sensor#Humidity<=60"),
+    F("Rules#Timer=1"),
+    F("MQTT#Connected"),
+    F("Dummy#*")
+  };
+  const __FlashStringHelper *events[] = {
+    F("Sensor#Temperature=21.5"),
+    F("Sensor#Humidity=55"),
+    F("Switch#State=0"),
+    F("Rules#Timer=2"),
+    F("Dummy#Value=3")
+  };
+  constexpr uint32_t nrRules  = sizeof(rules) / sizeof(rules[0]);
+  constexpr uint32_t nrEvents = sizeof(events) / sizeof(events[0]);
+  uint32_t nrMatches          = 0;
+
+  const uint64_t duration_usec = Benchmark_measure(iterations, [&](uint32_t i) {
+    const String event(events[i % nrEvents]);
+
+    for (uint32_t r = 0; r < nrRules; ++r) {
+      if (ruleMatch(event, String(rules[r]))) {
+        ++nrMatches;
+      }
+    }
+  });
+
+  Benchmark_addResult(result, F("rules"), iterations, duration_usec,
+                      to_json_object_value(F("rules_per_event"), String(nrRules)));
+}
+
+// Read a file with one event per line, lines starting with '//' are ignored.
+static bool Benchmark_readEvents(const String& fileName, std::vector<String>& events)
+{
+  fs::File f = tryOpenFile(fileName, F("r"));
+
+  if (!f) {
+    return false;
+  }
+
+  while (f.available()) {
+    String line = f.readStringUntil('\n');
+    line.trim();
+
+    if (!line.isEmpty() && !line.startsWith(F("//"))) {
+      events.emplace_back(std::move(line));
+    }
+  }
+  f.close();
+  return true;
+}
+
+static void Benchmark_events(uint32_t iterations, const String& eventFile, String& result)
+{
+  // Each iteration is one pass over the event stream, processed by the full rules engine.
+  // Heap use is sampled after each event, the ESP heap API does not count allocations.
+  std::vector<String> events;
+  String error;
+
+  if (!Settings.UseRules) {
+    error = F("Rules not enabled");
+  } else if (eventFile.isEmpty()) {
+    const __FlashStringHelper *defaultEvents[] = {
+      F("Test=9"),
+      F("Test=10"),
+      F("GPIO#2=1"),
+      F("GPIO#2=0"),
+      F("Rules#Timer=2"),
+      F("Test=12")
+    };
+
+    for (size_t i = 0; i < sizeof(defaultEvents) / sizeof(defaultEvents[0]); ++i) {
+      events.emplace_back(defaultEvents[i]);
+    }
+  } else if (!Benchmark_readEvents(eventFile, events)) {
+    error = concat(F("Cannot open: "), eventFile);
+  } else if (events.empty()) {
+    error = F("No events");
+  }
+
+  if (!error.isEmpty()) {
+    if (!result.isEmpty()) {
+      result += ',';
+    }
+    result += '{';
+    result += to_json_object_value(F("name"), F("events"), true);
+    result += ',';
+    result += to_json_object_value(F("error"), error, true);
+    result += '}';
+    return;
+  }
+
+  // Make sure the replayed events are not mixed with events already queued.
+  while (processNextEvent()) {}
+
+  const uint32_t freeMemStart = FreeMem();
+  uint32_t freeMemMin         = freeMemStart;
+  uint32_t nrEvents           = 0;
+
+  const uint64_t duration_usec = Benchmark_measure(iterations * events.size(), [&](uint32_t i) {
+    rulesProcessing(events[i % events.size()]);
+    ++nrEvents;
+
+    // Also process events added by the rules (e.g. asyncevent)
+    while (processNextEvent()) {
+      ++nrEvents;
+    }
+    const uint32_t freeMem = FreeMem();
+
+    if (freeMem < freeMemMin) {
+      freeMemMin = freeMem;
+    }
+  });
+
+  String extra = to_json_object_value(F("passes"), String(iterations));
+
+  extra += ',';
+  extra += to_json_object_value(F("peak_heap_use"), String(freeMemStart - freeMemMin));
+  extra += ',';
+  extra += to_json_object_value(F("heap_delta"), String(static_cast<int32_t>(FreeMem()) - static_cast<int32_t>(freeMemStart)));
+
+  // Report per processed event, including events queued by the rules
+  Benchmark_addResult(result, F("events"), nrEvents, duration_usec, extra);
+}
+
+static void Benchmark_calc(uint32_t iterations, String& result)
+{
+  const __FlashStringHelper *expressions[] = {
+    F("1+2*3-4/5"),
+    F("(10.5/3)^2"),
+    F("sqrt(2)*abs(-3)"),
+    F("((21.5-32)*5/9)%7")
+  };
+  constexpr uint32_t nrExpressions = sizeof(expressions) / sizeof(expressions[0]);
+  uint32_t nrErrors                = 0;
+
+  const uint64_t duration_usec = Benchmark_measure(iterations, [&](uint32_t i) {
+    ESPEASY_RULES_FLOAT_TYPE value{};
+
+    if (Calculate(String(expressions[i % nrExpressions]), value) != CalculateReturnCode::OK) {
+      ++nrErrors;
+    }
+  });
+
+  Benchmark_addResult(result, F("calc"), iterations, duration_usec,
+                      to_json_object_value(F("errors"), String(nrErrors)));
+}
+
+static void Benchmark_template(uint32_t iterations, String& result)
+{
+  const uint64_t duration_usec = Benchmark_measure(iterations, [](uint32_t) {
+    String tmpl(F("%sysname% %uptime% %sysheap% %systime%"));
+
+    parseTemplate(tmpl);
+  });
+
+  Benchmark_addResult(result, F("template"), iterations, duration_usec);
+}
+
+static void Benchmark_uservar(uint32_t iterations, String& result)
+{
+  const std::vector<taskIndex_t>& tasks = Cache.getEnabledTasks();
+  uint32_t nrValues                     = 0;
+
+  for (auto it = tasks.begin(); it != tasks.end(); ++it) {
+    nrValues += getValueCountForTask(*it);
+  }
+
+  // Each iteration formats all values of all enabled tasks
+  const uint64_t duration_usec = Benchmark_measure(iterations, [&](uint32_t) {
+    for (auto it = tasks.begin(); it != tasks.end(); ++it) {
+      const int valueCount = getValueCountForTask(*it);
+
+      for (int v = 0; v < valueCount; ++v) {
+        formatUserVarNoCheck(*it, v);
+      }
+    }
+  });
+
+  Benchmark_addResult(result, F("uservar"), iterations, duration_usec,
+                      to_json_object_value(F("values"), String(nrValues)));
+}
+
+static void Benchmark_fs(uint32_t iterations, String& result)
+{
+  if (iterations > BENCHMARK_FS_MAX_ITERATIONS) {
+    iterations = BENCHMARK_FS_MAX_ITERATIONS;
+  }
+
+  // Must be allocated on the heap, see doSaveToFile()
+  std::vector<uint8_t> data(BENCHMARK_FS_DATA_SIZE);
+
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = i & 0xFF;
+  }
+  String error = SaveToFile_trunc(BENCHMARK_FS_FILENAME, 0, &data[0], data.size());
+
+  uint64_t write_usec = 0;
+  uint64_t read_usec  = 0;
+
+  for (uint32_t i = 0; i < iterations && error.isEmpty(); ++i) {
+    uint64_t start = getMicros64();
+    error      = SaveToFile(BENCHMARK_FS_FILENAME, 0, &data[0], data.size());
+    write_usec += usecPassedSince(start);
+
+    if (error.isEmpty()) {
+      start     = getMicros64();
+      error     = LoadFromFile(BENCHMARK_FS_FILENAME, 0, &data[0], data.size());
+      read_usec += usecPassedSince(start);
+    }
+    delay(0);
+  }
+  tryDeleteFile(F(BENCHMARK_FS_FILENAME));
+
+  if (!error.isEmpty()) {
+    if (!result.isEmpty()) {
+      result += ',';
+    }
+    result += '{';
+    result += to_json_object_value(F("name"), F("fs"), true);
+    result += ',';
+    result += to_json_object_value(F("error"), error, true);
+    result += '}';
+    return;
+  }
+  const uint64_t bytes = static_cast<uint64_t>(iterations) * BENCHMARK_FS_DATA_SIZE;
+
+  Benchmark_addResult(result, F("fs_write"), iterations, write_usec, Benchmark_bytesPerSec(bytes, write_usec));
+  Benchmark_addResult(result, F("fs_read"),  iterations, read_usec,  Benchmark_bytesPerSec(bytes, read_usec));
+}
+
+// Return the first address which acknowledges on the currently selected bus, or -1 when none found.
+static int Benchmark_findI2Cdevice()
+{
+  for (uint8_t address = 0x08; address < 0x78; ++address) {
+    if (I2C_wakeup(address) == 0) {
+      return address;
+    }
+  }
+  return -1;
+}
+
+static void Benchmark_i2cBus(uint32_t iterations, int i2cAddress, int8_t channel, String& result)
+{
+  const int address = (i2cAddress < 0) ? Benchmark_findI2Cdevice() : i2cAddress;
+
+  if (address < 0) {
+    return;
+  }
+  uint32_t nrErrors = 0;
+
+  const uint64_t duration_usec = Benchmark_measure(iterations, [&](uint32_t) {
+    if (I2C_wakeup(address) != 0) {
+      ++nrErrors;
+    }
+  });
+
+  String extra = to_json_object_value(F("channel"), String(channel));
+
+  extra += ',';
+  extra += to_json_object_value(F("address"), formatToHex(address, 2), true);
+  extra += ',';
+  extra += to_json_object_value(F("errors"), String(nrErrors));
+  Benchmark_addResult(result, F("i2c"), iterations, duration_usec, extra);
+}
+
+static void Benchmark_i2c(uint32_t iterations, int i2cAddress, String& result)
+{
+  if (!Settings.isI2CEnabled()) {
+    return;
+  }
+
+  // Round trip on the standard bus (channel -1) and on each multiplexer channel
+  # if FEATURE_I2CMULTIPLEXER
+
+  if (isI2CMultiplexerEnabled()) {
+    I2CMultiplexerOff();
+  }
+  # endif // if FEATURE_I2CMULTIPLEXER
+  Benchmark_i2cBus(iterations, i2cAddress, -1, result);
+
+  # if FEATURE_I2CMULTIPLEXER
+
+  if (isI2CMultiplexerEnabled()) {
+    const uint8_t nrChannels = I2CMultiplexerMaxChannels();
+
+    for (uint8_t channel = 0; channel < nrChannels; ++channel) {
+      I2CMultiplexerSelect(channel);
+      Benchmark_i2cBus(iterations, i2cAddress, channel, result);
+    }
+    I2CMultiplexerOff();
+  }
+  # endif // if FEATURE_I2CMULTIPLEXER
+}
+
+static void Benchmark_heap(uint32_t iterations, String& result)
+{
+  const size_t sizes[] = { 32, 256, 2048 };
+
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+    const size_t size     = sizes[s];
+    uint32_t     nrFailed = 0;
+
+    const uint64_t duration_usec = Benchmark_measure(iterations, [&](uint32_t) {
+      void *ptr = malloc(size);
+
+      if (ptr == nullptr) {
+        ++nrFailed;
+      } else {
+        // Make sure the allocation is not optimized away
+        *static_cast<volatile uint8_t *>(ptr) = 0;
+        free(ptr);
+      }
+    });
+
+    String extra = to_json_object_value(F("size"), String(size));
+    extra += ',';
+    extra += to_json_object_value(F("failed"), String(nrFailed));
+    Benchmark_addResult(result, F("heap"), iterations, duration_usec, extra);
+  }
+}
+
+static void Benchmark_webbuffer(uint32_t iterations, String& result)
+{
+  Web_StreamingBuffer buffer;
+
+  buffer.startDiscardStream();
+
+  // Typical mix of flash strings, RAM strings and numbers as used when rendering a page
+  const String label(F("Sensor value"));
+
+  const uint64_t duration_usec = Benchmark_measure(iterations, [&](uint32_t i) {
+    buffer += F("<TR><TD>");
+    buffer += label;
+    buffer += F(":<TD>");
+    buffer += static_cast<int>(i);
+    buffer += F("</TD></TR>\n");
+  });
+
+  // Only count the time needed to flush the remaining buffered data
+  const uint64_t start = getMicros64();
+
+  buffer.flush();
+  const uint64_t flush_usec = usecPassedSince(start);
+
+  Benchmark_addResult(result, F("webbuffer"), iterations, duration_usec + flush_usec,
+                      Benchmark_bytesPerSec(buffer.sentBytes, duration_usec + flush_usec));
+}
+
+/*********************************************************************************************\
+* Run
+\*********************************************************************************************/
+const char Benchmark_suites[] PROGMEM = "rules|calc|template|uservar|fs|i2c|heap|webbuffer|events";
+enum class Benchmark_suite_e : uint8_t {
+  rules,
+  calc,
+  template_,
+  uservar,
+  fs,
+  i2c,
+  heap,
+  webbuffer,
+
+  // Not run by "all"
+  events,
+
+  NR_SUITES
+};
+
+const __FlashStringHelper* Benchmark_getSuites()
+{
+  return F("rules,calc,template,uservar,fs,i2c,heap,webbuffer,events,all");
+}
+
+// Default nr of iterations, the fs suite is kept short to limit flash wear
+static uint32_t Benchmark_defaultIterations(Benchmark_suite_e suite)
+{
+  switch (suite) {
+    case Benchmark_suite_e::rules:     return 100;
+    case Benchmark_suite_e::calc:      return 500;
+    case Benchmark_suite_e::template_: return 100;
+    case Benchmark_suite_e::uservar:   return 100;
+    case Benchmark_suite_e::fs:        return 2;
+    case Benchmark_suite_e::i2c:       return 100;
+    case Benchmark_suite_e::heap:      return 1000;
+    case Benchmark_suite_e::webbuffer: return 2000;
+    case Benchmark_suite_e::events:    return 1;
+    case Benchmark_suite_e::NR_SUITES: break;
+  }
+  return 1;
+}
+
+static void Benchmark_runSuite(Benchmark_suite_e suite, uint32_t iterations, int i2cAddress, const String& eventFile, String& result)
+{
+  if (iterations == 0) {
+    iterations = Benchmark_defaultIterations(suite);
+  }
+
+  switch (suite) {
+    case Benchmark_suite_e::rules:     Benchmark_rules(iterations, result); break;
+    case Benchmark_suite_e::calc:      Benchmark_calc(iterations, result); break;
+    case Benchmark_suite_e::template_: Benchmark_template(iterations, result); break;
+    case Benchmark_suite_e::uservar:   Benchmark_uservar(iterations, result); break;
+    case Benchmark_suite_e::fs:        Benchmark_fs(iterations, result); break;
+    case Benchmark_suite_e::i2c:       Benchmark_i2c(iterations, i2cAddress, result); break;
+    case Benchmark_suite_e::heap:      Benchmark_heap(iterations, result); break;
+    case Benchmark_suite_e::webbuffer: Benchmark_webbuffer(iterations, result); break;
+    case Benchmark_suite_e::events:    Benchmark_events(iterations, eventFile, result); break;
+    case Benchmark_suite_e::NR_SUITES: break;
+  }
+}
+
+bool Benchmark_run(const String& suite,
+                   uint32_t      iterations,
+                   int           i2cAddress,
+                   const String& eventFile,
+                   String      & result)
+{
+  String suite_lower = suite;
+
+  suite_lower.toLowerCase();
+  const bool runAll = equals(suite_lower, F("all"));
+  char tmp[12]{};
+  const int  suiteIndex = runAll ? -1 : GetCommandCode(tmp, sizeof(tmp), suite_lower.c_str(), Benchmark_suites);
+
+  String results;
+
+  if (runAll) {
+    for (uint8_t i = 0; i < static_cast<uint8_t>(Benchmark_suite_e::events); ++i) {
+      Benchmark_runSuite(static_cast<Benchmark_suite_e>(i), iterations, i2cAddress, eventFile, results);
+    }
+  } else {
+    if ((suiteIndex < 0) || (suiteIndex >= static_cast<int>(Benchmark_suite_e::NR_SUITES))) {
+      return false;
+    }
+    Benchmark_runSuite(static_cast<Benchmark_suite_e>(suiteIndex), iterations, i2cAddress, eventFile, results);
+  }
+
+  result  = '{';
+  result += to_json_object_value(F("build"), getValue(LabelType::BINARY_FILENAME), true);
+  result += ',';
+  result += to_json_object_value(F("git_build"), getValue(LabelType::GIT_BUILD), true);
+  result += ',';
+  result += to_json_object_value(F("chip"), getValue(LabelType::ESP_CHIP_MODEL), true);
+  result += ',';
+  result += to_json_object_value(F("cpu_mhz"), getValue(LabelType::ESP_CHIP_FREQ));
+  result += ',';
+  result += to_json_object_value(F("free_heap"), String(FreeMem()));
+  result += F(",\"results\":[");
+  result += results;
+  result += F("]}");
+  return true;
+}
+
+#endif // if FEATURE_BENCHMARK
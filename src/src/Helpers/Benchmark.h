@@ -0,0 +1,35 @@
+#ifndef HELPERS_BENCHMARK_H
+#define HELPERS_BENCHMARK_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_BENCHMARK
+
+/*********************************************************************************************\
+* On-device micro benchmarks
+* Each suite runs a fixed workload, so results can be compared between boards and builds.
+* Suites: rules, calc, template, uservar, fs, i2c, heap, webbuffer, all
+* The events suite replays an event stream against the active rules and is not part of "all",
+* as the rules may act on the events.
+*
+* The loop is blocked while running, but background tasks are run between iterations.
+\*********************************************************************************************/
+
+// Run a suite, or all suites when suite is "all".
+// @param iterations   Nr of iterations, 0 = default of the suite
+// @param i2cAddress   Address of the device to use for the I2C round trip, -1 = first device found
+// @param eventFile    File with one event per line for the events suite, empty = built-in event stream
+// @param result       JSON with the results
+// @retval false when the suite is unknown
+bool Benchmark_run(const String& suite,
+                   uint32_t      iterations,
+                   int           i2cAddress,
+                   const String& eventFile,
+                   String      & result);
+
+// Comma separated list of all suites
+const __FlashStringHelper* Benchmark_getSuites();
+
+#endif // if FEATURE_BENCHMARK
+
+#endif // ifndef HELPERS_BENCHMARK_H
@@ -0,0 +1,162 @@
+#include "../Helpers/BootProfiler.h"
+
+#if FEATURE_BOOT_PROFILER
+
+# include "../ESPEasyCore/ESPEasy_Log.h"
+# include "../Globals/CPlugins.h"
+# include "../Globals/Plugins.h"
+# include "../Helpers/ESPEasy_time_calc.h"
+# include "../Helpers/StringConverter.h"
+
+# define BOOT_PROFILE_MARKER   0xB0075EED
+
+struct BootProfile_t {
+  uint32_t phase_usec[static_cast<uint8_t>(BootPhase_e::NR_ELEMENTS)];
+  uint32_t setupDone_usec;
+  uint32_t marker;
+  uint8_t  lastPhaseDone;
+  bool     finished;
+};
+
+# ifdef ESP32
+RTC_NOINIT_ATTR BootProfile_t bootProfile;
+# else // ifdef ESP32
+static BootProfile_t bootProfile;
+# endif // ifdef ESP32
+
+static uint64_t bootProfiler_lastMark               = 0;
+static uint32_t bootProfiler_firstSample            = 0;
+static uint8_t  bootProfiler_prevStoppedAt          = static_cast<uint8_t>(BootPhase_e::NR_ELEMENTS);
+static uint32_t taskInit_usec[TASKS_MAX]            = { 0 };
+static uint32_t controllerInit_usec[CONTROLLER_MAX] = { 0 };
+
+
+const __FlashStringHelper* BootPhase_toString(BootPhase_e phase)
+{
+  switch (phase) {
+    case BootPhase_e::Core:           return F("Core");
+    case BootPhase_e::EarlyInit:      return F("Early Init");
+    case BootPhase_e::Log:            return F("Log");
+    case BootPhase_e::RTC:            return F("RTC");
+    case BootPhase_e::FileSystem:     return F("File System");
+    case BootPhase_e::LoadSettings:   return F("Load Settings");
+    case BootPhase_e::HardwareInit:   return F("Hardware Init");
+    case BootPhase_e::WiFiScan:       return F("WiFi Scan");
+    case BootPhase_e::RuleSets:       return F("Rule Sets");
+    case BootPhase_e::Serial:         return F("Serial");
+    case BootPhase_e::Controllers:    return F("Controllers");
+    case BootPhase_e::Notifications:  return F("Notifications");
+    case BootPhase_e::Plugins:        return F("Plugins");
+    case BootPhase_e::WakeEvents:     return F("Wake Events");
+    case BootPhase_e::NetworkConnect: return F("Network Connect");
+    case BootPhase_e::WebServer:      return F("Web Server");
+    case BootPhase_e::ArduinoOTA:     return F("Arduino OTA");
+    case BootPhase_e::BootEvent:      return F("Boot Event");
+    case BootPhase_e::WriteCSS:       return F("Write CSS");
+    case BootPhase_e::Scheduler:      return F("Scheduler");
+    case BootPhase_e::DeferredInit:   return F("Deferred Init");
+    case BootPhase_e::NR_ELEMENTS:    break;
+  }
+  return F("");
+}
+
+void BootProfiler_begin()
+{
+  if ((bootProfile.marker == BOOT_PROFILE_MARKER) && !bootProfile.finished) {
+    bootProfiler_prevStoppedAt = bootProfile.lastPhaseDone;
+  }
+  bootProfile.setupDone_usec = 0;
+  bootProfile.marker         = BOOT_PROFILE_MARKER;
+  bootProfile.lastPhaseDone  = static_cast<uint8_t>(BootPhase_e::NR_ELEMENTS);
+  bootProfile.finished       = false;
+
+  for (uint8_t i = 0; i < static_cast<uint8_t>(BootPhase_e::NR_ELEMENTS); ++i) {
+    bootProfile.phase_usec[i] = 0;
+  }
+  bootProfiler_lastMark = 0; // Core phase started at reset
+  BootProfiler_phaseDone(BootPhase_e::Core);
+}
+
+void BootProfiler_phaseStart()
+{
+  bootProfiler_lastMark = getMicros64();
+}
+
+void BootProfiler_phaseDone(BootPhase_e phase)
+{
+  const uint64_t now = getMicros64();
+
+  // A phase may be reached more than once, e.g. when skipped and done later.
+  bootProfile.phase_usec[static_cast<uint8_t>(phase)] += static_cast<uint32_t>(now - bootProfiler_lastMark);
+  bootProfile.lastPhaseDone                            = static_cast<uint8_t>(phase);
+  bootProfiler_lastMark                                = now;
+}
+
+void BootProfiler_end()
+{
+  bootProfile.setupDone_usec = static_cast<uint32_t>(getMicros64());
+  bootProfile.finished       = true;
+
+  if (bootProfiler_prevStoppedAt < static_cast<uint8_t>(BootPhase_e::NR_ELEMENTS)) {
+    addLog(LOG_LEVEL_ERROR, concat(
+             F("Boot : Previous boot did not finish, last phase done: "),
+             BootPhase_toString(static_cast<BootPhase_e>(bootProfiler_prevStoppedAt))));
+  }
+
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    addLogMove(LOG_LEVEL_INFO, concat(
+                 F("Boot : Setup done after "),
+                 bootProfile.setupDone_usec / 1000) + F(" ms"));
+  }
+}
+
+void BootProfiler_taskInit(taskIndex_t taskIndex, uint32_t duration_usec)
+{
+  if (validTaskIndex(taskIndex)) {
+    taskInit_usec[taskIndex] = duration_usec;
+  }
+}
+
+void BootProfiler_controllerInit(controllerIndex_t controllerIndex, uint32_t duration_usec)
+{
+  if (validControllerIndex(controllerIndex)) {
+    controllerInit_usec[controllerIndex] = duration_usec;
+  }
+}
+
+void BootProfiler_firstSample()
+{
+  if (bootProfiler_firstSample == 0) {
+    bootProfiler_firstSample = static_cast<uint32_t>(getMicros64());
+  }
+}
+
+uint32_t BootProfiler_getPhase(BootPhase_e phase)
+{
+  if (phase >= BootPhase_e::NR_ELEMENTS) { return 0; }
+  return bootProfile.phase_usec[static_cast<uint8_t>(phase)];
+}
+
+uint32_t BootProfiler_getTaskInit(taskIndex_t taskIndex)
+{
+  if (!validTaskIndex(taskIndex)) { return 0; }
+  return taskInit_usec[taskIndex];
+}
+
+uint32_t BootProfiler_getControllerInit(controllerIndex_t controllerIndex)
+{
+  if (!validControllerIndex(controllerIndex)) { return 0; }
+  return controllerInit_usec[controllerIndex];
+}
+
+uint32_t BootProfiler_getSetupDone()
+{
+  return bootProfile.setupDone_usec;
+}
+
+uint32_t BootProfiler_getFirstSample()
+{
+  return bootProfiler_firstSample;
+}
+
+#endif // if FEATURE_BOOT_PROFILER
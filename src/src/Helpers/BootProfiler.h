@@ -0,0 +1,89 @@
+#ifndef HELPERS_BOOTPROFILER_H
+#define HELPERS_BOOTPROFILER_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_BOOT_PROFILER
+# define BOOT_PHASE_DONE(P)  BootProfiler_phaseDone(BootPhase_e::P);
+#else // if FEATURE_BOOT_PROFILER
+# define BOOT_PHASE_DONE(P)
+#endif // if FEATURE_BOOT_PROFILER
+
+#if FEATURE_BOOT_PROFILER
+
+# include "../DataTypes/ControllerIndex.h"
+# include "../DataTypes/TaskIndex.h"
+
+/*********************************************************************************************\
+* Boot timeline
+* Duration of each phase in ESPEasy_setup(), the PLUGIN_INIT per task and the CPLUGIN_INIT
+* per controller. A phase lasts from the end of the previous phase until BootProfiler_phaseDone().
+*
+* On ESP32 the phase durations are kept in RTC memory, so the phase in progress can be shown
+* after a crash or watchdog reset during boot.
+* The ESP8266 RTC user memory is completely in use, so there they are only kept in RAM.
+\*********************************************************************************************/
+
+enum class BootPhase_e : uint8_t {
+  Core,          // From reset until ESPEasy_setup() is called
+  EarlyInit,     // Plugin/controller setup, WiFi object init
+  Log,
+  RTC,
+  FileSystem,
+  LoadSettings,
+  HardwareInit,
+  WiFiScan,
+  RuleSets,
+  Serial,
+  Controllers,
+  Notifications,
+  Plugins,
+  WakeEvents,
+  NetworkConnect,
+  WebServer,
+  ArduinoOTA,
+  BootEvent,
+  WriteCSS,
+  Scheduler,
+  DeferredInit,  // Subsystems started after the first sample, see Settings.FastFirstSample()
+
+  NR_ELEMENTS    // Must be the last one
+};
+
+const __FlashStringHelper* BootPhase_toString(BootPhase_e phase);
+
+// Start of ESPEasy_setup()
+void     BootProfiler_begin();
+
+// Mark the start of a phase not directly following the previous one.
+void     BootProfiler_phaseStart();
+
+void     BootProfiler_phaseDone(BootPhase_e phase);
+
+// ESPEasy_setup() has finished.
+void     BootProfiler_end();
+
+void     BootProfiler_taskInit(taskIndex_t taskIndex,
+                               uint32_t    duration_usec);
+
+void     BootProfiler_controllerInit(controllerIndex_t controllerIndex,
+                                     uint32_t          duration_usec);
+
+// First task has read and sent its values.
+void     BootProfiler_firstSample();
+
+uint32_t BootProfiler_getPhase(BootPhase_e phase);
+
+uint32_t BootProfiler_getTaskInit(taskIndex_t taskIndex);
+
+uint32_t BootProfiler_getControllerInit(controllerIndex_t controllerIndex);
+
+// Time since reset in usec when ESPEasy_setup() finished.
+uint32_t BootProfiler_getSetupDone();
+
+// Time since reset in usec when the first sample was sent, 0 when not (yet) sent.
+uint32_t BootProfiler_getFirstSample();
+
+#endif // if FEATURE_BOOT_PROFILER
+
+#endif // ifndef HELPERS_BOOTPROFILER_H
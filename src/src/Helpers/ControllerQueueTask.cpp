@@ -0,0 +1,242 @@
+#include "../Helpers/ControllerQueueTask.h"
+
+#if FEATURE_CONTROLLER_QUEUE_TASK
+
+# include "../ControllerQueue/DelayQueueElements.h"
+# include "../ESPEasyCore/ESPEasyNetwork.h"
+# include "../ESPEasyCore/ESPEasy_Log.h"
+# include "../Globals/EventQueue.h"
+# include "../Globals/Settings.h"
+# include "../Helpers/ESPEasyMutex.h"
+# include "../Helpers/ESPEasy_time_calc.h"
+# include "../Helpers/StringConverter.h"
+
+# include <atomic>
+# include <list>
+
+// Max. time to wait for a notification, same as the fall-back interval of the delay queue timers.
+# define CONTROLLER_QUEUE_TASK_MAX_WAIT  1000
+
+struct ControllerQueueTask_queue {
+  SchedulerIntervalTimer_e       timerID;
+  ControllerDelayHandlerStruct **handler;
+  void (*process)();
+};
+
+// Only controllers which just need the network and their own queue element in do_process.
+// Other controllers share state with the main loop, like the MQTT client, Blynk library, UDP port,
+// serial port or the file system, or read settings and caches while sending.
+const ControllerQueueTask_queue controllerQueueTask_queues[] = {
+  # ifdef USES_C001
+  { SchedulerIntervalTimer_e::TIMER_C001_DELAY_QUEUE, &C001_DelayHandler, process_c001_delay_queue },
+  # endif // ifdef USES_C001
+  # ifdef USES_C003
+  { SchedulerIntervalTimer_e::TIMER_C003_DELAY_QUEUE, &C003_DelayHandler, process_c003_delay_queue },
+  # endif // ifdef USES_C003
+  # ifdef USES_C004
+  { SchedulerIntervalTimer_e::TIMER_C004_DELAY_QUEUE, &C004_DelayHandler, process_c004_delay_queue },
+  # endif // ifdef USES_C004
+  # ifdef USES_C008
+  { SchedulerIntervalTimer_e::TIMER_C008_DELAY_QUEUE, &C008_DelayHandler, process_c008_delay_queue },
+  # endif // ifdef USES_C008
+  # ifdef USES_C011
+  { SchedulerIntervalTimer_e::TIMER_C011_DELAY_QUEUE, &C011_DelayHandler, process_c011_delay_queue },
+  # endif // ifdef USES_C011
+};
+
+constexpr size_t controllerQueueTask_nrQueues = sizeof(controllerQueueTask_queues) / sizeof(controllerQueueTask_queues[0]);
+
+struct ControllerQueueTask_deferred {
+  ControllerQueueTask_deferred(uint8_t logLevel, String&& text, bool isEvent, bool deduplicate)
+    : text(std::move(text)), logLevel(logLevel), isEvent(isEvent), deduplicate(deduplicate) {}
+
+  String  text;
+  uint8_t logLevel;
+  bool    isEvent;
+  bool    deduplicate;
+};
+
+TaskHandle_t                            controllerQueueTask_handle = nullptr;
+ESPEasy_Mutex                           controllerQueueTask_deferredMutex;
+std::list<ControllerQueueTask_deferred> controllerQueueTask_deferredList;
+uint32_t                                controllerQueueTask_deferredDropped = 0;
+
+// Network state as last checked by the main loop, as checking it may reset WiFi.
+std::atomic<bool> controllerQueueTask_network(false);
+
+
+void controllerQueueTask_run(void *parameter)
+{
+  uint32_t waitTime = CONTROLLER_QUEUE_TASK_MAX_WAIT;
+
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(waitTime));
+    waitTime = CONTROLLER_QUEUE_TASK_MAX_WAIT;
+
+    // Handlers may not be created or deleted while processing them.
+    ControllerDelayHandlerStruct::lockProcessing();
+
+    for (size_t i = 0; i < controllerQueueTask_nrQueues; ++i) {
+      const ControllerQueueTask_queue& queue = controllerQueueTask_queues[i];
+
+      if (*queue.handler != nullptr) {
+        unsigned long nextTime = (*queue.handler)->getNextScheduleTime();
+
+        if ((nextTime != 0) && (timePassedSince(nextTime) >= 0)) {
+          queue.process();
+          nextTime = (*queue.handler)->getNextScheduleTime();
+        }
+
+        if (nextTime != 0) {
+          const long wait = timeDiff(millis(), nextTime);
+
+          if (wait <= 0) {
+            waitTime = 1;
+          } else if (static_cast<uint32_t>(wait) < waitTime) {
+            waitTime = wait;
+          }
+        }
+      }
+    }
+    ControllerDelayHandlerStruct::unlockProcessing();
+  }
+}
+
+void controllerQueueTask_start()
+{
+  if ((controllerQueueTask_handle != nullptr) ||
+      !Settings.EnableControllerQueueTask() ||
+      (controllerQueueTask_nrQueues == 0)) {
+    return;
+  }
+
+  // Same priority as the main loop
+  xTaskCreatePinnedToCore(
+    controllerQueueTask_run,
+    "ControllerQueue",
+    CONTROLLER_QUEUE_TASK_STACK_SIZE,
+    nullptr,
+    1,
+    &controllerQueueTask_handle,
+    CONTROLLER_QUEUE_TASK_CORE);
+
+  if (controllerQueueTask_handle == nullptr) {
+    addLog(LOG_LEVEL_ERROR, F("RTOS : Could not start controller queue task"));
+  } else {
+    addLog(LOG_LEVEL_INFO, F("RTOS : Started controller queue task"));
+  }
+}
+
+bool controllerQueueTask_active()
+{
+  return controllerQueueTask_handle != nullptr;
+}
+
+bool controllerQueueTask_isWorker()
+{
+  return (controllerQueueTask_handle != nullptr) &&
+         (xTaskGetCurrentTaskHandle() == controllerQueueTask_handle);
+}
+
+bool controllerQueueTask_networkConnected()
+{
+  return controllerQueueTask_network.load();
+}
+
+bool controllerQueueTask_handlesQueue(SchedulerIntervalTimer_e timerID)
+{
+  if (controllerQueueTask_handle == nullptr) {
+    return false;
+  }
+
+  for (size_t i = 0; i < controllerQueueTask_nrQueues; ++i) {
+    if (controllerQueueTask_queues[i].timerID == timerID) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void controllerQueueTask_notify()
+{
+  if (controllerQueueTask_handle != nullptr) {
+    xTaskNotifyGive(controllerQueueTask_handle);
+  }
+}
+
+void controllerQueueTask_addDeferred(uint8_t logLevel, String&& text, bool isEvent, bool deduplicate)
+{
+  controllerQueueTask_deferredMutex.lock();
+
+  if (controllerQueueTask_deferredList.size() < CONTROLLER_QUEUE_TASK_MAX_DEFERRED) {
+    controllerQueueTask_deferredList.emplace_back(logLevel, std::move(text), isEvent, deduplicate);
+  } else {
+    ++controllerQueueTask_deferredDropped;
+  }
+  controllerQueueTask_deferredMutex.unlock();
+}
+
+void controllerQueueTask_deferLog(uint8_t logLevel, String&& line)
+{
+  controllerQueueTask_addDeferred(logLevel, std::move(line), false, false);
+}
+
+void controllerQueueTask_deferEvent(const char *event, size_t length, bool deduplicate)
+{
+  String str;
+
+  if (str.reserve(length)) {
+    for (size_t i = 0; i < length; ++i) {
+      str += event[i];
+    }
+    controllerQueueTask_addDeferred(0, std::move(str), true, deduplicate);
+  }
+}
+
+void controllerQueueTask_loop()
+{
+  if (controllerQueueTask_handle == nullptr) {
+    return;
+  }
+
+  const bool networkConnected = NetworkConnected();
+
+  if (controllerQueueTask_network.exchange(networkConnected) != networkConnected) {
+    controllerQueueTask_notify();
+  }
+
+  // Move the deferred items out of the list, so the lock is not held while logging.
+  std::list<ControllerQueueTask_deferred> deferred;
+  uint32_t dropped = 0;
+
+  controllerQueueTask_deferredMutex.lock();
+  deferred.swap(controllerQueueTask_deferredList);
+  dropped                             = controllerQueueTask_deferredDropped;
+  controllerQueueTask_deferredDropped = 0;
+  controllerQueueTask_deferredMutex.unlock();
+
+  for (auto it = deferred.begin(); it != deferred.end(); ++it) {
+    if (it->isEvent) {
+      eventQueue.addMove(std::move(it->text), it->deduplicate);
+    } else {
+      addToLogMove(it->logLevel, std::move(it->text));
+    }
+  }
+
+  if ((dropped != 0) && loglevelActiveFor(LOG_LEVEL_ERROR)) {
+    addLogMove(LOG_LEVEL_ERROR, concat(F("RTOS : Controller queue task dropped log lines/events: "), dropped));
+  }
+# if FEATURE_CONTROLLER_QUEUE_SPILL
+
+  // The spill files cannot be accessed from the controller queue task.
+  for (size_t i = 0; i < controllerQueueTask_nrQueues; ++i) {
+    ControllerDelayHandlerStruct *handler = *controllerQueueTask_queues[i].handler;
+
+    if ((handler != nullptr) && handler->processSpill()) {
+      controllerQueueTask_notify();
+    }
+  }
+# endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+}
+
+#endif // if FEATURE_CONTROLLER_QUEUE_TASK
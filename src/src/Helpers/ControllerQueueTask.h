@@ -0,0 +1,62 @@
+#ifndef HELPERS_CONTROLLERQUEUETASK_H
+#define HELPERS_CONTROLLERQUEUETASK_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_CONTROLLER_QUEUE_TASK
+
+# include "../DataTypes/SchedulerIntervalTimer.h"
+
+# ifndef CONTROLLER_QUEUE_TASK_STACK_SIZE
+#  define CONTROLLER_QUEUE_TASK_STACK_SIZE  8192
+# endif // ifndef CONTROLLER_QUEUE_TASK_STACK_SIZE
+
+# ifndef CONTROLLER_QUEUE_TASK_CORE
+#  define CONTROLLER_QUEUE_TASK_CORE        0
+# endif // ifndef CONTROLLER_QUEUE_TASK_CORE
+
+// Max. number of log lines and events kept while waiting for the main loop
+# define CONTROLLER_QUEUE_TASK_MAX_DEFERRED 32
+
+// ********************************************************************************
+// Process the delay queues of HTTP based controllers in a separate FreeRTOS task.
+// This keeps a slow server from blocking the main loop.
+// The delay queues of these controllers are then no longer processed by the scheduler.
+//
+// Code running in this task must not access the caches, the event queue or the log
+// directly. Log lines and events are deferred until controllerQueueTask_loop() is called
+// from the main loop. Timing stats are not collected for code running in this task.
+// ********************************************************************************
+
+// Start the task when enabled in the settings. Only evaluated at boot.
+void controllerQueueTask_start();
+
+bool controllerQueueTask_active();
+
+// Return true when called from the controller queue task.
+bool controllerQueueTask_isWorker();
+
+// Network state as last checked by controllerQueueTask_loop().
+// To be used from the controller queue task instead of NetworkConnected().
+bool controllerQueueTask_networkConnected();
+
+// Return true when the delay queue of this timer is processed in the controller queue task.
+bool controllerQueueTask_handlesQueue(SchedulerIntervalTimer_e timerID);
+
+// Wake up the task, to check the queues for new messages.
+void controllerQueueTask_notify();
+
+void controllerQueueTask_deferLog(uint8_t  logLevel,
+                                  String&& line);
+
+void controllerQueueTask_deferEvent(const char *event,
+                                    size_t      length,
+                                    bool        deduplicate);
+
+// Forward the deferred log lines and events and publish the network state.
+// Must be called from the main loop.
+void controllerQueueTask_loop();
+
+#endif // if FEATURE_CONTROLLER_QUEUE_TASK
+
+#endif // ifndef HELPERS_CONTROLLERQUEUETASK_H
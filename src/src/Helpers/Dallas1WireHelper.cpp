@@ -5,6 +5,10 @@
 #include "../Helpers/ESPEasy_Storage.h"
 #include "../Helpers/Misc.h"
 
+#if FEATURE_DALLAS_RMT
+# include "../Helpers/Dallas1WireRMT.h"
+#endif // if FEATURE_DALLAS_RMT
+
 #include "../WebServer/JSON.h"
 
 
@@ -29,6 +33,7 @@
 #endif // ifdef ESP32
 
 
+#include <map>
 #include <vector>
 
 unsigned char ROM_NO[8]{ 0 };
@@ -40,6 +45,53 @@ int64_t usec_release{};
 int64_t presence_start{};
 int64_t presence_end{};
 
+#if FEATURE_DALLAS_RMT
+
+// GPIO pins using the RMT driver, bit per GPIO
+static uint64_t Dallas_RMT_pins = 0;
+
+static bool Dallas_useRMT(int8_t gpio_pin_rx, int8_t gpio_pin_tx) {
+  return (gpio_pin_rx == gpio_pin_tx) &&
+         (gpio_pin_rx >= 0) && (gpio_pin_rx < 64) &&
+         bitRead(Dallas_RMT_pins, gpio_pin_rx);
+}
+
+void Dallas_setDriver(int8_t gpio_pin_rx, int8_t gpio_pin_tx, Dallas_driver_e driver) {
+  if ((gpio_pin_rx < 0) || (gpio_pin_rx >= 64)) {
+    return;
+  }
+  const bool useRMT = (driver == Dallas_driver_e::RMT) && (gpio_pin_rx == gpio_pin_tx);
+
+  const uint64_t mask = 1ull << gpio_pin_rx;
+
+  if (useRMT) {
+    Dallas_RMT_pins |= mask;
+  } else {
+    Dallas_RMT_pins &= ~mask;
+  }
+
+  if (Dallas_RMT_pins == 0) {
+    Dallas_RMT_end();
+  }
+}
+
+void Dallas_driver_webform_load(uint8_t driver) {
+  const __FlashStringHelper *options[] = { F("Bit-bang"), F("RMT") };
+  const int optionValues[]             = {
+    static_cast<int>(Dallas_driver_e::BitBang),
+    static_cast<int>(Dallas_driver_e::RMT)
+  };
+
+  addFormSelector(F("1-Wire Driver"), F("dallas_drv"), NR_ELEMENTS(optionValues), options, optionValues, driver);
+  addFormNote(F("RMT: Timing by hardware without disabling interrupts. Only for a single GPIO pin."));
+}
+
+uint8_t Dallas_driver_webform_save() {
+  return getFormItemInt(F("dallas_drv"), static_cast<int>(Dallas_driver_e::BitBang));
+}
+
+#endif // if FEATURE_DALLAS_RMT
+
 
 // References to 1-wire family codes:
 // http://owfs.sourceforge.net/simple_family.html
@@ -321,6 +373,67 @@ void Dallas_startConversion(const uint8_t ROM[8], int8_t gpio_pin_rx, int8_t gpi
   Dallas_write(0x44, gpio_pin_rx, gpio_pin_tx);
 }
 
+/*********************************************************************************************\
+*  Dallas Start Temperature Conversion, expected max duration:
+*    9 bits resolution ->  93.75 ms
+*   10 bits resolution -> 187.5 ms
+*   11 bits resolution -> 375 ms
+*   12 bits resolution -> 750 ms
+\*********************************************************************************************/
+unsigned long Dallas_conversionTime(uint8_t res)
+{
+  if ((res < 9) || (res > 12)) {
+    res = 12;
+  }
+  return 800 / (1 << (12 - res));
+}
+
+struct Dallas_BusConversion {
+  unsigned long start = 0;
+  uint32_t      id    = 0;
+};
+
+// Last conversion per GPIO pin (RX)
+static std::map<int8_t, Dallas_BusConversion> Dallas_busConversions;
+
+bool Dallas_startBusConversion(int8_t         gpio_pin_rx,
+                               int8_t         gpio_pin_tx,
+                               uint8_t        res,
+                               uint32_t     & conversionId,
+                               unsigned long& readyTime)
+{
+  const unsigned long conversionTime = Dallas_conversionTime(res);
+  auto it                            = Dallas_busConversions.find(gpio_pin_rx);
+
+  if ((it != Dallas_busConversions.end()) &&
+      (it->second.id != conversionId) &&
+      (timePassedSince(it->second.start) < static_cast<long>(conversionTime + DALLAS_BUS_CONVERSION_REUSE_MSEC))) {
+    // Conversion started by another task, not yet used by the caller
+    conversionId = it->second.id;
+    readyTime    = it->second.start + conversionTime;
+    return true;
+  }
+
+  if (!Dallas_reset(gpio_pin_rx, gpio_pin_tx)) {
+    return false;
+  }
+  Dallas_write(0xCC, gpio_pin_rx, gpio_pin_tx); // Skip ROM, address all sensors
+  Dallas_write(0x44, gpio_pin_rx, gpio_pin_tx); // Take temperature measurement
+
+  Dallas_BusConversion& conversion = Dallas_busConversions[gpio_pin_rx];
+
+  conversion.start = millis();
+  ++conversion.id;
+
+  if (conversion.id == 0) {
+    // 0 is used by callers which did not yet use a conversion
+    ++conversion.id;
+  }
+  conversionId = conversion.id;
+  readyTime    = conversion.start + conversionTime;
+  return true;
+}
+
 /*********************************************************************************************\
 *  Dallas Read temperature from scratchpad
 \*********************************************************************************************/
@@ -657,6 +770,21 @@ bool Dallas_setResolution(const uint8_t ROM[8], uint8_t res, int8_t gpio_pin_rx,
 \*********************************************************************************************/
 uint8_t Dallas_reset(int8_t gpio_pin_rx, int8_t gpio_pin_tx)
 {
+#if FEATURE_DALLAS_RMT
+
+  if (Dallas_useRMT(gpio_pin_rx, gpio_pin_tx)) {
+    bool presence = false;
+
+    usec_release = 0;
+
+    if (Dallas_RMT_reset(gpio_pin_rx, presence, presence_start, presence_end)) {
+      if (presence && ((presence_end - presence_start) > 60)) { return 1; }
+      return 0;
+    }
+
+    // Fall back to bit-banging
+  }
+#endif // if FEATURE_DALLAS_RMT
   uint8_t retries = 125;
 
   ISR_noInterrupts();
@@ -944,6 +1072,14 @@ uint8_t Dallas_read(int8_t gpio_pin_rx, int8_t gpio_pin_tx)
   uint8_t bitMask;
   uint8_t r = 0;
 
+#if FEATURE_DALLAS_RMT
+
+  if (Dallas_useRMT(gpio_pin_rx, gpio_pin_tx) &&
+      Dallas_RMT_read_bits(gpio_pin_rx, r, 8)) {
+    return r;
+  }
+#endif // if FEATURE_DALLAS_RMT
+
   for (bitMask = 0x01; bitMask; bitMask <<= 1) {
     if (Dallas_read_bit(gpio_pin_rx, gpio_pin_tx)) {
       r |= bitMask;
@@ -960,6 +1096,14 @@ void Dallas_write(uint8_t ByteToWrite, int8_t gpio_pin_rx, int8_t gpio_pin_tx)
 {
   uint8_t bitMask;
 
+#if FEATURE_DALLAS_RMT
+
+  if (Dallas_useRMT(gpio_pin_rx, gpio_pin_tx) &&
+      Dallas_RMT_write_bits(gpio_pin_rx, ByteToWrite, 8)) {
+    return;
+  }
+#endif // if FEATURE_DALLAS_RMT
+
   DIRECT_pinWrite(gpio_pin_tx, 1);
 
   if (gpio_pin_rx == gpio_pin_tx) {
@@ -989,6 +1133,16 @@ uint8_t Dallas_read_bit(int8_t gpio_pin_rx, int8_t gpio_pin_tx)
   if (gpio_pin_rx == -1) { return 0; }
 
   if (gpio_pin_tx == -1) { return 0; }
+#if FEATURE_DALLAS_RMT
+  {
+    uint8_t r = 0;
+
+    if (Dallas_useRMT(gpio_pin_rx, gpio_pin_tx) &&
+        Dallas_RMT_read_bits(gpio_pin_rx, r, 1)) {
+      return r;
+    }
+  }
+#endif // if FEATURE_DALLAS_RMT
   uint64_t start = 0;
   uint8_t  r     = Dallas_read_bit_ISR(gpio_pin_rx, gpio_pin_tx, start);
 
@@ -1048,6 +1202,14 @@ void Dallas_write_bit(uint8_t v, int8_t gpio_pin_rx, int8_t gpio_pin_tx)
 {
   if (gpio_pin_tx == -1) { return; }
 
+#if FEATURE_DALLAS_RMT
+
+  if (Dallas_useRMT(gpio_pin_rx, gpio_pin_tx) &&
+      Dallas_RMT_write_bits(gpio_pin_rx, v & 1, 1)) {
+    return;
+  }
+#endif // if FEATURE_DALLAS_RMT
+
   // Determine times in usec for high and low
   // write 1: low 6 usec, high 64 usec
   // write 0: low 60 usec, high 10 usec
@@ -1204,6 +1366,20 @@ bool Dallas_SensorData::initiate_read(int8_t gpio_rx, int8_t gpio_tx, int8_t res
   return true;
 }
 
+bool Dallas_SensorData::join_bus_conversion(int8_t gpio_rx, int8_t gpio_tx, int8_t res) {
+  if (addr == 0) { return false; }
+
+  if (lastReadError) {
+    if (!check_sensor(gpio_rx, gpio_tx, res)) {
+      return false;
+    }
+    lastReadError = false;
+  }
+
+  // Presence is checked when reading the scratchpad
+  return true;
+}
+
 bool Dallas_SensorData::collect_value(int8_t gpio_rx, int8_t gpio_tx) {
   if ((addr != 0) && measurementActive) {
     uint8_t tmpaddr[8];
@@ -29,6 +29,11 @@ struct Dallas_SensorData {
                      int8_t gpio_tx,
                      int8_t res);
 
+  // Sensor takes part in a conversion started by Dallas_startBusConversion()
+  bool join_bus_conversion(int8_t gpio_rx,
+                           int8_t gpio_tx,
+                           int8_t res);
+
   bool   collect_value(int8_t gpio_rx,
                        int8_t gpio_tx);
 
@@ -90,6 +95,26 @@ void Dallas_addr_selector_webform_save(taskIndex_t TaskIndex, int8_t gpio_pin_rx
 
 bool Dallas_plugin(pluginID_t pluginID);
 
+#if FEATURE_DALLAS_RMT
+
+/*********************************************************************************************\
+   1-Wire driver used for a GPIO pin, set by the tasks using this pin at PLUGIN_INIT.
+   RMT is only used when RX and TX are the same pin.
+\*********************************************************************************************/
+enum class Dallas_driver_e : uint8_t {
+  BitBang = 0,
+  RMT     = 1
+};
+
+void            Dallas_setDriver(int8_t          gpio_pin_rx,
+                                 int8_t          gpio_pin_tx,
+                                 Dallas_driver_e driver);
+
+void            Dallas_driver_webform_load(uint8_t driver);
+
+uint8_t         Dallas_driver_webform_save();
+#endif // if FEATURE_DALLAS_RMT
+
 // Load ROM address from tasksettings
 void Dallas_plugin_get_addr(uint8_t addr[], taskIndex_t TaskIndex, uint8_t var_index = 0);
 
@@ -113,6 +138,32 @@ void Dallas_startConversion(const uint8_t ROM[8],
                             int8_t        gpio_pin_rx,
                             int8_t        gpio_pin_tx);
 
+/*********************************************************************************************\
+*  Dallas conversion time in msec for the given resolution
+\*********************************************************************************************/
+unsigned long Dallas_conversionTime(uint8_t res);
+
+/*********************************************************************************************\
+*  Dallas bus-wide temperature conversion
+*  A single Skip ROM "Convert T" for all sensors on a GPIO pin, shared by all tasks using this pin.
+*  A conversion is reused until DALLAS_BUS_CONVERSION_REUSE_MSEC after it is ready,
+*  so tasks with the same interval only need to read their own scratchpads.
+*
+*  @param conversionId  ID of the conversion last used by the caller, updated to the ID of the
+*                       conversion to wait for. A new conversion is started when it is the same.
+*  @param readyTime     Time (millis) at which the conversion for the given resolution is ready.
+*  @retval false when no sensor responded on the bus.
+\*********************************************************************************************/
+#ifndef DALLAS_BUS_CONVERSION_REUSE_MSEC
+# define DALLAS_BUS_CONVERSION_REUSE_MSEC  1000
+#endif // ifndef DALLAS_BUS_CONVERSION_REUSE_MSEC
+
+bool Dallas_startBusConversion(int8_t         gpio_pin_rx,
+                               int8_t         gpio_pin_tx,
+                               uint8_t        res,
+                               uint32_t     & conversionId,
+                               unsigned long& readyTime);
+
 /*********************************************************************************************\
 *  Dallas data from scratchpad
 \*********************************************************************************************/
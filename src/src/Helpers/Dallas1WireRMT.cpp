@@ -0,0 +1,257 @@
+#include "../Helpers/Dallas1WireRMT.h"
+
+#if FEATURE_DALLAS_RMT
+
+# include "../ESPEasyCore/ESPEasy_Log.h"
+
+# include <driver/gpio.h>
+# include <driver/rmt.h>
+# include <soc/gpio_periph.h>
+# include <soc/gpio_struct.h>
+
+// RMT clock divider, 80 MHz APB clock => 1 usec per tick
+# define DALLAS_RMT_CLK_DIV            80
+
+// Timings in usec, matching the bit-banged timings in Dallas1WireHelper
+# define DALLAS_RMT_RESET_LOW          480
+# define DALLAS_RMT_SLOT               70
+# define DALLAS_RMT_WRITE_1_LOW        6
+# define DALLAS_RMT_WRITE_0_LOW        60
+# define DALLAS_RMT_READ_LOW           3
+# define DALLAS_RMT_SAMPLE             15 // Line released before this time is read as 1
+
+// RX stops when the line is idle for this long
+# define DALLAS_RMT_RX_IDLE_SLOT       (DALLAS_RMT_SLOT + 2)
+# define DALLAS_RMT_RX_IDLE_RESET      (DALLAS_RMT_RESET_LOW + 60)
+
+// Ignore glitches shorter than this nr of APB clock ticks (max. 255)
+# define DALLAS_RMT_RX_FILTER          30
+
+# define DALLAS_RMT_RX_BUFFER_SIZE     512
+# define DALLAS_RMT_RX_TIMEOUT_MS      20
+
+static bool             Dallas_RMT_installed  = false;
+static int8_t           Dallas_RMT_gpio       = -1;
+static RingbufHandle_t  Dallas_RMT_ringbuffer = nullptr;
+
+static bool Dallas_RMT_install() {
+  if (Dallas_RMT_installed) {
+    return true;
+  }
+  rmt_config_t tx_config{};
+
+  tx_config.rmt_mode                 = RMT_MODE_TX;
+  tx_config.channel                  = DALLAS_RMT_TX_CHANNEL;
+  tx_config.gpio_num                 = GPIO_NUM_NC;
+  tx_config.clk_div                  = DALLAS_RMT_CLK_DIV;
+  tx_config.mem_block_num            = 1;
+  tx_config.tx_config.idle_level     = RMT_IDLE_LEVEL_HIGH;
+  tx_config.tx_config.idle_output_en = true;
+
+  rmt_config_t rx_config{};
+
+  rx_config.rmt_mode                      = RMT_MODE_RX;
+  rx_config.channel                       = DALLAS_RMT_RX_CHANNEL;
+  rx_config.gpio_num                      = GPIO_NUM_NC;
+  rx_config.clk_div                       = DALLAS_RMT_CLK_DIV;
+  rx_config.mem_block_num                 = 1;
+  rx_config.rx_config.filter_en           = true;
+  rx_config.rx_config.filter_ticks_thresh = DALLAS_RMT_RX_FILTER;
+  rx_config.rx_config.idle_threshold      = DALLAS_RMT_RX_IDLE_SLOT;
+
+  if ((rmt_config(&tx_config) != ESP_OK) ||
+      (rmt_driver_install(tx_config.channel, 0, 0) != ESP_OK)) {
+    addLog(LOG_LEVEL_ERROR, F("1Wire: Could not install RMT TX channel"));
+    return false;
+  }
+
+  if ((rmt_config(&rx_config) != ESP_OK) ||
+      (rmt_driver_install(rx_config.channel, DALLAS_RMT_RX_BUFFER_SIZE, 0) != ESP_OK) ||
+      (rmt_get_ringbuf_handle(rx_config.channel, &Dallas_RMT_ringbuffer) != ESP_OK)) {
+    rmt_driver_uninstall(tx_config.channel);
+    addLog(LOG_LEVEL_ERROR, F("1Wire: Could not install RMT RX channel"));
+    return false;
+  }
+  Dallas_RMT_installed = true;
+  Dallas_RMT_gpio      = -1;
+  return true;
+}
+
+// Connect both RMT channels to the GPIO pin, set as open drain.
+// Done at every reset, as pinMode() on this pin disconnects the RMT TX signal.
+static bool Dallas_RMT_attach(int8_t gpio_pin, bool force) {
+  if (!Dallas_RMT_install()) {
+    return false;
+  }
+
+  if (!force && (gpio_pin == Dallas_RMT_gpio)) {
+    return true;
+  }
+
+  if ((Dallas_RMT_gpio != -1) && (Dallas_RMT_gpio != gpio_pin)) {
+    // Release the previous bus, the external pull-up keeps it high
+    pinMode(Dallas_RMT_gpio, INPUT);
+  }
+  const gpio_num_t gpio = static_cast<gpio_num_t>(gpio_pin);
+
+  if ((rmt_set_gpio(DALLAS_RMT_TX_CHANNEL, RMT_MODE_TX, gpio, false) != ESP_OK) ||
+      (rmt_set_gpio(DALLAS_RMT_RX_CHANNEL, RMT_MODE_RX, gpio, false) != ESP_OK)) {
+    Dallas_RMT_gpio = -1;
+    return false;
+  }
+
+  // Input must be enabled for the RX channel to see the line, open drain so the sensors can pull it low.
+  PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[gpio_pin]);
+  GPIO.pin[gpio_pin].pad_driver = 1;
+  Dallas_RMT_gpio               = gpio_pin;
+  return true;
+}
+
+static void Dallas_RMT_flush_rx() {
+  void  *item = nullptr;
+  size_t size = 0;
+
+  while ((item = xRingbufferReceive(Dallas_RMT_ringbuffer, &size, 0)) != nullptr) {
+    vRingbufferReturnItem(Dallas_RMT_ringbuffer, item);
+  }
+}
+
+static rmt_item32_t Dallas_RMT_slot(uint32_t low_time) {
+  rmt_item32_t item{};
+
+  item.level0    = 0;
+  item.duration0 = low_time;
+  item.level1    = 1;
+  item.duration1 = DALLAS_RMT_SLOT - low_time;
+  return item;
+}
+
+bool Dallas_RMT_reset(int8_t   gpio_pin,
+                      bool   & presence,
+                      int64_t& presence_start,
+                      int64_t& presence_end)
+{
+  presence       = false;
+  presence_start = 0;
+  presence_end   = 0;
+
+  if (!Dallas_RMT_attach(gpio_pin, true)) {
+    return false;
+  }
+
+  // Duration 0 marks the end of the transmission, line is released after the reset pulse.
+  rmt_item32_t tx_item{};
+
+  tx_item.level0    = 0;
+  tx_item.duration0 = DALLAS_RMT_RESET_LOW;
+  tx_item.level1    = 1;
+  tx_item.duration1 = 0;
+
+  rmt_set_rx_idle_thresh(DALLAS_RMT_RX_CHANNEL, DALLAS_RMT_RX_IDLE_RESET);
+  Dallas_RMT_flush_rx();
+  rmt_rx_start(DALLAS_RMT_RX_CHANNEL, true);
+
+  bool success = rmt_write_items(DALLAS_RMT_TX_CHANNEL, &tx_item, 1, true) == ESP_OK;
+
+  if (success) {
+    size_t rx_size         = 0;
+    rmt_item32_t *rx_items = static_cast<rmt_item32_t *>(
+      xRingbufferReceive(Dallas_RMT_ringbuffer, &rx_size, pdMS_TO_TICKS(DALLAS_RMT_RX_TIMEOUT_MS)));
+
+    if (rx_items != nullptr) {
+      // Item 0: reset pulse + time till presence, item 1: presence pulse
+      if ((rx_size >= 2 * sizeof(rmt_item32_t)) &&
+          (rx_items[0].level0 == 0) && (rx_items[0].duration0 >= DALLAS_RMT_RESET_LOW - 2) &&
+          (rx_items[0].level1 == 1) && (rx_items[0].duration1 > 0) &&
+          (rx_items[1].level0 == 0)) {
+        presence_start = rx_items[0].duration1;
+        presence_end   = presence_start + rx_items[1].duration0;
+        presence       = true;
+      }
+      vRingbufferReturnItem(Dallas_RMT_ringbuffer, rx_items);
+    } else {
+      // Nothing received, the line did not go low at all
+      success = false;
+    }
+  }
+  rmt_rx_stop(DALLAS_RMT_RX_CHANNEL);
+  rmt_set_rx_idle_thresh(DALLAS_RMT_RX_CHANNEL, DALLAS_RMT_RX_IDLE_SLOT);
+  return success;
+}
+
+bool Dallas_RMT_write_bits(int8_t  gpio_pin,
+                           uint8_t data,
+                           uint8_t nrBits)
+{
+  if ((nrBits == 0) || (nrBits > 8) || !Dallas_RMT_attach(gpio_pin, false)) {
+    return false;
+  }
+  rmt_item32_t tx_items[9]{}; // Last item all zero, marks the end
+
+  for (uint8_t i = 0; i < nrBits; ++i) {
+    tx_items[i] = Dallas_RMT_slot(((data >> i) & 1) ? DALLAS_RMT_WRITE_1_LOW : DALLAS_RMT_WRITE_0_LOW);
+  }
+  return rmt_write_items(DALLAS_RMT_TX_CHANNEL, tx_items, nrBits + 1, true) == ESP_OK;
+}
+
+bool Dallas_RMT_read_bits(int8_t   gpio_pin,
+                          uint8_t& data,
+                          uint8_t  nrBits)
+{
+  data = 0;
+
+  if ((nrBits == 0) || (nrBits > 8) || !Dallas_RMT_attach(gpio_pin, false)) {
+    return false;
+  }
+  rmt_item32_t tx_items[9]{}; // Last item all zero, marks the end
+
+  for (uint8_t i = 0; i < nrBits; ++i) {
+    tx_items[i] = Dallas_RMT_slot(DALLAS_RMT_READ_LOW);
+  }
+
+  Dallas_RMT_flush_rx();
+  rmt_rx_start(DALLAS_RMT_RX_CHANNEL, true);
+
+  bool success = rmt_write_items(DALLAS_RMT_TX_CHANNEL, tx_items, nrBits + 1, true) == ESP_OK;
+
+  if (success) {
+    size_t rx_size         = 0;
+    rmt_item32_t *rx_items = static_cast<rmt_item32_t *>(
+      xRingbufferReceive(Dallas_RMT_ringbuffer, &rx_size, pdMS_TO_TICKS(DALLAS_RMT_RX_TIMEOUT_MS)));
+
+    if (rx_items != nullptr) {
+      if (rx_size >= nrBits * sizeof(rmt_item32_t)) {
+        for (uint8_t i = 0; i < nrBits; ++i) {
+          // Sensor keeps the line low for a 0, so a short low period is a 1
+          if ((rx_items[i].level0 == 0) && (rx_items[i].duration0 < DALLAS_RMT_SAMPLE)) {
+            data |= (1 << i);
+          }
+        }
+      } else {
+        success = false;
+      }
+      vRingbufferReturnItem(Dallas_RMT_ringbuffer, rx_items);
+    } else {
+      success = false;
+    }
+  }
+  rmt_rx_stop(DALLAS_RMT_RX_CHANNEL);
+  return success;
+}
+
+void Dallas_RMT_end() {
+  if (!Dallas_RMT_installed) {
+    return;
+  }
+  rmt_driver_uninstall(DALLAS_RMT_TX_CHANNEL);
+  rmt_driver_uninstall(DALLAS_RMT_RX_CHANNEL);
+
+  if (Dallas_RMT_gpio != -1) {
+    pinMode(Dallas_RMT_gpio, INPUT);
+  }
+  Dallas_RMT_installed  = false;
+  Dallas_RMT_gpio       = -1;
+  Dallas_RMT_ringbuffer = nullptr;
+}
+
+#endif // if FEATURE_DALLAS_RMT
@@ -0,0 +1,59 @@
+#ifndef HELPERS_DALLAS1WIRERMT_H
+#define HELPERS_DALLAS1WIRERMT_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_DALLAS_RMT
+
+/*********************************************************************************************\
+*  1-Wire driver using the RMT peripheral of the ESP32.
+*  The RMT TX channel generates the reset and bit slots, the RX channel samples the line.
+*  This runs without disabling interrupts, so it does not add jitter to WiFi or other ISRs.
+*
+*  Only a single GPIO pin (RX = TX) is supported, which is set to open drain.
+*  A single pair of RMT channels is shared by all buses and moved to the GPIO pin in use.
+\*********************************************************************************************/
+
+// RMT channels used, must not be used by anything else.
+// NeoPixelBus uses channel 6 (ESP32) or channel 1 (other ESP32 variants) by default.
+# ifndef DALLAS_RMT_TX_CHANNEL
+#  if defined(CONFIG_IDF_TARGET_ESP32C3)
+#   define DALLAS_RMT_TX_CHANNEL  RMT_CHANNEL_0
+#   define DALLAS_RMT_RX_CHANNEL  RMT_CHANNEL_3
+#  elif defined(CONFIG_IDF_TARGET_ESP32S3)
+#   define DALLAS_RMT_TX_CHANNEL  RMT_CHANNEL_3
+#   define DALLAS_RMT_RX_CHANNEL  RMT_CHANNEL_7
+#  elif defined(CONFIG_IDF_TARGET_ESP32S2)
+#   define DALLAS_RMT_TX_CHANNEL  RMT_CHANNEL_2
+#   define DALLAS_RMT_RX_CHANNEL  RMT_CHANNEL_3
+#  else // if defined(CONFIG_IDF_TARGET_ESP32C3)
+#   define DALLAS_RMT_TX_CHANNEL  RMT_CHANNEL_4
+#   define DALLAS_RMT_RX_CHANNEL  RMT_CHANNEL_5
+#  endif // if defined(CONFIG_IDF_TARGET_ESP32C3)
+# endif // ifndef DALLAS_RMT_TX_CHANNEL
+
+// Reset pulse and presence detect
+// @param presence_start  [out] usec between release of the bus and the start of the presence pulse
+// @param presence_end    [out] usec between release of the bus and the end of the presence pulse
+// @retval false when the RMT peripheral could not be used.
+bool Dallas_RMT_reset(int8_t   gpio_pin,
+                      bool   & presence,
+                      int64_t& presence_start,
+                      int64_t& presence_end);
+
+// Write up to 8 bits, LSB first
+bool Dallas_RMT_write_bits(int8_t  gpio_pin,
+                           uint8_t data,
+                           uint8_t nrBits);
+
+// Read up to 8 bits, LSB first
+bool Dallas_RMT_read_bits(int8_t   gpio_pin,
+                          uint8_t& data,
+                          uint8_t  nrBits);
+
+// Release the RMT channels
+void Dallas_RMT_end();
+
+#endif // if FEATURE_DALLAS_RMT
+
+#endif // ifndef HELPERS_DALLAS1WIRERMT_H
@@ -9,11 +9,14 @@
 #include "../ESPEasyCore/ESPEasyWifi.h"
 #include "../ESPEasyCore/ESPEasyRules.h"
 
+#include "../CustomBuild/CompiletimeDefines.h"
+#include "../Globals/ESPEasy_time.h"
 #include "../Globals/EventQueue.h"
 #include "../Globals/RTC.h"
 #include "../Globals/Settings.h"
 #include "../Globals/Statistics.h"
 
+#include "../Helpers/ESPEasyRTC.h"
 #include "../Helpers/ESPEasy_time_calc.h"
 #include "../Helpers/Misc.h"
 #include "../Helpers/PeriodicalActions.h"
@@ -21,6 +24,25 @@
 #include <limits.h>
 
 
+#if FEATURE_DEEP_SLEEP_BATCH
+static bool deepSleepBatch_noWiFi     = false;
+static bool deepSleepBatch_noWiFiNext = false;
+
+static uint8_t deepSleepBatch_getCycles() {
+  return (RTC.deepSleepState & RTC_DEEPSLEEP_STATE_CYCLES_MASK) >> 1;
+}
+
+static void deepSleepBatch_setCycles(uint8_t cycles) {
+  if (cycles > (RTC_DEEPSLEEP_STATE_CYCLES_MASK >> 1)) {
+    cycles = RTC_DEEPSLEEP_STATE_CYCLES_MASK >> 1;
+  }
+  RTC.deepSleepState = (RTC.deepSleepState & ~RTC_DEEPSLEEP_STATE_CYCLES_MASK) | (cycles << 1);
+}
+
+// Update the wake cycle counter and decide whether the next wake cycle only collects samples.
+static void deepSleepBatch_prepareSleep();
+#endif // if FEATURE_DEEP_SLEEP_BATCH
+
 /**********************************************************
 *                                                         *
 * Deep Sleep related functions                            *
@@ -77,6 +99,14 @@ bool readyForSleep()
     return false;
   }
 
+  #if FEATURE_DEEP_SLEEP_BATCH
+
+  if (deepSleepBatch_sampleOnly()) {
+    // No connections to wait for, just allow the tasks to collect samples
+    return timeOutReached(timerAwakeFromDeepSleep + 1000 * Settings.deepSleep_wakeTime);
+  }
+  #endif // if FEATURE_DEEP_SLEEP_BATCH
+
   if (!NetworkConnected()) {
     // Allow 12 seconds to establish connections
     return timeOutReached(timerAwakeFromDeepSleep + 12000);
@@ -132,10 +162,30 @@ void deepSleepStart(int dsdelay)
   }
 
   addLog(LOG_LEVEL_INFO, F("SLEEP: Powering down to deepsleep..."));
-  RTC.deepSleepState = 1;
+  RTC.deepSleepState |= RTC_DEEPSLEEP_STATE_SLEEPING;
+  #if FEATURE_DEEP_SLEEP_BATCH
+  deepSleepBatch_prepareSleep();
+  #endif // if FEATURE_DEEP_SLEEP_BATCH
   prepareShutdown(IntendedRebootReason_e::DeepSleep);
 
+  #if FEATURE_DEEP_SLEEP_BATCH
+
+  if (deepSleepBatchEnabled() && (RTC.lastSysTime > get_build_unixtime()) && (dsdelay > 0)) {
+    // Samples collected without network need a timestamp, so restore the time at wake from RTC.
+    RTC.lastSysTime += dsdelay;
+    saveToRTC();
+  }
+  #endif // if FEATURE_DEEP_SLEEP_BATCH
+
   #if defined(ESP8266)
+  RFMode rfMode = WAKE_RF_DEFAULT;
+    # if FEATURE_DEEP_SLEEP_BATCH
+
+  if (deepSleepBatch_noWiFiNext) {
+    // Skip RF calibration, WiFi will not be used in the next wake cycle
+    rfMode = WAKE_RF_DISABLED;
+  }
+    # endif // if FEATURE_DEEP_SLEEP_BATCH
     # if defined(CORE_POST_2_5_0)
   if ((dsdelay < 0) || dsdelay > getDeepSleepMax()) {
     dsdelay = getDeepSleepMax();
@@ -149,7 +199,7 @@ void deepSleepStart(int dsdelay)
     // 1 = RF initialization only calibrate VDD33 and Tx power which will take about 18 ms
     // 2 = RF initialization only calibrate VDD33 which will take about 2 ms
     system_phy_set_powerup_option(2); // calibrate only 2ms;
-    system_deep_sleep_set_option(static_cast<int>(WAKE_RF_DEFAULT));
+    system_deep_sleep_set_option(static_cast<int>(rfMode));
     uint32_t*RT= (uint32_t *)0x60000700;
     uint32 t_us = 1.31 * deepSleep_usec;
     {
@@ -174,14 +224,14 @@ void deepSleepStart(int dsdelay)
     }
     yield();
   } else {
-    ESP.deepSleep(deepSleep_usec, WAKE_RF_DEFAULT);
+    ESP.deepSleep(deepSleep_usec, rfMode);
   }
     # else // if defined(CORE_POST_2_5_0)
 
   if ((dsdelay > 4294) || (dsdelay < 0)) {
     dsdelay = 4294; // max sleep time ~71 minutes
   }
-  ESP.deepSleep((uint32_t)dsdelay * 1000000, WAKE_RF_DEFAULT);
+  ESP.deepSleep((uint32_t)dsdelay * 1000000, rfMode);
     # endif // if defined(CORE_POST_2_5_0)
   #endif // if defined(ESP8266)
   #if defined(ESP32)
@@ -193,3 +243,90 @@ void deepSleepStart(int dsdelay)
   #endif // if defined(ESP32)
 }
 
+
+#if FEATURE_DEEP_SLEEP_BATCH
+
+bool deepSleepBatchEnabled()
+{
+  if ((Settings.deepSleep_batchCycles < 2) || !isDeepSleepEnabled()) {
+    return false;
+  }
+
+  // Samples are collected by the cache controller (C016)
+  for (controllerIndex_t x = 0; x < CONTROLLER_MAX; ++x) {
+    if ((16 == Settings.Protocol[x]) && Settings.ControllerEnabled[x]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void deepSleepBatch_initCycle()
+{
+  deepSleepBatch_noWiFi = false;
+
+  if ((lastBootCause != BOOT_CAUSE_DEEP_SLEEP) || !deepSleepBatchEnabled()) {
+    return;
+  }
+  const uint8_t cycle = deepSleepBatch_getCycles() + 1;
+
+  deepSleepBatch_noWiFi = !(RTC.deepSleepState & RTC_DEEPSLEEP_STATE_SEND_NEXT) &&
+                          (cycle < Settings.deepSleep_batchCycles);
+
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    String log = concat(F("SLEEP: Batch cycle "), cycle);
+    log += '/';
+    log += Settings.deepSleep_batchCycles;
+    log += deepSleepBatch_noWiFi ? F(" collect samples, WiFi off") : F(" send samples");
+    addLogMove(LOG_LEVEL_INFO, log);
+  }
+}
+
+bool deepSleepBatch_sampleOnly()
+{
+  return deepSleepBatch_noWiFi;
+}
+
+void deepSleepBatch_requestSend()
+{
+  if (!deepSleepBatch_noWiFi) {
+    // WiFi is (being) connected, samples are sent in this wake cycle
+    return;
+  }
+  RTC.deepSleepState |= RTC_DEEPSLEEP_STATE_SEND_NEXT;
+  addLog(LOG_LEVEL_INFO, F("SLEEP: Batch send requested"));
+
+  #ifdef ESP8266
+
+  // RF was disabled at wake, only a new wake cycle can enable WiFi again.
+  deepSleepStart(1);
+  #endif // ifdef ESP8266
+  #ifdef ESP32
+  deepSleepBatch_noWiFi = false;
+  saveToRTC();
+  NetworkConnectRelaxed();
+  #endif // ifdef ESP32
+}
+
+static void deepSleepBatch_prepareSleep()
+{
+  deepSleepBatch_noWiFiNext = false;
+
+  if (!deepSleepBatchEnabled()) {
+    deepSleepBatch_setCycles(0);
+    RTC.deepSleepState &= ~RTC_DEEPSLEEP_STATE_SEND_NEXT;
+    return;
+  }
+
+  if (deepSleepBatch_noWiFi || !NetworkConnected()) {
+    // Samples not sent, try again in the next cycle when already due
+    deepSleepBatch_setCycles(deepSleepBatch_getCycles() + 1);
+  } else {
+    deepSleepBatch_setCycles(0);
+    RTC.deepSleepState &= ~RTC_DEEPSLEEP_STATE_SEND_NEXT;
+  }
+  deepSleepBatch_noWiFiNext = !(RTC.deepSleepState & RTC_DEEPSLEEP_STATE_SEND_NEXT) &&
+                              ((deepSleepBatch_getCycles() + 1) < Settings.deepSleep_batchCycles);
+}
+
+#endif // if FEATURE_DEEP_SLEEP_BATCH
@@ -1,6 +1,8 @@
 #ifndef HELPERS_DEEPSLEEP_H
 #define HELPERS_DEEPSLEEP_H
 
+#include "../../ESPEasy_common.h"
+
 
 
 
@@ -20,5 +22,29 @@ void prepare_deepSleep(int dsdelay);
 
 void deepSleepStart(int dsdelay);
 
+#if FEATURE_DEEP_SLEEP_BATCH
+
+/**********************************************************
+*                                                         *
+* Deep sleep batch mode                                   *
+* Wake cycles only collect samples in the C016 cache      *
+* while WiFi stays off. Every N-th wake cycle (or when    *
+* requested via the "deepsleepsend" command) WiFi is      *
+* started to send the collected samples.                  *
+*                                                         *
+**********************************************************/
+bool deepSleepBatchEnabled();
+
+// Decide at boot whether this wake cycle only collects samples.
+void deepSleepBatch_initCycle();
+
+// This wake cycle only collects samples, WiFi must stay off.
+bool deepSleepBatch_sampleOnly();
+
+// Send the collected samples in this wake cycle, or in the next when WiFi is off.
+void deepSleepBatch_requestSend();
+
+#endif // if FEATURE_DEEP_SLEEP_BATCH
+
 
 #endif // HELPERS_DEEPSLEEP_H
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include "../Globals/RuntimeData.h"
 #include "../Globals/Settings.h"
 #include "../Helpers/CRC_functions.h"
+#include "../Helpers/StringConverter.h"
 #include "../../ESPEasy_common.h"
 
 #ifdef ESP8266
@@ -56,9 +57,10 @@
 // these offsets are in blocks, bytes = blocks * 4
 // 64   RTCStruct  max 40 bytes: ( 74 - 64 ) * 4
 // 74   UserVar
-// 122  UserVar checksum:  RTC_BASE_USERVAR + (TASKS_MAX * VARS_PER_TASK)
+// 122  UserVar checksums, 4 bits per task:  RTC_BASE_USERVAR + (TASKS_MAX * VARS_PER_TASK)
 // 128  Cache (C016) metadata  4 blocks
 // 132  Cache (C016) data  6 blocks per sample => max 10 samples
+// 188  Last WiFi DHCP lease  4 blocks
 
 
 
@@ -80,6 +82,7 @@
 // Structs stored in RTC SLOW:
 //   - RTCStruct to keep information on reboot reason, last used WiFi, etc.
 //   - UserVar   to keep task values persistent just like on ESP8266
+//   - Last WiFi DHCP lease
 
 
 
@@ -97,7 +100,8 @@ constexpr size_t UserVar_nrelements = VARS_PER_TASK * TASKS_MAX;
 // Thus we have to keep a copy here.
 RTC_NOINIT_ATTR RTCStruct RTC_tmp;
 RTC_NOINIT_ATTR uint32_t UserVar_RTC[UserVar_nrelements];
-RTC_NOINIT_ATTR uint32_t UserVar_checksum;
+RTC_NOINIT_ATTR uint32_t UserVar_checksum[TASKS_MAX];
+RTC_NOINIT_ATTR RTC_WiFiLease_t RTC_WiFiLease_tmp;
 #endif
 
 
@@ -125,6 +129,20 @@ bool saveToRTC()
   return true;
 }
 
+void saveLastPluginCallToRTC()
+{
+  #if defined(ESP32)
+  RTC_tmp.lastPluginCall = RTC.lastPluginCall;
+  #else // if defined(ESP32)
+  static_assert((offsetof(RTCStruct, lastPluginCall) % 4) == 0, "RTC_PluginCall_t must be aligned to RTC blocks");
+  static_assert((sizeof(RTC_PluginCall_t) % 4) == 0,           "RTC_PluginCall_t must be a multiple of RTC blocks");
+
+  system_rtc_mem_write(RTC_BASE_STRUCT + (offsetof(RTCStruct, lastPluginCall) / 4),
+                       reinterpret_cast<const uint8_t *>(&RTC.lastPluginCall),
+                       sizeof(RTC.lastPluginCall));
+  #endif // if defined(ESP32)
+}
+
 /********************************************************************************************\
    Initialize RTC memory
  \*********************************************************************************************/
@@ -157,72 +175,221 @@ bool readFromRTC()
 
 /********************************************************************************************\
    Save values to RTC memory
+   Task values are stored per task, each with its own checksum.
+   Only the tasks of which the values changed since the last save are written,
+   and on restore a corrupted task slot does not invalidate the values of other tasks.
  \*********************************************************************************************/
-bool saveUserVarToRTC()
+
+// Checksum of the task values as last written to RTC, to detect which tasks must be written.
+static uint32_t UserVar_RTC_taskCRC[TASKS_MAX] = { 0 };
+
+// Set when UserVar_RTC_taskCRC reflects the RTC content.
+static bool UserVar_RTC_taskCRC_valid = false;
+
+static uint32_t UserVar_task_CRC(taskIndex_t taskIndex, const uint8_t *data)
+{
+  // Include the task index, so task values written in the wrong slot will not be accepted.
+  return calc_CRC32(data, sizeof(TaskValues_Data_t::binary)) ^ taskIndex;
+}
+
+#ifdef ESP8266
+
+// ESP8266 has only 2 RTC blocks left for the checksums,
+// thus store 4 bits per task, folded from the CRC32 of the task values.
+// The task values are only restored when the RTC struct itself is valid, so this is enough to detect a corrupted slot.
+# define RTC_USERVAR_CHECKSUM_BLOCKS  ((TASKS_MAX + 7) / 8)
+# define RTC_BASE_USERVAR_CHECKSUM    (RTC_BASE_USERVAR + ((TASKS_MAX * sizeof(TaskValues_Data_t)) >> 2))
+
+static uint32_t UserVar_RTC_checksums[RTC_USERVAR_CHECKSUM_BLOCKS] = { 0 };
+
+static uint8_t UserVar_RTC_nibble(uint32_t crc)
+{
+  crc ^= crc >> 16;
+  crc ^= crc >> 8;
+  crc ^= crc >> 4;
+  return crc & 0x0F;
+}
+
+static uint8_t UserVar_RTC_getChecksum(taskIndex_t taskIndex)
+{
+  return (UserVar_RTC_checksums[taskIndex / 8] >> (4 * (taskIndex % 8))) & 0x0F;
+}
+
+static void UserVar_RTC_setChecksum(taskIndex_t taskIndex, uint32_t crc)
+{
+  const uint8_t shift = 4 * (taskIndex % 8);
+  uint32_t    & block = UserVar_RTC_checksums[taskIndex / 8];
+
+  block = (block & ~(0x0Ful << shift)) | (static_cast<uint32_t>(UserVar_RTC_nibble(crc)) << shift);
+}
+
+#endif // ifdef ESP8266
+
+static bool saveTaskUserVarToRTC(taskIndex_t taskIndex, bool& checksumsChanged)
 {
+  const TaskValues_Data_t *taskValues = UserVar.getTaskValues_Data(taskIndex);
+
+  if (taskValues == nullptr) {
+    return false;
+  }
+  const uint32_t crc = UserVar_task_CRC(taskIndex, taskValues->binary);
+
+  if (UserVar_RTC_taskCRC_valid && (UserVar_RTC_taskCRC[taskIndex] == crc)) {
+    // Not changed since last written
+    return true;
+  }
+  UserVar_RTC_taskCRC[taskIndex] = crc;
+  checksumsChanged               = true;
+
   // ESP8266 has the RTC struct stored in memory which we must actively fetch
   // ESP32   Uses a temp structure which is mapped to the RTC address range.
-  #if defined(ESP32)
-  for (taskIndex_t task = 0; task < TASKS_MAX; ++task) {
-    const TaskValues_Data_t* taskValues = UserVar.getTaskValues_Data(task);
-    if (taskValues != nullptr) {
-      for (uint8_t varNr = 0; varNr < VARS_PER_TASK; ++varNr) {
-        const size_t index = (task * VARS_PER_TASK) + varNr;
-        UserVar_RTC[index] = taskValues->getUint32(varNr);
-      }
-    }
-  }
-  UserVar_checksum = UserVar.compute_CRC32();
+  #ifdef ESP32
+  memcpy(&UserVar_RTC[taskIndex * VARS_PER_TASK], taskValues->binary, sizeof(TaskValues_Data_t::binary));
+  UserVar_checksum[taskIndex] = crc;
   return true;
-  #endif
+  #endif // ifdef ESP32
 
   #ifdef ESP8266
+  UserVar_RTC_setChecksum(taskIndex, crc);
+  return system_rtc_mem_write(
+    RTC_BASE_USERVAR + ((taskIndex * sizeof(TaskValues_Data_t)) >> 2),
+    taskValues->binary,
+    sizeof(TaskValues_Data_t::binary));
+  #endif // ifdef ESP8266
+}
+
+bool saveUserVarToRTC(taskIndex_t taskIndex)
+{
   // addLog(LOG_LEVEL_DEBUG, F("RTCMEM: saveUserVarToRTC"));
-  size_t   size{};
-  uint8_t *buffer    = UserVar.get(size);
-  const uint32_t sum = UserVar.compute_CRC32();
-  bool  ret    = system_rtc_mem_write(RTC_BASE_USERVAR, buffer, size);
-  ret &= system_rtc_mem_write(RTC_BASE_USERVAR + (size >> 2), reinterpret_cast<const uint8_t *>(&sum), 4);
+  bool ret              = true;
+  bool checksumsChanged = false;
+
+  if (validTaskIndex(taskIndex) && UserVar_RTC_taskCRC_valid) {
+    ret = saveTaskUserVarToRTC(taskIndex, checksumsChanged);
+  } else {
+    for (taskIndex_t task = 0; task < TASKS_MAX; ++task) {
+      ret &= saveTaskUserVarToRTC(task, checksumsChanged);
+    }
+    UserVar_RTC_taskCRC_valid = true;
+  }
+
+  #ifdef ESP8266
+
+  if (checksumsChanged) {
+    if (validTaskIndex(taskIndex)) {
+      // Only the block holding the checksum of this task
+      ret &= system_rtc_mem_write(
+        RTC_BASE_USERVAR_CHECKSUM + (taskIndex / 8),
+        reinterpret_cast<const uint8_t *>(&UserVar_RTC_checksums[taskIndex / 8]),
+        4);
+    } else {
+      ret &= system_rtc_mem_write(
+        RTC_BASE_USERVAR_CHECKSUM,
+        reinterpret_cast<const uint8_t *>(&UserVar_RTC_checksums[0]),
+        sizeof(UserVar_RTC_checksums));
+    }
+  }
+  #endif // ifdef ESP8266
   return ret;
-  #endif
 }
 
-/********************************************************************************************\
-   Read RTC struct from RTC memory
- \*********************************************************************************************/
 bool readUserVarFromRTC()
 {
   // ESP8266 has the RTC struct stored in memory which we must actively fetch
   // ESP32   Uses a temp structure which is mapped to the RTC address range.
-  #if defined(ESP32)
-  if (calc_CRC32(reinterpret_cast<const uint8_t *>(&UserVar_RTC[0]), UserVar_nrelements * sizeof(float)) == UserVar_checksum) {
-    for (size_t i = 0; i < UserVar_nrelements; ++i) {
-      const taskIndex_t taskIndex = i / VARS_PER_TASK;
-      const uint8_t varNr = i % VARS_PER_TASK;
-      UserVar.setUint32(taskIndex, varNr, UserVar_RTC[i]);
-    }
-    return true;
-  }
-  return false;
-  #endif
-
   #ifdef ESP8266
   // addLog(LOG_LEVEL_DEBUG, F("RTCMEM: readUserVarFromRTC"));
   size_t   size{};
   uint8_t *buffer = UserVar.get(size);
-  bool ret        = system_rtc_mem_read(RTC_BASE_USERVAR, buffer, size);
-  uint32_t sumRAM = UserVar.compute_CRC32();
-  uint32_t sumRTC = 0;
-  ret &= system_rtc_mem_read(RTC_BASE_USERVAR + (size >> 2), reinterpret_cast<uint8_t *>(&sumRTC), 4);
 
-  if (!ret || (sumRTC != sumRAM))
-  {
+  if (!system_rtc_mem_read(RTC_BASE_USERVAR, buffer, size) ||
+      !system_rtc_mem_read(RTC_BASE_USERVAR_CHECKSUM,
+                           reinterpret_cast<uint8_t *>(&UserVar_RTC_checksums[0]),
+                           sizeof(UserVar_RTC_checksums))) {
+    UserVar.clear();
+    UserVar_RTC_taskCRC_valid = false;
+    return false;
+  }
+  #endif // ifdef ESP8266
+
+  uint8_t nrRestored = 0;
+
+  for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; ++taskIndex) {
+    TaskValues_Data_t *taskValues = UserVar.getTaskValues_Data(taskIndex);
+
+    if (taskValues == nullptr) { continue; }
+
+    #ifdef ESP32
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(&UserVar_RTC[taskIndex * VARS_PER_TASK]);
+    const uint32_t crc  = UserVar_task_CRC(taskIndex, data);
+    const bool     valid = (crc == UserVar_checksum[taskIndex]);
+
+    if (valid) {
+      memcpy(taskValues->binary, data, sizeof(TaskValues_Data_t::binary));
+    }
+    #endif // ifdef ESP32
+    #ifdef ESP8266
+    const uint32_t crc   = UserVar_task_CRC(taskIndex, taskValues->binary);
+    const bool     valid = (UserVar_RTC_nibble(crc) == UserVar_RTC_getChecksum(taskIndex));
+    #endif // ifdef ESP8266
+
+    if (valid) {
+      ++nrRestored;
+    } else {
       # ifdef RTC_STRUCT_DEBUG
-    addLog(LOG_LEVEL_ERROR, F("RTC  : Checksum error on reading RTC user var"));
+      addLog(LOG_LEVEL_ERROR, concat(F("RTC  : Checksum error on reading RTC user var of task "), taskIndex + 1));
       # endif // ifdef RTC_STRUCT_DEBUG
-    memset(buffer, 0, size);
+      taskValues->clear();
+    }
+
+    // Force writing the slot of a corrupted task on the next save
+    UserVar_RTC_taskCRC[taskIndex] = valid ? crc : ~crc;
   }
-  return ret;
-  #endif 
+  UserVar_RTC_taskCRC_valid = true;
+  return nrRestored > 0;
+}
+
+
+/********************************************************************************************\
+   Save last WiFi DHCP lease to RTC memory
+ \*********************************************************************************************/
+bool saveWiFiLeaseToRTC(const RTC_WiFiLease_t& lease, uint8_t prefixLength)
+{
+  #ifdef ESP8266
+  static_assert(RTC_BASE_WIFI_LEASE >= RTC_BASE_CACHE + 4 + (RTC_CACHE_DATA_SIZE / 4), "WiFi lease overlaps RTC cache");
+  static_assert(RTC_BASE_WIFI_LEASE + (sizeof(RTC_WiFiLease_t) / 4) <= 192, "WiFi lease exceeds RTC user memory");
+
+  if (!system_rtc_mem_write(RTC_BASE_WIFI_LEASE, reinterpret_cast<const uint8_t *>(&lease), sizeof(lease))) {
+    return false;
+  }
+  #endif // ifdef ESP8266
+  #ifdef ESP32
+  RTC_WiFiLease_tmp = lease;
+  #endif // ifdef ESP32
+  RTC.lastWiFiLeasePrefix   = prefixLength;
+  RTC.lastWiFiLeaseChecksum = calc_CRC8(reinterpret_cast<const uint8_t *>(&lease), sizeof(lease));
+  return saveToRTC();
 }
 
+/********************************************************************************************\
+   Read last WiFi DHCP lease from RTC memory
+ \*********************************************************************************************/
+bool readWiFiLeaseFromRTC(RTC_WiFiLease_t& lease, uint8_t& prefixLength)
+{
+  prefixLength = RTC.lastWiFiLeasePrefix;
+
+  if ((prefixLength == 0) || (prefixLength > 30)) {
+    return false;
+  }
+  #ifdef ESP8266
+
+  if (!system_rtc_mem_read(RTC_BASE_WIFI_LEASE, reinterpret_cast<uint8_t *>(&lease), sizeof(lease))) {
+    return false;
+  }
+  #endif // ifdef ESP8266
+  #ifdef ESP32
+  lease = RTC_WiFiLease_tmp;
+  #endif // ifdef ESP32
+  return lease.ip != 0 &&
+         RTC.lastWiFiLeaseChecksum == calc_CRC8(reinterpret_cast<const uint8_t *>(&lease), sizeof(lease));
+}
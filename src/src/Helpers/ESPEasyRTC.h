@@ -1,8 +1,16 @@
 #ifndef HELPERS_ESPEASYRTC_H
 #define HELPERS_ESPEASYRTC_H
 
+#include "../DataStructs/RTCStruct.h"
+#include "../DataTypes/TaskIndex.h"
+
 bool saveToRTC();
 
+/********************************************************************************************\
+   Save only RTC.lastPluginCall to RTC memory, fast enough to call for each plugin call
+ \*********************************************************************************************/
+void saveLastPluginCallToRTC();
+
 /********************************************************************************************\
    Initialize RTC memory
  \*********************************************************************************************/
@@ -15,13 +23,30 @@ bool readFromRTC();
 
 /********************************************************************************************\
    Save values to RTC memory
+   Only the values of tasks which changed since the last save are written.
+   taskIndex: Only check this task, INVALID_TASK_INDEX to check all tasks.
  \*********************************************************************************************/
-bool saveUserVarToRTC();
+bool saveUserVarToRTC(taskIndex_t taskIndex = INVALID_TASK_INDEX);
 
 /********************************************************************************************\
-   Read RTC struct from RTC memory
+   Read task values from RTC memory
+   Each task is validated by its own checksum, the values of a corrupted task are cleared.
+   @retval true when the values of at least one task were restored.
  \*********************************************************************************************/
 bool readUserVarFromRTC();
 
+/********************************************************************************************\
+   Save last WiFi DHCP lease to RTC memory, also saves the RTC struct
+ \*********************************************************************************************/
+bool saveWiFiLeaseToRTC(const RTC_WiFiLease_t& lease,
+                        uint8_t                prefixLength);
+
+/********************************************************************************************\
+   Read last WiFi DHCP lease from RTC memory
+   @retval false when not set or the checksum does not match.
+ \*********************************************************************************************/
+bool readWiFiLeaseFromRTC(RTC_WiFiLease_t& lease,
+                          uint8_t        & prefixLength);
+
 
 #endif
\ No newline at end of file
@@ -4,6 +4,7 @@
 #if FEATURE_TIMING_STATS
 
 #include "../DataStructs/TimingStats.h"
+#include "../Globals/Cache.h"
 #include "../WebServer/ESPEasy_WebServer.h"
 #include "../Helpers/Convert.h"
 #include "../Helpers/_Plugin_init.h"
@@ -19,6 +20,11 @@ void stream_json_timing_stats(const TimingStats& stats, long timeSinceLastReset)
   json_number(F("min"),   ull2String(minVal));
   json_number(F("max"),   ull2String(maxVal));
   json_number(F("avg"),   toString(stats.getAvg(), 2));
+  #if FEATURE_TIMING_STATS_HISTOGRAM
+  json_number(F("p50"),   toString(stats.getPercentile(50), 2));
+  json_number(F("p90"),   toString(stats.getPercentile(90), 2));
+  json_number(F("p99"),   toString(stats.getPercentile(99), 2));
+  #endif // if FEATURE_TIMING_STATS_HISTOGRAM
   json_prop(F("unit"), F("usec"));
 }
 
@@ -135,9 +141,35 @@ void jsonStatistics(bool clearStats) {
     pluginStats.clear();
     controllerStats.clear();
     miscStats.clear();
+    schedulerLatenessStats.clear();
     timingstats_last_reset = millis();
   }
 }
 
+#if FEATURE_RULES_PROFILING
+void jsonRulesStatistics() {
+  const RulesEventCache& cache = Cache.rulesHelper.getEventCache();
+
+  json_open(true, F("rules"));
+
+  for (auto it = cache.begin(); it != cache.end(); ++it) {
+    const RulesEventCache_profile& profile = it->_profile;
+    json_open();
+    json_prop(F("file"),  it->_filename);
+    json_prop(F("event"), it->_event);
+    json_number(F("matched"),        String(it->_nrTimesMatched));
+    json_number(F("total"),          ull2String(profile._totalDuration_usec));
+    json_number(F("max"),            String(profile._maxDuration_usec));
+    json_number(F("commands"),       String(profile._nrCommands));
+    json_number(F("heap-delta"),     String(profile._heapDeltaTotal));
+    json_number(F("heap-delta-min"), String(profile._heapDeltaMin));
+    json_prop(F("unit"), F("usec"));
+    json_close();
+  }
+  json_close(true);
+}
+
+#endif // if FEATURE_RULES_PROFILING
+
 
 #endif // if FEATURE_TIMING_STATS
\ No newline at end of file
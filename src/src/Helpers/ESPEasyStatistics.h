@@ -15,6 +15,12 @@ void stream_json_timing_stats(const TimingStats& stats, long timeSinceLastReset)
 
 void jsonStatistics(bool clearStats);
 
+#if FEATURE_RULES_PROFILING
+
+// Execution statistics per rules block
+void jsonRulesStatistics();
+#endif // if FEATURE_RULES_PROFILING
+
 #endif // if FEATURE_TIMING_STATS
 
 
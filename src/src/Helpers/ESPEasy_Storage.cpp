@@ -5,6 +5,8 @@
 #include "../CustomBuild/CompiletimeDefines.h"
 #include "../CustomBuild/StorageLayout.h"
 
+#include "../DataStructs/SettingsFileMirror.h"
+#include "../DataStructs/SettingsWriteBack.h"
 #include "../DataStructs/TimingStats.h"
 
 #include "../DataTypes/ESPEasyFileType.h"
@@ -46,6 +48,7 @@
 #include "../Helpers/Networking.h"
 #include "../Helpers/Numerical.h"
 #include "../Helpers/PeriodicalActions.h"
+#include "../Helpers/PowerManagement.h"
 #include "../Helpers/StringConverter.h"
 #include "../Helpers/StringParser.h"
 
@@ -77,15 +80,34 @@ String FileError(int line, const char *fname)
   return log;
 }
 
+#if FEATURE_SETTINGS_WRITEBACK
+SettingsWriteBack_struct SettingsWriteBack;
+#endif // if FEATURE_SETTINGS_WRITEBACK
+#if FEATURE_SETTINGS_PSRAM_MIRROR
+SettingsFileMirror_struct SettingsFileMirror;
+
+bool loadSettingsFileMirror(const char *fname);
+#endif // if FEATURE_SETTINGS_PSRAM_MIRROR
+
+// Open a file without committing the buffered settings writes first.
+fs::File tryOpenFile_noCommit(const String& fname, const String& mode, FileDestination_e destination);
+
+// Read from the file system, not using any buffered data.
+String LoadFromFile_FS(const char *fname, int offset, uint8_t *memAddress, int datasize);
+
 /********************************************************************************************\
    Keep track of number of flash writes.
  \*********************************************************************************************/
-void flashCount()
+void flashCount(unsigned int count)
 {
+  if (count == 0) {
+    return;
+  }
+
   if (RTC.flashDayCounter <= MAX_FLASHWRITES_PER_DAY) {
-    RTC.flashDayCounter++;
+    RTC.flashDayCounter += count;
   }
-  RTC.flashCounter++;
+  RTC.flashCounter += count;
   saveToRTC();
 }
 
@@ -133,6 +155,15 @@ bool fileExists(const String& fname) {
   HeapSelectDram ephemeral;
   #endif
 
+  if (Cache.fileCacheClearMoment == 0) {
+    if (node_time.timeSource == timeSource_t::No_time_source) {
+      // use some random value as we don't have a time yet
+      Cache.fileCacheClearMoment = HwRandom();
+    } else {
+      Cache.fileCacheClearMoment = node_time.now();
+    }
+  }
+
   const String patched_fname = patch_fname(fname);
   auto search = Cache.fileExistsMap.find(patched_fname);
   if (search != Cache.fileExistsMap.end()) {
@@ -152,31 +183,42 @@ bool fileExists(const String& fname) {
   {
     Cache.fileExistsMap[patched_fname] = res;
   }
-  if (Cache.fileCacheClearMoment == 0) {
-    if (node_time.timeSource == timeSource_t::No_time_source) {
-      // use some random value as we don't have a time yet
-      Cache.fileCacheClearMoment = HwRandom();
-    } else {
-      Cache.fileCacheClearMoment = node_time.now();
-    }
-  }
   return res;
 }
 
 fs::File tryOpenFile(const String& fname, const String& mode, FileDestination_e destination) {
+#if FEATURE_SETTINGS_WRITEBACK
+
+  // Make sure the file is up to date for anyone else accessing it.
+  if (SettingsWriteBack.isDirty() && SettingsWriteBack.isDirty(patch_fname(fname))) {
+    commitSettingsWriteBack();
+  }
+#endif // if FEATURE_SETTINGS_WRITEBACK
+  return tryOpenFile_noCommit(fname, mode, destination);
+}
+
+fs::File tryOpenFile_noCommit(const String& fname, const String& mode, FileDestination_e destination) {
   START_TIMER;
   fs::File f;
   if (fname.isEmpty() || equals(fname, '/')) {
     return f;
   }
+#if FEATURE_SETTINGS_PSRAM_MIRROR
+
+  // Any write to a file makes its mirror invalid.
+  if (!SettingsFileMirror.isEmpty() && !equals(mode, 'r')) {
+    SettingsFileMirror.invalidate(patch_fname(fname));
+  }
+#endif // if FEATURE_SETTINGS_PSRAM_MIRROR
 
   bool exists = fileExists(fname);
 
-  if (!exists) {
-    if (equals(mode, 'r')) {
-      return f;
-    }
-    clearFileCaches();
+  if (!exists && equals(mode, 'r')) {
+    return f;
+  }
+  if (!equals(mode, 'r')) {
+    // File may be created or changed
+    Cache.invalidateFileCache(patch_fname(fname));
   }
   if ((destination == FileDestination_e::ANY) || (destination == FileDestination_e::FLASH)) {
     f = ESPEASY_FS.open(patch_fname(fname), mode.c_str());
@@ -199,12 +241,21 @@ bool fileMatchesTaskSettingsType(const String& fname) {
 }
 
 bool tryRenameFile(const String& fname_old, const String& fname_new, FileDestination_e destination) {
-  clearFileCaches();
+  #if FEATURE_SETTINGS_WRITEBACK
+  if (SettingsWriteBack.isDirty(patch_fname(fname_old))) {
+    commitSettingsWriteBack();
+  }
+  #endif // if FEATURE_SETTINGS_WRITEBACK
+  #if FEATURE_SETTINGS_PSRAM_MIRROR
+  SettingsFileMirror.invalidate(patch_fname(fname_old));
+  SettingsFileMirror.invalidate(patch_fname(fname_new));
+  #endif // if FEATURE_SETTINGS_PSRAM_MIRROR
   if (fileExists(fname_old) && !fileExists(fname_new)) {
     if (fileMatchesTaskSettingsType(fname_old)) {
       clearAllCaches();
     } else {
-      clearAllButTaskCaches();
+      clearAllButTaskCaches(fname_old);
+      Cache.invalidateFileCache(patch_fname(fname_new));
     }
     bool res = false;
     if ((destination == FileDestination_e::ANY) || (destination == FileDestination_e::FLASH)) {
@@ -228,10 +279,16 @@ bool tryDeleteFile(const String& fname, FileDestination_e destination) {
       ControllerCache.closeOpenFiles();
     }
     #endif
+    #if FEATURE_SETTINGS_WRITEBACK
+    SettingsWriteBack.discard(patch_fname(fname));
+    #endif // if FEATURE_SETTINGS_WRITEBACK
+    #if FEATURE_SETTINGS_PSRAM_MIRROR
+    SettingsFileMirror.invalidate(patch_fname(fname));
+    #endif // if FEATURE_SETTINGS_PSRAM_MIRROR
     if (fileMatchesTaskSettingsType(fname)) {
       clearAllCaches();
     } else {
-      clearAllButTaskCaches();
+      clearAllButTaskCaches(fname);
     }
     bool res = false;
     if ((destination == FileDestination_e::ANY) || (destination == FileDestination_e::FLASH)) {
@@ -401,6 +458,29 @@ bool BuildFixes()
     bitWrite(Settings.VariousBits1, 15, 0);
   }
   #endif
+  if (Settings.Build < 21719) {
+    // OLD_TaskDeviceID is now used for send on change settings, clear old IDX values
+    for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; ++taskIndex) {
+      Settings.TaskSendOnChange[taskIndex] = 0u;
+    }
+  }
+
+  if (Settings.StructSize <= offsetof(SettingsStruct, I2C2_clockSpeed)) {
+    // Settings of the 2nd I2C bus were not yet stored
+    Settings.I2C2_clockSpeed = DEFAULT_I2C2_CLOCK_SPEED;
+    Settings.Pin_i2c2_sda    = -1;
+    Settings.Pin_i2c2_scl    = -1;
+  }
+
+  if (Settings.StructSize <= offsetof(SettingsStruct, P2P_MulticastGroup)) {
+    // Use broadcast for the p2p network, like before
+    ZERO_FILL(Settings.P2P_MulticastGroup);
+  }
+
+  if (Settings.StructSize <= offsetof(SettingsStruct, deepSleep_batchCycles)) {
+    // Connect on every wake cycle, like before
+    Settings.deepSleep_batchCycles = 0;
+  }
 
   // Starting 2022/08/18
   // Use get_build_nr() value for settings transitions.
@@ -464,6 +544,12 @@ void fileSystemCheck()
 }
 
 bool FS_format() {
+  #if FEATURE_SETTINGS_WRITEBACK
+  SettingsWriteBack.clear();
+  #endif // if FEATURE_SETTINGS_WRITEBACK
+  #if FEATURE_SETTINGS_PSRAM_MIRROR
+  SettingsFileMirror.invalidateAll();
+  #endif // if FEATURE_SETTINGS_PSRAM_MIRROR
   #ifdef USE_LITTLEFS
     #ifdef ESP32
     const bool res = ESPEASY_FS.begin(true);
@@ -668,9 +754,7 @@ void afterloadSettings() {
     ResetFactoryDefaultPreference = pref_temp;
   }
   Scheduler.setEcoMode(Settings.EcoPowerMode());
-  #ifdef ESP32
-  setCpuFrequencyMhz(Settings.EcoPowerMode() ? 80 : 240);
-  #endif
+  PowerManagement_configure(Settings.EcoPowerMode());
 
   if (!Settings.UseRules) {
     eventQueue.clear();
@@ -757,6 +841,7 @@ uint8_t disablePlugin(uint8_t bootFailedCount) {
         // Disable temporarily as unit crashed
         // FIXME TD-er: Should this be stored?
         Settings.TaskDeviceEnabled[i] = false;
+        Cache.invalidateEnabledTasks();
       }
     }
   }
@@ -771,6 +856,7 @@ uint8_t disableAllPlugins(uint8_t bootFailedCount) {
         // FIXME TD-er: Should this be stored?
         Settings.TaskDeviceEnabled[i] = false;
     }
+    Cache.invalidateEnabledTasks();
   }
   return bootFailedCount;
 }
@@ -1116,6 +1202,12 @@ String LoadTaskSettings(taskIndex_t TaskIndex)
 //    Cache.updateExtraTaskSettingsCache_afterLoad_Save();
     return EMPTY_STRING;
   }
+  #if FEATURE_EXTRA_TASK_SETTINGS_LRU
+  if (Cache.loadExtraTaskSettingsFromLRU(TaskIndex)) {
+    STOP_TIMER(LOAD_TASK_SETTINGS_C);
+    return EMPTY_STRING;
+  }
+  #endif // if FEATURE_EXTRA_TASK_SETTINGS_LRU
   #ifndef BUILD_NO_RAM_TRACKER
   checkRAM(F("LoadTaskSettings"));
   #endif
@@ -1139,6 +1231,11 @@ String LoadTaskSettings(taskIndex_t TaskIndex)
   
   ExtraTaskSettings.validate();
   Cache.updateExtraTaskSettingsCache_afterLoad_Save();
+  #if FEATURE_EXTRA_TASK_SETTINGS_LRU
+  if (result.isEmpty()) {
+    Cache.storeExtraTaskSettingsInLRU();
+  }
+  #endif // if FEATURE_EXTRA_TASK_SETTINGS_LRU
   STOP_TIMER(LOAD_TASK_SETTINGS);
 
   return result;
@@ -1389,6 +1486,11 @@ String InitFile(const String& fname, int datasize)
   checkRAM(F("InitFile"));
   #endif
   FLASH_GUARD();
+  #if FEATURE_SETTINGS_WRITEBACK
+
+  // File will be truncated, so pending writes are no longer relevant.
+  SettingsWriteBack.discard(patch_fname(fname));
+  #endif // if FEATURE_SETTINGS_WRITEBACK
 
   fs::File f = tryOpenFile(fname, "w");
 
@@ -1422,14 +1524,119 @@ String InitFile(SettingsType::SettingsFileEnum file_type)
  \*********************************************************************************************/
 String SaveToFile(const char *fname, int index, const uint8_t *memAddress, int datasize)
 {
+  #if FEATURE_SETTINGS_WRITEBACK
+  if ((index >= 0) && (datasize > 0)) {
+    return bufferSaveToFile(fname, index, memAddress, datasize);
+  }
+  #endif // if FEATURE_SETTINGS_WRITEBACK
   return doSaveToFile(fname, index, memAddress, datasize, "r+");
 }
 
 String SaveToFile_trunc(const char *fname, int index, const uint8_t *memAddress, int datasize)
 {
+  #if FEATURE_SETTINGS_WRITEBACK
+  SettingsWriteBack.discard(patch_fname(fname));
+  #endif // if FEATURE_SETTINGS_WRITEBACK
   return doSaveToFile(fname, index, memAddress, datasize, "w+");
 }
 
+#if FEATURE_SETTINGS_WRITEBACK
+String bufferSaveToFile(const char *fname, int index, const uint8_t *memAddress, int datasize)
+{
+  if (RTC.flashDayCounter > MAX_FLASHWRITES_PER_DAY) {
+    // Log the error, without counting
+    return flashGuard();
+  }
+
+  if (!fileExists(fname)) {
+    // Let doSaveToFile report the error
+    return doSaveToFile(fname, index, memAddress, datasize, "r+");
+  }
+
+  if (!SettingsWriteBack.fits(datasize)) {
+    commitSettingsWriteBack();
+
+    if (!SettingsWriteBack.fits(datasize)) {
+      // Too large to buffer
+      return doSaveToFile(fname, index, memAddress, datasize, "r+");
+    }
+  }
+  clearAllButTaskCaches(fname);
+  SettingsWriteBack.add(patch_fname(fname), index, memAddress, datasize);
+  #ifndef BUILD_NO_DEBUG
+  if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+    addLogMove(LOG_LEVEL_DEBUG, strformat(
+      F("FILE : Buffered %s offset: %d size: %d"), fname, index, datasize));
+  }
+  #endif
+  return EMPTY_STRING;
+}
+
+String commitSettingsWriteBack()
+{
+  if (!SettingsWriteBack.isDirty()) {
+    return EMPTY_STRING;
+  }
+  START_TIMER;
+  String err;
+  const std::vector<SettingsWriteBack_range>& ranges = SettingsWriteBack.getRanges();
+  size_t i = 0;
+
+  while (i < ranges.size()) {
+    // Write all ranges of a single file in one pass, sorted by offset.
+    const String fname = ranges[i].fname;
+    fs::File     f     = tryOpenFile_noCommit(fname, F("r+"), FileDestination_e::ANY);
+    unsigned int nrErases   = 0;
+    int          lastSector = -1;
+
+    for (; i < ranges.size() && ranges[i].fname.equals(fname); ++i) {
+      const SettingsWriteBack_range& range = ranges[i];
+
+      if (!f || !f.seek(range.offset, fs::SeekSet) ||
+          (f.write(range.data.data(), range.data.size()) != range.data.size())) {
+        err = FileError(__LINE__, fname.c_str());
+        continue;
+      }
+
+      // Estimate the nr of flash sectors which need to be erased for this write.
+      int       firstSector = range.offset / SETTINGS_WRITEBACK_SECTOR_SIZE;
+      const int lastInRange = (range.end() - 1) / SETTINGS_WRITEBACK_SECTOR_SIZE;
+
+      if (firstSector == lastSector) {
+        ++firstSector;
+      }
+
+      if (lastInRange >= firstSector) {
+        nrErases += lastInRange - firstSector + 1;
+      }
+      lastSector = lastInRange;
+      delay(0);
+    }
+
+    if (f) {
+      f.close();
+    }
+    flashCount(nrErases);
+    #ifndef BUILD_NO_DEBUG
+    if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+      addLogMove(LOG_LEVEL_INFO, strformat(
+        F("FILE : Committed %s sectors: %d"), fname.c_str(), nrErases));
+    }
+    #endif
+  }
+  SettingsWriteBack.clear();
+  STOP_TIMER(SAVEFILE_STATS);
+  return err;
+}
+
+void processSettingsWriteBack()
+{
+  if (SettingsWriteBack.commitDue()) {
+    commitSettingsWriteBack();
+  }
+}
+#endif // if FEATURE_SETTINGS_WRITEBACK
+
 // See for mode description: https://github.com/esp8266/Arduino/blob/master/doc/filesystem.rst
 String doSaveToFile(const char *fname, int index, const uint8_t *memAddress, int datasize, const char *mode)
 {
@@ -1476,7 +1683,7 @@ String doSaveToFile(const char *fname, int index, const uint8_t *memAddress, int
   fs::File f          = tryOpenFile(fname, mode);
 
   if (f) {
-    clearAllButTaskCaches();
+    clearAllButTaskCaches(fname);
     SPIFFS_CHECK(f,                          fname);
     SPIFFS_CHECK(f.seek(index, fs::SeekSet), fname);
     const uint8_t *pointerToByteToSave = memAddress;
@@ -1559,6 +1766,14 @@ String ClearInFile(const char *fname, int index, int datasize)
   #ifndef BUILD_NO_RAM_TRACKER
   checkRAM(F("ClearInFile"));
   #endif
+  #if FEATURE_SETTINGS_WRITEBACK
+  if ((datasize > 0) && fileExists(fname) && SettingsWriteBack.fits(datasize) &&
+      (RTC.flashDayCounter <= MAX_FLASHWRITES_PER_DAY)) {
+    clearAllButTaskCaches(fname);
+    SettingsWriteBack.add(patch_fname(fname), index, nullptr, datasize);
+    return EMPTY_STRING;
+  }
+  #endif // if FEATURE_SETTINGS_WRITEBACK
   FLASH_GUARD();
 
   fs::File f = tryOpenFile(fname, "r+");
@@ -1610,8 +1825,63 @@ String LoadFromFile(const char *fname, int offset, uint8_t *memAddress, int data
   #ifndef BUILD_NO_RAM_TRACKER
   checkRAM(F("LoadFromFile"));
   #endif
-  
-  fs::File f = tryOpenFile(fname, "r");
+  #if FEATURE_SETTINGS_WRITEBACK
+  const int requested_size = datasize;
+  #endif // if FEATURE_SETTINGS_WRITEBACK
+  #if FEATURE_SETTINGS_PSRAM_MIRROR
+
+  if (!SettingsFileMirror.read(patch_fname(fname), offset, memAddress, datasize)) {
+    if (!loadSettingsFileMirror(fname)) {
+      const String err = LoadFromFile_FS(fname, offset, memAddress, datasize);
+
+      if (!err.isEmpty()) {
+        return err;
+      }
+    } else {
+      SettingsFileMirror.read(patch_fname(fname), offset, memAddress, datasize);
+    }
+  }
+  #else // if FEATURE_SETTINGS_PSRAM_MIRROR
+  {
+    const String err = LoadFromFile_FS(fname, offset, memAddress, datasize);
+
+    if (!err.isEmpty()) {
+      return err;
+    }
+  }
+  #endif // if FEATURE_SETTINGS_PSRAM_MIRROR
+  #if FEATURE_SETTINGS_WRITEBACK
+  SettingsWriteBack.overlay(patch_fname(fname), offset, memAddress, requested_size);
+  #endif // if FEATURE_SETTINGS_WRITEBACK
+
+  STOP_TIMER(LOADFILE_STATS);
+  delay(0);
+
+  return EMPTY_STRING;
+}
+
+#if FEATURE_SETTINGS_PSRAM_MIRROR
+bool loadSettingsFileMirror(const char *fname)
+{
+  if (!UsePSRAM()) {
+    return false;
+  }
+  fs::File f = tryOpenFile_noCommit(fname, "r", FileDestination_e::ANY);
+
+  if (!f || !SettingsFileMirror.canMirror(f.size())) {
+    return false;
+  }
+  const bool res = SettingsFileMirror.load(patch_fname(fname), f);
+
+  f.close();
+  return res;
+}
+#endif // if FEATURE_SETTINGS_PSRAM_MIRROR
+
+String LoadFromFile_FS(const char *fname, int offset, uint8_t *memAddress, int datasize)
+{
+  // Buffered writes are applied by the caller, no need to commit them first.
+  fs::File f = tryOpenFile_noCommit(fname, "r", FileDestination_e::ANY);
   SPIFFS_CHECK(f,                            fname);
   const int fileSize = f.size();
   if (fileSize > offset) {
@@ -1628,10 +1898,6 @@ String LoadFromFile(const char *fname, int offset, uint8_t *memAddress, int data
     SPIFFS_CHECK(f.read(memAddress, datasize), fname);
   }
   f.close();
-
-  STOP_TIMER(LOADFILE_STATS);
-  delay(0);
-
   return EMPTY_STRING;
 }
 
@@ -1836,6 +2102,19 @@ String createCacheFilename(unsigned int count) {
   return fname;
 }
 
+String createCacheIndexFilename(unsigned int count) {
+  String fname;
+
+  fname.reserve(16);
+  #ifdef ESP32
+  fname = '/';
+  #endif // ifdef ESP32
+  fname += F("cache_");
+  fname += String(count);
+  fname += F(".idx");
+  return fname;
+}
+
 // Match string with an integer between '_' and ".bin"
 int getCacheFileCountFromFilename(const String& fname) {
   if (!isCacheFile(fname)) return -1;
@@ -1905,7 +2184,7 @@ bool getCacheFileCounters(uint16_t& lowest, uint16_t& highest, size_t& filesizeH
             filesizeHighest = file.size();
           }
 #ifndef BUILD_NO_DEBUG
-        } else {
+        } else if (!fname.endsWith(F(".idx"))) {
           addLog(LOG_LEVEL_INFO, concat(F("RTC  : Cannot get count from: "), fname));
 #endif
         }
@@ -2018,6 +2297,13 @@ String getPartitionTable(uint8_t pType, const String& itemSep, const String& lin
 
 #if FEATURE_DOWNLOAD
 String downloadFileType(const String& url, const String& user, const String& pass, FileType::Enum filetype, unsigned int filenr)
+{
+  DownloadFile_session session;
+
+  return downloadFileType(session, url, user, pass, filetype, filenr);
+}
+
+String downloadFileType(DownloadFile_session& session, const String& url, const String& user, const String& pass, FileType::Enum filetype, unsigned int filenr)
 {
   if (!getDownloadFiletypeChecked(filetype, filenr)) {
     // Not selected, so not downloaded
@@ -2028,53 +2314,58 @@ String downloadFileType(const String& url, const String& user, const String& pas
   String fullUrl = joinUrlFilename(url, filename);
   String error;
 
+  // Always download to a tmp file, which is kept on failure to resume the download on the next attempt.
+  String tmpfile = filename;
+  tmpfile += F("_tmp");
+
+  String etag;
+
   if (ResetFactoryDefaultPreference.deleteFirst()) {
+    // Make room on the file system, thus not possible to skip an unchanged file.
     if (fileExists(filename) && !tryDeleteFile(filename)) {
       return F("Could not delete existing file");
     }
+    tryDeleteFile(getDownloadETagFilename(filename));
+  } else if (fileExists(filename)) {
+    etag = readDownloadETag(filename);
+  }
 
-    if (!downloadFile(fullUrl, filename, user, pass, error)) {
+  switch (downloadFile(session, fullUrl, tmpfile, user, pass, etag, error)) {
+    case DownloadFile_result::Success:
+      break;
+    case DownloadFile_result::Unchanged: // No error, nothing to replace
+    case DownloadFile_result::Error:
       return error;
-    }
-  } else {
-    if (fileExists(filename)) {
-      String filename_bak = filename;
-      filename_bak += F("_bak");
-      if (fileExists(filename_bak)) {
-        if (!ResetFactoryDefaultPreference.delete_Bak_Files() || !tryDeleteFile(filename_bak)) {
-          return F("Could not rename to _bak");
-        }
+  }
+
+  if (fileExists(filename)) {
+    String filename_bak = filename;
+    filename_bak += F("_bak");
+    if (fileExists(filename_bak)) {
+      if (!ResetFactoryDefaultPreference.delete_Bak_Files() || !tryDeleteFile(filename_bak)) {
+        return F("Could not rename to _bak");
       }
+    }
 
-      // Must download it to a tmp file.
-      String tmpfile = filename;
-      tmpfile += F("_tmp");
+    if (!tryRenameFile(filename, filename_bak)) {
+      return F("Could not rename to _bak");
+    }
+    tryDeleteFile(getDownloadETagFilename(filename));
 
-      if (!downloadFile(fullUrl, tmpfile, user, pass, error)) {
-        return error;
-      }
+    if (!tryRenameFile(tmpfile, filename)) {
+      error = F("Could not rename tmp file");
 
-      if (fileExists(filename) && !tryRenameFile(filename, filename_bak)) {
-        return F("Could not rename to _bak");
+      if (tryRenameFile(filename_bak, filename)) {
+        error += F("... reverted");
       } else {
-        // File does not exist (anymore)
-        if (!tryRenameFile(tmpfile, filename)) {
-          error = F("Could not rename tmp file");
-
-          if (tryRenameFile(filename_bak, filename)) {
-            error += F("... reverted");
-          } else {
-            error += F(" Not reverted!");
-          }
-          return error;
-        }
-      }
-    } else {
-      if (!downloadFile(fullUrl, filename, user, pass, error)) {
-        return error;
+        error += F(" Not reverted!");
       }
+      return error;
     }
+  } else if (!tryRenameFile(tmpfile, filename)) {
+    return F("Could not rename tmp file");
   }
+  tryRenameFile(getDownloadETagFilename(tmpfile), getDownloadETagFilename(filename));
   return error;
 }
 
@@ -2083,6 +2374,13 @@ String downloadFileType(const String& url, const String& user, const String& pas
 #if FEATURE_CUSTOM_PROVISIONING
 
 String downloadFileType(FileType::Enum filetype, unsigned int filenr)
+{
+  DownloadFile_session session;
+
+  return downloadFileType(session, filetype, filenr);
+}
+
+String downloadFileType(DownloadFile_session& session, FileType::Enum filetype, unsigned int filenr)
 {
   String url, user, pass;
 
@@ -2101,7 +2399,7 @@ String downloadFileType(FileType::Enum filetype, unsigned int filenr)
       pass = ProvisioningSettings->pass;
     }
   }
-  String res = downloadFileType(url, user, pass, filetype, filenr);
+  String res = downloadFileType(session, url, user, pass, filetype, filenr);
   clearAllCaches();
   return res;
 }
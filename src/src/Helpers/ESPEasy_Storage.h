@@ -23,7 +23,7 @@ String FileError(int line, const char *fname);
 /********************************************************************************************\
    Keep track of number of flash writes.
  \*********************************************************************************************/
-void flashCount();
+void flashCount(unsigned int count = 1);
 
 String flashGuard();
 
@@ -272,6 +272,18 @@ String SaveToFile(const char *fname, int index, const uint8_t *memAddress, int d
 
 String SaveToFile_trunc(const char *fname, int index, const uint8_t *memAddress, int datasize);
 
+#if FEATURE_SETTINGS_WRITEBACK
+// Keep the data in RAM, to be written along with other settings writes in a single pass.
+// Loading from file does include the buffered data.
+String bufferSaveToFile(const char *fname, int index, const uint8_t *memAddress, int datasize);
+
+// Write all buffered settings data to the file system.
+String commitSettingsWriteBack();
+
+// Commit the buffered settings data when no new data was added for a short while.
+void processSettingsWriteBack();
+#endif // if FEATURE_SETTINGS_WRITEBACK
+
 // See for mode description: https://github.com/esp8266/Arduino/blob/master/doc/filesystem.rst
 String doSaveToFile(const char *fname, int index, const uint8_t *memAddress, int datasize, const char *mode);
 
@@ -322,6 +334,9 @@ bool SpiffsFull();
  \*********************************************************************************************/
 String createCacheFilename(unsigned int count);
 
+// Sparse timestamp index of the cache file with the same count
+String createCacheIndexFilename(unsigned int count);
+
 bool isCacheFile(const String& fname);
 
 // Match string with an integer between '_' and ".bin"
@@ -350,13 +365,22 @@ String getPartitionTable(uint8_t pType, const String& itemSep, const String& lin
    Download ESPEasy file types from HTTP server
  \*********************************************************************************************/
 #if FEATURE_DOWNLOAD
+struct DownloadFile_session;
+
 String downloadFileType(const String& url, const String& user, const String& pass, FileType::Enum filetype, unsigned int filenr = 0);
 
+// Same, using the connection of the session, to download several files over a single connection.
+// The file is downloaded to <file>_tmp first. When interrupted, the next attempt will resume the download.
+// Files unchanged on the server (same ETag) are not downloaded again.
+String downloadFileType(DownloadFile_session& session, const String& url, const String& user, const String& pass, FileType::Enum filetype, unsigned int filenr = 0);
+
 #endif // if FEATURE_DOWNLOAD
 #if FEATURE_CUSTOM_PROVISIONING
 // Download file type based on settings stored in provisioning.dat file.
 String downloadFileType(FileType::Enum filetype, unsigned int filenr = 0);
 
+String downloadFileType(DownloadFile_session& session, FileType::Enum filetype, unsigned int filenr = 0);
+
 #endif
 
 
@@ -76,10 +76,10 @@ void run_compiletime_checks() {
   check_size<CRCStruct,                             204u>();
   check_size<SecurityStruct,                        593u>();
   #ifdef ESP32
-  constexpr unsigned int SettingsStructSize = (340 + 84 * TASKS_MAX);
+  constexpr unsigned int SettingsStructSize = (352 + 84 * TASKS_MAX);
   #endif
   #ifdef ESP8266
-  constexpr unsigned int SettingsStructSize = (316 + 84 * TASKS_MAX);
+  constexpr unsigned int SettingsStructSize = (328 + 84 * TASKS_MAX);
   #endif
   #if FEATURE_CUSTOM_PROVISIONING
   check_size<ProvisioningStruct,                    256u>();  
@@ -98,16 +98,8 @@ void run_compiletime_checks() {
   #endif
 
 
-  // LogStruct is mainly dependent on the number of lines.
-  // Has to be round up to multiple of 4.
-  #if ESP_IDF_VERSION_MAJOR > 3
-  // String class has increased with 4 bytes
-  const unsigned int LogStructSize = ((13u + 24 * LOG_STRUCT_MESSAGE_LINES) + 3) & ~3;
-  #else
-  const unsigned int LogStructSize = ((13u + 20 * LOG_STRUCT_MESSAGE_LINES) + 3) & ~3;
-  #endif
-  check_size<LogStruct,                             LogStructSize>(); // Is not stored
-  check_size<DeviceStruct,                          9u>(); // Is not stored
+  check_size<LogStruct,                             12u>(); // Is not stored, log lines are kept in a separate buffer
+  check_size<DeviceStruct,                          10u>(); // Is not stored
   check_size<ProtocolStruct,                        4u>();
   #if FEATURE_NOTIFIER
   check_size<NotificationStruct,                    3u>();
@@ -119,7 +111,7 @@ void run_compiletime_checks() {
   check_size<ProvisioningStruct,                    256u>();
   #endif
   check_size<systemTimerStruct,                     28u>();
-  check_size<RTCStruct,                             32u>();
+  check_size<RTCStruct,                             40u>();
   check_size<portStatusStruct,                      6u>();
   check_size<ResetFactoryDefaultPreference_struct,  4u>();
   check_size<GpioFactorySettingsStruct,             18u>();
@@ -173,7 +165,7 @@ void run_compiletime_checks() {
   static_assert(198u == offsetof(SettingsStruct, TaskDeviceNumber), "NOTIFICATION_MAX has changed?");
 
   // All settings related to N_TASKS
-  static_assert((200 + TASKS_MAX) == offsetof(SettingsStruct, OLD_TaskDeviceID), ""); // 32-bit alignment, so offset of 2 bytes.
+  static_assert((200 + TASKS_MAX) == offsetof(SettingsStruct, TaskSendOnChange), ""); // 32-bit alignment, so offset of 2 bytes.
   static_assert((200 + (67 * TASKS_MAX)) == offsetof(SettingsStruct, ControllerEnabled), ""); 
 
   // Used to compute true offset.
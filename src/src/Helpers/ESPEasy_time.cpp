@@ -72,7 +72,7 @@ void ESPEasy_time::restoreFromRTC()
   }
 #endif
 
-  if (firstCall && (RTC.lastSysTime != 0) && (RTC.deepSleepState != 1)) {
+  if (firstCall && (RTC.lastSysTime != 0) && !(RTC.deepSleepState & RTC_DEEPSLEEP_STATE_SLEEPING)) {
     firstCall = false;
 
     // Check to see if we have some kind of believable timestamp
@@ -158,7 +158,7 @@ unsigned long ESPEasy_time::now() {
   sysTime    += static_cast<double>(msec_passed) / 1000.0;
   prevMillis += msec_passed;
 
-  if (nextSyncTime <= sysTime) {
+  if ((nextSyncTime <= sysTime) || ntpQuery.active()) {
     // nextSyncTime & sysTime are in seconds
     double unixTime_d = -1.0;
 
@@ -175,12 +175,14 @@ unsigned long ESPEasy_time::now() {
       timeSource         = extTimeSource;
     }
 
-    if (!isExternalTimeSource(timeSource)
+    if (ntpQuery.active()
+        || !isExternalTimeSource(timeSource)
         || (extTimeSource <= timeSource)
         || (timePassedSince(lastSyncTime_ms) > static_cast<long>(1000 * syncInterval))) {
       if (getNtpTime(unixTime_d)) {
         updatedTime = true;
-      } else {
+      } else if (!ntpQuery.active()) {
+        // Only use other sources when no NTP query is waiting for replies.
         #if FEATURE_ESPEASY_P2P
         double tmp_unixtime_d;
 
@@ -296,10 +298,18 @@ unsigned long ESPEasy_time::now() {
   }
   RTC.lastSysTime = static_cast<unsigned long>(sysTime);
   uint32_t localSystime = time_zone.toLocal(sysTime);
-  breakTime(localSystime, local_tm);
 
-  if (timeSynced) {
+  if (timeSynced || (localSystime != local_tm_time)) {
+    breakTime(localSystime, local_tm);
+    local_tm_time = localSystime;
+  }
+
+  if (timeSynced || (local_tm.tm_mday != sunCalcDay)) {
+    // Only needed once per day, or when the time (zone) or location may have changed.
     calcSunRiseAndSet();
+  }
+
+  if (timeSynced) {
 
     if (loglevelActiveFor(LOG_LEVEL_INFO)) {
       String log = F("Local time: ");
@@ -364,200 +374,70 @@ bool ESPEasy_time::systemTimePresent() const {
 bool ESPEasy_time::getNtpTime(double& unixTime_d)
 {
   if (!Settings.UseNTP() || !NetworkConnected(10)) {
+    ntpQuery.stop();
     return false;
   }
 
-  if (lastNTPSyncTime_ms != 0) {
-    if (timePassedSince(lastNTPSyncTime_ms) < static_cast<long>(1000 * syncInterval)) {
-      // Make sure not to flood the NTP servers with requests.
-      return false;
+  if (!ntpQuery.active()) {
+    if (lastNTPSyncTime_ms != 0) {
+      if (timePassedSince(lastNTPSyncTime_ms) < static_cast<long>(1000 * syncInterval)) {
+        // Make sure not to flood the NTP servers with requests.
+        return false;
+      }
     }
-  }
-  START_TIMER;
-  IPAddress timeServerIP;
-  String    log = F("NTP  : NTP host ");
-
-  bool useNTPpool = false;
-
-  if (Settings.NTPHost[0] != 0) {
-    resolveHostByName(Settings.NTPHost, timeServerIP);
-    log += Settings.NTPHost;
-
-    // When single set host fails, retry again in 20 seconds
-    nextSyncTime = sysTime + HwRandom(20, 60);
-  } else  {
-    // Have to do a lookup each time, since the NTP pool always returns another IP
-    String ntpServerName = String(HwRandom(0, 3));
-    ntpServerName += F(".pool.ntp.org");
-    resolveHostByName(ntpServerName.c_str(), timeServerIP);
-    log += ntpServerName;
-
-    // When pool host fails, retry can be much sooner
-    nextSyncTime = sysTime + HwRandom(5, 20);
-    useNTPpool   = true;
-  }
 
-  log += F(" (");
-  log += formatIP(timeServerIP);
-  log += ')';
+    if (ntpQuery.start() == 0) {
+      // When single set host fails, retry again in 20 seconds
+      // When pool host fails, retry can be much sooner
+      nextSyncTime = sysTime + ((Settings.NTPHost[0] != 0) ? HwRandom(20, 60) : HwRandom(5, 20));
+      ADD_TIMER_STAT(NTP_FAIL, ntpQuery.duration_usec());
+      return false;
+    }
 
-  if (!hostReachable(timeServerIP)) {
-    log += F(" unreachable");
-    addLogMove(LOG_LEVEL_INFO, log);
-    STOP_TIMER(NTP_FAIL);
+    // Replies are collected in ntpQuery_loop() and evaluated on the next calls.
     return false;
   }
 
-  WiFiUDP udp;
+  ntpQuery.loop();
 
-  if (!beginWiFiUDP_randomPort(udp)) {
+  if (!ntpQuery.done()) {
     return false;
   }
 
-  const int NTP_PACKET_SIZE = 48;          // NTP time is in the first 48 bytes of message
-  uint8_t   packetBuffer[NTP_PACKET_SIZE]; // buffer to hold incoming & outgoing packets
+  uint32_t  delay_usec = 0;
+  IPAddress server;
+  const bool success = ntpQuery.getUnixTime(unixTime_d, delay_usec, server);
+  const int64_t duration_usec = ntpQuery.duration_usec();
+
+  ntpQuery.stop();
 
-  log += F(" queried");
+  if (!success) {
+    // Retry again in a minute, or sooner when only using the NTP pool.
+    nextSyncTime = sysTime + ((Settings.NTPHost[0] != 0) ? 60 : HwRandom(5, 20));
 #ifndef BUILD_NO_DEBUG
-  addLog(LOG_LEVEL_DEBUG_MORE, log);
+    addLog(LOG_LEVEL_DEBUG_MORE, F("NTP  : No reply"));
 #endif // ifndef BUILD_NO_DEBUG
-
-  while (udp.parsePacket() > 0) { // discard any previously received packets
-  }
-  memset(packetBuffer, 0, NTP_PACKET_SIZE);
-  packetBuffer[0]  = 0b11100011; // LI, Version, Mode
-  packetBuffer[1]  = 0;          // Stratum, or type of clock
-  packetBuffer[2]  = 6;          // Polling Interval
-  packetBuffer[3]  = 0xEC;       // Peer Clock Precision
-  packetBuffer[12] = 49;
-  packetBuffer[13] = 0x4E;
-  packetBuffer[14] = 49;
-  packetBuffer[15] = 52;
-
-  FeedSW_watchdog();
-
-  if (udp.beginPacket(timeServerIP, 123) == 0) { // NTP requests are to port 123
-    FeedSW_watchdog();
-    udp.stop();
-    STOP_TIMER(NTP_FAIL);
+    ADD_TIMER_STAT(NTP_FAIL, duration_usec);
     return false;
   }
-  udp.write(packetBuffer, NTP_PACKET_SIZE);
-  udp.endPacket();
-
-
-  uint32_t beginWait = millis();
-
-  while (!timeOutReached(beginWait + 1000)) {
-    int size       = udp.parsePacket();
-    int remotePort = udp.remotePort();
-
-    if ((size >= NTP_PACKET_SIZE) && (remotePort == 123)) {
-      udp.read(packetBuffer, NTP_PACKET_SIZE); // read packet into the buffer
-
-      if ((packetBuffer[0] & 0b11000000) == 0b11000000) {
-        // Leap-Indicator: unknown (clock unsynchronized)
-        // See: https://github.com/letscontrolit/ESPEasy/issues/2886#issuecomment-586656384
-        if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
-          String log = F("NTP  : NTP host (");
-          log += formatIP(timeServerIP);
-          log += F(") unsynchronized");
-          addLogMove(LOG_LEVEL_ERROR, log);
-        }
-
-        if (!useNTPpool) {
-          // Does not make sense to try it very often if a single host is used which is not synchronized.
-          nextSyncTime = sysTime + 120;
-        }
-        udp.stop();
-        STOP_TIMER(NTP_FAIL);
-        return false;
-      }
-
-      // For more detailed info on improving accuracy, see:
-      // https://github.com/lettier/ntpclient/issues/4#issuecomment-360703503
-      // For now, we simply use half the reply time as delay compensation.
-
-      unsigned long secsSince1900;
-
-      // convert four bytes starting at location 40 to a long integer
-      // TX time is used here.
-      secsSince1900  = (unsigned long)packetBuffer[40] << 24;
-      secsSince1900 |= (unsigned long)packetBuffer[41] << 16;
-      secsSince1900 |= (unsigned long)packetBuffer[42] << 8;
-      secsSince1900 |= (unsigned long)packetBuffer[43];
-
-      if (secsSince1900 == 0) {
-        // No time stamp received
-
-        if (!useNTPpool) {
-          // Retry again in a minute.
-          nextSyncTime = sysTime + 60;
-        }
-        udp.stop();
-        STOP_TIMER(NTP_FAIL);
-        return false;
-      }
-      uint32_t txTm = secsSince1900 - 2208988800UL;
-
-      unsigned long txTm_f;
-      txTm_f  = (unsigned long)packetBuffer[44] << 24;
-      txTm_f |= (unsigned long)packetBuffer[45] << 16;
-      txTm_f |= (unsigned long)packetBuffer[46] << 8;
-      txTm_f |= (unsigned long)packetBuffer[47];
-
-      // Convert seconds to double
-      unixTime_d = static_cast<double>(txTm);
-
-      // Add fractional part.
-      unixTime_d += (static_cast<double>(txTm_f) / 4294967295.0);
-
-      long total_delay = timePassedSince(beginWait);
-      lastSyncTime_ms = millis();
-
-      // compensate for the delay by adding half the total delay
-      // N.B. unixTime_d is in seconds and delay in msec.
-      double delay_compensation = static_cast<double>(total_delay) / 2000.0;
-      unixTime_d += delay_compensation;
-
-      if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-        String log = F("NTP  : NTP replied: delay ");
-        log += total_delay;
-        log += F(" mSec");
-        log += F(" Accuracy increased by ");
-        double fractpart, intpart;
-        fractpart = modf(unixTime_d, &intpart);
-
-        if (fractpart < delay_compensation) {
-          // We gained more than 1 second in accuracy
-          fractpart += 1.0;
-        }
-        log += static_cast<int>(fractpart * 1000.0);
-        log += F(" msec");
-        addLogMove(LOG_LEVEL_INFO, log);
-      }
-      udp.stop();
-      timeSource         = timeSource_t::NTP_time_source;
-      lastNTPSyncTime_ms = millis();
-      CheckRunningServices(); // FIXME TD-er: Sometimes services can only be started after NTP is successful
-      STOP_TIMER(NTP_SUCCESS);
-      return true;
-    }
-    delay(10);
-  }
 
-  // Timeout.
-  if (!useNTPpool) {
-    // Retry again in a minute.
-    nextSyncTime = sysTime + 60;
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    addLogMove(LOG_LEVEL_INFO, strformat(
+                 F("NTP  : Using NTP host %s, delay %d usec"),
+                 formatIP(server).c_str(),
+                 static_cast<int>(delay_usec)));
   }
+  lastSyncTime_ms    = millis();
+  timeSource         = timeSource_t::NTP_time_source;
+  lastNTPSyncTime_ms = millis();
+  CheckRunningServices(); // FIXME TD-er: Sometimes services can only be started after NTP is successful
+  ADD_TIMER_STAT(NTP_SUCCESS, duration_usec);
+  return true;
+}
 
-#ifndef BUILD_NO_DEBUG
-  addLog(LOG_LEVEL_DEBUG_MORE, F("NTP  : No reply"));
-#endif // ifndef BUILD_NO_DEBUG
-  udp.stop();
-  STOP_TIMER(NTP_FAIL);
-  return false;
+void ESPEasy_time::ntpQuery_loop()
+{
+  ntpQuery.loop();
 }
 
 /**************************************************
@@ -765,16 +645,25 @@ void ESPEasy_time::calcSunRiseAndSet() {
   tsSet  = addSeconds(tsSet, secOffset_longitude, false);
   tsRise = addSeconds(tsRise, secOffset_longitude, false);
 
-  breakTime(time_zone.toLocal(makeTime(tsRise)), sunRise);
-  breakTime(time_zone.toLocal(makeTime(tsSet)),  sunSet);
+  sunRise_local = time_zone.toLocal(makeTime(tsRise));
+  sunSet_local  = time_zone.toLocal(makeTime(tsSet));
+  breakTime(sunRise_local, sunRise);
+  breakTime(sunSet_local,  sunSet);
+  sunCalcDay = local_tm.tm_mday;
 }
 
 struct tm ESPEasy_time::getSunRise(int secOffset) const {
-  return addSeconds(tsRise, secOffset, true);
+  struct tm result;
+
+  breakTime(sunRise_local + secOffset, result);
+  return result;
 }
 
 struct tm ESPEasy_time::getSunSet(int secOffset) const {
-  return addSeconds(tsSet, secOffset, true);
+  struct tm result;
+
+  breakTime(sunSet_local + secOffset, result);
+  return result;
 }
 
 #if FEATURE_EXT_RTC
@@ -3,6 +3,7 @@
 
 #include "../../ESPEasy_common.h"
 
+#include "../DataStructs/NTP_query.h"
 #include "../DataTypes/ESPEasyTimeSource.h"
 
 #include <time.h>
@@ -54,8 +55,13 @@ public:
 
   bool          systemTimePresent() const;
 
+  // Non blocking, the NTP servers are queried in the first call and the best reply
+  // is returned in a later call, when all servers replied or the query timed out.
   bool          getNtpTime(double& unixTime_d);
 
+  // Collect NTP replies as soon as they arrive, for an accurate round trip delay.
+  void          ntpQuery_loop();
+
   String        getTimeZoneOffsetString();
 
   /********************************************************************************************\
@@ -203,6 +209,10 @@ public:
   struct tm tsRise, tsSet;
   struct tm sunRise;
   struct tm sunSet;
+  uint32_t sunRise_local = 0;       // Local time of sunrise, to apply offsets without recomputing sunrise
+  uint32_t sunSet_local  = 0;
+  int sunCalcDay         = 0;       // Day of month of the last sunrise/sunset calculation
+  uint32_t local_tm_time = 0xFFFFFFFF; // Local time as stored in local_tm
   timeSource_t timeSource               = timeSource_t::No_time_source;
   timeSource_t extTimeSource            = timeSource_t::No_time_source;
   float timeWander                      = 0.0f; // Clock instability in ppm
@@ -210,6 +220,10 @@ public:
 
   uint8_t PrevMinutes         = 0;
   uint8_t timeSource_p2p_unit = 0;
+
+private:
+
+  NTP_query_struct ntpQuery;
 };
 
 
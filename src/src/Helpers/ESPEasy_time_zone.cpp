@@ -136,24 +136,61 @@ bool ESPEasy_time_zone::calcTimeChanges(int yr)
   m_stdLoc = stdLoc;
   m_dstUTC = m_dstLoc - m_std.offset * SECS_PER_MIN;
   m_stdUTC = m_stdLoc - m_dst.offset * SECS_PER_MIN;
+
+  // Rules may have changed, so the cached offset is no longer valid.
+  m_cacheUTCstart = 0;
+  m_cacheUTCend   = 0;
   return changed;
 }
 
+void ESPEasy_time_zone::cacheOffset(uint32_t utc, int32_t offset)
+{
+  // Time changes are computed per year, so the cached offset is at most valid for the current year.
+  const int yr = ESPEasy_time::year(utc);
+  struct tm tm;
+
+  memset(&tm, 0, sizeof(tm));
+  tm.tm_mday = 1;
+  tm.tm_year = yr - 1900;
+  uint32_t start = makeTime(tm);
+
+  tm.tm_year = yr + 1 - 1900;
+  uint32_t end = makeTime(tm);
+
+  if (m_stdUTC != m_dstUTC) {
+    const uint32_t changes[2] = { m_dstUTC, m_stdUTC };
+
+    for (int i = 0; i < 2; ++i) {
+      if (changes[i] <= utc) {
+        if (changes[i] > start) { start = changes[i]; }
+      } else if (changes[i] < end) {
+        end = changes[i];
+      }
+    }
+  }
+  m_cacheUTCstart = start;
+  m_cacheUTCend   = end;
+  m_cacheOffset   = offset;
+}
+
 /*----------------------------------------------------------------------*
 * Convert the given UTC time to local time, standard or                *
 * daylight time, as appropriate.                                       *
 *----------------------------------------------------------------------*/
 uint32_t ESPEasy_time_zone::toLocal(uint32_t utc)
 {
+  // Typically called with the current time, so the same offset applies until the next time change.
+  if ((utc >= m_cacheUTCstart) && (utc < m_cacheUTCend)) {
+    return utc + m_cacheOffset;
+  }
+
   // recalculate the time change points if needed
   if (ESPEasy_time::year(utc) != ESPEasy_time::year(m_dstUTC)) { calcTimeChanges(ESPEasy_time::year(utc)); }
 
-  if (utcIsDST(utc)) {
-    return utc + m_dst.offset * SECS_PER_MIN;
-  }
-  else {
-    return utc + m_std.offset * SECS_PER_MIN;
-  }
+  const int32_t offset = (utcIsDST(utc) ? m_dst.offset : m_std.offset) * static_cast<int32_t>(SECS_PER_MIN);
+
+  cacheOffset(utc, offset);
+  return utc + offset;
 }
 
 /*----------------------------------------------------------------------*
@@ -117,6 +117,16 @@ uint32_t m_stdUTC = 0; // std time start for given/current year, given in UTC
 uint32_t m_dstLoc = 0; // dst start for given/current year, given in local time
 uint32_t m_stdLoc = 0; // std time start for given/current year, given in local time
 
+private:
+
+// Store the UTC offset valid for the given UTC time, until the next time change or the end of the year.
+void cacheOffset(uint32_t utc, int32_t offset);
+
+// toLocal() uses the cached offset for UTC times in [m_cacheUTCstart, m_cacheUTCend)
+uint32_t m_cacheUTCstart = 0;
+uint32_t m_cacheUTCend   = 0;
+int32_t  m_cacheOffset   = 0; // In seconds
+
 
 };
 
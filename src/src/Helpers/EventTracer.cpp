@@ -0,0 +1,159 @@
+#include "../Helpers/EventTracer.h"
+
+#if FEATURE_EVENT_TRACER
+
+# include "../Helpers/ESPEasy_time_calc.h"
+# include "../Helpers/Hardware.h"
+# include "../Helpers/Memory.h"
+
+static EventTraceRecord_t *eventTraceBuffer   = nullptr;
+static uint32_t            eventTraceCapacity = 0;
+static uint32_t            eventTraceWritePos = 0;
+static uint32_t            eventTraceCount    = 0;
+static bool                eventTraceRunning  = false;
+
+# ifdef ESP32
+static TaskHandle_t eventTraceMainTask = nullptr;
+# endif // ifdef ESP32
+
+const __FlashStringHelper* toString(EventTraceType_e type) {
+  switch (type) {
+    case EventTraceType_e::Scheduler:   return F("scheduler");
+    case EventTraceType_e::Plugin:      return F("plugin");
+    case EventTraceType_e::CPlugin:     return F("controller");
+    case EventTraceType_e::Rules:       return F("rules");
+    case EventTraceType_e::WebRequest:  return F("web");
+    case EventTraceType_e::NR_ELEMENTS: break;
+  }
+  return F("");
+}
+
+EventTraceScope::EventTraceScope(EventTraceType_e type, uint32_t arg)
+  : _arg(arg), _type(type)
+{
+  _active = EventTracer_add(_type, _arg, true);
+}
+
+EventTraceScope::~EventTraceScope()
+{
+  // Only add an end record when the begin record was added
+  if (_active) {
+    EventTracer_add(_type, _arg, false);
+  }
+}
+
+void EventTracer_init()
+{
+  # ifdef ESP32
+  eventTraceMainTask = xTaskGetCurrentTaskHandle();
+  # endif // ifdef ESP32
+}
+
+bool EventTracer_start()
+{
+  eventTraceRunning = false;
+
+  if (eventTraceBuffer == nullptr) {
+    uint32_t capacity = EVENT_TRACER_NR_RECORDS;
+    # ifdef ESP32
+
+    if (UsePSRAM()) {
+      capacity = EVENT_TRACER_NR_RECORDS_PSRAM;
+    }
+    # endif // ifdef ESP32
+    eventTraceBuffer = static_cast<EventTraceRecord_t *>(buffer_calloc(MemoryBufferClass_e::Generic, capacity, sizeof(EventTraceRecord_t)));
+
+    if (eventTraceBuffer == nullptr) {
+      return false;
+    }
+    eventTraceCapacity = capacity;
+  }
+  eventTraceWritePos = 0;
+  eventTraceCount    = 0;
+  eventTraceRunning  = true;
+  return true;
+}
+
+void EventTracer_stop()
+{
+  eventTraceRunning = false;
+}
+
+void EventTracer_free()
+{
+  eventTraceRunning = false;
+
+  if (eventTraceBuffer != nullptr) {
+    buffer_free(MemoryBufferClass_e::Generic, eventTraceBuffer, eventTraceCapacity * sizeof(EventTraceRecord_t));
+    eventTraceBuffer = nullptr;
+  }
+  eventTraceCapacity = 0;
+  eventTraceWritePos = 0;
+  eventTraceCount    = 0;
+}
+
+bool EventTracer_isRunning()
+{
+  return eventTraceRunning;
+}
+
+bool EventTracer_add(EventTraceType_e type, uint32_t arg, bool begin)
+{
+  if (!eventTraceRunning) {
+    return false;
+  }
+  # ifdef ESP32
+
+  if ((eventTraceMainTask == nullptr) || (xTaskGetCurrentTaskHandle() != eventTraceMainTask)) {
+    return false;
+  }
+  # endif // ifdef ESP32
+
+  EventTraceRecord_t& record = eventTraceBuffer[eventTraceWritePos];
+
+  record.timestamp = static_cast<uint32_t>(getMicros64());
+  record.arg       = arg;
+  record.type      = type;
+  record.begin     = begin;
+
+  if (++eventTraceWritePos >= eventTraceCapacity) {
+    eventTraceWritePos = 0;
+  }
+
+  if (eventTraceCount < eventTraceCapacity) {
+    ++eventTraceCount;
+  }
+  return true;
+}
+
+uint32_t EventTracer_getCount()
+{
+  return eventTraceCount;
+}
+
+uint32_t EventTracer_getCapacity()
+{
+  return eventTraceCapacity;
+}
+
+bool EventTracer_getRecord(uint32_t index, EventTraceRecord_t& record)
+{
+  if (index >= eventTraceCount) {
+    return false;
+  }
+
+  // When the ring is full, the oldest record is at the write position
+  uint32_t pos = index;
+
+  if (eventTraceCount == eventTraceCapacity) {
+    pos += eventTraceWritePos;
+
+    if (pos >= eventTraceCapacity) {
+      pos -= eventTraceCapacity;
+    }
+  }
+  record = eventTraceBuffer[pos];
+  return true;
+}
+
+#endif // if FEATURE_EVENT_TRACER
@@ -0,0 +1,104 @@
+#ifndef HELPERS_EVENTTRACER_H
+#define HELPERS_EVENTTRACER_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_EVENT_TRACER
+
+// Nr of records in the trace ring buffer.
+// Allocated when tracing is started, so it does not use memory when not used.
+# ifndef EVENT_TRACER_NR_RECORDS
+#  ifdef ESP32
+#   define EVENT_TRACER_NR_RECORDS        2048
+#  else // ifdef ESP32
+#   define EVENT_TRACER_NR_RECORDS        512
+#  endif // ifdef ESP32
+# endif // ifndef EVENT_TRACER_NR_RECORDS
+
+// Nr of records when PSRAM is available
+# ifndef EVENT_TRACER_NR_RECORDS_PSRAM
+#  define EVENT_TRACER_NR_RECORDS_PSRAM   16384
+# endif // ifndef EVENT_TRACER_NR_RECORDS_PSRAM
+
+enum class EventTraceType_e : uint8_t {
+  Scheduler,  // arg: Scheduler mixed ID
+  Plugin,     // arg: (taskIndex << 16) | (deviceIndex << 8) | function
+  CPlugin,    // arg: (protocolIndex << 8) | function
+  Rules,      // arg: 0
+  WebRequest, // arg: HTTP code
+
+  NR_ELEMENTS // Keep as last
+};
+
+// Category name as used in the trace_event JSON
+const __FlashStringHelper* toString(EventTraceType_e type);
+
+struct EventTraceRecord_t {
+  uint32_t         timestamp{}; // Lower 32 bit of getMicros64()
+  uint32_t         arg{};
+  EventTraceType_e type = EventTraceType_e::NR_ELEMENTS;
+  bool             begin{};
+  uint16_t         unused{}; // Force alignment to 4 bytes
+};
+
+/*********************************************************************************************\
+* EventTraceScope
+* Add a begin record at construction and an end record when going out of scope.
+* Use at the start of a block:
+*   EVENT_TRACE_SCOPE(Plugin, arg);
+* Only the main loop is traced, scopes in other tasks are ignored.
+\*********************************************************************************************/
+class EventTraceScope {
+public:
+
+  EventTraceScope(EventTraceType_e type,
+                  uint32_t         arg);
+  ~EventTraceScope();
+
+  EventTraceScope(const EventTraceScope&)            = delete;
+  EventTraceScope& operator=(const EventTraceScope&) = delete;
+
+private:
+
+  uint32_t         _arg;
+  EventTraceType_e _type;
+  bool             _active = false;
+};
+
+// Must be called from the main loop task, before any record is added.
+void     EventTracer_init();
+
+// Clear the ring buffer and start tracing. Allocates the ring buffer on first use.
+// @retval false when the ring buffer could not be allocated
+bool     EventTracer_start();
+
+// Stop tracing, keep the records to be downloaded
+void     EventTracer_stop();
+
+// Stop tracing and free the ring buffer
+void     EventTracer_free();
+
+bool     EventTracer_isRunning();
+
+// @retval true when a record was added
+bool     EventTracer_add(EventTraceType_e type,
+                         uint32_t         arg,
+                         bool             begin);
+
+uint32_t EventTracer_getCount();
+
+uint32_t EventTracer_getCapacity();
+
+// Get record by index, 0 is the oldest record.
+bool     EventTracer_getRecord(uint32_t            index,
+                               EventTraceRecord_t& record);
+
+# define EVENT_TRACE_SCOPE(T, A) EventTraceScope event_trace_scope_ ## T(EventTraceType_e::T, (A))
+
+#else // if FEATURE_EVENT_TRACER
+
+# define EVENT_TRACE_SCOPE(T, A)
+
+#endif // if FEATURE_EVENT_TRACER
+
+#endif // ifndef HELPERS_EVENTTRACER_H
@@ -0,0 +1,58 @@
+#include "../Helpers/FormattedTaskValues.h"
+
+#include "../DataStructs/ESPEasy_EventStruct.h"
+
+static FormattedTaskValuesScope *activeFormattedTaskValues = nullptr;
+
+FormattedTaskValuesScope::FormattedTaskValuesScope(struct EventStruct *event)
+  : _taskIndex(event != nullptr ? event->TaskIndex : INVALID_TASK_INDEX),
+  _sensorType(event != nullptr ? event->getSensorType() : Sensor_VType::SENSOR_TYPE_NONE),
+  _previous(activeFormattedTaskValues)
+{
+  activeFormattedTaskValues = this;
+}
+
+FormattedTaskValuesScope::~FormattedTaskValuesScope()
+{
+  activeFormattedTaskValues = _previous;
+}
+
+FormattedTaskValuesScope * FormattedTaskValuesScope::getActive(const struct EventStruct *event)
+{
+  if ((activeFormattedTaskValues == nullptr) || (event == nullptr)) {
+    return nullptr;
+  }
+
+  if ((event->TaskIndex != activeFormattedTaskValues->_taskIndex) ||
+      (event->sensorType != activeFormattedTaskValues->_sensorType) ||
+
+      // String values are taken from the event itself, which may differ per call
+      (activeFormattedTaskValues->_sensorType == Sensor_VType::SENSOR_TYPE_STRING)) {
+    return nullptr;
+  }
+  return activeFormattedTaskValues;
+}
+
+bool FormattedTaskValuesScope::get(const struct EventStruct *event, uint8_t rel_index, bool mustCheck, String& value, bool& isvalid)
+{
+  const FormattedTaskValuesScope *scope = getActive(event);
+
+  if ((scope == nullptr) || (rel_index >= VARS_PER_TASK) || !scope->_present[mustCheck][rel_index]) {
+    return false;
+  }
+  value   = scope->_values[mustCheck][rel_index];
+  isvalid = scope->_isvalid[mustCheck][rel_index];
+  return true;
+}
+
+void FormattedTaskValuesScope::set(const struct EventStruct *event, uint8_t rel_index, bool mustCheck, const String& value, bool isvalid)
+{
+  FormattedTaskValuesScope *scope = getActive(event);
+
+  if ((scope == nullptr) || (rel_index >= VARS_PER_TASK)) {
+    return;
+  }
+  scope->_values[mustCheck][rel_index]  = value;
+  scope->_isvalid[mustCheck][rel_index] = isvalid;
+  scope->_present[mustCheck][rel_index] = true;
+}
@@ -0,0 +1,55 @@
+#ifndef HELPERS_FORMATTEDTASKVALUES_H
+#define HELPERS_FORMATTEDTASKVALUES_H
+
+#include "../../ESPEasy_common.h"
+
+#include "../DataTypes/SensorVType.h"
+#include "../DataTypes/TaskIndex.h"
+
+struct EventStruct;
+
+/*********************************************************************************************\
+* FormattedTaskValuesScope
+* Keep the formatted task values of a single sample while in scope.
+* sendData() passes the same sample to rules, web event stream and all enabled controllers.
+* Each of them formats the task values, which may involve a PLUGIN_FORMAT_USERVAR call per value.
+* Within this scope, doFormatUserVar() only formats each value once for this task.
+*
+* N.B. Task values of this task must not be changed while in scope.
+\*********************************************************************************************/
+class FormattedTaskValuesScope {
+public:
+
+  explicit FormattedTaskValuesScope(struct EventStruct *event);
+  ~FormattedTaskValuesScope();
+
+  FormattedTaskValuesScope(const FormattedTaskValuesScope&)            = delete;
+  FormattedTaskValuesScope& operator=(const FormattedTaskValuesScope&) = delete;
+
+  // Get a formatted value of the active scope, if present.
+  static bool get(const struct EventStruct *event,
+                  uint8_t                   rel_index,
+                  bool                      mustCheck,
+                  String                  & value,
+                  bool                    & isvalid);
+
+  // Store a formatted value in the active scope, if applicable.
+  static void set(const struct EventStruct *event,
+                  uint8_t                   rel_index,
+                  bool                      mustCheck,
+                  const String            & value,
+                  bool                      isvalid);
+
+private:
+
+  static FormattedTaskValuesScope* getActive(const struct EventStruct *event);
+
+  String                    _values[2][VARS_PER_TASK];
+  bool                      _isvalid[2][VARS_PER_TASK]{};
+  bool                      _present[2][VARS_PER_TASK]{};
+  taskIndex_t               _taskIndex;
+  Sensor_VType              _sensorType;
+  FormattedTaskValuesScope *_previous;
+};
+
+#endif // ifndef HELPERS_FORMATTEDTASKVALUES_H
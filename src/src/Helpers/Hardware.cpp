@@ -6,6 +6,7 @@
 #include "../ESPEasyCore/ESPEasyGPIO.h"
 #include "../ESPEasyCore/ESPEasy_Log.h"
 
+#include "../Globals/Cache.h"
 #include "../Globals/Device.h"
 #include "../Globals/ESPEasyWiFiEvent.h"
 #include "../Globals/ExtraTaskSettings.h"
@@ -17,6 +18,7 @@
 #include "../Helpers/ESPEasy_Storage.h"
 #include "../Helpers/FS_Helper.h"
 #include "../Helpers/I2C_access.h"
+#include "../Helpers/I2C_async.h"
 #include "../Helpers/Misc.h"
 #include "../Helpers/PortStatus.h"
 #include "../Helpers/StringConverter.h"
@@ -24,9 +26,11 @@
 
 #if defined(ESP8266)
   # include <ESP8266WiFi.h>
+  # include <osapi.h>
 #endif // if defined(ESP8266)
 #if defined(ESP32)
   # include <WiFi.h>
+  # include <driver/ledc.h>
 #endif // if defined(ESP32)
 
 // #include "../../ESPEasy-Globals.h"
@@ -185,6 +189,9 @@ void hardwareInit()
   }
 
   initI2C();
+  #if FEATURE_I2C_ASYNC
+  I2C_async_begin();
+  #endif // if FEATURE_I2C_ASYNC
 
   #if FEATURE_PLUGIN_PRIORITY
   String dummy;
@@ -267,16 +274,14 @@ void initI2C() {
       log += Settings.WireClockStretchLimit;
       addLogMove(LOG_LEVEL_INFO, log);
     }
-      #if defined(ESP8266)
-    Wire.setClockStretchLimit(Settings.WireClockStretchLimit);
-      #endif // if defined(ESP8266)
-      #ifdef ESP32
-    Wire.setTimeOut(Settings.WireClockStretchLimit);
-      #endif
   }
+  I2CSetClockStretchLimit(Settings.WireClockStretchLimit);
 
   #if FEATURE_I2CMULTIPLEXER
 
+  // State of the multiplexer is unknown after (re)initializing the bus
+  I2CMultiplexerInvalidate();
+
   if (validGpio(Settings.I2C_Multiplexer_ResetPin)) { // Initialize Reset pin to High if configured
     pinMode(Settings.I2C_Multiplexer_ResetPin, OUTPUT);
     digitalWrite(Settings.I2C_Multiplexer_ResetPin, HIGH);
@@ -340,6 +345,9 @@ void I2CForceResetBus_swap_pins(uint8_t address) {
   I2CSelectClockSpeed(100000);
 }
 
+// Last set clock stretch limit, 0 = core default
+static uint32_t I2C_clockStretchLimit = 0;
+
 void I2CBegin(int8_t sda, int8_t scl, uint32_t clockFreq) {
   #ifdef ESP32
   uint32_t lastI2CClockSpeed = Wire.getClock();
@@ -369,6 +377,28 @@ void I2CBegin(int8_t sda, int8_t scl, uint32_t clockFreq) {
   #else // ifdef ESP32
   Wire.begin(sda, scl);
   Wire.setClock(clockFreq);
+
+  if (I2C_clockStretchLimit != 0) {
+    // Wire.begin() sets the default clock stretch limit
+    Wire.setClockStretchLimit(I2C_clockStretchLimit);
+  }
+  #endif // ifdef ESP32
+}
+
+void I2CSetClockStretchLimit(uint32_t limit) {
+  if (limit == I2C_clockStretchLimit) {
+    return;
+  }
+  I2C_clockStretchLimit = limit;
+
+  if (limit == 0) {
+    limit = I2C_DEFAULT_CLOCK_STRETCH_LIMIT;
+  }
+  #ifdef ESP8266
+  Wire.setClockStretchLimit(limit);
+  #endif // ifdef ESP8266
+  #ifdef ESP32
+  Wire.setTimeOut(limit);
   #endif // ifdef ESP32
 }
 
@@ -380,12 +410,24 @@ bool isI2CMultiplexerEnabled() {
          && Settings.I2C_Multiplexer_Addr != -1;
 }
 
+// Last value written to the multiplexer, to skip writing the same channel selection again
+static uint8_t I2CMultiplexer_selected      = 0;
+static bool    I2CMultiplexer_selectedValid = false;
+
+void I2CMultiplexerInvalidate() {
+  I2CMultiplexer_selectedValid = false;
+}
+
 // Reset the I2C Multiplexer, if a pin is assigned for that. Pulled to low to force a reset.
 void I2CMultiplexerReset() {
   if (Settings.I2C_Multiplexer_ResetPin != -1) {
     digitalWrite(Settings.I2C_Multiplexer_ResetPin, LOW);
     delay(1); // minimum requirement of low for a proper reset seems to be about 6 nsec, so 1 msec should be more than sufficient
     digitalWrite(Settings.I2C_Multiplexer_ResetPin, HIGH);
+
+    // No channel selected after reset
+    I2CMultiplexer_selected      = 0;
+    I2CMultiplexer_selectedValid = true;
   }
 }
 
@@ -418,18 +460,23 @@ void I2CMultiplexerSelectByTaskIndex(taskIndex_t taskIndex) {
 
   if (!I2CMultiplexerPortSelectedForTask(taskIndex)) { return; }
 
-  uint8_t toWrite = 0;
+  const uint8_t toWrite = I2CMultiplexerGetTaskSelection(taskIndex);
+
+  if (toWrite == 0) { return; }
+
+  SetI2CMultiplexer(toWrite);
+}
+
+uint8_t I2CMultiplexerGetTaskSelection(taskIndex_t taskIndex) {
+  if (!I2CMultiplexerPortSelectedForTask(taskIndex)) { return 0; }
 
   if (!bitRead(Settings.I2C_Flags[taskIndex], I2C_FLAGS_MUX_MULTICHANNEL)) {
     uint8_t i = Settings.I2C_Multiplexer_Channel[taskIndex];
 
-    if (i > 7) { return; }
-    toWrite = I2CMultiplexerShiftBit(i);
-  } else {
-    toWrite = Settings.I2C_Multiplexer_Channel[taskIndex]; // Bitpattern is already correctly stored
+    if (i > 7) { return 0; }
+    return I2CMultiplexerShiftBit(i);
   }
-
-  SetI2CMultiplexer(toWrite);
+  return Settings.I2C_Multiplexer_Channel[taskIndex]; // Bitpattern is already correctly stored
 }
 
 void I2CMultiplexerSelect(uint8_t i) {
@@ -446,14 +493,22 @@ void I2CMultiplexerOff() {
 
 void SetI2CMultiplexer(uint8_t toWrite) {
   if (isI2CMultiplexerEnabled()) {
-    // FIXME TD-er: Must check to see if we can cache the value so only change it when needed.
+    if (I2CMultiplexer_selectedValid && (I2CMultiplexer_selected == toWrite)) {
+      return; // Already selected
+    }
 
-    I2C_write8(Settings.I2C_Multiplexer_Addr, toWrite);
+    // Only remember the selection when the write was acknowledged
+    I2CMultiplexer_selectedValid = I2C_write8(Settings.I2C_Multiplexer_Addr, toWrite);
+    I2CMultiplexer_selected      = toWrite;
 
     // FIXME TD-er: We must check if the chip needs some time to set the output. (delay?)
   }
 }
 
+uint8_t I2CMultiplexerSelected() {
+  return isI2CMultiplexerEnabled() ? I2CMultiplexer_selected : 0;
+}
+
 uint8_t I2CMultiplexerMaxChannels() {
   uint channels = 0;
 
@@ -2328,26 +2383,124 @@ uint32_t analogWriteESP32(int pin, int value, uint32_t frequency)
   return 0;
 }
 
+// LEDC channel nr as used by the Arduino ledc functions: 8 channels per speed mode
+static void getLedcChannel(int8_t ledChannel, ledc_mode_t& mode, ledc_channel_t& channel)
+{
+  # ifdef SOC_LEDC_SUPPORT_HS_MODE
+  mode = (ledChannel < 8) ? LEDC_HIGH_SPEED_MODE : LEDC_LOW_SPEED_MODE;
+  # else // ifdef SOC_LEDC_SUPPORT_HS_MODE
+  mode = LEDC_LOW_SPEED_MODE;
+  # endif // ifdef SOC_LEDC_SUPPORT_HS_MODE
+  channel = static_cast<ledc_channel_t>(ledChannel % 8);
+}
+
+static bool ledcFadeInstall()
+{
+  static bool installed = false;
+
+  if (!installed) {
+    // May already be installed by other code
+    const esp_err_t res = ledc_fade_func_install(0);
+    installed = (res == ESP_OK) || (res == ESP_ERR_INVALID_STATE);
+  }
+  return installed;
+}
+
 #endif // if defined(ESP32)
 
-bool set_Gpio_PWM_pct(int gpio, float dutyCycle_f, uint32_t frequency) {
-  uint32_t dutyCycle = dutyCycle_f * 10.23f;
+#ifdef ESP8266
 
-  return set_Gpio_PWM(gpio, dutyCycle, frequency);
+// Fades of all pins are stepped from a single shared timer, instead of a blocking loop per pin.
+# define GPIO_PWM_FADE_MAX         8
+# define GPIO_PWM_FADE_INTERVAL    10 // msec
+# define GPIO_PWM_FADE_RESOLUTION  12 // bits
+
+struct GpioPWMfade_t {
+  int32_t  value  = 0; // Current duty cycle << GPIO_PWM_FADE_RESOLUTION
+  int32_t  step   = 0;
+  uint32_t steps  = 0; // Steps left, 0 = not fading
+  uint16_t target = 0;
+  int8_t   gpio   = -1;
+};
+
+static GpioPWMfade_t gpioPWMfades[GPIO_PWM_FADE_MAX];
+static os_timer_t    gpioPWMfadeTimer;
+static bool          gpioPWMfadeTimerArmed = false;
+
+static void gpioPWMfadeStep(void *)
+{
+  bool active = false;
+
+  for (uint8_t i = 0; i < GPIO_PWM_FADE_MAX; ++i) {
+    GpioPWMfade_t& fade = gpioPWMfades[i];
+
+    if (fade.steps != 0) {
+      --fade.steps;
+      fade.value += fade.step;
+
+      if (fade.steps == 0) {
+        analogWrite(fade.gpio, fade.target);
+        fade.gpio = -1;
+      } else {
+        analogWrite(fade.gpio, fade.value >> GPIO_PWM_FADE_RESOLUTION);
+        active = true;
+      }
+    }
+  }
+
+  if (!active) {
+    os_timer_disarm(&gpioPWMfadeTimer);
+    gpioPWMfadeTimerArmed = false;
+  }
 }
 
-bool set_Gpio_PWM(int gpio, uint32_t dutyCycle, uint32_t frequency) {
-  uint32_t key;
+static void gpioPWMfadeStop(int gpio)
+{
+  for (uint8_t i = 0; i < GPIO_PWM_FADE_MAX; ++i) {
+    if (gpioPWMfades[i].gpio == gpio) {
+      gpioPWMfades[i].steps = 0;
+      gpioPWMfades[i].gpio  = -1;
+    }
+  }
+}
 
-  return set_Gpio_PWM(gpio, dutyCycle, 0, frequency, key);
+// Add a fade, which is started by gpioPWMfadeStart()
+// @retval false when no fade slot is available
+static bool gpioPWMfadeAdd(int gpio, uint32_t from, uint32_t to, uint32_t fadeDuration_ms)
+{
+  const uint32_t steps = (fadeDuration_ms + GPIO_PWM_FADE_INTERVAL - 1) / GPIO_PWM_FADE_INTERVAL;
+
+  for (uint8_t i = 0; i < GPIO_PWM_FADE_MAX; ++i) {
+    GpioPWMfade_t& fade = gpioPWMfades[i];
+
+    if (fade.gpio == -1) {
+      fade.value  = static_cast<int32_t>(from) << GPIO_PWM_FADE_RESOLUTION;
+      fade.step   = ((static_cast<int32_t>(to) - static_cast<int32_t>(from)) << GPIO_PWM_FADE_RESOLUTION) / static_cast<int32_t>(steps);
+      fade.target = to;
+      fade.steps  = steps;
+      fade.gpio   = gpio;
+      return true;
+    }
+  }
+  return false;
 }
 
-bool set_Gpio_PWM(int gpio, uint32_t dutyCycle, uint32_t fadeDuration_ms, uint32_t& frequency, uint32_t& key)
+static void gpioPWMfadeStart()
 {
-  // For now, we only support the internal GPIO pins.
-  if (!checkValidPortRange(PLUGIN_GPIO, gpio)) {
-    return false;
+  if (!gpioPWMfadeTimerArmed) {
+    os_timer_setfn(&gpioPWMfadeTimer, gpioPWMfadeStep, nullptr);
+    os_timer_arm(&gpioPWMfadeTimer, GPIO_PWM_FADE_INTERVAL, true);
+    gpioPWMfadeTimerArmed = true;
   }
+}
+
+#endif // ifdef ESP8266
+
+// Set up the new duty cycle of a pin and update its port status.
+// On ESP32 the new duty cycle is only active after set_Gpio_PWM_apply(), so several pins can be started at once.
+// @retval LEDC channel to apply (ESP32), -1 when there is nothing left to apply
+static int8_t set_Gpio_PWM_prepare(int gpio, uint32_t dutyCycle, uint32_t fadeDuration_ms, uint32_t& frequency, uint32_t& key)
+{
   portStatusStruct tempStatus;
 
   // FIXME TD-er: PWM values cannot be stored very well in the portStatusStruct.
@@ -2357,52 +2510,48 @@ bool set_Gpio_PWM(int gpio, uint32_t dutyCycle, uint32_t fadeDuration_ms, uint32
   // So the next command should be part of each command:
   tempStatus = globalMapPortStatus[key];
 
-        #if defined(ESP8266)
-  pinMode(gpio, OUTPUT);
-        #endif // if defined(ESP8266)
+  const uint32_t prev_value = (tempStatus.mode == PIN_MODE_PWM) ? tempStatus.getDutyCycle() : 0;
+  int8_t ledChannel         = -1;
 
   #if defined(ESP8266)
+  pinMode(gpio, OUTPUT);
 
   if ((frequency > 0) && (frequency <= 40000)) {
     analogWriteFreq(frequency);
   }
-  #endif // if defined(ESP8266)
+  gpioPWMfadeStop(gpio);
 
-  if (fadeDuration_ms != 0)
-  {
-    const int32_t resolution_factor = (1 << 12);
-    const uint8_t prev_mode         = tempStatus.mode;
-    int32_t   prev_value            = tempStatus.getDutyCycle();
+  if ((fadeDuration_ms == 0) || !gpioPWMfadeAdd(gpio, prev_value, dutyCycle, fadeDuration_ms)) {
+    analogWrite(gpio, dutyCycle);
+  }
+  #endif // if defined(ESP8266)
+  #if defined(ESP32)
 
-    // getPinState(pluginID, gpio, &prev_mode, &prev_value);
-    if (prev_mode != PIN_MODE_PWM) {
-      prev_value = 0;
-    }
+  if ((dutyCycle == 0) && (fadeDuration_ms == 0)) {
+    frequency = analogWriteESP32(gpio, 0, frequency);
+  } else {
+    ledChannel = attachLedChannel(gpio, frequency);
+
+    if (ledChannel != -1) {
+      frequency = ledChannelFreq[ledChannel];
+      ledc_mode_t    mode;
+      ledc_channel_t channel;
+      getLedcChannel(ledChannel, mode, channel);
+
+      if ((fadeDuration_ms != 0) && ledcFadeInstall()) {
+        if (tempStatus.mode != PIN_MODE_PWM) {
+          ledc_set_duty(mode, channel, 0);
+          ledc_update_duty(mode, channel);
+        }
 
-    const int32_t step_value = ((static_cast<int32_t>(dutyCycle) - prev_value) * resolution_factor) / static_cast<int32_t>(fadeDuration_ms);
-    int32_t curr_value       = prev_value * resolution_factor;
-
-    int i = fadeDuration_ms;
-
-    while (i--) {
-      curr_value += step_value;
-      const int16_t new_value = curr_value / resolution_factor;
-            #if defined(ESP8266)
-      analogWrite(gpio, new_value);
-            #endif // if defined(ESP8266)
-            #if defined(ESP32)
-      frequency = analogWriteESP32(gpio, new_value, frequency);
-            #endif // if defined(ESP32)
-      delay(1);
+        // A running fade on this channel must end first, so this may block for the remaining fade time.
+        ledc_set_fade_with_time(mode, channel, dutyCycle, fadeDuration_ms);
+      } else {
+        ledc_set_duty(mode, channel, dutyCycle);
+      }
     }
   }
-
-        #if defined(ESP8266)
-  analogWrite(gpio, dutyCycle);
-        #endif // if defined(ESP8266)
-        #if defined(ESP32)
-  frequency = analogWriteESP32(gpio, dutyCycle, frequency);
-        #endif // if defined(ESP32)
+  #endif // if defined(ESP32)
 
   // setPinState(pluginID, gpio, PIN_MODE_PWM, dutyCycle);
   tempStatus.mode      = PIN_MODE_PWM;
@@ -2410,6 +2559,79 @@ bool set_Gpio_PWM(int gpio, uint32_t dutyCycle, uint32_t fadeDuration_ms, uint32
   tempStatus.command   = 1; // set to 1 in order to display the status in the PinStatus page
 
   savePortStatus(key, tempStatus);
+  return ledChannel;
+}
+
+static void set_Gpio_PWM_apply(int8_t ledChannel, bool fade)
+{
+  #if defined(ESP8266)
+
+  if (fade) {
+    gpioPWMfadeStart();
+  }
+  #endif // if defined(ESP8266)
+  #if defined(ESP32)
+
+  if (ledChannel == -1) {
+    return;
+  }
+  ledc_mode_t    mode;
+  ledc_channel_t channel;
+  getLedcChannel(ledChannel, mode, channel);
+
+  if (fade && ledcFadeInstall()) {
+    ledc_fade_start(mode, channel, LEDC_FADE_NO_WAIT);
+  } else {
+    ledc_update_duty(mode, channel);
+  }
+  #endif // if defined(ESP32)
+}
+
+bool set_Gpio_PWM_pct(int gpio, float dutyCycle_f, uint32_t frequency) {
+  uint32_t dutyCycle = dutyCycle_f * 10.23f;
+
+  return set_Gpio_PWM(gpio, dutyCycle, frequency);
+}
+
+bool set_Gpio_PWM(int gpio, uint32_t dutyCycle, uint32_t frequency) {
+  uint32_t key;
+
+  return set_Gpio_PWM(gpio, dutyCycle, 0, frequency, key);
+}
+
+bool set_Gpio_PWM(int gpio, uint32_t dutyCycle, uint32_t fadeDuration_ms, uint32_t& frequency, uint32_t& key)
+{
+  // For now, we only support the internal GPIO pins.
+  if (!checkValidPortRange(PLUGIN_GPIO, gpio)) {
+    return false;
+  }
+  set_Gpio_PWM_apply(set_Gpio_PWM_prepare(gpio, dutyCycle, fadeDuration_ms, frequency, key), fadeDuration_ms != 0);
+  return true;
+}
+
+bool set_Gpio_PWM_group(const int gpios[], const uint32_t dutyCycles[], uint8_t nrPins, uint32_t fadeDuration_ms, uint32_t frequency)
+{
+  if ((nrPins == 0) || (nrPins > GPIO_PWM_GROUP_MAX)) {
+    return false;
+  }
+
+  for (uint8_t i = 0; i < nrPins; ++i) {
+    if (!checkValidPortRange(PLUGIN_GPIO, gpios[i])) {
+      return false;
+    }
+  }
+  int8_t ledChannels[GPIO_PWM_GROUP_MAX];
+
+  for (uint8_t i = 0; i < nrPins; ++i) {
+    uint32_t freq = frequency;
+    uint32_t key;
+    ledChannels[i] = set_Gpio_PWM_prepare(gpios[i], dutyCycles[i], fadeDuration_ms, freq, key);
+  }
+
+  // Apply in a separate loop, so all pins start (almost) at the same time.
+  for (uint8_t i = 0; i < nrPins; ++i) {
+    set_Gpio_PWM_apply(ledChannels[i], fadeDuration_ms != 0);
+  }
   return true;
 }
 
@@ -2466,6 +2688,7 @@ void setBasicTaskValues(taskIndex_t taskIndex, unsigned long taskdevicetimer,
     }
   }
   Settings.TaskDeviceEnabled[taskIndex] = enabled;
+  Cache.invalidateEnabledTasks();
   //Settings.TaskDeviceEnabled[taskIndex].enabled = enabled;
   safe_strncpy(ExtraTaskSettings.TaskDeviceName, name.c_str(), sizeof(ExtraTaskSettings.TaskDeviceName));
 
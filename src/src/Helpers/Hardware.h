@@ -30,6 +30,19 @@ void I2CBegin(int8_t   sda,
               int8_t   scl,
               uint32_t clockFreq);
 
+#ifndef I2C_DEFAULT_CLOCK_STRETCH_LIMIT
+# ifdef ESP8266
+#  define I2C_DEFAULT_CLOCK_STRETCH_LIMIT  150000 // usec, default set by Wire.begin()
+# endif // ifdef ESP8266
+# ifdef ESP32
+#  define I2C_DEFAULT_CLOCK_STRETCH_LIMIT  50     // msec, default timeout of Wire
+# endif // ifdef ESP32
+#endif // ifndef I2C_DEFAULT_CLOCK_STRETCH_LIMIT
+
+// Clock stretch limit, ESP8266: usec, ESP32: msec. 0 = core default
+// Only changed when different from the current limit.
+void I2CSetClockStretchLimit(uint32_t limit);
+
 #if FEATURE_I2CMULTIPLEXER
 bool    isI2CMultiplexerEnabled();
 
@@ -38,8 +51,18 @@ void    I2CMultiplexerSelect(uint8_t i);
 
 void    I2CMultiplexerOff();
 
+// Skips the write when the value is already selected
 void    SetI2CMultiplexer(uint8_t toWrite);
 
+// Last value written to the multiplexer, 0 when no channel is selected
+uint8_t I2CMultiplexerSelected();
+
+// Force the next channel selection to be written, e.g. after a bus reset
+void    I2CMultiplexerInvalidate();
+
+// Value to write to the multiplexer for this task, 0 when not behind the multiplexer
+uint8_t I2CMultiplexerGetTaskSelection(taskIndex_t taskIndex);
+
 uint8_t I2CMultiplexerMaxChannels();
 
 void    I2CMultiplexerReset();
@@ -276,12 +299,23 @@ bool set_Gpio_PWM_pct(int      gpio,
 bool set_Gpio_PWM(int      gpio,
                   uint32_t dutyCycle,
                   uint32_t frequency = 0);
+// Fades run in the background (ESP32: LEDC hardware fade, ESP8266: shared timer)
 bool set_Gpio_PWM(int       gpio,
                   uint32_t  dutyCycle,
                   uint32_t  fadeDuration_ms,
                   uint32_t& frequency,
                   uint32_t& key);
 
+#define GPIO_PWM_GROUP_MAX  8
+
+// Set the duty cycle of several pins, started at the same time.
+// With fadeDuration_ms != 0, all pins fade in parallel.
+bool set_Gpio_PWM_group(const int      gpios[],
+                        const uint32_t dutyCycles[],
+                        uint8_t        nrPins,
+                        uint32_t       fadeDuration_ms,
+                        uint32_t       frequency = 0);
+
 
 // ********************************************************************************
 // change of device: cleanup old device and reset default settings
@@ -0,0 +1,35 @@
+#include "../Helpers/Hardware_PCNT.h"
+
+#if FEATURE_PULSE_PCNT || FEATURE_ENCODER_PCNT
+
+# include <driver/pcnt.h>
+
+// PCNT units in use, bit per unit
+static uint8_t Hardware_PCNTunits = 0;
+
+int8_t PCNT_claimUnit()
+{
+  for (int8_t i = 0; i < PCNT_UNIT_MAX; ++i) {
+    if ((Hardware_PCNTunits & (1 << i)) == 0) {
+      Hardware_PCNTunits |= (1 << i);
+      return i;
+    }
+  }
+  return -1;
+}
+
+void PCNT_releaseUnit(int8_t unit)
+{
+  if (unit >= 0) {
+    Hardware_PCNTunits &= ~(1 << unit);
+  }
+}
+
+bool PCNT_installISRservice()
+{
+  const esp_err_t res = pcnt_isr_service_install(0);
+
+  return (res == ESP_OK) || (res == ESP_ERR_INVALID_STATE);
+}
+
+#endif // if FEATURE_PULSE_PCNT || FEATURE_ENCODER_PCNT
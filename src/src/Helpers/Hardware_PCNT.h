@@ -0,0 +1,22 @@
+#ifndef HELPERS_HARDWARE_PCNT_H
+#define HELPERS_HARDWARE_PCNT_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_PULSE_PCNT || FEATURE_ENCODER_PCNT
+
+/*********************************************************************************************\
+* PCNT units are shared by all users of the PCNT peripheral (pulse counter, rotary encoder)
+\*********************************************************************************************/
+
+// @retval Claimed PCNT unit, or -1 when all units are in use
+int8_t PCNT_claimUnit();
+
+void   PCNT_releaseUnit(int8_t unit);
+
+// Install the PCNT ISR service, which may already be installed by another unit, or by other code
+bool   PCNT_installISRservice();
+
+#endif // if FEATURE_PULSE_PCNT || FEATURE_ENCODER_PCNT
+
+#endif // ifndef HELPERS_HARDWARE_PCNT_H
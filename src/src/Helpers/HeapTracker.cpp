@@ -0,0 +1,90 @@
+#include "../Helpers/HeapTracker.h"
+
+#if FEATURE_HEAP_TRACKER
+
+# include "../Helpers/Memory.h"
+
+static HeapTagStats_t  heapTagStats[static_cast<uint8_t>(HeapTag_e::NR_ELEMENTS)];
+static HeapTrackScope *heapTrackCurrentScope = nullptr;
+
+# ifdef ESP32
+static TaskHandle_t heapTrackMainTask = nullptr;
+# endif // ifdef ESP32
+
+static int32_t HeapTracker_getFreeMem() {
+  int32_t res = FreeMem();
+
+  # ifdef USE_SECOND_HEAP
+  res += FreeMem2ndHeap();
+  # endif // ifdef USE_SECOND_HEAP
+  return res;
+}
+
+const __FlashStringHelper* toString(HeapTag_e tag) {
+  switch (tag) {
+    case HeapTag_e::EventQueue:      return F("Event Queue");
+    case HeapTag_e::ControllerQueue: return F("Controller Queue");
+    case HeapTag_e::Log:             return F("Log");
+    case HeapTag_e::WebServer:       return F("Web Server");
+    case HeapTag_e::Plugins:         return F("Plugins");
+    case HeapTag_e::Rules:           return F("Rules");
+    case HeapTag_e::NR_ELEMENTS:     break;
+  }
+  return F("");
+}
+
+HeapTrackScope::HeapTrackScope(HeapTag_e tag) : _tag(tag)
+{
+  # ifdef ESP32
+
+  if ((heapTrackMainTask == nullptr) || (xTaskGetCurrentTaskHandle() != heapTrackMainTask)) {
+    return;
+  }
+  # endif // ifdef ESP32
+  _active               = true;
+  _parent               = heapTrackCurrentScope;
+  heapTrackCurrentScope = this;
+  _startFree            = HeapTracker_getFreeMem();
+}
+
+HeapTrackScope::~HeapTrackScope()
+{
+  if (!_active) {
+    return;
+  }
+  const int32_t allocated = _startFree - HeapTracker_getFreeMem();
+  const int32_t own       = allocated - _childDelta;
+
+  HeapTagStats_t& stats = heapTagStats[static_cast<uint8_t>(_tag)];
+
+  stats.current += own;
+
+  if (stats.current > stats.peak) {
+    stats.peak = stats.current;
+  }
+
+  if (own > 0) {
+    ++stats.allocations;
+  } else if (own < 0) {
+    ++stats.frees;
+  }
+
+  if (_parent != nullptr) {
+    _parent->_childDelta += allocated;
+  }
+  heapTrackCurrentScope = _parent;
+}
+
+void HeapTracker_init()
+{
+  # ifdef ESP32
+  heapTrackMainTask = xTaskGetCurrentTaskHandle();
+  # endif // ifdef ESP32
+}
+
+const HeapTagStats_t& HeapTracker_getStats(HeapTag_e tag)
+{
+  return heapTagStats[static_cast<uint8_t>(tag)];
+}
+
+#endif // if FEATURE_HEAP_TRACKER
@@ -0,0 +1,69 @@
+#ifndef HELPERS_HEAPTRACKER_H
+#define HELPERS_HEAPTRACKER_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_HEAP_TRACKER
+
+enum class HeapTag_e : uint8_t {
+  EventQueue,
+  ControllerQueue,
+  Log,
+  WebServer,
+  Plugins,
+  Rules,
+
+  NR_ELEMENTS // Keep as last
+};
+
+const __FlashStringHelper* toString(HeapTag_e tag);
+
+struct HeapTagStats_t {
+  int32_t  current{};     // Net nr of bytes allocated by the subsystem
+  int32_t  peak{};        // Max. of current since boot
+  uint32_t allocations{}; // Nr of scopes ending with more memory in use
+  uint32_t frees{};       // Nr of scopes ending with less memory in use
+};
+
+/*********************************************************************************************\
+* HeapTrackScope
+* Attribute the change in free heap during the lifetime of this object to a subsystem tag.
+* Use it like HeapSelectDram, at the start of a block which allocates or frees memory:
+*   HEAP_TRACK_SCOPE(EventQueue);
+* Nested scopes are subtracted from the outer scope, so each byte is counted only once.
+* Only the main loop is tracked, scopes in other tasks are ignored.
+* Allocations by interrupts or other tasks during a scope are attributed to it as well,
+* so the numbers are an indication of where memory is kept, not an exact accounting.
+\*********************************************************************************************/
+class HeapTrackScope {
+public:
+
+  explicit HeapTrackScope(HeapTag_e tag);
+  ~HeapTrackScope();
+
+  HeapTrackScope(const HeapTrackScope&)            = delete;
+  HeapTrackScope& operator=(const HeapTrackScope&) = delete;
+
+private:
+
+  HeapTrackScope *_parent     = nullptr;
+  int32_t         _startFree  = 0;
+  int32_t         _childDelta = 0; // Bytes allocated by nested scopes
+  HeapTag_e       _tag;
+  bool            _active = false;
+};
+
+// Must be called from the main loop task, before any scope is used.
+void                  HeapTracker_init();
+
+const HeapTagStats_t& HeapTracker_getStats(HeapTag_e tag);
+
+# define HEAP_TRACK_SCOPE(T) HeapTrackScope heap_track_scope_ ## T(HeapTag_e::T)
+
+#else // if FEATURE_HEAP_TRACKER
+
+# define HEAP_TRACK_SCOPE(T)
+
+#endif // if FEATURE_HEAP_TRACKER
+
+#endif // ifndef HELPERS_HEAPTRACKER_H
@@ -0,0 +1,136 @@
+#include "../Helpers/I2C_BusScanner.h"
+
+#ifdef WEBSERVER_I2C_SCANNER
+
+# include "../Globals/Settings.h"
+# include "../Helpers/ESPEasy_time_calc.h"
+# include "../Helpers/Hardware.h"
+# include "../Helpers/I2C_access.h"
+
+static std::vector<I2C_scan_result_t> I2C_scanner_result_list;
+
+static bool     I2C_scanner_active   = false;
+static int8_t   I2C_scanner_channel  = -1; // -1 = standard I2C bus
+static uint8_t  I2C_scanner_address  = 1;
+static uint8_t  I2C_scanner_nrBuses  = 1;
+static uint32_t I2C_scanner_finished = 0;
+static bool     I2C_scanner_done     = false;
+
+// Addresses found on the standard bus, to be skipped on the multiplexer channels
+static uint32_t I2C_scanner_mainBus[4] = { 0 };
+
+void I2C_scanner_start()
+{
+  if (I2C_scanner_active || !Settings.isI2CEnabled()) {
+    return;
+  }
+  I2C_scanner_result_list.clear();
+  memset(I2C_scanner_mainBus, 0, sizeof(I2C_scanner_mainBus));
+  I2C_scanner_channel = -1;
+  I2C_scanner_address = 1;
+  I2C_scanner_nrBuses = 1;
+  # if FEATURE_I2CMULTIPLEXER
+
+  if (isI2CMultiplexerEnabled()) {
+    I2C_scanner_nrBuses += I2CMultiplexerMaxChannels();
+  }
+  # endif // if FEATURE_I2CMULTIPLEXER
+  I2C_scanner_active = true;
+}
+
+void I2C_scanner_loop()
+{
+  if (!I2C_scanner_active) {
+    return;
+  }
+  I2CSelect_Max100kHz_ClockSpeed(); // Always scan in low speed to also find old/slow devices
+  # if FEATURE_I2CMULTIPLEXER
+
+  if (I2C_scanner_channel >= 0) {
+    I2CMultiplexerSelect(I2C_scanner_channel);
+  }
+  # endif // if FEATURE_I2CMULTIPLEXER
+
+  for (uint8_t i = 0; i < I2C_SCANNER_ADDRESSES_PER_SLICE && I2C_scanner_address <= 127; ++i, ++I2C_scanner_address) {
+    const uint8_t  address = I2C_scanner_address;
+    const uint32_t bit     = 1u << (address % 32);
+
+    if ((I2C_scanner_channel != -1) && (I2C_scanner_mainBus[address / 32] & bit)) {
+      // Ignore addresses already found on the standard bus when scanning multiplexer channels
+      continue;
+    }
+
+    I2C_wakeup(address); // Wakeup, workaround for slow-responding devices, see https://github.com/letscontrolit/ESPEasy/issues/3781
+    delay(1);
+    const uint64_t start    = getMicros64();
+    const uint8_t  error    = I2C_wakeup(address); // Get status
+    const int64_t  duration = usecPassedSince(start);
+    delay(1);
+
+    if ((error == 0) || (error == 3) || (error == 4)) {
+      I2C_scan_result_t result;
+      result.address       = address;
+      result.channel       = I2C_scanner_channel;
+      result.status        = error;
+      result.duration_usec = duration > 0xFFFF ? 0xFFFF : duration;
+      I2C_scanner_result_list.push_back(result);
+
+      if ((error == 0) && (I2C_scanner_channel == -1)) {
+        I2C_scanner_mainBus[address / 32] |= bit;
+      }
+
+      if (error == 4) {
+        I2CForceResetBus_swap_pins(address);
+      }
+    }
+  }
+  # if FEATURE_I2CMULTIPLEXER
+
+  if (I2C_scanner_channel >= 0) {
+    I2CMultiplexerOff();
+  }
+  # endif // if FEATURE_I2CMULTIPLEXER
+  I2CSelectHighClockSpeed(); // Reset bus to standard speed for the plugins
+
+  if (I2C_scanner_address > 127) {
+    ++I2C_scanner_channel;
+    I2C_scanner_address = 1;
+
+    if ((I2C_scanner_channel + 1) >= I2C_scanner_nrBuses) {
+      I2C_scanner_active   = false;
+      I2C_scanner_done     = true;
+      I2C_scanner_finished = millis();
+    }
+  }
+}
+
+bool I2C_scanner_running()
+{
+  return I2C_scanner_active;
+}
+
+uint8_t I2C_scanner_progress()
+{
+  if (!I2C_scanner_active) {
+    return 100;
+  }
+  const uint32_t done  = (I2C_scanner_channel + 1) * 127 + I2C_scanner_address - 1;
+  const uint32_t total = I2C_scanner_nrBuses * 127;
+
+  return (done * 100) / total;
+}
+
+int32_t I2C_scanner_age()
+{
+  if (!I2C_scanner_done) {
+    return -1;
+  }
+  return timePassedSince(I2C_scanner_finished);
+}
+
+const std::vector<I2C_scan_result_t>& I2C_scanner_results()
+{
+  return I2C_scanner_result_list;
+}
+
+#endif // ifdef WEBSERVER_I2C_SCANNER
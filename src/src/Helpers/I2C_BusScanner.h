@@ -0,0 +1,46 @@
+#ifndef HELPERS_I2C_BUSSCANNER_H
+#define HELPERS_I2C_BUSSCANNER_H
+
+#include "../../ESPEasy_common.h"
+
+#ifdef WEBSERVER_I2C_SCANNER
+
+# include <vector>
+
+// Nr of addresses probed per call of I2C_scanner_loop(), which runs 10x per second
+# ifndef I2C_SCANNER_ADDRESSES_PER_SLICE
+#  define I2C_SCANNER_ADDRESSES_PER_SLICE  16
+# endif // ifndef I2C_SCANNER_ADDRESSES_PER_SLICE
+
+struct I2C_scan_result_t {
+  uint8_t  address;
+  int8_t   channel;       // -1 = standard I2C bus, else multiplexer channel
+  uint8_t  status;        // Result of Wire.endTransmission(), 0 = device found
+  uint16_t duration_usec; // Duration of the address check
+};
+
+// ********************************************************************************
+// I2C bus scanner, running in the background in small slices,
+// so the loop is not blocked while scanning all addresses (and multiplexer channels).
+// The results are kept after the scan is finished.
+// ********************************************************************************
+
+// (Re)start a scan, does nothing when a scan is already running
+void                                  I2C_scanner_start();
+
+// Scan the next slice of addresses, called 10x per second
+void                                  I2C_scanner_loop();
+
+bool                                  I2C_scanner_running();
+
+// Progress of the running scan in percent
+uint8_t                               I2C_scanner_progress();
+
+// Msec since the last scan has finished, -1 when no scan has finished yet
+int32_t                               I2C_scanner_age();
+
+const std::vector<I2C_scan_result_t>& I2C_scanner_results();
+
+#endif // ifdef WEBSERVER_I2C_SCANNER
+
+#endif // ifndef HELPERS_I2C_BUSSCANNER_H
@@ -0,0 +1,187 @@
+#include "../Helpers/I2C_ClockProfile.h"
+
+#if FEATURE_I2C_CLOCK_PROFILE
+
+# include "../DataStructs/DeviceStruct.h"
+# include "../ESPEasyCore/ESPEasy_Log.h"
+# include "../Globals/Settings.h"
+# include "../Helpers/Hardware.h"
+# include "../Helpers/I2C_access.h"
+# include "../Helpers/StringConverter.h"
+
+// Nr of consecutive successful probes needed to accept a clock speed
+# define I2C_CLOCK_PROFILE_NR_PROBES  5
+
+// Max. clock stretch limit after backing off, ESP8266: usec, ESP32: msec
+# ifdef ESP8266
+#  define I2C_CLOCK_PROFILE_MAX_STRETCH_LIMIT  1000000
+# endif // ifdef ESP8266
+# ifdef ESP32
+#  define I2C_CLOCK_PROFILE_MAX_STRETCH_LIMIT  1000
+# endif // ifdef ESP32
+
+// Clock speeds tried by auto tune, highest first
+constexpr uint32_t I2C_autoTuneClockSpeeds[] = {
+  # ifdef ESP32
+  1000000,
+  # endif // ifdef ESP32
+  400000,
+  100000
+};
+
+constexpr uint8_t I2C_nrAutoTuneClockSpeeds = sizeof(I2C_autoTuneClockSpeeds) / sizeof(I2C_autoTuneClockSpeeds[0]);
+
+// Result of auto tune, 0 = not (yet) tuned
+struct I2C_taskClockProfile_t {
+  uint32_t clockSpeed        = 0;
+  uint32_t clockStretchLimit = 0;
+};
+
+static I2C_taskClockProfile_t I2C_taskClockProfiles[TASKS_MAX];
+
+const __FlashStringHelper* toString(I2C_clockProfile_e profile) {
+  switch (profile) {
+    case I2C_clockProfile_e::Default:      return F("Default");
+    case I2C_clockProfile_e::AutoTune:     return F("Auto tune");
+    case I2C_clockProfile_e::Fixed_100kHz: return F("100 kHz");
+    case I2C_clockProfile_e::Fixed_400kHz: return F("400 kHz");
+    case I2C_clockProfile_e::Fixed_1MHz:   return F("1 MHz");
+    case I2C_clockProfile_e::NR_ELEMENTS: break;
+  }
+  return F("");
+}
+
+I2C_clockProfile_e I2C_getTaskClockProfile(taskIndex_t taskIndex) {
+  const uint8_t profile = Settings.getI2CClockProfile(taskIndex);
+
+  if (profile < static_cast<uint8_t>(I2C_clockProfile_e::NR_ELEMENTS)) {
+    return static_cast<I2C_clockProfile_e>(profile);
+  }
+  return I2C_clockProfile_e::Default;
+}
+
+uint32_t I2C_getTaskClockSpeed(taskIndex_t taskIndex) {
+  if (!validTaskIndex(taskIndex)) {
+    return Settings.I2C_clockSpeed;
+  }
+
+  switch (I2C_getTaskClockProfile(taskIndex)) {
+    case I2C_clockProfile_e::AutoTune:
+
+      if (I2C_taskClockProfiles[taskIndex].clockSpeed != 0) {
+        return I2C_taskClockProfiles[taskIndex].clockSpeed;
+      }
+
+      // Not yet tuned, use the slow clock speed
+      return Settings.I2C_clockSpeed_Slow;
+    case I2C_clockProfile_e::Fixed_100kHz: return 100000;
+    case I2C_clockProfile_e::Fixed_400kHz: return 400000;
+    case I2C_clockProfile_e::Fixed_1MHz:   return 1000000;
+    case I2C_clockProfile_e::Default:
+    case I2C_clockProfile_e::NR_ELEMENTS:
+      break;
+  }
+
+  if (bitRead(Settings.I2C_Flags[taskIndex], I2C_FLAGS_SLOW_SPEED)) {
+    return Settings.I2C_clockSpeed_Slow;
+  }
+  return Settings.I2C_clockSpeed;
+}
+
+uint32_t I2C_getTaskClockStretchLimit(taskIndex_t taskIndex) {
+  if (validTaskIndex(taskIndex) &&
+      (I2C_getTaskClockProfile(taskIndex) == I2C_clockProfile_e::AutoTune) &&
+      (I2C_taskClockProfiles[taskIndex].clockStretchLimit != 0)) {
+    return I2C_taskClockProfiles[taskIndex].clockStretchLimit;
+  }
+  return Settings.WireClockStretchLimit;
+}
+
+void I2CSelectTaskClockSpeed(taskIndex_t taskIndex) {
+  // Both only change the settings when different from the current ones
+  I2CSelectClockSpeed(I2C_getTaskClockSpeed(taskIndex));
+  I2CSetClockStretchLimit(I2C_getTaskClockStretchLimit(taskIndex));
+}
+
+static void I2C_logTaskClockProfile(taskIndex_t taskIndex) {
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    addLogMove(LOG_LEVEL_INFO, strformat(
+                 F("I2C  : Task %d clock speed %u kHz, clock stretch limit %u"),
+                 taskIndex + 1,
+                 static_cast<unsigned int>(I2C_getTaskClockSpeed(taskIndex) / 1000),
+                 static_cast<unsigned int>(I2C_getTaskClockStretchLimit(taskIndex))));
+  }
+}
+
+void I2C_autoTuneTaskClockSpeed(taskIndex_t taskIndex, uint8_t i2caddr) {
+  if (!validTaskIndex(taskIndex) ||
+      (I2C_getTaskClockProfile(taskIndex) != I2C_clockProfile_e::AutoTune)) {
+    return;
+  }
+  I2C_taskClockProfile_t& profile = I2C_taskClockProfiles[taskIndex];
+
+  profile = I2C_taskClockProfile_t();
+
+  // Probe with the default clock stretch limit
+  I2CSetClockStretchLimit(Settings.WireClockStretchLimit);
+
+  for (uint8_t i = 0; i < I2C_nrAutoTuneClockSpeeds && profile.clockSpeed == 0; ++i) {
+    I2CSelectClockSpeed(I2C_autoTuneClockSpeeds[i]);
+    uint8_t nrOk = 0;
+
+    while (nrOk < I2C_CLOCK_PROFILE_NR_PROBES && I2C_wakeup(i2caddr) == 0) {
+      ++nrOk;
+    }
+
+    if (nrOk == I2C_CLOCK_PROFILE_NR_PROBES) {
+      profile.clockSpeed = I2C_autoTuneClockSpeeds[i];
+    }
+  }
+
+  // When the device does not respond at all, the slow clock speed is used.
+  I2CSelectTaskClockSpeed(taskIndex);
+  I2C_logTaskClockProfile(taskIndex);
+}
+
+void I2C_taskClockSpeedBackoff(taskIndex_t taskIndex) {
+  if (!validTaskIndex(taskIndex) ||
+      (I2C_getTaskClockProfile(taskIndex) != I2C_clockProfile_e::AutoTune)) {
+    return;
+  }
+  I2C_taskClockProfile_t& profile = I2C_taskClockProfiles[taskIndex];
+  const uint32_t currentSpeed     = I2C_getTaskClockSpeed(taskIndex);
+  uint32_t nextSpeed              = 0;
+
+  for (uint8_t i = 0; i < I2C_nrAutoTuneClockSpeeds && nextSpeed == 0; ++i) {
+    if (I2C_autoTuneClockSpeeds[i] < currentSpeed) {
+      nextSpeed = I2C_autoTuneClockSpeeds[i];
+    }
+  }
+
+  if ((nextSpeed != 0) && (Settings.I2C_clockSpeed_Slow < currentSpeed)) {
+    // Do not go below the slow clock speed
+    profile.clockSpeed = std::max(nextSpeed, Settings.I2C_clockSpeed_Slow);
+  } else {
+    // Already at the lowest clock speed, allow the device more time
+    uint32_t limit = I2C_getTaskClockStretchLimit(taskIndex);
+
+    if (limit == 0) {
+      limit = I2C_DEFAULT_CLOCK_STRETCH_LIMIT;
+    }
+
+    if (limit >= I2C_CLOCK_PROFILE_MAX_STRETCH_LIMIT) {
+      return;
+    }
+    profile.clockSpeed        = currentSpeed;
+    profile.clockStretchLimit = std::min(2 * limit, static_cast<uint32_t>(I2C_CLOCK_PROFILE_MAX_STRETCH_LIMIT));
+  }
+  I2C_logTaskClockProfile(taskIndex);
+}
+
+void I2C_clearTaskClockProfile(taskIndex_t taskIndex) {
+  if (validTaskIndex(taskIndex)) {
+    I2C_taskClockProfiles[taskIndex] = I2C_taskClockProfile_t();
+  }
+}
+
+#endif // if FEATURE_I2C_CLOCK_PROFILE
@@ -0,0 +1,47 @@
+#ifndef HELPERS_I2C_CLOCKPROFILE_H
+#define HELPERS_I2C_CLOCKPROFILE_H
+
+#include "../../ESPEasy_common.h"
+
+#include "../DataTypes/TaskIndex.h"
+
+#if FEATURE_I2C_CLOCK_PROFILE
+
+// Stored in bit 2 ... 4 of Settings.I2C_Flags, do not change the values
+enum class I2C_clockProfile_e : uint8_t {
+  Default      = 0, // Normal clock speed, or slow clock speed when 'Force Slow I2C speed' is checked
+  AutoTune     = 1, // Highest reliable clock speed, determined at task init
+  Fixed_100kHz = 2,
+  Fixed_400kHz = 3,
+  Fixed_1MHz   = 4,
+
+  NR_ELEMENTS // Keep as last
+};
+
+const __FlashStringHelper* toString(I2C_clockProfile_e profile);
+
+I2C_clockProfile_e         I2C_getTaskClockProfile(taskIndex_t taskIndex);
+
+// Clock speed and clock stretch limit to use for the task
+uint32_t                   I2C_getTaskClockSpeed(taskIndex_t taskIndex);
+uint32_t                   I2C_getTaskClockStretchLimit(taskIndex_t taskIndex);
+
+// Apply clock speed and clock stretch limit of the task.
+// Nothing is changed when the previous I2C task used the same values.
+void                       I2CSelectTaskClockSpeed(taskIndex_t taskIndex);
+
+// Probe the device, starting at the highest clock speed, and keep the highest
+// clock speed at which the device responds reliably.
+// Only for tasks using the AutoTune profile, called at PLUGIN_INIT.
+void                       I2C_autoTuneTaskClockSpeed(taskIndex_t taskIndex,
+                                                      uint8_t     i2caddr);
+
+// Device did not respond, use the next lower clock speed.
+// When already at the lowest speed, allow more clock stretching.
+void                       I2C_taskClockSpeedBackoff(taskIndex_t taskIndex);
+
+void                       I2C_clearTaskClockProfile(taskIndex_t taskIndex);
+
+#endif // if FEATURE_I2C_CLOCK_PROFILE
+
+#endif // ifndef HELPERS_I2C_CLOCKPROFILE_H
@@ -1,11 +1,15 @@
 #include "../Helpers/I2C_access.h"
 
 #include "../DataStructs/TimingStats.h"
+#include "../Globals/Cache.h"
 #include "../Globals/I2Cdev.h"
 #include "../Globals/Settings.h"
 #include "../Helpers/ESPEasy_time_calc.h"
+#include "../Helpers/Hardware.h"
 #include "../Helpers/StringConverter.h"
 
+#include <map>
+
 enum class I2C_clear_bus_state {
   Start,
   Wait_SCL_become_high,     // Wait for 2.5 seconds for SCL to become high after enabling pull-up resistors
@@ -348,6 +352,151 @@ int16_t I2C_readS16_LE_reg(uint8_t i2caddr, uint8_t reg, bool *is_ok) {
   return (int16_t)I2C_read16_LE_reg(i2caddr, reg, is_ok);
 }
 
+// **************************************************************************/
+// Reads length bytes starting at a given register over I2C in a single transfer
+// **************************************************************************/
+bool I2C_read_block_reg(uint8_t i2caddr, uint8_t reg, uint8_t *buffer, uint8_t length) {
+  if (buffer == nullptr) { return false; }
+
+  while (length > 0) {
+    const uint8_t nrBytes = length > I2C_MAX_TRANSFER_SIZE ? I2C_MAX_TRANSFER_SIZE : length;
+
+    if (!I2C_setRegister(i2caddr, reg, nullptr) || !I2C_requestFrom(i2caddr, nrBytes, nullptr)) {
+      return false;
+    }
+
+    for (uint8_t i = 0; i < nrBytes; ++i) {
+      *buffer++ = Wire.read();
+    }
+    reg    += nrBytes;
+    length -= nrBytes;
+  }
+  return true;
+}
+
+// **************************************************************************/
+// Scatter/gather read of several register blocks of a device
+// **************************************************************************/
+bool I2C_read_blocks_reg(uint8_t i2caddr, const I2C_reg_block_t *blocks, uint8_t nrBlocks) {
+  if (blocks == nullptr) { return false; }
+
+  uint8_t first = 0;
+
+  while (first < nrBlocks) {
+    // Collect adjacent blocks which fit in a single transfer
+    uint8_t  last        = first;
+    uint16_t totalLength = blocks[first].length;
+
+    while ((last + 1) < nrBlocks &&
+           (blocks[last + 1].reg == static_cast<uint16_t>(blocks[last].reg + blocks[last].length)) &&
+           (totalLength + blocks[last + 1].length) <= I2C_MAX_TRANSFER_SIZE) {
+      ++last;
+      totalLength += blocks[last].length;
+    }
+
+    if (last == first) {
+      if (!I2C_read_block_reg(i2caddr, blocks[first].reg, blocks[first].buffer, blocks[first].length)) {
+        return false;
+      }
+    } else {
+      if (!I2C_setRegister(i2caddr, blocks[first].reg, nullptr) ||
+          !I2C_requestFrom(i2caddr, static_cast<uint8_t>(totalLength), nullptr)) {
+        return false;
+      }
+
+      for (uint8_t b = first; b <= last; ++b) {
+        for (uint8_t i = 0; i < blocks[b].length; ++i) {
+          const uint8_t value = Wire.read();
+
+          if (blocks[b].buffer != nullptr) {
+            blocks[b].buffer[i] = value;
+          }
+        }
+      }
+    }
+    first = last + 1;
+  }
+  return true;
+}
+
+// **************************************************************************/
+// Register shadow cache
+// **************************************************************************/
+
+// Key: multiplexer selection (bits 16..23), I2C address (bits 8..15), register (bits 0..7)
+static std::map<uint32_t, uint8_t> I2C_shadow_registers;
+
+static uint32_t I2C_shadow_key(uint8_t i2caddr, uint8_t reg) {
+  uint32_t key = (static_cast<uint32_t>(i2caddr) << 8) | reg;
+
+#if FEATURE_I2CMULTIPLEXER
+  key |= static_cast<uint32_t>(I2CMultiplexerSelected()) << 16;
+#endif // if FEATURE_I2CMULTIPLEXER
+  return key;
+}
+
+bool I2C_write8_reg_shadow(uint8_t i2caddr, uint8_t reg, uint8_t value) {
+  const uint32_t key = I2C_shadow_key(i2caddr, reg);
+
+  if (I2C_write8_reg(i2caddr, reg, value)) {
+    I2C_shadow_registers[key] = value;
+    return true;
+  }
+
+  // Unknown what the device has now
+  I2C_shadow_registers.erase(key);
+  return false;
+}
+
+uint8_t I2C_read8_reg_shadow(uint8_t i2caddr, uint8_t reg, bool *is_ok) {
+  const uint32_t key = I2C_shadow_key(i2caddr, reg);
+  auto it            = I2C_shadow_registers.find(key);
+
+  if (it != I2C_shadow_registers.end()) {
+    if (is_ok != nullptr) {
+      *is_ok = true;
+    }
+    return it->second;
+  }
+
+  bool ok{};
+  const uint8_t value = I2C_read8_reg(i2caddr, reg, &ok);
+
+  if (ok) {
+    I2C_shadow_registers[key] = value;
+  }
+
+  if (is_ok != nullptr) {
+    *is_ok = ok;
+  }
+  return value;
+}
+
+bool I2C_update8_reg_shadow(uint8_t i2caddr, uint8_t reg, uint8_t mask, uint8_t value) {
+  bool is_ok{};
+  const uint8_t current = I2C_read8_reg_shadow(i2caddr, reg, &is_ok);
+
+  if (!is_ok) { return false; }
+
+  const uint8_t newValue = (current & ~mask) | (value & mask);
+
+  if (newValue == current) { return true; }
+  return I2C_write8_reg_shadow(i2caddr, reg, newValue);
+}
+
+void I2C_shadow_invalidate(uint8_t i2caddr) {
+  const uint32_t first = I2C_shadow_key(i2caddr, 0);
+  const uint32_t last  = I2C_shadow_key(i2caddr, 0xFF);
+
+  I2C_shadow_registers.erase(
+    I2C_shadow_registers.lower_bound(first),
+    I2C_shadow_registers.upper_bound(last));
+}
+
+void I2C_shadow_clear() {
+  I2C_shadow_registers.clear();
+}
+
 // *************************************************************************/
 // Checks if a device is responding on the address
 // Should be used in any I2C plugin case PLUGIN_INIT: before any initialization
@@ -386,6 +535,7 @@ bool I2C_deviceCheck(uint8_t     i2caddr,
           // Disable temporarily as device check failed
           // FIXME TD-er: Should reschedule call to PLUGIN_INIT????
           Settings.TaskDeviceEnabled[taskIndex] = false; // If the number of retries is reached, disable the device
+          Cache.invalidateEnabledTasks();
           # ifndef BUILD_NO_DEBUG
           addLog(LOG_LEVEL_ERROR, concat(F("I2C  : Device doesn't respond for task: "), static_cast<int>(taskIndex + 1)));
           # endif // ifndef BUILD_NO_DEBUG
@@ -119,6 +119,65 @@ int16_t I2C_readS16_LE_reg(uint8_t i2caddr,
                            uint8_t reg,
                            bool   *is_ok = nullptr);
 
+// **************************************************************************/
+// Reads length bytes starting at a given register over I2C in a single transfer
+// Larger blocks are split in transfers of at most I2C_MAX_TRANSFER_SIZE bytes,
+// which requires the device to auto-increment its register pointer.
+// **************************************************************************/
+#ifndef I2C_MAX_TRANSFER_SIZE
+# define I2C_MAX_TRANSFER_SIZE  32
+#endif // ifndef I2C_MAX_TRANSFER_SIZE
+
+bool I2C_read_block_reg(uint8_t  i2caddr,
+                        uint8_t  reg,
+                        uint8_t *buffer,
+                        uint8_t  length);
+
+// **************************************************************************/
+// Scatter/gather read of several register blocks of a device
+// Adjacent blocks (next reg == reg + length) are merged into a single transfer.
+// **************************************************************************/
+struct I2C_reg_block_t {
+  uint8_t  reg;
+  uint8_t  length;
+  uint8_t *buffer;
+};
+
+bool I2C_read_blocks_reg(uint8_t                i2caddr,
+                         const I2C_reg_block_t *blocks,
+                         uint8_t                nrBlocks);
+
+// **************************************************************************/
+// Register shadow cache
+// For write-only and configuration registers which only change when written by ESPEasy.
+// Values are kept per multiplexer channel, I2C address and register,
+// so a read-modify-write does not need a bus read once the register is known.
+// Call I2C_shadow_invalidate() after a device reset or power cycle.
+// **************************************************************************/
+
+// Writes the register and keeps the written value
+bool    I2C_write8_reg_shadow(uint8_t i2caddr,
+                              uint8_t reg,
+                              uint8_t value);
+
+// Returns the kept value, or reads it from the device when not yet known
+uint8_t I2C_read8_reg_shadow(uint8_t i2caddr,
+                             uint8_t reg,
+                             bool   *is_ok = nullptr);
+
+// Read-modify-write, only the bits set in mask are changed.
+// The write is skipped when the register already has the requested value.
+bool    I2C_update8_reg_shadow(uint8_t i2caddr,
+                               uint8_t reg,
+                               uint8_t mask,
+                               uint8_t value);
+
+// Forget all kept register values of this address on the selected multiplexer channel
+void    I2C_shadow_invalidate(uint8_t i2caddr);
+
+// Forget all kept register values
+void    I2C_shadow_clear();
+
 // *************************************************************************/
 // Checks if a device is responding on the address
 // Should be used in any I2C plugin case PLUGIN_INIT: before any initialization
@@ -0,0 +1,269 @@
+#include "../Helpers/I2C_async.h"
+
+#if FEATURE_I2C_ASYNC
+
+# include "../ESPEasyCore/ESPEasy_Log.h"
+# include "../Globals/Settings.h"
+# include "../Helpers/StringConverter.h"
+
+# include <driver/i2c.h>
+
+// Wire uses I2C_NUM_0 for the main I2C bus
+# define I2C_ASYNC_PORT  I2C_NUM_1
+
+// Sent to the queue to stop the task
+# define I2C_ASYNC_STOP  -1
+
+struct I2C_async_transaction_t {
+  I2C_async_callback_t callback;
+  void                *arg;
+  uint16_t             timeout_ms;
+  uint8_t              i2caddr;
+  uint8_t              writeLength;
+  uint8_t              readLength;
+  uint8_t              writeData[I2C_ASYNC_MAX_WRITE];
+  uint8_t              readData[I2C_ASYNC_MAX_READ];
+
+  // I2C_async_state_e, Free and Queued are set by the main loop, Busy, Done and Failed by the I2C task
+  uint8_t state;
+};
+
+static I2C_async_transaction_t I2C_async_transactions[I2C_ASYNC_MAX_TRANSACTIONS]{};
+static QueueHandle_t           I2C_async_queue       = nullptr;
+static TaskHandle_t            I2C_async_taskHandle  = nullptr;
+static SemaphoreHandle_t       I2C_async_stopped     = nullptr;
+
+static I2C_async_state_e I2C_async_loadState(const I2C_async_transaction_t& transaction) {
+  return static_cast<I2C_async_state_e>(__atomic_load_n(&transaction.state, __ATOMIC_ACQUIRE));
+}
+
+static void I2C_async_storeState(I2C_async_transaction_t& transaction, I2C_async_state_e state) {
+  __atomic_store_n(&transaction.state, static_cast<uint8_t>(state), __ATOMIC_RELEASE);
+}
+
+static bool I2C_async_validHandle(I2C_async_handle_t handle) {
+  return handle >= 0 && handle < I2C_ASYNC_MAX_TRANSACTIONS;
+}
+
+static esp_err_t I2C_async_execute(I2C_async_transaction_t& transaction) {
+  i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+
+  if (cmd == nullptr) {
+    return ESP_ERR_NO_MEM;
+  }
+  i2c_master_start(cmd);
+
+  if ((transaction.writeLength != 0) || (transaction.readLength == 0)) {
+    // Without data this is just an address probe
+    i2c_master_write_byte(cmd, (transaction.i2caddr << 1) | I2C_MASTER_WRITE, true);
+
+    if (transaction.writeLength != 0) {
+      i2c_master_write(cmd, transaction.writeData, transaction.writeLength, true);
+    }
+
+    if (transaction.readLength != 0) {
+      // Repeated start
+      i2c_master_start(cmd);
+    }
+  }
+
+  if (transaction.readLength != 0) {
+    i2c_master_write_byte(cmd, (transaction.i2caddr << 1) | I2C_MASTER_READ, true);
+    i2c_master_read(cmd, transaction.readData, transaction.readLength, I2C_MASTER_LAST_NACK);
+  }
+  i2c_master_stop(cmd);
+
+  const esp_err_t res = i2c_master_cmd_begin(I2C_ASYNC_PORT, cmd, pdMS_TO_TICKS(transaction.timeout_ms));
+
+  i2c_cmd_link_delete(cmd);
+  return res;
+}
+
+static void I2C_async_run(void *parameter) {
+  for (;;) {
+    I2C_async_handle_t handle = I2C_ASYNC_INVALID_HANDLE;
+
+    if (xQueueReceive(I2C_async_queue, &handle, portMAX_DELAY) != pdTRUE) {
+      continue;
+    }
+
+    if (handle == I2C_ASYNC_STOP) {
+      break;
+    }
+
+    if (I2C_async_validHandle(handle)) {
+      I2C_async_transaction_t& transaction = I2C_async_transactions[handle];
+      I2C_async_storeState(transaction, I2C_async_state_e::Busy);
+
+      const bool success = I2C_async_execute(transaction) == ESP_OK;
+      I2C_async_storeState(transaction, success ? I2C_async_state_e::Done : I2C_async_state_e::Failed);
+    }
+  }
+
+  i2c_driver_delete(I2C_ASYNC_PORT);
+  xSemaphoreGive(I2C_async_stopped);
+  vTaskDelete(nullptr);
+}
+
+bool I2C_async_begin() {
+  I2C_async_end();
+
+  if (!Settings.isI2C2Enabled()) {
+    return false;
+  }
+
+  if (I2C_async_queue == nullptr) {
+    I2C_async_queue = xQueueCreate(I2C_ASYNC_MAX_TRANSACTIONS + 1, sizeof(I2C_async_handle_t));
+  }
+
+  if (I2C_async_stopped == nullptr) {
+    I2C_async_stopped = xSemaphoreCreateBinary();
+  }
+
+  if ((I2C_async_queue == nullptr) || (I2C_async_stopped == nullptr)) {
+    addLog(LOG_LEVEL_ERROR, F("I2C2 : Could not allocate queue"));
+    return false;
+  }
+
+  i2c_config_t conf{};
+
+  conf.mode             = I2C_MODE_MASTER;
+  conf.sda_io_num       = Settings.Pin_i2c2_sda;
+  conf.scl_io_num       = Settings.Pin_i2c2_scl;
+  conf.sda_pullup_en    = GPIO_PULLUP_ENABLE;
+  conf.scl_pullup_en    = GPIO_PULLUP_ENABLE;
+  conf.master.clk_speed = Settings.I2C2_clockSpeed;
+
+  if ((i2c_param_config(I2C_ASYNC_PORT, &conf) != ESP_OK) ||
+      (i2c_driver_install(I2C_ASYNC_PORT, I2C_MODE_MASTER, 0, 0, 0) != ESP_OK)) {
+    addLog(LOG_LEVEL_ERROR, F("I2C2 : Could not initialize 2nd I2C bus"));
+    return false;
+  }
+
+  // Same priority as the main loop
+  xTaskCreatePinnedToCore(
+    I2C_async_run,
+    "I2C_async",
+    I2C_ASYNC_TASK_STACK_SIZE,
+    nullptr,
+    1,
+    &I2C_async_taskHandle,
+    I2C_ASYNC_TASK_CORE);
+
+  if (I2C_async_taskHandle == nullptr) {
+    i2c_driver_delete(I2C_ASYNC_PORT);
+    addLog(LOG_LEVEL_ERROR, F("RTOS : Could not start async I2C task"));
+    return false;
+  }
+
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    addLogMove(LOG_LEVEL_INFO, strformat(
+                 F("I2C2 : Async bus started, SDA: %d SCL: %d %u Hz"),
+                 Settings.Pin_i2c2_sda,
+                 Settings.Pin_i2c2_scl,
+                 static_cast<unsigned int>(Settings.I2C2_clockSpeed)));
+  }
+  return true;
+}
+
+void I2C_async_end() {
+  if (I2C_async_taskHandle == nullptr) {
+    return;
+  }
+  const I2C_async_handle_t stop = I2C_ASYNC_STOP;
+
+  // Queued transactions are processed first
+  xQueueSend(I2C_async_queue, &stop, portMAX_DELAY);
+  xSemaphoreTake(I2C_async_stopped, portMAX_DELAY);
+  I2C_async_taskHandle = nullptr;
+}
+
+bool I2C_async_active() {
+  return I2C_async_taskHandle != nullptr;
+}
+
+I2C_async_handle_t I2C_async_submit(uint8_t              i2caddr,
+                                    const uint8_t       *writeData,
+                                    uint8_t              writeLength,
+                                    uint8_t              readLength,
+                                    I2C_async_callback_t callback,
+                                    void                *arg,
+                                    uint16_t             timeout_ms) {
+  if ((I2C_async_taskHandle == nullptr) ||
+      (writeLength > I2C_ASYNC_MAX_WRITE) ||
+      (readLength > I2C_ASYNC_MAX_READ) ||
+      ((writeLength != 0) && (writeData == nullptr))) {
+    return I2C_ASYNC_INVALID_HANDLE;
+  }
+
+  for (I2C_async_handle_t handle = 0; handle < I2C_ASYNC_MAX_TRANSACTIONS; ++handle) {
+    I2C_async_transaction_t& transaction = I2C_async_transactions[handle];
+
+    if (I2C_async_loadState(transaction) == I2C_async_state_e::Free) {
+      transaction.callback    = callback;
+      transaction.arg         = arg;
+      transaction.timeout_ms  = timeout_ms;
+      transaction.i2caddr     = i2caddr;
+      transaction.writeLength = writeLength;
+      transaction.readLength  = readLength;
+
+      if (writeLength != 0) {
+        memcpy(transaction.writeData, writeData, writeLength);
+      }
+      I2C_async_storeState(transaction, I2C_async_state_e::Queued);
+
+      // Queue can hold all slots, so this never has to wait
+      xQueueSend(I2C_async_queue, &handle, 0);
+      return handle;
+    }
+  }
+  return I2C_ASYNC_INVALID_HANDLE;
+}
+
+I2C_async_state_e I2C_async_getState(I2C_async_handle_t handle) {
+  if (!I2C_async_validHandle(handle)) {
+    return I2C_async_state_e::Free;
+  }
+  return I2C_async_loadState(I2C_async_transactions[handle]);
+}
+
+bool I2C_async_getResult(I2C_async_handle_t handle, uint8_t *readData, uint8_t readLength) {
+  const I2C_async_state_e state = I2C_async_getState(handle);
+
+  if ((state != I2C_async_state_e::Done) && (state != I2C_async_state_e::Failed)) {
+    return false;
+  }
+  I2C_async_transaction_t& transaction = I2C_async_transactions[handle];
+  const bool success                   = state == I2C_async_state_e::Done;
+
+  if (success && (readData != nullptr)) {
+    memcpy(readData, transaction.readData, std::min(readLength, transaction.readLength));
+  }
+  I2C_async_storeState(transaction, I2C_async_state_e::Free);
+  return success;
+}
+
+void I2C_async_release(I2C_async_handle_t handle) {
+  I2C_async_getResult(handle, nullptr, 0);
+}
+
+void I2C_async_loop() {
+  for (I2C_async_handle_t handle = 0; handle < I2C_ASYNC_MAX_TRANSACTIONS; ++handle) {
+    I2C_async_transaction_t& transaction = I2C_async_transactions[handle];
+
+    if (transaction.callback == nullptr) {
+      // Handle is polled by its owner
+      continue;
+    }
+    const I2C_async_state_e state = I2C_async_loadState(transaction);
+
+    if ((state == I2C_async_state_e::Done) || (state == I2C_async_state_e::Failed)) {
+      const I2C_async_callback_t callback = transaction.callback;
+      transaction.callback = nullptr;
+      callback(state == I2C_async_state_e::Done, transaction.readData, transaction.readLength, transaction.arg);
+      I2C_async_storeState(transaction, I2C_async_state_e::Free);
+    }
+  }
+}
+
+#endif // if FEATURE_I2C_ASYNC
@@ -0,0 +1,98 @@
+#ifndef HELPERS_I2C_ASYNC_H
+#define HELPERS_I2C_ASYNC_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_I2C_ASYNC
+
+// Max. nr of transactions which can be pending at the same time
+# ifndef I2C_ASYNC_MAX_TRANSACTIONS
+#  define I2C_ASYNC_MAX_TRANSACTIONS  8
+# endif // ifndef I2C_ASYNC_MAX_TRANSACTIONS
+
+// Max. nr of bytes written/read per transaction
+# ifndef I2C_ASYNC_MAX_WRITE
+#  define I2C_ASYNC_MAX_WRITE         8
+# endif // ifndef I2C_ASYNC_MAX_WRITE
+# ifndef I2C_ASYNC_MAX_READ
+#  define I2C_ASYNC_MAX_READ          32
+# endif // ifndef I2C_ASYNC_MAX_READ
+
+# ifndef I2C_ASYNC_DEFAULT_TIMEOUT
+#  define I2C_ASYNC_DEFAULT_TIMEOUT   100 // msec
+# endif // ifndef I2C_ASYNC_DEFAULT_TIMEOUT
+
+# ifndef I2C_ASYNC_TASK_STACK_SIZE
+#  define I2C_ASYNC_TASK_STACK_SIZE   2048
+# endif // ifndef I2C_ASYNC_TASK_STACK_SIZE
+
+# ifndef I2C_ASYNC_TASK_CORE
+#  define I2C_ASYNC_TASK_CORE         0
+# endif // ifndef I2C_ASYNC_TASK_CORE
+
+enum class I2C_async_state_e : uint8_t {
+  Free,
+  Queued,
+  Busy,
+  Done,
+  Failed
+};
+
+// Index of a transaction slot, negative when invalid
+typedef int8_t I2C_async_handle_t;
+
+# define I2C_ASYNC_INVALID_HANDLE  -1
+
+// Called from the main loop when a transaction is finished.
+// readData is only valid during the callback, the handle is released after the callback returns.
+typedef void (*I2C_async_callback_t)(bool           success,
+                                     const uint8_t *readData,
+                                     uint8_t        readLength,
+                                     void          *arg);
+
+// ********************************************************************************
+// Queued non-blocking I2C transactions on the 2nd I2C controller of the ESP32.
+// The bus (Hardware page) runs with its own GPIO pins and clock speed,
+// so slow clock stretching devices do not hold the main loop.
+// Transactions are executed one after another by a FreeRTOS task, while the
+// main loop keeps using the 1st I2C controller via Wire.
+//
+// A transaction is an optional write, followed by an optional read with repeated start.
+// Either pass a callback, or poll the returned handle with I2C_async_getState()
+// and fetch the data with I2C_async_getResult(), which also releases the handle.
+// All functions must be called from the main loop.
+// ********************************************************************************
+
+// (Re)start with the current settings. Stops the bus when not configured.
+bool               I2C_async_begin();
+
+// Stop after all queued transactions are finished
+void               I2C_async_end();
+
+bool               I2C_async_active();
+
+I2C_async_handle_t I2C_async_submit(uint8_t              i2caddr,
+                                    const uint8_t       *writeData,
+                                    uint8_t              writeLength,
+                                    uint8_t              readLength,
+                                    I2C_async_callback_t callback   = nullptr,
+                                    void                *arg        = nullptr,
+                                    uint16_t             timeout_ms = I2C_ASYNC_DEFAULT_TIMEOUT);
+
+I2C_async_state_e  I2C_async_getState(I2C_async_handle_t handle);
+
+// Copy the read data and release the handle.
+// Returns false when the transaction failed or is not yet finished.
+bool               I2C_async_getResult(I2C_async_handle_t handle,
+                                       uint8_t           *readData,
+                                       uint8_t            readLength);
+
+// Release a finished handle without fetching the data
+void               I2C_async_release(I2C_async_handle_t handle);
+
+// Call the callbacks of finished transactions. Must be called from the main loop.
+void               I2C_async_loop();
+
+#endif // if FEATURE_I2C_ASYNC
+
+#endif // ifndef HELPERS_I2C_ASYNC_H
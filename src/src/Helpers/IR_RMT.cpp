@@ -0,0 +1,424 @@
+#include "../Helpers/IR_RMT.h"
+
+#if FEATURE_IR_RMT
+
+# include "../ESPEasyCore/ESPEasy_Log.h"
+
+# include <IRsend.h>
+
+# include <driver/rmt.h>
+
+# include <vector>
+
+// RX: 80 MHz APB clock / 160 => 2 usec per tick, the same resolution as IRrecv uses
+# define IR_RMT_RX_TICK_USEC           2
+# define IR_RMT_RX_CLK_DIV             (80 * IR_RMT_RX_TICK_USEC)
+
+// Ignore glitches shorter than this nr of APB clock ticks (max. 255 => 3.2 usec)
+# define IR_RMT_RX_FILTER              255
+
+// Max. duration of a single RMT item half (15 bits)
+# define IR_RMT_MAX_DURATION           32767
+
+# define IR_RMT_RX_BUFFER_SIZE         4096
+
+// TX: 80 MHz APB clock / 80 => 1 usec per tick. The carrier uses the undivided APB clock.
+# define IR_RMT_TX_CLK_DIV             80
+# define IR_RMT_CARRIER_CLOCK          80000000UL
+
+// Transmit what has been collected when a space of at least this length is sent.
+// This is the gap between messages or repeats, so the extra delay of the flush does no harm.
+# define IR_RMT_TX_FLUSH_GAP_USEC      20000
+
+/*********************************************************************************************\
+*  RX
+\*********************************************************************************************/
+static RingbufHandle_t IR_RMT_rx_ringbuffer = nullptr;
+
+bool IR_RMT_rx_begin(int8_t gpio_pin, uint8_t timeout_ms) {
+  IR_RMT_rx_end();
+
+  if (gpio_pin < 0) {
+    return false;
+  }
+  rmt_config_t rx_config{};
+
+  rx_config.rmt_mode                      = RMT_MODE_RX;
+  rx_config.channel                       = IR_RMT_RX_CHANNEL;
+  rx_config.gpio_num                      = static_cast<gpio_num_t>(gpio_pin);
+  rx_config.clk_div                       = IR_RMT_RX_CLK_DIV;
+  rx_config.mem_block_num                 = IR_RMT_RX_MEM_BLOCKS;
+  rx_config.rx_config.filter_en           = true;
+  rx_config.rx_config.filter_ticks_thresh = IR_RMT_RX_FILTER;
+  rx_config.rx_config.idle_threshold      =
+    std::min(static_cast<uint32_t>(timeout_ms) * 1000 / IR_RMT_RX_TICK_USEC, static_cast<uint32_t>(IR_RMT_MAX_DURATION));
+
+  if ((rmt_config(&rx_config) != ESP_OK) ||
+      (rmt_driver_install(rx_config.channel, IR_RMT_RX_BUFFER_SIZE, 0) != ESP_OK)) {
+    addLog(LOG_LEVEL_ERROR, F("IR: Could not install RMT RX channel"));
+    return false;
+  }
+
+  if ((rmt_get_ringbuf_handle(rx_config.channel, &IR_RMT_rx_ringbuffer) != ESP_OK) ||
+      (rmt_rx_start(rx_config.channel, true) != ESP_OK)) {
+    rmt_driver_uninstall(rx_config.channel);
+    IR_RMT_rx_ringbuffer = nullptr;
+    addLog(LOG_LEVEL_ERROR, F("IR: Could not start RMT RX channel"));
+    return false;
+  }
+  return true;
+}
+
+bool IR_RMT_rx_active() {
+  return IR_RMT_rx_ringbuffer != nullptr;
+}
+
+void IR_RMT_rx_enable(bool enable) {
+  if (IR_RMT_rx_ringbuffer == nullptr) {
+    return;
+  }
+
+  if (enable) {
+    rmt_rx_start(IR_RMT_RX_CHANNEL, true);
+  } else {
+    rmt_rx_stop(IR_RMT_RX_CHANNEL);
+  }
+}
+
+bool IR_RMT_rx_read(IRrecv *receiver) {
+  if ((IR_RMT_rx_ringbuffer == nullptr) || (receiver == nullptr)) {
+    return false;
+  }
+  size_t rx_size         = 0;
+  rmt_item32_t *rx_items = static_cast<rmt_item32_t *>(xRingbufferReceive(IR_RMT_rx_ringbuffer, &rx_size, 0));
+
+  if (rx_items == nullptr) {
+    return false;
+  }
+  const size_t nrItems = rx_size / sizeof(rmt_item32_t);
+  bool started         = false;
+  bool done            = false;
+
+  receiver->resume();
+
+  for (size_t i = 0; i < nrItems && !done; ++i) {
+    // The receiver output is active low, so level 0 is a mark.
+    const uint32_t levels[2]    = { rx_items[i].level0, rx_items[i].level1 };
+    const uint32_t durations[2] = { rx_items[i].duration0, rx_items[i].duration1 };
+
+    for (uint8_t half = 0; half < 2 && !done; ++half) {
+      if (durations[half] == 0) {
+        // End of the message, the idle time is not part of it
+        done = true;
+      } else if (started || (levels[half] == 0)) {
+        started = true;
+        done    = !receiver->addCapturedDuration(durations[half] * IR_RMT_RX_TICK_USEC);
+      }
+    }
+  }
+  vRingbufferReturnItem(IR_RMT_rx_ringbuffer, rx_items);
+
+  if (started) {
+    receiver->markCaptureComplete();
+  }
+  return started;
+}
+
+void IR_RMT_rx_end() {
+  if (IR_RMT_rx_ringbuffer == nullptr) {
+    return;
+  }
+  rmt_rx_stop(IR_RMT_RX_CHANNEL);
+  rmt_driver_uninstall(IR_RMT_RX_CHANNEL);
+  IR_RMT_rx_ringbuffer = nullptr;
+}
+
+/*********************************************************************************************\
+*  TX
+\*********************************************************************************************/
+class IR_RMT_Output : public IRsendHardwareOutput {
+public:
+
+  IR_RMT_Output() {
+    for (uint8_t i = 0; i < IR_RMT_TX_MAX_PINS; ++i) {
+      _pins[i] = -1;
+    }
+  }
+
+  bool handlesPin(const uint16_t pin) const override {
+    return findPin(pin) >= 0;
+  }
+
+  void setCarrier(const uint16_t pin, const uint32_t freq, const uint8_t duty) override {
+    if ((pin != _txPin) || (freq != _freq) || (duty != _duty)) {
+      flush();
+      _txPin = pin;
+      _freq  = freq;
+      _duty  = duty;
+    }
+  }
+
+  void mark(const uint16_t pin, const uint32_t usec) override {
+    add(pin, 1, usec);
+  }
+
+  void space(const uint16_t pin, const uint32_t usec) override {
+    add(pin, 0, usec);
+
+    if (usec >= IR_RMT_TX_FLUSH_GAP_USEC) {
+      flush();
+    }
+  }
+
+  bool addPin(int8_t gpio_pin, bool inverted) {
+    const int index = findPin(gpio_pin);
+
+    if (index >= 0) {
+      _inverted[index] = inverted;
+      return true;
+    }
+
+    for (uint8_t i = 0; i < IR_RMT_TX_MAX_PINS; ++i) {
+      if (_pins[i] < 0) {
+        _pins[i]     = gpio_pin;
+        _inverted[i] = inverted;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // @retval true when no pins are left
+  bool removePin(int8_t gpio_pin) {
+    const int index = findPin(gpio_pin);
+
+    if (index >= 0) {
+      if (gpio_pin == _txPin) {
+        _items.clear();
+        _pendingTicks = 0;
+        _halfOpen     = false;
+      }
+
+      if (gpio_pin == _attachedPin) {
+        release();
+      }
+      _pins[index] = -1;
+    }
+
+    for (uint8_t i = 0; i < IR_RMT_TX_MAX_PINS; ++i) {
+      if (_pins[i] >= 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool flush() {
+    emitPending();
+
+    if (_items.empty()) {
+      return true;
+    }
+
+    // A zero duration marks the end of the transmission
+    if (_halfOpen) {
+      _items.back().duration1 = 0;
+      _halfOpen               = false;
+    } else {
+      _items.push_back(rmt_item32_t{});
+    }
+
+    bool success = attach() &&
+                   (rmt_write_items(IR_RMT_TX_CHANNEL, _items.data(), _items.size(), true) == ESP_OK);
+
+    _items.clear();
+    return success;
+  }
+
+  // Disconnect the previously used pin from the RMT TX channel and turn the LED off
+  void release() {
+    if (_attachedPin >= 0) {
+      const int index = findPin(_attachedPin);
+      pinMode(_attachedPin, OUTPUT);
+      digitalWrite(_attachedPin, ((index >= 0) && _inverted[index]) ? HIGH : LOW);
+      _attachedPin = -1;
+    }
+  }
+
+private:
+
+  int findPin(int pin) const {
+    for (uint8_t i = 0; i < IR_RMT_TX_MAX_PINS; ++i) {
+      if ((_pins[i] >= 0) && (_pins[i] == pin)) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  void add(const uint16_t pin, uint32_t level, uint32_t usec) {
+    if (pin != _txPin) {
+      flush();
+      _txPin = pin;
+    }
+
+    if ((level != _pendingLevel) && (_pendingTicks != 0)) {
+      emitPending();
+    }
+    _pendingLevel  = level;
+    _pendingTicks += usec;
+  }
+
+  // Store the pending mark or space in RMT items, split when longer than a single item half can hold
+  void emitPending() {
+    while (_pendingTicks > 0) {
+      const uint32_t duration = std::min(_pendingTicks, static_cast<uint32_t>(IR_RMT_MAX_DURATION));
+
+      if (_halfOpen) {
+        _items.back().level1    = _pendingLevel;
+        _items.back().duration1 = duration;
+      } else {
+        rmt_item32_t item{};
+        item.level0    = _pendingLevel;
+        item.duration0 = duration;
+        _items.push_back(item);
+      }
+      _halfOpen      = !_halfOpen;
+      _pendingTicks -= duration;
+    }
+  }
+
+  // Connect the RMT TX channel to the pin and set the carrier.
+  // Done at every transmission, as pinMode() (e.g. from IRsend::begin()) disconnects the RMT TX signal.
+  bool attach() {
+    const int index = findPin(_txPin);
+
+    if ((index < 0) || !install()) {
+      return false;
+    }
+
+    if (_attachedPin != _txPin) {
+      release();
+    }
+
+    if (rmt_set_gpio(IR_RMT_TX_CHANNEL, RMT_MODE_TX, static_cast<gpio_num_t>(_txPin), _inverted[index]) != ESP_OK) {
+      return false;
+    }
+    _attachedPin = _txPin;
+
+    if ((_freq == 0) || (_duty >= 100)) {
+      return rmt_set_tx_carrier(IR_RMT_TX_CHANNEL, false, 0, 0, RMT_CARRIER_LEVEL_HIGH) == ESP_OK;
+    }
+    uint32_t period = IR_RMT_CARRIER_CLOCK / _freq;
+
+    if (period < 2) { period = 2; }
+
+    if (period > 0x1FFFE) { period = 0x1FFFE; } // High and low time are 16 bit each
+    uint32_t high = (period * _duty) / 100;
+
+    if (high < 1) { high = 1; }
+
+    if (high >= period) { high = period - 1; }
+
+    if (high > 0xFFFF) { high = 0xFFFF; }
+
+    if ((period - high) > 0xFFFF) { high = period - 0xFFFF; }
+
+    return rmt_set_tx_carrier(IR_RMT_TX_CHANNEL, true, high, period - high, RMT_CARRIER_LEVEL_HIGH) == ESP_OK;
+  }
+
+  bool install() {
+    if (_installed) {
+      return true;
+    }
+    rmt_config_t tx_config{};
+
+    tx_config.rmt_mode                 = RMT_MODE_TX;
+    tx_config.channel                  = IR_RMT_TX_CHANNEL;
+    tx_config.gpio_num                 = GPIO_NUM_NC;
+    tx_config.clk_div                  = IR_RMT_TX_CLK_DIV;
+    tx_config.mem_block_num            = 1;
+    tx_config.tx_config.idle_level     = RMT_IDLE_LEVEL_LOW;
+    tx_config.tx_config.idle_output_en = true;
+
+    if ((rmt_config(&tx_config) != ESP_OK) ||
+        (rmt_driver_install(tx_config.channel, 0, 0) != ESP_OK)) {
+      addLog(LOG_LEVEL_ERROR, F("IR: Could not install RMT TX channel"));
+      return false;
+    }
+    _installed = true;
+    return true;
+  }
+
+public:
+
+  void uninstall() {
+    release();
+
+    if (_installed) {
+      rmt_driver_uninstall(IR_RMT_TX_CHANNEL);
+      _installed = false;
+    }
+    _items.clear();
+    _pendingTicks = 0;
+    _halfOpen     = false;
+  }
+
+private:
+
+  std::vector<rmt_item32_t> _items;
+  uint32_t _pendingTicks = 0; // 1 usec per tick
+  uint32_t _pendingLevel = 0;
+  uint32_t _freq         = 38000;
+  uint8_t  _duty         = 50;
+  int      _txPin        = -1;
+  int      _attachedPin  = -1;
+  int8_t   _pins[IR_RMT_TX_MAX_PINS];
+  bool     _inverted[IR_RMT_TX_MAX_PINS]{};
+  bool     _halfOpen  = false;
+  bool     _installed = false;
+};
+
+static IR_RMT_Output *IR_RMT_output = nullptr;
+
+bool IR_RMT_tx_begin(int8_t gpio_pin, bool inverted) {
+  if (gpio_pin < 0) {
+    return false;
+  }
+
+  if (IR_RMT_output == nullptr) {
+    IR_RMT_output = new (std::nothrow) IR_RMT_Output();
+
+    if (IR_RMT_output == nullptr) {
+      return false;
+    }
+  }
+
+  if (!IR_RMT_output->addPin(gpio_pin, inverted)) {
+    return false;
+  }
+  IRsend::setHardwareOutput(IR_RMT_output);
+  return true;
+}
+
+bool IR_RMT_tx_flush() {
+  if (IR_RMT_output == nullptr) {
+    return false;
+  }
+  return IR_RMT_output->flush();
+}
+
+void IR_RMT_tx_end(int8_t gpio_pin) {
+  if (IR_RMT_output == nullptr) {
+    return;
+  }
+
+  if (IR_RMT_output->removePin(gpio_pin)) {
+    IRsend::setHardwareOutput(nullptr);
+    IR_RMT_output->uninstall();
+    delete IR_RMT_output;
+    IR_RMT_output = nullptr;
+  }
+}
+
+#endif // if FEATURE_IR_RMT
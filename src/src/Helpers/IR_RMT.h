@@ -0,0 +1,74 @@
+#ifndef HELPERS_IR_RMT_H
+#define HELPERS_IR_RMT_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_IR_RMT
+
+# include <IRrecv.h>
+
+/*********************************************************************************************\
+*  IR receive and transmit using the RMT peripheral of the ESP32.
+*
+*  RX: The RMT RX channel captures the mark/space durations of a complete message (ended by the
+*      receiver timeout) without a GPIO interrupt per edge. The durations are handed to IRrecv
+*      for decoding.
+*  TX: All IRsend instances on a registered GPIO pin (including the ones created by IRac and by
+*      the HeatpumpIR library) collect their marks and spaces here instead of bit-banging.
+*      The carrier is generated by the RMT TX channel. The collected signal is transmitted when
+*      a long gap is sent, or on IR_RMT_tx_flush().
+*
+*  A single RMT TX channel is shared by all registered pins and moved to the pin in use.
+\*********************************************************************************************/
+
+// RMT channels used, must not be used by anything else.
+// Dallas 1-Wire RMT and NeoPixelBus use other channels, see Dallas1WireRMT.h
+// The ESP32 has no RX ping-pong mode, so the RX channel needs memory blocks for a complete message.
+// Longer messages are lost, so these take the memory blocks of the next channels (1 ... 3) as well.
+# ifndef IR_RMT_TX_CHANNEL
+#  if defined(CONFIG_IDF_TARGET_ESP32S3)
+#   define IR_RMT_TX_CHANNEL         RMT_CHANNEL_2
+#   define IR_RMT_RX_CHANNEL         RMT_CHANNEL_4
+#   define IR_RMT_RX_MEM_BLOCKS      1
+#  else // if defined(CONFIG_IDF_TARGET_ESP32S3)
+#   define IR_RMT_TX_CHANNEL         RMT_CHANNEL_7
+#   define IR_RMT_RX_CHANNEL         RMT_CHANNEL_0
+#   define IR_RMT_RX_MEM_BLOCKS      4 // 256 items = 512 marks and spaces
+#  endif // if defined(CONFIG_IDF_TARGET_ESP32S3)
+# endif // ifndef IR_RMT_TX_CHANNEL
+
+// Max. nr. of GPIO pins registered for transmitting
+# ifndef IR_RMT_TX_MAX_PINS
+#  define IR_RMT_TX_MAX_PINS          4
+# endif // ifndef IR_RMT_TX_MAX_PINS
+
+// Start capturing on the RMT RX channel
+// @param timeout_ms  Idle time ending a message, max. 65 msec.
+bool IR_RMT_rx_begin(int8_t  gpio_pin,
+                     uint8_t timeout_ms);
+
+bool IR_RMT_rx_active();
+
+// Pause capturing, e.g. while transmitting
+void IR_RMT_rx_enable(bool enable);
+
+// Hand the next captured message (if any) to the receiver, resuming the receiver first.
+// Call right before receiver->decode()
+// @retval true when a message is ready to be decoded.
+bool IR_RMT_rx_read(IRrecv *receiver);
+
+void IR_RMT_rx_end();
+
+// Register a GPIO pin to transmit via the RMT TX channel
+bool IR_RMT_tx_begin(int8_t gpio_pin,
+                     bool   inverted);
+
+// Transmit the collected marks and spaces, blocks until done.
+bool IR_RMT_tx_flush();
+
+// Unregister the GPIO pin, the RMT TX channel is released when no pins are left.
+void IR_RMT_tx_end(int8_t gpio_pin);
+
+#endif // if FEATURE_IR_RMT
+
+#endif // ifndef HELPERS_IR_RMT_H
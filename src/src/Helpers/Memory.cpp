@@ -134,4 +134,136 @@ void *special_calloc(size_t num, size_t size) {
   #else
   return calloc(num, size);
   #endif
-}
\ No newline at end of file
+}
+
+/********************************************************************************************\
+   Allocation policy for large, long-lived buffers
+ \*********************************************************************************************/
+#ifdef ESP32
+# include <soc/soc_memory_layout.h>
+#endif // ifdef ESP32
+
+// Bytes allocated via the buffer allocation policy, in the regular [0] and secondary [1] heap.
+static uint32_t bufferHeapUsage[2] = { 0, 0 };
+
+MemoryHeap_e getPreferredHeap(MemoryBufferClass_e bufferClass)
+{
+  switch (bufferClass) {
+    case MemoryBufferClass_e::LogBuffer:       return MEMORY_HEAP_LOG_BUFFER;
+    case MemoryBufferClass_e::ControllerQueue: return MEMORY_HEAP_CONTROLLER_QUEUE;
+    case MemoryBufferClass_e::PluginStats:     return MEMORY_HEAP_PLUGIN_STATS;
+    case MemoryBufferClass_e::WebBuffer:       return MEMORY_HEAP_WEB_BUFFER;
+    case MemoryBufferClass_e::FileCache:       return MEMORY_HEAP_FILE_CACHE;
+    case MemoryBufferClass_e::DisplayBuffer:   return MEMORY_HEAP_DISPLAY_BUFFER;
+    case MemoryBufferClass_e::Generic:         return MEMORY_HEAP_GENERIC;
+    case MemoryBufferClass_e::NR_ELEMENTS:     break;
+  }
+  return MemoryHeap_e::Default;
+}
+
+static bool inSecondaryHeap(const void *ptr)
+{
+  #ifdef USE_SECOND_HEAP
+  return mmu_is_iram(ptr);
+  #elif defined(ESP32)
+  return esp_ptr_external_ram(ptr);
+  #else // ifdef USE_SECOND_HEAP
+  return false;
+  #endif // ifdef USE_SECOND_HEAP
+}
+
+static void *buffer_alloc(MemoryBufferClass_e bufferClass, size_t size, bool clear)
+{
+  if (size == 0) { return nullptr; }
+  const MemoryHeap_e heap = getPreferredHeap(bufferClass);
+  void *ptr               = nullptr;
+
+  if ((heap == MemoryHeap_e::Secondary) || (heap == MemoryHeap_e::SecondaryOnly)) {
+    #ifdef USE_SECOND_HEAP
+    HeapSelectIram ephemeral;
+    ptr = clear ? calloc(1, size) : malloc(size);
+    #elif defined(ESP32)
+
+    if (UsePSRAM()) {
+      ptr = clear
+        ? heap_caps_calloc(1, size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+        : heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    }
+    #endif // ifdef USE_SECOND_HEAP
+
+    if ((ptr == nullptr) && (heap == MemoryHeap_e::SecondaryOnly)) {
+      return nullptr;
+    }
+  }
+
+  if (ptr == nullptr) {
+    #ifdef USE_SECOND_HEAP
+    HeapSelectDram ephemeral;
+    #endif // ifdef USE_SECOND_HEAP
+    #ifdef ESP32
+
+    if (heap == MemoryHeap_e::Internal) {
+      ptr = clear
+        ? heap_caps_calloc(1, size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+        : heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    } else
+    #endif // ifdef ESP32
+    {
+      ptr = clear ? calloc(1, size) : malloc(size);
+    }
+  }
+
+  if (ptr != nullptr) {
+    bufferHeapUsage[inSecondaryHeap(ptr) ? 1 : 0] += size;
+  }
+  return ptr;
+}
+
+void *buffer_malloc(MemoryBufferClass_e bufferClass, size_t size)
+{
+  return buffer_alloc(bufferClass, size, false);
+}
+
+void *buffer_calloc(MemoryBufferClass_e bufferClass, size_t num, size_t size)
+{
+  return buffer_alloc(bufferClass, num * size, true);
+}
+
+void buffer_free(MemoryBufferClass_e bufferClass, void *ptr, size_t size)
+{
+  if (ptr == nullptr) { return; }
+  uint32_t& usage = bufferHeapUsage[inSecondaryHeap(ptr) ? 1 : 0];
+
+  usage = (usage > size) ? usage - size : 0;
+  free(ptr);
+}
+
+uint32_t getBufferHeapUsage(bool secondaryHeap)
+{
+  return bufferHeapUsage[secondaryHeap ? 1 : 0];
+}
+
+MemoryPolicyScope::MemoryPolicyScope(MemoryBufferClass_e bufferClass)
+{
+  #ifdef USE_SECOND_HEAP
+  _prevHeapId = umm_get_current_heap_id();
+
+  switch (getPreferredHeap(bufferClass)) {
+    case MemoryHeap_e::Secondary:
+    case MemoryHeap_e::SecondaryOnly:
+      umm_set_heap_by_id(UMM_HEAP_IRAM);
+      break;
+    case MemoryHeap_e::Default:
+    case MemoryHeap_e::Internal:
+      umm_set_heap_by_id(UMM_HEAP_DRAM);
+      break;
+  }
+  #endif // ifdef USE_SECOND_HEAP
+}
+
+MemoryPolicyScope::~MemoryPolicyScope()
+{
+  #ifdef USE_SECOND_HEAP
+  umm_set_heap_by_id(_prevHeapId);
+  #endif // ifdef USE_SECOND_HEAP
+}
@@ -55,4 +55,88 @@ unsigned long getMaxFreeBlock();
 
 void *special_malloc(uint32_t size);
 void *special_realloc(void *ptr, size_t size);
-void *special_calloc(size_t num, size_t size);
\ No newline at end of file
+void *special_calloc(size_t num, size_t size);
+
+/********************************************************************************************\
+   Allocation policy for large, long-lived buffers
+   Each buffer class is allocated in the heap preferred for that class.
+   The preferred heap can be set per build via the MEMORY_HEAP_xxx defines.
+ \*********************************************************************************************/
+enum class MemoryHeap_e : uint8_t {
+  Default,       // Regular heap
+  Secondary,     // ESP8266: 2nd heap in IRAM (USE_SECOND_HEAP), ESP32: PSRAM. Fall back to Default when not present or full.
+  SecondaryOnly, // Only allocate in the secondary heap, for buffers which are not worth taking memory from the regular heap.
+  Internal       // ESP32: Internal RAM only, e.g. for buffers used in DMA transfers
+};
+
+enum class MemoryBufferClass_e : uint8_t {
+  LogBuffer,       // Log ring buffer and serial write buffer
+  ControllerQueue, // Controller delay queues
+  PluginStats,     // PluginStats history buffers
+  WebBuffer,       // Web response cache
+  FileCache,       // Mirrored settings files
+  DisplayBuffer,   // Display line- and frame buffers
+  Generic,         // Other diagnostics and caches
+
+  NR_ELEMENTS // Keep as last
+};
+
+#ifndef MEMORY_HEAP_LOG_BUFFER
+# define MEMORY_HEAP_LOG_BUFFER        MemoryHeap_e::Secondary
+#endif // ifndef MEMORY_HEAP_LOG_BUFFER
+#ifndef MEMORY_HEAP_CONTROLLER_QUEUE
+# define MEMORY_HEAP_CONTROLLER_QUEUE  MemoryHeap_e::Secondary
+#endif // ifndef MEMORY_HEAP_CONTROLLER_QUEUE
+#ifndef MEMORY_HEAP_PLUGIN_STATS
+# ifdef ESP32
+#  define MEMORY_HEAP_PLUGIN_STATS     MemoryHeap_e::Secondary
+# else // ifdef ESP32
+
+// The 2nd heap on ESP8266 only allows fast 32-bit access, PluginStats history is accessed a lot.
+#  define MEMORY_HEAP_PLUGIN_STATS     MemoryHeap_e::Default
+# endif // ifdef ESP32
+#endif // ifndef MEMORY_HEAP_PLUGIN_STATS
+#ifndef MEMORY_HEAP_WEB_BUFFER
+# define MEMORY_HEAP_WEB_BUFFER        MemoryHeap_e::SecondaryOnly
+#endif // ifndef MEMORY_HEAP_WEB_BUFFER
+#ifndef MEMORY_HEAP_FILE_CACHE
+# define MEMORY_HEAP_FILE_CACHE        MemoryHeap_e::SecondaryOnly
+#endif // ifndef MEMORY_HEAP_FILE_CACHE
+#ifndef MEMORY_HEAP_DISPLAY_BUFFER
+# define MEMORY_HEAP_DISPLAY_BUFFER    MemoryHeap_e::Internal
+#endif // ifndef MEMORY_HEAP_DISPLAY_BUFFER
+#ifndef MEMORY_HEAP_GENERIC
+# define MEMORY_HEAP_GENERIC           MemoryHeap_e::Secondary
+#endif // ifndef MEMORY_HEAP_GENERIC
+
+MemoryHeap_e getPreferredHeap(MemoryBufferClass_e bufferClass);
+
+void        *buffer_malloc(MemoryBufferClass_e bufferClass,
+                           size_t              size);
+void        *buffer_calloc(MemoryBufferClass_e bufferClass,
+                           size_t              num,
+                           size_t              size);
+
+// Free a buffer allocated via buffer_malloc() or buffer_calloc().
+// size must be the allocated size, to keep track of the heap usage.
+void         buffer_free(MemoryBufferClass_e bufferClass,
+                         void               *ptr,
+                         size_t              size);
+
+// Nr of bytes currently allocated via buffer_malloc()/buffer_calloc() in the secondary or the regular heap.
+uint32_t     getBufferHeapUsage(bool secondaryHeap);
+
+// Select the preferred heap of the buffer class for all allocations within the scope, like String and std::vector.
+// Only has effect on ESP8266 with USE_SECOND_HEAP, as on ESP32 PSRAM is not used for generic allocations.
+class MemoryPolicyScope {
+public:
+
+  explicit MemoryPolicyScope(MemoryBufferClass_e bufferClass);
+  ~MemoryPolicyScope();
+
+private:
+
+#ifdef USE_SECOND_HEAP
+  size_t _prevHeapId;
+#endif // ifdef USE_SECOND_HEAP
+};
@@ -5,6 +5,7 @@
 #include "../../_Plugin_Helper.h"
 #include "../ESPEasyCore/ESPEasy_backgroundtasks.h"
 #include "../ESPEasyCore/Serial.h"
+#include "../Globals/Cache.h"
 #include "../Globals/ESPEasy_time.h"
 #include "../Globals/Statistics.h"
 #include "../Helpers/ESPEasy_FactoryDefault.h"
@@ -107,6 +108,7 @@ bool setTaskEnableStatus(struct EventStruct *event, bool enabled)
     // FIXME TD-er: Should this be a 'runtime' change, or actually change the intended state?
     //Settings.TaskDeviceEnabled[event->TaskIndex].enabled = enabled;
     Settings.TaskDeviceEnabled[event->TaskIndex] = enabled;
+    Cache.invalidateEnabledTasks();
 
     if (enabled) {
       // Schedule the plugin to be read.
@@ -6,6 +6,8 @@
 #include "../Helpers/ESPEasy_time_calc.h"
 #include "../Helpers/StringConverter.h"
 
+#include <algorithm>
+
 
 ModbusRTU_struct::~ModbusRTU_struct() {
   if (easySerial != nullptr) {
@@ -34,13 +36,16 @@ void ModbusRTU_struct::reset() {
   _reads_pass       = 0;
   _reads_crc_failed = 0;
   _reads_nodata     = 0;
+  _read_pending     = false;
+  _slave_stats.clear();
 }
 
-bool ModbusRTU_struct::init(const ESPEasySerialPort port, const int16_t serial_rx, const int16_t serial_tx, int16_t baudrate, uint8_t address) {
+bool ModbusRTU_struct::init(const ESPEasySerialPort port, const int16_t serial_rx, const int16_t serial_tx, uint32_t baudrate, uint8_t address) {
   return init(port, serial_rx, serial_tx, baudrate, address, -1);
 }
 
-bool ModbusRTU_struct::init(const ESPEasySerialPort port, const int16_t serial_rx, const int16_t serial_tx, int16_t baudrate, uint8_t address, int8_t dere_pin) {
+bool ModbusRTU_struct::init(const ESPEasySerialPort port, const int16_t serial_rx, const int16_t serial_tx, uint32_t baudrate, uint8_t address, int8_t dere_pin,
+                            bool detectDevice) {
   if ((serial_rx < 0) || (serial_tx < 0)) {
     return false;
   }
@@ -53,10 +58,21 @@ bool ModbusRTU_struct::init(const ESPEasySerialPort port, const int16_t serial_r
   _modbus_address = address;
   _dere_pin       = dere_pin;
 
+  // 3.5 characters of 11 bits
+  _inter_frame_gap = (38500 + baudrate - 1) / baudrate;
+
+  if (_inter_frame_gap < MODBUS_MIN_INTER_FRAME_GAP) {
+    _inter_frame_gap = MODBUS_MIN_INTER_FRAME_GAP;
+  }
+
   if (_dere_pin != -1) { // set output pin mode for DE/RE pin when used (for control MAX485)
     pinMode(_dere_pin, OUTPUT);
   }
 
+  if (!detectDevice) {
+    return true;
+  }
+
   detected_device_description = getDevice_description(_modbus_address);
 
   if (loglevelActiveFor(LOG_LEVEL_INFO)) {
@@ -78,6 +94,29 @@ void ModbusRTU_struct::getStatistics(uint32_t& pass, uint32_t& fail, uint32_t& n
   nodata = _reads_nodata;
 }
 
+bool ModbusRTU_struct::getStatistics(uint8_t slaveAddress, ModbusRTU_slaveStats& stats) const {
+  for (auto it = _slave_stats.begin(); it != _slave_stats.end(); ++it) {
+    if (it->address == slaveAddress) {
+      stats = *it;
+      return true;
+    }
+  }
+  return false;
+}
+
+void ModbusRTU_struct::setModbusAddress(uint8_t address) {
+  _modbus_address = address;
+}
+
+uint8_t ModbusRTU_struct::getModbusAddress() const {
+  return _modbus_address;
+}
+
+bool ModbusRTU_struct::readyToSend() const {
+  return isInitialized() && !_read_pending &&
+         (timePassedSince(_frame_end) >= static_cast<long>(_inter_frame_gap));
+}
+
 void ModbusRTU_struct::setModbusTimeout(uint16_t timeout) {
   _modbus_timeout = timeout;
 }
@@ -413,17 +452,7 @@ void ModbusRTU_struct::logModbusException(uint8_t value) {
    }
  */
 uint8_t ModbusRTU_struct::processCommand() {
-  // CRC-calculation
-  unsigned int crc =
-    ModRTU_CRC(_sendframe, _sendframe_used);
-
-  // Note, this number has low and high bytes swapped, so use it accordingly (or
-  // swap bytes)
-  uint8_t checksumHi = (uint8_t)((crc >> 8) & 0xFF);
-  uint8_t checksumLo = (uint8_t)(crc & 0xFF);
-
-  _sendframe[_sendframe_used++] = checksumLo;
-  _sendframe[_sendframe_used++] = checksumHi;
+  addCRC();
 
   int  nrRetriesLeft = 2;
   uint8_t return_value  = 0;
@@ -431,16 +460,9 @@ uint8_t ModbusRTU_struct::processCommand() {
   while (nrRetriesLeft > 0) {
     return_value = 0;
 
-    // Send the uint8_t array
-    startWrite();
-    easySerial->write(_sendframe, _sendframe_used);
-
-    // sent all data from buffer
-    easySerial->flush();
-    startRead();
+    transmitFrame();
 
     // Read answer from sensor
-    _recv_buf_used = 0;
     unsigned long timeout    = millis() + _modbus_timeout;
     bool validPacket         = false;
     bool invalidDueToTimeout = false;
@@ -463,7 +485,7 @@ uint8_t ModbusRTU_struct::processCommand() {
 
       if (_recv_buf_used > 2) {                                         // got length
         if (_recv_buf_used >= (3 + _recv_buf[2] + 2)) {                 // got whole pkt
-          crc          = ModRTU_CRC(_recv_buf, _recv_buf_used);         // crc16 is 0 for whole valid pkt
+          const unsigned int crc = ModRTU_CRC(_recv_buf, _recv_buf_used); // crc16 is 0 for whole valid pkt
           validPacket  = (crc == 0) && (_recv_buf[0] == _sendframe[0]); // check crc and address
           return_value = 0;                                             // reset return value
         }
@@ -471,17 +493,16 @@ uint8_t ModbusRTU_struct::processCommand() {
       delay(0);
     }
 
+    updateStatistics(validPacket, invalidDueToTimeout);
+
     // Check for MODBUS exception
     if (invalidDueToTimeout) {
-      ++_reads_nodata;
-
       if (_recv_buf_used == 0) {
         return_value = MODBUS_NODATA;
       } else {
         return_value = MODBUS_TIMEOUT;
       }
     } else if (!validPacket) {
-      ++_reads_crc_failed;
       return_value = MODBUS_BADCRC;
     } else {
       const uint8_t received_functionCode = _recv_buf[1];
@@ -489,8 +510,6 @@ uint8_t ModbusRTU_struct::processCommand() {
       if ((received_functionCode & 0x80) != 0) {
         return_value = _recv_buf[2];
       }
-      ++_reads_pass;
-      _reads_nodata = 0;
     }
 
     switch (return_value) {
@@ -559,6 +578,78 @@ int ModbusRTU_struct::readHoldingRegister(short address, uint8_t& errorcode) {
     _modbus_address, MODBUS_READ_HOLDING_REGISTERS, address, 1, errorcode);
 }
 
+uint8_t ModbusRTU_struct::readRegisters(uint8_t   slaveAddress,
+                                        uint8_t   functionCode,
+                                        uint16_t  startAddress,
+                                        uint16_t  nrRegisters,
+                                        uint16_t *values) {
+  if ((values == nullptr) || (nrRegisters == 0) || (nrRegisters > MODBUS_MAX_READ_REGISTERS)) {
+    return MODBUS_BADDATA;
+  }
+  buildFrame(slaveAddress, functionCode, startAddress, nrRegisters);
+  uint8_t errorcode = processCommand();
+
+  if ((errorcode == 0) && !decodeRegisters(values, nrRegisters)) {
+    errorcode = MODBUS_BADDATA;
+  }
+  logModbusException(errorcode);
+  return errorcode;
+}
+
+bool ModbusRTU_struct::startReadRegisters(uint8_t slaveAddress, uint8_t functionCode, uint16_t startAddress, uint16_t nrRegisters) {
+  if (!isInitialized() || (nrRegisters == 0) || (nrRegisters > MODBUS_MAX_READ_REGISTERS)) {
+    return false;
+  }
+  buildFrame(slaveAddress, functionCode, startAddress, nrRegisters);
+  addCRC();
+  transmitFrame();
+  _read_timeout = millis() + _modbus_timeout;
+  _read_pending = true;
+  return true;
+}
+
+uint8_t ModbusRTU_struct::pollReadRegisters(uint16_t *values, uint16_t nrRegisters) {
+  if (!_read_pending) {
+    // Cancelled by a blocking command in the mean time
+    return MODBUS_NODATA;
+  }
+
+  while (easySerial->available() && (_recv_buf_used < (MODBUS_RECEIVE_BUFFER - 1))) {
+    _recv_buf[_recv_buf_used++] = easySerial->read();
+  }
+  uint8_t return_value = MODBUS_BUSY;
+
+  if (_recv_buf_used > 2) {
+    // Exception reply: address, function code | 0x80, exception code, CRC
+    const uint8_t expected = ((_recv_buf[1] & 0x80) != 0) ? 5 : (3 + _recv_buf[2] + 2);
+
+    if (_recv_buf_used >= expected) {
+      const bool validPacket = (ModRTU_CRC(_recv_buf, expected) == 0) && (_recv_buf[0] == _sendframe[0]);
+      updateStatistics(validPacket, false);
+
+      if (!validPacket) {
+        return_value = MODBUS_BADCRC;
+      } else if ((_recv_buf[1] & 0x80) != 0) {
+        return_value = _recv_buf[2];
+      } else {
+        return_value = decodeRegisters(values, nrRegisters) ? 0 : MODBUS_BADDATA;
+      }
+    }
+  }
+
+  if ((return_value == MODBUS_BUSY) && timeOutReached(_read_timeout)) {
+    updateStatistics(false, true);
+    return_value = (_recv_buf_used == 0) ? MODBUS_NODATA : MODBUS_TIMEOUT;
+  }
+
+  if (return_value != MODBUS_BUSY) {
+    _read_pending = false;
+    _last_error   = return_value;
+    logModbusException(return_value);
+  }
+  return return_value;
+}
+
 // Write to holding register.
 int ModbusRTU_struct::writeSingleRegister(short address, short value) {
   // No check for the specific error code.
@@ -766,6 +857,92 @@ void ModbusRTU_struct::startWrite() {
   delay(2); // Switching may take some time
 }
 
+void ModbusRTU_struct::addCRC() {
+  // CRC-calculation
+  const unsigned int crc = ModRTU_CRC(_sendframe, _sendframe_used);
+
+  // Note, this number has low and high bytes swapped, so use it accordingly (or
+  // swap bytes)
+  _sendframe[_sendframe_used++] = (uint8_t)(crc & 0xFF);
+  _sendframe[_sendframe_used++] = (uint8_t)((crc >> 8) & 0xFF);
+}
+
+void ModbusRTU_struct::transmitFrame() {
+  // A new request cancels a pending non-blocking read, its late reply must not be mistaken for the new one.
+  _read_pending = false;
+
+  while (easySerial->available()) {
+    easySerial->read();
+  }
+
+  // Keep the inter-frame gap, only waits when a request immediately follows the previous reply
+  while (timePassedSince(_frame_end) < static_cast<long>(_inter_frame_gap)) {
+    delay(0);
+  }
+
+  // Send the uint8_t array
+  startWrite();
+  easySerial->write(_sendframe, _sendframe_used);
+
+  // sent all data from buffer
+  easySerial->flush();
+  startRead();
+  _recv_buf_used = 0;
+  _request_start = millis();
+}
+
+void ModbusRTU_struct::updateStatistics(bool validPacket, bool timeout) {
+  const uint8_t slaveAddress = _sendframe[0];
+  ModbusRTU_slaveStats *stats = nullptr;
+
+  for (auto it = _slave_stats.begin(); it != _slave_stats.end() && stats == nullptr; ++it) {
+    if (it->address == slaveAddress) {
+      stats = &(*it);
+    }
+  }
+
+  if (stats == nullptr) {
+    ModbusRTU_slaveStats newStats;
+    newStats.address = slaveAddress;
+    _slave_stats.push_back(newStats);
+    stats = &_slave_stats.back();
+  }
+
+  _frame_end = millis();
+
+  if (timeout) {
+    ++_reads_nodata;
+    ++stats->nodata;
+  } else if (!validPacket) {
+    ++_reads_crc_failed;
+    ++stats->fail;
+  } else {
+    ++_reads_pass;
+    _reads_nodata = 0;
+    ++stats->pass;
+    stats->lastLatency = timeDiff(_request_start, _frame_end);
+
+    if (stats->lastLatency > stats->maxLatency) {
+      stats->maxLatency = stats->lastLatency;
+    }
+  }
+}
+
+bool ModbusRTU_struct::decodeRegisters(uint16_t *values, uint16_t nrRegisters) const {
+  // Reply: address, function code, nr bytes, 2 bytes per register (high byte first), CRC
+  if ((values == nullptr) ||
+      (_recv_buf[2] != (2 * nrRegisters)) ||
+      (_recv_buf_used < (3 + 2 * nrRegisters + 2))) {
+    return false;
+  }
+  const uint8_t *data = &_recv_buf[3];
+
+  for (uint16_t i = 0; i < nrRegisters; ++i, data += 2) {
+    values[i] = (data[0] << 8) | data[1];
+  }
+  return true;
+}
+
 void ModbusRTU_struct::startRead() {
   if (!isInitialized()) { return; }
   easySerial->flush(); // clear out tx buffer
@@ -776,4 +953,298 @@ void ModbusRTU_struct::startRead() {
   }
 }
 
+/*********************************************************************************************\
+* ModbusRTU_RegisterMap
+\*********************************************************************************************/
+void ModbusRTU_RegisterMap::clear() {
+  _blocks.clear();
+  _values.clear();
+  _current     = 0;
+  _busy        = false;
+  _requestSent = false;
+  _completed   = false;
+}
+
+void ModbusRTU_RegisterMap::addRegisters(uint8_t functionCode, uint16_t address, uint8_t nrRegisters) {
+  if (nrRegisters == 0) {
+    return;
+  }
+  Block block;
+
+  block.functionCode = functionCode;
+  block.startAddress = address;
+  block.nrRegisters  = nrRegisters;
+  _blocks.push_back(block);
+}
+
+void ModbusRTU_RegisterMap::build(uint16_t maxGap) {
+  std::sort(_blocks.begin(), _blocks.end(), [](const Block& a, const Block& b) {
+    if (a.functionCode != b.functionCode) {
+      return a.functionCode < b.functionCode;
+    }
+    return a.startAddress < b.startAddress;
+  });
+
+  std::vector<Block> merged;
+
+  for (auto it = _blocks.begin(); it != _blocks.end(); ++it) {
+    if (!merged.empty()) {
+      Block& last              = merged.back();
+      const uint32_t lastEnd   = static_cast<uint32_t>(last.startAddress) + last.nrRegisters;
+      const uint32_t newEnd    = static_cast<uint32_t>(it->startAddress) + it->nrRegisters;
+      const uint32_t newLength = std::max(lastEnd, newEnd) - last.startAddress;
+
+      if ((last.functionCode == it->functionCode) &&
+          (it->startAddress <= (lastEnd + maxGap)) &&
+          (newLength <= MODBUS_MAX_READ_REGISTERS)) {
+        last.nrRegisters = newLength;
+        continue;
+      }
+    }
+    merged.push_back(*it);
+  }
+
+  uint16_t offset = 0;
+
+  for (auto it = merged.begin(); it != merged.end(); ++it) {
+    it->valueOffset = offset;
+    it->valid       = false;
+    offset         += it->nrRegisters;
+  }
+  _blocks.swap(merged);
+  _values.assign(offset, 0);
+  _current     = 0;
+  _busy        = false;
+  _requestSent = false;
+}
+
+bool ModbusRTU_RegisterMap::readAll(ModbusRTU_struct& modbus) {
+  bool success = !_blocks.empty();
+
+  _busy = false;
+
+  for (auto it = _blocks.begin(); it != _blocks.end(); ++it) {
+    it->valid = modbus.readRegisters(_slaveAddress, it->functionCode, it->startAddress, it->nrRegisters, &_values[it->valueOffset]) == 0;
+
+    if (!it->valid) {
+      success = false;
+    }
+  }
+  return success;
+}
+
+bool ModbusRTU_RegisterMap::startCycle() {
+  if (_busy || _blocks.empty()) {
+    return false;
+  }
+  _current     = 0;
+  _busy        = true;
+  _requestSent = false;
+  _completed   = false;
+  return true;
+}
+
+bool ModbusRTU_RegisterMap::loop(ModbusRTU_struct& modbus) {
+  if (!_busy) {
+    return false;
+  }
+
+  if (_current < _blocks.size()) {
+    Block& block = _blocks[_current];
+
+    if (!_requestSent) {
+      if (!modbus.readyToSend()) {
+        // Bus still busy or inter-frame gap not yet passed
+        return false;
+      }
+      _requestSent = modbus.startReadRegisters(_slaveAddress, block.functionCode, block.startAddress, block.nrRegisters);
+
+      if (_requestSent) {
+        return false;
+      }
+      block.valid = false;
+    } else {
+      const uint8_t result = modbus.pollReadRegisters(&_values[block.valueOffset], block.nrRegisters);
+
+      if (result == MODBUS_BUSY) {
+        return false;
+      }
+      block.valid  = (result == 0);
+      _requestSent = false;
+    }
+    ++_current;
+  }
+
+  if (_current < _blocks.size()) {
+    return false;
+  }
+  _busy      = false;
+  _completed = true;
+  return true;
+}
+
+bool ModbusRTU_RegisterMap::fetchCompleted() {
+  if (!_completed) {
+    return false;
+  }
+  _completed = false;
+  return true;
+}
+
+const uint16_t * ModbusRTU_RegisterMap::getValues(uint8_t functionCode, uint16_t address, uint8_t nrRegisters) const {
+  for (auto it = _blocks.begin(); it != _blocks.end(); ++it) {
+    if ((it->functionCode == functionCode) &&
+        (address >= it->startAddress) &&
+        ((static_cast<uint32_t>(address) + nrRegisters) <= (static_cast<uint32_t>(it->startAddress) + it->nrRegisters))) {
+      if (!it->valid) {
+        return nullptr;
+      }
+      return &_values[it->valueOffset + (address - it->startAddress)];
+    }
+  }
+  return nullptr;
+}
+
+bool ModbusRTU_RegisterMap::getRegister(uint8_t functionCode, uint16_t address, uint16_t& value) const {
+  const uint16_t *values = getValues(functionCode, address, 1);
+
+  if (values == nullptr) {
+    return false;
+  }
+  value = values[0];
+  return true;
+}
+
+bool ModbusRTU_RegisterMap::get32b(uint8_t functionCode, uint16_t address, uint32_t& value) const {
+  const uint16_t *values = getValues(functionCode, address, 2);
+
+  if (values == nullptr) {
+    return false;
+  }
+  value = (static_cast<uint32_t>(values[0]) << 16) | values[1];
+  return true;
+}
+
+bool ModbusRTU_RegisterMap::getFloat(uint8_t functionCode, uint16_t address, float& value) const {
+  union {
+    uint32_t ival;
+    float    fval;
+  } conversion;
+
+  if (!get32b(functionCode, address, conversion.ival)) {
+    return false;
+  }
+  value = conversion.fval;
+  return true;
+}
+
+/*********************************************************************************************\
+* ModbusRTU_bus
+\*********************************************************************************************/
+ModbusRTU_bus::ModbusRTU_bus(ESPEasySerialPort port, int16_t serial_rx, int16_t serial_tx, uint32_t baudrate, int8_t dere_pin)
+  : port(port), serial_rx(serial_rx), serial_tx(serial_tx), baudrate(baudrate), dere_pin(dere_pin) {}
+
+bool ModbusRTU_bus::usesPort(ESPEasySerialPort port, int16_t serial_rx, int16_t serial_tx) const {
+  return (this->port == port) && (this->serial_rx == serial_rx) && (this->serial_tx == serial_tx);
+}
+
+bool ModbusRTU_bus::enqueue(ModbusRTU_RegisterMap *registerMap) {
+  if ((registerMap == nullptr) || (registerMap == _active) ||
+      (std::find(_queue.begin(), _queue.end(), registerMap) != _queue.end())) {
+    return false;
+  }
+
+  // Insert after the maps with the same or higher priority
+  auto it = _queue.begin();
+
+  while ((it != _queue.end()) && ((*it)->getPriority() >= registerMap->getPriority())) {
+    ++it;
+  }
+  _queue.insert(it, registerMap);
+  return true;
+}
+
+void ModbusRTU_bus::remove(ModbusRTU_RegisterMap *registerMap) {
+  _queue.remove(registerMap);
+
+  if (_active == registerMap) {
+    // Late reply of a pending read is discarded when the next request is sent
+    _active = nullptr;
+  }
+}
+
+void ModbusRTU_bus::loop() {
+  if (_active == nullptr) {
+    if (_queue.empty() || !modbus.readyToSend()) {
+      return;
+    }
+    _active = _queue.front();
+    _queue.pop_front();
+
+    if (!_active->startCycle()) {
+      _active = nullptr;
+      return;
+    }
+  }
+
+  if (_active->loop(modbus)) {
+    _active = nullptr;
+  }
+}
+
+ModbusRTU_struct& ModbusRTU_bus::selectSlave(uint8_t address) {
+  modbus.setModbusAddress(address);
+  return modbus;
+}
+
+String ModbusRTU_bus::detectDevice(uint8_t address) {
+  const String description = selectSlave(address).getDevice_description(address);
+
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    addLog(LOG_LEVEL_INFO, description);
+    modbus.modbus_log_MEI(address);
+  }
+  return description;
+}
+
+static std::list<ModbusRTU_bus *> ModbusRTU_buses;
+
+ModbusRTU_bus* ModbusRTU_acquireBus(ESPEasySerialPort port, int16_t serial_rx, int16_t serial_tx, uint32_t baudrate, int8_t dere_pin) {
+  for (auto it = ModbusRTU_buses.begin(); it != ModbusRTU_buses.end(); ++it) {
+    if ((*it)->usesPort(port, serial_rx, serial_tx)) {
+      if (((*it)->baudrate != baudrate) || ((*it)->dere_pin != dere_pin)) {
+        addLog(LOG_LEVEL_ERROR, F("Modbus: Serial port already in use with other baudrate or DE/RE pin"));
+        return nullptr;
+      }
+      ++((*it)->refCount);
+      return *it;
+    }
+  }
+  ModbusRTU_bus *bus = new (std::nothrow) ModbusRTU_bus(port, serial_rx, serial_tx, baudrate, dere_pin);
+
+  if (bus == nullptr) {
+    return nullptr;
+  }
+
+  if (!bus->modbus.init(port, serial_rx, serial_tx, baudrate, MODBUS_BROADCAST_ADDRESS, dere_pin, false)) {
+    delete bus;
+    return nullptr;
+  }
+  bus->refCount = 1;
+  ModbusRTU_buses.push_back(bus);
+  return bus;
+}
+
+void ModbusRTU_releaseBus(ModbusRTU_bus *bus) {
+  if ((bus == nullptr) || (bus->refCount == 0)) {
+    return;
+  }
+  --(bus->refCount);
+
+  if (bus->refCount == 0) {
+    ModbusRTU_buses.remove(bus);
+    delete bus;
+  }
+}
+
 #endif
\ No newline at end of file
@@ -8,6 +8,9 @@
 #include "../../ESPEasy_common.h"
 #include <ESPeasySerial.h>
 
+#include <list>
+#include <vector>
+
 
 #define MODBUS_RECEIVE_BUFFER 256
 #define MODBUS_BROADCAST_ADDRESS 0xFE
@@ -44,6 +47,30 @@
 #define MODBUS_BADSLAVE (MODBUS_EXCEPTION_GATEWAY_TARGET + 6)
 #define MODBUS_TIMEOUT  (MODBUS_EXCEPTION_GATEWAY_TARGET + 7)
 #define MODBUS_NODATA   (MODBUS_EXCEPTION_GATEWAY_TARGET + 8)
+#define MODBUS_BUSY     (MODBUS_EXCEPTION_GATEWAY_TARGET + 9) // Non-blocking read still waiting for the reply
+
+// Max. nr of registers per read request, reply must fit in MODBUS_RECEIVE_BUFFER
+#define MODBUS_MAX_READ_REGISTERS    125
+
+// Max. nr of unused registers to read to join 2 ranges of a register map.
+// Reading a few extra registers is faster than an extra request with its turnaround time.
+#ifndef MODBUS_REGISTER_MAP_MAX_GAP
+# define MODBUS_REGISTER_MAP_MAX_GAP 8
+#endif // ifndef MODBUS_REGISTER_MAP_MAX_GAP
+
+// Min. silent time between frames, Modbus RTU requires 3.5 character times.
+#define MODBUS_MIN_INTER_FRAME_GAP   2 // msec
+
+
+// Statistics per slave address, so devices sharing a bus can be told apart.
+struct ModbusRTU_slaveStats {
+  uint8_t  address     = 0;
+  uint32_t pass        = 0;
+  uint32_t fail        = 0;
+  uint32_t nodata      = 0;
+  uint32_t lastLatency = 0; // msec between sending the request and receiving a valid reply
+  uint32_t maxLatency  = 0;
+};
 
 
 struct ModbusRTU_struct  {
@@ -56,15 +83,17 @@ struct ModbusRTU_struct  {
   bool init(const ESPEasySerialPort port,
             const int16_t serial_rx,
             const int16_t serial_tx,
-            int16_t       baudrate,
+            uint32_t      baudrate,
             uint8_t          address);
 
+  // When detectDevice is false, the slave is not scanned for its device description.
   bool init(const ESPEasySerialPort port,
             const int16_t serial_rx,
             const int16_t serial_tx,
-            int16_t       baudrate,
+            uint32_t      baudrate,
             uint8_t          address,
-            int8_t        dere_pin);
+            int8_t        dere_pin,
+            bool          detectDevice = true);
 
   bool isInitialized() const;
 
@@ -72,6 +101,18 @@ struct ModbusRTU_struct  {
                      uint32_t& fail,
                      uint32_t& nodata) const;
 
+  // Statistics of a single slave
+  // @retval false when nothing has been sent to this slave yet.
+  bool getStatistics(uint8_t               slaveAddress,
+                     ModbusRTU_slaveStats& stats) const;
+
+  void     setModbusAddress(uint8_t address);
+
+  uint8_t  getModbusAddress() const;
+
+  // True when no non-blocking read is pending and the inter-frame gap has passed.
+  bool     readyToSend() const;
+
   void     setModbusTimeout(uint16_t timeout);
 
   uint16_t getModbusTimeout() const;
@@ -140,6 +181,24 @@ struct ModbusRTU_struct  {
   int      readHoldingRegister(short address,
                                uint8_t& errorcode);
 
+  // Read a block of registers (function 0x03 or 0x04) in a single request.
+  // @retval 0 on success, else error code
+  uint8_t  readRegisters(uint8_t   slaveAddress,
+                         uint8_t   functionCode,
+                         uint16_t  startAddress,
+                         uint16_t  nrRegisters,
+                         uint16_t *values);
+
+  // Non-blocking version of readRegisters()
+  // Send the request, then call pollReadRegisters() until it no longer returns MODBUS_BUSY.
+  bool    startReadRegisters(uint8_t  slaveAddress,
+                             uint8_t  functionCode,
+                             uint16_t startAddress,
+                             uint16_t nrRegisters);
+
+  uint8_t pollReadRegisters(uint16_t *values,
+                            uint16_t  nrRegisters);
+
   // Write to holding register.
   int writeSingleRegister(short address,
                           short value);
@@ -205,6 +264,22 @@ private:
 
   void startRead();
 
+  // Append the CRC to _sendframe
+  void addCRC();
+
+  // Send _sendframe and prepare for receiving the reply
+  void transmitFrame();
+
+  // Copy the register values from a received read reply
+  bool decodeRegisters(uint16_t *values,
+                       uint16_t  nrRegisters) const;
+
+  // Count the result of a request, for the bus and for the slave it was sent to
+  void updateStatistics(bool validPacket,
+                        bool timeout);
+
+  std::vector<ModbusRTU_slaveStats> _slave_stats;
+
   uint8_t     _sendframe[12]                   = { 0 };
   uint8_t     _sendframe_used                  = 0;
   uint8_t     _recv_buf[MODBUS_RECEIVE_BUFFER] = { 0 };
@@ -216,10 +291,163 @@ private:
   uint32_t _reads_nodata                    = 0; // This will be reset as soon as a valid packet has been received.
   uint16_t _modbus_timeout                  = 180;
   uint8_t  _last_error                      = 0;
+  unsigned long _read_timeout               = 0; // Timeout of the pending non-blocking read
+  unsigned long _request_start              = 0; // Time the last request was sent
+  unsigned long _frame_end                  = 0; // Time the last reply was received or timed out
+  uint16_t _inter_frame_gap                 = MODBUS_MIN_INTER_FRAME_GAP;
+  bool     _read_pending                    = false;
 
   ESPeasySerial *easySerial = nullptr;
 };
 
+
+// Collects the registers a plugin needs and reads them with as few block reads as possible.
+// Call addRegisters() for each value, then build() to merge them into blocks.
+struct ModbusRTU_RegisterMap {
+  void clear();
+
+  void setSlaveAddress(uint8_t address) {
+    _slaveAddress = address;
+  }
+
+  uint8_t getSlaveAddress() const {
+    return _slaveAddress;
+  }
+
+  // Maps with a higher priority are read first when queued on a ModbusRTU_bus
+  void setPriority(uint8_t priority) {
+    _priority = priority;
+  }
+
+  uint8_t getPriority() const {
+    return _priority;
+  }
+
+  void addRegisters(uint8_t  functionCode,
+                    uint16_t address,
+                    uint8_t  nrRegisters = 1);
+
+  // Merge adjacent or nearby ranges with the same function code into block reads.
+  void build(uint16_t maxGap = MODBUS_REGISTER_MAP_MAX_GAP);
+
+  size_t nrBlocks() const {
+    return _blocks.size();
+  }
+
+  // Read all blocks, blocking.
+  // @retval true when all blocks were read successfully.
+  bool readAll(ModbusRTU_struct& modbus);
+
+  // Start reading all blocks, non-blocking.
+  // @retval false when still busy with a previous cycle.
+  bool startCycle();
+
+  bool cycleActive() const {
+    return _busy;
+  }
+
+  // Handle at most one request per call, for example from PLUGIN_FIFTY_PER_SECOND
+  // @retval true once, when all blocks of the started cycle have been handled.
+  bool loop(ModbusRTU_struct& modbus);
+
+  // For maps read by a ModbusRTU_bus
+  // @retval true once, after a cycle has been completed.
+  bool fetchCompleted();
+
+  // Get values from the last read, register order is big endian (high word first).
+  // @retval false when the register is not in the map or its block could not be read.
+  bool getRegister(uint8_t   functionCode,
+                   uint16_t  address,
+                   uint16_t& value) const;
+
+  bool get32b(uint8_t   functionCode,
+              uint16_t  address,
+              uint32_t& value) const;
+
+  bool getFloat(uint8_t  functionCode,
+                uint16_t address,
+                float  & value) const;
+
+private:
+
+  struct Block {
+    uint16_t startAddress = 0;
+    uint16_t nrRegisters  = 0;
+    uint16_t valueOffset  = 0; // Index of the first register in _values
+    uint8_t  functionCode = 0;
+    bool     valid        = false;
+  };
+
+  const uint16_t* getValues(uint8_t  functionCode,
+                            uint16_t address,
+                            uint8_t  nrRegisters) const;
+
+  std::vector<Block>    _blocks;
+  std::vector<uint16_t> _values;
+  uint8_t               _slaveAddress = 1;
+  uint8_t               _priority     = 0;
+  uint8_t               _current      = 0;
+  bool                  _busy         = false;
+  bool                  _requestSent  = false;
+  bool                  _completed    = false;
+};
+
+
+// Owner of a serial port (+ DE/RE pin) with one or more Modbus slaves, shared by all tasks using that bus.
+// Tasks queue their register map, the bus reads them one after another, non-blocking.
+struct ModbusRTU_bus {
+  ModbusRTU_bus(ESPEasySerialPort port,
+                int16_t           serial_rx,
+                int16_t           serial_tx,
+                uint32_t          baudrate,
+                int8_t            dere_pin);
+
+  bool usesPort(ESPEasySerialPort port,
+                int16_t           serial_rx,
+                int16_t           serial_tx) const;
+
+  // Queue a read cycle of the register map, ordered by priority.
+  // @retval false when the map is already queued or being read.
+  bool enqueue(ModbusRTU_RegisterMap *registerMap);
+
+  // Must be called before the register map is deleted.
+  void remove(ModbusRTU_RegisterMap *registerMap);
+
+  // Call frequently from all tasks using the bus, for example from PLUGIN_FIFTY_PER_SECOND
+  void loop();
+
+  // For blocking commands to a specific slave.
+  // Will cancel the block read of the active register map, if any.
+  ModbusRTU_struct& selectSlave(uint8_t address);
+
+  // Scan the device description of a slave and log its identification.
+  String detectDevice(uint8_t address);
+
+  ModbusRTU_struct  modbus;
+  ESPEasySerialPort port;
+  int16_t           serial_rx;
+  int16_t           serial_tx;
+  uint32_t          baudrate;
+  int8_t            dere_pin;
+  uint8_t           refCount = 0;
+
+private:
+
+  std::list<ModbusRTU_RegisterMap *> _queue;
+  ModbusRTU_RegisterMap             *_active = nullptr;
+};
+
+// Get the bus for the serial port, created when not used by another task.
+// @retval nullptr when the port could not be initialized, or is in use with other settings.
+ModbusRTU_bus* ModbusRTU_acquireBus(ESPEasySerialPort port,
+                                    int16_t           serial_rx,
+                                    int16_t           serial_tx,
+                                    uint32_t          baudrate,
+                                    int8_t            dere_pin);
+
+// Release the bus, deleted when no longer used by any task.
+void ModbusRTU_releaseBus(ModbusRTU_bus *bus);
+
 #endif
 
 #endif // HELPERS_MODBUS_RTU_H
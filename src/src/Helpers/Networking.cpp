@@ -11,6 +11,7 @@
 #include "../ESPEasyCore/ESPEasyNetwork.h"
 #include "../ESPEasyCore/ESPEasyWifi.h"
 #include "../ESPEasyCore/Serial.h"
+#include "../Globals/DNS_Cache.h"
 #include "../Globals/ESPEasyEthEvent.h"
 #include "../Globals/ESPEasyWiFiEvent.h"
 #include "../Globals/ESPEasy_Scheduler.h"
@@ -32,6 +33,7 @@
 #include "../Helpers/Numerical.h"
 #include "../Helpers/StringConverter.h"
 #include "../Helpers/StringProvider.h"
+#include "../Helpers/SyslogBuffer.h"
 
 #include "../../ESPEasy-Globals.h"
 
@@ -89,6 +91,7 @@ void etharp_gratuitous_r(struct netif *netif) {
 # ifdef ESP32
 #  include <HTTPClient.h>
 #  include <Update.h>
+#  include <ESP32UpdateInflate.h>
 # endif // ifdef ESP32
 #endif  // if FEATURE_DOWNLOAD
 
@@ -97,61 +100,72 @@ void etharp_gratuitous_r(struct netif *netif) {
 /*********************************************************************************************\
    Syslog client
 \*********************************************************************************************/
-void sendSyslog(uint8_t logLevel, const String& message)
+String getSyslogHeader(uint8_t logLevel)
 {
-  if ((Settings.Syslog_IP[0] != 0) && NetworkConnected())
-  {
-    IPAddress broadcastIP(Settings.Syslog_IP[0], Settings.Syslog_IP[1], Settings.Syslog_IP[2], Settings.Syslog_IP[3]);
+  unsigned int prio = Settings.SyslogFacility * 8;
 
-    FeedSW_watchdog();
+  if (logLevel == LOG_LEVEL_ERROR) {
+    prio += 3; // syslog error
+  }
+  else if (logLevel == LOG_LEVEL_INFO) {
+    prio += 5; // syslog notice
+  }
+  else {
+    prio += 7;
+  }
 
-    if (portUDP.beginPacket(broadcastIP, Settings.SyslogPort) == 0) {
-      // problem resolving the hostname or port
-      return;
-    }
-    unsigned int prio = Settings.SyslogFacility * 8;
+  // An RFC3164 compliant message must be formated like :  "<PRIO>[TimeStamp ]Hostname TaskName: Message"
 
-    if (logLevel == LOG_LEVEL_ERROR) {
-      prio += 3; // syslog error
-    }
-    else if (logLevel == LOG_LEVEL_INFO) {
-      prio += 5; // syslog notice
-    }
-    else {
-      prio += 7;
-    }
+  // Using Settings.Name as the Hostname (Hostname must NOT content space)
+  String header;
+  header += '<';
+  header += prio;
+  header += '>';
+  header += NetworkCreateRFCCompliantHostname(true);
+  header += F(" EspEasy: ");
+  header.trim();
+  header.replace(' ', '_');
+  return header;
+}
 
-    // An RFC3164 compliant message must be formated like :  "<PRIO>[TimeStamp ]Hostname TaskName: Message"
+bool sendSyslogPacket(const String& header, const String& message)
+{
+  if ((Settings.Syslog_IP[0] == 0) || !NetworkConnected()) {
+    return false;
+  }
+  IPAddress broadcastIP(Settings.Syslog_IP[0], Settings.Syslog_IP[1], Settings.Syslog_IP[2], Settings.Syslog_IP[3]);
 
-    // Using Settings.Name as the Hostname (Hostname must NOT content space)
-    {
-      String header;
-      header += '<';
-      header += prio;
-      header += '>';
-      header += NetworkCreateRFCCompliantHostname(true);
-      header += F(" EspEasy: ");
-      header.trim();
-      header.replace(' ', '_');
-      
-      #ifdef ESP8266
-      portUDP.write(header.c_str(),                                    header.length());
-      #endif // ifdef ESP8266
-      #ifdef ESP32
-      portUDP.write(reinterpret_cast<const uint8_t *>(header.c_str()), header.length());
-      #endif // ifdef ESP32
-    }
+  FeedSW_watchdog();
 
-    #ifdef ESP8266
-    portUDP.write(message.c_str(), message.length());
-    #endif // ifdef ESP8266
-    #ifdef ESP32
-    portUDP.write(reinterpret_cast<const uint8_t *>(message.c_str()), message.length());
-    #endif // ifdef ESP32
+  if (portUDP.beginPacket(broadcastIP, Settings.SyslogPort) == 0) {
+    // problem resolving the hostname or port
+    return false;
+  }
 
-    portUDP.endPacket();
-    FeedSW_watchdog();
-    delay(0);
+  #ifdef ESP8266
+  portUDP.write(header.c_str(),                                     header.length());
+  portUDP.write(message.c_str(),                                    message.length());
+  #endif // ifdef ESP8266
+  #ifdef ESP32
+  portUDP.write(reinterpret_cast<const uint8_t *>(header.c_str()),  header.length());
+  portUDP.write(reinterpret_cast<const uint8_t *>(message.c_str()), message.length());
+  #endif // ifdef ESP32
+
+  portUDP.endPacket();
+  FeedSW_watchdog();
+  delay(0);
+  return true;
+}
+
+void sendSyslog(uint8_t logLevel, const String& message)
+{
+  if ((Settings.Syslog_IP[0] != 0) && NetworkConnected())
+  {
+    #if FEATURE_SYSLOG_BUFFER
+    SyslogBuffer_add(logLevel, message);
+    #else // if FEATURE_SYSLOG_BUFFER
+    sendSyslogPacket(getSyslogHeader(logLevel), message);
+    #endif // if FEATURE_SYSLOG_BUFFER
   }
 }
 
@@ -172,8 +186,8 @@ void SendUDPCommand(uint8_t destUnit, const char *data, uint8_t dataLength)
     delay(10);
   } else {
     for (auto it = Nodes.begin(); it != Nodes.end(); ++it) {
-      if (it->first != Settings.Unit) {
-        sendUDP(it->first, (const uint8_t *)data, dataLength);
+      if (it->unit != Settings.Unit) {
+        sendUDP(it->unit, (const uint8_t *)data, dataLength);
         delay(10);
       }
     }
@@ -182,7 +196,7 @@ void SendUDPCommand(uint8_t destUnit, const char *data, uint8_t dataLength)
 }
 
 /*********************************************************************************************\
-   Send UDP message to specific unit (unit 255=broadcast)
+   Send UDP message to specific unit (unit 255=broadcast or multicast group)
 \*********************************************************************************************/
 void sendUDP(uint8_t unit, const uint8_t *data, uint8_t size)
 {
@@ -217,17 +231,54 @@ void sendUDP(uint8_t unit, const uint8_t *data, uint8_t size)
 /*********************************************************************************************\
    Update UDP port (ESPEasy propiertary protocol)
 \*********************************************************************************************/
+bool P2P_useMulticast()
+{
+  // 224.0.0.0 ... 239.255.255.255
+  return (Settings.P2P_MulticastGroup[0] >= 224) && (Settings.P2P_MulticastGroup[0] <= 239);
+}
+
+IPAddress P2P_multicastGroup()
+{
+  return IPAddress(Settings.P2P_MulticastGroup);
+}
+
+uint8_t P2P_nrKnownPeers()
+{
+  uint8_t res = 0;
+
+  for (auto it = Nodes.begin(); it != Nodes.end(); ++it) {
+    if ((it->unit != Settings.Unit) && (it->ip[0] != 0) && (res < 255)) {
+      ++res;
+    }
+  }
+  return res;
+}
+
+bool P2P_sendToGroup()
+{
+  if (!P2P_useMulticast()) {
+    return false;
+  }
+  const uint8_t nrPeers = P2P_nrKnownPeers();
+
+  return (nrPeers == 0) || (nrPeers > P2P_UNICAST_MAX_PEERS);
+}
+
 void updateUDPport()
 {
   static uint16_t lastUsedUDPPort = 0;
+  static uint32_t lastUsedGroup   = 0;
+
+  const uint32_t group = P2P_useMulticast() ? static_cast<uint32_t>(P2P_multicastGroup()) : 0;
 
-  if (Settings.UDPPort == lastUsedUDPPort) {
+  if ((Settings.UDPPort == lastUsedUDPPort) && (group == lastUsedGroup)) {
     return;
   }
 
   if (lastUsedUDPPort != 0) {
     portUDP.stop();
     lastUsedUDPPort = 0;
+    lastUsedGroup   = 0;
   }
 
   if (!NetworkConnected()) {
@@ -235,7 +286,20 @@ void updateUDPport()
   }
 
   if (Settings.UDPPort != 0) {
-    if (portUDP.begin(Settings.UDPPort) == 0) {
+    uint8_t res;
+
+    if (group != 0) {
+      // Also listens for unicast and broadcast packets on the port, and sends the IGMP join.
+      # ifdef ESP8266
+      res = portUDP.beginMulticast(NetworkLocalIP(), P2P_multicastGroup(), Settings.UDPPort);
+      # else // ifdef ESP8266
+      res = portUDP.beginMulticast(P2P_multicastGroup(), Settings.UDPPort);
+      # endif // ifdef ESP8266
+    } else {
+      res = portUDP.begin(Settings.UDPPort);
+    }
+
+    if (res == 0) {
       if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
         String log = F("UDP : Cannot bind to ESPEasy p2p UDP port ");
         log += String(Settings.UDPPort);
@@ -243,10 +307,16 @@ void updateUDPport()
       }
     } else {
       lastUsedUDPPort = Settings.UDPPort;
+      lastUsedGroup   = group;
 
       if (loglevelActiveFor(LOG_LEVEL_INFO)) {
         String log = F("UDP : Start listening on port ");
         log += String(Settings.UDPPort);
+
+        if (group != 0) {
+          log += F(", multicast group ");
+          log += formatIP(P2P_multicastGroup());
+        }
         addLogMove(LOG_LEVEL_INFO, log);
       }
     }
@@ -257,6 +327,20 @@ void updateUDPport()
    Check UDP messages (ESPEasy propiertary protocol)
 \*********************************************************************************************/
 boolean runningUPDCheck = false;
+struct UDP_receivedPacket {
+  uint16_t len;
+  uint8_t  remoteIP_last; // Last octet of the sender IP
+  char     data[UDP_PACKETSIZE_MAX];
+};
+
+// Allocated on first use, so it is not taking memory when the UDP port is not used.
+UDP_receivedPacket *UDP_receivePool = nullptr;
+
+uint32_t UDP_receivedCount      = 0;
+uint32_t UDP_droppedCount       = 0;
+uint32_t UDP_maxPacketsPerPass  = 0;
+uint32_t UDP_maxProcessingTime  = 0;
+
 void checkUDP()
 {
   if (Settings.UDPPort == 0) {
@@ -267,119 +351,198 @@ void checkUDP()
     return;
   }
 
+  if (UDP_receivePool == nullptr) {
+    UDP_receivePool = new (std::nothrow) UDP_receivedPacket[UDP_RECEIVE_POOL_SIZE];
+
+    if (UDP_receivePool == nullptr) {
+      return;
+    }
+  }
+
   runningUPDCheck = true;
 
-  // UDP events
-  int packetSize = portUDP.parsePacket();
+  const uint64_t start_usec = getMicros64();
 
-  if (packetSize > 0 /*&& portUDP.remotePort() == Settings.UDPPort*/)
-  {
-    statusLED(true);
+  // First read the pending packets into the pool, so lwIP can free its buffers
+  // before the (possibly slow) processing of the commands.
+  uint8_t nrPackets = 0;
 
-    IPAddress remoteIP = portUDP.remoteIP();
+  while (nrPackets < UDP_RECEIVE_POOL_SIZE &&
+         usecPassedSince(start_usec) < (UDP_RECEIVE_TIME_BUDGET * 1000ll)) {
+    const int packetSize = portUDP.parsePacket();
 
-    if (portUDP.remotePort() == 123)
-    {
-      // unexpected NTP reply, drop for now...
-      runningUPDCheck = false;
-      return;
+    if (packetSize <= 0) {
+      break;
     }
+    ++UDP_receivedCount;
 
     // UDP_PACKETSIZE_MAX should be as small as possible but still enough to hold all
     // data for PLUGIN_UDP_IN or CPLUGIN_UDP_IN calls
     // This node may also receive other UDP packets which may be quite large
     // and then crash due to memory allocation failures
-    if ((packetSize >= 2) && (packetSize < UDP_PACKETSIZE_MAX)) {
-      // Allocate buffer to process packet.
-      std::vector<char> packetBuffer;
-      packetBuffer.resize(packetSize + 1);
-
-      if (packetBuffer.size() >= static_cast<size_t>(packetSize)) {
-        memset(&packetBuffer[0], 0, packetSize + 1);
-        int len = portUDP.read(&packetBuffer[0], packetSize);
-
-        if (len >= 2) {
-          if (static_cast<uint8_t>(packetBuffer[0]) != 255)
-          {
-            packetBuffer[len] = 0;
-            # ifndef BUILD_NO_DEBUG
-            addLog(LOG_LEVEL_DEBUG, &packetBuffer[0]);
-            #endif
-            ExecuteCommand_all(EventValueSource::Enum::VALUE_SOURCE_SYSTEM, &packetBuffer[0]);
+    // Unexpected NTP replies are dropped too.
+    if ((portUDP.remotePort() == 123) || (packetSize < 2) || (packetSize >= UDP_PACKETSIZE_MAX)) {
+      ++UDP_droppedCount;
+    } else {
+      UDP_receivedPacket& packet = UDP_receivePool[nrPackets];
+      const int len              = portUDP.read(packet.data, packetSize);
+
+      if (len >= 2) {
+        packet.data[len]     = 0;
+        packet.len           = len;
+        packet.remoteIP_last = portUDP.remoteIP()[3];
+        ++nrPackets;
+      } else {
+        ++UDP_droppedCount;
+      }
+    }
+
+    // Flush any remaining content of the packet.
+    while (portUDP.available()) {
+      // Do not call portUDP.flush() as that's meant to sending the packet (on ESP8266)
+      portUDP.read();
+    }
+  }
+
+  if (nrPackets == 0) {
+    runningUPDCheck = false;
+    return;
+  }
+  statusLED(true);
+
+  // Sysinfo messages are collected per unit, so a node is only added once per pass.
+  NodeStruct nodeUpdates[UDP_RECEIVE_POOL_SIZE];
+  uint8_t    nrNodeUpdates = 0;
+
+  for (uint8_t i = 0; i < nrPackets; ++i) {
+    UDP_receivedPacket& packet = UDP_receivePool[i];
+    const int len              = packet.len;
+
+    if (static_cast<uint8_t>(packet.data[0]) != 255)
+    {
+      # ifndef BUILD_NO_DEBUG
+      addLog(LOG_LEVEL_DEBUG, packet.data);
+      #endif
+
+      // A packet may hold multiple commands, one per line, executed in order.
+      char *command = packet.data;
+
+      while (command != nullptr) {
+        char *next = strchr(command, '\n');
+
+        if (next != nullptr) {
+          *next = 0;
+          ++next;
+        }
+
+        // Strip '\r' of "\r\n" line endings
+        const size_t cmdlength = strlen(command);
+
+        if ((cmdlength > 0) && (command[cmdlength - 1] == '\r')) {
+          command[cmdlength - 1] = 0;
+        }
+
+        if (*command != 0) {
+          ExecuteCommand_all(EventValueSource::Enum::VALUE_SOURCE_SYSTEM, command);
+        }
+        command = next;
+      }
+    }
+    else
+    {
+      // binary data!
+      switch (packet.data[1])
+      {
+        case 1: // sysinfo message
+        {
+          if (len < 13) {
+            break;
+          }
+          int copy_length = sizeof(NodeStruct);
+          // Older versions sent 80 bytes, regardless of the size of NodeStruct
+          // Make sure the extra data received is ignored as it was also not initialized
+          if (len == 80) {
+            copy_length = 56;
           }
-          else
-          {
-            // binary data!
-            switch (packetBuffer[1])
-            {
-              case 1: // sysinfo message
-              {
-                if (len < 13) {
-                  break;
-                }
-                int copy_length = sizeof(NodeStruct);
-                // Older versions sent 80 bytes, regardless of the size of NodeStruct
-                // Make sure the extra data received is ignored as it was also not initialized
-                if (len == 80) {
-                  copy_length = 56;
-                }
 
-                if (copy_length > (len - 2)) {
-                  copy_length = (len - 2);
-                }
-                NodeStruct received;
-                memcpy(&received, &packetBuffer[2], copy_length);
+          if (copy_length > (len - 2)) {
+            copy_length = (len - 2);
+          }
+          NodeStruct received;
+          memcpy(&received, &packet.data[2], copy_length);
+
+          if (received.validate()) {
+            uint8_t n = 0;
 
-                if (received.validate()) {
-                  {
-                    #ifdef USE_SECOND_HEAP
-                    HeapSelectIram ephemeral;
-                    #endif
+            while (n < nrNodeUpdates && nodeUpdates[n].unit != received.unit) {
+              ++n;
+            }
+            nodeUpdates[n] = received;
 
-                    Nodes.addNode(received); // Create a new element when not present
-                  }
+            if (n == nrNodeUpdates) {
+              ++nrNodeUpdates;
+            }
 
 # ifndef BUILD_NO_DEBUG
 
-                  if (loglevelActiveFor(LOG_LEVEL_DEBUG_MORE)) {
-                    addLogMove(LOG_LEVEL_DEBUG_MORE,  
-                      strformat(F("UDP  : %s,%s,%d"), 
-                        received.STA_MAC().toString().c_str(), 
-                        formatIP(received.IP()).c_str(), 
-                        received.unit));
-                  }
+            if (loglevelActiveFor(LOG_LEVEL_DEBUG_MORE)) {
+              addLogMove(LOG_LEVEL_DEBUG_MORE,  
+                strformat(F("UDP  : %s,%s,%d"), 
+                  received.STA_MAC().toString().c_str(), 
+                  formatIP(received.IP()).c_str(), 
+                  received.unit));
+            }
 
 #endif // ifndef BUILD_NO_DEBUG
-                }
-                break;
-              }
-
-              default:
-              {
-                struct EventStruct TempEvent;
-                TempEvent.Data = reinterpret_cast<uint8_t *>(&packetBuffer[0]);
-                TempEvent.Par1 = remoteIP[3];
-                TempEvent.Par2 = len;
-                String dummy;
-                PluginCall(PLUGIN_UDP_IN, &TempEvent, dummy);
-                CPluginCall(CPlugin::Function::CPLUGIN_UDP_IN, &TempEvent);
-                break;
-              }
-            }
           }
+          break;
+        }
+
+        default:
+        {
+          struct EventStruct TempEvent;
+          TempEvent.Data = reinterpret_cast<uint8_t *>(packet.data);
+          TempEvent.Par1 = packet.remoteIP_last;
+          TempEvent.Par2 = len;
+          String dummy;
+          PluginCall(PLUGIN_UDP_IN, &TempEvent, dummy);
+          CPluginCall(CPlugin::Function::CPLUGIN_UDP_IN, &TempEvent);
+          break;
         }
       }
     }
   }
 
-  // Flush any remaining content of the packet.
-  while (portUDP.available()) {
-    // Do not call portUDP.flush() as that's meant to sending the packet (on ESP8266)
-    portUDP.read();
+  if (nrNodeUpdates > 0) {
+    #ifdef USE_SECOND_HEAP
+    HeapSelectIram ephemeral;
+    #endif
+
+    for (uint8_t n = 0; n < nrNodeUpdates; ++n) {
+      Nodes.addNode(nodeUpdates[n]); // Create a new element when not present
+    }
+  }
+
+  if (nrPackets > UDP_maxPacketsPerPass) {
+    UDP_maxPacketsPerPass = nrPackets;
   }
+  const uint32_t processingTime = usecPassedSince(start_usec);
+
+  if (processingTime > UDP_maxProcessingTime) {
+    UDP_maxProcessingTime = processingTime;
+  }
+  ADD_TIMER_STAT(CHECK_UDP, processingTime);
   runningUPDCheck = false;
 }
 
+void getUDPreceiveStats(uint32_t& received, uint32_t& dropped, uint32_t& maxPacketsPerPass, uint32_t& maxProcessingTime_usec)
+{
+  received               = UDP_receivedCount;
+  dropped                = UDP_droppedCount;
+  maxPacketsPerPass      = UDP_maxPacketsPerPass;
+  maxProcessingTime_usec = UDP_maxProcessingTime;
+}
+
 /*********************************************************************************************\
    Get formatted IP address for unit
    formatcodes: 0 = default toString(), 1 = empty string when invalid, 2 = 0 when invalid
@@ -407,16 +570,19 @@ String formatUnitToIPAddress(uint8_t unit, uint8_t formatCode) {
 \*********************************************************************************************/
 IPAddress getIPAddressForUnit(uint8_t unit) {
   if (unit == 255) {
+    if (P2P_useMulticast()) {
+      return P2P_multicastGroup();
+    }
     const IPAddress ip(255, 255, 255, 255);
     return ip;
   }
   auto it = Nodes.find(unit);
 
-  if (it == Nodes.end() || it->second.ip[0] == 0) {
+  if (it == Nodes.end() || it->ip[0] == 0) {
     IPAddress ip;
     return ip;
   }
-  return it->second.IP();
+  return it->IP();
 }
 
 
@@ -491,11 +657,23 @@ void sendSysInfoUDP(uint8_t repeats)
   {
     statusLED(true);
 
-    IPAddress broadcastIP(255, 255, 255, 255);
-    FeedSW_watchdog();
-    portUDP.beginPacket(broadcastIP, Settings.UDPPort);
-    portUDP.write(data, data_size);
-    portUDP.endPacket();
+    if ((counter > 0) && P2P_useMulticast() && !P2P_sendToGroup()) {
+      // Repeat to the known nodes only, unicast is acknowledged and sent at a higher rate.
+      for (auto it = Nodes.begin(); it != Nodes.end(); ++it) {
+        if ((it->unit != Settings.Unit) && (it->ip[0] != 0)) {
+          FeedSW_watchdog();
+          portUDP.beginPacket(it->IP(), Settings.UDPPort);
+          portUDP.write(data, data_size);
+          portUDP.endPacket();
+        }
+      }
+    } else {
+      // Multicast group when set, else broadcast
+      FeedSW_watchdog();
+      portUDP.beginPacket(getIPAddressForUnit(255), Settings.UDPPort);
+      portUDP.write(data, data_size);
+      portUDP.endPacket();
+    }
 
     if (counter < (repeats - 1)) {
       // FIXME TD-er: Must use scheduler to send out messages, not using delay
@@ -1099,6 +1277,17 @@ bool setDNS(int index, const IPAddress& dns) {
 }
 
 bool resolveHostByName(const char *aHostname, IPAddress& aResult, uint32_t timeout_ms) {
+#if FEATURE_DNS_CACHE
+  if (!NetworkConnected()) {
+    return false;
+  }
+  return DNScache.resolve(aHostname, aResult, timeout_ms);
+#else
+  return resolveHostByName_noCache(aHostname, aResult, timeout_ms);
+#endif // if FEATURE_DNS_CACHE
+}
+
+bool resolveHostByName_noCache(const char *aHostname, IPAddress& aResult, uint32_t timeout_ms) {
   START_TIMER;
 
   if (!NetworkConnected()) {
@@ -1481,8 +1670,9 @@ int http_authenticate(const String& logIdentifier,
   http.begin(client, host, port, uri);
 #endif // if defined(CORE_POST_2_6_0) || defined(ESP32)
 
-  const char *keys[] = { "WWW-Authenticate" };
-  http.collectHeaders(keys, 1);
+  // ETag and Content-Range are used to skip or resume file downloads.
+  const char *keys[] = { "WWW-Authenticate", "ETag", "Content-Range" };
+  http.collectHeaders(keys, NR_ELEMENTS(keys));
 
   {
     int headerpos = 0;
@@ -1583,6 +1773,44 @@ String send_via_http(const String& logIdentifier,
   HTTPClient http;
   http.setReuse(false);
 
+  const String response = send_via_http(
+    logIdentifier,
+    client,
+    http,
+    timeout,
+    user,
+    pass,
+    host,
+    port,
+    uri,
+    HttpMethod,
+    header,
+    postStr,
+    httpCode,
+    must_check_reply);
+
+  http.end();
+  // http.end() does not call client.stop() if it is no longer connected.
+  // However the client may still keep its internal state which may prevent 
+  // future connections to the same host until there has been a connection to another host inbetween.
+  client.stop(); 
+  return response;
+}
+
+String send_via_http(const String& logIdentifier,
+                     WiFiClient  & client,
+                     HTTPClient  & http,
+                     uint16_t      timeout,
+                     const String& user,
+                     const String& pass,
+                     const String& host,
+                     uint16_t      port,
+                     const String& uri,
+                     const String& HttpMethod,
+                     const String& header,
+                     const String& postStr,
+                     int         & httpCode,
+                     bool          must_check_reply) {
   httpCode = http_authenticate(
     logIdentifier,
     client,
@@ -1608,11 +1836,6 @@ String send_via_http(const String& logIdentifier,
     }
 #endif
   }
-  http.end();
-  // http.end() does not call client.stop() if it is no longer connected.
-  // However the client may still keep its internal state which may prevent 
-  // future connections to the same host until there has been a connection to another host inbetween.
-  client.stop(); 
   return response;
 }
 #endif // FEATURE_HTTP_CLIENT
@@ -1636,12 +1859,15 @@ bool downloadFile(const String& url, String file_save) {
 
 // User and Pass may be updated if they occur in the hostname part.
 // Thus have to be copied instead of const reference.
+// The replies to a conditional or range request (header) are accepted too: 206 Partial Content and 304 Not Modified.
 bool start_downloadFile(WiFiClient  & client,
                         HTTPClient  & http,
                         const String& url,
                         String      & file_save,
                         String        user,
                         String        pass,
+                        const String& header,
+                        int         & httpCode,
                         String      & error) {
   String   host, file;
   uint16_t port;
@@ -1673,7 +1899,7 @@ bool start_downloadFile(WiFiClient  & client,
     return false;
   }
 
-  const int httpCode = http_authenticate(
+  httpCode = http_authenticate(
     F("DownloadFile"),
     client,
     http,
@@ -1684,12 +1910,15 @@ bool start_downloadFile(WiFiClient  & client,
     port,
     uri,
     F("GET"),
-    EMPTY_STRING, // header
+    header,
     EMPTY_STRING, // postStr
     true          // must_check_reply
     );
 
-  if (httpCode != HTTP_CODE_OK) {
+  const bool conditionalReply = !header.isEmpty() &&
+                                (httpCode == HTTP_CODE_PARTIAL_CONTENT || httpCode == HTTP_CODE_NOT_MODIFIED);
+
+  if ((httpCode != HTTP_CODE_OK) && !conditionalReply) {
     error  = strformat(F("HTTP code: %d %s"), httpCode, url.c_str());
 
     addLog(LOG_LEVEL_ERROR, error);
@@ -1700,12 +1929,89 @@ bool start_downloadFile(WiFiClient  & client,
   return true;
 }
 
+// Write the body of the reply to f, using a fixed size buffer.
+// The connection is closed on error.
+bool downloadFile_writeBody(WiFiClient& client, HTTPClient& http, fs::File& f, const String& file_save, String& error)
+{
+  long len = http.getSize();
+
+  if (len < 0) {
+    // No Content-Length, e.g. chunked transfer encoding, which is only handled by the HTTPClient itself.
+    if (http.writeToStream(&f) < 0) {
+      error = concat(F("Error downloading file: "), file_save);
+      addLog(LOG_LEVEL_ERROR, error);
+      http.end();
+      client.stop();
+      return false;
+    }
+    return true;
+  }
+
+  const size_t downloadBuffSize = 256;
+  uint8_t buff[downloadBuffSize];
+  size_t  bytesWritten  = 0;
+  unsigned long timeout = millis() + DOWNLOAD_FILE_TIMEOUT;
+
+  // get tcp stream
+  WiFiClient *stream = &client;
+
+  // read all data from server
+  while (http.connected() && (len > 0)) {
+    // read up to downloadBuffSize at a time.
+    size_t bytes_to_read = downloadBuffSize;
+
+    if (len < static_cast<int>(bytes_to_read)) {
+      bytes_to_read = len;
+    }
+    const size_t c = stream->readBytes(buff, bytes_to_read);
+
+    if (c > 0) {
+      timeout = millis() + DOWNLOAD_FILE_TIMEOUT;
+
+      if (f.write(buff, c) != c) {
+        error  = F("Error saving file: ");
+        error += file_save;
+        error += ' ';
+        error += bytesWritten;
+        error += F(" Bytes written");
+        addLog(LOG_LEVEL_ERROR, error);
+        http.end();
+        client.stop();
+        return false;
+      }
+      bytesWritten += c;
+      len          -= c;
+    }
+
+    if (timeOutReached(timeout)) {
+      error  = F("Timeout: ");
+      error += file_save;
+      addLog(LOG_LEVEL_ERROR, error);
+      delay(0);
+      http.end();
+      client.stop();
+      return false;
+    }
+    delay(0);
+  }
+
+  if (len > 0) {
+    error = concat(F("Connection closed: "), file_save);
+    addLog(LOG_LEVEL_ERROR, error);
+    http.end();
+    client.stop();
+    return false;
+  }
+  return true;
+}
+
 bool downloadFile(const String& url, String file_save, const String& user, const String& pass, String& error) {
   WiFiClient client;
   HTTPClient http;
   http.setReuse(false);
+  int httpCode = 0;
 
-  if (!start_downloadFile(client, http, url, file_save, user, pass, error)) {
+  if (!start_downloadFile(client, http, url, file_save, user, pass, EMPTY_STRING, httpCode, error)) {
     return false;
   }
 
@@ -1718,57 +2024,11 @@ bool downloadFile(const String& url, String file_save, const String& user, const
     return false;
   }
 
-  long len   = http.getSize();
   fs::File f = tryOpenFile(file_save, "w");
 
   if (f) {
-    const size_t downloadBuffSize = 256;
-    uint8_t buff[downloadBuffSize];
-    size_t  bytesWritten  = 0;
-    unsigned long timeout = millis() + DOWNLOAD_FILE_TIMEOUT;
-
-    // get tcp stream
-    WiFiClient *stream = &client;
-
-    // read all data from server
-    while (http.connected() && (len > 0 || len == -1)) {
-      // read up to downloadBuffSize at a time.
-      size_t bytes_to_read = downloadBuffSize;
-
-      if ((len > 0) && (len < static_cast<int>(bytes_to_read))) {
-        bytes_to_read = len;
-      }
-      const size_t c = stream->readBytes(buff, bytes_to_read);
-
-      if (c > 0) {
-        timeout = millis() + DOWNLOAD_FILE_TIMEOUT;
-
-        if (f.write(buff, c) != c) {
-          error  = F("Error saving file: ");
-          error += file_save;
-          error += ' ';
-          error += bytesWritten;
-          error += F(" Bytes written");
-          addLog(LOG_LEVEL_ERROR, error);
-          http.end();
-          client.stop();
-          return false;
-        }
-        bytesWritten += c;
-
-        if (len > 0) { len -= c; }
-      }
-
-      if (timeOutReached(timeout)) {
-        error  = F("Timeout: ");
-        error += file_save;
-        addLog(LOG_LEVEL_ERROR, error);
-        delay(0);
-        http.end();
-        client.stop();
-        return false;
-      }
-      delay(0);
+    if (!downloadFile_writeBody(client, http, f, file_save, error)) {
+      return false;
     }
     f.close();
     http.end();
@@ -1790,6 +2050,157 @@ bool downloadFile(const String& url, String file_save, const String& user, const
   return false;
 }
 
+DownloadFile_session::DownloadFile_session()
+{
+  http.setReuse(true);
+}
+
+DownloadFile_session::~DownloadFile_session()
+{
+  http.end();
+  client.stop();
+}
+
+String getDownloadETagFilename(const String& file)
+{
+  return concat(file, F("_etag"));
+}
+
+String readDownloadETag(const String& file)
+{
+  String   etag;
+  fs::File f = tryOpenFile(getDownloadETagFilename(file), "r");
+
+  if (f) {
+    etag = f.readString();
+    f.close();
+  }
+  return etag;
+}
+
+// Start of the range in a "Content-Range: bytes <start>-<end>/<size>" header, or -1 when not present.
+static int getContentRangeStart(HTTPClient& http)
+{
+  const String range = http.header("Content-Range");
+  int start          = -1;
+
+  if (range.startsWith(F("bytes ")) &&
+      validIntFromString(range.substring(6, range.indexOf('-')), start)) {
+    return start;
+  }
+  return -1;
+}
+
+DownloadFile_result downloadFile(DownloadFile_session& session,
+                                 const String        & url,
+                                 const String        & file_save,
+                                 const String        & user,
+                                 const String        & pass,
+                                 const String        & ifNoneMatch,
+                                 String              & error)
+{
+  const String etagFile = getDownloadETagFilename(file_save);
+  size_t offset         = 0;
+  String header;
+
+  {
+    // A partial file of an earlier attempt can only be continued when it is known which version it is part of.
+    // When the file changed on the server, If-Range makes the server send the complete new file.
+    const String partialETag = readDownloadETag(file_save);
+
+    if (!partialETag.isEmpty()) {
+      fs::File f = tryOpenFile(file_save, "r");
+
+      if (f) {
+        offset = f.size();
+        f.close();
+      }
+    }
+
+    if (offset > 0) {
+      header = strformat(F("Range: bytes=%u-\r\nIf-Range: %s"), static_cast<unsigned int>(offset), partialETag.c_str());
+    } else if (!ifNoneMatch.isEmpty()) {
+      header = concat(F("If-None-Match: "), ifNoneMatch);
+    }
+  }
+
+  String fname = file_save;
+  int    httpCode = 0;
+
+  if (!start_downloadFile(session.client, session.http, url, fname, user, pass, header, httpCode, error)) {
+    if (offset > 0) {
+      // The partial file may already be complete (416 Range Not Satisfiable), or cannot be continued.
+      // Discard it, so no later attempt requests the same range again, and retry once without a range.
+      tryDeleteFile(etagFile);
+      tryDeleteFile(file_save);
+      return downloadFile(session, url, file_save, user, pass, ifNoneMatch, error);
+    }
+    return DownloadFile_result::Error;
+  }
+
+  if (httpCode == HTTP_CODE_NOT_MODIFIED) {
+    session.http.end();
+
+    if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+      addLogMove(LOG_LEVEL_INFO, concat(F("downloadFile: Unchanged "), url));
+    }
+    return DownloadFile_result::Unchanged;
+  }
+
+  if (httpCode == HTTP_CODE_PARTIAL_CONTENT) {
+    if ((offset == 0) || (getContentRangeStart(session.http) != static_cast<int>(offset))) {
+      // Do not try to continue this partial file again.
+      tryDeleteFile(etagFile);
+      error = concat(F("Unexpected range: "), file_save);
+      addLog(LOG_LEVEL_ERROR, error);
+      session.http.end();
+      session.client.stop();
+      return DownloadFile_result::Error;
+    }
+  } else {
+    // Complete file, store its ETag before writing so an interrupted download can be resumed.
+    offset = 0;
+    const String etag = session.http.header("ETag");
+
+    tryDeleteFile(etagFile);
+
+    if (!etag.isEmpty()) {
+      fs::File f = tryOpenFile(etagFile, "w");
+
+      if (f) {
+        f.print(etag);
+        f.close();
+      }
+    }
+  }
+
+  fs::File f = tryOpenFile(file_save, (offset == 0) ? "w" : "a");
+
+  if (!f) {
+    session.http.end();
+    session.client.stop();
+    error = concat(F("Failed to open file for writing: "), file_save);
+    addLog(LOG_LEVEL_ERROR, error);
+    return DownloadFile_result::Error;
+  }
+
+  if (!downloadFile_writeBody(session.client, session.http, f, file_save, error)) {
+    return DownloadFile_result::Error;
+  }
+  f.close();
+
+  // Keep the connection open for the next file.
+  session.http.end();
+
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    addLogMove(LOG_LEVEL_INFO, strformat(
+                 (offset == 0) ? F("downloadFile: %s Success") : F("downloadFile: %s Success, resumed at %u"),
+                 file_save.c_str(),
+                 static_cast<unsigned int>(offset)));
+  }
+  return DownloadFile_result::Success;
+}
+
 bool downloadFirmware(String filename, String& error)
 {
   String baseurl, user, pass;
@@ -1816,14 +2227,29 @@ bool downloadFirmware(const String& url, String& file_save, String& user, String
 {
   WiFiClient client;
   HTTPClient http;
+  int httpCode = 0;
 
-  if (!start_downloadFile(client, http, url, file_save, user, pass, error)) {
+  if (!start_downloadFile(client, http, url, file_save, user, pass, EMPTY_STRING, httpCode, error)) {
     return false;
   }
 
   int len = http.getSize();
 
-  if (Update.begin(len, U_FLASH, Settings.Pin_status_led, Settings.Pin_status_led_Inversed ? LOW : HIGH)) {
+# ifdef ESP32
+
+  // A gzip compressed image (.bin.gz) is decompressed while writing.
+  // Update.begin() is called on the first write, as only then it is known whether the image is compressed.
+  ESP32UpdateInflate updater;
+  updater.begin(len, Settings.Pin_status_led, Settings.Pin_status_led_Inversed ? LOW : HIGH);
+  const bool updateStarted = true;
+# else // ifdef ESP32
+
+  // The ESP8266 core accepts a gzip compressed image as is, the bootloader decompresses it.
+  UpdaterClass& updater    = Update;
+  const bool updateStarted = updater.begin(len, U_FLASH, Settings.Pin_status_led, Settings.Pin_status_led_Inversed ? LOW : HIGH);
+# endif // ifdef ESP32
+
+  if (updateStarted) {
     const size_t downloadBuffSize = 256;
     uint8_t buff[downloadBuffSize];
     size_t  bytesWritten  = 0;
@@ -1844,14 +2270,18 @@ bool downloadFirmware(const String& url, String& file_save, String& user, String
       if (c > 0) {
         timeout = millis() + DOWNLOAD_FILE_TIMEOUT;
 
-        if (Update.write(buff, c) != c) {
+        if (updater.write(buff, c) != c) {
           error  = F("Error saving firmware update: ");
           error += file_save;
           error += ' ';
           error += bytesWritten;
           error += F(" Bytes written");
+          # ifdef ESP32
+          error += F(", ");
+          error += updater.errorString();
+          # endif // ifdef ESP32
           addLog(LOG_LEVEL_ERROR, error);
-          Update.end();
+          updater.end();
           http.end();
           client.stop();
           return false;
@@ -1866,16 +2296,13 @@ bool downloadFirmware(const String& url, String& file_save, String& user, String
         error += file_save;
         addLog(LOG_LEVEL_ERROR, error);
         delay(0);
-        Update.end();
+        updater.end();
         http.end();
         client.stop();
         return false;
       }
 
-      if (!UseRTOSMultitasking) {
-        // On ESP32 the schedule is executed on the 2nd core.
-        Scheduler.handle_schedule();
-      }
+      Scheduler.handle_schedule();
       backgroundtasks();
     }
     http.end();
@@ -1888,18 +2315,34 @@ bool downloadFirmware(const String& url, String& file_save, String& user, String
       addLogMove(LOG_LEVEL_INFO, log);
     }
 
-    if (Update.end()) {
+    if (updater.end()) {
       if (Settings.UseRules) {
         String event = F("ProvisionFirmware#success=");
         event += file_save;
         eventQueue.addMove(std::move(event));
       }
+      return true;
     }
-    return true;
+
+    // Image not accepted, e.g. decompressed image CRC32 or image digest mismatch
+    error  = F("Failed verifying firmware: ");
+    error += file_save;
+    # ifdef ESP32
+    error += F(", ");
+    error += updater.errorString();
+    # endif // ifdef ESP32
+    addLog(LOG_LEVEL_ERROR, error);
+
+    if (Settings.UseRules) {
+      String event = F("ProvisionFirmware#failed=");
+      event += file_save;
+      eventQueue.addMove(std::move(event));
+    }
+    return false;
   }
   http.end();
   client.stop();
-  Update.end();
+  updater.end();
   error  = F("Failed update firmware: ");
   error += file_save;
   addLog(LOG_LEVEL_ERROR, error);
@@ -20,11 +20,38 @@
 /*********************************************************************************************\
    Syslog client
 \*********************************************************************************************/
-void sendSyslog(uint8_t logLevel, const String& message);
+void   sendSyslog(uint8_t       logLevel,
+                  const String& message);
+
+// Header of a syslog line: "<PRIO>Hostname_EspEasy:"
+String getSyslogHeader(uint8_t logLevel);
+
+// Send header + message as a single UDP datagram to the configured syslog server.
+bool   sendSyslogPacket(const String& header,
+                        const String& message);
 
 
 #if FEATURE_ESPEASY_P2P
 
+// Max. nr of known nodes to send messages for all nodes as unicast, when a multicast group is set.
+// Multicast is sent at the lowest rate and not acknowledged, so unicast is better for a few nodes.
+# ifndef P2P_UNICAST_MAX_PEERS
+#  define P2P_UNICAST_MAX_PEERS  2
+# endif // ifndef P2P_UNICAST_MAX_PEERS
+
+/*********************************************************************************************\
+   Multicast group for the ESPEasy p2p network, instead of broadcast
+\*********************************************************************************************/
+bool      P2P_useMulticast();
+
+IPAddress P2P_multicastGroup();
+
+// Nr of other nodes with a known IP address
+uint8_t   P2P_nrKnownPeers();
+
+// Send a message for all nodes once to the multicast group, instead of unicast to each known node.
+bool      P2P_sendToGroup();
+
 /*********************************************************************************************\
    Update UDP port (ESPEasy propiertary protocol)
 \*********************************************************************************************/
@@ -37,6 +64,13 @@ void updateUDPport();
 extern boolean runningUPDCheck;
 void checkUDP();
 
+// Packets received on the UDP port, dropped packets (too large or too small) and
+// the max. nr of packets and processing time of a single checkUDP() call.
+void getUDPreceiveStats(uint32_t& received,
+                        uint32_t& dropped,
+                        uint32_t& maxPacketsPerPass,
+                        uint32_t& maxProcessingTime_usec);
+
 /*********************************************************************************************\
    Send event using UDP message to specific unit
 \*********************************************************************************************/
@@ -54,7 +88,7 @@ String formatUnitToIPAddress(uint8_t unit, uint8_t formatCode);
 IPAddress getIPAddressForUnit(uint8_t unit);
 
 /*********************************************************************************************\
-   Send UDP message to specific unit (unit 255=broadcast)
+   Send UDP message to specific unit (unit 255=broadcast or multicast group)
 \*********************************************************************************************/
 void sendUDP(uint8_t unit, const uint8_t *data, uint8_t size);
 
@@ -160,8 +194,12 @@ bool valid_DNS_address(const IPAddress& dns);
 
 bool setDNS(int index, const IPAddress& dns);
 
+// Resolve a host name, using the DNS cache when FEATURE_DNS_CACHE is enabled.
 bool resolveHostByName(const char *aHostname, IPAddress& aResult, uint32_t timeout_ms = 1000);
 
+// Resolve a host name without using the DNS cache.
+bool resolveHostByName_noCache(const char *aHostname, IPAddress& aResult, uint32_t timeout_ms = 1000);
+
 bool hostReachable(const String& hostname);
 
 // Create a random port for the UDP connection.
@@ -219,6 +257,23 @@ String send_via_http(const String& logIdentifier,
                      const String& postStr,
                      int         & httpCode,
                      bool          must_check_reply);
+
+// Same as above, using the given client and http objects.
+// The caller must call http.end() and decide whether to keep the connection open.
+String send_via_http(const String& logIdentifier,
+                     WiFiClient  & client,
+                     HTTPClient  & http,
+                     uint16_t      timeout,
+                     const String& user,
+                     const String& pass,
+                     const String& host,
+                     uint16_t      port,
+                     const String& uri,
+                     const String& HttpMethod,
+                     const String& header,
+                     const String& postStr,
+                     int         & httpCode,
+                     bool          must_check_reply);
 #endif // FEATURE_HTTP_CLIENT
 
 #if FEATURE_DOWNLOAD
@@ -231,6 +286,41 @@ bool downloadFile(String file_save, String error);
 
 bool downloadFile(const String& url, String file_save, const String& user, const String& pass, String& error);
 
+enum class DownloadFile_result {
+  Success,
+  Unchanged, // Server replied "304 Not Modified", nothing written
+  Error
+};
+
+// Connection to download multiple files from the same server, kept open (keep-alive) between the downloads.
+struct DownloadFile_session {
+  DownloadFile_session();
+  ~DownloadFile_session();
+
+  WiFiClient client;
+  HTTPClient http;
+};
+
+// File holding the ETag of a file downloaded via a DownloadFile_session: <file>_etag
+String getDownloadETagFilename(const String& file);
+
+// ETag of a (partially) downloaded file, or empty when not known.
+String readDownloadETag(const String& file);
+
+// Download a file to file_save, reusing the connection of the session.
+// - An existing file_save with a known ETag is considered a partial download of an earlier attempt
+//   and is continued using a HTTP range request. Otherwise file_save is overwritten.
+// - When ifNoneMatch is set (the ETag of a previous download) the server may reply the file is unchanged.
+// - The ETag of the downloaded file is stored in getDownloadETagFilename(file_save).
+// On error, the partial file is kept to resume the download on the next attempt.
+DownloadFile_result downloadFile(DownloadFile_session& session,
+                                 const String        & url,
+                                 const String        & file_save,
+                                 const String        & user,
+                                 const String        & pass,
+                                 const String        & ifNoneMatch,
+                                 String              & error);
+
 bool downloadFirmware(String filename, String& error);
 bool downloadFirmware(const String& url, String& file_save, String& user, String& pass, String& error);
 
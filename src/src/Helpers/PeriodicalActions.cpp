@@ -13,7 +13,10 @@
 #include "../ESPEasyCore/ESPEasyNetwork.h"
 #include "../ESPEasyCore/ESPEasyWifi.h"
 #include "../ESPEasyCore/ESPEasyRules.h"
+#include "../ESPEasyCore/ESPEasy_setup.h"
 #include "../ESPEasyCore/Serial.h"
+#include "../Globals/Cache.h"
+#include "../Globals/DNS_Cache.h"
 #include "../Globals/ESPEasyWiFiEvent.h"
 #if FEATURE_ETHERNET
 #include "../Globals/ESPEasyEthEvent.h"
@@ -23,6 +26,7 @@
 #include "../Globals/EventQueue.h"
 #include "../Globals/MainLoopCommand.h"
 #include "../Globals/MQTT.h"
+#include "../Globals/NPlugins.h"
 #include "../Globals/NetworkState.h"
 #include "../Globals/RTC.h"
 #include "../Globals/SecuritySettings.h"
@@ -30,11 +34,21 @@
 #include "../Globals/Settings.h"
 #include "../Globals/Statistics.h"
 #include "../Globals/WiFi_AP_Candidates.h"
+#include "../Helpers/ControllerQueueTask.h"
+#include "../Helpers/I2C_async.h"
+#include "../Helpers/I2C_BusScanner.h"
 #include "../Helpers/ESPEasyRTC.h"
+#include "../Helpers/ESPEasy_Storage.h"
 #include "../Helpers/FS_Helper.h"
 #include "../Helpers/Hardware.h"
+#include "../Helpers/HeapTracker.h"
 #include "../Helpers/Memory.h"
 #include "../Helpers/Misc.h"
+#include "../Helpers/PowerManagement.h"
+#include "../Helpers/ProvisioningJob.h"
+#include "../Helpers/SD_LogBuffer.h"
+#include "../Helpers/SyslogBuffer.h"
+#include "../WebServer/EventStream.h"
 #include "../Helpers/Networking.h"
 #include "../Helpers/StringGenerator_System.h"
 #include "../Helpers/StringGenerator_WiFi.h"
@@ -65,7 +79,7 @@ void run50TimesPerSecond() {
     CPluginCall(CPlugin::Function::CPLUGIN_FIFTY_PER_SECOND, 0, dummy);
     STOP_TIMER(CPLUGIN_CALL_50PS);
   }
-  processNextEvent();
+  processEventQueue();
 }
 
 /*********************************************************************************************\
@@ -73,6 +87,7 @@ void run50TimesPerSecond() {
 \*********************************************************************************************/
 void run10TimesPerSecond() {
   String dummy;
+  ESPEasy_setup_deferred_loop();
   //@giig19767g: WARNING: Monitor10xSec must run before PLUGIN_TEN_PER_SECOND
   {
     START_TIMER;
@@ -95,14 +110,48 @@ void run10TimesPerSecond() {
     CPluginCall(CPlugin::Function::CPLUGIN_TEN_PER_SECOND, 0, dummy);
     STOP_TIMER(CPLUGIN_CALL_10PS);
   }
+  #if FEATURE_NOTIFIER
+  NPluginCall(NPlugin::Function::NPLUGIN_TEN_PER_SECOND, 0);
+  #endif // if FEATURE_NOTIFIER
+  #if FEATURE_CUSTOM_PROVISIONING
+  ProvisioningJob_loop();
+  #endif // if FEATURE_CUSTOM_PROVISIONING
+
+  if (Settings.UseRules) {
+    Cache.rulesHelper.processChangedFiles();
+  }
   
   #ifdef USES_C015
   if (NetworkConnected())
       Blynk_Run_c015();
   #endif
   #ifndef USE_RTOS_MULTITASKING
+  {
+    HEAP_TRACK_SCOPE(WebServer);
     web_server.handleClient();
+  }
   #endif
+  #if FEATURE_WEB_EVENT_STREAM
+  eventStream_loop();
+  #endif // if FEATURE_WEB_EVENT_STREAM
+  #if FEATURE_CONTROLLER_QUEUE_TASK
+  controllerQueueTask_loop();
+  #endif // if FEATURE_CONTROLLER_QUEUE_TASK
+  #if FEATURE_I2C_ASYNC
+  I2C_async_loop();
+  #endif // if FEATURE_I2C_ASYNC
+  #ifdef WEBSERVER_I2C_SCANNER
+  I2C_scanner_loop();
+  #endif // ifdef WEBSERVER_I2C_SCANNER
+  #if FEATURE_SETTINGS_WRITEBACK
+  processSettingsWriteBack();
+  #endif // if FEATURE_SETTINGS_WRITEBACK
+  #if FEATURE_SD_LOG_BUFFER
+  SD_LogBuffer_loop();
+  #endif // if FEATURE_SD_LOG_BUFFER
+  #if FEATURE_SYSLOG_BUFFER
+  SyslogBuffer_loop();
+  #endif // if FEATURE_SYSLOG_BUFFER
 }
 
 
@@ -173,6 +222,8 @@ void runOncePerSecond()
   // I2C Watchdog feed
   if (Settings.WDI2CAddress != 0)
   {
+    // Clock speed is not reset after each task
+    I2CSelectHighClockSpeed();
     I2C_write8(Settings.WDI2CAddress, 0xA5);
   }
 
@@ -185,6 +236,13 @@ void runOncePerSecond()
   #endif
   #endif // if FEATURE_MDNS
 
+  #if FEATURE_DNS_CACHE
+  // Resolve host names before they expire, so the next connect does not need to wait for it.
+  if (NetworkConnected()) {
+    DNScache.loop();
+  }
+  #endif // if FEATURE_DNS_CACHE
+
 
   checkResetFactoryPin();
   STOP_TIMER(PLUGIN_CALL_1PS);
@@ -232,6 +290,7 @@ void runEach30Seconds()
 #endif
   }
   WiFi_AP_Candidates.purge_expired();
+  WiFi_checkCachedLease();
   #if FEATURE_ESPEASY_P2P
   sendSysInfoUDP(1);
   refreshNodeList();
@@ -261,6 +320,58 @@ void runEach30Seconds()
 
 #if FEATURE_MQTT
 
+// Stream the payload file of the queue element to the broker.
+// The MQTT packet header is sent first, so the payload does not need to fit in memory or in the PubSubClient buffer.
+static bool MQTTpublishPayloadFile(const MQTT_queue_element& element) {
+  fs::File f = tryOpenFile(element._payloadFile, F("r"));
+
+  if (!f) {
+    // Retrying will not help, so consider it done.
+    addLog(LOG_LEVEL_ERROR, concat(F("MQTT : Cannot open payload file "), element._payloadFile));
+    return true;
+  }
+  const size_t size = f.size();
+
+  if (!MQTTclient.beginPublish(element._topic.c_str(), size, element._retained)) {
+    f.close();
+    return false;
+  }
+  uint8_t buffer[128];
+  size_t  written = 0;
+
+  while (written < size) {
+    const int read = f.read(buffer, sizeof(buffer));
+
+    if ((read <= 0) || (MQTTclient.write(buffer, read) != static_cast<size_t>(read))) {
+      break;
+    }
+    written += read;
+    delay(0);
+  }
+  f.close();
+  MQTTclient.endPublish();
+
+  if (written != size) {
+    // The broker expects the announced payload length, the connection can no longer be used.
+    addLog(LOG_LEVEL_ERROR, concat(F("MQTT : Publish incomplete, disconnect. File: "), element._payloadFile));
+    MQTTclient.disconnect();
+    return false;
+  }
+  return true;
+}
+
+static bool MQTTpublishElement(const MQTT_queue_element& element) {
+  if (element.hasPayloadFile()) {
+    return MQTTpublishPayloadFile(element);
+  }
+  const String& payload = element.getPayload();
+
+  // Use the length of the payload, as a binary payload may contain 0-bytes.
+  return MQTTclient.publish(element._topic.c_str(),
+                            reinterpret_cast<const uint8_t *>(payload.c_str()),
+                            payload.length(),
+                            element._retained);
+}
 
 void scheduleNextMQTTdelayQueue() {
   if (MQTTDelayHandler != nullptr) {
@@ -277,14 +388,11 @@ void schedule_all_MQTTimport_tasks() {
 
   deviceIndex_t DeviceIndex = getDeviceIndex(PLUGIN_MQTT_IMPORT); // Check if P037_MQTTimport is present in the build
   if (validDeviceIndex(DeviceIndex)) {
-    for (taskIndex_t task = 0; task < TASKS_MAX; task++) {
-      if ((Settings.getPluginID_for_task(task) == PLUGIN_MQTT_IMPORT) &&
-          (Settings.TaskDeviceEnabled[task])) {
-        // Schedule a call to each enabled MQTT import plugin to notify the broker connection state
-        EventStruct event(task);
-        event.Par1 = MQTTclient_connected ? 1 : 0;
-        Scheduler.schedule_plugin_task_event_timer(DeviceIndex, PLUGIN_MQTT_CONNECTION_STATE, std::move(event));
-      }
+    for (const taskIndex_t task : Cache.getEnabledTasks(PLUGIN_MQTT_IMPORT)) {
+      // Schedule a call to each enabled MQTT import plugin to notify the broker connection state
+      EventStruct event(task);
+      event.Par1 = MQTTclient_connected ? 1 : 0;
+      Scheduler.schedule_plugin_task_event_timer(DeviceIndex, PLUGIN_MQTT_CONNECTION_STATE, std::move(event));
     }
   }
 }
@@ -293,6 +401,9 @@ void processMQTTdelayQueue() {
   if (MQTTDelayHandler == nullptr) {
     return;
   }
+  #if FEATURE_CONTROLLER_QUEUE_SPILL
+  MQTTDelayHandler->processSpill();
+  #endif // if FEATURE_CONTROLLER_QUEUE_SPILL
   runPeriodicalMQTT(); // Update MQTT connected state.
   if (!MQTTclient_connected) {
     scheduleNextMQTTdelayQueue();
@@ -303,40 +414,60 @@ void processMQTTdelayQueue() {
   MQTT_queue_element *element(static_cast<MQTT_queue_element *>(MQTTDelayHandler->getNext()));
 
   if (element == nullptr) { return; }
+  #if FEATURE_CONTROLLER_BACKOFF
 
-  bool handled = false;
-
-  if (element->_call_PLUGIN_PROCESS_CONTROLLER_DATA) {
-    struct EventStruct TempEvent(element->_taskIndex);
-    String dummy;
-
-    // FIXME TD-er: Do we need anything from the element in the event?
-//    TempEvent.String1 = element->_topic;
-//    TempEvent.String2 = element->_payload;
-    if (PluginCall(PLUGIN_PROCESS_CONTROLLER_DATA, &TempEvent, dummy)) {
-      handled = true;
-      MQTTDelayHandler->markProcessed(true);
-    } else {
-      MQTTDelayHandler->markProcessed(false);
-    }
-  } else
-  if (!handled) {
-    if (MQTTclient.publish(element->_topic.c_str(), element->_payload.c_str(), element->_retained)) {
-      if (WiFiEventData.connectionFailures > 0) {
-        --WiFiEventData.connectionFailures;
+  if (!MQTTDelayHandler->mayAttempt()) {
+    scheduleNextMQTTdelayQueue();
+    return;
+  }
+  #endif // if FEATURE_CONTROLLER_BACKOFF
+
+  // Keep publishing while tokens are left for a burst and there is time left in this loop.
+  const unsigned long processStart = millis();
+
+  while (element != nullptr) {
+    bool handled = false;
+    bool processed = false;
+
+    if (element->_call_PLUGIN_PROCESS_CONTROLLER_DATA) {
+      struct EventStruct TempEvent(element->_taskIndex);
+      String dummy;
+
+      // FIXME TD-er: Do we need anything from the element in the event?
+//      TempEvent.String1 = element->_topic;
+//      TempEvent.String2 = element->_payload;
+      if (PluginCall(PLUGIN_PROCESS_CONTROLLER_DATA, &TempEvent, dummy)) {
+        handled = true;
+        processed = true;
+        MQTTDelayHandler->markProcessed(true);
+      } else {
+        MQTTDelayHandler->markProcessed(false);
       }
-      MQTTDelayHandler->markProcessed(true);
-    } else {
-      MQTTDelayHandler->markProcessed(false);
+    } else
+    if (!handled) {
+      if (MQTTpublishElement(*element)) {
+        if (WiFiEventData.connectionFailures > 0) {
+          --WiFiEventData.connectionFailures;
+        }
+        processed = true;
+        MQTTDelayHandler->markProcessed(true);
+      } else {
+        MQTTDelayHandler->markProcessed(false);
 #ifndef BUILD_NO_DEBUG
 
-      if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-        String log = F("MQTT : process MQTT queue not published, ");
-        log += MQTTDelayHandler->sendQueue.size();
-        log += F(" items left in queue");
-        addLogMove(LOG_LEVEL_DEBUG, log);
-      }
+        if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+          String log = F("MQTT : process MQTT queue not published, ");
+          log += MQTTDelayHandler->sendQueue.size();
+          log += F(" items left in queue");
+          addLogMove(LOG_LEVEL_DEBUG, log);
+        }
 #endif // ifndef BUILD_NO_DEBUG
+      }
+    }
+    element = nullptr;
+
+    if (processed && MQTTDelayHandler->mayProcessNext(processStart)) {
+      element = static_cast<MQTT_queue_element *>(MQTTDelayHandler->getNext());
     }
   }
   Scheduler.setIntervalTimerOverride(SchedulerIntervalTimer_e::TIMER_MQTT, 10); // Make sure the MQTT is being processed as soon as possible.
@@ -430,6 +561,7 @@ void updateLoopStats_30sec(uint8_t loglevel) {
     loopCounterMax = loopCounterLast;
 
   Scheduler.updateIdleTimeStats();
+  PowerManagement_updateStats();
 
 #ifndef BUILD_NO_DEBUG
   if (loglevelActiveFor(loglevel)) {
@@ -491,6 +623,15 @@ void prepareShutdown(IntendedRebootReason_e reason)
   process_serialWriteBuffer();
   flushAndDisconnectAllClients();
   saveUserVarToRTC();
+  #if FEATURE_SETTINGS_WRITEBACK
+  commitSettingsWriteBack();
+  #endif // if FEATURE_SETTINGS_WRITEBACK
+  #if FEATURE_SD_LOG_BUFFER
+  SD_LogBuffer_flush();
+  #endif // if FEATURE_SD_LOG_BUFFER
+  #if FEATURE_SYSLOG_BUFFER
+  SyslogBuffer_flush();
+  #endif // if FEATURE_SYSLOG_BUFFER
   setWifiMode(WIFI_OFF);
   ESPEASY_FS.end();
   process_serialWriteBuffer();
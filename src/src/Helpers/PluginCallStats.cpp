@@ -0,0 +1,161 @@
+#include "../Helpers/PluginCallStats.h"
+
+#if FEATURE_PLUGIN_CALL_STATS
+
+# include "../Globals/RTC.h"
+# include "../Globals/Settings.h"
+# include "../Helpers/ESPEasyRTC.h"
+# include "../Helpers/ESPEasy_time_calc.h"
+# include "../Helpers/Memory.h"
+
+static PluginCallStats_t pluginCallStats[PLUGIN_CALL_STATS_MAX_ENTRIES];
+static RTC_PluginCall_t  pluginCallBeforeReboot;
+
+uint16_t PluginCallStats_t::getWorstStack() const {
+  return (stackLow < minStackAtCall) ? stackLow : minStackAtCall;
+}
+
+static uint16_t PluginCallStats_toUint16(uint32_t value) {
+  return (value < PLUGIN_CALL_STATS_NO_STACK) ? value : PLUGIN_CALL_STATS_NO_STACK - 1;
+}
+
+static PluginCallStats_t* PluginCallStats_getEntry(taskIndex_t taskIndex, uint8_t function, uint16_t stack) {
+  PluginCallStats_t *best = nullptr;
+
+  for (uint8_t i = 0; i < PLUGIN_CALL_STATS_MAX_ENTRIES; ++i) {
+    PluginCallStats_t& entry = pluginCallStats[i];
+
+    if ((entry.taskIndex == taskIndex) && (entry.function == function)) {
+      return &entry;
+    }
+
+    // Prefer an empty entry, else the one with the most free stack
+    if ((best == nullptr) || (best->count != 0)) {
+      if ((best == nullptr) || (entry.count == 0) || (entry.getWorstStack() > best->getWorstStack())) {
+        best = &entry;
+      }
+    }
+  }
+
+  if ((best->count != 0) && (best->getWorstStack() <= stack)) {
+    // Not among the worst offenders
+    return nullptr;
+  }
+  *best           = PluginCallStats_t();
+  best->taskIndex = taskIndex;
+  best->function  = function;
+  return best;
+}
+
+PluginCallStatsScope::PluginCallStatsScope(taskIndex_t taskIndex, uint8_t function)
+  : _start(0), _taskIndex(taskIndex), _function(function)
+{
+  RTC.lastPluginCall.taskIndex = taskIndex;
+  RTC.lastPluginCall.function  = function;
+  RTC.lastPluginCall.active    = 1;
+  saveLastPluginCallToRTC();
+
+  if (Settings.EnableTimingStats()) {
+    _measure     = true;
+    _stackAtCall = getCurrentFreeStack();
+    _watermark   = getFreeStackWatermark();
+    _start       = getMicros64();
+  }
+}
+
+PluginCallStatsScope::~PluginCallStatsScope()
+{
+  RTC.lastPluginCall.active = 0;
+
+  if (_measure) {
+    const uint32_t duration  = usecPassedSince(_start);
+    const uint32_t watermark = getFreeStackWatermark();
+    uint16_t stackLow        = PLUGIN_CALL_STATS_NO_STACK;
+
+    if (watermark < _watermark) {
+      stackLow = PluginCallStats_toUint16(watermark);
+
+      if (stackLow < RTC.lastPluginCall.lowStack) {
+        RTC.lastPluginCall.lowStack          = stackLow;
+        RTC.lastPluginCall.lowStackTaskIndex = _taskIndex;
+        RTC.lastPluginCall.lowStackFunction  = _function;
+      }
+    }
+    const uint16_t stackAtCall = PluginCallStats_toUint16(_stackAtCall);
+    PluginCallStats_t *entry   = PluginCallStats_getEntry(
+      _taskIndex,
+      _function,
+      (stackLow < stackAtCall) ? stackLow : stackAtCall);
+
+    if (entry != nullptr) {
+      ++entry->count;
+      entry->sumDuration_usec += duration;
+
+      if (duration > entry->maxDuration_usec) {
+        entry->maxDuration_usec = duration;
+      }
+
+      if (stackAtCall < entry->minStackAtCall) {
+        entry->minStackAtCall = stackAtCall;
+      }
+
+      if (stackLow < entry->stackLow) {
+        entry->stackLow = stackLow;
+      }
+    }
+  }
+  saveLastPluginCallToRTC();
+}
+
+void PluginCallStats_loadFromRTC()
+{
+  pluginCallBeforeReboot = RTC.lastPluginCall;
+  RTC.lastPluginCall     = RTC_PluginCall_t();
+  saveLastPluginCallToRTC();
+}
+
+const RTC_PluginCall_t& PluginCallStats_getBeforeReboot()
+{
+  return pluginCallBeforeReboot;
+}
+
+uint8_t PluginCallStats_getSorted(PluginCallStats_t *res, uint8_t maxEntries)
+{
+  uint8_t nrEntries = 0;
+
+  for (uint8_t i = 0; i < PLUGIN_CALL_STATS_MAX_ENTRIES; ++i) {
+    const PluginCallStats_t& entry = pluginCallStats[i];
+
+    if (entry.count == 0) {
+      continue;
+    }
+
+    // Insertion sort, the list is short
+    uint8_t pos = nrEntries;
+
+    while (pos > 0 && res[pos - 1].getWorstStack() > entry.getWorstStack()) {
+      if (pos < maxEntries) {
+        res[pos] = res[pos - 1];
+      }
+      --pos;
+    }
+
+    if (pos < maxEntries) {
+      res[pos] = entry;
+
+      if (nrEntries < maxEntries) {
+        ++nrEntries;
+      }
+    }
+  }
+  return nrEntries;
+}
+
+void PluginCallStats_clear()
+{
+  for (uint8_t i = 0; i < PLUGIN_CALL_STATS_MAX_ENTRIES; ++i) {
+    pluginCallStats[i] = PluginCallStats_t();
+  }
+}
+
+#endif // if FEATURE_PLUGIN_CALL_STATS
@@ -0,0 +1,82 @@
+#ifndef HELPERS_PLUGINCALLSTATS_H
+#define HELPERS_PLUGINCALLSTATS_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_PLUGIN_CALL_STATS
+
+# include "../DataStructs/RTCStruct.h"
+# include "../DataTypes/TaskIndex.h"
+
+// Nr of (task, function) combinations kept.
+// When full, the entry with the most free stack is replaced by a call using less stack.
+# ifndef PLUGIN_CALL_STATS_MAX_ENTRIES
+#  ifdef ESP32
+#   define PLUGIN_CALL_STATS_MAX_ENTRIES  32
+#  else // ifdef ESP32
+#   define PLUGIN_CALL_STATS_MAX_ENTRIES  16
+#  endif // ifdef ESP32
+# endif // ifndef PLUGIN_CALL_STATS_MAX_ENTRIES
+
+// Value of a stack size not (yet) measured
+# define PLUGIN_CALL_STATS_NO_STACK       0xFFFF
+
+struct PluginCallStats_t {
+  // Free stack to rank the entries, lower is worse.
+  uint16_t getWorstStack() const;
+
+  uint64_t    sumDuration_usec{};
+  uint32_t    count{};
+  uint32_t    maxDuration_usec{};
+  uint16_t    minStackAtCall = PLUGIN_CALL_STATS_NO_STACK; // Free stack when the plugin was called
+  uint16_t    stackLow       = PLUGIN_CALL_STATS_NO_STACK; // Lowest free stack watermark set during the call
+  taskIndex_t taskIndex      = 0xFF;
+  uint8_t     function       = 0;
+};
+
+/*********************************************************************************************\
+* PluginCallStatsScope
+* Keep track of duration and stack usage of a plugin call per (task, function).
+* The task and function are stored in RTC before the call and marked done after the call,
+* so after a crash the plugin call in progress can be shown.
+* Stack usage is only measured when timing stats are enabled, as it takes a scan of the stack.
+* The stack watermark is the lowest free stack since boot, so only calls which lower
+* the watermark get a "stack low" value.
+\*********************************************************************************************/
+class PluginCallStatsScope {
+public:
+
+  PluginCallStatsScope(taskIndex_t taskIndex,
+                       uint8_t     function);
+  ~PluginCallStatsScope();
+
+  PluginCallStatsScope(const PluginCallStatsScope&)            = delete;
+  PluginCallStatsScope& operator=(const PluginCallStatsScope&) = delete;
+
+private:
+
+  uint64_t    _start;
+  uint32_t    _stackAtCall = 0;
+  uint32_t    _watermark   = 0;
+  taskIndex_t _taskIndex;
+  uint8_t     _function;
+  bool        _measure = false;
+};
+
+// Keep the RTC info of the previous run and reset it for this run.
+// Must be called after the RTC struct is read at boot.
+void                     PluginCallStats_loadFromRTC();
+
+// RTC info of the plugin calls before the last reboot.
+const RTC_PluginCall_t&  PluginCallStats_getBeforeReboot();
+
+// Entries sorted from least to most free stack.
+// @retval Nr of entries copied to res
+uint8_t                  PluginCallStats_getSorted(PluginCallStats_t *res,
+                                                   uint8_t            maxEntries);
+
+void                     PluginCallStats_clear();
+
+#endif // if FEATURE_PLUGIN_CALL_STATS
+
+#endif // ifndef HELPERS_PLUGINCALLSTATS_H
@@ -0,0 +1,161 @@
+#include "../Helpers/PowerManagement.h"
+
+#include "../Helpers/ESPEasy_time_calc.h"
+
+#ifdef ESP32
+# include <esp_pm.h>
+
+# if CONFIG_IDF_TARGET_ESP32
+#  include "hal/efuse_ll.h"
+#  include "hal/efuse_hal.h"
+# endif // if CONFIG_IDF_TARGET_ESP32
+#endif // ifdef ESP32
+
+static uint64_t powerManagement_waitTime_usec = 0;
+static uint32_t powerManagement_nrWaits       = 0;
+static uint32_t powerManagement_statsStart    = 0;
+static float    powerManagement_waitTimePct   = 0.0f;
+static uint32_t powerManagement_nrWaitsLast   = 0;
+
+#ifdef ESP32
+static bool powerManagement_DFS        = false;
+static bool powerManagement_lightSleep = false;
+
+# ifdef CONFIG_PM_ENABLE
+
+// Held while the loop is running, so work is done at maximum CPU frequency.
+static esp_pm_lock_handle_t powerManagement_cpuLock = nullptr;
+# endif // ifdef CONFIG_PM_ENABLE
+
+static int PowerManagement_maxFreqMHz()
+{
+# if CONFIG_IDF_TARGET_ESP32
+  return static_cast<int>(efuse_hal_get_rated_freq_mhz());
+# elif CONFIG_IDF_TARGET_ESP32S2 || CONFIG_IDF_TARGET_ESP32S3
+  return 240;
+# elif CONFIG_IDF_TARGET_ESP32C3
+  return 160;
+# elif CONFIG_IDF_TARGET_ESP32C2
+  return 120;
+# else // if CONFIG_IDF_TARGET_ESP32
+  return getCpuFrequencyMhz();
+# endif // if CONFIG_IDF_TARGET_ESP32
+}
+
+#endif // ifdef ESP32
+
+void PowerManagement_configure(bool ecoMode)
+{
+#ifdef ESP32
+  const int maxFreq = PowerManagement_maxFreqMHz();
+
+# ifdef CONFIG_PM_ENABLE
+
+  // Configure dynamic frequency scaling:
+  // Without eco mode, the min frequency is set to the max frequency to keep the CPU at full speed.
+  // Automatic light sleep is only possible when tickless idle support is enabled in the SDK.
+#  if CONFIG_IDF_TARGET_ESP32
+  esp_pm_config_esp32_t pm_config = {
+#  elif CONFIG_IDF_TARGET_ESP32S2
+  esp_pm_config_esp32s2_t pm_config = {
+#  elif CONFIG_IDF_TARGET_ESP32C3
+  esp_pm_config_esp32c3_t pm_config = {
+#  elif CONFIG_IDF_TARGET_ESP32S3
+  esp_pm_config_esp32s3_t pm_config = {
+#  elif CONFIG_IDF_TARGET_ESP32C2
+  esp_pm_config_esp32c2_t pm_config = {
+#  else // if CONFIG_IDF_TARGET_ESP32
+  esp_pm_config_t pm_config = {
+#  endif // if CONFIG_IDF_TARGET_ESP32
+    .max_freq_mhz = maxFreq,
+    .min_freq_mhz = ecoMode ? 80 : maxFreq,
+#  if CONFIG_FREERTOS_USE_TICKLESS_IDLE
+    .light_sleep_enable = ecoMode
+#  endif // if CONFIG_FREERTOS_USE_TICKLESS_IDLE
+  };
+
+  if (esp_pm_configure(&pm_config) == ESP_OK) {
+    powerManagement_DFS = ecoMode && (maxFreq > 80);
+    #  if CONFIG_FREERTOS_USE_TICKLESS_IDLE
+    powerManagement_lightSleep = ecoMode;
+    #  endif // if CONFIG_FREERTOS_USE_TICKLESS_IDLE
+  } else {
+    powerManagement_DFS        = false;
+    powerManagement_lightSleep = false;
+    setCpuFrequencyMhz(ecoMode ? 80 : maxFreq);
+  }
+
+  if (powerManagement_cpuLock == nullptr) {
+    if (esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "ESPEasy", &powerManagement_cpuLock) == ESP_OK) {
+      esp_pm_lock_acquire(powerManagement_cpuLock);
+    } else {
+      powerManagement_cpuLock = nullptr;
+    }
+  }
+# else // ifdef CONFIG_PM_ENABLE
+  setCpuFrequencyMhz(ecoMode ? 80 : maxFreq);
+# endif // ifdef CONFIG_PM_ENABLE
+#endif // ifdef ESP32
+}
+
+void PowerManagement_wait(uint32_t waitTime_msec)
+{
+  const uint64_t start = getMicros64();
+
+#if defined(ESP32) && defined(CONFIG_PM_ENABLE)
+
+  if (powerManagement_cpuLock != nullptr) {
+    esp_pm_lock_release(powerManagement_cpuLock);
+  }
+#endif // if defined(ESP32) && defined(CONFIG_PM_ENABLE)
+
+  delay(waitTime_msec);
+
+#if defined(ESP32) && defined(CONFIG_PM_ENABLE)
+
+  if (powerManagement_cpuLock != nullptr) {
+    esp_pm_lock_acquire(powerManagement_cpuLock);
+  }
+#endif // if defined(ESP32) && defined(CONFIG_PM_ENABLE)
+
+  powerManagement_waitTime_usec += usecPassedSince(start);
+  ++powerManagement_nrWaits;
+}
+
+void PowerManagement_updateStats()
+{
+  const long duration = timePassedSince(powerManagement_statsStart);
+
+  powerManagement_statsStart = millis();
+
+  if (duration > 0) {
+    powerManagement_waitTimePct = static_cast<float>(powerManagement_waitTime_usec) / duration / 10.0f;
+  }
+  powerManagement_nrWaitsLast   = powerManagement_nrWaits;
+  powerManagement_waitTime_usec = 0;
+  powerManagement_nrWaits       = 0;
+}
+
+float PowerManagement_getWaitTimePct()
+{
+  return powerManagement_waitTimePct;
+}
+
+uint32_t PowerManagement_getNrWaits()
+{
+  return powerManagement_nrWaitsLast;
+}
+
+#ifdef ESP32
+
+bool PowerManagement_DFSenabled()
+{
+  return powerManagement_DFS;
+}
+
+bool PowerManagement_lightSleepEnabled()
+{
+  return powerManagement_lightSleep;
+}
+
+#endif // ifdef ESP32
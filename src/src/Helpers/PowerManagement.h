@@ -0,0 +1,40 @@
+#ifndef HELPERS_POWERMANAGEMENT_H
+#define HELPERS_POWERMANAGEMENT_H
+
+#include "../../ESPEasy_common.h"
+
+/*********************************************************************************************\
+* Power management in eco mode
+* When no scheduler timer is due, the loop waits until the next timer (at most 50 msec).
+* On ESP32 the CPU is kept at maximum frequency while running. Only during these waits
+* dynamic frequency scaling may lower the frequency and, when the build supports tickless idle,
+* the CPU enters automatic light sleep until the next timer, GPIO or WiFi beacon (DTIM) wakeup.
+* Thus the response time of controllers, rules and the web server stays bounded by the max wait.
+\*********************************************************************************************/
+
+// Apply the eco mode setting, called after loading the settings.
+void     PowerManagement_configure(bool ecoMode);
+
+// Let the CPU lower its frequency or sleep, until waitTime_msec has passed.
+void     PowerManagement_wait(uint32_t waitTime_msec);
+
+// Compute the statistics of the last interval, called along with the scheduler idle time stats.
+void     PowerManagement_updateStats();
+
+// Percentage of time spent in PowerManagement_wait() during the last interval.
+float    PowerManagement_getWaitTimePct();
+
+// Nr of calls to PowerManagement_wait() during the last interval.
+uint32_t PowerManagement_getNrWaits();
+
+#ifdef ESP32
+
+// Dynamic frequency scaling active
+bool     PowerManagement_DFSenabled();
+
+// Automatic light sleep active
+bool     PowerManagement_lightSleepEnabled();
+
+#endif // ifdef ESP32
+
+#endif // ifndef HELPERS_POWERMANAGEMENT_H
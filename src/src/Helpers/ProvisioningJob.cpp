@@ -0,0 +1,120 @@
+#include "../Helpers/ProvisioningJob.h"
+
+#if FEATURE_CUSTOM_PROVISIONING
+
+# include "../DataTypes/ESPEasyFileType.h"
+# include "../ESPEasyCore/ESPEasyNetwork.h"
+# include "../ESPEasyCore/ESPEasy_Log.h"
+# include "../Globals/EventQueue.h"
+# include "../Globals/Settings.h"
+# include "../Helpers/ESPEasy_Storage.h"
+# include "../Helpers/Networking.h"
+# include "../Helpers/StringConverter.h"
+
+# include <memory>
+# include <vector>
+
+struct ProvisioningJob_t {
+  struct File_t {
+    FileType::Enum filetype;
+    uint8_t        filenr;
+  };
+
+  DownloadFile_session session;
+  std::vector<File_t>  files;
+  uint8_t              nrDone   = 0;
+  uint8_t              nrFailed = 0;
+};
+
+static std::unique_ptr<ProvisioningJob_t> provisioningJob;
+
+String ProvisioningJob_start()
+{
+  if (provisioningJob) {
+    return F("Provision: Already running");
+  }
+  std::unique_ptr<ProvisioningJob_t> job(new (std::nothrow) ProvisioningJob_t);
+
+  if (!job) {
+    return F("Provision: Out of memory");
+  }
+
+  {
+    MakeProvisioningSettings(ProvisioningSettings);
+
+    if (!ProvisioningSettings.get()) {
+      return F("Provision: Out of memory");
+    }
+    loadProvisioningSettings(*ProvisioningSettings);
+
+    // In the order of FileType, which fetches provisioning.dat last, as it may change the allowed files and the server.
+    for (int i = 0; i < FileType::MAX_FILETYPE; ++i) {
+      const FileType::Enum ft = static_cast<FileType::Enum>(i);
+      const int nrFiles       = (ft == FileType::RULES_TXT) ? RULESETS_MAX : 1;
+
+      for (int filenr = 0; filenr < nrFiles; ++filenr) {
+        if (ProvisioningSettings->fetchFileTypeAllowed(ft, filenr) &&
+            getDownloadFiletypeChecked(ft, filenr)) {
+          job->files.push_back({ ft, static_cast<uint8_t>(filenr) });
+        }
+      }
+    }
+  }
+
+  if (job->files.empty()) {
+    return F("Provision: Nothing allowed to fetch");
+  }
+
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    addLogMove(LOG_LEVEL_INFO, strformat(F("Provision: Start fetching %u files"), static_cast<unsigned int>(job->files.size())));
+  }
+  provisioningJob = std::move(job);
+  return EMPTY_STRING;
+}
+
+bool ProvisioningJob_active()
+{
+  return provisioningJob.get() != nullptr;
+}
+
+void ProvisioningJob_loop()
+{
+  if (!provisioningJob || !NetworkConnected()) {
+    return;
+  }
+  const uint8_t nrFiles = provisioningJob->files.size();
+
+  if (provisioningJob->nrDone < nrFiles) {
+    const ProvisioningJob_t::File_t& file = provisioningJob->files[provisioningJob->nrDone];
+    const String error                    = downloadFileType(provisioningJob->session, file.filetype, file.filenr);
+
+    ++provisioningJob->nrDone;
+
+    if (!error.isEmpty()) {
+      ++provisioningJob->nrFailed;
+    }
+
+    if (loglevelActiveFor(error.isEmpty() ? LOG_LEVEL_INFO : LOG_LEVEL_ERROR)) {
+      addLogMove(error.isEmpty() ? LOG_LEVEL_INFO : LOG_LEVEL_ERROR, strformat(
+                   F("Provision: %u/%u %s %s"),
+                   provisioningJob->nrDone,
+                   nrFiles,
+                   getFileName(file.filetype, file.filenr).c_str(),
+                   error.isEmpty() ? "OK" : error.c_str()));
+    }
+
+    if (Settings.UseRules) {
+      eventQueue.addMove(strformat(F("Provision#Progress=%u,%u"), provisioningJob->nrDone, nrFiles));
+    }
+    return;
+  }
+
+  if (Settings.UseRules) {
+    eventQueue.addMove(concat(F("Provision#Done="), provisioningJob->nrFailed));
+  }
+
+  // Also closes the connection
+  provisioningJob.reset();
+}
+
+#endif // if FEATURE_CUSTOM_PROVISIONING
@@ -0,0 +1,28 @@
+#ifndef HELPERS_PROVISIONINGJOB_H
+#define HELPERS_PROVISIONINGJOB_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_CUSTOM_PROVISIONING
+
+/*********************************************************************************************\
+* Provisioning job
+* Downloads all files allowed in provisioning.dat in the background, one file per call of
+* ProvisioningJob_loop(), over a single connection to the provisioning server.
+* Interrupted downloads are resumed and unchanged files are skipped, see downloadFileType().
+* Progress is reported in the log and via the events:
+*   Provision#Progress=<nr files done>,<nr files total>
+*   Provision#Done=<nr files failed>
+\*********************************************************************************************/
+
+// Return an error when the job could not be started, e.g. already running or nothing allowed to fetch.
+String ProvisioningJob_start();
+
+bool   ProvisioningJob_active();
+
+// Download the next file, called from the main loop.
+void   ProvisioningJob_loop();
+
+#endif // if FEATURE_CUSTOM_PROVISIONING
+
+#endif // ifndef HELPERS_PROVISIONINGJOB_H
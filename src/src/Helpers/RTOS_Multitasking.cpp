@@ -0,0 +1,93 @@
+#include "../Helpers/RTOS_Multitasking.h"
+
+#ifdef USE_RTOS_MULTITASKING
+
+# include "../../ESPEasy-Globals.h"
+# include "../ESPEasyCore/ESPEasy_Log.h"
+# include "../Globals/NetworkState.h"
+# include "../Globals/Services.h"
+# include "../Globals/Settings.h"
+# include "../Helpers/ESPEasyMutex.h"
+# include "../Helpers/HeapTracker.h"
+# include "../Helpers/Networking.h"
+
+# include <atomic>
+
+TaskHandle_t      RTOS_serverTask_handle = nullptr;
+TaskHandle_t      RTOS_mainLoop_handle   = nullptr;
+ESPEasy_Mutex     RTOS_coreLock;
+std::atomic<bool> RTOS_serverTask_waiting(false);
+
+
+void RTOS_serverTask_run(void *parameter)
+{
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(RTOS_SERVER_TASK_IDLE_WAIT));
+
+    RTOS_serverTask_waiting = true;
+    RTOS_coreLock.lock();
+    RTOS_serverTask_waiting = false;
+
+    if (webserverRunning) {
+      HEAP_TRACK_SCOPE(WebServer);
+      web_server.handleClient();
+    }
+    # if FEATURE_ESPEASY_P2P
+    checkUDP();
+    # endif // if FEATURE_ESPEASY_P2P
+
+    RTOS_coreLock.unlock();
+  }
+}
+
+void RTOS_serverTask_start()
+{
+  if ((RTOS_serverTask_handle != nullptr) || !UseRTOSMultitasking) {
+    return;
+  }
+
+  // setup() runs in the main loop task, which owns the core lock from now on.
+  RTOS_mainLoop_handle = xTaskGetCurrentTaskHandle();
+  RTOS_coreLock.lock();
+
+  // Same priority and core as the main loop, so the task is switched to right when the lock is released.
+  // On dual core chips the main loop does not run on the WiFi core.
+  xTaskCreatePinnedToCore(
+    RTOS_serverTask_run,
+    "RTOS_TaskServers",
+    RTOS_SERVER_TASK_STACK_SIZE,
+    nullptr,
+    uxTaskPriorityGet(nullptr),
+    &RTOS_serverTask_handle,
+    xPortGetCoreID());
+
+  if (RTOS_serverTask_handle == nullptr) {
+    RTOS_coreLock.unlock();
+    UseRTOSMultitasking = false;
+    addLog(LOG_LEVEL_ERROR, F("RTOS : Could not start server task"));
+  } else {
+    addLog(LOG_LEVEL_INFO, F("RTOS : Started server task"));
+  }
+}
+
+bool RTOS_serverTask_active()
+{
+  return RTOS_serverTask_handle != nullptr;
+}
+
+void RTOS_mainLoop_yield()
+{
+  if ((RTOS_serverTask_handle == nullptr) ||
+      !RTOS_serverTask_waiting ||
+      (xTaskGetCurrentTaskHandle() != RTOS_mainLoop_handle)) {
+    return;
+  }
+
+  // The waiting server task is unblocked by the unlock and runs on taskYIELD().
+  // The main loop blocks on lock() until the server task is done.
+  RTOS_coreLock.unlock();
+  taskYIELD();
+  RTOS_coreLock.lock();
+}
+
+#endif // ifdef USE_RTOS_MULTITASKING
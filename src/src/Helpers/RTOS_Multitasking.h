@@ -0,0 +1,46 @@
+#ifndef HELPERS_RTOS_MULTITASKING_H
+#define HELPERS_RTOS_MULTITASKING_H
+
+#include "../../ESPEasy_common.h"
+
+#ifdef USE_RTOS_MULTITASKING
+
+# ifndef RTOS_SERVER_TASK_STACK_SIZE
+#  define RTOS_SERVER_TASK_STACK_SIZE  16384
+# endif // ifndef RTOS_SERVER_TASK_STACK_SIZE
+
+// Max. time the server task waits before checking the web server and p2p UDP port again.
+// The WebServer and WiFiUDP libraries do not offer a receive event to wait for.
+# ifndef RTOS_SERVER_TASK_IDLE_WAIT
+#  define RTOS_SERVER_TASK_IDLE_WAIT   5
+# endif // ifndef RTOS_SERVER_TASK_IDLE_WAIT
+
+// ********************************************************************************
+// Ownership when "Enable RTOS Multitasking" is set:
+//
+// - Main loop task (Arduino loopTask): Owns Settings, ExtraTaskSettings, UserVar, the caches,
+//   the event queue, the scheduler and all plugin/controller state. It holds the core lock
+//   all the time, except at the safe point in backgroundtasks().
+//   The scheduler keeps running here, so the timing of the tasks is not affected.
+// - Server task: Runs the web server and the ESPEasy p2p UDP port. Runs on the same core as
+//   the main loop (not the WiFi core) and only accesses shared state while holding the core lock.
+//   It gets the lock when the main loop passes the safe point in backgroundtasks().
+// - Controller queue task: See ControllerQueueTask.h, does not use the core lock.
+//
+// Other tasks and callbacks (WiFi events, UART events) must not access the shared state,
+// but set flags or queue items for the main loop.
+// ********************************************************************************
+
+// Start the server task when enabled in the settings, must be called from setup().
+// Only evaluated at boot.
+void RTOS_serverTask_start();
+
+bool RTOS_serverTask_active();
+
+// Let the server task handle pending requests, only when called from the main loop task.
+// Called from backgroundtasks(), where the web server used to run in the main loop.
+void RTOS_mainLoop_yield();
+
+#endif // ifdef USE_RTOS_MULTITASKING
+
+#endif // ifndef HELPERS_RTOS_MULTITASKING_H
@@ -1,8 +1,11 @@
 #include "../Helpers/RulesHelper.h"
 
+#include "../DataTypes/ESPEasyFileType.h"
 #include "../ESPEasyCore/ESPEasy_Log.h"
 #include "../Globals/Settings.h"
 #include "../Helpers/ESPEasy_Storage.h"
+#include "../Helpers/ESPEasy_time_calc.h"
+#include "../Helpers/StringConverter.h"
 #include "../Helpers/StringProvider.h"
 
 /********************************************************************************************\
@@ -124,20 +127,72 @@ RulesHelperClass::~RulesHelperClass()
   closeAllFiles();
 }
 
-bool RulesHelperClass::findMatchingRule(const String& event, String& filename, size_t& pos)
+bool RulesHelperClass::findMatchingRule(const String& event, String& filename, size_t& pos, size_t& cacheIndex)
 {
   if (!_eventCache.isInitialized()) {
     init();
   }
+#ifndef CACHE_RULES_IN_MEMORY
+
+  // Positions of the cached events in a changed file are no longer valid.
+  rebuildChangedFiles(true);
+#endif // ifndef CACHE_RULES_IN_MEMORY
   RulesEventCache_vector::const_iterator it = _eventCache.findMatchingRule(event, Settings.EnableRulesEventReorder());
 
   if (it == _eventCache.end()) { return false; }
 
-  filename = it->_filename;
-  pos      = it->_posInFile;
+  filename   = it->_filename;
+  pos        = it->_posInFile;
+  cacheIndex = it - _eventCache.begin();
   return true;
 }
 
+bool RulesHelperClass::eventMayMatch(const char *event, size_t length) const
+{
+  if (!Settings.OldRulesEngine() ||
+      !Settings.EnableRulesCaching() ||
+      !Settings.EnableRulesEventFilter() ||
+      (_changedFiles != 0)) {
+    return true;
+  }
+  return _eventCache.mayMatch(event, length);
+}
+
+bool RulesHelperClass::taskEventMayMatch(const String& taskName) const
+{
+  if (!Settings.OldRulesEngine() ||
+      !Settings.EnableRulesCaching() ||
+      !Settings.EnableRulesEventFilter() ||
+      (_changedFiles != 0)) {
+    return true;
+  }
+  return _eventCache.mayMatchTask(taskName);
+}
+
+#if FEATURE_RULES_PROFILING
+void RulesHelperClass::addProfile(size_t cacheIndex, uint32_t duration_usec, uint32_t nrCommands, int32_t heapDelta)
+{
+  _eventCache.addProfile(cacheIndex, duration_usec, nrCommands, heapDelta);
+}
+
+void RulesHelperClass::clearProfiles()
+{
+  _eventCache.clearProfiles();
+}
+
+#endif // if FEATURE_RULES_PROFILING
+
+#if FEATURE_RULES_COMPILED
+bool RulesHelperClass::readCompiledOp(const String& filename, size_t& pos, RulesCompiled_op& op)
+{
+  if (!_eventCache.isInitialized()) {
+    init();
+  }
+  return _compiledRules.readOp(filename, pos, op);
+}
+
+#endif // if FEATURE_RULES_COMPILED
+
 void RulesHelperClass::init()
 {
   if (_eventCache.isInitialized()) { return; }
@@ -151,6 +206,38 @@ void RulesHelperClass::init()
     bool   moreAvailable         = true;
     const bool searchNextOnBlock = false;
 
+#if FEATURE_RULES_COMPILED
+
+    if (Settings.EnableRulesCompiled()) {
+      // Parse the whole file once, the compiled rules will add the events to the cache.
+      std::vector<String> lines;
+
+      while (moreAvailable) {
+        String rulesLine = readLn(filename, pos, moreAvailable, searchNextOnBlock);
+
+        if (!rulesLine.isEmpty()) {
+          lines.emplace_back(std::move(rulesLine));
+        }
+      }
+
+      if (lines.empty()) {
+# ifndef RULES_COMPILED_IN_MEMORY
+
+        // No need to keep a compiled form of a missing or empty file
+        _compiledRules.deleteSidecar(filename);
+# endif // ifndef RULES_COMPILED_IN_MEMORY
+      } else {
+        _compiledRules.compile(filename, lines, _eventCache);
+      }
+# ifdef CACHE_RULES_IN_MEMORY
+
+      // The text lines are no longer needed.
+      _fileHandleMap.erase(filename);
+# endif // ifdef CACHE_RULES_IN_MEMORY
+      continue;
+    }
+#endif // if FEATURE_RULES_COMPILED
+
     while (moreAvailable) {
       const size_t pos_start_line = pos;
       const String rulesLine      = readLn(filename, pos, moreAvailable, searchNextOnBlock);
@@ -177,6 +264,131 @@ void RulesHelperClass::init()
   _eventCache.initialize();
 }
 
+#if FEATURE_RULES_COMPILED
+void RulesHelperClass::deleteCompiledRules()
+{
+# ifndef RULES_COMPILED_IN_MEMORY
+
+  for (uint8_t x = 0; x < RULESETS_MAX; ++x) {
+    _compiledRules.deleteSidecar(getRulesFileName(x));
+  }
+# endif // ifndef RULES_COMPILED_IN_MEMORY
+}
+
+#endif // if FEATURE_RULES_COMPILED
+
+bool RulesHelperClass::invalidateRulesFile(const String& filename)
+{
+  const String patched_fname = patch_fname(filename);
+
+  for (uint8_t x = 0; x < RULESETS_MAX; ++x) {
+    const String rulesFilename = getRulesFileName(x);
+
+    if (!patched_fname.equalsIgnoreCase(patch_fname(rulesFilename))) {
+      continue;
+    }
+#if FEATURE_RULES_COMPILED
+# ifndef RULES_COMPILED_IN_MEMORY
+
+    // Compiled form of the changed, deleted or renamed file is outdated.
+    _compiledRules.deleteSidecar(rulesFilename);
+# endif // ifndef RULES_COMPILED_IN_MEMORY
+
+    if (Settings.EnableRulesCompiled()) {
+      // Compiled rules are built from all files at once
+      return false;
+    }
+#endif // if FEATURE_RULES_COMPILED
+
+    if (_eventCache.isInitialized()) {
+      bitSet(_changedFiles, x);
+      _changedMoment = millis();
+#ifndef CACHE_RULES_IN_MEMORY
+
+      // The file contents can no longer be read at the cached positions.
+      closeFile(rulesFilename);
+#endif // ifndef CACHE_RULES_IN_MEMORY
+    } else {
+      closeFile(rulesFilename);
+    }
+    return true;
+  }
+  return false;
+}
+
+void RulesHelperClass::processChangedFiles()
+{
+  if ((_changedFiles == 0) ||
+      (timePassedSince(_changedMoment) < RULES_FILE_REBUILD_DELAY)) {
+    return;
+  }
+
+  // Only parse one file per call, to spread the load.
+  rebuildChangedFiles(false);
+}
+
+void RulesHelperClass::rebuildChangedFiles(bool all)
+{
+  for (uint8_t x = 0; x < RULESETS_MAX && _changedFiles != 0; ++x) {
+    if (bitRead(_changedFiles, x)) {
+      bitClear(_changedFiles, x);
+      rebuildFile(x);
+
+      if (!all) { return; }
+    }
+  }
+}
+
+void RulesHelperClass::rebuildFile(uint8_t rulesSet)
+{
+  const String filename = getRulesFileName(rulesSet);
+
+  // Drop the old file contents, so readLn() will read the changed file.
+  // The old events are replaced before any rule can be processed again.
+  closeFile(filename);
+
+  RulesEventCache_vector events;
+  size_t pos                   = 0;
+  bool   moreAvailable         = true;
+  const bool searchNextOnBlock = false;
+
+  while (moreAvailable) {
+    const size_t pos_start_line = pos;
+    const String rulesLine      = readLn(filename, pos, moreAvailable, searchNextOnBlock);
+
+    RulesEventCache::parseLine(rulesLine, filename, pos_start_line, events);
+  }
+
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    addLogMove(LOG_LEVEL_INFO, strformat(
+                 F("Rules : Updated cache for %s, %u events"),
+                 filename.c_str(),
+                 static_cast<unsigned int>(events.size())));
+  }
+  _eventCache.replaceFileEvents(filename, std::move(events));
+}
+
+void RulesHelperClass::closeFile(const String& filename)
+{
+  auto it = _fileHandleMap.find(filename);
+
+  if (it != _fileHandleMap.end()) {
+    #ifndef CACHE_RULES_IN_MEMORY
+    it->second.close();
+    #endif // ifndef CACHE_RULES_IN_MEMORY
+    _fileHandleMap.erase(it);
+  }
+  #ifndef CACHE_RULES_IN_MEMORY
+
+  for (auto page = _pages.begin(); page != _pages.end(); ++page) {
+    if (page->filename.equals(filename)) {
+      page->length   = 0;
+      page->lastUsed = 0;
+    }
+  }
+  #endif // ifndef CACHE_RULES_IN_MEMORY
+}
+
 void RulesHelperClass::closeAllFiles() {
   for (auto it = _fileHandleMap.begin(); it != _fileHandleMap.end();) {
     #ifdef CACHE_RULES_IN_MEMORY
@@ -186,7 +398,16 @@ void RulesHelperClass::closeAllFiles() {
     it = _fileHandleMap.erase(it);
     #endif // ifdef CACHE_RULES_IN_MEMORY
   }
+  #ifndef CACHE_RULES_IN_MEMORY
+
+  // Rules may have been changed, so also drop the cached pages.
+  _pages.clear();
+  #endif // ifndef CACHE_RULES_IN_MEMORY
   _eventCache.clear();
+  _changedFiles = 0;
+#if FEATURE_RULES_COMPILED
+  _compiledRules.clear();
+#endif // if FEATURE_RULES_COMPILED
 }
 
 #ifndef CACHE_RULES_IN_MEMORY
@@ -226,6 +447,41 @@ size_t RulesHelperClass::read(const String& filename, size_t& pos, uint8_t *buff
   return ret;
 }
 
+const RulesHelperClass::RulesFilePage * RulesHelperClass::getPage(const String& filename, size_t pos)
+{
+  if (_pages.empty()) {
+    // Allocated only once, to prevent heap fragmentation.
+    _pages.resize(RULES_PAGE_CACHE_PAGES);
+  }
+  const size_t offset = pos - (pos % RULES_PAGE_CACHE_SIZE);
+  RulesFilePage *lru  = &_pages[0];
+
+  for (auto it = _pages.begin(); it != _pages.end(); ++it) {
+    if ((it->length != 0) && (it->offset == offset) && it->filename.equals(filename)) {
+      it->lastUsed = ++_pageCounter;
+      return (pos < offset + it->length) ? &(*it) : nullptr;
+    }
+
+    if (it->lastUsed < lru->lastUsed) {
+      lru = &(*it);
+    }
+  }
+
+  size_t readPos   = offset;
+  const size_t len = read(filename, readPos, reinterpret_cast<uint8_t *>(lru->data), RULES_PAGE_CACHE_SIZE);
+
+  if (len == 0) {
+    lru->length   = 0;
+    lru->lastUsed = 0;
+    return nullptr;
+  }
+  lru->filename = filename;
+  lru->offset   = offset;
+  lru->length   = len;
+  lru->lastUsed = ++_pageCounter;
+  return (pos < offset + len) ? lru : nullptr;
+}
+
 #endif // ifndef CACHE_RULES_IN_MEMORY
 
 bool RulesHelperClass::addChar(char c, String& line,   bool& firstNonSpaceRead)
@@ -343,54 +599,103 @@ String RulesHelperClass::readLn(const String& filename,
                                 bool        & moreAvailable,
                                 bool          searchNextOnBlock)
 {
-  std::vector<uint8_t> buf;
-
-  buf.resize(RULES_BUFFER_SIZE);
-
   bool firstNonSpaceRead = false;
 
+  // When searching for the next "on ... do" block, skip the rest of non matching lines.
+  bool skipLine = false;
+
   // Try to get the best possible estimate on line length based on earlier parsing of the rules.
   static size_t longestLineSize = RULES_BUFFER_SIZE;
   String line;
 
   line.reserve(longestLineSize);
 
-  bool done = false;
+  moreAvailable = true;
 
-  while (!done) {
-    const size_t startPos = pos;
-    int len               = read(filename, pos, &buf[0], RULES_BUFFER_SIZE);
-    moreAvailable = len != 0;
+  while (moreAvailable) {
+    const RulesFilePage *page = getPage(filename, pos);
+
+    if (page == nullptr) {
+      moreAvailable = false;
+      break;
+    }
+    const char *data = page->data;
+    size_t x         = pos - page->offset;
 
-    if (!moreAvailable) { done = true; }
+    while (x < page->length) {
+      if (skipLine) {
+        const char *nl = static_cast<const char *>(memchr(&data[x], '\n', page->length - x));
 
-    for (int x = 0; x < len; x++) {
-      int data = buf[x];
+        if (nl == nullptr) {
+          x = page->length;
+          break;
+        }
+        x        = nl - data;
+        skipLine = false;
+        line.clear();
+        firstNonSpaceRead = false;
+      }
 
-      if (addChar(char(data), line, firstNonSpaceRead)) {
-        if (line.length() > longestLineSize) {
-          longestLineSize = line.length();
+      if (!firstNonSpaceRead) {
+        // Strip leading spaces.
+        while (x < page->length && (data[x] == ' ' || data[x] == '\t' || data[x] == '\r')) {
+          ++x;
         }
+      }
+
+      // Append all characters up to the next one which needs special handling.
+      size_t end = x;
+
+      while (end < page->length && data[end] != '\n' && data[end] != '\r' && data[end] != '\t') {
+        ++end;
+      }
+
+      if (end > x) {
+        line.concat(&data[x], end - x);
+        firstNonSpaceRead = true;
+        x                 = end;
+      }
+
+      if (x < page->length) {
+        const char c = data[x];
+
+        if (addChar(c, line, firstNonSpaceRead)) {
+          if (line.length() > longestLineSize) {
+            longestLineSize = line.length();
+          }
 
-        // A line may end on every position in the buffer,
-        // so we must make sure the position is reflecting the end of the line.
-        pos = startPos + x;
+          // A line may end on every position in the page,
+          // so we must make sure the position is reflecting the end of the line.
+          pos = page->offset + x;
 
-        if (!searchNextOnBlock ||
-            line.substring(0, 3).equalsIgnoreCase(F("on ")))
-        {
-          done = true;
+          if (!searchNextOnBlock ||
+              line.substring(0, 3).equalsIgnoreCase(F("on ")))
+          {
+            return line;
+          }
 
-          return line;
-        } else {
           // Not starting with "on " which we need, so continue to search for a matching line
           line.clear();
+          firstNonSpaceRead = false;
         }
+        ++x;
+      }
+
+      if (searchNextOnBlock && (line.length() >= 3) &&
+          !line.substring(0, 3).equalsIgnoreCase(F("on "))) {
+        skipLine = true;
       }
     }
+    pos = page->offset + page->length;
   }
+
   rules_strip_trailing_comments(line);
   check_rules_line_user_errors(line);
+
+  if (searchNextOnBlock && !line.substring(0, 3).equalsIgnoreCase(F("on "))) {
+    // Last line of the file does not start with "on "
+    line.clear();
+  }
   return line;
 }
 
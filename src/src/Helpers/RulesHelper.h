@@ -3,6 +3,7 @@
 
 #include "../../ESPEasy_common.h"
 
+#include "../DataStructs/RulesCompiledProgram.h"
 #include "../DataStructs/RulesEventCache.h"
 
 #include <FS.h>
@@ -12,6 +13,22 @@
 # define CACHE_RULES_IN_MEMORY
 #endif // ifdef ESP32
 
+#ifndef CACHE_RULES_IN_MEMORY
+
+// Rules files are read in pages, which are kept in a small LRU cache shared by all rules files.
+# ifndef RULES_PAGE_CACHE_SIZE
+#  define RULES_PAGE_CACHE_SIZE    256
+# endif // ifndef RULES_PAGE_CACHE_SIZE
+# ifndef RULES_PAGE_CACHE_PAGES
+#  define RULES_PAGE_CACHE_PAGES   3
+# endif // ifndef RULES_PAGE_CACHE_PAGES
+#endif // ifndef CACHE_RULES_IN_MEMORY
+
+// Changed rules files are parsed again when not changed for this long, as an upload is written in multiple steps.
+#ifndef RULES_FILE_REBUILD_DELAY
+# define RULES_FILE_REBUILD_DELAY  500
+#endif // ifndef RULES_FILE_REBUILD_DELAY
+
 
 // Helper class to handle reading from the rules file(s).
 // Opening a file on ESP32 with a relatively large LittleFS file system
@@ -20,9 +37,7 @@
 // not be handled at all as they are not described in the rules files.
 // Thus we must also provide some kind of caching of handled in the rules files.
 
-#ifdef CACHE_RULES_IN_MEMORY
-# include <vector>
-#endif // ifdef CACHE_RULES_IN_MEMORY
+#include <vector>
 
 
 class RulesHelperClass {
@@ -36,18 +51,84 @@ public:
 
   void init();
 
+  // Mark a single rules file as changed, so only this file will be parsed again.
+  // Return false when the file is not a rules file, or the entire cache must be cleared.
+  bool invalidateRulesFile(const String& filename);
+
+#if FEATURE_RULES_COMPILED
+
+  // Remove the compiled rules stored on the file system, e.g. when compiled rules are disabled.
+  void deleteCompiledRules();
+#endif // if FEATURE_RULES_COMPILED
+
+  // Parse changed rules files and replace their part of the cache, called from the background.
+  // The old cache is used until the changed file is completely parsed.
+  void processChangedFiles();
+
+  // cacheIndex is set to the position of the matched rule in the event cache.
   bool findMatchingRule(const String& event,
                         String      & filename,
-                        size_t      & pos);
+                        size_t      & pos,
+                        size_t      & cacheIndex);
+
+  // Return false when the event cannot match any rule.
+  // Always true when the rules cache is not (yet) filled or the filter is disabled.
+  bool eventMayMatch(const char *event,
+                     size_t      length) const;
+
+  // Return false when no event of a task with this name can match any rule.
+  bool taskEventMayMatch(const String& taskName) const;
+
+#if FEATURE_RULES_PROFILING
+  void addProfile(size_t   cacheIndex,
+                  uint32_t duration_usec,
+                  uint32_t nrCommands,
+                  int32_t  heapDelta);
+
+  void clearProfiles();
+
+  const RulesEventCache& getEventCache() const {
+    return _eventCache;
+  }
+#endif // if FEATURE_RULES_PROFILING
+
+#if FEATURE_RULES_COMPILED
+
+  // Read compiled op at pos, as returned by findMatchingRule() when compiled rules are enabled.
+  bool readCompiledOp(const String    & filename,
+                      size_t          & pos,
+                      RulesCompiled_op& op);
+#endif // if FEATURE_RULES_COMPILED
 
 private:
 
+  // Parse the changed rules files, only the first one found when 'all' is not set.
+  void rebuildChangedFiles(bool all);
+
+  void rebuildFile(uint8_t rulesSet);
+
+  // Close the file and drop the data read from it.
+  void closeFile(const String& filename);
+
 #ifndef CACHE_RULES_IN_MEMORY
   size_t read(const String& filename,
               size_t      & pos,
               uint8_t      *buffer,
               size_t        length);
 
+  struct RulesFilePage {
+    String   filename;
+    size_t   offset   = 0; // Multiple of RULES_PAGE_CACHE_SIZE
+    size_t   length   = 0; // 0 = unused page
+    uint32_t lastUsed = 0;
+    char     data[RULES_PAGE_CACHE_SIZE]{};
+  };
+
+  // Return the page holding the data at pos.
+  // Return nullptr when pos is at or beyond the end of the file.
+  const RulesFilePage* getPage(const String& filename,
+                               size_t        pos);
+
 #endif // ifndef CACHE_RULES_IN_MEMORY
 
   bool addChar(char    c,
@@ -76,7 +157,20 @@ private:
 
   RulesEventCache _eventCache;
 
+#if FEATURE_RULES_COMPILED
+  RulesCompiledProgram _compiledRules;
+#endif // if FEATURE_RULES_COMPILED
+
   FileHandleMap _fileHandleMap;
+
+  // Bit per rules set which has been changed since the cache was built
+  uint8_t  _changedFiles  = 0;
+  uint32_t _changedMoment = 0;
+
+#ifndef CACHE_RULES_IN_MEMORY
+  std::vector<RulesFilePage> _pages;
+  uint32_t                   _pageCounter = 0;
+#endif // ifndef CACHE_RULES_IN_MEMORY
 };
 
 #endif // ifndef HELPERS_RULESHELPER_H
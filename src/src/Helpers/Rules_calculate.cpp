@@ -7,6 +7,10 @@
 #include "../Helpers/Numerical.h"
 #include "../Helpers/StringConverter.h"
 
+#if FEATURE_RULES_CALCULATE_CACHE
+# include <algorithm>
+#endif // if FEATURE_RULES_CALCULATE_CACHE
+
 
 RulesCalculate_t::RulesCalculate_t() {
   for (int i = 0; i < STACK_SIZE; ++i) {
@@ -284,6 +288,10 @@ CalculateReturnCode RulesCalculate_t::RPNCalculate(char *token)
     ESPEASY_RULES_FLOAT_TYPE first  = pop();
 
     ret = push(apply_operator(token[0], first, second));
+#if FEATURE_RULES_CALCULATE_CACHE
+
+    if (_recording != nullptr) { _recording->push_back(token[0]); }
+#endif // if FEATURE_RULES_CALCULATE_CACHE
 
 // FIXME TD-er: Regardless whether it is an error, all code paths return ret;
 //    if (isError(ret)) { return ret; }
@@ -292,6 +300,10 @@ CalculateReturnCode RulesCalculate_t::RPNCalculate(char *token)
     ESPEASY_RULES_FLOAT_TYPE first = pop();
 
     ret = push(apply_unary_operator(token[0], first));
+#if FEATURE_RULES_CALCULATE_CACHE
+
+    if (_recording != nullptr) { _recording->push_back(token[0]); }
+#endif // if FEATURE_RULES_CALCULATE_CACHE
 
 // FIXME TD-er: Regardless whether it is an error, all code paths return ret;
 //    if (isError(ret)) { return ret; }
@@ -301,6 +313,10 @@ CalculateReturnCode RulesCalculate_t::RPNCalculate(char *token)
     validDoubleFromString(token, value);
 
     ret = push(value); // If it is a value, push to the stack
+#if FEATURE_RULES_CALCULATE_CACHE
+
+    if (_recording != nullptr) { _recording->push_back(RPN_PUSH_VALUE); }
+#endif // if FEATURE_RULES_CALCULATE_CACHE
 
 // FIXME TD-er: Regardless whether it is an error, all code paths return ret;
 //    if (isError(ret)) { return ret; }
@@ -539,6 +555,283 @@ CalculateReturnCode RulesCalculate_t::doCalculate(const char *input, ESPEASY_RUL
   return CalculateReturnCode::OK;
 }
 
+#if FEATURE_RULES_CALCULATE_CACHE
+void RulesCalculate_program_t::clear()
+{
+  steps.clear();
+  operands.clear();
+}
+
+bool RulesCalculate_program_t::usesVariable(uint8_t varIndex) const
+{
+  for (auto it = operands.begin(); it != operands.end(); ++it) {
+    if (it->varIndex == varIndex) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool RulesCalculate_t::is_variable(char c)
+{
+  return c >= RULES_CALCULATE_VARIABLE_MARKER &&
+         c < (RULES_CALCULATE_VARIABLE_MARKER + RULES_CALCULATE_MAX_VARIABLES);
+}
+
+bool RulesCalculate_t::tokenize(const char *input, String& shape, std::vector<String>& constants, bool allowVariables)
+{
+  // Must follow the exact same steps as doCalculate() to determine
+  // which characters end up in which value token.
+  const char *strpos = input, *strend = input + strlen(input);
+  char   c = 0, oc = 0;
+  String token;
+  bool   inNumber = false;
+
+  if (input[0] == '=') {
+    ++strpos;
+
+    if (strpos < strend) {
+      c = *strpos;
+    }
+  }
+
+  shape.reserve(strend - strpos);
+
+  while (strpos < strend)
+  {
+    if (token.length() >= (TOKEN_LENGTH - 1)) { return false; }
+
+    oc = c;
+    c  = *strpos;
+
+    if (c != ' ')
+    {
+      if (is_number(oc, c) || (allowVariables && is_variable(c))) {
+        token += c;
+
+        if (!inNumber) {
+          // Numbers only differing in their value share the same shape.
+          shape   += '#';
+          inNumber = true;
+        }
+      } else {
+        if (is_operator(c) || is_unary_operator(c) || (c == ')')) {
+          // doCalculate() evaluates the pending token here.
+          if (!token.isEmpty()) {
+            if ((token.length() == 1) && is_operator(token[0])) {
+              // Would be handled as an operator, not as value
+              return false;
+            }
+            constants.emplace_back(std::move(token));
+            token = String();
+          }
+        } else if (c != '(') {
+          return false;
+        }
+        shape   += c;
+        inNumber = false;
+      }
+    }
+    ++strpos;
+  }
+
+  if (!token.isEmpty()) {
+    if ((token.length() == 1) && is_operator(token[0])) {
+      return false;
+    }
+    constants.emplace_back(std::move(token));
+  }
+  return true;
+}
+
+CalculateReturnCode RulesCalculate_t::runOperatorStep(char step)
+{
+  if (is_operator(step)) {
+    ESPEASY_RULES_FLOAT_TYPE second = pop();
+    ESPEASY_RULES_FLOAT_TYPE first  = pop();
+
+    return push(apply_operator(step, first, second));
+  }
+  ESPEASY_RULES_FLOAT_TYPE first = pop();
+
+  return push(apply_unary_operator(step, first));
+}
+
+CalculateReturnCode RulesCalculate_t::runProgram(const std::vector<char>  & steps,
+                                                 const std::vector<String>& constants,
+                                                 ESPEASY_RULES_FLOAT_TYPE  *result)
+{
+  CalculateReturnCode ret = CalculateReturnCode::OK;
+  auto constant           = constants.begin();
+
+  sp = globalstack - 1;
+
+  for (auto it = steps.begin(); it != steps.end() && !isError(ret); ++it) {
+    const char step = *it;
+
+    if (step == RPN_PUSH_VALUE) {
+      ESPEASY_RULES_FLOAT_TYPE value{};
+
+      if (constant != constants.end()) {
+        validDoubleFromString(*constant, value);
+        ++constant;
+      }
+      ret = push(value);
+    } else {
+      ret = runOperatorStep(step);
+    }
+  }
+
+  if (isError(ret) || (sp < globalstack))
+  {
+    *result = 0;
+    return isError(ret) ? ret : CalculateReturnCode::ERROR_STACK_OVERFLOW;
+  }
+  *result = *sp;
+  return CalculateReturnCode::OK;
+}
+
+CalculateReturnCode RulesCalculate_t::doCalculateCached(const char *input, ESPEASY_RULES_FLOAT_TYPE *result)
+{
+  String shape;
+  std::vector<String> constants;
+
+  if (!tokenize(input, shape, constants, false)) {
+    // Let doCalculate() deal with it, including reporting the error.
+    return doCalculate(input, result);
+  }
+
+  START_TIMER;
+
+  for (auto it = _programCache.begin(); it != _programCache.end(); ++it) {
+    if (it->shape.equals(shape)) {
+      // Move to the front, to keep the most recently used ones
+      std::rotate(_programCache.begin(), it, it + 1);
+      const CalculateReturnCode ret = runProgram(_programCache.front().steps, constants, result);
+      STOP_TIMER(COMPUTE_CACHE_HIT);
+      return ret;
+    }
+  }
+
+  RPNProgram program;
+  program.shape = std::move(shape);
+
+  _recording = &program.steps;
+  const CalculateReturnCode ret = doCalculate(input, result);
+  _recording = nullptr;
+
+  if (!isError(ret) &&
+      (static_cast<size_t>(std::count(program.steps.begin(), program.steps.end(), RPN_PUSH_VALUE)) == constants.size())) {
+    if (_programCache.size() >= RULES_CALCULATE_CACHE_SIZE) {
+      _programCache.pop_back();
+    }
+    _programCache.emplace(_programCache.begin(), std::move(program));
+  }
+  STOP_TIMER(COMPUTE_CACHE_MISS);
+  return ret;
+}
+
+void RulesCalculate_t::clearCache()
+{
+  _programCache.clear();
+}
+
+bool RulesCalculate_t::compile(const String& input, RulesCalculate_program_t& program)
+{
+  program.clear();
+
+  String shape;
+  std::vector<String> constants;
+
+  if (!tokenize(input.c_str(), shape, constants, true)) {
+    return false;
+  }
+
+  // Record the steps using some number for the variables.
+  // Since a variable marker is handled as a number by tokenize(),
+  // the recorded steps are the same.
+  String numerical(input);
+
+  for (size_t i = 0; i < numerical.length(); ++i) {
+    if (is_variable(numerical[i])) {
+      numerical[i] = '1';
+    }
+  }
+
+  ESPEASY_RULES_FLOAT_TYPE dummy{};
+
+  _recording = &program.steps;
+  const CalculateReturnCode ret = doCalculate(numerical.c_str(), &dummy);
+  _recording = nullptr;
+
+  if (isError(ret) ||
+      (static_cast<size_t>(std::count(program.steps.begin(), program.steps.end(), RPN_PUSH_VALUE)) != constants.size())) {
+    program.clear();
+    return false;
+  }
+
+  program.operands.resize(constants.size());
+
+  for (size_t i = 0; i < constants.size(); ++i) {
+    const String& token = constants[i];
+
+    if ((token.length() == 1) && is_variable(token[0])) {
+      program.operands[i].varIndex = token[0] - RULES_CALCULATE_VARIABLE_MARKER;
+    } else {
+      for (size_t c = 0; c < token.length(); ++c) {
+        if (is_variable(token[c])) {
+          // Variable combined with other characters in a single token
+          program.clear();
+          return false;
+        }
+      }
+      validDoubleFromString(token, program.operands[i].value);
+    }
+  }
+  return true;
+}
+
+CalculateReturnCode RulesCalculate_t::execute(const RulesCalculate_program_t& program,
+                                              const ESPEASY_RULES_FLOAT_TYPE *vars,
+                                              uint8_t                         nrVars,
+                                              ESPEASY_RULES_FLOAT_TYPE       *result)
+{
+  CalculateReturnCode ret = CalculateReturnCode::OK;
+  auto operand            = program.operands.begin();
+
+  sp = globalstack - 1;
+
+  for (auto it = program.steps.begin(); it != program.steps.end() && !isError(ret); ++it) {
+    const char step = *it;
+
+    if (step == RPN_PUSH_VALUE) {
+      ESPEASY_RULES_FLOAT_TYPE value{};
+
+      if (operand != program.operands.end()) {
+        if (operand->varIndex < 0) {
+          value = operand->value;
+        } else if (operand->varIndex < nrVars) {
+          value = vars[operand->varIndex];
+        }
+        ++operand;
+      }
+      ret = push(value);
+    } else {
+      ret = runOperatorStep(step);
+    }
+  }
+
+  if (isError(ret) || (sp < globalstack))
+  {
+    *result = 0;
+    return isError(ret) ? ret : CalculateReturnCode::ERROR_STACK_OVERFLOW;
+  }
+  *result = *sp;
+  return CalculateReturnCode::OK;
+}
+
+#endif // if FEATURE_RULES_CALCULATE_CACHE
+
 void preProcessReplace(String& input, UnaryOperator op) {
   String find = toString(op);
 
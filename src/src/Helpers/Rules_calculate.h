@@ -4,6 +4,10 @@
 
 #include "../../ESPEasy_common.h"
 
+#if FEATURE_RULES_CALCULATE_CACHE
+# include <vector>
+#endif // if FEATURE_RULES_CALCULATE_CACHE
+
 /********************************************************************************************\
    Calculate function for simple expressions
  \*********************************************************************************************/
@@ -13,6 +17,16 @@
 #define TOKEN_LENGTH 25
 #define OPERATOR_STACK_SIZE 32
 
+#if FEATURE_RULES_CALCULATE_CACHE
+# ifndef RULES_CALCULATE_CACHE_SIZE
+#  ifdef ESP8266
+#   define RULES_CALCULATE_CACHE_SIZE 4
+#  else // ifdef ESP8266
+#   define RULES_CALCULATE_CACHE_SIZE 16
+#  endif // ifdef ESP8266
+# endif // ifndef RULES_CALCULATE_CACHE_SIZE
+#endif // if FEATURE_RULES_CALCULATE_CACHE
+
 enum class CalculateReturnCode : uint8_t{
   OK                           = 0u,
   ERROR_STACK_OVERFLOW         = 1u,
@@ -52,6 +66,34 @@ enum class UnaryOperator : uint8_t {
   ArcTan_d   // Arc Tangent (degree)
 };
 
+#if FEATURE_RULES_CALCULATE_CACHE
+
+// Expression compiled into a RPN program with all operands already parsed.
+// An operand can also refer to a variable, which is bound at evaluation.
+struct RulesCalculate_operand_t {
+  ESPEASY_RULES_FLOAT_TYPE value{};
+  int8_t                   varIndex = -1; // -1 when operand is a constant
+};
+
+struct RulesCalculate_program_t {
+  void clear();
+
+  bool isEmpty() const {
+    return steps.empty();
+  }
+
+  bool usesVariable(uint8_t varIndex) const;
+
+  std::vector<char>                     steps;
+  std::vector<RulesCalculate_operand_t> operands;
+};
+
+// Variables are represented in an expression to compile as a single character
+// Variable n uses (RULES_CALCULATE_VARIABLE_MARKER + n)
+# define RULES_CALCULATE_VARIABLE_MARKER  0x01
+# define RULES_CALCULATE_MAX_VARIABLES    8
+#endif // if FEATURE_RULES_CALCULATE_CACHE
+
 void   preProcessReplace(String      & input,
                          UnaryOperator op);
 bool   angleDegree(UnaryOperator op);
@@ -100,6 +142,43 @@ private:
 
   unsigned int op_arg_count(const char c);
 
+#if FEATURE_RULES_CALCULATE_CACHE
+
+  // Step in a compiled RPN program to push the next constant onto the stack.
+  // All other steps are (unary) operators.
+  static constexpr char RPN_PUSH_VALUE = 0;
+
+  struct RPNProgram {
+    // Expression with all numerical constants replaced by a placeholder
+    String            shape;
+    std::vector<char> steps;
+  };
+
+  // Split the input into its shape and the numerical constants,
+  // the same way doCalculate() would tokenize it.
+  // Return false when the input cannot be handled by a cached program.
+  // When allowVariables is set, variable markers are accepted as value tokens.
+  bool                tokenize(const char          *input,
+                               String              & shape,
+                               std::vector<String> & constants,
+                               bool                  allowVariables);
+
+  static bool         is_variable(char c);
+
+  // Apply a (unary) operator step on the values on the stack
+  CalculateReturnCode runOperatorStep(char step);
+
+  CalculateReturnCode runProgram(const std::vector<char>  & steps,
+                                 const std::vector<String>& constants,
+                                 ESPEASY_RULES_FLOAT_TYPE  *result);
+
+  // LRU cache of compiled programs, most recently used first.
+  std::vector<RPNProgram> _programCache;
+
+  // When set, doCalculate() will record the RPN steps it executes.
+  std::vector<char> *_recording = nullptr;
+#endif // if FEATURE_RULES_CALCULATE_CACHE
+
 public:
 
   RulesCalculate_t();
@@ -107,6 +186,27 @@ public:
   CalculateReturnCode doCalculate(const char *input,
                                   ESPEASY_RULES_FLOAT_TYPE     *result);
 
+#if FEATURE_RULES_CALCULATE_CACHE
+
+  // Same as doCalculate(), but evaluate expressions with the same shape
+  // (only differing in numerical constants) via a cached RPN program.
+  CalculateReturnCode doCalculateCached(const char               *input,
+                                        ESPEASY_RULES_FLOAT_TYPE *result);
+
+  void                clearCache();
+
+  // Compile a preprocessed expression, which may contain variable markers.
+  // Return false when the expression cannot be compiled, e.g. due to errors.
+  bool                compile(const String            & input,
+                              RulesCalculate_program_t& program);
+
+  // Evaluate a compiled program, using the values in vars for the variables.
+  CalculateReturnCode execute(const RulesCalculate_program_t& program,
+                              const ESPEASY_RULES_FLOAT_TYPE *vars,
+                              uint8_t                         nrVars,
+                              ESPEASY_RULES_FLOAT_TYPE       *result);
+#endif // if FEATURE_RULES_CALCULATE_CACHE
+
   // Try to replace multi byte operators with single character ones.
   // For example log, sin, cos, tan.
   static String preProces(const String& input);
@@ -0,0 +1,208 @@
+#include "../Helpers/SD_LogBuffer.h"
+
+#if FEATURE_SD_LOG_BUFFER
+
+# include "../Globals/ESPEasy_time.h"
+# include "../Helpers/ESPEasyMutex.h"
+# include "../Helpers/ESPEasy_Storage.h"
+# include "../Helpers/ESPEasy_time_calc.h"
+# include "../Helpers/StringConverter.h"
+
+# include <SD.h>
+
+uint8_t       SD_LogBuffer_data[SD_LOG_BUFFER_SIZE];
+size_t        SD_LogBuffer_readPos    = 0;
+size_t        SD_LogBuffer_count      = 0;
+uint32_t      SD_LogBuffer_dropped    = 0;
+unsigned long SD_LogBuffer_lastAdd    = 0;
+ESPEasy_Mutex SD_LogBuffer_mutex;
+
+// Only a single writer at a time, as the block is static to keep it off the stack.
+ESPEasy_Mutex SD_LogBuffer_writeMutex;
+uint8_t       SD_LogBuffer_block[SD_LOG_BLOCK_SIZE];
+
+# ifdef ESP32
+TaskHandle_t SD_LogBuffer_taskHandle  = nullptr;
+bool         SD_LogBuffer_taskStarted = false;
+# endif // ifdef ESP32
+
+// Append to the ring buffer, must be called with SD_LogBuffer_mutex locked.
+void SD_LogBuffer_append(const uint8_t *data, size_t size)
+{
+  size_t writePos = (SD_LogBuffer_readPos + SD_LogBuffer_count) % SD_LOG_BUFFER_SIZE;
+
+  for (size_t i = 0; i < size; ++i) {
+    SD_LogBuffer_data[writePos] = data[i];
+    writePos                    = (writePos + 1) % SD_LOG_BUFFER_SIZE;
+  }
+  SD_LogBuffer_count += size;
+}
+
+// Write buffered data to the SD card.
+// Chunks are aligned to SD_LOG_BLOCK_SIZE within the file, so after writing a partial
+// block the next write completes that block first.
+// @param all  Also write the last partial block
+void SD_LogBuffer_write(bool all)
+{
+  SD_LogBuffer_writeMutex.lock();
+  fs::File logFile;
+  size_t   filePos = 0;
+
+  for (;;) {
+    SD_LogBuffer_mutex.lock();
+    const size_t buffered = SD_LogBuffer_count;
+    SD_LogBuffer_mutex.unlock();
+
+    if ((buffered == 0) || (!all && (buffered < SD_LOG_BLOCK_SIZE))) {
+      break;
+    }
+
+    if (!logFile) {
+      logFile = SD.open(SD_LogBuffer_getFileName(), "a+");
+
+      if (!logFile) {
+        // No card present, data is lost.
+        SD_LogBuffer_mutex.lock();
+        SD_LogBuffer_readPos = (SD_LogBuffer_readPos + SD_LogBuffer_count) % SD_LOG_BUFFER_SIZE;
+        SD_LogBuffer_count   = 0;
+        SD_LogBuffer_mutex.unlock();
+        break;
+      }
+      filePos = logFile.size();
+    }
+    const size_t chunkSize = SD_LOG_BLOCK_SIZE - (filePos % SD_LOG_BLOCK_SIZE);
+    size_t       size      = 0;
+    uint32_t     dropped   = 0;
+
+    SD_LogBuffer_mutex.lock();
+    size = SD_LogBuffer_count;
+
+    if (size > chunkSize) {
+      size = chunkSize;
+    }
+
+    if (all || (size == chunkSize)) {
+      for (size_t i = 0; i < size; ++i) {
+        SD_LogBuffer_block[i] = SD_LogBuffer_data[(SD_LogBuffer_readPos + i) % SD_LOG_BUFFER_SIZE];
+      }
+      SD_LogBuffer_readPos = (SD_LogBuffer_readPos + size) % SD_LOG_BUFFER_SIZE;
+      SD_LogBuffer_count  -= size;
+      dropped              = SD_LogBuffer_dropped;
+      SD_LogBuffer_dropped = 0;
+    } else {
+      size = 0;
+    }
+    SD_LogBuffer_mutex.unlock();
+
+    if (size == 0) {
+      break;
+    }
+
+    if (dropped != 0) {
+      filePos += logFile.print(concat(F("SD log: lines dropped: "), dropped));
+      filePos += logFile.print(F("\r\n"));
+    }
+    filePos += logFile.write(SD_LogBuffer_block, size);
+  }
+
+  if (logFile) {
+    logFile.close();
+  }
+  SD_LogBuffer_writeMutex.unlock();
+}
+
+bool SD_LogBuffer_isIdle()
+{
+  SD_LogBuffer_mutex.lock();
+  const bool idle = (SD_LogBuffer_count != 0) && (timePassedSince(SD_LogBuffer_lastAdd) >= SD_LOG_IDLE_FLUSH_TIME);
+
+  SD_LogBuffer_mutex.unlock();
+  return idle;
+}
+
+# ifdef ESP32
+void SD_LogBuffer_run(void *parameter)
+{
+  for (;;) {
+    // Woken up when a full block is buffered, or check for idle time.
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(SD_LOG_IDLE_FLUSH_TIME));
+    SD_LogBuffer_write(SD_LogBuffer_isIdle());
+  }
+}
+
+void SD_LogBuffer_startTask()
+{
+  SD_LogBuffer_taskStarted = true;
+
+  // Lower priority than the main loop, as writing the log is never urgent.
+  xTaskCreatePinnedToCore(
+    SD_LogBuffer_run,
+    "SD_Log",
+    SD_LOG_TASK_STACK_SIZE,
+    nullptr,
+    0,
+    &SD_LogBuffer_taskHandle,
+    0);
+}
+
+# endif // ifdef ESP32
+
+void SD_LogBuffer_add(const String& line)
+{
+  const size_t size = line.length() + 2;
+  bool blockFull    = false;
+
+  SD_LogBuffer_mutex.lock();
+
+  if ((SD_LogBuffer_count + size) > SD_LOG_BUFFER_SIZE) {
+    ++SD_LogBuffer_dropped;
+  } else {
+    SD_LogBuffer_append(reinterpret_cast<const uint8_t *>(line.c_str()), line.length());
+    SD_LogBuffer_append(reinterpret_cast<const uint8_t *>("\r\n"), 2);
+    SD_LogBuffer_lastAdd = millis();
+    blockFull            = SD_LogBuffer_count >= SD_LOG_BLOCK_SIZE;
+  }
+  SD_LogBuffer_mutex.unlock();
+
+  # ifdef ESP32
+
+  if (!SD_LogBuffer_taskStarted) {
+    // When the task cannot be started, the buffer is written from the main loop.
+    SD_LogBuffer_startTask();
+  }
+
+  if (blockFull && (SD_LogBuffer_taskHandle != nullptr)) {
+    xTaskNotifyGive(SD_LogBuffer_taskHandle);
+  }
+  # endif // ifdef ESP32
+}
+
+void SD_LogBuffer_loop()
+{
+  # ifdef ESP32
+
+  if (SD_LogBuffer_taskHandle != nullptr) {
+    return;
+  }
+  # endif // ifdef ESP32
+  SD_LogBuffer_write(SD_LogBuffer_isIdle());
+}
+
+void SD_LogBuffer_flush()
+{
+  SD_LogBuffer_write(true);
+}
+
+String SD_LogBuffer_getFileName()
+{
+  if (node_time.systemTimePresent()) {
+    return patch_fname(strformat(
+                         F("log_%04d%02d%02d.txt"),
+                         node_time.year(),
+                         node_time.month(),
+                         node_time.day()));
+  }
+  return patch_fname(F("log.txt"));
+}
+
+#endif // if FEATURE_SD_LOG_BUFFER
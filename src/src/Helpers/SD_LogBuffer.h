@@ -0,0 +1,54 @@
+#ifndef HELPERS_SD_LOGBUFFER_H
+#define HELPERS_SD_LOGBUFFER_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_SD_LOG_BUFFER
+
+// Size of the RAM buffer holding log lines not yet written to the SD card
+# ifndef SD_LOG_BUFFER_SIZE
+#  ifdef ESP32
+#   define SD_LOG_BUFFER_SIZE       4096
+#  else // ifdef ESP32
+#   define SD_LOG_BUFFER_SIZE       1024
+#  endif // ifdef ESP32
+# endif // ifndef SD_LOG_BUFFER_SIZE
+
+// Data is written in blocks of the SD card sector size, to prevent read-modify-write cycles on the card.
+# define SD_LOG_BLOCK_SIZE          512
+
+// Time in msec without new log lines before the remaining (partial block) data is written.
+# ifndef SD_LOG_IDLE_FLUSH_TIME
+#  define SD_LOG_IDLE_FLUSH_TIME    2000
+# endif // ifndef SD_LOG_IDLE_FLUSH_TIME
+
+# ifdef ESP32
+#  ifndef SD_LOG_TASK_STACK_SIZE
+#   define SD_LOG_TASK_STACK_SIZE   4096
+#  endif // ifndef SD_LOG_TASK_STACK_SIZE
+# endif // ifdef ESP32
+
+// ********************************************************************************
+// Buffered logging to the SD card.
+// Log lines are collected in a RAM ring buffer and appended to the log file in full
+// blocks of SD_LOG_BLOCK_SIZE bytes, or when no line was added for a while.
+// On ESP32 the file is written from a separate FreeRTOS task, so logging does not
+// block the caller. On ESP8266 the buffer is written from the main loop.
+// When the system time is known, a log file per day is used: log_YYYYMMDD.txt
+// Lines which do not fit in the buffer are dropped and counted.
+// ********************************************************************************
+
+void   SD_LogBuffer_add(const String& line);
+
+// Write full blocks, or all data when idle. Must be called from the main loop.
+// Does nothing on ESP32 while the background task is running.
+void   SD_LogBuffer_loop();
+
+// Write all buffered data, e.g. before a reboot.
+void   SD_LogBuffer_flush();
+
+String SD_LogBuffer_getFileName();
+
+#endif // if FEATURE_SD_LOG_BUFFER
+
+#endif // ifndef HELPERS_SD_LOGBUFFER_H
@@ -8,9 +8,12 @@
 
 #include "../ESPEasyCore/ESPEasyRules.h"
 
+#include "../Globals/C016_ControllerCache.h"
 #include "../Globals/RTC.h"
 
 #include "../Helpers/ESPEasyRTC.h"
+#include "../Helpers/EventTracer.h"
+#include "../Helpers/SlowLoopDetector.h"
 
 
 void ESPEasy_Scheduler::markIntendedReboot(IntendedRebootReason_e reason) {
@@ -55,7 +58,12 @@ void ESPEasy_Scheduler::handle_schedule() {
     process_system_event_queue();
 
     // System events may have added one or more rule events, try to process those
-    processNextEvent();
+    processEventQueue();
+    #ifdef USES_C016
+
+    // Keep room for the controller cache on the FS, which otherwise must be done while flushing the cache.
+    ControllerCache.backgroundMaintenance();
+    #endif // ifdef USES_C016
     last_system_event_run = millis();
     STOP_TIMER(HANDLE_SCHEDULER_IDLE);
     return;
@@ -63,6 +71,13 @@ void ESPEasy_Scheduler::handle_schedule() {
 
   const SchedulerTimerID timerID(mixed_id);
 
+  EVENT_TRACE_SCOPE(Scheduler, mixed_id);
+  #if FEATURE_SLOW_LOOP_DETECTOR
+  SlowLoop_scheduler(mixed_id);
+  #endif // if FEATURE_SLOW_LOOP_DETECTOR
+
+  ADD_SCHEDULER_LATENESS(getLatenessStatsKey(timerID), static_cast<int64_t>(timePassedSince(timer)) * 1000);
+
   delay(0); // See: https://github.com/letscontrolit/ESPEasy/issues/1818#issuecomment-425351328
 
   switch (timerID.getTimerType()) {
@@ -95,6 +110,19 @@ void ESPEasy_Scheduler::handle_schedule() {
   STOP_TIMER(HANDLE_SCHEDULER_TASK);
 }
 
+uint32_t ESPEasy_Scheduler::getLatenessStatsKey(SchedulerTimerID timerID) {
+  switch (timerID.getTimerType()) {
+    case SchedulerTimerType_e::ConstIntervalTimer:
+    case SchedulerTimerType_e::TaskDeviceTimer:
+      return timerID.mixed_id;
+    default:
+      break;
+  }
+
+  // Only the timer type, not the specific timer
+  return SchedulerTimerID(timerID.getTimerType()).mixed_id;
+}
+
 String ESPEasy_Scheduler::getQueueStats() {
   return msecTimerHandler.getQueueStats();
 }
@@ -107,6 +135,10 @@ float ESPEasy_Scheduler::getIdleTimePct() const {
   return msecTimerHandler.getIdleTimePct();
 }
 
+bool ESPEasy_Scheduler::hasScheduledTimerDue() const {
+  return msecTimerHandler.hasTimerDue();
+}
+
 void ESPEasy_Scheduler::setEcoMode(bool enabled) {
   msecTimerHandler.setEcoMode(enabled);
 }
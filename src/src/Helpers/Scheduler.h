@@ -17,6 +17,7 @@
 
 #include <list>
 #include <map>
+#include <vector>
 
 
 
@@ -102,12 +103,16 @@ public:
   \*********************************************************************************************/
   void                 handle_schedule();
 
+  // Check whether a scheduled timer is waiting to be processed.
+  bool                 hasScheduledTimerDue() const;
+
   /*********************************************************************************************\
   * Interval Timer
   * These timers set a new scheduled timer, based on the old value.
   * This will make their interval as constant as possible.
   \*********************************************************************************************/
-  void                 setNextTimeInterval(unsigned long     & timer,
+  // Return true when the interval was restarted, as more than 1 full interval was missed.
+  bool                 setNextTimeInterval(unsigned long     & timer,
                                            const unsigned long step);
 
   void                 setNextStrictTimeInterval(unsigned long     & timer,
@@ -172,6 +177,18 @@ void                 setPluginTaskTimer(unsigned long msecFromNow,
 
   bool resume_rules_timer(unsigned long timerIndex);
 
+  // Highest rules timer index which may be active, to iterate over all rules timers.
+  unsigned int getRulesTimerIndexMax() const;
+
+  // Get the state of a rules timer.
+  // @param msecRemaining  Time left until the timer fires next, or the remainder when paused.
+  // @retval false when the timer is not set.
+  bool getRulesTimerState(unsigned int   timerIndex,
+                          unsigned long& msecRemaining,
+                          unsigned long& interval,
+                          int          & loopCount,
+                          bool         & paused) const;
+
 
   /*********************************************************************************************\
   * Plugin Timer  (PLUGIN_DEVICETIMER_IN)
@@ -241,8 +258,10 @@ void                 setPluginTaskTimer(unsigned long msecFromNow,
                                         struct EventStruct&& event);
 
 #if FEATURE_MQTT
+  // valueMask: Task value indices subscribed to the topic, set as Par1
   void schedule_mqtt_plugin_import_event_timer(deviceIndex_t DeviceIndex,
                                                taskIndex_t   TaskIndex,
+                                               uint8_t       valueMask,
                                                uint8_t       Function,
                                                char         *c_topic,
                                                uint8_t      *b_payload,
@@ -298,10 +317,19 @@ void                 setPluginTaskTimer(unsigned long msecFromNow,
 
 private:
 
+  // Key to collect lateness statistics per timer type,
+  // per task for task device timers and per interval timer.
+  static uint32_t getLatenessStatsKey(SchedulerTimerID timerID);
+
   // Map mixed timer ID to system timer struct.
   // N.B. Must use Mixed timer ID, similar to how it is handled in the scheduler.
   std::map<unsigned long, systemTimerStruct>systemTimers;
 
+  // Rules timers, indexed by timer index - 1.
+  // Only grows up to the highest timer index used, as typically only the first few are used.
+  // A timer is not set when its timer index is 0.
+  std::vector<systemTimerStruct>rulesTimers;
+
   msecTimerHandlerStruct msecTimerHandler;
 
   std::list<EventStructCommandWrapper>ScheduledEventQueue;
@@ -2,6 +2,7 @@
 
 #include "../DataStructs/PinMode.h"
 #include "../DataStructs/Scheduler_GPIOTimerID.h"
+#include "../DataStructs/TimingStats.h"
 
 #include "../ESPEasyCore/ESPEasyGPIO.h"
 
@@ -92,7 +93,10 @@ void ESPEasy_Scheduler::process_gpio_timer(SchedulerTimerID timerID, unsigned lo
     it->second.markNextRecurring();
 
     unsigned long newTimer = lasttimer;
-    setNextTimeInterval(newTimer, it->second.getInterval());
+
+    if (setNextTimeInterval(newTimer, it->second.getInterval())) {
+      ADD_SCHEDULER_RESYNC(getLatenessStatsKey(timerID));
+    }
     setNewTimerAt(timerID, newTimer);
   }
 
@@ -6,9 +6,11 @@
 #include "../ControllerQueue/DelayQueueElements.h"
 
 #include "../DataStructs/Scheduler_ConstIntervalTimerID.h"
+#include "../DataStructs/TimingStats.h"
 
 #include "../Globals/Settings.h"
 
+#include "../Helpers/ControllerQueueTask.h"
 #include "../Helpers/ESPEasy_time_calc.h"
 #include "../Helpers/Networking.h"
 #include "../Helpers/PeriodicalActions.h"
@@ -24,23 +26,24 @@
 // For example running the PLUGIN_FIFTY_PER_SECOND calls probably need to run as fast as possible as they need to fetch data before a buffer
 // overflow happens.
 // For those it is more important to actually run it than keeping pace.
-void ESPEasy_Scheduler::setNextTimeInterval(unsigned long& timer, const unsigned long step) {
+bool ESPEasy_Scheduler::setNextTimeInterval(unsigned long& timer, const unsigned long step) {
   timer += step;
   const long passed = timePassedSince(timer);
 
   if (passed < 0) {
     // Event has not yet happened, which is fine.
-    return;
+    return false;
   }
 
   if (static_cast<unsigned long>(passed) > step) {
     // No need to keep running behind, start again.
     timer = millis() + step;
-    return;
+    return true;
   }
 
   // Try to get in sync again.
   timer = millis() + (step - passed);
+  return false;
 }
 
 // More strict interval where no time drift is more important than missing a scheduled interval.
@@ -81,6 +84,17 @@ void ESPEasy_Scheduler::setIntervalTimerOverride(SchedulerIntervalTimer_e interv
 }
 
 void ESPEasy_Scheduler::scheduleNextDelayQueue(SchedulerIntervalTimer_e intervalTimer, unsigned long nextTime) {
+#if FEATURE_CONTROLLER_QUEUE_TASK
+
+  if (controllerQueueTask_handlesQueue(intervalTimer)) {
+    // The controller queue task does keep track of the schedule itself.
+    if (nextTime != 0) {
+      controllerQueueTask_notify();
+    }
+    return;
+  }
+#endif // if FEATURE_CONTROLLER_QUEUE_TASK
+
   if (nextTime != 0) {
     // Schedule for next process run.
     setIntervalTimerAt(intervalTimer, nextTime);
@@ -133,10 +147,12 @@ void ESPEasy_Scheduler::setIntervalTimer(SchedulerIntervalTimer_e intervalTimer,
       interval = 1000; break;
   }
   unsigned long timer = lasttimer;
-
-  setNextTimeInterval(timer, interval);
   const ConstIntervalTimerID timerID(intervalTimer);
 
+  if (setNextTimeInterval(timer, interval)) {
+    ADD_SCHEDULER_RESYNC(getLatenessStatsKey(timerID));
+  }
+
   setNewTimerAt(timerID, timer);
 }
 
@@ -156,16 +172,20 @@ void ESPEasy_Scheduler::process_interval_timer(SchedulerTimerID timerID, unsigne
   const ConstIntervalTimerID *tmp              = reinterpret_cast<const ConstIntervalTimerID *>(&timerID);
   const SchedulerIntervalTimer_e intervalTimer = tmp->getIntervalTimer();
 
+#if FEATURE_CONTROLLER_QUEUE_TASK
+
+  if (controllerQueueTask_handlesQueue(intervalTimer)) {
+    // Do not reschedule, this queue is processed by the controller queue task.
+    controllerQueueTask_notify();
+    return;
+  }
+#endif // if FEATURE_CONTROLLER_QUEUE_TASK
+
   setIntervalTimer(intervalTimer, lasttimer);
 
   switch (intervalTimer) {
     case SchedulerIntervalTimer_e::TIMER_20MSEC:         run50TimesPerSecond(); break;
-    case SchedulerIntervalTimer_e::TIMER_100MSEC:
-
-      if (!UseRTOSMultitasking) {
-        run10TimesPerSecond();
-      }
-      break;
+    case SchedulerIntervalTimer_e::TIMER_100MSEC:        run10TimesPerSecond(); break;
     case SchedulerIntervalTimer_e::TIMER_1SEC:             runOncePerSecond();      break;
     case SchedulerIntervalTimer_e::TIMER_30SEC:            runEach30Seconds();      break;
     case SchedulerIntervalTimer_e::TIMER_MQTT:
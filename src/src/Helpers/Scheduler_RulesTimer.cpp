@@ -2,6 +2,7 @@
 
 
 #include "../DataStructs/Scheduler_RulesTimerID.h"
+#include "../DataStructs/TimingStats.h"
 
 #include "../ESPEasyCore/ESPEasyRules.h"
 
@@ -30,40 +31,52 @@ bool ESPEasy_Scheduler::setRulesTimer(unsigned long msecFromNow, unsigned int ti
 
   const RulesTimerID timerID(timerIndex);
 
-  const systemTimerStruct timer_data(recurringCount, msecFromNow, timerIndex);
+  if (msecFromNow == 0) {
+    // Clear the timer
+    addLog(LOG_LEVEL_INFO, F("TIMER: disable timer"));
 
-  systemTimers[timerID.mixed_id] = timer_data;
+    if (timerIndex <= rulesTimers.size()) {
+      rulesTimers[timerIndex - 1] = systemTimerStruct();
+    }
+    msecTimerHandler.remove(timerID.mixed_id);
+    return true;
+  }
+
+  if (timerIndex > rulesTimers.size()) {
+    rulesTimers.resize(timerIndex);
+  }
+  rulesTimers[timerIndex - 1] = systemTimerStruct(recurringCount, msecFromNow, timerIndex);
   setNewTimerAt(timerID, millis() + msecFromNow);
   return true;
 }
 
 void ESPEasy_Scheduler::process_rules_timer(SchedulerTimerID id, unsigned long lasttimer) {
-  auto it = systemTimers.find(id.mixed_id);
+  const unsigned int timerIndex = id.id;
 
-  if (it == systemTimers.end()) { return; }
+  if ((timerIndex == 0) || (timerIndex > rulesTimers.size())) { return; }
 
-  if (it->second.isPaused()) {
-    // Timer is paused.
-    // Must keep this timer 'active' in the scheduler.
-    // However it does not need to be looked at frequently as the resume function re-schedules it when needed.
-    // Look for its state every second.
-    setNewTimerAt(id, millis() + 1000);
+  systemTimerStruct& timer = rulesTimers[timerIndex - 1];
+
+  if ((timer.getTimerIndex() == 0) || timer.isPaused()) {
+    // Not set, or paused and thus rescheduled when resumed.
     return;
   }
 
-  // Create a deep copy of the timer data as we may delete it from the map before sending the event.
-  const int loopCount  = it->second.getLoopCount();
-  const int timerIndex = it->second.getTimerIndex();
+  // Create a deep copy of the timer data as it may be cleared before sending the event.
+  const int loopCount = timer.getLoopCount();
 
   // Reschedule before sending the event, as it may get rescheduled in handling the timer event.
-  if (it->second.isRecurring()) {
+  if (timer.isRecurring()) {
     // Recurring timer
     unsigned long newTimer = lasttimer;
-    setNextTimeInterval(newTimer, it->second.getInterval());
+
+    if (setNextTimeInterval(newTimer, timer.getInterval())) {
+      ADD_SCHEDULER_RESYNC(getLatenessStatsKey(id));
+    }
     setNewTimerAt(id, newTimer);
-    it->second.markNextRecurring();
+    timer.markNextRecurring();
   } else {
-    systemTimers.erase(id.mixed_id);
+    timer = systemTimerStruct();
   }
 
   if (loopCount > 0) {
@@ -82,27 +95,29 @@ void ESPEasy_Scheduler::process_rules_timer(SchedulerTimerID id, unsigned long l
 
 bool ESPEasy_Scheduler::pause_rules_timer(unsigned long timerIndex) {
   if (!checkRulesTimerIndex(timerIndex)) { return false; }
-  const RulesTimerID timerID(timerIndex);
-  auto it = systemTimers.find(timerID.mixed_id);
 
-  if (it == systemTimers.end()) {
+  if ((timerIndex > rulesTimers.size()) || (rulesTimers[timerIndex - 1].getTimerIndex() == 0)) {
     addLog(LOG_LEVEL_INFO, F("TIMER: no timer set"));
     return false;
   }
+  systemTimerStruct& timer = rulesTimers[timerIndex - 1];
 
-  unsigned long timer;
+  if (timer.isPaused()) {
+    addLog(LOG_LEVEL_INFO, F("TIMER: already paused"));
+    return false;
+  }
+  const RulesTimerID timerID(timerIndex);
+  unsigned long timer_msec;
 
-  if (msecTimerHandler.getTimerForId(timerID.mixed_id, timer)) {
-    if (it->second.isPaused()) {
-      addLog(LOG_LEVEL_INFO, F("TIMER: already paused"));
-    } else {
-      // Store remainder of interval
-      const long timeLeft = timePassedSince(timer) * -1;
+  if (msecTimerHandler.getTimerForId(timerID.mixed_id, timer_msec)) {
+    // Store remainder of interval
+    const long timeLeft = timePassedSince(timer_msec) * -1;
 
-      if (timeLeft > 0) {
-        it->second.setRemainder(timeLeft);
-        return true;
-      }
+    if (timeLeft > 0) {
+      // A paused timer does not need to be in the scheduler, resume will reschedule it.
+      timer.setRemainder(timeLeft);
+      msecTimerHandler.remove(timerID.mixed_id);
+      return true;
     }
   }
   return false;
@@ -110,20 +125,48 @@ bool ESPEasy_Scheduler::pause_rules_timer(unsigned long timerIndex) {
 
 bool ESPEasy_Scheduler::resume_rules_timer(unsigned long timerIndex) {
   if (!checkRulesTimerIndex(timerIndex)) { return false; }
-  const RulesTimerID timerID(timerIndex);
-  auto it = systemTimers.find(timerID.mixed_id);
 
-  if (it == systemTimers.end()) { return false; }
+  if (timerIndex > rulesTimers.size()) { return false; }
+  systemTimerStruct& timer = rulesTimers[timerIndex - 1];
 
-  unsigned long timer;
+  if ((timer.getTimerIndex() == 0) || !timer.isPaused()) { return false; }
 
-  if (msecTimerHandler.getTimerForId(timerID.mixed_id, timer)) {
-    if (it->second.isPaused()) {
-      // Reschedule timer with remainder of interval
-      setNewTimerAt(timerID, millis() + it->second.getRemainder());
-      it->second.setRemainder(0);
-      return true;
-    }
+  // Reschedule timer with remainder of interval
+  setNewTimerAt(RulesTimerID(timerIndex), millis() + timer.getRemainder());
+  timer.setRemainder(0);
+  return true;
+}
+
+unsigned int ESPEasy_Scheduler::getRulesTimerIndexMax() const {
+  return rulesTimers.size();
+}
+
+bool ESPEasy_Scheduler::getRulesTimerState(unsigned int   timerIndex,
+                                           unsigned long& msecRemaining,
+                                           unsigned long& interval,
+                                           int          & loopCount,
+                                           bool         & paused) const
+{
+  if ((timerIndex == 0) || (timerIndex > rulesTimers.size())) { return false; }
+  const systemTimerStruct& timer = rulesTimers[timerIndex - 1];
+
+  if (timer.getTimerIndex() == 0) { return false; }
+
+  interval  = timer.getInterval();
+  loopCount = timer.getLoopCount();
+  paused    = timer.isPaused();
+
+  if (paused) {
+    msecRemaining = timer.getRemainder();
+    return true;
   }
-  return false;
+  unsigned long timer_msec = 0;
+
+  if (!msecTimerHandler.getTimerForId(RulesTimerID(timerIndex).mixed_id, timer_msec)) {
+    return false;
+  }
+  const long timeLeft = timePassedSince(timer_msec) * -1;
+
+  msecRemaining = (timeLeft > 0) ? timeLeft : 0;
+  return true;
 }
@@ -35,6 +35,7 @@ void ESPEasy_Scheduler::schedule_plugin_task_event_timer(
 void ESPEasy_Scheduler::schedule_mqtt_plugin_import_event_timer(
   deviceIndex_t DeviceIndex,
   taskIndex_t   TaskIndex,
+  uint8_t       valueMask,
   uint8_t       Function,
   char         *c_topic,
   uint8_t      *b_payload,
@@ -43,6 +44,8 @@ void ESPEasy_Scheduler::schedule_mqtt_plugin_import_event_timer(
     EventStruct  event(TaskIndex);
     const size_t topic_length = strlen_P(c_topic);
 
+    event.Par1 = valueMask;
+
     if (!(event.String1.reserve(topic_length) &&
           event.String2.reserve(length))) {
       addLog(LOG_LEVEL_ERROR, F("MQTT : Out of Memory! Cannot process MQTT message"));
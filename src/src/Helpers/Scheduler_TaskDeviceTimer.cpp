@@ -4,8 +4,10 @@
 #include "../DataStructs/Scheduler_TaskDeviceTimerID.h"
 #include "../DataStructs/TimingStats.h"
 #include "../ESPEasyCore/Controller.h"
+#include "../Globals/Plugins.h"
 #include "../Globals/Settings.h"
 #include "../Helpers/DeepSleep.h"
+#include "../Helpers/Hardware.h"
 
 /*********************************************************************************************\
 * Task Device Timer
@@ -70,11 +72,90 @@ void ESPEasy_Scheduler::schedule_task_device_timer(unsigned long task_index, uns
   }
 }
 
+#if FEATURE_ALIGNED_READ_GROUP
+
+/*********************************************************************************************\
+* Aligned read group
+* Enabled tasks with the same read group and the same interval are read back to back
+* by the task with the lowest index, the group leader.
+* Members are ordered by I2C multiplexer channel and the clock speed is only changed when needed during this batch.
+\*********************************************************************************************/
+static bool isAlignedReadGroupMember(taskIndex_t task_index, uint8_t group, unsigned long interval) {
+  return Settings.TaskDeviceEnabled[task_index] &&
+         (Settings.getTaskReadGroup(task_index) == group) &&
+         (Settings.TaskDeviceTimer[task_index] == interval);
+}
+
+static taskIndex_t getAlignedReadGroupLeader(taskIndex_t task_index) {
+  if (!validTaskIndex(task_index)) { return INVALID_TASK_INDEX; }
+  const uint8_t group          = Settings.getTaskReadGroup(task_index);
+  const unsigned long interval = Settings.TaskDeviceTimer[task_index];
+
+  if ((group == 0) || (interval == 0)) { return INVALID_TASK_INDEX; }
+
+  for (taskIndex_t task = 0; task <= task_index; ++task) {
+    if (isAlignedReadGroupMember(task, group, interval)) {
+      return task;
+    }
+  }
+  return INVALID_TASK_INDEX;
+}
+
+static void process_aligned_read_group(taskIndex_t leader, unsigned long lasttimer) {
+  const uint8_t group          = Settings.getTaskReadGroup(leader);
+  const unsigned long interval = Settings.TaskDeviceTimer[leader];
+
+  taskIndex_t members[TASKS_MAX];
+  uint8_t     nrMembers = 0;
+
+  for (taskIndex_t task = leader; task < TASKS_MAX; ++task) {
+    if ((task == leader) || isAlignedReadGroupMember(task, group, interval)) {
+      members[nrMembers++] = task;
+    }
+  }
+
+  #if FEATURE_I2CMULTIPLEXER
+
+  if (isI2CMultiplexerEnabled()) {
+    // Order by multiplexer channel, so each channel is selected only once.
+    // Insertion sort keeps the task order per channel.
+    for (uint8_t i = 1; i < nrMembers; ++i) {
+      const taskIndex_t task = members[i];
+      const uint8_t     sel  = I2CMultiplexerGetTaskSelection(task);
+      uint8_t j              = i;
+
+      while (j > 0 && I2CMultiplexerGetTaskSelection(members[j - 1]) > sel) {
+        members[j] = members[j - 1];
+        --j;
+      }
+      members[j] = task;
+    }
+  }
+  #endif // if FEATURE_I2CMULTIPLEXER
+
+  for (uint8_t i = 0; i < nrMembers; ++i) {
+    // Same lasttimer for all, so the members stay aligned with the leader
+    struct EventStruct TempEvent(members[i]);
+    SensorSendTask(&TempEvent, 0, lasttimer);
+  }
+}
+
+#endif // if FEATURE_ALIGNED_READ_GROUP
+
 void ESPEasy_Scheduler::reschedule_task_device_timer(unsigned long task_index, unsigned long lasttimer) {
   if (!validTaskIndex(task_index)) { return; }
   unsigned long newtimer = Settings.TaskDeviceTimer[task_index];
 
   if (newtimer != 0) {
+    #if FEATURE_ALIGNED_READ_GROUP
+    const taskIndex_t leader = getAlignedReadGroupLeader(task_index);
+
+    if (validTaskIndex(leader) && (leader != task_index)) {
+      // The leader reads this task and pushes this timer forward on every read.
+      // Timer only runs out when the leader no longer reads the group, e.g. when disabled.
+      newtimer *= 2;
+    }
+    #endif // if FEATURE_ALIGNED_READ_GROUP
     newtimer = lasttimer + (newtimer * 1000);
     schedule_task_device_timer(task_index, newtimer);
   }
@@ -86,6 +167,14 @@ void ESPEasy_Scheduler::process_task_device_timer(SchedulerTimerID timerID, unsi
 
   if (!validTaskIndex(task_index)) { return; }
   START_TIMER;
+  #if FEATURE_ALIGNED_READ_GROUP
+
+  if (getAlignedReadGroupLeader(task_index) == task_index) {
+    process_aligned_read_group(task_index, lasttimer);
+    STOP_TIMER(SENSOR_SEND_TASK);
+    return;
+  }
+  #endif // if FEATURE_ALIGNED_READ_GROUP
   struct EventStruct TempEvent(task_index);
 
   SensorSendTask(&TempEvent, 0, lasttimer);
@@ -2,31 +2,19 @@
 
 #include "../Helpers/Memory.h"
 
-void SerialWriteBuffer_t::add(const String& line)
+SerialWriteBuffer_t::~SerialWriteBuffer_t()
 {
-  // When the buffer is too full, try to dump at least the size of what we try to add.
-  const bool mustPop = _buffer.size() > _maxSize;
-  {
-    #ifdef USE_SECOND_HEAP
-
-    // Allow to store the logs in 2nd heap if present.
-    HeapSelectIram ephemeral;
-    #endif // ifdef USE_SECOND_HEAP
-    int roomLeft = getRoomLeft();
-
-    auto it = line.begin();
-
-    while (roomLeft > 0 && it != line.end()) {
-      if (mustPop) {
-        _buffer.pop_front();
-      }
-      _buffer.push_back(*it);
-      --roomLeft;
-      ++it;
-    }
+  if (_buffer != nullptr) {
+    buffer_free(MemoryBufferClass_e::LogBuffer, _buffer, _maxSize);
+    _buffer = nullptr;
   }
 }
 
+void SerialWriteBuffer_t::add(const String& line)
+{
+  add(reinterpret_cast<const uint8_t *>(line.c_str()), line.length());
+}
+
 void SerialWriteBuffer_t::add(const __FlashStringHelper *line)
 {
   add(String(line));
@@ -34,71 +22,114 @@ void SerialWriteBuffer_t::add(const __FlashStringHelper *line)
 
 void SerialWriteBuffer_t::add(char c)
 {
-  if (_buffer.size() > _maxSize) {
-    _buffer.pop_front();
-  }
-  _buffer.push_back(c);
+  add(reinterpret_cast<const uint8_t *>(&c), 1);
 }
 
 void SerialWriteBuffer_t::addNewline()
 {
-  add('\r');
-  add('\n');
+  add(reinterpret_cast<const uint8_t *>("\r\n"), 2);
 }
 
 void SerialWriteBuffer_t::clear()
 {
-  _buffer.clear();
+  _readPos = 0;
+  _used    = 0;
 }
 
 int SerialWriteBuffer_t::availableForWrite() const
 {
-  return _buffer.size();
+  return _used;
 }
 
 size_t SerialWriteBuffer_t::write(Stream& stream, size_t nrBytesToWrite)
 {
-  size_t bytesWritten     = 0;
-  const size_t bufferSize = _buffer.size();
+  size_t bytesWritten = 0;
 
-  if (bufferSize == 0) {
-    return bytesWritten;
+  if (nrBytesToWrite > _used) {
+    nrBytesToWrite = _used;
   }
 
-  if (nrBytesToWrite > 0) {
-    if (nrBytesToWrite > bufferSize) {
-      nrBytesToWrite = bufferSize;
+  // At most 2 spans: up to the end of the buffer and from the start of the buffer.
+  while (nrBytesToWrite > 0) {
+    size_t spanSize = _maxSize - _readPos;
+
+    if (spanSize > nrBytesToWrite) {
+      spanSize = nrBytesToWrite;
+    }
+    const size_t written = stream.write(_buffer + _readPos, spanSize);
+
+    if (written > spanSize) {
+      // Should not happen, but do not corrupt the buffer administration.
+      break;
     }
 
-    while (nrBytesToWrite > 0 && !_buffer.empty()) {
-      const char c = _buffer.front();
+    _readPos += written;
 
-      if (stream.write((uint8_t)c) == 0) {
-        return bytesWritten;
-      }
-      _buffer.pop_front();
-      --nrBytesToWrite;
-      ++bytesWritten;
+    if (_readPos >= _maxSize) {
+      _readPos = 0;
     }
+    _used          -= written;
+    nrBytesToWrite -= written;
+    bytesWritten   += written;
+
+    if (written < spanSize) {
+      // Stream cannot accept more
+      break;
+    }
+  }
+
+  if (_used == 0) {
+    // Keep the data contiguous as long as possible.
+    _readPos = 0;
   }
   return bytesWritten;
 }
 
-int SerialWriteBuffer_t::getRoomLeft() const {
-  #ifdef USE_SECOND_HEAP
+bool SerialWriteBuffer_t::allocate()
+{
+  if (_buffer != nullptr) {
+    return true;
+  }
 
-  // If stored in 2nd heap, we must check this for space
-  HeapSelectIram ephemeral;
-  #endif // ifdef USE_SECOND_HEAP
+  if (_maxSize == 0) {
+    return false;
+  }
+  _buffer = static_cast<uint8_t *>(buffer_calloc(MemoryBufferClass_e::LogBuffer, 1, _maxSize));
+  clear();
+  return _buffer != nullptr;
+}
 
-  int roomLeft = getMaxFreeBlock();
+void SerialWriteBuffer_t::add(const uint8_t *data, size_t length)
+{
+  if ((length == 0) || !allocate()) {
+    return;
+  }
 
-  if (roomLeft < 1000) {
-    roomLeft = 0;                    // Do not append to buffer.
-  } else if (roomLeft < 4000) {
-    roomLeft = 128 - _buffer.size(); // 1 buffer.
-  } else {
-    roomLeft -= 4000;                // leave some free for normal use.
+  if (length > _maxSize) {
+    // Only keep the last part
+    data  += length - _maxSize;
+    length = _maxSize;
+  }
+
+  if ((_used + length) > _maxSize) {
+    // Drop the oldest data
+    const size_t drop = _used + length - _maxSize;
+    _readPos = (_readPos + drop) % _maxSize;
+    _used   -= drop;
+  }
+
+  size_t writePos = (_readPos + _used) % _maxSize;
+
+  while (length > 0) {
+    size_t spanSize = _maxSize - writePos;
+
+    if (spanSize > length) {
+      spanSize = length;
+    }
+    memcpy(_buffer + writePos, data, spanSize);
+    data    += spanSize;
+    length  -= spanSize;
+    _used   += spanSize;
+    writePos = 0;
   }
-  return roomLeft;
 }
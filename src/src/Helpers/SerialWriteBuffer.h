@@ -3,8 +3,6 @@
 
 #include "../../ESPEasy_common.h"
 
-#include <deque>
-
 #ifndef MAX_SERIALWRITEBUFFER_SIZE
 # ifdef ESP8266
 #  define MAX_SERIALWRITEBUFFER_SIZE 1024
@@ -14,12 +12,24 @@
 # endif // ifdef ESP32
 #endif // ifndef MAX_SERIALWRITEBUFFER_SIZE
 
+/*********************************************************************************************\
+* SerialWriteBuffer_t
+* Fixed size ring buffer for console output.
+* The buffer is allocated on first use, so an unused console port does not take any memory.
+* When full, the oldest data is dropped to make room for the new data.
+* Data is handed to the stream in bulk, at most 2 write calls when the data wraps around.
+\*********************************************************************************************/
 class SerialWriteBuffer_t {
 public:
 
   SerialWriteBuffer_t(size_t maxSize = MAX_SERIALWRITEBUFFER_SIZE)
     : _maxSize(maxSize) {}
 
+  ~SerialWriteBuffer_t();
+
+  SerialWriteBuffer_t(const SerialWriteBuffer_t&)            = delete;
+  SerialWriteBuffer_t& operator=(const SerialWriteBuffer_t&) = delete;
+
   void   add(const String& line);
   void   add(const __FlashStringHelper *line);
   void   add(char c);
@@ -28,7 +38,7 @@ public:
 
   void   clear();
 
-
+  // Nr of bytes waiting to be written
   int    availableForWrite() const;
 
   size_t write(Stream& stream,
@@ -36,10 +46,15 @@ public:
 
 private:
 
-  int getRoomLeft() const;
+  bool   allocate();
+
+  void   add(const uint8_t *data,
+             size_t         length);
 
-  std::deque<char>_buffer;
-  size_t _maxSize = MAX_SERIALWRITEBUFFER_SIZE;
+  uint8_t *_buffer  = nullptr;
+  size_t   _maxSize = MAX_SERIALWRITEBUFFER_SIZE;
+  size_t   _readPos = 0;
+  size_t   _used    = 0;
 };
 
 #endif // ifndef HELPERS_SERIALWRITEBUFFER_H
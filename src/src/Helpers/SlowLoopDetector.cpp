@@ -0,0 +1,173 @@
+#include "../Helpers/SlowLoopDetector.h"
+
+#if FEATURE_SLOW_LOOP_DETECTOR
+
+# include "../DataStructs/SchedulerTimerID.h"
+# include "../DataStructs/TimingStats.h"
+# include "../ESPEasyCore/ESPEasy_Log.h"
+# include "../Globals/ESPEasy_Scheduler.h"
+# include "../Globals/ESPEasy_time.h"
+# include "../Globals/RTC.h"
+# include "../Helpers/StringConverter.h"
+
+# define SLOW_LOOP_MARKER  0x510770F5
+
+struct SlowLoopStore_t {
+  SlowLoopIncident_t incidents[SLOW_LOOP_NR_INCIDENTS];
+  uint32_t           marker;
+  uint8_t            nrIncidents;
+  uint8_t            next; // Index where the next incident will be stored
+};
+
+# ifdef ESP32
+RTC_NOINIT_ATTR SlowLoopStore_t slowLoopStore;
+# else // ifdef ESP32
+static SlowLoopStore_t slowLoopStore;
+# endif // ifdef ESP32
+
+// Context of the running loop
+static SlowLoopIncident_t slowLoopCurrent;
+static uint32_t slowLoopCount = 0;
+
+void SlowLoopIncident_t::clear()
+{
+  memset(this, 0, sizeof(SlowLoopIncident_t));
+  taskIndex = 0xFF;
+}
+
+static void SlowLoop_checkStore()
+{
+  if ((slowLoopStore.marker != SLOW_LOOP_MARKER) ||
+      (slowLoopStore.nrIncidents > SLOW_LOOP_NR_INCIDENTS) ||
+      (slowLoopStore.next >= SLOW_LOOP_NR_INCIDENTS)) {
+    memset(&slowLoopStore, 0, sizeof(SlowLoopStore_t));
+    slowLoopStore.marker = SLOW_LOOP_MARKER;
+  }
+}
+
+static void SlowLoop_copyString(char *dest, const String& str)
+{
+  // Keep the start, which is the most descriptive part of an event or URI
+  strncpy(dest, str.c_str(), SLOW_LOOP_STRING_LENGTH - 1);
+  dest[SLOW_LOOP_STRING_LENGTH - 1] = 0;
+}
+
+void SlowLoop_loopDone(int64_t duration_usec)
+{
+  if (duration_usec > SLOW_LOOP_THRESHOLD_USEC) {
+    SlowLoop_checkStore();
+    ++slowLoopCount;
+
+    SlowLoopIncident_t& incident = slowLoopStore.incidents[slowLoopStore.next];
+    incident               = slowLoopCurrent;
+    incident.unixTime      = node_time.systemTimePresent() ? node_time.getUnixTime() : 0;
+    incident.uptime_msec   = millis();
+    incident.bootCounter   = RTC.bootCounter;
+    incident.duration_usec = (duration_usec < 0xFFFFFFFF) ? duration_usec : 0xFFFFFFFF;
+
+    slowLoopStore.next = (slowLoopStore.next + 1) % SLOW_LOOP_NR_INCIDENTS;
+
+    if (slowLoopStore.nrIncidents < SLOW_LOOP_NR_INCIDENTS) {
+      ++slowLoopStore.nrIncidents;
+    }
+
+    if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+      addLogMove(LOG_LEVEL_INFO, strformat(
+                   F("LOOP : Slow loop %d ms: %s"),
+                   static_cast<int>(incident.duration_usec / 1000),
+                   SlowLoop_describe(incident).c_str()));
+    }
+  }
+  slowLoopCurrent.clear();
+}
+
+void SlowLoop_scheduler(uint32_t mixed_id)
+{
+  slowLoopCurrent.schedulerId = mixed_id;
+}
+
+void SlowLoop_pluginCall(taskIndex_t taskIndex, uint8_t function, uint32_t duration_usec)
+{
+  if ((slowLoopCurrent.taskIndex == 0xFF) || (duration_usec > slowLoopCurrent.pluginDuration_usec)) {
+    slowLoopCurrent.taskIndex           = validTaskIndex(taskIndex) ? taskIndex : 0xFF;
+    slowLoopCurrent.function            = function;
+    slowLoopCurrent.pluginDuration_usec = duration_usec;
+  }
+}
+
+void SlowLoop_rulesEvent(const String& event, uint32_t duration_usec)
+{
+  const uint16_t duration_msec = (duration_usec / 1000 < 0xFFFF) ? duration_usec / 1000 : 0xFFFF;
+
+  if ((slowLoopCurrent.rulesEvent[0] == 0) || (duration_msec >= slowLoopCurrent.rulesDuration_msec)) {
+    SlowLoop_copyString(slowLoopCurrent.rulesEvent, event);
+    slowLoopCurrent.rulesDuration_msec = duration_msec;
+  }
+}
+
+void SlowLoop_webRequest(const String& uri)
+{
+  SlowLoop_copyString(slowLoopCurrent.webURI, uri);
+}
+
+uint32_t SlowLoop_getCount()
+{
+  return slowLoopCount;
+}
+
+uint8_t SlowLoop_getNrIncidents()
+{
+  SlowLoop_checkStore();
+  return slowLoopStore.nrIncidents;
+}
+
+const SlowLoopIncident_t* SlowLoop_getIncident(uint8_t index)
+{
+  if (index >= SlowLoop_getNrIncidents()) {
+    return nullptr;
+  }
+  const uint8_t pos = (slowLoopStore.next + SLOW_LOOP_NR_INCIDENTS - 1 - index) % SLOW_LOOP_NR_INCIDENTS;
+
+  return &slowLoopStore.incidents[pos];
+}
+
+String SlowLoop_describe(const SlowLoopIncident_t& incident)
+{
+  String res;
+
+  if (incident.schedulerId != 0) {
+    res += F("Scheduler: ");
+    res += ESPEasy_Scheduler::decodeSchedulerId(SchedulerTimerID(incident.schedulerId));
+  }
+
+  if (incident.taskIndex != 0xFF) {
+    if (!res.isEmpty()) { res += F(", "); }
+    res += strformat(F("Task %d "), incident.taskIndex + 1);
+    # if FEATURE_TIMING_STATS
+    res += getPluginFunctionName(incident.function);
+    # else // if FEATURE_TIMING_STATS
+    res += concat(F("function "), incident.function);
+    # endif // if FEATURE_TIMING_STATS
+    res += strformat(F(" (%d ms)"), static_cast<int>(incident.pluginDuration_usec / 1000));
+  }
+
+  if (incident.rulesEvent[0] != 0) {
+    if (!res.isEmpty()) { res += F(", "); }
+    res += F("Event: ");
+    res += incident.rulesEvent;
+    res += strformat(F(" (%d ms)"), incident.rulesDuration_msec);
+  }
+
+  if (incident.webURI[0] != 0) {
+    if (!res.isEmpty()) { res += F(", "); }
+    res += F("URI: ");
+    res += incident.webURI;
+  }
+
+  if (res.isEmpty()) {
+    res = F("Unknown");
+  }
+  return res;
+}
+
+#endif // if FEATURE_SLOW_LOOP_DETECTOR
@@ -0,0 +1,79 @@
+#ifndef HELPERS_SLOWLOOPDETECTOR_H
+#define HELPERS_SLOWLOOPDETECTOR_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_SLOW_LOOP_DETECTOR
+
+# include "../DataTypes/TaskIndex.h"
+
+// Loop duration above which the loop is considered slow
+# ifndef SLOW_LOOP_THRESHOLD_USEC
+#  define SLOW_LOOP_THRESHOLD_USEC  500000
+# endif // ifndef SLOW_LOOP_THRESHOLD_USEC
+
+// Nr of incidents kept, the oldest is replaced when full
+# ifndef SLOW_LOOP_NR_INCIDENTS
+#  define SLOW_LOOP_NR_INCIDENTS    4
+# endif // ifndef SLOW_LOOP_NR_INCIDENTS
+
+# define SLOW_LOOP_STRING_LENGTH    24
+
+// No default member initializers, as it is kept in RTC memory on ESP32 and may not be
+// cleared by a constructor at boot.
+struct SlowLoopIncident_t {
+  void     clear();
+
+  uint32_t unixTime;            // 0 when the time was not set
+  uint32_t uptime_msec;
+  uint32_t bootCounter;
+  uint32_t duration_usec;       // Duration of the loop
+  uint32_t schedulerId;         // Mixed scheduler ID of the timer run in the loop, 0 = none
+  uint32_t pluginDuration_usec; // Duration of the slowest plugin call in the loop
+  uint8_t  taskIndex;           // Task of the slowest plugin call, 0xFF = none
+  uint8_t  function;
+  uint16_t rulesDuration_msec;  // Duration of the slowest rules event in the loop
+  char     rulesEvent[SLOW_LOOP_STRING_LENGTH]; // Slowest rules event in the loop
+  char     webURI[SLOW_LOOP_STRING_LENGTH];     // Slowest web request in the loop
+};
+
+/*********************************************************************************************\
+* Slow loop detector
+* The subsystems report what they ran during a loop, keeping only the slowest plugin call,
+* rules event and web request. When the loop took longer than SLOW_LOOP_THRESHOLD_USEC,
+* this context is kept as an incident.
+*
+* On ESP32 the incidents are kept in RTC memory, so they are still available after a
+* watchdog reset. The ESP8266 RTC user memory is completely in use, so there they are only kept in RAM.
+\*********************************************************************************************/
+
+// Called at the start of each loop with the duration of the previous loop.
+void                      SlowLoop_loopDone(int64_t duration_usec);
+
+void                      SlowLoop_scheduler(uint32_t mixed_id);
+
+void                      SlowLoop_pluginCall(taskIndex_t taskIndex,
+                                              uint8_t     function,
+                                              uint32_t    duration_usec);
+
+void                      SlowLoop_rulesEvent(const String& event,
+                                              uint32_t      duration_usec);
+
+// Only one web request is handled per loop, so no need to keep the slowest.
+void                      SlowLoop_webRequest(const String& uri);
+
+// Nr of slow loops since boot
+uint32_t                  SlowLoop_getCount();
+
+// Nr of kept incidents
+uint8_t                   SlowLoop_getNrIncidents();
+
+// Get incident by index, 0 is the most recent.
+const SlowLoopIncident_t* SlowLoop_getIncident(uint8_t index);
+
+// Human readable description of what ran in the loop
+String                    SlowLoop_describe(const SlowLoopIncident_t& incident);
+
+#endif // if FEATURE_SLOW_LOOP_DETECTOR
+
+#endif // ifndef HELPERS_SLOWLOOPDETECTOR_H
@@ -3,6 +3,7 @@
 
 #include "../../_Plugin_Helper.h"
 
+#include "../DataStructs/CommandArguments.h"
 #include "../DataStructs/ESPEasy_EventStruct.h"
 #include "../DataStructs/TimingStats.h"
 
@@ -19,6 +20,7 @@
 
 #include "../Helpers/Convert.h"
 #include "../Helpers/ESPEasy_Storage.h"
+#include "../Helpers/FormattedTaskValues.h"
 #include "../Helpers/Misc.h"
 #include "../Helpers/Networking.h"
 #include "../Helpers/Numerical.h"
@@ -355,8 +357,21 @@ void replaceUnicodeByChar(String& line, char replChar) {
 /*********************************************************************************************\
    Format a value to the set number of decimals
 \*********************************************************************************************/
+static String doFormatUserVar_uncached(struct EventStruct *event, uint8_t rel_index, bool mustCheck, bool& isvalid);
+
 String doFormatUserVar(struct EventStruct *event, uint8_t rel_index, bool mustCheck, bool& isvalid) {
   if (event == nullptr) return EMPTY_STRING;
+  String res;
+
+  if (FormattedTaskValuesScope::get(event, rel_index, mustCheck, res, isvalid)) {
+    return res;
+  }
+  res = doFormatUserVar_uncached(event, rel_index, mustCheck, isvalid);
+  FormattedTaskValuesScope::set(event, rel_index, mustCheck, res, isvalid);
+  return res;
+}
+
+static String doFormatUserVar_uncached(struct EventStruct *event, uint8_t rel_index, bool mustCheck, bool& isvalid) {
   START_TIMER;
   isvalid = true;
 
@@ -733,6 +748,12 @@ String to_internal_string(const String& input, char replaceSpace) {
     // FIXME TD-er: parseString* should use index starting at 0.
 \*********************************************************************************************/
 String parseString(const char * string, uint8_t indexFind, char separator, bool trimResult) {
+  const CommandArguments *arguments = CommandArguments::find(string, separator);
+
+  if (arguments != nullptr) {
+    // Keep using the same line buffer, so its argument positions can be used.
+    return parseString(arguments->line(), indexFind, separator, trimResult);
+  }
   return parseString(String(string), indexFind, separator, trimResult);
 }
 
@@ -808,6 +829,11 @@ String tolerantParseStringKeepCase(const char * string,
                                    char         separator,
                                    bool         trimResult)
 {
+  const CommandArguments *arguments = CommandArguments::find(string, separator);
+
+  if (arguments != nullptr) {
+    return tolerantParseStringKeepCase(arguments->line(), indexFind, separator, trimResult);
+  }
   return tolerantParseStringKeepCase(String(string), indexFind, separator, trimResult);
 }
 
@@ -981,19 +1007,26 @@ int GetCommandCode(char* destination, size_t destination_size, const char* needl
 
 
 // escapes special characters in strings for use in html-forms
-bool htmlEscapeChar(char c, String& esc)
+const __FlashStringHelper* htmlEscapeCharSequence(char c)
 {
-  const __FlashStringHelper * escaped = F("");
   switch (c)
   {
-    case '&':  escaped = F("&amp;");  break;
-    case '\"': escaped = F("&quot;"); break;
-    case '\'': escaped = F("&#039;"); break;
-    case '<':  escaped = F("&lt;");   break;
-    case '>':  escaped = F("&gt;");   break;
-    case '/':  escaped = F("&#047;"); break;
-    default:
-      return false;
+    case '&':  return F("&amp;");
+    case '\"': return F("&quot;");
+    case '\'': return F("&#039;");
+    case '<':  return F("&lt;");
+    case '>':  return F("&gt;");
+    case '/':  return F("&#047;");
+  }
+  return nullptr;
+}
+
+bool htmlEscapeChar(char c, String& esc)
+{
+  const __FlashStringHelper * escaped = htmlEscapeCharSequence(c);
+
+  if (escaped == nullptr) {
+    return false;
   }
 
   esc = String(escaped);  
@@ -1178,6 +1211,12 @@ void parseSpecialCharacters(String& s, bool useURLencode)
    replace other system variables like %sysname%, %systime%, %ip%
  \*********************************************************************************************/
 void parseControllerVariables(String& s, struct EventStruct *event, bool useURLencode) {
+  #if FEATURE_TEMPLATE_CACHE
+
+  if (Cache.templateCache.parseControllerVariables(s, event, useURLencode)) {
+    return;
+  }
+  #endif // if FEATURE_TEMPLATE_CACHE
   s = parseTemplate(s, useURLencode);
   parseEventVariables(s, event, useURLencode);
 }
@@ -1389,11 +1428,15 @@ bool GetArgv(const char *string, String& argvString, unsigned int argc, char sep
   return true;
 }
 
-bool GetArgvBeginEnd(const char *string, const unsigned int argc, int& pos_begin, int& pos_end, char separator) {
-  pos_begin = -1;
-  pos_end   = -1;
-  size_t string_len = strlen(string);
-  unsigned int string_pos = 0, argc_pos = 0;
+// Scan the arguments of the string.
+// onArgument(argc, pos_begin, pos_end) is called for each argument found, argc = 1 => command.
+// Scanning stops when onArgument returns true.
+template<typename F>
+static bool scanArgv(const char *string, char separator, F onArgument) {
+  int    pos_begin         = -1;
+  int    pos_end           = -1;
+  size_t string_len        = strlen(string);
+  unsigned int string_pos  = 0, argc_pos = 0;
   bool parenthesis          = false;
   char matching_parenthesis = '"';
 
@@ -1444,7 +1487,7 @@ bool GetArgvBeginEnd(const char *string, const unsigned int argc, int& pos_begin
       if (!parenthesis && (isParameterSeparatorChar(d) || (d == separator) || (d == 0))) // end of word
       {
         argc_pos++;
-        if (argc_pos == argc)
+        if (onArgument(argc_pos, pos_begin, pos_end))
         {
           return true;
         }
@@ -1457,3 +1500,37 @@ bool GetArgvBeginEnd(const char *string, const unsigned int argc, int& pos_begin
   }
   return false;
 }
+
+bool GetArgvBeginEnd(const char *string, const unsigned int argc, int& pos_begin, int& pos_end, char separator) {
+  const CommandArguments *arguments = CommandArguments::find(string, separator);
+
+  if (arguments != nullptr) {
+    return arguments->getBeginEnd(argc, pos_begin, pos_end);
+  }
+  pos_begin = -1;
+  pos_end   = -1;
+
+  return scanArgv(string, separator, [&](unsigned int argc_pos, int begin, int end) {
+    if (argc_pos != argc) {
+      return false;
+    }
+    pos_begin = begin;
+    pos_end   = end;
+    return true;
+  });
+}
+
+uint8_t GetArgvPositions(const char *string, int16_t *pos_begin, int16_t *pos_end, uint8_t maxArguments, bool& complete, char separator) {
+  uint8_t count = 0;
+
+  complete = !scanArgv(string, separator, [&](unsigned int argc_pos, int begin, int end) {
+    if ((count >= maxArguments) || (end > INT16_MAX)) {
+      return true; // Stop, does not fit
+    }
+    pos_begin[count] = begin;
+    pos_end[count]   = end;
+    ++count;
+    return false;
+  });
+  return count;
+}
@@ -320,6 +320,9 @@ int GetCommandCode(char* destination, size_t destination_size, const char* needl
 
 
 // escapes special characters in strings for use in html-forms
+// @retval The escape sequence, or nullptr when the character does not need to be escaped.
+const __FlashStringHelper* htmlEscapeCharSequence(char c);
+
 bool   htmlEscapeChar(char    c,
                       String& esc);
 
@@ -420,5 +423,15 @@ bool GetArgvBeginEnd(const char        *string,
                      int              & pos_end,
                      char               separator = ',');
 
+// Get the begin and end positions of all arguments in a single scan.
+// complete is false when there are more than maxArguments arguments, or the string is too long.
+// Return the nr of arguments stored.
+uint8_t GetArgvPositions(const char *string,
+                         int16_t    *pos_begin,
+                         int16_t    *pos_end,
+                         uint8_t     maxArguments,
+                         bool      & complete,
+                         char        separator = ',');
+
 
 #endif // HELPERS_STRINGCONVERTER_H
@@ -2,6 +2,8 @@
 
 #include "../Helpers/Numerical.h"
 
+#include <cmath>
+
 /********************************************************************************************\
    Convert a char string to integer
  \*********************************************************************************************/
@@ -16,11 +18,105 @@ unsigned long str2int(const char *string)
   return static_cast<unsigned long>(temp);
 }
 
+/*********************************************************************************************\
+   Format a value with a fixed number of decimals into a caller provided buffer.
+\*********************************************************************************************/
+size_t formatFixedDecimals(char        *buf,
+                           size_t       bufSize,
+                           double       value,
+                           unsigned int decimalPlaces,
+                           bool         trimTrailingZeros_b)
+{
+  if ((buf == nullptr) ||
+      (decimalPlaces > FORMAT_FIXED_DECIMALS_MAX_DECIMALS) ||
+      !isfinite(value)) {
+    return 0;
+  }
+
+  static const uint32_t powersOf10[FORMAT_FIXED_DECIMALS_MAX_DECIMALS + 1] = {
+    1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u, 1000000000u
+  };
+
+  const bool   negative = std::signbit(value);
+  const double absValue = negative ? -value : value;
+  const double factor   = powersOf10[decimalPlaces];
+  const double scaled   = absValue * factor;
+
+  // Only values which can be represented exactly as integer in a double.
+  if (scaled >= 4503599627370496.0) { // 2^52
+    return 0;
+  }
+
+  // Round to nearest, ties to even, just like printf("%.*f") does.
+  // The error of the multiplication is computed exactly, to detect ties correctly.
+  const double intPart = floor(scaled);
+  const double frac    = scaled - intPart;
+  uint64_t     fixed   = static_cast<uint64_t>(intPart);
+
+  if (frac > 0.5) {
+    ++fixed;
+  } else if (frac == 0.5) {
+    const double error = fma(absValue, factor, -scaled);
+
+    if ((error > 0.0) || ((error == 0.0) && ((fixed & 1) != 0))) {
+      ++fixed;
+    }
+  }
+
+  // Write the digits backwards, starting with the decimals
+  char   tmp[FORMAT_FIXED_DECIMALS_BUFFER_SIZE];
+  size_t pos      = sizeof(tmp);
+  size_t decimals = decimalPlaces;
+
+  if (trimTrailingZeros_b) {
+    while ((decimals > 0) && ((fixed % 10) == 0)) {
+      fixed /= 10;
+      --decimals;
+    }
+  }
+
+  for (size_t i = 0; i < decimals; ++i) {
+    tmp[--pos] = '0' + (fixed % 10);
+    fixed     /= 10;
+  }
+
+  if (decimals > 0) {
+    tmp[--pos] = '.';
+  }
+
+  do {
+    tmp[--pos] = '0' + (fixed % 10);
+    fixed     /= 10;
+  } while (fixed > 0);
+
+  if (negative) {
+    tmp[--pos] = '-';
+  }
+
+  const size_t length = sizeof(tmp) - pos;
+
+  if (length >= bufSize) {
+    return 0;
+  }
+  memcpy(buf, &tmp[pos], length);
+  buf[length] = '\0';
+  return length;
+}
+
 /*********************************************************************************************\
    Workaround for removing trailing white space when String() converts a float with 0 decimals
 \*********************************************************************************************/
 String toString(const float& value, unsigned int decimalPlaces)
 {
+  {
+    char buf[FORMAT_FIXED_DECIMALS_BUFFER_SIZE];
+
+    if (formatFixedDecimals(buf, sizeof(buf), value, decimalPlaces) != 0) {
+      return String(buf);
+    }
+  }
+
+  // Fallback for values which cannot be formatted using formatFixedDecimals()
   /*
   #ifndef LIMIT_BUILD_SIZE
 
@@ -129,6 +225,15 @@ String toStringNoZero(int64_t value) {
 
 #if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
 String doubleToString(const double& value, unsigned int decimalPlaces, bool trimTrailingZeros_b) {
+  {
+    char buf[FORMAT_FIXED_DECIMALS_BUFFER_SIZE];
+
+    if (formatFixedDecimals(buf, sizeof(buf), value, decimalPlaces, trimTrailingZeros_b) != 0) {
+      return String(buf);
+    }
+  }
+
+  // Fallback for values which cannot be formatted using formatFixedDecimals()
   // This has been fixed in ESP32 code, not (yet) in ESP8266 code
   // https://github.com/espressif/arduino-esp32/pull/6138/files
   //  #ifdef ESP8266
@@ -164,6 +269,13 @@ String floatToString(const float& value,
                       unsigned int  decimalPlaces,
                       bool          trimTrailingZeros_b)
 {
+  {
+    char buf[FORMAT_FIXED_DECIMALS_BUFFER_SIZE];
+
+    if (formatFixedDecimals(buf, sizeof(buf), value, decimalPlaces, trimTrailingZeros_b) != 0) {
+      return String(buf);
+    }
+  }
   const String res = toString(value, decimalPlaces);
 
   if (trimTrailingZeros_b) {
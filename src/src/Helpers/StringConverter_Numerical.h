@@ -16,6 +16,26 @@ unsigned long str2int(const char *string);
 bool          string2float(const String& string,
                            float       & floatvalue);
 
+/*********************************************************************************************\
+   Format a value with a fixed number of decimals into a caller provided buffer.
+   Uses integer arithmetic and does not allocate memory on the heap.
+   Return the number of characters written, excluding the terminating zero.
+   Return 0 when the value cannot be formatted this way (NaN, infinite, too large,
+   too many decimals or buffer too small), the caller must then use a fallback.
+\*********************************************************************************************/
+
+// Buffer size which is large enough for any value formatFixedDecimals() can handle
+#define FORMAT_FIXED_DECIMALS_BUFFER_SIZE   32
+
+// Max. number of decimals formatFixedDecimals() can handle
+#define FORMAT_FIXED_DECIMALS_MAX_DECIMALS  9
+
+size_t formatFixedDecimals(char        *buf,
+                           size_t       bufSize,
+                           double       value,
+                           unsigned int decimalPlaces,
+                           bool         trimTrailingZeros = false);
+
 /*********************************************************************************************\
    Workaround for removing trailing white space when String() converts a float with 0 decimals
 \*********************************************************************************************/
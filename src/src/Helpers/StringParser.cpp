@@ -71,130 +71,7 @@ String parseTemplate_padded(String& tmpString, uint8_t minimal_lineSize, bool us
       // First copy all upto the start of the [...#...] part to be replaced.
       newString += tmpString.substring(lastStartpos, startpos);
 
-      // deviceName is lower case, so we can compare literal string (no need for equalsIgnoreCase)
-      const bool devNameEqInt = equals(deviceName, F("int"));
-      if (devNameEqInt || equals(deviceName, F("var")))
-      {
-        // Address an internal variable either as float or as int
-        // For example: Let,10,[VAR#9]
-        unsigned int varNum;
-
-        if (validUIntFromString(valueName, varNum)) {
-          unsigned char nr_decimals = maxNrDecimals_fpType(getCustomFloatVar(varNum));
-          bool trimTrailingZeros    = true;
-
-          if (devNameEqInt) {
-            nr_decimals = 0;
-          } else if (!format.isEmpty())
-          {
-            // There is some formatting here, so do not throw away decimals
-            trimTrailingZeros = false;
-          }
-          #if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
-          String value = doubleToString(getCustomFloatVar(varNum), nr_decimals, trimTrailingZeros);
-          #else
-          String value = floatToString(getCustomFloatVar(varNum), nr_decimals, trimTrailingZeros);
-          #endif
-          transformValue(
-            newString, 
-            minimal_lineSize, 
-            std::move(value), 
-            format, 
-            tmpString);
-        }
-      }
-      else if (equals(deviceName, F("plugin")))
-      {
-        // Handle a plugin request.
-        // For example: "[Plugin#GPIO#Pinstate#N]"
-        // The command is stored in valueName & format
-        String command;
-        command.reserve(valueName.length() + format.length() + 1);
-        command  = valueName;
-        command += '#';
-        command += format;
-        command.replace('#', ',');
-
-        if (getGPIOPinStateValues(command)) {
-          newString += command;
-        }
-  /* @giig1967g
-        if (PluginCall(PLUGIN_REQUEST, 0, command))
-        {
-          // Do not call transformValue here.
-          // The "format" is not empty so must not call the formatter function.
-          newString += command;
-        }
-  */
-      }
-      else
-      {
-        // Address a value from a plugin.
-        // For example: "[bme#temp]"
-        // If value name is unknown, run a PLUGIN_GET_CONFIG_VALUE command.
-        // For example: "[<taskname>#getLevel]"
-        taskIndex_t taskIndex = findTaskIndexByName(deviceName, true); // Check for enabled/disabled is done separately
-
-        if (validTaskIndex(taskIndex)) {
-          bool isHandled = false;
-          if (Settings.TaskDeviceEnabled[taskIndex]) {
-            uint8_t valueNr = findDeviceValueIndexByName(valueName, taskIndex);
-
-            if (valueNr != VARS_PER_TASK) {
-              // here we know the task and value, so find the uservar
-              // Try to format and transform the values
-              bool   isvalid;
-              String value = formatUserVar(taskIndex, valueNr, isvalid);
-
-              if (isvalid) {
-                transformValue(newString, minimal_lineSize, std::move(value), format, tmpString);
-                isHandled = true;
-              }
-            } else {
-              // try if this is a get config request
-              struct EventStruct TempEvent(taskIndex);
-              String tmpName = valueName;
-
-              if (PluginCall(PLUGIN_GET_CONFIG_VALUE, &TempEvent, tmpName))
-              {
-                transformValue(newString, minimal_lineSize, std::move(tmpName), format, tmpString);
-                isHandled = true;
-              }
-            }
-          }
-          if (!isHandled && valueName.startsWith(F("settings."))) {  // Task settings values
-            String value;
-            if (valueName.endsWith(F(".enabled"))) {           // Task state
-              value = Settings.TaskDeviceEnabled[taskIndex] ? '1' : '0';
-            } else if (valueName.endsWith(F(".interval"))) {   // Task interval
-              value = Settings.TaskDeviceTimer[taskIndex];
-            } else if (valueName.endsWith(F(".valuecount"))) { // Task value count
-              value = getValueCountForTask(taskIndex);
-            } else if ((valueName.indexOf(F(".controller")) == 8) && valueName.length() >= 20) { // Task controller values
-              String ctrl = valueName.substring(19, 20);
-              int ctrlNr = 0;
-              if (validIntFromString(ctrl, ctrlNr) && (ctrlNr >= 1) && (ctrlNr <= CONTROLLER_MAX) && 
-                  Settings.ControllerEnabled[ctrlNr - 1]) { // Controller nr. valid and enabled
-                if (valueName.endsWith(F(".enabled"))) {    // Task-controller enabled
-                  value = Settings.TaskDeviceSendData[ctrlNr - 1][taskIndex];
-                } else if (valueName.endsWith(F(".idx"))) { // Task-controller idx value
-                  protocolIndex_t ProtocolIndex = getProtocolIndex_from_ControllerIndex(ctrlNr - 1);
-
-                  if (validProtocolIndex(ProtocolIndex) && 
-                      getProtocolStruct(ProtocolIndex).usesID && (Settings.Protocol[ctrlNr - 1] != 0)) {
-                    value = Settings.TaskDeviceID[ctrlNr - 1][taskIndex];
-                  }
-                }
-              }
-            }
-            if (!value.isEmpty()) {
-              transformValue(newString, minimal_lineSize, std::move(value), format, tmpString);
-              // isHandled = true;
-            }
-          }
-        }
-      }
-
+      parseTemplate_replaceMarker(newString, minimal_lineSize, deviceName, valueName, format, tmpString);
 
       // Conversion is done (or impossible) for the found "[...#...]"
       // Continue with the next one.
@@ -235,6 +112,138 @@ String parseTemplate_padded(String& tmpString, uint8_t minimal_lineSize, bool us
   return newString;
 }
 
+void parseTemplate_replaceMarker(String      & newString,
+                                 uint8_t       minimal_lineSize,
+                                 const String& deviceName,
+                                 const String& valueName,
+                                 String      & format,
+                                 const String& tmpString)
+{
+  // deviceName is lower case, so we can compare literal string (no need for equalsIgnoreCase)
+  const bool devNameEqInt = equals(deviceName, F("int"));
+  if (devNameEqInt || equals(deviceName, F("var")))
+  {
+    // Address an internal variable either as float or as int
+    // For example: Let,10,[VAR#9]
+    unsigned int varNum;
+
+    if (validUIntFromString(valueName, varNum)) {
+      unsigned char nr_decimals = maxNrDecimals_fpType(getCustomFloatVar(varNum));
+      bool trimTrailingZeros    = true;
+
+      if (devNameEqInt) {
+        nr_decimals = 0;
+      } else if (!format.isEmpty())
+      {
+        // There is some formatting here, so do not throw away decimals
+        trimTrailingZeros = false;
+      }
+      #if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+      String value = doubleToString(getCustomFloatVar(varNum), nr_decimals, trimTrailingZeros);
+      #else
+      String value = floatToString(getCustomFloatVar(varNum), nr_decimals, trimTrailingZeros);
+      #endif
+      transformValue(
+        newString, 
+        minimal_lineSize, 
+        std::move(value), 
+        format, 
+        tmpString);
+    }
+  }
+  else if (equals(deviceName, F("plugin")))
+  {
+    // Handle a plugin request.
+    // For example: "[Plugin#GPIO#Pinstate#N]"
+    // The command is stored in valueName & format
+    String command;
+    command.reserve(valueName.length() + format.length() + 1);
+    command  = valueName;
+    command += '#';
+    command += format;
+    command.replace('#', ',');
+
+    if (getGPIOPinStateValues(command)) {
+      newString += command;
+    }
+  /* @giig1967g
+    if (PluginCall(PLUGIN_REQUEST, 0, command))
+    {
+      // Do not call transformValue here.
+      // The "format" is not empty so must not call the formatter function.
+      newString += command;
+    }
+  */
+  }
+  else
+  {
+    // Address a value from a plugin.
+    // For example: "[bme#temp]"
+    // If value name is unknown, run a PLUGIN_GET_CONFIG_VALUE command.
+    // For example: "[<taskname>#getLevel]"
+    taskIndex_t taskIndex = findTaskIndexByName(deviceName, true); // Check for enabled/disabled is done separately
+
+    if (validTaskIndex(taskIndex)) {
+      bool isHandled = false;
+      if (Settings.TaskDeviceEnabled[taskIndex]) {
+        uint8_t valueNr = findDeviceValueIndexByName(valueName, taskIndex);
+
+        if (valueNr != VARS_PER_TASK) {
+          // here we know the task and value, so find the uservar
+          // Try to format and transform the values
+          bool   isvalid;
+          String value = formatUserVar(taskIndex, valueNr, isvalid);
+
+          if (isvalid) {
+            transformValue(newString, minimal_lineSize, std::move(value), format, tmpString);
+            isHandled = true;
+          }
+        } else {
+          // try if this is a get config request
+          struct EventStruct TempEvent(taskIndex);
+          String tmpName = valueName;
+
+          if (PluginCall(PLUGIN_GET_CONFIG_VALUE, &TempEvent, tmpName))
+          {
+            transformValue(newString, minimal_lineSize, std::move(tmpName), format, tmpString);
+            isHandled = true;
+          }
+        }
+      }
+      if (!isHandled && valueName.startsWith(F("settings."))) {  // Task settings values
+        String value;
+        if (valueName.endsWith(F(".enabled"))) {           // Task state
+          value = Settings.TaskDeviceEnabled[taskIndex] ? '1' : '0';
+        } else if (valueName.endsWith(F(".interval"))) {   // Task interval
+          value = Settings.TaskDeviceTimer[taskIndex];
+        } else if (valueName.endsWith(F(".valuecount"))) { // Task value count
+          value = getValueCountForTask(taskIndex);
+        } else if ((valueName.indexOf(F(".controller")) == 8) && valueName.length() >= 20) { // Task controller values
+          String ctrl = valueName.substring(19, 20);
+          int ctrlNr = 0;
+          if (validIntFromString(ctrl, ctrlNr) && (ctrlNr >= 1) && (ctrlNr <= CONTROLLER_MAX) && 
+              Settings.ControllerEnabled[ctrlNr - 1]) { // Controller nr. valid and enabled
+            if (valueName.endsWith(F(".enabled"))) {    // Task-controller enabled
+              value = Settings.TaskDeviceSendData[ctrlNr - 1][taskIndex];
+            } else if (valueName.endsWith(F(".idx"))) { // Task-controller idx value
+              protocolIndex_t ProtocolIndex = getProtocolIndex_from_ControllerIndex(ctrlNr - 1);
+
+              if (validProtocolIndex(ProtocolIndex) && 
+                  getProtocolStruct(ProtocolIndex).usesID && (Settings.Protocol[ctrlNr - 1] != 0)) {
+                value = Settings.TaskDeviceID[ctrlNr - 1][taskIndex];
+              }
+            }
+          }
+        }
+        if (!value.isEmpty()) {
+          transformValue(newString, minimal_lineSize, std::move(value), format, tmpString);
+          // isHandled = true;
+        }
+      }
+    }
+  }
+}
+
 /********************************************************************************************\
    Transform values
  \*********************************************************************************************/
@@ -611,39 +620,35 @@ void transformValue(
 
 // Find the first (enabled) task with given name
 // Return INVALID_TASK_INDEX when not found, else return taskIndex
-taskIndex_t findTaskIndexByName(String deviceName, bool allowDisabled)
+taskIndex_t findTaskIndexByName(const String& deviceName, bool allowDisabled)
 {
-  deviceName.toLowerCase();
   // cache this, since LoadTaskSettings does take some time.
-  #ifdef USE_SECOND_HEAP
-  HeapSelectDram ephemeral;
-  auto result = Cache.taskIndexName.find(String(deviceName));
-  #else
-  auto result = Cache.taskIndexName.find(deviceName);
-  #endif
-
+  // Key is a case insensitive hash, so no lower case copy of the name is needed.
+  if (deviceName.isEmpty()) {
+    return INVALID_TASK_INDEX;
+  }
+  const uint32_t key = Caches::taskNameHash(deviceName);
+  auto result        = Cache.taskIndexName.find(key);
 
   if (result != Cache.taskIndexName.end()) {
-    return result->second;
+    // Check for hash collision
+    if (Cache.matchTaskDeviceName(result->second, deviceName, key)) {
+      return result->second;
+    }
   }
 
   for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; taskIndex++)
   {
     if (Settings.TaskDeviceEnabled[taskIndex] || allowDisabled) {
-      String taskDeviceName = getTaskDeviceName(taskIndex);
-
-      if (!taskDeviceName.isEmpty())
+      // Use entered taskDeviceName can have any case, so compare case insensitive.
+      // The cached names have a precomputed hash, so most names are rejected without comparing.
+      if (Cache.matchTaskDeviceName(taskIndex, deviceName, key))
       {
-        // Use entered taskDeviceName can have any case, so compare case insensitive.
-        if (deviceName.equalsIgnoreCase(taskDeviceName))
-        {
-          #ifdef USE_SECOND_HEAP
-          Cache.taskIndexName[String(deviceName)] = taskIndex;
-          #else
-          Cache.taskIndexName[deviceName] = taskIndex;
-          #endif
-          return taskIndex;
-        }
+        #ifdef USE_SECOND_HEAP
+        HeapSelectDram ephemeral;
+        #endif // ifdef USE_SECOND_HEAP
+        Cache.taskIndexName[key] = taskIndex;
+        return taskIndex;
       }
     }
   }
@@ -658,26 +663,20 @@ uint8_t findDeviceValueIndexByName(const String& valueName, taskIndex_t taskInde
 
   if (!validDeviceIndex(deviceIndex)) { return VARS_PER_TASK; }
 
-  #ifdef USE_SECOND_HEAP
-  HeapSelectDram ephemeral;
-  #endif
-
-
   // cache this, since LoadTaskSettings does take some time.
   // We need to use a cache search key including the taskIndex,
   // to allow several tasks to have the same value names.
-  String cache_valueName;
-
-  cache_valueName.reserve(valueName.length() + 4);
-  cache_valueName  = valueName;
-  cache_valueName += '#';        // The '#' cannot exist in a value name, use it in the cache key.
-  cache_valueName += taskIndex;
-  cache_valueName.toLowerCase(); // No need to store multiple versions of the same entry with only different case.
-
-  auto result = Cache.taskIndexValueName.find(cache_valueName);
+  // Key is a case insensitive hash, so no lower case copy of the name is needed.
+  const uint32_t nameHash = Caches::taskNameHash(valueName);
+  const uint32_t key      = Caches::taskValueNameHash(nameHash, taskIndex);
+  auto result             = Cache.taskIndexValueName.find(key);
 
   if (result != Cache.taskIndexValueName.end()) {
-    return result->second;
+    // Check for hash collision
+    if ((result->second.taskIndex == taskIndex) &&
+        Cache.matchTaskDeviceValueName(taskIndex, result->second.valueNr, valueName, nameHash)) {
+      return result->second.valueNr;
+    }
   }
   const uint8_t valCount = getValueCountForTask(taskIndex);
 
@@ -686,7 +685,13 @@ uint8_t findDeviceValueIndexByName(const String& valueName, taskIndex_t taskInde
     // Check case insensitive, since the user entered value name can have any case.
     if (valueName.equalsIgnoreCase(getTaskValueName(taskIndex, valueNr)))
     {
-      Cache.taskIndexValueName[cache_valueName] = valueNr;
+      #ifdef USE_SECOND_HEAP
+      HeapSelectDram ephemeral;
+      #endif // ifdef USE_SECOND_HEAP
+      TaskIndexValueName_t entry;
+      entry.taskIndex = taskIndex;
+      entry.valueNr   = valueNr;
+      Cache.taskIndexValueName[key] = entry;
       return valueNr;
     }
   }
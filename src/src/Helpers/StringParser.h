@@ -20,6 +20,14 @@ String parseTemplate_padded(String& tmpString,
                             uint8_t    minimal_lineSize,
                             bool    useURLencode);
 
+// Append the value for a [deviceName#valueName#format] marker, as found by findNextDevValNameInString()
+void parseTemplate_replaceMarker(String      & newString,
+                                 uint8_t       minimal_lineSize,
+                                 const String& deviceName,
+                                 const String& valueName,
+                                 String      & format,
+                                 const String& tmpString);
+
 
 /********************************************************************************************\
    Transform values
@@ -38,8 +46,8 @@ void transformValue(
 
 // Find the first (enabled) task with given name
 // Return INVALID_TASK_INDEX when not found, else return taskIndex
-// deviceName is deepcopy to only store lower case version in cache.
-taskIndex_t findTaskIndexByName(String deviceName, bool allowDisabled = false);
+// Name is compared case insensitive, the cache uses a case insensitive hash of the name.
+taskIndex_t findTaskIndexByName(const String& deviceName, bool allowDisabled = false);
 
 // Find the first device value index of a taskIndex.
 // Return VARS_PER_TASK if none found.
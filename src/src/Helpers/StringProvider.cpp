@@ -15,10 +15,12 @@
 #endif
 
 #include "../Globals/Device.h"
+#include "../Globals/DNS_Cache.h"
 #include "../Globals/ESPEasy_Console.h"
 #include "../Globals/ESPEasy_Scheduler.h"
 #include "../Globals/ESPEasy_time.h"
 #include "../Globals/ESPEasyWiFiEvent.h"
+#include "../Globals/EventQueue.h"
 
 #if FEATURE_ETHERNET
 #include "../Globals/ESPEasyEthEvent.h"
@@ -42,6 +44,12 @@
 #include "../WebServer/JSON.h"
 #include "../WebServer/AccessControl.h"
 
+#if FEATURE_LABEL_VALUE_CACHE
+# include <map>
+
+static std::map<LabelType::Enum, String> labelValueCache;
+#endif // if FEATURE_LABEL_VALUE_CACHE
+
 
 String getInternalLabel(LabelType::Enum label, char replaceSpace) {
   return to_internal_string(getLabel(label), replaceSpace);
@@ -109,6 +117,13 @@ const __FlashStringHelper * getLabel(LabelType::Enum label) {
     case LabelType::ENABLE_TIMING_STATISTICS:   return F("Collect Timing Statistics");
 #endif
     case LabelType::ENABLE_RULES_CACHING:       return F("Enable Rules Cache");
+    case LabelType::ENABLE_RULES_EVENT_FILTER:  return F("Skip Unhandled Events");
+#if FEATURE_RULES_COMPILED
+    case LabelType::ENABLE_RULES_COMPILED:      return F("Enable Compiled Rules");
+#endif
+#if FEATURE_CONTROLLER_QUEUE_TASK
+    case LabelType::ENABLE_CONTROLLER_QUEUE_TASK: return F("Controller Queue Task");
+#endif
     case LabelType::ENABLE_SERIAL_PORT_CONSOLE: return F("Enable Serial Port Console");
     case LabelType::CONSOLE_SERIAL_PORT:        return F("Console Serial Port");
 #if USES_ESPEASY_CONSOLE_FALLBACK_PORT
@@ -157,7 +172,15 @@ const __FlashStringHelper * getLabel(LabelType::Enum label) {
     case LabelType::DNS:                    return F("DNS");
     case LabelType::DNS_1:                  return F("DNS 1");
     case LabelType::DNS_2:                  return F("DNS 2");
+    #if FEATURE_DNS_CACHE
+    case LabelType::DNS_CACHE_STATS:        return F("DNS Cache");
+    case LabelType::DNS_LOOKUP_TIME:        return F("DNS Lookup Time (avg / max)");
+    #endif // if FEATURE_DNS_CACHE
     case LabelType::ALLOWED_IP_RANGE:       return F("Allowed IP Range");
+    #if FEATURE_ESPEASY_P2P
+    case LabelType::P2P_UDP_STATS:          return F("p2p UDP Packets");
+    case LabelType::P2P_UDP_PROCESSING_TIME: return F("p2p UDP Max Processing Time");
+    #endif // if FEATURE_ESPEASY_P2P
     case LabelType::STA_MAC:                return F("STA MAC");
     case LabelType::AP_MAC:                 return F("AP MAC");
     case LabelType::SSID:                   return F("SSID");
@@ -197,6 +220,13 @@ const __FlashStringHelper * getLabel(LabelType::Enum label) {
     case LabelType::I2C_BUS_STATE:          return F("I2C Bus State");
     case LabelType::I2C_BUS_CLEARED_COUNT:  return F("I2C bus cleared count");
 
+    case LabelType::EVENT_QUEUE_OVERFLOW_POLICY: return F("Event Queue Overflow");
+    case LabelType::RULES_EVENT_BUDGET:     return F("Rules Event Budget");
+    case LabelType::EVENT_QUEUE_MAX_DEPTH:  return F("Event Queue Max Depth");
+    case LabelType::EVENT_QUEUE_DROPPED:    return F("Events Dropped");
+    case LabelType::EVENT_QUEUE_COALESCED:  return F("Events Coalesced");
+    case LabelType::EVENT_QUEUE_FILTERED:   return F("Events Skipped (No Rule)");
+
     case LabelType::SYSLOG_LOG_LEVEL:       return F("Syslog Log Level");
     case LabelType::SERIAL_LOG_LEVEL:       return F("Serial Log Level");
     case LabelType::WEB_LOG_LEVEL:          return F("Web Log Level");
@@ -272,7 +302,123 @@ const __FlashStringHelper * getLabel(LabelType::Enum label) {
   return F("MissingString");
 }
 
-String getValue(LabelType::Enum label) {
+LabelVolatility getLabelVolatility(LabelType::Enum label) {
+  switch (label)
+  {
+    case LabelType::BUILD_DESC:
+    case LabelType::GIT_BUILD:
+    case LabelType::SYSTEM_LIBRARIES:
+    case LabelType::PLUGIN_COUNT:
+    case LabelType::PLUGIN_DESCRIPTION:
+    case LabelType::BUILD_TIME:
+    case LabelType::BINARY_FILENAME:
+    case LabelType::BUILD_PLATFORM:
+    case LabelType::GIT_HEAD:
+    #ifdef CONFIGURATION_CODE
+    case LabelType::CONFIGURATION_CODE_LBL:
+    #endif // ifdef CONFIGURATION_CODE
+    case LabelType::RESET_REASON:
+    case LabelType::LAST_TASK_BEFORE_REBOOT:
+    case LabelType::ESP_CHIP_ID:
+#ifdef ESP32
+    case LabelType::ESP_CHIP_XTAL_FREQ:
+#endif
+    case LabelType::ESP_CHIP_MODEL:
+    case LabelType::ESP_CHIP_REVISION:
+    case LabelType::ESP_CHIP_CORES:
+    case LabelType::ESP_BOARD_NAME:
+    case LabelType::FLASH_CHIP_ID:
+    case LabelType::FLASH_CHIP_VENDOR:
+    case LabelType::FLASH_CHIP_MODEL:
+    case LabelType::FLASH_CHIP_REAL_SIZE:
+    case LabelType::FLASH_CHIP_SPEED:
+    case LabelType::FLASH_IDE_MODE:
+    case LabelType::FS_SIZE:
+#if defined(ESP32) && defined(BOARD_HAS_PSRAM)
+    case LabelType::PSRAM_SIZE:
+#endif
+      return LabelVolatility::Static;
+
+    #if FEATURE_ZEROFILLED_UNITNUMBER
+    case LabelType::UNIT_NR_0:
+    #endif // FEATURE_ZEROFILLED_UNITNUMBER
+    case LabelType::UNIT_NAME:
+    case LabelType::HOST_NAME:
+#if FEATURE_SET_WIFI_TX_PWR
+    case LabelType::WIFI_TX_MAX_PWR:
+#endif
+    case LabelType::CONSOLE_SERIAL_PORT:
+#if USES_ESPEASY_CONSOLE_FALLBACK_PORT
+    case LabelType::CONSOLE_FALLBACK_PORT:
+#endif
+    case LabelType::IP_CONFIG:
+    #if FEATURE_MDNS
+    case LabelType::M_DNS:
+    #endif // if FEATURE_MDNS
+    case LabelType::ALLOWED_IP_RANGE:
+    case LabelType::WIFI_STORED_SSID1:
+    case LabelType::WIFI_STORED_SSID2:
+    case LabelType::SYSLOG_LOG_LEVEL:
+  #if FEATURE_SD
+    case LabelType::SD_LOG_LEVEL:
+  #endif // if FEATURE_SD
+    case LabelType::LATITUDE:
+    case LabelType::LONGITUDE:
+      return LabelVolatility::Settings;
+
+    case LabelType::IP_ADDRESS:
+    case LabelType::IP_SUBNET:
+    case LabelType::IP_ADDRESS_SUBNET:
+    case LabelType::GATEWAY:
+    case LabelType::DNS:
+    case LabelType::DNS_1:
+    case LabelType::DNS_2:
+    case LabelType::STA_MAC:
+    case LabelType::AP_MAC:
+    case LabelType::SSID:
+    case LabelType::BSSID:
+    case LabelType::ENCRYPTION_TYPE_STA:
+#if FEATURE_ETHERNET
+    case LabelType::ETH_IP_ADDRESS:
+    case LabelType::ETH_IP_SUBNET:
+    case LabelType::ETH_IP_ADDRESS_SUBNET:
+    case LabelType::ETH_IP_GATEWAY:
+    case LabelType::ETH_IP_DNS:
+    case LabelType::ETH_MAC:
+#endif // if FEATURE_ETHERNET
+# if FEATURE_ETHERNET || defined(USES_ESPEASY_NOW)
+    case LabelType::ETH_WIFI_MODE:
+#endif
+      return LabelVolatility::Network;
+
+    default:
+      break;
+  }
+  return LabelVolatility::Live;
+}
+
+#if FEATURE_LABEL_VALUE_CACHE
+void clearLabelValueCache(LabelVolatility volatility) {
+  if (volatility == LabelVolatility::Static) {
+    labelValueCache.clear();
+    return;
+  }
+
+  for (auto it = labelValueCache.begin(); it != labelValueCache.end();) {
+    const LabelVolatility entryVolatility = getLabelVolatility(it->first);
+
+    if ((entryVolatility == LabelVolatility::Network) ||
+        (entryVolatility == volatility)) {
+      it = labelValueCache.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+#endif // if FEATURE_LABEL_VALUE_CACHE
+
+static String getValue_uncached(LabelType::Enum label) {
   int retval = INT_MAX;
   switch (label)
   {
@@ -370,6 +516,13 @@ String getValue(LabelType::Enum label) {
     case LabelType::ENABLE_TIMING_STATISTICS:   return jsonBool(Settings.EnableTimingStats());
 #endif
     case LabelType::ENABLE_RULES_CACHING:       return jsonBool(Settings.EnableRulesCaching());
+    case LabelType::ENABLE_RULES_EVENT_FILTER:  return jsonBool(Settings.EnableRulesEventFilter());
+#if FEATURE_RULES_COMPILED
+    case LabelType::ENABLE_RULES_COMPILED:      return jsonBool(Settings.EnableRulesCompiled());
+#endif
+#if FEATURE_CONTROLLER_QUEUE_TASK
+    case LabelType::ENABLE_CONTROLLER_QUEUE_TASK: return jsonBool(Settings.EnableControllerQueueTask());
+#endif
     case LabelType::ENABLE_SERIAL_PORT_CONSOLE: return jsonBool(Settings.UseSerial);
     case LabelType::CONSOLE_SERIAL_PORT:        return ESPEasy_Console.getPortDescription();
 
@@ -420,7 +573,32 @@ String getValue(LabelType::Enum label) {
     case LabelType::DNS:                    return getValue(LabelType::DNS_1) + F(" / ") + getValue(LabelType::DNS_2);
     case LabelType::DNS_1:                  return formatIP(NetworkDnsIP(0));
     case LabelType::DNS_2:                  return formatIP(NetworkDnsIP(1));
+    #if FEATURE_DNS_CACHE
+    case LabelType::DNS_CACHE_STATS:        return strformat(F("%u hits / %u misses / %u fallback"),
+                                                             static_cast<unsigned int>(DNScache.getHits()),
+                                                             static_cast<unsigned int>(DNScache.getMisses()),
+                                                             static_cast<unsigned int>(DNScache.getFallbacks()));
+    case LabelType::DNS_LOOKUP_TIME:        return strformat(F("%u / %u ms"),
+                                                             static_cast<unsigned int>(DNScache.getAverageLookupTime()),
+                                                             static_cast<unsigned int>(DNScache.getMaxLookupTime()));
+    #endif // if FEATURE_DNS_CACHE
     case LabelType::ALLOWED_IP_RANGE:       return describeAllowedIPrange();
+    #if FEATURE_ESPEASY_P2P
+    case LabelType::P2P_UDP_STATS:
+    case LabelType::P2P_UDP_PROCESSING_TIME:
+    {
+      uint32_t received, dropped, maxPacketsPerPass, maxProcessingTime_usec;
+      getUDPreceiveStats(received, dropped, maxPacketsPerPass, maxProcessingTime_usec);
+
+      if (label == LabelType::P2P_UDP_STATS) {
+        return strformat(F("%u received / %u dropped / max %u per call"),
+                         static_cast<unsigned int>(received),
+                         static_cast<unsigned int>(dropped),
+                         static_cast<unsigned int>(maxPacketsPerPass));
+      }
+      return strformat(F("%u usec"), static_cast<unsigned int>(maxProcessingTime_usec));
+    }
+    #endif // if FEATURE_ESPEASY_P2P
     case LabelType::STA_MAC:                return WifiSTAmacAddress().toString();
     case LabelType::AP_MAC:                 return WifiSoftAPmacAddress().toString();
     case LabelType::SSID:                   return WiFi.SSID();
@@ -479,6 +657,12 @@ String getValue(LabelType::Enum label) {
     #endif // ifdef CONFIGURATION_CODE
     case LabelType::I2C_BUS_STATE:          return toString(I2C_state);
     case LabelType::I2C_BUS_CLEARED_COUNT:  retval = I2C_bus_cleared_count; break;
+    case LabelType::EVENT_QUEUE_OVERFLOW_POLICY: return toString(Settings.EventQueueOverflowPolicy());
+    case LabelType::RULES_EVENT_BUDGET:     retval = Settings.getRulesEventBudget(); break;
+    case LabelType::EVENT_QUEUE_MAX_DEPTH:  retval = eventQueue.getMaxDepth(); break;
+    case LabelType::EVENT_QUEUE_DROPPED:    retval = eventQueue.getDroppedCount(); break;
+    case LabelType::EVENT_QUEUE_COALESCED:  retval = eventQueue.getCoalescedCount(); break;
+    case LabelType::EVENT_QUEUE_FILTERED:   retval = eventQueue.getFilteredCount(); break;
     case LabelType::SYSLOG_LOG_LEVEL:       return getLogLevelDisplayString(Settings.SyslogLevel);
     case LabelType::SERIAL_LOG_LEVEL:       return getLogLevelDisplayString(getSerialLogLevel());
     case LabelType::WEB_LOG_LEVEL:          return getLogLevelDisplayString(getWebLogLevel());
@@ -553,6 +737,23 @@ String getValue(LabelType::Enum label) {
   return F("MissingString");
 }
 
+String getValue(LabelType::Enum label) {
+#if FEATURE_LABEL_VALUE_CACHE
+
+  if (getLabelVolatility(label) != LabelVolatility::Live) {
+    auto it = labelValueCache.find(label);
+
+    if (it != labelValueCache.end()) {
+      return it->second;
+    }
+    String res = getValue_uncached(label);
+    labelValueCache[label] = res;
+    return res;
+  }
+#endif // if FEATURE_LABEL_VALUE_CACHE
+  return getValue_uncached(label);
+}
+
 #if FEATURE_ETHERNET
 String getEthSpeed() {
   String result;
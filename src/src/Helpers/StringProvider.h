@@ -63,6 +63,13 @@ struct LabelType {
     ENABLE_TIMING_STATISTICS,
 #endif
     ENABLE_RULES_CACHING,
+    ENABLE_RULES_EVENT_FILTER,
+#if FEATURE_RULES_COMPILED
+    ENABLE_RULES_COMPILED,
+#endif
+#if FEATURE_CONTROLLER_QUEUE_TASK
+    ENABLE_CONTROLLER_QUEUE_TASK,
+#endif
     ENABLE_SERIAL_PORT_CONSOLE,
     CONSOLE_SERIAL_PORT,
 #if USES_ESPEASY_CONSOLE_FALLBACK_PORT
@@ -109,7 +116,15 @@ struct LabelType {
     DNS,                     // 192.168.1.1 / (IP unset)
     DNS_1,
     DNS_2,
+    #if FEATURE_DNS_CACHE
+    DNS_CACHE_STATS,         // 120 hits / 4 misses / 0 fallback
+    DNS_LOOKUP_TIME,         // 35 / 240 ms
+    #endif // if FEATURE_DNS_CACHE
     ALLOWED_IP_RANGE,        // 192.168.1.0 - 192.168.1.255
+    #if FEATURE_ESPEASY_P2P
+    P2P_UDP_STATS,           // 1234 received / 2 dropped / max 5 per call
+    P2P_UDP_PROCESSING_TIME, // 3400 usec
+    #endif // if FEATURE_ESPEASY_P2P
     STA_MAC,                 // EC:FA:BC:0E:AE:5B
     AP_MAC,                  // EE:FA:BC:0E:AE:5B
     SSID,                    // mynetwork
@@ -149,6 +164,13 @@ struct LabelType {
     I2C_BUS_STATE,
     I2C_BUS_CLEARED_COUNT,
 
+    EVENT_QUEUE_OVERFLOW_POLICY,
+    RULES_EVENT_BUDGET,
+    EVENT_QUEUE_MAX_DEPTH,
+    EVENT_QUEUE_DROPPED,
+    EVENT_QUEUE_COALESCED,
+    EVENT_QUEUE_FILTERED,
+
     SYSLOG_LOG_LEVEL,
     SERIAL_LOG_LEVEL,
     WEB_LOG_LEVEL,
@@ -229,5 +251,24 @@ const __FlashStringHelper * getLabel(LabelType::Enum label);
 String getValue(LabelType::Enum label);
 String getExtendedValue(LabelType::Enum label);
 
+// How often the value of a label may change.
+// Only non trivial values are marked as cacheable, as a cache lookup of a jsonBool or int costs about the same.
+enum class LabelVolatility : uint8_t {
+  Live,     // Computed on every call
+  Static,   // Does not change after boot
+  Settings, // Only changes when settings are changed
+  Network   // Only changes on network (dis)connect events
+};
+
+LabelVolatility getLabelVolatility(LabelType::Enum label);
+
+#if FEATURE_LABEL_VALUE_CACHE
+
+// Clear the cached rendered values of the given volatility.
+// Settings also clears Network values, as these may depend on settings (e.g. static IP).
+// Static clears all cached values.
+void clearLabelValueCache(LabelVolatility volatility);
+#endif // if FEATURE_LABEL_VALUE_CACHE
+
 
 #endif // STRING_PROVIDER_TYPES_H
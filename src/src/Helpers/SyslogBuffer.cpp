@@ -0,0 +1,129 @@
+#include "../Helpers/SyslogBuffer.h"
+
+#if FEATURE_SYSLOG_BUFFER
+
+# include "../ESPEasyCore/ESPEasy_Log.h"
+# include "../Globals/Settings.h"
+# include "../Helpers/ESPEasy_time_calc.h"
+# include "../Helpers/Networking.h"
+# include "../Helpers/StringConverter.h"
+
+// Index of the rate limit and header per priority
+# define SYSLOG_PRIO_ERROR        0
+# define SYSLOG_PRIO_INFO         1
+# define SYSLOG_PRIO_DEBUG        2
+# define SYSLOG_NR_PRIOS          3
+
+# define SYSLOG_RATE_WINDOW       1000
+
+static String        syslog_batch;
+static unsigned long syslog_batchStart = 0;
+
+static String        syslog_headers[SYSLOG_NR_PRIOS];
+static uint16_t      syslog_nrLines[SYSLOG_NR_PRIOS]{};
+static unsigned long syslog_windowStart = 0;
+static uint32_t      syslog_droppedInWindow = 0;
+static uint32_t      syslog_droppedTotal    = 0;
+
+static uint8_t SyslogBuffer_getPrioIndex(uint8_t logLevel) {
+  if (logLevel == LOG_LEVEL_ERROR) {
+    return SYSLOG_PRIO_ERROR;
+  }
+
+  if (logLevel == LOG_LEVEL_INFO) {
+    return SYSLOG_PRIO_INFO;
+  }
+  return SYSLOG_PRIO_DEBUG;
+}
+
+static void SyslogBuffer_startWindow() {
+  syslog_windowStart = millis();
+
+  for (uint8_t i = 0; i < SYSLOG_NR_PRIOS; ++i) {
+    syslog_nrLines[i] = 0;
+
+    // Hostname or facility may have changed
+    syslog_headers[i] = String();
+  }
+}
+
+static const String& SyslogBuffer_getHeader(uint8_t logLevel) {
+  String& header = syslog_headers[SyslogBuffer_getPrioIndex(logLevel)];
+
+  if (header.isEmpty()) {
+    header = getSyslogHeader(logLevel);
+  }
+  return header;
+}
+
+static void SyslogBuffer_addLine(uint8_t logLevel, const String& message) {
+  const String& header = SyslogBuffer_getHeader(logLevel);
+
+  if (!Settings.SyslogBatchLines()) {
+    sendSyslogPacket(header, message);
+    return;
+  }
+
+  if (!syslog_batch.isEmpty() &&
+      ((syslog_batch.length() + 1 + header.length() + message.length()) > SYSLOG_BATCH_MAX_SIZE)) {
+    SyslogBuffer_flush();
+  }
+
+  if (syslog_batch.isEmpty()) {
+    syslog_batch.reserve(SYSLOG_BATCH_MAX_SIZE);
+    syslog_batchStart = millis();
+  } else {
+    syslog_batch += '\n';
+  }
+  syslog_batch += header;
+  syslog_batch += message;
+}
+
+void SyslogBuffer_add(uint8_t logLevel, const String& message) {
+  if ((syslog_windowStart == 0) || (timePassedSince(syslog_windowStart) >= SYSLOG_RATE_WINDOW)) {
+    SyslogBuffer_loop();
+  }
+  const uint8_t prioIndex = SyslogBuffer_getPrioIndex(logLevel);
+
+  if (prioIndex != SYSLOG_PRIO_ERROR) {
+    if (syslog_nrLines[prioIndex] >= SYSLOG_MAX_LINES_PER_SEC) {
+      ++syslog_droppedInWindow;
+      ++syslog_droppedTotal;
+      return;
+    }
+    ++syslog_nrLines[prioIndex];
+  }
+  SyslogBuffer_addLine(logLevel, message);
+}
+
+void SyslogBuffer_loop() {
+  if ((syslog_windowStart == 0) || (timePassedSince(syslog_windowStart) >= SYSLOG_RATE_WINDOW)) {
+    SyslogBuffer_startWindow();
+
+    if (syslog_droppedInWindow != 0) {
+      // Not subject to the rate limit
+      SyslogBuffer_addLine(LOG_LEVEL_INFO, strformat(F("Syslog: %u lines dropped"), syslog_droppedInWindow));
+      syslog_droppedInWindow = 0;
+    }
+  }
+
+  if (!syslog_batch.isEmpty() && (timePassedSince(syslog_batchStart) >= SYSLOG_BATCH_FLUSH_TIME)) {
+    SyslogBuffer_flush();
+  }
+}
+
+void SyslogBuffer_flush() {
+  if (syslog_batch.isEmpty()) {
+    return;
+  }
+  sendSyslogPacket(EMPTY_STRING, syslog_batch);
+
+  // Keep the allocated memory, to prevent heap fragmentation.
+  syslog_batch.clear();
+}
+
+uint32_t SyslogBuffer_getDroppedLines() {
+  return syslog_droppedTotal;
+}
+
+#endif // if FEATURE_SYSLOG_BUFFER
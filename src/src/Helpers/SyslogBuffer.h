@@ -0,0 +1,49 @@
+#ifndef HELPERS_SYSLOGBUFFER_H
+#define HELPERS_SYSLOGBUFFER_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_SYSLOG_BUFFER
+
+// Max. size of a datagram holding multiple lines.
+// Stays below the max. UDP payload of a 1500 byte MTU, so datagrams are not fragmented.
+# ifndef SYSLOG_BATCH_MAX_SIZE
+#  define SYSLOG_BATCH_MAX_SIZE        1400
+# endif // ifndef SYSLOG_BATCH_MAX_SIZE
+
+// Max. time in msec a line is kept before the datagram is sent.
+# ifndef SYSLOG_BATCH_FLUSH_TIME
+#  define SYSLOG_BATCH_FLUSH_TIME      500
+# endif // ifndef SYSLOG_BATCH_FLUSH_TIME
+
+// Max. nr of lines per second per log level (info and debug), error lines are never dropped.
+# ifndef SYSLOG_MAX_LINES_PER_SEC
+#  define SYSLOG_MAX_LINES_PER_SEC     50
+# endif // ifndef SYSLOG_MAX_LINES_PER_SEC
+
+// ********************************************************************************
+// Syslog sink with rate limiting and optional batching.
+// The header ("<PRIO>Hostname_EspEasy:") is computed once per second per priority
+// instead of for each line.
+// Lines exceeding SYSLOG_MAX_LINES_PER_SEC for their log level are dropped and counted.
+// The nr of dropped lines is reported via syslog once per second.
+// When "Syslog Batch Lines" is enabled, lines are collected and sent as multiple
+// newline separated lines per UDP datagram, when the datagram would exceed
+// SYSLOG_BATCH_MAX_SIZE or after SYSLOG_BATCH_FLUSH_TIME msec.
+// ********************************************************************************
+
+void     SyslogBuffer_add(uint8_t       logLevel,
+                          const String& message);
+
+// Send pending lines when the flush time has passed. Must be called from the main loop.
+void     SyslogBuffer_loop();
+
+// Send all pending lines, e.g. before a reboot.
+void     SyslogBuffer_flush();
+
+// Nr of lines dropped by the rate limit since boot.
+uint32_t SyslogBuffer_getDroppedLines();
+
+#endif // if FEATURE_SYSLOG_BUFFER
+
+#endif // ifndef HELPERS_SYSLOGBUFFER_H
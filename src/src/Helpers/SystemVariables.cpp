@@ -42,6 +42,11 @@
 String getReplacementString(const String& format, String& s) {
   int startpos = s.indexOf(format);
   int endpos   = s.indexOf('%', startpos + 1);
+
+  if ((startpos == -1) || (endpos == -1)) {
+    // No closing '%'
+    return EMPTY_STRING;
+  }
   String R     = s.substring(startpos, endpos + 1);
 
 #ifndef BUILD_NO_DEBUG
@@ -57,16 +62,20 @@ String getReplacementString(const String& format, String& s) {
   return R;
 }
 
-void replSunRiseTimeString(const String& format, String& s, boolean useURLencode) {
+bool replSunRiseTimeString(const String& format, String& s, boolean useURLencode) {
   String R = getReplacementString(format, s);
 
+  if (R.isEmpty()) { return false; }
   repl(R, node_time.getSunriseTimeString(':', ESPEasy_time::getSecOffset(R)), s, useURLencode);
+  return true;
 }
 
-void replSunSetTimeString(const String& format, String& s, boolean useURLencode) {
+bool replSunSetTimeString(const String& format, String& s, boolean useURLencode) {
   String R = getReplacementString(format, s);
 
+  if (R.isEmpty()) { return false; }
   repl(R, node_time.getSunsetTimeString(':', ESPEasy_time::getSecOffset(R)), s, useURLencode);
+  return true;
 }
 
 String timeReplacement_leadZero(int value)
@@ -223,8 +232,9 @@ String SystemVariables::getSystemVariable(SystemVariables::Enum enumval) {
   return EMPTY_STRING;
 }
 
+// Stop when the replacement could not be done, to prevent an endless loop.
 #define SMART_REPL_T(T, S) \
-  while (s.indexOf(T) != -1) { (S((T), s, useURLencode)); }
+  while (s.indexOf(T) != -1) { if (!(S((T), s, useURLencode))) { break; } }
 
 void SystemVariables::parseSystemVariables(String& s, boolean useURLencode)
 {
@@ -235,102 +245,208 @@ void SystemVariables::parseSystemVariables(String& s, boolean useURLencode)
     return;
   }
 
-  SystemVariables::Enum enumval = static_cast<SystemVariables::Enum>(0);
-
-  do {
-    enumval = SystemVariables::nextReplacementEnum(s, enumval);
-
-    switch (enumval)
-    {
-      case SUNRISE:           
-        SMART_REPL_T(SystemVariables::toString(enumval), replSunRiseTimeString); 
-        break;
-      case SUNSET:            
-        SMART_REPL_T(SystemVariables::toString(enumval), replSunSetTimeString); 
-        break;
-      case UNKNOWN:
-
-        // Do not replace
-        break;
-      default:
-      {
-        const String value = getSystemVariable(enumval);
-        repl(SystemVariables::toString(enumval), value, s, useURLencode);
-        break;
+  String newString;
+  int    lastPos = 0;
+  int    pos     = s.indexOf('%');
+
+  while (pos != -1) {
+    const int endPos = s.indexOf('%', pos + 1);
+
+    if (endPos == -1) { break; }
+
+    const SystemVariables::Enum enumval = findEnum(s.c_str() + pos + 1, endPos - pos - 1);
+
+    if (enumval == Enum::UNKNOWN) {
+      // The closing '%' may be the start of the next variable
+      pos = endPos;
+    } else {
+      if (lastPos == 0) {
+        newString.reserve(s.length() + 16);
+      }
+      newString += s.substring(lastPos, pos);
+
+      const String value = getCachedSystemVariable(enumval);
+
+      if (useURLencode) {
+        newString += URLEncode(value);
+      } else {
+        newString += value;
       }
+      lastPos = endPos + 1;
+      pos     = s.indexOf('%', lastPos);
     }
   }
-  while (enumval != SystemVariables::Enum::UNKNOWN);
 
+  if (lastPos > 0) {
+    newString += s.substring(lastPos);
+    s = std::move(newString);
+  }
+
+  // Sun times may have an offset, like %sunrise-1h%
+  if (s.indexOf(F("%sun")) != -1) {
+    SMART_REPL_T(SystemVariables::toString(Enum::SUNRISE), replSunRiseTimeString);
+    SMART_REPL_T(SystemVariables::toString(Enum::SUNSET),  replSunSetTimeString);
+  }
+
+  parseCustomVariables(s, useURLencode);
+
+  STOP_TIMER(PARSE_SYSVAR);
+}
+
+void SystemVariables::parseCustomVariables(String& s, boolean useURLencode)
+{
   int v_index = s.indexOf(F("%v"));
 
-  while ((v_index != -1)) {
-    unsigned int i;
-
-    if (validUIntFromString(s.substring(v_index + 2), i)) {
-      String key = F("%v");
-      key += i;
-      key += '%';
-
-      if (s.indexOf(key) != -1) {
-        const bool trimTrailingZeros = true;
-        #if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
-        const String value = doubleToString(getCustomFloatVar(i), 6, trimTrailingZeros);
-        #else
-        const String value = floatToString(getCustomFloatVar(i), 6, trimTrailingZeros);
-        #endif
-        repl(key, value, s, useURLencode);
+  if (v_index == -1) { return; }
+
+  String newString;
+  size_t lastPos = 0;
+
+  while (v_index != -1) {
+    // Only accept %vN% where N is a decimal number without leading zeroes
+    size_t pos   = v_index + 2;
+    uint32_t i   = 0;
+    bool isValid = pos < s.length() && isDigit(s[pos]) &&
+                   !(s[pos] == '0' && (pos + 1) < s.length() && isDigit(s[pos + 1]));
+
+    for (; isValid && pos < s.length() && isDigit(s[pos]); ++pos) {
+      const uint32_t digit = s[pos] - '0';
+
+      if (i > ((UINT32_MAX - digit) / 10)) {
+        isValid = false;
+      } else {
+        i = (i * 10) + digit;
       }
     }
-    v_index = s.indexOf(F("%v"), v_index + 1); // Find next occurance
+
+    if (isValid && (pos < s.length()) && (s[pos] == '%')) {
+      if (newString.isEmpty()) {
+        newString.reserve(s.length());
+      }
+      newString += s.substring(lastPos, v_index);
+
+      const bool trimTrailingZeros = true;
+      #if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+      const String value = doubleToString(getCustomFloatVar(i), 6, trimTrailingZeros);
+      #else
+      const String value = floatToString(getCustomFloatVar(i), 6, trimTrailingZeros);
+      #endif
+
+      if (useURLencode) {
+        newString += URLEncode(value);
+      } else {
+        newString += value;
+      }
+      lastPos = pos + 1;
+      v_index = s.indexOf(F("%v"), lastPos);
+    } else {
+      v_index = s.indexOf(F("%v"), v_index + 1); // Find next occurance
+    }
   }
 
-  STOP_TIMER(PARSE_SYSVAR);
+  if (lastPos > 0) {
+    newString += s.substring(lastPos);
+    s = std::move(newString);
+  }
 }
 
 #undef SMART_REPL_T
 
 
-SystemVariables::Enum SystemVariables::nextReplacementEnum(const String& str, SystemVariables::Enum last_tested)
+// Enum values sorted on their name, to find a system variable via binary search.
+static uint8_t sortedEnums[SystemVariables::Enum::UNKNOWN]{};
+static bool    sortedEnumsInitialized = false;
+
+void SystemVariables::initSortedEnums()
 {
-  if (str.indexOf('%') == -1) {
-    return Enum::UNKNOWN;
+  for (size_t i = 0; i < Enum::UNKNOWN; ++i) {
+    sortedEnums[i] = i;
   }
 
-  SystemVariables::Enum nextTested = static_cast<SystemVariables::Enum>(0);
+  // Only done once, so simple insertion sort is fast enough.
+  for (size_t i = 1; i < Enum::UNKNOWN; ++i) {
+    const uint8_t enumval = sortedEnums[i];
+    const String  name(toFlashString(static_cast<Enum>(enumval)));
+    size_t j = i;
 
-  if (last_tested > nextTested) {
-    nextTested = static_cast<SystemVariables::Enum>(last_tested + 1);
+    for (; j > 0 && name.compareTo(toFlashString(static_cast<Enum>(sortedEnums[j - 1]))) < 0; --j) {
+      sortedEnums[j] = sortedEnums[j - 1];
+    }
+    sortedEnums[j] = enumval;
   }
+  sortedEnumsInitialized = true;
+}
 
-  if (nextTested >= Enum::UNKNOWN) {
+SystemVariables::Enum SystemVariables::findEnum(const char *name, size_t length)
+{
+  if (length == 0) {
     return Enum::UNKNOWN;
   }
 
-  String str_prefix        = SystemVariables::toString(nextTested).substring(0, 2);
-  bool   str_prefix_exists = str.indexOf(str_prefix) != -1;
+  if (!sortedEnumsInitialized) {
+    initSortedEnums();
+  }
+  size_t first = 0;
+  size_t last  = Enum::UNKNOWN;
+
+  while (first < last) {
+    const size_t middle  = first + (last - first) / 2;
+    const Enum   enumval = static_cast<Enum>(sortedEnums[middle]);
+    PGM_P        flash   = reinterpret_cast<PGM_P>(toFlashString(enumval));
+    int cmp              = strncmp_P(name, flash, length);
+
+    if ((cmp == 0) && (pgm_read_byte(flash + length) != 0)) {
+      // name is a prefix of this system variable
+      cmp = -1;
+    }
 
-  for (int i = nextTested; i < Enum::UNKNOWN; ++i) {
-    SystemVariables::Enum enumval = static_cast<SystemVariables::Enum>(i);
-    const String new_str_prefix   = SystemVariables::toString(enumval).substring(0, 2);
+    if (cmp == 0) {
+      if ((enumval == Enum::SUNRISE) || (enumval == Enum::SUNSET)) {
+        // Handled separately as these may have an offset
+        return Enum::UNKNOWN;
+      }
+      return enumval;
+    }
 
-    if ((str_prefix == new_str_prefix) && !str_prefix_exists) {
-      // Just continue
+    if (cmp < 0) {
+      last = middle;
     } else {
-      str_prefix        = new_str_prefix;
-      str_prefix_exists = str.indexOf(str_prefix) != -1;
-
-      if (str_prefix_exists) {
-        if (str.indexOf(SystemVariables::toString(enumval)) != -1) {
-          return enumval;
-        }
-      }
+      first = middle + 1;
     }
   }
-
   return Enum::UNKNOWN;
 }
 
+// Values which do not change during a loop iteration, but take some time to compute.
+static String cachedSysName;
+static String cachedIP;
+static String cachedUnit;
+
+void SystemVariables::clearCachedValues()
+{
+  cachedSysName = String();
+  cachedIP      = String();
+  cachedUnit    = String();
+}
+
+String SystemVariables::getCachedSystemVariable(SystemVariables::Enum enumval)
+{
+  String *cached = nullptr;
+
+  switch (enumval) {
+    case Enum::SYSNAME:     cached = &cachedSysName; break;
+    case Enum::IP:          cached = &cachedIP; break;
+    case Enum::UNIT_sysvar: cached = &cachedUnit; break;
+    default:
+      return getSystemVariable(enumval);
+  }
+
+  if (cached->isEmpty()) {
+    *cached = getSystemVariable(enumval);
+  }
+  return *cached;
+}
+
 String SystemVariables::toString(Enum enumval)
 {
   if (enumval == Enum::SUNRISE || enumval == Enum::SUNSET) {
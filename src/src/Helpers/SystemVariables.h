@@ -115,9 +115,9 @@ public:
     UNKNOWN
   };
 
-  // Find the next thing to replace.
-  // Return UNKNOWN when nothing needs to be replaced.
-  static SystemVariables::Enum nextReplacementEnum(const String& str, SystemVariables::Enum last_tested);
+  // Find the system variable with given name (without the '%'), name does not need to be 0-terminated.
+  // Return UNKNOWN when not found or when it needs parameters, like %sunrise-1h%.
+  static SystemVariables::Enum findEnum(const char *name, size_t length);
 
   static String toString(SystemVariables::Enum enumval);
   static const __FlashStringHelper * toFlashString(SystemVariables::Enum enumval);
@@ -126,6 +126,20 @@ public:
 
   static void parseSystemVariables(String& s, boolean useURLencode);
 
+  // Replace all %vN% custom variables in a single pass.
+  static void parseCustomVariables(String& s, boolean useURLencode);
+
+  // Same as getSystemVariable(), but values which will not change
+  // during a loop iteration are computed only once.
+  static String getCachedSystemVariable(SystemVariables::Enum enumval);
+
+  // Clear values which are kept during a loop iteration, like %sysname%
+  static void clearCachedValues();
+
+private:
+
+  static void initSortedEnums();
+
 };
 
 
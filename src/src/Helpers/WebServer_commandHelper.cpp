@@ -83,3 +83,114 @@ HandledWebCommand_result handle_command_from_web(EventValueSource::Enum source,
   }
   return HandledWebCommand_result::Unknown_or_restricted_command;
 }
+
+// Parse a JSON string starting at the opening quote at pos.
+// pos is set right after the closing quote.
+static bool parse_web_command_JSON_string(const String& str, size_t& pos, String& result)
+{
+  const size_t strlength = str.length();
+
+  result.clear();
+
+  for (++pos; pos < strlength; ++pos) {
+    char c = str[pos];
+
+    if (c == '"') {
+      ++pos;
+      return true;
+    }
+
+    if (c == '\\') {
+      if (++pos >= strlength) { return false; }
+      c = str[pos];
+
+      switch (c) {
+        case 'n': c = '\n'; break;
+        case 'r': c = '\r'; break;
+        case 't': c = '\t'; break;
+        case 'b': c = '\b'; break;
+        case 'f': c = '\f'; break;
+        case 'u':
+        {
+          // Only support the ASCII range, as commands are not expected to contain anything else.
+          if ((pos + 4) >= strlength) { return false; }
+          const String hex = str.substring(pos + 1, pos + 5);
+          c    = static_cast<char>(strtoul(hex.c_str(), nullptr, 16) & 0x7F);
+          pos += 4;
+          break;
+        }
+        default:
+          // '"', '\\' and '/' are just copied
+          break;
+      }
+    }
+    result += c;
+  }
+  return false;
+}
+
+static bool split_web_command_JSON_array(const String& webrequest, std::vector<String>& commands)
+{
+  const size_t strlength = webrequest.length();
+  size_t pos             = 1; // Skip '['
+  String command;
+
+  while (pos < strlength) {
+    const char c = webrequest[pos];
+
+    if (isspace(c) || (c == ',')) {
+      ++pos;
+    } else if (c == ']') {
+      return true;
+    } else if (c == '"') {
+      if (!parse_web_command_JSON_string(webrequest, pos, command)) {
+        return false;
+      }
+      command.trim();
+
+      if (!command.isEmpty()) {
+        commands.push_back(std::move(command));
+      }
+    } else {
+      // Only strings are accepted
+      return false;
+    }
+  }
+  return false;
+}
+
+bool split_web_command_batch(const String& webrequest, std::vector<String>& commands)
+{
+  commands.clear();
+  String request(webrequest);
+
+  request.trim();
+
+  if (request.startsWith(F("["))) {
+    if (split_web_command_JSON_array(request, commands)) {
+      return true;
+    }
+    commands.clear();
+
+    // Not a valid JSON array, just handle it as a (single) command.
+    return false;
+  }
+
+  if (request.indexOf('\n') == -1) {
+    return false;
+  }
+
+  int start = 0;
+
+  while (start >= 0) {
+    const int end = request.indexOf('\n', start);
+    String    command(request.substring(start, end == -1 ? request.length() : end));
+    command.trim(); // Also strips '\r'
+
+    if (!command.isEmpty()) {
+      commands.push_back(std::move(command));
+    }
+    start = (end == -1) ? -1 : end + 1;
+  }
+  return true;
+}
@@ -3,6 +3,8 @@
 
 #include "../DataTypes/EventValueSource.h"
 
+#include <vector>
+
 
 enum class HandledWebCommand_result {
     NoCommand = 0,
@@ -14,4 +16,9 @@ enum class HandledWebCommand_result {
 // Check if we got a command as argument and try to execute it.
 HandledWebCommand_result handle_command_from_web(EventValueSource::Enum source, String& webrequest);
 
+// Split a batch of commands, given as JSON array of strings (e.g. ["gpio,12,1","gpio,13,0"])
+// or one command per line.
+// @retval false when the request is just a single command.
+bool split_web_command_batch(const String& webrequest, std::vector<String>& commands);
+
 #endif // HELPERS_WEBSERVER_COMMANDHELPER_H
\ No newline at end of file
@@ -0,0 +1,245 @@
+#include "../Helpers/_CPlugin_CBOR_helper.h"
+
+#if FEATURE_MQTT_CBOR_PAYLOAD
+
+# include "../DataStructs/ESPEasy_EventStruct.h"
+# include "../Globals/Cache.h"
+# include "../Globals/Device.h"
+# include "../Globals/Plugins.h"
+# include "../Globals/RuntimeData.h"
+# include "../Helpers/Misc.h"
+# include "../Helpers/StringConverter.h"
+
+# include "../../_Plugin_Helper.h"
+
+// CBOR major types
+# define CBOR_MAJOR_UINT   0
+# define CBOR_MAJOR_NINT   1
+# define CBOR_MAJOR_TEXT   3
+# define CBOR_MAJOR_ARRAY  4
+# define CBOR_MAJOR_MAP    5
+
+# define CBOR_FLOAT32      0xFA
+# define CBOR_NULL         0xF6
+
+// Encode the type and argument, using the shortest form
+void CBOR_addHead(String& out, uint8_t majorType, uint64_t value) {
+  const uint8_t type = majorType << 5;
+
+  if (value < 24) {
+    out += static_cast<char>(type | value);
+    return;
+  }
+  uint8_t nrBytes = 8;
+  uint8_t info    = 27;
+
+  if (value <= 0xFF) {
+    nrBytes = 1;
+    info    = 24;
+  } else if (value <= 0xFFFF) {
+    nrBytes = 2;
+    info    = 25;
+  } else if (value <= 0xFFFFFFFFull) {
+    nrBytes = 4;
+    info    = 26;
+  }
+  out += static_cast<char>(type | info);
+
+  // CBOR uses network byte order
+  for (uint8_t i = nrBytes; i > 0; --i) {
+    out += static_cast<char>((value >> (8 * (i - 1))) & 0xFF);
+  }
+}
+
+void CBOR_addUInt(String& out, uint64_t value) {
+  CBOR_addHead(out, CBOR_MAJOR_UINT, value);
+}
+
+void CBOR_addInt(String& out, int64_t value) {
+  if (value >= 0) {
+    CBOR_addHead(out, CBOR_MAJOR_UINT, static_cast<uint64_t>(value));
+  } else {
+    // Negative integers are encoded as -1 - n
+    CBOR_addHead(out, CBOR_MAJOR_NINT, static_cast<uint64_t>(-1 - value));
+  }
+}
+
+void CBOR_addFloat(String& out, float value) {
+  uint32_t bits = 0;
+
+  memcpy(&bits, &value, sizeof(bits));
+  out += static_cast<char>(CBOR_FLOAT32);
+
+  for (uint8_t i = 4; i > 0; --i) {
+    out += static_cast<char>((bits >> (8 * (i - 1))) & 0xFF);
+  }
+}
+
+void CBOR_addText(String& out, const String& str) {
+  CBOR_addHead(out, CBOR_MAJOR_TEXT, str.length());
+  out += str;
+}
+
+void CBOR_addMapHeader(String& out, size_t nrPairs) {
+  CBOR_addHead(out, CBOR_MAJOR_MAP, nrPairs);
+}
+
+void CBOR_addArrayHeader(String& out, size_t nrItems) {
+  CBOR_addHead(out, CBOR_MAJOR_ARRAY, nrItems);
+}
+
+void CBOR_addNull(String& out) {
+  out += static_cast<char>(CBOR_NULL);
+}
+
+PackedData_enum CBOR_getPackedDataType(taskIndex_t taskIndex, uint8_t varNr, Sensor_VType sensorType) {
+  # if FEATURE_EXTENDED_TASK_VALUE_TYPES
+
+  if (isUInt64OutputDataType(sensorType) || isInt64OutputDataType(sensorType)) {
+    return 0;
+  }
+
+  if (isInt32OutputDataType(sensorType)) {
+    return PackedData_int32;
+  }
+  # endif // if FEATURE_EXTENDED_TASK_VALUE_TYPES
+
+  if (isUInt32OutputDataType(sensorType)) {
+    return PackedData_uint32;
+  }
+  uint8_t nrDecimals = 0;
+
+  const deviceIndex_t DeviceIndex = getDeviceIndex_from_TaskIndex(taskIndex);
+
+  if (validDeviceIndex(DeviceIndex) && Device[DeviceIndex].configurableDecimals()) {
+    nrDecimals = Cache.getTaskDeviceValueDecimals(taskIndex, varNr);
+  }
+
+  // Max. exponent in the packed data types
+  if (nrDecimals > 6) {
+    nrDecimals = 6;
+  }
+  return PackedData_int32 | nrDecimals;
+}
+
+void CBOR_addTaskValue(String& out, struct EventStruct *event, uint8_t varNr) {
+  const taskIndex_t  taskIndex  = event->TaskIndex;
+  const Sensor_VType sensorType = event->getSensorType();
+
+  if (!UserVar.isValid(taskIndex, varNr, sensorType)) {
+    CBOR_addNull(out);
+    return;
+  }
+  # if FEATURE_EXTENDED_TASK_VALUE_TYPES
+
+  if (isUInt64OutputDataType(sensorType)) {
+    CBOR_addUInt(out, UserVar.getUint64(taskIndex, varNr));
+    return;
+  }
+
+  if (isInt64OutputDataType(sensorType)) {
+    CBOR_addInt(out, UserVar.getInt64(taskIndex, varNr));
+    return;
+  }
+
+  if (isInt32OutputDataType(sensorType)) {
+    CBOR_addInt(out, UserVar.getInt32(taskIndex, varNr));
+    return;
+  }
+  # endif // if FEATURE_EXTENDED_TASK_VALUE_TYPES
+
+  if (isUInt32OutputDataType(sensorType)) {
+    CBOR_addUInt(out, UserVar.getUint32(taskIndex, varNr));
+    return;
+  }
+  float factor = 1;
+  float offset = 0;
+
+  getPackedDataTypeSize(CBOR_getPackedDataType(taskIndex, varNr, sensorType), factor, offset);
+
+  const ESPEASY_RULES_FLOAT_TYPE value  = UserVar.getAsDouble(taskIndex, varNr, sensorType);
+  const ESPEASY_RULES_FLOAT_TYPE scaled = round((value + offset) * factor);
+
+  if ((scaled >= INT32_MIN) && (scaled <= INT32_MAX)) {
+    CBOR_addInt(out, static_cast<int64_t>(scaled));
+  } else {
+    CBOR_addFloat(out, value);
+  }
+}
+
+String CBOR_encodeTaskValue(struct EventStruct *event, uint8_t varNr) {
+  String res;
+
+  CBOR_addTaskValue(res, event, varNr);
+  return res;
+}
+
+String CBOR_encodeTaskValues(struct EventStruct *event) {
+  const uint8_t valueCount = getValueCountForTask(event->TaskIndex);
+  uint8_t nrValues         = 0;
+
+  for (uint8_t x = 0; x < valueCount; x++) {
+    if (!getTaskValueName(event->TaskIndex, x).isEmpty()) {
+      ++nrValues;
+    }
+  }
+  String res;
+
+  res.reserve(16 * nrValues + 1);
+  CBOR_addMapHeader(res, nrValues);
+
+  for (uint8_t x = 0; x < valueCount; x++) {
+    const String valueName = getTaskValueName(event->TaskIndex, x);
+
+    // Skip values with empty labels, same as when publishing separate values
+    if (!valueName.isEmpty()) {
+      CBOR_addText(res, valueName);
+      CBOR_addTaskValue(res, event, x);
+    }
+  }
+  return res;
+}
+
+String CBOR_getTaskSchema(struct EventStruct *event) {
+  const uint8_t valueCount      = getValueCountForTask(event->TaskIndex);
+  const Sensor_VType sensorType = event->getSensorType();
+  String res;
+
+  res.reserve(32 + 48 * valueCount);
+  res += '{';
+  res += to_json_object_value(F("encoding"), F("cbor"), true);
+  res += F(",\"values\":[");
+
+  bool first = true;
+
+  for (uint8_t x = 0; x < valueCount; x++) {
+    const String valueName = getTaskValueName(event->TaskIndex, x);
+
+    if (valueName.isEmpty()) {
+      continue;
+    }
+    const PackedData_enum dtype = CBOR_getPackedDataType(event->TaskIndex, x, sensorType);
+    float factor                = 1;
+    float offset                = 0;
+
+    if (dtype != 0) {
+      getPackedDataTypeSize(dtype, factor, offset);
+    }
+
+    if (!first) {
+      res += ',';
+    }
+    first = false;
+    res  += '{';
+    res  += to_json_object_value(F("name"), valueName, true);
+    res  += ',';
+    res  += to_json_object_value(F("type"), String(dtype));
+    res  += ',';
+    res  += to_json_object_value(F("factor"), String(static_cast<uint32_t>(factor)));
+    res  += '}';
+  }
+  res += F("]}");
+  return res;
+}
+
+#endif // if FEATURE_MQTT_CBOR_PAYLOAD
@@ -0,0 +1,62 @@
+#ifndef HELPERS__CPLUGIN_CBOR_HELPER_H
+#define HELPERS__CPLUGIN_CBOR_HELPER_H
+
+#include "../../ESPEasy_common.h"
+
+// #######################################################################################################
+// #  Helper functions to encode task values as CBOR (RFC 8949) for use as compact MQTT payload.
+// #######################################################################################################
+
+#if FEATURE_MQTT_CBOR_PAYLOAD
+
+# include "../DataStructs/ESPEasy_packed_raw_data.h"
+# include "../DataTypes/SensorVType.h"
+# include "../DataTypes/TaskIndex.h"
+
+struct EventStruct;
+
+// Append a single CBOR data item to a String.
+// The String may contain 0-bytes, so always use its length.
+void CBOR_addUInt(String & out,
+                  uint64_t value);
+void CBOR_addInt(String & out,
+                 int64_t value);
+void CBOR_addFloat(String& out,
+                   float   value);
+void CBOR_addText(String      & out,
+                  const String& str);
+void CBOR_addMapHeader(String& out,
+                       size_t  nrPairs);
+void CBOR_addArrayHeader(String& out,
+                         size_t  nrItems);
+void CBOR_addNull(String& out);
+
+// Data type of a task value in the CBOR payload, using the types of the packed raw data.
+// Floating point values are sent as integer, multiplied by 10^(nr decimals) of the task value.
+// For example a temperature with 2 decimals is sent as PackedData_int32_1e2, so 21.5 is sent as 2150.
+// Return 0 for 64 bit integer values, which are sent as CBOR integer without scaling.
+PackedData_enum CBOR_getPackedDataType(taskIndex_t  taskIndex,
+                                       uint8_t      varNr,
+                                       Sensor_VType sensorType);
+
+// Append the task value using the data type from CBOR_getPackedDataType().
+// A value which does not fit in the type is sent as CBOR float, an invalid value as CBOR null.
+void CBOR_addTaskValue(String            & out,
+                       struct EventStruct *event,
+                       uint8_t             varNr);
+
+// Encode a single task value
+String CBOR_encodeTaskValue(struct EventStruct *event,
+                            uint8_t             varNr);
+
+// Encode all task values with a name as a map, like {"Temperature": 2150, "Humidity": 452}
+String CBOR_encodeTaskValues(struct EventStruct *event);
+
+// JSON description of the CBOR payload, so consumers know how to decode it.
+// {"encoding":"cbor","values":[{"name":"Temperature","type":4674,"factor":100},...]}
+// "type" is the PackedData_enum value, a received integer must be divided by "factor".
+String CBOR_getTaskSchema(struct EventStruct *event);
+
+#endif // if FEATURE_MQTT_CBOR_PAYLOAD
+
+#endif // ifndef HELPERS__CPLUGIN_CBOR_HELPER_H
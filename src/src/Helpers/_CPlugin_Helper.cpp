@@ -21,6 +21,7 @@
 #include "../Globals/SecuritySettings.h"
 #include "../Globals/ESPEasyWiFiEvent.h"
 
+#include "../Helpers/ControllerQueueTask.h"
 #include "../Helpers/ESPEasy_time_calc.h"
 #include "../Helpers/Misc.h"
 #include "../Helpers/Network.h"
@@ -30,6 +31,10 @@
 #include <WiFiClient.h>
 #include <WiFiUdp.h>
 
+#if FEATURE_CONTROLLER_ASYNC_CONNECT
+# include <lwip/sockets.h>
+#endif // if FEATURE_CONTROLLER_ASYNC_CONNECT
+
 
 bool safeReadStringUntil(Stream     & input,
                          String     & str,
@@ -68,7 +73,16 @@ bool safeReadStringUntil(Stream     & input,
       // We must run the backgroundtasks every now and then.
       if (timeOutReached(backgroundtasks_timer)) {
         backgroundtasks_timer += 10;
-        backgroundtasks();
+#if FEATURE_CONTROLLER_QUEUE_TASK
+
+        if (controllerQueueTask_isWorker()) {
+          // Background tasks are not thread safe and are run by the main loop anyway.
+          delay(1);
+        } else
+#endif // if FEATURE_CONTROLLER_QUEUE_TASK
+        {
+          backgroundtasks();
+        }
       } else {
         delay(0);
       }
@@ -222,6 +236,211 @@ bool client_available(WiFiClient& client) {
   return (client.available() != 0) || (client.connected() != 0);
 }
 
+#if FEATURE_HTTP_KEEP_ALIVE
+
+// Close a kept alive connection when it has not been used for this long.
+// Most HTTP servers close idle connections after 5 - 15 seconds.
+# ifndef HTTP_KEEP_ALIVE_MAX_IDLE
+#  define HTTP_KEEP_ALIVE_MAX_IDLE  5000
+# endif // ifndef HTTP_KEEP_ALIVE_MAX_IDLE
+
+struct ControllerHttpConnection {
+  WiFiClient    client;
+  HTTPClient    http;
+  String        host;
+  uint16_t      port     = 0;
+  unsigned long lastUsed = 0;
+# if FEATURE_CONTROLLER_ASYNC_CONNECT
+  unsigned long connectStart   = 0;
+  int           connectSocket  = -1;    // Socket while connecting
+  bool          freshConnect   = false; // Connected by http_connect_async, not yet used
+# endif // if FEATURE_CONTROLLER_ASYNC_CONNECT
+};
+
+// Only accessed while processing the queue of the controller, so never from 2 tasks at the same time.
+std::unique_ptr<ControllerHttpConnection> controllerHttpConnections[CONTROLLER_MAX];
+
+// Without checking the reply, the response is not read and thus the connection cannot be reused.
+bool useKeepAlive(const ControllerSettingsStruct& ControllerSettings)
+{
+  return ControllerSettings.http_keepAlive() && ControllerSettings.MustCheckReply;
+}
+
+void stopControllerHttpConnection(ControllerHttpConnection& connection)
+{
+  connection.client.stop();
+# if FEATURE_CONTROLLER_ASYNC_CONNECT
+
+  if (connection.connectSocket >= 0) {
+    close(connection.connectSocket);
+    connection.connectSocket = -1;
+  }
+  connection.freshConnect = false;
+# endif // if FEATURE_CONTROLLER_ASYNC_CONNECT
+}
+
+// Return the connection to use for this controller, or nullptr when a new connection must be made per message.
+ControllerHttpConnection* getControllerHttpConnection(controllerIndex_t               controller_idx,
+                                                      const ControllerSettingsStruct& ControllerSettings,
+                                                      const String                  & host)
+{
+  if (!validControllerIndex(controller_idx)) {
+    return nullptr;
+  }
+  std::unique_ptr<ControllerHttpConnection>& connection = controllerHttpConnections[controller_idx];
+
+  // With async connect, the connection object is also needed to hand over the connected socket.
+  if (!useKeepAlive(ControllerSettings) && !FEATURE_CONTROLLER_ASYNC_CONNECT) {
+    if (connection) {
+      stopControllerHttpConnection(*connection);
+      connection.reset();
+    }
+    return nullptr;
+  }
+
+  if (!connection) {
+    connection.reset(new (std::nothrow) ControllerHttpConnection());
+
+    if (!connection) {
+      return nullptr;
+    }
+  }
+  connection->http.setReuse(useKeepAlive(ControllerSettings));
+
+  bool idle = timePassedSince(connection->lastUsed) > HTTP_KEEP_ALIVE_MAX_IDLE;
+# if FEATURE_CONTROLLER_ASYNC_CONNECT
+
+  if (connection->connectSocket >= 0) {
+    // Still connecting, timeout is handled by http_connect_async
+    idle = false;
+  }
+# endif // if FEATURE_CONTROLLER_ASYNC_CONNECT
+
+  if (!connection->host.equals(host) ||
+      (connection->port != ControllerSettings.Port) ||
+      idle) {
+    stopControllerHttpConnection(*connection);
+    connection->host = host;
+    connection->port = ControllerSettings.Port;
+  }
+  return connection.get();
+}
+
+// Errors which may occur when the server closed a kept alive connection while it was idle.
+bool isStaleConnectionError(int httpCode)
+{
+  return httpCode == HTTPC_ERROR_SEND_HEADER_FAILED ||
+         httpCode == HTTPC_ERROR_SEND_PAYLOAD_FAILED ||
+         httpCode == HTTPC_ERROR_NOT_CONNECTED ||
+         httpCode == HTTPC_ERROR_CONNECTION_LOST;
+}
+
+#endif // if FEATURE_HTTP_KEEP_ALIVE
+
+#if FEATURE_CONTROLLER_ASYNC_CONNECT
+
+AsyncConnectResult http_connect_async_failed(int                       controller_number,
+                                             ControllerHttpConnection& connection)
+{
+  stopControllerHttpConnection(connection);
+  count_connection_results(false, F("HTTP : "), controller_number, connection.connectStart);
+  return AsyncConnectResult::Failed;
+}
+
+AsyncConnectResult http_connect_async(int                       controller_number,
+                                      controllerIndex_t         controller_idx,
+                                      ControllerSettingsStruct& ControllerSettings)
+{
+  ControllerHttpConnection *connection = getControllerHttpConnection(controller_idx, ControllerSettings, ControllerSettings.getHost());
+
+  if ((connection == nullptr) || connection->client.connected()) {
+    // Use the blocking connect of the HTTP client, or the already connected socket
+    return AsyncConnectResult::Ready;
+  }
+
+  if (connection->connectSocket < 0) {
+    // Resolving the host name is still blocking, but only done when the IP is not yet cached.
+    if (!ControllerSettings.checkHostReachable(true)) {
+      return AsyncConnectResult::Failed;
+    }
+# ifndef BUILD_NO_DEBUG
+    log_connecting_to(F("HTTP : "), controller_number, ControllerSettings);
+# endif // ifndef BUILD_NO_DEBUG
+
+    const int sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+    if (sock < 0) {
+      return AsyncConnectResult::Failed;
+    }
+    fcntl(sock, F_SETFL, fcntl(sock, F_GETFL, 0) | O_NONBLOCK);
+
+    const IPAddress ip = ControllerSettings.getIP();
+    struct sockaddr_in serveraddr;
+
+    memset(&serveraddr, 0, sizeof(serveraddr));
+    serveraddr.sin_family      = AF_INET;
+    serveraddr.sin_addr.s_addr = static_cast<uint32_t>(ip);
+    serveraddr.sin_port        = htons(ControllerSettings.Port);
+
+    connection->connectSocket = sock;
+    connection->connectStart  = millis();
+
+    if ((connect(sock, reinterpret_cast<struct sockaddr *>(&serveraddr), sizeof(serveraddr)) < 0) &&
+        (errno != EINPROGRESS)) {
+      return http_connect_async_failed(controller_number, *connection);
+    }
+  }
+
+  // Check without waiting whether the socket is connected
+  fd_set fdset;
+  struct timeval tv;
+
+  FD_ZERO(&fdset);
+  FD_SET(connection->connectSocket, &fdset);
+  tv.tv_sec  = 0;
+  tv.tv_usec = 0;
+
+  const int res = select(connection->connectSocket + 1, nullptr, &fdset, nullptr, &tv);
+
+  if (res < 0) {
+    return http_connect_async_failed(controller_number, *connection);
+  }
+
+  if (res == 0) {
+    // Same timeout as used for a blocking connect
+    const uint32_t timeout = ControllerSettings.MustCheckReply
+    ? WiFiEventData.getSuggestedTimeout(controller_number, ControllerSettings.ClientTimeout)
+    : ControllerSettings.ClientTimeout;
+
+    if (timePassedSince(connection->connectStart) > static_cast<long>(timeout)) {
+      return http_connect_async_failed(controller_number, *connection);
+    }
+    return AsyncConnectResult::Pending;
+  }
+
+  int sockerr       = 0;
+  socklen_t len     = sizeof(sockerr);
+
+  if ((getsockopt(connection->connectSocket, SOL_SOCKET, SO_ERROR, &sockerr, &len) < 0) || (sockerr != 0)) {
+    return http_connect_async_failed(controller_number, *connection);
+  }
+
+  // Hand over the connected socket to the client, which expects a blocking socket.
+  const int sock = connection->connectSocket;
+  const int one  = 1;
+
+  fcntl(sock, F_SETFL, fcntl(sock, F_GETFL, 0) & (~O_NONBLOCK));
+  setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  connection->connectSocket = -1;
+  connection->client        = WiFiClient(sock);
+  connection->freshConnect  = true;
+  connection->lastUsed      = millis();
+  count_connection_results(true, F("HTTP : "), controller_number, connection->connectStart);
+  return AsyncConnectResult::Ready;
+}
+
+#endif // if FEATURE_CONTROLLER_ASYNC_CONNECT
+
 String send_via_http(int                             controller_number,
                      const ControllerSettingsStruct& ControllerSettings,
                      controllerIndex_t               controller_idx,
@@ -240,19 +459,78 @@ String send_via_http(int                             controller_number,
     : ControllerSettings.ClientTimeout;
 
   const unsigned long connect_start_time = millis();
-  const String result = send_via_http(
-    get_formatted_Controller_number(controller_number),
-    timeout,
-    getControllerUser(controller_idx, ControllerSettings),
-    getControllerPass(controller_idx, ControllerSettings),
-    ControllerSettings.getHost(),
-    ControllerSettings.Port,
-    uri,
-    HttpMethod,
-    header,
-    postStr,
-    httpCode,
-    ControllerSettings.MustCheckReply);
+  const String host = ControllerSettings.getHost();
+  String result;
+
+#if FEATURE_HTTP_KEEP_ALIVE
+  ControllerHttpConnection *connection = getControllerHttpConnection(controller_idx, ControllerSettings, host);
+
+  if (connection != nullptr) {
+    const String user = getControllerUser(controller_idx, ControllerSettings);
+    const String pass = getControllerPass(controller_idx, ControllerSettings);
+
+    // Try at most twice, as the server may have closed the connection since the last message.
+    bool reused = connection->client.connected();
+# if FEATURE_CONTROLLER_ASYNC_CONNECT
+
+    if (connection->connectSocket >= 0) {
+      // Async connect did not finish, let the HTTP client connect.
+      stopControllerHttpConnection(*connection);
+      reused = false;
+    }
+
+    if (connection->freshConnect) {
+      reused                   = false;
+      connection->freshConnect = false;
+    }
+# endif // if FEATURE_CONTROLLER_ASYNC_CONNECT
+
+    for (uint8_t i = 0; i < 2; ++i) {
+      result = send_via_http(
+        get_formatted_Controller_number(controller_number),
+        connection->client,
+        connection->http,
+        timeout,
+        user,
+        pass,
+        host,
+        ControllerSettings.Port,
+        uri,
+        HttpMethod,
+        header,
+        postStr,
+        httpCode,
+        ControllerSettings.MustCheckReply);
+
+      // Keeps the connection open when reuse is set, unless the server replied with "Connection: close"
+      connection->http.end();
+
+      if ((httpCode <= 0) || !useKeepAlive(ControllerSettings)) {
+        connection->client.stop();
+      }
+
+      if (!reused || !isStaleConnectionError(httpCode)) {
+        break;
+      }
+    }
+    connection->lastUsed = millis();
+  } else
+#endif // if FEATURE_HTTP_KEEP_ALIVE
+  {
+    result = send_via_http(
+      get_formatted_Controller_number(controller_number),
+      timeout,
+      getControllerUser(controller_idx, ControllerSettings),
+      getControllerPass(controller_idx, ControllerSettings),
+      host,
+      ControllerSettings.Port,
+      uri,
+      HttpMethod,
+      header,
+      postStr,
+      httpCode,
+      ControllerSettings.MustCheckReply);
+  }
 
   // FIXME TD-er: Shouldn't this be: success = (httpCode >= 100) && (httpCode < 300)
   // or is reachability of the host the important factor here?
@@ -62,6 +62,27 @@ String send_via_http(int                             controller_number,
                      const String                  & header,
                      const String                  & postStr,
                      int                           & httpCode);
+
+# if FEATURE_CONTROLLER_ASYNC_CONNECT
+
+// Interval to check whether a non blocking connect has finished
+#  ifndef HTTP_ASYNC_CONNECT_POLL_INTERVAL
+#   define HTTP_ASYNC_CONNECT_POLL_INTERVAL  10
+#  endif // ifndef HTTP_ASYNC_CONNECT_POLL_INTERVAL
+
+enum class AsyncConnectResult : uint8_t {
+  Ready,   // Connected, or no async connect needed for this controller
+  Pending, // Still connecting, call again later
+  Failed
+};
+
+// Connect the HTTP connection of the controller without blocking.
+// Must be called repeatedly until it no longer returns Pending.
+// When Ready, send_via_http() will use the connected socket.
+AsyncConnectResult http_connect_async(int                       controller_number,
+                                      controllerIndex_t         controller_idx,
+                                      ControllerSettingsStruct& ControllerSettings);
+# endif // if FEATURE_CONTROLLER_ASYNC_CONNECT
 #endif // FEATURE_HTTP_CLIENT
                      
 
@@ -29,6 +29,7 @@ const __FlashStringHelper * toString(ControllerSettingsStruct::VarType parameter
     case ControllerSettingsStruct::CONTROLLER_MIN_SEND_INTERVAL:        return  F("Minimum Send Interval");  
     case ControllerSettingsStruct::CONTROLLER_MAX_QUEUE_DEPTH:          return  F("Max Queue Depth");        
     case ControllerSettingsStruct::CONTROLLER_MAX_RETRIES:              return  F("Max Retries");            
+    case ControllerSettingsStruct::CONTROLLER_MAX_BURST:                return  F("Max Burst");
     case ControllerSettingsStruct::CONTROLLER_FULL_QUEUE_ACTION:        return  F("Full Queue Action");      
     case ControllerSettingsStruct::CONTROLLER_ALLOW_EXPIRE:             return  F("Allow Expire");           
     case ControllerSettingsStruct::CONTROLLER_DEDUPLICATE:              return  F("De-duplicate");           
@@ -49,6 +50,12 @@ const __FlashStringHelper * toString(ControllerSettingsStruct::VarType parameter
     case ControllerSettingsStruct::CONTROLLER_CLEAN_SESSION:            return  F("Clean Session");          
     case ControllerSettingsStruct::CONTROLLER_USE_EXTENDED_CREDENTIALS: return  F("Use Extended Credentials");  
     case ControllerSettingsStruct::CONTROLLER_SEND_BINARY:              return  F("Send Binary");            
+    case ControllerSettingsStruct::CONTROLLER_MQTT_AGGREGATE_VALUES:    return  F("Aggregate Task Values");
+    case ControllerSettingsStruct::CONTROLLER_HTTP_KEEP_ALIVE:          return  F("HTTP Keep-Alive");
+    case ControllerSettingsStruct::CONTROLLER_QUEUE_SPILL:              return  F("Spill Queue To File");
+    case ControllerSettingsStruct::CONTROLLER_P2P_COMPACT_DATA:         return  F("Compact Sensor Data");
+    case ControllerSettingsStruct::CONTROLLER_MQTT_TLS:                 return  F("Use TLS");
+    case ControllerSettingsStruct::CONTROLLER_CACHE_COMPRESS:           return  F("Compress Samples");
     case ControllerSettingsStruct::CONTROLLER_TIMEOUT:                  return  F("Client Timeout");         
     case ControllerSettingsStruct::CONTROLLER_SAMPLE_SET_INITIATOR:     return  F("Sample Set Initiator");   
 
@@ -195,6 +202,12 @@ void addControllerParameterForm(const ControllerSettingsStruct& ControllerSettin
       addFormNumericBox(displayName, internalName, ControllerSettings.MaxRetry, 1, CONTROLLER_DELAY_QUEUE_RETRY_MAX);
       break;
     }
+    case ControllerSettingsStruct::CONTROLLER_MAX_BURST:
+    {
+      addFormNumericBox(displayName, internalName, ControllerSettings.MaxBurst, 1, CONTROLLER_DELAY_QUEUE_BURST_MAX);
+      addFormNote(F("Messages sent at once after an idle period. The average rate is limited by the Minimum Send Interval"));
+      break;
+    }
     case ControllerSettingsStruct::CONTROLLER_FULL_QUEUE_ACTION:
     {
       const __FlashStringHelper * options[2] {
@@ -261,6 +274,28 @@ void addControllerParameterForm(const ControllerSettingsStruct& ControllerSettin
     case ControllerSettingsStruct::CONTROLLER_SEND_BINARY:
       addFormCheckBox(displayName, internalName, ControllerSettings.sendBinary());
       break;
+    case ControllerSettingsStruct::CONTROLLER_MQTT_AGGREGATE_VALUES:
+      addFormCheckBox(displayName, internalName, ControllerSettings.mqtt_aggregateValues());
+      break;
+    case ControllerSettingsStruct::CONTROLLER_HTTP_KEEP_ALIVE:
+      addFormCheckBox(displayName, internalName, ControllerSettings.http_keepAlive());
+      addFormNote(F("Reuse the connection for the next message. Only used with 'Check Acknowledgement'"));
+      break;
+    case ControllerSettingsStruct::CONTROLLER_QUEUE_SPILL:
+      addFormCheckBox(displayName, internalName, ControllerSettings.queueSpill());
+      addFormNote(F("Store messages in a file when the queue is full, to be sent later"));
+      break;
+    case ControllerSettingsStruct::CONTROLLER_P2P_COMPACT_DATA:
+      addFormCheckBox(displayName, internalName, ControllerSettings.p2p_compactData());
+      break;
+    case ControllerSettingsStruct::CONTROLLER_MQTT_TLS:
+      addFormCheckBox(displayName, internalName, ControllerSettings.mqtt_useTLS());
+      addFormNote(F("Usually port 8883. The broker certificate is checked using the CA certificate in file 'mqtt_ca.pem', when present"));
+      break;
+    case ControllerSettingsStruct::CONTROLLER_CACHE_COMPRESS:
+      addFormCheckBox(displayName, internalName, ControllerSettings.cache_compressSamples());
+      addFormNote(F("Store samples in compressed blocks. dump6.htm and readers of the binary export must support this format"));
+      break;
     case ControllerSettingsStruct::CONTROLLER_TIMEOUT:
       addFormNumericBox(displayName, internalName, ControllerSettings.ClientTimeout, 10, CONTROLLER_CLIENTTIMEOUT_MAX);
       addUnit(F("ms"));
@@ -332,6 +367,9 @@ void saveControllerParameterForm(ControllerSettingsStruct        & ControllerSet
     case ControllerSettingsStruct::CONTROLLER_MAX_RETRIES:
       ControllerSettings.MaxRetry = getFormItemInt(internalName, ControllerSettings.MaxRetry);
       break;
+    case ControllerSettingsStruct::CONTROLLER_MAX_BURST:
+      ControllerSettings.MaxBurst = getFormItemInt(internalName, ControllerSettings.MaxBurst);
+      break;
     case ControllerSettingsStruct::CONTROLLER_FULL_QUEUE_ACTION:
       ControllerSettings.DeleteOldest = getFormItemInt(internalName, ControllerSettings.DeleteOldest);
       break;
@@ -386,6 +424,24 @@ void saveControllerParameterForm(ControllerSettingsStruct        & ControllerSet
     case ControllerSettingsStruct::CONTROLLER_SEND_BINARY:
       ControllerSettings.sendBinary(isFormItemChecked(internalName));
       break;
+    case ControllerSettingsStruct::CONTROLLER_MQTT_AGGREGATE_VALUES:
+      ControllerSettings.mqtt_aggregateValues(isFormItemChecked(internalName));
+      break;
+    case ControllerSettingsStruct::CONTROLLER_HTTP_KEEP_ALIVE:
+      ControllerSettings.http_keepAlive(isFormItemChecked(internalName));
+      break;
+    case ControllerSettingsStruct::CONTROLLER_QUEUE_SPILL:
+      ControllerSettings.queueSpill(isFormItemChecked(internalName));
+      break;
+    case ControllerSettingsStruct::CONTROLLER_P2P_COMPACT_DATA:
+      ControllerSettings.p2p_compactData(isFormItemChecked(internalName));
+      break;
+    case ControllerSettingsStruct::CONTROLLER_MQTT_TLS:
+      ControllerSettings.mqtt_useTLS(isFormItemChecked(internalName));
+      break;
+    case ControllerSettingsStruct::CONTROLLER_CACHE_COMPRESS:
+      ControllerSettings.cache_compressSamples(isFormItemChecked(internalName));
+      break;
     case ControllerSettingsStruct::CONTROLLER_TIMEOUT:
       ControllerSettings.ClientTimeout = getFormItemInt(internalName, ControllerSettings.ClientTimeout);
       break;
@@ -8,6 +8,7 @@
 #include "../Globals/CPlugins.h"
 #include "../Globals/Settings.h"
 
+#include "../Helpers/EventTracer.h"
 #include "../Helpers/Misc.h"
 
 // ********************************************************************************
@@ -2124,6 +2125,7 @@ bool CPluginCall(protocolIndex_t protocolIndex, CPlugin::Function Function, stru
 {
   if (protocolIndex < ProtocolIndex_to_CPlugin_id_size)
   {
+    EVENT_TRACE_SCOPE(CPlugin, (static_cast<uint32_t>(protocolIndex) << 8) | static_cast<uint8_t>(Function));
     START_TIMER;
     CPlugin_ptr_t cplugin_call = (CPlugin_ptr_t)pgm_read_ptr(CPlugin_ptr + protocolIndex);
     const bool res = cplugin_call(Function, event, string);
@@ -12,6 +12,12 @@
 
 #include <GPIO_Direct_Access.h>
 
+#if FEATURE_PULSE_PCNT
+# include "../Helpers/Hardware_PCNT.h"
+
+# include <driver/pcnt.h>
+#endif // if FEATURE_PULSE_PCNT
+
 
 const __FlashStringHelper * Internal_GPIO_pulseHelper::toString(GPIOtriggerMode mode)
 {
@@ -53,6 +59,25 @@ Internal_GPIO_pulseHelper::Internal_GPIO_pulseHelper(Internal_GPIO_pulseHelper::
   : config(configuration) {}
 
 Internal_GPIO_pulseHelper::~Internal_GPIO_pulseHelper() {
+  #if FEATURE_PULSE_PERIOD_STATS
+
+  if (edgeTimestamps != nullptr) {
+    detachInterrupt(digitalPinToInterrupt(config.gpio));
+    delete[] edgeTimestamps;
+    edgeTimestamps = nullptr;
+  }
+  #endif // if FEATURE_PULSE_PERIOD_STATS
+  #if FEATURE_PULSE_PCNT
+
+  if (pcntUnit >= 0) {
+    const pcnt_unit_t unit = static_cast<pcnt_unit_t>(pcntUnit);
+    pcnt_counter_pause(unit);
+    pcnt_intr_disable(unit);
+    pcnt_isr_handler_remove(unit);
+    PCNT_releaseUnit(pcntUnit);
+    return;
+  }
+  #endif // if FEATURE_PULSE_PCNT
   detachInterrupt(digitalPinToInterrupt(config.gpio));
 }
 
@@ -73,6 +98,26 @@ bool Internal_GPIO_pulseHelper::init()
     pulseModeData.Step3OKcounter = ISRdata.pulseTotalCounter;
     #endif // ifdef PULSE_STATISTIC
 
+    #if FEATURE_PULSE_PCNT
+
+    if (config.usePCNTmode()) {
+      if (initPCNT()) {
+        return true;
+      }
+
+      if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+        addLogMove(LOG_LEVEL_ERROR, concat(F("Pulse: No PCNT unit available, using interrupt for GPIO "), static_cast<int>(config.gpio)));
+      }
+    }
+    #endif // if FEATURE_PULSE_PCNT
+
+    #if FEATURE_PULSE_PERIOD_STATS
+
+    if (config.usePeriodStats && config.useEdgeMode() && (edgeTimestamps == nullptr)) {
+      edgeTimestamps = new (std::nothrow) uint32_t[PULSE_EDGE_BUFFER_SIZE];
+    }
+    #endif // if FEATURE_PULSE_PERIOD_STATS
+
     const int intPinMode = static_cast<int>(config.interruptPinMode) & MODE_INTERRUPT_MASK;
     attachInterruptArg(
       digitalPinToInterrupt(config.gpio),
@@ -88,6 +133,9 @@ bool Internal_GPIO_pulseHelper::init()
 
 void Internal_GPIO_pulseHelper::getPulseCounters(unsigned long& pulseCounter, unsigned long& pulseTotalCounter, float& pulseTime_msec)
 {
+  #if FEATURE_PULSE_PCNT
+  samplePCNT();
+  #endif // if FEATURE_PULSE_PCNT
   pulseCounter      = ISRdata.pulseCounter;
   pulseTotalCounter = ISRdata.pulseTotalCounter;
   pulseTime_msec    = static_cast<float>(ISRdata.pulseTime) / 1000.0f;
@@ -117,6 +165,14 @@ void Internal_GPIO_pulseHelper::doPulseStepProcessing(int pStep)
     case GPIO_PULSE_HELPER_PROCESSING_STEP_0:
       // regularily called to check if the trigger has flagged the next signal edge
     {
+      #if FEATURE_PULSE_PCNT
+
+      if (pcntUnit >= 0) {
+        // No interrupts, collect the pulses counted by the PCNT unit instead
+        samplePCNT();
+        break;
+      }
+      #endif // if FEATURE_PULSE_PCNT
       if (ISRdata.initStepsFlags)
       {
         // schedule step 1 in remaining milliseconds from debounce time
@@ -378,6 +434,19 @@ void IRAM_ATTR Internal_GPIO_pulseHelper::ISR_edgeCheck(Internal_GPIO_pulseHelpe
     self->ISRdata.pulseTotalCounter++;
     self->ISRdata.pulseTime              = timeSinceLastTrigger;
     self->ISRdata.currentStableStartTime = currentTime; // reset when counted to determine interval between counted pulses
+    #if FEATURE_PULSE_PERIOD_STATS
+
+    if (self->edgeTimestamps != nullptr) {
+      const uint32_t head = self->edgeHead;
+
+      if ((head - self->edgeTail) < PULSE_EDGE_BUFFER_SIZE) {
+        self->edgeTimestamps[head & (PULSE_EDGE_BUFFER_SIZE - 1)] = static_cast<uint32_t>(currentTime);
+        self->edgeHead                                            = head + 1;
+      } else {
+        self->edgeOverflowCount = self->edgeOverflowCount + 1;
+      }
+    }
+    #endif // if FEATURE_PULSE_PERIOD_STATS
   }
   ISR_interrupts(); // enable interrupts again.
 }
@@ -402,6 +471,197 @@ void IRAM_ATTR Internal_GPIO_pulseHelper::ISR_pulseCheck(Internal_GPIO_pulseHelp
   ISR_interrupts(); // enable interrupts again.
 }
 
+#if FEATURE_PULSE_PCNT
+
+bool Internal_GPIO_pulseHelper::initPCNT()
+{
+  const int8_t unit = PCNT_claimUnit();
+
+  if (unit < 0) {
+    return false;
+  }
+
+  pcnt_config_t pcnt_config{};
+
+  pcnt_config.pulse_gpio_num = config.gpio;
+  pcnt_config.ctrl_gpio_num  = PCNT_PIN_NOT_USED;
+  pcnt_config.lctrl_mode     = PCNT_MODE_KEEP;
+  pcnt_config.hctrl_mode     = PCNT_MODE_KEEP;
+  pcnt_config.pos_mode       = config.interruptPinMode == GPIOtriggerMode::Falling ? PCNT_COUNT_DIS : PCNT_COUNT_INC;
+  pcnt_config.neg_mode       = config.interruptPinMode == GPIOtriggerMode::Rising ? PCNT_COUNT_DIS : PCNT_COUNT_INC;
+  pcnt_config.counter_h_lim  = PULSE_PCNT_HIGH_LIMIT;
+  pcnt_config.counter_l_lim  = -PULSE_PCNT_HIGH_LIMIT;
+  pcnt_config.unit           = static_cast<pcnt_unit_t>(unit);
+  pcnt_config.channel        = PCNT_CHANNEL_0;
+
+  if (pcnt_unit_config(&pcnt_config) != ESP_OK) {
+    PCNT_releaseUnit(unit);
+    return false;
+  }
+
+  // pcnt_unit_config() sets a pull-up, restore the configured pin mode
+  pinMode(config.gpio, config.pullupPinMode);
+
+  // Glitch filter in APB clock cycles. The debounce time (msec) is far longer than the
+  // max. filter, so longer debounce times are not possible in hardware.
+  const pcnt_unit_t pcnt_unit = pcnt_config.unit;
+
+  if (config.debounceTime_micros != 0) {
+    const uint64_t filter = config.debounceTime_micros * (APB_CLK_FREQ / 1000000);
+    pcnt_set_filter_value(pcnt_unit, filter > PULSE_PCNT_MAX_FILTER ? PULSE_PCNT_MAX_FILTER : filter);
+    pcnt_filter_enable(pcnt_unit);
+  } else {
+    pcnt_filter_disable(pcnt_unit);
+  }
+
+  pcnt_counter_pause(pcnt_unit);
+  pcnt_counter_clear(pcnt_unit);
+
+  if (!PCNT_installISRservice() ||
+      (pcnt_isr_handler_add(pcnt_unit, ISR_PCNToverflow, this) != ESP_OK)) {
+    PCNT_releaseUnit(unit);
+    return false;
+  }
+  pcnt_event_enable(pcnt_unit, PCNT_EVT_H_LIM);
+  pcnt_intr_enable(pcnt_unit);
+
+  pcntOverflowCount = 0;
+  pcntLastCount     = 0;
+  pcntLastPulseTime = getMicros64();
+  pcntUnit          = unit;
+
+  pcnt_counter_resume(pcnt_unit);
+  return true;
+}
+
+void Internal_GPIO_pulseHelper::samplePCNT()
+{
+  if (pcntUnit < 0) {
+    return;
+  }
+  uint32_t overflowCount = 0;
+  int16_t  counter       = 0;
+
+  do {
+    overflowCount = pcntOverflowCount;
+    pcnt_get_counter_value(static_cast<pcnt_unit_t>(pcntUnit), &counter);
+  } while (overflowCount != pcntOverflowCount);
+
+  const uint32_t count = overflowCount * PULSE_PCNT_HIGH_LIMIT + static_cast<uint16_t>(counter);
+
+  if (count <= pcntLastCount) {
+    // No new pulses, or the counter wrapped and the overflow interrupt is not yet handled
+    return;
+  }
+  const uint32_t nrPulses = count - pcntLastCount;
+  const uint64_t now      = getMicros64();
+
+  // Average time between the pulses since the previous sample with pulses
+  ISRdata.pulseTime          = (now - pcntLastPulseTime) / nrPulses;
+  ISRdata.pulseCounter      += nrPulses;
+  ISRdata.pulseTotalCounter += nrPulses;
+  pcntLastCount              = count;
+  pcntLastPulseTime          = now;
+}
+
+void IRAM_ATTR Internal_GPIO_pulseHelper::ISR_PCNToverflow(void *arg)
+{
+  Internal_GPIO_pulseHelper *self = static_cast<Internal_GPIO_pulseHelper *>(arg);
+
+  self->pcntOverflowCount = self->pcntOverflowCount + 1;
+}
+
+#endif // if FEATURE_PULSE_PCNT
+
+#if FEATURE_PULSE_PERIOD_STATS
+
+void pulsePeriodStats_t::clear()
+{
+  *this = pulsePeriodStats_t();
+}
+
+void pulsePeriodStats_t::add(uint32_t period_usec)
+{
+  if ((count == 0) || (period_usec < min_usec)) {
+    min_usec = period_usec;
+  }
+
+  if (period_usec > max_usec) {
+    max_usec = period_usec;
+  }
+  ++count;
+  const double delta = period_usec - mean_usec;
+
+  mean_usec   += delta / count;
+  sumSqr_usec += delta * (period_usec - mean_usec);
+}
+
+float pulsePeriodStats_t::mean_msec() const
+{
+  return mean_usec / 1000.0;
+}
+
+float pulsePeriodStats_t::min_msec() const
+{
+  return min_usec / 1000.0f;
+}
+
+float pulsePeriodStats_t::max_msec() const
+{
+  return max_usec / 1000.0f;
+}
+
+float pulsePeriodStats_t::jitter_msec() const
+{
+  if (count < 2) {
+    return 0.0f;
+  }
+  return sqrt(sumSqr_usec / count) / 1000.0;
+}
+
+void Internal_GPIO_pulseHelper::processEdgeTimestamps()
+{
+  if (edgeTimestamps == nullptr) {
+    return;
+  }
+
+  // Edges got lost between the last edge of the previous call and the first buffered edge.
+  const uint32_t overflowCount = edgeOverflowCount;
+  const bool     overflow      = overflowCount != edgeOverflowHandled;
+
+  if (overflow) {
+    lastEdgeValid = false;
+  }
+  const uint32_t head = edgeHead;
+  uint32_t tail       = edgeTail;
+
+  for (; tail != head; ++tail) {
+    const uint32_t timestamp = edgeTimestamps[tail & (PULSE_EDGE_BUFFER_SIZE - 1)];
+
+    if (lastEdgeValid) {
+      periodStats.add(timestamp - lastEdgeTimestamp);
+    }
+    lastEdgeTimestamp = timestamp;
+    lastEdgeValid     = true;
+  }
+  edgeTail = tail;
+
+  if (overflow) {
+    // The buffer was full, so edges were also lost after the last processed edge
+    lastEdgeValid       = false;
+    edgeOverflowHandled = overflowCount;
+  }
+}
+
+void Internal_GPIO_pulseHelper::getPeriodStats(pulsePeriodStats_t& stats)
+{
+  processEdgeTimestamps();
+  stats = periodStats;
+  periodStats.clear();
+}
+
+#endif // if FEATURE_PULSE_PERIOD_STATS
+
 #ifdef PULSE_STATISTIC
 
 void Internal_GPIO_pulseHelper::updateStatisticalCounters(int par1) {
@@ -31,6 +31,44 @@
 #define PULSE_MODE_MASK         0x30
 #define MODE_INTERRUPT_MASK     0x03
 
+#if FEATURE_PULSE_PCNT
+
+// PCNT counter wraps to 0 when reaching this value
+# define PULSE_PCNT_HIGH_LIMIT  32767
+
+// Max. PCNT glitch filter, in APB clock cycles (80 MHz => 12.8 usec)
+# define PULSE_PCNT_MAX_FILTER  1023
+#endif // if FEATURE_PULSE_PCNT
+
+#if FEATURE_PULSE_PERIOD_STATS
+
+// Nr of edge timestamps buffered by the ISR, must be a power of 2.
+// Edges arriving while the buffer is full are still counted, but not used for the period statistics.
+# ifndef PULSE_EDGE_BUFFER_SIZE
+#  define PULSE_EDGE_BUFFER_SIZE  64
+# endif // ifndef PULSE_EDGE_BUFFER_SIZE
+
+// Statistics of the time between counted edges
+struct pulsePeriodStats_t {
+  void  clear();
+
+  void  add(uint32_t period_usec);
+
+  float mean_msec() const;
+  float min_msec() const;
+  float max_msec() const;
+
+  // Standard deviation of the period
+  float jitter_msec() const;
+
+  uint32_t count       = 0;
+  uint32_t min_usec    = 0;
+  uint32_t max_usec    = 0;
+  double   mean_usec   = 0.0; // Running mean and sum of squared differences (Welford)
+  double   sumSqr_usec = 0.0;
+};
+#endif // if FEATURE_PULSE_PERIOD_STATS
+
 
 // volatile counter variables for use in ISR
 struct pulseCounterISRdata_t {
@@ -106,12 +144,23 @@ struct Internal_GPIO_pulseHelper {
       return (static_cast<int>(interruptPinMode) & PULSE_MODE_MASK) == 0;
     }
 
+    // PCNT is only used for the edge modes, PULSE modes need the step processing
+    bool usePCNTmode() const {
+      #if FEATURE_PULSE_PCNT
+      return usePCNT && useEdgeMode() && (interruptPinMode != GPIOtriggerMode::None);
+      #else // if FEATURE_PULSE_PCNT
+      return false;
+      #endif // if FEATURE_PULSE_PCNT
+    }
+
     uint64_t        debounceTime_micros = 0; // 64 bit version of debounceTime in micoseconds
     uint16_t        debounceTime        = 0;
     taskIndex_t     taskIndex           = INVALID_TASK_INDEX;
     uint8_t         gpio                = -1;
     uint8_t         pullupPinMode       = INPUT_PULLUP;
     GPIOtriggerMode interruptPinMode    = GPIOtriggerMode::Change;
+    bool            usePCNT             = false; // Count with the PCNT peripheral instead of an ISR
+    bool            usePeriodStats      = false; // Keep edge timestamps for period statistics (edge modes only)
   };
 
 
@@ -130,6 +179,17 @@ struct Internal_GPIO_pulseHelper {
 
   void setPulseCountTotal(unsigned long pulseTotalCounter);
 
+#if FEATURE_PULSE_PERIOD_STATS
+
+  // Compute the periods of the edges buffered by the ISR.
+  // Typically from PLUGIN_TEN_PER_SECOND
+  void processEdgeTimestamps();
+
+  // Period statistics since the previous call, also starts a new interval.
+  // Typically from PLUGIN_READ
+  void getPeriodStats(pulsePeriodStats_t& stats);
+#endif // if FEATURE_PULSE_PERIOD_STATS
+
   void setPulseCounter(unsigned long pulseCounter,
                        float         pulseTime_msec = 0.0f);
 
@@ -160,6 +220,36 @@ private:
   static void ISR_edgeCheck(Internal_GPIO_pulseHelper *self);
   static void ISR_pulseCheck(Internal_GPIO_pulseHelper *self);
 
+#if FEATURE_PULSE_PCNT
+
+  bool        initPCNT();
+
+  // Add the pulses counted by the PCNT unit since the previous call
+  void        samplePCNT();
+
+  // Called when the PCNT counter wraps, so only once per PULSE_PCNT_HIGH_LIMIT pulses
+  static void ISR_PCNToverflow(void *arg);
+
+  volatile uint32_t pcntOverflowCount = 0;
+  uint32_t          pcntLastCount     = 0; // Last sampled (overflows * limit + counter)
+  uint64_t          pcntLastPulseTime = 0; // Time of the sample with the most recent counted pulses
+  int8_t            pcntUnit          = -1;
+#endif // if FEATURE_PULSE_PCNT
+
+#if FEATURE_PULSE_PERIOD_STATS
+
+  // Single producer (ISR), single consumer ring buffer of edge timestamps in usec.
+  // Only the ISR writes edgeHead, only processEdgeTimestamps() writes edgeTail.
+  uint32_t         *edgeTimestamps      = nullptr;
+  volatile uint32_t edgeHead            = 0;
+  volatile uint32_t edgeTail            = 0;
+  volatile uint32_t edgeOverflowCount   = 0; // Incremented by the ISR when the buffer is full
+  uint32_t          edgeOverflowHandled = 0;
+  uint32_t          lastEdgeTimestamp   = 0;
+  bool              lastEdgeValid       = false;
+  pulsePeriodStats_t periodStats;
+#endif // if FEATURE_PULSE_PERIOD_STATS
+
 
 
 public:
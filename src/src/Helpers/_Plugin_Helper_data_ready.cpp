@@ -0,0 +1,106 @@
+#include "../Helpers/_Plugin_Helper_data_ready.h"
+
+#include "../Globals/ESPEasy_Scheduler.h"
+#include "../Helpers/Hardware.h"
+
+#if FEATURE_PLUGIN_DATA_READY_PIN
+
+struct dataReadyPin_t {
+  volatile bool pending   = false; // Set from the ISR
+  int8_t        gpio      = -1;
+  bool          scheduled = false; // PLUGIN_TASKTIMER_IN scheduled, not yet handled
+};
+
+static dataReadyPin_t dataReadyPins[TASKS_MAX];
+
+static void IRAM_ATTR dataReadyPin_ISR(void *arg)
+{
+  static_cast<dataReadyPin_t *>(arg)->pending = true;
+}
+
+#endif // if FEATURE_PLUGIN_DATA_READY_PIN
+
+bool dataReadyPin_enable(taskIndex_t taskIndex, int8_t gpio, int mode)
+{
+  #if FEATURE_PLUGIN_DATA_READY_PIN
+
+  if (!validTaskIndex(taskIndex) || !validGpio(gpio) || (digitalPinToInterrupt(gpio) == NOT_AN_INTERRUPT)) {
+    return false;
+  }
+  dataReadyPin_disable(taskIndex);
+
+  dataReadyPin_t& drdy = dataReadyPins[taskIndex];
+
+  drdy.gpio = gpio;
+  pinMode(gpio, (mode == FALLING) ? INPUT_PULLUP : INPUT);
+  attachInterruptArg(digitalPinToInterrupt(gpio), dataReadyPin_ISR, &drdy, mode);
+
+  // The sensor may already have data available, signalled before the ISR was attached.
+  drdy.pending = (digitalRead(gpio) == ((mode == FALLING) ? LOW : HIGH));
+  return true;
+  #else // if FEATURE_PLUGIN_DATA_READY_PIN
+  return false;
+  #endif // if FEATURE_PLUGIN_DATA_READY_PIN
+}
+
+void dataReadyPin_disable(taskIndex_t taskIndex)
+{
+  #if FEATURE_PLUGIN_DATA_READY_PIN
+
+  if (!validTaskIndex(taskIndex)) {
+    return;
+  }
+  dataReadyPin_t& drdy = dataReadyPins[taskIndex];
+
+  if (drdy.gpio >= 0) {
+    detachInterrupt(digitalPinToInterrupt(drdy.gpio));
+  }
+  drdy.gpio      = -1;
+  drdy.pending   = false;
+  drdy.scheduled = false;
+  #endif // if FEATURE_PLUGIN_DATA_READY_PIN
+}
+
+bool dataReadyPin_enabled(taskIndex_t taskIndex)
+{
+  #if FEATURE_PLUGIN_DATA_READY_PIN
+  return validTaskIndex(taskIndex) && (dataReadyPins[taskIndex].gpio >= 0);
+  #else // if FEATURE_PLUGIN_DATA_READY_PIN
+  return false;
+  #endif // if FEATURE_PLUGIN_DATA_READY_PIN
+}
+
+bool dataReadyPin_triggered(taskIndex_t taskIndex)
+{
+  #if FEATURE_PLUGIN_DATA_READY_PIN
+
+  if (dataReadyPin_enabled(taskIndex)) {
+    dataReadyPin_t& drdy = dataReadyPins[taskIndex];
+
+    drdy.scheduled = false;
+
+    if (drdy.pending) {
+      // Clear before reading, an edge during the read will set it again.
+      drdy.pending = false;
+      return true;
+    }
+  }
+  #endif // if FEATURE_PLUGIN_DATA_READY_PIN
+  return false;
+}
+
+#if FEATURE_PLUGIN_DATA_READY_PIN
+
+void dataReadyPin_processEvents()
+{
+  for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; ++taskIndex) {
+    dataReadyPin_t& drdy = dataReadyPins[taskIndex];
+
+    if (drdy.pending && (drdy.gpio >= 0) && !drdy.scheduled) {
+      drdy.scheduled = true;
+      Scheduler.setPluginTaskTimer(0, taskIndex, DATA_READY_PIN_TASKTIMER_PAR1);
+    }
+  }
+}
+
+#endif // if FEATURE_PLUGIN_DATA_READY_PIN
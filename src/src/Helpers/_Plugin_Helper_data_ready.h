@@ -0,0 +1,53 @@
+#ifndef HELPERS__PLUGIN_HELPER_DATA_READY_H
+#define HELPERS__PLUGIN_HELPER_DATA_READY_H
+
+
+#include "../../ESPEasy_common.h"
+
+#include "../DataTypes/TaskIndex.h"
+
+
+// Par1 of the PLUGIN_TASKTIMER_IN call to wake a task when its data-ready pin fired
+#define DATA_READY_PIN_TASKTIMER_PAR1  0x4452
+
+/*********************************************************************************************\
+* Data-ready pin
+* Several sensors have an output signalling new data (DRDY, RDY, INT), which allows to only
+* access the sensor when there is something to read, instead of polling its status on a timer.
+* A task declares the GPIO and the active edge, a shared ISR only sets a per-task flag and
+* dataReadyPin_processEvents() in the main loop turns it into an immediate PLUGIN_TASKTIMER_IN
+* with Par1 = DATA_READY_PIN_TASKTIMER_PAR1.
+*
+* Typical use:
+*   PLUGIN_INIT:          dataReadyPin_enable(event->TaskIndex, P123_DRDY_PIN, RISING);
+*   PLUGIN_EXIT:          dataReadyPin_disable(event->TaskIndex);
+*   PLUGIN_TASKTIMER_IN:  if ((event->Par1 == DATA_READY_PIN_TASKTIMER_PAR1) && dataReadyPin_triggered(event->TaskIndex)) {
+*                           read the sensor
+*                         }
+*   Polling code:         skip polling the sensor when dataReadyPin_enabled(event->TaskIndex)
+*
+* When FEATURE_PLUGIN_DATA_READY_PIN is disabled, dataReadyPin_enable() returns false,
+* so the task keeps polling as before.
+\*********************************************************************************************/
+
+// @param mode  Active edge, RISING or FALLING. For FALLING the internal pull-up is enabled, as these outputs are often open drain.
+// @retval True when the pin is attached, otherwise the task must keep polling.
+bool dataReadyPin_enable(taskIndex_t taskIndex,
+                         int8_t      gpio,
+                         int         mode);
+
+void dataReadyPin_disable(taskIndex_t taskIndex);
+
+bool dataReadyPin_enabled(taskIndex_t taskIndex);
+
+// Return true (once) when the pin fired since the last call.
+bool dataReadyPin_triggered(taskIndex_t taskIndex);
+
+#if FEATURE_PLUGIN_DATA_READY_PIN
+
+// Schedule PLUGIN_TASKTIMER_IN for tasks with a fired data-ready pin, called from the main loop.
+void dataReadyPin_processEvents();
+#endif // if FEATURE_PLUGIN_DATA_READY_PIN
+
+
+#endif // ifndef HELPERS__PLUGIN_HELPER_DATA_READY_H
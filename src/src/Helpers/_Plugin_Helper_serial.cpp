@@ -7,6 +7,7 @@
 
 #include "../DataStructs/ESPEasy_EventStruct.h"
 #include "../Globals/Cache.h"
+#include "../Globals/ESPEasy_Scheduler.h"
 #include "../Helpers/StringConverter.h"
 #include "../Helpers/StringGenerator_GPIO.h"
 
@@ -436,4 +437,88 @@ uint8_t serialHelper_convertOldSerialConfig(uint8_t newLocationConfig) {
   return static_cast<uint8_t>(SERIAL_8N1 & 0xFF); // Some default
 }
 
+#if FEATURE_SERIAL_RX_EVENT
+
+struct serialHelper_rxEvent_t {
+  volatile bool pending        = false; // Set from the UART event task
+  bool          enabled        = false;
+  bool          scheduled      = false; // PLUGIN_TASKTIMER_IN scheduled, not yet handled
+  bool          checkAvailable = false; // Previous read may have left data in the buffer
+};
+
+static serialHelper_rxEvent_t serialHelper_rxEvents[TASKS_MAX];
+
+static void serialHelper_onReceive(void *arg) {
+  // Runs in the UART event task, so only set a flag.
+  static_cast<serialHelper_rxEvent_t *>(arg)->pending = true;
+}
+
+bool serialHelper_enableRxEvent(taskIndex_t taskIndex, ESPeasySerial& serial, uint8_t rxTimeout_symbols) {
+  if (!validTaskIndex(taskIndex)) {
+    return false;
+  }
+  serialHelper_rxEvent_t& rxEvent = serialHelper_rxEvents[taskIndex];
+
+  rxEvent.pending        = false;
+  rxEvent.scheduled      = false;
+  rxEvent.checkAvailable = true; // Data may have been received before enabling
+  rxEvent.enabled        = serial.setOnReceiveCallback(serialHelper_onReceive, &rxEvent, rxTimeout_symbols);
+  return rxEvent.enabled;
+}
+
+void serialHelper_disableRxEvent(taskIndex_t taskIndex, ESPeasySerial& serial) {
+  if (!validTaskIndex(taskIndex)) {
+    return;
+  }
+  serialHelper_rxEvent_t& rxEvent = serialHelper_rxEvents[taskIndex];
+
+  if (rxEvent.enabled) {
+    serial.setOnReceiveCallback(nullptr, nullptr, 0);
+  }
+  rxEvent.enabled = false;
+  rxEvent.pending = false;
+}
+
+void serialHelper_processRxEvents() {
+  for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; ++taskIndex) {
+    serialHelper_rxEvent_t& rxEvent = serialHelper_rxEvents[taskIndex];
+
+    if (rxEvent.pending && rxEvent.enabled && !rxEvent.scheduled) {
+      rxEvent.scheduled = true;
+      Scheduler.setPluginTaskTimer(0, taskIndex, SERIAL_RX_EVENT_TASKTIMER_PAR1);
+    }
+  }
+}
+
+#endif // if FEATURE_SERIAL_RX_EVENT
+
+bool serialHelper_rxDataReady(taskIndex_t taskIndex, ESPeasySerial& serial) {
+  #if FEATURE_SERIAL_RX_EVENT
+
+  if (validTaskIndex(taskIndex)) {
+    serialHelper_rxEvent_t& rxEvent = serialHelper_rxEvents[taskIndex];
+
+    if (rxEvent.enabled) {
+      rxEvent.scheduled = false;
+
+      if (rxEvent.pending) {
+        // Clear before reading, data received while reading will set it again.
+        rxEvent.pending        = false;
+        rxEvent.checkAvailable = true;
+        return true;
+      }
+
+      if (rxEvent.checkAvailable) {
+        if (serial.available() > 0) {
+          return true;
+        }
+        rxEvent.checkAvailable = false;
+      }
+      return false;
+    }
+  }
+  #endif // if FEATURE_SERIAL_RX_EVENT
+  return true;
+}
+
 #endif
\ No newline at end of file
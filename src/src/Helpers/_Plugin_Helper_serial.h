@@ -8,6 +8,8 @@
 
 #include <ESPeasySerial.h>
 
+#include "../DataTypes/TaskIndex.h"
+
 
 struct ESPeasySerialType;
 
@@ -73,6 +75,32 @@ uint8_t serialHelper_serialconfig_webformSave();
 // Used by some plugins, which used several TaskDevicePluginConfigLong
 uint8_t serialHelper_convertOldSerialConfig(uint8_t newLocationConfig);
 
+#if FEATURE_SERIAL_RX_EVENT
+
+// Par1 of the PLUGIN_TASKTIMER_IN call to wake a task when data was received
+# define SERIAL_RX_EVENT_TASKTIMER_PAR1  0x5E7A
+
+// Wake the task via PLUGIN_TASKTIMER_IN when data is received, instead of waiting for the next poll.
+// Must be called after the serial port is started.
+// @param rxTimeout_symbols  Only wake when the line was idle for this nr of symbols (end of frame), 0 = on every received chunk
+// @retval True when supported by the port, otherwise the task must keep polling.
+bool serialHelper_enableRxEvent(taskIndex_t    taskIndex,
+                                ESPeasySerial& serial,
+                                uint8_t        rxTimeout_symbols = 0);
+
+void serialHelper_disableRxEvent(taskIndex_t    taskIndex,
+                                 ESPeasySerial& serial);
+
+// Schedule PLUGIN_TASKTIMER_IN for tasks with received data, called from the main loop.
+void serialHelper_processRxEvents();
+#endif // if FEATURE_SERIAL_RX_EVENT
+
+// Check whether the task must read from its serial port.
+// Always true when RX events are not enabled for the task, so it keeps polling as before.
+// With RX events, only true when data was received, or data was left in the buffer by the previous read.
+bool serialHelper_rxDataReady(taskIndex_t    taskIndex,
+                              ESPeasySerial& serial);
+
 #endif // ifdef PLUGIN_USES_SERIAL
 
 #endif // ifndef HELPERS__PLUGIN_HELPER_SERIAL_H
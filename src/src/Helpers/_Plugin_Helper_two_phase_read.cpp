@@ -0,0 +1,37 @@
+#include "../Helpers/_Plugin_Helper_two_phase_read.h"
+
+#include "../Globals/ESPEasy_Scheduler.h"
+#include "../Helpers/ESPEasy_time_calc.h"
+
+
+PluginReadPhase_e PluginTwoPhaseRead::getPhase(taskIndex_t taskIndex)
+{
+  if (!_converting) {
+    // Keep the start of the first conversion, to re-align with the task interval when done.
+    _readStart = millis();
+    return PluginReadPhase_e::Start;
+  }
+
+  if (!timeOutReached(_readyAt)) {
+    // Called too early, e.g. via TaskRun
+    Scheduler.schedule_task_device_timer(taskIndex, _readyAt);
+    return PluginReadPhase_e::Wait;
+  }
+  _converting = false;
+
+  // Try to get in sync with the existing interval again.
+  Scheduler.reschedule_task_device_timer(taskIndex, _readStart);
+  return PluginReadPhase_e::Collect;
+}
+
+void PluginTwoPhaseRead::conversionStarted(taskIndex_t taskIndex, uint32_t conversionTime_ms)
+{
+  _readyAt    = millis() + conversionTime_ms;
+  _converting = true;
+  Scheduler.schedule_task_device_timer(taskIndex, _readyAt);
+}
+
+void PluginTwoPhaseRead::reset()
+{
+  _converting = false;
+}
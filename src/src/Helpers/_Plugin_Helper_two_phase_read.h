@@ -0,0 +1,61 @@
+#ifndef HELPERS__PLUGIN_HELPER_TWO_PHASE_READ_H
+#define HELPERS__PLUGIN_HELPER_TWO_PHASE_READ_H
+
+
+#include "../../ESPEasy_common.h"
+
+#include "../DataTypes/TaskIndex.h"
+
+
+enum class PluginReadPhase_e : uint8_t {
+  Start,   // Start a conversion and call conversionStarted()
+  Wait,    // Conversion not yet ready, PLUGIN_READ is rescheduled
+  Collect  // Conversion ready, read the result
+};
+
+/*********************************************************************************************\
+* Helper for sensors which need some time for a conversion.
+* Instead of blocking in PLUGIN_READ with a delay(), the read is split in 2 phases:
+* - Start:   Start the conversion and call conversionStarted() with the conversion time.
+*            The next PLUGIN_READ is scheduled at the moment the conversion is ready.
+*            PLUGIN_READ should return false, so no values are processed.
+* - Collect: Read the result and return true.
+*            The task timer is re-aligned with the interval, as if the read was not delayed.
+*            A plugin may call conversionStarted() again from the collect phase to chain conversions.
+*
+* Typical use in PLUGIN_READ:
+*   switch (data->readPhase.getPhase(event->TaskIndex)) {
+*     case PluginReadPhase_e::Start:
+*       if (data->startConversion()) { data->readPhase.conversionStarted(event->TaskIndex, conversionTime_ms); }
+*       break;
+*     case PluginReadPhase_e::Wait:
+*       break;
+*     case PluginReadPhase_e::Collect:
+*       success = data->collect(event);
+*       break;
+*   }
+\*********************************************************************************************/
+class PluginTwoPhaseRead {
+public:
+
+  PluginReadPhase_e getPhase(taskIndex_t taskIndex);
+
+  void              conversionStarted(taskIndex_t taskIndex,
+                                      uint32_t    conversionTime_ms);
+
+  bool              isConverting() const {
+    return _converting;
+  }
+
+  // Abort a running conversion, next read will start a new one.
+  void reset();
+
+private:
+
+  uint32_t _readStart  = 0;
+  uint32_t _readyAt    = 0;
+  bool     _converting = false;
+};
+
+
+#endif // ifndef HELPERS__PLUGIN_HELPER_TWO_PHASE_READ_H
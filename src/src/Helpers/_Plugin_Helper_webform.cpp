@@ -119,7 +119,7 @@ void SwitchWebformSave(
   // PCONFIG_LONG(2) = getFormItemInt(F("sw_elpmininterval"));
 
   // check if a task has been edited and remove 'task' bit from the previous pin
-  for (std::map<uint32_t, portStatusStruct>::iterator it = globalMapPortStatus.begin(); it != globalMapPortStatus.end(); ++it) {
+  for (auto it = globalMapPortStatus.begin(); it != globalMapPortStatus.end(); ++it) {
     if ((it->second.previousTask == TaskIndex) && (getPluginFromKey(it->first) == pluginID)) {
       globalMapPortStatus[it->first].previousTask = -1;
       removeTaskFromPort(it->first);
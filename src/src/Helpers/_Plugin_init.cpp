@@ -2,10 +2,17 @@
 
 #include "../../ESPEasy_common.h"
 
+#include "../DataStructs/ESPEasy_EventStruct.h"
+#include "../DataStructs/PluginTaskData_base.h"
+
+#include "../Globals/Cache.h"
 #include "../Globals/Device.h"
 #include "../Globals/Settings.h"
 
+#include "../Helpers/ESPEasy_time_calc.h"
+#include "../Helpers/EventTracer.h"
 #include "../Helpers/Misc.h"
+#include "../Helpers/SlowLoopDetector.h"
 
 
 // ********************************************************************************
@@ -2086,69 +2093,29 @@ constexpr const Plugin_ptr_t PROGMEM Plugin_ptr[] =
 
 constexpr size_t DeviceIndex_to_Plugin_id_size = NR_ELEMENTS(DeviceIndex_to_Plugin_id);
 
-// Lowest plugin ID included in the build
-constexpr size_t Lowest_Plugin_id = DeviceIndex_to_Plugin_id_size == 0 ? 0 : DeviceIndex_to_Plugin_id[0];
-
-// Highest plugin ID included in the build
-constexpr size_t Highest_Plugin_id = DeviceIndex_to_Plugin_id_size > 1 ? DeviceIndex_to_Plugin_id[DeviceIndex_to_Plugin_id_size - 1] : 0;
-
-// Array size including index of highest plugin ID.
-constexpr size_t Plugin_id_to_DeviceIndex_size = Highest_Plugin_id + 1 - Lowest_Plugin_id;
-
-// Array filled during init.
-// Valid index: 1 ... Highest_Plugin_id
-// Returns index to the DeviceIndex_to_Plugin_id array
-//
-// Vector size should is lowest pluginID ... highest pluginID
-deviceIndex_t Plugin_id_to_DeviceIndex[Plugin_id_to_DeviceIndex_size]{};
-
-// Used as lookup for getting an alfabetically sorted deviceIndex
-deviceIndex_t DeviceIndex_sorted[DeviceIndex_to_Plugin_id_size];
-
-
-size_t get_Plugin_id_to_DeviceIndex_arrayIndex(pluginID_t pluginID)
+// Constexpr binary search in DeviceIndex_to_Plugin_id, which is sorted on plugin ID.
+// Written as a single return statement to be accepted as C++11 constexpr function.
+constexpr uint8_t getDeviceIndex_from_PluginID_constexpr(unsigned pluginID,
+                                                         unsigned low  = 0,
+                                                         unsigned high = DeviceIndex_to_Plugin_id_size)
 {
-  if (pluginID.value >= Lowest_Plugin_id)
-  {
-    const size_t arrIndex = static_cast<size_t>(pluginID.value) - Lowest_Plugin_id;
-    if (arrIndex < Plugin_id_to_DeviceIndex_size) {
-      return arrIndex;
-    }
-  }
-  return Plugin_id_to_DeviceIndex_size;
+  return (low >= high) ? DEVICE_INDEX_MAX
+  : (DeviceIndex_to_Plugin_id[(low + high) / 2] == pluginID) ? (low + high) / 2
+  : (DeviceIndex_to_Plugin_id[(low + high) / 2] < pluginID)
+    ? getDeviceIndex_from_PluginID_constexpr(pluginID, (low + high) / 2 + 1, high)
+    : getDeviceIndex_from_PluginID_constexpr(pluginID, low, (low + high) / 2);
 }
 
+// Plugin_id_to_DeviceIndex and DeviceIndex_sorted are generated by tools/pio/generate-plugin-tables.py
+// as the plugin names needed for sorting are only known in the plugin .ino files.
+// Both are constexpr PROGMEM tables, so they do not need to be filled at boot.
+#include "../Helpers/_Plugin_init_tables.h"
 
-/*
-// TD-er: Test to make constexpr array Plugin_id_to_DeviceIndex
-// Have to postpone, since std::integer_sequence is not available in Espressif SDK
-
-// Constexpr functions to create Plugin_id_to_DeviceIndex at compile time
-constexpr uint8_t getDevId_from_PId(unsigned p_id, unsigned d_id) {
-  return (p_id == 0 || d_id == DeviceIndex_to_Plugin_id_size) ? DEVICE_INDEX_MAX
-  :  (p_id == DeviceIndex_to_Plugin_id[d_id]) ? d_id : getDevId_from_PId(p_id, d_id+1);
-}
-
-constexpr uint8_t getDevId_from_PId(unsigned p_id) {
-  return getDevId_from_PId(p_id, 0);
-}
-constexpr auto test = getDevId_from_PId(30);
+constexpr size_t Plugin_id_to_DeviceIndex_size = NR_ELEMENTS(Plugin_id_to_DeviceIndex);
 
+static_assert(NR_ELEMENTS(DeviceIndex_sorted) == DeviceIndex_to_Plugin_id_size,
+              "DeviceIndex_sorted incomplete, run tools/pio/generate-plugin-tables.py");
 
-#include <array>
-#include <utility>
-#include <type_traits>
-
-
-template <unsigned... Is>
-constexpr auto get_DevId_from_PId_array(std::integer_sequence<unsigned, Is...> a) -> std::array<uint8_t, a.size()> {
-    std::array<uint8_t, a.size()> vals{};
-    ((vals[Is] = getDevId_from_PId(Is)), ...);
-    return vals;
-}
-
-constexpr auto x = get_DevId_from_PId_array(std::make_integer_sequence<unsigned, Plugin_id_to_DeviceIndex_size>{});
-*/
 
 unsigned getNrBitsDeviceIndex()
 {
@@ -2164,10 +2131,9 @@ unsigned getNrBuiltInDeviceIndex()
 
 deviceIndex_t getDeviceIndex_from_PluginID(pluginID_t pluginID)
 {
-  const size_t arrayIndex = get_Plugin_id_to_DeviceIndex_arrayIndex(pluginID);
-  if (arrayIndex < Plugin_id_to_DeviceIndex_size)
+  if (pluginID.value < Plugin_id_to_DeviceIndex_size)
   {
-    return Plugin_id_to_DeviceIndex[arrayIndex];
+    return deviceIndex_t::toDeviceIndex(pgm_read_byte(Plugin_id_to_DeviceIndex + pluginID.value));
   }
   return INVALID_DEVICE_INDEX;
 }
@@ -2190,7 +2156,7 @@ bool validDeviceIndex_init(deviceIndex_t deviceIndex)
 deviceIndex_t getDeviceIndex_sorted(deviceIndex_t deviceIndex)
 {
   if (deviceIndex < DeviceIndex_to_Plugin_id_size) {
-    return DeviceIndex_sorted[deviceIndex.value];
+    return deviceIndex_t::toDeviceIndex(pgm_read_byte(DeviceIndex_sorted + deviceIndex.value));
   }
   return INVALID_DEVICE_INDEX;
 }
@@ -2200,8 +2166,24 @@ boolean PluginCall(deviceIndex_t deviceIndex, uint8_t function, struct EventStru
 {
   if (deviceIndex < DeviceIndex_to_Plugin_id_size)
   {
+    EVENT_TRACE_SCOPE(
+      Plugin,
+      (static_cast<uint32_t>(event != nullptr ? event->TaskIndex : INVALID_TASK_INDEX) << 16) |
+      (static_cast<uint32_t>(deviceIndex.value) << 8) |
+      function);
+    #if FEATURE_PLUGIN_TASKDATA_ARENA
+    PluginTaskDataArenaScope arenaScope(
+      (function == PLUGIN_INIT && event != nullptr) ? event->TaskIndex : INVALID_TASK_INDEX);
+    #endif // if FEATURE_PLUGIN_TASKDATA_ARENA
     Plugin_ptr_t plugin_call = (Plugin_ptr_t)pgm_read_ptr(Plugin_ptr + deviceIndex.value);
+    #if FEATURE_SLOW_LOOP_DETECTOR
+    const uint64_t callStart = getMicros64();
+    const bool     res       = plugin_call(function, event, string);
+    SlowLoop_pluginCall(event != nullptr ? event->TaskIndex : INVALID_TASK_INDEX, function, usecPassedSince(callStart));
+    return res;
+    #else // if FEATURE_SLOW_LOOP_DETECTOR
     return plugin_call(function, event, string);
+    #endif // if FEATURE_SLOW_LOOP_DETECTOR
   }
   return false;
 }
@@ -2213,10 +2195,6 @@ void PluginSetup()
 
   setupDone = true;
 
-  for (size_t id = 0; id < Plugin_id_to_DeviceIndex_size; ++id)
-  {
-    Plugin_id_to_DeviceIndex[id] = INVALID_DEVICE_INDEX;
-  }
   #ifdef ESP8266
   Device = new (std::nothrow) DeviceStruct[DeviceIndex_to_Plugin_id_size];
   #else
@@ -2228,41 +2206,15 @@ void PluginSetup()
     const pluginID_t pluginID = getPluginID_from_DeviceIndex(deviceIndex);
 
     if (validPluginID(pluginID)) { 
-      const size_t arrayIndex = get_Plugin_id_to_DeviceIndex_arrayIndex(pluginID);
-      if (arrayIndex < Plugin_id_to_DeviceIndex_size) {
-        // Should never be outside these limits.
-        Plugin_id_to_DeviceIndex[arrayIndex] = deviceIndex;
-        struct EventStruct TempEvent;
-        TempEvent.idx = deviceIndex.value;
-        String dummy;
-        PluginCall(deviceIndex, PLUGIN_DEVICE_ADD, &TempEvent, dummy);
-      }
+      struct EventStruct TempEvent;
+      TempEvent.idx = deviceIndex.value;
+      String dummy;
+      PluginCall(deviceIndex, PLUGIN_DEVICE_ADD, &TempEvent, dummy);
     }
   }
 #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("PLUGIN_DEVICE_ADD"));
 #endif
-
-  // ********************************************************************************
-  // Device Sort routine, actual sorting alfabetically by plugin name.
-  // Sorting does happen case sensitive.
-  // Used in device selector dropdown.
-  // ********************************************************************************
-
-  // First fill the existing number of the DeviceIndex.
-  for (deviceIndex_t x; x < DeviceIndex_to_Plugin_id_size; ++x) {
-    DeviceIndex_sorted[x.value] = x;
-  }
-
-  struct
-  {
-    bool operator()(deviceIndex_t a, deviceIndex_t b) const { 
-      return getPluginNameFromDeviceIndex(a) < 
-             getPluginNameFromDeviceIndex(b); 
-    }
-  }
-  customLess;
-  std::sort(DeviceIndex_sorted, DeviceIndex_sorted + DeviceIndex_to_Plugin_id_size, customLess);
 }
 
 void PluginInit(bool priorityOnly)
@@ -2274,6 +2226,7 @@ void PluginInit(bool priorityOnly)
       Settings.TaskDeviceEnabled[taskIndex] = false;
     }
   }
+  Cache.invalidateEnabledTasks();
 
 
   if (!priorityOnly) {
@@ -0,0 +1,854 @@
+// Generated by tools/pio/generate-plugin-tables.py, do not edit.
+// Included from _Plugin_init.cpp
+
+// Plugin ID to DeviceIndex, array index is the plugin ID.
+// Entries of plugins not included in the build are DEVICE_INDEX_MAX
+constexpr /*deviceIndex_t*/ uint8_t Plugin_id_to_DeviceIndex[] PROGMEM =
+{
+  getDeviceIndex_from_PluginID_constexpr(0),
+  getDeviceIndex_from_PluginID_constexpr(1),
+  getDeviceIndex_from_PluginID_constexpr(2),
+  getDeviceIndex_from_PluginID_constexpr(3),
+  getDeviceIndex_from_PluginID_constexpr(4),
+  getDeviceIndex_from_PluginID_constexpr(5),
+  getDeviceIndex_from_PluginID_constexpr(6),
+  getDeviceIndex_from_PluginID_constexpr(7),
+  getDeviceIndex_from_PluginID_constexpr(8),
+  getDeviceIndex_from_PluginID_constexpr(9),
+  getDeviceIndex_from_PluginID_constexpr(10),
+  getDeviceIndex_from_PluginID_constexpr(11),
+  getDeviceIndex_from_PluginID_constexpr(12),
+  getDeviceIndex_from_PluginID_constexpr(13),
+  getDeviceIndex_from_PluginID_constexpr(14),
+  getDeviceIndex_from_PluginID_constexpr(15),
+  getDeviceIndex_from_PluginID_constexpr(16),
+  getDeviceIndex_from_PluginID_constexpr(17),
+  getDeviceIndex_from_PluginID_constexpr(18),
+  getDeviceIndex_from_PluginID_constexpr(19),
+  getDeviceIndex_from_PluginID_constexpr(20),
+  getDeviceIndex_from_PluginID_constexpr(21),
+  getDeviceIndex_from_PluginID_constexpr(22),
+  getDeviceIndex_from_PluginID_constexpr(23),
+  getDeviceIndex_from_PluginID_constexpr(24),
+  getDeviceIndex_from_PluginID_constexpr(25),
+  getDeviceIndex_from_PluginID_constexpr(26),
+  getDeviceIndex_from_PluginID_constexpr(27),
+  getDeviceIndex_from_PluginID_constexpr(28),
+  getDeviceIndex_from_PluginID_constexpr(29),
+  getDeviceIndex_from_PluginID_constexpr(30),
+  getDeviceIndex_from_PluginID_constexpr(31),
+  getDeviceIndex_from_PluginID_constexpr(32),
+  getDeviceIndex_from_PluginID_constexpr(33),
+  getDeviceIndex_from_PluginID_constexpr(34),
+  getDeviceIndex_from_PluginID_constexpr(35),
+  getDeviceIndex_from_PluginID_constexpr(36),
+  getDeviceIndex_from_PluginID_constexpr(37),
+  getDeviceIndex_from_PluginID_constexpr(38),
+  getDeviceIndex_from_PluginID_constexpr(39),
+  getDeviceIndex_from_PluginID_constexpr(40),
+  getDeviceIndex_from_PluginID_constexpr(41),
+  getDeviceIndex_from_PluginID_constexpr(42),
+  getDeviceIndex_from_PluginID_constexpr(43),
+  getDeviceIndex_from_PluginID_constexpr(44),
+  getDeviceIndex_from_PluginID_constexpr(45),
+  getDeviceIndex_from_PluginID_constexpr(46),
+  getDeviceIndex_from_PluginID_constexpr(47),
+  getDeviceIndex_from_PluginID_constexpr(48),
+  getDeviceIndex_from_PluginID_constexpr(49),
+  getDeviceIndex_from_PluginID_constexpr(50),
+  getDeviceIndex_from_PluginID_constexpr(51),
+  getDeviceIndex_from_PluginID_constexpr(52),
+  getDeviceIndex_from_PluginID_constexpr(53),
+  getDeviceIndex_from_PluginID_constexpr(54),
+  getDeviceIndex_from_PluginID_constexpr(55),
+  getDeviceIndex_from_PluginID_constexpr(56),
+  getDeviceIndex_from_PluginID_constexpr(57),
+  getDeviceIndex_from_PluginID_constexpr(58),
+  getDeviceIndex_from_PluginID_constexpr(59),
+  getDeviceIndex_from_PluginID_constexpr(60),
+  getDeviceIndex_from_PluginID_constexpr(61),
+  getDeviceIndex_from_PluginID_constexpr(62),
+  getDeviceIndex_from_PluginID_constexpr(63),
+  getDeviceIndex_from_PluginID_constexpr(64),
+  getDeviceIndex_from_PluginID_constexpr(65),
+  getDeviceIndex_from_PluginID_constexpr(66),
+  getDeviceIndex_from_PluginID_constexpr(67),
+  getDeviceIndex_from_PluginID_constexpr(68),
+  getDeviceIndex_from_PluginID_constexpr(69),
+  getDeviceIndex_from_PluginID_constexpr(70),
+  getDeviceIndex_from_PluginID_constexpr(71),
+  getDeviceIndex_from_PluginID_constexpr(72),
+  getDeviceIndex_from_PluginID_constexpr(73),
+  getDeviceIndex_from_PluginID_constexpr(74),
+  getDeviceIndex_from_PluginID_constexpr(75),
+  getDeviceIndex_from_PluginID_constexpr(76),
+  getDeviceIndex_from_PluginID_constexpr(77),
+  getDeviceIndex_from_PluginID_constexpr(78),
+  getDeviceIndex_from_PluginID_constexpr(79),
+  getDeviceIndex_from_PluginID_constexpr(80),
+  getDeviceIndex_from_PluginID_constexpr(81),
+  getDeviceIndex_from_PluginID_constexpr(82),
+  getDeviceIndex_from_PluginID_constexpr(83),
+  getDeviceIndex_from_PluginID_constexpr(84),
+  getDeviceIndex_from_PluginID_constexpr(85),
+  getDeviceIndex_from_PluginID_constexpr(86),
+  getDeviceIndex_from_PluginID_constexpr(87),
+  getDeviceIndex_from_PluginID_constexpr(88),
+  getDeviceIndex_from_PluginID_constexpr(89),
+  getDeviceIndex_from_PluginID_constexpr(90),
+  getDeviceIndex_from_PluginID_constexpr(91),
+  getDeviceIndex_from_PluginID_constexpr(92),
+  getDeviceIndex_from_PluginID_constexpr(93),
+  getDeviceIndex_from_PluginID_constexpr(94),
+  getDeviceIndex_from_PluginID_constexpr(95),
+  getDeviceIndex_from_PluginID_constexpr(96),
+  getDeviceIndex_from_PluginID_constexpr(97),
+  getDeviceIndex_from_PluginID_constexpr(98),
+  getDeviceIndex_from_PluginID_constexpr(99),
+  getDeviceIndex_from_PluginID_constexpr(100),
+  getDeviceIndex_from_PluginID_constexpr(101),
+  getDeviceIndex_from_PluginID_constexpr(102),
+  getDeviceIndex_from_PluginID_constexpr(103),
+  getDeviceIndex_from_PluginID_constexpr(104),
+  getDeviceIndex_from_PluginID_constexpr(105),
+  getDeviceIndex_from_PluginID_constexpr(106),
+  getDeviceIndex_from_PluginID_constexpr(107),
+  getDeviceIndex_from_PluginID_constexpr(108),
+  getDeviceIndex_from_PluginID_constexpr(109),
+  getDeviceIndex_from_PluginID_constexpr(110),
+  getDeviceIndex_from_PluginID_constexpr(111),
+  getDeviceIndex_from_PluginID_constexpr(112),
+  getDeviceIndex_from_PluginID_constexpr(113),
+  getDeviceIndex_from_PluginID_constexpr(114),
+  getDeviceIndex_from_PluginID_constexpr(115),
+  getDeviceIndex_from_PluginID_constexpr(116),
+  getDeviceIndex_from_PluginID_constexpr(117),
+  getDeviceIndex_from_PluginID_constexpr(118),
+  getDeviceIndex_from_PluginID_constexpr(119),
+  getDeviceIndex_from_PluginID_constexpr(120),
+  getDeviceIndex_from_PluginID_constexpr(121),
+  getDeviceIndex_from_PluginID_constexpr(122),
+  getDeviceIndex_from_PluginID_constexpr(123),
+  getDeviceIndex_from_PluginID_constexpr(124),
+  getDeviceIndex_from_PluginID_constexpr(125),
+  getDeviceIndex_from_PluginID_constexpr(126),
+  getDeviceIndex_from_PluginID_constexpr(127),
+  getDeviceIndex_from_PluginID_constexpr(128),
+  getDeviceIndex_from_PluginID_constexpr(129),
+  getDeviceIndex_from_PluginID_constexpr(130),
+  getDeviceIndex_from_PluginID_constexpr(131),
+  getDeviceIndex_from_PluginID_constexpr(132),
+  getDeviceIndex_from_PluginID_constexpr(133),
+  getDeviceIndex_from_PluginID_constexpr(134),
+  getDeviceIndex_from_PluginID_constexpr(135),
+  getDeviceIndex_from_PluginID_constexpr(136),
+  getDeviceIndex_from_PluginID_constexpr(137),
+  getDeviceIndex_from_PluginID_constexpr(138),
+  getDeviceIndex_from_PluginID_constexpr(139),
+  getDeviceIndex_from_PluginID_constexpr(140),
+  getDeviceIndex_from_PluginID_constexpr(141),
+  getDeviceIndex_from_PluginID_constexpr(142),
+  getDeviceIndex_from_PluginID_constexpr(143),
+  getDeviceIndex_from_PluginID_constexpr(144),
+  getDeviceIndex_from_PluginID_constexpr(145),
+  getDeviceIndex_from_PluginID_constexpr(146),
+  getDeviceIndex_from_PluginID_constexpr(147),
+  getDeviceIndex_from_PluginID_constexpr(148),
+  getDeviceIndex_from_PluginID_constexpr(149),
+  getDeviceIndex_from_PluginID_constexpr(150),
+  getDeviceIndex_from_PluginID_constexpr(151),
+  getDeviceIndex_from_PluginID_constexpr(152),
+  getDeviceIndex_from_PluginID_constexpr(153),
+  getDeviceIndex_from_PluginID_constexpr(154),
+  getDeviceIndex_from_PluginID_constexpr(155),
+  getDeviceIndex_from_PluginID_constexpr(156),
+  getDeviceIndex_from_PluginID_constexpr(157),
+  getDeviceIndex_from_PluginID_constexpr(158),
+  getDeviceIndex_from_PluginID_constexpr(159),
+  getDeviceIndex_from_PluginID_constexpr(160),
+  getDeviceIndex_from_PluginID_constexpr(161),
+  getDeviceIndex_from_PluginID_constexpr(162),
+  getDeviceIndex_from_PluginID_constexpr(163),
+  getDeviceIndex_from_PluginID_constexpr(164),
+  getDeviceIndex_from_PluginID_constexpr(165),
+  getDeviceIndex_from_PluginID_constexpr(166),
+  getDeviceIndex_from_PluginID_constexpr(167),
+  getDeviceIndex_from_PluginID_constexpr(168),
+  getDeviceIndex_from_PluginID_constexpr(169),
+  getDeviceIndex_from_PluginID_constexpr(170),
+  getDeviceIndex_from_PluginID_constexpr(171),
+  getDeviceIndex_from_PluginID_constexpr(172),
+  getDeviceIndex_from_PluginID_constexpr(173),
+  getDeviceIndex_from_PluginID_constexpr(174),
+  getDeviceIndex_from_PluginID_constexpr(175),
+  getDeviceIndex_from_PluginID_constexpr(176),
+  getDeviceIndex_from_PluginID_constexpr(177),
+  getDeviceIndex_from_PluginID_constexpr(178),
+  getDeviceIndex_from_PluginID_constexpr(179),
+  getDeviceIndex_from_PluginID_constexpr(180),
+  getDeviceIndex_from_PluginID_constexpr(181),
+  getDeviceIndex_from_PluginID_constexpr(182),
+  getDeviceIndex_from_PluginID_constexpr(183),
+  getDeviceIndex_from_PluginID_constexpr(184),
+  getDeviceIndex_from_PluginID_constexpr(185),
+  getDeviceIndex_from_PluginID_constexpr(186),
+  getDeviceIndex_from_PluginID_constexpr(187),
+  getDeviceIndex_from_PluginID_constexpr(188),
+  getDeviceIndex_from_PluginID_constexpr(189),
+  getDeviceIndex_from_PluginID_constexpr(190),
+  getDeviceIndex_from_PluginID_constexpr(191),
+  getDeviceIndex_from_PluginID_constexpr(192),
+  getDeviceIndex_from_PluginID_constexpr(193),
+  getDeviceIndex_from_PluginID_constexpr(194),
+  getDeviceIndex_from_PluginID_constexpr(195),
+  getDeviceIndex_from_PluginID_constexpr(196),
+  getDeviceIndex_from_PluginID_constexpr(197),
+  getDeviceIndex_from_PluginID_constexpr(198),
+  getDeviceIndex_from_PluginID_constexpr(199),
+  getDeviceIndex_from_PluginID_constexpr(200),
+  getDeviceIndex_from_PluginID_constexpr(201),
+  getDeviceIndex_from_PluginID_constexpr(202),
+  getDeviceIndex_from_PluginID_constexpr(203),
+  getDeviceIndex_from_PluginID_constexpr(204),
+  getDeviceIndex_from_PluginID_constexpr(205),
+  getDeviceIndex_from_PluginID_constexpr(206),
+  getDeviceIndex_from_PluginID_constexpr(207),
+  getDeviceIndex_from_PluginID_constexpr(208),
+  getDeviceIndex_from_PluginID_constexpr(209),
+  getDeviceIndex_from_PluginID_constexpr(210),
+  getDeviceIndex_from_PluginID_constexpr(211),
+  getDeviceIndex_from_PluginID_constexpr(212),
+  getDeviceIndex_from_PluginID_constexpr(213),
+  getDeviceIndex_from_PluginID_constexpr(214),
+  getDeviceIndex_from_PluginID_constexpr(215),
+  getDeviceIndex_from_PluginID_constexpr(216),
+  getDeviceIndex_from_PluginID_constexpr(217),
+  getDeviceIndex_from_PluginID_constexpr(218),
+  getDeviceIndex_from_PluginID_constexpr(219),
+  getDeviceIndex_from_PluginID_constexpr(220),
+  getDeviceIndex_from_PluginID_constexpr(221),
+  getDeviceIndex_from_PluginID_constexpr(222),
+  getDeviceIndex_from_PluginID_constexpr(223),
+  getDeviceIndex_from_PluginID_constexpr(224),
+  getDeviceIndex_from_PluginID_constexpr(225),
+  getDeviceIndex_from_PluginID_constexpr(226),
+  getDeviceIndex_from_PluginID_constexpr(227),
+  getDeviceIndex_from_PluginID_constexpr(228),
+  getDeviceIndex_from_PluginID_constexpr(229),
+  getDeviceIndex_from_PluginID_constexpr(230),
+  getDeviceIndex_from_PluginID_constexpr(231),
+  getDeviceIndex_from_PluginID_constexpr(232),
+  getDeviceIndex_from_PluginID_constexpr(233),
+  getDeviceIndex_from_PluginID_constexpr(234),
+  getDeviceIndex_from_PluginID_constexpr(235),
+  getDeviceIndex_from_PluginID_constexpr(236),
+  getDeviceIndex_from_PluginID_constexpr(237),
+  getDeviceIndex_from_PluginID_constexpr(238),
+  getDeviceIndex_from_PluginID_constexpr(239),
+  getDeviceIndex_from_PluginID_constexpr(240),
+  getDeviceIndex_from_PluginID_constexpr(241),
+  getDeviceIndex_from_PluginID_constexpr(242),
+  getDeviceIndex_from_PluginID_constexpr(243),
+  getDeviceIndex_from_PluginID_constexpr(244),
+  getDeviceIndex_from_PluginID_constexpr(245),
+  getDeviceIndex_from_PluginID_constexpr(246),
+  getDeviceIndex_from_PluginID_constexpr(247),
+  getDeviceIndex_from_PluginID_constexpr(248),
+  getDeviceIndex_from_PluginID_constexpr(249),
+  getDeviceIndex_from_PluginID_constexpr(250),
+  getDeviceIndex_from_PluginID_constexpr(251),
+  getDeviceIndex_from_PluginID_constexpr(252),
+  getDeviceIndex_from_PluginID_constexpr(253),
+  getDeviceIndex_from_PluginID_constexpr(254),
+  getDeviceIndex_from_PluginID_constexpr(255),
+};
+
+// DeviceIndex alfabetically sorted on plugin name (case sensitive).
+// Used in device selector dropdown.
+constexpr /*deviceIndex_t*/ uint8_t DeviceIndex_sorted[] PROGMEM =
+{
+#ifdef USES_P120
+  getDeviceIndex_from_PluginID_constexpr(120), // Accelerometer - ADXL345 (I2C)
+#endif // ifdef USES_P120
+
+#ifdef USES_P125
+  getDeviceIndex_from_PluginID_constexpr(125), // Accelerometer - ADXL345 (SPI)
+#endif // ifdef USES_P125
+
+#ifdef USES_P025
+  getDeviceIndex_from_PluginID_constexpr(25), // Analog input - ADS1x15
+#endif // ifdef USES_P025
+
+#ifdef USES_P060
+  getDeviceIndex_from_PluginID_constexpr(60), // Analog input - MCP3221
+#endif // ifdef USES_P060
+
+#ifdef USES_P007
+  getDeviceIndex_from_PluginID_constexpr(7), // Analog input - PCF8591
+#endif // ifdef USES_P007
+
+#ifdef USES_P002
+  getDeviceIndex_from_PluginID_constexpr(2), // Analog input - internal
+#endif // ifdef USES_P002
+
+#ifdef USES_P112
+  getDeviceIndex_from_PluginID_constexpr(112), // Color - AS7265X
+#endif // ifdef USES_P112
+
+#ifdef USES_P050
+  getDeviceIndex_from_PluginID_constexpr(50), // Color - TCS34725
+#endif // ifdef USES_P050
+
+#ifdef USES_P066
+  getDeviceIndex_from_PluginID_constexpr(66), // Color - VEML6040
+#endif // ifdef USES_P066
+
+#ifdef USES_P094
+  getDeviceIndex_from_PluginID_constexpr(94), // Communication - CUL Reader
+#endif // ifdef USES_P094
+
+#ifdef USES_P054
+  getDeviceIndex_from_PluginID_constexpr(54), // Communication - DMX512 TX
+#endif // ifdef USES_P054
+
+#ifdef USES_P016
+  getDeviceIndex_from_PluginID_constexpr(16), // Communication - IR Receive (TSOP4838)
+#endif // ifdef USES_P016
+
+#ifdef USES_P035
+  getDeviceIndex_from_PluginID_constexpr(35), // Communication - IR Transmit
+#endif // ifdef USES_P035
+
+#ifdef USES_P118
+  getDeviceIndex_from_PluginID_constexpr(118), // Communication - Itho ventilation
+#endif // ifdef USES_P118
+
+#ifdef USES_P071
+  getDeviceIndex_from_PluginID_constexpr(71), // Communication - Kamstrup Multical 401
+#endif // ifdef USES_P071
+
+#ifdef USES_P044
+  getDeviceIndex_from_PluginID_constexpr(44), // Communication - P1 Wifi Gateway
+#endif // ifdef USES_P044
+
+#ifdef USES_P089
+  getDeviceIndex_from_PluginID_constexpr(89), // Communication - Ping
+#endif // ifdef USES_P089
+
+#ifdef USES_P087
+  getDeviceIndex_from_PluginID_constexpr(87), // Communication - Serial Proxy
+#endif // ifdef USES_P087
+
+#ifdef USES_P020
+  getDeviceIndex_from_PluginID_constexpr(20), // Communication - Serial Server
+#endif // ifdef USES_P020
+
+#ifdef USES_P101
+  getDeviceIndex_from_PluginID_constexpr(101), // Communication - Wake On LAN
+#endif // ifdef USES_P101
+
+#ifdef USES_P073
+  getDeviceIndex_from_PluginID_constexpr(73), // Display - 7-segment display
+#endif // ifdef USES_P073
+
+#ifdef USES_P057
+  getDeviceIndex_from_PluginID_constexpr(57), // Display - HT16K33
+#endif // ifdef USES_P057
+
+#ifdef USES_P012
+  getDeviceIndex_from_PluginID_constexpr(12), // Display - LCD2004
+#endif // ifdef USES_P012
+
+#ifdef USES_P104
+  getDeviceIndex_from_PluginID_constexpr(104), // Display - MAX7219 dot matrix
+#endif // ifdef USES_P104
+
+#ifdef USES_P131
+  getDeviceIndex_from_PluginID_constexpr(131), // Display - NeoPixel Matrix
+#endif // ifdef USES_P131
+
+#ifdef USES_P075
+  getDeviceIndex_from_PluginID_constexpr(75), // Display - Nextion
+#endif // ifdef USES_P075
+
+#ifdef USES_P023
+  getDeviceIndex_from_PluginID_constexpr(23), // Display - OLED SSD1306
+#endif // ifdef USES_P023
+
+#ifdef USES_P036
+  getDeviceIndex_from_PluginID_constexpr(36), // Display - OLED SSD1306/SH1106 Framed
+#endif // ifdef USES_P036
+
+#ifdef USES_P109
+  getDeviceIndex_from_PluginID_constexpr(109), // Display - OLED SSD1306/SH1106 Thermo
+#endif // ifdef USES_P109
+
+#ifdef USES_P141
+  getDeviceIndex_from_PluginID_constexpr(141), // Display - PCD8544 Nokia 5110 LCD
+#endif // ifdef USES_P141
+
+#ifdef USES_P148
+  getDeviceIndex_from_PluginID_constexpr(148), // Display - POWR3xxD/THR3xxD
+#endif // ifdef USES_P148
+
+#ifdef USES_P116
+  getDeviceIndex_from_PluginID_constexpr(116), // Display - ST77xx TFT
+#endif // ifdef USES_P116
+
+#ifdef USES_P095
+  getDeviceIndex_from_PluginID_constexpr(95), // Display - TFT ILI934x/ILI948x
+#endif // ifdef USES_P095
+
+#ifdef USES_P096
+  getDeviceIndex_from_PluginID_constexpr(96), // Display - eInk with Lolin ePaper screen
+#endif // ifdef USES_P096
+
+#ifdef USES_P134
+  getDeviceIndex_from_PluginID_constexpr(134), // Distance - A02YYUW
+#endif // ifdef USES_P134
+
+#ifdef USES_P110
+  getDeviceIndex_from_PluginID_constexpr(110), // Distance - VL53L0X (200cm)
+#endif // ifdef USES_P110
+
+#ifdef USES_P113
+  getDeviceIndex_from_PluginID_constexpr(113), // Distance - VL53L1X (400cm)
+#endif // ifdef USES_P113
+
+#ifdef USES_P144
+  getDeviceIndex_from_PluginID_constexpr(144), // Dust - PM1006(K) (Vindriktning)
+#endif // ifdef USES_P144
+
+#ifdef USES_P053
+  getDeviceIndex_from_PluginID_constexpr(53), // Dust - PMSx003
+#endif // ifdef USES_P053
+
+#ifdef USES_P056
+  getDeviceIndex_from_PluginID_constexpr(56), // Dust - SDS011/018/198
+#endif // ifdef USES_P056
+
+#ifdef USES_P018
+  getDeviceIndex_from_PluginID_constexpr(18), // Dust - Sharp GP2Y10
+#endif // ifdef USES_P018
+
+#ifdef USES_P077
+  getDeviceIndex_from_PluginID_constexpr(77), // Energy (AC) - CSE7766 (POW r2)
+#endif // ifdef USES_P077
+
+#ifdef USES_P108
+  getDeviceIndex_from_PluginID_constexpr(108), // Energy (AC) - DDS238-x ZN
+#endif // ifdef USES_P108
+
+#ifdef USES_P078
+  getDeviceIndex_from_PluginID_constexpr(78), // Energy (AC) - Eastron SDMxxx Modbus
+#endif // ifdef USES_P078
+
+#ifdef USES_P076
+  getDeviceIndex_from_PluginID_constexpr(76), // Energy (AC) - HLW8012/BL0937
+#endif // ifdef USES_P076
+
+#ifdef USES_P102
+  getDeviceIndex_from_PluginID_constexpr(102), // Energy (AC) - PZEM-004Tv30-Multiple
+#endif // ifdef USES_P102
+
+#ifdef USES_P027
+  getDeviceIndex_from_PluginID_constexpr(27), // Energy (DC) - INA219
+#endif // ifdef USES_P027
+
+#ifdef USES_P132
+  getDeviceIndex_from_PluginID_constexpr(132), // Energy (DC) - INA3221
+#endif // ifdef USES_P132
+
+#ifdef USES_P088
+  getDeviceIndex_from_PluginID_constexpr(88), // Energy (Heat) - Heatpump IR transmitter
+#endif // ifdef USES_P088
+
+#ifdef USES_P093
+  getDeviceIndex_from_PluginID_constexpr(93), // Energy (Heat) - Mitsubishi Heat Pump
+#endif // ifdef USES_P093
+
+#ifdef USES_P085
+  getDeviceIndex_from_PluginID_constexpr(85), // Energy - AccuEnergy AcuDC24x
+#endif // ifdef USES_P085
+
+#ifdef USES_P115
+  getDeviceIndex_from_PluginID_constexpr(115), // Energy - Fuel Gauge MAX1704x
+#endif // ifdef USES_P115
+
+#ifdef USES_P004
+  getDeviceIndex_from_PluginID_constexpr(4), // Environment - 1-Wire Temperature
+#endif // ifdef USES_P004
+
+#ifdef USES_P105
+  getDeviceIndex_from_PluginID_constexpr(105), // Environment - AHT10/AHT2x
+#endif // ifdef USES_P105
+
+#ifdef USES_P051
+  getDeviceIndex_from_PluginID_constexpr(51), // Environment - AM2320
+#endif // ifdef USES_P051
+
+#ifdef USES_P103
+  getDeviceIndex_from_PluginID_constexpr(103), // Environment - Atlas EZO pH ORP EC DO
+#endif // ifdef USES_P103
+
+#ifdef USES_P106
+  getDeviceIndex_from_PluginID_constexpr(106), // Environment - BME68x
+#endif // ifdef USES_P106
+
+#ifdef USES_P006
+  getDeviceIndex_from_PluginID_constexpr(6), // Environment - BMP085/180
+#endif // ifdef USES_P006
+
+#ifdef USES_P154
+  getDeviceIndex_from_PluginID_constexpr(154), // Environment - BMP3xx
+#endif // ifdef USES_P154
+
+#ifdef USES_P028
+  getDeviceIndex_from_PluginID_constexpr(28), // Environment - BMx280
+#endif // ifdef USES_P028
+
+#ifdef USES_P005
+  getDeviceIndex_from_PluginID_constexpr(5), // Environment - DHT11/12/22  SONOFF2301/7021/MS01
+#endif // ifdef USES_P005
+
+#ifdef USES_P034
+  getDeviceIndex_from_PluginID_constexpr(34), // Environment - DHT12 (I2C)
+#endif // ifdef USES_P034
+
+#ifdef USES_P072
+  getDeviceIndex_from_PluginID_constexpr(72), // Environment - HDC10xx (I2C)
+#endif // ifdef USES_P072
+
+#ifdef USES_P151
+  getDeviceIndex_from_PluginID_constexpr(151), // Environment - I2C Honeywell Pressure
+#endif // ifdef USES_P151
+
+#ifdef USES_P069
+  getDeviceIndex_from_PluginID_constexpr(69), // Environment - LM75A
+#endif // ifdef USES_P069
+
+#ifdef USES_P024
+  getDeviceIndex_from_PluginID_constexpr(24), // Environment - MLX90614
+#endif // ifdef USES_P024
+
+#ifdef USES_P032
+  getDeviceIndex_from_PluginID_constexpr(32), // Environment - MS5611 (GY-63)
+#endif // ifdef USES_P032
+
+#ifdef USES_P031
+  getDeviceIndex_from_PluginID_constexpr(31), // Environment - SHT1x
+#endif // ifdef USES_P031
+
+#ifdef USES_P122
+  getDeviceIndex_from_PluginID_constexpr(122), // Environment - SHT2x
+#endif // ifdef USES_P122
+
+#ifdef USES_P068
+  getDeviceIndex_from_PluginID_constexpr(68), // Environment - SHT3x
+#endif // ifdef USES_P068
+
+#ifdef USES_P153
+  getDeviceIndex_from_PluginID_constexpr(153), // Environment - SHT4x
+#endif // ifdef USES_P153
+
+#ifdef USES_P014
+  getDeviceIndex_from_PluginID_constexpr(14), // Environment - SI70xx/HTU21D
+#endif // ifdef USES_P014
+
+#ifdef USES_P047
+  getDeviceIndex_from_PluginID_constexpr(47), // Environment - Soil moisture sensor
+#endif // ifdef USES_P047
+
+#ifdef USES_P150
+  getDeviceIndex_from_PluginID_constexpr(150), // Environment - TMP117 Temperature
+#endif // ifdef USES_P150
+
+#ifdef USES_P039
+  getDeviceIndex_from_PluginID_constexpr(39), // Environment - Thermosensors
+#endif // ifdef USES_P039
+
+#ifdef USES_P022
+  getDeviceIndex_from_PluginID_constexpr(22), // Extra IO - PCA9685
+#endif // ifdef USES_P022
+
+#ifdef USES_P011
+  getDeviceIndex_from_PluginID_constexpr(11), // Extra IO - ProMini Extender
+#endif // ifdef USES_P011
+
+#ifdef USES_P090
+  getDeviceIndex_from_PluginID_constexpr(90), // Gases - CCS811 TVOC/eCO2
+#endif // ifdef USES_P090
+
+#ifdef USES_P127
+  getDeviceIndex_from_PluginID_constexpr(127), // Gases - CO2 CDM7160
+#endif // ifdef USES_P127
+
+#ifdef USES_P049
+  getDeviceIndex_from_PluginID_constexpr(49), // Gases - CO2 MH-Z19
+#endif // ifdef USES_P049
+
+#ifdef USES_P117
+  getDeviceIndex_from_PluginID_constexpr(117), // Gases - CO2 SCD30
+#endif // ifdef USES_P117
+
+#ifdef USES_P135
+  getDeviceIndex_from_PluginID_constexpr(135), // Gases - CO2 SCD4x
+#endif // ifdef USES_P135
+
+#ifdef USES_P052
+  getDeviceIndex_from_PluginID_constexpr(52), // Gases - CO2 Senseair
+#endif // ifdef USES_P052
+
+#ifdef USES_P145
+  getDeviceIndex_from_PluginID_constexpr(145), // Gases - MQxxx (MQ135 CO2, MQ3 Alcohol) [TESTING]
+#endif // ifdef USES_P145
+
+#ifdef USES_P083
+  getDeviceIndex_from_PluginID_constexpr(83), // Gases - SGP30 TVOC/eCO2
+#endif // ifdef USES_P083
+
+#ifdef USES_P147
+  getDeviceIndex_from_PluginID_constexpr(147), // Gases - SGP4x VOC(/NOx)
+#endif // ifdef USES_P147
+
+#ifdef USES_P081
+  getDeviceIndex_from_PluginID_constexpr(81), // Generic - CRON
+#endif // ifdef USES_P081
+
+#ifdef USES_P146
+  getDeviceIndex_from_PluginID_constexpr(146), // Generic - Cache Reader
+#endif // ifdef USES_P146
+
+#ifdef USES_P033
+  getDeviceIndex_from_PluginID_constexpr(33), // Generic - Dummy Device
+#endif // ifdef USES_P033
+
+#ifdef USES_P086
+  getDeviceIndex_from_PluginID_constexpr(86), // Generic - Homie receiver
+#endif // ifdef USES_P086
+
+#ifdef USES_P037
+  getDeviceIndex_from_PluginID_constexpr(37), // Generic - MQTT Import
+#endif // ifdef USES_P037
+
+#ifdef USES_P003
+  getDeviceIndex_from_PluginID_constexpr(3), // Generic - Pulse counter
+#endif // ifdef USES_P003
+
+#ifdef USES_P026
+  getDeviceIndex_from_PluginID_constexpr(26), // Generic - System Info
+#endif // ifdef USES_P026
+
+#ifdef USES_P064
+  getDeviceIndex_from_PluginID_constexpr(64), // Gesture - APDS9960
+#endif // ifdef USES_P064
+
+#ifdef USES_P119
+  getDeviceIndex_from_PluginID_constexpr(119), // Gyro - ITG3205
+#endif // ifdef USES_P119
+
+#ifdef USES_P045
+  getDeviceIndex_from_PluginID_constexpr(45), // Gyro - MPU 6050
+#endif // ifdef USES_P045
+
+#ifdef USES_P046
+  getDeviceIndex_from_PluginID_constexpr(46), // Hardware - Ventus W266
+#endif // ifdef USES_P046
+
+#ifdef USES_P092
+  getDeviceIndex_from_PluginID_constexpr(92), // Heating - DL-Bus (Technische Alternative)
+#endif // ifdef USES_P092
+
+#ifdef USES_P129
+  getDeviceIndex_from_PluginID_constexpr(129), // Input - Shift registers (74HC165)
+#endif // ifdef USES_P129
+
+#ifdef USES_P080
+  getDeviceIndex_from_PluginID_constexpr(80), // Input - iButton
+#endif // ifdef USES_P080
+
+#ifdef USES_P058
+  getDeviceIndex_from_PluginID_constexpr(58), // Keypad - HT16K33
+#endif // ifdef USES_P058
+
+#ifdef USES_P062
+  getDeviceIndex_from_PluginID_constexpr(62), // Keypad - MPR121 Touch
+#endif // ifdef USES_P062
+
+#ifdef USES_P061
+  getDeviceIndex_from_PluginID_constexpr(61), // Keypad - PCF8574 / MCP23017 / PCF8575
+#endif // ifdef USES_P061
+
+#ifdef USES_P063
+  getDeviceIndex_from_PluginID_constexpr(63), // Keypad - TTP229 Touch
+#endif // ifdef USES_P063
+
+#ifdef USES_P010
+  getDeviceIndex_from_PluginID_constexpr(10), // Light/Lux - BH1750
+#endif // ifdef USES_P010
+
+#ifdef USES_P015
+  getDeviceIndex_from_PluginID_constexpr(15), // Light/Lux - TSL2561
+#endif // ifdef USES_P015
+
+#ifdef USES_P074
+  getDeviceIndex_from_PluginID_constexpr(74), // Light/Lux - TSL2591
+#endif // ifdef USES_P074
+
+#ifdef USES_P048
+  getDeviceIndex_from_PluginID_constexpr(48), // Motor - Adafruit Motorshield v2
+#endif // ifdef USES_P048
+
+#ifdef USES_P098
+  getDeviceIndex_from_PluginID_constexpr(98), // Motor - PWM Motor
+#endif // ifdef USES_P098
+
+#ifdef USES_P079
+  getDeviceIndex_from_PluginID_constexpr(79), // Motor - Wemos/Lolin Motorshield
+#endif // ifdef USES_P079
+
+#ifdef USES_P055
+  getDeviceIndex_from_PluginID_constexpr(55), // Notify - Chiming
+#endif // ifdef USES_P055
+
+#ifdef USES_P065
+  getDeviceIndex_from_PluginID_constexpr(65), // Notify - DFPlayer-Mini MP3
+#endif // ifdef USES_P065
+
+#ifdef USES_P043
+  getDeviceIndex_from_PluginID_constexpr(43), // Output - Clock
+#endif // ifdef USES_P043
+
+#ifdef USES_P029
+  getDeviceIndex_from_PluginID_constexpr(29), // Output - Domoticz MQTT Helper
+#endif // ifdef USES_P029
+
+#ifdef USES_P152
+  getDeviceIndex_from_PluginID_constexpr(152), // Output - ESP32 DAC
+#endif // ifdef USES_P152
+
+#ifdef USES_P124
+  getDeviceIndex_from_PluginID_constexpr(124), // Output - I2C Multi Relay
+#endif // ifdef USES_P124
+
+#ifdef USES_P038
+  getDeviceIndex_from_PluginID_constexpr(38), // Output - NeoPixel (Basic)
+#endif // ifdef USES_P038
+
+#ifdef USES_P128
+  getDeviceIndex_from_PluginID_constexpr(128), // Output - NeoPixel (BusFX)
+#endif // ifdef USES_P128
+
+#ifdef USES_P042
+  getDeviceIndex_from_PluginID_constexpr(42), // Output - NeoPixel (Candle)
+#endif // ifdef USES_P042
+
+#ifdef USES_P041
+  getDeviceIndex_from_PluginID_constexpr(41), // Output - NeoPixel (Word Clock)
+#endif // ifdef USES_P041
+
+#ifdef USES_P070
+  getDeviceIndex_from_PluginID_constexpr(70), // Output - NeoPixel Ring Clock
+#endif // ifdef USES_P070
+
+#ifdef USES_P126
+  getDeviceIndex_from_PluginID_constexpr(126), // Output - Shift registers (74HC595)
+#endif // ifdef USES_P126
+
+#ifdef USES_P082
+  getDeviceIndex_from_PluginID_constexpr(82), // Position - GPS
+#endif // ifdef USES_P082
+
+#ifdef USES_P013
+  getDeviceIndex_from_PluginID_constexpr(13), // Position - HC-SR04, RCW-0001, etc.
+#endif // ifdef USES_P013
+
+#ifdef USES_P121
+  getDeviceIndex_from_PluginID_constexpr(121), // Position - HMC5883L
+#endif // ifdef USES_P121
+
+#ifdef USES_P137
+  getDeviceIndex_from_PluginID_constexpr(137), // Power mgt - AXP192 Power management
+#endif // ifdef USES_P137
+
+#ifdef USES_P138
+  getDeviceIndex_from_PluginID_constexpr(138), // Power mgt - IP5306 Power management
+#endif // ifdef USES_P138
+
+#ifdef USES_P100
+  getDeviceIndex_from_PluginID_constexpr(100), // Pulse Counter - DS2423
+#endif // ifdef USES_P100
+
+#ifdef USES_P040
+  getDeviceIndex_from_PluginID_constexpr(40), // RFID - ID12LA/RDM6300
+#endif // ifdef USES_P040
+
+#ifdef USES_P017
+  getDeviceIndex_from_PluginID_constexpr(17), // RFID - PN532
+#endif // ifdef USES_P017
+
+#ifdef USES_P111
+  getDeviceIndex_from_PluginID_constexpr(111), // RFID - RC522
+#endif // ifdef USES_P111
+
+#ifdef USES_P008
+  getDeviceIndex_from_PluginID_constexpr(8), // RFID - Wiegand
+#endif // ifdef USES_P008
+
+#ifdef USES_P021
+  getDeviceIndex_from_PluginID_constexpr(21), // Regulator - Level Control
+#endif // ifdef USES_P021
+
+#ifdef USES_P091
+  getDeviceIndex_from_PluginID_constexpr(91), // Serial MCU controlled switch
+#endif // ifdef USES_P091
+
+#ifdef USES_P059
+  getDeviceIndex_from_PluginID_constexpr(59), // Switch Input - Rotary Encoder
+#endif // ifdef USES_P059
+
+#ifdef USES_P143
+  getDeviceIndex_from_PluginID_constexpr(143), // Switch input - I2C Rotary encoders
+#endif // ifdef USES_P143
+
+#ifdef USES_P009
+  getDeviceIndex_from_PluginID_constexpr(9), // Switch input - MCP23017
+#endif // ifdef USES_P009
+
+#ifdef USES_P019
+  getDeviceIndex_from_PluginID_constexpr(19), // Switch input - PCF8574
+#endif // ifdef USES_P019
+
+#ifdef USES_P001
+  getDeviceIndex_from_PluginID_constexpr(1), // Switch input - Switch
+#endif // ifdef USES_P001
+
+#ifdef USES_P097
+  getDeviceIndex_from_PluginID_constexpr(97), // Touch (ESP32) - internal
+#endif // ifdef USES_P097
+
+#ifdef USES_P099
+  getDeviceIndex_from_PluginID_constexpr(99), // Touch - XPT2046 on a TFT display
+#endif // ifdef USES_P099
+
+#ifdef USES_P133
+  getDeviceIndex_from_PluginID_constexpr(133), // UV - LTR390
+#endif // ifdef USES_P133
+
+#ifdef USES_P107
+  getDeviceIndex_from_PluginID_constexpr(107), // UV - SI1145
+#endif // ifdef USES_P107
+
+#ifdef USES_P084
+  getDeviceIndex_from_PluginID_constexpr(84), // UV - VEML6070
+#endif // ifdef USES_P084
+
+#ifdef USES_P114
+  getDeviceIndex_from_PluginID_constexpr(114), // UV - VEML6075 UVA/UVB Sensor
+#endif // ifdef USES_P114
+
+#ifdef USES_P067
+  getDeviceIndex_from_PluginID_constexpr(67), // Weight - HX711 Load Cell
+#endif // ifdef USES_P067
+
+};
@@ -2,6 +2,7 @@
 
 
 #include "../Helpers/ESPEasy_time_calc.h"
+#include "../Helpers/PowerManagement.h"
 
 
 #define MAX_SCHEDULER_WAIT_TIME 50 // Max delay used in the scheduler for passing idle time.
@@ -16,6 +17,8 @@
     eco_mode = enabled;
   }
 
+  constexpr uint16_t msecTimerHandlerStruct::INDEX_EMPTY;
+
   void msecTimerHandlerStruct::registerAt(unsigned long id, unsigned long timer) {
     timer_id_couple item(id, timer);
 
@@ -27,6 +30,14 @@
     remove(item);
   }
 
+  // Check if the first item has reached its timeout, without removing it.
+  bool msecTimerHandlerStruct::hasTimerDue() const {
+    if (_timer_ids.empty()) {
+      return false;
+    }
+    return timePassedSince(_timer_ids.front()._item._timer) >= 0;
+  }
+
   // Check if timeout has been reached and also return its set timer.
   // Return 0 if no item has reached timeout moment.
   unsigned long msecTimerHandlerStruct::getNextId(unsigned long& timer) {
@@ -36,12 +47,12 @@
       recordIdle();
 
       if (eco_mode) {
-        delay(MAX_SCHEDULER_WAIT_TIME); // Nothing to do, try save some power.
+        PowerManagement_wait(MAX_SCHEDULER_WAIT_TIME); // Nothing to do, try save some power.
       }
       return 0;
     }
-    timer_id_couple item = _timer_ids.front();
-    const long passed    = timePassedSince(item._timer);
+    const timer_id_couple item = _timer_ids.front()._item;
+    const long passed          = timePassedSince(item._timer);
 
     if (passed < 0) {
       // No timeOutReached
@@ -56,7 +67,7 @@
           // Should not happen, but just to be sure we will not wait forever.
           waitTime = 0;
         }
-        delay(waitTime);
+        PowerManagement_wait(waitTime);
       }
       return 0;
     }
@@ -64,7 +75,7 @@
     unsigned long size = _timer_ids.size();
 
     if (size > max_queue_length) { max_queue_length = size; }
-    _timer_ids.pop_front();
+    removeAt(0);
     timer = item._timer;
     ++get_called_ret_id;
     return item._id;
@@ -72,13 +83,13 @@
 
 
   bool msecTimerHandlerStruct::getTimerForId(unsigned long id, unsigned long& timer) const {
-    for (auto it = _timer_ids.begin(); it != _timer_ids.end(); ++it) {
-      if (it->_id == id) {
-        timer = it->_timer;
-        return true;
-      }
+    const uint16_t slot = findSlot(id);
+
+    if (slot == INDEX_EMPTY) {
+      return false;
     }
-    return false;
+    timer = _timer_ids[_index[slot]]._item._timer;
+    return true;
   }
 
   String msecTimerHandlerStruct::getQueueStats() {
@@ -110,38 +121,167 @@
     return idle_time_pct;
   }
 
-  struct match_id {
-    match_id(unsigned long id) : _id(id) {}
+  void msecTimerHandlerStruct::insert(const timer_id_couple& item) {
+    if (item._id == 0) { return; }
 
-    bool operator()(const timer_id_couple& item) {
-      return _id == item._id;
+    // Make sure only one is present with the same id.
+    const uint16_t slot = findSlot(item._id);
+
+    if (slot != INDEX_EMPTY) {
+      // Already scheduled, only update the timer.
+      const size_t pos = _index[slot];
+      _timer_ids[pos]._item._timer = item._timer;
+      siftUp(pos);
+      siftDown(_index[slot]);
+      return;
     }
 
-    unsigned long _id;
-  };
+    const size_t capacity = _index.size() / 2;
 
-  void msecTimerHandlerStruct::insert(const timer_id_couple& item) {
+    if (_timer_ids.size() >= capacity) {
+      // Allocated only once at the first insert, unless more timers are needed.
+      if (!allocate(capacity == 0 ? MSEC_TIMER_HANDLER_INITIAL_CAPACITY : 2 * capacity)) { return; }
+    }
+    const uint16_t pos = _timer_ids.size();
+    _timer_ids.emplace_back(item, addToIndex(item._id, pos));
+    siftUp(pos);
+  }
+
+  void msecTimerHandlerStruct::remove(const timer_id_couple& item) {
     if (item._id == 0) { return; }
 
-    // Make sure only one is present with the same id.
-    _timer_ids.remove_if(match_id(item._id));
-    const bool mustSort = !_timer_ids.empty();
-    _timer_ids.push_front(item);
+    const uint16_t slot = findSlot(item._id);
 
-    if (mustSort) {
-      _timer_ids.sort(); // TD-er: Must check if this is an expensive operation.
+    if (slot != INDEX_EMPTY) {
+      removeAt(_index[slot]);
+    }
+  }
+
+  bool msecTimerHandlerStruct::allocate(size_t capacity) {
+    uint8_t bits = 1;
+
+    while ((static_cast<size_t>(1) << bits) < (2 * capacity)) {
+      ++bits;
     }
 
-    // It should be a relative light operation, to insert into a sorted list.
-    // Perhaps it is better to use std::set ????
-    // Keep in mind: order is based on timer, uniqueness is based on id.
+    if ((static_cast<size_t>(1) << bits) >= INDEX_EMPTY) {
+      return false;
+    }
+    _timer_ids.reserve(capacity);
+    _index.assign(static_cast<size_t>(1) << bits, INDEX_EMPTY);
+    _indexBits = bits;
+
+    // Rebuild the index for already present timers
+    for (size_t pos = 0; pos < _timer_ids.size(); ++pos) {
+      _timer_ids[pos]._slot = addToIndex(_timer_ids[pos]._item._id, pos);
+    }
+    return _timer_ids.capacity() >= capacity;
   }
 
-  void msecTimerHandlerStruct::remove(const timer_id_couple& item) {
-    if (item._id == 0) { return; }
+  bool msecTimerHandlerStruct::isEarlier(size_t a, size_t b) const {
+    // Wrap-around safe, as long as timers are set less than 24 days apart.
+    return timeDiff(_timer_ids[a]._item._timer, _timer_ids[b]._item._timer) > 0;
+  }
 
-    // Make sure only one is present with the same id.
-    _timer_ids.remove_if(match_id(item._id));
+  void msecTimerHandlerStruct::swapEntries(size_t a, size_t b) {
+    std::swap(_timer_ids[a], _timer_ids[b]);
+    _index[_timer_ids[a]._slot] = a;
+    _index[_timer_ids[b]._slot] = b;
+  }
+
+  void msecTimerHandlerStruct::siftUp(size_t pos) {
+    while (pos > 0) {
+      const size_t parent = (pos - 1) / 2;
+
+      if (!isEarlier(pos, parent)) { return; }
+      swapEntries(pos, parent);
+      pos = parent;
+    }
+  }
+
+  void msecTimerHandlerStruct::siftDown(size_t pos) {
+    const size_t size = _timer_ids.size();
+
+    while (true) {
+      const size_t left  = 2 * pos + 1;
+      const size_t right = left + 1;
+      size_t earliest    = pos;
+
+      if ((left < size) && isEarlier(left, earliest)) { earliest = left; }
+
+      if ((right < size) && isEarlier(right, earliest)) { earliest = right; }
+
+      if (earliest == pos) { return; }
+      swapEntries(pos, earliest);
+      pos = earliest;
+    }
+  }
+
+  void msecTimerHandlerStruct::removeAt(size_t pos) {
+    if (pos >= _timer_ids.size()) { return; }
+    removeFromIndex(_timer_ids[pos]._slot);
+
+    const size_t last = _timer_ids.size() - 1;
+
+    if (pos != last) {
+      _timer_ids[pos]             = _timer_ids[last];
+      _index[_timer_ids[pos]._slot] = pos;
+    }
+    _timer_ids.pop_back();
+
+    if (pos < _timer_ids.size()) {
+      const uint16_t slot = _timer_ids[pos]._slot;
+      siftUp(pos);
+      siftDown(_index[slot]);
+    }
+  }
+
+  uint16_t msecTimerHandlerStruct::hashSlot(unsigned long id) const {
+    // Fibonacci hashing, as IDs often only differ in a few bits.
+    return static_cast<uint32_t>(static_cast<uint32_t>(id) * 2654435769u) >> (32 - _indexBits);
+  }
+
+  uint16_t msecTimerHandlerStruct::findSlot(unsigned long id) const {
+    if (_index.empty()) { return INDEX_EMPTY; }
+    const uint16_t mask = _index.size() - 1;
+
+    for (uint16_t slot = hashSlot(id); _index[slot] != INDEX_EMPTY; slot = (slot + 1) & mask) {
+      if (_timer_ids[_index[slot]]._item._id == id) {
+        return slot;
+      }
+    }
+    return INDEX_EMPTY;
+  }
+
+  uint16_t msecTimerHandlerStruct::addToIndex(unsigned long id, uint16_t pos) {
+    const uint16_t mask = _index.size() - 1;
+    uint16_t slot       = hashSlot(id);
+
+    while (_index[slot] != INDEX_EMPTY) {
+      slot = (slot + 1) & mask;
+    }
+    _index[slot] = pos;
+    return slot;
+  }
+
+  void msecTimerHandlerStruct::removeFromIndex(uint16_t slot) {
+    // Backward shift deletion, so no tombstones are needed.
+    const uint16_t mask = _index.size() - 1;
+    uint16_t hole       = slot;
+    uint16_t next       = (slot + 1) & mask;
+
+    while (_index[next] != INDEX_EMPTY) {
+      const uint16_t home = hashSlot(_timer_ids[_index[next]]._item._id);
+
+      // Move the entry to the hole, when the hole is between its home slot and its current slot.
+      if (((next - home) & mask) >= ((next - hole) & mask)) {
+        _index[hole]                   = _index[next];
+        _timer_ids[_index[hole]]._slot = hole;
+        hole                           = next;
+      }
+      next = (next + 1) & mask;
+    }
+    _index[hole] = INDEX_EMPTY;
   }
 
   void msecTimerHandlerStruct::recordIdle() {
@@ -3,10 +3,20 @@
 
 
 #include "../../ESPEasy_common.h"
-#include <list>
+#include <vector>
 
 #include "../DataStructs/timer_id_couple.h"
 
+// Initial number of timers which can be set without allocating memory.
+// More timers can be set, but then the storage has to grow.
+#ifndef MSEC_TIMER_HANDLER_INITIAL_CAPACITY
+# ifdef ESP8266
+#  define MSEC_TIMER_HANDLER_INITIAL_CAPACITY  64
+# else // ifdef ESP8266
+#  define MSEC_TIMER_HANDLER_INITIAL_CAPACITY  128
+# endif // ifdef ESP8266
+#endif // ifndef MSEC_TIMER_HANDLER_INITIAL_CAPACITY
+
 
 struct msecTimerHandlerStruct {
   msecTimerHandlerStruct();
@@ -22,6 +32,10 @@ struct msecTimerHandlerStruct {
   // Return 0 if no item has reached timeout moment.
   unsigned long getNextId(unsigned long& timer);
 
+  // Check if the first scheduled item has reached its timeout.
+  // Does not update any statistics.
+  bool   hasTimerDue() const;
+
   // Check if a give ID is scheduled and if so, return the set timer.
   // N.B. the ID is the mixed ID.
   bool   getTimerForId(unsigned long  id,
@@ -35,10 +49,48 @@ struct msecTimerHandlerStruct {
 
 private:
 
+  // Timers are kept in a binary min-heap, ordered on their timer.
+  // A hash index (open addressing, linear probing) maps an ID to its position in the heap,
+  // so insert, remove and lookup by ID do not need to walk all timers.
+  struct timer_entry {
+    timer_entry(const timer_id_couple& item, uint16_t slot) : _item(item), _slot(slot) {}
+
+    timer_id_couple _item;
+    uint16_t        _slot; // Slot in the index pointing to this entry
+  };
+
   void insert(const timer_id_couple& item);
 
   void remove(const timer_id_couple& item);
 
+  // (Re)allocate the heap and index for at least the given number of timers.
+  bool allocate(size_t capacity);
+
+  // Return true when timer of heap position a is due before timer at position b
+  bool isEarlier(size_t a,
+                 size_t b) const;
+
+  void swapEntries(size_t a,
+                   size_t b);
+
+  void siftUp(size_t pos);
+
+  void siftDown(size_t pos);
+
+  void removeAt(size_t pos);
+
+  uint16_t hashSlot(unsigned long id) const;
+
+  // Return the index slot for the ID, or INDEX_EMPTY when not present.
+  uint16_t findSlot(unsigned long id) const;
+
+  uint16_t addToIndex(unsigned long id,
+                      uint16_t      pos);
+
+  void     removeFromIndex(uint16_t slot);
+
+  static constexpr uint16_t INDEX_EMPTY = 0xFFFF;
+
   void recordIdle();
 
   void recordRunning();
@@ -56,8 +108,12 @@ private:
   bool          is_idle;
   bool          eco_mode;
 
-  // The list of set timers
-  std::list<timer_id_couple>_timer_ids;
+  // The set timers
+  std::vector<timer_entry>_timer_ids;
+
+  // Heap position per slot, size is a power of 2 and at least twice the heap capacity.
+  std::vector<uint16_t>_index;
+  uint8_t              _indexBits = 0;
 };
 
 #endif // HELPERS_MSECTIMERHANDLERSTRUCT_H
@@ -0,0 +1,56 @@
+#include "../PluginStructs/P001_data_struct.h"
+
+#ifdef USES_P001
+
+# if FEATURE_SWITCH_INTERRUPT
+
+#  include "../ESPEasyCore/ESPEasyGPIO.h"
+
+P001_data_struct::P001_data_struct(int8_t   gpio,
+                                   uint8_t  pinMode,
+                                   uint32_t debounce_ms)
+  : _debounce_ms(debounce_ms), _gpio(gpio), _pinMode(pinMode) {}
+
+P001_data_struct::~P001_data_struct() {
+  detachInterrupt(digitalPinToInterrupt(_gpio));
+}
+
+void P001_data_struct::init() {
+  _state = GPIO_Read_Switch_State(_gpio, _pinMode);
+
+  // Report the initial state once, needed to send the boot state
+  _lastEdgeTime     = millis();
+  _edgeCount        = 1;
+  _handledEdgeCount = 0;
+  attachInterruptArg(
+    digitalPinToInterrupt(_gpio),
+    reinterpret_cast<void (*)(void *)>(ISR_edge),
+    this,
+    CHANGE);
+}
+
+bool P001_data_struct::update() {
+  const uint32_t edgeCount    = _edgeCount;
+  const uint32_t lastEdgeTime = _lastEdgeTime;
+
+  if ((edgeCount == _handledEdgeCount) ||
+      (timePassedSince(lastEdgeTime) < static_cast<long>(_debounce_ms))) {
+    return false;
+  }
+  _state = GPIO_Read_Switch_State(_gpio, _pinMode);
+
+  if (edgeCount != _edgeCount) {
+    // Input changed again while reading, wait for it to settle
+    return false;
+  }
+  _handledEdgeCount = edgeCount;
+  return true;
+}
+
+void IRAM_ATTR P001_data_struct::ISR_edge(P001_data_struct *self) {
+  self->_lastEdgeTime = millis();
+  self->_edgeCount    = self->_edgeCount + 1;
+}
+
+# endif // if FEATURE_SWITCH_INTERRUPT
+#endif  // ifdef USES_P001
@@ -0,0 +1,50 @@
+#ifndef PLUGINSTRUCTS_P001_DATA_STRUCT_H
+#define PLUGINSTRUCTS_P001_DATA_STRUCT_H
+
+#include "../../_Plugin_Helper.h"
+#ifdef USES_P001
+
+# if FEATURE_SWITCH_INTERRUPT
+
+// Interrupt mode of the switch input.
+// The ISR only keeps the time of the last edge, the debounce is done by checking
+// the input was stable for the debounce time since that edge.
+struct P001_data_struct : public PluginTaskData_base {
+  P001_data_struct(int8_t   gpio,
+                   uint8_t  pinMode,
+                   uint32_t debounce_ms);
+  P001_data_struct() = delete;
+
+  virtual ~P001_data_struct();
+
+  void          init();
+
+  // Returns true once per (series of) edge(s), when the input is stable for the debounce time.
+  // The debounced state is then available via getState().
+  bool          update();
+
+  int8_t        getState() const {
+    return _state;
+  }
+
+  // millis() of the last edge of the input
+  unsigned long getEdgeTime() const {
+    return _lastEdgeTime;
+  }
+
+private:
+
+  static void ISR_edge(P001_data_struct *self);
+
+  volatile unsigned long _lastEdgeTime     = 0;
+  volatile uint32_t      _edgeCount        = 0;
+  uint32_t               _handledEdgeCount = 0;
+  const uint32_t         _debounce_ms;
+  const int8_t           _gpio;
+  const uint8_t          _pinMode;
+  int8_t                 _state = -1;
+};
+
+# endif // if FEATURE_SWITCH_INTERRUPT
+#endif  // ifdef USES_P001
+#endif  // ifndef PLUGINSTRUCTS_P001_DATA_STRUCT_H
@@ -10,9 +10,22 @@
 # endif // ifndef DEFAULT_VREF
 
 
+P002_data_struct::~P002_data_struct()
+{
+# if FEATURE_ADC_DMA
+
+  if (_dmaStarted) {
+    ADC_DMA_removeChannel(_taskIndex);
+  }
+# endif // if FEATURE_ADC_DMA
+}
+
 void P002_data_struct::init(struct EventStruct *event)
 {
   _sampleMode = P002_OVERSAMPLING;
+# if FEATURE_ADC_DMA
+  _taskIndex = event->TaskIndex;
+# endif // if FEATURE_ADC_DMA
 
   # ifdef ESP8266
   _pin_analogRead = A0;
@@ -45,6 +58,56 @@ void P002_data_struct::init(struct EventStruct *event)
 # endif // ifndef LIMIT_BUILD_SIZE
 }
 
+# if FEATURE_ADC_DMA
+void P002_data_struct::startDMA(struct EventStruct *event)
+{
+  if (_sampleMode == P002_USE_DMA) {
+    const uint32_t sampleRate = P002_DMA_SAMPLE_RATE > 0 ? P002_DMA_SAMPLE_RATE : P002_DMA_DEFAULT_SAMPLE_RATE;
+    _dmaStarted = ADC_DMA_addChannel(_taskIndex, _pin_analogRead, _attenuation, sampleRate * 1000);
+
+    if (!_dmaStarted) {
+      addLog(LOG_LEVEL_ERROR, F("ADC  : Continuous DMA sampling needs an ADC1 pin"));
+    }
+  } else if (_dmaStarted) {
+    ADC_DMA_removeChannel(_taskIndex);
+    _dmaStarted = false;
+  }
+}
+
+bool P002_data_struct::plugin_get_config_value(struct EventStruct *event,
+                                               String            & string) const
+{
+  const String command = parseString(string, 1);
+  float value          = 0.0f;
+
+  if (equals(command, F("dmasamples"))) {
+    string = String(_dmaStats.count);
+    return true;
+  }
+
+  if (equals(command, F("dmamin"))) {
+    value = calibrateAveragedValue(_dmaStats.min);
+  } else if (equals(command, F("dmamax"))) {
+    value = calibrateAveragedValue(_dmaStats.max);
+  } else if (equals(command, F("dmap2p"))) {
+    value = calibrateAveragedValue(_dmaStats.max) - calibrateAveragedValue(_dmaStats.min);
+  } else if (equals(command, F("dmarms"))) {
+    // Convert the RMS in ADC steps to output units, using the slope of the calibration around the mean
+    const float mean = _dmaStats.getMean();
+    value = fabs(calibrateAveragedValue(mean + _dmaStats.getRMS_AC()) - calibrateAveragedValue(mean));
+  } else {
+    return false;
+  }
+
+  if (_dmaStats.count == 0) {
+    value = 0.0f;
+  }
+  string = toString(value, _nrDecimals);
+  return true;
+}
+
+# endif // if FEATURE_ADC_DMA
+
 # ifndef LIMIT_BUILD_SIZE
 void P002_data_struct::load(struct EventStruct *event)
 {
@@ -142,6 +205,9 @@ void P002_data_struct::webformLoad(struct EventStruct *event)
 # ifndef LIMIT_BUILD_SIZE
       , F("Binning")
 # endif // ifndef LIMIT_BUILD_SIZE
+# if FEATURE_ADC_DMA
+      , F("Continuous DMA")
+# endif // if FEATURE_ADC_DMA
     };
     const int outputOptionValues[] = {
       P002_USE_CURENT_SAMPLE,
@@ -149,11 +215,32 @@ void P002_data_struct::webformLoad(struct EventStruct *event)
 # ifndef LIMIT_BUILD_SIZE
       , P002_USE_BINNING
 # endif // ifndef LIMIT_BUILD_SIZE
+# if FEATURE_ADC_DMA
+      , P002_USE_DMA
+# endif // if FEATURE_ADC_DMA
     };
     const int nrOptions = NR_ELEMENTS(outputOptionValues);
     addFormSelector(F("Oversampling"), F("oversampling"), nrOptions, outputOptions, outputOptionValues, P002_OVERSAMPLING);
   }
 
+# if FEATURE_ADC_DMA
+
+  if (P002_OVERSAMPLING == P002_USE_DMA) {
+    addFormNumericBox(F("DMA Sample Rate"), F("dma_rate"),
+                      P002_DMA_SAMPLE_RATE > 0 ? P002_DMA_SAMPLE_RATE : P002_DMA_DEFAULT_SAMPLE_RATE,
+                      (SOC_ADC_SAMPLE_FREQ_THRES_LOW + 999) / 1000, ADC_DMA_MAX_SAMPLE_RATE / 1000);
+    addUnit(F("kHz"));
+    addFormNote(F("ADC1 pins only. Shared by all DMA tasks, the highest rate is used and divided over the channels. "
+                  "ADC1 cannot be read by other tasks."));
+
+    if (ADC_DMA_getSampleRate() != 0) {
+      addRowLabel(F("Actual Sample Rate"));
+      addHtmlInt(static_cast<int>(ADC_DMA_getSampleRate()));
+      addUnit(F("Hz"));
+    }
+  }
+# endif // if FEATURE_ADC_DMA
+
 # ifdef ESP32
   addFormSubHeader(F("Factory Calibration"));
   addFormCheckBox(F("Apply Factory Calibration"), F("fac_cal"), P002_APPLY_FACTORY_CALIB, !hasADC_factory_calibration());
@@ -687,6 +774,9 @@ void P002_data_struct::webformLoad_multipointCurve(struct EventStruct *event) co
 String P002_data_struct::webformSave(struct EventStruct *event)
 {
   P002_OVERSAMPLING = getFormItemInt(F("oversampling"), 0); // Set a default for LIMIT_BUILD_SIZE
+  # if FEATURE_ADC_DMA
+  P002_DMA_SAMPLE_RATE = getFormItemInt(F("dma_rate"), P002_DMA_DEFAULT_SAMPLE_RATE);
+  # endif // if FEATURE_ADC_DMA
 
   P002_CALIBRATION_ENABLED = isFormItemChecked(F("cal"));
   # ifdef ESP32
@@ -741,6 +831,14 @@ String P002_data_struct::webformSave(struct EventStruct *event)
 void P002_data_struct::takeSample()
 {
   if (_sampleMode == P002_USE_CURENT_SAMPLE) { return; }
+# if FEATURE_ADC_DMA
+
+  if (_sampleMode == P002_USE_DMA) {
+    // Move the samples from the DMA buffer to the stats of all DMA channels
+    ADC_DMA_process();
+    return;
+  }
+# endif // if FEATURE_ADC_DMA
   int raw = espeasy_analogRead(_pin_analogRead);
 
 # if FEATURE_PLUGIN_STATS
@@ -788,6 +886,10 @@ bool P002_data_struct::getValue(float& float_value,
     case P002_USE_CURENT_SAMPLE:
       mustTakeSample = true;
       break;
+# if FEATURE_ADC_DMA
+    case P002_USE_DMA:
+      return getDMAValue(float_value, raw_value);
+# endif // if FEATURE_ADC_DMA
   }
 
   if (!mustTakeSample) {
@@ -851,6 +953,12 @@ void P002_data_struct::reset()
 
       break;
     }
+#  if FEATURE_ADC_DMA
+    case P002_USE_DMA:
+      // Keep the stats of this interval for plugin_get_config_value()
+      ADC_DMA_getStats(_taskIndex, _dmaStats, true);
+      break;
+#  endif // if FEATURE_ADC_DMA
   }
 # else // ifndef LIMIT_BUILD_SIZE
   resetOversampling();
@@ -874,24 +982,55 @@ bool P002_data_struct::getOversamplingValue(float& float_value, int& raw_value)
   if (OverSampling.peek(float_value)) {
     raw_value = static_cast<int>(float_value);
 
+    // We counted the raw oversampling values, so now we need to apply the calibration and multi-point processing
+    float_value = calibrateAveragedValue(float_value);
+    return true;
+  }
+  return false;
+}
+
+float P002_data_struct::calibrateAveragedValue(float raw_value) const {
+  float float_value = raw_value;
+
 # ifdef ESP32
 
-    if (_useFactoryCalibration) {
-      float_value = applyFactoryCalibration(float_value, _attenuation);
-    }
+  if (_useFactoryCalibration) {
+    float_value = applyFactoryCalibration(float_value, _attenuation);
+  }
 # endif // ifdef ESP32
 
-    // We counted the raw oversampling values, so now we need to apply the calibration and multi-point processing
-    float_value = applyCalibration(float_value);
+  float_value = applyCalibration(float_value);
 # ifndef LIMIT_BUILD_SIZE
-    float_value = applyMultiPointInterpolation(float_value);
+  float_value = applyMultiPointInterpolation(float_value);
 # endif // ifndef LIMIT_BUILD_SIZE
+  return float_value;
+}
 
-    return true;
+# if FEATURE_ADC_DMA
+bool P002_data_struct::getDMAValue(float& float_value, int& raw_value) const {
+  ADC_DMA_process();
+  ADC_DMA_stats_t stats;
+
+  if (!ADC_DMA_getStats(_taskIndex, stats, false)) {
+    return false;
   }
-  return false;
+#  if FEATURE_PLUGIN_STATS
+  PluginStats *pluginStats = getPluginStats(0);
+
+  if (pluginStats != nullptr) {
+    pluginStats->trackPeak(stats.min);
+    pluginStats->trackPeak(stats.max);
+  }
+#  endif // if FEATURE_PLUGIN_STATS
+
+  float_value = stats.getMean();
+  raw_value   = static_cast<int>(float_value);
+  float_value = calibrateAveragedValue(float_value);
+  return true;
 }
 
+# endif // if FEATURE_ADC_DMA
+
 # ifndef LIMIT_BUILD_SIZE
 int P002_data_struct::getBinIndex(float currentValue) const
 {
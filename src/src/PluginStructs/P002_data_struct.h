@@ -3,6 +3,7 @@
 
 #include "../../_Plugin_Helper.h"
 
+#include "../Helpers/ADC_DMA.h"
 #include "../Helpers/OversamplingHelper.h"
 
 #ifdef USES_P002
@@ -35,6 +36,12 @@
 # define P002_USE_CURENT_SAMPLE   0
 # define P002_USE_OVERSAMPLING    1
 # define P002_USE_BINNING         2
+# define P002_USE_DMA             3 // ESP32 only, continuous sampling using DMA
+
+# if FEATURE_ADC_DMA
+#  define P002_DMA_SAMPLE_RATE    PCONFIG(6) // kHz
+#  define P002_DMA_DEFAULT_SAMPLE_RATE  20
+# endif // if FEATURE_ADC_DMA
 
 // FIXME TD-er: Must test if HTML POST on ESP8266 will not take too much ram on save
 # define P002_MAX_NR_MP_ITEMS     64
@@ -96,10 +103,21 @@ struct P002_binningRange {
 
 struct P002_data_struct : public PluginTaskData_base {
   P002_data_struct() = default;
-  virtual ~P002_data_struct() = default;
+  virtual ~P002_data_struct();
 
   void init(struct EventStruct *event);
 
+# if FEATURE_ADC_DMA
+
+  // Start or stop continuous sampling, depending on the sample mode.
+  // Must only be called for the running task, not for a temporary object.
+  void startDMA(struct EventStruct *event);
+
+  // Stats of the DMA samples of the last PLUGIN_READ interval
+  bool plugin_get_config_value(struct EventStruct *event,
+                               String            & string) const;
+# endif // if FEATURE_ADC_DMA
+
 private:
 
 # ifndef LIMIT_BUILD_SIZE
@@ -178,6 +196,14 @@ private:
   bool getOversamplingValue(float& float_value,
                             int  & raw_value) const;
 
+  // Apply factory calibration, 2-point calibration and multipoint interpolation to an averaged ADC value
+  float calibrateAveragedValue(float raw_value) const;
+
+# if FEATURE_ADC_DMA
+  bool getDMAValue(float& float_value,
+                   int  & raw_value) const;
+# endif // if FEATURE_ADC_DMA
+
 private:
 
 # ifndef LIMIT_BUILD_SIZE
@@ -272,6 +298,11 @@ private:
   bool        _useFactoryCalibration = false;
   adc_atten_t _attenuation           = ADC_ATTEN_DB_11;
 # endif // ifdef ESP32
+# if FEATURE_ADC_DMA
+  taskIndex_t     _taskIndex  = INVALID_TASK_INDEX;
+  bool            _dmaStarted = false;
+  ADC_DMA_stats_t _dmaStats;
+# endif // if FEATURE_ADC_DMA
 };
 
 
@@ -14,6 +14,9 @@ struct P003_data_struct : public PluginTaskData_base {
   virtual ~P003_data_struct() = default;
 
   Internal_GPIO_pulseHelper pulseHelper;
+  # if FEATURE_PULSE_PERIOD_STATS
+  pulsePeriodStats_t        periodStats; // Of the last PLUGIN_READ interval
+  # endif // if FEATURE_PULSE_PERIOD_STATS
 };
 
 
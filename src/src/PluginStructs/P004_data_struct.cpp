@@ -91,27 +91,36 @@ void P004_data_struct::add_addr(const uint8_t addr[], uint8_t index) {
 bool P004_data_struct::initiate_read() {
   _measurementStart = millis();
 
-  bool mustInit   = false;
-  uint8_t use_res = 9;
+  bool mustInit        = false;
+  bool parasitePowered = false;
+  uint8_t use_res      = 9;
 
   for (uint8_t i = 0; i < VARS_PER_TASK; ++i) { // Determine the resolution to use
     use_res = max(use_res, _sensors[i].actual_res);
+
+    if ((_sensors[i].addr != 0) && _sensors[i].parasitePowered) {
+      parasitePowered = true;
+    }
   }
 
+  // Parasite powered sensors cannot all convert at the same time,
+  // as they draw their power from the data line.
+  unsigned long busReadyTime = 0;
+  const bool    busConversion =
+    !parasitePowered &&
+    Dallas_startBusConversion(_gpio_rx, _gpio_tx, use_res, _busConversionId, busReadyTime);
+
   for (uint8_t i = 0; i < VARS_PER_TASK; ++i) {
-    if (_sensors[i].initiate_read(_gpio_rx, _gpio_tx, _res)) {
+    const bool started = busConversion
+      ? _sensors[i].join_bus_conversion(_gpio_rx, _gpio_tx, _res)
+      : _sensors[i].initiate_read(_gpio_rx, _gpio_tx, _res);
+
+    if (started) {
       if (!measurement_active()) {
         // Set the timer right after initiating the first sensor
-
-
-        /*********************************************************************************************\
-        *  Dallas Start Temperature Conversion, expected max duration:
-        *    9 bits resolution ->  93.75 ms
-        *   10 bits resolution -> 187.5 ms
-        *   11 bits resolution -> 375 ms
-        *   12 bits resolution -> 750 ms
-        \*********************************************************************************************/
-        _timer = millis() + (800 / (1 << (12 - use_res))); // Use actual sensor resolution
+        _timer = busConversion
+          ? busReadyTime
+          : millis() + Dallas_conversionTime(use_res); // Use actual sensor resolution
       }
       _sensors[i].measurementActive = true;
     } else {
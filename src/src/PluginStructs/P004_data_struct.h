@@ -46,6 +46,8 @@ struct P004_data_struct : public PluginTaskData_base {
 
   // Send the start measuremnt command to all set sensors which have a non-zero address
   // Their index determines the order in which the sensors receive this command.
+  // A single conversion for all sensors on the GPIO pin is shared with other tasks
+  // using the same pin, unless a sensor is parasite powered.
   bool initiate_read();
 
   bool collect_values();
@@ -86,6 +88,7 @@ private:
   // while the node is up some time between 24.9 and 49.7 days.
   unsigned long     _timer;
   unsigned long     _measurementStart;
+  uint32_t          _busConversionId = 0;
   Dallas_SensorData _sensors[VARS_PER_TASK];
   taskIndex_t       _taskIndex;
   int8_t            _gpio_rx;
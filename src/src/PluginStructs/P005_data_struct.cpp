@@ -99,6 +99,27 @@ bool P005_data_struct::waitState(uint32_t state)
 * Perform the actual reading + interpreting of data.
 \*********************************************************************************************/
 bool P005_data_struct::readDHT(struct EventStruct *event) {
+  const uint32_t startSignal_ms = getStartSignalDuration_ms();
+
+  sendStartSignal();
+
+  if (startSignal_ms != 0) {
+    delay(startSignal_ms);
+  }
+  return readResponse(event);
+}
+
+uint32_t P005_data_struct::getStartSignalDuration_ms() const {
+  switch (SensorModel) {
+    case P005_DHT11:  return 19;  // minimum 18ms
+    case P005_DHT12:  return 200; // minimum 200ms
+  }
+
+  // Short start signal is handled in sendStartSignal()
+  return 0;
+}
+
+void P005_data_struct::sendStartSignal() {
   // Call the "slow" function to make sure the pin is in a defined state.
   // Apparently the pull-up state may not always be in a well known state
   // With the direct pinmode calls we don't set the pull-up or -down resistors.
@@ -118,14 +139,14 @@ bool P005_data_struct::readDHT(struct EventStruct *event) {
   DIRECT_pinWrite(DHT_pin, 0);           // Pull low
 
   switch (SensorModel) {
-    case P005_DHT11:  delay(19); break;  // minimum 18ms
     case P005_DHT22:  delay(2);  break;  // minimum 1ms
-    case P005_DHT12:  delay(200); break; // minimum 200ms
     case P005_AM2301: delayMicroseconds(900); break;
     case P005_SI7021: delayMicroseconds(500); break;
     case P005_MS01:   delayMicroseconds(450); break;
   }
+}
 
+bool P005_data_struct::readResponse(struct EventStruct *event) {
   {
 #ifdef DEBUG_LOGIC_ANALYZER_PIN
     DIRECT_pinWrite(DEBUG_LOGIC_ANALYZER_PIN, 1);
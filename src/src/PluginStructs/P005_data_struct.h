@@ -27,6 +27,25 @@ struct P005_data_struct : public PluginTaskData_base {
   \*********************************************************************************************/
   bool readDHT(struct EventStruct *event);
 
+  /*********************************************************************************************\
+  * Duration of the start signal for sensors needing a long start signal, 0 for a short one.
+  * A long start signal is not waited for in readDHT() when split via readPhase.
+  \*********************************************************************************************/
+  uint32_t getStartSignalDuration_ms() const;
+
+  /*********************************************************************************************\
+  * Pull the pin low to start a reading.
+  * Short start signal durations are included.
+  \*********************************************************************************************/
+  void sendStartSignal();
+
+  /*********************************************************************************************\
+  * End the start signal and read the response.
+  \*********************************************************************************************/
+  bool readResponse(struct EventStruct *event);
+
+  PluginTwoPhaseRead readPhase;
+
 
   int8_t DHT_pin;
   uint8_t SensorModel;
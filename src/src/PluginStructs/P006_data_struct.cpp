@@ -27,20 +27,26 @@ bool P006_data_struct::begin()
   if (!initialized) {
     if (I2C_read8_reg(BMP085_I2CADDR, 0xD0) != 0x55) { return false; }
 
-    /* read calibration data */
-    ac1 = I2C_read16_reg(BMP085_I2CADDR, BMP085_CAL_AC1);
-    ac2 = I2C_read16_reg(BMP085_I2CADDR, BMP085_CAL_AC2);
-    ac3 = I2C_read16_reg(BMP085_I2CADDR, BMP085_CAL_AC3);
-    ac4 = I2C_read16_reg(BMP085_I2CADDR, BMP085_CAL_AC4);
-    ac5 = I2C_read16_reg(BMP085_I2CADDR, BMP085_CAL_AC5);
-    ac6 = I2C_read16_reg(BMP085_I2CADDR, BMP085_CAL_AC6);
+    /* read calibration data, 11 big endian words in a single transfer */
+    uint8_t cal[BMP085_CAL_MD + 2 - BMP085_CAL_AC1]{};
 
-    b1 = I2C_read16_reg(BMP085_I2CADDR, BMP085_CAL_B1);
-    b2 = I2C_read16_reg(BMP085_I2CADDR, BMP085_CAL_B2);
+    if (!I2C_read_block_reg(BMP085_I2CADDR, BMP085_CAL_AC1, cal, sizeof(cal))) { return false; }
 
-    mb = I2C_read16_reg(BMP085_I2CADDR, BMP085_CAL_MB);
-    mc = I2C_read16_reg(BMP085_I2CADDR, BMP085_CAL_MC);
-    md = I2C_read16_reg(BMP085_I2CADDR, BMP085_CAL_MD);
+    # define P006_CAL(reg) ((static_cast<uint16_t>(cal[(reg) - BMP085_CAL_AC1]) << 8) | cal[(reg) - BMP085_CAL_AC1 + 1])
+    ac1 = P006_CAL(BMP085_CAL_AC1);
+    ac2 = P006_CAL(BMP085_CAL_AC2);
+    ac3 = P006_CAL(BMP085_CAL_AC3);
+    ac4 = P006_CAL(BMP085_CAL_AC4);
+    ac5 = P006_CAL(BMP085_CAL_AC5);
+    ac6 = P006_CAL(BMP085_CAL_AC6);
+
+    b1 = P006_CAL(BMP085_CAL_B1);
+    b2 = P006_CAL(BMP085_CAL_B2);
+
+    mb = P006_CAL(BMP085_CAL_MB);
+    mc = P006_CAL(BMP085_CAL_MC);
+    md = P006_CAL(BMP085_CAL_MD);
+    # undef P006_CAL
 
     initialized = true;
   }
@@ -48,10 +54,18 @@ bool P006_data_struct::begin()
   return true;
 }
 
-uint16_t P006_data_struct::readRawTemperature()
+void P006_data_struct::startTemperatureConversion()
 {
   I2C_write8_reg(BMP085_I2CADDR, BMP085_CONTROL, BMP085_READTEMPCMD);
-  delay(5);
+}
+
+void P006_data_struct::startPressureConversion()
+{
+  I2C_write8_reg(BMP085_I2CADDR, BMP085_CONTROL, BMP085_READPRESSURECMD + (oversampling << 6));
+}
+
+uint16_t P006_data_struct::readRawTemperature()
+{
   return I2C_read16_reg(BMP085_I2CADDR, BMP085_TEMPDATA);
 }
 
@@ -59,10 +73,6 @@ uint32_t P006_data_struct::readRawPressure()
 {
   uint32_t raw;
 
-  I2C_write8_reg(BMP085_I2CADDR, BMP085_CONTROL, BMP085_READPRESSURECMD + (oversampling << 6));
-
-  delay(26);
-
   raw   = I2C_read16_reg(BMP085_I2CADDR, BMP085_PRESSUREDATA);
   raw <<= 8;
   raw  |= I2C_read8_reg(BMP085_I2CADDR, BMP085_PRESSUREDATA + 2);
@@ -71,14 +81,11 @@ uint32_t P006_data_struct::readRawPressure()
   return raw;
 }
 
-int32_t P006_data_struct::readPressure()
+int32_t P006_data_struct::computePressure(int32_t UT, int32_t UP) const
 {
-  int32_t  UT, UP, B3, B5, B6, X1, X2, X3, p;
+  int32_t  B3, B5, B6, X1, X2, X3, p;
   uint32_t B4, B7;
 
-  UT = readRawTemperature();
-  UP = readRawPressure();
-
   // do temperature calculations
   X1 = (UT - (int32_t)(ac6)) * ((int32_t)(ac5)) / 32768.0f /*pow(2, 15)*/;
   X2 = ((int32_t)mc * 2048.0f /*pow(2, 11)*/) / (X1 + (int32_t)md);
@@ -113,13 +120,11 @@ int32_t P006_data_struct::readPressure()
   return p;
 }
 
-float P006_data_struct::readTemperature()
+float P006_data_struct::computeTemperature(int32_t UT) const
 {
-  int32_t UT, X1, X2, B5; // following ds convention
+  int32_t X1, X2, B5; // following ds convention
   float   temp;
 
-  UT = readRawTemperature();
-
   // step 1
   X1    = (UT - (int32_t)ac6) * ((int32_t)ac5) / 32768.0f /*pow(2, 15)*/;
   X2    = ((int32_t)mc * 2048.0f /*pow(2, 11)*/) / (X1 + (int32_t)md);
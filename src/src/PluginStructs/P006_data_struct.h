@@ -7,19 +7,33 @@
 
 # define BMP085_ULTRAHIGHRES         3
 
+// Conversion times in msec, see datasheet
+# define P006_TEMPERATURE_CONVERSION_TIME  5
+# define P006_PRESSURE_CONVERSION_TIME     26 // Ultra high resolution
+
 struct P006_data_struct : public PluginTaskData_base {
   P006_data_struct() = default;
   virtual ~P006_data_struct() = default;
 
   bool     begin();
 
+  // Start the conversions, readout is done in PLUGIN_READ via readPhase
+  void     startTemperatureConversion();
+
+  void     startPressureConversion();
+
   uint16_t readRawTemperature();
 
   uint32_t readRawPressure();
 
-  int32_t  readPressure();
+  int32_t  computePressure(int32_t UT,
+                           int32_t UP) const;
+
+  float    computeTemperature(int32_t UT) const;
 
-  float    readTemperature();
+  PluginTwoPhaseRead readPhase;
+  int32_t            rawTemperature = 0;
+  bool               rawTemperatureValid = false;
 
   uint8_t  oversampling = BMP085_ULTRAHIGHRES;
   int16_t  ac1 = 0;
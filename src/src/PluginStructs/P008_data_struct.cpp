@@ -84,105 +84,163 @@ bool P008_data_struct::plugin_init(struct EventStruct *event) {
 * plugin_once_a_second
 *****************************************************/
 bool P008_data_struct::plugin_once_a_second(struct EventStruct *event) {
+  if (initialised && (bitCount > 0)) {
+    // Incomplete keypad entry, not finished by #
+    timeoutCount++;
+
+    if (timeoutCount > P008_TIMEOUT_LIMIT) {
+      if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+        addLogMove(LOG_LEVEL_INFO, concat(F("RFID : reset bits: "), static_cast<int>(bitCount)));
+      }
+
+      // reset after ~5 sec
+      keyBuffer    = 0ull;
+      bitCount     = 0u;
+      timeoutCount = 0u;
+    }
+  }
+  return false;
+}
+
+/*****************************************************
+* plugin_fifty_per_second
+*****************************************************/
+bool P008_data_struct::plugin_fifty_per_second(struct EventStruct *event) {
   bool success = false;
 
   if (initialised) {
-    if (bitCount > 0) {
-      success = true; // Let's assume read succeeded
-      uint64_t keyMask = 0ull;
-
-      if ((bitCount % 4 == 0) && ((keyBuffer & 0xF) == 11)) {
-        // a number of keys were pressed and finished by #
-        keyBuffer   = keyBuffer >> 4; // Strip #
-        bufferValid = true;
-        bufferBits  = bitCount;
-      } else if (bitCount == P008_DATA_BITS) {
-        // read a tag
-        keyBuffer = keyBuffer >> 1;                 // Strip leading and trailing parity bits from the keyBuffer
-
-        keyMask = (0x1ull << (P008_DATA_BITS - 2)); // Shift in 1 just past the number of remaining bits
-        keyMask--;                                  // Decrement by 1 to get 0xFFFFFFFFFFFF...
-        keyBuffer  &= keyMask;
-        bufferValid = true;
-        bufferBits  = bitCount;
-      } else {
-        // not enough bits, maybe next time
-        timeoutCount++;
-        bufferValid = false;
-        bufferBits  = 0u;
-
-        if (timeoutCount > P008_TIMEOUT_LIMIT) {
-          if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-            addLogMove(LOG_LEVEL_INFO, concat(F("RFID : reset bits: "), static_cast<int>(bitCount)));
-          }
-
-          // reset after ~5 sec
-          keyBuffer    = 0ull;
-          bitCount     = 0u;
-          timeoutCount = 0u;
-        }
-        success = false;
+    finishPendingFrame();
+
+    if (_framesLost != 0) {
+      if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+        addLogMove(LOG_LEVEL_ERROR, concat(F("RFID : Frames lost: "), static_cast<int>(_framesLost)));
       }
+      _framesLost = 0u;
+    }
 
-      if (success) {
-        uint64_t old_key = UserVar.getSensorTypeLong(event->TaskIndex);
-        bool     new_key = false;
-
-        if (P008_HEX_AS_DEC == 1) {
-          keyBuffer = castHexAsDec(keyBuffer);
-        }
-
-        if (old_key != keyBuffer) {
-          UserVar.setSensorTypeLong(event->TaskIndex, keyBuffer);
-          new_key = true;
-        }
-
-        if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-          // write log
-          String log = F("RFID : ");
-
-          if (new_key) {
-            log += F("New Tag: ");
-          } else {
-            log += F("Old Tag: ");
-          }
-          log += (unsigned long)keyBuffer;
-          log += F(", 0x");
-          log += ull2String(keyBuffer, 16);
-          log += F(", mask: 0x");
-          log += ull2String(keyMask, 16);
-          log += F(" Bits: ");
-          log += bitCount;
-          addLogMove(LOG_LEVEL_INFO, log);
-        }
-
-        // reset everything
-        keyBuffer    = 0ull;
-        bitCount     = 0u;
-        timeoutCount = 0u;
-
-        if (new_key) { sendData(event); }
-        uint32_t resetTimer = P008_REMOVE_TIMEOUT;
-
-        if (resetTimer < 250) { resetTimer = 250; }
-        Scheduler.setPluginTaskTimer(resetTimer, event->TaskIndex, event->Par1);
-
-        // Used during debugging
-        // String   info;
-        // uint64_t invalue  = 0x1234;
-        // uint64_t outvalue = castHexAsDec(invalue);
-        // info.reserve(40);
-        // info += F("Test castHexAsDec(");
-        // info += (ESPEASY_RULES_FLOAT_TYPE)invalue;
-        // info += F(") => ");
-        // info += (ESPEASY_RULES_FLOAT_TYPE)outvalue;
-        // addLog(LOG_LEVEL_INFO, info);
+    while (_frameTail != _frameHead) {
+      const Frame frame = _frames[_frameTail];
+
+      _frameTail = (_frameTail + 1) & (P008_FRAME_BUFFER_SIZE - 1);
+
+      if (processFrame(event, frame)) {
+        success = true;
       }
     }
   }
   return success;
 }
 
+void P008_data_struct::finishPendingFrame() {
+  if ((_isrBitCount != 0) && ((micros() - _lastBitMicros) > P008_FRAME_GAP_USEC)) {
+    ISR_noInterrupts();
+
+    // Check again, as a bit may have arrived in the meantime
+    if ((_isrBitCount != 0) && ((micros() - _lastBitMicros) > P008_FRAME_GAP_USEC)) {
+      Plugin_008_push_frame(this);
+    }
+    ISR_interrupts();
+  }
+}
+
+bool P008_data_struct::processFrame(struct EventStruct *event, const Frame& frame) {
+  if (frame.bitCount > 8) {
+    // A tag is handled on its own, drop any incomplete keypad entry
+    keyBuffer = 0ull;
+    bitCount  = 0u;
+  }
+  keyBuffer     = (frame.bitCount >= 64) ? frame.bits : ((keyBuffer << frame.bitCount) | frame.bits);
+  bitCount     += frame.bitCount;
+  timeoutCount  = 0u;
+
+  uint64_t keyMask = 0ull;
+
+  if ((bitCount % 4 == 0) && ((keyBuffer & 0xF) == 11)) {
+    // a number of keys were pressed and finished by #
+    keyBuffer   = keyBuffer >> 4; // Strip #
+    bufferValid = true;
+    bufferBits  = bitCount;
+  } else if (bitCount == P008_DATA_BITS) {
+    // read a tag
+    keyBuffer = keyBuffer >> 1;                 // Strip leading and trailing parity bits from the keyBuffer
+
+    keyMask = (0x1ull << (P008_DATA_BITS - 2)); // Shift in 1 just past the number of remaining bits
+    keyMask--;                                  // Decrement by 1 to get 0xFFFFFFFFFFFF...
+    keyBuffer  &= keyMask;
+    bufferValid = true;
+    bufferBits  = bitCount;
+  } else {
+    bufferValid = false;
+    bufferBits  = 0u;
+
+    if (frame.bitCount > 8) {
+      // Not a valid tag, e.g. a read error or a different Wiegand type.
+      if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+        addLogMove(LOG_LEVEL_INFO, concat(F("RFID : reset bits: "), static_cast<int>(bitCount)));
+      }
+      keyBuffer = 0ull;
+      bitCount  = 0u;
+    }
+
+    // else: a key press, wait for more keys
+    return false;
+  }
+
+  uint64_t old_key = UserVar.getSensorTypeLong(event->TaskIndex);
+  bool     new_key = false;
+
+  if (P008_HEX_AS_DEC == 1) {
+    keyBuffer = castHexAsDec(keyBuffer);
+  }
+
+  if (old_key != keyBuffer) {
+    UserVar.setSensorTypeLong(event->TaskIndex, keyBuffer);
+    new_key = true;
+  }
+
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    // write log
+    String log = F("RFID : ");
+
+    if (new_key) {
+      log += F("New Tag: ");
+    } else {
+      log += F("Old Tag: ");
+    }
+    log += (unsigned long)keyBuffer;
+    log += F(", 0x");
+    log += ull2String(keyBuffer, 16);
+    log += F(", mask: 0x");
+    log += ull2String(keyMask, 16);
+    log += F(" Bits: ");
+    log += bitCount;
+    addLogMove(LOG_LEVEL_INFO, log);
+  }
+
+  // reset everything
+  keyBuffer    = 0ull;
+  bitCount     = 0u;
+  timeoutCount = 0u;
+
+  if (new_key) { sendData(event); }
+  uint32_t resetTimer = P008_REMOVE_TIMEOUT;
+
+  if (resetTimer < 250) { resetTimer = 250; }
+  Scheduler.setPluginTaskTimer(resetTimer, event->TaskIndex, event->Par1);
+
+  // Used during debugging
+  // String   info;
+  // uint64_t invalue  = 0x1234;
+  // uint64_t outvalue = castHexAsDec(invalue);
+  // info.reserve(40);
+  // info += F("Test castHexAsDec(");
+  // info += (ESPEASY_RULES_FLOAT_TYPE)invalue;
+  // info += F(") => ");
+  // info += (ESPEASY_RULES_FLOAT_TYPE)outvalue;
+  // addLog(LOG_LEVEL_INFO, info);
+  return true;
+}
+
 /*****************************************************
 * plugin_timer_in
 *****************************************************/
@@ -202,15 +260,40 @@ bool P008_data_struct::plugin_timer_in(struct EventStruct *event) {
   return false;
 }
 
+/***********************************************************************
+ * push_frame
+ **********************************************************************/
+void IRAM_ATTR P008_data_struct::Plugin_008_push_frame(P008_data_struct *self) {
+  const uint8_t next = (self->_frameHead + 1) & (P008_FRAME_BUFFER_SIZE - 1);
+
+  if (next == self->_frameTail) {
+    // Buffer full, the oldest frames must be processed first.
+    self->_framesLost++;
+  } else {
+    self->_frames[self->_frameHead].bits     = self->_isrBuffer;
+    self->_frames[self->_frameHead].bitCount = self->_isrBitCount;
+    self->_frameHead                         = next;
+  }
+  self->_isrBuffer   = 0ull;
+  self->_isrBitCount = 0u;
+}
+
 /***********************************************************************
  * shift_bit_in_buffer
  **********************************************************************/
 void IRAM_ATTR P008_data_struct::Plugin_008_shift_bit_in_buffer(P008_data_struct *self,
                                                                 uint8_t           bit) {
-  self->keyBuffer = self->keyBuffer << 1; // Left shift the number (effectively multiplying by 2)
+  const uint32_t now = micros();
+
+  if ((self->_isrBitCount != 0) && ((now - self->_lastBitMicros) > P008_FRAME_GAP_USEC)) {
+    // First bit of a new frame, while the previous one was not yet completed by finishPendingFrame()
+    Plugin_008_push_frame(self);
+  }
+  self->_lastBitMicros = now;
+  self->_isrBuffer     = self->_isrBuffer << 1; // Left shift the number (effectively multiplying by 2)
 
-  if (bit) { self->keyBuffer |= 1ull; }   // Add the 1 (not necessary for the zeroes)
-  self->bitCount++;                       // Increment the bit count
+  if (bit) { self->_isrBuffer |= 1ull; }        // Add the 1 (not necessary for the zeroes)
+  self->_isrBitCount++;                         // Increment the bit count
 }
 
 /*********************************************************************
@@ -14,6 +14,15 @@
 
 # define P008_TIMEOUT_LIMIT   5 // Number of loops through plugin_one_per_second = 5 second time-out
 
+// A pause in the bit stream longer than this marks the end of a frame (tag or key press).
+// Wiegand readers typically send a bit every 1 - 2 msec.
+# ifndef P008_FRAME_GAP_USEC
+#  define P008_FRAME_GAP_USEC  15000
+# endif // ifndef P008_FRAME_GAP_USEC
+
+// Nr. of completed frames which can be buffered between two PLUGIN_FIFTY_PER_SECOND calls, must be a power of 2.
+# define P008_FRAME_BUFFER_SIZE  4
+
 struct P008_data_struct : public PluginTaskData_base {
 public:
 
@@ -24,23 +33,49 @@ public:
 
   bool plugin_init(struct EventStruct *event);
   bool plugin_once_a_second(struct EventStruct *event);
+  bool plugin_fifty_per_second(struct EventStruct *event);
   bool plugin_timer_in(struct EventStruct *event);
   bool plugin_get_config(struct EventStruct *event,
                          String            & string);
 
-  volatile uint8_t  bitCount  = 0u;   // Count the number of bits received.
-  volatile uint64_t keyBuffer = 0ull; // A 64-bit-long keyBuffer into which the number is stored.
-
 private:
 
+  struct Frame {
+    uint64_t bits     = 0ull;
+    uint8_t  bitCount = 0u;
+  };
+
   uint64_t    castHexAsDec(uint64_t hexValue);
 
+  // Complete the frame received by the ISR after the frame gap, when no more bits arrived.
+  void        finishPendingFrame();
+
+  // Add the frame to the key buffer and report a complete tag or keypad entry.
+  bool        processFrame(struct EventStruct *event,
+                           const Frame       & frame);
+
+  // Move the bits received by the ISR to the frame buffer. Only to be called from the ISR or with interrupts disabled.
+  static void Plugin_008_push_frame(P008_data_struct *self);
+
   static void Plugin_008_shift_bit_in_buffer(P008_data_struct *self,
                                              uint8_t           bit);
   static void Plugin_008_interrupt1(P008_data_struct *self);
   static void Plugin_008_interrupt2(P008_data_struct *self);
 
-  uint8_t timeoutCount = 0u;
+  // Written by the ISR only
+  volatile uint64_t _isrBuffer     = 0ull;
+  volatile uint8_t  _isrBitCount   = 0u;
+  volatile uint32_t _lastBitMicros = 0u;
+  volatile uint8_t  _frameHead     = 0u; // Also written with interrupts disabled by finishPendingFrame()
+  volatile uint8_t  _framesLost    = 0u;
+
+  // Single producer (ISR), single consumer (plugin_fifty_per_second) ring buffer of completed frames.
+  Frame            _frames[P008_FRAME_BUFFER_SIZE];
+  volatile uint8_t _frameTail = 0u;
+
+  uint8_t  bitCount     = 0u;   // Count the number of bits received.
+  uint64_t keyBuffer    = 0ull; // A 64-bit-long keyBuffer into which the number is stored.
+  uint8_t  timeoutCount = 0u;
   bool    initialised  = false;
   bool    bufferValid  = false;
   uint8_t bufferBits   = 0u;
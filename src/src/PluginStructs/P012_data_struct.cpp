@@ -37,10 +37,21 @@ void P012_data_struct::init() {
   // Setup LCD display
   lcd.init(); // initialize the lcd
   lcd.backlight();
-  lcd.print(F("ESP Easy"));
+  setShownText(' '); // Display is cleared by init()
+  lcdWrite(F("ESP Easy"), 0, 0);
   createCustomChars();
 }
 
+void P012_data_struct::clearDisplay() {
+  lcd.clear();
+  setShownText(' ');
+}
+
+void P012_data_struct::setShownText(char c) {
+  memset(shownText, c, sizeof(shownText));
+  runLength = 0;
+}
+
 void P012_data_struct::setBacklightTimer(uint8_t timer) {
   displayTimer = timer;
   lcd.backlight();
@@ -58,23 +69,16 @@ void P012_data_struct::checkTimer() {
 }
 
 void P012_data_struct::lcdWrite(const String& text, uint8_t col, uint8_t row) {
-  // clear line before writing new string
-  if (Plugin_012_mode == 2) {
-    lcd.setCursor(col, row);
-
-    for (uint8_t i = col; i < Plugin_012_cols; i++) {
-      lcd.print(' ');
-    }
-  }
-
-  lcd.setCursor(col, row);
+  const uint16_t textLength = text.length();
 
   if ((Plugin_012_mode == 1) || (Plugin_012_mode == 2)) {
-    lcd.setCursor(col, row);
-
-    for (uint8_t i = 0; i < Plugin_012_cols - col; i++) {
-      if (text[i]) {
-        lcd.print(text[i]);
+    for (uint8_t i = col; i < Plugin_012_cols; i++) {
+      if ((i - col) < textLength) {
+        lcdPut(i, row, text[i - col]);
+      } else if (Plugin_012_mode == 2) {
+        lcdPut(i, row, ' '); // clear rest of the line
+      } else {
+        break;
       }
     }
   }
@@ -82,29 +86,47 @@ void P012_data_struct::lcdWrite(const String& text, uint8_t col, uint8_t row) {
   // message exceeding cols will continue to next line
   else {
     // Fix Weird (native) lcd display behaviour that split long string into row 1,3,2,4, instead of 1,2,3,4
-    bool stillProcessing = 1;
-    uint8_t charCount    = 1;
-
-    while (stillProcessing) {
-      if (++col > Plugin_012_cols) { // have we printed 20 characters yet (+1 for the logic)
-        row += 1;
-        lcd.setCursor(0, row);       // move cursor down
-        col = 1;
-      }
+    // by positioning each line explicitly
+    for (uint16_t i = 0; i < textLength; i++) {
+      const uint16_t pos = col + i;
+      const uint16_t r   = row + pos / Plugin_012_cols;
 
-      // dont print if "lower" than the lcd
-      if (row < Plugin_012_rows) {
-        lcd.print(text[charCount - 1]);
+      if (r >= Plugin_012_rows) { // dont print if "lower" than the lcd
+        break;
       }
-
-      if (!text[charCount]) { // no more chars to process?
-        stillProcessing = 0;
-      }
-      charCount += 1;
+      lcdPut(pos % Plugin_012_cols, r, text[i]);
     }
+  }
+  lcdFlush();
+}
+
+void P012_data_struct::lcdPut(uint8_t col, uint8_t row, char c) {
+  if ((col >= Plugin_012_cols) || (row >= Plugin_012_rows)) {
+    return;
+  }
+
+  if (shownText[row][col] == c) {
+    lcdFlush(); // Unchanged, send what we have so far
+    return;
+  }
+
+  if ((runLength > 0) && ((row != runRow) || (col != (runCol + runLength)))) {
+    lcdFlush();
+  }
+
+  if (runLength == 0) {
+    runCol = col;
+    runRow = row;
+  }
+  runBuffer[runLength++] = c;
+  shownText[row][col]    = c;
+}
 
-    // lcd.print(text.c_str());
-    // end fix
+void P012_data_struct::lcdFlush() {
+  if (runLength > 0) {
+    lcd.setCursor(runCol, runRow);
+    lcd.write(reinterpret_cast<const uint8_t *>(runBuffer), runLength);
+    runLength = 0;
   }
 }
 
@@ -7,6 +7,9 @@
 
 # include <LiquidCrystal_I2C.h>
 
+# define P012_MAX_COLS  20
+# define P012_MAX_ROWS  4
+
 struct P012_data_struct : public PluginTaskData_base {
   P012_data_struct(uint8_t addr,
                    uint8_t lcd_size,
@@ -21,10 +24,13 @@ struct P012_data_struct : public PluginTaskData_base {
 
   void checkTimer();
 
+  // Only the characters that differ from what is shown are sent to the display
   void lcdWrite(const String& text,
                 uint8_t       col,
                 uint8_t       row);
 
+  void clearDisplay();
+
   String P012_parseTemplate(String& tmpString,
                             uint8_t lineSize);
 
@@ -36,6 +42,23 @@ struct P012_data_struct : public PluginTaskData_base {
   int               Plugin_012_rows = 2;
   int               Plugin_012_mode = 1;
   uint8_t           displayTimer    = 0;
+
+private:
+
+  // Queue a character at col, row, consecutive characters are sent in a single write
+  void lcdPut(uint8_t col,
+              uint8_t row,
+              char    c);
+
+  void lcdFlush();
+
+  void setShownText(char c);
+
+  char    shownText[P012_MAX_ROWS][P012_MAX_COLS] = {}; // Characters on the display, 0 = unknown
+  char    runBuffer[P012_MAX_COLS]                = {};
+  uint8_t runLength                               = 0;
+  uint8_t runCol                                  = 0;
+  uint8_t runRow                                  = 0;
 };
 
 #endif // ifdef USES_P012
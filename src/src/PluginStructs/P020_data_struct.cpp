@@ -27,6 +27,7 @@ P020_Task::~P020_Task() {
     delete ser2netSerial;
     ser2netSerial = nullptr;
   }
+  initBridge(false);
 }
 
 bool P020_Task::serverActive(WiFiServer *server) {
@@ -95,6 +96,7 @@ bool P020_Task::hasClientConnected() {
     #else // ifdef MUSTFIX_CLIENT_TIMEOUT_IN_SECONDS
     ser2netClient.setTimeout(CONTROLLER_CLIENTTIMEOUT_DFLT);                // in msec as it should be!
     #endif // ifdef MUSTFIX_CLIENT_TIMEOUT_IN_SECONDS
+    ser2netClient.setNoDelay(noDelay);
 
     sendConnectedEvent(true);
     addLog(LOG_LEVEL_INFO, F("Ser2Net   : Client connected!"));
@@ -129,11 +131,17 @@ void P020_Task::clearBuffer() {
   serial_buffer.reserve(P020_DATAGRAM_MAX_SIZE);
 }
 
-void P020_Task::serialBegin(const ESPEasySerialPort port, int16_t rxPin, int16_t txPin, unsigned long baud, uint8_t config) {
+void P020_Task::serialBegin(const ESPEasySerialPort port,
+                            int16_t                 rxPin,
+                            int16_t                 txPin,
+                            unsigned long           baud,
+                            uint8_t                 config,
+                            unsigned int            rxBufferSize) {
   serialEnd();
 
   if (rxPin >= 0) {
-    ser2netSerial = new (std::nothrow) ESPeasySerial(port, rxPin, txPin);
+    serialRxBufferSize = rxBufferSize;
+    ser2netSerial      = new (std::nothrow) ESPeasySerial(port, rxPin, txPin, false, rxBufferSize);
 
     if (nullptr != ser2netSerial) {
       # if defined(ESP8266)
@@ -284,6 +292,74 @@ void P020_Task::rulesEngine(const String& message) {
   } while (handleMultiLine && NewLinePos > StartPos);
 }
 
+bool P020_Task::initBridge(bool enable) {
+  bridgeMode = false;
+
+  if (enable) {
+    if (nullptr == bridgeBuffer) {
+      bridgeBuffer = new (std::nothrow) uint8_t[P020_BRIDGE_BUFFER_SIZE];
+    }
+    bridgeMode = nullptr != bridgeBuffer;
+  } else if (nullptr != bridgeBuffer) {
+    delete[] bridgeBuffer;
+    bridgeBuffer = nullptr;
+  }
+  serialBytesIn = 0;
+  clientBytesIn = 0;
+  serialRxFull  = 0;
+  clientDropped = 0;
+  return bridgeMode;
+}
+
+void P020_Task::handleBridge() {
+  if ((nullptr == ser2netSerial) || (nullptr == bridgeBuffer)) { return; }
+  const bool connected = ser2netClient.connected();
+
+  // Serial to client, everything received so far in a single read and write
+  int count = ser2netSerial->available();
+
+  if (count > 0) {
+    if (static_cast<unsigned int>(count) >= serialRxBufferSize) {
+      ++serialRxFull;
+    }
+
+    if (count > P020_BRIDGE_BUFFER_SIZE) { count = P020_BRIDGE_BUFFER_SIZE; }
+    const size_t bytes_read = ser2netSerial->read(bridgeBuffer, count);
+    serialBytesIn += bytes_read;
+
+    if (connected && (bytes_read > 0)) {
+      const size_t written = ser2netClient.write(bridgeBuffer, bytes_read);
+
+      if (written < bytes_read) {
+        clientDropped += bytes_read - written;
+      }
+    }
+  }
+
+  if (!connected) { return; }
+
+  // Client to serial, no more than fits in the serial TX buffer.
+  // The remaining data is kept in the TCP receive window, so the sender is throttled instead of data dropped.
+  count = ser2netClient.available();
+
+  if (count > 0) {
+    const int room = ser2netSerial->availableForWrite();
+
+    if (count > room) { count = room; }
+
+    if (count > P020_BRIDGE_BUFFER_SIZE) { count = P020_BRIDGE_BUFFER_SIZE; }
+
+    if (count > 0) {
+      const int bytes_read = ser2netClient.read(bridgeBuffer, count);
+
+      if (bytes_read > 0) {
+        ser2netSerial->write(bridgeBuffer, bytes_read);
+        clientBytesIn += bytes_read;
+      }
+    }
+  }
+}
+
 bool P020_Task::isInit() const {
   return nullptr != ser2netServer && nullptr != ser2netSerial;
 }
@@ -13,6 +13,7 @@
 
 # define P020_STATUS_LED                    12
 # define P020_DATAGRAM_MAX_SIZE             256
+# define P020_BRIDGE_BUFFER_SIZE            1460 // TCP MSS, max. bytes per read/write in bridge mode
 struct P020_Task : public PluginTaskData_base {
   P020_Task(taskIndex_t taskIndex);
   P020_Task() = delete;
@@ -37,7 +38,8 @@ struct P020_Task : public PluginTaskData_base {
                                  int16_t                 rxPin,
                                  int16_t                 txPin,
                                  unsigned long           baud,
-                                 uint8_t                 config);
+                                 uint8_t                 config,
+                                 unsigned int            rxBufferSize = SOC_UART_FIFO_LEN);
 
   void serialEnd();
 
@@ -45,6 +47,10 @@ struct P020_Task : public PluginTaskData_base {
   void handleClientIn(struct EventStruct *event);
   void rulesEngine(const String& message);
 
+  // Transparent bridge mode, pass all data as-is in both directions, without event processing
+  bool initBridge(bool enable);
+  void handleBridge();
+
   void discardSerialIn();
 
   bool isInit() const;
@@ -62,6 +68,16 @@ struct P020_Task : public PluginTaskData_base {
   uint8_t        serial_processing = 0;
   taskIndex_t    _taskIndex        = INVALID_TASK_INDEX;
   bool           handleMultiLine   = false;
+  bool           bridgeMode        = false;
+  bool           noDelay           = false; // Disable Nagle algorithm on the client connection
+  uint8_t       *bridgeBuffer      = nullptr;
+  unsigned int   serialRxBufferSize = SOC_UART_FIFO_LEN;
+
+  // Bridge mode statistics
+  uint32_t serialBytesIn = 0;
+  uint32_t clientBytesIn = 0;
+  uint32_t serialRxFull  = 0; // Nr of times the serial RX buffer was full, received data may be lost
+  uint32_t clientDropped = 0; // Bytes that could not be written to the client
 };
 
 #endif // ifdef USES_P020
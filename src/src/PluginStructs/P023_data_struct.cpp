@@ -356,15 +356,22 @@ void P023_data_struct::displayOff() {
 }
 
 void P023_data_struct::clearDisplay() {
-  unsigned char i, k;
+  uint8_t zeros[P023_I2C_CHUNK_SIZE] = { 0 };
 
-  for (k = 0; k < 8; k++) {
+  for (unsigned char k = 0; k < 8; k++) {
     setXY(k, 0);
 
-    for (i = 0; i < 128; i++) { // clear all COL
-      sendChar(0);              // clear all COL
+    for (uint8_t i = 0; i < 128; i += sizeof(zeros)) { // clear all COL
+      sendData(zeros, sizeof(zeros));
     }
   }
+
+  // Spaces are drawn as empty cells, with optimized spacing the lines are empty
+  memset(shownText, font_spacing == Spacing::optimized ? 0 : ' ', sizeof(shownText));
+
+  for (unsigned char k = 0; k < P23_Nlines; k++) {
+    shownText[k][P023_SHADOW_CHARS] = 0;
+  }
 }
 
 // Actually this sends a byte, not a char to draw in the display.
@@ -376,52 +383,121 @@ void P023_data_struct::sendCommand(unsigned char com) {
   I2C_write8_reg(address, P023_COMMAND_MODE_REG, com);
 }
 
+void P023_data_struct::sendData(uint8_t *data, size_t length) {
+  while (length > 0) {
+    const uint8_t chunk = (length > P023_I2C_CHUNK_SIZE) ? P023_I2C_CHUNK_SIZE : length;
+    I2C_writeBytes_reg(address, P023_DATA_MODE_REG, data, chunk);
+    data   += chunk;
+    length -= chunk;
+  }
+}
+
+uint8_t P023_data_struct::charWidth(char c) const {
+  if (font_spacing == Spacing::optimized) {
+    return pgm_read_byte(&(Plugin_023_myFont_Size[c - 0x20]));
+  }
+  return 8;
+}
+
 // Set the cursor position in a 16 COL * 8 ROW map (128x64 pixels)
 // or 8 COL * 5 ROW map (64x48 pixels)
 void P023_data_struct::setXY(unsigned char row, unsigned char col) {
-  unsigned char col_offset = 0;
+  setXYpixel(row, 8 * col);
+}
 
+void P023_data_struct::setXYpixel(unsigned char row, uint16_t pixel) {
   if (use_sh1106) {
-    col_offset = 0x02; // offset of 2 when using SSH1106 controller
+    pixel += 0x02; // offset of 2 when using SSH1106 controller
   }
 
   if (type == OLED_64x48) {
-    col += 4;
+    pixel += 32;
   } else if (type == (OLED_64x48 | OLED_rotated)) {
-    col += 4;
-    row += 2;
+    pixel += 32;
+    row   += 2;
   }
 
-  sendCommand(0xb0 + row);                             // set page address
-  sendCommand(0x00 + ((8 * col + col_offset) & 0x0f)); // set low col address
-  sendCommand(0x10 + (((8 * col) >> 4) & 0x0f));       // set high col address
+  uint8_t commands[3] = {
+    static_cast<uint8_t>(0xb0 + row),                    // set page address
+    static_cast<uint8_t>(0x00 + (pixel & 0x0f)),         // set low col address
+    static_cast<uint8_t>(0x10 + ((pixel >> 4) & 0x0f)) }; // set high col address
+
+  I2C_writeBytes_reg(address, 0x00, commands, sizeof(commands)); // Control byte for a stream of commands
 }
 
 // Prints a string in coordinates X Y, being multiples of 8.
 // This means we have 16 COLS (0-15) and 8 ROWS (0-7).
 void P023_data_struct::sendStrXY(const char *string, int X, int Y) {
-  setXY(X, Y);
-  uint16_t i             = 0;
-  uint16_t char_width    = 8;
+  if ((X < 0) || (X >= P23_Nlines) || (Y < 0)) { return; }
   uint16_t maxPixels     = 128;   // Assumed default display width
   uint16_t currentPixels = Y * 8; // setXY always uses char_width = 8, Y = 0-based
+  uint8_t  index         = Y;     // Character index in shownText
+  char    *shown         = shownText[X];
+  const bool optimized   = font_spacing == Spacing::optimized;
 
   if ((type == OLED_64x48) ||     // Cater for that 1 smaller size display
       (type == (OLED_64x48 | OLED_rotated))) {
     maxPixels = 64;
   }
 
+  if (optimized) {
+    if (Y == 0) {
+      // Characters up to the first change keep their position, skip these
+      index = 0;
+
+      while (string[index] && (string[index] == shown[index]) && currentPixels < maxPixels) {
+        currentPixels += charWidth(string[index]);
+        index++;
+      }
+      string += index;
+
+      if (!*string) { return; } // Nothing changed
+    } else {
+      // Not aligned with the text from column 0, next update of this line will redraw all
+      shown[0] = 0;
+      index    = P023_SHADOW_CHARS + 1;
+    }
+  }
+
+  uint8_t buffer[P023_I2C_CHUNK_SIZE];
+  uint8_t length     = 0;
+  bool    positioned = false;
+
   while (*string && currentPixels < maxPixels) { // Prevent display overflow on the character level
-    if (font_spacing == Spacing::optimized) {
-      char_width = pgm_read_byte(&(Plugin_023_myFont_Size[*string - 0x20]));
+    const uint8_t char_width = charWidth(*string);
+
+    if (!optimized && (shown[index] == *string)) {
+      // Unchanged cell, send the changed cells so far
+      sendData(buffer, length);
+      length     = 0;
+      positioned = false;
+    } else {
+      if (!positioned) {
+        setXYpixel(X, currentPixels);
+        positioned = true;
+      }
+
+      for (uint8_t i = 0; i < char_width && currentPixels + i < maxPixels; i++) { // Prevent display overflow on the pixel-level
+        if (length == sizeof(buffer)) {
+          sendData(buffer, length);
+          length = 0;
+        }
+        buffer[length++] = pgm_read_byte(Plugin_023_myFont[*string - 0x20] + i);
+      }
     }
 
-    for (i = 0; i < char_width && currentPixels + i < maxPixels; i++) { // Prevent display overflow on the pixel-level
-      sendChar(pgm_read_byte(Plugin_023_myFont[*string - 0x20] + i));
+    if (index < P023_SHADOW_CHARS) {
+      shown[index] = *string;
+      index++;
     }
     currentPixels += char_width;
     string++;
   }
+  sendData(buffer, length);
+
+  if (optimized && (index <= P023_SHADOW_CHARS)) {
+    shown[index] = 0;
+  }
 }
 
 void P023_data_struct::init_OLED() {
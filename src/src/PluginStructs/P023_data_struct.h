@@ -9,6 +9,9 @@
 # define P23_Nlines 8 // The number of different lines which can be displayed
 # define P23_Nchars 64
 
+# define P023_SHADOW_CHARS    26 // Max. characters shown on a line, 128 pixels / 5 pixels for the smallest optimized character
+# define P023_I2C_CHUNK_SIZE  64 // Max. data bytes sent in a single I2C transmission
+
 
 struct P023_data_struct : public PluginTaskData_base {
   enum {
@@ -78,6 +81,7 @@ struct P023_data_struct : public PluginTaskData_base {
 
   // Prints a string in coordinates X Y, being multiples of 8.
   // This means we have 16 COLS (0-15) and 8 ROWS (0-7).
+  // Only the characters that differ from what is shown are sent to the display.
   void sendStrXY(const char *string,
                  int         X,
                  int         Y);
@@ -92,8 +96,22 @@ struct P023_data_struct : public PluginTaskData_base {
 
 private:
 
+  // Set the cursor position in pixels, and send the commands in a single I2C transmission
+  void    setXYpixel(unsigned char row,
+                     uint16_t      pixel);
+
+  // Send display data in chunks of P023_I2C_CHUNK_SIZE bytes
+  void    sendData(uint8_t *data,
+                   size_t   length);
+
+  uint8_t charWidth(char c) const;
+
   String strings[P23_Nlines]{};
   String currentLines[P23_Nlines]{};
+
+  // Characters on the display, per 8 pixel cell with normal spacing, 0 = unknown.
+  // With optimized spacing the zero-terminated text shown from column 0.
+  char shownText[P23_Nlines][P023_SHADOW_CHARS + 1]{};
 };
 
 #endif // ifdef USES_P023
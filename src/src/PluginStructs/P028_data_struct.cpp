@@ -263,28 +263,50 @@ bool P028_data_struct::begin() {
 
 void P028_data_struct::readCoefficients()
 {
-  calib.dig_T1 = I2C_read16_LE_reg(i2cAddress, BMx280_REGISTER_DIG_T1);
-  calib.dig_T2 = I2C_readS16_LE_reg(i2cAddress, BMx280_REGISTER_DIG_T2);
-  calib.dig_T3 = I2C_readS16_LE_reg(i2cAddress, BMx280_REGISTER_DIG_T3);
-
-  calib.dig_P1 = I2C_read16_LE_reg(i2cAddress, BMx280_REGISTER_DIG_P1);
-  calib.dig_P2 = I2C_readS16_LE_reg(i2cAddress, BMx280_REGISTER_DIG_P2);
-  calib.dig_P3 = I2C_readS16_LE_reg(i2cAddress, BMx280_REGISTER_DIG_P3);
-  calib.dig_P4 = I2C_readS16_LE_reg(i2cAddress, BMx280_REGISTER_DIG_P4);
-  calib.dig_P5 = I2C_readS16_LE_reg(i2cAddress, BMx280_REGISTER_DIG_P5);
-  calib.dig_P6 = I2C_readS16_LE_reg(i2cAddress, BMx280_REGISTER_DIG_P6);
-  calib.dig_P7 = I2C_readS16_LE_reg(i2cAddress, BMx280_REGISTER_DIG_P7);
-  calib.dig_P8 = I2C_readS16_LE_reg(i2cAddress, BMx280_REGISTER_DIG_P8);
-  calib.dig_P9 = I2C_readS16_LE_reg(i2cAddress, BMx280_REGISTER_DIG_P9);
+  // Read the calibration data in blocks instead of per register
+  uint8_t tp[BMx280_REGISTER_DIG_P9 + 2 - BMx280_REGISTER_DIG_T1]{}; // T1 ... P9
+  uint8_t h1{};
+  uint8_t h[BMx280_REGISTER_DIG_H6 + 1 - BMx280_REGISTER_DIG_H2]{};  // H2 ... H6
+
+  const I2C_reg_block_t blocks[] = {
+    { BMx280_REGISTER_DIG_T1, sizeof(tp), tp  },
+    { BMx280_REGISTER_DIG_H1, 1,          &h1 },
+    { BMx280_REGISTER_DIG_H2, sizeof(h),  h   },
+  };
+  constexpr uint8_t nrBlocks = sizeof(blocks) / sizeof(blocks[0]);
+
+  I2C_read_blocks_reg(i2cAddress, blocks, hasHumidity() ? nrBlocks : 1);
+
+  // All 16 bit values are little endian
+  # define P028_CALIB_LE(buf, reg, first) (static_cast<uint16_t>(buf[(reg) - (first) + 1] << 8) | buf[(reg) - (first)])
+  # define P028_CALIB_TP(reg)             P028_CALIB_LE(tp, reg, BMx280_REGISTER_DIG_T1)
+
+  calib.dig_T1 = P028_CALIB_TP(BMx280_REGISTER_DIG_T1);
+  calib.dig_T2 = static_cast<int16_t>(P028_CALIB_TP(BMx280_REGISTER_DIG_T2));
+  calib.dig_T3 = static_cast<int16_t>(P028_CALIB_TP(BMx280_REGISTER_DIG_T3));
+
+  calib.dig_P1 = P028_CALIB_TP(BMx280_REGISTER_DIG_P1);
+  calib.dig_P2 = static_cast<int16_t>(P028_CALIB_TP(BMx280_REGISTER_DIG_P2));
+  calib.dig_P3 = static_cast<int16_t>(P028_CALIB_TP(BMx280_REGISTER_DIG_P3));
+  calib.dig_P4 = static_cast<int16_t>(P028_CALIB_TP(BMx280_REGISTER_DIG_P4));
+  calib.dig_P5 = static_cast<int16_t>(P028_CALIB_TP(BMx280_REGISTER_DIG_P5));
+  calib.dig_P6 = static_cast<int16_t>(P028_CALIB_TP(BMx280_REGISTER_DIG_P6));
+  calib.dig_P7 = static_cast<int16_t>(P028_CALIB_TP(BMx280_REGISTER_DIG_P7));
+  calib.dig_P8 = static_cast<int16_t>(P028_CALIB_TP(BMx280_REGISTER_DIG_P8));
+  calib.dig_P9 = static_cast<int16_t>(P028_CALIB_TP(BMx280_REGISTER_DIG_P9));
 
   if (hasHumidity()) {
-    calib.dig_H1 = I2C_read8_reg(i2cAddress, BMx280_REGISTER_DIG_H1);
-    calib.dig_H2 = I2C_readS16_LE_reg(i2cAddress, BMx280_REGISTER_DIG_H2);
-    calib.dig_H3 = I2C_read8_reg(i2cAddress, BMx280_REGISTER_DIG_H3);
-    calib.dig_H4 = (I2C_read8_reg(i2cAddress, BMx280_REGISTER_DIG_H4) << 4) | (I2C_read8_reg(i2cAddress, BMx280_REGISTER_DIG_H4 + 1) & 0xF);
-    calib.dig_H5 = (I2C_read8_reg(i2cAddress, BMx280_REGISTER_DIG_H5 + 1) << 4) | (I2C_read8_reg(i2cAddress, BMx280_REGISTER_DIG_H5) >> 4);
-    calib.dig_H6 = (int8_t)I2C_read8_reg(i2cAddress, BMx280_REGISTER_DIG_H6);
+    # define P028_CALIB_H(reg) h[(reg) - BMx280_REGISTER_DIG_H2]
+    calib.dig_H1 = h1;
+    calib.dig_H2 = static_cast<int16_t>(P028_CALIB_LE(h, BMx280_REGISTER_DIG_H2, BMx280_REGISTER_DIG_H2));
+    calib.dig_H3 = P028_CALIB_H(BMx280_REGISTER_DIG_H3);
+    calib.dig_H4 = (P028_CALIB_H(BMx280_REGISTER_DIG_H4) << 4) | (P028_CALIB_H(BMx280_REGISTER_DIG_H4 + 1) & 0xF);
+    calib.dig_H5 = (P028_CALIB_H(BMx280_REGISTER_DIG_H5 + 1) << 4) | (P028_CALIB_H(BMx280_REGISTER_DIG_H5) >> 4);
+    calib.dig_H6 = static_cast<int8_t>(P028_CALIB_H(BMx280_REGISTER_DIG_H6));
+    # undef P028_CALIB_H
   }
+  # undef P028_CALIB_TP
+  # undef P028_CALIB_LE
 }
 
 bool P028_data_struct::readUncompensatedData() {
@@ -40,9 +40,6 @@ bool P032_data_struct::begin() {
 // clocked with the MSB first.
 // **************************************************************************/
 void P032_data_struct::read_prom() {
-  I2C_write8(i2cAddress, MS5xxx_CMD_RESET);
-  delay(3);
-
   for (uint8_t i = 0; i < 8; i++)
   {
     ms5611_prom[i] = I2C_read16_reg(i2cAddress, MS5xxx_CMD_PROM_RD + 2 * i);
@@ -50,26 +47,28 @@ void P032_data_struct::read_prom() {
 }
 
 // **************************************************************************/
-// Read analog/digital converter
+// Start the analog/digital converter
 // **************************************************************************/
-unsigned long P032_data_struct::read_adc(unsigned char aCMD)
+uint32_t P032_data_struct::start_adc(unsigned char aCMD)
 {
   I2C_write8(i2cAddress, MS5xxx_CMD_ADC_CONV + aCMD); // start DAQ and conversion of ADC data
 
   switch (aCMD & 0x0f)
   {
-    case MS5xxx_CMD_ADC_256: delayMicroseconds(900);
-      break;
-    case MS5xxx_CMD_ADC_512: delay(3);
-      break;
-    case MS5xxx_CMD_ADC_1024: delay(4);
-      break;
-    case MS5xxx_CMD_ADC_2048: delay(6);
-      break;
-    case MS5xxx_CMD_ADC_4096: delay(10);
-      break;
+    case MS5xxx_CMD_ADC_256:  return 1;
+    case MS5xxx_CMD_ADC_512:  return 3;
+    case MS5xxx_CMD_ADC_1024: return 4;
+    case MS5xxx_CMD_ADC_2048: return 6;
+    case MS5xxx_CMD_ADC_4096: return 10;
   }
+  return 10;
+}
 
+// **************************************************************************/
+// Read analog/digital converter result
+// **************************************************************************/
+unsigned long P032_data_struct::read_adc()
+{
   // read out values
   return I2C_read24_reg(i2cAddress, MS5xxx_CMD_ADC_READ);
 }
@@ -77,16 +76,33 @@ unsigned long P032_data_struct::read_adc(unsigned char aCMD)
 // **************************************************************************/
 // Readout
 // **************************************************************************/
-void P032_data_struct::readout() {
-  unsigned long D1 = 0, D2 = 0;
+uint32_t P032_data_struct::readout_step() {
+  switch (_readoutStep) {
+    case 0:
+      I2C_write8(i2cAddress, MS5xxx_CMD_RESET);
+      _readoutStep = 1;
+      return 3;
+    case 1:
+      read_prom();
+      _readoutStep = 2;
+      return start_adc(MS5xxx_CMD_ADC_D2 + MS5xxx_CMD_ADC_4096);
+    case 2:
+      _D2          = read_adc();
+      _readoutStep = 3;
+      return start_adc(MS5xxx_CMD_ADC_D1 + MS5xxx_CMD_ADC_4096);
+    default:
+      break;
+  }
+  _readoutStep = 0;
+  compute(read_adc(), _D2);
+  return 0;
+}
 
+void P032_data_struct::compute(unsigned long D1, unsigned long D2) {
   ESPEASY_RULES_FLOAT_TYPE dT;
   ESPEASY_RULES_FLOAT_TYPE Offset;
   ESPEASY_RULES_FLOAT_TYPE SENS;
 
-  D2 = read_adc(MS5xxx_CMD_ADC_D2 + MS5xxx_CMD_ADC_4096);
-  D1 = read_adc(MS5xxx_CMD_ADC_D1 + MS5xxx_CMD_ADC_4096);
-
   // calculate 1st order pressure and temperature (MS5611 1st order algorithm)
   dT                 = D2 - ms5611_prom[5] * static_cast<ESPEASY_RULES_FLOAT_TYPE>(1 << 8);
   Offset             = ms5611_prom[2] * static_cast<ESPEASY_RULES_FLOAT_TYPE>(1 << 16) + dT * ms5611_prom[4] / static_cast<ESPEASY_RULES_FLOAT_TYPE>(1 << 7);
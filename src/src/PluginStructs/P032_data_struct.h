@@ -25,23 +25,49 @@ public:
   // coefficients and address 7 contains the serial code and CRC.
   // The command sequence is 8 bits long with a 16 bit result which is
   // clocked with the MSB first.
+  // N.B. Sensor must have been reset at least 3 msec before.
   // **************************************************************************/
   void read_prom();
 
   // **************************************************************************/
-  // Read analog/digital converter
+  // Start the analog/digital converter
+  // Returns the conversion time in msec.
   // **************************************************************************/
-  unsigned long read_adc(unsigned char aCMD);
+  uint32_t start_adc(unsigned char aCMD);
 
   // **************************************************************************/
-  // Readout
+  // Read analog/digital converter result
   // **************************************************************************/
-  void readout();
+  unsigned long read_adc();
+
+  // **************************************************************************/
+  // Readout, split into steps to wait for the conversions without blocking.
+  // Returns the time in msec to wait before the next step,
+  // or 0 when the readout is complete.
+  // **************************************************************************/
+  uint32_t readout_step();
+
+  void     readout_reset() {
+    _readoutStep = 0;
+  }
+
+  PluginTwoPhaseRead readPhase;
 
   uint8_t      i2cAddress;
   unsigned int ms5611_prom[8]     = { 0 };
   ESPEASY_RULES_FLOAT_TYPE       ms5611_pressure    = 0;
   ESPEASY_RULES_FLOAT_TYPE       ms5611_temperature = 0;
+
+private:
+
+  // **************************************************************************/
+  // Compute pressure and temperature from the ADC values
+  // **************************************************************************/
+  void compute(unsigned long D1,
+               unsigned long D2);
+
+  unsigned long _D2          = 0;
+  uint8_t       _readoutStep = 0;
 };
 #endif // ifdef USES_P032
 #endif // ifndef PLUGINSTRUCTS_P032_DATA_STRUCT_H
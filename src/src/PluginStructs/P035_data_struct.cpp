@@ -12,6 +12,10 @@ P035_data_struct::P035_data_struct(int8_t gpioPin, bool inverted)
 // Destructor
 // **************************************************************************/
 P035_data_struct::~P035_data_struct() {
+  # if FEATURE_IR_RMT
+  IR_RMT_tx_end(_gpioPin);
+  # endif // if FEATURE_IR_RMT
+
   if (Plugin_035_irSender != nullptr) {
     delete Plugin_035_irSender;
     Plugin_035_irSender = nullptr;
@@ -40,6 +44,11 @@ bool P035_data_struct::plugin_init(struct EventStruct *event) {
 
     if (Plugin_035_irSender != nullptr) {
       Plugin_035_irSender->begin(); // Start the sender
+      # if FEATURE_IR_RMT
+
+      // All IRsend instances on this pin, also the ones used by IRac, now transmit via RMT
+      IR_RMT_tx_begin(_gpioPin, _inverted);
+      # endif // if FEATURE_IR_RMT
       success = true;
     }
   }
@@ -85,6 +94,9 @@ bool P035_data_struct::plugin_write(struct EventStruct *event, const String& str
   }
   # endif // P016_P035_Extended_AC
 
+  # if FEATURE_IR_RMT
+  IR_RMT_tx_flush();
+  # endif // if FEATURE_IR_RMT
   enableIR_RX(true);
 
   return success;
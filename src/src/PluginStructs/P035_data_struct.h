@@ -12,6 +12,8 @@
 # include <IRutils.h>
 # include <IRsend.h>
 
+# include "../Helpers/IR_RMT.h"
+
 extern void enableIR_RX(boolean enable); // To be found in _P016_IR.ino
 
 # define STATE_SIZE_MAX 53U
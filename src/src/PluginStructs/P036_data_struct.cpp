@@ -96,6 +96,9 @@ P036_data_struct::~P036_data_struct() {
     delete LineContent;
     LineContent = nullptr;
   }
+  # if P036_ENABLE_PAGE_IMAGES
+  FreeScrollImages();
+  # endif // if P036_ENABLE_PAGE_IMAGES
 }
 
 void P036_data_struct::reset() {
@@ -110,6 +113,9 @@ void P036_data_struct::reset() {
     delete LineContent;
     LineContent = nullptr;
   }
+  # if P036_ENABLE_PAGE_IMAGES
+  FreeScrollImages();
+  # endif // if P036_ENABLE_PAGE_IMAGES
 }
 
 # ifdef P036_FONT_CALC_LOG
@@ -1280,6 +1286,24 @@ uint8_t P036_data_struct::display_scroll_timer(bool             initialScroll,
   }
 
   // page scrolling (using PLUGIN_TASKTIMER_IN)
+  # if P036_ENABLE_PAGE_IMAGES
+
+  if (initialScroll) {
+    FreeScrollImages(); // Content may have changed since the previous page
+  } else if ((ScrollImages != nullptr) && (ScrollingPages.dPixSum <= P36_MaxDisplayWidth)) {
+    // Only copy the pre-rendered pages to the new position
+    DrawScrollImages();
+    update_display();
+
+    if (ScrollingPages.dPixSum < P36_MaxDisplayWidth) {
+      ScrollingPages.dPixSum += ScrollingPages.dPix;
+    } else {
+      ScrollingPages.Scrolling = 0;
+      FreeScrollImages();
+    }
+    return ScrollingPages.Scrolling;
+  }
+  # endif // if P036_ENABLE_PAGE_IMAGES
   display->setColor(BLACK);
 
   // We allow 12 pixels (including underline) at the top because otherwise the wifi indicator gets too squashed!!
@@ -1321,6 +1345,12 @@ uint8_t P036_data_struct::display_scroll_timer(bool             initialScroll,
       // non-scrolling or scrolling prepare scrolling page in from left
       DrawScrollingPageLine(&ScrollingPages.In[j], ScrollingLines.SLine[j].Width, TEXT_ALIGN_LEFT);
     }
+    # if P036_ENABLE_PAGE_IMAGES
+
+    if (initialScroll && (lscrollspeed < ePageScrollSpeed::ePSS_Instant)) {
+      CreateScrollImages();
+    }
+    # endif // if P036_ENABLE_PAGE_IMAGES
   }
 
   update_display();
@@ -1332,10 +1362,111 @@ uint8_t P036_data_struct::display_scroll_timer(bool             initialScroll,
   } else {
     // page scrolling finished
     ScrollingPages.Scrolling = 0; // allow following line scrolling
+    # if P036_ENABLE_PAGE_IMAGES
+    FreeScrollImages();
+    # endif // if P036_ENABLE_PAGE_IMAGES
   }
   return ScrollingPages.Scrolling;
 }
 
+# if P036_ENABLE_PAGE_IMAGES
+bool P036_data_struct::CreateScrollImages() {
+  FreeScrollImages();
+
+  if ((display->buffer == nullptr) || (display->width() != P36_MaxDisplayWidth)) {
+    return false;
+  }
+
+  // Same area as cleared by display_scroll_timer() while scrolling
+  const int16_t top    = GetHeaderHeight() + 1 + TopLineOffset;
+  const int16_t bottom = std::min(static_cast<int16_t>(GetIndicatorTop() + 1 + TopLineOffset),
+                                  static_cast<int16_t>(display->height()));
+
+  if (bottom <= top) {
+    return false;
+  }
+  const uint8_t  pages     = ((bottom - 1) >> 3) - (top >> 3) + 1;
+  const uint16_t imageSize = pages * P36_MaxDisplayWidth;
+
+  ScrollImages = new (std::nothrow) uint8_t[2 * imageSize];
+
+  if (ScrollImages == nullptr) {
+    return false;
+  }
+  ScrollImageTop   = top;
+  ScrollImageRows  = bottom - top;
+  ScrollImagePages = pages;
+
+  // Everything drawn moves with dPixSum, so the display at dPixSum = 0 and at dPixSum = P36_MaxDisplayWidth
+  // holds all content that becomes visible while scrolling
+  const int dPixSum = ScrollingPages.dPixSum;
+
+  for (uint8_t i = 0; i < 2; ++i) {
+    ScrollingPages.dPixSum = i * P36_MaxDisplayWidth;
+    display->setColor(BLACK);
+    display->fillRect(0, top, P36_MaxDisplayWidth, ScrollImageRows);
+    display->setColor(WHITE);
+
+    for (uint8_t j = 0; j < ScrollingPages.linesPerFrameOut; j++) {
+      DrawScrollingPageLine(&ScrollingPages.Out[j], ScrollingLines.SLine[j].LastWidth, TEXT_ALIGN_RIGHT);
+    }
+
+    for (uint8_t j = 0; j < ScrollingPages.linesPerFrameIn; j++) {
+      DrawScrollingPageLine(&ScrollingPages.In[j], ScrollingLines.SLine[j].Width, TEXT_ALIGN_LEFT);
+    }
+    memcpy(&ScrollImages[i * imageSize], &display->buffer[(top >> 3) * P36_MaxDisplayWidth], imageSize);
+  }
+  ScrollingPages.dPixSum = dPixSum;
+
+  // Restore the display at the current position
+  DrawScrollImages();
+  return true;
+}
+
+void P036_data_struct::DrawScrollImages() {
+  const int16_t  firstPage = ScrollImageTop >> 3;
+  const int16_t  lastRow   = ScrollImageTop + ScrollImageRows - 1;
+  const uint16_t imageSize = ScrollImagePages * P36_MaxDisplayWidth;
+
+  for (uint8_t p = 0; p < ScrollImagePages; ++p) {
+    const int16_t page = firstPage + p;
+    uint8_t mask       = 0xFF;
+
+    // Leave the header line and the footer in partially used display memory pages alone
+    if (p == 0) {
+      mask &= static_cast<uint8_t>(0xFF << (ScrollImageTop & 7));
+    }
+
+    if (page == (lastRow >> 3)) {
+      mask &= static_cast<uint8_t>(0xFF >> (7 - (lastRow & 7)));
+    }
+    uint8_t       *dest    = &display->buffer[page * P36_MaxDisplayWidth];
+    const uint8_t *pageOut = &ScrollImages[p * P36_MaxDisplayWidth];
+    const uint8_t *pageIn  = &ScrollImages[imageSize + p * P36_MaxDisplayWidth];
+
+    for (int16_t x = 0; x < P36_MaxDisplayWidth; ++x) {
+      const int16_t src = x - ScrollingPages.dPixSum;
+      uint8_t data      = 0;
+
+      if (src >= 0) {
+        data = pageOut[src];
+      } else if ((src + P36_MaxDisplayWidth) >= 0) {
+        data = pageIn[src + P36_MaxDisplayWidth];
+      }
+      dest[x] = (dest[x] & ~mask) | (data & mask);
+    }
+  }
+}
+
+void P036_data_struct::FreeScrollImages() {
+  if (ScrollImages != nullptr) {
+    delete[] ScrollImages;
+    ScrollImages = nullptr;
+  }
+}
+
+# endif // if P036_ENABLE_PAGE_IMAGES
+
 // Draw scrolling line (1pix/s)
 void P036_data_struct::display_scrolling_lines() {
   if (!isInitialized()) {
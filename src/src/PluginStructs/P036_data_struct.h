@@ -48,6 +48,9 @@
 #  ifndef P036_ENABLE_TICKER
 #   define P036_ENABLE_TICKER   1   // Enable ticker function
 #  endif // ifndef
+#  ifndef P036_ENABLE_PAGE_IMAGES
+#   define P036_ENABLE_PAGE_IMAGES 1 // Pre-render the pages for page scrolling
+#  endif // ifndef P036_ENABLE_PAGE_IMAGES
 # else // ifndef P036_LIMIT_BUILD_SIZE
 #  if defined(P036_SEND_EVENTS) && P036_SEND_EVENTS
 #   undef P036_SEND_EVENTS
@@ -71,6 +74,12 @@
 #  ifndef P036_ENABLE_TICKER
 #   define P036_ENABLE_TICKER   0 // Disable ticker function
 #  endif // ifndef
+#  if defined(P036_ENABLE_PAGE_IMAGES) && P036_ENABLE_PAGE_IMAGES
+#   undef P036_ENABLE_PAGE_IMAGES
+#  endif // if defined(P036_ENABLE_PAGE_IMAGES) && P036_ENABLE_PAGE_IMAGES
+#  ifndef P036_ENABLE_PAGE_IMAGES
+#   define P036_ENABLE_PAGE_IMAGES 0 // Disable pre-rendering the pages for page scrolling
+#  endif // ifndef P036_ENABLE_PAGE_IMAGES
 # endif // ifndef P036_LIMIT_BUILD_SIZE
 # ifndef P036_USERDEF_HEADERS
 #  define P036_USERDEF_HEADERS   1  // Enable User defined headers if not handled yet
@@ -527,6 +536,19 @@ private:
   void     CreateScrollingPageLine(tScrollingPageLines *ScrollingPageLine,
                                    uint8_t              Counter);
 
+  # if P036_ENABLE_PAGE_IMAGES
+
+  // Render the outgoing and incoming page once, so page scrolling only has to copy display memory
+  bool CreateScrollImages();
+  void DrawScrollImages();
+  void FreeScrollImages();
+
+  uint8_t *ScrollImages     = nullptr; // Scrolling area at dPixSum = 0, followed by the area at dPixSum = P36_MaxDisplayWidth
+  int16_t  ScrollImageTop   = 0;       // First display row of the scrolling area
+  int16_t  ScrollImageRows  = 0;       // Nr of display rows of the scrolling area
+  uint8_t  ScrollImagePages = 0;       // Nr of 8-row display memory pages covering the scrolling area
+  # endif // if P036_ENABLE_PAGE_IMAGES
+
   # if P036_FEATURE_DISPLAY_PREVIEW
   String currentLines[P36_MAX_LinesPerPage]{};
   # endif // if P036_FEATURE_DISPLAY_PREVIEW
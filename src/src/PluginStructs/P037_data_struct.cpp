@@ -15,16 +15,7 @@
 P037_data_struct::P037_data_struct(taskIndex_t taskIndex) : _taskIndex(taskIndex)
 {}
 
-P037_data_struct::~P037_data_struct() {
-  # if P037_JSON_SUPPORT
-
-  if (nullptr != root) {
-    root->clear();
-    delete root;
-    root = nullptr;
-  }
-  # endif // if P037_JSON_SUPPORT
-}
+P037_data_struct::~P037_data_struct() {}
 
 /**
  * Load the settings from file
@@ -52,6 +43,9 @@ bool P037_data_struct::loadSettings() {
 
     LoadCustomTaskSettings(_taskIndex, valueArray,
                            P037_ARRAY_SIZE, 0, offset + 1);
+    # if P037_JSON_SUPPORT
+    parseJSONAttributes();
+    # endif // if P037_JSON_SUPPORT
     return true;
   }
   return false;
@@ -936,51 +930,302 @@ bool P037_data_struct::checkFilters(const String& key, const String& value, int8
 # ifdef P037_JSON_SUPPORT
 
 /**
- * Allocate a DynamicJsonDocument and parse the message.
- * Returns true if the operation succeeded, and doc and iter can be used, when n ot successful the state of those variables is undefined.
+ * Minimal json scanner, working directly on the message buffer
  */
-bool P037_data_struct::parseJSONMessage(const String& message) {
-  bool result = false;
+static void P037_jsonSkipWhitespace(const char *& pos, const char *end) {
+  while ((pos < end) && isspace(*pos)) {
+    ++pos;
+  }
+}
 
-  if ((nullptr != root) &&
-      (message.length() * 1.5 > lastJsonMessageLength)) {
-    cleanupJSON();
+/**
+ * Scan a json string, pos must point to the opening quote.
+ * When out is not nullptr, the unescaped string is appended to it.
+ */
+static bool P037_jsonScanString(const char *& pos, const char *end, String *out) {
+  if ((pos >= end) || (*pos != '"')) {
+    return false;
   }
+  ++pos;
 
-  if (message.length() * 1.5 > lastJsonMessageLength) {
-    lastJsonMessageLength = message.length() * 1.5;
-    #  ifdef PLUGIN_037_DEBUG
+  while (pos < end) {
+    char c = *pos++;
 
-    if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-      addLogMove(LOG_LEVEL_INFO, concat(F("IMPT : JSON buffer increased to "), (int)lastJsonMessageLength));
+    if (c == '"') {
+      return true;
     }
-    #  endif // ifdef PLUGIN_037_DEBUG
+
+    if (c == '\\') {
+      if (pos >= end) {
+        return false;
+      }
+      c = *pos++;
+
+      switch (c) {
+        case 'b': c = '\b'; break;
+        case 'f': c = '\f'; break;
+        case 'n': c = '\n'; break;
+        case 'r': c = '\r'; break;
+        case 't': c = '\t'; break;
+        case 'u':
+        {
+          if ((end - pos) < 4) {
+            return false;
+          }
+          uint16_t code = 0;
+
+          for (uint8_t i = 0; i < 4; ++i) {
+            const char h = *pos++;
+
+            if (!isxdigit(h)) {
+              return false;
+            }
+            code = (code << 4) | (isdigit(h) ? h - '0' : (tolower(h) - 'a' + 10));
+          }
+
+          if (out != nullptr) {
+            // Encode as UTF-8
+            if (code < 0x80) {
+              *out += static_cast<char>(code);
+            } else if (code < 0x800) {
+              *out += static_cast<char>(0xC0 | (code >> 6));
+              *out += static_cast<char>(0x80 | (code & 0x3F));
+            } else {
+              *out += static_cast<char>(0xE0 | (code >> 12));
+              *out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+              *out += static_cast<char>(0x80 | (code & 0x3F));
+            }
+          }
+          continue;
+        }
+        default: // '"', '\\' and '/'
+          break;
+      }
+    }
+
+    if (out != nullptr) {
+      *out += c;
+    }
+  }
+  return false;
+}
+
+/**
+ * Skip a json value of any type, pos must point to its first character.
+ */
+static bool P037_jsonSkipValue(const char *& pos, const char *end) {
+  if (pos >= end) {
+    return false;
   }
 
-  if (nullptr == root) {
-    root = new (std::nothrow) DynamicJsonDocument(lastJsonMessageLength); // Dynamic allocation
+  if (*pos == '"') {
+    return P037_jsonScanString(pos, end, nullptr);
   }
 
-  if (nullptr != root) {
-    deserializeJson(*root, message);
+  if ((*pos == '{') || (*pos == '[')) {
+    uint8_t depth = 0;
 
-    if (!root->isNull()) {
-      result = true;
-      doc    = root->as<JsonObject>();
-      iter   = doc.begin();
+    while (pos < end) {
+      if (*pos == '"') {
+        if (!P037_jsonScanString(pos, end, nullptr)) {
+          return false;
+        }
+        continue;
+      }
+
+      if ((*pos == '{') || (*pos == '[')) {
+        ++depth;
+      } else if ((*pos == '}') || (*pos == ']')) {
+        ++pos;
+
+        if (--depth == 0) {
+          return true;
+        }
+        continue;
+      }
+      ++pos;
     }
+    return false;
   }
-  return result;
+
+  // Number, true, false or null
+  const char *start = pos;
+
+  while ((pos < end) && (*pos != ',') && (*pos != '}') && (*pos != ']') && !isspace(*pos)) {
+    ++pos;
+  }
+  return pos > start;
+}
+
+/**
+ * Get a json value like ArduinoJson as<String>() does: strings unescaped, all other values as their json text.
+ */
+static bool P037_jsonScanValue(const char *pos, const char *end, String& out) {
+  out.clear();
+
+  if ((pos < end) && (*pos == '"')) {
+    return P037_jsonScanString(pos, end, &out);
+  }
+  const char *start = pos;
+
+  if (!P037_jsonSkipValue(pos, end)) {
+    return false;
+  }
+  out.reserve(pos - start);
+
+  while (start < pos) {
+    out += *start++;
+  }
+  return true;
+}
+
+/**
+ * Read the next member of a json object, pos must point after the opening brace or the previous member.
+ * Returns false at the end of the object, or when the json is invalid.
+ */
+static bool P037_jsonNextMember(const char *& pos, const char *end, String& key, const char *& value) {
+  P037_jsonSkipWhitespace(pos, end);
+
+  if ((pos >= end) || (*pos == '}')) {
+    return false;
+  }
+  key.clear();
+
+  if (!P037_jsonScanString(pos, end, &key)) {
+    return false;
+  }
+  P037_jsonSkipWhitespace(pos, end);
+
+  if ((pos >= end) || (*pos != ':')) {
+    return false;
+  }
+  ++pos;
+  P037_jsonSkipWhitespace(pos, end);
+  value = pos;
+
+  if (!P037_jsonSkipValue(pos, end)) {
+    return false;
+  }
+  P037_jsonSkipWhitespace(pos, end);
+
+  if ((pos < end) && (*pos == ',')) {
+    ++pos;
+  }
+  return true;
+}
+
+/**
+ * Split the configured json attributes (<key>[.<subkey>][;<index>]) once, so they don't have to be parsed for every message.
+ */
+void P037_data_struct::parseJSONAttributes() {
+  for (uint8_t x = 0; x < VARS_PER_TASK; ++x) {
+    String attribute = parseStringKeepCase(jsonAttributes[x], 1, ';');
+
+    attribute.trim();
+    _jsonAttributeKey[x]    = parseStringKeepCase(attribute, 1, '.');
+    _jsonAttributeSubKey[x] = parseStringKeepCase(attribute, 2, '.');
+  }
+}
+
+/**
+ * Scan the message as a json object, and extract the values of the configured attributes in a single pass.
+ * Returns true if the message is a valid json object, then the jsonKey() and jsonValue() of the first attribute can be used.
+ */
+bool P037_data_struct::parseJSONMessage(const String& message) {
+  cleanupJSON();
+
+  const char *pos = message.c_str();
+  const char *end = pos + message.length();
+
+  P037_jsonSkipWhitespace(pos, end);
+
+  if ((pos >= end) || (*pos != '{')) {
+    return false;
+  }
+  ++pos;
+  _jsonBegin = pos;
+  _jsonEnd   = end;
+
+  uint8_t     found = 0;
+  String      key;
+  const char *value = nullptr;
+
+  while (P037_jsonNextMember(pos, end, key, value)) {
+    for (uint8_t x = 0; x < VARS_PER_TASK; ++x) {
+      if (bitRead(found, x) || _jsonAttributeKey[x].isEmpty() || !key.equals(_jsonAttributeKey[x])) {
+        continue;
+      }
+
+      if (_jsonAttributeSubKey[x].isEmpty()) {
+        bitSet(found, x);
+        P037_jsonScanValue(value, end, _jsonAttributeValue[x]);
+      } else if (*value == '{') {
+        const char *subPos   = value + 1;
+        const char *subValue = nullptr;
+        String      subKey;
+
+        while (P037_jsonNextMember(subPos, end, subKey, subValue)) {
+          if (subKey.equals(_jsonAttributeSubKey[x])) {
+            bitSet(found, x);
+            P037_jsonScanValue(subValue, end, _jsonAttributeValue[x]);
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  if ((pos >= end) || (*pos != '}')) {
+    // Invalid json
+    cleanupJSON();
+    return false;
+  }
+
+  for (uint8_t x = 0; x < VARS_PER_TASK; ++x) {
+    if (!bitRead(found, x)) {
+      _jsonAttributeValue[x] = F("null");
+    }
+  }
+  firstJsonAttribute();
+  return true;
+}
+
+void P037_data_struct::firstJsonAttribute() {
+  _jsonPos = _jsonBegin;
+  nextJsonAttribute();
+}
+
+void P037_data_struct::nextJsonAttribute() {
+  const char *value = nullptr;
+
+  _jsonAtEnd = (nullptr == _jsonPos) ||
+               !P037_jsonNextMember(_jsonPos, _jsonEnd, _jsonKey, value) ||
+               !P037_jsonScanValue(value, _jsonEnd, _jsonValue);
+
+  if (_jsonAtEnd) {
+    _jsonPos = nullptr;
+    _jsonKey.clear();
+    _jsonValue.clear();
+  }
+}
+
+const String& P037_data_struct::jsonAttributeValue(uint8_t taskValueIndex) const {
+  return _jsonAttributeValue[taskValueIndex];
 }
 
 /**
- * Release the created DynamicJsonDocument (if it was allocated)
+ * Release the references to the scanned message
  */
 void P037_data_struct::cleanupJSON() {
-  if (nullptr != root) {
-    root->clear();
-    delete root;
-    root = nullptr;
+  _jsonPos   = nullptr;
+  _jsonBegin = nullptr;
+  _jsonEnd   = nullptr;
+  _jsonAtEnd = true;
+  _jsonKey.clear();
+  _jsonValue.clear();
+
+  for (uint8_t x = 0; x < VARS_PER_TASK; ++x) {
+    _jsonAttributeValue[x].clear();
   }
 }
 
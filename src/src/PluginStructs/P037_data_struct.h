@@ -11,8 +11,6 @@
 # include "../Helpers/StringParser.h"
 # include "../Globals/MQTT.h"
 
-# include <ArduinoJson.h>
-
 // # define PLUGIN_037_DEBUG     // Additional debugging information
 
 # if defined(PLUGIN_BUILD_CUSTOM) || defined(PLUGIN_BUILD_MAX_ESP32) \
@@ -159,10 +157,31 @@ struct P037_data_struct : public PluginTaskData_base
 
 
   # if P037_JSON_SUPPORT
-  bool parseJSONMessage(const String& message);
-  void cleanupJSON();
-  JsonObject           doc;
-  JsonObject::iterator iter;
+
+  // Scan the message as a json object, without building a json document in memory.
+  // The values of the configured json attributes are extracted in the same pass,
+  // and the attribute iterator is positioned on the first attribute.
+  // The message must stay unchanged until cleanupJSON() is called.
+  bool          parseJSONMessage(const String& message);
+  void          cleanupJSON();
+
+  // Iterate over the attributes of the (top level) json object
+  void          firstJsonAttribute();
+  void          nextJsonAttribute();
+  bool          jsonAtEnd() const {
+    return _jsonAtEnd;
+  }
+
+  const String& jsonKey() const {
+    return _jsonKey;
+  }
+
+  const String& jsonValue() const {
+    return _jsonValue;
+  }
+
+  // Value of the json attribute configured for the task value, "null" when not present in the message
+  const String& jsonAttributeValue(uint8_t taskValueIndex) const;
   # endif // if P037_JSON_SUPPORT
 
   // The settings structures
@@ -195,8 +214,18 @@ private:
   String _filterListItem;
   # endif // if P037_FILTER_SUPPORT
   # if P037_JSON_SUPPORT
-  DynamicJsonDocument *root                  = nullptr;
-  uint16_t             lastJsonMessageLength = 512;
+  void parseJSONAttributes();
+
+  // Configured json attributes, split in <key>.<subkey> on load
+  String      _jsonAttributeKey[VARS_PER_TASK];
+  String      _jsonAttributeSubKey[VARS_PER_TASK];
+  String      _jsonAttributeValue[VARS_PER_TASK];
+  const char *_jsonPos   = nullptr;
+  const char *_jsonBegin = nullptr;
+  const char *_jsonEnd   = nullptr;
+  String      _jsonKey;
+  String      _jsonValue;
+  bool        _jsonAtEnd = true;
   # endif // if P037_JSON_SUPPORT
 };
 
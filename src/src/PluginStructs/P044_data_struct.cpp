@@ -129,16 +129,67 @@ void P044_Task::checkBlinkLED() {
 }
 
 void P044_Task::clearBuffer() {
-  if (serial_buffer.length() > maxMessageSize) {
-    maxMessageSize = _min(serial_buffer.length(), P044_DATAGRAM_MAX_SIZE);
+  lineLength     = 0;
+  lineOverflow   = false;
+  telegramLength = 0;
+  crc            = 0;
+  checkI         = 0;
+  checksum[0]    = 0;
+  obisUpdated    = 0;
+}
+
+void P044_Task::addChar(char ch) {
+  ++telegramLength;
+  lineBuffer[lineLength++] = ch;
+
+  if (ch == '\n') {
+    flushLine(true);
+  } else if (lineLength >= P044_LINE_BUFFER_SIZE) {
+    lineOverflow = true;
+    flushLine(false);
+  }
+}
+
+void P044_Task::flushLine(bool complete) {
+  if (lineLength == 0) { return; }
+
+  if (clientConnected) {
+    P1GatewayClient.write(reinterpret_cast<const uint8_t *>(lineBuffer), lineLength);
+  }
+
+  if (complete) {
+    if (!lineOverflow) {
+      lineBuffer[lineLength] = 0;
+      parseObisLine();
+    }
+    lineOverflow = false;
   }
+  lineLength = 0;
+}
+
+void P044_Task::parseObisLine() {
+  for (uint8_t i = 0; i < nrObisValues; ++i) {
+    const size_t len = obisCodes[i].length();
 
-  serial_buffer = String();
-  serial_buffer.reserve(maxMessageSize);
+    if ((len > 0) && (strncmp(lineBuffer, obisCodes[i].c_str(), len) == 0) && (lineBuffer[len] == '(')) {
+      // Value is in the last pair of brackets, e.g. 0-1:24.2.1(230101120000W)(01234.567*m3)
+      const char *value = strrchr(lineBuffer, '(');
+      obisValues[i] = strtod(value + 1, nullptr);
+      bitSet(obisUpdated, i);
+    }
+  }
 }
 
-void P044_Task::addChar(char ch) {
-  serial_buffer += ch;
+void P044_Task::loadObisCodes(taskIndex_t taskIndex) {
+  LoadCustomTaskSettings(taskIndex, obisCodes, P044_NR_OBIS_VALUES, P044_OBIS_CODE_LENGTH);
+  nrObisValues = 0;
+
+  while (nrObisValues < P044_NR_OBIS_VALUES) {
+    obisCodes[nrObisValues].trim();
+
+    if (obisCodes[nrObisValues].isEmpty()) { break; }
+    ++nrObisValues;
+  }
 }
 
 /*  checkDatagram
@@ -146,28 +197,10 @@ void P044_Task::addChar(char ch) {
     attached to the telegram
  */
 bool P044_Task::checkDatagram() const {
-  int endChar = serial_buffer.length() - 1;
-
-  if (CRCcheck) {
-    endChar -= P044_CHECKSUM_LENGTH;
-  }
-
-  if ((endChar < 0) || (serial_buffer[0] != P044_DATAGRAM_START_CHAR) ||
-      (serial_buffer[endChar] != P044_DATAGRAM_END_CHAR)) { return false; }
-
   if (!CRCcheck) { return true; }
 
-  const int checksumStartIndex = endChar + 1;
-
-  #ifdef PLUGIN_044_DEBUG
-    for (unsigned int cnt = 0; cnt < serial_buffer.length(); ++cnt) {
-      serialPrint(serial_buffer.substring(cnt, 1));
-    }
-  #endif
-
-  // calculate the CRC and check if it equals the hexadecimal one attached to the datagram
-  unsigned int crc = CRC16(serial_buffer, checksumStartIndex);
-  return strtoul(serial_buffer.substring(checksumStartIndex).c_str(), nullptr, 16) == crc;
+  // the CRC is calculated while receiving, check if it equals the hexadecimal one attached to the datagram
+  return strtoul(checksum, nullptr, 16) == crc;
 }
 
 /*
@@ -175,22 +208,17 @@ bool P044_Task::checkDatagram() const {
       based on code written by Jan ten Hove
      https://github.com/jantenhove/P1-Meter-ESP8266
  */
-unsigned int P044_Task::CRC16(const String& buf, int len)
+uint16_t P044_Task::CRC16(uint16_t crc, uint8_t ch)
 {
-  unsigned int crc = 0;
-
-  for (int pos = 0; pos < len; pos++)
-  {
-    crc ^= static_cast<const unsigned int>(buf[pos]); // XOR byte into least sig. byte of crc
+  crc ^= ch;                     // XOR byte into least sig. byte of crc
 
-    for (int i = 8; i != 0; i--) {                    // Loop over each bit
-      if ((crc & 0x0001) != 0) {                      // If the LSB is set
-        crc >>= 1;                                    // Shift right and XOR 0xA001
-        crc  ^= 0xA001;
-      }
-      else {                                          // Else LSB is not set
-        crc >>= 1;                                    // Just shift right
-      }
+  for (int i = 8; i != 0; i--) { // Loop over each bit
+    if ((crc & 0x0001) != 0) {   // If the LSB is set
+      crc >>= 1;                 // Shift right and XOR 0xA001
+      crc  ^= 0xA001;
+    }
+    else {                       // Else LSB is not set
+      crc >>= 1;                 // Just shift right
     }
   }
 
@@ -271,8 +299,19 @@ void P044_Task::handleSerialIn(struct EventStruct *event) {
   } while (true);
 
   if (done) {
-    P1GatewayClient.print(serial_buffer);
-    P1GatewayClient.flush();
+    // Telegram is already sent to the client while receiving
+    if (clientConnected) {
+      P1GatewayClient.flush();
+    }
+
+    if (obisUpdated != 0) {
+      for (uint8_t i = 0; i < nrObisValues; ++i) {
+        if (bitRead(obisUpdated, i)) {
+          UserVar[event->BaseVarIndex + i] = obisValues[i];
+        }
+      }
+      sendData(event);
+    }
 # ifndef BUILD_NO_DEBUG
     addLog(LOG_LEVEL_DEBUG, F("P1   : data send!"));
 #endif
@@ -283,11 +322,13 @@ void P044_Task::handleSerialIn(struct EventStruct *event) {
 }
 
 bool P044_Task::handleChar(char ch) {
-  if (serial_buffer.length() >= P044_DATAGRAM_MAX_SIZE - 2) { // room for cr/lf
+  if (telegramLength >= P044_DATAGRAM_MAX_SIZE - 2) { // room for cr/lf
 # ifndef BUILD_NO_DEBUG
     addLog(LOG_LEVEL_DEBUG, F("P1   : Error: Buffer overflow, discarded input."));
 #endif
-    state = ParserState::WAITING;                             // reset
+    state          = ParserState::WAITING;              // reset
+    telegramLength = 0;
+    lineLength     = 0;
   }
 
   bool done    = false;
@@ -298,6 +339,7 @@ bool P044_Task::handleChar(char ch) {
 
       if (ch == P044_DATAGRAM_START_CHAR)  {
         clearBuffer();
+        crc = CRC16(crc, ch);
         addChar(ch);
         state = ParserState::READING;
       } // else ignore data
@@ -305,8 +347,10 @@ bool P044_Task::handleChar(char ch) {
     case ParserState::READING:
 
       if (validP1char(ch)) {
+        crc = CRC16(crc, ch);
         addChar(ch);
       } else if (ch == P044_DATAGRAM_END_CHAR) {
+        crc = CRC16(crc, ch);
         addChar(ch);
 
         if (CRCcheck) {
@@ -328,11 +372,13 @@ bool P044_Task::handleChar(char ch) {
     case ParserState::CHECKSUM:
 
       if (validP1char(ch)) {
+        checksum[checkI] = ch;
         addChar(ch);
         ++checkI;
 
         if (checkI == P044_CHECKSUM_LENGTH) {
-          done = true;
+          checksum[checkI] = 0;
+          done             = true;
         }
       } else {
         invalid = true;
@@ -351,7 +397,8 @@ bool P044_Task::handleChar(char ch) {
       serialPrint(String(ch));
       serialPrintln("<");
     #endif
-    state = ParserState::WAITING; // reset
+    state      = ParserState::WAITING; // reset
+    lineLength = 0;                    // don't send the incomplete line
   }
 
   if (done) {
@@ -363,6 +410,8 @@ bool P044_Task::handleChar(char ch) {
       addChar('\r');
       addChar('\n');
     } else if (CRCcheck) {
+      // The end line is not sent, so the client will also drop this telegram
+      lineLength = 0;
 # ifndef BUILD_NO_DEBUG
       addLog(LOG_LEVEL_DEBUG, F("P1   : Error: Invalid CRC, dropped data"));
 #endif
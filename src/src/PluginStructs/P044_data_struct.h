@@ -14,6 +14,9 @@
 #define P044_DATAGRAM_START_CHAR           '/'
 #define P044_DATAGRAM_END_CHAR             '!'
 #define P044_DATAGRAM_MAX_SIZE             2048u
+#define P044_LINE_BUFFER_SIZE              128 // Lines are sent to the client in chunks of this size, longer lines are not parsed
+#define P044_OBIS_CODE_LENGTH              16
+#define P044_NR_OBIS_VALUES                VARS_PER_TASK
 
 
 struct P044_Task : public PluginTaskData_base {
@@ -46,8 +49,14 @@ struct P044_Task : public PluginTaskData_base {
 
   void                clearBuffer();
 
+  // Add a character to the line buffer, complete lines are sent to the client and parsed for OBIS values.
   void                addChar(char ch);
 
+  // Send the line buffer to the client, parse it for OBIS values if it is a complete line
+  void                flushLine(bool complete);
+
+  void                parseObisLine();
+
   /*  checkDatagram
       checks whether the P044_CHECKSUM of the data received from P1 matches the P044_CHECKSUM
       attached to the telegram
@@ -58,9 +67,12 @@ struct P044_Task : public PluginTaskData_base {
      CRC16
         based on code written by Jan ten Hove
        https://github.com/jantenhove/P1-Meter-ESP8266
+     Updated per character, as the telegram is received
    */
-  static unsigned int CRC16(const String& buf,
-                            int           len);
+  static uint16_t     CRC16(uint16_t crc,
+                            uint8_t  ch);
+
+  void                loadObisCodes(taskIndex_t taskIndex);
 
   /*
      validP1char
@@ -89,13 +101,25 @@ struct P044_Task : public PluginTaskData_base {
   uint16_t       gatewayPort     = 0;
   WiFiClient     P1GatewayClient;
   bool           clientConnected = false;
-  String         serial_buffer;
   ParserState    state             = ParserState::WAITING;
   int            checkI            = 0;
   boolean        CRCcheck          = false;
   ESPeasySerial *P1EasySerial      = nullptr;
   unsigned long  blinkLEDStartTime = 0;
-  size_t         maxMessageSize    = P044_DATAGRAM_MAX_SIZE / 4;
+
+  // Telegram parsing state, the telegram itself is not stored
+  char     lineBuffer[P044_LINE_BUFFER_SIZE + 1] = { 0 };
+  char     checksum[P044_CHECKSUM_LENGTH + 1]    = { 0 };
+  uint16_t lineLength                            = 0;
+  uint16_t telegramLength                        = 0;
+  uint16_t crc                                   = 0;
+  bool     lineOverflow                          = false;
+
+  // OBIS codes to parse into task values
+  String  obisCodes[P044_NR_OBIS_VALUES];
+  float   obisValues[P044_NR_OBIS_VALUES] = { 0.0f };
+  uint8_t nrObisValues                    = 0;
+  uint8_t obisUpdated                     = 0; // Bit per value found in the current telegram
 };
 
 #endif
@@ -2,10 +2,26 @@
 
 #ifdef USES_P045
 
+# define MPU6050_RA_SMPLRT_DIV               0x19
+# define MPU6050_RA_CONFIG                   0x1A
 # define MPU6050_RA_GYRO_CONFIG              0x1B
 # define MPU6050_RA_ACCEL_CONFIG             0x1C
+# define MPU6050_RA_FIFO_EN                  0x23
+# define MPU6050_RA_INT_STATUS               0x3A
 # define MPU6050_RA_ACCEL_XOUT_H             0x3B
+# define MPU6050_RA_USER_CTRL                0x6A
 # define MPU6050_RA_PWR_MGMT_1               0x6B
+# define MPU6050_RA_FIFO_COUNTH              0x72
+# define MPU6050_RA_FIFO_R_W                 0x74
+# define MPU6050_CFG_DLPF_CFG_BIT            2
+# define MPU6050_CFG_DLPF_CFG_LENGTH         3
+# define MPU6050_DLPF_BW_188                 0x01 // Gyro output rate 1 kHz
+# define MPU6050_ACCEL_FIFO_EN               0x08
+# define MPU6050_USERCTRL_FIFO_EN            0x40
+# define MPU6050_USERCTRL_FIFO_RESET         0x04
+# define MPU6050_INTERRUPT_FIFO_OFLOW        0x10
+# define MPU6050_FIFO_SAMPLE_SIZE            6    // Accelerometer X/Y/Z only
+# define MPU6050_FIFO_BURST_SIZE             (20 * MPU6050_FIFO_SAMPLE_SIZE) // Fits in the Wire buffer
 # define MPU6050_ACONFIG_AFS_SEL_BIT         4
 # define MPU6050_ACONFIG_AFS_SEL_LENGTH      2
 # define MPU6050_GCONFIG_FS_SEL_BIT          4
@@ -19,7 +35,7 @@
 
 P045_data_struct::P045_data_struct(uint8_t i2c_addr) : i2cAddress(i2c_addr) {}
 
-void P045_data_struct::init()
+void P045_data_struct::init(uint16_t fifoRate)
 {
   // Initialize the MPU6050, for details look at the MPU6050 library: MPU6050::Initialize
   writeBits(MPU6050_RA_PWR_MGMT_1,   MPU6050_PWR1_CLKSEL_BIT,     MPU6050_PWR1_CLKSEL_LENGTH,     MPU6050_CLOCK_PLL_XGYRO);
@@ -37,6 +53,118 @@ void P045_data_struct::init()
       _axis[i][j] = 0;
     }
   }
+
+  _useFIFO = fifoRate > 0;
+
+  if (_useFIFO) {
+    // Sample rate = 1 kHz / (1 + SMPLRT_DIV)
+    writeBits(MPU6050_RA_CONFIG, MPU6050_CFG_DLPF_CFG_BIT, MPU6050_CFG_DLPF_CFG_LENGTH, MPU6050_DLPF_BW_188);
+    I2C_write8_reg(i2cAddress, MPU6050_RA_SMPLRT_DIV, (1000 / fifoRate) - 1);
+    I2C_write8_reg(i2cAddress, MPU6050_RA_FIFO_EN,    MPU6050_ACCEL_FIFO_EN);
+    resetFIFO();
+  } else {
+    I2C_write8_reg(i2cAddress, MPU6050_RA_USER_CTRL, 0);
+    I2C_write8_reg(i2cAddress, MPU6050_RA_FIFO_EN,   0);
+  }
+}
+
+void P045_data_struct::resetFIFO()
+{
+  I2C_write8_reg(i2cAddress, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_FIFO_RESET);
+  I2C_write8_reg(i2cAddress, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_FIFO_EN);
+}
+
+void P045_data_struct::readFIFO()
+{
+  if (!_useFIFO) {
+    return;
+  }
+  bool is_ok = true;
+
+  if (I2C_read8_reg(i2cAddress, MPU6050_RA_INT_STATUS, &is_ok) & MPU6050_INTERRUPT_FIFO_OFLOW) {
+    // Oldest samples are overwritten, the FIFO content is no longer aligned to whole samples
+    resetFIFO();
+    return;
+  }
+  uint16_t count = I2C_read16_reg(i2cAddress, MPU6050_RA_FIFO_COUNTH, &is_ok);
+
+  if (!is_ok) {
+    return;
+  }
+  count -= count % MPU6050_FIFO_SAMPLE_SIZE;
+
+  while (count > 0) {
+    const uint8_t burst = count > MPU6050_FIFO_BURST_SIZE ? MPU6050_FIFO_BURST_SIZE : count;
+
+    I2C_write8(i2cAddress, MPU6050_RA_FIFO_R_W);
+
+    if (Wire.requestFrom(i2cAddress, burst) != burst) {
+      resetFIFO();
+      return;
+    }
+
+    for (uint8_t i = 0; i < burst; i += MPU6050_FIFO_SAMPLE_SIZE) {
+      int16_t a[3];
+
+      for (uint8_t axis = 0; axis < 3; ++axis) {
+        const uint8_t high = Wire.read();
+        a[axis]         = (((int16_t)high) << 8) | Wire.read();
+        _fifoSum[axis] += a[axis];
+        trackMinMax(a[axis], &_axis[axis][0], &_axis[axis][1]);
+      }
+      addSample(a[0], a[1], a[2]);
+      ++_fifoCount;
+    }
+    count -= burst;
+  }
+}
+
+void P045_data_struct::addSample(int16_t ax, int16_t ay, int16_t az)
+{
+  const float length = sqrtf(static_cast<float>(ax) * ax + static_cast<float>(ay) * ay + static_cast<float>(az) * az);
+
+  if (_vibCount == 0) {
+    _vibRef   = length;
+    _vibSum   = 0.0f;
+    _vibSumSq = 0.0f;
+    _vibMin   = length;
+    _vibMax   = length;
+  }
+  const float delta = length - _vibRef;
+
+  _vibSum   += delta;
+  _vibSumSq += delta * delta;
+
+  if (length < _vibMin) {
+    _vibMin = length;
+  } else if (length > _vibMax) {
+    _vibMax = length;
+  }
+  ++_vibCount;
+}
+
+bool P045_data_struct::getVibration(float& rms, float& peak) const
+{
+  rms  = 0.0f;
+  peak = 0.0f;
+
+  if (_vibCount == 0) {
+    return false;
+  }
+  const float mean     = _vibSum / _vibCount;
+  const float variance = (_vibSumSq / _vibCount) - (mean * mean);
+
+  if (variance > 0.0f) {
+    rms = sqrtf(variance);
+  }
+  const float meanLength = _vibRef + mean;
+
+  peak = _vibMax - meanLength;
+
+  if ((meanLength - _vibMin) > peak) {
+    peak = meanLength - _vibMin;
+  }
+  return true;
 }
 
 void P045_data_struct::loop()
@@ -49,6 +177,21 @@ void P045_data_struct::loop()
                     &_axis[1][4],
                     &_axis[2][4]);
 
+  if (_useFIFO) {
+    readFIFO();
+
+    // a-values are the mean of all samples collected since the last loop()
+    if (_fifoCount > 0) {
+      for (uint8_t i = 0; i < 3; ++i) {
+        _axis[i][3]  = _fifoSum[i] / _fifoCount;
+        _fifoSum[i] = 0;
+      }
+      _fifoCount = 0;
+    }
+  } else {
+    addSample(_axis[0][3], _axis[1][3], _axis[2][3]);
+  }
+
   // Set the minimum and maximum value for each axis a-value, overwrite previous values if smaller/larger
   trackMinMax(_axis[0][3], &_axis[0][0], &_axis[0][1]);
   trackMinMax(_axis[1][3], &_axis[1][0], &_axis[1][1]);
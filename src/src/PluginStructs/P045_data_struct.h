@@ -4,6 +4,13 @@
 #include "../../_Plugin_Helper.h"
 #ifdef USES_P045
 
+# define P045_FIFO_RATE              PCONFIG_LONG(3) // Sample rate in Hz when using the FIFO, 0 = FIFO not used
+
+// Functions (PCONFIG(1))
+# define P045_FUNCTION_VIBRATION_RMS   10
+# define P045_FUNCTION_VIBRATION_PEAK  11
+# define P045_NR_FUNCTIONS             12
+
 struct P045_data_struct : public PluginTaskData_base {
 public:
 
@@ -11,12 +18,30 @@ public:
   P045_data_struct() = delete;
   virtual ~P045_data_struct() = default;
 
-  void init();
+  // fifoRate: Sample rate in Hz for the accelerometer samples collected in the FIFO, 0 = FIFO not used
+  void init(uint16_t fifoRate);
 
   void loop();
 
+  // Read all samples collected in the FIFO in bursts
+  void readFIFO();
+
+  // RMS and peak of the deviation of the acceleration vector length from its mean, since the last clear
+  bool getVibration(float& rms,
+                    float& peak) const;
+
+  void clearVibration() {
+    _vibCount = 0;
+  }
+
 private:
 
+  void addSample(int16_t ax,
+                 int16_t ay,
+                 int16_t az);
+
+  void resetFIFO();
+
   void trackMinMax(int16_t  current,
                    int16_t *min,
                    int16_t *max);
@@ -56,6 +81,19 @@ private:
 
   unsigned long _timer = 0; // Timer to check values each 5 seconds
   uint8_t       i2cAddress;
+  bool          _useFIFO = false;
+
+  // Sum of the accelerometer FIFO samples since the last loop(), for the mean a-values
+  int32_t  _fifoSum[3]{};
+  uint16_t _fifoCount = 0;
+
+  // Statistics of the acceleration vector length, sums relative to the first sample to keep rounding errors small
+  uint32_t _vibCount = 0;
+  float    _vibRef   = 0.0f;
+  float    _vibSum   = 0.0f;
+  float    _vibSumSq = 0.0f;
+  float    _vibMin   = 0.0f;
+  float    _vibMax   = 0.0f;
 };
 #endif // ifdef USES_P045
 #endif // ifndef PLUGINSTRUCTS_P045_DATA_STRUCT_H
@@ -83,6 +83,9 @@ bool P053_data_struct::init() {
   # endif // ifndef BUILD_NO_DEBUG
 
   if (_easySerial != nullptr) {
+    # if FEATURE_SERIAL_RX_EVENT
+    serialHelper_disableRxEvent(_taskIndex, *_easySerial);
+    # endif // if FEATURE_SERIAL_RX_EVENT
     delete _easySerial;
     _easySerial = nullptr;
   }
@@ -104,6 +107,12 @@ bool P053_data_struct::init() {
     // Make sure to set the mode to active reading mode.
     // This is the default, but not sure if passive mode can be set persistant.
     setActiveReadingMode();
+
+    # if FEATURE_SERIAL_RX_EVENT
+
+    // Sensor sends packets of max. 40 bytes, wake the task at the end of a packet.
+    serialHelper_enableRxEvent(_taskIndex, *_easySerial, P053_RX_EVENT_TIMEOUT_SYMBOLS);
+    # endif // if FEATURE_SERIAL_RX_EVENT
   }
   clearReceivedData();
   return initialized();
@@ -111,6 +120,9 @@ bool P053_data_struct::init() {
 
 P053_data_struct::~P053_data_struct() {
   if (_easySerial != nullptr) {
+    # if FEATURE_SERIAL_RX_EVENT
+    serialHelper_disableRxEvent(_taskIndex, *_easySerial);
+    # endif // if FEATURE_SERIAL_RX_EVENT
     delete _easySerial;
     _easySerial = nullptr;
   }
@@ -181,6 +193,9 @@ bool P053_data_struct::packetAvailable()
   if (_easySerial != nullptr)
   {
     if (_packetPos < expectedSize) {
+      // No need to check the buffer when the task was not woken by received data.
+      if (!serialHelper_rxDataReady(_taskIndex, *_easySerial)) { return false; }
+
       // When there is enough data in the buffer, search through the buffer to
       // find header (buffer may be out of sync)
       if (!_easySerial->available()) { return false; }
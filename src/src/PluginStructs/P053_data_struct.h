@@ -90,6 +90,9 @@ const __FlashStringHelper* toString(PMSx003_event_datatype selection);
 // Use the largest possible packet size as buffer size
 # define PMSx003_PACKET_BUFFER_SIZE  PMS5003_ST_SIZE
 
+// Line idle time (in symbols) to consider a packet complete when woken by received data
+# define P053_RX_EVENT_TIMEOUT_SYMBOLS  4
+
 
 // Active mode transport protocol description
 // "factory" relates to "CF=1" in the datasheet. (CF: Calibration Factory)
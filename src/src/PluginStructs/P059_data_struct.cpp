@@ -0,0 +1,231 @@
+#include "../PluginStructs/P059_data_struct.h"
+
+#ifdef USES_P059
+
+# if FEATURE_ENCODER_PCNT
+#  include "../Helpers/Hardware_PCNT.h"
+
+#  include <driver/pcnt.h>
+# endif // if FEATURE_ENCODER_PCNT
+
+P059_data_struct::~P059_data_struct()
+{
+  # if FEATURE_ENCODER_PCNT
+
+  if (_pcntUnit >= 0) {
+    const pcnt_unit_t unit = static_cast<pcnt_unit_t>(_pcntUnit);
+    pcnt_counter_pause(unit);
+    pcnt_intr_disable(unit);
+    pcnt_isr_handler_remove(unit);
+    PCNT_releaseUnit(_pcntUnit);
+  }
+  # endif // if FEATURE_ENCODER_PCNT
+
+  if (_qei != nullptr) {
+    delete _qei;
+  }
+}
+
+bool P059_data_struct::begin(int8_t  pinA,
+                             int8_t  pinB,
+                             int8_t  pinI,
+                             uint8_t mode,
+                             long    limitMin,
+                             long    limitMax,
+                             bool    usePCNT)
+{
+  # if FEATURE_ENCODER_PCNT
+
+  if (usePCNT) {
+    _pinI         = pinI;
+    _indexTrigger = pinI >= 0;
+    _limitMin     = limitMin;
+    _limitMax     = limitMax;
+
+    if (initPCNT(pinA, pinB, mode)) {
+      if (pinI >= 0) {
+        pinMode(pinI, INPUT_PULLUP);
+      }
+      return true;
+    }
+    addLog(LOG_LEVEL_ERROR, F("QEI  : No PCNT unit available, using interrupts"));
+  }
+  # endif // if FEATURE_ENCODER_PCNT
+
+  _qei = new (std::nothrow) QEIx4;
+
+  if (_qei == nullptr) {
+    return false;
+  }
+  _qei->begin(pinA, pinB, pinI, mode);
+  _qei->setLimit(limitMin, limitMax);
+  _qei->setIndexTrigger(true);
+  return true;
+}
+
+bool P059_data_struct::hasChanged()
+{
+  # if FEATURE_ENCODER_PCNT
+
+  if (_pcntUnit >= 0) {
+    samplePCNT();
+    return _changed;
+  }
+  # endif // if FEATURE_ENCODER_PCNT
+  return (_qei != nullptr) && _qei->hasChanged();
+}
+
+long P059_data_struct::read()
+{
+  # if FEATURE_ENCODER_PCNT
+
+  if (_pcntUnit >= 0) {
+    samplePCNT();
+    _changed = false;
+    return _counter;
+  }
+  # endif // if FEATURE_ENCODER_PCNT
+  return (_qei == nullptr) ? 0 : _qei->read();
+}
+
+void P059_data_struct::write(long counter)
+{
+  # if FEATURE_ENCODER_PCNT
+
+  if (_pcntUnit >= 0) {
+    // Steps counted so far belong to the old value
+    samplePCNT();
+    _counter = counter;
+    return;
+  }
+  # endif // if FEATURE_ENCODER_PCNT
+
+  if (_qei != nullptr) {
+    _qei->write(counter);
+  }
+}
+
+# if FEATURE_ENCODER_PCNT
+
+bool P059_data_struct::initPCNT(int8_t pinA, int8_t pinB, uint8_t mode)
+{
+  const int8_t unit = PCNT_claimUnit();
+
+  if (unit < 0) {
+    return false;
+  }
+
+  // Channel 0 counts the edges of A, direction by B.
+  // A leading B counts up, like QEIx4 does.
+  pcnt_config_t pcnt_config{};
+
+  pcnt_config.pulse_gpio_num = pinA;
+  pcnt_config.ctrl_gpio_num  = pinB;
+  pcnt_config.lctrl_mode     = PCNT_MODE_KEEP;
+  pcnt_config.hctrl_mode     = PCNT_MODE_REVERSE;
+  pcnt_config.pos_mode       = PCNT_COUNT_INC;
+  pcnt_config.neg_mode       = (mode == 1) ? PCNT_COUNT_DIS : PCNT_COUNT_DEC;
+  pcnt_config.counter_h_lim  = P059_PCNT_LIMIT;
+  pcnt_config.counter_l_lim  = -P059_PCNT_LIMIT;
+  pcnt_config.unit           = static_cast<pcnt_unit_t>(unit);
+  pcnt_config.channel        = PCNT_CHANNEL_0;
+
+  bool success = pcnt_unit_config(&pcnt_config) == ESP_OK;
+
+  if (success && (mode != 1) && (mode != 2)) {
+    // 4 pulses per cycle: Channel 1 counts the edges of B, direction by A
+    pcnt_config.pulse_gpio_num = pinB;
+    pcnt_config.ctrl_gpio_num  = pinA;
+    pcnt_config.lctrl_mode     = PCNT_MODE_REVERSE;
+    pcnt_config.hctrl_mode     = PCNT_MODE_KEEP;
+    pcnt_config.neg_mode       = PCNT_COUNT_DEC;
+    pcnt_config.channel        = PCNT_CHANNEL_1;
+    success                    = pcnt_unit_config(&pcnt_config) == ESP_OK;
+  }
+
+  const pcnt_unit_t pcnt_unit = pcnt_config.unit;
+
+  if (success) {
+    pcnt_set_filter_value(pcnt_unit, P059_PCNT_FILTER);
+    pcnt_filter_enable(pcnt_unit);
+    pcnt_counter_pause(pcnt_unit);
+    pcnt_counter_clear(pcnt_unit);
+
+    success = PCNT_installISRservice() &&
+              (pcnt_isr_handler_add(pcnt_unit, ISR_PCNTlimit, this) == ESP_OK);
+  }
+
+  if (!success) {
+    PCNT_releaseUnit(unit);
+    return false;
+  }
+  _pcntOverflow = 0;
+  _pcntLast     = 0;
+  _counter      = 0;
+  _changed      = false;
+  _pcntUnit     = unit;
+
+  pcnt_event_enable(pcnt_unit, PCNT_EVT_H_LIM);
+  pcnt_event_enable(pcnt_unit, PCNT_EVT_L_LIM);
+  pcnt_intr_enable(pcnt_unit);
+  pcnt_counter_resume(pcnt_unit);
+  return true;
+}
+
+void P059_data_struct::samplePCNT()
+{
+  int32_t overflow = 0;
+  int16_t counter  = 0;
+
+  do {
+    overflow = _pcntOverflow;
+    pcnt_get_counter_value(static_cast<pcnt_unit_t>(_pcntUnit), &counter);
+  } while (overflow != _pcntOverflow);
+
+  const int32_t count = overflow * P059_PCNT_LIMIT + counter;
+  const int32_t delta = count - _pcntLast;
+
+  if (delta == 0) {
+    return;
+  }
+  _pcntLast = count;
+
+  // All steps since the previous sample are applied at once, so the limits are applied to the sum.
+  const long prev = _counter;
+
+  _counter += delta;
+
+  // Like QEIx4, a counter outside the limits may move towards the limits, but not away from them.
+  if ((delta > 0) && (_counter > _limitMax)) { _counter = prev > _limitMax ? prev : _limitMax; }
+
+  if ((delta < 0) && (_counter < _limitMin)) { _counter = prev < _limitMin ? prev : _limitMin; }
+
+  if (_counter == prev) {
+    return;
+  }
+
+  // Index pin is only checked when sampling, not on every step like QEIx4 does.
+  if (_indexTrigger && digitalRead(_pinI)) {
+    _indexTrigger = false;
+    _counter      = 0;
+  }
+  _changed = true;
+}
+
+void IRAM_ATTR P059_data_struct::ISR_PCNTlimit(void *arg)
+{
+  P059_data_struct *self = static_cast<P059_data_struct *>(arg);
+  uint32_t status        = 0;
+
+  pcnt_get_event_status(static_cast<pcnt_unit_t>(self->_pcntUnit), &status);
+
+  if (status & PCNT_EVT_H_LIM) {
+    self->_pcntOverflow = self->_pcntOverflow + 1;
+  } else if (status & PCNT_EVT_L_LIM) {
+    self->_pcntOverflow = self->_pcntOverflow - 1;
+  }
+}
+
+# endif // if FEATURE_ENCODER_PCNT
+
+#endif // ifdef USES_P059
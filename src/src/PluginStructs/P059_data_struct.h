@@ -0,0 +1,81 @@
+#ifndef PLUGINSTRUCTS_P059_DATA_STRUCT_H
+#define PLUGINSTRUCTS_P059_DATA_STRUCT_H
+
+#include "../../_Plugin_Helper.h"
+#ifdef USES_P059
+
+# include <QEIx4.h>
+
+# define P059_MODE       PCONFIG(0)
+# define P059_USE_PCNT   PCONFIG(1)
+# define P059_LIMIT_MIN  PCONFIG_LONG(0)
+# define P059_LIMIT_MAX  PCONFIG_LONG(1)
+
+# if FEATURE_ENCODER_PCNT
+
+// PCNT counter is reset to 0 when reaching +/- this value
+#  define P059_PCNT_LIMIT   32767
+
+// Glitch filter in APB clock cycles (80 MHz => 12.8 usec)
+#  define P059_PCNT_FILTER  1023
+# endif // if FEATURE_ENCODER_PCNT
+
+
+struct P059_data_struct : public PluginTaskData_base {
+public:
+
+  P059_data_struct() = default;
+  virtual ~P059_data_struct();
+
+  // usePCNT: Decode the A/B signals with a PCNT unit (ESP32), falls back to interrupts when no unit is available.
+  bool begin(int8_t  pinA,
+             int8_t  pinB,
+             int8_t  pinI,
+             uint8_t mode,
+             long    limitMin,
+             long    limitMax,
+             bool    usePCNT);
+
+  bool hasChanged();
+
+  long read();
+
+  void write(long counter);
+
+  bool usesPCNT() const {
+    # if FEATURE_ENCODER_PCNT
+    return _pcntUnit >= 0;
+    # else // if FEATURE_ENCODER_PCNT
+    return false;
+    # endif // if FEATURE_ENCODER_PCNT
+  }
+
+private:
+
+  QEIx4 *_qei = nullptr;
+
+  # if FEATURE_ENCODER_PCNT
+  bool        initPCNT(int8_t  pinA,
+                       int8_t  pinB,
+                       uint8_t mode);
+
+  // Add the steps counted by the PCNT unit since the previous call to the counter
+  void        samplePCNT();
+
+  // Called when the PCNT counter reaches a limit, so only once per P059_PCNT_LIMIT steps
+  static void ISR_PCNTlimit(void *arg);
+
+  volatile int32_t _pcntOverflow = 0; // Nr of times the counter reached +limit minus -limit
+  int32_t          _pcntLast     = 0;
+  int8_t           _pcntUnit     = -1;
+  int8_t           _pinI         = -1;
+  bool             _indexTrigger = false;
+  bool             _changed      = false;
+  long             _counter      = 0;
+  long             _limitMin     = 0;
+  long             _limitMax     = 0;
+  # endif // if FEATURE_ENCODER_PCNT
+};
+
+#endif // ifdef USES_P059
+#endif // ifndef PLUGINSTRUCTS_P059_DATA_STRUCT_H
@@ -27,6 +27,32 @@ void P067_int2float(int16_t valInt0, int16_t valInt1, float *valFloat) {
   *valFloat = offset;
 }
 
+/****************************************************
+* Sliding median filter
+****************************************************/
+int32_t P067_median_t::add(int32_t value) {
+  _samples[_index] = value;
+  _index           = (_index + 1) % P067_MEDIAN_SIZE;
+
+  if (_count < P067_MEDIAN_SIZE) {
+    ++_count;
+  }
+
+  // Insertion sort of a copy, only a few samples
+  int32_t sorted[P067_MEDIAN_SIZE];
+
+  for (uint8_t i = 0; i < _count; ++i) {
+    int32_t sample = _samples[i];
+    uint8_t j      = i;
+
+    for (; j > 0 && sorted[j - 1] > sample; --j) {
+      sorted[j] = sorted[j - 1];
+    }
+    sorted[j] = sample;
+  }
+  return sorted[_count / 2];
+}
+
 /**************************************************************************
 * Constructor
 **************************************************************************/
@@ -37,6 +63,8 @@ P067_data_struct::P067_data_struct(struct EventStruct *event,
 {
   _modeChanA = P067_GET_CHANNEL_A_MODE_e;
   _modeChanB = P067_GET_CHANNEL_B_MODE_e;
+  _useInterrupt = P067_GET_USE_INTERRUPT;
+  _useMedian    = P067_GET_MEDIAN_FILTER;
   P067_int2float(P067_OFFSET_CHANNEL_A_1, P067_OFFSET_CHANNEL_A_2, &_offsetChanA);
   P067_int2float(P067_OFFSET_CHANNEL_B_1, P067_OFFSET_CHANNEL_B_2, &_offsetChanB);
 }
@@ -44,7 +72,11 @@ P067_data_struct::P067_data_struct(struct EventStruct *event,
 /*****************************************************
 * Destructor
 *****************************************************/
-P067_data_struct::~P067_data_struct() {}
+P067_data_struct::~P067_data_struct() {
+  if (_useInterrupt && isInitialized()) {
+    detachInterrupt(digitalPinToInterrupt(_pinDOUT));
+  }
+}
 
 /****************************************************
 * Initialization
@@ -65,6 +97,16 @@ bool P067_data_struct::init(struct EventStruct *event) {
 
     pinMode(_pinDOUT, INPUT); // Checked, doesn't seem applicable: https://github.com/bogde/HX711/issues/222
 
+    if (_useInterrupt &&
+        ((_modeChanA != P067_ChannelA_State_e::modeAoff) || (_modeChanB != P067_ChannelB_State_e::modeBoff))) {
+      attachInterruptArg(digitalPinToInterrupt(_pinDOUT),
+                         reinterpret_cast<void (*)(void *)>(ISR_dataReady),
+                         this,
+                         FALLING);
+    } else {
+      _useInterrupt = false;
+    }
+
     return true;
   }
   return false;
@@ -157,40 +199,74 @@ bool P067_data_struct::plugin_read(struct EventStruct *event)           {
 bool P067_data_struct::plugin_fifty_per_second(struct EventStruct *event) {
   bool success = false;
 
-  if (isInitialized() && isDataReady()) {
-    int32_t value = readHX711();
-    success = true;
+  if (!isInitialized()) {
+    return success;
+  }
 
-    switch (_channelRead) {
-      case P067_Channel_e::chanA64:  //
-      case P067_Channel_e::chanA128:
-      {
-        if (!P067_GET_CHANNEL_A_OS) { // Oversampling on channel A?
-          OversamplingChanA.reset();
-        }
-        if (OversamplingChanA.getCount() > 250) {
-          OversamplingChanA.resetKeepLast();
-        }
-        OversamplingChanA.add(value);
-        break;
-      }
-      case P067_Channel_e::chanB32:
-      {
-        if (!P067_GET_CHANNEL_B_OS) { // Oversampling on channel B?
-          OversamplingChanB.reset();
-        }
-        if (OversamplingChanB.getCount() > 250) {
-          OversamplingChanB.resetKeepLast();
-        }
-        OversamplingChanB.add(value);
-        break;
+  if (_useInterrupt) {
+    if (isDataReady()) {
+      // Normally the ISR reads DOUT low within a few usec.
+      // Still low here means no falling edge was seen, e.g. at startup, so read it to get the chip going again.
+      ISR_noInterrupts();
+
+      if (isDataReady()) {
+        ISR_dataReady(this);
       }
+      ISR_interrupts();
+    }
+
+    while (_ringTail != _ringHead) {
+      const uint8_t tail = _ringTail;
+      addSample(event, _ringValue[tail], static_cast<P067_Channel_e>(_ringChannel[tail]));
+      _ringTail = (tail + 1) & (P067_RING_SIZE - 1);
+      success   = true;
     }
+  } else if (isDataReady()) {
+    const int32_t value = readHX711(); // Sets _channelRead
+    addSample(event, value, _channelRead);
+    success = true;
   }
 
   return success;
 }
 
+/*****************************************************
+* Process a sample, via the median filter and oversampling
+*****************************************************/
+void P067_data_struct::addSample(struct EventStruct *event, int32_t value, P067_Channel_e channel) {
+  switch (channel) {
+    case P067_Channel_e::chanA64:  //
+    case P067_Channel_e::chanA128:
+    {
+      if (_useMedian) {
+        value = _medianChanA.add(value);
+      }
+      if (!P067_GET_CHANNEL_A_OS) { // Oversampling on channel A?
+        OversamplingChanA.reset();
+      }
+      if (OversamplingChanA.getCount() > 250) {
+        OversamplingChanA.resetKeepLast();
+      }
+      OversamplingChanA.add(value);
+      break;
+    }
+    case P067_Channel_e::chanB32:
+    {
+      if (_useMedian) {
+        value = _medianChanB.add(value);
+      }
+      if (!P067_GET_CHANNEL_B_OS) { // Oversampling on channel B?
+        OversamplingChanB.reset();
+      }
+      if (OversamplingChanB.getCount() > 250) {
+        OversamplingChanB.resetKeepLast();
+      }
+      OversamplingChanB.add(value);
+      break;
+    }
+  }
+}
+
 /*****************************************************
 * plugin_write
 *****************************************************/
@@ -204,6 +280,7 @@ bool P067_data_struct::plugin_write(struct EventStruct *event,
     P067_float2int(-UserVar[event->BaseVarIndex + 2], &P067_OFFSET_CHANNEL_A_1, &P067_OFFSET_CHANNEL_A_2);
     P067_int2float(P067_OFFSET_CHANNEL_A_1, P067_OFFSET_CHANNEL_A_2, &_offsetChanA);
     OversamplingChanA.reset();
+    _medianChanA.reset();
 
     addLog(LOG_LEVEL_INFO, F("HX711: tare channel A"));
     success = true;
@@ -211,6 +288,7 @@ bool P067_data_struct::plugin_write(struct EventStruct *event,
     P067_float2int(-UserVar[event->BaseVarIndex + 3], &P067_OFFSET_CHANNEL_B_1, &P067_OFFSET_CHANNEL_B_2);
     P067_int2float(P067_OFFSET_CHANNEL_B_1, P067_OFFSET_CHANNEL_B_2, &_offsetChanB);
     OversamplingChanB.reset();
+    _medianChanB.reset();
 
     addLog(LOG_LEVEL_INFO, F("HX711: tare channel B"));
     success = true;
@@ -242,7 +320,7 @@ bool P067_data_struct::isDataReady() {
 /****************************************************
 * Read data from the load sensor
 ****************************************************/
-int32_t P067_data_struct::readHX711() {
+int32_t IRAM_ATTR P067_data_struct::readHX711() {
   int32_t  value = 0;
   uint32_t mask  = 0x00800000;
 
@@ -250,7 +328,7 @@ int32_t P067_data_struct::readHX711() {
 
   // Both channels off
   if ((_modeChanA == P067_ChannelA_State_e::modeAoff) && (_modeChanB == P067_ChannelB_State_e::modeBoff)) {
-    DIRECT_pinWrite(_pinSCL, HIGH);
+    DIRECT_pinWrite_ISR(_pinSCL, HIGH);
     return 0;
   }
 
@@ -283,11 +361,11 @@ int32_t P067_data_struct::readHX711() {
   }
 
   for (uint8_t i = 0; i < 24; i++) {
-    DIRECT_pinWrite(_pinSCL, HIGH);
+    DIRECT_pinWrite_ISR(_pinSCL, HIGH);
     delayMicroseconds(1);
-    DIRECT_pinWrite(_pinSCL, LOW);
+    DIRECT_pinWrite_ISR(_pinSCL, LOW);
 
-    if (DIRECT_pinRead(_pinDOUT)) {
+    if (DIRECT_pinRead_ISR(_pinDOUT)) {
       value |= mask;
     }
     delayMicroseconds(1);
@@ -295,9 +373,9 @@ int32_t P067_data_struct::readHX711() {
   }
 
   for (uint8_t i = 0; i < (static_cast < uint8_t > (_nextChannel) + 1); i++) {
-    DIRECT_pinWrite(_pinSCL, HIGH);
+    DIRECT_pinWrite_ISR(_pinSCL, HIGH);
     delayMicroseconds(1);
-    DIRECT_pinWrite(_pinSCL, LOW);
+    DIRECT_pinWrite_ISR(_pinSCL, LOW);
     delayMicroseconds(1);
   }
 
@@ -307,4 +385,23 @@ int32_t P067_data_struct::readHX711() {
   return value;
 }
 
+/****************************************************
+* Data ready ISR, on falling edge of DOUT
+****************************************************/
+void IRAM_ATTR P067_data_struct::ISR_dataReady(P067_data_struct *self) {
+  // Also triggered by the data bits while clocking out a conversion, DOUT is high again when done.
+  if (DIRECT_pinRead_ISR(self->_pinDOUT)) {
+    return;
+  }
+  const int32_t value = self->readHX711();
+  const uint8_t head  = self->_ringHead;
+  const uint8_t next  = (head + 1) & (P067_RING_SIZE - 1);
+
+  if (next != self->_ringTail) { // Drop the sample when the ring is full
+    self->_ringValue[head]   = value;
+    self->_ringChannel[head] = static_cast<uint8_t>(self->_channelRead);
+    self->_ringHead          = next;
+  }
+}
+
 #endif // ifdef USES_P067
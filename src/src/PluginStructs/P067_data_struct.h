@@ -26,6 +26,15 @@
 # define P067_CONFIG_CHANNEL_B_CALIB  6
 # define P067_GET_CHANNEL_B_CALIB   bitRead(P067_CONFIG_FLAGS, P067_CONFIG_CHANNEL_B_CALIB)
 # define P067_SET_CHANNEL_B_CALIB(X) bitWrite(P067_CONFIG_FLAGS, P067_CONFIG_CHANNEL_B_CALIB, X)
+# define P067_CONFIG_USE_INTERRUPT   7
+# define P067_GET_USE_INTERRUPT      bitRead(P067_CONFIG_FLAGS, P067_CONFIG_USE_INTERRUPT)
+# define P067_SET_USE_INTERRUPT(X) bitWrite(P067_CONFIG_FLAGS, P067_CONFIG_USE_INTERRUPT, X)
+# define P067_CONFIG_MEDIAN_FILTER   8
+# define P067_GET_MEDIAN_FILTER      bitRead(P067_CONFIG_FLAGS, P067_CONFIG_MEDIAN_FILTER)
+# define P067_SET_MEDIAN_FILTER(X) bitWrite(P067_CONFIG_FLAGS, P067_CONFIG_MEDIAN_FILTER, X)
+
+# define P067_RING_SIZE              16 // Samples read by the ISR, must be a power of 2
+# define P067_MEDIAN_SIZE            5  // Nr of samples for the median filter
 
 # define P067_CONFIG_CHANNEL_A_ADC1   PCONFIG_LONG(0)
 # define P067_CONFIG_CHANNEL_A_ADC2   PCONFIG_LONG(1)
@@ -58,6 +67,21 @@ enum class P067_Channel_e : uint8_t {
   chanA64  = 2u
 };
 
+// Sliding median over the last P067_MEDIAN_SIZE samples
+struct P067_median_t {
+  int32_t add(int32_t value);
+
+  void    reset() {
+    _count = 0;
+  }
+
+private:
+
+  int32_t _samples[P067_MEDIAN_SIZE]{};
+  uint8_t _count = 0;
+  uint8_t _index = 0;
+};
+
 void P067_float2int(float    valFloat,
                     int16_t *valInt0,
                     int16_t *valInt1);
@@ -88,6 +112,13 @@ private:
   bool    isDataReady();
   int32_t readHX711();
 
+  void    addSample(struct EventStruct *event,
+                    int32_t             value,
+                    P067_Channel_e      channel);
+
+  // Clock out the conversion as soon as DOUT signals data ready
+  static void ISR_dataReady(P067_data_struct *self);
+
   int8_t _pinSCL  = -1;
   int8_t _pinDOUT = -1;
 
@@ -105,6 +136,18 @@ private:
   float _offsetChanB = 0.0f;
 
   bool firstRead = true;
+
+  bool _useInterrupt = false;
+  bool _useMedian    = false;
+
+  P067_median_t _medianChanA;
+  P067_median_t _medianChanB;
+
+  // Ring of samples read by the ISR, processed in plugin_fifty_per_second
+  volatile int32_t _ringValue[P067_RING_SIZE]{};
+  volatile uint8_t _ringChannel[P067_RING_SIZE]{};
+  volatile uint8_t _ringHead = 0;
+  volatile uint8_t _ringTail = 0;
 };
 
 #endif // ifdef USES_P067
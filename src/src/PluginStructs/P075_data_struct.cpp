@@ -2,6 +2,7 @@
 
 #ifdef USES_P075
 
+# include "../Helpers/CRC_functions.h"
 
 P075_data_struct::P075_data_struct(ESPEasySerialPort port, int rx, int tx, uint32_t baud) : rxPin(rx), txPin(tx), baudrate(baud) {
   if ((baudrate < 9600) || (baudrate > 115200)) {
@@ -36,4 +37,108 @@ String P075_data_struct::getLogString() const {
   return result;
 }
 
+bool P075_data_struct::queueCommand(const String& cmd, int line, bool send_changed_only) {
+  if ((easySerial == nullptr) || (txPin < 0)) {
+    return false;
+  }
+
+  if ((line >= 0) && (line < P75_Nlines)) {
+    uint32_t crc = calc_CRC32(reinterpret_cast<const uint8_t *>(cmd.c_str()), cmd.length());
+
+    if (crc == 0) { crc = 1; } // 0 is reserved for 'not sent yet'
+
+    if (send_changed_only && (crc == lastSentCRC[line])) {
+      return false;
+    }
+    lastSentCRC[line] = crc;
+  }
+  const uint16_t len = cmd.length();
+
+  if ((txLength + len + 3) > TXBUFFSZ) {
+    flushCommands();
+  }
+
+  if ((len + 3) > TXBUFFSZ) {
+    // Does not fit in the buffer, send as-is
+    const uint8_t terminator[3] = { 0xff, 0xff, 0xff };
+    easySerial->write(reinterpret_cast<const uint8_t *>(cmd.c_str()), len);
+    easySerial->write(terminator, sizeof(terminator));
+    return true;
+  }
+  memcpy(&txBuffer[txLength], cmd.c_str(), len);
+  txLength += len;
+
+  for (uint8_t i = 0; i < 3; ++i) {
+    txBuffer[txLength++] = 0xff;
+  }
+  return true;
+}
+
+void P075_data_struct::flushCommands() {
+  if ((easySerial != nullptr) && (txLength > 0)) {
+    easySerial->write(txBuffer, txLength);
+  }
+  txLength = 0;
+}
+
+void P075_data_struct::invalidateSentCache() {
+  memset(lastSentCRC, 0, sizeof(lastSentCRC));
+}
+
+bool P075_data_struct::readFrame() {
+  if (easySerial == nullptr) {
+    return false;
+  }
+
+  while (easySerial->available() > 0) {
+    const int c = easySerial->read();
+
+    if (c < 0) {
+      break;
+    }
+    const uint8_t b          = static_cast<uint8_t>(c);
+    bool          endOfFrame = false;
+
+    if ((rxIndex > 0) && (rxBuffer[0] == P075_PIPE_CMD)) {
+      endOfFrame = (b == 0x0a) || (b == 0x0d);
+    } else if ((rxIndex == 0) && ((b == 0x0a) || (b == 0x0d))) {
+      continue; // Trailing CR/LF of a previous pipe command
+    } else if (b == 0xff) {
+      ++rxFFcount;
+
+      if (rxFFcount < 3) {
+        continue;
+      }
+      endOfFrame = true;
+    } else {
+      // Earlier 0xFF bytes were data, not the terminator
+      for (; rxFFcount > 0; --rxFFcount) {
+        if (rxIndex < RXBUFFSZ) {
+          rxBuffer[rxIndex++] = 0xff;
+        } else {
+          rxOverflow = true;
+        }
+      }
+    }
+
+    if (endOfFrame) {
+      const bool valid = !rxOverflow && (rxIndex > 0);
+      rxLength           = rxIndex;
+      rxBuffer[rxLength] = 0;
+      rxIndex            = 0;
+      rxFFcount          = 0;
+      rxOverflow         = false;
+
+      if (valid) {
+        return true;
+      }
+    } else if (rxIndex < RXBUFFSZ) {
+      rxBuffer[rxIndex++] = b;
+    } else {
+      rxOverflow = true; // Frame is dropped when its terminator arrives
+    }
+  }
+  return false;
+}
+
 #endif // ifdef USES_P075
@@ -18,6 +18,14 @@
 # define RXBUFFSZ  64               // Serial RxD buffer (Local staging buffer and ESPeasySerial).
 # define RXBUFFWARN (RXBUFFSZ - 16) // Warning, Rx buffer close to being full.
 # define TOUCH_BASE 500             // Base offset for 0X65 Touch Event Send Component ID.
+# define TXBUFFSZ  128              // Serial TxD buffer, commands are collected and sent in a single write.
+
+// Nextion return codes
+# define P075_TOUCH_EVENT    0x65   // Touch event, component id and event follow.
+# define P075_PAGE_ID        0x66   // Current page id, response to 'sendme'.
+# define P075_STARTUP        0x00   // Sent as 0x00 0x00 0x00 after power on or reset.
+# define P075_READY          0x88   // Display ready after power on or reset.
+# define P075_PIPE_CMD       '|'    // Pipe command, text terminated by CR or LF.
 
 // Serial defines
 # define P075_B9600    0
@@ -41,12 +49,42 @@ struct P075_data_struct : public PluginTaskData_base {
 
   String getLogString() const;
 
+  // Append a command and its 0xFF 0xFF 0xFF terminator to the TxD buffer.
+  // When send_changed_only is set, the command is skipped if it equals the last one sent for this line.
+  // Returns false if the command is skipped.
+  bool queueCommand(const String& cmd,
+                    int           line              = -1,
+                    bool          send_changed_only = false);
+
+  // Send the buffered commands in a single serial write.
+  void flushCommands();
+
+  // Forget the last sent commands, so all lines are sent at the next interval.
+  void invalidateSentCache();
+
+  // Read available serial data, return true when a complete frame is stored in rxBuffer.
+  // Binary frames are terminated by 0xFF 0xFF 0xFF, pipe commands by CR or LF.
+  // rxBuffer is zero terminated and rxLength excludes the terminator.
+  bool readFrame();
+
   ESPeasySerial *easySerial = nullptr;
   int            rxPin      = -1;
   int            txPin      = -1;
   uint32_t       baudrate   = 9600UL;
 
   String displayLines[P75_Nlines];
+
+  uint8_t rxBuffer[RXBUFFSZ + 1] = { 0 };
+  uint8_t rxLength               = 0;
+
+private:
+
+  uint32_t lastSentCRC[P75_Nlines] = { 0 }; // 0 = not sent yet
+  uint8_t  txBuffer[TXBUFFSZ]      = { 0 };
+  uint16_t txLength                = 0;
+  uint8_t  rxIndex                 = 0;
+  uint8_t  rxFFcount               = 0;
+  bool     rxOverflow              = false;
 };
 
 #endif // ifdef USES_P075
@@ -114,6 +114,104 @@ void P081_check_or_init(struct EventStruct *event)
   }
 }
 
+// Enabled task running the cron plugin, with a valid cron expression
+static bool P081_isCronTask(taskIndex_t taskIndex)
+{
+  constexpr pluginID_t PLUGIN_ID_P081_CRON(PLUGIN_ID_081);
+
+  if (!Settings.TaskDeviceEnabled[taskIndex] ||
+      (getPluginID_from_TaskIndex(taskIndex) != PLUGIN_ID_P081_CRON)) {
+    return false;
+  }
+  P081_data_struct *P081_data =
+    static_cast<P081_data_struct *>(getPluginTaskData(taskIndex));
+
+  return (nullptr != P081_data) && P081_data->isInitialized();
+}
+
+taskIndex_t P081_firstCronTask()
+{
+  for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; ++taskIndex) {
+    if (P081_isCronTask(taskIndex)) {
+      return taskIndex;
+    }
+  }
+  return INVALID_TASK_INDEX;
+}
+
+void P081_processCronTasks(bool sendEvents)
+{
+  if (!node_time.systemTimePresent()) {
+    addLog(LOG_LEVEL_ERROR, F("CRON: Time not synced"));
+    return;
+  }
+
+  constexpr pluginID_t PLUGIN_ID_P081_CRON(PLUGIN_ID_081);
+  const time_t current_time    = P081_getCurrentTime();
+  time_t       first_exec_time = CRON_INVALID_INSTANT;
+
+  for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; ++taskIndex) {
+    if (!P081_isCronTask(taskIndex)) {
+      continue;
+    }
+    struct EventStruct TempEvent(taskIndex);
+
+    P081_check_or_init(&TempEvent);
+    time_t next_exec_time = P081_getCronExecTime(taskIndex, NEXTEXECUTION);
+
+    if (next_exec_time == CRON_INVALID_INSTANT) {
+      addLog(LOG_LEVEL_ERROR, F("CRON: INVALID INSTANT"));
+      continue;
+    }
+
+    if (next_exec_time <= current_time) {
+      # ifndef BUILD_NO_DEBUG
+      addLog(LOG_LEVEL_DEBUG, F("Cron Elapsed"));
+      # endif // ifndef BUILD_NO_DEBUG
+
+      const time_t last_exec_time = next_exec_time;
+      next_exec_time = P081_computeNextCronTime(taskIndex, current_time);
+      P081_setCronExecTimes(&TempEvent, last_exec_time, next_exec_time);
+
+      # ifndef BUILD_NO_DEBUG
+      addLog(LOG_LEVEL_DEBUG, String(F("Next execution:")) + formatDateTimeString(*gmtime(&next_exec_time)));
+      # endif // ifndef BUILD_NO_DEBUG
+
+      if (sendEvents && Settings.UseRules) {
+        eventQueue.addMove(concat(F("Cron#"), getTaskDeviceName(taskIndex)));
+      }
+    }
+
+    if ((next_exec_time != CRON_INVALID_INSTANT) &&
+        ((first_exec_time == CRON_INVALID_INSTANT) || (next_exec_time < first_exec_time))) {
+      first_exec_time = next_exec_time;
+    }
+  }
+
+  if ((first_exec_time == CRON_INVALID_INSTANT) || (first_exec_time <= current_time)) {
+    return;
+  }
+
+  // Subtract the part of the current second already passed,
+  // so the timer fires right at the start of the scheduled second.
+  uint32_t unix_time_frac = 0;
+
+  node_time.getUnixTime(unix_time_frac);
+  const uint32_t msec_passed = (static_cast<uint64_t>(unix_time_frac) * 1000ull) >> 32;
+  uint64_t msecFromNow       = static_cast<uint64_t>(first_exec_time - current_time) * 1000ull;
+
+  if (msecFromNow > msec_passed) {
+    msecFromNow -= msec_passed;
+  }
+
+  if (msecFromNow > P081_MAX_TIMER_INTERVAL_MSEC) {
+    msecFromNow = P081_MAX_TIMER_INTERVAL_MSEC;
+  }
+
+  // All cron tasks share the same timer, as it is set per plugin and not per task.
+  Scheduler.setPluginTimer(static_cast<unsigned long>(msecFromNow), PLUGIN_ID_P081_CRON, 0);
+}
+
 # if PLUGIN_081_DEBUG
 void PrintCronExp(struct cron_expr_t e) {
   serialPrintln(F("===DUMP Cron Expression==="));
@@ -17,10 +17,14 @@ extern "C"
 # ifndef PLUGIN_081_DEBUG
   #  define PLUGIN_081_DEBUG  false // set to true for extra log info in the debug
 # endif // ifndef PLUGIN_081_DEBUG
+# define PLUGIN_ID_081         81
 # define PLUGIN_081_EXPRESSION_SIZE 41
 # define LASTEXECUTION         0
 # define NEXTEXECUTION         1
 
+// The plugin timer is checked at least this often, to correct for drift between millis() and the system time.
+# define P081_MAX_TIMER_INTERVAL_MSEC  600000
+
 
 struct P081_data_struct : public PluginTaskData_base {
   P081_data_struct() = delete;
@@ -61,6 +65,14 @@ time_t P081_getCurrentTime();
 
 void   P081_check_or_init(struct EventStruct *event);
 
+// Handle the elapsed schedules of all cron tasks and set a single plugin timer (PLUGIN_DEVICETIMER_IN)
+// at the first next execution time of all cron tasks.
+// @param sendEvents  Send Cron#<taskname> events for elapsed schedules
+void   P081_processCronTasks(bool sendEvents);
+
+// Return the first enabled cron task with a valid cron expression, or INVALID_TASK_INDEX
+taskIndex_t P081_firstCronTask();
+
 # if PLUGIN_081_DEBUG
 void   PrintCronExp(struct cron_expr_t e);
 # endif // if PLUGIN_081_DEBUG
@@ -133,13 +133,35 @@ bool P082_data_struct::loop() {
       --available;
       int c = easySerial->read();
       if (c >= 0) {
+        if (c == '$') {
+          _sentenceHeaderLength = 0;
+          _skipSentence         = false;
 # ifdef P082_SEND_GPS_TO_LOG
-        if (_currentSentence.length() <= 80) {
-          // No need to capture more than 80 bytes as a NMEA message is never that long.
-          if (c != 0) {
-            _currentSentence += static_cast<char>(c);
+          _currentSentenceLength = 0;
+# endif // ifdef P082_SEND_GPS_TO_LOG
+        } else if (_skipSentence) {
+          // Sentence is not needed, so do not feed the rest of it to the parser.
+          if (c == '\n') {
+            _skipSentence = false;
+          }
+          if (available == 0) {
+            available = easySerial->available();
+          }
+          continue;
+        } else if (_sentenceHeaderLength < P082_NMEA_HEADER_LENGTH) {
+          _sentenceHeader[_sentenceHeaderLength++] = static_cast<char>(c);
+
+          if ((_sentenceHeaderLength == P082_NMEA_HEADER_LENGTH) && !sentenceNeeded()) {
+            _skipSentence = true;
+            ++_sentencesSkipped;
           }
         }
+# ifdef P082_SEND_GPS_TO_LOG
+
+        // No need to capture line endings, a NMEA message is never longer than 82 bytes.
+        if ((c >= 0x20) && (_currentSentenceLength < (P082_SENTENCE_BUFFER_LEN - 1))) {
+          _currentSentence[_currentSentenceLength++] = static_cast<char>(c);
+        }
 # endif // ifdef P082_SEND_GPS_TO_LOG
 
         if (c == 0x85) {
@@ -195,8 +217,9 @@ bool P082_data_struct::loop() {
         if (gps->encode(c)) {
           // Full sentence received
 # ifdef P082_SEND_GPS_TO_LOG
-          _lastSentence    = _currentSentence;
-          _currentSentence = String();
+          memcpy(_lastSentence, _currentSentence, _currentSentenceLength);
+          _lastSentence[_currentSentenceLength] = '\0';
+          _currentSentenceLength                = 0;
 # endif // ifdef P082_SEND_GPS_TO_LOG
           completeSentence = true;
         } else {
@@ -226,6 +249,31 @@ bool P082_data_struct::loop() {
   return completeSentence;
 }
 
+bool P082_data_struct::sentenceNeeded() const {
+  // Skip the talker ID (GP, GL, GN, ...), only the sentence type matters.
+  const char *type = &_sentenceHeader[2];
+
+  if ((strncmp_P(type, PSTR("RMC"), 3) == 0) ||
+      (strncmp_P(type, PSTR("GGA"), 3) == 0) ||
+      (strncmp_P(type, PSTR("GLL"), 3) == 0)) {
+    // Time, date, location, speed, altitude, fix quality and HDOP
+    return true;
+  }
+
+  if (_parseSatStats &&
+      ((strncmp_P(type, PSTR("GSV"), 3) == 0) ||
+       (strncmp_P(type, PSTR("GSA"), 3) == 0))) {
+    return true;
+  }
+# ifdef P082_SEND_GPS_TO_LOG
+
+  if (strncmp_P(type, PSTR("TXT"), 3) == 0) {
+    return true;
+  }
+# endif // ifdef P082_SEND_GPS_TO_LOG
+  return false;
+}
+
 bool P082_data_struct::hasFix(unsigned int maxAge_msec) {
   if (!isInitialized()) {
     return false;
@@ -262,7 +310,7 @@ ESPEASY_RULES_FLOAT_TYPE P082_data_struct::distanceSinceLast(unsigned int maxAge
 // additional centiseconds given by the GPS.
 bool P082_data_struct::getDateTime(
   struct tm& dateTime,
-  uint32_t & age,
+  uint32_t & age_usec,
   bool     & updated,
   bool     & pps_sync) {
   updated = false;
@@ -275,11 +323,16 @@ bool P082_data_struct::getDateTime(
     return false;
   }
 
-  if (_pps_time != 0) {
-    age       = timePassedSince(_pps_time);
-    _pps_time = 0;
-    pps_sync  = true;
+  uint32_t age;
+
+  if (_pps_time_usec != 0) {
+    // Unsigned subtraction, so micros() overflow is handled.
+    age_usec       = micros() - _pps_time_usec;
+    age            = age_usec / 1000;
+    _pps_time_usec = 0;
+    pps_sync       = true;
 
+    // The sentence must have been received after the PPS pulse of the reported second.
     if ((age > P082_TIMESTAMP_AGE) || (gps->time.age() > age)) {
       return false;
     }
@@ -322,14 +375,15 @@ bool P082_data_struct::getDateTime(
 
   _last_time = reported_time;
   _last_date = reported_date;
-  // FIXME TD-er: Must the offset in centisecond be added when pps_sync active?
+  // The PPS pulse marks the start of the reported second, so the centisecond offset only applies without PPS.
   if (!pps_sync) {
     // Don't use the "commit" time when the sentence was read, but use the timestamp when the first sentence of a NMEA sequence was received.
     const long time_since_start_seq = timePassedSince(_start_sequence);
     if (time_since_start_seq < P082_TIMESTAMP_AGE) {
       age = time_since_start_seq;
     }
-    age += (gps->time.centisecond() * 10);
+    age     += (gps->time.centisecond() * 10);
+    age_usec = age * 1000;
   }
 
   return true;
@@ -13,6 +13,8 @@
 #endif
 
 # define P082_TIMESTAMP_AGE       1000
+# define P082_NMEA_HEADER_LENGTH  5    // Talker ID + sentence type, e.g. "GPRMC"
+# define P082_SENTENCE_BUFFER_LEN 83   // Max. NMEA sentence length (82) + terminator
 # define P082_DEFAULT_FIX_TIMEOUT 2500 // TTL of fix status in ms since last update
 
 
@@ -82,6 +84,15 @@ struct P082_data_struct : public PluginTaskData_base {
 
   bool loop();
 
+  // Satellite stats (GSV/GSA sentences) are only parsed when needed for one of the task values.
+  void setParseSatelliteStats(bool parse) {
+    _parseSatStats = parse;
+  }
+
+  bool parseSatelliteStats() const {
+    return _parseSatStats;
+  }
+
   bool hasFix(unsigned int maxAge_msec);
 
   bool storeCurPos(unsigned int maxAge_msec);
@@ -93,8 +104,9 @@ struct P082_data_struct : public PluginTaskData_base {
   // Return the GPS time stamp, which is in UTC.
   // @param age is the time in msec since the last update of the time +
   // additional centiseconds given by the GPS.
+  // @param age_usec  Time in usec since the start of the reported second
   bool getDateTime(struct tm& dateTime,
-                   uint32_t & age,
+                   uint32_t & age_usec,
                    bool     & updated,
                    bool     & pps_sync);
 
@@ -128,6 +140,14 @@ private:
 #endif
 
   bool writeToGPS(const uint8_t* data, size_t size);
+
+  // Check the sentence header whether TinyGPS++ needs to parse the rest of the sentence.
+  bool sentenceNeeded() const;
+
+  char    _sentenceHeader[P082_NMEA_HEADER_LENGTH]{};
+  uint8_t _sentenceHeaderLength = 0;
+  bool    _skipSentence         = false;
+  bool    _parseSatStats        = true;
 public:
 
   TinyGPSPlus   *gps        = nullptr;
@@ -140,7 +160,8 @@ public:
   ESPEASY_RULES_FLOAT_TYPE _distance{};
 
 
-  unsigned long _pps_time            = 0;
+  uint32_t      _pps_time_usec       = 0; // micros() at the last PPS pulse, 0 = none
+  uint32_t      _sentencesSkipped    = 0;
   unsigned long _last_measurement    = 0;
   uint32_t      _last_time           = 0;
   uint32_t      _last_date           = 0;
@@ -149,8 +170,9 @@ public:
   uint32_t      _start_prev_sentence = 0;
   uint32_t      _start_sequence      = 0;
 # ifdef P082_SEND_GPS_TO_LOG
-  String _lastSentence;
-  String _currentSentence;
+  char    _lastSentence[P082_SENTENCE_BUFFER_LEN]{};
+  char    _currentSentence[P082_SENTENCE_BUFFER_LEN]{};
+  uint8_t _currentSentenceLength = 0;
 # endif // ifdef P082_SEND_GPS_TO_LOG
 
   float _cache[static_cast<uint8_t>(P082_query::P082_NR_OUTPUT_OPTIONS)]{};
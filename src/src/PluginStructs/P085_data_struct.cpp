@@ -3,16 +3,38 @@
 #ifdef USES_P085
 
 P085_data_struct::~P085_data_struct() {
-  modbus.reset();
+  reset();
 }
 
 void P085_data_struct::reset() {
-  modbus.reset();
+  if (bus != nullptr) {
+    bus->remove(&registerMap);
+    ModbusRTU_releaseBus(bus);
+    bus = nullptr;
+  }
 }
 
 bool P085_data_struct::init(ESPEasySerialPort port, const int16_t serial_rx, const int16_t serial_tx, int8_t dere_pin,
                             unsigned int baudrate, uint8_t modbusAddress) {
-  return modbus.init(port, serial_rx, serial_tx, baudrate, modbusAddress, dere_pin);
+  reset();
+  bus = ModbusRTU_acquireBus(port, serial_rx, serial_tx, baudrate, dere_pin);
+
+  if (bus == nullptr) {
+    return false;
+  }
+  this->modbusAddress = modbusAddress;
+  registerMap.setSlaveAddress(modbusAddress);
+  detected_device_description = bus->detectDevice(modbusAddress);
+  return true;
+}
+
+void P085_data_struct::initRegisterMap(struct EventStruct *event) {
+  registerMap.clear();
+
+  for (int i = 0; i < P085_NR_OUTPUT_VALUES; ++i) {
+    p085_addQueryRegisters(registerMap, PCONFIG(i + P085_QUERY1_CONFIG_POS));
+  }
+  registerMap.build();
 }
 
 const __FlashStringHelper* Plugin_085_valuename(uint8_t value_nr, bool displayString) {
@@ -48,47 +70,80 @@ int p085_storageValueToBaudrate(uint8_t baudrate_setting) {
   return 19200;
 }
 
-float p085_readValue(uint8_t query, struct EventStruct *event) {
-  P085_data_struct *P085_data =
-    static_cast<P085_data_struct *>(getPluginTaskData(event->TaskIndex));
-
-  if ((nullptr != P085_data) && P085_data->isInitialized()) {
-    switch (query) {
-      case P085_QUERY_V:
-        return P085_data->modbus.read_float_HoldingRegister(0x200);
-      case P085_QUERY_A:
-        return P085_data->modbus.read_float_HoldingRegister(0x202);
-      case P085_QUERY_W:
-        return P085_data->modbus.read_float_HoldingRegister(0x204) * 1000.0f; // power (kW => W)
-      case P085_QUERY_Wh_imp:
-        return P085_data->modbus.read_32b_HoldingRegister(0x300) * 10.0f;     // 0.01 kWh => Wh
-      case P085_QUERY_Wh_exp:
-        return P085_data->modbus.read_32b_HoldingRegister(0x302) * 10.0f;     // 0.01 kWh => Wh
-      case P085_QUERY_Wh_tot:
-        return P085_data->modbus.read_32b_HoldingRegister(0x304) * 10.0f;     // 0.01 kWh => Wh
-      case P085_QUERY_Wh_net:
-      {
-        int64_t intvalue = P085_data->modbus.read_32b_HoldingRegister(0x306);
-
-        if (intvalue >= 2147483648ll) {
-          intvalue = 4294967296ll - intvalue;
+// All values are 2 holding registers
+static uint16_t p085_getQueryRegister(uint8_t query) {
+  switch (query) {
+    case P085_QUERY_V:      return 0x200;
+    case P085_QUERY_A:      return 0x202;
+    case P085_QUERY_W:      return 0x204;
+    case P085_QUERY_Wh_imp: return 0x300;
+    case P085_QUERY_Wh_exp: return 0x302;
+    case P085_QUERY_Wh_tot: return 0x304;
+    case P085_QUERY_Wh_net: return 0x306;
+    case P085_QUERY_h_tot:  return 0x280;
+    case P085_QUERY_h_load: return 0x282;
+  }
+  return 0;
+}
+
+void p085_addQueryRegisters(ModbusRTU_RegisterMap& registerMap, uint8_t query) {
+  if (query < P085_NR_OUTPUT_OPTIONS) {
+    registerMap.addRegisters(MODBUS_READ_HOLDING_REGISTERS, p085_getQueryRegister(query), 2);
+  }
+}
+
+float p085_decodeValue(uint8_t query, const ModbusRTU_RegisterMap& registerMap) {
+  const uint16_t reg = p085_getQueryRegister(query);
+  float    floatvalue = 0.0f;
+  uint32_t intvalue   = 0;
+
+  switch (query) {
+    case P085_QUERY_V:
+    case P085_QUERY_A:
+
+      if (registerMap.getFloat(MODBUS_READ_HOLDING_REGISTERS, reg, floatvalue)) {
+        return floatvalue;
+      }
+      break;
+    case P085_QUERY_W:
+
+      if (registerMap.getFloat(MODBUS_READ_HOLDING_REGISTERS, reg, floatvalue)) {
+        return floatvalue * 1000.0f; // power (kW => W)
+      }
+      break;
+    case P085_QUERY_Wh_imp:
+    case P085_QUERY_Wh_exp:
+    case P085_QUERY_Wh_tot:
+
+      if (registerMap.get32b(MODBUS_READ_HOLDING_REGISTERS, reg, intvalue)) {
+        return intvalue * 10.0f; // 0.01 kWh => Wh
+      }
+      break;
+    case P085_QUERY_Wh_net:
+
+      if (registerMap.get32b(MODBUS_READ_HOLDING_REGISTERS, reg, intvalue)) {
+        int64_t value = intvalue;
+
+        if (value >= 2147483648ll) {
+          value = 4294967296ll - value;
         }
-        float value = static_cast<float>(intvalue);
-        value *= 10.0f; // 0.01 kWh => Wh
-        return value;
+        return static_cast<float>(value) * 10.0f; // 0.01 kWh => Wh
+      }
+      break;
+    case P085_QUERY_h_tot:
+    case P085_QUERY_h_load:
+
+      if (registerMap.get32b(MODBUS_READ_HOLDING_REGISTERS, reg, intvalue)) {
+        return intvalue / 100.0f;
       }
-      case P085_QUERY_h_tot:
-        return P085_data->modbus.read_32b_HoldingRegister(0x280) / 100.0f;
-      case P085_QUERY_h_load:
-        return P085_data->modbus.read_32b_HoldingRegister(0x282) / 100.0f;
-    }
+      break;
   }
   return 0.0f;
 }
 
-void p085_showValueLoadPage(uint8_t query, struct EventStruct *event) {
+void p085_showValueLoadPage(uint8_t query, const ModbusRTU_RegisterMap& registerMap) {
   addRowLabel(Plugin_085_valuename(query, true));
-  addHtml(String(p085_readValue(query, event)));
+  addHtml(String(p085_decodeValue(query, registerMap)));
 }
 
 #endif // ifdef USES_P085
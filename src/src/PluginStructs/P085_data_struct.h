@@ -60,10 +60,21 @@ struct P085_data_struct : public PluginTaskData_base {
             uint8_t           modbusAddress);
 
   bool isInitialized() const {
-    return modbus.isInitialized();
+    return bus != nullptr;
   }
 
-  ModbusRTU_struct modbus;
+  // Modbus access for blocking commands to the slave of this task
+  ModbusRTU_struct& modbus() {
+    return bus->selectSlave(modbusAddress);
+  }
+
+  // Collect the registers of the selected output values, so they are read in as few requests as possible
+  void initRegisterMap(struct EventStruct *event);
+
+  ModbusRTU_bus        *bus = nullptr; // Shared with other tasks using the same serial port
+  String                detected_device_description;
+  uint8_t               modbusAddress = 0;
+  ModbusRTU_RegisterMap registerMap;
 };
 
 
@@ -72,11 +83,14 @@ const __FlashStringHelper* Plugin_085_valuename(uint8_t value_nr,
 
 int                        p085_storageValueToBaudrate(uint8_t baudrate_setting);
 
-float                      p085_readValue(uint8_t             query,
-                                          struct EventStruct *event);
+void                       p085_addQueryRegisters(ModbusRTU_RegisterMap& registerMap,
+                                                  uint8_t                query);
+
+float                      p085_decodeValue(uint8_t                      query,
+                                            const ModbusRTU_RegisterMap& registerMap);
 
-void                       p085_showValueLoadPage(uint8_t             query,
-                                                  struct EventStruct *event);
+void                       p085_showValueLoadPage(uint8_t                      query,
+                                                  const ModbusRTU_RegisterMap& registerMap);
 
 
 #endif // ifdef USES_P085
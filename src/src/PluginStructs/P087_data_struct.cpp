@@ -13,17 +13,18 @@
 
 
 P087_data_struct::~P087_data_struct() {
-  if (easySerial != nullptr) {
-    delete easySerial;
-    easySerial = nullptr;
-  }
+  reset();
 }
 
 void P087_data_struct::reset() {
   if (easySerial != nullptr) {
+    # if FEATURE_SERIAL_RX_EVENT
+    serialHelper_disableRxEvent(rx_event_task, *easySerial);
+    # endif // if FEATURE_SERIAL_RX_EVENT
     delete easySerial;
     easySerial = nullptr;
   }
+  rx_event_task = INVALID_TASK_INDEX;
 }
 
 bool P087_data_struct::init(ESPEasySerialPort port, const int16_t serial_rx, const int16_t serial_tx, unsigned long baudrate,
@@ -50,6 +51,30 @@ void P087_data_struct::post_init() {
     capture_index_used[i] = false;
   }
   regex_empty = _lines[P087_REGEX_POS].isEmpty();
+
+  // Cache the settings used for every received sentence, so they are not parsed again per sentence.
+  filter_off_window_time = getFilterOffWindowTime();
+  regexp_match_length    = getRegExpMatchLength();
+  match_type             = getMatchType();
+  invert_match           = false;
+  global_match           = false;
+
+  switch (match_type) {
+    case Regular_Match:
+      break;
+    case Regular_Match_inverted:
+      invert_match = true;
+      break;
+    case Global_Match:
+      global_match = true;
+      break;
+    case Global_Match_inverted:
+      invert_match = true;
+      global_match = true;
+      break;
+    case Filter_Disabled:
+      break;
+  }
   # ifndef BUILD_NO_DEBUG
   String log = F("P087_post_init:");
   # endif // ifndef BUILD_NO_DEBUG
@@ -107,8 +132,19 @@ void P087_data_struct::sendData(uint8_t *data, size_t size) {
   }
 }
 
+bool P087_data_struct::enableRxEvent(taskIndex_t taskIndex) {
+  # if FEATURE_SERIAL_RX_EVENT
+
+  if (isInitialized() && serialHelper_enableRxEvent(taskIndex, *easySerial)) {
+    rx_event_task = taskIndex;
+    return true;
+  }
+  # endif // if FEATURE_SERIAL_RX_EVENT
+  return false;
+}
+
 bool P087_data_struct::loop() {
-  if (!isInitialized()) {
+  if (!isInitialized() || !serialHelper_rxDataReady(rx_event_task, *easySerial)) {
     return false;
   }
   bool fullSentenceReceived = false;
@@ -118,7 +154,7 @@ bool P087_data_struct::loop() {
 
     while (available > 0 && !fullSentenceReceived) {
       // Look for end marker
-      char c = easySerial->read();
+      const uint8_t c = easySerial->read();
       --available;
 
       if (available == 0) {
@@ -128,43 +164,52 @@ bool P087_data_struct::loop() {
 
       switch (c) {
         case 13:
-        {
-          const size_t length = sentence_part.length();
-          bool valid          = length > 0;
-
-          for (size_t i = 0; i < length && valid; ++i) {
-            if ((sentence_part[i] > 127) || (sentence_part[i] < 32)) {
-              sentence_part = String();
-              ++sentences_received_error;
-              valid = false;
-            }
-          }
-
-          if (valid) {
-            fullSentenceReceived = true;
-            last_sentence        = sentence_part;
-            sentence_part        = String();
-          }
+          fullSentenceReceived = processSentence();
           break;
-        }
         case 10:
 
           // Ignore LF
           break;
         default:
-          sentence_part += c;
+
+          if ((c > 127) || (c < 32)) {
+            // Sentence will be rejected at the end marker, no need to store it.
+            rx_invalid = true;
+          } else if (!rx_invalid) {
+            rx_buffer[rx_length++] = c;
+
+            if (max_length_reached()) {
+              fullSentenceReceived = processSentence();
+            }
+          }
           break;
       }
-
-      if (max_length_reached()) { fullSentenceReceived = true; }
     }
   }
+  return fullSentenceReceived;
+}
 
-  if (fullSentenceReceived) {
+bool P087_data_struct::processSentence() {
+  bool accepted = false;
+
+  if (rx_invalid) {
+    ++sentences_received_error;
+  } else if (rx_length > 0) {
     ++sentences_received;
-    length_last_received = last_sentence.length();
+    length_last_received  = rx_length;
+    rx_buffer[rx_length] = 0;
+
+    // Only sentences passing the filter are copied into a String
+    if (matchAll(rx_buffer, rx_length)) {
+      last_sentence = rx_buffer;
+      accepted      = true;
+    } else {
+      ++sentences_rejected;
+    }
   }
-  return fullSentenceReceived;
+  rx_length  = 0;
+  rx_invalid = false;
+  return accepted;
 }
 
 bool P087_data_struct::getSentence(String& string) {
@@ -184,6 +229,9 @@ void P087_data_struct::getSentencesReceived(uint32_t& succes, uint32_t& error, u
 }
 
 void P087_data_struct::setMaxLength(uint16_t maxlenght) {
+  if ((maxlenght == 0) || (maxlenght > P087_RX_BUFFER_SIZE)) {
+    maxlenght = P087_RX_BUFFER_SIZE;
+  }
   max_length = maxlenght;
 }
 
@@ -210,31 +258,11 @@ P087_Match_Type P087_data_struct::getMatchType() const {
 }
 
 bool P087_data_struct::invertMatch() const {
-  switch (getMatchType()) {
-    case Regular_Match:          // fallthrough
-    case Global_Match:
-      break;
-    case Regular_Match_inverted: // fallthrough
-    case Global_Match_inverted:
-      return true;
-    case Filter_Disabled:
-      break;
-  }
-  return false;
+  return invert_match;
 }
 
 bool P087_data_struct::globalMatch() const {
-  switch (getMatchType()) {
-    case Regular_Match: // fallthrough
-    case Regular_Match_inverted:
-      break;
-    case Global_Match:  // fallthrough
-    case Global_Match_inverted:
-      return true;
-    case Filter_Disabled:
-      break;
-  }
-  return false;
+  return global_match;
 }
 
 String P087_data_struct::getFilter(uint8_t lineNr, uint8_t& capture, P087_Filter_Comp& comparator) const
@@ -249,11 +277,11 @@ String P087_data_struct::getFilter(uint8_t lineNr, uint8_t& capture, P087_Filter
 }
 
 void P087_data_struct::setDisableFilterWindowTimer() {
-  if (getFilterOffWindowTime() == 0) {
+  if (filter_off_window_time == 0) {
     disable_filter_window = 0;
   }
   else {
-    disable_filter_window = millis() + getFilterOffWindowTime();
+    disable_filter_window = millis() + filter_off_window_time;
   }
 }
 
@@ -267,8 +295,13 @@ bool P087_data_struct::disableFilterWindowActive() const {
   return false;
 }
 
-typedef std::pair<uint8_t, String> capture_tuple;
-static std::vector<capture_tuple> capture_vector;
+// Captures point into the receive buffer, so no String is needed to compare them with the filters.
+struct P087_capture_t {
+  const char *init;
+  int         len;
+  uint8_t     index;
+};
+static std::vector<P087_capture_t> capture_vector;
 
 
 // called for each match
@@ -276,79 +309,100 @@ void P087_data_struct::match_callback(const char *match, const unsigned int leng
 {
   for (uint8_t i = 0; i < ms.level; i++)
   {
-    capture_tuple tuple;
-    tuple.first  = i;
-    tuple.second = ms.GetCapture(i);
-    capture_vector.push_back(tuple);
+    // Position captures and unfinished captures have a negative length
+    if (ms.capture[i].len >= 0) {
+      P087_capture_t capture;
+      capture.init  = ms.capture[i].init;
+      capture.len   = ms.capture[i].len;
+      capture.index = i;
+      capture_vector.push_back(capture);
+    }
   } // end of for each capture
 }
 
-bool P087_data_struct::matchRegexp(String& received) const {
-  size_t strlength = received.length();
+bool P087_data_struct::matchAll(char *received, size_t strlength) const {
+  if (disableFilterWindowActive()) {
+    addLog(LOG_LEVEL_INFO, F("Serial Proxy: Disable Filter Window active"));
+    return true;
+  }
 
+  const bool res = matchRegexp(received, strlength);
+
+  if (invert_match) {
+    addLog(LOG_LEVEL_INFO, F("Serial Proxy: invert filter"));
+    return !res;
+  }
+  return res;
+}
+
+bool P087_data_struct::matchRegexp(char *received, size_t strlength) const {
   if (strlength == 0) {
     return false;
   }
 
-  if (regex_empty || (getMatchType() == Filter_Disabled)) {
+  if (regex_empty || (match_type == Filter_Disabled)) {
     return true;
   }
 
-
-  uint32_t regexp_match_length = getRegExpMatchLength();
-
   if ((regexp_match_length > 0) && (strlength > regexp_match_length)) {
     strlength = regexp_match_length;
   }
 
-  // We need to do a const_cast here, but this only is valid as long as we
-  // don't call a replace function from regexp.
-  MatchState ms(const_cast<char *>(received.c_str()), strlength);
+  // Only valid as long as we don't call a replace function from regexp.
+  MatchState ms(received, strlength);
 
   bool match_result = false;
 
-  if (globalMatch()) {
+  if (global_match) {
+    // Keeps its capacity, so no allocations after the first few sentences.
     capture_vector.clear();
     ms.GlobalMatch(_lines[P087_REGEX_POS].c_str(), match_callback);
-    const uint8_t vectorlength = capture_vector.size();
+    const size_t vectorlength = capture_vector.size();
 
-    for (uint8_t i = 0; i < vectorlength; ++i) {
-      if ((capture_vector[i].first < P87_MAX_CAPTURE_INDEX) && capture_index_used[capture_vector[i].first]) {
-        for (uint8_t n = 0; n < P087_NR_FILTERS; ++n) {
-          unsigned int lines_index = n * 3 + P087_FIRST_FILTER_POS + 2;
+    for (size_t i = 0; i < vectorlength; ++i) {
+      const P087_capture_t& capture = capture_vector[i];
 
-          if ((capture_index[n] == capture_vector[i].first) && !(_lines[lines_index].isEmpty())) {
-            String log;
-            log.reserve(32);
-            log  = F("P087: Index: ");
-            log += capture_vector[i].first;
-            log += F(" Found ");
-            log += capture_vector[i].second;
+      if ((capture.index < P87_MAX_CAPTURE_INDEX) && capture_index_used[capture.index]) {
+        for (uint8_t n = 0; n < P087_NR_FILTERS; ++n) {
+          const String& filter = _lines[n * 3 + P087_FIRST_FILTER_POS + 2];
 
+          if ((capture_index[n] == capture.index) && !filter.isEmpty()) {
             // Found a Capture Filter with this capture index.
-            if (capture_vector[i].second == _lines[lines_index]) {
-              log += F(" Matches");
-
-              // Found a match. Now check if it is supposed to be one or not.
-              if (capture_index_must_not_match[n]) {
-                log += F(" (!=)");
+            const bool matches = (filter.length() == static_cast<unsigned int>(capture.len)) &&
+                                 (strncmp(filter.c_str(), capture.init, capture.len) == 0);
+
+            if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+              String log;
+
+              if (log.reserve(48 + capture.len + filter.length())) {
+                log  = F("P087: Index: ");
+                log += capture.index;
+                log += F(" Found ");
+
+                for (int c = 0; c < capture.len; ++c) {
+                  log += capture.init[c];
+                }
+
+                if (matches) {
+                  log += F(" Matches");
+                  log += capture_index_must_not_match[n] ? F(" (!=)") : F(" (==)");
+                } else {
+                  log += F(" No Match");
+                  log += capture_index_must_not_match[n] ? F(" (!=) ") : F(" (==) ");
+                  log += filter;
+                }
                 addLogMove(LOG_LEVEL_INFO, log);
-                return false;
-              } else {
-                match_result = true;
-                log         += F(" (==)");
               }
-            } else {
-              log += F(" No Match");
+            }
 
+            if (matches) {
+              // Found a match. Now check if it is supposed to be one or not.
               if (capture_index_must_not_match[n]) {
-                log += F(" (!=) ");
-              } else {
-                log += F(" (==) ");
+                capture_vector.clear();
+                return false;
               }
-              log += _lines[lines_index];
+              match_result = true;
             }
-            addLogMove(LOG_LEVEL_INFO, log);
           }
         }
       }
@@ -387,8 +441,7 @@ const __FlashStringHelper * P087_data_struct::MatchType_toString(P087_Match_Type
 }
 
 bool P087_data_struct::max_length_reached() const {
-  if (max_length == 0) { return false; }
-  return sentence_part.length() >= max_length;
+  return rx_length >= max_length;
 }
 
 #endif // USES_P087
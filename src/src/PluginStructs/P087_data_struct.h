@@ -21,6 +21,9 @@
 # define P87_Nchars              128
 # define P87_MAX_CAPTURE_INDEX   32
 
+// Max. sentence length, longer sentences are processed in chunks of this size
+# define P087_RX_BUFFER_SIZE     550
+
 
 enum P087_Filter_Comp {
   Equal    = 0,
@@ -54,14 +57,22 @@ public:
 
   // Called after loading the config from the settings.
   // Will interpret some data and load caches.
+  // Must be called again when the settings in _lines have changed.
   void post_init();
 
   bool isInitialized() const;
 
+  // Only read the serial port when woken via PLUGIN_TASKTIMER_IN, when supported by the port.
+  bool enableRxEvent(taskIndex_t taskIndex);
+
   void sendString(const String& data);
   void sendData(uint8_t *data,
                 size_t   size);
 
+  // Collect received characters in the receive buffer.
+  // Each complete sentence is checked against the regex and capture filters,
+  // only an accepted sentence is copied to be fetched with getSentence().
+  // @retval true when a sentence was accepted.
   bool loop();
 
   // Get the received sentence
@@ -72,6 +83,10 @@ public:
                             uint32_t& error,
                             uint32_t& length_last) const;
 
+  uint32_t getSentencesRejected() const {
+    return sentences_rejected;
+  }
+
   void            setMaxLength(uint16_t maxlenght);
 
   void            setLine(uint8_t       varNr,
@@ -102,7 +117,13 @@ public:
                              const unsigned int length,
                              const MatchState & ms);
 
-  bool                              matchRegexp(String& received) const;
+  // Match the sentence with the regex and capture filters, ignoring the invert setting.
+  bool                              matchRegexp(char  *received,
+                                                size_t strlength) const;
+
+  // Apply the filter window, regex, capture filters and invert setting.
+  bool                              matchAll(char  *received,
+                                             size_t strlength) const;
 
   static const __FlashStringHelper* MatchType_toString(P087_Match_Type matchType);
 
@@ -114,15 +135,30 @@ private:
 
   bool max_length_reached() const;
 
+  // Process the sentence in the receive buffer and clear the buffer.
+  // @retval true when the sentence was accepted.
+  bool processSentence();
+
   ESPeasySerial *easySerial = nullptr;
-  String         sentence_part;
+  taskIndex_t    rx_event_task = INVALID_TASK_INDEX;
   String         last_sentence;
-  uint16_t       max_length               = 550;
+  char           rx_buffer[P087_RX_BUFFER_SIZE + 1] = { 0 };
+  uint16_t       rx_length                = 0;
+  bool           rx_invalid               = false;
+  uint16_t       max_length               = P087_RX_BUFFER_SIZE;
   uint32_t       sentences_received       = 0;
   uint32_t       sentences_received_error = 0;
+  uint32_t       sentences_rejected       = 0;
   uint32_t       length_last_received     = 0;
   unsigned long  disable_filter_window    = 0;
 
+  // Cached settings, set in post_init()
+  uint32_t        filter_off_window_time = 0;
+  uint16_t        regexp_match_length    = 0;
+  P087_Match_Type match_type             = P087_Match_Type::Filter_Disabled;
+  bool            invert_match           = false;
+  bool            global_match           = false;
+
   uint8_t capture_index[P87_MAX_CAPTURE_INDEX] = { 0 };
 
   bool capture_index_used[P87_MAX_CAPTURE_INDEX]           = { 0 };
@@ -3,10 +3,16 @@
 #if defined(USES_P089) && defined(ESP8266)
 
 
+#include "../Globals/EventQueue.h"
+
+#include "../Helpers/ESPEasy_time_calc.h"
 #include "../Helpers/Networking.h"
+#include "../Helpers/StringConverter.h"
 
 #include "../Helpers/_Plugin_init.h"
 
+// All tasks share a single raw ICMP socket
+struct P089_icmp_pcb *P089_data_struct::P089_data = nullptr;
 
 P089_data_struct::P089_data_struct() {
   destIPAddress.addr = 0;
@@ -63,12 +69,27 @@ bool P089_data_struct::send_ping(struct EventStruct *event) {
 
   /* Generate random ID & seq */
   idseq = HwRandom();
+
+  /* Lost for sure, TODO: Might be good to log such failures, this means we are short on ram? */
+  if (!sendEchoRequest(destIPAddress,
+                       (uint16_t)((idseq & 0xffff0000) >> 16),
+                       (uint16_t)(idseq & 0xffff))) {
+    return true;
+  }
+
+  return is_failure;
+}
+
+bool P089_data_struct::sendEchoRequest(const ip_addr_t& ip, uint16_t id, uint16_t seqno)
+{
+  if ((P089_data == nullptr) || (P089_data->m_IcmpPCB == nullptr)) {
+    return false;
+  }
   u16_t ping_len            = ICMP_PAYLOAD_LEN + sizeof(struct icmp_echo_hdr);
   struct pbuf *packetBuffer = pbuf_alloc(PBUF_IP, ping_len, PBUF_RAM);
 
-  /* Lost for sure, TODO: Might be good to log such failures, this means we are short on ram? */
   if (packetBuffer == nullptr) {
-    return true;
+    return false;
   }
 
   struct icmp_echo_hdr *echoRequestHeader = (struct icmp_echo_hdr *)packetBuffer->payload;
@@ -76,8 +97,8 @@ bool P089_data_struct::send_ping(struct EventStruct *event) {
   ICMPH_TYPE_SET(echoRequestHeader, ICMP_ECHO);
   ICMPH_CODE_SET(echoRequestHeader, 0);
   echoRequestHeader->chksum = 0;
-  echoRequestHeader->id     = (uint16_t)((idseq & 0xffff0000) >> 16);
-  echoRequestHeader->seqno  = (uint16_t)(idseq & 0xffff);
+  echoRequestHeader->id     = id;
+  echoRequestHeader->seqno  = seqno;
   size_t icmpHeaderLen = sizeof(struct icmp_echo_hdr);
   size_t icmpDataLen   = ping_len - icmpHeaderLen;
   char   dataByte      = 0x61;
@@ -92,14 +113,160 @@ bool P089_data_struct::send_ping(struct EventStruct *event) {
     }
   }
   echoRequestHeader->chksum = inet_chksum(echoRequestHeader, ping_len);
-  ip_addr_t destIPAddress;
 
-  destIPAddress.addr = ip;
-  raw_sendto(P089_data->m_IcmpPCB, packetBuffer, &destIPAddress);
+  const err_t err = raw_sendto(P089_data->m_IcmpPCB, packetBuffer, &ip);
 
   pbuf_free(packetBuffer);
 
-  return is_failure;
+  return err == ERR_OK;
+}
+
+void P089_data_struct::loadHosts(taskIndex_t taskIndex)
+{
+  String strings[P089_MAX_HOSTS];
+
+  LoadCustomTaskSettings(taskIndex, strings, P089_MAX_HOSTS, P089_HOST_SIZE, P089_HOSTS_OFFSET);
+
+  _hosts.clear();
+
+  for (uint8_t i = 0; i < P089_MAX_HOSTS; ++i) {
+    strings[i].trim();
+
+    if (!strings[i].isEmpty()) {
+      P089_host host;
+      host.hostname = std::move(strings[i]);
+      _hosts.push_back(std::move(host));
+    }
+  }
+  _hostsLoaded = true;
+}
+
+bool P089_data_struct::send_pings(struct EventStruct *event)
+{
+  if (!_hostsLoaded) {
+    loadHosts(event->TaskIndex);
+
+    // One ICMP id per task, the sequence number holds the host index and round
+    _id = HwRandom() & 0xffff;
+  }
+
+  if (_roundActive) {
+    // Previous round not yet finished, its missing replies are lost
+    finishRound(event);
+  }
+
+  if (_hosts.empty() || !NetworkConnected()) {
+    return false;
+  }
+
+  ++_round;
+  _roundStart  = millis();
+  _roundActive = true;
+
+  for (size_t i = 0; i < _hosts.size(); ++i) {
+    P089_host& host = _hosts[i];
+
+    if (host.ip.addr == 0) {
+      // IP-addresses are parsed without DNS lookup, hostnames use the DNS cache when present.
+      IPAddress ip;
+
+      if (!ip.fromString(host.hostname) && !resolveHostByName(host.hostname.c_str(), ip)) {
+        ip = IPAddress();
+      }
+      host.ip.addr = ip;
+    }
+    host.rtt = -1;
+    ++host.nrSent;
+    host.sendMoment = millis();
+    host.pending    = (host.ip.addr != 0) &&
+                      sendEchoRequest(host.ip, _id, static_cast<uint16_t>((i << 8) | _round));
+  }
+  return true;
+}
+
+bool P089_data_struct::roundCompleted(struct EventStruct *event) const
+{
+  if (!_roundActive) {
+    return false;
+  }
+
+  const uint32_t timeout = (P089_TIMEOUT > 0) ? P089_TIMEOUT : P089_DEFAULT_TIMEOUT;
+
+  if (timePassedSince(_roundStart) >= static_cast<long>(timeout)) {
+    return true;
+  }
+
+  for (auto it = _hosts.begin(); it != _hosts.end(); ++it) {
+    if (it->pending) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void P089_data_struct::finishRound(struct EventStruct *event)
+{
+  _roundActive = false;
+
+  uint32_t nrDown   = 0;
+  uint32_t nrUp     = 0;
+  uint32_t rttTotal = 0;
+
+  for (size_t i = 0; i < _hosts.size(); ++i) {
+    P089_host& host = _hosts[i];
+    host.pending = false;
+
+    if (host.rtt < 0) {
+      ++nrDown;
+
+      // Try to resolve the hostname again next round, it may have a new IP-address.
+      host.ip.addr = 0;
+    } else {
+      ++nrUp;
+      rttTotal += host.rtt;
+    }
+
+    if (P089_SEND_EVENTS && Settings.UseRules) {
+      // Event: <taskname>#Host<n>=<rtt msec, -1 = no reply>,<loss percentage>
+      const uint32_t lossPct = (host.nrSent == 0) ? 0 : (100 * (host.nrSent - host.nrReceived)) / host.nrSent;
+      eventQueue.add(event->TaskIndex,
+                     concat(F("Host"), i + 1),
+                     strformat(F("%d,%u"), static_cast<int>(host.rtt), static_cast<unsigned int>(lossPct)));
+    }
+  }
+
+  UserVar.setFloat(event->TaskIndex, 0, nrDown);
+  UserVar.setFloat(event->TaskIndex, 1, nrUp);
+  UserVar.setFloat(event->TaskIndex, 2, (nrUp == 0) ? -1 : static_cast<float>(rttTotal) / nrUp);
+}
+
+bool P089_data_struct::receivedReply(taskIndex_t taskIndex, uint16_t id, uint16_t seqno)
+{
+  if (!_hostsLoaded) {
+    // Single host mode
+    if ((id == (uint16_t)((idseq & 0xffff0000) >> 16)) &&
+        (seqno == (uint16_t)(idseq & 0xffff))) {
+      UserVar[taskIndex * VARS_PER_TASK] = 0; // Reset "fails", we got reply
+      idseq                              = 0;
+      destIPAddress.addr                 = 0;
+      return true;
+    }
+    return false;
+  }
+
+  const size_t hostIndex = seqno >> 8;
+
+  if ((id != _id) || ((seqno & 0xff) != _round) || (hostIndex >= _hosts.size())) {
+    return false;
+  }
+  P089_host& host = _hosts[hostIndex];
+
+  if (host.pending) {
+    host.pending = false;
+    host.rtt     = timePassedSince(host.sendMoment);
+    ++host.nrReceived;
+  }
+  return true;
 }
 
 uint8_t PingReceiver(void *origin, struct raw_pcb *pcb, struct pbuf *packetBuffer, const ip_addr_t *addr)
@@ -139,12 +306,8 @@ uint8_t PingReceiver(void *origin, struct raw_pcb *pcb, struct pbuf *packetBuffe
     if (getPluginID_from_DeviceIndex(deviceIndex) == PLUGIN_ID_P089_PING) {
       P089_data_struct *P089_taskdata = static_cast<P089_data_struct *>(getPluginTaskData(index));
 
-      if ((P089_taskdata != nullptr) && (icmp_hdr->id == (uint16_t)((P089_taskdata->idseq & 0xffff0000) >> 16)) &&
-          (icmp_hdr->seqno == (uint16_t)(P089_taskdata->idseq & 0xffff))) {
-        UserVar[index * VARS_PER_TASK]    = 0; // Reset "fails", we got reply
-        P089_taskdata->idseq              = 0;
-        P089_taskdata->destIPAddress.addr = 0;
-        is_found                          = true;
+      if ((P089_taskdata != nullptr) && P089_taskdata->receivedReply(index, icmp_hdr->id, icmp_hdr->seqno)) {
+        is_found = true;
       }
     }
   }
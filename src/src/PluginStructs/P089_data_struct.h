@@ -12,6 +12,20 @@
 
 # define ICMP_PAYLOAD_LEN          32
 
+# define P089_MODE                 PCONFIG(0)
+# define P089_SEND_EVENTS          PCONFIG(1)
+# define P089_TIMEOUT              PCONFIG(2)
+
+# define P089_MODE_SINGLE          0 // Single host, count the consecutive fails
+# define P089_MODE_MULTI           1 // Host list, all pinged at once
+
+// Host list is stored after the single hostname in the custom task settings
+# define P089_MAX_HOSTS            16
+# define P089_HOST_SIZE            48
+# define P089_HOSTS_OFFSET         PLUGIN_089_HOSTNAME_SIZE
+
+# define P089_DEFAULT_TIMEOUT      1000 // msec
+
 extern "C"
 {
 # include <lwip/raw.h>
@@ -30,6 +44,17 @@ struct P089_icmp_pcb {
   uint8_t         instances = 1; /* Sort of refcount */
 };
 
+// State of a single host in the host list
+struct P089_host {
+  String    hostname;
+  ip_addr_t ip{};
+  uint32_t  sendMoment = 0;  // millis() when the last echo request was sent
+  int32_t   rtt        = -1; // msec, -1 = no reply on the last echo request
+  uint32_t  nrSent     = 0;
+  uint32_t  nrReceived = 0;
+  bool      pending    = false;
+};
+
 class P089_data_struct : public PluginTaskData_base {
 public:
 
@@ -39,9 +64,38 @@ public:
 
   bool send_ping(struct EventStruct *event);
 
-  struct P089_icmp_pcb *P089_data = nullptr;
+  // Host list mode: send an echo request to all hosts, without waiting for the replies.
+  bool send_pings(struct EventStruct *event);
+
+  // Host list mode: all replies received, or timeout passed.
+  bool roundCompleted(struct EventStruct *event) const;
+
+  // Host list mode: set the task values and send the events for the completed round.
+  void finishRound(struct EventStruct *event);
+
+  // Called from the ICMP receive callback, return true when the reply was for this task.
+  bool receivedReply(taskIndex_t taskIndex,
+                     uint16_t    id,
+                     uint16_t    seqno);
+
+  static struct P089_icmp_pcb *P089_data;
   ip_addr_t destIPAddress;
   uint32_t idseq;
+
+private:
+
+  static bool sendEchoRequest(const ip_addr_t& ip,
+                              uint16_t         id,
+                              uint16_t         seqno);
+
+  void        loadHosts(taskIndex_t taskIndex);
+
+  std::vector<P089_host> _hosts;
+  uint32_t               _roundStart  = 0;
+  uint16_t               _id          = 0;
+  uint8_t                _round       = 0;
+  bool                   _roundActive = false;
+  bool                   _hostsLoaded = false;
 };
 
 // Callback function
@@ -9,6 +9,10 @@
 
 // #define DLbus_DEBUG
 
+# if P092_FEATURE_RMT
+#  include <driver/rmt.h>
+# endif // if P092_FEATURE_RMT
+
 // Flags for pulse width (bit 0 is the content!)
 # define DLbus_FlagSingleWidth                 0x02
 # define DLbus_FlagDoubleWidth                 0x04
@@ -20,15 +24,13 @@
                                                 DLbus_FlagBetweenDoubleSingleWidth | DLbus_FlagShorterThanSingleWidth)
 
 // Helper for ISR call
-DLBus *DLBus::__instance                         = nullptr;
-volatile  static uint8_t *ISR_PtrChangeBitStream = nullptr; // pointer to received bit change stream
+DLBus *DLBus::__instance = nullptr;
 
 DLBus::DLBus()
 {
   if (__instance == nullptr)
   {
-    __instance             = this;
-    ISR_PtrChangeBitStream = DLbus_ChangeBitStream;
+    __instance = this;
 # ifndef P092_LIMIT_BUILD_SIZE
     addLog(LOG_LEVEL_INFO, F("Class DLBus created"));
 #endif // ifndef P092_LIMIT_BUILD_SIZE
@@ -37,10 +39,11 @@ DLBus::DLBus()
 
 DLBus::~DLBus()
 {
+  detachDLBusInterrupt();
+
   if (__instance == this)
   {
-    __instance             = nullptr;
-    ISR_PtrChangeBitStream = nullptr;
+    __instance = nullptr;
 # ifndef P092_LIMIT_BUILD_SIZE
     addLog(LOG_LEVEL_INFO, F("Class DLBus destroyed"));
 #endif // ifndef P092_LIMIT_BUILD_SIZE
@@ -68,16 +71,62 @@ void DLBus::attachDLBusInterrupt(void)
   ISR_Receiving = false;
   IsISRset      = true;
   IsNoData      = false;
+# if P092_FEATURE_RMT
+
+  if (attachRMT()) {
+    return;
+  }
+# endif // if P092_FEATURE_RMT
   attachInterrupt(digitalPinToInterrupt(ISR_DLB_Pin), ISR, CHANGE);
 }
 
+void DLBus::detachDLBusInterrupt(void)
+{
+  if (!IsISRset) {
+    return;
+  }
+  IsISRset      = false;
+  ISR_Receiving = false;
+# if P092_FEATURE_RMT
+
+  if (UseRMT) {
+    rmt_rx_stop(P092_RMT_RX_CHANNEL);
+    rmt_driver_uninstall(P092_RMT_RX_CHANNEL);
+    RMT_ringbuffer = nullptr;
+    UseRMT         = false;
+    return;
+  }
+# endif // if P092_FEATURE_RMT
+  detachInterrupt(digitalPinToInterrupt(ISR_DLB_Pin));
+}
+
 void DLBus::StartReceiving(void)
 {
+  ReceiveStart     = millis();
+  ReceivedEdges    = 0;
+  StoredPulses     = 0;
+  DecodedPulses    = 0;
+  BitNumber        = 0;
+  SyncOnes         = 0;
+  SyncZeros        = 0;
+  StartBit         = -1;
+  StartBitInverted = -1;
+  PrevPulse        = 0;
+  WrongTimeCnt     = 0;
+  FrameComplete    = false;
+  FrameTimingOK    = false;
+# if P092_FEATURE_RMT
+
+  if (UseRMT) {
+    // RX stops at the sync, when the line does not change for more than 2 double pulse widths. 2 usec per tick.
+    rmt_set_rx_idle_thresh(P092_RMT_RX_CHANNEL, std::min(MinDoublePulseWidth, static_cast<uint16_t>(32767)));
+  }
+# endif // if P092_FEATURE_RMT
+
   ISR_noInterrupts(); // make sure we don't get interrupted before we are ready
-  ISR_PulseCount      = 0;
-  ISR_Receiving       = (ISR_PtrChangeBitStream != nullptr);
-  ISR_AllBitsReceived = false;
-  ISR_interrupts(); // interrupts allowed now, next instruction WILL be executed
+  EdgeTail      = ISR_EdgeHead; // drop edges received before
+  ISR_Receiving = true;
+  ISR_interrupts();   // interrupts allowed now, next instruction WILL be executed
 }
 
 void IRAM_ATTR DLBus::ISR(void)
@@ -90,203 +139,259 @@ void IRAM_ATTR DLBus::ISR(void)
 
 void IRAM_ATTR DLBus::ISR_PinChanged(void)
 {
-  //  long TimeDiff = usecPassedSince(ISR_TimeLastBitChange); // time difference to previous pulse in Âµs
   uint32_t _now     = micros();
-  int32_t  TimeDiff = (int32_t)(_now - ISR_TimeLastBitChange);
+  uint32_t TimeDiff = _now - ISR_TimeLastBitChange; // time difference to previous pulse in µs
 
-  //  ISR_TimeLastBitChange = micros();                           // save last pin change time
-  ISR_TimeLastBitChange = _now;             // save last pin change time
+  ISR_TimeLastBitChange = _now;                     // save last pin change time
 
   if (ISR_Receiving) {
-    uint8_t val = digitalRead(ISR_DLB_Pin); // read state
-
-    // check pulse width
-    if (TimeDiff >= 2 * ISR_MinDoublePulseWidth) {
-      val |= DLbus_FlagLongerThanTwiceDoubleWidth; // longer then 2x double pulse width
-    }
-    else if (TimeDiff > ISR_MaxDoublePulseWidth) {
-      val |= DLbus_FlagLongerThanDoubleWidth;      // longer then double pulse width
-    }
-    else if (TimeDiff >= ISR_MinDoublePulseWidth) {
-      val |= DLbus_FlagDoubleWidth;                // double pulse width
-    }
-    else if (TimeDiff > ISR_MaxPulseWidth) {
-      val |= DLbus_FlagBetweenDoubleSingleWidth;   // between double and single pulse width
-    }
-    else if (TimeDiff < ISR_MinPulseWidth) {
-      val |= DLbus_FlagShorterThanSingleWidth;     // shorter then single pulse width
-    }
-    else {
-      val |= DLbus_FlagSingleWidth;                // single pulse width
-    }
+    const uint16_t head = ISR_EdgeHead;
+    const uint16_t next = (head + 1) & (DLbus_EdgeBufferSize - 1);
 
-    if (ISR_PulseCount < 2) {
-      // check if sync is received
-      if (val & DLbus_FlagLongerThanTwiceDoubleWidth) {
-        // sync received
-        *ISR_PtrChangeBitStream       = !(val & 0x01);
-        *(ISR_PtrChangeBitStream + 1) = val;
-        ISR_PulseCount                = 2;
-      }
-      else {
-        ISR_PulseCount = 1; // flag that interrupt is receiving
+    if (next != EdgeTail) {
+      // Edge is dropped when the buffer is full, the decoder will see a wrong timing
+      if (TimeDiff > 0x7FFFFFFF) {
+        TimeDiff = 0x7FFFFFFF;
       }
+      ISR_EdgeBuffer[head] = (TimeDiff << 1) | (digitalRead(ISR_DLB_Pin) & 0x01);
+      ISR_EdgeHead         = next;
     }
-    else {
-      *(ISR_PtrChangeBitStream + ISR_PulseCount) = val;         // set bit
-      ISR_PulseCount++;
-      ISR_Receiving       = (ISR_PulseCount < ISR_PulseNumber); // stop P092_receiving when data frame is complete
-      ISR_AllBitsReceived = !ISR_Receiving;
-    }
   }
 }
 
-boolean DLBus::CheckTimings(void) {
-  uint8_t rawval, val;
-  uint8_t WrongTimeCnt = 0;
-  int     i;
+void DLBus::ProcessEdges(void)
+{
+  if (!ISR_Receiving) {
+    return;
+  }
+# if P092_FEATURE_RMT
+
+  if (UseRMT) {
+    ProcessRMTItems();
+  }
+# endif // if P092_FEATURE_RMT
+
+  uint16_t tail = EdgeTail;
+
+  while (ISR_Receiving && (tail != ISR_EdgeHead)) {
+    const uint32_t edge = ISR_EdgeBuffer[tail];
+    tail     = (tail + 1) & (DLbus_EdgeBufferSize - 1);
+    EdgeTail = tail;
+    DecodeEdge(edge >> 1, edge & 0x01);
+  }
+
+  if (ISR_Receiving && (ReceivedEdges == 0) && (timePassedSince(ReceiveStart) >= 100)) {
+    // nothing received (timeout 100ms)
+    ISR_Receiving = false;
+    IsNoData      = true; // stop receiving until next PLUGIN_092_READ
+    AddToErrorLog(F("## StartReceiving: Error: Nothing received! No DL bus connected!"));
+  }
+}
+
+# if P092_FEATURE_RMT
+boolean DLBus::attachRMT(void)
+{
+  rmt_config_t rx_config{};
 
-# ifdef DLbus_DEBUG
-  uint16_t WrongTimingArray[5][6];
-# endif // DLbus_DEBUG
+  rx_config.rmt_mode                      = RMT_MODE_RX;
+  rx_config.channel                       = P092_RMT_RX_CHANNEL;
+  rx_config.gpio_num                      = static_cast<gpio_num_t>(ISR_DLB_Pin);
+  rx_config.clk_div                       = 160; // 80 MHz APB clock => 2 usec per tick
+  rx_config.mem_block_num                 = 1;
+  rx_config.rx_config.filter_en           = true;
+  rx_config.rx_config.filter_ticks_thresh = 255;
+  rx_config.rx_config.idle_threshold      = 32767;
 
-  //  AddToInfoLog(F("Receive stopped."));
+  RingbufHandle_t ringbuffer = nullptr;
 
-  ISR_PulseCount = 0;
+  if ((rmt_config(&rx_config) != ESP_OK) ||
+      (rmt_driver_install(rx_config.channel, 4096, 0) != ESP_OK)) {
+    return false;
+  }
 
-  for (i = 0; i <= ISR_PulseNumber; i++) {
-    // store DLbus_ChangeBitStream into ByteStream
-    rawval = *(ISR_PtrChangeBitStream + i);
+  if ((rmt_get_ringbuf_handle(rx_config.channel, &ringbuffer) != ESP_OK) ||
+      (rmt_rx_start(rx_config.channel, true) != ESP_OK)) {
+    rmt_driver_uninstall(rx_config.channel);
+    return false;
+  }
+  RMT_ringbuffer = ringbuffer;
+  UseRMT         = true;
+  return true;
+}
 
-    if (rawval & DLbus_FlagsWrongTiming) {
-      // wrong DLbus_time_diff
-      if (ISR_PulseCount > 0) {
-# ifdef DLbus_DEBUG
-        WrongTimingArray[WrongTimeCnt][0] = i;
-        WrongTimingArray[WrongTimeCnt][1] = ISR_PulseCount;
-        WrongTimingArray[WrongTimeCnt][2] = BitNumber;
-        WrongTimingArray[WrongTimeCnt][3] = rawval;
-# endif // DLbus_DEBUG
+// Every RMT capture ends at a sync, the level of the sync is the level of the first edge of the next capture.
+void DLBus::ProcessRMTItems(void)
+{
+  size_t rx_size         = 0;
+  rmt_item32_t *rx_items = nullptr;
 
-        if ((rawval == DLbus_FlagLongerThanTwiceDoubleWidth) && (*(ISR_PtrChangeBitStream + i - 1) == (DLbus_FlagDoubleWidth | 0x01))) {
-          // Add two additional short pulses (low and high), previous bit is High and contains DLbus_FlagDoubleWidth
-          ProcessBit(0);
-          ProcessBit(1);
-# ifdef DLbus_DEBUG
-          WrongTimingArray[WrongTimeCnt][4] = DLbus_FlagSingleWidth;
-          WrongTimingArray[WrongTimeCnt][5] = DLbus_FlagSingleWidth + 1;
-# endif // DLbus_DEBUG
-        }
-# ifdef DLbus_DEBUG
-        else {
-          WrongTimingArray[WrongTimeCnt][4] = 0xff;
-          WrongTimingArray[WrongTimeCnt][5] = 0xff;
-        }
-# endif // DLbus_DEBUG
-        WrongTimeCnt++;
+  while (ISR_Receiving &&
+         (rx_items = static_cast<rmt_item32_t *>(xRingbufferReceive(static_cast<RingbufHandle_t>(RMT_ringbuffer), &rx_size, 0))) != nullptr) {
+    const size_t nrItems = rx_size / sizeof(rmt_item32_t);
 
-        if (WrongTimeCnt >= 5) {
-          return false;
-        }
-      }
+    if (nrItems > 0) {
+      // The edge after the sync
+      DecodeEdge(2 * MinDoublePulseWidth, rx_items[0].level0);
     }
-    else {
-      val = rawval & 0x01;
 
-      if ((rawval & DLbus_FlagDoubleWidth) == DLbus_FlagDoubleWidth) {
-        // double pulse width
-        ProcessBit(!val);
-        ProcessBit(val);
-      }
-      else {
-        // single pulse width
-        ProcessBit(val);
-      }
+    for (size_t i = 0; i < nrItems && ISR_Receiving; ++i) {
+      if (rx_items[i].duration0 == 0) { break; }
+      DecodeEdge(rx_items[i].duration0 * 2, !rx_items[i].level0);
+
+      if (rx_items[i].duration1 == 0) { break; }
+      DecodeEdge(rx_items[i].duration1 * 2, !rx_items[i].level1);
     }
+    vRingbufferReturnItem(static_cast<RingbufHandle_t>(RMT_ringbuffer), rx_items);
   }
+}
+
+# endif // if P092_FEATURE_RMT
 
-  //  AddToInfoLog(F("DLbus_ChangeBitStream copied."));
+void DLBus::DecodeEdge(uint32_t TimeDiff, uint8_t PinState)
+{
+  uint8_t val = PinState;
+
+  ++ReceivedEdges;
 
+  // check pulse width
+  if (TimeDiff >= 2u * MinDoublePulseWidth) {
+    val |= DLbus_FlagLongerThanTwiceDoubleWidth; // longer then 2x double pulse width
+  }
+  else if (TimeDiff > MaxDoublePulseWidth) {
+    val |= DLbus_FlagLongerThanDoubleWidth;      // longer then double pulse width
+  }
+  else if (TimeDiff >= MinDoublePulseWidth) {
+    val |= DLbus_FlagDoubleWidth;                // double pulse width
+  }
+  else if (TimeDiff > MaxPulseWidth) {
+    val |= DLbus_FlagBetweenDoubleSingleWidth;   // between double and single pulse width
+  }
+  else if (TimeDiff < MinPulseWidth) {
+    val |= DLbus_FlagShorterThanSingleWidth;     // shorter then single pulse width
+  }
+  else {
+    val |= DLbus_FlagSingleWidth;                // single pulse width
+  }
+
+  if (StoredPulses < 2) {
+    // check if sync is received
+    if (val & DLbus_FlagLongerThanTwiceDoubleWidth) {
+      // sync received
+      DecodePulse(!(val & 0x01));
+      DecodePulse(val);
+      StoredPulses = 2;
+    }
+    return;
+  }
+  DecodePulse(val);
+  StoredPulses++;
+
+  if (StoredPulses >= PulseNumber) {
+    // stop receiving when data frame is complete
+    ISR_Receiving = false;
+    FrameComplete = true;
+    FrameTimingOK = true;
+  }
+}
+
+void DLBus::DecodePulse(uint8_t rawval)
+{
+  if (rawval & DLbus_FlagsWrongTiming) {
+    // wrong DLbus_time_diff
+    if (DecodedPulses > 0) {
 # ifdef DLbus_DEBUG
+      if (IsLogLevelInfo) {
+        AddToInfoLog(strformat(
+          F("Wrong Timing %d: PulseCount:%d BitCount:%d Value:0x%x ValueBefore:0x%x"),
+          WrongTimeCnt + 1,
+          DecodedPulses,
+          BitNumber,
+          rawval,
+          PrevPulse));
+      }
+# endif // DLbus_DEBUG
 
-  if (WrongTimeCnt > 0) {
-    if (IsLogLevelInfo) {
-      String log = F("Wrong Timings: ");
-      AddToInfoLog(log);
-
-      for (i = 0; i < WrongTimeCnt; i++) {
-        log  = i + 1;
-        log += F(": PulseCount:");
-        log += WrongTimingArray[i][1];
-        log += F(": BitCount:");
-        log += WrongTimingArray[i][2];
-        log += F(" Value:0x");
-        log += String(WrongTimingArray[i][3], HEX);
-        log += F(" ValueBefore:0x");
-        log += String(*(ISR_PtrChangeBitStream + WrongTimingArray[i][0] - 1), HEX);
-        log += F(" ValueAfter:0x");
-        log += String(*(ISR_PtrChangeBitStream + WrongTimingArray[i][0] + 1), HEX);
-
-        if (WrongTimingArray[i][4] != 0xff) {
-          log += F(" Added:0x");
-          log += String(WrongTimingArray[i][4], HEX);
-        }
-
-        if (WrongTimingArray[i][5] != 0xff) {
-          log += F(" Added:0x");
-          log += String(WrongTimingArray[i][5], HEX);
-        }
-        AddToInfoLog(log);
+      if ((rawval == DLbus_FlagLongerThanTwiceDoubleWidth) && (PrevPulse == (DLbus_FlagDoubleWidth | 0x01))) {
+        // Add two additional short pulses (low and high), previous bit is High and contains DLbus_FlagDoubleWidth
+        ProcessBit(0);
+        ProcessBit(1);
+      }
+      WrongTimeCnt++;
+
+      if (WrongTimeCnt >= 5) {
+        // too many wrong timings, stop receiving
+        ISR_Receiving = false;
+        FrameComplete = true;
+        FrameTimingOK = false;
       }
     }
   }
-# endif // DLbus_DEBUG
-  return true;
+  else {
+    const uint8_t val = rawval & 0x01;
+
+    if ((rawval & DLbus_FlagDoubleWidth) == DLbus_FlagDoubleWidth) {
+      // double pulse width
+      ProcessBit(!val);
+      ProcessBit(val);
+    }
+    else {
+      // single pulse width
+      ProcessBit(val);
+    }
+  }
+  PrevPulse = rawval;
 }
 
 void DLBus::ProcessBit(uint8_t b) {
   // ignore first pulse
-  ISR_PulseCount++;
+  DecodedPulses++;
 
-  if (ISR_PulseCount % 2) {
+  if (DecodedPulses % 2) {
     return;
   }
-  BitNumber = (ISR_PulseCount / 2);
 
+  if ((DecodedPulses / 2) >= (8 * sizeof(BitStream))) {
+    return;
+  }
+  BitNumber = (DecodedPulses / 2);
+  WriteBit(BitNumber, b);
+
+  // find SYNC (16 * sequential 1) followed by the first 0, or the same for an inverted signal
   if (b) {
-    ByteStream[BitNumber / 8] |= (1 << (BitNumber % 8));  // set bit
+    if ((SyncZeros >= DLBus_SyncBits) && (StartBitInverted == -1)) {
+      StartBitInverted = BitNumber;
+    }
+    SyncZeros = 0;
+    SyncOnes++;
   }
   else {
-    ByteStream[BitNumber / 8] &= ~(1 << (BitNumber % 8)); // clear bit
+    if ((SyncOnes >= DLBus_SyncBits) && (StartBit == -1)) {
+      StartBit = BitNumber; // beginning of data frame
+    }
+    SyncOnes = 0;
+    SyncZeros++;
   }
 }
 
 boolean DLBus::Processing(void) {
-  boolean inverted = false;
-  int16_t StartBit; // first bit of data frame (-1 not recognized)
+  int16_t FrameStartBit = StartBit; // first bit of data frame (-1 not recognized)
 
 # ifndef P092_LIMIT_BUILD_SIZE
   AddToInfoLog(F("Processing..."));
 #endif // ifndef P092_LIMIT_BUILD_SIZE
-  StartBit = Analyze(); // find the data frame's beginning
 
   // inverted signal?
-  while (StartBit == -1) {
-    if (inverted) {
-      AddToErrorLog(F("Error: Already inverted!"));
-      return false;
-    }
-    Invert(); // invert again
-    inverted = true;
-    StartBit = Analyze();
+  if (FrameStartBit == -1) {
+    Invert();
+    FrameStartBit = StartBitInverted;
 
-    if (StartBit == -1) {
+    if (FrameStartBit == -1) {
       AddToErrorLog(F("Error: No data frame available!"));
       return false;
     }
-    uint16_t RequiredBitStreamLength = (ISR_PulseNumber - DLBus_ReserveBytes) / DLBus_BitChangeFactor;
+    uint16_t RequiredBitStreamLength = (PulseNumber - DLBus_ReserveBytes) / DLBus_BitChangeFactor;
 
-    if ((BitNumber - StartBit) < RequiredBitStreamLength) {
+    if ((BitNumber - FrameStartBit) < RequiredBitStreamLength) {
       // no complete data frame available (difference between start_bit and received bits is < RequiredBitStreamLength)
       AddToErrorLog(F("Start bit too close to end of stream!"));
 
@@ -295,7 +400,7 @@ boolean DLBus::Processing(void) {
         AddToInfoLog(strformat(
           F("# Required bits: %d StartBit: %d / EndBit: %d"), 
           RequiredBitStreamLength, 
-          StartBit, 
+          FrameStartBit, 
           BitNumber));
       }
 #endif // ifndef P092_LIMIT_BUILD_SIZE
@@ -307,12 +412,13 @@ boolean DLBus::Processing(void) {
   if (IsLogLevelInfo) {
     AddToInfoLog(strformat(
       F("StartBit: %d / EndBit: %d"),
-       StartBit, BitNumber));
+       FrameStartBit, BitNumber));
   }
 #endif // ifndef P092_LIMIT_BUILD_SIZE
-  Trim(StartBit);      // remove start and stop bits
+  Trim(FrameStartBit); // remove start and stop bits
 
   if (CheckDevice()) { // check connected device
+    memcpy(ByteStream, BitStream, sizeof(ByteStream));
     return true;
   }
   else {
@@ -321,31 +427,6 @@ boolean DLBus::Processing(void) {
   }
 }
 
-int DLBus::Analyze(void) {
-  uint8_t sync = 0;
-
-  // find SYNC (16 * sequential 1)
-  for (int i = 0; i < BitNumber; i++) {
-    if (ReadBit(i)) {
-      sync++;
-    }
-    else {
-      sync = 0;
-    }
-
-    if (sync == DLBus_SyncBits) {
-      // finde erste 0 // find first 0
-      while (ReadBit(i) == 1) {
-        i++;
-      }
-      return i; // beginning of data frame
-    }
-  }
-
-  // no data frame available. check signal?
-  return -1;
-}
-
 void DLBus::Invert(void) {
 # ifndef P092_LIMIT_BUILD_SIZE
   AddToInfoLog(F("Invert bit stream..."));
@@ -357,10 +438,10 @@ void DLBus::Invert(void) {
 }
 
 uint8_t DLBus::ReadBit(int pos) {
-  int row = pos / 8;                          // detect position in bitmap
+  int row = pos / 8;                         // detect position in bitmap
   int col = pos % 8;
 
-  return ((ByteStream[row]) >> (col)) & 0x01; // return bit
+  return ((BitStream[row]) >> (col)) & 0x01; // return bit
 }
 
 void DLBus::WriteBit(int pos, uint8_t set) {
@@ -368,10 +449,10 @@ void DLBus::WriteBit(int pos, uint8_t set) {
   int col = pos % 8;
 
   if (set) {
-    ByteStream[row] |= 1 << col;    // set bit
+    BitStream[row] |= 1 << col;    // set bit
   }
   else {
-    ByteStream[row] &= ~(1 << col); // clear bit
+    BitStream[row] &= ~(1 << col); // clear bit
   }
 }
 
@@ -391,8 +472,8 @@ void DLBus::Trim(int start_bit) {
 
 boolean DLBus::CheckDevice(void) {
   // Data frame of a device?
-  if (ByteStream[0] == DeviceBytes[0]) {
-    if ((DeviceBytes[1] == 0) || (ByteStream[1] == DeviceBytes[1])) {
+  if (BitStream[0] == DeviceBytes[0]) {
+    if ((DeviceBytes[1] == 0) || (BitStream[1] == DeviceBytes[1])) {
       return true;
     }
   }
@@ -400,10 +481,10 @@ boolean DLBus::CheckDevice(void) {
 # ifndef P092_LIMIT_BUILD_SIZE
   if (IsLogLevelInfo) {
     String log = F("# Received DeviceByte(s): 0x");
-    log += String(ByteStream[0], HEX);
+    log += String(BitStream[0], HEX);
 
     if (DeviceBytes[1] != 0) {
-      log += String(ByteStream[1], HEX);
+      log += String(BitStream[1], HEX);
     }
     log += F(" Requested: 0x");
     log += String(DeviceBytes[0], HEX);
@@ -465,9 +546,7 @@ boolean DLBus::CheckCRC(uint8_t IdxCRC) {
 
 P092_data_struct::~P092_data_struct() {
   if (DLbus_Data != nullptr) {
-    if (DLbus_Data->ISR_DLB_Pin != 0xFF) {
-      detachInterrupt(digitalPinToInterrupt(DLbus_Data->ISR_DLB_Pin));
-    }
+    // Detaches the interrupt (or RMT)
     delete DLbus_Data;
     DLbus_Data = nullptr;
   }
@@ -636,15 +715,14 @@ void P092_data_struct::Plugin_092_StartReceiving(taskIndex_t taskindex) {
   DLbus_Data->ISR_Receiving   = false;
   DLbus_Data->DeviceBytes[0]  = P092_DataSettings.DeviceByte0;
   DLbus_Data->DeviceBytes[1]  = P092_DataSettings.DeviceByte1;
-  DLbus_Data->ISR_PulseNumber =
+  DLbus_Data->PulseNumber =
     (((P092_DataSettings.DataBytes + DLbus_AdditionalRecBytes) * (DLbus_StartBits + 8 +  DLbus_StopBits) + DLBus_SyncBits) *
      DLBus_BitChangeFactor) + DLBus_ReserveBytes;
-  DLbus_Data->ISR_MinPulseWidth       = P092_DataSettings.DLbus_MinPulseWidth;
-  DLbus_Data->ISR_MaxPulseWidth       = P092_DataSettings.DLbus_MaxPulseWidth;
-  DLbus_Data->ISR_MinDoublePulseWidth = P092_DataSettings.DLbus_MinDoublePulseWidth;
-  DLbus_Data->ISR_MaxDoublePulseWidth = P092_DataSettings.DLbus_MaxDoublePulseWidth;
+  DLbus_Data->MinPulseWidth       = P092_DataSettings.DLbus_MinPulseWidth;
+  DLbus_Data->MaxPulseWidth       = P092_DataSettings.DLbus_MaxPulseWidth;
+  DLbus_Data->MinDoublePulseWidth = P092_DataSettings.DLbus_MinDoublePulseWidth;
+  DLbus_Data->MaxDoublePulseWidth = P092_DataSettings.DLbus_MaxDoublePulseWidth;
   DLbus_Data->StartReceiving();
-  uint32_t start = millis();
 
 # ifndef P092_LIMIT_BUILD_SIZE
   if (loglevelActiveFor(LOG_LEVEL_INFO)) {
@@ -654,17 +732,7 @@ void P092_data_struct::Plugin_092_StartReceiving(taskIndex_t taskindex) {
   }
 #endif // ifndef P092_LIMIT_BUILD_SIZE
 
-  while ((timePassedSince(start) < 100) && (DLbus_Data->ISR_PulseCount == 0)) {
-    // wait for first pulse received (timeout 100ms)
-    delay(0);
-  }
-
-  if (DLbus_Data->ISR_PulseCount == 0) {
-    // nothing received
-    DLbus_Data->ISR_Receiving = false;
-    DLbus_Data->IsNoData      = true; // stop receiving until next PLUGIN_092_READ
-    addLog(LOG_LEVEL_ERROR, F("## StartReceiving: Error: Nothing received! No DL bus connected!"));
-  }
+  // The edges are decoded in DLbus_Data->ProcessEdges(), which also detects that nothing is received
 }
 
 /****************\
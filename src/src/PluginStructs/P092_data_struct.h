@@ -27,8 +27,34 @@
 #define DLbus_MaxDataBits (((DLbus_MaxDataBytes + DLbus_AdditionalRecBytes) * (DLbus_StartBits + 8 + DLbus_StopBits) + DLBus_SyncBits) * \
                            DLBus_BitChangeFactor) + DLBus_ReserveBytes
 
-// MaxDataBits is double of the maximum bit length because each bit change is stored
-// (((64+2) * (8+1+1) + 16) * 2) + 50 = 1402 bytes
+// MaxDataBits is double of the maximum bit length because each bit change is counted
+// (((64+2) * (8+1+1) + 16) * 2) + 20 = 1352 bit changes, decoded into a bitmap of 1352 / 2 / 8 bytes
+
+// Nr of edges buffered between the ISR and the decoder, must be a power of 2.
+// At 488 Hz there are up to 976 edges per second, the decoder runs 50 times per second.
+#define DLbus_EdgeBufferSize 128
+
+// Use the RMT peripheral to capture the edges, only on ESP32 variants with RX ping-pong mode,
+// as a data frame is longer than the RMT memory of a channel.
+# ifndef P092_FEATURE_RMT
+#  if defined(ESP32S3) || defined(ESP32C3)
+#   define P092_FEATURE_RMT  1
+#  else // if defined(ESP32S3) || defined(ESP32C3)
+#   define P092_FEATURE_RMT  0
+#  endif // if defined(ESP32S3) || defined(ESP32C3)
+# endif // ifndef P092_FEATURE_RMT
+
+# if P092_FEATURE_RMT
+
+// RMT channel used, must not be used by anything else (see Dallas1WireRMT.h and IR_RMT.h)
+#  ifndef P092_RMT_RX_CHANNEL
+#   if defined(ESP32C3)
+#    define P092_RMT_RX_CHANNEL  RMT_CHANNEL_2
+#   else // if defined(ESP32C3)
+#    define P092_RMT_RX_CHANNEL  RMT_CHANNEL_5
+#   endif // if defined(ESP32C3)
+#  endif // ifndef P092_RMT_RX_CHANNEL
+# endif // if P092_FEATURE_RMT
 
 enum class eP092pinmode {
   ePPM_Input          = 1,
@@ -43,38 +69,66 @@ public:
 
   volatile uint8_t ISR_DLB_Pin = 0xFF;
   volatile boolean ISR_Receiving = false; // receiving flag
-  volatile boolean ISR_AllBitsReceived = false;
-  volatile uint16_t ISR_PulseCount = 0;   // number of received pulses
-  volatile uint16_t ISR_PulseNumber = 0;  // max naumber of the received pulses
-  volatile uint16_t ISR_MinPulseWidth = 0;
-  volatile uint16_t ISR_MaxPulseWidth = 0;
-  volatile uint16_t ISR_MinDoublePulseWidth = 0;
-  volatile uint16_t ISR_MaxDoublePulseWidth = 0;
+  boolean  FrameComplete = false;         // all pulses of a frame are decoded
+  boolean  FrameTimingOK = false;         // no more than the allowed nr of wrong timings in the frame
+  uint16_t PulseNumber = 0;               // max number of the received pulses
+  uint16_t MinPulseWidth = 0;
+  uint16_t MaxPulseWidth = 0;
+  uint16_t MinDoublePulseWidth = 0;
+  uint16_t MaxDoublePulseWidth = 0;
 
   // identification bytes for each DL bus device
   uint8_t DeviceBytes[2] = { 0 };
-  uint8_t ByteStream[DLbus_MaxDataBits / 8 + 1] = { 0 }; // every bit gets sorted into a bitmap
+  uint8_t ByteStream[DLbus_MaxDataBits / 16 + 1] = { 0 }; // data bytes of the last processed data frame
   boolean IsLogLevelInfo = false;
   boolean IsNoData = false;           // no data received (DL bus not connected), stop receiving until next call to PLUGIN_READ
   boolean IsISRset = false;           // ISR set flag, used for setting the ISR after network connected
   uint8_t LogLevelInfo   = 0xff;
   uint8_t LogLevelError  = 0xFF;
   void    attachDLBusInterrupt(void);
+  void    detachDLBusInterrupt(void);
   void    StartReceiving(void);
-  boolean CheckTimings(void);
+
+  // Decode the edges received since the previous call, typically from PLUGIN_FIFTY_PER_SECOND
+  void    ProcessEdges(void);
   boolean Processing(void);
   boolean CheckCRC(uint8_t IdxCRC);
 
 private:
 
+  // Single producer (ISR), single consumer ring buffer of edges: (usec since previous edge << 1) | pin state after the edge
+  // Only the ISR writes ISR_EdgeHead, only ProcessEdges() writes EdgeTail.
+  volatile uint32_t ISR_EdgeBuffer[DLbus_EdgeBufferSize] = { 0 };
+  volatile uint16_t ISR_EdgeHead = 0;
+  volatile uint16_t EdgeTail     = 0;
   volatile uint32_t ISR_TimeLastBitChange = 0;      // remember time of last transition
-  uint8_t DLbus_ChangeBitStream[DLbus_MaxDataBits] = { 0 }; // received bit change stream (each bit change is extended to uint8_t, containing the
-                                                    // timing flags)
-  uint16_t BitNumber = 0;                           // bit number of the received DLbus_ChangeBitStream
+
+  // Incremental decoder state
+  uint8_t  BitStream[DLbus_MaxDataBits / 16 + 1] = { 0 }; // every bit gets sorted into a bitmap
+  uint32_t ReceiveStart     = 0;                    // millis() at StartReceiving()
+  uint16_t ReceivedEdges    = 0;                    // edges received since StartReceiving()
+  uint16_t StoredPulses     = 0;                    // pulses of the data frame, counted from the sync
+  uint16_t DecodedPulses    = 0;                    // pulses processed by ProcessBit()
+  uint16_t BitNumber        = 0;                    // bit number of the last decoded bit
+  uint16_t SyncOnes         = 0;                    // sequential 1 bits decoded
+  uint16_t SyncZeros        = 0;                    // sequential 0 bits decoded
+  int16_t  StartBit         = -1;                   // first bit of the data frame after a sync (-1 not recognized)
+  int16_t  StartBitInverted = -1;                   // same, for an inverted signal
+  uint8_t  PrevPulse        = 0;                    // previous pulse incl. timing flags
+  uint8_t  WrongTimeCnt     = 0;
+# if P092_FEATURE_RMT
+  void    *RMT_ringbuffer = nullptr;
+  boolean  UseRMT         = false;
+  boolean  attachRMT(void);
+  void     ProcessRMTItems(void);
+# endif // if P092_FEATURE_RMT
+
   static void ISR(void);
   void        ISR_PinChanged(void);
+  void        DecodeEdge(uint32_t TimeDiff,
+                         uint8_t  PinState);
+  void        DecodePulse(uint8_t rawval);
   void        ProcessBit(uint8_t b);
-  int         Analyze(void);
   void        Invert(void);
   uint8_t     ReadBit(int pos);
   void        WriteBit(int     pos,
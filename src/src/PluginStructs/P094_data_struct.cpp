@@ -12,6 +12,30 @@
 #include "../Helpers/StringConverter.h"
 
 
+// Parse hex characters from the received frame, like hexToUL() but without creating a String.
+// Stops at the first non-hex character.
+static uint32_t P094_hexToUL(const char *received, size_t length, size_t startpos, size_t nrHexDecimals) {
+  uint32_t res = 0;
+
+  for (size_t i = startpos; i < length && i < (startpos + nrHexDecimals); ++i) {
+    const char c = received[i];
+    uint8_t    nibble;
+
+    if ((c >= '0') && (c <= '9')) {
+      nibble = c - '0';
+    } else if ((c >= 'a') && (c <= 'f')) {
+      nibble = c - 'a' + 10;
+    } else if ((c >= 'A') && (c <= 'F')) {
+      nibble = c - 'A' + 10;
+    } else {
+      break;
+    }
+    res = (res << 4) | nibble;
+  }
+  return res;
+}
+
+
 P094_data_struct::P094_data_struct() :  easySerial(nullptr) {
   for (int i = 0; i < P094_NR_FILTERS; ++i) {
     valueType_index[i] = P094_Filter_Value_Type::P094_not_used;
@@ -20,17 +44,18 @@ P094_data_struct::P094_data_struct() :  easySerial(nullptr) {
 }
 
 P094_data_struct::~P094_data_struct() {
-  if (easySerial != nullptr) {
-    delete easySerial;
-    easySerial = nullptr;
-  }
+  reset();
 }
 
 void P094_data_struct::reset() {
   if (easySerial != nullptr) {
+    #if FEATURE_SERIAL_RX_EVENT
+    serialHelper_disableRxEvent(rx_event_task, *easySerial);
+    #endif // if FEATURE_SERIAL_RX_EVENT
     delete easySerial;
     easySerial = nullptr;
   }
+  rx_event_task = INVALID_TASK_INDEX;
 }
 
 bool P094_data_struct::init(ESPEasySerialPort port, 
@@ -51,9 +76,14 @@ bool P094_data_struct::init(ESPEasySerialPort port,
 }
 
 void P094_data_struct::post_init() {
+  match_type        = getMatchType();
+  filter_off_window = getFilterOffWindowTime();
+  dedup_window      = getDedupWindowTime();
+
   for (uint8_t i = 0; i < P094_FILTER_VALUE_Type_NR_ELEMENTS; ++i) {
     valueType_used[i] = false;
   }
+  nr_compiled_filters = 0;
 
   for (uint8_t i = 0; i < P094_NR_FILTERS; ++i) {
     size_t lines_baseindex            = P094_Get_filter_base_index(i);
@@ -69,8 +99,27 @@ void P094_data_struct::post_init() {
       valueType_used[index] = true;
       valueType_index[i]    = static_cast<P094_Filter_Value_Type>(index);
       filter_comp[i]        = static_cast<P094_Filter_Comp>(tmp_filter_comp);
+
+      if (valueType_index[i] != P094_Filter_Value_Type::P094_not_used) {
+        // Convert the filter value once, instead of for every received frame
+        P094_compiled_filter_t& compiled = compiled_filters[nr_compiled_filters++];
+        compiled.filterLine = i;
+        compiled.valueType  = valueType_index[i];
+        compiled.comparator = filter_comp[i];
+
+        if (compiled.valueType == P094_Filter_Value_Type::P094_position) {
+          compiled.position = _lines[lines_baseindex + 1].toInt();
+        } else {
+          compiled.value = hexToUL(_lines[lines_baseindex + 3]);
+        }
+      }
     }
   }
+
+  for (uint8_t i = 0; i < P094_DEDUP_ENTRIES; ++i) {
+    dedup_entries[i].timestamp = 0;
+  }
+  dedup_next = 0;
 }
 
 bool P094_data_struct::isInitialized() const {
@@ -92,8 +141,19 @@ void P094_data_struct::sendString(const String& data) {
   }
 }
 
+bool P094_data_struct::enableRxEvent(taskIndex_t taskIndex) {
+  #if FEATURE_SERIAL_RX_EVENT
+
+  if (isInitialized() && serialHelper_enableRxEvent(taskIndex, *easySerial)) {
+    rx_event_task = taskIndex;
+    return true;
+  }
+  #endif // if FEATURE_SERIAL_RX_EVENT
+  return false;
+}
+
 bool P094_data_struct::loop() {
-  if (!isInitialized()) {
+  if (!isInitialized() || !serialHelper_rxDataReady(rx_event_task, *easySerial)) {
     return false;
   }
   bool fullSentenceReceived = false;
@@ -117,61 +177,67 @@ bool P094_data_struct::loop() {
 
       switch (c) {
         case 13:
-        {
-          const size_t length = sentence_part.length();
-          bool valid          = length > 0;
-
-          for (size_t i = 0; i < length && valid; ++i) {
-            if ((sentence_part[i] > 127) || (sentence_part[i] < 32)) {
-              sentence_part = String();
-              ++sentences_received_error;
-              valid = false;
-            }
-          }
-          if (valid) {
-            fullSentenceReceived = true;
+
+          if (frame_length > 0) {
+            fullSentenceReceived = frameReceived();
           }
           break;
-        }
         case 10:
 
           // Ignore LF
           break;
         default:
           if (c >= 32 && c < 127) {
-            sentence_part += c;
+            frame[frame_length++] = c;
+            frame[frame_length]   = 0;
           } else {
             current_sentence_errored = true;
           }
           break;
       }
 
-      if (max_length_reached()) { fullSentenceReceived = true; }
+      if (!fullSentenceReceived && max_length_reached()) {
+        fullSentenceReceived = frameReceived();
+      }
     }
   }
 
-  if (fullSentenceReceived) {
-    ++sentences_received;
-    length_last_received = sentence_part.length();
-  }
   return fullSentenceReceived;
 }
 
-const String& P094_data_struct::peekSentence() const {
-  return sentence_part;
+bool P094_data_struct::frameReceived() {
+  ++sentences_received;
+  length_last_received = frame_length;
+
+  if (frameAccepted(frame, frame_length)) {
+    return true;
+  }
+
+  // Rejected frames are dropped before creating a String, continue with the next frame.
+  clearFrame();
+  return false;
+}
+
+void P094_data_struct::clearFrame() {
+  frame_length             = 0;
+  frame[0]                 = 0;
+  current_sentence_errored = false;
+}
+
+String P094_data_struct::peekSentence() const {
+  return String(frame);
 }
 
 void P094_data_struct::getSentence(String& string, bool appendSysTime) {
-  string = std::move(sentence_part);
-  sentence_part = String(); // FIXME TD-er: Should not be needed as move already cleared it.
+  // Unix timestamp = 10 decimals + separator
+  string.reserve(frame_length + (appendSysTime ? 11 : 0));
+  string = frame;
+
   if (appendSysTime) {
-    // Unix timestamp = 10 decimals + separator
-    if (string.reserve(sentence_part.length() + 11)) {
-      string += ';';
-      string += node_time.getUnixTime();
-    }
+    string += ';';
+    string += node_time.getUnixTime();
   }
-  sentence_part.reserve(string.length());
+  clearFrame();
 }
 
 void P094_data_struct::getSentencesReceived(uint32_t& succes, uint32_t& error, uint32_t& length_last) const {
@@ -180,6 +246,15 @@ void P094_data_struct::getSentencesReceived(uint32_t& succes, uint32_t& error, u
   length_last = length_last_received;
 }
 
+void P094_data_struct::getFilterStats(uint32_t& rejected, uint32_t& duplicates, uint32_t setHits[], uint8_t nrSets) const {
+  rejected   = sentences_rejected;
+  duplicates = sentences_duplicate;
+
+  for (uint8_t i = 0; i < nrSets && i < (P094_NR_FILTERS / P094_AND_FILTER_BLOCK); ++i) {
+    setHits[i] = filter_set_hits[i];
+  }
+}
+
 void P094_data_struct::setMaxLength(uint16_t maxlenght) {
   max_length = maxlenght;
 }
@@ -194,12 +269,16 @@ uint32_t P094_data_struct::getFilterOffWindowTime() const {
   return _lines[P094_FILTER_OFF_WINDOW_POS].toInt();
 }
 
+uint32_t P094_data_struct::getDedupWindowTime() const {
+  return _lines[P094_DEDUP_WINDOW_POS].toInt();
+}
+
 P094_Match_Type P094_data_struct::getMatchType() const {
   return static_cast<P094_Match_Type>(_lines[P094_MATCH_TYPE_POS].toInt());
 }
 
 bool P094_data_struct::invertMatch() const {
-  switch (getMatchType()) {
+  switch (match_type) {
     case P094_Regular_Match:
       break;
     case P094_Regular_Match_inverted:
@@ -235,11 +314,11 @@ String P094_data_struct::getFilter(uint8_t lineNr, P094_Filter_Value_Type& filte
 }
 
 void P094_data_struct::setDisableFilterWindowTimer() {
-  if (getFilterOffWindowTime() == 0) {
+  if (filter_off_window == 0) {
     disable_filter_window = 0;
   }
   else {
-    disable_filter_window = millis() + getFilterOffWindowTime();
+    disable_filter_window = millis() + filter_off_window;
   }
 }
 
@@ -253,15 +332,72 @@ bool P094_data_struct::disableFilterWindowActive() const {
   return false;
 }
 
-bool P094_data_struct::parsePacket(const String& received) const {
-  size_t strlength = received.length();
+bool P094_data_struct::frameAccepted(const char *received, size_t length) {
+  if (disableFilterWindowActive()) {
+    addLog(LOG_LEVEL_INFO, F("CUL Reader: Disable Filter Window active"));
+    return true;
+  }
+
+  bool res = parsePacket(received, length);
 
-  if (strlength == 0) {
+  if (invertMatch()) {
+    # ifndef BUILD_NO_DEBUG
+    addLog(LOG_LEVEL_DEBUG, F("CUL Reader: invert filter"));
+    # endif // ifndef BUILD_NO_DEBUG
+    res = !res;
+  }
+
+  if (!res) {
+    ++sentences_rejected;
     return false;
   }
 
+  if (isDuplicate(received, length)) {
+    ++sentences_duplicate;
+    return false;
+  }
+  return true;
+}
+
+bool P094_data_struct::isDuplicate(const char *received, size_t length) {
+  if ((dedup_window == 0) || (length == 0) || (received[0] != 'b')) {
+    return false;
+  }
 
-  if (getMatchType() == P094_Filter_Disabled) {
+  // FNV-1a hash of the telegram, without the RSSI as that differs per repetition.
+  const size_t hashLength = length > P094_DEDUP_SKIP_CHARS ? length - P094_DEDUP_SKIP_CHARS : length;
+  uint32_t     hash       = 2166136261u;
+
+  for (size_t i = 0; i < hashLength; ++i) {
+    hash ^= static_cast<uint8_t>(received[i]);
+    hash *= 16777619u;
+  }
+
+  for (uint8_t i = 0; i < P094_DEDUP_ENTRIES; ++i) {
+    if ((dedup_entries[i].timestamp != 0) &&
+        (dedup_entries[i].hash == hash) &&
+        (timePassedSince(dedup_entries[i].timestamp) < static_cast<long>(dedup_window))) {
+      # ifndef BUILD_NO_DEBUG
+      addLog(LOG_LEVEL_DEBUG, F("CUL Reader: Repeated telegram dropped"));
+      # endif // ifndef BUILD_NO_DEBUG
+      return true;
+    }
+  }
+
+  // Replace the oldest entry
+  dedup_entries[dedup_next].hash      = hash;
+  dedup_entries[dedup_next].timestamp = millis();
+  dedup_next                          = (dedup_next + 1) % P094_DEDUP_ENTRIES;
+  return false;
+}
+
+bool P094_data_struct::parsePacket(const char *received, size_t length) {
+  if (length == 0) {
+    return false;
+  }
+
+
+  if (match_type == P094_Filter_Disabled) {
     return true;
   }
 
@@ -270,34 +406,36 @@ bool P094_data_struct::parsePacket(const String& received) const {
   // FIXME TD-er: For now added '$' to test with GPS.
   if ((received[0] == 'b') || (received[0] == '$')) {
     // Received a data packet in CUL format.
-    if (strlength < 21) {
+    if (length < 21) {
       return false;
     }
 
     // Decoded packet
 
-    unsigned long packet_header[P094_FILTER_VALUE_Type_NR_ELEMENTS];
-    packet_header[P094_packet_length] = hexToUL(received, 1, 2);
-    packet_header[P094_unknown1]      = hexToUL(received, 3, 2);
-    packet_header[P094_manufacturer]  = hexToUL(received, 5, 4);
-    packet_header[P094_serial_number] = hexToUL(received, 9, 8);
-    packet_header[P094_unknown2]      = hexToUL(received, 17, 2);
-    packet_header[P094_meter_type]    = hexToUL(received, 19, 2);
+    uint32_t packet_header[P094_FILTER_VALUE_Type_NR_ELEMENTS] = { 0 };
+    packet_header[P094_packet_length] = P094_hexToUL(received, length, 1, 2);
+    packet_header[P094_unknown1]      = P094_hexToUL(received, length, 3, 2);
+    packet_header[P094_manufacturer]  = P094_hexToUL(received, length, 5, 4);
+    packet_header[P094_serial_number] = P094_hexToUL(received, length, 9, 8);
+    packet_header[P094_unknown2]      = P094_hexToUL(received, length, 17, 2);
+    packet_header[P094_meter_type]    = P094_hexToUL(received, length, 19, 2);
 
     // FIXME TD-er: Is this also correct?
-    packet_header[P094_rssi] = hexToUL(received, strlength - 4, 4);
+    packet_header[P094_rssi] = P094_hexToUL(received, length, length - 4, 4);
 
     // FIXME TD-er: Is this correct?
-    // match_result = packet_length == (strlength - 21) / 2;
+    // match_result = packet_length == (length - 21) / 2;
+
+    # ifndef BUILD_NO_DEBUG
 
-    if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
       String log;
       if (log.reserve(128)) {
         log  = F("CUL Reader: ");
         log += F(" length: ");
         log += packet_header[P094_packet_length];
         log += F(" (header: ");
-        log += strlength - (packet_header[P094_packet_length] * 2);
+        log += length - (packet_header[P094_packet_length] * 2);
         log += F(") manu: ");
         log += formatToHex_decimal(packet_header[P094_manufacturer]);
         log += F(" serial: ");
@@ -306,9 +444,10 @@ bool P094_data_struct::parsePacket(const String& received) const {
         log += formatToHex_decimal(packet_header[P094_meter_type]);
         log += F(" RSSI: ");
         log += formatToHex_decimal(packet_header[P094_rssi]);
-        addLogMove(LOG_LEVEL_INFO, log);
+        addLogMove(LOG_LEVEL_DEBUG, log);
       }
     }
+    # endif // ifndef BUILD_NO_DEBUG
 
     bool filter_matches[P094_NR_FILTERS];
 
@@ -316,109 +455,107 @@ bool P094_data_struct::parsePacket(const String& received) const {
       filter_matches[f] = false;
     }
 
-    // Do not check for "not used" (0)
-    for (unsigned int i = 1; i < P094_FILTER_VALUE_Type_NR_ELEMENTS; ++i) {
-      if (valueType_used[i]) {
-        for (unsigned int f = 0; f < P094_NR_FILTERS; ++f) {
-          if (valueType_index[f] == i) {
-            // Have a matching filter
-
-            uint32_t optional;
-            P094_Filter_Value_Type filterValueType;
-            P094_Filter_Comp comparator;
-            bool   match = false;
-            String inputString;
-            String valueString;
-
-            if (i == P094_Filter_Value_Type::P094_position) {
-              valueString = getFilter(f, filterValueType, optional, comparator);
-
-              if (received.length() >= (optional + valueString.length())) {
-                // received string is long enough to fit the expression.
-                inputString = received.substring(optional, optional + valueString.length());
-                match = inputString.equalsIgnoreCase(valueString);
-              }
-            } else {
-              unsigned long value = hexToUL(getFilter(f, filterValueType, optional, comparator));
-              match       = (value == packet_header[i]);
-              inputString = formatToHex_decimal(packet_header[i]);
-              valueString = formatToHex_decimal(value);
-            }
+    for (uint8_t c = 0; c < nr_compiled_filters; ++c) {
+      const P094_compiled_filter_t& filter = compiled_filters[c];
+      bool match                           = false;
 
+      if (filter.valueType == P094_Filter_Value_Type::P094_position) {
+        const String& valueString = _lines[P094_Get_filter_base_index(filter.filterLine) + 3];
+        const size_t  valueLength = valueString.length();
 
-            if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-              String log;
-              if (log.reserve(64)) {
-                log += F("CUL Reader: ");
-                log += P094_FilterValueType_toString(valueType_index[f]);
-                log += F(":  in:");
-                log += inputString;
-                log += ' ';
-                log += P094_FilterComp_toString(comparator);
-                log += ' ';
-                log += valueString;
-
-                switch (comparator) {
-                  case P094_Filter_Comp::P094_Equal_OR:
-                  case P094_Filter_Comp::P094_Equal_MUST:
-
-                    if (match) { log += F(" expected MATCH"); } 
-                    break;
-                  case P094_Filter_Comp::P094_NotEqual_OR:
-                  case P094_Filter_Comp::P094_NotEqual_MUST:
-
-                    if (!match) { log += F(" expected NO MATCH"); }
-                    break;
-                }
-                addLogMove(LOG_LEVEL_INFO, log);
-              }
-            }
+        if (length >= (filter.position + valueLength)) {
+          // received frame is long enough to fit the expression.
+          match = strncasecmp(received + filter.position, valueString.c_str(), valueLength) == 0;
+        }
+      } else {
+        match = (filter.value == packet_header[filter.valueType]);
+      }
 
-            switch (comparator) {
-              case P094_Filter_Comp::P094_Equal_OR:
+      # ifndef BUILD_NO_DEBUG
 
-                if (match) { filter_matches[f] = true; }
-                break;
-              case P094_Filter_Comp::P094_NotEqual_OR:
+      if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+        String log;
+        if (log.reserve(64)) {
+          log += F("CUL Reader: ");
+          log += P094_FilterValueType_toString(filter.valueType);
+          log += F(":  in:");
 
-                if (!match) { filter_matches[f] = true; }
-                break;
+          if (filter.valueType == P094_Filter_Value_Type::P094_position) {
+            const String& valueString = _lines[P094_Get_filter_base_index(filter.filterLine) + 3];
 
-              case P094_Filter_Comp::P094_Equal_MUST:
+            for (size_t i = filter.position; i < length && i < (filter.position + valueString.length()); ++i) {
+              log += received[i];
+            }
+            log += ' ';
+            log += P094_FilterComp_toString(filter.comparator);
+            log += ' ';
+            log += valueString;
+          } else {
+            log += formatToHex_decimal(packet_header[filter.valueType]);
+            log += ' ';
+            log += P094_FilterComp_toString(filter.comparator);
+            log += ' ';
+            log += formatToHex_decimal(filter.value);
+          }
 
-                if (!match) { return false; }
-                break;
+          switch (filter.comparator) {
+            case P094_Filter_Comp::P094_Equal_OR:
+            case P094_Filter_Comp::P094_Equal_MUST:
 
-              case P094_Filter_Comp::P094_NotEqual_MUST:
+              if (match) { log += F(" expected MATCH"); }
+              break;
+            case P094_Filter_Comp::P094_NotEqual_OR:
+            case P094_Filter_Comp::P094_NotEqual_MUST:
 
-                if (match) { return false; }
-                break;
-            }
+              if (!match) { log += F(" expected NO MATCH"); }
+              break;
           }
+          addLogMove(LOG_LEVEL_DEBUG, log);
         }
       }
-    }
+      # endif // ifndef BUILD_NO_DEBUG
 
-    // Now we have to check if all rows per filter line in filter_matches[f] are true or not used.
-    int nrMatches = 0;
-    int nrNotUsed = 0;
+      switch (filter.comparator) {
+        case P094_Filter_Comp::P094_Equal_OR:
 
-    for (unsigned int f = 0; !match_result && f < P094_NR_FILTERS; ++f) {
-      if (f % P094_AND_FILTER_BLOCK == 0) {
-        if ((nrMatches > 0) && ((nrMatches + nrNotUsed) == P094_AND_FILTER_BLOCK)) {
-          match_result = true;
-        }
-        nrMatches = 0;
-        nrNotUsed = 0;
+          if (match) { filter_matches[filter.filterLine] = true; }
+          break;
+        case P094_Filter_Comp::P094_NotEqual_OR:
+
+          if (!match) { filter_matches[filter.filterLine] = true; }
+          break;
+
+        case P094_Filter_Comp::P094_Equal_MUST:
+
+          if (!match) { return false; }
+          break;
+
+        case P094_Filter_Comp::P094_NotEqual_MUST:
+
+          if (match) { return false; }
+          break;
       }
+    }
 
-      if (filter_matches[f]) {
-        ++nrMatches;
-      } else {
-        if (!filterUsed(f)) {
-          ++nrNotUsed;
+    // Now we have to check if all rows per filter set in filter_matches[f] are true or not used.
+    for (unsigned int set = 0; !match_result && set < (P094_NR_FILTERS / P094_AND_FILTER_BLOCK); ++set) {
+      int nrMatches = 0;
+      int nrNotUsed = 0;
+
+      for (unsigned int f = set * P094_AND_FILTER_BLOCK; f < ((set + 1) * P094_AND_FILTER_BLOCK); ++f) {
+        if (filter_matches[f]) {
+          ++nrMatches;
+        } else {
+          if (!filterUsed(f)) {
+            ++nrNotUsed;
+          }
         }
       }
+
+      if ((nrMatches > 0) && ((nrMatches + nrNotUsed) == P094_AND_FILTER_BLOCK)) {
+        match_result = true;
+        ++filter_set_hits[set];
+      }
     }
   } else {
     switch (received[0]) {
@@ -477,8 +614,9 @@ const __FlashStringHelper * P094_data_struct::P094_FilterComp_toString(P094_Filt
 }
 
 bool P094_data_struct::max_length_reached() const {
+  if (frame_length >= P094_MAX_FRAME_LENGTH) { return true; }
   if (max_length == 0) { return false; }
-  return sentence_part.length() >= max_length;
+  return frame_length >= max_length;
 }
 
 size_t P094_data_struct::P094_Get_filter_base_index(size_t filterLine) {
@@ -12,6 +12,7 @@
 # define P094_NR_CHAR_USE_POS       1
 # define P094_FILTER_OFF_WINDOW_POS 2
 # define P094_MATCH_TYPE_POS        3
+# define P094_DEDUP_WINDOW_POS      4
 
 # define P094_FIRST_FILTER_POS   10
 
@@ -22,6 +23,15 @@
 # define P94_Nchars              128
 # define P94_MAX_CAPTURE_INDEX   32
 
+// Max. length of a received frame, longer frames are truncated
+# define P094_MAX_FRAME_LENGTH   550
+
+// Nr of recently sent telegrams remembered to detect repeated ones
+# define P094_DEDUP_ENTRIES      8
+
+// Nr of characters at the end of a data packet not used for detecting repeated telegrams (RSSI)
+# define P094_DEDUP_SKIP_CHARS   4
+
 
 enum P094_Match_Type {
   P094_Regular_Match          = 0,
@@ -52,6 +62,21 @@ enum P094_Filter_Comp {
 
 # define P094_FILTER_COMP_NR_ELEMENTS 4
 
+// Filter line converted at init, so matching a frame does not have to parse the settings.
+struct P094_compiled_filter_t {
+  uint32_t               value      = 0;  // Filter value for the header fields
+  uint16_t               position   = 0;  // Offset in the frame for P094_position
+  uint8_t                filterLine = 0;
+  P094_Filter_Value_Type valueType  = P094_Filter_Value_Type::P094_not_used;
+  P094_Filter_Comp       comparator = P094_Filter_Comp::P094_Equal_OR;
+};
+
+// Recently sent telegram, frame hash without RSSI
+struct P094_dedup_entry_t {
+  uint32_t      hash      = 0;
+  unsigned long timestamp = 0;
+};
+
 
 struct P094_data_struct : public PluginTaskData_base {
 public:
@@ -71,11 +96,14 @@ public:
 
   bool isInitialized() const;
 
+  // Only read the serial port when woken via PLUGIN_TASKTIMER_IN, when supported by the port.
+  bool enableRxEvent(taskIndex_t taskIndex);
+
   void sendString(const String& data);
 
   bool loop();
 
-  const String& peekSentence() const;
+  String peekSentence() const;
 
   void getSentence(String& string, bool appendSysTime);
 
@@ -83,6 +111,12 @@ public:
                             uint32_t& error,
                             uint32_t& length_last) const;
 
+  // Nr of frames dropped by the filters and as repeated telegram, nr of frames sent per filter set
+  void getFilterStats(uint32_t& rejected,
+                      uint32_t& duplicates,
+                      uint32_t  setHits[],
+                      uint8_t   nrSets) const;
+
   void setMaxLength(uint16_t maxlenght);
 
   void setLine(uint8_t          varNr,
@@ -91,6 +125,8 @@ public:
 
   uint32_t        getFilterOffWindowTime() const;
 
+  uint32_t        getDedupWindowTime() const;
+
   P094_Match_Type getMatchType() const;
 
   bool            invertMatch() const;
@@ -106,7 +142,12 @@ public:
 
   bool          disableFilterWindowActive() const;
 
-  bool          parsePacket(const String& received) const;
+  // Check the frame against the filter-off window, the compiled filters and the match type.
+  bool          frameAccepted(const char *received,
+                              size_t      length);
+
+  bool          parsePacket(const char *received,
+                            size_t      length);
 
   static const __FlashStringHelper * MatchType_toString(P094_Match_Type matchType);
   static const __FlashStringHelper * P094_FilterValueType_toString(P094_Filter_Value_Type valueType);
@@ -125,19 +166,44 @@ private:
 
   bool max_length_reached() const;
 
+  // A received frame is complete, keep it when accepted, else start a new one.
+  bool frameReceived();
+
+  void clearFrame();
+
+  // Check (and remember) the frame as recently sent telegram
+  bool isDuplicate(const char *received,
+                   size_t      length);
+
   ESPeasySerial *easySerial = nullptr;
-  String         sentence_part;
-  uint16_t       max_length               = 550;
+  taskIndex_t    rx_event_task = INVALID_TASK_INDEX;
+  char           frame[P094_MAX_FRAME_LENGTH + 1] = { 0 };
+  uint16_t       frame_length             = 0;
+  uint16_t       max_length               = P094_MAX_FRAME_LENGTH;
   uint32_t       sentences_received       = 0;
   uint32_t       sentences_received_error = 0;
   bool           current_sentence_errored = false;
   uint32_t       length_last_received     = 0;
   unsigned long  disable_filter_window    = 0;
   uint32_t       debug_counter            = 0;
+  uint32_t       sentences_rejected       = 0;
+  uint32_t       sentences_duplicate      = 0;
+
+  // Settings used per frame, set in post_init()
+  P094_Match_Type match_type        = P094_Match_Type::P094_Regular_Match;
+  uint32_t        filter_off_window = 0;
+  uint32_t        dedup_window      = 0;
 
   bool                   valueType_used[P094_FILTER_VALUE_Type_NR_ELEMENTS] = {0};
   P094_Filter_Value_Type valueType_index[P094_NR_FILTERS];
   P094_Filter_Comp       filter_comp[P094_NR_FILTERS];
+
+  P094_compiled_filter_t compiled_filters[P094_NR_FILTERS];
+  uint8_t                nr_compiled_filters = 0;
+  uint32_t               filter_set_hits[P094_NR_FILTERS / P094_AND_FILTER_BLOCK] = { 0 };
+
+  P094_dedup_entry_t dedup_entries[P094_DEDUP_ENTRIES];
+  uint8_t            dedup_next = 0;
 };
 
 
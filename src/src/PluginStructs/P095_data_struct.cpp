@@ -179,6 +179,9 @@ bool P095_data_struct::plugin_init(struct EventStruct *event) {
       gfxHelper->setColumnRowMode(bitRead(P095_CONFIG_FLAGS, P095_CONFIG_FLAG_USE_COL_ROW));
       gfxHelper->setTxtfullCompensation(!bitRead(P095_CONFIG_FLAGS, P095_CONFIG_FLAG_COMPAT_P095) ? 0 : 1);
       gfxHelper->invertDisplay(P095_CONFIG_FLAG_GET_INVERTDISPLAY);
+      # if ADAGFX_ENABLE_DRAW_CACHE
+      gfxHelper->setDrawCache(true); // Don't send unchanged text over SPI again
+      # endif // if ADAGFX_ENABLE_DRAW_CACHE
     }
     updateFontMetrics();
     tft->fillScreen(_bgcolor);             // fill screen with background color
@@ -305,6 +308,12 @@ bool P095_data_struct::plugin_ten_per_second(struct EventStruct *event) {
 
       if (nullptr != tft) {
         tft->fillScreen(_bgcolor); // fill screen with background color
+        # if ADAGFX_ENABLE_DRAW_CACHE
+
+        if (nullptr != gfxHelper) {
+          gfxHelper->invalidateDrawCache();
+        }
+        # endif // if ADAGFX_ENABLE_DRAW_CACHE
       }
 
       // Schedule the surrogate initial PLUGIN_READ that has been suppressed by the splash
@@ -355,10 +364,15 @@ bool P095_data_struct::plugin_write(struct EventStruct *event, const String& str
     {
       String arg2 = parseString(string, 3);
 
-      if (!arg2.isEmpty()) {
-        tft->fillScreen(AdaGFXparseColor(arg2));
+      const uint16_t color = arg2.isEmpty() ? _bgcolor : AdaGFXparseColor(arg2);
+
+      if (nullptr != gfxHelper) {
+        gfxHelper->fillScreen(color); // Uses the line buffer, if available
+        # if ADAGFX_ENABLE_DRAW_CACHE
+        gfxHelper->invalidateDrawCache();
+        # endif // if ADAGFX_ENABLE_DRAW_CACHE
       } else {
-        tft->fillScreen(_bgcolor);
+        tft->fillScreen(color);
       }
     }
     else if (equals(arg1, F("backlight"))) {
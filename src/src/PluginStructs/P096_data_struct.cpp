@@ -199,6 +199,14 @@ bool P096_data_struct::plugin_init(struct EventStruct *event) {
       eInkScreen->begin(); // Start the device
       eInkScreen->clearBuffer();
 
+      // Don't block during the refresh, only possible with the Busy pin connected
+      eInkScreen->setAsyncRefresh(validGpio(PIN(3)));
+      # if P096_USE_EXTENDED_SETTINGS
+      _maxPartial = P096_CONFIG_FLAG_GET_PARTIAL;
+      # endif // if P096_USE_EXTENDED_SETTINGS
+      _partialCount = 0;
+      _fullRefresh  = true;
+
       eInkScreen->setRotation(_rotation);
       eInkScreen->setTextColor(_fgcolor);
       eInkScreen->setTextSize(_fontscaling); // Handles 0 properly, text size, default 1 = very small
@@ -236,6 +244,31 @@ void P096_data_struct::updateFontMetrics() {
   }
 }
 
+/****************************************************************************
+ * updateDisplay: Refresh the display only when the content changed.
+ * A full refresh is done after _maxPartial partial updates, or when requested.
+ ***************************************************************************/
+void P096_data_struct::updateDisplay(bool fullRefresh) {
+  const uint32_t checksum = eInkScreen->bufferChecksum();
+
+  if (fullRefresh) {
+    _fullRefresh = true;
+  }
+
+  if (!_fullRefresh && (checksum == _lastChecksum)) {
+    return; // Same content, avoid a needless refresh
+  }
+  _lastChecksum = checksum;
+
+  if (!_fullRefresh && (_partialCount < _maxPartial) && eInkScreen->partialDisplay()) {
+    _partialCount++;
+  } else {
+    eInkScreen->display();
+    _partialCount = 0;
+    _fullRefresh  = false;
+  }
+}
+
 /****************************************************************************
  * plugin_exit: De-initialize before destruction
  ***************************************************************************/
@@ -287,7 +320,7 @@ bool P096_data_struct::plugin_read(struct EventStruct *event) {
       UserVar[event->BaseVarIndex]     = curX;                                               // and put into Values
       UserVar[event->BaseVarIndex + 1] = curY;
 
-      eInkScreen->display();
+      updateDisplay();
       eInkScreen->clearBuffer();
     }
   }
@@ -321,7 +354,7 @@ bool P096_data_struct::plugin_write(struct EventStruct *event, const String& str
       } else {
         eInkScreen->fillScreen(_bgcolor);
       }
-      eInkScreen->display();
+      updateDisplay(true); // Full refresh also removes any ghosting
       eInkScreen->clearBuffer();
       success = true;
     }
@@ -330,6 +363,11 @@ bool P096_data_struct::plugin_write(struct EventStruct *event, const String& str
     }
     else if (equals(arg1, F("deepsleep"))) {
       eInkScreen->deepSleep();
+      _fullRefresh = true;
+    }
+    else if (equals(arg1, F("fullrefresh"))) { // Next update will be a full refresh
+      _fullRefresh = true;
+      success      = true;
     }
     else if (equals(arg1, F("seq_start"))) {
       String arg2 = parseString(string, 3);
@@ -347,7 +385,7 @@ bool P096_data_struct::plugin_write(struct EventStruct *event, const String& str
       //             TimingStats s;
       //             const unsigned statisticsTimerStart(micros());
       // # endif // ifndef BUILD_NO_DEBUG
-      eInkScreen->display();
+      updateDisplay();
 
       // # ifndef BUILD_NO_DEBUG
       //             s.add(usecPassedSince(statisticsTimerStart));
@@ -365,7 +403,7 @@ bool P096_data_struct::plugin_write(struct EventStruct *event, const String& str
           (nArg2 >= 0) &&
           (nArg2 <= 1)) {
         eInkScreen->invertDisplay(nArg2);
-        eInkScreen->display();
+        updateDisplay(true);
         success = true;
       }
     }
@@ -378,7 +416,7 @@ bool P096_data_struct::plugin_write(struct EventStruct *event, const String& str
       if (validIntFromString(arg2, nArg2) &&
           (nArg2 >= 0)) {
         eInkScreen->setRotation(nArg2 % 4);
-        eInkScreen->display();
+        updateDisplay(true);
         success = true;
       }
     } else {
@@ -405,7 +443,7 @@ bool P096_data_struct::plugin_write(struct EventStruct *event, const String& str
       success = gfxHelper->processCommand(AdaGFXparseTemplate(tmp, _textcols, gfxHelper));
 
       if (success && !plugin_096_sequence_in_progress) {
-        eInkScreen->display();
+        updateDisplay();
 
         // eInkScreen->clearBuffer();
       }
@@ -42,6 +42,7 @@
 # define P096_CONFIG_FLAG_MODE          16 // Flag-offset to store 4 bits for Mode, uses bits 16, 17, 18 and 19
 # define P096_CONFIG_FLAG_COLORDEPTH    20 // Flag-offset to store 4 bits for Color depth, uses bits 20, 21, 22 and 23
 # define P096_CONFIG_FLAG_DISPLAYTYPE   24 // Flag-offset to store 4 bits for Display type, uses bits 24, 25, 26 and 27
+# define P096_CONFIG_FLAG_PARTIAL       28 // Flag-offset to store 4 bits for Partial updates before a full refresh, uses bits 28..31
 
 // // Getters
 # define P096_CONFIG_GET_COLOR_FOREGROUND   (P096_CONFIG_COLORS & 0xFFFF)
@@ -51,6 +52,7 @@
 # define P096_CONFIG_FLAG_GET_MODE          (get4BitFromUL(P096_CONFIG_FLAGS, P096_CONFIG_FLAG_MODE))
 # define P096_CONFIG_FLAG_GET_COLORDEPTH    (get4BitFromUL(P096_CONFIG_FLAGS, P096_CONFIG_FLAG_COLORDEPTH))
 # define P096_CONFIG_FLAG_GET_DISPLAYTYPE   (get4BitFromUL(P096_CONFIG_FLAGS, P096_CONFIG_FLAG_DISPLAYTYPE))
+# define P096_CONFIG_FLAG_GET_PARTIAL       (get4BitFromUL(P096_CONFIG_FLAGS, P096_CONFIG_FLAG_PARTIAL))
 
 # ifdef ESP32
 
@@ -126,12 +128,20 @@ private:
 
   void updateFontMetrics();
 
+  // Refresh the display if the buffer changed, using partial updates when supported and configured
+  void updateDisplay(bool fullRefresh = false);
+
   LOLIN_EPD *eInkScreen = nullptr;
 
   AdafruitGFX_helper *gfxHelper = nullptr;
 
   bool plugin_096_sequence_in_progress = false;
 
+  uint32_t _lastChecksum = 0; // Buffer checksum at the previous refresh
+  uint8_t  _maxPartial   = 0; // Partial updates before a full refresh, 0 = always full refresh
+  uint8_t  _partialCount = 0;
+  bool     _fullRefresh  = false; // Next refresh must be a full refresh
+
   EPD_type_e _display;
   uint16_t   _xpix         = 0;
   uint16_t   _ypix         = 0;
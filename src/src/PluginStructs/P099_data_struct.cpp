@@ -11,10 +11,7 @@
 # include <XPT2046_Touchscreen.h>
 
 P099_data_struct::~P099_data_struct() {
-  if (touchscreen != nullptr) {
-    delete touchscreen;
-    touchscreen = nullptr;
-  }
+  reset();
 }
 
 /**
@@ -22,6 +19,10 @@ P099_data_struct::~P099_data_struct() {
  */
 void P099_data_struct::reset() {
   if (touchscreen != nullptr) {
+    if (validGpio(_irq_pin)) {
+      // The library attaches its own ISR, referring to the touchscreen object
+      detachInterrupt(digitalPinToInterrupt(_irq_pin));
+    }
     delete touchscreen;
     touchscreen = nullptr;
   }
@@ -35,6 +36,7 @@ void P099_data_struct::reset() {
  */
 bool P099_data_struct::init(taskIndex_t taskIndex,
                             uint8_t     cs,
+                            int8_t      irq_pin,
                             uint8_t     rotation,
                             bool        flipped,
                             uint8_t     z_treshold,
@@ -46,6 +48,7 @@ bool P099_data_struct::init(taskIndex_t taskIndex,
   reset();
 
   _address_ts_cs  = cs;
+  _irq_pin        = validGpio(irq_pin) ? irq_pin : -1;
   _z_treshold     = z_treshold;
   _rotation       = rotation;
   _flipped        = flipped;
@@ -55,7 +58,8 @@ bool P099_data_struct::init(taskIndex_t taskIndex,
   _ts_x_res       = ts_x_res;
   _ts_y_res       = ts_y_res;
 
-  touchscreen = new (std::nothrow) XPT2046_Touchscreen(_address_ts_cs);
+  // With the PENIRQ pin connected, the library only reads the touchscreen via SPI after it was touched
+  touchscreen = new (std::nothrow) XPT2046_Touchscreen(_address_ts_cs, (_irq_pin >= 0) ? _irq_pin : 255);
 
   if (touchscreen != nullptr) {
     touchscreen->setRotation(_rotation);
@@ -33,6 +33,7 @@ struct P099_data_struct : public PluginTaskData_base
   void reset();
   bool init(taskIndex_t taskIndex,
             uint8_t     cs,
+            int8_t      irq_pin,
             uint8_t     rotation,
             bool        flipped,
             uint8_t     z_treshold,
@@ -64,6 +65,7 @@ struct P099_data_struct : public PluginTaskData_base
   // This is initialized by calling init()
   XPT2046_Touchscreen *touchscreen     = nullptr;
   uint8_t              _address_ts_cs  = 0;
+  int8_t               _irq_pin        = -1;
   uint8_t              _rotation       = 0;
   bool                 _flipped        = 0;
   uint8_t              _z_treshold     = 0;
@@ -24,8 +24,9 @@ struct P106_data_struct : public PluginTaskData_base {
   bool begin(uint8_t addr,
              bool    initSettings = true);
 
-  Adafruit_BME680 bme; // I2C
-  bool            initialized = false;
+  Adafruit_BME680    bme; // I2C
+  PluginTwoPhaseRead readPhase;
+  bool               initialized = false;
 };
 
 #endif // ifdef USES_P106
@@ -4,16 +4,38 @@
 
 
 P108_data_struct::~P108_data_struct() {
-  modbus.reset();
+  reset();
 }
 
 void P108_data_struct::reset() {
-  modbus.reset();
+  if (bus != nullptr) {
+    bus->remove(&registerMap);
+    ModbusRTU_releaseBus(bus);
+    bus = nullptr;
+  }
 }
 
 bool P108_data_struct::init(ESPEasySerialPort port, const int16_t serial_rx, const int16_t serial_tx, int8_t dere_pin,
                             unsigned int baudrate, uint8_t modbusAddress) {
-  return modbus.init(port, serial_rx, serial_tx, baudrate, modbusAddress, dere_pin);
+  reset();
+  bus = ModbusRTU_acquireBus(port, serial_rx, serial_tx, baudrate, dere_pin);
+
+  if (bus == nullptr) {
+    return false;
+  }
+  this->modbusAddress = modbusAddress;
+  registerMap.setSlaveAddress(modbusAddress);
+  detected_device_description = bus->detectDevice(modbusAddress);
+  return true;
+}
+
+void P108_data_struct::initRegisterMap(struct EventStruct *event) {
+  registerMap.clear();
+
+  for (int i = 0; i < P108_NR_OUTPUT_VALUES; ++i) {
+    p108_addQueryRegisters(registerMap, PCONFIG(i + P108_QUERY1_CONFIG_POS));
+  }
+  registerMap.build();
 }
 
 
@@ -46,56 +68,71 @@ int p108_storageValueToBaudrate(uint8_t baudrate_setting) {
   return 9600;
 }
 
-float p108_readValue(uint8_t query, struct EventStruct *event) {
-  uint8_t errorcode           = -1;   // DF - not present in P085
-  float   value               = 0.0f; // DF - not present in P085
-  P108_data_struct *P108_data =
-    static_cast<P108_data_struct *>(getPluginTaskData(event->TaskIndex));
-
-  if ((nullptr != P108_data) && P108_data->isInitialized()) {
-    switch (query) {
-      case P108_QUERY_V:
-        value = P108_data->modbus.readHoldingRegister(0x0C, errorcode) / 10.0f;  // 0.1 V => V
-        break;
-      case P108_QUERY_A:
-        value = P108_data->modbus.readHoldingRegister(0x0D, errorcode) / 100.0f; // 0.01 A => A
-        break;
-      case P108_QUERY_W:
-        value =  P108_data->modbus.readHoldingRegister(0x0E, errorcode);
-
-        if (value > 32767) { value -= 65535; }
-        break;
-      case P108_QUERY_VA:
-        value = P108_data->modbus.readHoldingRegister(0x0F, errorcode);
-
-        if (value > 32767) { value -= 65535; }
-        break;
-      case P108_QUERY_PF:
-        value = P108_data->modbus.readHoldingRegister(0x10, errorcode) / 1000.0f; // 0.001 Pf => Pf
-        break;
-      case P108_QUERY_F:
-        value = P108_data->modbus.readHoldingRegister(0x11, errorcode) / 100.0f;  // 0.01 Hz => Hz
-        break;
-      case P108_QUERY_Wh_imp:
-        return P108_data->modbus.read_32b_HoldingRegister(0x0A) * 10.0f;          // 0.01 kWh => Wh
-        break;
-      case P108_QUERY_Wh_exp:
-        return P108_data->modbus.read_32b_HoldingRegister(0x08) * 10.0f;          // 0.01 kWh => Wh
-        break;
-      case P108_QUERY_Wh_tot:
-        return P108_data->modbus.read_32b_HoldingRegister(0x00) * 10.0f;          // 0.01 kWh => Wh
-        break;
+// Holding register of the query, energy values use 2 registers
+static uint16_t p108_getQueryRegister(uint8_t query, uint8_t& nrRegisters) {
+  nrRegisters = 1;
+
+  switch (query) {
+    case P108_QUERY_V:      return 0x0C;
+    case P108_QUERY_A:      return 0x0D;
+    case P108_QUERY_W:      return 0x0E;
+    case P108_QUERY_VA:     return 0x0F;
+    case P108_QUERY_PF:     return 0x10;
+    case P108_QUERY_F:      return 0x11;
+    case P108_QUERY_Wh_imp: nrRegisters = 2; return 0x0A;
+    case P108_QUERY_Wh_exp: nrRegisters = 2; return 0x08;
+    case P108_QUERY_Wh_tot: nrRegisters = 2; return 0x00;
+  }
+  nrRegisters = 0;
+  return 0;
+}
+
+void p108_addQueryRegisters(ModbusRTU_RegisterMap& registerMap, uint8_t query) {
+  uint8_t nrRegisters = 0;
+  const uint16_t reg  = p108_getQueryRegister(query, nrRegisters);
+
+  registerMap.addRegisters(MODBUS_READ_HOLDING_REGISTERS, reg, nrRegisters);
+}
+
+float p108_decodeValue(uint8_t query, const ModbusRTU_RegisterMap& registerMap) {
+  uint8_t  nrRegisters = 0;
+  const uint16_t reg   = p108_getQueryRegister(query, nrRegisters);
+  uint16_t value16     = 0;
+  uint32_t value32     = 0;
+
+  if (nrRegisters == 2) {
+    if (registerMap.get32b(MODBUS_READ_HOLDING_REGISTERS, reg, value32)) {
+      return value32 * 10.0f; // 0.01 kWh => Wh
     }
+    return 0.0f;
+  }
+
+  if ((nrRegisters == 0) || !registerMap.getRegister(MODBUS_READ_HOLDING_REGISTERS, reg, value16)) {
+    return 0.0f;
   }
+  float value = value16;
+
+  switch (query) {
+    case P108_QUERY_V:
+      return value / 10.0f;   // 0.1 V => V
+    case P108_QUERY_A:
+      return value / 100.0f;  // 0.01 A => A
+    case P108_QUERY_W:
+    case P108_QUERY_VA:
 
-  if (errorcode == 0) { return value; // DF - not present in P085
+      if (value > 32767) { value -= 65535; }
+      return value;
+    case P108_QUERY_PF:
+      return value / 1000.0f; // 0.001 Pf => Pf
+    case P108_QUERY_F:
+      return value / 100.0f;  // 0.01 Hz => Hz
   }
   return 0.0f;
 }
 
-void p108_showValueLoadPage(uint8_t query, struct EventStruct *event) {
+void p108_showValueLoadPage(uint8_t query, const ModbusRTU_RegisterMap& registerMap) {
   addRowLabel(Plugin_108_valuename(query, true));
-  addHtml(String(p108_readValue(query, event)));
+  addHtml(String(p108_decodeValue(query, registerMap)));
 }
 
 #endif // ifdef USES_P108
@@ -61,10 +61,21 @@ struct P108_data_struct : public PluginTaskData_base {
             uint8_t           modbusAddress);
 
   bool isInitialized() const {
-      return modbus.isInitialized();
+    return bus != nullptr;
   }
 
-  ModbusRTU_struct modbus;
+  // Modbus access for blocking commands to the slave of this task
+  ModbusRTU_struct& modbus() {
+    return bus->selectSlave(modbusAddress);
+  }
+
+  // Collect the registers of the selected output values, so they are read in as few requests as possible
+  void initRegisterMap(struct EventStruct *event);
+
+  ModbusRTU_bus        *bus = nullptr; // Shared with other tasks using the same serial port
+  String                detected_device_description;
+  uint8_t               modbusAddress = 0;
+  ModbusRTU_RegisterMap registerMap;
 };
 
 
@@ -73,11 +84,14 @@ const __FlashStringHelper* Plugin_108_valuename(uint8_t value_nr,
 
 int                        p108_storageValueToBaudrate(uint8_t baudrate_setting);
 
-float                      p108_readValue(uint8_t             query,
-                                          struct EventStruct *event);
+void                       p108_addQueryRegisters(ModbusRTU_RegisterMap& registerMap,
+                                                  uint8_t                query);
+
+float                      p108_decodeValue(uint8_t                      query,
+                                            const ModbusRTU_RegisterMap& registerMap);
 
-void                       p108_showValueLoadPage(uint8_t             query,
-                                                  struct EventStruct *event);
+void                       p108_showValueLoadPage(uint8_t                      query,
+                                                  const ModbusRTU_RegisterMap& registerMap);
 
 #endif // ifdef USES_P108
 #endif // ifndef PLUGINSTRUCTS_P108_DATA_STRUCT_H
@@ -10,11 +10,15 @@
 # include <MFRC522.h>
 
 P111_data_struct::P111_data_struct(int8_t csPin,
-                                   int8_t rstPin)
-  : mfrc522(nullptr), _csPin(csPin), _rstPin(rstPin)
+                                   int8_t rstPin,
+                                   int8_t irqPin)
+  : mfrc522(nullptr), _csPin(csPin), _rstPin(rstPin), _irqPin(irqPin)
 {}
 
 P111_data_struct::~P111_data_struct() {
+  if (validGpio(_irqPin)) {
+    detachInterrupt(digitalPinToInterrupt(_irqPin));
+  }
   delete mfrc522;
   mfrc522 = nullptr;
 }
@@ -27,9 +31,39 @@ void P111_data_struct::init() {
   if (mfrc522 != nullptr) {
     mfrc522->PCD_Init();                                 // Initialize MFRC522 reader
     initPhase = P111_initPhases::Ready;
+
+    if (validGpio(_irqPin)) {
+      pinMode(_irqPin, INPUT_PULLUP);
+      enableIRQ();
+      attachInterruptArg(digitalPinToInterrupt(_irqPin),
+                         reinterpret_cast<void (*)(void *)>(P111_irq_handler),
+                         this,
+                         FALLING);
+    }
+  }
+}
+
+void P111_data_struct::enableIRQ() {
+  if (validGpio(_irqPin) && (mfrc522 != nullptr)) {
+    // IRqInv (IRQ pin active low) + RxIEn
+    mfrc522->PCD_WriteRegister(MFRC522::ComIEnReg, 0xA0);
+    mfrc522->PCD_WriteRegister(MFRC522::ComIrqReg, 0x7F); // Clear all interrupt flags
   }
 }
 
+void P111_data_struct::activateReception() {
+  mfrc522->PCD_WriteRegister(MFRC522::CommandReg, MFRC522::PCD_Idle);    // Stop any active command
+  mfrc522->PCD_WriteRegister(MFRC522::ComIrqReg, 0x7F);                  // Clear all interrupt flags
+  mfrc522->PCD_WriteRegister(MFRC522::FIFOLevelReg, 0x80);               // Flush the FIFO
+  mfrc522->PCD_WriteRegister(MFRC522::FIFODataReg, MFRC522::PICC_CMD_REQA);
+  mfrc522->PCD_WriteRegister(MFRC522::CommandReg, MFRC522::PCD_Transceive);
+  mfrc522->PCD_WriteRegister(MFRC522::BitFramingReg, 0x87);              // StartSend, 7 bits for REQA
+}
+
+void IRAM_ATTR P111_data_struct::P111_irq_handler(P111_data_struct *self) {
+  self->_irqTriggered = true;
+}
+
 /**
  * read status and tag
  */
@@ -146,6 +180,9 @@ bool P111_data_struct::reset(int8_t csPin,
 
   bool result = mfrc522->PCD_PerformSelfTest(); // perform the test
 
+  // Init and self test do a soft reset, which also clears the interrupt configuration.
+  enableIRQ();
+
   if (result) {
     // String log = F("RC522: Found");
     // Get the MFRC522 software version
@@ -188,9 +225,11 @@ bool P111_data_struct::reset(int8_t csPin,
 uint8_t P111_data_struct::readPassiveTargetID(uint8_t *uid,
                                               uint8_t *uidLength) { // needed ? see above (not PN532)
   // Getting ready for Reading PICCs
-  if (!mfrc522->PICC_IsNewCardPresent()) {                          // If a new PICC placed to RFID reader continue
+  // A card which answered the REQA of activateReception() is already in READY state, and won't answer a new REQA.
+  if (!_cardPresent && !mfrc522->PICC_IsNewCardPresent()) {         // If a new PICC placed to RFID reader continue
     return P111_ERROR_NO_TAG;
   }
+  _cardPresent = false;
   addLog(LOG_LEVEL_INFO, F("MFRC522: New Card Detected"));
 
   if (!mfrc522->PICC_ReadCardSerial()) { // Since a PICC placed get Serial and continue
@@ -225,10 +264,30 @@ bool P111_data_struct::plugin_ten_per_second(struct EventStruct *event) {
     return success;
   }
 
-  counter++;          // This variable replaces a static variable in the original implementation
+  bool doRead = false;
+
+  if (validGpio(_irqPin)) {
+    // Only read the card when it answered a REQA, or as a slow heartbeat poll.
+    if (_irqTriggered) {
+      _irqTriggered = false;
+      _cardPresent  = (mfrc522->PCD_ReadRegister(MFRC522::ComIrqReg) & 0x20) != 0; // RxIRq
+      doRead        = _cardPresent;
+    }
+
+    if (!doRead && (timePassedSince(_lastPoll) >= P111_IRQ_HEARTBEAT)) {
+      doRead = true;
+    }
+  } else {
+    counter++;          // This variable replaces a static variable in the original implementation
+
+    if (counter == 3) { // Only every 3rd 0.1 second we do a read
+      counter = 0;
+      doRead  = true;
+    }
+  }
 
-  if (counter == 3) { // Only every 3rd 0.1 second we do a read
-    counter = 0;
+  if (doRead) {
+    _lastPoll = millis();
 
     uint32_t key        = P111_NO_KEY;
     bool     removedTag = false;
@@ -274,6 +333,13 @@ bool P111_data_struct::plugin_ten_per_second(struct EventStruct *event) {
       success = true;
     }
   }
+
+  if (validGpio(_irqPin) && (initPhase == P111_initPhases::Ready)) {
+    // Reading the card also triggers the IRQ pin, so ignore that and start a new detection.
+    _irqTriggered = false;
+    _cardPresent  = false;
+    activateReception();
+  }
   return success;
 }
 
@@ -8,6 +8,7 @@
 
 # define P111_CS_PIN            PIN(0)
 # define P111_RST_PIN           PIN(1)
+# define P111_IRQ_PIN           PIN(2)
 # define P111_TAG_AUTOREMOVAL   PCONFIG(0)
 # define P111_SENDRESET         PCONFIG(1)
 # define P111_REMOVALVALUE      PCONFIG_LONG(0)
@@ -20,6 +21,11 @@
 
 # define P111_NO_KEY           0xFFFFFFFF
 
+// With the IRQ pin connected, a full card poll is still done at this interval, in case an interrupt is missed.
+# ifndef P111_IRQ_HEARTBEAT
+#  define P111_IRQ_HEARTBEAT    5000 // msec
+# endif // ifndef P111_IRQ_HEARTBEAT
+
 // #define P111_USE_REMOVAL      // Enable (real) Tag Removal detection options (but that won't work with MFRC522 reader)
 
 enum class P111_initPhases : uint8_t {
@@ -31,7 +37,8 @@ enum class P111_initPhases : uint8_t {
 
 struct P111_data_struct : public PluginTaskData_base {
   P111_data_struct(int8_t csPin,
-                   int8_t rstPin);
+                   int8_t rstPin,
+                   int8_t irqPin = -1);
   P111_data_struct() = delete;
   virtual ~P111_data_struct();
 
@@ -53,10 +60,23 @@ private:
   uint8_t readPassiveTargetID(uint8_t *uid,
                               uint8_t *uidLength);
 
+  // Interrupt on received data, the IRQ pin is active low
+  void    enableIRQ();
+
+  // Send a REQA without waiting for the answer, a card answering will trigger the IRQ pin.
+  void    activateReception();
+
+  static void P111_irq_handler(P111_data_struct *self);
+
   int32_t timeToWait = 0;
 
   int8_t _csPin;
   int8_t _rstPin;
+  int8_t _irqPin;
+
+  volatile bool _irqTriggered = false;
+  bool          _cardPresent  = false; // Card answered the REQA sent by activateReception()
+  uint32_t      _lastPoll     = 0;
 
   uint8_t         errorCount   = 0;
   bool            removedState = true; // On startup, there will usually not be a tag nearby
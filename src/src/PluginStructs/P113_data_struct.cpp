@@ -51,6 +51,19 @@ bool P113_data_struct::begin() {
   return initState;
 }
 
+// **************************************************************************/
+// Use the GPIO1 output of the sensor to signal a new measurement
+// **************************************************************************/
+bool P113_data_struct::enableDataReadyPin(taskIndex_t taskIndex, int8_t intPin) {
+  if (!initState || !validGpio(intPin)) {
+    return false;
+  }
+
+  // Active low, as most breakout boards have a pull-up on GPIO1
+  sensor->setInterruptPolarityLow();
+  return dataReadyPin_enable(taskIndex, intPin, FALLING);
+}
+
 bool P113_data_struct::startRead() {
   if (initState && !readActive && (nullptr != sensor)) {
     sensor->startRanging();
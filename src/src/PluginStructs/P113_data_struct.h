@@ -18,6 +18,8 @@
 # include <Wire.h>
 # include <SparkFun_VL53L1X.h>
 
+# define P113_INT_PIN      CONFIG_PIN1
+
 struct P113_data_struct : public PluginTaskData_base {
 public:
 
@@ -28,6 +30,8 @@ public:
   virtual ~P113_data_struct();
 
   bool     begin();
+  bool     enableDataReadyPin(taskIndex_t taskIndex,
+                              int8_t      intPin);
   bool     startRead();
   bool     readAvailable();
   uint16_t readDistance();
@@ -227,6 +227,9 @@ bool P116_data_struct::plugin_init(struct EventStruct *event) {
 
       gfxHelper->initialize();
       gfxHelper->setRotation(_rotation);
+      # if ADAGFX_ENABLE_DRAW_CACHE
+      gfxHelper->setDrawCache(true);            // Don't send unchanged text over SPI again
+      # endif // if ADAGFX_ENABLE_DRAW_CACHE
       st77xx->fillScreen(_bgcolor);             // fill screen with black color
       st77xx->setTextColor(_fgcolor, _bgcolor); // set text color to white and black background
 
@@ -384,7 +387,14 @@ bool P116_data_struct::plugin_write(struct EventStruct *event,
       displayOnOff(true);
     }
     else if (equals(arg1, F("clear"))) {
-      st77xx->fillScreen(_bgcolor);
+      if (nullptr != gfxHelper) {
+        gfxHelper->fillScreen(_bgcolor); // Uses the line buffer, if available
+        # if ADAGFX_ENABLE_DRAW_CACHE
+        gfxHelper->invalidateDrawCache();
+        # endif // if ADAGFX_ENABLE_DRAW_CACHE
+      } else {
+        st77xx->fillScreen(_bgcolor);
+      }
     }
     else if (equals(arg1, F("backlight"))) {
       String arg2 = parseString(string, 3);
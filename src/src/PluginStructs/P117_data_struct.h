@@ -9,6 +9,7 @@
 # define P117_TEMPERATURE_OFFSET  PCONFIG_FLOAT(0)
 # define P117_AUTO_CALIBRATION    PCONFIG(1)
 # define P117_MEASURE_INTERVAL    PCONFIG(2)
+# define P117_RDY_PIN             CONFIG_PIN1
 
 struct P117_data_struct : public PluginTaskData_base {
 public:
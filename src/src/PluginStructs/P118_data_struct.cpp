@@ -123,9 +123,23 @@ bool P118_data_struct::plugin_once_a_second(struct EventStruct *event) {
 }
 
 bool P118_data_struct::plugin_fifty_per_second(struct EventStruct *event) {
-  if (_Int) {
-    ITHOcheck();
-    _Int = false; // reset flag
+  if (!isInitialized()) {
+    return false;
+  }
+
+  // First empty the RX fifo, as it only holds a single packet and the next packet would overflow it.
+  if (_IntCount != _IntHandled) {
+    // Take the count before reading, a packet received meanwhile will be handled on the next call
+    _IntHandled = _IntCount;
+    ITHOreceive();
+  }
+
+  // Decode and handle at most 1 buffered packet per call
+  if (_packetTail != _packetHead) {
+    const uint8_t index = _packetTail;
+
+    _packetTail = (_packetTail + 1) % P118_PACKET_BUFFER_SIZE;
+    ITHOcheck(_packets[index]);
   }
 
   return true;
@@ -396,7 +410,28 @@ bool P118_data_struct::plugin_write(struct EventStruct *event, const String& str
   return success;
 }
 
-void P118_data_struct::ITHOcheck() {
+void P118_data_struct::ITHOreceive() {
+  // The slot at head is always free
+  if (!_rf->receivePacket(&_packets[_packetHead])) {
+    return;
+  }
+  _packetHead = (_packetHead + 1) % P118_PACKET_BUFFER_SIZE;
+
+  if (_packetHead == _packetTail) {
+    // Buffer full, drop the oldest packet
+    _packetTail = (_packetTail + 1) % P118_PACKET_BUFFER_SIZE;
+    ++_packetsLost;
+
+    # ifndef BUILD_NO_DEBUG
+
+    if (_log && loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+      addLogMove(LOG_LEVEL_DEBUG, strformat(F("ITHO: Receive buffer full, packets lost: %u"), static_cast<unsigned int>(_packetsLost)));
+    }
+    # endif // ifndef BUILD_NO_DEBUG
+  }
+}
+
+void P118_data_struct::ITHOcheck(const CC1101Packet& packet) {
   bool _dbgLog = _log
   # ifndef BUILD_NO_DEBUG
                  && loglevelActiveFor(LOG_LEVEL_DEBUG)
@@ -410,7 +445,7 @@ void P118_data_struct::ITHOcheck() {
   }                                                      // reduce log clutter when many RF sources are present
   # endif // ifndef BUILD_NO_DEBUG
 
-  if (_rf->checkForNewPacket()) {
+  if (_rf->parsePacket(&packet)) {
     IthoCommand cmd = _rf->getLastCommand();
     String Id       = _rf->getLastIDstr();
 
@@ -658,7 +693,7 @@ void P118_data_struct::PluginWriteLog(const String& command) {
 // Interrupt handler
 // **************************************************************************/
 void P118_data_struct::ISR_ithoCheck(P118_data_struct *self) {
-  self->_Int = true;
+  self->_IntCount++;
 }
 
 # if P118_FEATURE_ORCON
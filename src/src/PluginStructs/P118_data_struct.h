@@ -27,6 +27,10 @@
 
 # define P118_TIMEOUT_LIMIT   5000 // If initialization takes > 5 seconds, most likely the hardware is not correctly connected
 
+# ifndef P118_PACKET_BUFFER_SIZE
+#  define P118_PACKET_BUFFER_SIZE  4 // Received packets waiting to be decoded, 1 less than the size
+# endif // ifndef P118_PACKET_BUFFER_SIZE
+
 # define P118_CSPIN           PIN(1)
 # define P118_IRQPIN          PIN(0)
 # define P118_CONFIG_LOG      PCONFIG(0)
@@ -78,7 +82,8 @@ public:
 
 private:
 
-  void ITHOcheck();
+  void ITHOreceive();
+  void ITHOcheck(const CC1101Packet& packet);
   void PublishData(struct EventStruct *event);
   void PluginWriteLog(const String& command);
 
@@ -96,7 +101,6 @@ private:
   IthoCC1101 *_rf = nullptr;
 
   // extra for interrupt handling
-  bool _ITHOhasPacket  = false;
   int  _State          = 1; // after startup it is assumed that the fan is running low
   int  _OldState       = 1;
   int  _Timer          = 0;
@@ -111,7 +115,15 @@ private:
 
   PLUGIN_118_ExtraSettingsStruct _ExtraSettings;
 
-  volatile bool _Int = false;
+  // Incremented by the ISR on every received packet (GDO2 falling edge)
+  volatile uint8_t _IntCount   = 0;
+  uint8_t          _IntHandled = 0;
+
+  // Packets copied from the CC1101 RX fifo, not yet decoded
+  CC1101Packet _packets[P118_PACKET_BUFFER_SIZE];
+  uint8_t      _packetHead  = 0;
+  uint8_t      _packetTail  = 0;
+  uint32_t     _packetsLost = 0;
 
   static void ISR_ithoCheck(P118_data_struct *self) ICACHE_RAM_ATTR;
 };
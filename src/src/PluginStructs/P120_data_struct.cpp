@@ -4,6 +4,14 @@
 
 # define P120_RAD_TO_DEG        57.295779f // 180.0/M_PI
 
+static uint8_t P120_get_fifo_rate(struct EventStruct *event) {
+  const uint8_t rate = get8BitFromUL(P120_CONFIG_FLAGS3, P120_FLAGS3_FIFO_RATE);
+
+  if ((rate < P120_FIFO_RATE_100) || (rate > P120_FIFO_RATE_800)) {
+    return P120_DEFAULT_FIFO_RATE;
+  }
+  return rate;
+}
 
 P120_data_struct::P120_data_struct(uint8_t aSize)
   : _aSize(aSize)
@@ -73,20 +81,15 @@ bool P120_data_struct::read_sensor(struct EventStruct *event) {
   }
 
   if (initialized()) {
-    _x = 0; _y = 0; _z = 0;
-    adxl345->readAccel(&_x, &_y, &_z);
-    _XA[_aUsed] = _x;
-    _YA[_aUsed] = _y;
-    _ZA[_aUsed] = _z;
-
-    _aUsed++;
-
-    if ((_aMax < _aUsed) && (_aUsed < _aSize)) {
-      _aMax = _aUsed;
-    }
-
-    if (_aUsed == _aSize) {
-      _aUsed = 0;
+    if (_fifoMode) {
+      if (!read_fifo(event)) {
+        return true; // Nothing to process yet
+      }
+    } else {
+      _x = 0; _y = 0; _z = 0;
+      adxl345->readAccel(&_x, &_y, &_z);
+      add_average(_x, _y, _z);
+      add_vibration_sample(_x, _y, _z);
     }
 
     # if PLUGIN_120_DEBUG
@@ -110,10 +113,114 @@ bool P120_data_struct::read_sensor(struct EventStruct *event) {
   return false;
 }
 
+// **************************************************************************/
+// Read all samples from the FIFO, when the watermark is reached or the measuring interval has passed
+// **************************************************************************/
+bool P120_data_struct::read_fifo(struct EventStruct *event) {
+  const uint32_t interval = (P120_FREQUENCY == P120_FREQUENCY_50) ? 20 : 100;
+
+  if ((adxl345->getFIFOEntries() < P120_FIFO_WATERMARK) && !timeOutReached(_fifoTimer + interval)) {
+    return false;
+  }
+  _fifoTimer = millis();
+
+  int16_t xyz[ADXL345_FIFO_SIZE * 3];
+  const uint8_t entries = adxl345->readFIFO(xyz, ADXL345_FIFO_SIZE);
+
+  if (entries == 0) {
+    return false;
+  }
+  int32_t sumX = 0, sumY = 0, sumZ = 0;
+
+  for (uint8_t i = 0; i < entries; ++i) {
+    const int16_t *sample = &xyz[i * 3];
+    sumX += sample[0];
+    sumY += sample[1];
+    sumZ += sample[2];
+    add_vibration_sample(sample[0], sample[1], sample[2]);
+  }
+
+  // The events use the last sample, the averaging buffer the mean of the batch
+  const int16_t *last = &xyz[(entries - 1) * 3];
+
+  _x = last[0];
+  _y = last[1];
+  _z = last[2];
+  add_average(sumX / entries, sumY / entries, sumZ / entries);
+  return true;
+}
+
+void P120_data_struct::add_average(int x, int y, int z) {
+  _XA[_aUsed] = x;
+  _YA[_aUsed] = y;
+  _ZA[_aUsed] = z;
+
+  _aUsed++;
+
+  if ((_aMax < _aUsed) && (_aUsed < _aSize)) {
+    _aMax = _aUsed;
+  }
+
+  if (_aUsed == _aSize) {
+    _aUsed = 0;
+  }
+}
+
+void P120_data_struct::add_vibration_sample(int x, int y, int z) {
+  const float length = sqrtf(static_cast<float>(x * x + y * y + z * z));
+
+  if (_vibCount == 0) {
+    _vibRef   = length;
+    _vibSum   = 0.0f;
+    _vibSumSq = 0.0f;
+    _vibMin   = length;
+    _vibMax   = length;
+  }
+  const float delta = length - _vibRef;
+
+  _vibSum   += delta;
+  _vibSumSq += delta * delta;
+
+  if (length < _vibMin) {
+    _vibMin = length;
+  } else if (length > _vibMax) {
+    _vibMax = length;
+  }
+  ++_vibCount;
+}
+
+void P120_data_struct::clear_vibration_stats() {
+  _vibCount = 0;
+}
+
+bool P120_data_struct::get_vibration(float& rms, float& peak) const
+{
+  rms  = 0.0f;
+  peak = 0.0f;
+
+  if (_vibCount == 0) {
+    return false;
+  }
+  const float mean     = _vibSum / _vibCount;
+  const float variance = (_vibSumSq / _vibCount) - (mean * mean);
+
+  if (variance > 0.0f) {
+    rms = sqrtf(variance);
+  }
+  const float meanLength = _vibRef + mean;
+
+  peak = _vibMax - meanLength;
+
+  if ((meanLength - _vibMin) > peak) {
+    peak = meanLength - _vibMin;
+  }
+  return true;
+}
+
 // **************************************************************************/
 // Average the measurements and return the results
 // **************************************************************************/
-bool P120_data_struct::read_data(struct EventStruct *event) const
+bool P120_data_struct::read_data(struct EventStruct *event)
 {
   float pitch, roll;
 
@@ -136,6 +243,10 @@ bool P120_data_struct::read_data(struct EventStruct *event) const
   }
   last_scale_factor_g = scaleFactor_g;
 
+  float rms, peak;
+
+  get_vibration(rms, peak);
+
   const uint8_t valueCount = P120_NR_OUTPUT_VALUES;
 
   for (uint8_t i = 0; i < VARS_PER_TASK; ++i) {
@@ -170,6 +281,12 @@ bool P120_data_struct::read_data(struct EventStruct *event) const
         case valueType::Roll:
           value = roll;
           break;
+        case valueType::RMS_g:
+          value = rms / scaleFactor_g;
+          break;
+        case valueType::Peak_g:
+          value = peak / scaleFactor_g;
+          break;
         case valueType::NR_ValueTypes:
           break;
       }
@@ -327,6 +444,17 @@ bool P120_data_struct::init_sensor(struct EventStruct *event) {
       adxl345->setFreeFallDuration(0);
     }
 
+    // FIFO, in stream mode the sensor keeps the last 32 samples
+    _fifoMode = bitRead(P120_CONFIG_FLAGS1, P120_FLAGS1_FIFO_MODE);
+
+    if (_fifoMode) {
+      adxl345->set_bw(P120_get_fifo_rate(event));
+      adxl345->setFIFOMode(ADXL345_FIFO_MODE_STREAM, P120_FIFO_WATERMARK);
+    } else {
+      adxl345->set_bw(P120_FIFO_RATE_100); // Power-on default
+      adxl345->setFIFOMode(ADXL345_FIFO_MODE_BYPASS, 0);
+    }
+
     // Enable interrupts
     adxl345->setImportantInterruptMapping(singleTap, doubleTap, freeFall, act, act);
     adxl345->ActivityINT(act);
@@ -639,6 +767,18 @@ bool P120_data_struct::plugin_webform_load(struct EventStruct *event) {
     addFormSelector(F("Measuring frequency"), F("frequency"), 2, frequencyOptions, frequencyValues, P120_FREQUENCY);
     addUnit(F("Hz"));
     addFormNote(F("Values X/Y/Z are updated 1x per second, Controller updates &amp; Value-events are based on 'Interval' setting."));
+
+    addFormCheckBox(F("Use FIFO"), F("fifo"), bitRead(P120_CONFIG_FLAGS1, P120_FLAGS1_FIFO_MODE) == 1);
+
+    const __FlashStringHelper *rateOptions[] = {
+      F("100"),
+      F("200"),
+      F("400"),
+      F("800") };
+    int rateValues[] = { P120_FIFO_RATE_100, P120_FIFO_RATE_200, P120_FIFO_RATE_400, P120_FIFO_RATE_800 };
+    addFormSelector(F("FIFO output data rate"), F("fifo_rate"), 4, rateOptions, rateValues, P120_get_fifo_rate(event));
+    addUnit(F("Hz"));
+    addFormNote(F("With FIFO, all samples are collected by the sensor and read in bursts. Vibration RMS/peak values cover all samples since the previous 'Interval'."));
   }
 
   return true;
@@ -672,6 +812,7 @@ bool P120_data_struct::plugin_webform_save(struct EventStruct *event) {
   bitWrite(flags, P120_FLAGS1_LOG_ACTIVITY,     isFormItemChecked(F("log_act")));
   bitWrite(flags, P120_FLAGS1_EVENT_RAW_VALUES, isFormItemChecked(F("raw_measure")));
   bitWrite(flags, P120_FLAGS1_ANGLE_IN_RAD,     getFormItemInt(F("angle_rad")));
+  bitWrite(flags, P120_FLAGS1_FIFO_MODE,        isFormItemChecked(F("fifo")));
   set8BitToUL(flags, P120_FLAGS1_ACTIVITY_TRESHOLD,   getFormItemInt(F("act_thres")));
   set8BitToUL(flags, P120_FLAGS1_INACTIVITY_TRESHOLD, getFormItemInt(F("inact_thres")));
   P120_CONFIG_FLAGS1 = flags;
@@ -686,6 +827,7 @@ bool P120_data_struct::plugin_webform_save(struct EventStruct *event) {
   flags = 0ul;
   set8BitToUL(flags, P120_FLAGS3_FREEFALL_TRESHOLD, getFormItemInt(F("fr_fall_thres")));
   set8BitToUL(flags, P120_FLAGS3_FREEFALL_DURATION, getFormItemInt(F("fr_fall_dur")));
+  set8BitToUL(flags, P120_FLAGS3_FIFO_RATE,         getFormItemInt(F("fifo_rate")));
   P120_CONFIG_FLAGS3 = flags;
 
   flags = 0ul;
@@ -721,6 +863,7 @@ bool P120_data_struct::plugin_set_defaults(struct EventStruct *event) {
   flags = 0ul;
   set8BitToUL(flags, P120_FLAGS3_FREEFALL_TRESHOLD, P120_DEFAULT_FREEFALL_TRESHOLD);
   set8BitToUL(flags, P120_FLAGS3_FREEFALL_DURATION, P120_DEFAULT_FREEFALL_DURATION);
+  set8BitToUL(flags, P120_FLAGS3_FIFO_RATE,         P120_DEFAULT_FIFO_RATE);
   P120_CONFIG_FLAGS3 = flags;
 
   flags = 0ul;
@@ -793,6 +936,8 @@ const __FlashStringHelper * P120_data_struct::valuename(uint8_t value_nr, bool d
     case valueType::Z_g:      return displayString ? F("Z (g)") : F("Z");
     case valueType::Pitch:    return displayString ? F("Pitch Angle") : F("Pitch");
     case valueType::Roll:     return displayString ? F("Roll Angle")  : F("Roll");
+    case valueType::RMS_g:    return displayString ? F("Vibration RMS (g)") : F("RMS");
+    case valueType::Peak_g:   return displayString ? F("Vibration peak (g)") : F("Peak");
     case valueType::NR_ValueTypes:
       break;
   }
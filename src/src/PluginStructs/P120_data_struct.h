@@ -41,6 +41,7 @@
 # define P120_FLAGS1_LOG_ACTIVITY         11   // Log activity at INFO level
 # define P120_FLAGS1_EVENT_RAW_VALUES     12   // Events use direct raw sensorvalues
 # define P120_FLAGS1_ANGLE_IN_RAD         13   // Whether to output angles in radians or degrees
+# define P120_FLAGS1_FIFO_MODE            14   // Read all samples via the FIFO of the sensor
 # define P120_FLAGS1_ACTIVITY_TRESHOLD    16   // Activity treshold, 8 bits
 # define P120_DEFAULT_ACTIVITY_TRESHOLD     75 // Default treshold: 75 * 62.5 mg = 4.6875 g
 # define P120_FLAGS1_INACTIVITY_TRESHOLD  24   // Inactivity treshold, 8 bits
@@ -63,6 +64,13 @@
 # define P120_DEFAULT_FREEFALL_TRESHOLD     7  // Default treshold: 7 * 62.5 mg = 0.4375 g
 # define P120_FLAGS3_FREEFALL_DURATION    8
 # define P120_DEFAULT_FREEFALL_DURATION     30 // Default duration: 30 * 5 ms = .15 sec
+# define P120_FLAGS3_FIFO_RATE            16   // Output data rate in FIFO mode, BW_RATE register code
+# define P120_FIFO_RATE_100                 0x0A
+# define P120_FIFO_RATE_200                 0x0B
+# define P120_FIFO_RATE_400                 0x0C
+# define P120_FIFO_RATE_800                 0x0D
+# define P120_DEFAULT_FIFO_RATE             P120_FIFO_RATE_200
+# define P120_FIFO_WATERMARK                16 // Read the FIFO when half full, or when the measuring interval has passed
 
 // Fourth set of configuration flags, Axis Offset settings
 # define P120_CONFIG_FLAGS4               PCONFIG_LONG(3)
@@ -73,7 +81,7 @@
 # define P120_QUERY1_CONFIG_POS  4
 # define P120_SENSOR_TYPE_INDEX  0
 # define P120_NR_OUTPUT_VALUES   getValueCountFromSensorType(static_cast<Sensor_VType>(PCONFIG(P120_SENSOR_TYPE_INDEX)))
-# define P120_NR_OUTPUT_OPTIONS  9
+# define P120_NR_OUTPUT_OPTIONS  11
 
 
 
@@ -90,6 +98,8 @@ public:
     Z_g   = 6,
     Pitch = 7,
     Roll  = 8,
+    RMS_g  = 9,  // RMS of the acceleration vector length around its mean, since last PLUGIN_READ
+    Peak_g = 10, // Max. deviation of the acceleration vector length from its mean, since last PLUGIN_READ
 
     NR_ValueTypes // keep as last
   };
@@ -105,13 +115,18 @@ public:
 
   bool read_sensor(struct EventStruct *event);
 
-  bool read_data(struct EventStruct *event) const;
+  bool read_data(struct EventStruct *event);
+
+  void clear_vibration_stats();
 
 private:
   bool get_XYZ(float& X,
                float& Y,
                float& Z) const;
 
+  bool get_vibration(float& rms,
+                     float& peak) const;
+
 
 public:
 
@@ -138,6 +153,13 @@ public:
 private:
 
   bool init_sensor(struct EventStruct *event);
+  bool read_fifo(struct EventStruct *event);
+  void add_average(int x,
+                   int y,
+                   int z);
+  void add_vibration_sample(int x,
+                            int y,
+                            int z);
   void sensor_check_interrupt(struct EventStruct *event);
   void appendPayloadXYZ(struct EventStruct *event,
                         String            & payload,
@@ -165,6 +187,18 @@ private:
   bool activityTriggered   = false;
   bool inactivityTriggered = false;
   bool i2c_mode            = false;
+  bool _fifoMode           = false;
+
+  uint32_t _fifoTimer = 0;
+
+  // Statistics of the acceleration vector length of all samples since the last clear.
+  // Sums are relative to the first sample to keep float rounding errors small.
+  uint32_t _vibCount = 0;
+  float    _vibRef   = 0.0f;
+  float    _vibSum   = 0.0f;
+  float    _vibSumSq = 0.0f;
+  float    _vibMin   = 0.0f;
+  float    _vibMax   = 0.0f;
 };
 
 #endif // if defined(USES_P120) || defined(USES_P125)
@@ -8,9 +8,15 @@
 P126_data_struct::P126_data_struct(int8_t  dataPin,
                                    int8_t  clockPin,
                                    int8_t  latchPin,
-                                   uint8_t chipCount)
+                                   uint8_t chipCount,
+                                   bool    useHardwareSPI)
   : _dataPin(dataPin), _clockPin(clockPin), _latchPin(latchPin), _chipCount(chipCount) {
-  shift = new (std::nothrow) ShiftRegister74HC595_NonTemplate(_chipCount, _dataPin, _clockPin, _latchPin);
+  if (useHardwareSPI) {
+    // The whole chain is sent in a single SPI transfer
+    shift = new (std::nothrow) ShiftRegister74HC595_NonTemplate(_chipCount, SPI, _latchPin);
+  } else {
+    shift = new (std::nothrow) ShiftRegister74HC595_NonTemplate(_chipCount, _dataPin, _clockPin, _latchPin);
+  }
 }
 
 // **************************************************************************/
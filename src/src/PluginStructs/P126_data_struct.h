@@ -20,12 +20,14 @@
 # define P126_FLAGS_VALUES_DISPLAY    0 // 0/off = HEX, 1/on = BIN
 // Restore values from RTC after warm boot (default enabled, inverted logic)
 # define P126_FLAGS_VALUES_RESTORE    1
+# define P126_FLAGS_USE_HW_SPI        2 // Use hardware SPI MOSI/SCK instead of Data/Clock pins
 // 0 = decimal & hex/bin, 1 = Decimal, 2 = hex/bin
 # define P126_FLAGS_OUTPUT_SELECTION  4
 
 # define P126_CONFIG_FLAGS_GET_VALUES_DISPLAY (bitRead(P126_CONFIG_FLAGS, P126_FLAGS_VALUES_DISPLAY))
 # define P126_CONFIG_FLAGS_GET_VALUES_RESTORE (bitRead(P126_CONFIG_FLAGS, P126_FLAGS_VALUES_RESTORE) == 0) // Inverted logic
 # define P126_CONFIG_FLAGS_GET_OUTPUT_SELECTION (get4BitFromUL(P126_CONFIG_FLAGS, P126_FLAGS_OUTPUT_SELECTION))
+# define P126_CONFIG_FLAGS_GET_USE_HW_SPI (bitRead(P126_CONFIG_FLAGS, P126_FLAGS_USE_HW_SPI))
 
 # define P126_OUTPUT_BOTH             0 // Decimal + hex/bin
 # define P126_OUTPUT_DEC_ONLY         1 // Decimal
@@ -53,7 +55,8 @@ public:
   P126_data_struct(int8_t  dataPin,
                    int8_t  clockPin,
                    int8_t  latchPin,
-                   uint8_t chipCount);
+                   uint8_t chipCount,
+                   bool    useHardwareSPI);
 
   P126_data_struct() = delete;
   virtual ~P126_data_struct();
@@ -723,6 +723,14 @@ void P128_data_struct::rgb2colorStr() {
 
 bool P128_data_struct::plugin_fifty_per_second(struct EventStruct *event) {
   counter20ms++;
+
+  if (skipFrames > 0) {
+    // Previous frame took too long, effects stay in time as they are based on counter20ms
+    skipFrames--;
+    return true;
+  }
+  const uint64_t frameStart = getMicros64();
+
   lastmode = mode;
 
   switch (mode) {
@@ -802,6 +810,12 @@ bool P128_data_struct::plugin_fifty_per_second(struct EventStruct *event) {
 
   Plugin_128_pixels->Show();
 
+  const int64_t frameTime = usecPassedSince(frameStart);
+
+  if (frameTime > P128_FRAME_BUDGET_USEC) {
+    skipFrames = std::min(frameTime / P128_FRAME_BUDGET_USEC, static_cast<int64_t>(10));
+  }
+
   if (mode != lastmode) {
     if (loglevelActiveFor(LOG_LEVEL_INFO)) {
       String log = F("NeoPixelBus: Mode Change: ");
@@ -815,21 +829,25 @@ bool P128_data_struct::plugin_fifty_per_second(struct EventStruct *event) {
 
 void P128_data_struct::fade(void) {
   for (int pixel = 0; pixel < pixelCount; pixel++) {
-    long  counter  = 20 * (counter20ms - starttime[pixel]);
-    float progress = (float)counter / (float)fadetime;
-    progress = (progress < 0) ? 0 : progress;
-    progress = (progress > 1) ? 1 : progress;
+    const long counter = 20 * (counter20ms - starttime[pixel]);
 
+    // Progress in 0..255 steps, the 8 bit LinearBlend avoids float math per pixel
     # if defined(RGBW) || defined(GRBW)
-    RgbwColor updatedColor = RgbwColor::LinearBlend(
-      rgb_old[pixel], rgb_target[pixel],
-      progress);
+    RgbwColor updatedColor = rgb_target[pixel];
     # else // if defined(RGBW) || defined(GRBW)
-    RgbColor updatedColor = RgbColor::LinearBlend(
-      rgb_old[pixel], rgb_target[pixel],
-      progress);
+    RgbColor updatedColor = rgb_target[pixel];
     # endif // if defined(RGBW) || defined(GRBW)
 
+    if (counter < static_cast<long>(fadetime)) {
+      const uint8_t progress = (counter > 0) ? (static_cast<uint32_t>(counter) * 255u) / fadetime : 0;
+
+      # if defined(RGBW) || defined(GRBW)
+      updatedColor = RgbwColor::LinearBlend(rgb_old[pixel], rgb_target[pixel], progress);
+      # else // if defined(RGBW) || defined(GRBW)
+      updatedColor = RgbColor::LinearBlend(rgb_old[pixel], rgb_target[pixel], progress);
+      # endif // if defined(RGBW) || defined(GRBW)
+    }
+
     if ((counter20ms > maxtime) && (Plugin_128_pixels->GetPixelColor(pixel).CalculateBrightness() == 0)) {
       mode = P128_modetype::Off;
     } else if (counter20ms > maxtime) {
@@ -992,11 +1010,11 @@ void P128_data_struct::rainbow(void) {
     fadeIn = (progress == 1) ? false : true;
   }
 
+  const uint32_t offset = counter20ms * rainbowspeed / 10;
+
   for (int i = 0; i < pixelCount; i++) {
-    uint8_t r1 = (Wheel(((i * 256 / pixelCount) + counter20ms * rainbowspeed / 10) & 255) >> 16);
-    uint8_t g1 = (Wheel(((i * 256 / pixelCount) + counter20ms * rainbowspeed / 10) & 255) >> 8);
-    uint8_t b1 = (Wheel(((i * 256 / pixelCount) + counter20ms * rainbowspeed / 10) & 255));
-    Plugin_128_pixels->SetPixelColor(i, RgbColor(r1, g1, b1));
+    const uint32_t color = Wheel(((i * 256 / pixelCount) + offset) & 255);
+    Plugin_128_pixels->SetPixelColor(i, RgbColor(color >> 16, color >> 8, color));
   }
   mode = (rainbowspeed == 0) ? P128_modetype::On : P128_modetype::Rainbow;
 }
@@ -1246,12 +1264,11 @@ void P128_data_struct::fire(void) {
   if (counter20ms > fireTimer + 50 / fps) {
     fireTimer = counter20ms;
     Fire2012();
-    RgbColor pixel;
-
     for (int i = 0; i < pixelCount; i++) {
-      pixel = leds[i];
-      pixel = RgbColor::LinearBlend(pixel, RgbColor(0, 0, 0), (255 - brightness) / 255.0f);
-      Plugin_128_pixels->SetPixelColor(i, pixel);
+      // Dim to brightness/255 in integer math
+      Plugin_128_pixels->SetPixelColor(i, RgbColor((leds[i].R * brightness) / 255,
+                                                   (leds[i].G * brightness) / 255,
+                                                   (leds[i].B * brightness) / 255));
     }
   }
 }
@@ -1389,7 +1406,7 @@ void P128_data_struct::fire_flicker() {
     byte b   = 12;  // (SEGMENT.colors[0]        & 0xFF);
     byte lum = max(w, max(r, max(g, b))) / rev_intensity;
 
-    for (uint16_t i = 0; i <= NUMPixels - 1; i++) {
+    for (uint16_t i = 0; i < pixelCount; i++) {
       int flicker = random8(lum);
 
       # if defined(RGBW) || defined(GRBW)
@@ -1422,16 +1439,22 @@ void P128_data_struct::Plugin_128_simpleclock() {
   }
 
 
+  // Hand positions, rounded to the nearest pixel, calculated once per frame
+  const int32_t ticks      = static_cast<int32_t>(Seconds) * 50 + static_cast<int32_t>(counter20ms - maxtime);
+  const int32_t secondsPos = (ticks * pixelCount * 2 + 3000) / 6000;
+  const int32_t minutesPos = ((static_cast<int32_t>(Minutes) * 60 + Seconds) * pixelCount * 2 + 3600) / 7200;
+  const int32_t hoursPos   = ((static_cast<int32_t>(Hours) * 60 + Minutes) * pixelCount * 2 + 720) / 1440;
+
   for (int i = 0; i < pixelCount; i++) {
-    if (lround((((float)Seconds + ((float)counter20ms - (float)maxtime) / 50.0) * (float)pixelCount) / 60.0) == i) {
+    if (secondsPos == i) {
       if (rgb_s_off  == false) {
         Plugin_128_pixels->SetPixelColor(i, rgb_s);
       }
     }
-    else if (lround((((float)Minutes * 60.0) + (float)Seconds) / 60.0 * (float)pixelCount / 60.0) == i) {
+    else if (minutesPos == i) {
       Plugin_128_pixels->SetPixelColor(i, rgb_m);
     }
-    else if (lround(((float)Hours + (float)Minutes / 60) * (float)pixelCount / 12.0)  == i) {
+    else if (hoursPos == i) {
       Plugin_128_pixels->SetPixelColor(i,                                 rgb_h);
       Plugin_128_pixels->SetPixelColor((i + 1) % pixelCount,              rgb_h);
       Plugin_128_pixels->SetPixelColor((i - 1 + pixelCount) % pixelCount, rgb_h);
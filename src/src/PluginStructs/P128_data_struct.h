@@ -2219,6 +2219,10 @@ const uint8_t PROGMEM ftv_colors[] = {
 # define SPEED_MAX 50
 # define ARRAYSIZE 300 // Max LED Count
 
+# define P128_FRAME_BUDGET_USEC 20000 // Time available for 1 frame at 50 frames/sec, frames are skipped if it takes longer
+
+// # define P128_USES_DMA // ESP8266: Use the I2S DMA method, stripe must be connected to GPIO3 (RX), disables serial input
+
 // # define P128_USES_GRB // Different type of pixel?
 
 // Choose your color order below:
@@ -2252,7 +2256,11 @@ const uint8_t PROGMEM ftv_colors[] = {
 #  define METHOD NeoWs2812xMethod             // Automatic method, user selected pin
 # endif // if defined(ESP32)
 # if defined(ESP8266)
-#  define METHOD NeoEsp8266Uart1800KbpsMethod // GPIO2 - use NeoEsp8266Uart0800KbpsMethod for GPIO1(TX)
+#  ifdef P128_USES_DMA
+#   define METHOD NeoEsp8266Dma800KbpsMethod  // GPIO3 (RX)
+#  else // ifdef P128_USES_DMA
+#   define METHOD NeoEsp8266Uart1800KbpsMethod // GPIO2 - use NeoEsp8266Uart0800KbpsMethod for GPIO1(TX)
+#  endif // ifdef P128_USES_DMA
 # endif // if defined(ESP8266)
 
 # if defined GRB
@@ -2316,6 +2324,7 @@ private:
   uint16_t difference = 0;
   uint16_t fps        = 50;
   uint16_t colorcount = 0;
+  uint8_t  skipFrames = 0; // Nr of frames to skip after a frame took longer than P128_FRAME_BUDGET_USEC
 
 # if defined(RGBW) || defined(GRBW)
   RgbwColor rgb_target[ARRAYSIZE],
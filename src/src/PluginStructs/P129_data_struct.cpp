@@ -2,6 +2,7 @@
 
 #ifdef USES_P129
 #include <GPIO_Direct_Access.h>
+#include <SPI.h>
 
 // **************************************************************************/
 // Constructor
@@ -10,8 +11,10 @@ P129_data_struct::P129_data_struct(int8_t  dataPin,
                                    int8_t  clockPin,
                                    int8_t  enablePin,
                                    int8_t  loadPin,
-                                   uint8_t chipCount)
-  : _dataPin(dataPin), _clockPin(clockPin), _enablePin(enablePin), _loadPin(loadPin), _chipCount(chipCount) {}
+                                   uint8_t chipCount,
+                                   bool    useHardwareSPI)
+  : _dataPin(dataPin), _clockPin(clockPin), _enablePin(enablePin), _loadPin(loadPin), _chipCount(chipCount),
+  _useHardwareSPI(useHardwareSPI) {}
 
 
 bool P129_data_struct::plugin_init(struct EventStruct *event) {
@@ -23,8 +26,11 @@ bool P129_data_struct::plugin_init(struct EventStruct *event) {
     // Prepare all used GPIO pins
     if (validGpio(_enablePin)) { pinMode(_enablePin, OUTPUT); }
     pinMode(_loadPin,  OUTPUT);
-    pinMode(_clockPin, OUTPUT);
-    pinMode(_dataPin,  INPUT);
+
+    if (!_useHardwareSPI) {
+      pinMode(_clockPin, OUTPUT);
+      pinMode(_dataPin,  INPUT);
+    }
     DIRECT_pinWrite(_loadPin, HIGH);
 
     if (validGpio(_enablePin)) { DIRECT_pinWrite(_enablePin, HIGH); }
@@ -178,15 +184,28 @@ bool P129_data_struct::plugin_readData(struct EventStruct *event) {
 
     if (validGpio(_enablePin)) { DIRECT_pinWrite(_enablePin, LOW); }
 
-    for (uint8_t i = 0; i < P129_CONFIG_CHIP_COUNT; i++) {
-      prevBuffer[i] = readBuffer[i];
-      readBuffer[i] = shiftIn(static_cast<uint8_t>(_dataPin), static_cast<uint8_t>(_clockPin), MSBFIRST);
+    const uint8_t chipCount = P129_CONFIG_CHIP_COUNT;
+
+    memcpy(prevBuffer, readBuffer, chipCount);
+
+    if (_useHardwareSPI) {
+      // Read the whole chain in a single burst, MOSI is not connected so its data does not matter
+      SPI.beginTransaction(SPISettings(P129_SPI_FREQUENCY, MSBFIRST, SPI_MODE0));
+      SPI.transfer(readBuffer, chipCount);
+      SPI.endTransaction();
+    } else {
+      for (uint8_t i = 0; i < chipCount; i++) {
+        readBuffer[i] = shiftIn(static_cast<uint8_t>(_dataPin), static_cast<uint8_t>(_clockPin), MSBFIRST);
+      }
     }
 
     if (validGpio(_enablePin)) { DIRECT_pinWrite(_enablePin, HIGH); }
     delay(0);
 
-    checkDiff(event);
+    // Only check for events when any input changed
+    if (memcmp(prevBuffer, readBuffer, chipCount) != 0) {
+      checkDiff(event);
+    }
 
     return true;
   }
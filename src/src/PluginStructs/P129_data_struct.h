@@ -18,6 +18,7 @@
 # define P129_FLAGS_VALUES_DISPLAY    0          // 0/off = HEX, 1/on = BIN
 # define P129_FLAGS_READ_FREQUENCY    1          // 0 = 10x/sec, 1 = 50x/sec
 # define P129_FLAGS_SEPARATE_EVENTS   2          // Enable/disable separate events per pin <taskname>[#<pin>]=state,chip,port,pin
+# define P129_FLAGS_USE_HW_SPI        3          // Use hardware SPI MISO/SCK instead of Data/Clock pins
 # define P129_FLAGS_OUTPUT_SELECTION  4          // 0 = decimal & hex/bin, 1 = Decimal, 2= hex/bin
 
 # define P129_CONFIG_SHOW_OFFSET      0          // Fixed setting
@@ -26,6 +27,9 @@
 # define P129_CONFIG_FLAGS_GET_READ_FREQUENCY   (bitRead(P129_CONFIG_FLAGS, P129_FLAGS_READ_FREQUENCY))
 # define P129_CONFIG_FLAGS_GET_SEPARATE_EVENTS  (bitRead(P129_CONFIG_FLAGS, P129_FLAGS_SEPARATE_EVENTS))
 # define P129_CONFIG_FLAGS_GET_OUTPUT_SELECTION (get4BitFromUL(P129_CONFIG_FLAGS, P129_FLAGS_OUTPUT_SELECTION))
+# define P129_CONFIG_FLAGS_GET_USE_HW_SPI       (bitRead(P129_CONFIG_FLAGS, P129_FLAGS_USE_HW_SPI))
+
+# define P129_SPI_FREQUENCY           4000000 // 74HC165 supports up to ~25 MHz at 4.5V, be conservative for long chains
 
 # define P129_FREQUENCY_10            0 // 10x per second
 # define P129_FREQUENCY_50            1 // 50x per second
@@ -58,14 +62,16 @@ public:
                    int8_t  clockPin,
                    int8_t  enablePin,
                    int8_t  loadPin,
-                   uint8_t chipCount);
+                   uint8_t chipCount,
+                   bool    useHardwareSPI);
 
   P129_data_struct() = delete;
   virtual ~P129_data_struct() = default;
 
   const bool isInitialized() const { // All GPIO's defined
-    return _dataPin != -1 &&
-           _clockPin != -1 &&
+    return (_useHardwareSPI ||
+            (_dataPin != -1 &&
+             _clockPin != -1)) &&
            _loadPin != -1;
   }
 
@@ -96,6 +102,7 @@ private:
   const int8_t  _enablePin;
   const int8_t  _loadPin;
   uint8_t _chipCount;
+  const bool    _useHardwareSPI;
 
   uint8_t readBuffer[P129_MAX_CHIP_COUNT] = { 0 };
   uint8_t prevBuffer[P129_MAX_CHIP_COUNT] = { 0 }; // To compare to
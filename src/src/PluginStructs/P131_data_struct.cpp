@@ -354,7 +354,7 @@ void P131_data_struct::display_content(struct EventStruct *event,
       yPos += P131_CONFIG_MATRIX_HEIGHT;
     }
     gfxHelper->setValidation(useVal);
-    matrix->show();
+    _frameDirty = true;
   }
 }
 
@@ -471,7 +471,7 @@ bool P131_data_struct::plugin_write(struct EventStruct *event, const String& str
     }
 
     if (success && matrix) {
-      matrix->show();
+      _frameDirty = true; // Multiple commands are combined into a single show()
     }
   }
   return success;
@@ -513,6 +513,7 @@ bool P131_data_struct::plugin_ten_per_second(struct EventStruct *event) {
 
       if (nullptr != matrix) {
         matrix->fillScreen(_bgcolor); // fill screen with black color
+        _frameDirty = true;
       }
 
       // Schedule the surrogate initial PLUGIN_READ that has been suppressed by the splash
@@ -525,21 +526,37 @@ bool P131_data_struct::plugin_ten_per_second(struct EventStruct *event) {
     loadContent(event);
     success = true;
 
+    bool scrolled = false;
+
     for (uint8_t x = 0; x < P131_CONFIG_TILE_HEIGHT; x++) {
       if (content[x].active && (content[x].length > _xpix)) {
         if (content[x].loop == -1) { content[x].loop = content[x].speed; } // Initialize
 
         if (!content[x].loop--) {
           content[x].pixelPos += (content[x].rightScroll ? 1 : -1) * content[x].stepWidth;
-
-          display_content(event, true);
+          scrolled             = true;
         }
       }
     }
+
+    if (scrolled) {
+      display_content(event, true); // Redraws all scrolling lines, so only once for all lines that moved
+    }
   }
   return success;
 }
 
+/****************************************************************************
+ * plugin_fifty_per_second: Send the composed frame to the matrix, if changed
+ ***************************************************************************/
+bool P131_data_struct::plugin_fifty_per_second(struct EventStruct *event) {
+  if (isInitialized() && _frameDirty && matrix->canShow()) {
+    matrix->show();
+    _frameDirty = false;
+  }
+  return true;
+}
+
 /****************************************************************************
  * updateFontMetrics: recalculate x and y columns, based on font size and font scale
  ***************************************************************************/
@@ -122,6 +122,7 @@ public:
                                String            & string);
   # endif // if ADAGFX_ENABLE_GET_CONFIG_VALUE
   bool plugin_ten_per_second(struct EventStruct *event);
+  bool plugin_fifty_per_second(struct EventStruct *event);
 
   bool isInitialized() {
     return matrix != nullptr;
@@ -175,6 +176,7 @@ private:
   bool                            contentInitialized = false;
 
   bool _splashState = false; // Have this always available to avoid 'many' #ifdefs in the code
+  bool _frameDirty  = false; // Matrix buffer changed, show() on the next frame tick
   # ifdef P131_SHOW_SPLASH
   uint8_t _splashCounter = P131_SPLASH_DURATION;
   # endif // ifdef P131_SHOW_SPLASH
@@ -3,8 +3,10 @@
 #ifdef USES_P146
 
 # include "../ControllerQueue/C016_queue_element.h"
+# include "../DataStructs/ControllerSettingsStruct.h"
 # include "../Globals/C016_ControllerCache.h"
 # include "../Globals/MQTT.h"
+# include "../Helpers/Networking.h"
 
 
 P146_data_struct::P146_data_struct(struct EventStruct *event)
@@ -182,10 +184,12 @@ uint32_t P146_data_struct::sendBinaryInBulk(taskIndex_t P146_TaskIndex, uint32_t
     writeToMqtt(formatToHex_array(reinterpret_cast<const uint8_t *>(&element), chunkSize), true);
     writeToMqtt(';',                                                                       true);
   }
-  MQTTclient.endPublish();
 
-  // Restore peek position
-  //  ControllerCache.setPeekFilePos(peekFileNr, peekReadPos);
+  if (MQTTclient.endPublish() == 0) {
+    // Restore peek position, so these samples will be sent again
+    ControllerCache.setPeekFilePos(peekFileNr, peekReadPos);
+    return 0;
+  }
   return expectedMessageSize;
 }
 
@@ -330,6 +334,147 @@ uint32_t P146_data_struct::sendCSVInBulk(taskIndex_t P146_TaskIndex, uint32_t ma
   return expectedMessageSize;
 }
 
+uint32_t P146_data_struct::sendJSONInBulk(taskIndex_t P146_TaskIndex, uint32_t maxMessageSize, bool viaHttp) const
+{
+  if (!viaHttp && !validControllerIndex(firstEnabledMQTT_ControllerIndex())) {
+    return 0;
+  }
+
+  // Keep the current peek position, so we can reset it when we fail to deliver the data.
+  int startFileNr, startPos, peekFileSize;
+
+  if (!getPeekFilePos(startFileNr, startPos, peekFileSize)) {
+    return 0;
+  }
+
+  // Example of a message:
+  // {"fileNr":17,"filePos":14616,"samples":[{"ts":1700000000,"task":"bme","values":{"Temperature":21.50,"Humidity":45.2}},...]}
+  String message;
+
+  if (!message.reserve(maxMessageSize)) {
+    return 0;
+  }
+  message += strformat(F("{\"fileNr\":%d,\"filePos\":%d,\"samples\":["), startFileNr, startPos);
+
+  constexpr size_t tailLength = 2; // "]}"
+  size_t nrSamples            = 0;
+  bool   done                 = false;
+
+  while (!done) {
+    int peekFileNr        = 0;
+    const int peekReadPos = ControllerCache.getPeekFilePos(peekFileNr);
+    C016_binary_element element;
+
+    if (!C016_getTaskSample(element)) {
+      done = true;
+    } else if (validTaskIndex(element.TaskIndex)) {
+      String sample = strformat(F("{\"ts\":%u,\"task\":%s,\"values\":{"),
+                                static_cast<unsigned int>(element.unixTime),
+                                to_json_value(getTaskDeviceName(element.TaskIndex), true).c_str());
+
+      for (uint8_t i = 0; i < element.valueCount && i < VARS_PER_TASK; ++i) {
+        const uint8_t nrDecimals = Cache.getTaskDeviceValueDecimals(element.TaskIndex, i);
+
+        if (i != 0) { sample += ','; }
+        sample += to_json_object_value(
+          Cache.getTaskDeviceValueName(element.TaskIndex, i),
+          isFloatOutputDataType(element.sensorType)
+            ? toString(element.values.getFloat(i), nrDecimals)
+            : element.values.getAsString(i, element.sensorType, nrDecimals));
+      }
+      sample += F("}}");
+
+      // Always send at least 1 sample, even when larger than the max. message size.
+      if ((nrSamples != 0) && ((message.length() + sample.length() + 1 + tailLength) > maxMessageSize)) {
+        // Keep this sample for the next message
+        ControllerCache.setPeekFilePos(peekFileNr, peekReadPos);
+        done = true;
+      } else {
+        if (nrSamples != 0) { message += ','; }
+        message += sample;
+        ++nrSamples;
+      }
+    }
+  }
+
+  if (nrSamples == 0) {
+    // Nothing to be sent
+    return 0;
+  }
+  message += F("]}");
+
+  bool sent = false;
+
+  if (viaHttp) {
+    sent = postHttp(message);
+  } else {
+    const String topic = getTopic(P146_PublishTopicIndex, P146_TaskIndex);
+
+    if (MQTTclient.beginPublish(topic.c_str(), message.length(), false)) {
+      writeToMqtt(message, true);
+      sent = MQTTclient.endPublish() != 0;
+    }
+  }
+
+  if (!sent) {
+    // Retry these samples later
+    ControllerCache.setPeekFilePos(startFileNr, startPos);
+    return 0;
+  }
+  return message.length();
+}
+
+bool P146_data_struct::postHttp(const String& payload) const
+{
+  # if FEATURE_HTTP_CLIENT
+  String   user, pass, host, file;
+  uint16_t port    = 80;
+  const String uri = splitURL(parseTemplate(_topics[P146_HttpUrlIndex]), user, pass, host, port, file);
+
+  if (host.isEmpty()) {
+    addLog(LOG_LEVEL_ERROR, F("CacheReader : No HTTP POST URL set"));
+    return false;
+  }
+  int httpCode = -1;
+
+  send_via_http(
+    F("CacheReader"),
+    CONTROLLER_CLIENTTIMEOUT_MAX,
+    user,
+    pass,
+    host,
+    port,
+    uri,
+    F("POST"),
+    F("Content-Type: application/json\r\n"),
+    payload,
+    httpCode,
+    false);
+
+  return (httpCode >= 200) && (httpCode < 300);
+  # else // if FEATURE_HTTP_CLIENT
+  return false;
+  # endif // if FEATURE_HTTP_CLIENT
+}
+
+void P146_data_struct::storeReadPos(struct EventStruct *event)
+{
+  int readFileNr    = 0;
+  const int readPos = ControllerCache.getPeekFilePos(readFileNr);
+
+  if (P146_GET_ERASE_BINFILES) {
+    // Check whether we must delete the oldest file
+    const int filenr = P146_TASKVALUE_FILENR;
+
+    if ((filenr != 0) && (filenr < readFileNr)) {
+      ControllerCache.deleteCacheBlock(filenr);
+    }
+  }
+
+  P146_TASKVALUE_FILENR  = readFileNr;
+  P146_TASKVALUE_FILEPOS = readPos;
+}
+
 bool P146_data_struct::sendViaOriginalTask(
   taskIndex_t P146_TaskIndex, bool sendTimestamp)
 {
@@ -408,11 +553,15 @@ bool P146_data_struct::sendViaOriginalTask(
 
 bool P146_data_struct::setPeekFilePos(int peekFileNr, int peekReadPos)
 {
+# if !FEATURE_RTC_CACHE_COMPRESSION
+
+  // With compression, samples do not have a fixed size and the cache does align the position itself.
   {
     const int modulo_24 = peekReadPos % sizeof(C016_binary_element);
 
     if (modulo_24 != 0) { peekReadPos -= modulo_24; }
   }
+# endif // if !FEATURE_RTC_CACHE_COMPRESSION
 
   ControllerCache.setPeekFilePos(peekFileNr, peekReadPos);
 
@@ -423,6 +572,24 @@ bool P146_data_struct::setPeekFilePos(int peekFileNr, int peekReadPos)
   return true;
 }
 
+# if FEATURE_RTC_CACHE_INDEX
+bool P146_data_struct::seekToTime(uint32_t unixTime)
+{
+  // Make sure samples still in RTC memory can be found too.
+  C016_flush();
+  const bool res = ControllerCache.seekToTime(unixTime);
+
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    int peekFileNr    = 0;
+    const int readPos = ControllerCache.getPeekFilePos(peekFileNr);
+    addLog(LOG_LEVEL_INFO, concat(F("CacheReader : SeekTime,"), unixTime) + (res ? F(" -> ") : F(" Not found -> ")) +
+           peekFileNr + ',' + readPos);
+  }
+  return res;
+}
+
+# endif // if FEATURE_RTC_CACHE_INDEX
+
 void P146_data_struct::flush() {
   C016_flush();
 }
@@ -8,10 +8,11 @@
 # include "../DataStructs/ESPEasyControllerCache_CSV_dumper.h"
 # include <list>
 
-# define P146_Nlines                            2
+# define P146_Nlines                            3
 # define P146_Nchars                            128
 # define P146_TaskInfoTopicIndex                0
 # define P146_PublishTopicIndex                 1
+# define P146_HttpUrlIndex                      2
 
 
 # define P146_TASKVALUE_FILENR  UserVar[event->BaseVarIndex + 0]
@@ -38,6 +39,12 @@
 # define P146_GET_ERASE_BINFILES    bitRead(PCONFIG(0), 6)
 # define P146_SET_ERASE_BINFILES(X) bitWrite(PCONFIG(0), 6, X)
 
+# define P146_GET_SEND_JSON         bitRead(PCONFIG(0), 7)
+# define P146_SET_SEND_JSON(X)      bitWrite(PCONFIG(0), 7, X)
+
+# define P146_GET_SEND_HTTP         bitRead(PCONFIG(0), 8)
+# define P146_SET_SEND_HTTP(X)      bitWrite(PCONFIG(0), 8, X)
+
 
 # define P146_SEPARATOR_CHARACTER   PCONFIG(1)
 
@@ -67,6 +74,15 @@ public:
                             bool        onlySetTasks,
                             char        separator);
 
+  // Send samples as a JSON array, each with its timestamp, via MQTT or HTTP POST.
+  // The read position is restored when the message could not be delivered.
+  uint32_t sendJSONInBulk(taskIndex_t P146_TaskIndex,
+                          uint32_t    maxMessageSize,
+                          bool        viaHttp) const;
+
+  // Store the read position in the task values, after data was sent.
+  static void storeReadPos(struct EventStruct *event);
+
   static bool prepare_BulkMQTT_message(taskIndex_t P146_TaskIndex);
 
   static bool sendViaOriginalTask(taskIndex_t P146_TaskIndex,
@@ -75,6 +91,12 @@ public:
   static bool setPeekFilePos(int peekFileNr,
                              int peekReadPos);
 
+# if FEATURE_RTC_CACHE_INDEX
+
+  // Set the read position to the first sample at or after the given unix time.
+  static bool seekToTime(uint32_t unixTime);
+# endif // if FEATURE_RTC_CACHE_INDEX
+
   static void flush();
 
 private:
@@ -86,6 +108,8 @@ private:
   String getTopic(int         index,
                   taskIndex_t P146_TaskIndex) const;
 
+  bool   postHttp(const String& payload) const;
+
   String _topics[P146_Nlines];
 
   ESPEasyControllerCache_CSV_dumper *dumper = nullptr;
@@ -2,6 +2,8 @@
 
 #ifdef USES_P147
 
+# include "../Globals/Statistics.h"
+
 /**************************************************************************
 * Constructor
 **************************************************************************/
@@ -13,7 +15,8 @@ P147_data_struct::P147_data_struct(struct EventStruct *event)
   _ignoreFirstRead = P147_LOW_POWER_MEASURE == 1;
   _useCompensation = P147_GET_USE_COMPENSATION;
   # if P147_FEATURE_GASINDEXALGORITHM
-  _rawOnly = P147_GET_RAW_DATA_ONLY;
+  _rawOnly   = P147_GET_RAW_DATA_ONLY;
+  _keepState = P147_GET_KEEP_VOC_STATE;
   # endif // if P147_FEATURE_GASINDEXALGORITHM
 
   if (validTaskIndex(P147_TEMPERATURE_TASK) && validTaskVarIndex(P147_TEMPERATURE_VALUE)) {
@@ -48,6 +51,10 @@ bool P147_data_struct::init(struct EventStruct *event) {
         _initialized = false;
       }
     }
+
+    if (_initialized) {
+      restoreVocState(event);
+    }
     # endif // if P147_FEATURE_GASINDEXALGORITHM
 
     // Read serial number
@@ -80,7 +87,10 @@ bool P147_data_struct::init(struct EventStruct *event) {
 
     if (_initialized && I2C_write8_reg(P147_I2C_ADDRESS, P147_CMD_SELF_TEST_A, P147_CMD_SELF_TEST_B)) {
       _state = P147_state_e::MeasureTest;
-      Scheduler.setPluginTaskTimer(P147_DELAY_SELFTEST, event->TaskIndex, 0); // Retrieve selftest result after 320 msec
+      Scheduler.setPluginTaskTimer(P147_DELAY_SELFTEST, event->TaskIndex, P147_TIMER_STEP); // Retrieve selftest result after 320 msec
+
+      _nextSample = millis();
+      scheduleNextSample(event->TaskIndex);
     }
 
     // addLog(LOG_LEVEL_INFO,
@@ -104,6 +114,10 @@ P147_data_struct::~P147_data_struct() {
 * plugin_tasktimer_in : Handle several delay related tasks
 *****************************************************/
 bool P147_data_struct::plugin_tasktimer_in(struct EventStruct *event) {
+  if (event->Par1 == P147_TIMER_SAMPLE) {
+    return sampleTick(event);
+  }
+
   bool success = false;
   bool is_ok;
 
@@ -176,7 +190,7 @@ bool P147_data_struct::plugin_tasktimer_in(struct EventStruct *event) {
                                        ? (_sensorType == P147_sensor_e::SGP40 ? P147_DELAY_REGULAR : P147_DELAY_REGULAR_SGP41)
                                        : P147_DELAY_LOW_POWER,
                                        event->TaskIndex,
-                                       0);
+                                       P147_TIMER_STEP);
         }
         break;
       }
@@ -207,6 +221,8 @@ bool P147_data_struct::plugin_tasktimer_in(struct EventStruct *event) {
           if (_vocIndex == 0) {
             _skipCount++;
           }
+          _vocSeconds += _initialCounter;
+          storeVocState(event);
 
           if ((_lastCommand == P147_CMD_SGP41_READ_B) && (_sensorType == P147_sensor_e::SGP41)) {
             _noxIndex = noxGasIndexAlgorithm->process(_rawNOx);
@@ -221,14 +237,14 @@ bool P147_data_struct::plugin_tasktimer_in(struct EventStruct *event) {
           if (P147_LOW_POWER_MEASURE == 1) {                                     // Turn  off heater
             I2C_write8_reg(P147_I2C_ADDRESS, P147_CMD_HEATER_OFF_A, P147_CMD_HEATER_OFF_B);
           }
-          Scheduler.setPluginTaskTimer(P147_DELAY_MINIMAL, event->TaskIndex, 0); // Next step
+          Scheduler.setPluginTaskTimer(P147_DELAY_MINIMAL, event->TaskIndex, P147_TIMER_STEP); // Next step
         } else {
-          _state = P147_state_e::MeasureStart;                                   // Restart from once_a_second
+          _state = P147_state_e::MeasureStart;                                   // Restart from the next sample tick
 
           if (_readLoop > 0) {
             _state = P147_state_e::MeasureTrigger;                               // Trigger only
             Scheduler.setPluginTaskTimer(_sensorType == P147_sensor_e::SGP40 ? P147_DELAY_REGULAR : P147_DELAY_REGULAR_SGP41,
-                                         event->TaskIndex, 0);                   // Trigger actual read after heating up
+                                         event->TaskIndex, P147_TIMER_STEP);     // Trigger actual read after heating up
           }
         }
 
@@ -237,7 +253,7 @@ bool P147_data_struct::plugin_tasktimer_in(struct EventStruct *event) {
       }
 
       case P147_state_e::Ready:
-        _state = P147_state_e::MeasureStart; // When ready, start a new sequence from plugin_once_a_second
+        _state = P147_state_e::MeasureStart; // When ready, start a new sequence from the next sample tick
         break;
 
       case P147_state_e::Uninitialized:      // Keep compiler happy
@@ -248,11 +264,15 @@ bool P147_data_struct::plugin_tasktimer_in(struct EventStruct *event) {
 }
 
 /*****************************************************
-* plugin_once_a_second
+* sampleTick : Called every P147_SAMPLE_INTERVAL msec.
+* The gas index algorithm expects a fixed sampling interval,
+* so this runs on a strict timer instead of PLUGIN_ONCE_A_SECOND.
 *****************************************************/
-bool P147_data_struct::plugin_once_a_second(struct EventStruct *event) {
+bool P147_data_struct::sampleTick(struct EventStruct *event) {
   bool success = false;
 
+  scheduleNextSample(event->TaskIndex);
+
   // addLog(LOG_LEVEL_INFO,
   //        concat(F("P147 : State: "),   static_cast<int>(_state)) +
   //        concat(F(", Last _rawVOC: "), _rawVOC) +
@@ -268,7 +288,7 @@ bool P147_data_struct::plugin_once_a_second(struct EventStruct *event) {
       // Execute a measurement cycle
       if (_state == P147_state_e::MeasureStart) {
         // Trigger a cycle
-        Scheduler.setPluginTaskTimer(P147_DELAY_MINIMAL, event->TaskIndex, 0); // Next step
+        Scheduler.setPluginTaskTimer(P147_DELAY_MINIMAL, event->TaskIndex, P147_TIMER_STEP); // Next step
         success = true;
       }
 
@@ -376,6 +396,52 @@ bool P147_data_struct::plugin_get_config_value(struct EventStruct *event,
 
 // Private
 
+void P147_data_struct::scheduleNextSample(taskIndex_t taskIndex) {
+  // Keep the sample moments at a fixed interval, without drift
+  Scheduler.setNextStrictTimeInterval(_nextSample, P147_SAMPLE_INTERVAL);
+  Scheduler.setPluginTaskTimer(timeDiff(millis(), _nextSample), taskIndex, P147_TIMER_SAMPLE);
+}
+
+# if P147_FEATURE_GASINDEXALGORITHM
+
+/*****************************************************
+ * restoreVocState : Resume the VOC algorithm with the state kept in RTC memory, skipping the learning period.
+ * Only allowed after a short interruption, so not after a cold boot (RTC values are cleared)
+ * or deep sleep, as the heater has been off.
+ ****************************************************/
+void P147_data_struct::restoreVocState(struct EventStruct *event) {
+  if (!_keepState || (lastBootCause == BOOT_CAUSE_DEEP_SLEEP)) {
+    return;
+  }
+  const float state0 = UserVar[event->BaseVarIndex + P147_VOC_STATE0_VAR];
+  const float state1 = UserVar[event->BaseVarIndex + P147_VOC_STATE1_VAR];
+
+  if (isValidFloat(state0) && isValidFloat(state1) && definitelyGreaterThan(state1, 0.0f)) {
+    vocGasIndexAlgorithm->set_states(state0, state1);
+    _vocSeconds = P147_VOC_STATE_MIN_AGE;
+    addLog(LOG_LEVEL_INFO, F("SGP4x: VOC algorithm state restored"));
+  }
+}
+
+/*****************************************************
+ * storeVocState : Keep the VOC algorithm state in the unused task values, saved to RTC memory with the task values.
+ ****************************************************/
+void P147_data_struct::storeVocState(struct EventStruct *event) {
+  if (!_keepState) {
+    return;
+  }
+  float state0 = 0.0f;
+  float state1 = 0.0f;
+
+  if (_vocSeconds >= P147_VOC_STATE_MIN_AGE) {
+    vocGasIndexAlgorithm->get_states(state0, state1);
+  }
+  UserVar[event->BaseVarIndex + P147_VOC_STATE0_VAR] = state0;
+  UserVar[event->BaseVarIndex + P147_VOC_STATE1_VAR] = state1;
+}
+
+# endif // if P147_FEATURE_GASINDEXALGORITHM
+
 /*****************************************************
  * readCheckedWord : Read 2 data bytes from I2C and validate checksum (3rd byte)
  ****************************************************/
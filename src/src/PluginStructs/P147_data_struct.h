@@ -29,15 +29,30 @@
 
 # define P147_FLAG_USE_COMPENSATION 0
 # define P147_FLAG_RAW_DATA_ONLY    1
+# define P147_FLAG_KEEP_VOC_STATE   2
 
 # define P147_GET_USE_COMPENSATION    bitRead(P147_FLAGS, P147_FLAG_USE_COMPENSATION)
 # define P147_SET_USE_COMPENSATION(x) bitWrite(P147_FLAGS, P147_FLAG_USE_COMPENSATION, (x))
 # define P147_GET_RAW_DATA_ONLY    bitRead(P147_FLAGS, P147_FLAG_RAW_DATA_ONLY)
 # define P147_SET_RAW_DATA_ONLY(x) bitWrite(P147_FLAGS, P147_FLAG_RAW_DATA_ONLY, (x))
+# define P147_GET_KEEP_VOC_STATE    bitRead(P147_FLAGS, P147_FLAG_KEEP_VOC_STATE)
+# define P147_SET_KEEP_VOC_STATE(x) bitWrite(P147_FLAGS, P147_FLAG_KEEP_VOC_STATE, (x))
 
 # define P147_SHORT_COUNTER       1   // Regular measurement 1x second
 # define P147_LONG_COUNTER        10  // Low power measurement, 1x 10 seconds
 
+# define P147_SAMPLE_INTERVAL     1000 // Milliseconds, strict interval of the sample tick, as expected by the gas index algorithm
+
+// Par1 of PLUGIN_TASKTIMER_IN
+# define P147_TIMER_STEP          0 // Next step of the measurement state machine
+# define P147_TIMER_SAMPLE        1 // Sample tick
+
+// The VOC algorithm state is kept in the unused task values 3 and 4, which are also stored in RTC memory,
+// so a reboot doesn't need a new learning period.
+# define P147_VOC_STATE0_VAR      2
+# define P147_VOC_STATE1_VAR      3
+# define P147_VOC_STATE_MIN_AGE   (3 * 3600) // Seconds, the algorithm states are only valid after 3 hours of operation
+
 # define P147_DELAY_REGULAR       30  // Milliseconds, regular measurement
 # define P147_DELAY_REGULAR_SGP41 50  // Milliseconds, regular measurement for SGP41
 # define P147_DELAY_LOW_POWER     140 // Allow the heater to heat up, 170 - 30 msec
@@ -88,7 +103,6 @@ public:
   bool init(struct EventStruct *event);
 
   bool plugin_tasktimer_in(struct EventStruct *event);
-  bool plugin_once_a_second(struct EventStruct *event);
   bool plugin_read(struct EventStruct *event);
   bool plugin_write(struct EventStruct *event,
                     String            & string);
@@ -107,6 +121,13 @@ private:
   uint32_t              _noxIndex            = 0;
   # endif // if P147_FEATURE_GASINDEXALGORITHM
 
+  bool     sampleTick(struct EventStruct *event);
+  void     scheduleNextSample(taskIndex_t taskIndex);
+  # if P147_FEATURE_GASINDEXALGORITHM
+  void     restoreVocState(struct EventStruct *event);
+  void     storeVocState(struct EventStruct *event);
+  # endif // if P147_FEATURE_GASINDEXALGORITHM
+
   uint16_t readCheckedWord(bool& is_ok,
                            long  extraDelay = 5);
   bool     startSensorRead(uint16_t compensationRh,
@@ -123,10 +144,14 @@ private:
   bool          _useCompensation       = false;
   bool          _initialized           = false;
   # if P147_FEATURE_GASINDEXALGORITHM
-  uint16_t _skipCount = 0;
-  bool     _rawOnly   = false;
+  uint32_t _vocSeconds = 0; // Seconds of operation of the VOC algorithm, to know when its state is valid
+  uint16_t _skipCount  = 0;
+  bool     _rawOnly    = false;
+  bool     _keepState  = false;
   # endif // if P147_FEATURE_GASINDEXALGORITHM
 
+  unsigned long _nextSample = 0;
+
   uint64_t _serial          = 0;
   uint16_t _rawVOC          = 0;
   uint16_t _rawNOx          = 0;
@@ -708,7 +708,7 @@ static const char DATA_UPDATE_SENSOR_VALUES_DEVICE_PAGE_JS[] PROGMEM = {0x66,0x7
 #endif // WEBSERVER_INCLUDE_JS
 
 #ifdef WEBSERVER_INCLUDE_JS
-static const char DATA_FETCH_AND_PARSE_LOG_JS[] PROGMEM = {0x66,0x75,0x6e,0x63,0x74,0x69,0x6f,0x6e,0x20,0x67,0x65,0x74,0x42,0x72,0x6f,0x77,0x73,0x65,0x72,0x28,0x29,0x7b,0x76,0x61,0x72,0x20,0x65,0x2c,0x6f,0x3d,0x6e,0x61,0x76,0x69,0x67,0x61,0x74,0x6f,0x72,0x2e,0x75,0x73,0x65,0x72,0x41,0x67,0x65,0x6e,0x74,0x2c,0x74,0x3d,0x6f,0x2e,0x6d,0x61,0x74,0x63,0x68,0x28,0x2f,0x28,0x6f,0x70,0x65,0x72,0x61,0x7c,0x63,0x68,0x72,0x6f,0x6d,0x65,0x7c,0x73,0x61,0x66,0x61,0x72,0x69,0x7c,0x66,0x69,0x72,0x65,0x66,0x6f,0x78,0x7c,0x6d,0x73,0x69,0x65,0x7c,0x74,0x72,0x69,0x64,0x65,0x6e,0x74,0x28,0x3f,0x3d,0x5c,0x2f,0x29,0x29,0x5c,0x2f,0x3f,0x5c,0x73,0x2a,0x28,0x5c,0x64,0x2b,0x29,0x2f,0x69,0x29,0x7c,0x7c,0x5b,0x5d,0x3b,0x72,0x65,0x74,0x75,0x72,0x6e,0x2f,0x74,0x72,0x69,0x64,0x65,0x6e,0x74,0x2f,0x69,0x2e,0x74,0x65,0x73,0x74,0x28,0x74,0x5b,0x31,0x5d,0x29,0x3f,0x7b,0x6e,0x61,0x6d,0x65,0x3a,0x22,0x49,0x45,0x22,0x2c,0x76,0x65,0x72,0x73,0x69,0x6f,0x6e,0x3a,0x28,0x65,0x3d,0x2f,0x5c,0x62,0x72,0x76,0x5b,0x20,0x3a,0x5d,0x2b,0x28,0x5c,0x64,0x2b,0x29,0x2f,0x67,0x2e,0x65,0x78,0x65,0x63,0x28,0x6f,0x29,0x7c,0x7c,0x5b,0x5d,0x29,0x5b,0x31,0x5d,0x7c,0x7c,0x22,0x22,0x7d,0x3a,0x22,0x43,0x68,0x72,0x6f,0x6d,0x65,0x22,0x3d,0x3d,0x3d,0x74,0x5b,0x31,0x5d,0x26,0x26,0x6e,0x75,0x6c,0x6c,0x21,0x3d,0x28,0x65,0x3d,0x6f,0x2e,0x6d,0x61,0x74,0x63,0x68,0x28,0x2f,0x5c,0x62,0x4f,0x50,0x52,0x7c,0x45,0x64,0x67,0x65,0x5c,0x2f,0x28,0x5c,0x64,0x2b,0x29,0x2f,0x29,0x29,0x3f,0x7b,0x6e,0x61,0x6d,0x65,0x3a,0x22,0x4f,0x70,0x65,0x72,0x61,0x22,0x2c,0x76,0x65,0x72,0x73,0x69,0x6f,0x6e,0x3a,0x65,0x5b,0x31,0x5d,0x7d,0x3a,0x28,0x74,0x3d,0x74,0x5b,0x32,0x5d,0x3f,0x5b,0x74,0x5b,0x31,0x5d,0x2c,0x74,0x5b,0x32,0x5d,0x5d,0x3a,0x5b,0x6e,0x61,0x76,0x69,0x67,0x61,0x74,0x6f,0x72,0x2e,0x61,0x70,0x70,0x4e,0x61,0x6d,0x65,0x2c,0x6e,0x61,0x76,0x69,0x67,0x61,0x74,0x6f,0x72,0x2e,0x61,0x70,0x70,0x56,0x65,0x72,0x73,0x69,0x6f,0x6e,0x2c,0x22,0x2d,0x3f,0x22,0x5d,0x2c,0x6e,0x75,0x6c,0x6c,0x21,0x3d,0x28,0x65,0x3d,0x6f,0x2e,0x6d,0x61,0x74,0x63,0x68,0x28,0x2f,0x76,0x65,0x72,0x73,0x69,0x6f,0x6e,0x5c,0x2f,0x28,0x5c,0x64,0x2b,0x29,0x2f,0x69,0x29,0x29,0x26,0x26,0x74,0x2e,0x73,0x70,0x6c,0x69,0x63,0x65,0x28,0x31,0x2c,0x31,0x2c,0x65,0x5b,0x31,0x5d,0x29,0x2c,0x7b,0x6e,0x61,0x6d,0x65,0x3a,0x74,0x5b,0x30,0x5d,0x2c,0x76,0x65,0x72,0x73,0x69,0x6f,0x6e,0x3a,0x74,0x5b,0x31,0x5d,0x7d,0x29,0x7d,0x76,0x61,0x72,0x20,0x62,0x72,0x6f,0x77,0x73,0x65,0x72,0x3d,0x67,0x65,0x74,0x42,0x72,0x6f,0x77,0x73,0x65,0x72,0x28,0x29,0x2c,0x63,0x75,0x72,0x72,0x65,0x6e,0x74,0x42,0x72,0x6f,0x77,0x73,0x65,0x72,0x3d,0x62,0x72,0x6f,0x77,0x73,0x65,0x72,0x2e,0x6e,0x61,0x6d,0x65,0x2b,0x62,0x72,0x6f,0x77,0x73,0x65,0x72,0x2e,0x76,0x65,0x72,0x73,0x69,0x6f,0x6e,0x3b,0x28,0x62,0x72,0x6f,0x77,0x73,0x65,0x72,0x2e,0x6e,0x61,0x6d,0x65,0x3d,0x62,0x72,0x6f,0x77,0x73,0x65,0x72,0x2e,0x76,0x65,0x72,0x73,0x69,0x6f,0x6e,0x3c,0x31,0x32,0x29,0x3f,0x74,0x65,0x78,0x74,0x54,0x6f,0x44,0x69,0x73,0x70,0x6c,0x61,0x79,0x3d,0x22,0x45,0x72,0x72,0x6f,0x72,0x3a,0x20,0x22,0x2b,0x63,0x75,0x72,0x72,0x65,0x6e,0x74,0x42,0x72,0x6f,0x77,0x73,0x65,0x72,0x2b,0x22,0x20,0x69,0x73,0x20,0x6e,0x6f,0x74,0x20,0x73,0x75,0x70,0x70,0x6f,0x72,0x74,0x65,0x64,0x21,0x20,0x50,0x6c,0x65,0x61,0x73,0x65,0x20,0x74,0x72,0x79,0x20,0x61,0x20,0x6d,0x6f,0x64,0x65,0x72,0x6e,0x20,0x77,0x65,0x62,0x20,0x62,0x72,0x6f,0x77,0x73,0x65,0x72,0x2e,0x22,0x3a,0x74,0x65,0x78,0x74,0x54,0x6f,0x44,0x69,0x73,0x70,0x6c,0x61,0x79,0x3d,0x22,0x46,0x65,0x74,0x63,0x68,0x69,0x6e,0x67,0x20,0x6c,0x6f,0x67,0x20,0x65,0x6e,0x74,0x72,0x69,0x65,0x73,0x2e,0x2e,0x2e,0x22,0x2c,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x67,0x65,0x74,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,0x22,0x63,0x6f,0x70,0x79,0x54,0x65,0x78,0x74,0x5f,0x31,0x22,0x29,0x2e,0x69,0x6e,0x6e,0x65,0x72,0x48,0x54,0x4d,0x4c,0x3d,0x74,0x65,0x78,0x74,0x54,0x6f,0x44,0x69,0x73,0x70,0x6c,0x61,0x79,0x2c,0x6c,0x6f,0x6f,0x70,0x44,0x65,0x4c,0x6f,0x6f,0x70,0x28,0x31,0x65,0x33,0x2c,0x30,0x29,0x3b,0x76,0x61,0x72,0x20,0x6c,0x6f,0x67,0x4c,0x65,0x76,0x65,0x6c,0x3d,0x6e,0x65,0x77,0x20,0x41,0x72,0x72,0x61,0x79,0x28,0x22,0x55,0x6e,0x75,0x73,0x65,0x64,0x22,0x2c,0x22,0x45,0x72,0x72,0x6f,0x72,0x22,0x2c,0x22,0x49,0x6e,0x66,0x6f,0x22,0x2c,0x22,0x44,0x65,0x62,0x75,0x67,0x22,0x2c,0x22,0x44,0x65,0x62,0x75,0x67,0x20,0x4d,0x6f,0x72,0x65,0x22,0x2c,0x22,0x55,0x6e,0x64,0x65,0x66,0x69,0x6e,0x65,0x64,0x22,0x2c,0x22,0x55,0x6e,0x64,0x65,0x66,0x69,0x6e,0x65,0x64,0x22,0x2c,0x22,0x55,0x6e,0x64,0x65,0x66,0x69,0x6e,0x65,0x64,0x22,0x2c,0x22,0x55,0x6e,0x64,0x65,0x66,0x69,0x6e,0x65,0x64,0x22,0x2c,0x22,0x44,0x65,0x62,0x75,0x67,0x20,0x44,0x65,0x76,0x22,0x29,0x3b,0x66,0x75,0x6e,0x63,0x74,0x69,0x6f,0x6e,0x20,0x6c,0x6f,0x6f,0x70,0x44,0x65,0x4c,0x6f,0x6f,0x70,0x28,0x65,0x2c,0x6f,0x29,0x7b,0x76,0x61,0x72,0x20,0x74,0x2c,0x6e,0x3b,0x69,0x73,0x4e,0x61,0x4e,0x28,0x6f,0x29,0x26,0x26,0x28,0x6f,0x3d,0x31,0x29,0x2c,0x6e,0x75,0x6c,0x6c,0x3d,0x3d,0x65,0x26,0x26,0x28,0x65,0x3d,0x31,0x65,0x33,0x29,0x2c,0x73,0x63,0x72,0x6f,0x6c,0x6c,0x69,0x6e,0x67,0x5f,0x74,0x79,0x70,0x65,0x3d,0x65,0x3c,0x3d,0x35,0x30,0x30,0x3f,0x22,0x61,0x75,0x74,0x6f,0x22,0x3a,0x22,0x73,0x6d,0x6f,0x6f,0x74,0x68,0x22,0x3b,0x76,0x61,0x72,0x20,0x72,0x3d,0x22,0x22,0x2c,0x6c,0x3d,0x30,0x2c,0x73,0x3d,0x73,0x65,0x74,0x49,0x6e,0x74,0x65,0x72,0x76,0x61,0x6c,0x28,0x66,0x75,0x6e,0x63,0x74,0x69,0x6f,0x6e,0x28,0x29,0x7b,0x6c,0x3e,0x30,0x3f,0x63,0x6c,0x65,0x61,0x72,0x49,0x6e,0x74,0x65,0x72,0x76,0x61,0x6c,0x28,0x73,0x29,0x3a,0x28,0x2b,0x2b,0x6f,0x3e,0x31,0x3f,0x6c,0x3d,0x31,0x3a,0x66,0x65,0x74,0x63,0x68,0x28,0x22,0x2f,0x6c,0x6f,0x67,0x6a,0x73,0x6f,0x6e,0x22,0x29,0x2e,0x74,0x68,0x65,0x6e,0x28,0x66,0x75,0x6e,0x63,0x74,0x69,0x6f,0x6e,0x28,0x6f,0x29,0x7b,0x32,0x30,0x30,0x3d,0x3d,0x3d,0x6f,0x2e,0x73,0x74,0x61,0x74,0x75,0x73,0x3f,0x6f,0x2e,0x6a,0x73,0x6f,0x6e,0x28,0x29,0x2e,0x74,0x68,0x65,0x6e,0x28,0x66,0x75,0x6e,0x63,0x74,0x69,0x6f,0x6e,0x28,0x6f,0x29,0x7b,0x76,0x61,0x72,0x20,0x6c,0x3b,0x66,0x6f,0x72,0x28,0x6e,0x75,0x6c,0x6c,0x3d,0x3d,0x6e,0x26,0x26,0x28,0x6e,0x3d,0x22,0x22,0x29,0x2c,0x74,0x3d,0x30,0x3b,0x74,0x3c,0x6f,0x2e,0x4c,0x6f,0x67,0x2e,0x6e,0x72,0x45,0x6e,0x74,0x72,0x69,0x65,0x73,0x3b,0x2b,0x2b,0x74,0x29,0x74,0x72,0x79,0x7b,0x6c,0x3d,0x6f,0x2e,0x4c,0x6f,0x67,0x2e,0x45,0x6e,0x74,0x72,0x69,0x65,0x73,0x5b,0x74,0x5d,0x2e,0x74,0x69,0x6d,0x65,0x73,0x74,0x61,0x6d,0x70,0x7d,0x63,0x61,0x74,0x63,0x68,0x28,0x65,0x29,0x7b,0x6c,0x3d,0x65,0x2e,0x6e,0x61,0x6d,0x65,0x7d,0x66,0x69,0x6e,0x61,0x6c,0x6c,0x79,0x7b,0x22,0x54,0x79,0x70,0x65,0x45,0x72,0x72,0x6f,0x72,0x22,0x21,0x3d,0x3d,0x6c,0x26,0x26,0x28,0x72,0x3d,0x6f,0x2e,0x4c,0x6f,0x67,0x2e,0x45,0x6e,0x74,0x72,0x69,0x65,0x73,0x5b,0x74,0x5d,0x2e,0x74,0x69,0x6d,0x65,0x73,0x74,0x61,0x6d,0x70,0x2c,0x6e,0x2b,0x3d,0x22,0x3c,0x64,0x69,0x76,0x20,0x63,0x6c,0x61,0x73,0x73,0x3d,0x6c,0x65,0x76,0x65,0x6c,0x5f,0x22,0x2b,0x6f,0x2e,0x4c,0x6f,0x67,0x2e,0x45,0x6e,0x74,0x72,0x69,0x65,0x73,0x5b,0x74,0x5d,0x2e,0x6c,0x65,0x76,0x65,0x6c,0x2b,0x22,0x20,0x69,0x64,0x3d,0x22,0x2b,0x72,0x2b,0x27,0x3e,0x3c,0x66,0x6f,0x6e,0x74,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x3d,0x22,0x67,0x72,0x61,0x79,0x22,0x3e,0x27,0x2b,0x6f,0x2e,0x4c,0x6f,0x67,0x2e,0x45,0x6e,0x74,0x72,0x69,0x65,0x73,0x5b,0x74,0x5d,0x2e,0x74,0x69,0x6d,0x65,0x73,0x74,0x61,0x6d,0x70,0x2b,0x22,0x3a,0x3c,0x2f,0x66,0x6f,0x6e,0x74,0x3e,0x20,0x22,0x2b,0x6f,0x2e,0x4c,0x6f,0x67,0x2e,0x45,0x6e,0x74,0x72,0x69,0x65,0x73,0x5b,0x74,0x5d,0x2e,0x74,0x65,0x78,0x74,0x2b,0x22,0x3c,0x2f,0x64,0x69,0x76,0x3e,0x22,0x29,0x7d,0x65,0x3d,0x6f,0x2e,0x4c,0x6f,0x67,0x2e,0x54,0x54,0x4c,0x2c,0x22,0x22,0x21,0x3d,0x3d,0x6e,0x26,0x26,0x28,0x22,0x46,0x65,0x74,0x63,0x68,0x69,0x6e,0x67,0x20,0x6c,0x6f,0x67,0x20,0x65,0x6e,0x74,0x72,0x69,0x65,0x73,0x2e,0x2e,0x2e,0x22,0x3d,0x3d,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x67,0x65,0x74,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,0x22,0x63,0x6f,0x70,0x79,0x54,0x65,0x78,0x74,0x5f,0x31,0x22,0x29,0x2e,0x69,0x6e,0x6e,0x65,0x72,0x48,0x54,0x4d,0x4c,0x26,0x26,0x28,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x67,0x65,0x74,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,0x22,0x63,0x6f,0x70,0x79,0x54,0x65,0x78,0x74,0x5f,0x31,0x22,0x29,0x2e,0x69,0x6e,0x6e,0x65,0x72,0x48,0x54,0x4d,0x4c,0x3d,0x22,0x22,0x29,0x2c,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x67,0x65,0x74,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,0x22,0x63,0x6f,0x70,0x79,0x54,0x65,0x78,0x74,0x5f,0x31,0x22,0x29,0x2e,0x69,0x6e,0x6e,0x65,0x72,0x48,0x54,0x4d,0x4c,0x2b,0x3d,0x6e,0x29,0x2c,0x6e,0x3d,0x22,0x22,0x2c,0x61,0x75,0x74,0x6f,0x73,0x63,0x72,0x6f,0x6c,0x6c,0x5f,0x6f,0x6e,0x3d,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x67,0x65,0x74,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,0x22,0x61,0x75,0x74,0x6f,0x73,0x63,0x72,0x6f,0x6c,0x6c,0x22,0x29,0x2e,0x63,0x68,0x65,0x63,0x6b,0x65,0x64,0x2c,0x31,0x3d,0x3d,0x61,0x75,0x74,0x6f,0x73,0x63,0x72,0x6f,0x6c,0x6c,0x5f,0x6f,0x6e,0x26,0x26,0x22,0x22,0x21,0x3d,0x3d,0x72,0x26,0x26,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x67,0x65,0x74,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,0x72,0x29,0x2e,0x73,0x63,0x72,0x6f,0x6c,0x6c,0x49,0x6e,0x74,0x6f,0x56,0x69,0x65,0x77,0x28,0x7b,0x62,0x65,0x68,0x61,0x76,0x69,0x6f,0x72,0x3a,0x73,0x63,0x72,0x6f,0x6c,0x6c,0x69,0x6e,0x67,0x5f,0x74,0x79,0x70,0x65,0x7d,0x29,0x2c,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x67,0x65,0x74,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,0x22,0x63,0x75,0x72,0x72,0x65,0x6e,0x74,0x5f,0x6c,0x6f,0x67,0x6c,0x65,0x76,0x65,0x6c,0x22,0x29,0x2e,0x69,0x6e,0x6e,0x65,0x72,0x48,0x54,0x4d,0x4c,0x3d,0x22,0x4c,0x6f,0x67,0x67,0x69,0x6e,0x67,0x3a,0x20,0x22,0x2b,0x6c,0x6f,0x67,0x4c,0x65,0x76,0x65,0x6c,0x5b,0x6f,0x2e,0x4c,0x6f,0x67,0x2e,0x53,0x65,0x74,0x74,0x69,0x6e,0x67,0x73,0x57,0x65,0x62,0x4c,0x6f,0x67,0x4c,0x65,0x76,0x65,0x6c,0x5d,0x2b,0x22,0x20,0x28,0x22,0x2b,0x6f,0x2e,0x4c,0x6f,0x67,0x2e,0x53,0x65,0x74,0x74,0x69,0x6e,0x67,0x73,0x57,0x65,0x62,0x4c,0x6f,0x67,0x4c,0x65,0x76,0x65,0x6c,0x2b,0x22,0x29,0x22,0x2c,0x63,0x6c,0x65,0x61,0x72,0x49,0x6e,0x74,0x65,0x72,0x76,0x61,0x6c,0x28,0x73,0x29,0x2c,0x6c,0x6f,0x6f,0x70,0x44,0x65,0x4c,0x6f,0x6f,0x70,0x28,0x65,0x2c,0x30,0x29,0x7d,0x29,0x3a,0x63,0x6f,0x6e,0x73,0x6f,0x6c,0x65,0x2e,0x6c,0x6f,0x67,0x28,0x22,0x4c,0x6f,0x6f,0x6b,0x73,0x20,0x6c,0x69,0x6b,0x65,0x20,0x74,0x68,0x65,0x72,0x65,0x20,0x77,0x61,0x73,0x20,0x61,0x20,0x70,0x72,0x6f,0x62,0x6c,0x65,0x6d,0x2e,0x20,0x53,0x74,0x61,0x74,0x75,0x73,0x20,0x43,0x6f,0x64,0x65,0x3a,0x20,0x22,0x2b,0x6f,0x2e,0x73,0x74,0x61,0x74,0x75,0x73,0x29,0x7d,0x29,0x2e,0x63,0x61,0x74,0x63,0x68,0x28,0x66,0x75,0x6e,0x63,0x74,0x69,0x6f,0x6e,0x28,0x6f,0x29,0x7b,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x67,0x65,0x74,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,0x22,0x63,0x6f,0x70,0x79,0x54,0x65,0x78,0x74,0x5f,0x31,0x22,0x29,0x2e,0x69,0x6e,0x6e,0x65,0x72,0x48,0x54,0x4d,0x4c,0x2b,0x3d,0x22,0x3c,0x64,0x69,0x76,0x3e,0x3e,0x3e,0x20,0x22,0x2b,0x6f,0x2e,0x6d,0x65,0x73,0x73,0x61,0x67,0x65,0x2b,0x22,0x20,0x3c,0x3c,0x3c,0x2f,0x64,0x69,0x76,0x3e,0x22,0x2c,0x61,0x75,0x74,0x6f,0x73,0x63,0x72,0x6f,0x6c,0x6c,0x5f,0x6f,0x6e,0x3d,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x67,0x65,0x74,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,0x22,0x61,0x75,0x74,0x6f,0x73,0x63,0x72,0x6f,0x6c,0x6c,0x22,0x29,0x2e,0x63,0x68,0x65,0x63,0x6b,0x65,0x64,0x2c,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x67,0x65,0x74,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,0x22,0x63,0x6f,0x70,0x79,0x54,0x65,0x78,0x74,0x5f,0x31,0x22,0x29,0x2e,0x73,0x63,0x72,0x6f,0x6c,0x6c,0x54,0x6f,0x70,0x3d,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x67,0x65,0x74,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,0x22,0x63,0x6f,0x70,0x79,0x54,0x65,0x78,0x74,0x5f,0x31,0x22,0x29,0x2e,0x73,0x63,0x72,0x6f,0x6c,0x6c,0x48,0x65,0x69,0x67,0x68,0x74,0x2c,0x65,0x3d,0x35,0x65,0x33,0x2c,0x63,0x6c,0x65,0x61,0x72,0x49,0x6e,0x74,0x65,0x72,0x76,0x61,0x6c,0x28,0x73,0x29,0x2c,0x6c,0x6f,0x6f,0x70,0x44,0x65,0x4c,0x6f,0x6f,0x70,0x28,0x65,0x2c,0x30,0x29,0x7d,0x29,0x2c,0x6c,0x3d,0x31,0x29,0x7d,0x2c,0x65,0x29,0x7d,0};
+static const char DATA_FETCH_AND_PARSE_LOG_JS[] PROGMEM = {0x66,0x75,0x6e,0x63,0x74,0x69,0x6f,0x6e,0x20,0x67,0x65,0x74,0x42,0x72,0x6f,0x77,0x73,0x65,0x72,0x28,0x29,0x7b,0x76,0x61,0x72,0x20,0x65,0x2c,0x6f,0x3d,0x6e,0x61,0x76,0x69,0x67,0x61,0x74,0x6f,0x72,0x2e,0x75,0x73,0x65,0x72,0x41,0x67,0x65,0x6e,0x74,0x2c,0x74,0x3d,0x6f,0x2e,0x6d,0x61,0x74,0x63,0x68,0x28,0x2f,0x28,0x6f,0x70,0x65,0x72,0x61,0x7c,0x63,0x68,0x72,0x6f,0x6d,0x65,0x7c,0x73,0x61,0x66,0x61,0x72,0x69,0x7c,0x66,0x69,0x72,0x65,0x66,0x6f,0x78,0x7c,0x6d,0x73,0x69,0x65,0x7c,0x74,0x72,0x69,0x64,0x65,0x6e,0x74,0x28,0x3f,0x3d,0x5c,0x2f,0x29,0x29,0x5c,0x2f,0x3f,0x5c,0x73,0x2a,0x28,0x5c,0x64,0x2b,0x29,0x2f,0x69,0x29,0x7c,0x7c,0x5b,0x5d,0x3b,0x72,0x65,0x74,0x75,0x72,0x6e,0x2f,0x74,0x72,0x69,0x64,0x65,0x6e,0x74,0x2f,0x69,0x2e,0x74,0x65,0x73,0x74,0x28,0x74,0x5b,0x31,0x5d,0x29,0x3f,0x7b,0x6e,0x61,0x6d,0x65,0x3a,0x22,0x49,0x45,0x22,0x2c,0x76,0x65,0x72,0x73,0x69,0x6f,0x6e,0x3a,0x28,0x65,0x3d,0x2f,0x5c,0x62,0x72,0x76,0x5b,0x20,0x3a,0x5d,0x2b,0x28,0x5c,0x64,0x2b,0x29,0x2f,0x67,0x2e,0x65,0x78,0x65,0x63,0x28,0x6f,0x29,0x7c,0x7c,0x5b,0x5d,0x29,0x5b,0x31,0x5d,0x7c,0x7c,0x22,0x22,0x7d,0x3a,0x22,0x43,0x68,0x72,0x6f,0x6d,0x65,0x22,0x3d,0x3d,0x3d,0x74,0x5b,0x31,0x5d,0x26,0x26,0x6e,0x75,0x6c,0x6c,0x21,0x3d,0x28,0x65,0x3d,0x6f,0x2e,0x6d,0x61,0x74,0x63,0x68,0x28,0x2f,0x5c,0x62,0x4f,0x50,0x52,0x7c,0x45,0x64,0x67,0x65,0x5c,0x2f,0x28,0x5c,0x64,0x2b,0x29,0x2f,0x29,0x29,0x3f,0x7b,0x6e,0x61,0x6d,0x65,0x3a,0x22,0x4f,0x70,0x65,0x72,0x61,0x22,0x2c,0x76,0x65,0x72,0x73,0x69,0x6f,0x6e,0x3a,0x65,0x5b,0x31,0x5d,0x7d,0x3a,0x28,0x74,0x3d,0x74,0x5b,0x32,0x5d,0x3f,0x5b,0x74,0x5b,0x31,0x5d,0x2c,0x74,0x5b,0x32,0x5d,0x5d,0x3a,0x5b,0x6e,0x61,0x76,0x69,0x67,0x61,0x74,0x6f,0x72,0x2e,0x61,0x70,0x70,0x4e,0x61,0x6d,0x65,0x2c,0x6e,0x61,0x76,0x69,0x67,0x61,0x74,0x6f,0x72,0x2e,0x61,0x70,0x70,0x56,0x65,0x72,0x73,0x69,0x6f,0x6e,0x2c,0x22,0x2d,0x3f,0x22,0x5d,0x2c,0x6e,0x75,0x6c,0x6c,0x21,0x3d,0x28,0x65,0x3d,0x6f,0x2e,0x6d,0x61,0x74,0x63,0x68,0x28,0x2f,0x76,0x65,0x72,0x73,0x69,0x6f,0x6e,0x5c,0x2f,0x28,0x5c,0x64,0x2b,0x29,0x2f,0x69,0x29,0x29,0x26,0x26,0x74,0x2e,0x73,0x70,0x6c,0x69,0x63,0x65,0x28,0x31,0x2c,0x31,0x2c,0x65,0x5b,0x31,0x5d,0x29,0x2c,0x7b,0x6e,0x61,0x6d,0x65,0x3a,0x74,0x5b,0x30,0x5d,0x2c,0x76,0x65,0x72,0x73,0x69,0x6f,0x6e,0x3a,0x74,0x5b,0x31,0x5d,0x7d,0x29,0x7d,0x76,0x61,0x72,0x20,0x62,0x72,0x6f,0x77,0x73,0x65,0x72,0x3d,0x67,0x65,0x74,0x42,0x72,0x6f,0x77,0x73,0x65,0x72,0x28,0x29,0x2c,0x63,0x75,0x72,0x72,0x65,0x6e,0x74,0x42,0x72,0x6f,0x77,0x73,0x65,0x72,0x3d,0x62,0x72,0x6f,0x77,0x73,0x65,0x72,0x2e,0x6e,0x61,0x6d,0x65,0x2b,0x62,0x72,0x6f,0x77,0x73,0x65,0x72,0x2e,0x76,0x65,0x72,0x73,0x69,0x6f,0x6e,0x3b,0x28,0x62,0x72,0x6f,0x77,0x73,0x65,0x72,0x2e,0x6e,0x61,0x6d,0x65,0x3d,0x62,0x72,0x6f,0x77,0x73,0x65,0x72,0x2e,0x76,0x65,0x72,0x73,0x69,0x6f,0x6e,0x3c,0x31,0x32,0x29,0x3f,0x74,0x65,0x78,0x74,0x54,0x6f,0x44,0x69,0x73,0x70,0x6c,0x61,0x79,0x3d,0x22,0x45,0x72,0x72,0x6f,0x72,0x3a,0x20,0x22,0x2b,0x63,0x75,0x72,0x72,0x65,0x6e,0x74,0x42,0x72,0x6f,0x77,0x73,0x65,0x72,0x2b,0x22,0x20,0x69,0x73,0x20,0x6e,0x6f,0x74,0x20,0x73,0x75,0x70,0x70,0x6f,0x72,0x74,0x65,0x64,0x21,0x20,0x50,0x6c,0x65,0x61,0x73,0x65,0x20,0x74,0x72,0x79,0x20,0x61,0x20,0x6d,0x6f,0x64,0x65,0x72,0x6e,0x20,0x77,0x65,0x62,0x20,0x62,0x72,0x6f,0x77,0x73,0x65,0x72,0x2e,0x22,0x3a,0x74,0x65,0x78,0x74,0x54,0x6f,0x44,0x69,0x73,0x70,0x6c,0x61,0x79,0x3d,0x22,0x46,0x65,0x74,0x63,0x68,0x69,0x6e,0x67,0x20,0x6c,0x6f,0x67,0x20,0x65,0x6e,0x74,0x72,0x69,0x65,0x73,0x2e,0x2e,0x2e,0x22,0x2c,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x67,0x65,0x74,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,0x22,0x63,0x6f,0x70,0x79,0x54,0x65,0x78,0x74,0x5f,0x31,0x22,0x29,0x2e,0x69,0x6e,0x6e,0x65,0x72,0x48,0x54,0x4d,0x4c,0x3d,0x74,0x65,0x78,0x74,0x54,0x6f,0x44,0x69,0x73,0x70,0x6c,0x61,0x79,0x2c,0x6c,0x6f,0x6f,0x70,0x44,0x65,0x4c,0x6f,0x6f,0x70,0x28,0x31,0x65,0x33,0x2c,0x30,0x29,0x3b,0x76,0x61,0x72,0x20,0x6c,0x6f,0x67,0x4e,0x65,0x78,0x74,0x53,0x65,0x71,0x2c,0x6c,0x6f,0x67,0x4c,0x65,0x76,0x65,0x6c,0x3d,0x6e,0x65,0x77,0x20,0x41,0x72,0x72,0x61,0x79,0x28,0x22,0x55,0x6e,0x75,0x73,0x65,0x64,0x22,0x2c,0x22,0x45,0x72,0x72,0x6f,0x72,0x22,0x2c,0x22,0x49,0x6e,0x66,0x6f,0x22,0x2c,0x22,0x44,0x65,0x62,0x75,0x67,0x22,0x2c,0x22,0x44,0x65,0x62,0x75,0x67,0x20,0x4d,0x6f,0x72,0x65,0x22,0x2c,0x22,0x55,0x6e,0x64,0x65,0x66,0x69,0x6e,0x65,0x64,0x22,0x2c,0x22,0x55,0x6e,0x64,0x65,0x66,0x69,0x6e,0x65,0x64,0x22,0x2c,0x22,0x55,0x6e,0x64,0x65,0x66,0x69,0x6e,0x65,0x64,0x22,0x2c,0x22,0x55,0x6e,0x64,0x65,0x66,0x69,0x6e,0x65,0x64,0x22,0x2c,0x22,0x44,0x65,0x62,0x75,0x67,0x20,0x44,0x65,0x76,0x22,0x29,0x3b,0x66,0x75,0x6e,0x63,0x74,0x69,0x6f,0x6e,0x20,0x6c,0x6f,0x6f,0x70,0x44,0x65,0x4c,0x6f,0x6f,0x70,0x28,0x65,0x2c,0x6f,0x29,0x7b,0x76,0x61,0x72,0x20,0x74,0x2c,0x6e,0x3b,0x69,0x73,0x4e,0x61,0x4e,0x28,0x6f,0x29,0x26,0x26,0x28,0x6f,0x3d,0x31,0x29,0x2c,0x6e,0x75,0x6c,0x6c,0x3d,0x3d,0x65,0x26,0x26,0x28,0x65,0x3d,0x31,0x65,0x33,0x29,0x2c,0x73,0x63,0x72,0x6f,0x6c,0x6c,0x69,0x6e,0x67,0x5f,0x74,0x79,0x70,0x65,0x3d,0x65,0x3c,0x3d,0x35,0x30,0x30,0x3f,0x22,0x61,0x75,0x74,0x6f,0x22,0x3a,0x22,0x73,0x6d,0x6f,0x6f,0x74,0x68,0x22,0x3b,0x76,0x61,0x72,0x20,0x72,0x3d,0x22,0x22,0x2c,0x6c,0x3d,0x30,0x2c,0x73,0x3d,0x73,0x65,0x74,0x49,0x6e,0x74,0x65,0x72,0x76,0x61,0x6c,0x28,0x66,0x75,0x6e,0x63,0x74,0x69,0x6f,0x6e,0x28,0x29,0x7b,0x6c,0x3e,0x30,0x3f,0x63,0x6c,0x65,0x61,0x72,0x49,0x6e,0x74,0x65,0x72,0x76,0x61,0x6c,0x28,0x73,0x29,0x3a,0x28,0x2b,0x2b,0x6f,0x3e,0x31,0x3f,0x6c,0x3d,0x31,0x3a,0x66,0x65,0x74,0x63,0x68,0x28,0x22,0x2f,0x6c,0x6f,0x67,0x6a,0x73,0x6f,0x6e,0x22,0x2b,0x28,0x6e,0x75,0x6c,0x6c,0x21,0x3d,0x6c,0x6f,0x67,0x4e,0x65,0x78,0x74,0x53,0x65,0x71,0x3f,0x22,0x3f,0x73,0x69,0x6e,0x63,0x65,0x3d,0x22,0x2b,0x6c,0x6f,0x67,0x4e,0x65,0x78,0x74,0x53,0x65,0x71,0x3a,0x22,0x22,0x29,0x29,0x2e,0x74,0x68,0x65,0x6e,0x28,0x66,0x75,0x6e,0x63,0x74,0x69,0x6f,0x6e,0x28,0x6f,0x29,0x7b,0x32,0x30,0x30,0x3d,0x3d,0x3d,0x6f,0x2e,0x73,0x74,0x61,0x74,0x75,0x73,0x3f,0x6f,0x2e,0x6a,0x73,0x6f,0x6e,0x28,0x29,0x2e,0x74,0x68,0x65,0x6e,0x28,0x66,0x75,0x6e,0x63,0x74,0x69,0x6f,0x6e,0x28,0x6f,0x29,0x7b,0x76,0x61,0x72,0x20,0x6c,0x3b,0x66,0x6f,0x72,0x28,0x6e,0x75,0x6c,0x6c,0x3d,0x3d,0x6e,0x26,0x26,0x28,0x6e,0x3d,0x22,0x22,0x29,0x2c,0x74,0x3d,0x30,0x3b,0x74,0x3c,0x6f,0x2e,0x4c,0x6f,0x67,0x2e,0x6e,0x72,0x45,0x6e,0x74,0x72,0x69,0x65,0x73,0x3b,0x2b,0x2b,0x74,0x29,0x74,0x72,0x79,0x7b,0x6c,0x3d,0x6f,0x2e,0x4c,0x6f,0x67,0x2e,0x45,0x6e,0x74,0x72,0x69,0x65,0x73,0x5b,0x74,0x5d,0x2e,0x74,0x69,0x6d,0x65,0x73,0x74,0x61,0x6d,0x70,0x7d,0x63,0x61,0x74,0x63,0x68,0x28,0x65,0x29,0x7b,0x6c,0x3d,0x65,0x2e,0x6e,0x61,0x6d,0x65,0x7d,0x66,0x69,0x6e,0x61,0x6c,0x6c,0x79,0x7b,0x22,0x54,0x79,0x70,0x65,0x45,0x72,0x72,0x6f,0x72,0x22,0x21,0x3d,0x3d,0x6c,0x26,0x26,0x28,0x72,0x3d,0x6f,0x2e,0x4c,0x6f,0x67,0x2e,0x45,0x6e,0x74,0x72,0x69,0x65,0x73,0x5b,0x74,0x5d,0x2e,0x74,0x69,0x6d,0x65,0x73,0x74,0x61,0x6d,0x70,0x2c,0x6e,0x2b,0x3d,0x22,0x3c,0x64,0x69,0x76,0x20,0x63,0x6c,0x61,0x73,0x73,0x3d,0x6c,0x65,0x76,0x65,0x6c,0x5f,0x22,0x2b,0x6f,0x2e,0x4c,0x6f,0x67,0x2e,0x45,0x6e,0x74,0x72,0x69,0x65,0x73,0x5b,0x74,0x5d,0x2e,0x6c,0x65,0x76,0x65,0x6c,0x2b,0x22,0x20,0x69,0x64,0x3d,0x22,0x2b,0x72,0x2b,0x27,0x3e,0x3c,0x66,0x6f,0x6e,0x74,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x3d,0x22,0x67,0x72,0x61,0x79,0x22,0x3e,0x27,0x2b,0x6f,0x2e,0x4c,0x6f,0x67,0x2e,0x45,0x6e,0x74,0x72,0x69,0x65,0x73,0x5b,0x74,0x5d,0x2e,0x74,0x69,0x6d,0x65,0x73,0x74,0x61,0x6d,0x70,0x2b,0x22,0x3a,0x3c,0x2f,0x66,0x6f,0x6e,0x74,0x3e,0x20,0x22,0x2b,0x6f,0x2e,0x4c,0x6f,0x67,0x2e,0x45,0x6e,0x74,0x72,0x69,0x65,0x73,0x5b,0x74,0x5d,0x2e,0x74,0x65,0x78,0x74,0x2b,0x22,0x3c,0x2f,0x64,0x69,0x76,0x3e,0x22,0x29,0x7d,0x65,0x3d,0x6f,0x2e,0x4c,0x6f,0x67,0x2e,0x54,0x54,0x4c,0x2c,0x6e,0x75,0x6c,0x6c,0x21,0x3d,0x6f,0x2e,0x4c,0x6f,0x67,0x2e,0x6e,0x65,0x78,0x74,0x26,0x26,0x28,0x6c,0x6f,0x67,0x4e,0x65,0x78,0x74,0x53,0x65,0x71,0x3d,0x6f,0x2e,0x4c,0x6f,0x67,0x2e,0x6e,0x65,0x78,0x74,0x29,0x2c,0x22,0x22,0x21,0x3d,0x3d,0x6e,0x26,0x26,0x28,0x22,0x46,0x65,0x74,0x63,0x68,0x69,0x6e,0x67,0x20,0x6c,0x6f,0x67,0x20,0x65,0x6e,0x74,0x72,0x69,0x65,0x73,0x2e,0x2e,0x2e,0x22,0x3d,0x3d,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x67,0x65,0x74,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,0x22,0x63,0x6f,0x70,0x79,0x54,0x65,0x78,0x74,0x5f,0x31,0x22,0x29,0x2e,0x69,0x6e,0x6e,0x65,0x72,0x48,0x54,0x4d,0x4c,0x26,0x26,0x28,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x67,0x65,0x74,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,0x22,0x63,0x6f,0x70,0x79,0x54,0x65,0x78,0x74,0x5f,0x31,0x22,0x29,0x2e,0x69,0x6e,0x6e,0x65,0x72,0x48,0x54,0x4d,0x4c,0x3d,0x22,0x22,0x29,0x2c,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x67,0x65,0x74,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,0x22,0x63,0x6f,0x70,0x79,0x54,0x65,0x78,0x74,0x5f,0x31,0x22,0x29,0x2e,0x69,0x6e,0x6e,0x65,0x72,0x48,0x54,0x4d,0x4c,0x2b,0x3d,0x6e,0x29,0x2c,0x6e,0x3d,0x22,0x22,0x2c,0x61,0x75,0x74,0x6f,0x73,0x63,0x72,0x6f,0x6c,0x6c,0x5f,0x6f,0x6e,0x3d,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x67,0x65,0x74,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,0x22,0x61,0x75,0x74,0x6f,0x73,0x63,0x72,0x6f,0x6c,0x6c,0x22,0x29,0x2e,0x63,0x68,0x65,0x63,0x6b,0x65,0x64,0x2c,0x31,0x3d,0x3d,0x61,0x75,0x74,0x6f,0x73,0x63,0x72,0x6f,0x6c,0x6c,0x5f,0x6f,0x6e,0x26,0x26,0x22,0x22,0x21,0x3d,0x3d,0x72,0x26,0x26,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x67,0x65,0x74,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,0x72,0x29,0x2e,0x73,0x63,0x72,0x6f,0x6c,0x6c,0x49,0x6e,0x74,0x6f,0x56,0x69,0x65,0x77,0x28,0x7b,0x62,0x65,0x68,0x61,0x76,0x69,0x6f,0x72,0x3a,0x73,0x63,0x72,0x6f,0x6c,0x6c,0x69,0x6e,0x67,0x5f,0x74,0x79,0x70,0x65,0x7d,0x29,0x2c,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x67,0x65,0x74,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,0x22,0x63,0x75,0x72,0x72,0x65,0x6e,0x74,0x5f,0x6c,0x6f,0x67,0x6c,0x65,0x76,0x65,0x6c,0x22,0x29,0x2e,0x69,0x6e,0x6e,0x65,0x72,0x48,0x54,0x4d,0x4c,0x3d,0x22,0x4c,0x6f,0x67,0x67,0x69,0x6e,0x67,0x3a,0x20,0x22,0x2b,0x6c,0x6f,0x67,0x4c,0x65,0x76,0x65,0x6c,0x5b,0x6f,0x2e,0x4c,0x6f,0x67,0x2e,0x53,0x65,0x74,0x74,0x69,0x6e,0x67,0x73,0x57,0x65,0x62,0x4c,0x6f,0x67,0x4c,0x65,0x76,0x65,0x6c,0x5d,0x2b,0x22,0x20,0x28,0x22,0x2b,0x6f,0x2e,0x4c,0x6f,0x67,0x2e,0x53,0x65,0x74,0x74,0x69,0x6e,0x67,0x73,0x57,0x65,0x62,0x4c,0x6f,0x67,0x4c,0x65,0x76,0x65,0x6c,0x2b,0x22,0x29,0x22,0x2c,0x63,0x6c,0x65,0x61,0x72,0x49,0x6e,0x74,0x65,0x72,0x76,0x61,0x6c,0x28,0x73,0x29,0x2c,0x6c,0x6f,0x6f,0x70,0x44,0x65,0x4c,0x6f,0x6f,0x70,0x28,0x65,0x2c,0x30,0x29,0x7d,0x29,0x3a,0x63,0x6f,0x6e,0x73,0x6f,0x6c,0x65,0x2e,0x6c,0x6f,0x67,0x28,0x22,0x4c,0x6f,0x6f,0x6b,0x73,0x20,0x6c,0x69,0x6b,0x65,0x20,0x74,0x68,0x65,0x72,0x65,0x20,0x77,0x61,0x73,0x20,0x61,0x20,0x70,0x72,0x6f,0x62,0x6c,0x65,0x6d,0x2e,0x20,0x53,0x74,0x61,0x74,0x75,0x73,0x20,0x43,0x6f,0x64,0x65,0x3a,0x20,0x22,0x2b,0x6f,0x2e,0x73,0x74,0x61,0x74,0x75,0x73,0x29,0x7d,0x29,0x2e,0x63,0x61,0x74,0x63,0x68,0x28,0x66,0x75,0x6e,0x63,0x74,0x69,0x6f,0x6e,0x28,0x6f,0x29,0x7b,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x67,0x65,0x74,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,0x22,0x63,0x6f,0x70,0x79,0x54,0x65,0x78,0x74,0x5f,0x31,0x22,0x29,0x2e,0x69,0x6e,0x6e,0x65,0x72,0x48,0x54,0x4d,0x4c,0x2b,0x3d,0x22,0x3c,0x64,0x69,0x76,0x3e,0x3e,0x3e,0x20,0x22,0x2b,0x6f,0x2e,0x6d,0x65,0x73,0x73,0x61,0x67,0x65,0x2b,0x22,0x20,0x3c,0x3c,0x3c,0x2f,0x64,0x69,0x76,0x3e,0x22,0x2c,0x61,0x75,0x74,0x6f,0x73,0x63,0x72,0x6f,0x6c,0x6c,0x5f,0x6f,0x6e,0x3d,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x67,0x65,0x74,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,0x22,0x61,0x75,0x74,0x6f,0x73,0x63,0x72,0x6f,0x6c,0x6c,0x22,0x29,0x2e,0x63,0x68,0x65,0x63,0x6b,0x65,0x64,0x2c,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x67,0x65,0x74,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,0x22,0x63,0x6f,0x70,0x79,0x54,0x65,0x78,0x74,0x5f,0x31,0x22,0x29,0x2e,0x73,0x63,0x72,0x6f,0x6c,0x6c,0x54,0x6f,0x70,0x3d,0x64,0x6f,0x63,0x75,0x6d,0x65,0x6e,0x74,0x2e,0x67,0x65,0x74,0x45,0x6c,0x65,0x6d,0x65,0x6e,0x74,0x42,0x79,0x49,0x64,0x28,0x22,0x63,0x6f,0x70,0x79,0x54,0x65,0x78,0x74,0x5f,0x31,0x22,0x29,0x2e,0x73,0x63,0x72,0x6f,0x6c,0x6c,0x48,0x65,0x69,0x67,0x68,0x74,0x2c,0x65,0x3d,0x35,0x65,0x33,0x2c,0x63,0x6c,0x65,0x61,0x72,0x49,0x6e,0x74,0x65,0x72,0x76,0x61,0x6c,0x28,0x73,0x29,0x2c,0x6c,0x6f,0x6f,0x70,0x44,0x65,0x4c,0x6f,0x6f,0x70,0x28,0x65,0x2c,0x30,0x29,0x7d,0x29,0x2c,0x6c,0x3d,0x31,0x29,0x7d,0x2c,0x65,0x29,0x7d,0};
 #endif // WEBSERVER_INCLUDE_JS
 
 #endif // WEBSTATICDATA_h
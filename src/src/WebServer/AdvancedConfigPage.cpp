@@ -8,6 +8,7 @@
 #include "../WebServer/Markup_Forms.h"
 #include "../WebServer/ESPEasy_WebServer.h"
 
+#include "../ESPEasyCore/ESPEasyRules.h"
 #include "../ESPEasyCore/ESPEasyWifi.h"
 
 #include "../Globals/ESPEasy_time.h"
@@ -19,6 +20,7 @@
 #include "../Helpers/ESPEasy_time.h"
 #include "../Helpers/Hardware.h"
 #include "../Helpers/Hardware_defines.h"
+#include "../Helpers/Networking.h"
 #include "../Helpers/StringConverter.h"
 
 void setLogLevelFor(uint8_t destination, LabelType::Enum label) {
@@ -53,9 +55,19 @@ void handle_advanced() {
     webArg2ip(F("syslogip"), Settings.Syslog_IP);
     Settings.WebserverPort = getFormItemInt(F("webport"));
     Settings.UDPPort = getFormItemInt(F("udpport"));
+    #if FEATURE_ESPEASY_P2P
+    webArg2ip(F("p2pmcast"), Settings.P2P_MulticastGroup);
+
+    if (!P2P_useMulticast()) {
+      ZERO_FILL(Settings.P2P_MulticastGroup);
+    }
+    #endif // if FEATURE_ESPEASY_P2P
 
     Settings.SyslogFacility = getFormItemInt(F("syslogfacility"));
     Settings.SyslogPort     = getFormItemInt(F("syslogport"));
+    #if FEATURE_SYSLOG_BUFFER
+    Settings.SyslogBatchLines(isFormItemChecked(F("syslogbatch")));
+    #endif // if FEATURE_SYSLOG_BUFFER
     Settings.UseSerial      = isFormItemChecked(LabelType::ENABLE_SERIAL_PORT_CONSOLE);
 
 #if FEATURE_DEFINE_SERIAL_CONSOLE_PORT
@@ -93,6 +105,10 @@ void handle_advanced() {
     Settings.ConnectionFailuresThreshold = getFormItemInt(LabelType::CONNECTION_FAIL_THRESH);
     Settings.ArduinoOTAEnable            = isFormItemChecked(F("arduinootaenable"));
     Settings.UseRTOSMultitasking         = isFormItemChecked(F("usertosmultitasking"));
+    Settings.FastFirstSample(isFormItemChecked(F("fastfirstsample")));
+    #if FEATURE_CONTROLLER_QUEUE_TASK
+    Settings.EnableControllerQueueTask(isFormItemChecked(LabelType::ENABLE_CONTROLLER_QUEUE_TASK));
+    #endif // if FEATURE_CONTROLLER_QUEUE_TASK
 
     // MQTT settings now moved to the controller settings.
 //    Settings.MQTTRetainFlag_unused              = isFormItemChecked(F("mqttretainflag"));
@@ -143,6 +159,16 @@ void handle_advanced() {
     #endif
 
     Settings.EnableRulesCaching(isFormItemChecked(LabelType::ENABLE_RULES_CACHING));
+    Settings.EnableRulesEventFilter(isFormItemChecked(LabelType::ENABLE_RULES_EVENT_FILTER));
+#if FEATURE_RULES_COMPILED
+    if (Settings.EnableRulesCompiled() != isFormItemChecked(LabelType::ENABLE_RULES_COMPILED)) {
+      Settings.EnableRulesCompiled(!Settings.EnableRulesCompiled());
+      // Rules cache needs to be rebuilt using the other format
+      checkRuleSets();
+    }
+#endif // if FEATURE_RULES_COMPILED
+    Settings.EventQueueOverflowPolicy(static_cast<EventQueueOverflowPolicy_e>(getFormItemInt(LabelType::EVENT_QUEUE_OVERFLOW_POLICY)));
+    Settings.RulesEventBudget_usec = getFormItemInt(LabelType::RULES_EVENT_BUDGET);
 //    Settings.EnableRulesEventReorder(isFormItemChecked(LabelType::ENABLE_RULES_EVENT_REORDER)); // TD-er: Disabled for now
 
 #ifndef NO_HTTP_UPDATER
@@ -174,6 +200,35 @@ void handle_advanced() {
   addFormCheckBox(F("Old Engine"), F("oldrulesengine"), Settings.OldRulesEngine());
   #endif // WEBSERVER_NEW_RULES
   addFormCheckBox(LabelType::ENABLE_RULES_CACHING, Settings.EnableRulesCaching());
+  addFormCheckBox(LabelType::ENABLE_RULES_EVENT_FILTER, Settings.EnableRulesEventFilter());
+  addFormNote(F("Requires Rules Cache. Events which cannot match any rule are not queued and not logged"));
+#if FEATURE_RULES_COMPILED
+  addFormCheckBox(LabelType::ENABLE_RULES_COMPILED, Settings.EnableRulesCompiled());
+  addFormNote(F("Requires Rules Cache. Parse rules once and execute the pre-parsed form"));
+#endif // if FEATURE_RULES_COMPILED
+  {
+    const __FlashStringHelper * options[] = {
+      toString(EventQueueOverflowPolicy_e::DropOldest),
+      toString(EventQueueOverflowPolicy_e::DropNewest),
+      toString(EventQueueOverflowPolicy_e::CoalesceEventName)
+    };
+    const int optionValues[] = {
+      static_cast<int>(EventQueueOverflowPolicy_e::DropOldest),
+      static_cast<int>(EventQueueOverflowPolicy_e::DropNewest),
+      static_cast<int>(EventQueueOverflowPolicy_e::CoalesceEventName)
+    };
+    constexpr int nrOptions = NR_ELEMENTS(optionValues);
+    addFormSelector(getLabel(LabelType::EVENT_QUEUE_OVERFLOW_POLICY),
+                    getInternalLabel(LabelType::EVENT_QUEUE_OVERFLOW_POLICY),
+                    nrOptions,
+                    options,
+                    optionValues,
+                    static_cast<int>(Settings.EventQueueOverflowPolicy()));
+    addFormNote(F("What to do with new events when the event queue is full"));
+  }
+  addFormNumericBox(LabelType::RULES_EVENT_BUDGET, Settings.getRulesEventBudget(), 100, 60000);
+  addUnit(F("usec"));
+  addFormNote(F("Max. time per loop to process queued events. At least one event is processed per loop"));
 //  addFormCheckBox(LabelType::ENABLE_RULES_EVENT_REORDER, Settings.EnableRulesEventReorder()); // TD-er: Disabled for now
 
   addFormCheckBox(F("Tolerant last parameter"), F("tolerantargparse"), Settings.TolerantLastArgParse());
@@ -225,6 +280,10 @@ void handle_advanced() {
 
   addFormLogLevelSelect(LabelType::SYSLOG_LOG_LEVEL, Settings.SyslogLevel);
   addFormLogFacilitySelect(F("Syslog Facility"), F("syslogfacility"), Settings.SyslogFacility);
+  #if FEATURE_SYSLOG_BUFFER
+  addFormCheckBox(F("Syslog Batch Lines"), F("syslogbatch"), Settings.SyslogBatchLines());
+  addFormNote(F("Send multiple newline separated lines per UDP packet. Syslog server must split packets on newlines"));
+  #endif // if FEATURE_SYSLOG_BUFFER
   addFormLogLevelSelect(LabelType::SERIAL_LOG_LEVEL, Settings.SerialLogLevel);
   addFormLogLevelSelect(LabelType::WEB_LOG_LEVEL,    Settings.WebLogLevel);
 
@@ -269,6 +328,10 @@ void handle_advanced() {
   addFormSubHeader(F("Inter-ESPEasy Network"));
   if (Settings.UDPPort != 8266 ) addFormNote(F("Preferred P2P port is 8266"));
   addFormNumericBox(F("ESPEasy p2p UDP port"), F("udpport"), Settings.UDPPort, 0, 65535);
+  #if FEATURE_ESPEASY_P2P
+  addFormIPBox(F("ESPEasy p2p Multicast Group"), F("p2pmcast"), Settings.P2P_MulticastGroup);
+  addFormNote(F("224.0.0.0 - 239.255.255.255, same on all nodes. Empty: use broadcast"));
+  #endif // if FEATURE_ESPEASY_P2P
 
   // TODO sort settings in groups or move to other pages/groups
   addFormSubHeader(F("Special and Experimental Settings"));
@@ -292,8 +355,15 @@ void handle_advanced() {
   addFormCheckBox(F("Enable Arduino OTA"), F("arduinootaenable"), Settings.ArduinoOTAEnable);
   #endif // if FEATURE_ARDUINO_OTA
   #if defined(ESP32)
-  addFormCheckBox_disabled(F("Enable RTOS Multitasking"), F("usertosmultitasking"), Settings.UseRTOSMultitasking);
+  addFormCheckBox(F("Enable RTOS Multitasking"), F("usertosmultitasking"), Settings.UseRTOSMultitasking);
+  addFormNote(F("Run the web server and p2p network in a separate task. Requires reboot"));
   #endif // if defined(ESP32)
+  #if FEATURE_CONTROLLER_QUEUE_TASK
+  addFormCheckBox(LabelType::ENABLE_CONTROLLER_QUEUE_TASK, Settings.EnableControllerQueueTask());
+  addFormNote(F("Send queued messages of HTTP based controllers from a separate task. Requires reboot"));
+  #endif // if FEATURE_CONTROLLER_QUEUE_TASK
+  addFormCheckBox(F("Fast First Sample"), F("fastfirstsample"), Settings.FastFirstSample());
+  addFormNote(F("Start web server, mDNS, SSDP, notifications and rules after the first task has sent its values. Requires reboot"));
 
   addFormCheckBox(LabelType::JSON_BOOL_QUOTES, Settings.JSONBoolWithoutQuotes());
 #if FEATURE_TIMING_STATS
@@ -6,6 +6,7 @@
 # include "../WebServer/AccessControl.h"
 # include "../WebServer/HTML_wrappers.h"
 # include "../WebServer/JSON.h"
+# include "../WebServer/Markup_Forms.h"
 # include "../CustomBuild/ESPEasyLimits.h"
 # include "../DataStructs/DeviceStruct.h"
 # include "../DataStructs/ESPEasyControllerCache_CSV_dumper.h"
@@ -20,18 +21,17 @@
 # include "../Helpers/Misc.h"
 
 
+# ifndef CACHE_EXPORT_BUFFER_SIZE
+#  define CACHE_EXPORT_BUFFER_SIZE  512
+# endif // ifndef CACHE_EXPORT_BUFFER_SIZE
+
 // ********************************************************************************
-// URLs needed for C016_CacheController
-// to help dump the content of the binary log files
+// Helper functions to parse the export arguments
 // ********************************************************************************
-void handle_dumpcache() {
-  if (!isLoggedIn()) { return; }
-
-  // Filters/export settings
-  char separator     = ';';
-  bool joinTimestamp = false;
-  bool onlySetTasks  = false;
-
+static void getCacheExportCSVSettings(char& separator, bool& joinTimestamp, bool& onlySetTasks) {
+  separator     = ';';
+  joinTimestamp = false;
+  onlySetTasks  = false;
 
   if (hasArg(F("separator"))) {
     String sep = webArg(F("separator"));
@@ -52,37 +52,206 @@ void handle_dumpcache() {
   if (hasArg(F("onlysettasks"))) {
     onlySetTasks = true;
   }
+}
 
-  {
-    // Send HTTP headers to directly save the dump as a CSV file
-    String str =  F("attachment; filename=cachedump_");
-    str += Settings.getName();
-    str += F("_U");
-    str += Settings.Unit;
-
-    if (node_time.systemTimePresent())
-    {
-      str += '_';
-      str += node_time.getDateTimeString('\0', '\0', '\0');
+# if FEATURE_RTC_CACHE_INDEX
+
+// Time range, either as unix time or as the last N hours
+static void getCacheExportTimeRange(uint32_t& startTime, uint32_t& endTime) {
+  startTime = getFormItemInt(F("start"), 0);
+  endTime   = getFormItemInt(F("end"), 0);
+
+  if (hasArg(F("hours")) && node_time.systemTimePresent()) {
+    const uint32_t hours = getFormItemInt(F("hours"), 0);
+
+    if (hours != 0) {
+      startTime = node_time.getUnixTime() - hours * 3600;
     }
-    str += F(".csv");
+  }
+}
+
+# endif // if FEATURE_RTC_CACHE_INDEX
+
+static void sendCacheExportHeader(const __FlashStringHelper *extension) {
+  // Send HTTP headers to directly save the dump as a file
+  String str =  F("attachment; filename=cachedump_");
+
+  str += Settings.getName();
+  str += F("_U");
+  str += Settings.Unit;
 
-    sendHeader(F("Content-Disposition"), str);
-    TXBuffer.startStream(F("application/octet-stream"), F("*"), 200);
+  if (node_time.systemTimePresent())
+  {
+    str += '_';
+    str += node_time.getDateTimeString('\0', '\0', '\0');
   }
+  str += extension;
 
+  sendHeader(F("Content-Disposition"), str);
+}
 
+static void streamCacheCSV(char     separator,
+                           bool     joinTimestamp,
+                           bool     onlySetTasks,
+                           int      startFileNr,
+                           int      startPos,
+                           uint32_t startTime,
+                           uint32_t endTime) {
   ESPEasyControllerCache_CSV_dumper dumper(
-    joinTimestamp, 
-    onlySetTasks, 
-    separator, 
+    joinTimestamp,
+    onlySetTasks,
+    separator,
     ESPEasyControllerCache_CSV_dumper::Target::CSV_file);
 
+  if ((startFileNr != 0) || (startPos != 0)) {
+    dumper.setPeekFilePos(startFileNr, startPos);
+  }
+# if FEATURE_RTC_CACHE_INDEX
+
+  if ((startTime != 0) || (endTime != 0)) {
+    dumper.setTimeRange(startTime, endTime);
+  }
+# endif // if FEATURE_RTC_CACHE_INDEX
+
   dumper.generateCSVHeader(true);
 
+  // The line buffer of the dumper is reused for each line.
   while (dumper.createCSVLine()) {
     dumper.writeCSVLine(true);
   }
+}
+
+// Send part of a cache file, as stored.
+// @param skip  Nr of bytes to skip, decremented by the size of the part which is skipped in this file.
+static void streamCacheFile(fs::File& f, size_t from, size_t to, uint32_t& skip) {
+  if (to <= from) {
+    return;
+  }
+
+  if (skip >= (to - from)) {
+    skip -= (to - from);
+    return;
+  }
+  from += skip;
+  skip  = 0;
+
+  if (!f.seek(from)) {
+    return;
+  }
+  uint8_t buf[CACHE_EXPORT_BUFFER_SIZE];
+
+  while (from < to) {
+    size_t bytesToRead = to - from;
+
+    if (bytesToRead > sizeof(buf)) {
+      bytesToRead = sizeof(buf);
+    }
+    const size_t bytesRead = f.read(buf, bytesToRead);
+
+    if (bytesRead == 0) {
+      return;
+    }
+    TXBuffer.sendBinary(buf, bytesRead);
+    from += bytesRead;
+  }
+}
+
+// ********************************************************************************
+// URLs needed for C016_CacheController
+// to help dump the content of the binary log files
+// ********************************************************************************
+void handle_dumpcache() {
+  if (!isLoggedIn()) { return; }
+
+  // Filters/export settings
+  char separator     = ';';
+  bool joinTimestamp = false;
+  bool onlySetTasks  = false;
+
+  getCacheExportCSVSettings(separator, joinTimestamp, onlySetTasks);
+
+  uint32_t startTime = 0;
+  uint32_t endTime   = 0;
+# if FEATURE_RTC_CACHE_INDEX
+  getCacheExportTimeRange(startTime, endTime);
+# endif // if FEATURE_RTC_CACHE_INDEX
+
+  sendCacheExportHeader(F(".csv"));
+  TXBuffer.startStream(F("application/octet-stream"), F("*"), 200);
+
+  streamCacheCSV(separator, joinTimestamp, onlySetTasks, 0, 0, startTime, endTime);
+
+  TXBuffer.endStream();
+}
+
+void handle_cache_export() {
+  if (!isLoggedIn()) { return; }
+
+  // Make sure all samples are on the file system
+  C016_flush();
+
+  int startFileNr = getFormItemInt(F("file"), 0);
+  int startPos    = getFormItemInt(F("pos"), 0);
+  int endFileNr   = -1;
+  int endPos      = -1;
+
+  uint32_t startTime = 0;
+  uint32_t endTime   = 0;
+# if FEATURE_RTC_CACHE_INDEX
+  getCacheExportTimeRange(startTime, endTime);
+
+  if ((startTime != 0) || (endTime != 0)) {
+    int fileNr = 0;
+    int pos    = 0;
+    ControllerCache.getIndexedRange(startTime, endTime, fileNr, pos, endFileNr, endPos);
+
+    if (startTime != 0) {
+      startFileNr = fileNr;
+      startPos    = pos;
+    }
+  }
+# endif // if FEATURE_RTC_CACHE_INDEX
+
+  const bool csv = equals(webArg(F("format")), F("csv"));
+
+  sendHeader(F("X-Cache-Start"), String(startFileNr) + ',' + startPos);
+  sendCacheExportHeader(csv ? F(".csv") : F(".bin"));
+  TXBuffer.startStream(F("application/octet-stream"), F("*"), 200);
+
+  if (csv) {
+    char separator     = ';';
+    bool joinTimestamp = false;
+    bool onlySetTasks  = false;
+
+    getCacheExportCSVSettings(separator, joinTimestamp, onlySetTasks);
+    streamCacheCSV(separator, joinTimestamp, onlySetTasks, startFileNr, startPos, startTime, endTime);
+  } else {
+    // Raw cache data, as stored in the files.
+    // The index positions are always at the start of a flush, thus never split a sample or block.
+    uint32_t skip   = getFormItemInt(F("offset"), 0);
+    bool     islast = false;
+    int      fileNr = startFileNr;
+
+    while (!islast) {
+      const String fname = C016_getCacheFileName(fileNr, islast);
+
+      if (fname.isEmpty() || ((endFileNr >= 0) && (fileNr > endFileNr))) {
+        break;
+      }
+      fs::File f = tryOpenFile(fname, "r");
+
+      if (f) {
+        const size_t from = (fileNr == startFileNr) ? startPos : 0;
+        size_t to         = f.size();
+
+        if ((fileNr == endFileNr) && (endPos >= 0) && (static_cast<size_t>(endPos) < to)) {
+          to = endPos;
+        }
+        streamCacheFile(f, from, to, skip);
+      }
+      ++fileNr;
+    }
+  }
 
   TXBuffer.endStream();
 }
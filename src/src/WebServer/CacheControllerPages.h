@@ -11,6 +11,9 @@
 // ********************************************************************************
 void handle_dumpcache();
 
+// Bulk export of the cache, either as stored or as CSV.
+void handle_cache_export();
+
 void handle_cache_json();
 
 void handle_cache_csv();
@@ -2,6 +2,7 @@
 
 #if FEATURE_CHART_JS
 
+#include "../Globals/TXBuffer.h"
 #include "../Helpers/StringConverter.h"
 #include "../WebServer/HTML_wrappers.h"
 
@@ -231,4 +232,95 @@ void add_ChartJS_dataset_footer(bool hidden, const String& options) {
 void add_ChartJS_chart_footer() {
   addHtml(F("]}});</script>"));
 }
+
+void add_ChartJS_binary_decoder() {
+  addHtml(F(
+            "<script>function chartBin(u,id,t,tt){fetch(u).then(r=>r.arrayBuffer()).then(b=>{"
+            "const v=new DataView(b),n=v.getUint16(0,!0),h=JSON.parse(new TextDecoder().decode(new Uint8Array(b,2,n)));"
+            "let p=2+n;const l=[],d=[];"
+            "for(let i=0;i<h.count;++i){let x=i;if(h.labels){const s=v.getUint32(p,!0);p+=4;if(s&&s<=h.now)x=-((h.now-s)/3600).toFixed(2);}l.push(x);}"
+            "for(const s of h.datasets){const a=[];for(let i=0;i<s.count;++i){let x;"
+            "if(s.scale>0){x=v.getInt16(p,!0);p+=2;x=x==-32768?null:x/s.scale;}else{x=v.getFloat32(p,!0);p+=4;if(isNaN(x))x=null;}a.push(x);}"
+            "d.push({label:s.name,backgroundColor:s.color,borderColor:s.color,hidden:s.hidden,data:a});}"
+            "new Chart(document.getElementById(id),{type:t,options:{responsive:false,plugins:{legend:{position:'top'},title:{display:true,text:tt}}},"
+            "data:{labels:l,datasets:d}});});}</script>"));
+}
+
+void add_ChartJS_binary_chart(
+  const __FlashStringHelper *chartType,
+  const __FlashStringHelper *id,
+  const __FlashStringHelper *chartTitle,
+  int                        width,
+  int                        height,
+  const String             & url)
+{
+  addHtml(F("<canvas"));
+  addHtmlAttribute(F("id"),     id);
+  addHtmlAttribute(F("width"),  width);
+  addHtmlAttribute(F("height"), height);
+  addHtml(F("></canvas><script>chartBin('"));
+  addHtml(url);
+  addHtml(F("','"));
+  addHtml(id);
+  addHtml(F("','"));
+  addHtml(chartType);
+  addHtml(F("','"));
+  addHtml(chartTitle);
+  addHtml(F("');</script>"));
+}
+
+void add_ChartJS_binary_header(const String& header) {
+  const uint16_t length = header.length();
+
+  TXBuffer.sendBinary(reinterpret_cast<const uint8_t *>(&length),        sizeof(length));
+  TXBuffer.sendBinary(reinterpret_cast<const uint8_t *>(header.c_str()), length);
+}
+
+float get_ChartJS_binary_scale(float minValue, float maxValue, uint8_t nrDecimals) {
+  if (minValue > maxValue) {
+    // No values
+    return 1.0f;
+  }
+  float scale = 1.0f;
+
+  for (uint8_t i = 0; i < nrDecimals; ++i) {
+    scale *= 10.0f;
+  }
+
+  // -32768 is kept for missing values
+  if (((maxValue * scale) < 32767.5f) && ((minValue * scale) > -32767.5f)) {
+    return scale;
+  }
+  return 0.0f;
+}
+
+ChartJS_binary_array::ChartJS_binary_array(float scale) : _scale(scale) {}
+
+void ChartJS_binary_array::add(float value) {
+  if (_scale > 0.0f) {
+    const int16_t fixed = isnan(value) ? INT16_MIN : static_cast<int16_t>(lroundf(value * _scale));
+    addBytes(&fixed, sizeof(fixed));
+  } else {
+    addBytes(&value, sizeof(value));
+  }
+}
+
+void ChartJS_binary_array::addTimestamp(uint32_t timestamp) {
+  addBytes(&timestamp, sizeof(timestamp));
+}
+
+void ChartJS_binary_array::flush() {
+  if (_pos > 0) {
+    TXBuffer.sendBinary(_buffer, _pos);
+    _pos = 0;
+  }
+}
+
+void ChartJS_binary_array::addBytes(const void *data, size_t size) {
+  if ((_pos + size) > sizeof(_buffer)) {
+    flush();
+  }
+  memcpy(_buffer + _pos, data, size);
+  _pos += size;
+}
 #endif // if FEATURE_CHART_JS
\ No newline at end of file
@@ -15,6 +15,14 @@
 // Split into several parts so a long array of
 // values can also be served directly
 // to reduce memory usage.
+//
+// Charts with many values can also be served
+// as binary data, fetched and decoded by the browser:
+// - add_ChartJS_binary_decoder (once per page)
+// - add_ChartJS_binary_chart
+// The URL then serves:
+// - add_ChartJS_binary_header
+// - ChartJS_binary_array (1x or more)
 // *********************************************
 
 #if FEATURE_CHART_JS
@@ -91,6 +99,57 @@ void add_ChartJS_dataset_footer(bool          hidden  = false,
 
 
 void add_ChartJS_chart_footer();
+
+
+// Binary chart data:
+// - uint16_t length of the JSON header
+// - JSON header: {"count":N,"now":unixtime,"labels":0|1,"datasets":[{"name","color","hidden","count","scale"}]}
+// - When "labels" is 1: uint32_t unix timestamp per label, shown as hours ago (index when 0)
+// - Per dataset "count" values:
+//   scale > 0: int16_t fixed point (value * scale), -32768 for missing values
+//   scale = 0: float, NaN for missing values
+// All values are little endian, like the ESP itself.
+void add_ChartJS_binary_decoder();
+
+void add_ChartJS_binary_chart(
+  const __FlashStringHelper *chartType,
+  const __FlashStringHelper *id,
+  const __FlashStringHelper *chartTitle,
+  int                        width,
+  int                        height,
+  const String             & url);
+
+// Send the JSON header, after the binary stream has been started
+void add_ChartJS_binary_header(const String& header);
+
+// Scale to send values in the range minValue ... maxValue as int16_t fixed point
+// with nrDecimals, or 0 when they must be sent as float.
+float get_ChartJS_binary_scale(float   minValue,
+                               float   maxValue,
+                               uint8_t nrDecimals);
+
+struct ChartJS_binary_array {
+  // @param scale  As returned by get_ChartJS_binary_scale()
+  explicit ChartJS_binary_array(float scale = 0.0f);
+
+  // NaN is sent as missing value
+  void add(float value);
+
+  void addTimestamp(uint32_t timestamp);
+
+  // Send the remaining buffered values
+  void flush();
+
+private:
+
+  void addBytes(const void *data,
+                size_t      size);
+
+  float   _scale;
+  uint8_t  _buffer[256];
+  uint16_t _pos = 0;
+};
+
 #endif // if FEATURE_CHART_JS
 
 #endif // ifndef WEBSERVER_CHART_JS_H
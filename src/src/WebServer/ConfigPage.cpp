@@ -14,6 +14,8 @@
 #include "../DataStructs/NodeStruct.h"
 #endif
 
+#include "../DataStructs/RTCStruct.h"
+
 #include "../ESPEasyCore/Controller.h"
 #include "../ESPEasyCore/ESPEasyNetwork.h"
 
@@ -136,6 +138,9 @@ void handle_config() {
     #endif
 
     Settings.deepSleepOnFail = isFormItemChecked(F("deepsleeponfail"));
+    #if FEATURE_DEEP_SLEEP_BATCH
+    Settings.deepSleep_batchCycles = getFormItemInt(F("sleepbatch"), Settings.deepSleep_batchCycles);
+    #endif // if FEATURE_DEEP_SLEEP_BATCH
     webArg2ip(F("espip"),      Settings.IP);
     webArg2ip(F("espgateway"), Settings.Gateway);
     webArg2ip(F("espsubnet"),  Settings.Subnet);
@@ -257,6 +262,11 @@ void handle_config() {
 
   addFormCheckBox(F("Sleep on connection failure"), F("deepsleeponfail"), Settings.deepSleepOnFail);
 
+  #if FEATURE_DEEP_SLEEP_BATCH
+  addFormNumericBox(F("Send every N-th wake cycle"), F("sleepbatch"), Settings.deepSleep_batchCycles, 0, RTC_DEEPSLEEP_STATE_CYCLES_MASK >> 1);
+  addFormNote(F("0 = Send every cycle, else WiFi stays off and samples are collected by the Cache Controller"));
+  #endif // if FEATURE_DEEP_SLEEP_BATCH
+
   addFormSeparator(2);
 
   html_TR_TD();
@@ -6,11 +6,68 @@
 
 # include "../WebServer/HTML_wrappers.h"
 # include "../WebServer/ESPEasy_WebServer.h"
+# include "../Helpers/StringConverter.h"
 # include "../Helpers/WebServer_commandHelper.h"
 
 # include "../../ESPEasy-Globals.h"
 
 
+// ********************************************************************************
+// Execute a batch of commands in order and reply with a JSON array of the results:
+// [{"return": "OK","command": "gpio,12,1"},...]
+// ********************************************************************************
+static void handle_control_batch(std::vector<String>& commands) {
+  bool first = true;
+
+  for (auto it = commands.begin(); it != commands.end(); ++it) {
+    const HandledWebCommand_result res = handle_command_from_web(EventValueSource::Enum::VALUE_SOURCE_HTTP, *it);
+
+    if (res == HandledWebCommand_result::IP_not_allowed) {
+      return;
+    }
+
+    if (first) {
+      TXBuffer.startJsonStream();
+      addHtml('[');
+      first = false;
+    } else {
+      addHtml(',');
+    }
+
+    if (printToWebJSON && !printWebString.isEmpty()) {
+      // Already formatted as JSON
+      addHtml(printWebString);
+    } else {
+      String reply = printWebString;
+
+      if (reply.isEmpty()) {
+        reply = (res == HandledWebCommand_result::CommandHandled)
+          ? F("OK")
+          : F("Unknown or restricted command");
+      }
+      addHtml('{');
+      addHtml(to_json_object_value(F("return"), reply, true));
+      addHtml(',');
+      addHtml(to_json_object_value(F("command"), *it, true));
+      addHtml('}');
+    }
+    printWebString = String();
+    printToWeb     = false;
+    printToWebJSON = false;
+
+    // Free memory as soon as possible
+    *it = String();
+  }
+
+  if (first) {
+    // No commands at all
+    TXBuffer.startJsonStream();
+    addHtml('[');
+  }
+  addHtml(']');
+  TXBuffer.endStream();
+}
+
 // ********************************************************************************
 // Web Interface control page (no password!)
 // ********************************************************************************
@@ -19,7 +76,17 @@ void handle_control() {
   checkRAM(F("handle_control"));
   # endif // ifndef BUILD_NO_RAM_TRACKER
 
-  String webrequest            = webArg(F("cmd"));
+  String webrequest = webArg(F("cmd"));
+
+  {
+    std::vector<String> commands;
+
+    if (split_web_command_batch(webrequest, commands)) {
+      webrequest = String();
+      handle_control_batch(commands);
+      return;
+    }
+  }
   HandledWebCommand_result res = handle_command_from_web(EventValueSource::Enum::VALUE_SOURCE_HTTP, webrequest);
 
   switch (res) {
@@ -9,6 +9,9 @@
 # include "../WebServer/Markup_Buttons.h"
 # include "../WebServer/Markup_Forms.h"
 
+# include "../ControllerQueue/ControllerDelayHandlerStruct.h"
+# include "../ControllerQueue/SampleLatency.h"
+
 # include "../DataStructs/ESPEasy_EventStruct.h"
 
 # include "../ESPEasyCore/Controller.h"
@@ -20,6 +23,7 @@
 # include "../Helpers/_CPlugin_Helper_webform.h"
 # include "../Helpers/_Plugin_SensorTypeHelper.h"
 # include "../Helpers/ESPEasy_Storage.h"
+# include "../Helpers/Misc.h"
 # include "../Helpers/StringConverter.h"
 
 
@@ -276,6 +280,71 @@ void handle_controllers_ShowAllControllersTable()
   html_end_form();
 }
 
+# if FEATURE_CONTROLLER_BACKOFF
+
+// ********************************************************************************
+// Show the retry backoff state of the controller queue
+// ********************************************************************************
+void handle_controllers_ShowBackoffState(controllerIndex_t controllerindex)
+{
+  ControllerBackoff backoff;
+
+  if (!ControllerDelayHandlerStruct::getBackoffState(controllerindex, backoff)) {
+    return;
+  }
+  addRowLabel(F("Circuit State"));
+  addHtml(toString(backoff.getState()));
+
+  if (backoff.getConsecutiveFailures() != 0) {
+    addHtml(strformat(F(", %d failed attempts"), backoff.getConsecutiveFailures()));
+  }
+  const unsigned long nextAttempt = backoff.getNextAttemptTime();
+
+  if (nextAttempt != 0) {
+    addHtml(strformat(F(", next attempt in %d sec"), static_cast<int>((timeDiff(millis(), nextAttempt) + 999) / 1000)));
+  }
+
+  if (backoff.getOpenCount() != 0) {
+    addFormNote(strformat(F("Circuit opened %d times since boot"), static_cast<int>(backoff.getOpenCount())));
+  }
+}
+# endif // if FEATURE_CONTROLLER_BACKOFF
+
+# if FEATURE_SAMPLE_LATENCY
+
+static void addSampleLatency(const SampleLatencyStats& stats)
+{
+  addHtml(strformat(
+            F("min %s, avg %s, p99 %s, max %s ms (%d samples)"),
+            toString(stats.min_usec / 1000.0f, 1).c_str(),
+            toString(stats.getAverage() / 1000.0f, 1).c_str(),
+            toString(stats.getP99() / 1000.0f, 1).c_str(),
+            toString(stats.max_usec / 1000.0f, 1).c_str(),
+            static_cast<int>(stats.count)));
+}
+
+void handle_controllers_ShowSampleLatency(controllerIndex_t controllerindex)
+{
+  const SampleLatencyStats stats = SampleLatency_getController(controllerindex);
+
+  if (stats.isEmpty()) {
+    return;
+  }
+  addRowLabel(F("Sample Latency"));
+  addSampleLatency(stats);
+
+  // Per task latency is of all controllers the task sends to.
+  for (taskIndex_t x = 0; x < TASKS_MAX; ++x) {
+    const SampleLatencyStats taskStats = SampleLatency_getTask(x);
+
+    if (!taskStats.isEmpty() && Settings.TaskDeviceSendData[controllerindex][x]) {
+      addRowLabel(strformat(F("Task %d (%s)"), x + 1, getTaskDeviceName(x).c_str()));
+      addSampleLatency(taskStats);
+    }
+  }
+}
+# endif // if FEATURE_SAMPLE_LATENCY
+
 // ********************************************************************************
 // Show the controller settings page
 // ********************************************************************************
@@ -356,12 +425,22 @@ void handle_controllers_ControllerSettingsPage(controllerIndex_t controllerindex
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_MIN_SEND_INTERVAL);
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_MAX_QUEUE_DEPTH);
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_MAX_RETRIES);
+            addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_MAX_BURST);
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_FULL_QUEUE_ACTION);
+            # if FEATURE_CONTROLLER_QUEUE_SPILL
+            addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_QUEUE_SPILL);
+            # endif // if FEATURE_CONTROLLER_QUEUE_SPILL
 
             if (proto.allowsExpire) {
               addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_ALLOW_EXPIRE);
             }
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_DEDUPLICATE);
+            # if FEATURE_CONTROLLER_BACKOFF
+            handle_controllers_ShowBackoffState(controllerindex);
+            # endif // if FEATURE_CONTROLLER_BACKOFF
+            # if FEATURE_SAMPLE_LATENCY
+            handle_controllers_ShowSampleLatency(controllerindex);
+            # endif // if FEATURE_SAMPLE_LATENCY
           }
 
           if (proto.usesCheckReply) {
@@ -371,6 +450,12 @@ void handle_controllers_ControllerSettingsPage(controllerIndex_t controllerindex
           if (proto.usesTimeout) {
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_TIMEOUT);
           }
+          # if FEATURE_HTTP_KEEP_ALIVE
+
+          if (proto.usesHTTP) {
+            addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_HTTP_KEEP_ALIVE);
+          }
+          # endif // if FEATURE_HTTP_KEEP_ALIVE
 
           if (proto.usesSampleSets) {
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_SAMPLE_SET_INITIATOR);
@@ -407,6 +492,9 @@ void handle_controllers_ControllerSettingsPage(controllerIndex_t controllerindex
             addHtml(getMQTTclientID(*ControllerSettings));
             addFormNote(F("Updated on load of this page"));
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_RETAINFLAG);
+            # if FEATURE_MQTT_TLS
+            addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_MQTT_TLS);
+            # endif // if FEATURE_MQTT_TLS
           }
           # endif // if FEATURE_MQTT
 
@@ -32,6 +32,22 @@ void handle_controllers_CopySubmittedSettings_CPluginCall(uint8_t controllerinde
 // ********************************************************************************
 void handle_controllers_ShowAllControllersTable();
 
+#if FEATURE_CONTROLLER_BACKOFF
+
+// ********************************************************************************
+// Show the retry backoff state of the controller queue
+// ********************************************************************************
+void handle_controllers_ShowBackoffState(controllerIndex_t controllerindex);
+#endif // if FEATURE_CONTROLLER_BACKOFF
+
+#if FEATURE_SAMPLE_LATENCY
+
+// ********************************************************************************
+// Show the time from reading a sample until it was delivered by the controller
+// ********************************************************************************
+void handle_controllers_ShowSampleLatency(controllerIndex_t controllerindex);
+#endif // if FEATURE_SAMPLE_LATENCY
+
 // ********************************************************************************
 // Show the controller settings page
 // ********************************************************************************
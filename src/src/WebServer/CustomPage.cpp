@@ -56,7 +56,7 @@ bool handle_custom(const String& path) {
         TXBuffer.startStream();
         sendHeadandTail(F("TmplDsh"), _HEAD);
         addHtml(F("<meta http-equiv=\"refresh\" content=\"0; URL=http://"));
-        addHtml(formatIP(it->second.IP()));
+        addHtml(formatIP(it->IP()));
         addHtml(F("/dashboard.esp\">"));
         sendHeadandTail(F("TmplDsh"), _TAIL);
         TXBuffer.endStream();
@@ -85,17 +85,17 @@ bool handle_custom(const String& path) {
 
     for (auto it = Nodes.begin(); it != Nodes.end(); ++it)
     {
-      if ((it->second.ip[0] != 0) || (it->first == Settings.Unit))
+      if ((it->ip[0] != 0) || (it->unit == Settings.Unit))
       {
-        String name = String(it->first) + F(" - ");
+        String name = String(it->unit) + F(" - ");
 
-        if (it->first != Settings.Unit) {
-          name += it->second.getNodeName();
+        if (it->unit != Settings.Unit) {
+          name += it->getNodeName();
         }
         else {
           name += Settings.getName();
         }
-        addSelector_Item(name, it->first, choice == it->first);
+        addSelector_Item(name, it->unit, choice == it->unit);
       }
     }
     addSelector_Foot();
@@ -108,7 +108,7 @@ bool handle_custom(const String& path) {
       auto it = Nodes.find(x);
 
       if (it != Nodes.end()) {
-        if (it->second.ip[0] != 0) { prev = x; break; }
+        if (it->ip[0] != 0) { prev = x; break; }
       }
     }
 
@@ -116,7 +116,7 @@ bool handle_custom(const String& path) {
       auto it = Nodes.find(x);
 
       if (it != Nodes.end()) {
-        if (it->second.ip[0] != 0) { next = x; break; }
+        if (it->ip[0] != 0) { next = x; break; }
       }
     }
 
@@ -2,6 +2,7 @@
 
 #ifdef WEBSERVER_DEVICES
 
+# include "../WebServer/Chart_JS.h"
 # include "../WebServer/ESPEasy_WebServer.h"
 # include "../WebServer/HTML_wrappers.h"
 # include "../WebServer/Markup.h"
@@ -15,6 +16,7 @@
 # include "../Globals/ExtraTaskSettings.h"
 # include "../Globals/Nodes.h"
 # include "../Globals/Plugins.h"
+# include "../Globals/RuntimeData.h"
 
 # include "../Static/WebStaticData.h"
 
@@ -24,6 +26,7 @@
 # include "../Helpers/_Plugin_Helper_serial.h"
 # include "../Helpers/ESPEasy_Storage.h"
 # include "../Helpers/Hardware.h"
+# include "../Helpers/I2C_ClockProfile.h"
 # include "../Helpers/I2C_Plugin_Helper.h"
 # include "../Helpers/StringConverter.h"
 # include "../Helpers/StringGenerator_GPIO.h"
@@ -282,6 +285,9 @@ void handle_devices_CopySubmittedSettings(taskIndex_t taskIndex, pluginID_t task
 # endif // if FEATURE_I2CMULTIPLEXER
 
     Settings.I2C_Flags[taskIndex] = flags;
+# if FEATURE_I2C_CLOCK_PROFILE
+    Settings.setI2CClockProfile(taskIndex, getFormItemInt(F("taskdeviceflags2"), 0));
+# endif // if FEATURE_I2C_CLOCK_PROFILE
   }
 
   // Must load from file system to make sure all caches and checksums match.
@@ -326,6 +332,12 @@ void handle_devices_CopySubmittedSettings(taskIndex_t taskIndex, pluginID_t task
                       pins);
   }
 
+  #if FEATURE_ALIGNED_READ_GROUP
+  if (device.TimerOption) {
+    Settings.setTaskReadGroup(taskIndex, getFormItemInt(F("TDRG"), 0));
+  }
+  #endif // if FEATURE_ALIGNED_READ_GROUP
+
   #if FEATURE_PLUGIN_PRIORITY
   if (device.PowerManager // Check extra priority device flags when available
       ) {
@@ -352,7 +364,15 @@ void handle_devices_CopySubmittedSettings(taskIndex_t taskIndex, pluginID_t task
   {
     Settings.TaskDeviceID[controllerNr][taskIndex]       = getFormItemInt(getPluginCustomArgName(F("TDID"), controllerNr));
     Settings.TaskDeviceSendData[controllerNr][taskIndex] = isFormItemChecked(getPluginCustomArgName(F("TDSD"), controllerNr));
+    #if FEATURE_SEND_ON_CHANGE
+    Settings.SendOnChange(taskIndex, controllerNr, isFormItemChecked(getPluginCustomArgName(F("TDSOC"), controllerNr)));
+    #endif // if FEATURE_SEND_ON_CHANGE
   }
+  #if FEATURE_SEND_ON_CHANGE
+  Settings.SendOnChangeDeadband(taskIndex, getFormItemInt(F("TDSOCDB"), 0));
+  Settings.SendOnChangeMaxSilence(taskIndex, getFormItemInt(F("TDSOCMS"), 0));
+  UserVar.clearLastSent(taskIndex);
+  #endif // if FEATURE_SEND_ON_CHANGE
 
   if (device.PullUpOption) {
     Settings.TaskDevicePin1PullUp[taskIndex] = isFormItemChecked(F("TDPPU"));
@@ -479,6 +499,9 @@ void handle_devicess_ShowAllTasksTable(uint8_t page)
 
   for (taskIndex_t x = (page - 1) * TASKS_PER_PAGE; x < ((page) * TASKS_PER_PAGE) && validTaskIndex(x); x++)
   {
+    // Each row may call several plugins, keep the network stack running.
+    delay(0);
+
     const deviceIndex_t DeviceIndex = getDeviceIndex_from_TaskIndex(x);
     const bool pluginID_set         = INVALID_PLUGIN_ID != Settings.getPluginID_for_task(x);
 
@@ -1145,6 +1168,32 @@ void devicePage_show_I2C_config(taskIndex_t taskIndex)
   PluginCall(PLUGIN_WEBFORM_SHOW_I2C_PARAMS, &TempEvent, dummy);
   addFormCheckBox(F("Force Slow I2C speed"), F("taskdeviceflags0"), bitRead(Settings.I2C_Flags[taskIndex], I2C_FLAGS_SLOW_SPEED));
 
+  # if FEATURE_I2C_CLOCK_PROFILE
+  {
+    const __FlashStringHelper *i2c_clockProfiles[] = {
+      toString(I2C_clockProfile_e::Default),
+      toString(I2C_clockProfile_e::AutoTune),
+      toString(I2C_clockProfile_e::Fixed_100kHz),
+      toString(I2C_clockProfile_e::Fixed_400kHz),
+      toString(I2C_clockProfile_e::Fixed_1MHz)
+    };
+    constexpr int i2c_clockProfileOptions[] = {
+      static_cast<int>(I2C_clockProfile_e::Default),
+      static_cast<int>(I2C_clockProfile_e::AutoTune),
+      static_cast<int>(I2C_clockProfile_e::Fixed_100kHz),
+      static_cast<int>(I2C_clockProfile_e::Fixed_400kHz),
+      static_cast<int>(I2C_clockProfile_e::Fixed_1MHz)
+    };
+    addFormSelector(F("I2C Clock Speed"),
+                    F("taskdeviceflags2"),
+                    NR_ELEMENTS(i2c_clockProfileOptions),
+                    i2c_clockProfiles,
+                    i2c_clockProfileOptions,
+                    static_cast<int>(I2C_getTaskClockProfile(taskIndex)));
+    addFormNote(F("Default: Use the (slow) I2C clock speed of the Hardware page. Auto tune: Highest clock speed at which the device responds, checked at task init."));
+  }
+  # endif // if FEATURE_I2C_CLOCK_PROFILE
+
   # if FEATURE_I2CMULTIPLEXER
 
   // Show selector for an I2C multiplexer port if a multiplexer is configured
@@ -1257,7 +1306,11 @@ void devicePage_show_task_statistics(taskIndex_t taskIndex, deviceIndex_t Device
       #if FEATURE_CHART_JS
       if (taskData->nrSamplesPresent() > 0) {
         addRowLabel(F("Historic data"));
-        taskData->plot_ChartJS();
+        add_ChartJS_binary_decoder();
+        taskData->plot_ChartJS(taskIndex);
+        # if FEATURE_PLUGIN_STATS_HISTORY
+        taskData->plot_ChartJS_history(taskIndex);
+        # endif // if FEATURE_PLUGIN_STATS_HISTORY
       }
       #endif // if FEATURE_CHART_JS
 
@@ -1338,9 +1391,27 @@ void devicePage_show_controller_config(taskIndex_t taskIndex, deviceIndex_t Devi
             getPluginCustomArgName(F("TDID"), controllerNr), // ="taskdeviceid"
             Settings.TaskDeviceID[controllerNr][taskIndex], 0, DOMOTICZ_MAX_IDX);
         }
+        #if FEATURE_SEND_ON_CHANGE
+        html_TD();
+        addCheckBox(
+          getPluginCustomArgName(F("TDSOC"), controllerNr), // ="taskdevicesendonchange"
+          Settings.SendOnChange(taskIndex, controllerNr));
+        html_TD();
+        addHtml(F("On change"));
+        #endif // if FEATURE_SEND_ON_CHANGE
         html_end_table();
       }
     }
+    #if FEATURE_SEND_ON_CHANGE
+
+    if (separatorAdded) {
+      addFormNumericBox(F("Send on change deadband"), F("TDSOCDB"), Settings.SendOnChangeDeadband(taskIndex), 0, 255);
+      addFormNote(F("In steps of the last decimal of each value, e.g. 5 with 2 decimals = 0.05. 0 = any change"));
+      addFormNumericBox(F("Send on change max. silence"), F("TDSOCMS"), Settings.SendOnChangeMaxSilence(taskIndex), 0, 65535);
+      addUnit(F("sec"));
+      addFormNote(F("Send anyway when nothing was sent for this period. 0 = no max."));
+    }
+    #endif // if FEATURE_SEND_ON_CHANGE
   }
 }
 
@@ -1360,6 +1431,11 @@ void devicePage_show_interval_config(taskIndex_t taskIndex, deviceIndex_t Device
     if (device.TimerOptional) {
       addHtml(F(" (Optional for this Device)"));
     }
+
+    #if FEATURE_ALIGNED_READ_GROUP
+    addFormNumericBox(F("Aligned Read Group"), F("TDRG"), Settings.getTaskReadGroup(taskIndex), 0, 15); // ="taskdevicereadgroup"
+    addFormNote(F("0 = none. Enabled tasks with the same group and interval are read in a single scheduler slot."));
+    #endif // if FEATURE_ALIGNED_READ_GROUP
   }
 }
 
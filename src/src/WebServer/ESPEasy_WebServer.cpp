@@ -12,6 +12,8 @@
 #include "../WebServer/CustomPage.h"
 #include "../WebServer/DevicesPage.h"
 #include "../WebServer/DownloadPage.h"
+#include "../WebServer/EventTracePage.h"
+#include "../WebServer/EventStream.h"
 #include "../WebServer/FactoryResetPage.h"
 #include "../WebServer/FileList.h"
 #include "../WebServer/HTML_wrappers.h"
@@ -54,6 +56,7 @@
 #include "../ESPEasyCore/ESPEasyRules.h"
 #include "../ESPEasyCore/ESPEasyWifi.h"
 
+#include "../Globals/Cache.h"
 #include "../Globals/CPlugins.h"
 #include "../Globals/Device.h"
 #include "../Globals/NetworkState.h"
@@ -80,6 +83,53 @@ void safe_strncpy_webserver_arg(char *dest, const __FlashStringHelper * arg, siz
   safe_strncpy_webserver_arg(dest, String(arg), max_size);
 }
 
+#if FEATURE_WEB_TEMPLATE_CACHE
+// Split the template in literal text and variables once, so it does not need to be parsed on every page load.
+// Return nullptr when the template cannot be cached.
+static const WebPageTemplate_segments * getCompiledWebPageTemplate(const String& tmplName, bool Tail) {
+  const WebPageTemplate_segments *segments = Cache.webTemplateCache.get(tmplName, Tail);
+
+  if (segments != nullptr) {
+    return segments;
+  }
+  WebPageTemplate_segments head;
+  WebPageTemplate_segments tail;
+  {
+    WebTemplateParser headParser(_HEAD, head);
+    WebTemplateParser tailParser(_TAIL, tail);
+    fs::File f = tryOpenFile(concat(tmplName, F(".htm")), "r");
+
+    if (f) {
+      if (f.size() > WEB_TEMPLATE_CACHE_MAX_FILE_SIZE) {
+        f.close();
+        return nullptr;
+      }
+      uint8_t buf[64];
+      bool headDone = false;
+
+      while (f.available()) {
+        const int nrRead = f.read(buf, sizeof(buf));
+
+        if (nrRead <= 0) { break; }
+
+        for (int i = 0; i < nrRead; ++i) {
+          if (!headDone) {
+            headDone = !headParser.process(static_cast<char>(buf[i]));
+          }
+          tailParser.process(static_cast<char>(buf[i]));
+        }
+      }
+      f.close();
+    } else {
+      getWebPageTemplateDefault(tmplName, headParser);
+      getWebPageTemplateDefault(tmplName, tailParser);
+    }
+  }
+  Cache.webTemplateCache.add(tmplName, std::move(head), std::move(tail));
+  return Cache.webTemplateCache.get(tmplName, Tail);
+}
+#endif // if FEATURE_WEB_TEMPLATE_CACHE
+
 void sendHeadandTail(const __FlashStringHelper * tmplName, bool Tail, bool rebooting) {
   // This function is called twice per serving a web page.
   // So it must keep track of the timer longer than the scope of this function.
@@ -92,18 +142,27 @@ void sendHeadandTail(const __FlashStringHelper * tmplName, bool Tail, bool reboo
   }
   #endif // if FEATURE_TIMING_STATS
   {
-    const String fileName = concat(tmplName, F(".htm"));
-    fs::File f = tryOpenFile(fileName, "r");
-
     WebTemplateParser templateParser(Tail, rebooting);
-    if (f) {
-      bool success = true;
-      while (f.available() && success) { 
-        success = templateParser.process((char)f.read());
+    #if FEATURE_WEB_TEMPLATE_CACHE
+    const WebPageTemplate_segments *segments = getCompiledWebPageTemplate(tmplName, Tail);
+
+    if (segments != nullptr) {
+      templateParser.render(*segments);
+    } else
+    #endif // if FEATURE_WEB_TEMPLATE_CACHE
+    {
+      const String fileName = concat(tmplName, F(".htm"));
+      fs::File f = tryOpenFile(fileName, "r");
+
+      if (f) {
+        bool success = true;
+        while (f.available() && success) { 
+          success = templateParser.process((char)f.read());
+        }
+        f.close();
+      } else {
+        getWebPageTemplateDefault(tmplName, templateParser);
       }
-      f.close();
-    } else {
-      getWebPageTemplateDefault(tmplName, templateParser);
     }
     #ifndef BUILD_NO_RAM_TRACKER
     checkRAM(F("sendWebPage"));
@@ -225,6 +284,7 @@ void WebServerInit()
   web_server.on(F("/dumpcache"),     handle_dumpcache);  // C016 specific entrie
   web_server.on(F("/cache_json"), handle_cache_json); // C016 specific entrie
   web_server.on(F("/cache_csv"),  handle_cache_csv);  // C016 specific entrie
+  web_server.on(F("/cache_export"), handle_cache_export); // C016 specific entrie
 #endif // USES_C016
 
   #ifdef WEBSERVER_FACTORY_RESET
@@ -244,8 +304,17 @@ void WebServerInit()
   #endif // ifdef WEBSERVER_I2C_SCANNER
   web_server.on(F("/json"),            handle_json); // Also part of WEBSERVER_NEW_UI
   web_server.on(F("/csv"),             handle_csvval);
+  #if FEATURE_PLUGIN_STATS_HISTORY
+  web_server.on(F("/pluginstats_history_json"), handle_pluginstats_history_json);
+  #endif // if FEATURE_PLUGIN_STATS_HISTORY
+  #if FEATURE_PLUGIN_STATS && FEATURE_CHART_JS
+  web_server.on(F("/pluginstats_bin"), handle_pluginstats_bin);
+  #endif // if FEATURE_PLUGIN_STATS && FEATURE_CHART_JS
   web_server.on(F("/log"),             handle_log);
   web_server.on(F("/logjson"),         handle_log_JSON); // Also part of WEBSERVER_NEW_UI
+#if FEATURE_WEB_EVENT_STREAM
+  web_server.on(F("/events"),          handle_events);
+#endif // if FEATURE_WEB_EVENT_STREAM
 #if FEATURE_NOTIFIER
   web_server.on(F("/notifications"),   handle_notifications);
 #endif // if FEATURE_NOTIFIER
@@ -281,6 +350,15 @@ void WebServerInit()
 #endif // WEBSERVER_SYSVARS
 #ifdef WEBSERVER_TIMINGSTATS
   web_server.on(F("/timingstats"), handle_timingstats);
+# if FEATURE_RULES_PROFILING
+  web_server.on(F("/rules_timingstats"),      handle_rules_timingstats);
+  web_server.on(F("/rules_timingstats_csv"),  handle_rules_timingstats_csv);
+  web_server.on(F("/rules_timingstats_json"), handle_rules_timingstats_json);
+# endif // if FEATURE_RULES_PROFILING
+# if FEATURE_EVENT_TRACER
+  web_server.on(F("/eventtrace"),             handle_eventtrace);
+  web_server.on(F("/eventtrace_json"),        handle_eventtrace_json);
+# endif // if FEATURE_EVENT_TRACER
 #endif // WEBSERVER_TIMINGSTATS
 #ifdef WEBSERVER_TOOLS
   web_server.on(F("/tools"),       handle_tools);
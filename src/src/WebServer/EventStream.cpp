@@ -0,0 +1,245 @@
+#include "../WebServer/EventStream.h"
+
+#if FEATURE_WEB_EVENT_STREAM
+
+# include "../WebServer/ESPEasy_WebServer.h"
+
+# include "../DataStructs/LogStruct.h"
+
+# include "../Globals/Logging.h"
+# include "../Globals/Services.h"
+
+# include "../Helpers/ESPEasy_time_calc.h"
+# include "../Helpers/Misc.h"
+# include "../Helpers/StringConverter.h"
+
+# include "../../_Plugin_Helper.h"
+
+# ifdef ESP8266
+#  define EVENT_STREAM_MAX_CLIENTS         2
+#  define EVENT_STREAM_MAX_PENDING         1024
+# else // ifdef ESP8266
+#  define EVENT_STREAM_MAX_CLIENTS         4
+#  define EVENT_STREAM_MAX_PENDING         4096
+# endif // ifdef ESP8266
+
+// Max. number of bytes written to a client per call, to keep the loop responsive
+# define EVENT_STREAM_WRITE_CHUNK          512
+
+// Send a comment when idle, to detect disconnected clients
+# define EVENT_STREAM_KEEPALIVE_INTERVAL   15000
+
+struct EventStreamClient_t {
+  WiFiClient    client;
+
+  // Data not yet written to the client.
+  // New frames are dropped when a client cannot keep up.
+  String        pending;
+  unsigned long lastWrite = 0;
+  uint32_t      dropped   = 0;
+  bool          active    = false;
+  bool          sendLog   = false;
+};
+
+static EventStreamClient_t eventStreamClients[EVENT_STREAM_MAX_CLIENTS];
+static uint8_t eventStreamNrClients = 0;
+
+// Log cursor shared by all event stream clients, independent of /logjson clients
+static uint32_t eventStreamLogSeq = 0;
+
+static void eventStream_disconnect(EventStreamClient_t& c)
+{
+  c.client.stop();
+  c.client  = WiFiClient();
+  c.pending = String();
+  c.active  = false;
+  c.sendLog = false;
+
+  if (eventStreamNrClients > 0) {
+    --eventStreamNrClients;
+  }
+}
+
+static void eventStream_queue(EventStreamClient_t& c, const String& frame)
+{
+  if ((c.pending.length() + frame.length()) > EVENT_STREAM_MAX_PENDING) {
+    ++c.dropped;
+    return;
+  }
+  c.pending += frame;
+}
+
+static void eventStream_write(EventStreamClient_t& c)
+{
+  if (!c.client.connected()) {
+    eventStream_disconnect(c);
+    return;
+  }
+
+  if (c.pending.isEmpty()) {
+    if (c.dropped == 0) { return; }
+
+    // Let the client know it missed some data, so it may fetch /json to resync.
+    c.pending  = F("event: dropped\ndata: ");
+    c.pending += c.dropped;
+    c.pending += F("\n\n");
+    c.dropped  = 0;
+  }
+  size_t toWrite = c.pending.length();
+
+  if (toWrite > EVENT_STREAM_WRITE_CHUNK) {
+    toWrite = EVENT_STREAM_WRITE_CHUNK;
+  }
+  # ifdef ESP8266
+
+  // Do not block when the TCP send buffer is full
+  const size_t available = c.client.availableForWrite();
+
+  if (toWrite > available) {
+    toWrite = available;
+  }
+
+  if (toWrite == 0) { return; }
+  # endif // ifdef ESP8266
+
+  const size_t written = c.client.write(reinterpret_cast<const uint8_t *>(c.pending.c_str()), toWrite);
+
+  if (written > 0) {
+    c.pending.remove(0, written);
+    c.lastWrite = millis();
+  }
+}
+
+void handle_events()
+{
+  const bool sendLog = equals(webArg(F("log")), '1');
+
+  if (sendLog && !isLoggedIn()) { return; }
+
+  EventStreamClient_t *c = nullptr;
+
+  for (uint8_t i = 0; i < EVENT_STREAM_MAX_CLIENTS && c == nullptr; ++i) {
+    if (!eventStreamClients[i].active) {
+      c = &eventStreamClients[i];
+    }
+  }
+
+  if (c == nullptr) {
+    web_server.send_P(503, (PGM_P)F("text/plain"), (PGM_P)F("Too many event stream clients"));
+    return;
+  }
+
+  // Keep a copy of the client, so the connection remains open after this request is handled.
+  // The response header is written directly, as the stream has no end.
+  c->client = web_server.client();
+  c->client.setNoDelay(true);
+  c->pending = F("HTTP/1.1 200 OK\r\n"
+                 "Content-Type: text/event-stream\r\n"
+                 "Cache-Control: no-cache\r\n"
+                 "Connection: keep-alive\r\n"
+                 "Access-Control-Allow-Origin: *\r\n"
+                 "\r\n"
+                 "retry: 5000\n\n");
+  c->lastWrite = millis();
+  c->dropped   = 0;
+  c->active    = true;
+  c->sendLog   = sendLog;
+  ++eventStreamNrClients;
+
+  eventStream_write(*c);
+}
+
+void eventStream_sendTaskValues(struct EventStruct *event)
+{
+  if ((eventStreamNrClients == 0) || (event == nullptr)) { return; }
+
+  const uint8_t valueCount = getValueCountForTask(event->TaskIndex);
+
+  // Compact JSON frame, using the same keys as /json
+  String frame;
+
+  frame.reserve(64 + 32 * valueCount);
+  frame  = F("event: taskvalues\ndata: {\"TaskNumber\":");
+  frame += event->TaskIndex + 1;
+  frame += F(",\"TaskName\":");
+  frame += to_json_value(getTaskDeviceName(event->TaskIndex), true);
+  frame += F(",\"TaskValues\":[");
+
+  for (uint8_t x = 0; x < valueCount; x++) {
+    if (x != 0) {
+      frame += ',';
+    }
+    frame += F("{\"ValueNumber\":");
+    frame += x + 1;
+    frame += F(",\"Name\":");
+    frame += to_json_value(getTaskValueName(event->TaskIndex, x), true);
+    frame += F(",\"Value\":");
+    frame += to_json_value(formatUserVarNoCheck(event, x));
+    frame += '}';
+  }
+  frame += F("]}\n\n");
+
+  for (uint8_t i = 0; i < EVENT_STREAM_MAX_CLIENTS; ++i) {
+    if (eventStreamClients[i].active) {
+      eventStream_queue(eventStreamClients[i], frame);
+      eventStream_write(eventStreamClients[i]);
+    }
+  }
+}
+
+void eventStream_loop()
+{
+  if (eventStreamNrClients == 0) { return; }
+
+  bool sendLog = false;
+
+  for (uint8_t i = 0; i < EVENT_STREAM_MAX_CLIENTS; ++i) {
+    if (eventStreamClients[i].active && eventStreamClients[i].sendLog) {
+      sendLog = true;
+    }
+  }
+
+  if (sendLog) {
+    unsigned long timestamp = 0;
+    char    message[LOG_STRUCT_MESSAGE_SIZE];
+    uint8_t loglevel = 0;
+    int     length   = 0;
+
+    while ((length = Logging.getLine(eventStreamLogSeq, timestamp, message, loglevel)) >= 0) {
+      ++eventStreamLogSeq;
+      String frame;
+      frame.reserve(length + 64);
+      frame  = F("event: log\ndata: {\"timestamp\":");
+      frame += timestamp;
+      frame += F(",\"level\":");
+      frame += loglevel;
+      frame += F(",\"text\":");
+      frame += to_json_value(String(message), true);
+      frame += F("}\n\n");
+
+      for (uint8_t i = 0; i < EVENT_STREAM_MAX_CLIENTS; ++i) {
+        if (eventStreamClients[i].active && eventStreamClients[i].sendLog) {
+          eventStream_queue(eventStreamClients[i], frame);
+        }
+      }
+    }
+  }
+
+  for (uint8_t i = 0; i < EVENT_STREAM_MAX_CLIENTS; ++i) {
+    EventStreamClient_t& c = eventStreamClients[i];
+
+    if (c.active) {
+      if (c.pending.isEmpty() && (timePassedSince(c.lastWrite) > EVENT_STREAM_KEEPALIVE_INTERVAL)) {
+        c.pending = F(":\n\n");
+      }
+      eventStream_write(c);
+    }
+  }
+}
+
+uint8_t eventStream_clientCount()
+{
+  return eventStreamNrClients;
+}
+
+#endif // if FEATURE_WEB_EVENT_STREAM
@@ -0,0 +1,28 @@
+#ifndef WEBSERVER_WEBSERVER_EVENTSTREAM_H
+#define WEBSERVER_WEBSERVER_EVENTSTREAM_H
+
+#include "../WebServer/common.h"
+
+#if FEATURE_WEB_EVENT_STREAM
+
+# include "../DataStructs/ESPEasy_EventStruct.h"
+
+// ********************************************************************************
+// Server-Sent Events stream, to push live data to web clients without polling.
+// /events        Task values, sent when a task sends its data
+// /events?log=1  Also the web log lines (requires login)
+// ********************************************************************************
+void    handle_events();
+
+// Push the task values of the event to all connected clients.
+// Called from sendData()
+void    eventStream_sendTaskValues(struct EventStruct *event);
+
+// Forward new log lines, send keep-alive comments and write pending data to the clients.
+void    eventStream_loop();
+
+uint8_t eventStream_clientCount();
+
+#endif // if FEATURE_WEB_EVENT_STREAM
+
+#endif // ifndef WEBSERVER_WEBSERVER_EVENTSTREAM_H
@@ -0,0 +1,143 @@
+#include "../WebServer/EventTracePage.h"
+
+#if defined(WEBSERVER_TIMINGSTATS) && FEATURE_EVENT_TRACER
+
+# include "../WebServer/ESPEasy_WebServer.h"
+# include "../WebServer/HTML_wrappers.h"
+# include "../WebServer/Markup.h"
+# include "../WebServer/Markup_Buttons.h"
+# include "../WebServer/Markup_Forms.h"
+
+# include "../DataStructs/TimingStats.h"
+
+# include "../Globals/CPlugins.h"
+# include "../Globals/ESPEasy_Scheduler.h"
+# include "../Globals/Plugins.h"
+
+# include "../Helpers/EventTracer.h"
+# include "../Helpers/StringConverter.h"
+# include "../Helpers/_Plugin_init.h"
+
+void handle_eventtrace() {
+  if (!isLoggedIn()) { return; }
+  # ifndef BUILD_NO_RAM_TRACKER
+  checkRAM(F("handle_eventtrace"));
+  # endif // ifndef BUILD_NO_RAM_TRACKER
+  navMenuIndex = MENU_INDEX_TOOLS;
+
+  bool allocFailed = false;
+
+  if (hasArg(F("start"))) {
+    allocFailed = !EventTracer_start();
+  } else if (hasArg(F("stop"))) {
+    EventTracer_stop();
+  } else if (hasArg(F("free"))) {
+    EventTracer_free();
+  }
+
+  TXBuffer.startStream();
+  sendHeadandTail_stdtemplate(_HEAD);
+  html_table_class_normal();
+  addFormHeader(F("Event Trace"));
+  addRowLabel(F("State"));
+
+  if (allocFailed) {
+    addHtml(F("Not enough memory for trace buffer"));
+  } else {
+    addHtml(EventTracer_isRunning() ? F("Running") : F("Stopped"));
+  }
+  addRowLabel(F("Records"));
+  addHtml(strformat(
+            F("%u / %u"),
+            static_cast<unsigned int>(EventTracer_getCount()),
+            static_cast<unsigned int>(EventTracer_getCapacity())));
+  addRowLabel(F("Buffer Size"));
+  addHtmlInt(static_cast<uint32_t>(EventTracer_getCapacity() * sizeof(EventTraceRecord_t)));
+  addHtml(F(" [Bytes]"));
+  html_TR_TD();
+  html_TD();
+  addButton(F("/eventtrace?start=1"), F("Start"));
+  addButton(F("/eventtrace?stop=1"),  F("Stop"));
+  addButton(F("/eventtrace?free=1"),  F("Free"));
+  addButton(F("/eventtrace_json"),    F("Download"));
+  addRowLabel(F("*"));
+  addHtml(F("Open the downloaded file in ui.perfetto.dev or chrome://tracing"));
+  html_end_table();
+
+  sendHeadandTail_stdtemplate(_TAIL);
+  TXBuffer.endStream();
+}
+
+static String getEventTraceName(const EventTraceRecord_t& record) {
+  switch (record.type) {
+    case EventTraceType_e::Scheduler:
+      return ESPEasy_Scheduler::decodeSchedulerId(SchedulerTimerID(record.arg));
+    case EventTraceType_e::Plugin:
+    {
+      const deviceIndex_t deviceIndex = deviceIndex_t::toDeviceIndex((record.arg >> 8) & 0xFF);
+      return concat(
+        get_formatted_Plugin_number(getPluginID_from_DeviceIndex(deviceIndex)),
+        ' ') + getPluginFunctionName(record.arg & 0xFF);
+    }
+    case EventTraceType_e::CPlugin:
+      return concat(
+        get_formatted_Controller_number(getCPluginID_from_ProtocolIndex((record.arg >> 8) & 0xFF)),
+        ' ') + getCPluginCFunctionName(static_cast<CPlugin::Function>(record.arg & 0xFF));
+    case EventTraceType_e::Rules:
+      return F("rulesProcessing");
+    case EventTraceType_e::WebRequest:
+      return F("Web request");
+    case EventTraceType_e::NR_ELEMENTS:
+      break;
+  }
+  return EMPTY_STRING;
+}
+
+void handle_eventtrace_json() {
+  if (!isLoggedIn()) { return; }
+
+  // Do not add records while reading the ring buffer
+  EventTracer_stop();
+
+  sendHeader(F("Content-Disposition"), F("attachment; filename=eventtrace.json"));
+  TXBuffer.startJsonStream();
+  addHtml(F("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"));
+
+  const uint32_t     count = EventTracer_getCount();
+  EventTraceRecord_t record;
+  uint32_t           prevTimestamp = 0;
+  uint64_t           ts            = 0;
+
+  for (uint32_t i = 0; i < count && EventTracer_getRecord(i, record); ++i) {
+    // Timestamps are 32 bit usec, so accumulate the difference to handle overflow
+    if (i != 0) {
+      ts += static_cast<uint32_t>(record.timestamp - prevTimestamp);
+      addHtml(F(",\n"));
+    }
+    prevTimestamp = record.timestamp;
+
+    addHtml(strformat(
+              F("{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%s,\"pid\":0,\"tid\":0"),
+              getEventTraceName(record).c_str(),
+              String(toString(record.type)).c_str(),
+              record.begin ? 'B' : 'E',
+              ull2String(ts).c_str()));
+
+    if (record.begin) {
+      if (record.type == EventTraceType_e::Plugin) {
+        const taskIndex_t taskIndex = (record.arg >> 16) & 0xFF;
+
+        if (validTaskIndex(taskIndex)) {
+          addHtml(strformat(F(",\"args\":{\"task\":%u}"), static_cast<unsigned int>(taskIndex + 1)));
+        }
+      } else if (record.type == EventTraceType_e::WebRequest) {
+        addHtml(strformat(F(",\"args\":{\"code\":%u}"), static_cast<unsigned int>(record.arg)));
+      }
+    }
+    addHtml('}');
+  }
+  addHtml(F("\n]}\n"));
+  TXBuffer.endStream();
+}
+
+#endif // if defined(WEBSERVER_TIMINGSTATS) && FEATURE_EVENT_TRACER
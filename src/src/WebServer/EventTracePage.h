@@ -0,0 +1,20 @@
+#ifndef WEBSERVER_WEBSERVER_EVENTTRACEPAGE_H
+#define WEBSERVER_WEBSERVER_EVENTTRACEPAGE_H
+
+#include "../WebServer/common.h"
+
+#if defined(WEBSERVER_TIMINGSTATS) && FEATURE_EVENT_TRACER
+
+// ********************************************************************************
+// Web Interface to start/stop the event tracer
+// ********************************************************************************
+void handle_eventtrace();
+
+// ********************************************************************************
+// Download the event trace in Chrome trace_event JSON format, to view in Perfetto
+// ********************************************************************************
+void handle_eventtrace_json();
+
+#endif // if defined(WEBSERVER_TIMINGSTATS) && FEATURE_EVENT_TRACER
+
+#endif // ifndef WEBSERVER_WEBSERVER_EVENTTRACEPAGE_H
@@ -24,7 +24,9 @@
 #endif // if FEATURE_SD
 
 
-#define FILES_PER_PAGE   50
+#ifndef FILES_PER_PAGE
+# define FILES_PER_PAGE   50
+#endif // ifndef FILES_PER_PAGE
 
 #ifdef WEBSERVER_NEW_UI
 
@@ -60,7 +62,14 @@ void handle_filelist_json() {
   {
     validIntFromString(fstart, startIdx);
   }
-  int endIdx = startIdx + FILES_PER_PAGE - 1;
+
+  // Allow the client to fetch the list in smaller chunks via start=..&limit=..
+  int limit = FILES_PER_PAGE;
+
+  if (validIntFromString(webArg(F("limit")), limit)) {
+    limit = constrain(limit, 1, FILES_PER_PAGE);
+  }
+  int endIdx = startIdx + limit - 1;
 
   addHtml('[', '{');
   bool firstentry = true;
@@ -71,6 +80,8 @@ void handle_filelist_json() {
 
   while (file and count < endIdx)
   {
+    delay(0);
+
     if (!file.isDirectory()) {
       ++count;
 
@@ -111,12 +122,8 @@ void handle_filelist_json() {
 
     stream_next_json_object_value(F("fileName"), String(dir.fileName()));
 
-    fs::File f = dir.openFile("r");
-
-    if (f) {
-      stream_next_json_object_value(F("size"), f.size());
-      f.close();
-    }
+    // Size is known from the directory entry, no need to open the file
+    stream_next_json_object_value(F("size"), dir.fileSize());
 
     stream_last_json_object_value(F("index"), startIdx);
 
@@ -194,12 +201,8 @@ void handle_filelist() {
 
     if (count >= startIdx)
     {
-      int filesize = -1;
-      fs::File f   = dir.openFile("r");
-
-      if (f) {
-        filesize = f.size();
-      }
+      // Size is known from the directory entry, no need to open the file
+      const int filesize = dir.fileSize();
 #if FEATURE_RTC_CACHE_STORAGE
       if (!cacheFilesPresent && (getCacheFileCountFromFilename(dir.fileName()) != -1))
       {
@@ -217,6 +220,8 @@ void handle_filelist() {
 
   while (file && count < endIdx)
   {
+    delay(0);
+
     if (!file.isDirectory()) {
       ++count;
 
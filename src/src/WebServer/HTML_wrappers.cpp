@@ -394,19 +394,19 @@ void addHtml(String&& html) {
 }
 
 void addHtmlInt(int32_t int_val) {
-  addHtml(String(int_val));
+  TXBuffer += static_cast<int64_t>(int_val);
 }
 
 void addHtmlInt(uint32_t int_val) {
-  addHtml(String(int_val));
+  TXBuffer += static_cast<uint64_t>(int_val);
 }
 
 void addHtmlInt(int64_t int_val) {
-  addHtml(ll2String(int_val));
+  TXBuffer += int_val;
 }
 
 void addHtmlInt(uint64_t int_val) {
-  addHtml(ull2String(int_val));
+  TXBuffer += int_val;
 }
 
 void addHtmlFloat(const float& value, unsigned int nrDecimals) {
@@ -420,25 +420,61 @@ void addHtmlFloat(const double& value, unsigned int nrDecimals) {
 #endif
 
 
-void addEncodedHtml(const __FlashStringHelper * html) {
+// Escape per character while streaming, so no copy of the string is needed.
+static void addEncodedHtml(const char *html, size_t length, bool isFlash) {
   // FIXME TD-er: What about the function htmlStrongEscape ??
-  addEncodedHtml(String(html));
+  size_t start = 0;
+
+  for (size_t i = 0; i < length; ++i) {
+    const char c = isFlash ? static_cast<char>(pgm_read_byte(html + i)) : html[i];
+    const __FlashStringHelper *escaped = htmlEscapeCharSequence(c);
+
+    if (escaped != nullptr) {
+      if (i > start) {
+        if (isFlash) {
+          TXBuffer.addFlashString(html + start, i - start);
+        } else {
+          TXBuffer.addChars(html + start, i - start);
+        }
+      }
+      addHtml(escaped);
+      start = i + 1;
+    }
+  }
+
+  if (length > start) {
+    if (isFlash) {
+      TXBuffer.addFlashString(html + start, length - start);
+    } else {
+      TXBuffer.addChars(html + start, length - start);
+    }
+  }
 }
 
-void addEncodedHtml(const String& html) {
-  // FIXME TD-er: What about the function htmlStrongEscape ??
-  String copy(html);
+void addEncodedHtml(const __FlashStringHelper * html) {
+  if (html != nullptr) {
+    addEncodedHtml((PGM_P)html, strlen_P((PGM_P)html), true);
+  }
+}
 
-  htmlEscape(copy);
-  addHtml(copy);
+void addEncodedHtml(const String& html) {
+  addEncodedHtml(html.c_str(), html.length(), false);
 }
 
 void addHtmlAttribute(char label, int value) {
-  addHtmlAttribute(String(label), value);
+  addHtml(' ');
+  addHtml(label);
+  addHtml('=');
+  addHtmlInt(value);
+  addHtml(' ');
 }
 
 void addHtmlAttribute(char label, float value) {
-  addHtmlAttribute(String(label), toString(value, 2));
+  addHtml(' ');
+  addHtml(label);
+  addHtml(F("='"));
+  TXBuffer += value;
+  addHtml(F("' "));
 }
 
 void addHtmlAttribute(const __FlashStringHelper * label, int value) {
@@ -450,7 +486,11 @@ void addHtmlAttribute(const __FlashStringHelper * label, int value) {
 }
 
 void addHtmlAttribute(const __FlashStringHelper * label, float value) {
-  addHtmlAttribute(label, toString(value, 2));
+  addHtml(' ');
+  addHtml(label);
+  addHtml(F("='"));
+  TXBuffer += value;
+  addHtml(F("' "));
 }
 
 void addHtmlAttribute(const String& label, int value) {
@@ -462,7 +502,11 @@ void addHtmlAttribute(const String& label, int value) {
 }
 
 void addHtmlAttribute(const __FlashStringHelper * label, const __FlashStringHelper * value) {
-  addHtmlAttribute(label, String(value));
+  addHtml(' ');
+  addHtml(label);
+  addHtml(F("='"));
+  addEncodedHtml(value);
+  addHtml(F("' "));
 }
 
 void addHtmlAttribute(const __FlashStringHelper * label, const String& value) {
@@ -481,6 +525,61 @@ void addHtmlAttribute(const String& label, const String& value) {
   addHtml(F("' "));
 }
 
+// ********************************************************************************
+// HTML templates
+// ********************************************************************************
+void addHtmlTemplate(const __FlashStringHelper *tmpl, std::initializer_list<HtmlTemplateArg> args)
+{
+  if (tmpl == nullptr) {
+    return;
+  }
+  PGM_P literal = (PGM_P)tmpl;
+  PGM_P pos     = literal;
+
+  while (true) {
+    const char c = static_cast<char>(pgm_read_byte(pos));
+
+    if (c == '\0') {
+      if (pos != literal) {
+        TXBuffer.addFlashString(literal, pos - literal);
+      }
+      return;
+    }
+
+    const char slot = (c == '{') ? static_cast<char>(pgm_read_byte(pos + 1)) : '\0';
+
+    if (isDigit(slot) && (pgm_read_byte(pos + 2) == '}')) {
+      if (pos != literal) {
+        TXBuffer.addFlashString(literal, pos - literal);
+      }
+      const size_t index = slot - '0';
+
+      if (index < args.size()) {
+        const HtmlTemplateArg& arg = *(args.begin() + index);
+
+        switch (arg.type) {
+          case HtmlTemplateArg::Type::Int:
+            TXBuffer += arg.intValue;
+            break;
+          case HtmlTemplateArg::Type::Flash:
+            addHtml(arg.flashValue);
+            break;
+          case HtmlTemplateArg::Type::String:
+            addHtml(*arg.stringValue);
+            break;
+          case HtmlTemplateArg::Type::EncodedString:
+            addEncodedHtml(*arg.stringValue);
+            break;
+        }
+      }
+      pos    += 3;
+      literal = pos;
+    } else {
+      ++pos;
+    }
+  }
+}
+
 void addDisabled() {
   addHtml(F(" disabled"));
 }
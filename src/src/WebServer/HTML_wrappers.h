@@ -3,6 +3,8 @@
 
 #include "../WebServer/common.h"
 
+#include <initializer_list>
+
 
 // ********************************************************************************
 // HTML string re-use to keep the executable smaller
@@ -143,6 +145,48 @@ void addHtmlAttribute(const __FlashStringHelper * label, const __FlashStringHelp
 void addHtmlAttribute(const __FlashStringHelper * label, const String& value);
 void addHtmlAttribute(const String& label, const String& value);
 
+// ********************************************************************************
+// HTML templates
+// A template is a flash string with slots {0} ... {9}, rendered in one pass into
+// TXBuffer without allocating temporary strings. For example:
+//   addHtmlTemplate(F("<input type='checkbox' id='{0}' name='{0}'{1}>"),
+//                   { HtmlTemplateArg::encoded(id), checked ? F(" checked") : F("") });
+// Slots without matching argument are left empty, a '{' not followed by a digit and '}' is copied as-is.
+// Arguments refer to the given values, so they must only be used within the addHtmlTemplate call.
+// ********************************************************************************
+struct HtmlTemplateArg {
+  enum class Type : uint8_t {
+    Int,
+    Flash,
+    String,
+    EncodedString
+  };
+
+  HtmlTemplateArg(int value) : type(Type::Int), intValue(value) {}
+
+  HtmlTemplateArg(const __FlashStringHelper *value) : type(Type::Flash), flashValue(value) {}
+
+  HtmlTemplateArg(const String& value) : type(Type::String), stringValue(&value) {}
+
+  // String value to be HTML encoded, e.g. used as attribute value
+  static HtmlTemplateArg encoded(const String& value) {
+    HtmlTemplateArg res(value);
+
+    res.type = Type::EncodedString;
+    return res;
+  }
+
+  Type type;
+  union {
+    int                        intValue;
+    const __FlashStringHelper *flashValue;
+    const String              *stringValue;
+  };
+};
+
+void addHtmlTemplate(const __FlashStringHelper      *tmpl,
+                     std::initializer_list<HtmlTemplateArg> args);
+
 void addDisabled();
 
 void addHtmlLink(const String& htmlclass, const String& url, const String& label);
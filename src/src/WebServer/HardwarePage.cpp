@@ -12,10 +12,12 @@
 
 #include "../DataStructs/DeviceStruct.h"
 
+#include "../Globals/Cache.h"
 #include "../Globals/Settings.h"
 
 #include "../Helpers/ESPEasy_Storage.h"
 #include "../Helpers/Hardware.h"
+#include "../Helpers/I2C_async.h"
 #include "../Helpers/StringConverter.h"
 #include "../Helpers/StringGenerator_GPIO.h"
 
@@ -29,6 +31,10 @@ void handle_hardware() {
 
   if (!isLoggedIn()) { return; }
   navMenuIndex = MENU_INDEX_HARDWARE;
+  #if FEATURE_WEB_RESPONSE_CACHE
+  // Only depends on the settings, saving the form is a POST and thus not cached.
+  if (Cache.webResponseCache.serve(F("text/html"))) { return; }
+  #endif // if FEATURE_WEB_RESPONSE_CACHE
   TXBuffer.startStream();
   sendHeadandTail_stdtemplate(_HEAD);
 
@@ -55,6 +61,11 @@ void handle_hardware() {
     }
     Settings.I2C_Multiplexer_ResetPin = getFormItemInt(F("pi2cmuxreset"));
     #endif // if FEATURE_I2CMULTIPLEXER
+    #if FEATURE_I2C_ASYNC
+    Settings.Pin_i2c2_sda             = getFormItemInt(F("psda2"));
+    Settings.Pin_i2c2_scl             = getFormItemInt(F("pscl2"));
+    Settings.I2C2_clockSpeed          = getFormItemInt(F("pi2csp2"), DEFAULT_I2C2_CLOCK_SPEED);
+    #endif // if FEATURE_I2C_ASYNC
     #ifdef ESP32
       Settings.InitSPI                = getFormItemInt(F("initspi"), static_cast<int>(SPI_Options_e::None));
       if (Settings.InitSPI == static_cast<int>(SPI_Options_e::UserDefined)) { // User-define SPI GPIO pins
@@ -97,6 +108,9 @@ void handle_hardware() {
     if (error.isEmpty()) {
       // Apply I2C settings.
       initI2C();
+      #if FEATURE_I2C_ASYNC
+      I2C_async_begin();
+      #endif // if FEATURE_I2C_ASYNC
     }
   }
 
@@ -136,6 +150,14 @@ void handle_hardware() {
   addFormNote(F("Use 100 kHz for old I2C devices, 400 kHz is max for most."));
   addFormNumericBox(F("Slow device Clock Speed"), F("pi2cspslow"), Settings.I2C_clockSpeed_Slow, 100, 3400000);
   addUnit(F("Hz"));
+  #if FEATURE_I2C_ASYNC
+  addFormSubHeader(F("I2C Interface 2 (async)"));
+  addFormPinSelectI2C(formatGpioName_bidirectional(F("SDA")), F("psda2"), Settings.Pin_i2c2_sda);
+  addFormPinSelectI2C(formatGpioName_output(F("SCL")),        F("pscl2"), Settings.Pin_i2c2_scl);
+  addFormNumericBox(F("Clock Speed"), F("pi2csp2"), Settings.I2C2_clockSpeed, 100, 1000000);
+  addUnit(F("Hz"));
+  addFormNote(F("2nd I2C controller, for slow devices accessed by plugins in the background."));
+  #endif // if FEATURE_I2C_ASYNC
   #if FEATURE_I2CMULTIPLEXER
   addFormSubHeader(F("I2C Multiplexer"));
   // Select the type of multiplexer to use
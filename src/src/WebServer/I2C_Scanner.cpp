@@ -5,6 +5,7 @@
 #include "../WebServer/ESPEasy_WebServer.h"
 #include "../WebServer/AccessControl.h"
 #include "../WebServer/HTML_wrappers.h"
+#include "../WebServer/Markup_Buttons.h"
 
 #include "../Globals/Device.h"
 #include "../Globals/Settings.h"
@@ -12,100 +13,35 @@
 #include "../Helpers/_Plugin_init.h"
 #include "../Helpers/Hardware.h"
 #include "../Helpers/I2C_access.h"
+#include "../Helpers/I2C_BusScanner.h"
 #include "../Helpers/StringConverter.h"
 
 
 #include <Wire.h>
 
+// Start a scan when requested via ?rescan=1 or when no scan was done before.
+// The scan itself is run in the background by I2C_scanner_loop()
+static void i2cscanner_start_if_needed()
+{
+  if (hasArg(F("rescan")) || (!I2C_scanner_running() && (I2C_scanner_age() < 0))) {
+    I2C_scanner_start();
+  }
+}
+
+static bool i2cscanner_showBus()
+{
+  #if FEATURE_I2CMULTIPLEXER
+  return isI2CMultiplexerEnabled();
+  #else // if FEATURE_I2CMULTIPLEXER
+  return false;
+  #endif // if FEATURE_I2CMULTIPLEXER
+}
+
 #ifdef WEBSERVER_NEW_UI
 
 // ********************************************************************************
 // Web Interface I2C scanner
 // ********************************************************************************
-
-int scanI2CbusForDevices_json( // Utility function for scanning the I2C bus for valid devices, with JSON output
-        int8_t muxAddr
-      , int8_t channel
-      , int nDevices
-      #if FEATURE_I2CMULTIPLEXER
-      , i2c_addresses_t &excludeDevices
-      #endif // if FEATURE_I2CMULTIPLEXER
-) {
-  uint8_t error, address;
-
-  for (address = 1; address <= 127; address++)
-  {
-    #if FEATURE_I2CMULTIPLEXER
-    bool skipCheck = false;
-    if (channel != -1 && excludeDevices.size() > address) {
-      skipCheck = excludeDevices[address];
-    }
-    if (!skipCheck) { // Ignore I2C multiplexer and addresses to exclude when scanning its channels
-    #endif // if FEATURE_I2CMULTIPLEXER
-      I2C_wakeup(address); // Wakeup, workaround for slow-responding devices, see https://github.com/letscontrolit/ESPEasy/issues/3781
-      delay(1);
-      error = I2C_wakeup(address); // Get status
-      delay(1);
-
-      if ((error == 0) || (error == 4))
-      {
-        json_open();
-        json_prop(F("addr"), formatToHex(address, 2));
-        #if FEATURE_I2CMULTIPLEXER
-        if (muxAddr != -1) {
-          if (channel == -1){
-            json_prop(F("I2Cbus"), F("Standard I2C bus"));
-            excludeDevices[address] = true;
-          } else {
-            String i2cChannel = F("Multiplexer channel ");
-            i2cChannel += String(channel);
-            json_prop(F("I2Cbus"), i2cChannel);
-          }
-        }
-        #endif // if FEATURE_I2CMULTIPLEXER
-        json_number(F("status"), String(error));
-
-        if (error == 4) {
-          json_prop(F("error"), F("Unknown error at address "));
-        } else {
-          String description = getKnownI2Cdevice(address);
-
-          if (description.length() > 0) {
-            json_open(true, F("known devices"));
-            int pos = 0;
-
-            while (pos >= 0) {
-              int newpos = description.indexOf(',', pos);
-
-              if (pos != 0) {
-                addHtml(',');
-              }
-
-              if (newpos == -1) {
-                json_quote_val(description.substring(pos));
-              } else {
-                json_quote_val(description.substring(pos, newpos));
-              }
-              pos = newpos;
-
-              if (newpos != -1) {
-                ++pos;
-              }
-            }
-            json_close(true);
-          }
-          nDevices++;
-        }
-        json_close();
-        addHtml('\n');
-      }
-    #if FEATURE_I2CMULTIPLEXER
-    }
-    #endif // if FEATURE_I2CMULTIPLEXER
-  }
-  return nDevices;
-}
-
 void handle_i2cscanner_json() {
   #ifndef BUILD_NO_RAM_TRACKER
   checkRAM(F("handle_i2cscanner"));
@@ -113,36 +49,70 @@ void handle_i2cscanner_json() {
 
   if (!isLoggedIn()) { return; }
   navMenuIndex = MENU_INDEX_TOOLS;
+
+  i2cscanner_start_if_needed();
+
+  // Reply with the last results, the client may poll again while X-Scan-In-Progress is set.
+  sendHeader(F("X-Scan-In-Progress"), I2C_scanner_running() ? F("1") : F("0"));
+  sendHeader(F("X-Scan-Progress"), String(I2C_scanner_progress()));
   TXBuffer.startJsonStream();
   json_init();
   json_open(true);
 
-  int  nDevices = 0;
+  const bool showBus = i2cscanner_showBus();
 
-  I2CSelect_Max100kHz_ClockSpeed();    // Always scan in low speed to also find old/slow devices
-  #if FEATURE_I2CMULTIPLEXER
-  i2c_addresses_t mainBusDevices;
-  mainBusDevices.resize(128);
-  for (int i = 0; i < 128; i++) {
-    mainBusDevices[i] = false;
-  }
-  nDevices = scanI2CbusForDevices_json(Settings.I2C_Multiplexer_Addr, -1, nDevices, mainBusDevices); // Channel -1 = standard I2C bus
-  #else // if FEATURE_I2CMULTIPLEXER
-  nDevices = scanI2CbusForDevices_json(-1, -1, nDevices); // Standard scan
-  #endif // if FEATURE_I2CMULTIPLEXER
+  for (auto it = I2C_scanner_results().begin(); it != I2C_scanner_results().end(); ++it)
+  {
+    if ((it->status != 0) && (it->status != 4)) {
+      continue;
+    }
+    json_open();
+    json_prop(F("addr"), formatToHex(it->address, 2));
+
+    if (showBus) {
+      if (it->channel == -1) {
+        json_prop(F("I2Cbus"), F("Standard I2C bus"));
+      } else {
+        json_prop(F("I2Cbus"), concat(F("Multiplexer channel "), it->channel));
+      }
+    }
+    json_number(F("status"), String(it->status));
+    json_number(F("duration_usec"), String(it->duration_usec));
 
-  #if FEATURE_I2CMULTIPLEXER
-  if (isI2CMultiplexerEnabled()) {
-    uint8_t mux_max = I2CMultiplexerMaxChannels();
-    for (int8_t channel = 0; channel < mux_max; channel++) {
-      I2CMultiplexerSelect(channel);
-      nDevices += scanI2CbusForDevices_json(Settings.I2C_Multiplexer_Addr, channel, nDevices, mainBusDevices); // Specific channels
+    if (it->status == 4) {
+      json_prop(F("error"), F("Unknown error at address "));
+    } else {
+      String description = getKnownI2Cdevice(it->address);
+
+      if (description.length() > 0) {
+        json_open(true, F("known devices"));
+        int pos = 0;
+
+        while (pos >= 0) {
+          int newpos = description.indexOf(',', pos);
+
+          if (pos != 0) {
+            addHtml(',');
+          }
+
+          if (newpos == -1) {
+            json_quote_val(description.substring(pos));
+          } else {
+            json_quote_val(description.substring(pos, newpos));
+          }
+          pos = newpos;
+
+          if (newpos != -1) {
+            ++pos;
+          }
+        }
+        json_close(true);
+      }
     }
-    I2CMultiplexerOff();
+    json_close();
+    addHtml('\n');
   }
-  #endif // if FEATURE_I2CMULTIPLEXER
-  I2CSelectHighClockSpeed(); // Reset bus to standard speed
-  
+
   json_close(true);
   TXBuffer.endStream();
 }
@@ -360,83 +330,6 @@ String getKnownI2Cdevice(uint8_t address) {
   return result;
 }
 
-int scanI2CbusForDevices( // Utility function for scanning the I2C bus for valid devices, with HTML table output
-        int8_t muxAddr
-      , int8_t channel
-      , int nDevices
-      #if FEATURE_I2CMULTIPLEXER
-      , i2c_addresses_t &excludeDevices
-      #endif // if FEATURE_I2CMULTIPLEXER
-) {
-  uint8_t error, address;
-
-  for (address = 1; address <= 127; address++)
-  {
-    #if FEATURE_I2CMULTIPLEXER
-    bool skipCheck = false;
-    if (channel != -1 && excludeDevices.size() > address) {
-      skipCheck = excludeDevices[address];
-    }
-    if (!skipCheck) { // Ignore I2C multiplexer and addresses to exclude when scanning its channels
-    #endif // if FEATURE_I2CMULTIPLEXER
-      I2C_wakeup(address); // Wakeup, workaround for slow-responding devices, see https://github.com/letscontrolit/ESPEasy/issues/3781
-      delay(1);
-      error = I2C_wakeup(address); // Get status
-      delay(1);
-
-      switch (error) {
-        case 0:
-      {
-        html_TR_TD();
-        #if FEATURE_I2CMULTIPLEXER
-        if (muxAddr != -1) {
-          if (channel == -1){
-            addHtml(F("Standard I2C bus"));
-            excludeDevices[address] = true;
-          } else {
-            addHtml(F("Multiplexer channel "));
-            addHtmlInt(channel);
-          }
-          html_TD();
-        }
-        #endif // if FEATURE_I2CMULTIPLEXER
-        addHtml(formatToHex(address, 2));
-        html_TD();
-        String description = getKnownI2Cdevice(address);
-
-        if (description.length() > 0) {
-          description.replace(F(","), F("<BR>"));
-          addHtml(description);
-        }
-        nDevices++;
-        break;
-      }
-      case 2: // NACK on transmit address, thus not found 
-        break;
-      case 3: 
-      {
-        html_TR_TD();
-        addHtml(F("NACK on transmit data to address "));
-        addHtml(formatToHex(address, 2));
-        break;
-      }
-      case 4:
-      {
-        html_TR_TD();
-        addHtml(F("SDA low at address "));
-        addHtml(formatToHex(address, 2));
-        I2CForceResetBus_swap_pins(address);
-        addHtml(F(" Reset bus attempted"));
-        break;
-      }
-      }
-    #if FEATURE_I2CMULTIPLEXER
-    }
-    #endif // if FEATURE_I2CMULTIPLEXER
-  }
-  return nDevices;
-}
-
 // FIXME TD-er: Query all included plugins for their supported addresses (return name of plugin)
 void handle_i2cscanner() {
   #ifndef BUILD_NO_RAM_TRACKER
@@ -445,52 +338,86 @@ void handle_i2cscanner() {
 
   if (!isLoggedIn()) { return; }
   navMenuIndex = MENU_INDEX_TOOLS;
+
+  i2cscanner_start_if_needed();
+
   TXBuffer.startStream();
   sendHeadandTail_stdtemplate(_HEAD);
 
-  html_table_class_multirow();
-  #if FEATURE_I2CMULTIPLEXER
-  if (isI2CMultiplexerEnabled()) {
-    html_table_header(F("I2C bus"));
-  }
-  #endif // if FEATURE_I2CMULTIPLEXER
-  html_table_header(F("I2C Addresses in use"));
-  html_table_header(F("Supported devices"));
-
-  if (Settings.isI2CEnabled()) {
-    int  nDevices = 0;
-    I2CSelect_Max100kHz_ClockSpeed();  // Scan bus using low speed
-    #if FEATURE_I2CMULTIPLEXER
-    i2c_addresses_t mainBusDevices;
-    mainBusDevices.resize(128);
-    for (int i = 0; i < 128; i++) {
-      mainBusDevices[i] = false;
+  if (!Settings.isI2CEnabled()) {
+    html_table_class_multirow();
+    addHtml(F("<TR>I2C pins not configured"));
+    html_end_table();
+  } else if (I2C_scanner_running()) {
+    // Poll until the background scan is finished
+    addHtml(F("<meta http-equiv='refresh' content='1'>"));
+    addHtml(strformat(F("Scanning I2C bus... %d%%"), I2C_scanner_progress()));
+  } else {
+    const bool showBus = i2cscanner_showBus();
+
+    html_table_class_multirow();
+
+    if (showBus) {
+      html_table_header(F("I2C bus"));
     }
-    nDevices = scanI2CbusForDevices(Settings.I2C_Multiplexer_Addr, -1, nDevices, mainBusDevices); // Channel -1 = standard I2C bus
-    #else // if FEATURE_I2CMULTIPLEXER
-    nDevices = scanI2CbusForDevices(-1, -1, nDevices); // Standard scan
-    #endif // if FEATURE_I2CMULTIPLEXER
-
-    #if FEATURE_I2CMULTIPLEXER
-    if (isI2CMultiplexerEnabled()) {
-      uint8_t mux_max = I2CMultiplexerMaxChannels();
-      for (int8_t channel = 0; channel < mux_max; channel++) {
-        I2CMultiplexerSelect(channel);
-        nDevices += scanI2CbusForDevices(Settings.I2C_Multiplexer_Addr, channel, nDevices, mainBusDevices);
+    html_table_header(F("I2C Addresses in use"));
+    html_table_header(F("Supported devices"));
+    html_table_header(F("Response (usec)"), 100);
+
+    int nDevices = 0;
+
+    for (auto it = I2C_scanner_results().begin(); it != I2C_scanner_results().end(); ++it)
+    {
+      html_TR_TD();
+
+      if (showBus) {
+        if (it->channel == -1) {
+          addHtml(F("Standard I2C bus"));
+        } else {
+          addHtml(F("Multiplexer channel "));
+          addHtmlInt(it->channel);
+        }
+        html_TD();
+      }
+
+      switch (it->status) {
+        case 0:
+        {
+          addHtml(formatToHex(it->address, 2));
+          html_TD();
+          String description = getKnownI2Cdevice(it->address);
+
+          if (description.length() > 0) {
+            description.replace(F(","), F("<BR>"));
+            addHtml(description);
+          }
+          nDevices++;
+          break;
+        }
+        case 3:
+          addHtml(F("NACK on transmit data to address "));
+          addHtml(formatToHex(it->address, 2));
+          html_TD();
+          break;
+        case 4:
+          addHtml(F("SDA low at address "));
+          addHtml(formatToHex(it->address, 2));
+          addHtml(F(" Reset bus attempted"));
+          html_TD();
+          break;
       }
-      I2CMultiplexerOff();
+      html_TD();
+      addHtmlInt(it->duration_usec);
     }
-    #endif // if FEATURE_I2CMULTIPLEXER
-    I2CSelectHighClockSpeed();   // By default the bus is in standard speed
 
     if (nDevices == 0) {
       addHtml(F("<TR>No I2C devices found"));
     }
-  } else {
-    addHtml(F("<TR>I2C pins not configured"));
+    html_end_table();
+    addHtml(strformat(F("Scanned %d sec ago "), static_cast<int>(I2C_scanner_age() / 1000)));
+    addButton(F("/i2cscanner?rescan=1"), F("Rescan"));
   }
 
-  html_end_table();
   sendHeadandTail_stdtemplate(_TAIL);
   TXBuffer.endStream();
 }
@@ -1,6 +1,7 @@
 #include "../WebServer/JSON.h"
 
 #include "../WebServer/ESPEasy_WebServer.h"
+#include "../WebServer/404.h"
 #include "../WebServer/JSON.h"
 #include "../WebServer/Markup_Forms.h"
 
@@ -103,6 +104,21 @@ void handle_csvval()
   TXBuffer.endStream();
 }
 
+#if FEATURE_JSON_DELTA
+
+// Check whether any value of the task changed after the given change sequence number.
+bool hasChangedTaskValue(taskIndex_t TaskIndex, uint8_t valueCount, uint32_t since)
+{
+  for (uint8_t x = 0; x < valueCount; x++) {
+    if (UserVar.getChangeSequence(TaskIndex, x) > since) {
+      return true;
+    }
+  }
+  return false;
+}
+
+#endif // if FEATURE_JSON_DELTA
+
 // ********************************************************************************
 // Web Interface JSON page (no password!)
 // ********************************************************************************
@@ -139,6 +155,36 @@ void handle_json()
     }
   }
 
+  // Delta mode, using /json?since=<seq>
+  // Only return the task values changed after the given change sequence number.
+  // The system info is only included when requested with &system=1
+  bool     deltaMode = false;
+  uint32_t since     = 0;
+  #if FEATURE_JSON_DELTA
+  {
+    unsigned int arg_since = 0;
+
+    if (validUIntFromString(webArg(F("since")), arg_since)) {
+      deltaMode = true;
+      since     = arg_since;
+      UserVar.enableChangeTracking();
+
+      if (!equals(webArg(F("system")), '1')) {
+        showSystem = false;
+        showWifi   = false;
+        #if FEATURE_ETHERNET
+        showEthernet = false;
+        #endif // if FEATURE_ETHERNET
+        #if FEATURE_ESPEASY_P2P
+        showNodes = false;
+        #endif // if FEATURE_ESPEASY_P2P
+      }
+      showDataAcquisition = false;
+      showTaskDetails     = false;
+    }
+  }
+  #endif // if FEATURE_JSON_DELTA
+
   TXBuffer.startJsonStream();
 
   if (!showSpecificTask)
@@ -313,7 +359,7 @@ void handle_json()
 
       for (auto it = Nodes.begin(); it != Nodes.end(); ++it)
       {
-        if (it->second.ip[0] != 0)
+        if (it->ip[0] != 0)
         {
           if (comma_between) {
             addHtml(',');
@@ -323,23 +369,23 @@ void handle_json()
           }
 
           addHtml('{');
-          stream_next_json_object_value(F("nr"), it->first);
+          stream_next_json_object_value(F("nr"), it->unit);
           stream_next_json_object_value(F("name"),
-                                        (it->first != Settings.Unit) ? it->second.getNodeName() : Settings.getName());
+                                        (it->unit != Settings.Unit) ? it->getNodeName() : Settings.getName());
 
-          if (it->second.build) {
-            stream_next_json_object_value(F("build"), formatSystemBuildNr(it->second.build));
+          if (it->build) {
+            stream_next_json_object_value(F("build"), formatSystemBuildNr(it->build));
           }
 
-          if (it->second.nodeType) {
-            stream_next_json_object_value(F("platform"), it->second.getNodeTypeDisplayString());
+          if (it->nodeType) {
+            stream_next_json_object_value(F("platform"), it->getNodeTypeDisplayString());
           }
-          const int8_t rssi = it->second.getRSSI();
+          const int8_t rssi = it->getRSSI();
           if (rssi < 0) {
             stream_next_json_object_value(F("rssi"), rssi);
           }
-          stream_next_json_object_value(F("ip"), formatIP(it->second.IP()));
-          stream_last_json_object_value(F("age"), it->second.getAge());
+          stream_next_json_object_value(F("ip"), formatIP(it->IP()));
+          stream_last_json_object_value(F("age"), it->getAge());
         } // if node info exists
       }   // for loop
 
@@ -357,6 +403,18 @@ void handle_json()
   {
     firstTaskIndex = taskNr - 1;
     lastTaskIndex  = taskNr - 1;
+  } else {
+    // Only return a part of the tasks, using /json?offset=<first task index>&limit=<nr of tasks>
+    const int offset = getFormItemInt(F("offset"), 0);
+    const int limit  = getFormItemInt(F("limit"), 0);
+
+    if ((offset > 0) && (offset < TASKS_MAX)) {
+      firstTaskIndex = offset;
+    }
+
+    if ((limit > 0) && ((firstTaskIndex + limit) < TASKS_MAX)) {
+      lastTaskIndex = firstTaskIndex + limit - 1;
+    }
   }
   taskIndex_t lastActiveTaskIndex = 0;
 
@@ -372,6 +430,7 @@ void handle_json()
 
   // Keep track of the lowest reported TTL and use that as refresh interval.
   unsigned long lowest_ttl_json = 60;
+  bool firstTask                = true;
 
   for (taskIndex_t TaskIndex = firstTaskIndex; TaskIndex <= lastActiveTaskIndex && validTaskIndex(TaskIndex); TaskIndex++)
   {
@@ -380,14 +439,30 @@ void handle_json()
     if (validDeviceIndex(DeviceIndex))
     {
       const unsigned long taskInterval = Settings.TaskDeviceTimer[TaskIndex];
+
+      // For simplicity, do the optional values first.
+      const uint8_t valueCount = getValueCountForTask(TaskIndex);
+
+      if (deltaMode) {
+        #if FEATURE_JSON_DELTA
+
+        // Skip tasks without changed values
+        if (!showSpecificTask && !hasChangedTaskValue(TaskIndex, valueCount, since)) {
+          continue;
+        }
+        #endif // if FEATURE_JSON_DELTA
+
+        if (!firstTask) {
+          addHtml(',', '\n');
+        }
+        firstTask = false;
+      }
+
       //LoadTaskSettings(TaskIndex);
       addHtml('{', '\n');
 
       unsigned long ttl_json = 60; // Default value
 
-      // For simplicity, do the optional values first.
-      const uint8_t valueCount = getValueCountForTask(TaskIndex);
-
       if (valueCount != 0) {
         if (Settings.TaskDeviceEnabled[TaskIndex]) {
           if (taskInterval == 0) {
@@ -401,9 +476,21 @@ void handle_json()
           }
         }
         addHtml(F("\"TaskValues\": [\n"));
+        bool firstValue = true;
 
         for (uint8_t x = 0; x < valueCount; x++)
         {
+          #if FEATURE_JSON_DELTA
+
+          if (deltaMode && (UserVar.getChangeSequence(TaskIndex, x) <= since)) {
+            continue;
+          }
+          #endif // if FEATURE_JSON_DELTA
+
+          if (!firstValue) {
+            stream_comma_newline();
+          }
+          firstValue = false;
           addHtml('{');
           const String value = formatUserVarNoCheck(TaskIndex, x);
           uint8_t nrDecimals    = Cache.getTaskDeviceValueDecimals(TaskIndex, x);
@@ -416,16 +503,16 @@ void handle_json()
           stream_next_json_object_value(F("Name"),        Cache.getTaskDeviceValueName(TaskIndex, x));
           stream_next_json_object_value(F("NrDecimals"),  nrDecimals);
           stream_last_json_object_value(F("Value"), value);
-
-          if (x < (valueCount - 1)) {
-            stream_comma_newline();
-          }
         }
         addHtml(F("],\n"));
       }
 
       if (showSpecificTask) {
         stream_next_json_object_value(F("TTL"), ttl_json * 1000);
+
+        if (deltaMode) {
+          stream_next_json_object_value(F("Sequence"), String(UserVar.getLastChangeSequence()));
+        }
       }
 
       if (showDataAcquisition) {
@@ -483,6 +570,8 @@ void handle_json()
           }
         }
         #endif // if FEATURE_I2CMULTIPLEXER
+      } else if (deltaMode) {
+        stream_next_json_object_value(F("TaskName"),         getTaskDeviceName(TaskIndex));
       }
       stream_next_json_object_value(F("TaskEnabled"), 
         // jsonBool(Settings.TaskDeviceEnabled[TaskIndex].enabled));
@@ -490,7 +579,7 @@ void handle_json()
 
       stream_last_json_object_value(F("TaskNumber"), TaskIndex + 1);
 
-      if (TaskIndex != lastActiveTaskIndex) {
+      if (!deltaMode && (TaskIndex != lastActiveTaskIndex)) {
         addHtml(',');
       }
       addHtml('\n');
@@ -499,6 +588,10 @@ void handle_json()
 
   if (!showSpecificTask) {
     addHtml(F("],\n"));
+
+    if (deltaMode) {
+      stream_next_json_object_value(F("Sequence"), String(UserVar.getLastChangeSequence()));
+    }
     stream_last_json_object_value(F("TTL"), lowest_ttl_json * 1000);
   }
 
@@ -524,6 +617,86 @@ void handle_timingstats_json() {
 
 #endif // WEBSERVER_NEW_UI
 
+#if FEATURE_RULES_PROFILING
+void handle_rules_timingstats_json() {
+  if (!isLoggedIn()) { return; }
+  TXBuffer.startJsonStream();
+  json_init();
+  json_open();
+  jsonRulesStatistics();
+  json_close();
+  TXBuffer.endStream();
+}
+
+#endif // if FEATURE_RULES_PROFILING
+
+#if FEATURE_PLUGIN_STATS_HISTORY
+void handle_pluginstats_history_json() {
+  if (!isLoggedIn()) { return; }
+  const taskIndex_t taskNr = getFormItemInt(F("tasknr"), 0);
+  const PluginStatsHistoryTier_e tier =
+    equals(webArg(F("tier")), '0') ? PluginStatsHistoryTier_e::Minute : PluginStatsHistoryTier_e::QuarterHour;
+
+  TXBuffer.startJsonStream();
+  addHtml(strformat(
+            F("{\"TaskNumber\":%u,\"Interval\":%u,\"Values\":["),
+            static_cast<unsigned int>(taskNr),
+            static_cast<unsigned int>(PluginStatsHistory::getIntervalSec(tier))));
+
+  // Buckets are streamed as compact arrays: [timestamp,min,avg,max]
+  const PluginTaskData_base *taskData = (taskNr > 0) ? getPluginTaskDataBaseClassOnly(taskNr - 1) : nullptr;
+
+  if (taskData != nullptr) {
+    bool first = true;
+
+    for (taskVarIndex_t i = 0; i < VARS_PER_TASK; ++i) {
+      const PluginStats *stats = taskData->getPluginStats(i);
+
+      if ((stats == nullptr) || (stats->getHistory() == nullptr)) { continue; }
+
+      if (!first) { addHtml(','); }
+      first = false;
+      addHtml(F("{\"Name\":"));
+      json_quote_val(stats->getLabel());
+      addHtml(F(",\"Buckets\":["));
+
+      PluginStatsBucket_t bucket;
+
+      for (uint16_t b = 0; stats->getHistory()->getBucket(tier, b, bucket); ++b) {
+        if (b != 0) { addHtml(','); }
+        addHtml(strformat(
+                  F("[%u,%s,%s,%s]"),
+                  static_cast<unsigned int>(bucket.timestamp),
+                  toString(bucket.min, stats->getNrDecimals()).c_str(),
+                  toString(bucket.avg, stats->getNrDecimals()).c_str(),
+                  toString(bucket.max, stats->getNrDecimals()).c_str()));
+      }
+      addHtml(F("]}"));
+    }
+  }
+  addHtml(F("]}\n"));
+  TXBuffer.endStream();
+}
+
+#endif // if FEATURE_PLUGIN_STATS_HISTORY
+
+#if FEATURE_PLUGIN_STATS && FEATURE_CHART_JS
+void handle_pluginstats_bin() {
+  if (!isLoggedIn()) { return; }
+  const taskIndex_t taskNr = getFormItemInt(F("tasknr"), 0);
+  const PluginTaskData_base *taskData = (taskNr > 0) ? getPluginTaskDataBaseClassOnly(taskNr - 1) : nullptr;
+
+  if ((taskData == nullptr) || !taskData->hasPluginStats()) {
+    handleNotFound();
+    return;
+  }
+  TXBuffer.startStream(F("application/octet-stream"), F("*"), 200);
+  taskData->send_ChartJS_binary(equals(webArg(F("history")), '1'));
+  TXBuffer.endStream();
+}
+
+#endif // if FEATURE_PLUGIN_STATS && FEATURE_CHART_JS
+
 #ifdef WEBSERVER_NEW_UI
 
 #if FEATURE_ESPEASY_P2P
@@ -535,22 +708,22 @@ void handle_nodes_list_json() {
 
   for (auto it = Nodes.begin(); it != Nodes.end(); ++it)
   {
-    if (it->second.ip[0] != 0)
+    if (it->ip[0] != 0)
     {
       json_open();
-      bool isThisUnit = it->first == Settings.Unit;
+      bool isThisUnit = it->unit == Settings.Unit;
 
       if (isThisUnit) {
         json_number(F("thisunit"), String(1));
       }
 
-      json_number(F("first"), String(it->first));
-      json_prop(F("name"), isThisUnit ? Settings.getName() : it->second.getNodeName());
+      json_number(F("first"), String(it->unit));
+      json_prop(F("name"), isThisUnit ? Settings.getName() : it->getNodeName());
 
-      if (it->second.build) { json_prop(F("build"), formatSystemBuildNr(it->second.build)); }
-      json_prop(F("type"), it->second.getNodeTypeDisplayString());
-      json_prop(F("ip"),   formatIP(it->second.ip));
-      json_number(F("age"), String(it->second.getAge() / 1000)); // time in seconds
+      if (it->build) { json_prop(F("build"), formatSystemBuildNr(it->build)); }
+      json_prop(F("type"), it->getNodeTypeDisplayString());
+      json_prop(F("ip"),   formatIP(it->ip));
+      json_number(F("age"), String(it->getAge() / 1000)); // time in seconds
       json_close();
     }
   }
@@ -561,6 +734,9 @@ void handle_nodes_list_json() {
 
 void handle_buildinfo() {
   if (!isLoggedIn()) { return; }
+  #if FEATURE_WEB_RESPONSE_CACHE
+  if (Cache.webResponseCache.serve(F("application/json"), F("*"))) { return; }
+  #endif // if FEATURE_WEB_RESPONSE_CACHE
   TXBuffer.startJsonStream();
   json_init();
   json_open();
@@ -24,6 +24,30 @@ void handle_timingstats_json();
 
 #endif // WEBSERVER_NEW_UI
 
+#if FEATURE_RULES_PROFILING
+void handle_rules_timingstats_json();
+
+#endif // if FEATURE_RULES_PROFILING
+
+#if FEATURE_PLUGIN_STATS_HISTORY
+
+// ********************************************************************************
+// Downsampled task value history, use tasknr=<1..N>&tier=<0: 1 minute, 1: 15 minutes>
+// ********************************************************************************
+void handle_pluginstats_history_json();
+
+#endif // if FEATURE_PLUGIN_STATS_HISTORY
+
+#if FEATURE_PLUGIN_STATS && FEATURE_CHART_JS
+
+// ********************************************************************************
+// Task statistics as binary chart data, use tasknr=<1..N>[&history=1]
+// Format described with add_ChartJS_binary_header()
+// ********************************************************************************
+void handle_pluginstats_bin();
+
+#endif // if FEATURE_PLUGIN_STATS && FEATURE_CHART_JS
+
 #ifdef WEBSERVER_NEW_UI
 #if FEATURE_ESPEASY_P2P
 void handle_nodes_list_json();
@@ -177,6 +177,21 @@ bool reply_304_not_modified(const String& path) {
   return res;
 }
 
+// ********************************************************************************
+// Check whether a generated page is requested again while it has not changed
+// ********************************************************************************
+bool reply_304_not_modified_ETag(const String& etag) {
+  const String ifNoneMatch = stripQuotes(web_server.header(F("If-None-Match")));
+
+  if (ifNoneMatch.isEmpty() || !ifNoneMatch.equals(stripQuotes(etag))) {
+    return false;
+  }
+#ifndef BUILD_NO_DEBUG
+  addLog(LOG_LEVEL_INFO, concat(F("Serve 304: "), etag) + ' ' + web_server.uri());
+#endif // ifndef BUILD_NO_DEBUG
+  return true;
+}
+
 // ********************************************************************************
 // Determine HTTP content type
 // ********************************************************************************
@@ -6,6 +6,9 @@
 
 bool loadFromFS(String path);
 
+// Return true when the browser already has the version of the page with this ETag.
+bool reply_304_not_modified_ETag(const String& etag);
+
 void serve_CSS_inline();
 
 // Send the content of a file directly to the webserver, like addHtml()
@@ -11,7 +11,9 @@
 
 #include "../Globals/Logging.h"
 #include "../Globals/Settings.h"
+#include "../Globals/TXBuffer.h"
 #include "../Helpers/ESPEasy_time_calc.h"
+#include "../Helpers/Numerical.h"
 #include "../Static/WebStaticData.h"
 
 // ********************************************************************************
@@ -42,8 +44,40 @@ void handle_log() {
   TXBuffer.endStream();
 }
 
+#ifdef WEBSERVER_LOG
+
+// Stream the log message as JSON string, straight from the buffer.
+// Same character replacements as to_json_value()
+static void stream_log_message_json(char *message, int length) {
+  for (int i = 0; i < length; ++i) {
+    switch (message[i]) {
+      case '\n':
+      case '\r':
+      case '\\':
+      case '\b':
+      case '\f':
+        message[i] = '^';
+        break;
+      case '\t':
+        message[i] = ' ';
+        break;
+      case '"':
+        message[i] = '\'';
+        break;
+    }
+  }
+  addHtml('"');
+  TXBuffer.addFlashString(message, length);
+  addHtml('"');
+}
+
+#endif // ifdef WEBSERVER_LOG
+
 // ********************************************************************************
 // Web Interface JSON log page
+// Every client keeps its own cursor: "next" in the reply is to be used as
+// "since" argument in the next request, to only receive the new lines.
+// Without "since", all lines present in the log buffer are sent.
 // ********************************************************************************
 void handle_log_JSON() {
   if (!isLoggedIn()) { return; }
@@ -67,40 +101,59 @@ void handle_log_JSON() {
     addHtml(F("],\n"));
   }
   addHtml(F("\"Entries\": ["));
-  bool logLinesAvailable       = true;
+  uint32_t seq = Logging.getOldestSeq();
+  {
+    unsigned int since = 0;
+
+    if (validUIntFromString(webArg(F("since")), since)) {
+      seq = since;
+    }
+  }
   int  nrEntries               = 0;
+  long bytesRead               = 0;
   unsigned long firstTimeStamp = 0;
   unsigned long lastTimeStamp  = 0;
-
-  while (logLinesAvailable) {
-    String message;
-    uint8_t loglevel;
-    if (Logging.getNext(logLinesAvailable, lastTimeStamp, message, loglevel)) {
-      addHtml('{');
-      stream_next_json_object_value(F("timestamp"), lastTimeStamp);
-      stream_next_json_object_value(F("text"),  std::move(message));
-      stream_last_json_object_value(F("level"), loglevel);
-      if (logLinesAvailable) {
-        addHtml(',', '\n');
-      }
-      if (nrEntries == 0) {
-        firstTimeStamp = lastTimeStamp;
-      }
-      ++nrEntries;
+  char message[LOG_STRUCT_MESSAGE_SIZE];
+  uint8_t loglevel = 0;
+  int length       = Logging.getLine(seq, lastTimeStamp, message, loglevel);
+
+  while (length >= 0) {
+    if (nrEntries != 0) {
+      addHtml(',', '\n');
+
+      // Size of the entries added after the first entry
+      bytesRead += LOG_STRUCT_RECORD_HEADER_SIZE + length;
+    } else {
+      firstTimeStamp = lastTimeStamp;
     }
-
-    // Do we need to do something here and maybe limit number of lines at once?
+    addHtml(F("{\"seq\":"));
+    addHtmlInt(seq);
+    addHtml(F(",\"timestamp\":"));
+    addHtmlInt(static_cast<uint32_t>(lastTimeStamp));
+    addHtml(F(",\"text\":"));
+    stream_log_message_json(message, length);
+    addHtml(F(",\"level\":"));
+    addHtmlInt(static_cast<int32_t>(loglevel));
+    addHtml('}');
+    ++nrEntries;
+    ++seq;
+    length = Logging.getLine(seq, lastTimeStamp, message, loglevel);
   }
   addHtml(F("],\n"));
   long logTimeSpan       = timeDiff(firstTimeStamp, lastTimeStamp);
   long refreshSuggestion = 1000;
   long newOptimum        = 1000;
 
-  if ((nrEntries > 2) && (logTimeSpan > 1)) {
+  if ((nrEntries > 2) && (logTimeSpan > 1) && (bytesRead > 0)) {
     // May need to lower the TTL for refresh when time needed
     // to fill half the log is lower than current TTL
-    newOptimum = logTimeSpan * (LOG_STRUCT_MESSAGE_LINES / 2);
-    newOptimum = newOptimum / (nrEntries - 1);
+    newOptimum = (static_cast<int64_t>(logTimeSpan) * (LOG_STRUCT_BUFFER_SIZE / 2)) / bytesRead;
+  }
+
+  if (nrEntries == 0) {
+    // Nothing logged since the last request, poll less often.
+    // Still well within LOG_BUFFER_ACTIVE_READ_TIMEOUT, so logging to the web log stays active.
+    refreshSuggestion = 2000;
   }
 
   if (newOptimum < refreshSuggestion) { refreshSuggestion = newOptimum; }
@@ -112,6 +165,7 @@ void handle_log_JSON() {
   stream_next_json_object_value(F("TTL"),                 refreshSuggestion);
   stream_next_json_object_value(F("timeHalfBuffer"),      newOptimum);
   stream_next_json_object_value(F("nrEntries"),           nrEntries);
+  stream_next_json_object_value(F("next"),                String(seq));
   stream_next_json_object_value(F("SettingsWebLogLevel"), Settings.WebLogLevel);
   stream_last_json_object_value(F("logTimeSpan"),         logTimeSpan);
   addHtml(F("}\n"));
@@ -244,10 +244,8 @@ void do_addSelector_Head(const String& id, const __FlashStringHelper * classname
                          #endif // if FEATURE_TOOLTIPS
                          )
 {
-  addHtml(F("<select "));
-  addHtmlAttribute(F("class"), classname);
-  addHtmlAttribute(F("name"),  id);
-  addHtmlAttribute(F("id"),    id);
+  addHtmlTemplate(F("<select class='{0}' name='{1}' id='{1}'"),
+                  { classname, HtmlTemplateArg::encoded(id) });
 
   #if FEATURE_TOOLTIPS
 
@@ -389,48 +387,24 @@ void addPinSelector_Item(PinSelectPurpose purpose, const String& gpio_label, int
 
 void addSelector_Item(const __FlashStringHelper *option, int index, bool    selected, bool    disabled, const String& attr)
 {
-  addHtml(F("<option "));
-  addHtmlAttribute(F("value"), index);
-
-  if (selected) {
-    addHtml(F(" selected"));
-  }
-
-  if (disabled) {
-    addDisabled();
-  }
-
-  if (attr.length() > 0)
-  {
-    addHtml(' ');
-    addHtml(attr);
-  }
-  addHtml('>');
-  addHtml(option);
-  addHtml(F("</option>"));
+  addHtmlTemplate(F("<option value={0}{1}{2}{3}{4}>{5}</option>"),
+                  { index,
+                    selected ? F(" selected") : F(""),
+                    disabled ? F(" disabled") : F(""),
+                    (attr.length() > 0) ? F(" ") : F(""),
+                    attr,
+                    option });
 }
 
 void addSelector_Item(const String& option, int index, bool    selected, bool    disabled, const String& attr)
 {
-  addHtml(F("<option "));
-  addHtmlAttribute(F("value"), index);
-
-  if (selected) {
-    addHtml(F(" selected"));
-  }
-
-  if (disabled) {
-    addDisabled();
-  }
-
-  if (attr.length() > 0)
-  {
-    addHtml(' ');
-    addHtml(attr);
-  }
-  addHtml('>');
-  addHtml(option);
-  addHtml(F("</option>"));
+  addHtmlTemplate(F("<option value={0}{1}{2}{3}{4}>{5}</option>"),
+                  { index,
+                    selected ? F(" selected") : F(""),
+                    disabled ? F(" disabled") : F(""),
+                    (attr.length() > 0) ? F(" ") : F(""),
+                    attr,
+                    option });
 }
 
 void addSelector_Foot()
@@ -650,21 +624,12 @@ void addCheckBox(const String& id, bool    checked, bool disabled
                  #endif // if FEATURE_TOOLTIPS
                  )
 {
-  addHtml(F("<label class='container'>&nbsp;"));
-  addHtml(F("<input "));
-  addHtmlAttribute(F("type"), F("checkbox"));
-  addHtmlAttribute(F("id"),   id);
-  addHtmlAttribute(F("name"), id);
-
-  if (checked) {
-    addHtml(F(" checked"));
-  }
+  const __FlashStringHelper *disabledAttr = disabled ? F(" disabled") : F("");
 
-  if (disabled) { addDisabled(); }
-  addHtml(F("><span class='checkmark"));
-
-  if (disabled) { addDisabled(); }
-  addHtml('\'');
+  addHtmlTemplate(F("<label class='container'>&nbsp;<input type='checkbox' id='{0}' name='{0}'{1}{2}><span class='checkmark{2}'"),
+                  { HtmlTemplateArg::encoded(id),
+                    checked ? F(" checked") : F(""),
+                    disabledAttr });
   #if FEATURE_TOOLTIPS
 
   if (tooltip.length() > 0) {
@@ -689,15 +654,14 @@ void addNumericBox(const String& id, int value, int min, int max
                    , bool disabled
                    )
 {
-  addHtml(F("<input "));
-  #if FEATURE_TOOLTIPS
-  addHtmlAttribute(F("class"), classname);
-  #else // if FEATURE_TOOLTIPS
-  addHtmlAttribute(F("class"), F("widenumber"));
-  #endif  // if FEATURE_TOOLTIPS
-  addHtmlAttribute(F("type"),  F("number"));
-  addHtmlAttribute(F("name"),  id);
-  addHtmlAttribute(F("id"),    id);
+  addHtmlTemplate(F("<input class='{0}' type='number' name='{1}' id='{1}'"),
+                  {
+                    #if FEATURE_TOOLTIPS
+                    classname,
+                    #else // if FEATURE_TOOLTIPS
+                    F("widenumber"),
+                    #endif  // if FEATURE_TOOLTIPS
+                    HtmlTemplateArg::encoded(id) });
 
   #if FEATURE_TOOLTIPS
 
@@ -1,5 +1,6 @@
 #include "../WebServer/Metrics.h"
 #include "../WebServer/ESPEasy_WebServer.h"
+#include "../WebServer/HTML_wrappers.h"
 #include "../../ESPEasy-Globals.h"
 #include "../Commands/Diagnostic.h"
 #include "../ESPEasyCore/ESPEasyNetwork.h"
@@ -10,10 +11,188 @@
 
 #ifdef WEBSERVER_METRICS
 
+# include "../ControllerQueue/ControllerDelayHandlerStruct.h"
+# include "../ControllerQueue/SampleLatency.h"
+# include "../DataStructs/TimingStats.h"
+# include "../Globals/CPlugins.h"
+# include "../Globals/EventQueue.h"
+# include "../Helpers/HeapTracker.h"
+# include "../Helpers/SlowLoopDetector.h"
+# include "../Helpers/_Plugin_init.h"
+
+# ifdef USES_C018
+#  include "../Controller_struct/C018_data_struct.h"
+# endif // ifdef USES_C018
+
 # ifdef ESP32
 #  include <esp_partition.h>
 # endif // ifdef ESP32
 
+// The device values section is cached between scrapes until a task sends new data.
+// Values may also be changed without sending data (e.g. TaskValueSet),
+// so the cache is also refreshed when it gets too old.
+# define METRICS_DEVICES_CACHE_MAX_AGE  60000
+
+# ifdef ESP8266
+#  define METRICS_DEVICES_CACHE_MAX_SIZE 2048
+# else // ifdef ESP8266
+#  define METRICS_DEVICES_CACHE_MAX_SIZE 16384
+# endif // ifdef ESP8266
+
+static String metricsDevicesCache;
+static unsigned long metricsDevicesCacheTime = 0;
+static bool metricsDevicesDirty              = true;
+
+void metrics_markDevicesDirty() {
+  metricsDevicesDirty = true;
+}
+
+static void addMetricsHeader(const __FlashStringHelper *name,
+                             const __FlashStringHelper *help,
+                             const __FlashStringHelper *type) {
+  addHtml(F("# HELP espeasy_"));
+  addHtml(name);
+  addHtml(' ');
+  addHtml(help);
+  addHtml(F("\n# TYPE espeasy_"));
+  addHtml(name);
+  addHtml(' ');
+  addHtml(type);
+  addHtml('\n');
+}
+
+# if FEATURE_TIMING_STATS && FEATURE_TIMING_STATS_HISTOGRAM
+
+// Export TimingStats as Prometheus histogram, with cumulative bucket counts.
+static void addMetricsHistogram(const __FlashStringHelper *name,
+                                const String             & labels,
+                                const TimingStats        & stats) {
+  uint32_t cumulative = 0;
+
+  for (uint8_t bucket = 0; bucket < TIMING_STATS_HISTOGRAM_BUCKETS; ++bucket) {
+    cumulative += stats.getBucketCount(bucket);
+    addHtml(F("espeasy_"));
+    addHtml(name);
+    addHtml(F("_bucket{"));
+    addHtml(labels);
+    addHtml(F(",le=\""));
+    const uint32_t upperBound = TimingStats::getBucketUpperBound(bucket);
+
+    if (upperBound == 0) {
+      addHtml(F("+Inf"));
+    } else {
+      addHtmlInt(upperBound);
+    }
+    addHtml(F("\"} "));
+    addHtmlInt(cumulative);
+    addHtml('\n');
+  }
+  uint64_t minVal, maxVal;
+  const uint32_t count = stats.getMinMax(minVal, maxVal);
+
+  addHtml(F("espeasy_"));
+  addHtml(name);
+  addHtml(F("_sum{"));
+  addHtml(labels);
+  addHtml(F("} "));
+  addHtml(toString(stats.getSum(), 0));
+  addHtml('\n');
+
+  addHtml(F("espeasy_"));
+  addHtml(name);
+  addHtml(F("_count{"));
+  addHtml(labels);
+  addHtml(F("} "));
+  addHtmlInt(count);
+  addHtml('\n');
+}
+
+static void handle_metrics_timing_stats() {
+  if (!Settings.EnableTimingStats()) { return; }
+
+  addMetricsHeader(F("timing_plugin_usec"), F("Duration of plugin calls in usec"), F("histogram"));
+
+  for (auto& x: pluginStats) {
+    if (!x.second.isEmpty()) {
+      const deviceIndex_t deviceIndex = deviceIndex_t::toDeviceIndex(x.first >> 8);
+
+      if (validDeviceIndex(deviceIndex)) {
+        String labels = F("plugin=\"");
+        labels += get_formatted_Plugin_number(getPluginID_from_DeviceIndex(deviceIndex));
+        labels += F("\",function=\"");
+        labels += getPluginFunctionName(x.first % 256);
+        labels += '"';
+        addMetricsHistogram(F("timing_plugin_usec"), labels, x.second);
+      }
+    }
+  }
+
+  addMetricsHeader(F("timing_controller_usec"), F("Duration of controller calls in usec"), F("histogram"));
+
+  for (auto& x: controllerStats) {
+    if (!x.second.isEmpty()) {
+      const int ProtocolIndex = x.first >> 8;
+      String    labels        = F("controller=\"");
+      labels += get_formatted_Controller_number(getCPluginID_from_ProtocolIndex(ProtocolIndex));
+      labels += F("\",function=\"");
+      labels += getCPluginCFunctionName(static_cast<CPlugin::Function>(x.first % 256));
+      labels += '"';
+      addMetricsHistogram(F("timing_controller_usec"), labels, x.second);
+    }
+  }
+
+  addMetricsHeader(F("timing_misc_usec"), F("Duration of internal functions in usec"), F("histogram"));
+
+  for (auto& x: miscStats) {
+    if (!x.second.isEmpty()) {
+      String labels = F("stat=\"");
+      labels += getMiscStatsName(x.first);
+      labels += '"';
+      addMetricsHistogram(F("timing_misc_usec"), labels, x.second);
+    }
+  }
+}
+
+# endif // if FEATURE_TIMING_STATS && FEATURE_TIMING_STATS_HISTOGRAM
+
+# if FEATURE_SAMPLE_LATENCY
+
+// Export SampleLatencyStats as Prometheus histogram, with cumulative bucket counts.
+static void addMetricsSampleLatency(const String& labels, const SampleLatencyStats& stats) {
+  uint32_t cumulative = 0;
+
+  for (uint8_t bucket = 0; bucket < SAMPLE_LATENCY_NR_BUCKETS; ++bucket) {
+    cumulative += stats.buckets[bucket];
+    addHtml(F("espeasy_sample_latency_usec_bucket{"));
+    addHtml(labels);
+    addHtml(F(",le=\""));
+
+    if (bucket == (SAMPLE_LATENCY_NR_BUCKETS - 1)) {
+      // Bucket counts saturate, the total count does not.
+      cumulative = stats.count;
+      addHtml(F("+Inf"));
+    } else {
+      addHtmlInt(SampleLatencyStats::getBucketUpperBound(bucket));
+    }
+    addHtml(F("\"} "));
+    addHtmlInt(cumulative);
+    addHtml('\n');
+  }
+  addHtml(F("espeasy_sample_latency_usec_sum{"));
+  addHtml(labels);
+  addHtml(F("} "));
+  addHtml(ull2String(stats.sum_usec));
+  addHtml('\n');
+
+  addHtml(F("espeasy_sample_latency_usec_count{"));
+  addHtml(labels);
+  addHtml(F("} "));
+  addHtmlInt(stats.count);
+  addHtml('\n');
+}
+
+# endif // if FEATURE_SAMPLE_LATENCY
+
 void handle_metrics() {
   TXBuffer.startStream(F("text/plain"), F("*"));
   const __FlashStringHelper *prefixHELP = F("# HELP espeasy_");
@@ -82,57 +261,289 @@ void handle_metrics() {
   addHtml(getValue(LabelType::NUMBER_RECONNECTS));
   addHtml('\n');
 
+  // Largest free heap block
+  addMetricsHeader(F("heap_max_free_block"), F("Largest free block on the heap in Bytes"), F("gauge"));
+  addHtml(F("espeasy_heap_max_free_block "));
+  addHtml(getValue(LabelType::HEAP_MAX_FREE_BLOCK));
+  addHtml('\n');
+
+  # if FEATURE_HEAP_TRACKER
+
+  // Heap usage per subsystem
+  addMetricsHeader(F("heap_tag_bytes"), F("Net heap usage of the subsystem since boot in Bytes"), F("gauge"));
+
+  for (uint8_t i = 0; i < static_cast<uint8_t>(HeapTag_e::NR_ELEMENTS); ++i) {
+    addHtml(F("espeasy_heap_tag_bytes{tag=\""));
+    addHtml(toString(static_cast<HeapTag_e>(i)));
+    addHtml(F("\"} "));
+    addHtmlInt(HeapTracker_getStats(static_cast<HeapTag_e>(i)).current);
+    addHtml('\n');
+  }
+  addMetricsHeader(F("heap_tag_peak_bytes"), F("Peak heap usage of the subsystem since boot in Bytes"), F("gauge"));
+
+  for (uint8_t i = 0; i < static_cast<uint8_t>(HeapTag_e::NR_ELEMENTS); ++i) {
+    addHtml(F("espeasy_heap_tag_peak_bytes{tag=\""));
+    addHtml(toString(static_cast<HeapTag_e>(i)));
+    addHtml(F("\"} "));
+    addHtmlInt(HeapTracker_getStats(static_cast<HeapTag_e>(i)).peak);
+    addHtml('\n');
+  }
+  addMetricsHeader(F("heap_tag_allocations"), F("Number of times the subsystem used more heap after a call"), F("counter"));
+
+  for (uint8_t i = 0; i < static_cast<uint8_t>(HeapTag_e::NR_ELEMENTS); ++i) {
+    addHtml(F("espeasy_heap_tag_allocations{tag=\""));
+    addHtml(toString(static_cast<HeapTag_e>(i)));
+    addHtml(F("\"} "));
+    addHtmlInt(HeapTracker_getStats(static_cast<HeapTag_e>(i)).allocations);
+    addHtml('\n');
+  }
+  # endif // if FEATURE_HEAP_TRACKER
+
+  # if FEATURE_SLOW_LOOP_DETECTOR
+
+  // Slow loops
+  addMetricsHeader(F("slow_loops"), F("Number of loops taking longer than the slow loop threshold since boot"), F("counter"));
+  addHtml(F("espeasy_slow_loops "));
+  addHtmlInt(SlowLoop_getCount());
+  addHtml('\n');
+  addMetricsHeader(F("slow_loop_duration_usec"), F("Duration of the last slow loops and what ran in it, 0 = most recent"), F("gauge"));
+
+  for (uint8_t i = 0; i < SlowLoop_getNrIncidents(); ++i) {
+    const SlowLoopIncident_t *incident = SlowLoop_getIncident(i);
+
+    if (incident == nullptr) { continue; }
+    String context = SlowLoop_describe(*incident);
+    context.replace('"', '\'');
+    context.replace('\\', '/');
+    addHtml(strformat(
+              F("espeasy_slow_loop_duration_usec{index=\"%d\",boot=\"%u\",uptime_msec=\"%u\",context=\"%s\"} %u\n"),
+              i,
+              static_cast<unsigned int>(incident->bootCounter),
+              static_cast<unsigned int>(incident->uptime_msec),
+              context.c_str(),
+              static_cast<unsigned int>(incident->duration_usec)));
+  }
+  # endif // if FEATURE_SLOW_LOOP_DETECTOR
+
+  // Rules event queue
+  addMetricsHeader(F("event_queue_depth"), F("Number of events waiting to be processed by the rules"), F("gauge"));
+  addHtml(F("espeasy_event_queue_depth "));
+  addHtmlInt(static_cast<uint32_t>(eventQueue.size()));
+  addHtml('\n');
+
+  // Controller queues
+  addMetricsHeader(F("controller_queue_depth"), F("Number of messages waiting in the controller queue"), F("gauge"));
+
+  for (controllerIndex_t x = 0; validControllerIndex(x); x++) {
+    if (Settings.Protocol[x] != 0) {
+      addHtml(F("espeasy_controller_queue_depth{controller=\""));
+      addHtmlInt(static_cast<int32_t>(x + 1));
+      addHtml(F("\"} "));
+      addHtmlInt(static_cast<uint32_t>(ControllerDelayHandlerStruct::getQueueDepth(x)));
+      addHtml('\n');
+    }
+  }
+
+  # if FEATURE_SAMPLE_LATENCY
+
+  // Time from reading a sample until delivered by the controller
+  addMetricsHeader(F("sample_latency_usec"), F("Time from reading a sample until delivered by the controller in usec"), F("histogram"));
+
+  for (controllerIndex_t x = 0; validControllerIndex(x); x++) {
+    const SampleLatencyStats stats = SampleLatency_getController(x);
+
+    if (!stats.isEmpty()) {
+      addMetricsSampleLatency(concat(F("controller=\""), x + 1) + '"', stats);
+    }
+  }
+
+  for (taskIndex_t x = 0; validTaskIndex(x); x++) {
+    const SampleLatencyStats stats = SampleLatency_getTask(x);
+
+    if (!stats.isEmpty()) {
+      addMetricsSampleLatency(concat(F("task=\""), x + 1) + '"', stats);
+    }
+  }
+  addMetricsHeader(F("sample_latency_p99_usec"), F("Upper bound of the 99th percentile of the sample latency in usec"), F("gauge"));
+
+  for (controllerIndex_t x = 0; validControllerIndex(x); x++) {
+    const SampleLatencyStats stats = SampleLatency_getController(x);
+
+    if (!stats.isEmpty()) {
+      addHtml(strformat(F("espeasy_sample_latency_p99_usec{controller=\"%d\"} %u\n"),
+                        x + 1, static_cast<unsigned int>(stats.getP99())));
+    }
+  }
+
+  for (taskIndex_t x = 0; validTaskIndex(x); x++) {
+    const SampleLatencyStats stats = SampleLatency_getTask(x);
+
+    if (!stats.isEmpty()) {
+      addHtml(strformat(F("espeasy_sample_latency_p99_usec{task=\"%d\"} %u\n"),
+                        x + 1, static_cast<unsigned int>(stats.getP99())));
+    }
+  }
+  # endif // if FEATURE_SAMPLE_LATENCY
+
+  # ifdef USES_C018
+  {
+    const float airtime = C018_getRemainingAirtime();
+
+    if (airtime >= 0.0f) {
+      addMetricsHeader(F("lora_airtime_budget_msec"), F("Remaining LoRaWAN duty cycle air time in msec"), F("gauge"));
+      addHtml(F("espeasy_lora_airtime_budget_msec "));
+      addHtml(toString(airtime, 0));
+      addHtml('\n');
+    }
+  }
+  # endif // ifdef USES_C018
+
+  # if FEATURE_CONTROLLER_BACKOFF
+
+  // Controller retry backoff
+  addMetricsHeader(F("controller_circuit_state"), F("Circuit state of the controller queue, 0 = closed, 1 = open, 2 = half-open"), F("gauge"));
+
+  for (controllerIndex_t x = 0; validControllerIndex(x); x++) {
+    ControllerBackoff backoff;
+
+    if ((Settings.Protocol[x] != 0) && ControllerDelayHandlerStruct::getBackoffState(x, backoff)) {
+      addHtml(F("espeasy_controller_circuit_state{controller=\""));
+      addHtmlInt(static_cast<int32_t>(x + 1));
+      addHtml(F("\"} "));
+      addHtmlInt(static_cast<uint32_t>(backoff.getState()));
+      addHtml('\n');
+    }
+  }
+  addMetricsHeader(F("controller_consecutive_failures"), F("Number of failed attempts of the controller since the last successful message"), F("gauge"));
+
+  for (controllerIndex_t x = 0; validControllerIndex(x); x++) {
+    ControllerBackoff backoff;
+
+    if ((Settings.Protocol[x] != 0) && ControllerDelayHandlerStruct::getBackoffState(x, backoff)) {
+      addHtml(F("espeasy_controller_consecutive_failures{controller=\""));
+      addHtmlInt(static_cast<int32_t>(x + 1));
+      addHtml(F("\"} "));
+      addHtmlInt(static_cast<uint32_t>(backoff.getConsecutiveFailures()));
+      addHtml('\n');
+    }
+  }
+  addMetricsHeader(F("controller_circuit_opened"), F("Number of times the circuit of the controller queue was opened since boot"), F("counter"));
+
+  for (controllerIndex_t x = 0; validControllerIndex(x); x++) {
+    ControllerBackoff backoff;
+
+    if ((Settings.Protocol[x] != 0) && ControllerDelayHandlerStruct::getBackoffState(x, backoff)) {
+      addHtml(F("espeasy_controller_circuit_opened{controller=\""));
+      addHtmlInt(static_cast<int32_t>(x + 1));
+      addHtml(F("\"} "));
+      addHtmlInt(backoff.getOpenCount());
+      addHtml('\n');
+    }
+  }
+  # endif // if FEATURE_CONTROLLER_BACKOFF
+
   // devices
   handle_metrics_devices();
 
+  # if FEATURE_TIMING_STATS && FEATURE_TIMING_STATS_HISTOGRAM
+  handle_metrics_timing_stats();
+  # endif // if FEATURE_TIMING_STATS && FEATURE_TIMING_STATS_HISTOGRAM
+
   TXBuffer.endStream();
 }
 
-void handle_metrics_devices() {
-  for (taskIndex_t x = 0; validTaskIndex(x); x++) {
-    const deviceIndex_t DeviceIndex = getDeviceIndex_from_TaskIndex(x);
-    const bool pluginID_set         = INVALID_PLUGIN_ID != Settings.getPluginID_for_task(x);
-
-    if (pluginID_set) {
-      if (Settings.TaskDeviceEnabled[x]) {
-        String deviceName = getTaskDeviceName(x);
-
-        if (deviceName.isEmpty()) { // Empty name, then use taskN
-          deviceName  = F("task");
-          deviceName += x + 1;
-        }
-        addHtml(F("# HELP espeasy_device_"));
-        addHtml(deviceName);
-        addHtml(F(" Values from connected device\n"));
-        addHtml(F("# TYPE espeasy_device_"));
-        addHtml(deviceName);
-        addHtml(F(" gauge\n"));
-
-        if (validDeviceIndex(DeviceIndex)) {
-          String customValuesString;
-
-          // const bool customValues = PluginCall(PLUGIN_WEBFORM_SHOW_VALUES, &TempEvent, customValuesString);
-          const bool customValues = 0; // TODO: handle custom values
-
-          if (!customValues) {
-            const uint8_t valueCount = getValueCountForTask(x);
-
-            for (uint8_t varNr = 0; varNr < valueCount; varNr++) {
-              if (validPluginID_fullcheck(Settings.getPluginID_for_task(x))) {
-                addHtml(F("espeasy_device_"));
-                addHtml(deviceName);
-                addHtml(F("{valueName=\""));
-                addHtml(getTaskValueName(x, varNr));
-                addHtml(F("\"} "));
-                addHtml(formatUserVarNoCheck(x, varNr));
-                addHtml('\n');
-              }
-            }
-          }
-        }
+// Collects the device section to be cached.
+// Once it grows beyond the max. cache size, the collected part is sent and the rest is streamed directly.
+class MetricsDevicesWriter {
+public:
+
+  template<typename T>
+  MetricsDevicesWriter& operator+=(const T& value) {
+    if (_streaming) {
+      TXBuffer += value;
+    } else {
+      _res += value;
+
+      if (_res.length() > METRICS_DEVICES_CACHE_MAX_SIZE) {
+        TXBuffer += _res;
+        _res       = String();
+        _streaming = true;
+      }
+    }
+    return *this;
+  }
+
+  bool streaming() const {
+    return _streaming;
+  }
+
+  String _res;
+
+private:
+
+  bool _streaming = false;
+};
+
+static void render_metrics_devices(MetricsDevicesWriter& res) {
+  // Copy, as loading the task settings may rebuild the list.
+  const std::vector<taskIndex_t> enabledTasks = Cache.getEnabledTasks();
+
+  for (const taskIndex_t x : enabledTasks) {
+    String deviceName = getTaskDeviceName(x);
+
+    if (deviceName.isEmpty()) { // Empty name, then use taskN
+      deviceName  = F("task");
+      deviceName += x + 1;
+    }
+    res += F("# HELP espeasy_device_");
+    res += deviceName;
+    res += F(" Values from connected device\n");
+    res += F("# TYPE espeasy_device_");
+    res += deviceName;
+    res += F(" gauge\n");
+
+    // const bool customValues = PluginCall(PLUGIN_WEBFORM_SHOW_VALUES, &TempEvent, customValuesString);
+    const bool customValues = 0; // TODO: handle custom values
+
+    if (!customValues) {
+      const uint8_t valueCount = getValueCountForTask(x);
+
+      for (uint8_t varNr = 0; varNr < valueCount; varNr++) {
+        res += F("espeasy_device_");
+        res += deviceName;
+        res += F("{valueName=\"");
+        res += getTaskValueName(x, varNr);
+        res += F("\"} ");
+        res += formatUserVarNoCheck(x, varNr);
+        res += '\n';
       }
     }
   }
 }
 
+void handle_metrics_devices() {
+  if (!metricsDevicesDirty &&
+      !metricsDevicesCache.isEmpty() &&
+      (timePassedSince(metricsDevicesCacheTime) < METRICS_DEVICES_CACHE_MAX_AGE)) {
+    addHtml(metricsDevicesCache);
+    return;
+  }
+  // Release the old cache first, so it is not in memory together with the new one.
+  metricsDevicesCache = String();
+
+  MetricsDevicesWriter res;
+
+  render_metrics_devices(res);
+
+  metricsDevicesDirty     = false;
+  metricsDevicesCacheTime = millis();
+
+  if (res.streaming()) {
+    // Too large to keep in memory, already sent and rendered again on each scrape.
+    return;
+  }
+  addHtml(res._res);
+  metricsDevicesCache = std::move(res._res);
+}
+
 #endif // WEBSERVER_METRICS
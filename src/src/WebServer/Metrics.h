@@ -8,6 +8,10 @@
 void handle_metrics();
 void handle_metrics_devices();
 
+// Mark the cached device values section as outdated.
+// Called when a task sent new values or task settings were changed.
+void metrics_markDevicesDirty();
+
 #endif    // ifdef WEBSERVER_METRICS
 
 #endif
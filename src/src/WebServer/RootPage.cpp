@@ -290,9 +290,9 @@ void handle_root() {
 
     for (auto it = Nodes.begin(); it != Nodes.end(); ++it)
     {
-      if (it->second.valid())
+      if (it->valid())
       {
-        bool isThisUnit = it->first == Settings.Unit;
+        bool isThisUnit = it->unit == Settings.Unit;
 
         if (isThisUnit) {
           html_TR_TD_highlight();
@@ -302,77 +302,77 @@ void handle_root() {
         }
 
         addHtml(F("Unit "));
-        addHtmlInt(it->first);
+        addHtmlInt(it->unit);
         html_TD();
 
         if (isThisUnit) {
           addHtml(Settings.getName());
         }
         else {
-          addHtml(it->second.getNodeName());
+          addHtml(it->getNodeName());
         }
         html_TD();
 
         if (MAIN_PAGE_SHOW_NODE_LIST_BUILD) {
-          if (it->second.build) {
-            addHtml(formatSystemBuildNr(it->second.build));
+          if (it->build) {
+            addHtml(formatSystemBuildNr(it->build));
           }
           html_TD();
         }
 
         if (MAIN_PAGE_SHOW_NODE_LIST_TYPE) {
-          addHtml(it->second.getNodeTypeDisplayString());
+          addHtml(it->getNodeTypeDisplayString());
           html_TD();
         }
 
-        if (it->second.ip[0] != 0)
+        if (it->ip[0] != 0)
         {
           html_add_wide_button_prefix();
 
           addHtml(F("http://"));
-          addHtml(formatIP(it->second.IP()));
-          uint16_t port = it->second.webgui_portnumber;
+          addHtml(formatIP(it->IP()));
+          uint16_t port = it->webgui_portnumber;
 
           if ((port != 0) && (port != 80)) {
             addHtml(':');
             addHtmlInt(port);
           }
           addHtml('\'', '>');
-          addHtml(formatIP(it->second.IP()));
+          addHtml(formatIP(it->IP()));
           addHtml(F("</a>"));
         }
         html_TD();
-        const float load = it->second.getLoad();
+        const float load = it->getLoad();
 
         if (load > 0.1) {
           addHtmlFloat(load);
         }
         html_TD();
-        addHtmlInt(static_cast<uint32_t>(it->second.getAge() / 1000)); // time in seconds
+        addHtmlInt(static_cast<uint32_t>(it->getAge() / 1000)); // time in seconds
         #  ifdef USES_ESPEASY_NOW
 
         if (Settings.UseESPEasyNow()) {
           html_TD();
 
-          if (it->second.distance != 255) {
-            addHtmlInt(it->second.distance);
+          if (it->distance != 255) {
+            addHtmlInt(it->distance);
           }
           html_TD();
 
-          if (it->second.ESPEasyNowPeer) {
+          if (it->ESPEasyNowPeer) {
             addHtml(F(ESPEASY_NOW_NAME));
             addHtml(' ');
-            addHtml(it->second.ESPEasy_Now_MAC().toString());
+            addHtml(it->ESPEasy_Now_MAC().toString());
             addHtml(F(" (ch: "));
-            addHtmlInt(it->second.channel);
-            int8_t rssi = it->second.getRSSI();
+            addHtmlInt(it->channel);
+            int8_t rssi = it->getRSSI();
 
             if (rssi < 0) {
               addHtml(' ');
               addHtmlInt(rssi);
             }
             addHtml(')');
-            const ESPEasy_now_traceroute_struct *trace = Nodes.getDiscoveryRoute(it->second.unit);
+            const ESPEasy_now_traceroute_struct *trace = Nodes.getDiscoveryRoute(it->unit);
 
             if (trace != nullptr) {
               addHtml(' ');
@@ -112,8 +112,6 @@ void handle_rules() {
 
   sendHeadandTail_stdtemplate(_TAIL);
   TXBuffer.endStream();
-
-  checkRuleSets();
 }
 
 // ********************************************************************************
@@ -107,12 +107,15 @@ void handle_settingsarchive() {
     addTableSeparator(F("Download result"), 2, 3);
     bool somethingDownloaded = false;
 
+    // Use a single connection for all files.
+    DownloadFile_session session;
+
     for (int i = 0; i < FileType::MAX_FILETYPE; ++i) {
       const FileType::Enum ft = static_cast<FileType::Enum>(i);
 
       if (ft != FileType::RULES_TXT) {
         if (getDownloadFiletypeChecked(ft, 0)) {
-          if (tryDownloadFileType(url, user, pass, ft)) {
+          if (tryDownloadFileType(session, url, user, pass, ft)) {
             somethingDownloaded = true;
           }
         }
@@ -121,7 +124,7 @@ void handle_settingsarchive() {
 
     for (int i = 0; i < RULESETS_MAX; ++i) {
       if (getDownloadFiletypeChecked(FileType::RULES_TXT, i)) {
-        if (tryDownloadFileType(url, user, pass, FileType::RULES_TXT, i)) {
+        if (tryDownloadFileType(session, url, user, pass, FileType::RULES_TXT, i)) {
           somethingDownloaded = true;
         }
       }
@@ -280,11 +283,16 @@ void storeAllowFiletypeCheckbox(ProvisioningStruct& ProvisioningSettings, FileTy
 # endif // if FEATURE_CUSTOM_PROVISIONING
 
 
-bool tryDownloadFileType(const String& url, const String& user, const String& pass, FileType::Enum filetype, unsigned int filenr) {
+bool tryDownloadFileType(DownloadFile_session& session,
+                         const String        & url,
+                         const String        & user,
+                         const String        & pass,
+                         FileType::Enum        filetype,
+                         unsigned int          filenr) {
   const String filename = getFileName(filetype, filenr);
 
   addRowLabel(filename);
-  const String error = downloadFileType(url, user, pass, filetype, filenr);
+  const String error = downloadFileType(session, url, user, pass, filetype, filenr);
 
   if (error.length() == 0) {
     addHtml(F("Success"));
@@ -6,6 +6,7 @@
 #if FEATURE_SETTINGS_ARCHIVE
 
 #include "../DataTypes/ESPEasyFileType.h"
+#include "../Helpers/Networking.h"
 
 #if FEATURE_CUSTOM_PROVISIONING
 #include "../DataStructs/ProvisioningStruct.h"
@@ -31,7 +32,12 @@ void addAllowFiletypeCheckbox(const ProvisioningStruct& ProvisioningSettings, Fi
 void storeAllowFiletypeCheckbox(ProvisioningStruct& ProvisioningSettings, FileType::Enum filetype, unsigned int filenr = 0);
 # endif
 
-bool tryDownloadFileType(const String& url, const String& user, const String& pass, FileType::Enum filetype, unsigned int filenr = 0);
+bool tryDownloadFileType(DownloadFile_session& session,
+                         const String        & url,
+                         const String        & user,
+                         const String        & pass,
+                         FileType::Enum        filetype,
+                         unsigned int          filenr = 0);
 
 #endif // if FEATURE_SETTINGS_ARCHIVE
 
@@ -22,20 +22,25 @@
 # include "../ESPEasyCore/ESPEasyWifi.h"
 
 # include "../Globals/CRCValues.h"
+# include "../Globals/ESPEasy_Scheduler.h"
 # include "../Globals/ESPEasy_time.h"
 # include "../Globals/ESPEasyWiFiEvent.h"
 # include "../Globals/NetworkState.h"
 # include "../Globals/RTC.h"
 # include "../Globals/Settings.h"
 
+# include "../Helpers/BootProfiler.h"
 # include "../Helpers/Convert.h"
 # include "../Helpers/ESPEasyStatistics.h"
 # include "../Helpers/ESPEasy_Storage.h"
 # include "../Helpers/Hardware.h"
+# include "../Helpers/HeapTracker.h"
 # include "../Helpers/Memory.h"
 # include "../Helpers/Misc.h"
 # include "../Helpers/Networking.h"
 # include "../Helpers/OTA.h"
+# include "../Helpers/PowerManagement.h"
+# include "../Helpers/SlowLoopDetector.h"
 # include "../Helpers/StringConverter.h"
 # include "../Helpers/StringGenerator_GPIO.h"
 # include "../Helpers/StringGenerator_System.h"
@@ -273,6 +278,14 @@ void handle_sysinfo() {
 
   handle_sysinfo_NetworkServices();
 
+# if FEATURE_BOOT_PROFILER
+  handle_sysinfo_BootTimeline();
+# endif // if FEATURE_BOOT_PROFILER
+
+# if FEATURE_SLOW_LOOP_DETECTOR
+  handle_sysinfo_SlowLoops();
+# endif // if FEATURE_SLOW_LOOP_DETECTOR
+
   handle_sysinfo_ESP_Board();
 
   handle_sysinfo_Storage();
@@ -317,6 +330,24 @@ void handle_sysinfo_basicInfo() {
   }
   addRowLabelValue(LabelType::CPU_ECO_MODE);
 
+  addRowLabel(F("Scheduler Idle"));
+  addHtml(toString(Scheduler.getIdleTimePct(), 1));
+  addUnit('%');
+
+  if (Settings.EcoPowerMode()) {
+    addRowLabel(F("Eco Wait"));
+    addHtml(strformat(F("%s%% (%u waits)"),
+                      toString(PowerManagement_getWaitTimePct(), 1).c_str(),
+                      static_cast<unsigned int>(PowerManagement_getNrWaits())));
+    # ifdef ESP32
+    addRowLabel(F("Power Management"));
+    addHtml(strformat(F("DFS: %s, Light Sleep: %s, CPU: %d MHz"),
+                      PowerManagement_DFSenabled() ? "on" : "off",
+                      PowerManagement_lightSleepEnabled() ? "on" : "off",
+                      static_cast<int>(getCpuFrequencyMhz())));
+    # endif // ifdef ESP32
+  }
+
 
   addRowLabel(F("Boot"));
   {
@@ -390,6 +421,37 @@ void handle_sysinfo_memory() {
     addRowLabelValue(LabelType::PSRAM_MAX_FREE_BLOCK);
   } 
 # endif // if defined(ESP32) && defined(BOARD_HAS_PSRAM)
+
+  addRowLabel(F("Buffers"));
+  {
+    addHtmlInt(getBufferHeapUsage(false));
+    addHtml(F(" bytes"));
+# if defined(USE_SECOND_HEAP) || (defined(ESP32) && defined(BOARD_HAS_PSRAM))
+#  ifdef ESP32
+    addHtml(F(" + PSRAM: "));
+#  else // ifdef ESP32
+    addHtml(F(" + 2nd heap: "));
+#  endif // ifdef ESP32
+    addHtmlInt(getBufferHeapUsage(true));
+    addHtml(F(" bytes"));
+# endif // if defined(USE_SECOND_HEAP) || (defined(ESP32) && defined(BOARD_HAS_PSRAM))
+  }
+
+# if FEATURE_HEAP_TRACKER
+  addTableSeparator(F("Heap Usage"), 2, 3);
+
+  for (uint8_t i = 0; i < static_cast<uint8_t>(HeapTag_e::NR_ELEMENTS); ++i) {
+    const HeapTag_e tag         = static_cast<HeapTag_e>(i);
+    const HeapTagStats_t& stats = HeapTracker_getStats(tag);
+    addRowLabel(toString(tag));
+    addHtml(strformat(
+              F("%d [byte] (peak: %d, allocs: %u, frees: %u)"),
+              static_cast<int>(stats.current),
+              static_cast<int>(stats.peak),
+              static_cast<unsigned int>(stats.allocations),
+              static_cast<unsigned int>(stats.frees)));
+  }
+# endif // if FEATURE_HEAP_TRACKER
 }
 #endif
 
@@ -421,7 +483,15 @@ void handle_sysinfo_Network() {
   addRowLabelValue(LabelType::GATEWAY);
   addRowLabelValue(LabelType::CLIENT_IP);
   addRowLabelValue(LabelType::DNS);
+  # if FEATURE_DNS_CACHE
+  addRowLabelValue(LabelType::DNS_CACHE_STATS);
+  addRowLabelValue(LabelType::DNS_LOOKUP_TIME);
+  # endif // if FEATURE_DNS_CACHE
   addRowLabelValue(LabelType::ALLOWED_IP_RANGE);
+  # if FEATURE_ESPEASY_P2P
+  addRowLabelValue(LabelType::P2P_UDP_STATS);
+  addRowLabelValue(LabelType::P2P_UDP_PROCESSING_TIME);
+  # endif // if FEATURE_ESPEASY_P2P
   addRowLabelValue(LabelType::CONNECTED);
   addRowLabelValue(LabelType::NUMBER_RECONNECTS);
 
@@ -545,6 +615,12 @@ void handle_sysinfo_SystemStatus() {
     addRowLabelValue(LabelType::I2C_BUS_STATE);
     addRowLabelValue(LabelType::I2C_BUS_CLEARED_COUNT);
   }
+
+  addRowLabelValue(LabelType::EVENT_QUEUE_OVERFLOW_POLICY);
+  addRowLabelValue(LabelType::EVENT_QUEUE_MAX_DEPTH);
+  addRowLabelValue(LabelType::EVENT_QUEUE_DROPPED);
+  addRowLabelValue(LabelType::EVENT_QUEUE_COALESCED);
+  addRowLabelValue(LabelType::EVENT_QUEUE_FILTERED);
 }
 #endif
 
@@ -567,6 +643,76 @@ void handle_sysinfo_NetworkServices() {
 }
 #endif
 
+#if !defined(WEBSERVER_SYSINFO_MINIMAL) && FEATURE_BOOT_PROFILER
+static void addBootTimelineRow(const String& label, uint32_t duration_usec)
+{
+  addRowLabel(label);
+  addHtmlFloat(duration_usec / 1000.0f, 3);
+  addUnit(F("ms"));
+}
+
+void handle_sysinfo_BootTimeline() {
+  addTableSeparator(F("Boot Timeline"), 2, 3);
+
+  for (uint8_t i = 0; i < static_cast<uint8_t>(BootPhase_e::NR_ELEMENTS); ++i) {
+    const BootPhase_e phase    = static_cast<BootPhase_e>(i);
+    const uint32_t    duration = BootProfiler_getPhase(phase);
+
+    if (duration != 0) {
+      addBootTimelineRow(BootPhase_toString(phase), duration);
+    }
+  }
+  addBootTimelineRow(F("Setup Done"), BootProfiler_getSetupDone());
+
+  if (BootProfiler_getFirstSample() != 0) {
+    addBootTimelineRow(F("First Sample Sent"), BootProfiler_getFirstSample());
+  }
+
+  for (controllerIndex_t x = 0; x < CONTROLLER_MAX; ++x) {
+    const uint32_t duration = BootProfiler_getControllerInit(x);
+
+    if (duration != 0) {
+      addBootTimelineRow(concat(F("Controller "), x + 1) + F(" Init"), duration);
+    }
+  }
+
+  for (taskIndex_t x = 0; x < TASKS_MAX; ++x) {
+    const uint32_t duration = BootProfiler_getTaskInit(x);
+
+    if (duration != 0) {
+      addBootTimelineRow(
+        strformat(F("Task %d Init (%s)"), x + 1, getTaskDeviceName(x).c_str()),
+        duration);
+    }
+  }
+}
+#endif // if !defined(WEBSERVER_SYSINFO_MINIMAL) && FEATURE_BOOT_PROFILER
+
+#if !defined(WEBSERVER_SYSINFO_MINIMAL) && FEATURE_SLOW_LOOP_DETECTOR
+void handle_sysinfo_SlowLoops() {
+  addTableSeparator(F("Slow Loops"), 2, 3);
+
+  addRowLabel(F("Slow Loops Since Boot"));
+  addHtmlInt(SlowLoop_getCount());
+  addHtml(strformat(F(" (&gt; %d ms)"), SLOW_LOOP_THRESHOLD_USEC / 1000));
+
+  for (uint8_t i = 0; i < SlowLoop_getNrIncidents(); ++i) {
+    const SlowLoopIncident_t *incident = SlowLoop_getIncident(i);
+
+    if (incident == nullptr) { continue; }
+
+    if (incident->bootCounter == RTC.bootCounter) {
+      addRowLabel(strformat(F("Uptime %d sec"), static_cast<int>(incident->uptime_msec / 1000)));
+    } else {
+      addRowLabel(strformat(F("Boot #%u, uptime %d sec"), static_cast<unsigned int>(incident->bootCounter), static_cast<int>(incident->uptime_msec / 1000)));
+    }
+    addHtmlInt(incident->duration_usec / 1000);
+    addHtml(F(" ms: "));
+    addHtml(SlowLoop_describe(*incident));
+  }
+}
+#endif // if !defined(WEBSERVER_SYSINFO_MINIMAL) && FEATURE_SLOW_LOOP_DETECTOR
+
 #ifndef WEBSERVER_SYSINFO_MINIMAL
 void handle_sysinfo_ESP_Board() {
   addTableSeparator(F("ESP Board"), 2, 3);
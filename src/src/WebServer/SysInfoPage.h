@@ -40,6 +40,14 @@ void handle_sysinfo_SystemStatus();
 
 void handle_sysinfo_NetworkServices();
 
+#if FEATURE_BOOT_PROFILER
+void handle_sysinfo_BootTimeline();
+#endif
+
+#if FEATURE_SLOW_LOOP_DETECTOR
+void handle_sysinfo_SlowLoops();
+#endif
+
 void handle_sysinfo_ESP_Board();
 
 void handle_sysinfo_Storage();
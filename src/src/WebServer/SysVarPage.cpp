@@ -170,9 +170,16 @@ void handle_sysvars() {
   addTableSeparator(F("Custom Variables"), 3, 3);
 
   bool customVariablesAdded = false;
-  for (auto it = customFloatVar.begin(); it != customFloatVar.end(); ++it) {
-    addSysVar_html("%v" + String(it->first) + '%');
-    customVariablesAdded = true;
+  {
+    uint32_t index = 0;
+    ESPEASY_RULES_FLOAT_TYPE value{};
+    bool hasNext = getFirstCustomFloatVar(index, value);
+
+    while (hasNext) {
+      addSysVar_html("%v" + String(index) + '%');
+      customVariablesAdded = true;
+      hasNext = getNextCustomFloatVar(index, value);
+    }
   }
   if (!customVariablesAdded) {
     html_TR_TD();
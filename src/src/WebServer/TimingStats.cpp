@@ -5,15 +5,22 @@
 #include "../WebServer/ESPEasy_WebServer.h"
 #include "../WebServer/HTML_wrappers.h"
 #include "../WebServer/Markup.h"
+#include "../WebServer/Markup_Buttons.h"
 #include "../WebServer/Markup_Forms.h"
 
 #include "../DataTypes/ESPEasy_plugin_functions.h"
 
+#include "../Globals/Cache.h"
 #include "../Globals/ESPEasy_time.h"
 #include "../Globals/RamTracker.h"
+#include "../Globals/Settings.h"
 
 #include "../Globals/Device.h"
+#include "../Globals/ESPEasy_Scheduler.h"
+#include "../Globals/Plugins.h"
 
+#include "../Helpers/Misc.h"
+#include "../Helpers/PluginCallStats.h"
 #include "../Helpers/_Plugin_init.h"
 
 
@@ -36,10 +43,21 @@ void handle_timingstats() {
   html_table_header(F("min (ms)"));
   html_table_header(F("Avg (ms)"));
   html_table_header(F("max (ms)"));
+  #if FEATURE_TIMING_STATS_HISTOGRAM
+  html_table_header(F("p50 (ms)"));
+  html_table_header(F("p90 (ms)"));
+  html_table_header(F("p99 (ms)"));
+  #endif // if FEATURE_TIMING_STATS_HISTOGRAM
 
   const long timeSinceLastReset = stream_timing_statistics(true);
   html_end_table();
 
+  stream_scheduler_lateness_statistics(true);
+
+  #if FEATURE_PLUGIN_CALL_STATS
+  stream_plugin_call_statistics(true);
+  #endif // if FEATURE_PLUGIN_CALL_STATS
+
   html_table_class_normal();
   const float timespan = timeSinceLastReset / 1000.0f;
   addFormHeader(F("Statistics"));
@@ -50,6 +68,21 @@ void handle_timingstats() {
   addRowLabel(F("Time span"));
   addHtmlFloat(timespan);
   addHtml(F(" sec"));
+  #if FEATURE_EXTRA_TASK_SETTINGS_LRU
+  {
+    // Counted since boot, not reset with the statistics above.
+    const uint32_t hits   = Cache.extraTaskSettings_LRU.getHits();
+    const uint32_t misses = Cache.extraTaskSettings_LRU.getMisses();
+    addRowLabel(F("Task Settings Cache"));
+    addHtml(strformat(F("%u hits / %u misses"), static_cast<unsigned int>(hits), static_cast<unsigned int>(misses)));
+
+    if ((hits + misses) != 0) {
+      addHtml(F(" ("));
+      addHtmlFloat(100.0f * hits / (hits + misses), 1);
+      addHtml(F("% hit ratio)"));
+    }
+  }
+  #endif // if FEATURE_EXTRA_TASK_SETTINGS_LRU
   addRowLabel(F("*"));
   addHtml(F("Duty cycle based on average < 1 msec is highly unreliable"));
   html_end_table();
@@ -103,6 +136,14 @@ void stream_html_timing_stats(const TimingStats& stats, long timeSinceLastReset)
   format_using_threshhold(avg);
   html_TD();
   format_using_threshhold(maxVal);
+  #if FEATURE_TIMING_STATS_HISTOGRAM
+  html_TD();
+  format_using_threshhold(stats.getPercentile(50));
+  html_TD();
+  format_using_threshhold(stats.getPercentile(90));
+  html_TD();
+  format_using_threshhold(stats.getPercentile(99));
+  #endif // if FEATURE_TIMING_STATS_HISTOGRAM
 }
 
 long stream_timing_statistics(bool clearStats) {
@@ -173,4 +214,273 @@ long stream_timing_statistics(bool clearStats) {
   return timeSinceLastReset;
 }
 
+void stream_scheduler_lateness_statistics(bool clearStats) {
+  if (schedulerLatenessStats.empty()) { return; }
+
+  html_table_class_multirow();
+  html_TR();
+  html_table_header(F("Scheduler Lateness"));
+  html_table_header(F("#runs"));
+  html_table_header(F("#resync"));
+  html_table_header(F("min (ms)"));
+  html_table_header(F("Avg (ms)"));
+  html_table_header(F("max (ms)"));
+  #if FEATURE_TIMING_STATS_HISTOGRAM
+  html_table_header(F("p90 (ms)"));
+  html_table_header(F("p99 (ms)"));
+  #endif // if FEATURE_TIMING_STATS_HISTOGRAM
+
+  for (auto& x: schedulerLatenessStats) {
+    const TimingStats& stats = x.second.lateness;
+    uint64_t minVal, maxVal;
+    const uint32_t count = stats.getMinMax(minVal, maxVal);
+
+    if (stats.thresholdExceeded(TIMING_STATS_THRESHOLD) || (x.second.resyncCount != 0)) {
+      html_TR_TD_highlight();
+    } else {
+      html_TR_TD();
+    }
+    const SchedulerTimerID timerID(x.first);
+
+    if (timerID.id == 0) {
+      addHtml(toString(timerID.getTimerType()));
+    } else {
+      addHtml(ESPEasy_Scheduler::decodeSchedulerId(timerID));
+    }
+    html_TD();
+    addHtmlInt(count);
+    html_TD();
+    addHtmlInt(x.second.resyncCount);
+    html_TD();
+    format_using_threshhold(minVal);
+    html_TD();
+    format_using_threshhold(stats.getAvg());
+    html_TD();
+    format_using_threshhold(maxVal);
+    #if FEATURE_TIMING_STATS_HISTOGRAM
+    html_TD();
+    format_using_threshhold(stats.getPercentile(90));
+    html_TD();
+    format_using_threshhold(stats.getPercentile(99));
+    #endif // if FEATURE_TIMING_STATS_HISTOGRAM
+  }
+  html_end_table();
+
+  if (clearStats) {
+    schedulerLatenessStats.clear();
+  }
+}
+
+#if FEATURE_PLUGIN_CALL_STATS
+
+// Max nr of plugin calls shown, sorted on lowest free stack
+# define PLUGIN_CALL_STATS_NR_SHOWN  10
+
+static void addPluginCallDescription(taskIndex_t taskIndex, uint8_t function) {
+  if (validTaskIndex(taskIndex)) {
+    addHtml(strformat(F("Task %d "), taskIndex + 1));
+    addHtml(getTaskDeviceName(taskIndex));
+  } else {
+    addHtml('-');
+  }
+  html_TD();
+  addHtml(getPluginFunctionName(function));
+}
+
+void stream_plugin_call_statistics(bool clearStats) {
+  PluginCallStats_t stats[PLUGIN_CALL_STATS_NR_SHOWN];
+  const uint8_t     nrEntries = PluginCallStats_getSorted(stats, PLUGIN_CALL_STATS_NR_SHOWN);
+
+  html_table_class_multirow();
+  html_TR();
+  html_table_header(F("Plugin Call Stack"));
+  html_table_header(F("Function"));
+  html_table_header(F("#calls"));
+  html_table_header(F("Avg (ms)"));
+  html_table_header(F("max (ms)"));
+  html_table_header(F("Free stack at call"));
+  html_table_header(F("Free stack low"));
+
+  for (uint8_t i = 0; i < nrEntries; ++i) {
+    const PluginCallStats_t& entry = stats[i];
+
+    if (entry.maxDuration_usec > TIMING_STATS_THRESHOLD) {
+      html_TR_TD_highlight();
+    } else {
+      html_TR_TD();
+    }
+    addPluginCallDescription(entry.taskIndex, entry.function);
+    html_TD();
+    addHtmlInt(entry.count);
+    html_TD();
+    format_using_threshhold(entry.sumDuration_usec / entry.count);
+    html_TD();
+    format_using_threshhold(entry.maxDuration_usec);
+    html_TD();
+    addHtmlInt(entry.minStackAtCall);
+    html_TD();
+
+    if (entry.stackLow != PLUGIN_CALL_STATS_NO_STACK) {
+      addHtmlInt(entry.stackLow);
+    } else {
+      addHtml('-');
+    }
+  }
+  html_end_table();
+
+  const RTC_PluginCall_t& beforeReboot = PluginCallStats_getBeforeReboot();
+
+  if (validTaskIndex(beforeReboot.taskIndex) || validTaskIndex(beforeReboot.lowStackTaskIndex)) {
+    html_table_class_multirow();
+    html_TR();
+    html_table_header(F("Before Reboot"));
+    html_table_header(F("Task"));
+    html_table_header(F("Function"));
+    html_table_header(F("Free stack"));
+
+    if (validTaskIndex(beforeReboot.taskIndex)) {
+      if (beforeReboot.active) {
+        html_TR_TD_highlight();
+        addHtml(F("Active plugin call"));
+      } else {
+        html_TR_TD();
+        addHtml(F("Last plugin call"));
+      }
+      html_TD();
+      addPluginCallDescription(beforeReboot.taskIndex, beforeReboot.function);
+      html_TD();
+    }
+
+    if (validTaskIndex(beforeReboot.lowStackTaskIndex)) {
+      html_TR_TD();
+      addHtml(F("Lowest free stack"));
+      html_TD();
+      addPluginCallDescription(beforeReboot.lowStackTaskIndex, beforeReboot.lowStackFunction);
+      html_TD();
+      addHtmlInt(beforeReboot.lowStack);
+    }
+    html_end_table();
+  }
+
+  if (clearStats) {
+    PluginCallStats_clear();
+  }
+}
+
+#endif // if FEATURE_PLUGIN_CALL_STATS
+
+#if FEATURE_RULES_PROFILING
+
+// ********************************************************************************
+// Statistics per rules block
+// ********************************************************************************
+void handle_rules_timingstats() {
+  if (!isLoggedIn()) { return; }
+  #ifndef BUILD_NO_RAM_TRACKER
+  checkRAM(F("handle_rules_timingstats"));
+  #endif
+  navMenuIndex = MENU_INDEX_TOOLS;
+
+  if (hasArg(F("clear"))) {
+    Cache.rulesHelper.clearProfiles();
+  }
+  TXBuffer.startStream();
+  sendHeadandTail_stdtemplate(_HEAD);
+  html_table_class_multirow();
+  html_TR();
+  html_table_header(F("File"));
+  html_table_header(F("Event"));
+  html_table_header(F("#matched"));
+  html_table_header(F("Total (ms)"));
+  html_table_header(F("Avg (ms)"));
+  html_table_header(F("max (ms)"));
+  html_table_header(F("#commands"));
+  html_table_header(F("Heap delta"));
+  html_table_header(F("Min heap delta"));
+
+  const RulesEventCache& cache = Cache.rulesHelper.getEventCache();
+
+  for (auto it = cache.begin(); it != cache.end(); ++it) {
+    if (it->_nrTimesMatched != 0) {
+      const RulesEventCache_profile& profile = it->_profile;
+
+      if (profile._maxDuration_usec > TIMING_STATS_THRESHOLD) {
+        html_TR_TD_highlight();
+      } else {
+        html_TR_TD();
+      }
+      addHtml(it->_filename);
+      html_TD();
+      addHtml(it->_event);
+      html_TD();
+      addHtmlInt(static_cast<uint32_t>(it->_nrTimesMatched));
+      html_TD();
+      addHtmlFloat(profile._totalDuration_usec / 1000.0f, 3);
+      html_TD();
+      format_using_threshhold(profile._totalDuration_usec / it->_nrTimesMatched);
+      html_TD();
+      format_using_threshhold(profile._maxDuration_usec);
+      html_TD();
+      addHtmlInt(profile._nrCommands);
+      html_TD();
+      addHtmlInt(profile._heapDeltaTotal);
+      html_TD();
+      addHtmlInt(profile._heapDeltaMin);
+    }
+  }
+  html_end_table();
+
+  html_table_class_normal();
+  addFormHeader(F("Rules Statistics"));
+  addRowLabel(F("*"));
+
+  if (Settings.EnableRulesCaching()) {
+    addHtml(F("Time and commands include nested events"));
+  } else {
+    addHtml(F("Requires Rules Cache to be enabled"));
+  }
+  html_TR_TD();
+  html_TD();
+  addButton(F("/rules_timingstats?clear=1"), F("Reset"));
+  addButton(F("/rules_timingstats_csv"),     F("Download CSV"));
+  addButton(F("/rules_timingstats_json"),    F("Show JSON"));
+  html_end_table();
+
+  sendHeadandTail_stdtemplate(_TAIL);
+  TXBuffer.endStream();
+}
+
+void handle_rules_timingstats_csv() {
+  if (!isLoggedIn()) { return; }
+
+  sendHeader(F("Content-Disposition"), F("attachment; filename=rules_timingstats.csv"));
+  TXBuffer.startStream(F("text/csv"), F("*"), 200);
+  addHtml(F("file;event;matched;total_usec;max_usec;commands;heap_delta;heap_delta_min\n"));
+
+  const RulesEventCache& cache = Cache.rulesHelper.getEventCache();
+
+  for (auto it = cache.begin(); it != cache.end(); ++it) {
+    const RulesEventCache_profile& profile = it->_profile;
+    addHtml(it->_filename);
+    addHtml(';');
+    addHtml(it->_event);
+    addHtml(';');
+    addHtmlInt(static_cast<uint32_t>(it->_nrTimesMatched));
+    addHtml(';');
+    addHtmlInt(profile._totalDuration_usec);
+    addHtml(';');
+    addHtmlInt(profile._maxDuration_usec);
+    addHtml(';');
+    addHtmlInt(profile._nrCommands);
+    addHtml(';');
+    addHtmlInt(profile._heapDeltaTotal);
+    addHtml(';');
+    addHtmlInt(profile._heapDeltaMin);
+    addHtml('\n');
+  }
+  TXBuffer.endStream();
+}
+
+#endif // if FEATURE_RULES_PROFILING
+
 #endif // WEBSERVER_TIMINGSTATS
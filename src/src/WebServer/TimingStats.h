@@ -18,6 +18,27 @@ void stream_html_timing_stats(const TimingStats& stats, long timeSinceLastReset)
 
 long stream_timing_statistics(bool clearStats);
 
+// Table with the lateness of scheduled timers
+void stream_scheduler_lateness_statistics(bool clearStats);
+
+#if FEATURE_PLUGIN_CALL_STATS
+
+// Table with the plugin calls using the most stack
+void stream_plugin_call_statistics(bool clearStats);
+
+#endif // if FEATURE_PLUGIN_CALL_STATS
+
+#if FEATURE_RULES_PROFILING
+
+// ********************************************************************************
+// Statistics per rules block
+// ********************************************************************************
+void handle_rules_timingstats();
+
+void handle_rules_timingstats_csv();
+
+#endif // if FEATURE_RULES_PROFILING
+
 #endif 
 
 
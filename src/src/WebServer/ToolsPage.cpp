@@ -84,6 +84,12 @@ void handle_tools() {
 
   # ifdef WEBSERVER_TIMINGSTATS
   addWideButtonPlusDescription(F("timingstats"), F("Timing stats"), F("Open timing statistics of system"));
+  #  if FEATURE_RULES_PROFILING
+  addWideButtonPlusDescription(F("rules_timingstats"), F("Rules stats"), F("Open timing statistics per rules block"));
+  #  endif // if FEATURE_RULES_PROFILING
+  #  if FEATURE_EVENT_TRACER
+  addWideButtonPlusDescription(F("eventtrace"), F("Event trace"), F("Record a timeline of the main loop"));
+  #  endif // if FEATURE_EVENT_TRACER
   # endif // WEBSERVER_TIMINGSTATS
 
   # ifdef WEBSERVER_PINSTATES
@@ -176,7 +176,12 @@ void handleFileUploadBase(bool toSDcard) {
   }
   else if (upload.status == UPLOAD_FILE_END)
   {
-    if (uploadFile) { uploadFile.close(); }
+    if (uploadFile) {
+      uploadFile.close();
+
+      // Only now the rules file is complete, so start parsing it again from here.
+      Cache.rulesHelper.invalidateRulesFile(upload.filename);
+    }
 
     if (loglevelActiveFor(LOG_LEVEL_INFO)) {
       String log = F("Upload: END, Size: ");
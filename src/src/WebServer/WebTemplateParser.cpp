@@ -5,6 +5,7 @@
 #include "../DataTypes/ControllerIndex.h"
 
 #include "../Globals/Settings.h"
+#include "../Globals/TXBuffer.h"
 
 #include "../Helpers/_CPlugin_init.h"
 #include "../Helpers/ESPEasy_Storage.h"
@@ -144,7 +145,7 @@ bool WebTemplateParser::process(const char c) {
         if (Tail == contentVarFound) {
           // only send the template tail after {{content}} is found
           // Or send all until the {{content}} tag.
-          addHtml(c);
+          addLiteral(c);
         }
       }
       break;
@@ -191,7 +192,30 @@ bool WebTemplateParser::process(PGM_P pstr)
   const char *c = pstr;
   size_t length = strlen_P((PGM_P)pstr);
 
-  while (length-- > 0) {
+  while (length > 0) {
+    if (!parsingVarName) {
+      // Literal text up to the next '{' or '}' can be sent at once
+      size_t run = 0;
+
+      while (run < length) {
+        const char ch = static_cast<char>(pgm_read_byte(c + run));
+
+        if ((ch == '{') || (ch == '}')) { break; }
+        ++run;
+      }
+
+      if (run > 0) {
+        if (Tail == contentVarFound) {
+          addLiteral(c, run);
+        }
+        prev    = static_cast<char>(pgm_read_byte(c + run - 1));
+        c      += run;
+        length -= run;
+        continue;
+      }
+    }
+    --length;
+
     if (!process(static_cast<char>(pgm_read_byte(c++)))) { return false; }
   }
   return true;
@@ -213,9 +237,82 @@ void WebTemplateParser::processVarName()
   if (!varName.length()) { return; }
   varName.toLowerCase();
 
+  #if FEATURE_WEB_TEMPLATE_CACHE
+
+  if (_compileTo != nullptr) {
+    WebPageTemplate_segment segment;
+    segment.text  = varName;
+    segment.isVar = true;
+    _compileTo->push_back(std::move(segment));
+    return;
+  }
+  #endif // if FEATURE_WEB_TEMPLATE_CACHE
+
   getWebPageTemplateVar(varName);
 }
 
+void WebTemplateParser::addLiteral(char c)
+{
+  #if FEATURE_WEB_TEMPLATE_CACHE
+
+  if (_compileTo != nullptr) {
+    if (_compileTo->empty() || _compileTo->back().isVar || (_compileTo->back().flashText != nullptr)) {
+      _compileTo->emplace_back();
+    }
+    _compileTo->back().text += c;
+    return;
+  }
+  #endif // if FEATURE_WEB_TEMPLATE_CACHE
+  addHtml(c);
+}
+
+void WebTemplateParser::addLiteral(PGM_P str, size_t length)
+{
+  #if FEATURE_WEB_TEMPLATE_CACHE
+
+  if (_compileTo != nullptr) {
+    if (!_compileTo->empty()) {
+      WebPageTemplate_segment& last = _compileTo->back();
+
+      // Merge with the previous span when the text is adjacent in flash
+      if ((last.flashText != nullptr) &&
+          (last.flashText + last.flashLength == str) &&
+          (last.flashLength + length <= 0xFFFF)) {
+        last.flashLength += length;
+        return;
+      }
+    }
+
+    while (length > 0) {
+      const uint16_t spanLength = (length > 0xFFFF) ? 0xFFFF : length;
+      WebPageTemplate_segment segment;
+      segment.flashText   = str;
+      segment.flashLength = spanLength;
+      _compileTo->push_back(std::move(segment));
+      str    += spanLength;
+      length -= spanLength;
+    }
+    return;
+  }
+  #endif // if FEATURE_WEB_TEMPLATE_CACHE
+  TXBuffer.addFlashString(str, length);
+}
+
+#if FEATURE_WEB_TEMPLATE_CACHE
+void WebTemplateParser::render(const WebPageTemplate_segments& segments)
+{
+  for (auto it = segments.begin(); it != segments.end(); ++it) {
+    if (it->isVar) {
+      getWebPageTemplateVar(it->text);
+    } else if (it->flashText != nullptr) {
+      TXBuffer.addFlashString(it->flashText, it->flashLength);
+    } else {
+      addHtml(it->text);
+    }
+  }
+}
+#endif // if FEATURE_WEB_TEMPLATE_CACHE
+
 void WebTemplateParser::getErrorNotifications() {
   // Check number of MQTT controllers active.
   int nrMQTTenabled = 0;
@@ -3,10 +3,21 @@
 
 #include "../../ESPEasy_common.h"
 
+#include "../CustomBuild/ESPEasyLimits.h"
+#include "../DataStructs/WebPageTemplateCache.h"
+
 #define _HEAD false
 #define _TAIL true
 
-#define TASKS_PER_PAGE TASKS_MAX
+#ifndef TASKS_PER_PAGE
+# if TASKS_MAX > 16
+
+// Rendering all tasks at once takes too long on nodes with a lot of tasks
+#  define TASKS_PER_PAGE (TASKS_MAX / 2)
+# else // if TASKS_MAX > 16
+#  define TASKS_PER_PAGE TASKS_MAX
+# endif // if TASKS_MAX > 16
+#endif // ifndef TASKS_PER_PAGE
 
 
 #define MENU_INDEX_MAIN          0
@@ -27,6 +38,15 @@ public:
 
   WebTemplateParser(bool tail, bool rebooting) : Tail(tail), Rebooting(rebooting) {}
 
+  #if FEATURE_WEB_TEMPLATE_CACHE
+
+  // Split the template in literal text and variables, instead of sending it.
+  WebTemplateParser(bool tail, WebPageTemplate_segments& compileTo) : Tail(tail), _compileTo(&compileTo) {}
+
+  // Send a template split by the parser above.
+  void render(const WebPageTemplate_segments& segments);
+  #endif // if FEATURE_WEB_TEMPLATE_CACHE
+
   bool process(const char c);
 
   bool process(const __FlashStringHelper * pstr);
@@ -39,6 +59,11 @@ private:
 
   void processVarName();
 
+  void addLiteral(char c);
+
+  void addLiteral(PGM_P  str,
+                  size_t length);
+
   void getErrorNotifications();
 
   void getWebPageTemplateVar(const String& varName);
@@ -50,6 +75,10 @@ private:
   const bool Rebooting = false;
   bool contentVarFound = false;
   bool parsingVarName = false;
+
+  #if FEATURE_WEB_TEMPLATE_CACHE
+  WebPageTemplate_segments *_compileTo = nullptr;
+  #endif // if FEATURE_WEB_TEMPLATE_CACHE
 };
 
 
@@ -5,6 +5,7 @@
 #include "../WebServer/HTML_wrappers.h"
 
 #include "../ESPEasyCore/ESPEasyWifi.h"
+#include "../Globals/ESPEasyWiFiEvent.h"
 #include "../Globals/WiFi_AP_Candidates.h"
 #include "../Helpers/StringGenerator_WiFi.h"
 
@@ -24,16 +25,18 @@ void handle_wifiscanner_json() {
 
   if (!isLoggedIn()) { return; }
   navMenuIndex = MENU_INDEX_TOOLS;
+
+  // Do not wait for a scan, reply with the last results.
+  // The client may poll again while X-Scan-In-Progress is set.
+  sendHeader(F("X-Scan-In-Progress"), WifiScan_request() ? F("1") : F("0"));
+
+  if (WiFiEventData.lastScanMoment.isSet()) {
+    sendHeader(F("X-Scan-Age"), String(static_cast<uint32_t>(WiFiEventData.lastScanMoment.millisPassedSince())));
+  }
   TXBuffer.startJsonStream();
   addHtml('[', '{');
   bool firstentry = true;
 
-  if (WiFi_AP_Candidates.scanComplete() <= 0) {
-    WiFiMode_t cur_wifimode = WiFi.getMode();
-    WifiScan(false);
-    setWifiMode(cur_wifimode);
-  }
-
   for (auto it = WiFi_AP_Candidates.scanned_begin(); it != WiFi_AP_Candidates.scanned_end(); ++it)
   {
     if (firstentry) { firstentry = false; }
@@ -65,14 +68,22 @@ void handle_wifiscanner() {
 
   if (!isLoggedIn()) { return; }
 
-  WiFiMode_t cur_wifimode = WiFi.getMode();
-  WifiScan(false);
-  int8_t scanCompleteStatus = WiFi_AP_Candidates.scanComplete();
-  setWifiMode(cur_wifimode);
+  // Show the last scan results, a new scan is started from the loop when needed.
+  const bool   scanInProgress     = WifiScan_request();
+  const int8_t scanCompleteStatus = WiFi_AP_Candidates.scanComplete();
 
   navMenuIndex = MENU_INDEX_TOOLS;
   TXBuffer.startStream();
   sendHeadandTail_stdtemplate(_HEAD);
+
+  if (scanInProgress) {
+    addHtml(F("<meta http-equiv='refresh' content='3'>"));
+    addHtml(F("Scan in progress..."));
+    html_BR();
+  } else if (WiFiEventData.lastScanMoment.isSet()) {
+    addHtml(strformat(F("Last scan: %d sec ago"), static_cast<int>(WiFiEventData.lastScanMoment.millisPassedSince() / 1000)));
+    html_BR();
+  }
   html_table_class_multirow();
   html_TR();
   html_table_header(getLabel(LabelType::SSID));
@@ -35,11 +35,16 @@ if (browser.name = 'IE' && browser.version < 12) {
 }
 document.getElementById('copyText_1').innerHTML = textToDisplay;
 loopDeLoop(1000, 0);
+// Sequence nr of the next log line, so only new lines are fetched
+var logNextSeq;
 var logLevel = new Array('Unused', 'Error', 'Info', 'Debug', 'Debug More', 'Undefined', 'Undefined', 'Undefined', 'Undefined', 'Debug Dev');
 
 function loopDeLoop(timeForNext, activeRequests) {
     var maximumRequests = 1;
     var url = '/logjson';
+    if (logNextSeq != null) {
+        url += '?since=' + logNextSeq;
+    }
     if (isNaN(activeRequests)) {
         activeRequests = maximumRequests;
     }
@@ -87,6 +92,9 @@ function loopDeLoop(timeForNext, activeRequests) {
                         }
                     }
                     timeForNext = data.Log.TTL;
+                    if (data.Log.next != null) {
+                        logNextSeq = data.Log.next;
+                    }
                     if (logEntriesChunk !== '') {
                         if (document.getElementById('copyText_1').innerHTML == 'Fetching log entries...') {
                             document.getElementById('copyText_1').innerHTML = '';
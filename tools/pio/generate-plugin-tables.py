@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+#
+# Generate the lookup tables for the plugins included in a build.
+#
+# The plugin names are only known in the _Pxxx_*.ino files, so the order of the
+# device selector (alfabetically sorted on plugin name) cannot be determined by
+# the compiler. This script collects the PLUGIN_NAME_xxx defines and writes
+# src/src/Helpers/_Plugin_init_tables.h which is included in _Plugin_init.cpp.
+#
+# Every entry is guarded by its USES_Pxxx define, so the tables fit any build.
+# The generated file is part of the repository, so it can also be run by hand:
+#   python3 tools/pio/generate-plugin-tables.py
+
+import os
+import re
+import sys
+
+try:
+    Import("env")
+    project_dir = env.subst("$PROJECT_DIR")
+except NameError:
+    project_dir = os.path.abspath(os.path.join(os.path.dirname(sys.argv[0]), '..', '..'))
+
+
+PLUGIN_ID_MAX = 255
+
+plugin_file_re = re.compile(r'^_P(\d{3})_.*\.ino$')
+plugin_name_re = re.compile(r'^\s*#\s*define\s+PLUGIN_NAME_(\d{3})\s+"([^"]*)"', re.MULTILINE)
+
+
+def collect_plugin_names(src_dir):
+    names = {}
+
+    for filename in sorted(os.listdir(src_dir)):
+        match = plugin_file_re.match(filename)
+        if not match:
+            continue
+        plugin_id = int(match.group(1))
+
+        with open(os.path.join(src_dir, filename), 'r', encoding='utf-8', errors='ignore') as f:
+            content = f.read()
+
+        # Some plugins have a different name depending on build flags.
+        # Use the first one, it only affects the order in the device selector.
+        name_match = plugin_name_re.search(content)
+        if name_match and int(name_match.group(1)) == plugin_id:
+            names[plugin_id] = name_match.group(2)
+    return names
+
+
+def generate_header(names):
+    lines = [
+        '// Generated by tools/pio/generate-plugin-tables.py, do not edit.',
+        '// Included from _Plugin_init.cpp',
+        '',
+        '// Plugin ID to DeviceIndex, array index is the plugin ID.',
+        '// Entries of plugins not included in the build are DEVICE_INDEX_MAX',
+        'constexpr /*deviceIndex_t*/ uint8_t Plugin_id_to_DeviceIndex[] PROGMEM =',
+        '{'
+    ]
+
+    for plugin_id in range(PLUGIN_ID_MAX + 1):
+        lines.append('  getDeviceIndex_from_PluginID_constexpr({}),'.format(plugin_id))
+
+    lines += [
+        '};',
+        '',
+        '// DeviceIndex alfabetically sorted on plugin name (case sensitive).',
+        '// Used in device selector dropdown.',
+        'constexpr /*deviceIndex_t*/ uint8_t DeviceIndex_sorted[] PROGMEM =',
+        '{'
+    ]
+
+    # Python string compare matches the case sensitive String compare on the ESP
+    for plugin_id, name in sorted(names.items(), key=lambda item: (item[1], item[0])):
+        lines += [
+            '#ifdef USES_P{:03d}'.format(plugin_id),
+            '  getDeviceIndex_from_PluginID_constexpr({}), // {}'.format(plugin_id, name),
+            '#endif // ifdef USES_P{:03d}'.format(plugin_id),
+            ''
+        ]
+
+    lines += [
+        '};',
+        ''
+    ]
+    return '\n'.join(lines)
+
+
+def write_if_changed(filename, content):
+    if os.path.isfile(filename):
+        with open(filename, 'r', encoding='utf-8') as f:
+            if f.read() == content:
+                return
+    # Only write when changed, to prevent a full rebuild
+    with open(filename, 'w', encoding='utf-8', newline='\n') as f:
+        f.write(content)
+    print('Generated {}'.format(filename))
+
+
+src_dir = os.path.join(project_dir, 'src')
+write_if_changed(
+    os.path.join(src_dir, 'src', 'Helpers', '_Plugin_init_tables.h'),
+    generate_header(collect_plugin_names(src_dir)))